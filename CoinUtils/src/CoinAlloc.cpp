@@ -5,11 +5,45 @@
 
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include "CoinAlloc.hpp"
+#include "CoinHelperFunctions.hpp"
 
 #if (COINUTILS_MEMPOOL_MAXPOOLED >= 0)
 
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+/* Pointers in a tagged word.  User space addresses fit in 48 bits on
+   64 bit platforms, which leaves 16 bits for the tag */
+static const CoinUInt64 coinTagPointerMask = sizeof(void*) == 8 ?
+  (static_cast<CoinUInt64>(1) << 48) - 1 : 0xffffffffu;
+static const CoinUInt64 coinTagIncrement = coinTagPointerMask + 1;
+
+static inline char*
+coinTagPointer(CoinUInt64 tagged)
+{
+  return reinterpret_cast<char*>(static_cast<size_t>(tagged & coinTagPointerMask));
+}
+static inline CoinUInt64
+coinTagNext(CoinUInt64 old, char* pointer)
+{
+  return ((old + coinTagIncrement) & ~coinTagPointerMask)
+    | static_cast<CoinUInt64>(reinterpret_cast<size_t>(pointer));
+}
+// Link between entries in batch
+static inline char*&
+coinEntryNext(char* entry)
+{
+  return reinterpret_cast<char**>(entry)[0];
+}
+// Link between batches
+static inline char*&
+coinBatchNext(char* entry)
+{
+  return reinterpret_cast<char**>(entry)[1];
+}
+#endif
+
 //=============================================================================
 
 CoinMempool::CoinMempool(size_t entry) :
@@ -20,9 +54,12 @@ CoinMempool::CoinMempool(size_t entry) :
 #endif
   last_block_size_(0),
   first_free_(NULL),
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+  batches_(0),
+#endif
   entry_size_(entry)
 {
-#if defined(COINUTILS_PTHREADS) && (COINUTILS_PTHREAD == 1)
+#ifdef COINUTILS_PTHREADS
   pthread_mutex_init(&mutex_, NULL);
 #endif
   assert((entry_size_/COINUTILS_MEMPOOL_ALIGNMENT)*COINUTILS_MEMPOOL_ALIGNMENT
@@ -38,13 +75,117 @@ CoinMempool::~CoinMempool()
     free(block_heads_[i]);
   }
 #endif
-#if defined(COINUTILS_PTHREADS) && (COINUTILS_PTHREAD == 1)
+#ifdef COINUTILS_PTHREADS
   pthread_mutex_destroy(&mutex_);
 #endif
 }
 
 //==============================================================================
 
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+
+void
+CoinMempool::push_batch(char* batch)
+{
+  CoinUInt64 old = __atomic_load_n(&batches_, __ATOMIC_ACQUIRE);
+  while (true) {
+    __atomic_store_n(&coinBatchNext(batch), coinTagPointer(old), __ATOMIC_RELAXED);
+    CoinUInt64 seen =
+      __sync_val_compare_and_swap(&batches_, old, coinTagNext(old, batch));
+    if (seen == old)
+      return;
+    old = seen;
+  }
+}
+
+char*
+CoinMempool::pop_batch()
+{
+  CoinUInt64 old = __atomic_load_n(&batches_, __ATOMIC_ACQUIRE);
+  while (true) {
+    char* batch = coinTagPointer(old);
+    if (!batch)
+      return NULL;
+    /* batch may have been taken by another thread, but the memory stays
+       in the pool so the read is safe and the tag makes the swap fail */
+    char* next = __atomic_load_n(&coinBatchNext(batch), __ATOMIC_RELAXED);
+    CoinUInt64 seen =
+      __sync_val_compare_and_swap(&batches_, old, coinTagNext(old, next));
+    if (seen == old)
+      return batch;
+    old = seen;
+  }
+}
+
+char*
+CoinMempool::refill(CoinMempoolCache& cache)
+{
+  char* batch = pop_batch();
+  if (!batch) {
+    lock_mutex();
+    batch = allocate_new_block();
+    record_block(batch);
+    unlock_mutex();
+  }
+  // keep a batch worth and give back the rest
+  int n = 1;
+  char* last = batch;
+  while (n < COINUTILS_MEMPOOL_BATCH && coinEntryNext(last)) {
+    last = coinEntryNext(last);
+    n++;
+  }
+  char* rest = coinEntryNext(last);
+  if (rest) {
+    coinEntryNext(last) = NULL;
+    push_batch(rest);
+  }
+  cache.first = coinEntryNext(batch);
+  cache.number = n - 1;
+  return batch;
+}
+
+void
+CoinMempool::drain(CoinMempoolCache& cache, int keep)
+{
+  if (keep <= 0) {
+    if (cache.first)
+      push_batch(cache.first);
+    cache.first = NULL;
+    cache.number = 0;
+    return;
+  }
+  char* last = cache.first;
+  int n = 1;
+  while (n < keep && last && coinEntryNext(last)) {
+    last = coinEntryNext(last);
+    n++;
+  }
+  if (last && coinEntryNext(last)) {
+    push_batch(coinEntryNext(last));
+    coinEntryNext(last) = NULL;
+  }
+  cache.number = last ? n : 0;
+}
+
+char*
+CoinMempool::alloc()
+{
+  CoinMempoolCache cache;
+  char* p = refill(cache);
+  if (cache.first)
+    push_batch(cache.first);
+  return p;
+}
+
+void
+CoinMempool::dealloc(char* p)
+{
+  coinEntryNext(p) = NULL;
+  push_batch(p);
+}
+
+#else
+
 char* 
 CoinMempool::alloc()
 {
@@ -53,19 +194,7 @@ CoinMempool::alloc()
     unlock_mutex();
     char* block = allocate_new_block();
     lock_mutex();
-#if (COIN_MEMPOOL_SAVE_BLOCKHEADS==1)
-    // see if we can record another block head. If not, then resize
-    // block_heads
-    if (max_block_num_ == block_num_) {
-      max_block_num_ = 2 * block_num_ + 10;
-      char** old_block_heads = block_heads_;
-      block_heads_ = (char**)malloc(max_block_num_ * sizeof(char*));
-      CoinMemcpyN( old_block_heads,block_num_,block_heads_);
-      free(old_block_heads);
-    }
-    // save the new block
-    block_heads_[block_num_++] = block;
-#endif
+    record_block(block);
     // link in the new block
     *(char**)(block+((last_block_size_-1)*entry_size_)) = first_free_;
     first_free_ = block;
@@ -76,6 +205,30 @@ CoinMempool::alloc()
   return p;
 }
 
+#endif
+
+//=============================================================================
+
+void
+CoinMempool::record_block(char* block)
+{
+#if (COIN_MEMPOOL_SAVE_BLOCKHEADS==1)
+  // see if we can record another block head. If not, then resize
+  // block_heads
+  if (max_block_num_ == block_num_) {
+    max_block_num_ = 2 * block_num_ + 10;
+    char** old_block_heads = block_heads_;
+    block_heads_ = (char**)malloc(max_block_num_ * sizeof(char*));
+    CoinMemcpyN( old_block_heads,block_num_,block_heads_);
+    free(old_block_heads);
+  }
+  // save the new block
+  block_heads_[block_num_++] = block;
+#else
+  (void) block;
+#endif
+}
+
 //=============================================================================
 
 char*
@@ -83,6 +236,7 @@ CoinMempool::allocate_new_block()
 {
   last_block_size_ = static_cast<int>(1.5 * last_block_size_ + 32);
   char* block = static_cast<char*>(std::malloc(last_block_size_*entry_size_));
+  if (block == NULL) throw std::bad_alloc();
   // link the entries in the new block together
   for (int i = last_block_size_-2; i >= 0; --i) {
     *(char**)(block+(i*entry_size_)) = block+((i+1)*entry_size_);
@@ -112,8 +266,37 @@ CoinAlloc::CoinAlloc() :
       new (&pool_[i]) CoinMempool(i*COINUTILS_MEMPOOL_ALIGNMENT);
     }
   }
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+  pthread_key_create(&cacheKey_, freeThreadCache);
+#endif
 }
 
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+CoinMempoolCache*
+CoinAlloc::newThreadCache()
+{
+  const size_t poolnum = maxpooled_ / COINUTILS_MEMPOOL_ALIGNMENT;
+  const size_t size = sizeof(ThreadCache) + poolnum*sizeof(CoinMempoolCache);
+  ThreadCache* caches = static_cast<ThreadCache*>(std::malloc(size));
+  if (caches == NULL) throw std::bad_alloc();
+  std::memset(caches, 0, size);
+  caches->owner = this;
+  pthread_setspecific(cacheKey_, caches);
+  return caches->cache;
+}
+
+void
+CoinAlloc::freeThreadCache(void* data)
+{
+  ThreadCache* caches = static_cast<ThreadCache*>(data);
+  CoinAlloc* owner = caches->owner;
+  const int poolnum = owner->maxpooled_ / COINUTILS_MEMPOOL_ALIGNMENT;
+  for (int i = 0; i < poolnum; i++)
+    owner->pool_[i].drain(caches->cache[i], 0);
+  std::free(caches);
+}
+#endif
+
 //#############################################################################
 
 #if defined(COINUTILS_MEMPOOL_OVERRIDE_NEW) && (COINUTILS_MEMPOOL_OVERRIDE_NEW == 1)
@@ -8,6 +8,11 @@
 
 #include "CoinUtilsConfig.h"
 #include <cstdlib>
+#include <new>
+#include "CoinTypes.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 
 #if !defined(COINUTILS_MEMPOOL_MAXPOOLED)
 #  define COINUTILS_MEMPOOL_MAXPOOLED -1
@@ -46,21 +51,47 @@ static const std::size_t CoinAllocRoundMask = ~((std::size_t)7);
 #  define COIN_MEMPOOL_SAVE_BLOCKHEADS 0
 #endif
 
+/* With threads (and gcc style atomics) each thread keeps a cache of free
+   entries for every pool, so most allocations take no lock.  Caches are
+   refilled from, and give back to, the shared pool COINUTILS_MEMPOOL_BATCH
+   entries at a time.  The shared free list is a lock-free stack of such
+   batches; the mutex is only taken to allocate a new block.
+*/
+#if defined(COINUTILS_PTHREADS) && defined(__GNUC__) && !defined(COIN_MEMPOOL_NO_THREAD_CACHE)
+#define COIN_MEMPOOL_THREAD_CACHE
+#endif
+#ifndef COINUTILS_MEMPOOL_BATCH
+#define COINUTILS_MEMPOOL_BATCH 32
+#endif
+
+/// Free entries of one pool held by one thread
+struct CoinMempoolCache {
+  char* first;
+  int number;
+};
+
 //#############################################################################
 
 class CoinMempool 
 {
 private:
 #if (COIN_MEMPOOL_SAVE_BLOCKHEADS == 1)
-   char** block_heads;
-   std::size_t block_num;
-   std::size_t max_block_num;
+   char** block_heads_;
+   std::size_t block_num_;
+   std::size_t max_block_num_;
 #endif
-#if defined(COINUTILS_PTHREADS) && (COINUTILS_PTHREAD == 1)
+#ifdef COINUTILS_PTHREADS
   pthread_mutex_t mutex_;
 #endif
   int last_block_size_;
   char* first_free_;
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+  /** Lock-free stack of batches - pointer to first entry of first batch
+      with a tag in the high bits against ABA.  Entries in a batch are
+      linked through their first word and batches through the second word
+      of their first entry. */
+  volatile CoinUInt64 batches_;
+#endif
   const std::size_t entry_size_;
 
 private:
@@ -69,22 +100,38 @@ private:
 
 private:
   char* allocate_new_block();
+  /// Remembers block so destructor can free it (if saving block heads)
+  void record_block(char* block);
   inline void lock_mutex() {
-#if defined(COINUTILS_PTHREADS) && (COINUTILS_PTHREAD == 1)
+#ifdef COINUTILS_PTHREADS
     pthread_mutex_lock(&mutex_);
 #endif
   }
   inline void unlock_mutex() {
-#if defined(COINUTILS_PTHREADS) && (COINUTILS_PTHREAD == 1)
+#ifdef COINUTILS_PTHREADS
     pthread_mutex_unlock(&mutex_);
 #endif
   }
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+  /// Pushes chain of entries as one batch
+  void push_batch(char* batch);
+  /// Pops a batch (NULL if none)
+  char* pop_batch();
+#endif
 
 public:
   CoinMempool(std::size_t size = 0);
   ~CoinMempool();
 
   char* alloc();
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+  void dealloc(char *p);
+  /** Takes up to COINUTILS_MEMPOOL_BATCH entries from the shared pool,
+      returns one and puts the rest in cache (which must be empty) */
+  char* refill(CoinMempoolCache& cache);
+  /// Gives all but keep entries in cache back to the shared pool
+  void drain(CoinMempoolCache& cache, int keep);
+#else
   inline void dealloc(char *p) 
   {
     char** pp = (char**)p;
@@ -93,6 +140,7 @@ public:
     first_free_ = p;
     unlock_mutex();
   }
+#endif
 };
 
 //#############################################################################
@@ -107,6 +155,10 @@ public:
     then malloc is used. In either case, the size of the allocated
     chunk is written into the first \c sizeof(void*) bytes and a
     pointer pointing afterwards is returned.
+
+    When built with thread caches, pooled chunks come from and go to a
+    cache belonging to the calling thread, which is given back to the
+    pools when the thread exits.
 */
 
 class CoinAlloc
@@ -114,6 +166,24 @@ class CoinAlloc
 private:
   CoinMempool* pool_;
   int maxpooled_;
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+  /// Caches of one thread (allocated with malloc as new may come here)
+  struct ThreadCache {
+    CoinAlloc* owner;
+    CoinMempoolCache cache[1];
+  };
+  pthread_key_t cacheKey_;
+  /// Creates caches for this thread
+  CoinMempoolCache* newThreadCache();
+  /// Gives caches back to pools (called at thread exit)
+  static void freeThreadCache(void* caches);
+  inline CoinMempoolCache* threadCache()
+  {
+    ThreadCache* caches =
+      static_cast<ThreadCache*>(pthread_getspecific(cacheKey_));
+    return caches ? caches->cache : newThreadCache();
+  }
+#endif
 public:
   CoinAlloc();
   ~CoinAlloc() {}
@@ -124,16 +194,29 @@ public:
       return std::malloc(n);
     }
     char *p = NULL;
+    // at least one byte so free entries have room for two links
     const std::size_t to_alloc =
-      ((n+COINUTILS_MEMPOOL_ALIGNMENT-1) & CoinAllocRoundMask) +
+      (((n ? n : 1)+COINUTILS_MEMPOOL_ALIGNMENT-1) & CoinAllocRoundMask) +
       COINUTILS_MEMPOOL_ALIGNMENT;
     CoinMempool* pool = NULL;
     if (maxpooled_ > 0 && to_alloc >= (size_t)maxpooled_) {
       p = static_cast<char*>(std::malloc(to_alloc));
       if (p == NULL) throw std::bad_alloc();
     } else {
-      pool = pool_ + (to_alloc >> CoinAllocPtrShift);
+      const std::size_t which = to_alloc >> CoinAllocPtrShift;
+      pool = pool_ + which;
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+      CoinMempoolCache& cache = threadCache()[which];
+      if (cache.first) {
+	p = cache.first;
+	cache.first = *((char**)p);
+	cache.number--;
+      } else {
+	p = pool->refill(cache);
+      }
+#else
       p = pool->alloc();
+#endif
     }
     *((CoinMempool**)p) = pool;
     return static_cast<void*>(p+COINUTILS_MEMPOOL_ALIGNMENT);
@@ -151,7 +234,15 @@ public:
       if (!pool) {
 	std::free(base);
       } else {
+#ifdef COIN_MEMPOOL_THREAD_CACHE
+	CoinMempoolCache& cache = threadCache()[pool - pool_];
+	*((char**)base) = cache.first;
+	cache.first = base;
+	if (++cache.number > 2*COINUTILS_MEMPOOL_BATCH)
+	  pool->drain(cache, COINUTILS_MEMPOOL_BATCH);
+#else
 	pool->dealloc(base);
+#endif
       }
     }
   }
@@ -0,0 +1,215 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinArena.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+//#############################################################################
+// All live arenas (so anyOwns can be answered)
+
+static CoinArena *coinFirstArena = NULL;
+static int coinNumberArenas = 0;
+#ifdef COINUTILS_PTHREADS
+static pthread_mutex_t coinArenaMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static inline void
+coinArenaLock()
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_lock(&coinArenaMutex);
+#endif
+}
+
+static inline void
+coinArenaUnlock()
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_unlock(&coinArenaMutex);
+#endif
+}
+
+// Largest chunk size when growing
+static const size_t coinMaximumChunk = 1 << 24;
+
+//#############################################################################
+
+CoinArena::CoinArena(size_t chunkSize)
+  : chunks_(NULL)
+  , large_(NULL)
+  , free_(NULL)
+  , end_(NULL)
+  , chunkSize_(chunkSize > 1024 ? chunkSize : 1024)
+  , nextChunkSize_(chunkSize_)
+  , bytesAllocated_(0)
+  , bytesReserved_(0)
+  , previous_(NULL)
+  , next_(NULL)
+{
+  registerArena();
+}
+
+CoinArena::~CoinArena()
+{
+  release(true);
+  unregisterArena();
+}
+
+void CoinArena::registerArena()
+{
+  coinArenaLock();
+  next_ = coinFirstArena;
+  if (coinFirstArena)
+    coinFirstArena->previous_ = this;
+  coinFirstArena = this;
+  coinNumberArenas++;
+  coinArenaUnlock();
+}
+
+void CoinArena::unregisterArena()
+{
+  coinArenaLock();
+  if (previous_)
+    previous_->next_ = next_;
+  else
+    coinFirstArena = next_;
+  if (next_)
+    next_->previous_ = previous_;
+  coinNumberArenas--;
+  coinArenaUnlock();
+}
+
+void CoinArena::newChunk(size_t bytes, size_t alignment)
+{
+  size_t size = nextChunkSize_;
+  if (size < bytes + alignment)
+    size = bytes + alignment;
+  if (nextChunkSize_ < coinMaximumChunk)
+    nextChunkSize_ *= 2;
+  Chunk *chunk = static_cast<Chunk *>(std::malloc(sizeof(Chunk) + size));
+  if (!chunk)
+    throw std::bad_alloc();
+  chunk->size = size;
+  chunk->next = chunks_;
+  chunks_ = chunk;
+  bytesReserved_ += size;
+  free_ = reinterpret_cast<char *>(chunk + 1);
+  end_ = free_ + size;
+}
+
+// Bytes to skip so p is aligned
+static inline size_t
+coinArenaPad(const char *p, size_t alignment)
+{
+  return (alignment - (reinterpret_cast<size_t>(p) & (alignment - 1)))
+    & (alignment - 1);
+}
+
+void *
+CoinArena::allocate(size_t bytes, size_t alignment)
+{
+  assert(alignment && alignment <= 64 && !(alignment & (alignment - 1)));
+  if (!bytes)
+    bytes = 1;
+  bytesAllocated_ += bytes;
+  size_t offset = coinArenaPad(free_, alignment);
+  if (free_ && offset + bytes <= static_cast<size_t>(end_ - free_)) {
+    char *p = free_ + offset;
+    free_ = p + bytes;
+    return p;
+  }
+  if (4 * bytes > chunkSize_) {
+    // own chunk so the current one is not wasted
+    size_t size = bytes + alignment;
+    Chunk *chunk = static_cast<Chunk *>(std::malloc(sizeof(Chunk) + size));
+    if (!chunk)
+      throw std::bad_alloc();
+    chunk->size = size;
+    chunk->next = large_;
+    large_ = chunk;
+    bytesReserved_ += size;
+    char *data = reinterpret_cast<char *>(chunk + 1);
+    return data + coinArenaPad(data, alignment);
+  }
+  newChunk(bytes, alignment);
+  char *p = free_ + coinArenaPad(free_, alignment);
+  free_ = p + bytes;
+  return p;
+}
+
+char *
+CoinArena::strdup(const char *name)
+{
+  if (!name)
+    return NULL;
+  size_t length = strlen(name) + 1;
+  char *copy = static_cast<char *>(allocate(length, 1));
+  memcpy(copy, name, length);
+  return copy;
+}
+
+void CoinArena::release(bool freeAll)
+{
+  while (large_) {
+    Chunk *next = large_->next;
+    std::free(large_);
+    large_ = next;
+  }
+  // keep the newest (largest) chunk for reuse
+  Chunk *keep = freeAll ? NULL : chunks_;
+  Chunk *chunk = keep ? chunks_->next : chunks_;
+  while (chunk) {
+    Chunk *next = chunk->next;
+    std::free(chunk);
+    chunk = next;
+  }
+  chunks_ = keep;
+  bytesAllocated_ = 0;
+  bytesReserved_ = 0;
+  free_ = NULL;
+  end_ = NULL;
+  if (keep) {
+    keep->next = NULL;
+    bytesReserved_ = keep->size;
+    free_ = reinterpret_cast<char *>(keep + 1);
+    end_ = free_ + keep->size;
+  }
+}
+
+bool CoinArena::owns(const void *p) const
+{
+  const char *q = static_cast<const char *>(p);
+  for (int which = 0; which < 2; which++) {
+    const Chunk *chunk = which ? large_ : chunks_;
+    for (; chunk; chunk = chunk->next) {
+      const char *data = reinterpret_cast<const char *>(chunk + 1);
+      if (q >= data && q < data + chunk->size)
+        return true;
+    }
+  }
+  return false;
+}
+
+bool CoinArena::anyOwns(const void *p)
+{
+  if (!p || !coinNumberArenas)
+    return false;
+  bool found = false;
+  coinArenaLock();
+  for (const CoinArena *arena = coinFirstArena; arena && !found;
+       arena = arena->next_)
+    found = arena->owns(p);
+  coinArenaUnlock();
+  return found;
+}
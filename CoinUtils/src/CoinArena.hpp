@@ -0,0 +1,123 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinArena_H
+#define CoinArena_H
+
+#include <cstddef>
+#include <new>
+
+/** Bump allocator for many small arrays which are all freed together.
+
+    Memory comes from chunks (malloc'ed, the first chunkSize bytes and
+    each one after twice the last, up to 16MB).  allocate just moves a pointer,
+    there is no per allocation free, and release() gives all memory back
+    at once.  Requests bigger than a quarter of a chunk get their own chunk
+    so they do not waste the current one.
+
+    Code which frees arrays which may or may not have come from an arena
+    (for example presolve actions, see deleteAction) can ask
+    CoinArena::anyOwns; all live arenas are known for this.
+
+    Arenas are not thread safe - use one per thread (one per presolve run
+    or model build).
+*/
+class CoinArena {
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor - first chunk is allocated on first use
+  CoinArena(size_t chunkSize = 65536);
+  /// Destructor - frees all memory
+  ~CoinArena();
+  //@}
+
+  /**@name Allocation */
+  //@{
+  /// Returns bytes aligned to alignment (a power of 2 up to 64)
+  void *allocate(size_t bytes, size_t alignment = 16);
+  /// Array of n T (default constructed) - T should not need a destructor
+  template <class T>
+  inline T *allocateArray(int n)
+  {
+    T *array = static_cast<T *>(allocate(n * sizeof(T)));
+    for (int i = 0; i < n; i++)
+      new (array + i) T;
+    return array;
+  }
+  /// Copy of array of n T (NULL if array NULL)
+  template <class T>
+  inline T *copyOfArray(const T *array, int n)
+  {
+    if (!array)
+      return NULL;
+    T *copy = allocateArray<T>(n);
+    for (int i = 0; i < n; i++)
+      copy[i] = array[i];
+    return copy;
+  }
+  /// Copy of string (NULL if name NULL)
+  char *strdup(const char *name);
+  /** Frees everything allocated.  The newest (largest) chunk is kept for
+      reuse unless freeAll is true */
+  void release(bool freeAll = false);
+  //@}
+
+  /**@name Queries */
+  //@{
+  /// True if p was allocated from this arena
+  bool owns(const void *p) const;
+  /// True if p was allocated from any live arena
+  static bool anyOwns(const void *p);
+  /// Bytes handed out since construction or release
+  inline size_t bytesAllocated() const
+  {
+    return bytesAllocated_;
+  }
+  /// Bytes held in chunks
+  inline size_t bytesReserved() const
+  {
+    return bytesReserved_;
+  }
+  //@}
+
+private:
+  /// Chunk header (data follows)
+  struct Chunk {
+    Chunk *next;
+    size_t size;
+  };
+  CoinArena(const CoinArena &);
+  CoinArena &operator=(const CoinArena &);
+  /// Gets a chunk with room for bytes (and alignment) and makes it current
+  void newChunk(size_t bytes, size_t alignment);
+  /// Links arena into list of live arenas
+  void registerArena();
+  /// Unlinks arena from list of live arenas
+  void unregisterArena();
+
+  /// Chunks (current first)
+  Chunk *chunks_;
+  /// Chunks each holding one large request
+  Chunk *large_;
+  /// Next free byte in current chunk
+  char *free_;
+  /// End of current chunk
+  char *end_;
+  /// Minimum chunk size
+  size_t chunkSize_;
+  /// Size of next chunk
+  size_t nextChunkSize_;
+  /// Bytes handed out
+  size_t bytesAllocated_;
+  /// Bytes in chunks
+  size_t bytesReserved_;
+  /// Previous live arena
+  CoinArena *previous_;
+  /// Next live arena
+  CoinArena *next_;
+};
+
+#endif
@@ -0,0 +1,208 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinBitVector_H
+#define CoinBitVector_H
+
+#include <cstdio>
+#include <string>
+
+#include "CoinTypes.hpp"
+
+//#############################################################################
+
+/// Number of bits set in x
+inline int CoinBitCount(CoinUInt64 x)
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll(x);
+#else
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/// Number of bits set in n words
+inline int CoinBitCount(const CoinUInt64 *words, int n)
+{
+  int count = 0;
+  for (int i = 0; i < n; i++)
+    count += CoinBitCount(words[i]);
+  return count;
+}
+
+/** Compare n words as one number, most significant word last.
+    Returns -1, 0 or 1. */
+inline int CoinBitCompare(const CoinUInt64 *a, const CoinUInt64 *b, int n)
+{
+  for (int i = n - 1; i >= 0; i--) {
+    if (a[i] != b[i])
+      return a[i] < b[i] ? -1 : 1;
+  }
+  return 0;
+}
+
+//#############################################################################
+
+/** Bit vector of fixed length NBITS (a multiple of 64).
+
+    The bits are held in 64-bit words, so the bulk operations and the
+    comparisons work a word at a time. For the sizes used (a few words)
+    the loops have constant trip counts and the compiler unrolls or
+    vectorises them. Ordering is as for an unsigned number with bit 0
+    least significant.
+
+    BitVector128, used for the preferred child encoding of CoinTreeNode,
+    is CoinBitVector<128>. The word level functions above (CoinBitCount,
+    CoinBitCompare) serve masks of any length.
+*/
+template <int NBITS>
+class CoinBitVector {
+public:
+  enum { numberWords = NBITS / 64 };
+
+private:
+  CoinUInt64 words_[numberWords];
+
+public:
+  /**@name Constructors */
+  //@{
+  /// All bits clear
+  CoinBitVector()
+  {
+    clear();
+  }
+  /// From NBITS/32 unsigned ints, least significant first
+  CoinBitVector(const unsigned int *bits)
+  {
+    set(bits);
+  }
+  //@}
+
+  /**@name Bits */
+  //@{
+  /// Set from NBITS/32 unsigned ints, least significant first
+  inline void set(const unsigned int *bits)
+  {
+    for (int i = 0; i < numberWords; i++)
+      words_[i] = static_cast<CoinUInt64>(bits[2 * i]) | (static_cast<CoinUInt64>(bits[2 * i + 1]) << 32);
+  }
+  inline void setBit(int i)
+  {
+    words_[i >> 6] |= static_cast<CoinUInt64>(1) << (i & 63);
+  }
+  inline void clearBit(int i)
+  {
+    words_[i >> 6] &= ~(static_cast<CoinUInt64>(1) << (i & 63));
+  }
+  inline bool testBit(int i) const
+  {
+    return (words_[i >> 6] >> (i & 63)) & 1;
+  }
+  /// Clear all bits
+  inline void clear()
+  {
+    for (int i = 0; i < numberWords; i++)
+      words_[i] = 0;
+  }
+  /// Number of bits set
+  inline int count() const
+  {
+    return CoinBitCount(words_, numberWords);
+  }
+  /// True if any bit is set
+  inline bool any() const
+  {
+    CoinUInt64 x = 0;
+    for (int i = 0; i < numberWords; i++)
+      x |= words_[i];
+    return x != 0;
+  }
+  /// Word i (bits 64i to 64i+63)
+  inline CoinUInt64 word(int i) const
+  {
+    return words_[i];
+  }
+  /// Hexadecimal, most significant first
+  std::string str() const
+  {
+    char output[16 * numberWords + 1];
+    for (int i = 0; i < numberWords; i++) {
+      const CoinUInt64 w = words_[numberWords - 1 - i];
+      sprintf(output + 16 * i, "%08X%08X",
+        static_cast<unsigned int>(w >> 32), static_cast<unsigned int>(w));
+    }
+    return output;
+  }
+  //@}
+
+  /**@name Bulk operations */
+  //@{
+  inline CoinBitVector &operator&=(const CoinBitVector &rhs)
+  {
+    for (int i = 0; i < numberWords; i++)
+      words_[i] &= rhs.words_[i];
+    return *this;
+  }
+  inline CoinBitVector &operator|=(const CoinBitVector &rhs)
+  {
+    for (int i = 0; i < numberWords; i++)
+      words_[i] |= rhs.words_[i];
+    return *this;
+  }
+  inline CoinBitVector &operator^=(const CoinBitVector &rhs)
+  {
+    for (int i = 0; i < numberWords; i++)
+      words_[i] ^= rhs.words_[i];
+    return *this;
+  }
+  inline CoinBitVector operator~() const
+  {
+    CoinBitVector result(*this);
+    for (int i = 0; i < numberWords; i++)
+      result.words_[i] = ~words_[i];
+    return result;
+  }
+  //@}
+
+  /**@name Comparisons */
+  //@{
+  friend inline bool operator<(const CoinBitVector &b0, const CoinBitVector &b1)
+  {
+    return CoinBitCompare(b0.words_, b1.words_, numberWords) < 0;
+  }
+  friend inline bool operator==(const CoinBitVector &b0, const CoinBitVector &b1)
+  {
+    CoinUInt64 x = 0;
+    for (int i = 0; i < numberWords; i++)
+      x |= b0.words_[i] ^ b1.words_[i];
+    return x == 0;
+  }
+  friend inline bool operator!=(const CoinBitVector &b0, const CoinBitVector &b1)
+  {
+    return !(b0 == b1);
+  }
+  //@}
+};
+
+template <int NBITS>
+inline CoinBitVector<NBITS> operator&(CoinBitVector<NBITS> b0, const CoinBitVector<NBITS> &b1)
+{
+  return b0 &= b1;
+}
+template <int NBITS>
+inline CoinBitVector<NBITS> operator|(CoinBitVector<NBITS> b0, const CoinBitVector<NBITS> &b1)
+{
+  return b0 |= b1;
+}
+template <int NBITS>
+inline CoinBitVector<NBITS> operator^(CoinBitVector<NBITS> b0, const CoinBitVector<NBITS> &b1)
+{
+  return b0 ^= b1;
+}
+
+#endif
@@ -16,25 +16,7 @@
 
 #include "CoinPragma.hpp"
 #include "CoinHelperFunctions.hpp"
-
-/*
-  Format of each item is a bit sleazy.
-  First we have pointer to next item
-  Then we have two ints giving item number and number of elements
-  Then we have three double for objective lower and upper
-  Then we have elements
-  Then indices
-*/
-struct buildFormat {
-  buildFormat * next;
-  int itemNumber;
-  int numberElements;
-  double objective;
-  double lower;
-  double upper;
-  double restDouble[1]; 
-  int restInt[1]; // just to make correct size 
-} ;
+#include "CoinPackedMatrix.hpp"
 
 //#############################################################################
 // Constructors / Destructor / Assignment
@@ -47,9 +29,15 @@ CoinBuild::CoinBuild ()
   : numberItems_(0),
     numberOther_(0),
     numberElements_(0),
-    currentItem_(NULL),
-    firstItem_(NULL),
-    lastItem_(NULL),
+    currentItem_(-1),
+    maximumItems_(0),
+    maximumElements_(0),
+    start_(NULL),
+    indices_(NULL),
+    elements_(NULL),
+    lower_(NULL),
+    upper_(NULL),
+    objective_(NULL),
     type_(-1)
 {
 }
@@ -60,9 +48,15 @@ CoinBuild::CoinBuild (int type)
   : numberItems_(0),
     numberOther_(0),
     numberElements_(0),
-    currentItem_(NULL),
-    firstItem_(NULL),
-    lastItem_(NULL),
+    currentItem_(-1),
+    maximumItems_(0),
+    maximumElements_(0),
+    start_(NULL),
+    indices_(NULL),
+    elements_(NULL),
+    lower_(NULL),
+    upper_(NULL),
+    objective_(NULL),
     type_(type)
 {
   if (type<0||type>1)
@@ -73,40 +67,8 @@ CoinBuild::CoinBuild (int type)
 // Copy constructor 
 //-------------------------------------------------------------------
 CoinBuild::CoinBuild (const CoinBuild & rhs) 
-  : numberItems_(rhs.numberItems_),
-    numberOther_(rhs.numberOther_),
-    numberElements_(rhs.numberElements_),
-    type_(rhs.type_)
 {
-  if (numberItems_) {
-    firstItem_=NULL;
-    buildFormat * lastItem = NULL;
-    buildFormat * currentItem = reinterpret_cast<buildFormat *> ( rhs.firstItem_);
-    for (int iItem=0;iItem<numberItems_;iItem++) {
-      buildFormat * item = currentItem;
-      assert (item);
-      int numberElements = item->numberElements;
-      int length = ( CoinSizeofAsInt(buildFormat) + (numberElements-1) *
-                     (CoinSizeofAsInt(double)+CoinSizeofAsInt(int)) );
-      int doubles = (length + CoinSizeofAsInt(double)-1)/CoinSizeofAsInt(double);
-      double * copyOfItem = new double [doubles];
-      memcpy(copyOfItem,item,length);
-      if (!firstItem_) {
-        firstItem_ = copyOfItem;
-      } else {
-        // update pointer
-        lastItem->next = reinterpret_cast<buildFormat *> ( copyOfItem);
-      }
-      currentItem = currentItem->next; // on to next
-      lastItem = reinterpret_cast<buildFormat *> ( copyOfItem);
-    }
-    currentItem_=firstItem_;
-    lastItem_=reinterpret_cast<double *> ( lastItem);
-  } else {
-    currentItem_=NULL;
-    firstItem_=NULL;
-    lastItem_=NULL;
-  }
+  gutsOfCopy(rhs);
 }
 
 //-------------------------------------------------------------------
@@ -114,12 +76,7 @@ CoinBuild::CoinBuild (const CoinBuild & rhs)
 //-------------------------------------------------------------------
 CoinBuild::~CoinBuild ()
 {
-  buildFormat * item = reinterpret_cast<buildFormat *> ( firstItem_);
-  for (int iItem=0;iItem<numberItems_;iItem++) {
-    double * array = reinterpret_cast<double *> ( item);
-    item = item->next;
-    delete [] array;
-  }
+  gutsOfDelete();
 }
 
 //----------------------------------------------------------------
@@ -129,47 +86,130 @@ CoinBuild &
 CoinBuild::operator=(const CoinBuild& rhs)
 {
   if (this != &rhs) {
-    buildFormat * item = reinterpret_cast<buildFormat *> ( firstItem_);
-    for (int iItem=0;iItem<numberItems_;iItem++) {
-      double * array = reinterpret_cast<double *> ( item);
-      item = item->next;
-      delete [] array;
-    }
-    numberItems_=rhs.numberItems_;
-    numberOther_=rhs.numberOther_;
-    numberElements_=rhs.numberElements_;
-    type_=rhs.type_;
-    if (numberItems_) {
-      firstItem_=NULL;
-      buildFormat * lastItem = NULL;
-      buildFormat * currentItem = reinterpret_cast<buildFormat *> ( rhs.firstItem_);
-      for (int iItem=0;iItem<numberItems_;iItem++) {
-        buildFormat * item = currentItem;
-        assert (item);
-        int numberElements = item->numberElements;
-        int length = CoinSizeofAsInt(buildFormat)+(numberElements-1)*(CoinSizeofAsInt(double)+CoinSizeofAsInt(int));
-        int doubles = (length + CoinSizeofAsInt(double)-1)/CoinSizeofAsInt(double);
-        double * copyOfItem = new double [doubles];
-        memcpy(copyOfItem,item,length);
-        if (!firstItem_) {
-          firstItem_ = copyOfItem;
-        } else {
-          // update pointer
-          lastItem->next = reinterpret_cast<buildFormat *> ( copyOfItem);
-        }
-        currentItem = currentItem->next; // on to next
-        lastItem = reinterpret_cast<buildFormat *> ( copyOfItem);
-      }
-      currentItem_=firstItem_;
-      lastItem_=reinterpret_cast<double *> ( lastItem);
-    } else {
-      currentItem_=NULL;
-      firstItem_=NULL;
-      lastItem_=NULL;
-    }
+    gutsOfDelete();
+    gutsOfCopy(rhs);
   }
   return *this;
 }
+// Frees all arrays
+void
+CoinBuild::gutsOfDelete()
+{
+  delete [] start_;
+  delete [] indices_;
+  delete [] elements_;
+  delete [] lower_;
+  delete [] upper_;
+  delete [] objective_;
+  start_=NULL;
+  indices_=NULL;
+  elements_=NULL;
+  lower_=NULL;
+  upper_=NULL;
+  objective_=NULL;
+  maximumItems_=0;
+  maximumElements_=0;
+}
+// Copies rhs (arrays just big enough)
+void
+CoinBuild::gutsOfCopy(const CoinBuild & rhs)
+{
+  numberItems_=rhs.numberItems_;
+  numberOther_=rhs.numberOther_;
+  numberElements_=rhs.numberElements_;
+  currentItem_=numberItems_ ? 0 : -1;
+  type_=rhs.type_;
+  maximumItems_=numberItems_;
+  maximumElements_=numberElements_;
+  start_ = new CoinBigIndex [maximumItems_+1];
+  if (numberItems_)
+    CoinMemcpyN(rhs.start_,numberItems_+1,start_);
+  else
+    start_[0]=0;
+  indices_ = CoinCopyOfArray(rhs.indices_,numberElements_);
+  elements_ = CoinCopyOfArray(rhs.elements_,numberElements_);
+  lower_ = CoinCopyOfArray(rhs.lower_,numberItems_);
+  upper_ = CoinCopyOfArray(rhs.upper_,numberItems_);
+  objective_ = CoinCopyOfArray(rhs.objective_,numberItems_);
+}
+// Makes room for at least numberItems items and numberElements elements
+void
+CoinBuild::resize(int numberItems, CoinBigIndex numberElements)
+{
+  if (numberItems>maximumItems_||!start_) {
+    maximumItems_ = CoinMax(numberItems,maximumItems_);
+    CoinBigIndex * start = new CoinBigIndex [maximumItems_+1];
+    if (start_)
+      CoinMemcpyN(start_,numberItems_+1,start);
+    else
+      start[0]=0;
+    delete [] start_;
+    start_ = start;
+    double * temp = CoinCopyOfArrayPartial(lower_,maximumItems_,numberItems_);
+    delete [] lower_;
+    lower_ = temp;
+    temp = CoinCopyOfArrayPartial(upper_,maximumItems_,numberItems_);
+    delete [] upper_;
+    upper_ = temp;
+    temp = CoinCopyOfArrayPartial(objective_,maximumItems_,numberItems_);
+    delete [] objective_;
+    objective_ = temp;
+  }
+  if (numberElements>maximumElements_) {
+    maximumElements_ = numberElements;
+    int * indices = CoinCopyOfArrayPartial(indices_,maximumElements_,
+					   numberElements_);
+    delete [] indices_;
+    indices_ = indices;
+    double * elements = CoinCopyOfArrayPartial(elements_,maximumElements_,
+						numberElements_);
+    delete [] elements_;
+    elements_ = elements;
+  }
+}
+// Removes all items but keeps space
+void
+CoinBuild::clear(bool keepType)
+{
+  numberItems_=0;
+  numberOther_=0;
+  numberElements_=0;
+  currentItem_=-1;
+  if (start_)
+    start_[0]=0;
+  if (!keepType)
+    type_=-1;
+}
+// Makes room for numberItems items with numberElements elements
+void
+CoinBuild::reserve(int numberItems, CoinBigIndex numberElements)
+{
+  resize(numberItems,numberElements);
+}
+// Moves elements into matrix without copying
+void
+CoinBuild::moveToMatrix(CoinPackedMatrix & matrix, double * lower,
+			double * upper, double * objective)
+{
+  if (lower)
+    CoinMemcpyN(lower_,numberItems_,lower);
+  if (upper)
+    CoinMemcpyN(upper_,numberItems_,upper);
+  if (objective)
+    CoinMemcpyN(objective_,numberItems_,objective);
+  // matrix wants some space
+  resize(CoinMax(maximumItems_,1),CoinMax(maximumElements_,
+					  static_cast<CoinBigIndex>(1)));
+  int * length = NULL;
+  // matrix keeps extra space
+  matrix.assignMatrix(type_!=0,numberOther_,numberItems_,numberElements_,
+		      elements_,indices_,start_,length,maximumItems_,
+		      maximumElements_);
+  // item arrays kept for reuse
+  maximumElements_=0;
+  start_ = new CoinBigIndex [maximumItems_+1];
+  clear();
+}
 // add a row
 void 
 CoinBuild::addRow(int numberInRow, const int * columns,
@@ -201,7 +241,6 @@ CoinBuild::row(int whichRow, double & rowLower, double & rowUpper,
   return currentItem(rowLower,rowUpper,dummyObjective,indices,elements);
 }
 /*  Returns number of elements in current row and information in row
-    Used as rows may be stored in a chain
 */
 int 
 CoinBuild::currentRow(double & rowLower, double & rowUpper,
@@ -253,7 +292,6 @@ CoinBuild::column(int whichColumn,
   return currentItem(columnLower,columnUpper,objectiveValue,indices,elements);
 }
 /*  Returns number of elements in current column and information in column
-    Used as columns may be stored in a chain
 */
 int 
 CoinBuild::currentColumn( double & columnLower, double & columnUpper, double & objectiveValue, 
@@ -283,30 +321,20 @@ CoinBuild::addItem(int numberInItem, const int * indices,
                   double itemLower, 
                   double itemUpper, double objectiveValue)
 {
-  buildFormat * lastItem = reinterpret_cast<buildFormat *> ( lastItem_);
-  int length = CoinSizeofAsInt(buildFormat)+(numberInItem-1)*(CoinSizeofAsInt(double)+CoinSizeofAsInt(int));
-  int doubles = (length + CoinSizeofAsInt(double)-1)/CoinSizeofAsInt(double);
-  double * newItem = new double [doubles];
-  if (!firstItem_) {
-    firstItem_ = newItem;
-  } else {
-    // update pointer
-    lastItem->next = reinterpret_cast<buildFormat *> ( newItem);
+  if (numberItems_==maximumItems_||
+      numberElements_+numberInItem>maximumElements_) {
+    // grow geometrically
+    int numberItems = maximumItems_;
+    if (numberItems_==maximumItems_)
+      numberItems = 2*maximumItems_+100;
+    CoinBigIndex numberElements = maximumElements_;
+    if (numberElements_+numberInItem>maximumElements_)
+      numberElements = CoinMax(numberElements_+numberInItem,
+			       2*maximumElements_+1000);
+    resize(numberItems,numberElements);
   }
-  lastItem_=newItem;
-  currentItem_=newItem;
-  // now fill in
-  buildFormat * item = reinterpret_cast<buildFormat *> ( newItem);
-  double * els = &item->restDouble[0];
-  int * cols = reinterpret_cast<int *> (els+numberInItem);
-  item->next=NULL;
-  item->itemNumber=numberItems_;
-  numberItems_++;
-  item->numberElements=numberInItem;
-  numberElements_ += numberInItem;
-  item->objective=objectiveValue;
-  item->lower=itemLower;
-  item->upper=itemUpper;
+  int * COIN_RESTRICT cols = indices_+numberElements_;
+  double * COIN_RESTRICT els = elements_+numberElements_;
   for (int k=0;k<numberInItem;k++) {
     int iColumn = indices[k];
     assert (iColumn>=0);
@@ -319,6 +347,13 @@ CoinBuild::addItem(int numberInItem, const int * indices,
     els[k]=elements[k];
     cols[k]=iColumn;
   }
+  lower_[numberItems_]=itemLower;
+  upper_[numberItems_]=itemUpper;
+  objective_[numberItems_]=objectiveValue;
+  currentItem_=numberItems_;
+  numberItems_++;
+  numberElements_ += numberInItem;
+  start_[numberItems_]=numberElements_;
   return;
 }
 /*  Returns number of elements in a item and information in item
@@ -332,22 +367,20 @@ CoinBuild::item(int whichItem,
   return currentItem(itemLower,itemUpper,objectiveValue,indices,elements);
 }
 /*  Returns number of elements in current item and information in item
-    Used as items may be stored in a chain
 */
 int 
 CoinBuild::currentItem(double & itemLower, double & itemUpper,
                        double & objectiveValue, 
                        const int * & indices, const double * & elements) const
 {
-  buildFormat * item = reinterpret_cast<buildFormat *> ( currentItem_);
-  if (item) {
-    int numberElements = item->numberElements;
-    elements = &item->restDouble[0];
-    indices = reinterpret_cast<const int *> (elements+numberElements);
-    objectiveValue=item->objective;
-    itemLower = item->lower;
-    itemUpper=item->upper;
-    return numberElements;
+  if (currentItem_>=0) {
+    CoinBigIndex start = start_[currentItem_];
+    elements = elements_+start;
+    indices = indices_+start;
+    objectiveValue=objective_[currentItem_];
+    itemLower = lower_[currentItem_];
+    itemUpper = upper_[currentItem_];
+    return static_cast<int>(start_[currentItem_+1]-start);
   } else {
     return -1;
   }
@@ -362,29 +395,12 @@ CoinBuild::setCurrentItem(int whichItem)
 void 
 CoinBuild::setMutableCurrent(int whichItem) const
 {
-  if (whichItem>=0&&whichItem<numberItems_) {
-    int nSkip = whichItem-1;
-    buildFormat * item = reinterpret_cast<buildFormat *> ( firstItem_);
-    // if further on then we can start from where we are
-    buildFormat * current = reinterpret_cast<buildFormat *> ( currentItem_);
-    if (current->itemNumber<=whichItem) {
-      item=current;
-      nSkip = whichItem-current->itemNumber;
-    }
-    for (int iItem=0;iItem<nSkip;iItem++) {
-      item = item->next;
-    }
-    assert (whichItem==item->itemNumber);
-    currentItem_ = reinterpret_cast<double *> ( item);
-  }
+  if (whichItem>=0&&whichItem<numberItems_) 
+    currentItem_ = whichItem;
 }
 // Returns current item number
 int 
 CoinBuild::currentItem() const
 {
-  buildFormat * item = reinterpret_cast<buildFormat *> ( currentItem_);
-  if (item)
-    return item->itemNumber;
-  else
-    return -1;
+  return currentItem_;
 }
@@ -7,18 +7,26 @@
 #define CoinBuild_H
 
 
+#include <cstddef>
+
 #include "CoinPragma.hpp"
 #include "CoinTypes.hpp"
 #include "CoinFinite.hpp"
 
+class CoinPackedMatrix;
+
 
 /** 
     In many cases it is natural to build a model by adding one row at a time.  In Coin this
     is inefficient so this class gives some help.  An instance of CoinBuild can be built up
     more efficiently and then added to the Clp/OsiModel in one go.
 
-    It may be more efficient to have fewer arrays and re-allocate them but this should
-    give a large gain over addRow.
+    Items (rows or columns) are stored one after another in large arrays
+    which grow geometrically, so adding an item is normally just copying
+    it.  clear() keeps the space so one CoinBuild can be reused (e.g. for
+    each round of cuts) and moveToMatrix hands the arrays to a
+    CoinPackedMatrix without copying.  Pointers returned by row or column
+    are only valid until the next item is added.
 
     I have now extended it to columns.
 
@@ -58,7 +66,6 @@ public:
   int row(int whichRow, double & rowLower, double & rowUpper,
           const int * & indices, const double * & elements) const;
   /**  Returns number of elements in current row and information in row
-       Used as rows may be stored in a chain
    */
   int currentRow(double & rowLower, double & rowUpper,
           const int * & indices, const double * & elements) const;
@@ -72,7 +79,6 @@ public:
              double & columnLower, double & columnUpper,double & objectiveValue,
              const int * & indices, const double * & elements) const;
   /**  Returns number of elements in current column and information in column
-       Used as columns may be stored in a chain
    */
   int currentColumn( double & columnLower, double & columnUpper,double & objectiveValue,
           const int * & indices, const double * & elements) const;
@@ -83,6 +89,17 @@ public:
   /// Returns type
   inline int type() const
   { return type_;}
+  /** Removes all items but keeps space.  Type is kept unless
+      keepType false (when it becomes unset) */
+  void clear(bool keepType = true);
+  /// Makes room for numberItems items with numberElements elements
+  void reserve(int numberItems, CoinBigIndex numberElements);
+  /** Moves elements into matrix without copying - row ordered if rows
+      were added, column ordered if columns.  If lower, upper or objective
+      given they are filled in for each item first.  CoinBuild is then
+      empty (as after clear() but with no space for elements) */
+  void moveToMatrix(CoinPackedMatrix & matrix, double * lower = NULL,
+		    double * upper = NULL, double * objective = NULL);
    //@}
 
 
@@ -104,6 +121,12 @@ public:
    CoinBuild& operator=(const CoinBuild&);
    //@}
 private:
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs (arrays just big enough)
+  void gutsOfCopy(const CoinBuild & rhs);
+  /// Makes room for at least numberItems items and numberElements elements
+  void resize(int numberItems, CoinBigIndex numberElements);
   /// Set current 
   void setMutableCurrent(int which) const;
    /// add a item
@@ -117,7 +140,6 @@ private:
              double & itemLower, double & itemUpper,double & objectiveValue,
              const int * & indices, const double * & elements) const;
   /**  Returns number of elements in current item and information in item
-       Used as items may be stored in a chain
    */
   int currentItem( double & itemLower, double & itemUpper,double & objectiveValue,
           const int * & indices, const double * & elements) const;
@@ -135,12 +157,24 @@ private:
   int numberOther_;
   /// Current number of elements
   CoinBigIndex numberElements_;
-  /// Current item pointer
-  mutable double * currentItem_;
-  /// First item pointer
-  double * firstItem_;
-  /// Last item pointer
-  double * lastItem_;
+  /// Current item (-1 if none)
+  mutable int currentItem_;
+  /// Space for items
+  int maximumItems_;
+  /// Space for elements
+  CoinBigIndex maximumElements_;
+  /// Start of each item in indices_ and elements_ (numberItems_+1)
+  CoinBigIndex * start_;
+  /// Indices of all items
+  int * indices_;
+  /// Elements of all items
+  double * elements_;
+  /// Lower bound of each item
+  double * lower_;
+  /// Upper bound of each item
+  double * upper_;
+  /// Objective of each item
+  double * objective_;
   /// Type of build - 0 for row, 1 for column, -1 unset
   int type_;
    //@}
@@ -0,0 +1,553 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinSort.hpp"
+#include "CoinCliqueTable.hpp"
+#include "CoinThreadPool.hpp"
+
+// Cliques up to this size have their pairs hashed
+#define COIN_CLIQUE_SMALL 8
+
+//#############################################################################
+// Mixes 64 bits (splitmix64 finalizer)
+static inline CoinUInt64
+coinCliqueMix(CoinUInt64 value)
+{
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+// Key of a pair of literals (never all ones)
+static inline CoinUInt64
+coinCliqueKey(int literal1, int literal2)
+{
+  if (literal1 > literal2)
+    std::swap(literal1, literal2);
+  return (static_cast<CoinUInt64>(literal1) << 32) |
+    static_cast<CoinUInt64>(literal2);
+}
+
+// Work for one thread
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  const double * columnLower;
+  const double * columnUpper;
+  const char * integerType;
+  const double * rowLower;
+  const double * rowUpper;
+  int minimumSize;
+  int first;
+  int last;
+  // cliques found (sizes, sorted literals and rows)
+  std::vector<int> * size;
+  std::vector<int> * member;
+  std::vector<int> * row;
+} CoinCliqueThread;
+
+// Adds clique of literals (sorting them)
+static void
+coinCliqueAdd(CoinCliqueThread * thread, int number, int * literals,
+	      int iRow)
+{
+  std::sort(literals, literals + number);
+  thread->size->push_back(number);
+  thread->member->insert(thread->member->end(), literals, literals + number);
+  thread->row->push_back(iRow);
+}
+
+/* Cliques from one side of a row - sum sign*element*x <= rhs.  Binaries
+   are complemented so all weights are positive; everything else goes to
+   its best bound.  Two literals conflict if their weights add up to more
+   than what is left of rhs; with weights in decreasing order the largest
+   ones which do so pairwise form a clique, and each smaller literal which
+   conflicts with the largest gives another with a leading part of them */
+static void
+coinCliqueRowSide(CoinCliqueThread * thread, int iRow, double sign,
+		  double rhs, double * weight, int * literal, int * clique)
+{
+  const CoinBigIndex start = thread->start[iRow];
+  const int length = thread->length[iRow];
+  const int * index = thread->index + start;
+  const double * element = thread->element + start;
+  int numberBinary = 0;
+  for (int j = 0; j < length; j++) {
+    const int iColumn = index[j];
+    const double value = sign * element[j];
+    if (!value)
+      continue;
+    const double lower = thread->columnLower[iColumn];
+    const double upper = thread->columnUpper[iColumn];
+    if (thread->integerType[iColumn] && lower == 0.0 && upper == 1.0) {
+      if (value > 0.0) {
+	literal[numberBinary] = CoinCliqueTable::literal(iColumn);
+	weight[numberBinary++] = -value;
+      } else {
+	literal[numberBinary] = CoinCliqueTable::literal(iColumn, true);
+	weight[numberBinary++] = value;
+	rhs -= value;
+      }
+    } else if (value > 0.0) {
+      if (lower == -COIN_DBL_MAX)
+	return;
+      rhs -= value * lower;
+    } else {
+      if (upper == COIN_DBL_MAX)
+	return;
+      rhs -= value * upper;
+    }
+  }
+  const double tolerance = 1.0e-9 * (1.0 + fabs(rhs));
+  if (numberBinary < 2 || rhs < -tolerance)
+    return;
+  // weights negated so sort gives decreasing order
+  CoinSort_2(weight, weight + numberBinary, literal);
+  const double cutoff = -rhs - tolerance;
+  if (weight[0] + weight[1] >= cutoff)
+    return;
+  int last = 1;
+  while (last + 1 < numberBinary && weight[last] + weight[last+1] < cutoff)
+    last++;
+  if (last + 1 >= thread->minimumSize) {
+    CoinMemcpyN(literal, last + 1, clique);
+    coinCliqueAdd(thread, last + 1, clique, iRow);
+  }
+  // smaller literals (limited so knapsacks do not give too much)
+  int numberLeft = 4 * length;
+  for (int k = last + 1; k < numberBinary; k++) {
+    if (weight[0] + weight[k] >= cutoff)
+      break;
+    int number = 1;
+    while (number < last && weight[number] + weight[k] < cutoff)
+      number++;
+    if (number + 1 < thread->minimumSize)
+      continue;
+    numberLeft -= number + 1;
+    if (numberLeft < 0)
+      break;
+    CoinMemcpyN(literal, number, clique);
+    clique[number] = literal[k];
+    coinCliqueAdd(thread, number + 1, clique, iRow);
+  }
+}
+
+static void *
+coinCliqueWorker(void * info)
+{
+  CoinCliqueThread * thread = reinterpret_cast<CoinCliqueThread *>(info);
+  int maximumLength = 0;
+  for (int iRow = thread->first; iRow < thread->last; iRow++)
+    maximumLength = CoinMax(maximumLength, thread->length[iRow]);
+  double * weight = new double [maximumLength];
+  int * literal = new int [2 * maximumLength];
+  int * clique = literal + maximumLength;
+  for (int iRow = thread->first; iRow < thread->last; iRow++) {
+    if (thread->length[iRow] < 2)
+      continue;
+    if (thread->rowUpper[iRow] < COIN_DBL_MAX)
+      coinCliqueRowSide(thread, iRow, 1.0, thread->rowUpper[iRow],
+			weight, literal, clique);
+    if (thread->rowLower[iRow] > -COIN_DBL_MAX)
+      coinCliqueRowSide(thread, iRow, -1.0, -thread->rowLower[iRow],
+			weight, literal, clique);
+  }
+  delete [] literal;
+  delete [] weight;
+  return NULL;
+}
+
+//#############################################################################
+
+CoinCliqueTable::CoinCliqueTable() :
+  numberColumns_(0),
+  minimumSize_(2),
+  numberThreads_(1)
+{
+  clear(0);
+}
+
+CoinCliqueTable::CoinCliqueTable(int numberColumns) :
+  numberColumns_(0),
+  minimumSize_(2),
+  numberThreads_(1)
+{
+  clear(numberColumns);
+}
+
+void
+CoinCliqueTable::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value, 1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
+
+void
+CoinCliqueTable::clear(int numberColumns)
+{
+  numberColumns_ = CoinMax(numberColumns, 0);
+  cliqueStart_.assign(1, 0);
+  member_.clear();
+  cliqueRow_.clear();
+  makeIndex();
+}
+
+//#############################################################################
+
+int
+CoinCliqueTable::extract(const CoinPackedMatrix & matrix,
+			 const double * columnLower,
+			 const double * columnUpper,
+			 const char * integerType,
+			 const double * rowLower, const double * rowUpper)
+{
+  CoinPackedMatrix rowCopy;
+  const CoinPackedMatrix * byRow = &matrix;
+  if (matrix.isColOrdered()) {
+    rowCopy.reverseOrderedCopyOf(matrix);
+    byRow = &rowCopy;
+  }
+  const int numberRows = byRow->getMajorDim();
+  numberColumns_ = CoinMax(numberColumns_, byRow->getMinorDim());
+  // threads only worth it if plenty of rows each
+  int numberThreads = CoinMax(1, CoinMin(numberThreads_, numberRows / 1000));
+  CoinCliqueThread * thread = new CoinCliqueThread [numberThreads];
+  std::vector<int> * found = new std::vector<int> [3 * numberThreads];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i].start = byRow->getVectorStarts();
+    thread[i].length = byRow->getVectorLengths();
+    thread[i].index = byRow->getIndices();
+    thread[i].element = byRow->getElements();
+    thread[i].columnLower = columnLower;
+    thread[i].columnUpper = columnUpper;
+    thread[i].integerType = integerType;
+    thread[i].rowLower = rowLower;
+    thread[i].rowUpper = rowUpper;
+    thread[i].minimumSize = minimumSize_;
+    thread[i].first = static_cast<int>((static_cast<double>(numberRows) * i)
+				       / numberThreads);
+    thread[i].last = static_cast<int>((static_cast<double>(numberRows) * (i+1))
+				      / numberThreads);
+    thread[i].size = found + 3 * i;
+    thread[i].member = found + 3 * i + 1;
+    thread[i].row = found + 3 * i + 2;
+  }
+  thread[numberThreads-1].last = numberRows;
+  CoinThreadPool::run(coinCliqueWorker, thread, sizeof(CoinCliqueThread),
+		      numberThreads);
+  // append in order of rows
+  int numberAdded = 0;
+  for (int i = 0; i < numberThreads; i++) {
+    const std::vector<int> & size = *thread[i].size;
+    for (size_t k = 0; k < size.size(); k++)
+      cliqueStart_.push_back(cliqueStart_.back() + size[k]);
+    member_.insert(member_.end(), thread[i].member->begin(),
+		   thread[i].member->end());
+    cliqueRow_.insert(cliqueRow_.end(), thread[i].row->begin(),
+		      thread[i].row->end());
+    numberAdded += static_cast<int>(size.size());
+  }
+  delete [] found;
+  delete [] thread;
+  makeIndex();
+  return numberAdded;
+}
+
+int
+CoinCliqueTable::addClique(int number, const int * literals, int row)
+{
+  std::vector<int> clique(literals, literals + number);
+  std::sort(clique.begin(), clique.end());
+  clique.erase(std::unique(clique.begin(), clique.end()), clique.end());
+  if (clique.size() < 2)
+    return -1;
+  numberColumns_ = CoinMax(numberColumns_, column(clique.back()) + 1);
+  cliqueStart_.push_back(cliqueStart_.back() +
+			 static_cast<CoinBigIndex>(clique.size()));
+  member_.insert(member_.end(), clique.begin(), clique.end());
+  cliqueRow_.push_back(row);
+  makeIndex();
+  return numberCliques() - 1;
+}
+
+void
+CoinCliqueTable::addCliques(const CoinCliqueTable & other)
+{
+  const CoinBigIndex offset = cliqueStart_.back();
+  const int numberOther = other.numberCliques();
+  for (int i = 0; i < numberOther; i++)
+    cliqueStart_.push_back(offset + other.cliqueStart_[i+1]);
+  member_.insert(member_.end(), other.member_.begin(), other.member_.end());
+  cliqueRow_.insert(cliqueRow_.end(), other.cliqueRow_.begin(),
+		    other.cliqueRow_.end());
+  numberColumns_ = CoinMax(numberColumns_, other.numberColumns_);
+  makeIndex();
+}
+
+int
+CoinCliqueTable::removeDominated()
+{
+  const int number = numberCliques();
+  std::vector<char> keep(number, 1);
+  std::vector<int> mark(2 * numberColumns_, -1);
+  int numberRemoved = 0;
+  for (int iClique = 0; iClique < number; iClique++) {
+    const int size = cliqueSize(iClique);
+    const int * members = &member_[0] + cliqueStart_[iClique];
+    // any clique containing this one contains its rarest literal
+    int rarest = members[0];
+    for (int j = 0; j < size; j++) {
+      mark[members[j]] = iClique;
+      if (numberCliques(members[j]) < numberCliques(rarest))
+	rarest = members[j];
+    }
+    const int * look = cliques(rarest);
+    const int numberLook = numberCliques(rarest);
+    for (int k = 0; k < numberLook; k++) {
+      const int jClique = look[k];
+      const int otherSize = cliqueSize(jClique);
+      // of equal cliques keep first
+      if (otherSize < size || (otherSize == size && jClique >= iClique))
+	continue;
+      const int * other = &member_[0] + cliqueStart_[jClique];
+      int numberIn = 0;
+      for (int j = 0; j < otherSize; j++) {
+	if (mark[other[j]] == iClique)
+	  numberIn++;
+      }
+      if (numberIn == size) {
+	keep[iClique] = 0;
+	numberRemoved++;
+	break;
+      }
+    }
+  }
+  if (numberRemoved) {
+    CoinBigIndex put = 0;
+    int nPut = 0;
+    for (int iClique = 0; iClique < number; iClique++) {
+      const CoinBigIndex start = cliqueStart_[iClique];
+      const CoinBigIndex end = cliqueStart_[iClique+1];
+      if (keep[iClique]) {
+	for (CoinBigIndex j = start; j < end; j++)
+	  member_[put++] = member_[j];
+	cliqueRow_[nPut++] = cliqueRow_[iClique];
+	cliqueStart_[nPut] = put;
+      }
+    }
+    cliqueStart_.resize(nPut + 1);
+    member_.resize(put);
+    cliqueRow_.resize(nPut);
+    makeIndex();
+  }
+  return numberRemoved;
+}
+
+int
+CoinCliqueTable::mergeCliques(int maximumCandidates)
+{
+  const int number = numberCliques();
+  std::vector<int> candidate(2 * numberColumns_);
+  std::vector<int> mark(2 * numberColumns_, -1);
+  std::vector<int> grown;
+  std::vector<CoinBigIndex> newStart(1, 0);
+  std::vector<int> newMember;
+  std::vector<int> newRow;
+  int numberGrown = 0;
+  for (int iClique = 0; iClique < number; iClique++) {
+    const int size = cliqueSize(iClique);
+    const int * members = &member_[0] + cliqueStart_[iClique];
+    grown.assign(members, members + size);
+    // candidates are neighbours of member in fewest cliques
+    int rarest = members[0];
+    for (int j = 0; j < size; j++) {
+      mark[members[j]] = iClique;
+      if (numberCliques(members[j]) < numberCliques(rarest))
+	rarest = members[j];
+    }
+    const int numberCandidates =
+      CoinMin(neighbours(rarest, &candidate[0]), maximumCandidates);
+    for (int k = 0; k < numberCandidates; k++) {
+      const int iLiteral = candidate[k];
+      if (mark[iLiteral] == iClique)
+	continue;
+      bool inAll = true;
+      for (size_t j = 0; j < grown.size(); j++) {
+	if (!conflict(iLiteral, grown[j])) {
+	  inAll = false;
+	  break;
+	}
+      }
+      if (inAll) {
+	grown.push_back(iLiteral);
+	mark[iLiteral] = iClique;
+      }
+    }
+    if (static_cast<int>(grown.size()) > size) {
+      std::sort(grown.begin(), grown.end());
+      newMember.insert(newMember.end(), grown.begin(), grown.end());
+      newStart.push_back(static_cast<CoinBigIndex>(newMember.size()));
+      newRow.push_back(cliqueRow_[iClique]);
+      numberGrown++;
+    }
+  }
+  if (numberGrown) {
+    // grown cliques go at end so originals are removed as dominated
+    const CoinBigIndex offset = cliqueStart_.back();
+    for (int i = 0; i < numberGrown; i++)
+      cliqueStart_.push_back(offset + newStart[i+1]);
+    member_.insert(member_.end(), newMember.begin(), newMember.end());
+    cliqueRow_.insert(cliqueRow_.end(), newRow.begin(), newRow.end());
+    makeIndex();
+    removeDominated();
+  }
+  return numberGrown;
+}
+
+//#############################################################################
+
+void
+CoinCliqueTable::makeIndex()
+{
+  const int numberLiterals = 2 * numberColumns_;
+  const int number = numberCliques();
+  literalStart_.assign(numberLiterals + 1, 0);
+  numberLarge_.assign(numberLiterals, 0);
+  CoinBigIndex numberPairs = 0;
+  for (int iClique = 0; iClique < number; iClique++) {
+    const int size = cliqueSize(iClique);
+    const int * members = &member_[0] + cliqueStart_[iClique];
+    for (int j = 0; j < size; j++) {
+      literalStart_[members[j]+1]++;
+      if (size > COIN_CLIQUE_SMALL)
+	numberLarge_[members[j]]++;
+    }
+    if (size <= COIN_CLIQUE_SMALL)
+      numberPairs += (size * (size - 1)) / 2;
+  }
+  for (int i = 0; i < numberLiterals; i++)
+    literalStart_[i+1] += literalStart_[i];
+  literalClique_.resize(literalStart_[numberLiterals]);
+  // large cliques first (each part in order of cliques)
+  std::vector<CoinBigIndex> putLarge(literalStart_.begin(),
+				     literalStart_.end() - 1);
+  std::vector<CoinBigIndex> putSmall(numberLiterals);
+  for (int i = 0; i < numberLiterals; i++)
+    putSmall[i] = literalStart_[i] + numberLarge_[i];
+  for (int iClique = 0; iClique < number; iClique++) {
+    const int size = cliqueSize(iClique);
+    const int * members = &member_[0] + cliqueStart_[iClique];
+    std::vector<CoinBigIndex> & put =
+      (size > COIN_CLIQUE_SMALL) ? putLarge : putSmall;
+    for (int j = 0; j < size; j++)
+      literalClique_[put[members[j]]++] = iClique;
+  }
+  // pairs of small cliques
+  pairHash_.clear();
+  if (numberPairs) {
+    size_t sizeHash = 16;
+    while (sizeHash < 2 * static_cast<size_t>(numberPairs))
+      sizeHash *= 2;
+    pairHash_.assign(sizeHash, ~static_cast<CoinUInt64>(0));
+    const size_t mask = sizeHash - 1;
+    for (int iClique = 0; iClique < number; iClique++) {
+      const int size = cliqueSize(iClique);
+      if (size > COIN_CLIQUE_SMALL)
+	continue;
+      const int * members = &member_[0] + cliqueStart_[iClique];
+      for (int j = 0; j < size; j++) {
+	for (int k = j + 1; k < size; k++) {
+	  const CoinUInt64 key = coinCliqueKey(members[j], members[k]);
+	  size_t slot = static_cast<size_t>(coinCliqueMix(key)) & mask;
+	  while (pairHash_[slot] != key &&
+		 pairHash_[slot] != ~static_cast<CoinUInt64>(0))
+	    slot = (slot + 1) & mask;
+	  pairHash_[slot] = key;
+	}
+      }
+    }
+  }
+}
+
+bool
+CoinCliqueTable::inHash(int literal1, int literal2) const
+{
+  if (pairHash_.empty())
+    return false;
+  const size_t mask = pairHash_.size() - 1;
+  const CoinUInt64 key = coinCliqueKey(literal1, literal2);
+  size_t slot = static_cast<size_t>(coinCliqueMix(key)) & mask;
+  while (pairHash_[slot] != ~static_cast<CoinUInt64>(0)) {
+    if (pairHash_[slot] == key)
+      return true;
+    slot = (slot + 1) & mask;
+  }
+  return false;
+}
+
+bool
+CoinCliqueTable::conflict(int literal1, int literal2) const
+{
+  if (literal1 == literal2)
+    return false;
+  if (literal1 == complement(literal2))
+    return true;
+  if (inHash(literal1, literal2))
+    return true;
+  // large cliques in common (both lists in order of cliques)
+  const int * large1 = cliques(literal1);
+  const int * large2 = cliques(literal2);
+  const int number1 = numberLarge_[literal1];
+  const int number2 = numberLarge_[literal2];
+  int i = 0;
+  int j = 0;
+  while (i < number1 && j < number2) {
+    if (large1[i] == large2[j])
+      return true;
+    else if (large1[i] < large2[j])
+      i++;
+    else
+      j++;
+  }
+  return false;
+}
+
+int
+CoinCliqueTable::neighbours(int literal, int * which) const
+{
+  std::vector<int> found(1, complement(literal));
+  const int * look = cliques(literal);
+  const int numberLook = numberCliques(literal);
+  for (int k = 0; k < numberLook; k++) {
+    const int iClique = look[k];
+    const CoinBigIndex end = cliqueStart_[iClique+1];
+    for (CoinBigIndex j = cliqueStart_[iClique]; j < end; j++) {
+      if (member_[j] != literal)
+	found.push_back(member_[j]);
+    }
+  }
+  std::sort(found.begin(), found.end());
+  const int number = static_cast<int>(std::unique(found.begin(), found.end())
+				       - found.begin());
+  CoinMemcpyN(&found[0], number, which);
+  return number;
+}
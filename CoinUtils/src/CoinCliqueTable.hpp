@@ -0,0 +1,185 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinCliqueTable_H
+#define CoinCliqueTable_H
+
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+
+/** Table of cliques of binary literals (conflict graph)
+
+    A literal is a binary column at one (2*column) or at zero
+    (2*column+1, the complement).  A clique is a set of literals of which
+    at most one can be true; two literals in a clique are in conflict,
+    which read the other way gives the implications l true implies m
+    false.  A literal always conflicts with its complement.
+
+    extract finds cliques in rows of a matrix: the binaries of a row
+    (complemented where the coefficient is negative, with everything else
+    at its best bound) conflict in pairs whose weights add up to more than
+    the right hand side, and the largest such pairs give a clique -
+    all of a set packing or partitioning row.  Rows are done in parallel
+    if built with COINUTILS_PTHREADS and setNumberThreads is used; the
+    cliques found, and their order, do not depend on the number of
+    threads.
+
+    Queries are cheap once the table is built: conflict(l,m) looks up
+    pairs from small cliques in a hash table and intersects the (short)
+    lists of large cliques of l and m, so is about constant time however
+    long the rows.  Cliques can be added by cut generators and
+    propagators (addClique, addImplication, addCliques), grown into
+    larger ones (mergeCliques) and cliques contained in others dropped
+    (removeDominated).  Each change rebuilds the lookup structures, so
+    add in batches.
+*/
+class CoinCliqueTable {
+public:
+  /**@name Literals */
+  //@{
+  /// Literal of column at one (or at zero if complement)
+  static inline int literal(int column, bool complement = false)
+  { return 2 * column + (complement ? 1 : 0);}
+  /// Column of literal
+  static inline int column(int literal)
+  { return literal >> 1;}
+  /// True if literal is column at zero
+  static inline bool isComplement(int literal)
+  { return (literal & 1) != 0;}
+  /// Complement of literal
+  static inline int complement(int literal)
+  { return literal ^ 1;}
+  //@}
+
+  /**@name Building */
+  //@{
+  /** Empties table for literals of numberColumns columns */
+  void clear(int numberColumns);
+  /** Adds cliques from rows of matrix (column or row ordered).  Binary
+      columns are integer with bounds 0 and 1; other columns must have
+      the bound needed for a row side finite for the side to be used.
+      Only cliques with at least minimumSize() literals are kept.
+      Returns number of cliques added. */
+  int extract(const CoinPackedMatrix & matrix,
+	      const double * columnLower, const double * columnUpper,
+	      const char * integerType,
+	      const double * rowLower, const double * rowUpper);
+  /** Adds a clique (literals need not be sorted; repeats are dropped).
+      row is just kept for cliqueRow.  Returns index of clique or -1 if
+      fewer than two different literals */
+  int addClique(int number, const int * literals, int row = -1);
+  /// Adds implication - if literal1 true then literal2 true
+  inline int addImplication(int literal1, int literal2)
+  { int pair[2] = {literal1, complement(literal2)};
+    return addClique(2, pair);}
+  /// Adds all cliques of other (columns taken as the same)
+  void addCliques(const CoinCliqueTable & other);
+  /** Removes cliques contained in another (of equal cliques the first
+      is kept).  Returns number removed */
+  int removeDominated();
+  /** Grows each clique by literals in conflict with all its members
+      (looking at no more than maximumCandidates of them per clique),
+      then removes dominated cliques.  Returns number of cliques which
+      grew */
+  int mergeCliques(int maximumCandidates = 1000);
+  //@}
+
+  /**@name Queries */
+  //@{
+  /// True if literals can not both be true
+  bool conflict(int literal1, int literal2) const;
+  /** Literals in conflict with literal (so implied false if it is true),
+      in increasing order.  which must have room for 2*numberColumns().
+      Returns number */
+  int neighbours(int literal, int * which) const;
+  /// Number of cliques containing literal
+  inline int numberCliques(int literal) const
+  { return static_cast<int>(literalStart_[literal+1] - literalStart_[literal]);}
+  /// Cliques containing literal (larger ones first)
+  inline const int * cliques(int literal) const
+  { return literalClique_.size() ?
+      &literalClique_[0] + literalStart_[literal] : NULL;}
+  //@}
+
+  /**@name Cliques */
+  //@{
+  /// Number of columns
+  inline int numberColumns() const
+  { return numberColumns_;}
+  /// Number of cliques
+  inline int numberCliques() const
+  { return static_cast<int>(cliqueStart_.size()) - 1;}
+  /// Start of each clique in cliqueMembers (numberCliques()+1)
+  inline const CoinBigIndex * cliqueStarts() const
+  { return &cliqueStart_[0];}
+  /// Literals of cliques (increasing order in a clique)
+  inline const int * cliqueMembers() const
+  { return member_.size() ? &member_[0] : NULL;}
+  /// Size of a clique
+  inline int cliqueSize(int iClique) const
+  { return static_cast<int>(cliqueStart_[iClique+1] - cliqueStart_[iClique]);}
+  /// Row clique came from (-1 if added)
+  inline int cliqueRow(int iClique) const
+  { return cliqueRow_[iClique];}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Smallest clique kept by extract (default 2)
+  inline int minimumSize() const
+  { return minimumSize_;}
+  inline void setMinimumSize(int value)
+  { minimumSize_ = value < 2 ? 2 : value;}
+  /// Number of threads for extract
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (1 if not built with threads)
+  void setNumberThreads(int value);
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Default constructor
+  CoinCliqueTable();
+  /// Constructor for numberColumns columns
+  explicit CoinCliqueTable(int numberColumns);
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Rebuilds literal lists and pair hash from cliques
+  void makeIndex();
+  /// True if pair is in hash of small cliques
+  bool inHash(int literal1, int literal2) const;
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Start of each clique (number of cliques + 1)
+  std::vector<CoinBigIndex> cliqueStart_;
+  /// Literals of cliques
+  std::vector<int> member_;
+  /// Row of each clique
+  std::vector<int> cliqueRow_;
+  /// Start of cliques of each literal (2*numberColumns_+1)
+  std::vector<CoinBigIndex> literalStart_;
+  /// Cliques of each literal - large ones first
+  std::vector<int> literalClique_;
+  /// Number of large cliques of each literal
+  std::vector<int> numberLarge_;
+  /// Open addressed hash of pairs of literals in small cliques
+  std::vector<CoinUInt64> pairHash_;
+  /// Number of columns
+  int numberColumns_;
+  /// Smallest clique kept by extract
+  int minimumSize_;
+  /// Number of threads
+  int numberThreads_;
+  //@}
+};
+
+#endif
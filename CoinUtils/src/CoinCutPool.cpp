@@ -0,0 +1,330 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinFloatEqual.hpp"
+#include "CoinSort.hpp"
+#include "CoinCutPool.hpp"
+#include "CoinPackedMatrixDuplicates.hpp"
+#include "CoinThreadPool.hpp"
+
+//#############################################################################
+// Work for one thread of evaluate
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  const double * lower;
+  const double * upper;
+  const double * norm;
+  const double * x;
+  double * violation;
+  double * efficacy;
+  int first;
+  int last;
+} CoinCutPoolThread;
+
+static void *
+coinCutPoolWorker(void * info)
+{
+  CoinCutPoolThread * thread = reinterpret_cast<CoinCutPoolThread *>(info);
+  const CoinBigIndex * start = thread->start;
+  const int * length = thread->length;
+  const int * COIN_RESTRICT index = thread->index;
+  const double * COIN_RESTRICT element = thread->element;
+  const double * COIN_RESTRICT x = thread->x;
+  for (int i = thread->first; i < thread->last; i++) {
+    double activity = 0.0;
+    const CoinBigIndex end = start[i] + length[i];
+    for (CoinBigIndex j = start[i]; j < end; j++)
+      activity += element[j] * x[index[j]];
+    const double violation =
+      CoinMax(CoinMax(thread->lower[i] - activity,
+		      activity - thread->upper[i]), 0.0);
+    if (thread->violation)
+      thread->violation[i] = violation;
+    if (thread->efficacy)
+      thread->efficacy[i] = violation / thread->norm[i];
+  }
+  return NULL;
+}
+
+//#############################################################################
+
+CoinCutPool::CoinCutPool()
+  : cuts_(false, 0.25, 0.0),
+    tolerance_(1.0e-12),
+    numberDuplicates_(0),
+    numberThreads_(1)
+{
+}
+
+void
+CoinCutPool::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value, 1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
+
+//#############################################################################
+
+int
+CoinCutPool::addCut(int number, const int * index, const double * element,
+		    double lower, double upper)
+{
+  // copy non zero entries and sort by index
+  workIndex_.resize(CoinMax(number, 1));
+  workElement_.resize(CoinMax(number, 1));
+  int * which = &workIndex_[0];
+  double * value = &workElement_[0];
+  int n = 0;
+  double largest = 0.0;
+  for (int j = 0; j < number; j++) {
+    if (element[j]) {
+      which[n] = index[j];
+      value[n++] = element[j];
+      largest = CoinMax(largest, fabs(element[j]));
+    }
+  }
+  if (!n)
+    return -1;
+  CoinSort_2(which, which + n, value);
+  // scale so largest is 1.0 and first positive
+  double scale = 1.0 / largest;
+  if (value[0] < 0.0)
+    scale = -scale;
+  double sumSquares = 0.0;
+  for (int j = 0; j < n; j++) {
+    value[j] *= scale;
+    sumSquares += value[j] * value[j];
+  }
+  double newLower = lower > -1.0e30 ? lower * scale : -COIN_DBL_MAX;
+  double newUpper = upper < 1.0e30 ? upper * scale : COIN_DBL_MAX;
+  if (scale < 0.0) {
+    double temp = newLower;
+    newLower = upper < 1.0e30 ? newUpper : -COIN_DBL_MAX;
+    newUpper = lower > -1.0e30 ? temp : COIN_DBL_MAX;
+  }
+  const CoinUInt64 hash =
+    CoinPackedMatrixDuplicates::hashVector(n, which, value);
+  int iCut = findParallel(hash, n, which, value);
+  if (iCut >= 0) {
+    lower_[iCut] = CoinMax(lower_[iCut], newLower);
+    upper_[iCut] = CoinMin(upper_[iCut], newUpper);
+    age_[iCut] = 0;
+    numberDuplicates_++;
+    return iCut;
+  }
+  iCut = numberCuts();
+  cuts_.appendRow(n, which, value);
+  lower_.push_back(newLower);
+  upper_.push_back(newUpper);
+  norm_.push_back(sqrt(sumSquares));
+  hash_.push_back(hash);
+  age_.push_back(0);
+  // keep table at most half full
+  if (2 * numberCuts() > static_cast<int>(table_.size()))
+    rebuildHash(numberCuts());
+  else
+    insertHash(iCut);
+  return iCut;
+}
+
+int
+CoinCutPool::addCut(const CoinPackedVectorBase & row, double lower,
+		    double upper)
+{
+  return addCut(row.getNumElements(), row.getIndices(), row.getElements(),
+		lower, upper);
+}
+
+void
+CoinCutPool::deleteCuts(int number, const int * which)
+{
+  const int numberCuts = this->numberCuts();
+  int * newIndex = new int [numberCuts + 1];
+  const int numberKept = CoinDeletionMap(numberCuts, number, which,
+					 newIndex);
+  if (numberKept < numberCuts) {
+    // deleteRows wants each once
+    int * deleted = new int [numberCuts - numberKept];
+    int numberDeleted = 0;
+    for (int i = 0; i < numberCuts; i++) {
+      int k = newIndex[i];
+      if (k < 0) {
+	deleted[numberDeleted++] = i;
+      } else {
+	lower_[k] = lower_[i];
+	upper_[k] = upper_[i];
+	norm_[k] = norm_[i];
+	hash_[k] = hash_[i];
+	age_[k] = age_[i];
+      }
+    }
+    cuts_.deleteRows(numberDeleted, deleted);
+    delete [] deleted;
+    lower_.resize(numberKept);
+    upper_.resize(numberKept);
+    norm_.resize(numberKept);
+    hash_.resize(numberKept);
+    age_.resize(numberKept);
+    rebuildHash(numberKept);
+  }
+  delete [] newIndex;
+}
+
+int
+CoinCutPool::purge(int maximumAge)
+{
+  std::vector<int> old;
+  for (int i = 0; i < numberCuts(); i++) {
+    if (age_[i] > maximumAge)
+      old.push_back(i);
+  }
+  if (!old.empty())
+    deleteCuts(static_cast<int>(old.size()), &old[0]);
+  return static_cast<int>(old.size());
+}
+
+void
+CoinCutPool::clear()
+{
+  cuts_ = CoinPackedMatrix(false, 0.25, 0.0);
+  lower_.clear();
+  upper_.clear();
+  norm_.clear();
+  hash_.clear();
+  age_.clear();
+  table_.clear();
+  numberDuplicates_ = 0;
+}
+
+//#############################################################################
+
+void
+CoinCutPool::evaluate(const double * x, double * violation,
+		      double * efficacy) const
+{
+  const int n = numberCuts();
+  if (!n || (!violation && !efficacy))
+    return;
+  // threads only worth it if plenty of elements each
+  int numberThreads =
+    CoinMax(1, CoinMin(numberThreads_,
+		       static_cast<int>(cuts_.getNumElements() / 20000)));
+  numberThreads = CoinMin(numberThreads, n);
+  CoinCutPoolThread * thread = new CoinCutPoolThread [numberThreads];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i].start = cuts_.getVectorStarts();
+    thread[i].length = cuts_.getVectorLengths();
+    thread[i].index = cuts_.getIndices();
+    thread[i].element = cuts_.getElements();
+    thread[i].lower = &lower_[0];
+    thread[i].upper = &upper_[0];
+    thread[i].norm = &norm_[0];
+    thread[i].x = x;
+    thread[i].violation = violation;
+    thread[i].efficacy = efficacy;
+    thread[i].first = static_cast<int>((static_cast<double>(n) * i)
+				       / numberThreads);
+    thread[i].last = static_cast<int>((static_cast<double>(n) * (i+1))
+				      / numberThreads);
+  }
+  thread[numberThreads-1].last = n;
+  CoinThreadPool::run(coinCutPoolWorker, thread, sizeof(CoinCutPoolThread),
+		      numberThreads);
+  delete [] thread;
+}
+
+int
+CoinCutPool::violatedCuts(const double * x, double minimumEfficacy,
+			  int * which, bool updateAges)
+{
+  const int n = numberCuts();
+  if (!n)
+    return 0;
+  double * efficacy = new double [n];
+  evaluate(x, NULL, efficacy);
+  int numberViolated = 0;
+  for (int i = 0; i < n; i++) {
+    if (efficacy[i] > minimumEfficacy) {
+      which[numberViolated] = i;
+      // most efficacious first
+      efficacy[numberViolated++] = -efficacy[i];
+      if (updateAges)
+	age_[i] = 0;
+    } else if (updateAges) {
+      age_[i]++;
+    }
+  }
+  CoinSort_2(efficacy, efficacy + numberViolated, which);
+  delete [] efficacy;
+  return numberViolated;
+}
+
+//#############################################################################
+
+int
+CoinCutPool::findParallel(CoinUInt64 hash, int number, const int * index,
+			  const double * element) const
+{
+  if (table_.empty())
+    return -1;
+  const CoinBigIndex * start = cuts_.getVectorStarts();
+  const int * length = cuts_.getVectorLengths();
+  const int * cutIndex = cuts_.getIndices();
+  const double * cutElement = cuts_.getElements();
+  CoinRelFltEq equal(tolerance_);
+  const int mask = static_cast<int>(table_.size()) - 1;
+  for (int position = static_cast<int>(hash & mask); table_[position] >= 0;
+       position = (position + 1) & mask) {
+    const int iCut = table_[position];
+    if (hash_[iCut] != hash || length[iCut] != number)
+      continue;
+    const int * thisIndex = cutIndex + start[iCut];
+    const double * thisElement = cutElement + start[iCut];
+    int j;
+    for (j = 0; j < number; j++) {
+      if (thisIndex[j] != index[j] || !equal(thisElement[j], element[j]))
+	break;
+    }
+    if (j == number)
+      return iCut;
+  }
+  return -1;
+}
+
+void
+CoinCutPool::insertHash(int iCut)
+{
+  const int mask = static_cast<int>(table_.size()) - 1;
+  int position = static_cast<int>(hash_[iCut] & mask);
+  while (table_[position] >= 0)
+    position = (position + 1) & mask;
+  table_[position] = iCut;
+}
+
+void
+CoinCutPool::rebuildHash(int number)
+{
+  int size = 64;
+  while (size < 4 * number)
+    size *= 2;
+  table_.assign(size, -1);
+  for (int i = 0; i < numberCuts(); i++)
+    insertHash(i);
+}
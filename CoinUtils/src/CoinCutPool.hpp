@@ -0,0 +1,159 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinCutPool_H
+#define CoinCutPool_H
+
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+#include "CoinPackedVectorBase.hpp"
+
+/** Pool of cuts (rows lower <= a.x <= upper)
+
+    All cuts are kept in one row ordered CoinPackedMatrix which is
+    appended to, so checking the pool against a solution is one sparse
+    matrix times vector (split between threads if built with
+    COINUTILS_PTHREADS and setNumberThreads is used) rather than one dot
+    product per CoinPackedVector.
+
+    Cuts are stored normalized - entries in increasing index order,
+    scaled so the largest is 1.0 in size and the first is positive
+    (bounds are scaled, and swapped if need be, to match).  A 64 bit hash
+    of the normalized entries (CoinPackedMatrixDuplicates::hashVector)
+    finds parallel cuts: if a new cut has the same entries as one in the
+    pool (to CoinRelFltEq) it is not added but the bounds of the old one
+    are tightened.  As cuts are scaled, violation is in units of the
+    largest coefficient; efficacy is violation divided by 2-norm of the
+    cut (distance of x from the cut hyperplane).
+
+    Each cut has an age - violatedCuts sets it to zero for cuts it
+    returns and adds one for the others - so purge can throw out cuts
+    which have not been useful for a while.  Deleting renumbers the cuts
+    which are left (keeping their order).
+
+    Bounds of 1.0e30 or more in size are infinite.
+*/
+class CoinCutPool {
+public:
+  /**@name Adding and deleting cuts */
+  //@{
+  /** Adds cut lower <= sum element[j]*x[index[j]] <= upper (indices must
+      not repeat, zero elements are dropped).  Returns index of cut in
+      pool - of the old cut if parallel to one already there (which then
+      gets tighter of the bounds and age zero) - or -1 if no entries */
+  int addCut(int number, const int * index, const double * element,
+	     double lower, double upper);
+  /// Adds cut from packed vector (as above)
+  int addCut(const CoinPackedVectorBase & row, double lower, double upper);
+  /// Deletes cuts (any order), renumbering the rest
+  void deleteCuts(int number, const int * which);
+  /// Deletes cuts with age more than maximumAge.  Returns number deleted
+  int purge(int maximumAge);
+  /// Deletes all cuts
+  void clear();
+  //@}
+
+  /**@name Checking against a solution */
+  //@{
+  /** Violation of each cut at x (zero if satisfied) and, if efficacy is
+      not NULL, violation divided by 2-norm of cut.  Either may be NULL */
+  void evaluate(const double * x, double * violation,
+		double * efficacy = NULL) const;
+  /** Puts indices of cuts with efficacy at x above minimumEfficacy in
+      which (most efficacious first) and returns how many.  Ages cuts if
+      updateAges - those found go to zero and the others go up by one */
+  int violatedCuts(const double * x, double minimumEfficacy, int * which,
+		   bool updateAges = true);
+  //@}
+
+  /**@name Cuts */
+  //@{
+  /// Number of cuts
+  inline int numberCuts() const
+  { return static_cast<int>(lower_.size());}
+  /// Cuts (normalized and row ordered)
+  inline const CoinPackedMatrix & matrix() const
+  { return cuts_;}
+  /// Lower bounds of cuts (normalized)
+  inline const double * lower() const
+  { return numberCuts() ? &lower_[0] : NULL;}
+  /// Upper bounds of cuts (normalized)
+  inline const double * upper() const
+  { return numberCuts() ? &upper_[0] : NULL;}
+  /// 2-norm of cut
+  inline double norm(int iCut) const
+  { return norm_[iCut];}
+  /// Age of cut
+  inline int age(int iCut) const
+  { return age_[iCut];}
+  /// Sets age of cut
+  inline void setAge(int iCut, int value)
+  { age_[iCut] = value;}
+  /// Hash of cut
+  inline CoinUInt64 hash(int iCut) const
+  { return hash_[iCut];}
+  /// Number of cuts not added (as parallel to one in pool) since clear
+  inline int numberDuplicates() const
+  { return numberDuplicates_;}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Relative tolerance for entries of parallel cuts (default 1.0e-12)
+  inline double tolerance() const
+  { return tolerance_;}
+  inline void setTolerance(double value)
+  { tolerance_ = value;}
+  /// Number of threads for evaluate
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (1 if not built with threads)
+  void setNumberThreads(int value);
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Default constructor
+  CoinCutPool();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Existing cut with same normalized entries (-1 if none)
+  int findParallel(CoinUInt64 hash, int number, const int * index,
+		   const double * element) const;
+  /// Puts cut into hash table
+  void insertHash(int iCut);
+  /// Rebuilds hash table for current cuts (size for at least number)
+  void rebuildHash(int number);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Cuts (row ordered)
+  CoinPackedMatrix cuts_;
+  /// Bounds
+  std::vector<double> lower_;
+  std::vector<double> upper_;
+  /// 2-norms
+  std::vector<double> norm_;
+  /// Hashes
+  std::vector<CoinUInt64> hash_;
+  /// Ages
+  std::vector<int> age_;
+  /// Open addressing table of cuts by hash (-1 empty, power of 2 long)
+  std::vector<int> table_;
+  /// Work arrays for normalizing
+  std::vector<int> workIndex_;
+  std::vector<double> workElement_;
+  double tolerance_;
+  int numberDuplicates_;
+  int numberThreads_;
+  //@}
+};
+
+#endif
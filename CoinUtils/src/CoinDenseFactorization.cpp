@@ -14,6 +14,7 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
+#include "CoinThreadPool.hpp"
 #if COIN_BIG_DOUBLE==1
 #undef COIN_FACTORIZATION_DENSE_CODE
 #endif
@@ -32,6 +33,53 @@ extern "C"
 			       int trans_len);
 }
 #endif
+/* factor works on blocks of COIN_DENSE_BLOCK columns.  Each block is
+   factorized column by column and then applied to rest of matrix a few
+   columns and COIN_DENSE_ROWS rows at a time so block stays in cache.
+   Order of operations on each element is same as for simple code. */
+#ifndef COIN_DENSE_BLOCK
+#define COIN_DENSE_BLOCK 64
+#endif
+#define COIN_DENSE_ROWS 256
+// Number of right hand sides done together in updateColumns
+#define COIN_DENSE_RHS 8
+// Work (multiply-adds) below which not worth starting threads
+#define COIN_DENSE_THREAD_WORK 1000000
+// Information for one thread in factor or updateColumns
+typedef struct {
+  CoinDenseFactorization * factorization;
+  const int * swaps;
+  int firstPivot;
+  int numberPivots;
+  int first;
+  int last;
+  // for updateColumns
+  double * array;
+  int leadingDimension;
+  bool transpose;
+  CoinFactorizationDouble * work;
+} CoinDenseThreadInfo;
+static void * 
+denseWorker(void * info)
+{
+  CoinDenseThreadInfo * thread = reinterpret_cast<CoinDenseThreadInfo *>(info);
+  if (!thread->array) 
+    thread->factorization->updateTrailing(thread->firstPivot,thread->numberPivots,
+					  thread->swaps,thread->first,thread->last);
+  else
+    thread->factorization->updateBlock(thread->last-thread->first,
+				       thread->array+thread->first*thread->leadingDimension,
+				       thread->leadingDimension,thread->transpose,
+				       thread->work);
+  return NULL;
+}
+// Runs numberThreads workers on shared pool
+static void
+runDenseWorkers(CoinDenseThreadInfo * thread, int numberThreads)
+{
+  CoinThreadPool::run(denseWorker,thread,sizeof(CoinDenseThreadInfo),
+		      numberThreads);
+}
 //:class CoinDenseFactorization.  Deals with Factorization and Updates
 //  CoinDenseFactorization.  Constructor
 CoinDenseFactorization::CoinDenseFactorization (  )
@@ -90,6 +138,7 @@ void CoinDenseFactorization::gutsOfInitialize()
   pivotRow_ = NULL;
   workArea_ = NULL;
   solveMode_=0;
+  numberThreads_=1;
 }
 //  ~CoinDenseFactorization.  Destructor
 CoinDenseFactorization::~CoinDenseFactorization (  )
@@ -128,6 +177,7 @@ void CoinDenseFactorization::gutsOfCopy(const CoinDenseFactorization &other)
   numberPivots_ = other.numberPivots_;
   factorElements_ = other.factorElements_;
   status_ = other.status_;
+  numberThreads_ = other.numberThreads_;
   if (other.pivotRow_) {
     pivotRow_ = new int [2*maximumRows_+maximumPivots_];
     CoinMemcpyN(other.pivotRow_,(2*maximumRows_+numberPivots_),pivotRow_);
@@ -228,25 +278,40 @@ CoinDenseFactorization::factor ( )
   for (int j=0;j<numberRows_;j++) {
     pivotRow_[j+numberRows_]=j;
   }
-  CoinFactorizationDouble * elements = elements_;
   numberGoodU_=0;
-  for (int i=0;i<numberColumns_;i++) {
-    int iRow = -1;
-    // Find largest
-    double largest=zeroTolerance_;
-    for (int j=i;j<numberRows_;j++) {
-      double value = fabs(elements[j]);
-      if (value>largest) {
-	largest=value;
-	iRow=j;
+  int numberThreads = 1;
+#ifdef COINUTILS_PTHREADS
+  numberThreads = numberThreads_;
+#endif
+  CoinDenseThreadInfo thread[COIN_DENSE_BLOCK];
+  numberThreads = CoinMin(numberThreads,COIN_DENSE_BLOCK);
+  int swaps[COIN_DENSE_BLOCK];
+  for (int iBlock=0;iBlock<numberColumns_;iBlock+=COIN_DENSE_BLOCK) {
+    int lastBlock = CoinMin(iBlock+COIN_DENSE_BLOCK,numberColumns_);
+    CoinFactorizationDouble * elements = elements_+iBlock*numberRows_;
+    int i;
+    // factorize block
+    for (i=iBlock;i<lastBlock;i++) {
+      int iRow = -1;
+      // Find largest
+      double largest=zeroTolerance_;
+      for (int j=i;j<numberRows_;j++) {
+	double value = fabs(elements[j]);
+	if (value>largest) {
+	  largest=value;
+	  iRow=j;
+	}
       }
-    }
-    if (iRow>=0) {
+      if (iRow<0) {
+	status_=-1;
+	break;
+      }
+      swaps[i-iBlock]=iRow;
       if (iRow!=i) {
-	// swap
+	// swap in L and this block (rest done in updateTrailing)
 	assert (iRow>i);
 	CoinFactorizationDouble * elementsA = elements_;
-	for (int k=0;k<=i;k++) {
+	for (int k=0;k<lastBlock;k++) {
 	  // swap
 	  CoinFactorizationDouble value = elementsA[i];
 	  elementsA[i]=elementsA[iRow];
@@ -262,27 +327,46 @@ CoinDenseFactorization::factor ( )
       for (int j=i+1;j<numberRows_;j++) {
 	elements[j] *= pivotValue;
       }
-      // Update rest
+      // Update rest of block
       CoinFactorizationDouble * elementsA = elements;
-      for (int k=i+1;k<numberColumns_;k++) {
+      for (int k=i+1;k<lastBlock;k++) {
 	elementsA += numberRows_;
-	// swap
-	if (iRow!=i) {
-	  CoinFactorizationDouble value = elementsA[i];
-	  elementsA[i]=elementsA[iRow];
-	  elementsA[iRow]=value;
-	}
 	CoinFactorizationDouble value = elementsA[i];
 	for (int j=i+1;j<numberRows_;j++) {
 	  elementsA[j] -= value * elements[j];
 	}
       }
-    } else {
-      status_=-1;
-      break;
+      numberGoodU_++;
+      elements += numberRows_;
     }
-    numberGoodU_++;
-    elements += numberRows_;
+    // now rest of matrix
+    int numberPivots = i-iBlock;
+    int numberTrailing = numberColumns_-lastBlock;
+    if (numberPivots&&numberTrailing) {
+      double work = static_cast<double>(numberTrailing)*
+	static_cast<double>(numberRows_-iBlock)*numberPivots;
+      int nThreads = CoinMin(numberThreads,
+			     static_cast<int>(work/COIN_DENSE_THREAD_WORK)+1);
+      // split in multiples of 4
+      int chunk = (numberTrailing+nThreads-1)/nThreads;
+      chunk = 4*((chunk+3)/4);
+      int start = lastBlock;
+      int n = 0;
+      while (start<numberColumns_) {
+	CoinDenseThreadInfo & info = thread[n++];
+	memset(&info,0,sizeof(CoinDenseThreadInfo));
+	info.factorization = this;
+	info.swaps = swaps;
+	info.firstPivot = iBlock;
+	info.numberPivots = numberPivots;
+	info.first = start;
+	start = CoinMin(start+chunk,numberColumns_);
+	info.last = start;
+      }
+      runDenseWorkers(thread,n);
+    }
+    if (status_)
+      break;
   }
   for (int j=0;j<numberRows_;j++) {
     int k = pivotRow_[j+numberRows_];
@@ -915,6 +999,279 @@ CoinDenseFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse
   regionSparse2->setNumElements(numberNonZero);
   return 0;
 }
+/* Applies numberPivots pivots of factor starting at firstPivot
+   (row interchanges in swaps) to columns first to last-1 */
+void 
+CoinDenseFactorization::updateTrailing(int firstPivot, int numberPivots, 
+				       const int * swaps, int first, int last)
+{
+  int lastPivot = firstPivot+numberPivots;
+  // interchanges and triangular solve with block of L
+  for (int k=first;k<last;k++) {
+    CoinFactorizationDouble * COIN_RESTRICT elementsA = elements_+k*numberRows_;
+    for (int i=firstPivot;i<lastPivot;i++) {
+      int iRow = swaps[i-firstPivot];
+      if (iRow!=i) {
+	CoinFactorizationDouble value = elementsA[i];
+	elementsA[i]=elementsA[iRow];
+	elementsA[iRow]=value;
+      }
+    }
+    const CoinFactorizationDouble * COIN_RESTRICT elements = 
+      elements_+firstPivot*numberRows_;
+    for (int i=firstPivot;i<lastPivot;i++) {
+      CoinFactorizationDouble value = elementsA[i];
+      for (int j=i+1;j<lastPivot;j++) 
+	elementsA[j] -= value * elements[j];
+      elements += numberRows_;
+    }
+  }
+  // rest of rows - four columns at a time
+  for (int iRow=lastPivot;iRow<numberRows_;iRow+=COIN_DENSE_ROWS) {
+    int lastRow = CoinMin(iRow+COIN_DENSE_ROWS,numberRows_);
+    int k=first;
+    for (;k+4<=last;k+=4) {
+      CoinFactorizationDouble * COIN_RESTRICT elements0 = elements_+k*numberRows_;
+      CoinFactorizationDouble * COIN_RESTRICT elements1 = elements0+numberRows_;
+      CoinFactorizationDouble * COIN_RESTRICT elements2 = elements1+numberRows_;
+      CoinFactorizationDouble * COIN_RESTRICT elements3 = elements2+numberRows_;
+      const CoinFactorizationDouble * COIN_RESTRICT elements = 
+	elements_+firstPivot*numberRows_;
+      for (int i=firstPivot;i<lastPivot;i++) {
+	CoinFactorizationDouble value0 = elements0[i];
+	CoinFactorizationDouble value1 = elements1[i];
+	CoinFactorizationDouble value2 = elements2[i];
+	CoinFactorizationDouble value3 = elements3[i];
+	if (value0||value1||value2||value3) {
+	  for (int j=iRow;j<lastRow;j++) {
+	    CoinFactorizationDouble value = elements[j];
+	    elements0[j] -= value0 * value;
+	    elements1[j] -= value1 * value;
+	    elements2[j] -= value2 * value;
+	    elements3[j] -= value3 * value;
+	  }
+	}
+	elements += numberRows_;
+      }
+    }
+    for (;k<last;k++) {
+      CoinFactorizationDouble * COIN_RESTRICT elementsA = elements_+k*numberRows_;
+      const CoinFactorizationDouble * COIN_RESTRICT elements = 
+	elements_+firstPivot*numberRows_;
+      for (int i=firstPivot;i<lastPivot;i++) {
+	CoinFactorizationDouble value = elementsA[i];
+	if (value) {
+	  for (int j=iRow;j<lastRow;j++) 
+	    elementsA[j] -= value * elements[j];
+	}
+	elements += numberRows_;
+      }
+    }
+  }
+}
+/* Updates numberRhs dense columns held one after another in array
+   - see updateColumn and updateColumnTranspose */
+int 
+CoinDenseFactorization::updateColumns ( int numberRhs, double * array,
+					int leadingDimension, 
+					bool transpose) const
+{
+  assert (numberRows_==numberColumns_);
+  if (numberRhs<=0)
+    return 0;
+  int numberThreads = 1;
+#ifdef COINUTILS_PTHREADS
+  double work = static_cast<double>(numberRows_)*
+    static_cast<double>(numberRows_+numberPivots_)*numberRhs;
+  numberThreads = CoinMin(numberThreads_,
+			  static_cast<int>(work/COIN_DENSE_THREAD_WORK)+1);
+  numberThreads = CoinMin(numberThreads,(numberRhs+COIN_DENSE_RHS-1)/COIN_DENSE_RHS);
+  numberThreads = CoinMax(numberThreads,1);
+#endif
+  CoinFactorizationDouble * workArea = 
+    new CoinFactorizationDouble [numberThreads*COIN_DENSE_RHS*numberRows_];
+  if (numberThreads==1) {
+    updateBlock(numberRhs,array,leadingDimension,transpose,workArea);
+  } else {
+    CoinDenseThreadInfo * thread = new CoinDenseThreadInfo [numberThreads];
+    int chunk = (numberRhs+numberThreads-1)/numberThreads;
+    int start = 0;
+    int n = 0;
+    while (start<numberRhs) {
+      CoinDenseThreadInfo & info = thread[n];
+      memset(&info,0,sizeof(CoinDenseThreadInfo));
+      info.factorization = const_cast<CoinDenseFactorization *>(this);
+      info.array = array;
+      info.leadingDimension = leadingDimension;
+      info.transpose = transpose;
+      info.work = workArea+n*COIN_DENSE_RHS*numberRows_;
+      info.first = start;
+      start = CoinMin(start+chunk,numberRhs);
+      info.last = start;
+      n++;
+    }
+    runDenseWorkers(thread,n);
+    delete [] thread;
+  }
+  delete [] workArea;
+  return 0;
+}
+// Does work of updateColumns - work has room for COIN_DENSE_RHS columns
+void 
+CoinDenseFactorization::updateBlock(int numberRhs, double * array, 
+				    int leadingDimension, bool transpose,
+				    CoinFactorizationDouble * work) const
+{
+  bool lapack = false;
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+  lapack = (solveMode_%10)!=0;
+#endif
+  for (int iRhs=0;iRhs<numberRhs;iRhs+=COIN_DENSE_RHS) {
+    int nRhs = CoinMin(COIN_DENSE_RHS,numberRhs-iRhs);
+    double * arrayBlock = array+iRhs*leadingDimension;
+    // copy in 
+    for (int r=0;r<nRhs;r++) {
+      const double * COIN_RESTRICT column = arrayBlock+r*leadingDimension;
+      CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+      if (lapack) {
+	for (int j=0;j<numberRows_;j++) 
+	  region[j]=column[j];
+      } else if (!transpose) {
+	for (int j=0;j<numberRows_;j++) 
+	  region[j]=column[pivotRow_[j+numberRows_]];
+      } else {
+	for (int j=0;j<numberRows_;j++) 
+	  region[pivotRow_[j]]=column[j];
+      }
+    }
+    const CoinFactorizationDouble * elements;
+    if (!transpose) {
+      if (!lapack) {
+	// base factorization L
+	elements = elements_;
+	for (int i=0;i<numberColumns_;i++) {
+	  for (int r=0;r<nRhs;r++) {
+	    CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+	    CoinFactorizationDouble value = region[i];
+	    if (value) {
+	      for (int j=i+1;j<numberRows_;j++) 
+		region[j] -= value*elements[j];
+	    }
+	  }
+	  elements += numberRows_;
+	}
+	// base factorization U
+	elements = elements_+numberRows_*numberRows_;
+	for (int i=numberColumns_-1;i>=0;i--) {
+	  elements -= numberRows_;
+	  for (int r=0;r<nRhs;r++) {
+	    CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+	    CoinFactorizationDouble value = region[i]*elements[i];
+	    region[i] = value;
+	    if (value) {
+	      for (int j=0;j<i;j++) 
+		region[j] -= value*elements[j];
+	    }
+	  }
+	}
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+      } else {
+	char trans = 'N';
+	int info;
+	F77_FUNC(dgetrs,DGETRS)(&trans,const_cast<int *>(&numberRows_),&nRhs,
+				elements_,const_cast<int *>(&numberRows_),
+				pivotRow_,work,const_cast<int *>(&numberRows_),
+				&info,1);
+#endif
+      }
+      // now updates
+      elements = elements_+numberRows_*numberRows_;
+      for (int i=0;i<numberPivots_;i++) {
+	int iPivot = pivotRow_[i+2*numberRows_];
+	for (int r=0;r<nRhs;r++) {
+	  CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+	  CoinFactorizationDouble value = region[iPivot]*elements[iPivot];
+	  if (value) {
+	    for (int j=0;j<numberRows_;j++) 
+	      region[j] -= value*elements[j];
+	  }
+	  region[iPivot] = value;
+	}
+	elements += numberRows_;
+      }
+    } else {
+      // updates
+      elements = elements_+numberRows_*(numberRows_+numberPivots_);
+      for (int i=numberPivots_-1;i>=0;i--) {
+	elements -= numberRows_;
+	int iPivot = pivotRow_[i+2*numberRows_];
+	for (int r=0;r<nRhs;r++) {
+	  CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+	  CoinFactorizationDouble value = region[iPivot];
+	  for (int j=0;j<iPivot;j++) 
+	    value -= region[j]*elements[j];
+	  for (int j=iPivot+1;j<numberRows_;j++) 
+	    value -= region[j]*elements[j];
+	  region[iPivot] = value*elements[iPivot];
+	}
+      }
+      if (!lapack) {
+	// base factorization U
+	elements = elements_;
+	for (int i=0;i<numberColumns_;i++) {
+	  for (int r=0;r<nRhs;r++) {
+	    CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+	    CoinFactorizationDouble value = region[i];
+	    for (int j=0;j<i;j++) 
+	      value -= region[j]*elements[j];
+	    region[i] = value*elements[i];
+	  }
+	  elements += numberRows_;
+	}
+	// base factorization L
+	elements = elements_+numberRows_*numberRows_;
+	for (int i=numberColumns_-1;i>=0;i--) {
+	  elements -= numberRows_;
+	  for (int r=0;r<nRhs;r++) {
+	    CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+	    CoinFactorizationDouble value = region[i];
+	    for (int j=i+1;j<numberRows_;j++) 
+	      value -= region[j]*elements[j];
+	    region[i] = value;
+	  }
+	}
+#ifdef COIN_FACTORIZATION_DENSE_CODE
+      } else {
+	char trans = 'T';
+	int info;
+	F77_FUNC(dgetrs,DGETRS)(&trans,const_cast<int *>(&numberRows_),&nRhs,
+				elements_,const_cast<int *>(&numberRows_),
+				pivotRow_,work,const_cast<int *>(&numberRows_),
+				&info,1);
+#endif
+      }
+    }
+    // copy out
+    for (int r=0;r<nRhs;r++) {
+      double * COIN_RESTRICT column = arrayBlock+r*leadingDimension;
+      CoinFactorizationDouble * COIN_RESTRICT region = work+r*numberRows_;
+      for (int j=0;j<numberRows_;j++) {
+	int iRow = j;
+	int jRow = j;
+	if (!lapack) {
+	  if (!transpose)
+	    iRow = pivotRow_[j];
+	  else
+	    jRow = pivotRow_[j+numberRows_];
+	}
+	CoinFactorizationDouble value = region[iRow];
+	if (fabs(value)<=zeroTolerance_)
+	  value = 0.0;
+	column[jRow]=value;
+      }
+    }
+  }
+}
 // Default constructor
 CoinOtherFactorization::CoinOtherFactorization (  )
    :  pivotTolerance_(1.0e-1),
@@ -1050,3 +1407,387 @@ CoinOtherFactorization::wantsTableauColumn() const
 void 
 CoinOtherFactorization::setUsefulInformation(const int * ,int )
 { }
+/* CoinDenseBatchFactorization does everything as lane by lane
+   multiply-adds across a group of COIN_DENSE_BATCH_WIDTH (4) matrices.
+   COIN_DENSE_SIMD 1 allows AVX2 for these and 0 switches off.
+   Instruction set is chosen at run time so library can still be built
+   for generic x86.  Each lane gets same operations in same order whichever
+   is used. */
+#ifndef COIN_DENSE_SIMD
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+  && (defined(__x86_64__) || defined(__i386__))
+#define COIN_DENSE_SIMD 1
+#else
+#define COIN_DENSE_SIMD 0
+#endif
+#endif
+#if COIN_DENSE_BATCH_WIDTH != 4
+#undef COIN_DENSE_SIMD
+#define COIN_DENSE_SIMD 0
+#endif
+#if COIN_DENSE_SIMD
+#include <immintrin.h>
+// 0 not known, 1 none, 2 AVX2
+static int coinDenseSimdLevel = 0;
+static inline int coinDenseSimd()
+{
+  if (!coinDenseSimdLevel) {
+    int level = 1;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      level = 2;
+    coinDenseSimdLevel = level;
+  }
+  return coinDenseSimdLevel;
+}
+// y[4*k+l] -= x[4*k+l]*t[l]
+__attribute__((target("avx2"))) static void
+coinDenseBatchAxpyAvx2(double * COIN_RESTRICT y, const double * COIN_RESTRICT x,
+		       const double * COIN_RESTRICT t, int n)
+{
+  __m256d tt = _mm256_loadu_pd(t);
+  for (int k=0;k<n;k++) {
+    __m256d yy = _mm256_loadu_pd(y+4*k);
+    yy = _mm256_sub_pd(yy, _mm256_mul_pd(_mm256_loadu_pd(x+4*k), tt));
+    _mm256_storeu_pd(y+4*k, yy);
+  }
+}
+// sum[l] += x[4*k+l]*y[4*k+l]
+__attribute__((target("avx2"))) static void
+coinDenseBatchDotAvx2(const double * COIN_RESTRICT x, const double * COIN_RESTRICT y,
+		      int n, double * COIN_RESTRICT sum)
+{
+  __m256d ss = _mm256_loadu_pd(sum);
+  for (int k=0;k<n;k++) 
+    ss = _mm256_add_pd(ss, _mm256_mul_pd(_mm256_loadu_pd(x+4*k),
+					 _mm256_loadu_pd(y+4*k)));
+  _mm256_storeu_pd(sum, ss);
+}
+#endif
+// y[W*k+l] -= x[W*k+l]*t[l] for k < n (W is COIN_DENSE_BATCH_WIDTH)
+static inline void 
+coinDenseBatchAxpy(double * COIN_RESTRICT y, const double * COIN_RESTRICT x,
+		   const double * COIN_RESTRICT t, int n)
+{
+#if COIN_DENSE_SIMD
+  if (coinDenseSimd()==2) {
+    coinDenseBatchAxpyAvx2(y, x, t, n);
+    return;
+  }
+#endif
+  for (int k=0;k<n;k++) {
+    for (int l=0;l<COIN_DENSE_BATCH_WIDTH;l++)
+      y[l] -= x[l]*t[l];
+    y += COIN_DENSE_BATCH_WIDTH;
+    x += COIN_DENSE_BATCH_WIDTH;
+  }
+}
+// sum[l] += x[W*k+l]*y[W*k+l] for k < n
+static inline void 
+coinDenseBatchDot(const double * COIN_RESTRICT x, const double * COIN_RESTRICT y,
+		  int n, double * COIN_RESTRICT sum)
+{
+#if COIN_DENSE_SIMD
+  if (coinDenseSimd()==2) {
+    coinDenseBatchDotAvx2(x, y, n, sum);
+    return;
+  }
+#endif
+  for (int k=0;k<n;k++) {
+    for (int l=0;l<COIN_DENSE_BATCH_WIDTH;l++)
+      sum[l] += x[l]*y[l];
+    y += COIN_DENSE_BATCH_WIDTH;
+    x += COIN_DENSE_BATCH_WIDTH;
+  }
+}
+// Information for one thread of CoinDenseBatchFactorization
+typedef struct {
+  CoinDenseBatchFactorization * factorization;
+  int first;
+  int last;
+  double * rhs; // NULL for factor
+  bool transpose;
+  int numberSingular;
+} CoinDenseBatchThreadInfo;
+static void * 
+denseBatchWorker(void * info)
+{
+  CoinDenseBatchThreadInfo * thread = 
+    reinterpret_cast<CoinDenseBatchThreadInfo *>(info);
+  if (!thread->rhs) 
+    thread->numberSingular = 
+      thread->factorization->factorGroups(thread->first,thread->last);
+  else
+    thread->factorization->solveGroups(thread->first,thread->last,
+				       thread->rhs,thread->transpose);
+  return NULL;
+}
+// Splits groups between threads (rhs NULL for factor) and returns number singular
+static int
+runDenseBatch(CoinDenseBatchFactorization * factorization, int numberThreads,
+	      double * rhs, bool transpose)
+{
+  int numberGroups = factorization->numberGroups();
+  CoinDenseBatchThreadInfo * thread = new CoinDenseBatchThreadInfo [numberThreads];
+  for (int i=0;i<numberThreads;i++) {
+    CoinDenseBatchThreadInfo & info = thread[i];
+    info.factorization = factorization;
+    info.first = (numberGroups*i)/numberThreads;
+    info.last = (numberGroups*(i+1))/numberThreads;
+    info.rhs = rhs;
+    info.transpose = transpose;
+    info.numberSingular = 0;
+  }
+  CoinThreadPool::run(denseBatchWorker,thread,sizeof(CoinDenseBatchThreadInfo),
+		      numberThreads);
+  int numberSingular = 0;
+  for (int i=0;i<numberThreads;i++) 
+    numberSingular += thread[i].numberSingular;
+  delete [] thread;
+  return numberSingular;
+}
+// Default constructor
+CoinDenseBatchFactorization::CoinDenseBatchFactorization()
+  : numberMatrices_(0),
+    numberRows_(0),
+    zeroTolerance_(1.0e-13),
+    numberThreads_(1)
+{
+}
+// Gets space for numberMatrices zero matrices of order numberRows
+void 
+CoinDenseBatchFactorization::resize(int numberMatrices, int numberRows)
+{
+  assert (numberMatrices>=0&&numberRows>=0);
+  numberMatrices_ = numberMatrices;
+  numberRows_ = numberRows;
+  int numberGroups = this->numberGroups();
+  elements_.assign(static_cast<size_t>(numberGroups)*numberRows*numberRows
+		   *COIN_DENSE_BATCH_WIDTH,0.0);
+  swaps_.assign(static_cast<size_t>(numberGroups)*numberRows
+		*COIN_DENSE_BATCH_WIDTH,0);
+  status_.assign(numberGroups*COIN_DENSE_BATCH_WIDTH,0);
+  // unit matrices in padding so they factorize
+  for (int m=numberMatrices;m<numberGroups*COIN_DENSE_BATCH_WIDTH;m++) {
+    for (int i=0;i<numberRows;i++)
+      elements_[offset(m,i,i)] = 1.0;
+  }
+}
+// Sets matrix m to zero
+void 
+CoinDenseBatchFactorization::clearMatrix(int m)
+{
+  assert (m>=0&&m<numberMatrices_);
+  for (int j=0;j<numberRows_;j++) {
+    for (int i=0;i<numberRows_;i++)
+      elements_[offset(m,i,j)] = 0.0;
+  }
+}
+// Sets matrix m from column ordered array
+void 
+CoinDenseBatchFactorization::setMatrix(int m, const double * array, 
+				       int leadingDimension)
+{
+  assert (m>=0&&m<numberMatrices_);
+  for (int j=0;j<numberRows_;j++) {
+    double * column = &elements_[offset(m,0,j)];
+    for (int i=0;i<numberRows_;i++)
+      column[i*COIN_DENSE_BATCH_WIDTH] = array[i];
+    array += leadingDimension;
+  }
+}
+// Sets column j of matrix m from packed form
+void 
+CoinDenseBatchFactorization::setColumn(int m, int j, int numberElements,
+				       const int * rows, const double * elements)
+{
+  assert (m>=0&&m<numberMatrices_&&j>=0&&j<numberRows_);
+  double * column = &elements_[offset(m,0,j)];
+  for (int i=0;i<numberRows_;i++)
+    column[i*COIN_DENSE_BATCH_WIDTH] = 0.0;
+  for (int i=0;i<numberElements;i++) {
+    assert (rows[i]>=0&&rows[i]<numberRows_);
+    column[rows[i]*COIN_DENSE_BATCH_WIDTH] = elements[i];
+  }
+}
+// Factorizes all matrices and returns number which were singular
+int 
+CoinDenseBatchFactorization::factor()
+{
+  int numberGroups = this->numberGroups();
+  int numberThreads = 1;
+#ifdef COINUTILS_PTHREADS
+  double work = static_cast<double>(numberRows_)*numberRows_*numberRows_
+    *numberGroups/3.0;
+  numberThreads = CoinMin(numberThreads_,
+			  static_cast<int>(work/COIN_DENSE_THREAD_WORK)+1);
+  numberThreads = CoinMax(CoinMin(numberThreads,numberGroups),1);
+#endif
+  if (numberThreads==1)
+    return factorGroups(0,numberGroups);
+  else
+    return runDenseBatch(this,numberThreads,NULL,false);
+}
+// Solves B x = b (B' x = b if transpose) for every matrix
+void 
+CoinDenseBatchFactorization::solve(double * rhs, bool transpose) const
+{
+  int numberGroups = this->numberGroups();
+  int numberThreads = 1;
+#ifdef COINUTILS_PTHREADS
+  double work = static_cast<double>(numberRows_)*numberRows_*numberGroups;
+  numberThreads = CoinMin(numberThreads_,
+			  static_cast<int>(work/COIN_DENSE_THREAD_WORK)+1);
+  numberThreads = CoinMax(CoinMin(numberThreads,numberGroups),1);
+#endif
+  if (numberThreads==1)
+    solveGroups(0,numberGroups,rhs,transpose);
+  else
+    runDenseBatch(const_cast<CoinDenseBatchFactorization *>(this),
+		  numberThreads,rhs,transpose);
+}
+/* Factorizes groups first to last-1 and returns number singular.
+   Reciprocal of pivot is stored on diagonal as in CoinDenseFactorization.
+   Pivot is chosen lane by lane and rows swapped right across, then L
+   column is scaled and rest of matrix updated for whole group. */
+int 
+CoinDenseBatchFactorization::factorGroups(int first, int last)
+{
+  const int n = numberRows_;
+  const int W = COIN_DENSE_BATCH_WIDTH;
+  const size_t groupSize = static_cast<size_t>(n)*n*W;
+  int numberSingular = 0;
+  for (int iGroup=first;iGroup<last;iGroup++) {
+    double * elements = &elements_[0]+iGroup*groupSize;
+    int * swaps = &swaps_[0]+static_cast<size_t>(iGroup)*n*W;
+    int * status = &status_[0]+iGroup*W;
+    for (int l=0;l<W;l++)
+      status[l]=0;
+    for (int k=0;k<n;k++) {
+      double * columnK = elements+static_cast<size_t>(k)*n*W;
+      double pivotValue[COIN_DENSE_BATCH_WIDTH];
+      for (int l=0;l<W;l++) {
+	int iRow = -1;
+	// Find largest
+	double largest=zeroTolerance_;
+	for (int i=k;i<n;i++) {
+	  double value = fabs(columnK[i*W+l]);
+	  if (value>largest) {
+	    largest=value;
+	    iRow=i;
+	  }
+	}
+	if (iRow<0) {
+	  // drop pivot - L column and reciprocal are zero
+	  status[l]++;
+	  swaps[k*W+l]=k;
+	  for (int i=k;i<n;i++)
+	    columnK[i*W+l]=0.0;
+	  pivotValue[l]=0.0;
+	  continue;
+	}
+	swaps[k*W+l]=iRow;
+	if (iRow!=k) {
+	  double * elementsA = elements+l;
+	  for (int j=0;j<n;j++) {
+	    double value = elementsA[k*W];
+	    elementsA[k*W]=elementsA[iRow*W];
+	    elementsA[iRow*W]=value;
+	    elementsA += n*W;
+	  }
+	}
+	pivotValue[l]=1.0/columnK[k*W+l];
+      }
+      for (int l=0;l<W;l++)
+	columnK[k*W+l]=pivotValue[l];
+      for (int i=k+1;i<n;i++) {
+	for (int l=0;l<W;l++)
+	  columnK[i*W+l] *= pivotValue[l];
+      }
+      // Update rest of matrix
+      double * columnJ = columnK;
+      for (int j=k+1;j<n;j++) {
+	columnJ += n*W;
+	coinDenseBatchAxpy(columnJ+(k+1)*W,columnK+(k+1)*W,columnJ+k*W,n-k-1);
+      }
+    }
+    for (int l=0;l<W;l++) {
+      if (status[l]&&iGroup*W+l<numberMatrices_)
+	numberSingular++;
+    }
+  }
+  return numberSingular;
+}
+// Solves for groups first to last-1
+void 
+CoinDenseBatchFactorization::solveGroups(int first, int last, double * rhs,
+					 bool transpose) const
+{
+  const int n = numberRows_;
+  const int W = COIN_DENSE_BATCH_WIDTH;
+  const size_t groupSize = static_cast<size_t>(n)*n*W;
+  for (int iGroup=first;iGroup<last;iGroup++) {
+    const double * elements = &elements_[0]+iGroup*groupSize;
+    const int * swaps = &swaps_[0]+static_cast<size_t>(iGroup)*n*W;
+    double * region = rhs+static_cast<size_t>(iGroup)*n*W;
+    if (!transpose) {
+      // P
+      for (int k=0;k<n;k++) {
+	for (int l=0;l<W;l++) {
+	  int iRow = swaps[k*W+l];
+	  if (iRow!=k) {
+	    double value = region[k*W+l];
+	    region[k*W+l]=region[iRow*W+l];
+	    region[iRow*W+l]=value;
+	  }
+	}
+      }
+      // L
+      const double * columnK = elements;
+      for (int k=0;k<n-1;k++) {
+	coinDenseBatchAxpy(region+(k+1)*W,columnK+(k+1)*W,region+k*W,n-k-1);
+	columnK += n*W;
+      }
+      // U
+      for (int k=n-1;k>=0;k--) {
+	columnK = elements+static_cast<size_t>(k)*n*W;
+	for (int l=0;l<W;l++)
+	  region[k*W+l] *= columnK[k*W+l];
+	coinDenseBatchAxpy(region,columnK,region+k*W,k);
+      }
+    } else {
+      // U'
+      const double * columnK = elements;
+      for (int k=0;k<n;k++) {
+	double sum[COIN_DENSE_BATCH_WIDTH];
+	for (int l=0;l<W;l++)
+	  sum[l]=0.0;
+	coinDenseBatchDot(columnK,region,k,sum);
+	for (int l=0;l<W;l++)
+	  region[k*W+l] = (region[k*W+l]-sum[l])*columnK[k*W+l];
+	columnK += n*W;
+      }
+      // L'
+      for (int k=n-2;k>=0;k--) {
+	columnK = elements+static_cast<size_t>(k)*n*W;
+	double sum[COIN_DENSE_BATCH_WIDTH];
+	for (int l=0;l<W;l++)
+	  sum[l]=0.0;
+	coinDenseBatchDot(columnK+(k+1)*W,region+(k+1)*W,n-k-1,sum);
+	for (int l=0;l<W;l++)
+	  region[k*W+l] -= sum[l];
+      }
+      // P' - swaps in reverse order
+      for (int k=n-1;k>=0;k--) {
+	for (int l=0;l<W;l++) {
+	  int iRow = swaps[k*W+l];
+	  if (iRow!=k) {
+	    double value = region[k*W+l];
+	    region[k*W+l]=region[iRow*W+l];
+	    region[iRow*W+l]=value;
+	  }
+	}
+      }
+    }
+  }
+}
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <vector>
 #include "CoinTypes.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinFactorization.hpp"
@@ -150,6 +151,10 @@ public:
   virtual int * permute() const = 0;
   /// Total number of elements in factorization
   virtual int numberElements (  ) const = 0;
+  /** Number of nonzeros held in factors and updates.  Default is
+      numberElements() which for some classes is size of dense area */
+  virtual CoinBigIndex numberNonZeros (  ) const
+  { return numberElements();}
   //@}
   /**@name Do factorization - public */
   //@{
@@ -332,6 +337,12 @@ public:
   }
   /// Returns maximum absolute value in factorization
   double maximumCoefficient() const;
+  /** Number of threads used by factor and updateColumns
+      (only if built with COINUTILS_PTHREADS) */
+  inline int numberThreads() const
+  { return numberThreads_;}
+  inline void setNumberThreads(int value)
+  { numberThreads_ = CoinMax(1,value);}
   //@}
 
   /**@name rank one updates which do exist */
@@ -380,6 +391,13 @@ public:
   */
   virtual int updateColumnTranspose ( CoinIndexedVector * regionSparse,
 			      CoinIndexedVector * regionSparse2) const;
+  /** Updates numberRhs dense columns held one after another in array
+      (column i starts at array+i*leadingDimension).  Same result as
+      updateColumn (or updateColumnTranspose if transpose) on each one
+      unpacked, but factorization is passed once for a block of columns.
+      Values less than zero tolerance are set to zero */
+  int updateColumns ( int numberRhs, double * array,
+		      int leadingDimension, bool transpose=false) const;
   //@}
   /// *** Below this user may not want to know about
 
@@ -403,6 +421,13 @@ public:
   void gutsOfInitialize();
   /// The real work of copy
   void gutsOfCopy(const CoinDenseFactorization &other);
+  /** Applies numberPivots pivots of factor starting at firstPivot
+      (row interchanges in swaps) to columns first to last-1 */
+  void updateTrailing(int firstPivot, int numberPivots, const int * swaps,
+		      int first, int last);
+  /// Does work of updateColumns - work has room for numberRhs columns
+  void updateBlock(int numberRhs, double * array, int leadingDimension,
+		   bool transpose, CoinFactorizationDouble * work) const;
 
   //@}
 protected:
@@ -414,6 +439,122 @@ protected:
 
   /**@name data */
   //@{
+  /// Number of threads for factor and updateColumns
+  int numberThreads_;
+  //@}
+};
+/// Number of matrices interleaved in each group of a CoinDenseBatchFactorization
+#define COIN_DENSE_BATCH_WIDTH 4
+/** Factorizes and solves many small dense matrices of the same order together
+
+    Matrices are held in one buffer in groups of COIN_DENSE_BATCH_WIDTH
+    with the groups' elements interleaved, so element (i,j) of matrix m is
+    at elements()[offset(m,i,j)] and every multiply-add of factor and
+    solve is done for a whole group at once (with AVX2 if the processor
+    has it).  Groups are split between threads if built with
+    COINUTILS_PTHREADS and setNumberThreads is used.  Right hand sides are
+    interleaved the same way (see rhsOffset).
+
+    Each matrix is factorized as LU with partial pivoting.  A column with
+    no pivot larger than zero tolerance is dropped - solves give zero for
+    that variable and status of matrix is number dropped.
+
+    Subproblems of different sizes can each have a batch of their own.
+*/
+class CoinDenseBatchFactorization {
+public:
+  /**@name Matrices */
+  //@{
+  /// Gets space for numberMatrices zero matrices of order numberRows
+  void resize(int numberMatrices, int numberRows);
+  /// Sets matrix m to zero
+  void clearMatrix(int m);
+  /** Sets matrix m from column ordered array
+      (column j starts at array+j*leadingDimension) */
+  void setMatrix(int m, const double * array, int leadingDimension);
+  /// Sets column j of matrix m from packed form (other rows zero)
+  void setColumn(int m, int j, int numberElements,
+		 const int * rows, const double * elements);
+  /// Position of element (i,j) of matrix m in elements()
+  inline size_t offset(int m, int i, int j) const
+  { return (static_cast<size_t>(m/COIN_DENSE_BATCH_WIDTH)*numberRows_*numberRows_
+	    + static_cast<size_t>(j)*numberRows_ + i)*COIN_DENSE_BATCH_WIDTH
+      + m%COIN_DENSE_BATCH_WIDTH;}
+  /// Position of element i of right hand side of matrix m (see solve)
+  inline size_t rhsOffset(int m, int i) const
+  { return (static_cast<size_t>(m/COIN_DENSE_BATCH_WIDTH)*numberRows_ + i)
+      *COIN_DENSE_BATCH_WIDTH + m%COIN_DENSE_BATCH_WIDTH;}
+  /// Length of right hand side array for solve
+  inline size_t rhsLength() const
+  { return static_cast<size_t>(numberGroups())*numberRows_*COIN_DENSE_BATCH_WIDTH;}
+  /// Elements (factors after factor)
+  inline double * elements()
+  { return elements_.empty() ? NULL : &elements_[0];}
+  inline int numberMatrices() const
+  { return numberMatrices_;}
+  inline int numberRows() const
+  { return numberRows_;}
+  /// Number of groups (last may be padded with unit matrices)
+  inline int numberGroups() const
+  { return (numberMatrices_+COIN_DENSE_BATCH_WIDTH-1)/COIN_DENSE_BATCH_WIDTH;}
+  //@}
+
+  /**@name Factorize and solve */
+  //@{
+  /** Factorizes all matrices (overwriting them) and returns number
+      which were singular */
+  int factor();
+  /// 0 if matrix m was factorized OK, otherwise number of pivots dropped
+  inline int status(int m) const
+  { return status_[m];}
+  /** Solves B x = b (B' x = b if transpose) for every matrix.  rhs has
+      rhsLength() entries with b of matrix m at rhsOffset(m,i) and is
+      overwritten by x */
+  void solve(double * rhs, bool transpose=false) const;
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Pivots not larger than this are dropped
+  inline double zeroTolerance() const
+  { return zeroTolerance_;}
+  inline void setZeroTolerance(double value)
+  { zeroTolerance_ = value;}
+  /** Number of threads used by factor and solve
+      (only if built with COINUTILS_PTHREADS) */
+  inline int numberThreads() const
+  { return numberThreads_;}
+  inline void setNumberThreads(int value)
+  { numberThreads_ = CoinMax(1,value);}
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Default constructor (no matrices)
+  CoinDenseBatchFactorization();
+  //@}
+
+  /**@name Work for one thread which user may not want to know about */
+  //@{
+  /// Factorizes groups first to last-1 and returns number singular
+  int factorGroups(int first, int last);
+  /// Solves for groups first to last-1
+  void solveGroups(int first, int last, double * rhs, bool transpose) const;
+  //@}
+
+private:
+  /**@name Private member data */
+  //@{
+  /// Elements of each group interleaved (column ordered)
+  std::vector<double> elements_;
+  /// Row swapped with each pivot row for each matrix (interleaved)
+  std::vector<int> swaps_;
+  /// Status of each matrix (and padding)
+  std::vector<int> status_;
+  int numberMatrices_;
+  int numberRows_;
+  double zeroTolerance_;
+  int numberThreads_;
   //@}
 };
 #endif
@@ -128,6 +128,112 @@ CoinDenseVector<T>::operator/=(T value)
 
 //#############################################################################
 
+// Sum of n elements - halves are summed separately down to blocks which
+// are summed with four partial sums
+template <typename T> static double
+coinPairwiseSum(const T * elements, int n)
+{
+  if (n <= 128) {
+    double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+    int i = 0;
+    for ( ; i + 4 <= n; i += 4) {
+      sum0 += elements[i];
+      sum1 += elements[i+1];
+      sum2 += elements[i+2];
+      sum3 += elements[i+3];
+    }
+    for ( ; i < n; i++)
+      sum0 += elements[i];
+    return (sum0 + sum1) + (sum2 + sum3);
+  } else {
+    // keep blocks a multiple of four
+    int half = (n / 2) & ~3;
+    return coinPairwiseSum(elements, half) +
+      coinPairwiseSum(elements + half, n - half);
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T> double
+CoinDenseVector<T>::pairwiseSum() const
+{
+  return coinPairwiseSum(elements_, nElements_);
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T> double
+CoinDenseVector<T>::compensatedSum() const
+{
+  // Neumaier's variant which also copes with terms bigger than the sum
+  double sum = 0.0;
+  double correction = 0.0;
+  for (int i=0; i<nElements_; i++) {
+    double value = elements_[i];
+    double newSum = sum + value;
+    if (fabs(sum) >= fabs(value))
+      correction += (sum - newSum) + value;
+    else
+      correction += (value - newSum) + sum;
+    sum = newSum;
+  }
+  return sum + correction;
+}
+
+//#############################################################################
+
+template <typename T> void
+CoinDenseVector<T>::setLinearCombination(T alpha, const CoinDenseVector<T> & x,
+					 T beta, const CoinDenseVector<T> & y)
+{
+  assert(x.size() == y.size());
+  const int n = x.size();
+  if (n != nElements_) {
+    // this is neither x nor y
+    delete [] elements_;
+    elements_ = n ? new T[n] : NULL;
+    nElements_ = n;
+  }
+  const T * elementsX = x.getElements();
+  const T * elementsY = y.getElements();
+  for (int i=0; i<n; i++)
+    elements_[i] = alpha * elementsX[i] + beta * elementsY[i];
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T> void
+CoinDenseVector<T>::axpy(T alpha, const CoinDenseVector<T> & x)
+{
+  assert(x.size() == nElements_);
+  const T * elementsX = x.getElements();
+  for (int i=0; i<nElements_; i++)
+    elements_[i] += alpha * elementsX[i];
+}
+
+//-----------------------------------------------------------------------------
+
+template <typename T> double
+CoinDenseVector<T>::dotProduct(const CoinDenseVector<T> & x) const
+{
+  assert(x.size() == nElements_);
+  const T * elementsX = x.getElements();
+  double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+  int i = 0;
+  for ( ; i + 4 <= nElements_; i += 4) {
+    sum0 += static_cast<double>(elements_[i]) * elementsX[i];
+    sum1 += static_cast<double>(elements_[i+1]) * elementsX[i+1];
+    sum2 += static_cast<double>(elements_[i+2]) * elementsX[i+2];
+    sum3 += static_cast<double>(elements_[i+3]) * elementsX[i+3];
+  }
+  for ( ; i < nElements_; i++)
+    sum0 += static_cast<double>(elements_[i]) * elementsX[i];
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+//#############################################################################
+
 template <typename T> CoinDenseVector<T>::CoinDenseVector():
    nElements_(0),
    elements_(NULL)
@@ -124,28 +124,50 @@ public:
 
    /**@name norms, sum and scale */
    //@{
+   // The norms keep several partial results (combined at the end) so the
+   // loop has no single dependency chain and the compiler can unroll or
+   // vectorise it.  Results may differ in the last bit from a simple loop.
    /// 1-norm of vector
    inline T oneNorm() const {
-     T norm = 0;
-     for (int i=0; i<nElements_; i++)
-       norm += CoinAbs(elements_[i]);
-     return norm;
+     T norm0 = 0, norm1 = 0, norm2 = 0, norm3 = 0;
+     int i = 0;
+     for ( ; i + 4 <= nElements_; i += 4) {
+       norm0 += CoinAbs(elements_[i]);
+       norm1 += CoinAbs(elements_[i+1]);
+       norm2 += CoinAbs(elements_[i+2]);
+       norm3 += CoinAbs(elements_[i+3]);
+     }
+     for ( ; i < nElements_; i++)
+       norm0 += CoinAbs(elements_[i]);
+     return (norm0 + norm1) + (norm2 + norm3);
    }
    /// 2-norm of vector
    inline double twoNorm() const {
-     double norm = 0.;
-     for (int i=0; i<nElements_; i++)
-       norm += elements_[i] * elements_[i];
+     double norm0 = 0., norm1 = 0., norm2 = 0., norm3 = 0.;
+     int i = 0;
+     for ( ; i + 4 <= nElements_; i += 4) {
+       norm0 += static_cast<double>(elements_[i]) * elements_[i];
+       norm1 += static_cast<double>(elements_[i+1]) * elements_[i+1];
+       norm2 += static_cast<double>(elements_[i+2]) * elements_[i+2];
+       norm3 += static_cast<double>(elements_[i+3]) * elements_[i+3];
+     }
+     for ( ; i < nElements_; i++)
+       norm0 += static_cast<double>(elements_[i]) * elements_[i];
      // std namespace removed because it was causing a compile
      // problem with Microsoft Visual C++
-     return /*std::*/sqrt(norm);
+     return /*std::*/sqrt((norm0 + norm1) + (norm2 + norm3));
    }
    /// infinity-norm of vector
    inline T infNorm() const {
-     T norm = 0;
-     for (int i=0; i<nElements_; i++)
-       norm = CoinMax(norm, CoinAbs(elements_[i]));
-     return norm;
+     T norm0 = 0, norm1 = 0;
+     int i = 0;
+     for ( ; i + 2 <= nElements_; i += 2) {
+       norm0 = CoinMax(norm0, CoinAbs(elements_[i]));
+       norm1 = CoinMax(norm1, CoinAbs(elements_[i+1]));
+     }
+     if (i < nElements_)
+       norm0 = CoinMax(norm0, CoinAbs(elements_[i]));
+     return CoinMax(norm0, norm1);
    }
    /// sum of vector elements
    inline T sum() const {
@@ -154,6 +176,13 @@ public:
        sume += elements_[i];
      return sume;
    }
+   /** sum of vector elements by compensated (Kahan-Babuska) summation,
+       so the rounding error does not grow with the length of the vector */
+   double compensatedSum() const;
+   /** sum of vector elements by pairwise summation of blocks, so the
+       rounding error grows only with log of the length.  Nearly as
+       accurate as compensatedSum() and nearly as fast as sum() */
+   double pairwiseSum() const;
    /// scale vector elements
    inline void scale(T factor) {
      for (int i=0; i<nElements_; i++)
@@ -162,6 +191,23 @@ public:
    }
    //@}
 
+   /**@name Fused kernels
+
+   Each is one pass over the vectors and makes no temporary vector, so
+   <code>a.setLinearCombination(1.0,b,2.0,c)</code> costs one pass where
+   <code>a = b + 2.0*c</code> costs one for each operator.  Operands must
+   be the same size (asserted); this may be one of them.
+   */
+   //@{
+   /// this = alpha * x + beta * y (resized to the size of x)
+   void setLinearCombination(T alpha, const CoinDenseVector & x,
+			     T beta, const CoinDenseVector & y);
+   /// this += alpha * x
+   void axpy(T alpha, const CoinDenseVector & x);
+   /// Returns this . x (accumulated in double)
+   double dotProduct(const CoinDenseVector & x) const;
+   //@}
+
    /**@name Arithmetic operators. */
    //@{
    /// add <code>value</code> to every entry
@@ -184,6 +230,17 @@ public:
    CoinDenseVector(int size, T element=T());
    /** Copy constructors */
    CoinDenseVector(const CoinDenseVector &);
+#if COIN_HAS_MOVE
+   /** Move constructor (rhs is left empty) */
+   CoinDenseVector(CoinDenseVector && rhs) COIN_NOEXCEPT
+     : nElements_(rhs.nElements_), elements_(rhs.elements_)
+   { rhs.nElements_ = 0; rhs.elements_ = NULL; }
+   /** Move assignment - swaps with rhs, so the result of an arithmetic
+       operator is taken over rather than copied */
+   CoinDenseVector & operator=(CoinDenseVector && rhs) COIN_NOEXCEPT
+   { std::swap(nElements_, rhs.nElements_);
+     std::swap(elements_, rhs.elements_); return *this; }
+#endif
 
     /** Destructor */
    ~CoinDenseVector ();
@@ -205,7 +262,9 @@ private:
 
    <strong>NOTE</strong>: Because these methods return an object (they can't
    return a reference, though they could return a pointer...) they are
-   <em>very</em> inefficient...
+   <em>very</em> inefficient...  Chains such as <code>b + 2.0*c</code>
+   make a temporary for each operator; see the fused kernels
+   (setLinearCombination, axpy) for one pass versions.
  */
 //@{
 /// Return the sum of two dense vectors
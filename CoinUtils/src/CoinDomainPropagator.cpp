@@ -0,0 +1,345 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cmath>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinDomainPropagator.hpp"
+
+// Bounds this large are infinite
+#define COIN_PROPAGATE_INFINITY 1.0e30
+// Tolerance for rounding integer bounds
+#define COIN_PROPAGATE_INTEGER 1.0e-6
+
+static inline bool
+coinInfinite(double value)
+{
+  return fabs(value) >= COIN_PROPAGATE_INFINITY;
+}
+
+//#############################################################################
+CoinDomainPropagator::CoinDomainPropagator()
+  : numberColumns_(0),
+    numberRows_(0),
+    infeasibleRow_(-1),
+    infeasibleColumn_(-1),
+    numberRowsProcessed_(0),
+    feasibilityTolerance_(1.0e-7),
+    minimumImprovement_(1.0e-3)
+{
+}
+//-----------------------------------------------------------------------------
+void
+CoinDomainPropagator::load(const CoinPackedMatrix & matrix,
+			   const double * columnLower,
+			   const double * columnUpper,
+			   const char * integerType,
+			   const double * rowLower, const double * rowUpper)
+{
+  if (matrix.isColOrdered()) {
+    byColumn_ = matrix;
+    byRow_.reverseOrderedCopyOf(matrix);
+  } else {
+    byRow_ = matrix;
+    byColumn_.reverseOrderedCopyOf(matrix);
+  }
+  byRow_.removeGaps();
+  byColumn_.removeGaps();
+  numberRows_ = byRow_.getNumRows();
+  numberColumns_ = byRow_.getNumCols();
+  lower_.assign(columnLower, columnLower + numberColumns_);
+  upper_.assign(columnUpper, columnUpper + numberColumns_);
+  rowLower_.assign(rowLower, rowLower + numberRows_);
+  rowUpper_.assign(rowUpper, rowUpper + numberRows_);
+  integer_.assign(numberColumns_, 0);
+  if (integerType) {
+    for (int i = 0; i < numberColumns_; i++)
+      integer_[i] = integerType[i] ? 1 : 0;
+  }
+  minimum_.assign(numberRows_, 0.0);
+  maximum_.assign(numberRows_, 0.0);
+  numberMinimumInfinite_.assign(numberRows_, 0);
+  numberMaximumInfinite_.assign(numberRows_, 0);
+  const CoinBigIndex * rowStart = byRow_.getVectorStarts();
+  const int * column = byRow_.getIndices();
+  const double * element = byRow_.getElements();
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    double minimum = 0.0;
+    double maximum = 0.0;
+    int numberMinimumInfinite = 0;
+    int numberMaximumInfinite = 0;
+    for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow+1]; j++) {
+      int iColumn = column[j];
+      double value = element[j];
+      double low = value > 0.0 ? lower_[iColumn] : upper_[iColumn];
+      double high = value > 0.0 ? upper_[iColumn] : lower_[iColumn];
+      if (coinInfinite(low))
+	numberMinimumInfinite++;
+      else
+	minimum += value * low;
+      if (coinInfinite(high))
+	numberMaximumInfinite++;
+      else
+	maximum += value * high;
+    }
+    minimum_[iRow] = minimum;
+    maximum_[iRow] = maximum;
+    numberMinimumInfinite_[iRow] = numberMinimumInfinite;
+    numberMaximumInfinite_[iRow] = numberMaximumInfinite;
+  }
+  trail_.clear();
+  activityTrail_.clear();
+  lastChange_.assign(2 * numberColumns_, -1);
+  queue_.clear();
+  inQueue_.assign(numberRows_, 0);
+  infeasibleRow_ = -1;
+  infeasibleColumn_ = -1;
+  numberRowsProcessed_ = 0;
+  queueAllRows();
+}
+//-----------------------------------------------------------------------------
+void
+CoinDomainPropagator::queueAllRows()
+{
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    queueRow(iRow);
+}
+//-----------------------------------------------------------------------------
+void
+CoinDomainPropagator::clearQueue()
+{
+  for (size_t i = 0; i < queue_.size(); i++)
+    inQueue_[queue_[i]] = 0;
+  queue_.clear();
+}
+//-----------------------------------------------------------------------------
+double
+CoinDomainPropagator::minimumActivity(int iRow) const
+{
+  return numberMinimumInfinite_[iRow] ? -COIN_DBL_MAX : minimum_[iRow];
+}
+//-----------------------------------------------------------------------------
+double
+CoinDomainPropagator::maximumActivity(int iRow) const
+{
+  return numberMaximumInfinite_[iRow] ? COIN_DBL_MAX : maximum_[iRow];
+}
+//-----------------------------------------------------------------------------
+void
+CoinDomainPropagator::setBound(int iColumn, bool isUpper, double value,
+			       int reason)
+{
+  double & bound = isUpper ? upper_[iColumn] : lower_[iColumn];
+  int & last = lastChange_[2 * iColumn + (isUpper ? 1 : 0)];
+  boundChange change;
+  change.oldValue = bound;
+  change.newValue = value;
+  change.column = iColumn;
+  change.reason = reason;
+  change.previous = last;
+  change.activityStart = static_cast<int>(activityTrail_.size());
+  change.isUpper = isUpper ? 1 : 0;
+  last = static_cast<int>(trail_.size());
+  trail_.push_back(change);
+  bool oldInfinite = coinInfinite(bound);
+  bool newInfinite = coinInfinite(value);
+  const CoinBigIndex * columnStart = byColumn_.getVectorStarts();
+  const int * row = byColumn_.getIndices();
+  const double * element = byColumn_.getElements();
+  for (CoinBigIndex j = columnStart[iColumn]; j < columnStart[iColumn+1]; j++) {
+    int iRow = row[j];
+    double elementValue = element[j];
+    savedActivity saved;
+    saved.minimum = minimum_[iRow];
+    saved.maximum = maximum_[iRow];
+    saved.row = iRow;
+    saved.numberMinimumInfinite = numberMinimumInfinite_[iRow];
+    saved.numberMaximumInfinite = numberMaximumInfinite_[iRow];
+    activityTrail_.push_back(saved);
+    // lower bound of positive or upper of negative element gives minimum
+    bool isMinimum = (elementValue > 0.0) != isUpper;
+    double & activity = isMinimum ? minimum_[iRow] : maximum_[iRow];
+    int & numberInfinite = isMinimum ? numberMinimumInfinite_[iRow] :
+      numberMaximumInfinite_[iRow];
+    if (oldInfinite)
+      numberInfinite--;
+    else
+      activity -= elementValue * bound;
+    if (newInfinite)
+      numberInfinite++;
+    else
+      activity += elementValue * value;
+    queueRow(iRow);
+  }
+  bound = value;
+}
+//-----------------------------------------------------------------------------
+int
+CoinDomainPropagator::changeLower(int iColumn, double value, int reason)
+{
+  if (integer_[iColumn])
+    value = ceil(value - COIN_PROPAGATE_INTEGER);
+  if (value <= lower_[iColumn])
+    return 0;
+  if (value > upper_[iColumn] + feasibilityTolerance_)
+    return 1;
+  if (value > upper_[iColumn])
+    value = upper_[iColumn];
+  setBound(iColumn, false, value, reason);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+int
+CoinDomainPropagator::changeUpper(int iColumn, double value, int reason)
+{
+  if (integer_[iColumn])
+    value = floor(value + COIN_PROPAGATE_INTEGER);
+  if (value >= upper_[iColumn])
+    return 0;
+  if (value < lower_[iColumn] - feasibilityTolerance_)
+    return 1;
+  if (value < lower_[iColumn])
+    value = lower_[iColumn];
+  setBound(iColumn, true, value, reason);
+  return 0;
+}
+//-----------------------------------------------------------------------------
+/* Upper side: sum a x <= rowUpper gives, for each column, a bound from the
+   minimum activity of the rest of the row.  Lower side is the same with
+   the maximum activity and the inequality reversed.  Tightening from one
+   side only moves the other activity, so the activity used stays the same
+   while the row is scanned. */
+bool
+CoinDomainPropagator::propagateRow(int iRow, bool upperSide,
+				   int & numberChanged)
+{
+  double rhs = upperSide ? rowUpper_[iRow] : rowLower_[iRow];
+  if (coinInfinite(rhs))
+    return true;
+  int numberInfinite = upperSide ? numberMinimumInfinite_[iRow] :
+    numberMaximumInfinite_[iRow];
+  if (numberInfinite > 1)
+    return true;
+  double activity = upperSide ? minimum_[iRow] : maximum_[iRow];
+  double slack = rhs - activity;
+  double tolerance = feasibilityTolerance_ * CoinMax(1.0, fabs(rhs));
+  if (!numberInfinite) {
+    if (upperSide ? slack < -tolerance : slack > tolerance) {
+      infeasibleRow_ = iRow;
+      return false;
+    }
+  }
+  const CoinBigIndex * rowStart = byRow_.getVectorStarts();
+  const int * column = byRow_.getIndices();
+  const double * element = byRow_.getElements();
+  for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow+1]; j++) {
+    int iColumn = column[j];
+    double value = element[j];
+    // bound which this column contributes to activity
+    bool fromLower = (value > 0.0) == upperSide;
+    double bound = fromLower ? lower_[iColumn] : upper_[iColumn];
+    double newBound;
+    if (numberInfinite) {
+      // only the column with the infinite contribution can be bounded
+      if (!coinInfinite(bound))
+	continue;
+      newBound = slack / value;
+    } else {
+      newBound = bound + slack / value;
+    }
+    // positive element on upper side (or negative on lower) gives upper
+    bool isUpper = fromLower;
+    double current = isUpper ? upper_[iColumn] : lower_[iColumn];
+    if (coinInfinite(newBound))
+      continue;
+    if (integer_[iColumn]) {
+      newBound = isUpper ? floor(newBound + COIN_PROPAGATE_INTEGER) :
+	ceil(newBound - COIN_PROPAGATE_INTEGER);
+      if (isUpper ? newBound > current - 0.5 : newBound < current + 0.5)
+	continue;
+    } else if (!coinInfinite(current)) {
+      double step = minimumImprovement_ * CoinMax(1.0, fabs(current));
+      if (isUpper ? newBound > current - step : newBound < current + step)
+	continue;
+    }
+    double other = isUpper ? lower_[iColumn] : upper_[iColumn];
+    if (isUpper ? newBound < other : newBound > other) {
+      if (fabs(newBound - other) > feasibilityTolerance_ *
+	  CoinMax(1.0, fabs(other))) {
+	infeasibleRow_ = iRow;
+	infeasibleColumn_ = iColumn;
+	return false;
+      }
+      newBound = other;
+      if (newBound == current)
+	continue;
+    }
+    setBound(iColumn, isUpper, newBound, iRow);
+    numberChanged++;
+    if (numberInfinite)
+      break;
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+int
+CoinDomainPropagator::propagate()
+{
+  infeasibleRow_ = -1;
+  infeasibleColumn_ = -1;
+  int numberChanged = 0;
+  size_t next = 0;
+  while (next < queue_.size()) {
+    int iRow = queue_[next++];
+    inQueue_[iRow] = 0;
+    numberRowsProcessed_++;
+    if (!propagateRow(iRow, true, numberChanged) ||
+	!propagateRow(iRow, false, numberChanged)) {
+      clearQueue();
+      return -1;
+    }
+    // keep worklist from growing without end
+    if (next > 1024 && 2 * next > queue_.size()) {
+      queue_.erase(queue_.begin(), queue_.begin() + next);
+      next = 0;
+    }
+  }
+  queue_.clear();
+  return numberChanged;
+}
+//-----------------------------------------------------------------------------
+void
+CoinDomainPropagator::backtrack(int markTrail)
+{
+  assert (markTrail >= 0 && markTrail <= mark());
+  clearQueue();
+  infeasibleRow_ = -1;
+  infeasibleColumn_ = -1;
+  for (int k = mark() - 1; k >= markTrail; k--) {
+    const boundChange & change = trail_[k];
+    int iColumn = change.column;
+    if (change.isUpper)
+      upper_[iColumn] = change.oldValue;
+    else
+      lower_[iColumn] = change.oldValue;
+    lastChange_[2 * iColumn + change.isUpper] = change.previous;
+    for (int j = static_cast<int>(activityTrail_.size()) - 1;
+	 j >= change.activityStart; j--) {
+      const savedActivity & saved = activityTrail_[j];
+      int iRow = saved.row;
+      minimum_[iRow] = saved.minimum;
+      maximum_[iRow] = saved.maximum;
+      numberMinimumInfinite_[iRow] = saved.numberMinimumInfinite;
+      numberMaximumInfinite_[iRow] = saved.numberMaximumInfinite;
+    }
+    activityTrail_.resize(change.activityStart);
+  }
+  trail_.resize(markTrail);
+}
@@ -0,0 +1,219 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinDomainPropagator_H
+#define CoinDomainPropagator_H
+
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+
+/** Bound propagation for nodes of branch and bound
+
+    Each row keeps its minimum and maximum activity over the current
+    bounds as a finite part and a count of infinite contributions, as
+    presolve does, but kept up to date as bounds change: changing a bound
+    of a column updates just the rows of that column and puts them on a
+    worklist.  propagate takes rows off the worklist and tightens bounds
+    of their columns from the activity of the rest of the row (a row
+    with one infinite contribution can still bound that column),
+    rounding for integer columns, until nothing changes or a row or
+    column is infeasible.
+
+    Every change goes on a trail with its old value and its reason - the
+    row which implied it, or -1 for a branching or other outside change.
+    Which side of the row follows from the sign of the element and
+    whether it was a lower or an upper bound.  lastChange gives the trail
+    position of the latest change of each bound, and each trail entry the
+    one before it for the same bound, so conflict analysis can walk back
+    from an infeasible row to the branchings behind it.
+
+    mark and backtrack undo to an earlier state: old activities of rows
+    are kept on the trail too, so undoing is exact and costs only what
+    the changes did.  A search keeps one propagator, marks on entering a
+    node and backtracks on leaving it.
+
+    Bounds of 1.0e30 or more in size are infinite.
+*/
+class CoinDomainPropagator {
+public:
+  /**@name Loading and changing bounds */
+  //@{
+  /** Loads problem (matrix row or column ordered).  integerType may be
+      NULL (all continuous).  Trail is emptied */
+  void load(const CoinPackedMatrix & matrix,
+	    const double * columnLower, const double * columnUpper,
+	    const char * integerType,
+	    const double * rowLower, const double * rowUpper);
+  /** Raises lower bound of column (nothing if not higher).  reason is row
+      or -1.  Returns 1 if then above upper bound (and bounds are not
+      changed), otherwise 0 */
+  int changeLower(int iColumn, double value, int reason = -1);
+  /// Lowers upper bound of column (as changeLower)
+  int changeUpper(int iColumn, double value, int reason = -1);
+  /** Propagates rows on worklist.  Returns number of bounds changed or
+      -1 if infeasible (see infeasibleRow) */
+  int propagate();
+  /** Puts all rows on worklist (as after load) */
+  void queueAllRows();
+  //@}
+
+  /**@name Undoing */
+  //@{
+  /// Position on trail to backtrack to
+  inline int mark() const
+  { return static_cast<int>(trail_.size());}
+  /// Undoes all changes after mark (and empties worklist)
+  void backtrack(int markTrail);
+  //@}
+
+  /**@name Current state */
+  //@{
+  /// Number of columns
+  inline int numberColumns() const
+  { return numberColumns_;}
+  /// Number of rows
+  inline int numberRows() const
+  { return numberRows_;}
+  /// Current lower bounds
+  inline const double * lower() const
+  { return &lower_[0];}
+  /// Current upper bounds
+  inline const double * upper() const
+  { return &upper_[0];}
+  /// Minimum activity of row (-COIN_DBL_MAX if unbounded)
+  double minimumActivity(int iRow) const;
+  /// Maximum activity of row (COIN_DBL_MAX if unbounded)
+  double maximumActivity(int iRow) const;
+  /// Row found infeasible by last propagate (-1 if none or a column was)
+  inline int infeasibleRow() const
+  { return infeasibleRow_;}
+  /// Column found infeasible by last propagate (-1 if none)
+  inline int infeasibleColumn() const
+  { return infeasibleColumn_;}
+  //@}
+
+  /**@name Trail (for conflict analysis) */
+  //@{
+  /// Column of change
+  inline int changeColumn(int which) const
+  { return trail_[which].column;}
+  /// True if change was of upper bound
+  inline bool changeIsUpper(int which) const
+  { return trail_[which].isUpper != 0;}
+  /// Value before change
+  inline double changeOldValue(int which) const
+  { return trail_[which].oldValue;}
+  /// Value after change
+  inline double changeNewValue(int which) const
+  { return trail_[which].newValue;}
+  /// Row which implied change (-1 if from outside)
+  inline int changeReason(int which) const
+  { return trail_[which].reason;}
+  /// Previous change of same bound (-1 if none)
+  inline int changePrevious(int which) const
+  { return trail_[which].previous;}
+  /// Latest change of a bound of column (-1 if none)
+  inline int lastChange(int iColumn, bool isUpper) const
+  { return lastChange_[2*iColumn+(isUpper ? 1 : 0)];}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Feasibility tolerance (default 1.0e-7)
+  inline double feasibilityTolerance() const
+  { return feasibilityTolerance_;}
+  inline void setFeasibilityTolerance(double value)
+  { feasibilityTolerance_ = value;}
+  /** Smallest change of a continuous bound which is made, relative to
+      the larger of 1.0 and the bound (default 1.0e-3) */
+  inline double minimumImprovement() const
+  { return minimumImprovement_;}
+  inline void setMinimumImprovement(double value)
+  { minimumImprovement_ = value;}
+  /// Rows looked at by propagate since load
+  inline int numberRowsProcessed() const
+  { return numberRowsProcessed_;}
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Default constructor
+  CoinDomainPropagator();
+  //@}
+
+private:
+  /// One change of a bound
+  typedef struct {
+    double oldValue;
+    double newValue;
+    int column;
+    int reason;
+    int previous;
+    // where saved activities of this change start
+    int activityStart;
+    char isUpper;
+  } boundChange;
+  /// Activity of a row before a change
+  typedef struct {
+    double minimum;
+    double maximum;
+    int row;
+    int numberMinimumInfinite;
+    int numberMaximumInfinite;
+  } savedActivity;
+
+  /**@name Private methods */
+  //@{
+  /// Changes bound and activities of rows of column, putting rows on worklist
+  void setBound(int iColumn, bool isUpper, double value, int reason);
+  /// Tightens bounds from one side of row - false if infeasible
+  bool propagateRow(int iRow, bool upperSide, int & numberChanged);
+  /// Puts row on worklist
+  inline void queueRow(int iRow)
+  { if (!inQueue_[iRow]) { inQueue_[iRow] = 1; queue_.push_back(iRow);}}
+  /// Empties worklist
+  void clearQueue();
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Row copy
+  CoinPackedMatrix byRow_;
+  /// Column copy
+  CoinPackedMatrix byColumn_;
+  /// Current bounds
+  std::vector<double> lower_;
+  std::vector<double> upper_;
+  /// Row bounds
+  std::vector<double> rowLower_;
+  std::vector<double> rowUpper_;
+  /// Integer columns
+  std::vector<char> integer_;
+  /// Finite parts of activities
+  std::vector<double> minimum_;
+  std::vector<double> maximum_;
+  /// Infinite contributions to activities
+  std::vector<int> numberMinimumInfinite_;
+  std::vector<int> numberMaximumInfinite_;
+  /// Worklist
+  std::vector<int> queue_;
+  std::vector<char> inQueue_;
+  /// Trail
+  std::vector<boundChange> trail_;
+  std::vector<savedActivity> activityTrail_;
+  /// Latest change of each bound (lower then upper for each column)
+  std::vector<int> lastChange_;
+  int numberColumns_;
+  int numberRows_;
+  int infeasibleRow_;
+  int infeasibleColumn_;
+  int numberRowsProcessed_;
+  double feasibilityTolerance_;
+  double minimumImprovement_;
+  //@}
+};
+
+#endif
@@ -22,6 +22,12 @@
 #include "CoinIndexedVector.hpp"
 
 class CoinPackedMatrix;
+/* Pivots in sparse factorization with more than this many updates
+   (rows times columns) share their columns between threads if
+   numberThreads is set */
+#ifndef COIN_FACTORIZATION_PARALLEL_PIVOT
+#define COIN_FACTORIZATION_PARALLEL_PIVOT 100000.0
+#endif
 /** This deals with Factorization and Updates
 
     This class started with a parallel simplex code I was writing in the
@@ -75,6 +81,19 @@ public:
   void sort (  ) const;
   /// = copy
     CoinFactorization & operator = ( const CoinFactorization & other );
+  /** Copies factorization of other as operator = would, but keeps this
+      object's arrays where they are big enough, so a worker can take a
+      copy of a shared factorization without allocating each time.
+      Switches on persistence (see setPersistenceFlag) if it is off. */
+  void cloneFactorization ( const CoinFactorization & other );
+  /** Writes factorization to a binary file (native byte order) which
+      readFactorization can restore without factorizing.  Only the parts
+      of the arrays in use are written.  Returns 0 if OK */
+  int writeFactorization ( const char * file ) const;
+  /** Restores factorization written by writeFactorization.  Returns 0 if
+      OK, -1 if file could not be opened and -2 if file is not valid
+      (when factorization is left empty) */
+  int readFactorization ( const char * file );
   //@}
 
   /**@name Do factorization */
@@ -128,6 +147,30 @@ public:
   int factorizePart2 (int permutation[],int exactNumberElements);
   /// Condition number - product of pivots after factorization
   double conditionNumber() const;
+  /** Estimate of 1-norm condition number of basis (Hager/Higham).
+      This is basisNorm times inverseNormEstimate so costs a few
+      updateColumn and updateColumnTranspose calls.  The norm of the basis
+      is as at factorization - columns replaced since are not included */
+  double conditionEstimate ( CoinIndexedVector * regionSparse,
+			     CoinIndexedVector * regionSparse2,
+			     int maximumIterations = 5) const;
+  /** Estimate of 1-norm of inverse of basis (Hager/Higham).  Each
+      iteration is one FTRAN and one BTRAN; the estimate is a lower bound
+      and almost always within a factor of 3.  regionSparse is as for
+      updateColumn and regionSparse2 must be empty and as long as for
+      updateColumn.  Both are left empty (in mode regionSparse2 had) */
+  double inverseNormEstimate ( CoinIndexedVector * regionSparse,
+			       CoinIndexedVector * regionSparse2,
+			       int maximumIterations = 5) const;
+  /// Largest column 1-norm of basis at factorization
+  inline double basisNorm() const
+    { return basisNorm_;}
+  /** Growth in sparse factorization - largest element in any column
+      of the pivot rows when they were pivoted on divided by largest
+      element of basis.  Large values (say 1.0e8) mean trouble is coming
+      and pivotTolerance should be raised before checkPivot fails */
+  inline double growthFactor() const
+    { return growthFactor_;}
   
   //@}
 
@@ -262,6 +305,114 @@ public:
   /// Sets dense threshold
   inline void setDenseThreshold(int value)
     { denseThreshold_ = value;}
+  /// Gets supernode threshold
+  inline int supernodeThreshold() const 
+    { return supernodeThreshold_;}
+  /** Sets supernode threshold - runs of at least this many consecutive
+      columns of L or U with identical row pattern are solved as blocks
+      in densish FTRAN.  0 (default) switches off.  Takes effect at
+      next factorization */
+  inline void setSupernodeThreshold(int value)
+    { supernodeThreshold_ = value;}
+  /// Whether FTRAN L kernel is chosen per solve
+  inline bool adaptiveSparse() const 
+    { return adaptiveSparse_;}
+  /** Sets adaptive choice of FTRAN L kernel.  When on (and sparse
+      technology is in use) each solve predicts its output count from
+      recent solves, and small inputs first find their reach in L by depth
+      first search, giving up once it passes sparseThreshold.  The last
+      reach found is kept so a solve with the same input pattern skips the
+      search.  Off by default */
+  inline void setAdaptiveSparse(bool yesNo)
+    { adaptiveSparse_ = yesNo;}
+  /// Number of threads used in sparse factorization
+  inline int numberThreads() const 
+    { return numberThreads_;}
+  /** Sets number of threads for sparse factorization.  Large pivots
+      share the update of their columns among this many threads, the
+      row lists and counts being done afterwards in the same order, so
+      the factorization is as it would be with one thread.  On large
+      bases the column passes of preProcess (largest element first,
+      taking out slack rows) are shared the same way.  Needs
+      COINUTILS_PTHREADS, otherwise stays at 1 */
+  void setNumberThreads(int value);
+  /// Whether L and U are also kept in float
+  inline bool mixedPrecision() const 
+    { return mixedPrecision_;}
+  /** Sets mixed precision solves.  When on, each factorization also
+      keeps the elements of L and U as float and updateColumn (not the FT
+      or transpose updates) reads those in densish solves, accumulating
+      in double.  Float U is only used until the first update.  Solutions
+      are then only good to about single precision - see
+      updateColumnRefined.  Takes effect at next factorization.  Off by
+      default */
+  inline void setMixedPrecision(bool yesNo)
+    { mixedPrecision_ = yesNo;}
+  /// Whether pivot order of last factorization is followed
+  inline bool reusePivotOrder() const 
+    { return reusePivotOrder_;}
+  /** Sets reuse of pivot order.  When on, factorize (the version given
+      basic variables) remembers the variable and row of each pivot in
+      the sparse phase and the next factorization takes the same pivots
+      again where the variable is still basic, so skipping the Markowitz
+      search.  Each pivot must still pass the pivot tolerance; the first
+      that does not sends the rest back to the normal search.  Once the
+      factors grow to more than 10% above those of the last searched
+      factorization the order is dropped and searched for again.  Off by
+      default */
+  inline void setReusePivotOrder(bool yesNo)
+    { reusePivotOrder_ = yesNo; numberPivotOrder_ = 0;}
+  /// Number of pivots taken from last pivot order at last factorization
+  inline int numberFollowedPivots() const 
+    { return numberFollowed_;}
+  /// Maximum number of updates kept out of row copy of U
+  inline int lazyRowCopyU() const 
+    { return lazyRowCopyU_;}
+  /** Sets lazy maintenance of row copy of U.  When positive, replaceColumn
+      does not add the new column of U to the row copy; up to this many new
+      columns are kept pending and then added in one batch.  BTRAN and
+      replaceColumn use the pending columns by column.  Other users of the
+      row copy (replaceRow, emptyRows, saving) add them first.  0 (default)
+      switches off - setting 0 adds any pending columns */
+  void setLazyRowCopyU(int value);
+  /// Number of R etas merged into a block
+  inline int blockSizeR() const 
+    { return blockSizeR_;}
+  /** Sets merging of R etas.  When positive, each time this many
+      Forrest-Tomlin updates have been done their R etas are also stored as
+      one dense block over the union of their rows - if they do not
+      refer to each other and the block is at least half full.  Densish
+      BTRAN and dot product FTRAN of R then do a block with one gather or
+      scatter of its rows.  At most 32, 0 (default) switches off */
+  void setBlockSizeR(int value);
+  /// Adaptive control of refactorization and areas (0 off)
+  inline int adaptiveRefactor() const 
+    { return adaptiveRefactor_;}
+  /** Sets adaptive control of refactorization and areas.  When on,
+      factorize tries again with larger areas rather than returning -99,
+      and areaFactor is left at what this model needed - raised when
+      factorization or updates ran out of room, lowered a little when
+      most of the areas were not used - so later factorizations of the
+      model get it right first time.  replaceColumn also sets
+      refactorizationRecommended once refactorizing is cheaper than going
+      on with updates.  1 just records that, 2 also makes replaceColumn
+      return 3 then.  0 (default) switches off */
+  inline void setAdaptiveRefactor(int value)
+    { adaptiveRefactor_ = value;}
+  /** True if (with adaptive control) refactorizing now would be cheaper
+      than more updates.  Every solve passes the elements updates have
+      added since factorization, while refactorizing costs refactorWork
+      times the elements of the factorization.  Refactorizing is
+      recommended once that would bring down the average work per update
+      since factorization */
+  inline bool refactorizationRecommended() const 
+    { return refactorRecommended_;}
+  /// Work of refactorizing per element of factorization
+  inline double refactorWork() const 
+    { return refactorWork_;}
+  /// Sets work of refactorizing per element of factorization (default 64)
+  inline void setRefactorWork(double value)
+    { refactorWork_ = value;}
   /// Pivot tolerance
   inline double pivotTolerance (  ) const {
     return pivotTolerance_ ;
@@ -378,6 +529,24 @@ public:
 		      double pivotCheck ,
 		      bool checkBeforeModifying=false,
 		      double acceptablePivot=1.0e-8);
+  /** Replaces numberColumns columns of basis one after another, as
+      updateColumnFT followed by replaceColumn (or replaceColumnPFI)
+      would for each in turn.  columns[i] is i'th incoming column (not
+      packed) and pivotRow[i] the row it replaces.  As L does not change
+      with updates the L parts are done first, densish ones together in
+      one pass through L.  If there are not enough pivots left for all
+      of them nothing is changed and 5 is returned.
+      numberDone gives how many went in.  Those (and one which failed)
+      hold updated column with respect to basis at that stage, any
+      others are left empty.
+      returns worst replaceColumn status, stopping at first >1 */
+  int replaceColumns ( int numberColumns,
+		       CoinIndexedVector * regionSparse,
+		       CoinIndexedVector ** columns,
+		       const int pivotRow[],
+		       int & numberDone,
+		       bool checkBeforeModifying=false,
+		       double acceptablePivot=1.0e-8);
   /** Combines BtranU and delete elements
       If deleted is NULL then delete elements
       otherwise store where elements are
@@ -504,7 +673,8 @@ public:
       Tries to do FT update
       number returned is negative if no room.
       Also updates region3
-      region1 starts as zero and is zero at end */
+      region1 starts as zero and is zero at end.
+      region2 and region3 may each be packed or not and come back so */
   int updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
 			   CoinIndexedVector * regionSparse2,
 			   CoinIndexedVector * regionSparse3,
@@ -515,6 +685,56 @@ public:
   */
   int updateColumnTranspose ( CoinIndexedVector * regionSparse,
 			      CoinIndexedVector * regionSparse2) const;
+  /** Updates one column (FTRAN) as updateColumn and then refines the
+      solution against the basis taken from matrix, rowIsBasic and
+      columnIsBasic as returned by factorize(matrix,...).  While largest
+      residual relative to |B||x|+|b| is above tolerance a correction is
+      solved for and added (at most maximumPasses times).  Meant for
+      mixed precision but works in any mode.  If regionSparse2 is packed
+      it is unpacked while working and packed again at end.  Returns number of corrections made or -1 if residual
+      still above tolerance (solution is then best found)
+  */
+  int updateColumnRefined ( CoinIndexedVector * regionSparse,
+			    CoinIndexedVector * regionSparse2,
+			    const CoinPackedMatrix & matrix,
+			    const int rowIsBasic[],
+			    const int columnIsBasic[],
+			    int maximumPasses=3,
+			    double tolerance=1.0e-12) const;
+  /** Updates numberColumns independent columns (FTRAN).
+      Each regionSparse2[i] is treated exactly as by updateColumn
+      (result is un-permuted, packed mode is kept) but the columns are
+      shared out between numberThreads workers, each with its own scratch
+      region and sparse work area, so the factors are only read.
+      Without COINUTILS_PTHREADS (or if numberThreads<2) the columns are
+      done one after another.  No other method may be called while this
+      is running.  Returns total number of elements in results.
+  */
+  int updateColumnsBatch ( int numberColumns,
+			   CoinIndexedVector ** regionSparse2,
+			   int numberThreads=1) const;
+  /** Updates numberColumns independent columns (BTRAN).
+      As updateColumnsBatch but each column is treated as by
+      updateColumnTranspose */
+  int updateColumnsTransposeBatch ( int numberColumns,
+				    CoinIndexedVector ** regionSparse2,
+				    int numberThreads=1) const;
+  /** Updates numberColumns columns (FTRAN) together.  Each
+      regionSparse2[i] ends as after updateColumn (un-permuted), but
+      densish ones go through L, R and U once, each column of a factor
+      being applied to all of them while it is in cache - others are done
+      one by one.  Columns are worked on in place so must not be packed
+      and must have room for numberRows+maximumPivots.  regionSparse is
+      as for updateColumn.  Returns total number of elements in results.
+  */
+  int updateColumns ( CoinIndexedVector * regionSparse,
+		      int numberColumns,
+		      CoinIndexedVector ** regionSparse2) const;
+  /** Updates numberColumns columns (BTRAN) together.
+      As updateColumns but each ends as after updateColumnTranspose */
+  int updateColumnsTranspose ( CoinIndexedVector * regionSparse,
+			       int numberColumns,
+			       CoinIndexedVector ** regionSparse2) const;
   /** makes a row copy of L for speed and to allow very sparse problems */
   void goSparse();
   /**  get sparse threshold */
@@ -587,6 +807,12 @@ public:
   /// 1 bit - tolerances etc, 2 more, 4 dummy arrays
   void gutsOfInitialize(int type);
   void gutsOfCopy(const CoinFactorization &other);
+  /// Copies scalars and factorization arrays (space already there)
+  void gutsOfCopyContents(const CoinFactorization &other);
+  /** Gets arrays needed to hold a factorization with dimensions of
+      sizes - keeps own arrays if persistent and big enough */
+  void getCopyAreas(const CoinFactorization &sizes, bool rowCopyU,
+		    bool extraR);
 
   /// Reset all sparsity etc statistics
   void resetStatistics();
@@ -620,6 +846,17 @@ protected:
   /** Does dense phase of factorization
       return code is <0 error, 0= finished */
   int factorDense (  );
+  /** Takes next pivot from last pivot order if still available and
+      acceptable (pivotRowPosition is position in column).  Returns false
+      if none, after which Markowitz search is used for rest */
+  bool followPivot ( int & iPivotRow, int & iPivotColumn,
+		     CoinBigIndex & pivotRowPosition );
+  /// Turns saved pivot order into pivots on internal basic columns
+  void makeFollowOrder ( int numberColumns, const int rowIsBasic[],
+			 const int columnIsBasic[] );
+  /// Saves pivots just taken as variables for next factorization
+  void savePivotOrder ( int numberColumns, const int rowIsBasic[],
+			const int columnIsBasic[] );
 
   /// Pivots when just one other row so faster?
   bool pivotOneOtherRow ( int pivotRow,
@@ -663,6 +900,8 @@ protected:
   also moves existing vector */
   bool getRowSpaceIterate ( int iRow,
 			    int extraNeeded );
+  /// Adds any pending columns of U to row copy (see setLazyRowCopyU)
+  void flushRowCopyU (  );
   /// Checks that row and column copies look OK
   void checkConsistency (  );
   /// Adds a link in chain of equal counts
@@ -706,34 +945,143 @@ protected:
   void separateLinks(int count,bool rowsFirst);
   /// Cleans up at end of factorization
   void cleanup (  );
-
-  /// Updates part of column (FTRANL)
-  void updateColumnL ( CoinIndexedVector * region, int * indexIn ) const;
-  /// Updates part of column (FTRANL) when densish
-  void updateColumnLDensish ( CoinIndexedVector * region, int * indexIn ) const;
+  /// Finds runs of columns in L and U with same pattern (after cleanup)
+  void findSupernodes (  );
+  /// Merges R etas since last block into a block if worthwhile
+  void makeBlockR (  );
+  /// Makes float copies of L and U if mixed precision (after cleanup)
+  void makeFloatFactors (  );
+
+  /** As updateColumn but using given sparse work area (of same size and
+      with same zeroed mark part as sparse_) */
+  int updateColumnWork ( CoinIndexedVector * regionSparse,
+			 CoinIndexedVector * regionSparse2,
+			 bool noPermute, int * sparseWork) const;
+  /** As updateColumnTranspose but using given sparse work area (of same
+      size and with same zeroed mark part as sparse_) */
+  int updateColumnTransposeWork ( CoinIndexedVector * regionSparse,
+				  CoinIndexedVector * regionSparse2,
+				  int * sparseWork) const;
+  /// Does work for updateColumnsBatch and updateColumnsTransposeBatch
+  int gutsOfBatch ( int numberColumns, CoinIndexedVector ** regionSparse2,
+		    int numberThreads, bool transpose) const;
+  /// Body of each batch worker (info is CoinFactorizationBatchThread)
+  static void * batchWorker ( void * info );
+  /** Does columns of pivot row in pivot using numberThreads_ threads.
+      Returns 0 if done, 1 if left to be done by one thread (room kept
+      being compressed away) and -1 if no room */
+  template <class T> int
+  pivotColumnsParallel ( int pivotRow, int numberInPivotRow,
+			 int numberInPivotColumn, const int * indexL,
+			 const CoinFactorizationDouble * multipliersL,
+			 CoinFactorizationDouble work[],
+			 unsigned int workArea2[], int increment2,
+			 const T markRow[], int largeInteger,
+			 CoinBigIndex & added);
+  /// Body of each pivot worker (info is CoinFactorizationPivotThread)
+  template <class T> static void * pivotWorker ( void * info );
+  /** Does columns firstColumn to lastColumn-1 of preProcess state 2
+      (largest first and column norms) or 4 (elements in rows already
+      pivoted moved out, then largest first).  index and work are scratch
+      for a column (state 4).  If doRows the row copy (state 2) or row
+      counts (state 4) are done as well - only for one thread */
+  void preProcessColumns ( int state, int firstColumn, int lastColumn,
+			   int * index, CoinFactorizationDouble * work,
+			   bool doRows, double & norm, double & largest );
+  /** Does column pass of preProcess state 2 or 4 using numberThreads_
+      threads, leaving row copy or counts to be done */
+  void preProcessParallel ( int state );
+  /// Body of each preProcess worker (info is CoinFactorizationPreProcessThread)
+  static void * preProcessWorker ( void * info );
+
+  /** Updates part of column (FTRANL).  If lowPrecision then float
+      copy of L is used in densish code (if there is one) */
+  void updateColumnL ( CoinIndexedVector * region, int * indexIn,
+		       int * sparseWork, bool lowPrecision=false ) const;
+  /// Updates part of column (FTRANL) when densish (element is L or copy)
+  template <class T> void
+  updateColumnLDensish ( CoinIndexedVector * region, int * indexIn,
+			 const T * element ) const;
+  /** Updates part of several columns (FTRANL) when densish, going
+      through L once */
+  void updateColumnsLDensish ( int numberColumns,
+			       CoinIndexedVector ** regions ) const;
+  /** Updates part of several columns (FTRANR) as dot products, going
+      through R once */
+  void updateColumnsRByEta ( int numberColumns,
+			     CoinIndexedVector ** regions ) const;
+  /** Updates part of several columns (FTRANU) when densish, going
+      through U once */
+  void updateColumnsUDensish ( int numberColumns,
+			       CoinIndexedVector ** regions ) const;
+  /** Updates part of several columns transpose (BTRANU) when densish,
+      going through row copy of U once (no columns may be pending) */
+  void updateColumnsTransposeUDensish ( int numberColumns,
+					CoinIndexedVector ** regions,
+					int smallestIndex ) const;
+  /** Updates part of several columns transpose (BTRANR) when densish,
+      going through R once.  Indices are lost as in
+      updateColumnTransposeRDensish */
+  void updateColumnsTransposeRDensish ( int numberColumns,
+					CoinIndexedVector ** regions ) const;
+  /** Updates part of several columns transpose (BTRANL) when densish,
+      going through L once and then finding indices */
+  void updateColumnsTransposeLDensish ( int numberColumns,
+					CoinIndexedVector ** regions ) const;
+  /// Which FTRAN L kernel - 0 densish, 1 sparsish, 2 sparse, 3 adaptive
+  int updateColumnLMethod ( int number ) const;
+  /// Updates dense part of L (FTRANL) after sparse part
+  void updateColumnLDense ( CoinIndexedVector * region,
+			    int * indexIn ) const;
   /// Updates part of column (FTRANL) when sparse
-  void updateColumnLSparse ( CoinIndexedVector * region, int * indexIn ) const;
+  void updateColumnLSparse ( CoinIndexedVector * region, int * indexIn,
+			     int * sparseWork ) const;
   /// Updates part of column (FTRANL) when sparsish
-  void updateColumnLSparsish ( CoinIndexedVector * region, int * indexIn ) const;
+  void updateColumnLSparsish ( CoinIndexedVector * region, int * indexIn,
+			       int * sparseWork ) const;
+  /// Updates part of column (FTRANL) choosing kernel from history and reach
+  void updateColumnLAdaptive ( CoinIndexedVector * region, int * indexIn,
+			       int * sparseWork, bool lowPrecision ) const;
+  /** Reach in L of indexIn (those >= baseL_) by depth first search.
+      Returns number in reach (list in sparseWork, last first in
+      topological order) or -1 if more than maximum */
+  int reachL ( const int * indexIn, int number, int * sparseWork,
+	       int maximum ) const;
 
   /// Updates part of column (FTRANR) without FT update
-  void updateColumnR ( CoinIndexedVector * region ) const;
+  void updateColumnR ( CoinIndexedVector * region, int * sparseWork ) const;
+  /** Does R etas in order as dot products (FTRANR) -
+      returns new number in regionIndex */
+  int updateColumnRByEta ( double * region, int * regionIndex,
+			   int numberNonZero ) const;
+  /** Gets index array for FT update - in U if room (doFT true),
+      otherwise that of regionSparse */
+  int * reserveColumnFT ( CoinIndexedVector * regionSparse, bool & doFT );
+  /** Does R (storing partial update if doFT) and U parts of FT update,
+      permuting back into regionSparse2.  Returns as updateColumnFT */
+  int updateColumnFTAfterL ( CoinIndexedVector * regionSparse,
+			     CoinIndexedVector * regionSparse2,
+			     int * regionIndex, bool doFT );
   /** Updates part of column (FTRANR) with FT update.
       Also stores update after L and R */
   void updateColumnRFT ( CoinIndexedVector * region, int * indexIn );
 
-  /// Updates part of column (FTRANU)
-  void updateColumnU ( CoinIndexedVector * region, int * indexIn) const;
+  /** Updates part of column (FTRANU).  If lowPrecision then float
+      copy of U is used in densish code (if there is one) */
+  void updateColumnU ( CoinIndexedVector * region, int * indexIn,
+		       int * sparseWork, bool lowPrecision=false) const;
 
   /// Updates part of column (FTRANU) when sparse
   void updateColumnUSparse ( CoinIndexedVector * regionSparse, 
-			     int * indexIn) const;
+			     int * indexIn, int * sparseWork) const;
   /// Updates part of column (FTRANU) when sparsish
   void updateColumnUSparsish ( CoinIndexedVector * regionSparse, 
-			       int * indexIn) const;
-  /// Updates part of column (FTRANU)
-  int updateColumnUDensish ( double * COIN_RESTRICT region, 
-			     int * COIN_RESTRICT regionIndex) const;
+			       int * indexIn, int * sparseWork) const;
+  /// Updates part of column (FTRANU) (element is U or copy)
+  template <class T> int
+  updateColumnUDensish ( double * COIN_RESTRICT region, 
+			 int * COIN_RESTRICT regionIndex,
+			 const T * element ) const;
   /// Updates part of 2 columns (FTRANU) real work
   void updateTwoColumnsUDensish (
 				 int & numberNonZero1,
@@ -753,40 +1101,52 @@ protected:
   /** Updates part of column transpose (BTRANU),
       assumes index is sorted i.e. region is correct */
   void updateColumnTransposeU ( CoinIndexedVector * region,
-				int smallestIndex) const;
+				int smallestIndex, int * sparseWork) const;
   /** Updates part of column transpose (BTRANU) when sparsish,
       assumes index is sorted i.e. region is correct */
   void updateColumnTransposeUSparsish ( CoinIndexedVector * region,
-					int smallestIndex) const;
+					int smallestIndex,
+					int * sparseWork) const;
   /** Updates part of column transpose (BTRANU) when densish,
       assumes index is sorted i.e. region is correct */
   void updateColumnTransposeUDensish ( CoinIndexedVector * region,
 				       int smallestIndex) const;
   /** Updates part of column transpose (BTRANU) when sparse,
       assumes index is sorted i.e. region is correct */
-  void updateColumnTransposeUSparse ( CoinIndexedVector * region) const;
+  void updateColumnTransposeUSparse ( CoinIndexedVector * region,
+				      int * sparseWork) const;
   /** Updates part of column transpose (BTRANU) by column
       assumes index is sorted i.e. region is correct */
   void updateColumnTransposeUByColumn ( CoinIndexedVector * region,
 					int smallestIndex) const;
+  /** Finishes BTRANU for columns of U not yet in row copy
+      (region must not index them on entry) */
+  void updateColumnTransposeUPending ( CoinIndexedVector * region) const;
 
   /// Updates part of column transpose (BTRANR)
-  void updateColumnTransposeR ( CoinIndexedVector * region ) const;
+  void updateColumnTransposeR ( CoinIndexedVector * region,
+				int * sparseWork ) const;
   /// Updates part of column transpose (BTRANR) when dense
   void updateColumnTransposeRDensish ( CoinIndexedVector * region ) const;
   /// Updates part of column transpose (BTRANR) when sparse
-  void updateColumnTransposeRSparse ( CoinIndexedVector * region ) const;
+  void updateColumnTransposeRSparse ( CoinIndexedVector * region,
+				      int * sparseWork ) const;
 
+  /// Updates dense part of column transpose (BTRAN) - whole region
+  void updateColumnTransposeDense ( double * region ) const;
   /// Updates part of column transpose (BTRANL)
-  void updateColumnTransposeL ( CoinIndexedVector * region ) const;
+  void updateColumnTransposeL ( CoinIndexedVector * region,
+				int * sparseWork ) const;
   /// Updates part of column transpose (BTRANL) when densish by column
   void updateColumnTransposeLDensish ( CoinIndexedVector * region ) const;
   /// Updates part of column transpose (BTRANL) when densish by row
   void updateColumnTransposeLByRow ( CoinIndexedVector * region ) const;
   /// Updates part of column transpose (BTRANL) when sparsish by row
-  void updateColumnTransposeLSparsish ( CoinIndexedVector * region ) const;
+  void updateColumnTransposeLSparsish ( CoinIndexedVector * region,
+					int * sparseWork ) const;
   /// Updates part of column transpose (BTRANL) when sparse (by Row)
-  void updateColumnTransposeLSparse ( CoinIndexedVector * region ) const;
+  void updateColumnTransposeLSparse ( CoinIndexedVector * region,
+				      int * sparseWork ) const;
 public:
   /** Replaces one Column to basis for PFI
    returns 0=OK, 1=Probably OK, 2=singular, 3=no room.
@@ -808,6 +1168,206 @@ protected:
 #define COINFACTORIZATION_SHIFT_PER_INT 5
 #define COINFACTORIZATION_MASK_PER_INT 0x1f
 #endif
+  /** Does column jColumn of saveColumn_ in pivot - compresses it,
+      updates by multiplier times pivot column and puts largest first.
+      If removed is NULL row lists and column links are updated as we go.
+      Otherwise there must already be room and entries which go and must
+      come out of row lists are saved as row, column pairs in removed.
+      Returns false if no room */
+  template <class T>  inline bool
+  pivotOneColumn ( int jColumn,
+		   int pivotRow,
+		   int numberInPivotColumn,
+		   const int * indexL,
+		   const CoinFactorizationDouble * multipliersL,
+		   CoinFactorizationDouble work[],
+		   unsigned int * temp2,
+		   const T markRow[] ,
+		   int largeInteger,
+		   CoinBigIndex & added,
+		   int * removed,
+		   int & numberRemoved)
+{
+  CoinBigIndex *startColumnU = startColumnU_.array();
+  int *numberInColumn = numberInColumn_.array();
+  CoinFactorizationDouble *elementU = elementU_.array();
+  int *indexRowU = indexRowU_.array();
+  int *indexColumnU = indexColumnU_.array();
+  CoinBigIndex *startRowU = startRowU_.array();
+  int *numberInRow = numberInRow_.array();
+  int * nextColumn = nextColumn_.array();
+  int j;
+
+  int iColumn = saveColumn_.array()[jColumn];
+  CoinBigIndex startColumn = startColumnU[iColumn];
+  CoinBigIndex endColumn = startColumn + numberInColumn[iColumn];
+  int iRow = indexRowU[startColumn];
+  CoinFactorizationDouble value = elementU[startColumn];
+  double largest;
+  CoinBigIndex put = startColumn;
+  CoinBigIndex positionLargest = -1;
+  CoinFactorizationDouble thisPivotValue = 0.0;
+
+  //compress column and find largest not updated
+  bool checkLargest;
+  int mark = markRow[iRow];
+
+  if ( mark == largeInteger+1 ) {
+    largest = fabs ( value );
+    positionLargest = put;
+    put++;
+    checkLargest = false;
+  } else {
+    //need to find largest
+    largest = 0.0;
+    checkLargest = true;
+    if ( mark != largeInteger ) {
+      //will be updated
+      work[mark] = value;
+      int word = mark >> COINFACTORIZATION_SHIFT_PER_INT;
+      int bit = mark & COINFACTORIZATION_MASK_PER_INT;
+
+      temp2[word] = temp2[word] | ( 1 << bit );	//say already in counts
+      added--;
+    } else {
+      thisPivotValue = value;
+    }
+  }
+  CoinBigIndex i;
+  for ( i = startColumn + 1; i < endColumn; i++ ) {
+    iRow = indexRowU[i];
+    value = elementU[i];
+    int mark = markRow[iRow];
+
+    if ( mark == largeInteger+1 ) {
+      //keep
+      indexRowU[put] = iRow;
+      elementU[put] = value;
+      if ( checkLargest ) {
+	double absValue = fabs ( value );
+
+	if ( absValue > largest ) {
+	  largest = absValue;
+	  positionLargest = put;
+	}
+      }
+      put++;
+    } else if ( mark != largeInteger ) {
+      //will be updated
+      work[mark] = value;
+      int word = mark >> COINFACTORIZATION_SHIFT_PER_INT;
+      int bit = mark & COINFACTORIZATION_MASK_PER_INT;
+
+      temp2[word] = temp2[word] | ( 1 << bit );	//say already in counts
+      added--;
+    } else {
+      thisPivotValue = value;
+    }
+  }
+  //slot in pivot
+  elementU[put] = elementU[startColumn];
+  indexRowU[put] = indexRowU[startColumn];
+  if ( positionLargest == startColumn ) {
+    positionLargest = put;	//follow if was largest
+  }
+  put++;
+  elementU[startColumn] = thisPivotValue;
+  indexRowU[startColumn] = pivotRow;
+  //clean up counts
+  startColumn++;
+  numberInColumn[iColumn] = put - startColumn;
+  int * numberInColumnPlus = numberInColumnPlus_.array();
+  numberInColumnPlus[iColumn]++;
+  startColumnU[iColumn]++;
+  //how much space have we got (made sure of already if removed)
+  int next = removed ? -1 : nextColumn[iColumn];
+  CoinBigIndex space;
+
+  space = removed ? numberInPivotColumn :
+    startColumnU[next] - put - numberInColumnPlus[next];
+  //assume no zero elements
+  if ( numberInPivotColumn > space ) {
+    //getColumnSpace also moves fixed part
+    if ( !getColumnSpace ( iColumn, numberInPivotColumn ) ) {
+      return false;
+    }
+    //redo starts
+    if (positionLargest >= 0)
+       positionLargest = positionLargest + startColumnU[iColumn] - startColumn;
+    startColumn = startColumnU[iColumn];
+    put = startColumn + numberInColumn[iColumn];
+  }
+  double tolerance = zeroTolerance_;
+
+  int *nextCount = nextCount_.array();
+  for ( j = 0; j < numberInPivotColumn; j++ ) {
+    value = work[j] - thisPivotValue * multipliersL[j];
+    double absValue = fabs ( value );
+
+    if ( absValue > tolerance ) {
+      work[j] = 0.0;
+      assert (put<lengthAreaU_); 
+      elementU[put] = value;
+      indexRowU[put] = indexL[j];
+      if ( absValue > largest ) {
+	largest = absValue;
+	positionLargest = put;
+      }
+      put++;
+    } else {
+      work[j] = 0.0;
+      added--;
+      int word = j >> COINFACTORIZATION_SHIFT_PER_INT;
+      int bit = j & COINFACTORIZATION_MASK_PER_INT;
+
+      if ( temp2[word] & ( 1 << bit ) && removed ) {
+	//take out of row list later
+	removed[numberRemoved++] = indexL[j];
+	removed[numberRemoved++] = iColumn;
+      } else if ( temp2[word] & ( 1 << bit ) ) {
+	//take out of row list
+	iRow = indexL[j];
+	CoinBigIndex start = startRowU[iRow];
+	CoinBigIndex end = start + numberInRow[iRow];
+	CoinBigIndex where = start;
+
+	while ( indexColumnU[where] != iColumn ) {
+	  where++;
+	}			/* endwhile */
+#if DEBUG_COIN
+	if ( where >= end ) {
+	  abort (  );
+	}
+#endif
+	indexColumnU[where] = indexColumnU[end - 1];
+	numberInRow[iRow]--;
+      } else {
+	//make sure won't be added
+	int word = j >> COINFACTORIZATION_SHIFT_PER_INT;
+	int bit = j & COINFACTORIZATION_MASK_PER_INT;
+
+	temp2[word] = temp2[word] | ( 1 << bit );	//say already in counts
+      }
+    }
+  }
+  numberInColumn[iColumn] = put - startColumn;
+  //move largest
+  if ( positionLargest >= 0 ) {
+    value = elementU[positionLargest];
+    iRow = indexRowU[positionLargest];
+    elementU[positionLargest] = elementU[startColumn];
+    indexRowU[positionLargest] = indexRowU[startColumn];
+    elementU[startColumn] = value;
+    indexRowU[startColumn] = iRow;
+  }
+  //linked list for column
+  if ( !removed && nextCount[iColumn + numberRows_] != -2 ) {
+    //modify linked list
+    deleteLink ( iColumn + numberRows_ );
+    addLink ( iColumn + numberRows_, numberInColumn[iColumn] );
+  }
+  return true;
+}
   template <class T>  inline bool
   pivot ( int pivotRow,
 	  int pivotColumn,
@@ -994,175 +1554,32 @@ protected:
   }
   CoinBigIndex added = numberInPivotRow * numberInPivotColumn;
   unsigned int *temp2 = workArea2;
-  int * nextColumn = nextColumn_.array();
 
   //pack down and move to work
   int jColumn;
-  for ( jColumn = 0; jColumn < numberInPivotRow; jColumn++ ) {
-    int iColumn = saveColumn[jColumn];
-    CoinBigIndex startColumn = startColumnU[iColumn];
-    CoinBigIndex endColumn = startColumn + numberInColumn[iColumn];
-    int iRow = indexRowU[startColumn];
-    CoinFactorizationDouble value = elementU[startColumn];
-    double largest;
-    CoinBigIndex put = startColumn;
-    CoinBigIndex positionLargest = -1;
-    CoinFactorizationDouble thisPivotValue = 0.0;
-
-    //compress column and find largest not updated
-    bool checkLargest;
-    int mark = markRow[iRow];
-
-    if ( mark == largeInteger+1 ) {
-      largest = fabs ( value );
-      positionLargest = put;
-      put++;
-      checkLargest = false;
-    } else {
-      //need to find largest
-      largest = 0.0;
-      checkLargest = true;
-      if ( mark != largeInteger ) {
-	//will be updated
-	work[mark] = value;
-	int word = mark >> COINFACTORIZATION_SHIFT_PER_INT;
-	int bit = mark & COINFACTORIZATION_MASK_PER_INT;
-
-	temp2[word] = temp2[word] | ( 1 << bit );	//say already in counts
-	added--;
-      } else {
-	thisPivotValue = value;
-      }
-    }
-    CoinBigIndex i;
-    for ( i = startColumn + 1; i < endColumn; i++ ) {
-      iRow = indexRowU[i];
-      value = elementU[i];
-      int mark = markRow[iRow];
-
-      if ( mark == largeInteger+1 ) {
-	//keep
-	indexRowU[put] = iRow;
-	elementU[put] = value;
-	if ( checkLargest ) {
-	  double absValue = fabs ( value );
-
-	  if ( absValue > largest ) {
-	    largest = absValue;
-	    positionLargest = put;
-	  }
-	}
-	put++;
-      } else if ( mark != largeInteger ) {
-	//will be updated
-	work[mark] = value;
-	int word = mark >> COINFACTORIZATION_SHIFT_PER_INT;
-	int bit = mark & COINFACTORIZATION_MASK_PER_INT;
-
-	temp2[word] = temp2[word] | ( 1 << bit );	//say already in counts
-	added--;
-      } else {
-	thisPivotValue = value;
-      }
-    }
-    //slot in pivot
-    elementU[put] = elementU[startColumn];
-    indexRowU[put] = indexRowU[startColumn];
-    if ( positionLargest == startColumn ) {
-      positionLargest = put;	//follow if was largest
+  int returnCode = 1;
+  if ( numberThreads_ > 1 && numberInPivotRow >= 2 * numberThreads_ &&
+       static_cast<double> (numberInPivotRow) * numberInPivotColumn >
+       COIN_FACTORIZATION_PARALLEL_PIVOT ) {
+    returnCode = pivotColumnsParallel ( pivotRow, numberInPivotRow,
+					numberInPivotColumn, indexL,
+					multipliersL, work, workArea2,
+					increment2, markRow, largeInteger,
+					added );
+    if ( returnCode < 0 ) {
+      return false;
     }
-    put++;
-    elementU[startColumn] = thisPivotValue;
-    indexRowU[startColumn] = pivotRow;
-    //clean up counts
-    startColumn++;
-    numberInColumn[iColumn] = put - startColumn;
-    int * numberInColumnPlus = numberInColumnPlus_.array();
-    numberInColumnPlus[iColumn]++;
-    startColumnU[iColumn]++;
-    //how much space have we got
-    int next = nextColumn[iColumn];
-    CoinBigIndex space;
-
-    space = startColumnU[next] - put - numberInColumnPlus[next];
-    //assume no zero elements
-    if ( numberInPivotColumn > space ) {
-      //getColumnSpace also moves fixed part
-      if ( !getColumnSpace ( iColumn, numberInPivotColumn ) ) {
+  }
+  if ( returnCode ) {
+    for ( jColumn = 0; jColumn < numberInPivotRow; jColumn++ ) {
+      int numberRemoved = 0;
+      if ( !pivotOneColumn ( jColumn, pivotRow, numberInPivotColumn,
+			     indexL, multipliersL, work, temp2, markRow,
+			     largeInteger, added, NULL, numberRemoved ) ) {
 	return false;
       }
-      //redo starts
-      if (positionLargest >= 0)
-         positionLargest = positionLargest + startColumnU[iColumn] - startColumn;
-      startColumn = startColumnU[iColumn];
-      put = startColumn + numberInColumn[iColumn];
-    }
-    double tolerance = zeroTolerance_;
-
-    int *nextCount = nextCount_.array();
-    for ( j = 0; j < numberInPivotColumn; j++ ) {
-      value = work[j] - thisPivotValue * multipliersL[j];
-      double absValue = fabs ( value );
-
-      if ( absValue > tolerance ) {
-	work[j] = 0.0;
-	assert (put<lengthAreaU_); 
-	elementU[put] = value;
-	indexRowU[put] = indexL[j];
-	if ( absValue > largest ) {
-	  largest = absValue;
-	  positionLargest = put;
-	}
-	put++;
-      } else {
-	work[j] = 0.0;
-	added--;
-	int word = j >> COINFACTORIZATION_SHIFT_PER_INT;
-	int bit = j & COINFACTORIZATION_MASK_PER_INT;
-
-	if ( temp2[word] & ( 1 << bit ) ) {
-	  //take out of row list
-	  iRow = indexL[j];
-	  CoinBigIndex start = startRowU[iRow];
-	  CoinBigIndex end = start + numberInRow[iRow];
-	  CoinBigIndex where = start;
-
-	  while ( indexColumnU[where] != iColumn ) {
-	    where++;
-	  }			/* endwhile */
-#if DEBUG_COIN
-	  if ( where >= end ) {
-	    abort (  );
-	  }
-#endif
-	  indexColumnU[where] = indexColumnU[end - 1];
-	  numberInRow[iRow]--;
-	} else {
-	  //make sure won't be added
-	  int word = j >> COINFACTORIZATION_SHIFT_PER_INT;
-	  int bit = j & COINFACTORIZATION_MASK_PER_INT;
-
-	  temp2[word] = temp2[word] | ( 1 << bit );	//say already in counts
-	}
-      }
-    }
-    numberInColumn[iColumn] = put - startColumn;
-    //move largest
-    if ( positionLargest >= 0 ) {
-      value = elementU[positionLargest];
-      iRow = indexRowU[positionLargest];
-      elementU[positionLargest] = elementU[startColumn];
-      indexRowU[positionLargest] = indexRowU[startColumn];
-      elementU[startColumn] = value;
-      indexRowU[startColumn] = iRow;
-    }
-    //linked list for column
-    if ( nextCount[iColumn + numberRows_] != -2 ) {
-      //modify linked list
-      deleteLink ( iColumn + numberRows_ );
-      addLink ( iColumn + numberRows_, numberInColumn[iColumn] );
+      temp2 += increment2;
     }
-    temp2 += increment2;
   }
   //get space for row list
   unsigned int *putBase = workArea2;
@@ -1494,6 +1911,41 @@ protected:
   /// Dense threshold
   int denseThreshold_;
 
+  /// Minimum length of run of identical columns to treat as block
+  int supernodeThreshold_;
+
+  /// Number of threads for sparse factorization
+  int numberThreads_;
+
+  /** For each column of L number of columns (including this one) in
+      block going forward - 0 or 1 if not in block */
+  CoinIntArrayWithLength supernodeL_;
+
+  /** For each column of U number of columns (including this one) in
+      block going backward - only valid if no pivots since factorization */
+  CoinIntArrayWithLength supernodeU_;
+
+  /// Number of R etas to merge into a block (0 off)
+  int blockSizeR_;
+
+  /// Number of blocks of R etas
+  int numberBlocksR_;
+
+  /// First R eta (as pivot) not yet looked at for a block
+  int firstUnblockedR_;
+
+  /// For each block of R first eta, number of etas and number of rows
+  CoinIntArrayWithLength blockR_;
+
+  /// For each block of R start of rows and of elements
+  CoinBigIndexArrayWithLength startBlockR_;
+
+  /// Rows of blocks of R
+  CoinIntArrayWithLength indexBlockR_;
+
+  /// Elements of blocks of R (for each row the etas in order)
+  CoinFactorizationDoubleArrayWithLength elementBlockR_;
+
   /// First work area
   CoinFactorizationDoubleArrayWithLength workArea_;
 
@@ -1549,8 +2001,88 @@ protected:
   /// Elements in L (row copy)
   CoinFactorizationDoubleArrayWithLength elementByRowL_;
 
+  /// Elements of L as float (mixed precision)
+  CoinFloatArrayWithLength elementLFloat_;
+
+  /// Elements of U as float (mixed precision, valid until U modified)
+  CoinFloatArrayWithLength elementUFloat_;
+
   /// Sparse regions
   mutable CoinIntArrayWithLength sparse_;
+
+  /// Whether FTRAN L kernel is chosen per solve
+  bool adaptiveSparse_;
+
+  /// Whether L and U are also kept in float
+  bool mixedPrecision_;
+
+  /// Maximum number of columns of U kept out of row copy
+  int lazyRowCopyU_;
+
+  /// Number of columns of U not in row copy (the last ones)
+  int numberPendingU_;
+
+  /// Adaptive control of refactorization and areas
+  int adaptiveRefactor_;
+
+  /// Whether refactorization is recommended (adaptive control)
+  bool refactorRecommended_;
+
+  /// Work of refactorizing per element of factorization
+  double refactorWork_;
+
+  /// Sum over updates of elements added since factorization
+  double updateWork_;
+
+  /// Largest column 1-norm of basis at factorization
+  double basisNorm_;
+
+  /// Largest element of basis at factorization
+  double largestBasisElement_;
+
+  /// Growth in sparse factorization
+  double growthFactor_;
+
+  /// Whether pivot order of last factorization is followed
+  bool reusePivotOrder_;
+
+  /** Pivot order of last factorization - row then variable (column, or
+      -1-row for slack) */
+  CoinIntArrayWithLength pivotOrder_;
+
+  /// Number of pivots in pivotOrder_
+  int numberPivotOrder_;
+
+  /// Elements in L and U at last factorization without pivot order
+  CoinBigIndex searchedElements_;
+
+  /** Pivots to follow (row then internal column) followed by pivots
+      taken in this factorization */
+  CoinIntArrayWithLength followOrder_;
+
+  /// Number of pivots to follow
+  int numberFollow_;
+
+  /// Next pivot to follow
+  int nextFollow_;
+
+  /// Number of pivots recorded (-1 if not recording)
+  int numberRecorded_;
+
+  /// Number of pivots followed
+  int numberFollowed_;
+
+  /// Recent growth in FTRAN L (adaptive mode)
+  mutable double adaptiveRatioL_;
+
+  /// Last reach in L (adaptive mode) - inputs then reach
+  mutable CoinIntArrayWithLength reachL_;
+
+  /// Number of inputs in reachL_ (-1 if not valid)
+  mutable int reachInputL_;
+
+  /// Number in reach in reachL_
+  mutable int reachNumberL_;
   /** L to U bias
       0 - U bias, 1 - some U bias, 2 some L bias, 3 L bias
   */
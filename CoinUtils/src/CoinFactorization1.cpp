@@ -11,12 +11,15 @@
 #include "CoinUtilsConfig.h"
 
 #include <cassert>
+#include <cstring>
 #include "CoinFactorization.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
 #include "CoinTime.hpp"
+#include "CoinInstrument.hpp"
+#include "CoinThreadPool.hpp"
 #include <stdio.h>
 /*
   Somehow with some BLAS we get multithreaded by default
@@ -82,11 +85,24 @@ void CoinFactorization::gutsOfDestructor(int type)
     pivotRowL_.switchOff();
     pivotRegion_.switchOff();
     elementByRowL_.switchOff();
+    elementLFloat_.switchOff();
+    elementUFloat_.switchOff();
     startRowL_.switchOff();
     indexColumnL_.switchOff();
     sparse_.switchOff();
+    supernodeL_.switchOff();
+    supernodeU_.switchOff();
+    blockR_.switchOff();
+    startBlockR_.switchOff();
+    indexBlockR_.switchOff();
+    elementBlockR_.switchOff();
     workArea_.switchOff();
     workArea2_.switchOff();
+    followOrder_.switchOff();
+    // pivot order is kept between factorizations so only goes here
+    pivotOrder_.switchOff();
+    pivotOrder_.conditionalDelete();
+    numberPivotOrder_ = 0;
   }
   elementU_.conditionalDelete();
   startRowU_.conditionalDelete();
@@ -117,16 +133,34 @@ void CoinFactorization::gutsOfDestructor(int type)
   pivotRowL_.conditionalDelete();
   pivotRegion_.conditionalDelete();
   elementByRowL_.conditionalDelete();
+  elementLFloat_.conditionalDelete();
+  elementUFloat_.conditionalDelete();
   startRowL_.conditionalDelete();
   indexColumnL_.conditionalDelete();
   sparse_.conditionalDelete();
+  supernodeL_.conditionalDelete();
+  supernodeU_.conditionalDelete();
+  blockR_.conditionalDelete();
+  startBlockR_.conditionalDelete();
+  indexBlockR_.conditionalDelete();
+  elementBlockR_.conditionalDelete();
   workArea_.conditionalDelete();
   workArea2_.conditionalDelete();
+  followOrder_.conditionalDelete();
   numberCompressions_ = 0;
   biggerDimension_ = 0;
   numberRows_ = 0;
   numberRowsExtra_ = 0;
+  numberPendingU_ = 0;
   maximumRowsExtra_ = 0;
+  refactorRecommended_ = false;
+  updateWork_ = 0.0;
+  basisNorm_ = 0.0;
+  largestBasisElement_ = 0.0;
+  growthFactor_ = 1.0;
+  numberFollow_ = 0;
+  nextFollow_ = 0;
+  numberRecorded_ = -1;
   numberColumns_ = 0;
   numberColumnsExtra_ = 0;
   maximumColumnsExtra_ = 0;
@@ -146,6 +180,8 @@ void CoinFactorization::gutsOfDestructor(int type)
   lengthAreaL_ = 0;
   numberR_ = 0;
   lengthR_ = 0;
+  numberBlocksR_ = 0;
+  firstUnblockedR_ = 0;
   lengthAreaR_ = 0;
   denseArea_=NULL;
   densePermute_=NULL;
@@ -171,7 +207,17 @@ void CoinFactorization::gutsOfInitialize(int type)
     biggerDimension_ = 0;
     numberRows_ = 0;
     numberRowsExtra_ = 0;
+    numberPendingU_ = 0;
     maximumRowsExtra_ = 0;
+    refactorRecommended_ = false;
+    updateWork_ = 0.0;
+    basisNorm_ = 0.0;
+    largestBasisElement_ = 0.0;
+    growthFactor_ = 1.0;
+    numberFollow_ = 0;
+    nextFollow_ = 0;
+    numberRecorded_ = -1;
+    numberFollowed_ = 0;
     numberColumns_ = 0;
     numberColumnsExtra_ = 0;
     maximumColumnsExtra_ = 0;
@@ -192,12 +238,16 @@ void CoinFactorization::gutsOfInitialize(int type)
     lengthAreaL_ = 0;
     numberR_ = 0;
     lengthR_ = 0;
+    numberBlocksR_ = 0;
+    firstUnblockedR_ = 0;
     lengthAreaR_ = 0;
     elementR_ = NULL;
     indexRowR_ = NULL;
     // always switch off sparse
     sparseThreshold_=0;
     sparseThreshold2_= 0;
+    reachInputL_=-1;
+    reachNumberL_=0;
     denseArea_ = NULL;
     densePermute_=NULL;
     numberDense_=0;
@@ -225,6 +275,17 @@ void CoinFactorization::gutsOfInitialize(int type)
 #else
     denseThreshold_=0;
 #endif
+    supernodeThreshold_=0;
+    adaptiveSparse_=false;
+    mixedPrecision_=false;
+    reusePivotOrder_=false;
+    numberPivotOrder_=0;
+    searchedElements_=0;
+    lazyRowCopyU_=0;
+    blockSizeR_=0;
+    adaptiveRefactor_=0;
+    refactorWork_=64.0;
+    numberThreads_=1;
     biasLU_=2;
     doForrestTomlin_=true;
     persistenceFlag_=0;
@@ -272,6 +333,7 @@ void CoinFactorization::gutsOfInitialize(int type)
     btranAverageAfterU_=0;
     btranAverageAfterR_=0;
     btranAverageAfterL_=0; 
+    adaptiveRatioL_=0.0;
 #ifdef ZEROFAULT
     startColumnL_.array()[0] = 0;
     startColumnR_.array()[0] = 0;
@@ -371,10 +433,19 @@ int CoinFactorization::factorize (
   lengthU_ = numberElements;
   maximumU_ = numberElements;
 
+  if (reusePivotOrder_)
+    makeFollowOrder(numberColumns, rowIsBasic, columnIsBasic);
   preProcess ( 0 );
   factor (  );
+  if (status_ == -99 && adaptiveRefactor_ && areaFactor_ < 1.0e3) {
+    // out of room - start again with larger areas (kept for next time)
+    return factorize(matrix, rowIsBasic, columnIsBasic,
+		     2.0 * CoinMax(areaFactor_, 1.0));
+  }
   numberBasic=0;
   if (status_ == 0) {
+    if (reusePivotOrder_)
+      savePivotOrder(numberColumns, rowIsBasic, columnIsBasic);
     int * permuteBack = permuteBack_.array();
     int * back = pivotColumnBack();
     for (i=0;i<numberRows;i++) {
@@ -417,6 +488,94 @@ int CoinFactorization::factorize (
 
   return status_;
 }
+// Turns saved pivot order into pivots on internal basic columns
+void 
+CoinFactorization::makeFollowOrder ( int numberColumns, const int rowIsBasic[],
+				     const int columnIsBasic[] )
+{
+  followOrder_.conditionalNew(4*numberRows_);
+  numberFollow_ = 0;
+  nextFollow_ = 0;
+  numberRecorded_ = 0;
+  numberFollowed_ = 0;
+  if (!numberPivotOrder_)
+    return;
+  // internal column of each basic variable (slacks first)
+  int * which = new int [numberColumns+numberRows_];
+  int * whichSlack = which + numberColumns;
+  int numberBasic=0;
+  int i;
+  for (i=0;i<numberRows_;i++) {
+    if (rowIsBasic[i]>=0) 
+      whichSlack[i]=numberBasic++;
+    else
+      whichSlack[i]=-1;
+  }
+  for (i=0;i<numberColumns;i++) {
+    if (columnIsBasic[i]>=0) 
+      which[i]=numberBasic++;
+    else
+      which[i]=-1;
+  }
+  const int * order = pivotOrder_.array();
+  int * follow = followOrder_.array();
+  for (i=0;i<numberPivotOrder_;i++) {
+    int iRow = order[2*i];
+    int iVariable = order[2*i+1];
+    int iColumn=-1;
+    if (iVariable>=0) {
+      if (iVariable<numberColumns)
+	iColumn = which[iVariable];
+    } else if (-1-iVariable<numberRows_) {
+      iColumn = whichSlack[-1-iVariable];
+    }
+    // variables which have left basis are skipped
+    if (iRow<numberRows_&&iColumn>=0) {
+      follow[2*numberFollow_]=iRow;
+      follow[2*numberFollow_+1]=iColumn;
+      numberFollow_++;
+      if (numberFollow_==numberRows_)
+	break;
+    }
+  }
+  delete [] which;
+}
+// Saves pivots just taken as variables for next factorization
+void 
+CoinFactorization::savePivotOrder ( int numberColumns, const int rowIsBasic[],
+				    const int columnIsBasic[] )
+{
+  numberPivotOrder_ = 0;
+  if (numberRecorded_<=0)
+    return;
+  CoinBigIndex numberElements = numberElementsL()+numberElementsU();
+  if (!numberFollowed_) {
+    searchedElements_ = numberElements;
+  } else if (numberElements>searchedElements_+searchedElements_/10) {
+    // too much fill - search next time
+    return;
+  }
+  // basic variable of each internal column (slacks first)
+  int * variable = new int [numberRows_];
+  int numberBasic=0;
+  int i;
+  for (i=0;i<numberRows_;i++) {
+    if (rowIsBasic[i]>=0) 
+      variable[numberBasic++]=-1-i;
+  }
+  for (i=0;i<numberColumns;i++) {
+    if (columnIsBasic[i]>=0) 
+      variable[numberBasic++]=i;
+  }
+  int * order = pivotOrder_.conditionalNew(2*numberRows_);
+  const int * recorded = followOrder_.array() + 2*numberRows_;
+  for (i=0;i<numberRecorded_;i++) {
+    order[2*i] = recorded[2*i];
+    order[2*i+1] = variable[recorded[2*i+1]];
+  }
+  numberPivotOrder_ = numberRecorded_;
+  delete [] variable;
+}
 //Given as triplets
 int CoinFactorization::factorize (
 			     int numberOfRows,
@@ -446,6 +605,12 @@ int CoinFactorization::factorize (
   maximumU_ = numberOfElements;
   preProcess ( 0 );
   factor (  );
+  if (status_ == -99 && adaptiveRefactor_ && areaFactor_ < 1.0e3) {
+    // out of room - start again with larger areas (kept for next time)
+    return factorize(numberOfRows, numberOfColumns, numberOfElements,
+		     maximumL, maximumU, indicesRow, indicesColumn, elements,
+		     permutation, 2.0 * CoinMax(areaFactor_, 1.0));
+  }
   //say which column is pivoting on which row
   if (status_ == 0) {
     int * permuteBack = permuteBack_.array();
@@ -518,13 +683,13 @@ CoinFactorization::factorizePart2 (int permutation[],int exactNumberElements)
   factor (  );
   //say which column is pivoting on which row
   int i;
-  int * permuteBack = permuteBack_.array();
-  int * back = pivotColumnBack();
-  // permute so slacks on own rows etc
-  for (i=0;i<numberColumns_;i++) {
-    permutation[i]=permuteBack[back[i]];
-  }
   if (status_ == 0) {
+    int * permuteBack = permuteBack_.array();
+    int * back = pivotColumnBack();
+    // permute so slacks on own rows etc
+    for (i=0;i<numberColumns_;i++) {
+      permutation[i]=permuteBack[back[i]];
+    }
     // Set up permutation vector
     // these arrays start off as copies of permute
     // (and we could use permute_ instead of pivotColumn (not back though))
@@ -723,6 +888,8 @@ CoinFactorization::getAreas ( int numberOfRows,
   }
 }
 
+// Fewest elements for column passes of preProcess to use threads
+#define PREPROCESS_PARALLEL_ELEMENTS 100000
 //  preProcess.  PreProcesses raw triplet data
 //state is 0 - triplets, 1 - some counts etc , 2 - ..
 void
@@ -812,39 +979,26 @@ CoinFactorization::preProcess ( int state,
 	i += numberInRow[iRow];
       }
       CoinZeroN ( numberInRow, numberRows );
-      int iColumn;
-      for ( iColumn = 0; iColumn < numberColumns; iColumn++ ) {
-	int number = numberInColumn[iColumn];
-
-	if ( number ) {
+      // norms of basis (for condition and growth)
+      basisNorm_ = 0.0;
+      largestBasisElement_ = 0.0;
+      if (numberThreads_>1&&numberElements>=PREPROCESS_PARALLEL_ELEMENTS) {
+	preProcessParallel(2);
+	// row copy as one thread would have done it
+	int iColumn;
+	for ( iColumn = 0; iColumn < numberColumns; iColumn++ ) {
 	  CoinBigIndex first = startColumn[iColumn];
-	  CoinBigIndex largest = first;
-	  int iRowSave = indexRow[first];
-	  CoinFactorizationDouble valueSave = element[first];
-	  double valueLargest = fabs ( valueSave );
-	  int iLook = numberInRow[iRowSave];
-
-	  numberInRow[iRowSave] = iLook + 1;
-	  indexColumn[startRow[iRowSave] + iLook] = iColumn;
-	  for ( k = first + 1; k < first + number; k++ ) {
+	  for ( k = first; k < first + numberInColumn[iColumn]; k++ ) {
 	    int iRow = indexRow[k];
 	    int iLook = numberInRow[iRow];
 
 	    numberInRow[iRow] = iLook + 1;
 	    indexColumn[startRow[iRow] + iLook] = iColumn;
-	    CoinFactorizationDouble value = element[k];
-	    double valueAbs = fabs ( value );
-
-	    if ( valueAbs > valueLargest ) {
-	      valueLargest = valueAbs;
-	      largest = k;
-	    }
 	  }
-	  indexRow[first] = indexRow[largest];
-	  element[first] = element[largest];
-	  indexRow[largest] = iRowSave;
-	  element[largest] = valueSave;
 	}
+      } else {
+	preProcessColumns(2,0,numberColumns,NULL,NULL,true,
+			  basisNorm_,largestBasisElement_);
       }
     }
   case 3:			//links and initialize pivots
@@ -902,51 +1056,19 @@ CoinFactorization::preProcess ( int state,
 	}
       }
       //CoinZeroN ( numberInColumnPlus, maximumColumnsExtra_ + 1 );
-      for ( iColumn = 0; iColumn < numberColumns; iColumn++ ) {
-	int number = numberInColumn[iColumn];
-
-	if ( number ) {
-	  // use pivotRegion and startRow for remaining elements
+      if (numberThreads_>1&&numberElements>=PREPROCESS_PARALLEL_ELEMENTS) {
+	preProcessParallel(4);
+	// counts of rows left
+	for ( iColumn = 0; iColumn < numberColumns; iColumn++ ) {
 	  CoinBigIndex first = startColumn[iColumn];
-	  CoinBigIndex largest = -1;
-	  
-	  double valueLargest = -1.0;
-	  int nOther=0;
-	  k = first;
-	  CoinBigIndex end = first+number;
-	  for (  ; k < end; k++ ) {
-	    int iRow = indexRow[k];
-	    assert (iRow<numberRows_);
-	    CoinFactorizationDouble value = element[k];
-	    if (numberInRow[iRow]>=0) {
-	      numberInRow[iRow]++;
-	      double valueAbs = fabs ( value );
-	      if ( valueAbs > valueLargest ) {
-		valueLargest = valueAbs;
-		largest = nOther;
-	      }
-	      startRow[nOther]=iRow;
-	      pivotRegion[nOther++]=value;
-	    } else {
-	      indexRow[first] = iRow;
-	      element[first++] = value;
-	    }
-	  }
-	  numberInColumnPlus[iColumn]=first-startColumn[iColumn];
-	  startColumn[iColumn]=first;
-	  //largest
-	  if (largest>=0) {
-	    indexRow[first] = startRow[largest];
-	    element[first++] = pivotRegion[largest];
-	  }
-	  for (k=0;k<nOther;k++) {
-	    if (k!=largest) {
-	      indexRow[first] = startRow[k];
-	      element[first++] = pivotRegion[k];
-	    }
-	  }
-	  numberInColumn[iColumn]=first-startColumn[iColumn];
+	  for ( k = first; k < first + numberInColumn[iColumn]; k++ ) 
+	    numberInRow[indexRow[k]]++;
 	}
+      } else {
+	double norm;
+	double largest;
+	preProcessColumns(4,0,numberColumns,startRow,pivotRegion,true,
+			  norm,largest);
       }
       //and do row part
       i = 0;
@@ -1008,6 +1130,191 @@ CoinFactorization::preProcess ( int state,
     }
   }				/* endswitch */
 }
+// Does column part of preProcess state 2 or 4 for some columns
+void
+CoinFactorization::preProcessColumns ( int state, int firstColumn,
+				       int lastColumn, int * index,
+				       CoinFactorizationDouble * work,
+				       bool doRows, double & norm,
+				       double & largestElement )
+{
+  int *indexRow = indexRowU_.array();
+  int *indexColumn = indexColumnU_.array();
+  CoinFactorizationDouble *element = elementU_.array();
+  int *numberInRow = numberInRow_.array();
+  int *numberInColumn = numberInColumn_.array();
+  int *numberInColumnPlus = numberInColumnPlus_.array();
+  CoinBigIndex *startRow = startRowU_.array();
+  CoinBigIndex *startColumn = startColumnU_.array();
+  CoinBigIndex k;
+  int iColumn;
+  if (state==2) {
+    norm = 0.0;
+    largestElement = 0.0;
+    for ( iColumn = firstColumn; iColumn < lastColumn; iColumn++ ) {
+      int number = numberInColumn[iColumn];
+
+      if ( number ) {
+	CoinBigIndex first = startColumn[iColumn];
+	CoinBigIndex largest = first;
+	int iRowSave = indexRow[first];
+	CoinFactorizationDouble valueSave = element[first];
+	double valueLargest = fabs ( valueSave );
+	double sum = valueLargest;
+
+	if (doRows) {
+	  int iLook = numberInRow[iRowSave];
+	  numberInRow[iRowSave] = iLook + 1;
+	  indexColumn[startRow[iRowSave] + iLook] = iColumn;
+	}
+	for ( k = first + 1; k < first + number; k++ ) {
+	  if (doRows) {
+	    int iRow = indexRow[k];
+	    int iLook = numberInRow[iRow];
+
+	    numberInRow[iRow] = iLook + 1;
+	    indexColumn[startRow[iRow] + iLook] = iColumn;
+	  }
+	  CoinFactorizationDouble value = element[k];
+	  double valueAbs = fabs ( value );
+
+	  sum += valueAbs;
+	  if ( valueAbs > valueLargest ) {
+	    valueLargest = valueAbs;
+	    largest = k;
+	  }
+	}
+	indexRow[first] = indexRow[largest];
+	element[first] = element[largest];
+	indexRow[largest] = iRowSave;
+	element[largest] = valueSave;
+	norm = CoinMax(norm,sum);
+	largestElement = CoinMax(largestElement,valueLargest);
+      }
+    }
+  } else {
+    for ( iColumn = firstColumn; iColumn < lastColumn; iColumn++ ) {
+      int number = numberInColumn[iColumn];
+
+      if ( number ) {
+	// use work and index for remaining elements
+	CoinBigIndex first = startColumn[iColumn];
+	CoinBigIndex largest = -1;
+	  
+	double valueLargest = -1.0;
+	int nOther=0;
+	k = first;
+	CoinBigIndex end = first+number;
+	for (  ; k < end; k++ ) {
+	  int iRow = indexRow[k];
+	  assert (iRow<numberRows_);
+	  CoinFactorizationDouble value = element[k];
+	  if (numberInRow[iRow]>=0) {
+	    if (doRows)
+	      numberInRow[iRow]++;
+	    double valueAbs = fabs ( value );
+	    if ( valueAbs > valueLargest ) {
+	      valueLargest = valueAbs;
+	      largest = nOther;
+	    }
+	    index[nOther]=iRow;
+	    work[nOther++]=value;
+	  } else {
+	    indexRow[first] = iRow;
+	    element[first++] = value;
+	  }
+	}
+	numberInColumnPlus[iColumn]=first-startColumn[iColumn];
+	startColumn[iColumn]=first;
+	//largest
+	if (largest>=0) {
+	  indexRow[first] = index[largest];
+	  element[first++] = work[largest];
+	}
+	for (k=0;k<nOther;k++) {
+	  if (k!=largest) {
+	    indexRow[first] = index[k];
+	    element[first++] = work[k];
+	  }
+	}
+	numberInColumn[iColumn]=first-startColumn[iColumn];
+      }
+    }
+  }
+}
+// Information for each worker doing columns in preProcess
+typedef struct {
+  CoinFactorization * factorization;
+  int state;
+  int firstColumn;
+  int lastColumn;
+  int * index;
+  CoinFactorizationDouble * work;
+  double norm;
+  double largest;
+} CoinFactorizationPreProcessThread;
+// Body of each preProcess worker - does its block of columns
+void * 
+CoinFactorization::preProcessWorker ( void * info )
+{
+  CoinFactorizationPreProcessThread * thread = 
+    reinterpret_cast<CoinFactorizationPreProcessThread *> (info);
+  thread->factorization->preProcessColumns(thread->state,
+					   thread->firstColumn,
+					   thread->lastColumn,
+					   thread->index, thread->work,
+					   false, thread->norm,
+					   thread->largest);
+  return NULL;
+}
+/* Does column pass of preProcess state 2 or 4 using numberThreads_
+   threads.  Each column is only touched by one worker, row copy or counts
+   are left to be done afterwards in column order. */
+void
+CoinFactorization::preProcessParallel ( int state )
+{
+  const int * numberInColumn = numberInColumn_.array();
+  int numberColumns = numberColumns_;
+  int numberThreads = numberThreads_;
+  CoinFactorizationPreProcessThread * thread = 
+    new CoinFactorizationPreProcessThread [numberThreads];
+  // scratch for state 4
+  int * index = NULL;
+  CoinFactorizationDouble * work = NULL;
+  if (state==4) {
+    index = new int [numberThreads*numberRows_];
+    work = new CoinFactorizationDouble [numberThreads*numberRows_];
+  }
+  // share out columns by elements
+  double total = 0.0;
+  int iColumn;
+  for (iColumn=0;iColumn<numberColumns;iColumn++)
+    total += numberInColumn[iColumn];
+  double done = 0.0;
+  iColumn = 0;
+  for (int i=0;i<numberThreads;i++) {
+    thread[i].factorization = this;
+    thread[i].state = state;
+    thread[i].firstColumn = iColumn;
+    thread[i].index = index ? index + i*numberRows_ : NULL;
+    thread[i].work = work ? work + i*numberRows_ : NULL;
+    double target = (total*(i+1))/numberThreads;
+    while (iColumn < numberColumns && (done < target || i == numberThreads-1)) 
+      done += numberInColumn[iColumn++];
+    thread[i].lastColumn = iColumn;
+  }
+  CoinThreadPool::run(preProcessWorker,thread,
+		      sizeof(CoinFactorizationPreProcessThread),numberThreads);
+  if (state==2) {
+    for (int i=0;i<numberThreads;i++) {
+      basisNorm_ = CoinMax(basisNorm_,thread[i].norm);
+      largestBasisElement_ = CoinMax(largestBasisElement_,thread[i].largest);
+    }
+  }
+  delete [] index;
+  delete [] work;
+  delete [] thread;
+}
 #ifdef CLP_FACTORIZATION_INSTRUMENT
 double externalTimeStart=0.0;
 double timeInFactorize=0.0;
@@ -1045,6 +1352,9 @@ int endLengthU2=0;
 int
 CoinFactorization::factor (  )
 {
+  COIN_TIME_SCOPE("factorization.factor");
+  // old reach in L no longer valid
+  reachInputL_=-1;
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   int nUse=numberUpdate+numberUpdateTranspose+numberUpdateFT+
     2*numberUpdateTwoFT+numberReplace;
@@ -1195,6 +1505,7 @@ CoinFactorization::factor (  )
   currentLengthU=lengthU_;
   currentTakeoutU=0;
 #endif
+  CoinChargeWork(static_cast<double>(totalElements_));
   return status_;
 }
 
@@ -1940,6 +2251,9 @@ CoinFactorization::cleanup (  )
 #endif
   numberU_ = numberU;
   numberGoodU_ = numberU;
+  numberPendingU_ = 0;
+  refactorRecommended_ = false;
+  updateWork_ = 0.0;
   numberL_ = numberGoodL_;
 #if COIN_DEBUG
   for ( i = 0; i < numberRows_; i++ ) {
@@ -2083,6 +2397,11 @@ CoinFactorization::cleanup (  )
     lengthAreaR_ = space;
     elementR_ = elementL_.array() + lengthL_;
     indexRowR_ = indexRowL_.array() + lengthL_;
+    if (adaptiveRefactor_ && areaFactor_ > 1.0 && space > 4 * needed
+	&& 4 * lengthU_ < lengthAreaU_) {
+      // areas were made larger than this model needs - give some back
+      areaFactor_ = CoinMax(0.9 * areaFactor_, 1.0);
+    }
   } else {
     lengthR_ = 0;
     lengthAreaR_ = space;
@@ -2098,6 +2417,187 @@ CoinFactorization::cleanup (  )
     }
   }
   numberR_ = 0;
+  numberBlocksR_ = 0;
+  firstUnblockedR_ = numberRows_;
+  findSupernodes();
+  makeFloatFactors();
+}
+// Finds runs of columns in L and U with same pattern (after cleanup)
+void
+CoinFactorization::findSupernodes (  )
+{
+  supernodeL_.conditionalDelete();
+  supernodeU_.conditionalDelete();
+  if (supernodeThreshold_<2)
+    return;
+  /* Columns with identical patterns are independent as L is strictly
+     below diagonal and U strictly above (in permuted order) */
+  const CoinBigIndex * startColumnL = startColumnL_.array();
+  const int * indexRowL = indexRowL_.array();
+  int last = numberRows_;
+#if COIN_FACTORIZATION_DENSE_CODE
+  last -= numberDense_;
+#endif
+  int * runL = supernodeL_.conditionalNew(numberRows_);
+  CoinZeroN(runL,numberRows_);
+  bool anyBlocks=false;
+  for (int i = last - 1; i >= baseL_; i-- ) {
+    CoinBigIndex start = startColumnL[i];
+    int number = startColumnL[i+1] - start;
+    if (number) {
+      runL[i]=1;
+      if (i<last-1&&number==startColumnL[i+2]-startColumnL[i+1]&&
+	  !memcmp(indexRowL+start,indexRowL+start+number,number*sizeof(int)))
+	runL[i]=runL[i+1]+1;
+    }
+  }
+  // take out short runs
+  for (int i = baseL_; i < last; ) {
+    int number = CoinMax(runL[i],1);
+    if (runL[i]<supernodeThreshold_) 
+      CoinZeroN(runL+i,number);
+    else
+      anyBlocks=true;
+    i += number;
+  }
+  if (!anyBlocks)
+    supernodeL_.conditionalDelete();
+  const CoinBigIndex * startColumnU = startColumnU_.array();
+  const int * numberInColumn = numberInColumn_.array();
+  const int * indexRowU = indexRowU_.array();
+  int * runU = supernodeU_.conditionalNew(numberU_);
+  CoinZeroN(runU,numberU_);
+  anyBlocks=false;
+  for (int i = numberSlacks_; i < numberU_; i++ ) {
+    int number = numberInColumn[i];
+    if (number) {
+      runU[i]=1;
+      if (i>numberSlacks_&&number==numberInColumn[i-1]&&
+	  !memcmp(indexRowU+startColumnU[i],indexRowU+startColumnU[i-1],
+		  number*sizeof(int)))
+	runU[i]=runU[i-1]+1;
+    }
+  }
+  for (int i = numberU_-1; i >= numberSlacks_; ) {
+    int number = CoinMax(runU[i],1);
+    if (runU[i]<supernodeThreshold_) 
+      CoinZeroN(runU+i-number+1,number);
+    else
+      anyBlocks=true;
+    i -= number;
+  }
+  if (!anyBlocks)
+    supernodeU_.conditionalDelete();
+}
+// Makes float copies of L and U if mixed precision (after cleanup)
+void
+CoinFactorization::makeFloatFactors (  )
+{
+  elementLFloat_.conditionalDelete();
+  elementUFloat_.conditionalDelete();
+  if (!mixedPrecision_||!numberRows_)
+    return;
+  // L is contiguous
+  const CoinFactorizationDouble * elementL = elementL_.array();
+  float * elementLFloat = elementLFloat_.conditionalNew(lengthL_+1);
+  for (CoinBigIndex j=0;j<lengthL_;j++)
+    elementLFloat[j] = static_cast<float> (elementL[j]);
+  // U may have gaps so only do what is used
+  const CoinBigIndex * startColumnU = startColumnU_.array();
+  const int * numberInColumn = numberInColumn_.array();
+  const CoinFactorizationDouble * elementU = elementU_.array();
+  CoinBigIndex endU = 0;
+  for (int i = numberSlacks_; i < numberU_; i++ ) {
+    if (numberInColumn[i])
+      endU = CoinMax(endU,startColumnU[i]+numberInColumn[i]);
+  }
+  float * elementUFloat = elementUFloat_.conditionalNew(endU+1);
+  for (int i = numberSlacks_; i < numberU_; i++ ) {
+    CoinBigIndex start = startColumnU[i];
+    CoinBigIndex end = start + numberInColumn[i];
+    for (CoinBigIndex j=start;j<end;j++)
+      elementUFloat[j] = static_cast<float> (elementU[j]);
+  }
+}
+/* Merges R etas since last block into a block if worthwhile.
+   They must not refer to each other's pivots or replaced rows (so can
+   be done in any order) and the block over the union of their rows
+   must be at least half full */
+void
+CoinFactorization::makeBlockR (  )
+{
+  int first = CoinMax(firstUnblockedR_,numberRows_);
+  int last = numberRowsExtra_;
+  firstUnblockedR_ = last;
+  int numberEtas = last - first;
+  if (numberEtas<2||numberEtas>32)
+    return;
+  if (!numberBlocksR_) {
+    // room for as many blocks as there can be
+    int maximumBlocks = maximumPivots_/2+1;
+    blockR_.conditionalNew(3*maximumBlocks);
+    CoinBigIndex * startBlock = startBlockR_.conditionalNew(2*maximumBlocks+2);
+    startBlock[0] = 0;
+    startBlock[1] = 0;
+    // at least half full so at most twice size of R
+    indexBlockR_.conditionalNew(lengthAreaR_+1);
+    elementBlockR_.conditionalNew(2*lengthAreaR_+1);
+  }
+  const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
+  const int * indexRow = indexRowR_;
+  const CoinFactorizationDouble * element = elementR_;
+  const int * permute = permute_.array();
+  int * mark = new int [maximumRowsExtra_];
+  CoinFillN(mark,maximumRowsExtra_,-1);
+  // replaced rows may not be used
+  for (int i = first; i < last; i++ ) {
+    int iRow = permute[i];
+    if ( iRow >= first ) {
+      delete [] mark;
+      return;
+    }
+    mark[iRow] = -2;
+  }
+  CoinBigIndex * startBlock = startBlockR_.array() + 2*numberBlocksR_;
+  int * indexBlock = indexBlockR_.array() + startBlock[0];
+  int numberIndices = 0;
+  CoinBigIndex numberElements = 0;
+  bool good = true;
+  for (int i = first; i < last && good; i++ ) {
+    for (CoinBigIndex j = startColumn[i]; j < startColumn[i+1]; j++ ) {
+      int iRow = indexRow[j];
+      if ( iRow >= first || mark[iRow] == -2 ) {
+	good = false;
+	break;
+      } else if ( mark[iRow] < 0 ) {
+	mark[iRow] = numberIndices;
+	indexBlock[numberIndices++] = iRow;
+      }
+    }
+    numberElements += startColumn[i+1] - startColumn[i];
+  }
+  CoinBigIndex size = numberIndices*numberEtas;
+  if ( good && numberIndices && size <= 2*numberElements &&
+       startBlock[0]+numberIndices <= lengthAreaR_ &&
+       startBlock[1]+size <= 2*lengthAreaR_ ) {
+    // for each row the etas in order
+    CoinFactorizationDouble * elementBlock = elementBlockR_.array() + startBlock[1];
+    CoinZeroN(elementBlock,size);
+    for (int i = first; i < last; i++ ) {
+      for (CoinBigIndex j = startColumn[i]; j < startColumn[i+1]; j++ ) {
+	int k = mark[indexRow[j]];
+	elementBlock[k*numberEtas+i-first] = element[j];
+      }
+    }
+    int * block = blockR_.array() + 3*numberBlocksR_;
+    block[0] = first;
+    block[1] = numberEtas;
+    block[2] = numberIndices;
+    startBlock[2] = startBlock[0] + numberIndices;
+    startBlock[3] = startBlock[1] + size;
+    numberBlocksR_++;
+  }
+  delete [] mark;
 }
 // Returns areaFactor but adjusted for dense
 double 
@@ -2496,6 +2996,33 @@ CoinFactorization::pivotOneOtherRow ( int pivotRow,
   deleteLink ( pivotColumn + numberRows_ );
   return true;
 }
+// Sets lazy maintenance of row copy of U
+void 
+CoinFactorization::setLazyRowCopyU(int value)
+{
+  lazyRowCopyU_ = CoinMax(value,0);
+  if (!lazyRowCopyU_)
+    flushRowCopyU();
+}
+// Sets merging of R etas
+void 
+CoinFactorization::setBlockSizeR(int value)
+{
+  blockSizeR_ = CoinMax(CoinMin(value,32),0);
+  if (blockSizeR_==1)
+    blockSizeR_ = 0;
+}
+// Sets number of threads for sparse factorization
+void 
+CoinFactorization::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value,1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
 void 
 CoinFactorization::setPersistenceFlag(int flag)
 { 
@@ -2534,6 +3061,10 @@ CoinFactorization::setPersistenceFlag(int flag)
   indexColumnL_.setPersistence( flag, 0 );
   elementByRowL_.setPersistence( flag, 0 );
   sparse_.setPersistence( flag, 0 );
+  supernodeL_.setPersistence( flag, 0 );
+  elementLFloat_.setPersistence( flag, 0 );
+  elementUFloat_.setPersistence( flag, 0 );
+  supernodeU_.setPersistence( flag, 0 );
 }
 // Delete all stuff
 void 
@@ -13,10 +13,12 @@
 #include <cassert>
 #include <cfloat>
 #include <stdio.h>
+#include <cstring>
 #include "CoinFactorization.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinFinite.hpp"
+#include "CoinThreadPool.hpp"
 #if COIN_FACTORIZATION_DENSE_CODE==1
 // using simple lapack interface
 extern "C" 
@@ -40,6 +42,168 @@ int clapack_dgetrf ( const enum CBLAS_ORDER Order, const int M, const int N, dou
 #ifndef NDEBUG
 static int counter1=0;
 #endif
+// Information for each worker doing columns of a pivot
+typedef struct {
+  CoinFactorization * factorization;
+  const void * markRow;
+  const int * indexL;
+  const CoinFactorizationDouble * multipliersL;
+  CoinFactorizationDouble * work;
+  unsigned int * workArea2;
+  int increment2;
+  int pivotRow;
+  int numberInPivotColumn;
+  int largeInteger;
+  // columns (in saveColumn_) firstColumn to lastColumn-1
+  int firstColumn;
+  int lastColumn;
+  // row, column pairs to take out of row lists afterwards
+  int * removed;
+  int numberRemoved;
+  CoinBigIndex added;
+} CoinFactorizationPivotThread;
+// Body of each pivot worker - does its block of columns
+template <class T> void * 
+CoinFactorization::pivotWorker ( void * info )
+{
+  CoinFactorizationPivotThread * thread = 
+    reinterpret_cast<CoinFactorizationPivotThread *> (info);
+  CoinFactorization * factorization = thread->factorization;
+  const T * markRow = reinterpret_cast<const T *> (thread->markRow);
+  unsigned int * temp2 = thread->workArea2 + 
+    thread->firstColumn*thread->increment2;
+  thread->numberRemoved = 0;
+  thread->added = 0;
+  for (int jColumn = thread->firstColumn; jColumn < thread->lastColumn;
+       jColumn++) {
+    // room already there so can not fail
+    factorization->pivotOneColumn(jColumn, thread->pivotRow,
+				  thread->numberInPivotColumn,
+				  thread->indexL, thread->multipliersL,
+				  thread->work, temp2, markRow,
+				  thread->largeInteger, thread->added,
+				  thread->removed, thread->numberRemoved);
+    temp2 += thread->increment2;
+  }
+  return NULL;
+}
+/* Does columns of pivot row in pivot using numberThreads_ threads.
+   Room is made for every column first so workers only touch their own
+   columns.  Row lists and column links are then done here in the order
+   a single thread would have done them. */
+template <class T> int
+CoinFactorization::pivotColumnsParallel ( int pivotRow, int numberInPivotRow,
+					  int numberInPivotColumn,
+					  const int * indexL,
+					  const CoinFactorizationDouble * multipliersL,
+					  CoinFactorizationDouble work[],
+					  unsigned int workArea2[], 
+					  int increment2,
+					  const T markRow[], int largeInteger,
+					  CoinBigIndex & added)
+{
+  const int * saveColumn = saveColumn_.array();
+  int * numberInColumn = numberInColumn_.array();
+  const int * numberInColumnPlus = numberInColumnPlus_.array();
+  CoinBigIndex * startColumnU = startColumnU_.array();
+  const int * nextColumn = nextColumn_.array();
+  /* get room - again if compression took away room already found
+     (if still compressing leave to one thread) */
+  bool enoughRoom = false;
+  for (int iPass=0;iPass<3&&!enoughRoom;iPass++) {
+    int numberCompressions = numberCompressions_;
+    for (int jColumn = 0; jColumn < numberInPivotRow; jColumn++ ) {
+      int iColumn = saveColumn[jColumn];
+      int next = nextColumn[iColumn];
+      CoinBigIndex space = startColumnU[next] - numberInColumnPlus[next]
+	- startColumnU[iColumn] - numberInColumn[iColumn];
+      if ( space < numberInPivotColumn ) {
+	if ( !getColumnSpace ( iColumn, numberInPivotColumn ) ) 
+	  return -1;
+      }
+    }
+    enoughRoom = (numberCompressions == numberCompressions_);
+  }
+  if (!enoughRoom)
+    return 1;
+  // share out columns by work
+  double total = 0.0;
+  for (int jColumn = 0; jColumn < numberInPivotRow; jColumn++ ) 
+    total += numberInColumn[saveColumn[jColumn]] + numberInPivotColumn;
+  int numberThreads = CoinMin(numberThreads_,numberInPivotRow/2);
+  CoinFactorizationPivotThread * thread = 
+    new CoinFactorizationPivotThread [numberThreads];
+  // first thread uses work - others need own zeroed area
+  CoinFactorizationDouble * workArea = 
+    new CoinFactorizationDouble [(numberThreads-1)*numberInPivotColumn];
+  CoinZeroN(workArea,(numberThreads-1)*numberInPivotColumn);
+  CoinBigIndex numberRemovable = 0;
+  int jColumn = 0;
+  double done = 0.0;
+  for (int i=0;i<numberThreads;i++) {
+    thread[i].factorization = this;
+    thread[i].markRow = markRow;
+    thread[i].indexL = indexL;
+    thread[i].multipliersL = multipliersL;
+    thread[i].work = i ? workArea+(i-1)*numberInPivotColumn : work;
+    thread[i].workArea2 = workArea2;
+    thread[i].increment2 = increment2;
+    thread[i].pivotRow = pivotRow;
+    thread[i].numberInPivotColumn = numberInPivotColumn;
+    thread[i].largeInteger = largeInteger;
+    thread[i].firstColumn = jColumn;
+    double target = (total*(i+1))/numberThreads;
+    // a removed entry must have been in column
+    thread[i].numberRemoved = static_cast<int>(numberRemovable);
+    while (jColumn < numberInPivotRow && (done < target || i == numberThreads-1)) {
+      int number = numberInColumn[saveColumn[jColumn++]];
+      numberRemovable += 2*number;
+      done += number + numberInPivotColumn;
+    }
+    thread[i].lastColumn = jColumn;
+  }
+  int * removed = new int [numberRemovable];
+  for (int i=0;i<numberThreads;i++) 
+    thread[i].removed = removed + thread[i].numberRemoved;
+  CoinThreadPool::run(pivotWorker<T>,thread,
+		      sizeof(CoinFactorizationPivotThread),numberThreads);
+  // now as one thread would have done
+  int * indexColumnU = indexColumnU_.array();
+  CoinBigIndex * startRowU = startRowU_.array();
+  int * numberInRow = numberInRow_.array();
+  int * nextCount = nextCount_.array();
+  for (int i=0;i<numberThreads;i++) {
+    const int * removedThis = thread[i].removed;
+    for (int k=0;k<thread[i].numberRemoved;k+=2) {
+      //take out of row list
+      int iRow = removedThis[k];
+      int iColumn = removedThis[k+1];
+      CoinBigIndex start = startRowU[iRow];
+      CoinBigIndex where = start;
+      
+      while ( indexColumnU[where] != iColumn ) {
+	where++;
+      }			/* endwhile */
+      indexColumnU[where] = indexColumnU[start + numberInRow[iRow] - 1];
+      numberInRow[iRow]--;
+    }
+    for (jColumn = thread[i].firstColumn; jColumn < thread[i].lastColumn;
+	 jColumn++) {
+      int iColumn = saveColumn[jColumn];
+      //linked list for column
+      if ( nextCount[iColumn + numberRows_] != -2 ) {
+	//modify linked list
+	deleteLink ( iColumn + numberRows_ );
+	addLink ( iColumn + numberRows_, numberInColumn[iColumn] );
+      }
+    }
+    added += thread[i].added;
+  }
+  delete [] removed;
+  delete [] workArea;
+  delete [] thread;
+  return 0;
+}
 //  factorSparse.  Does sparse phase of factorization
 //return code is <0 error, 0= finished
 int
@@ -53,6 +217,8 @@ CoinFactorization::factorSparse (  )
     larger = numberRows_;
   }
   int returnCode;
+  // growth is largest element seen in active columns until end
+  growthFactor_ = largestBasisElement_;
 #define LARGELIMIT 65530
 #define SMALL_SET 65531
 #define SMALL_UNSET (SMALL_SET+1)
@@ -62,8 +228,53 @@ CoinFactorization::factorSparse (  )
     returnCode = factorSparseSmall();
   else
     returnCode = factorSparseLarge();
+  if (largestBasisElement_)
+    growthFactor_ /= largestBasisElement_;
+  else
+    growthFactor_ = 1.0;
   return returnCode;
 }
+// Takes next pivot from last pivot order if still acceptable
+bool
+CoinFactorization::followPivot ( int & iPivotRow, int & iPivotColumn,
+				 CoinBigIndex & pivotRowPosition )
+{
+  const int * follow = followOrder_.array();
+  const int * numberInRow = numberInRow_.array();
+  const int * numberInColumn = numberInColumn_.array();
+  const CoinBigIndex * startColumn = startColumnU_.array();
+  const int * indexRow = indexRowU_.array();
+  const CoinFactorizationDouble * element = elementU_.array();
+  while ( nextFollow_ < numberFollow_ ) {
+    int iRow = follow[2*nextFollow_];
+    int iColumn = follow[2*nextFollow_+1];
+    nextFollow_++;
+    // may have gone already (e.g. as slack)
+    if ( numberInRow[iRow] <= 0 || numberInColumn[iColumn] <= 0 )
+      continue;
+    CoinBigIndex start = startColumn[iColumn];
+    CoinBigIndex end = start + numberInColumn[iColumn];
+    CoinBigIndex where;
+    for ( where = start; where < end; where++ ) {
+      if ( indexRow[where] == iRow ) 
+	break;
+    }
+    if ( where == end )
+      continue;
+    // largest in column is first
+    if ( fabs ( element[where] ) < pivotTolerance_ * fabs ( element[start] ) ) {
+      // not stable now - search for rest
+      numberFollow_ = 0;
+      return false;
+    }
+    iPivotRow = iRow;
+    iPivotColumn = iColumn;
+    pivotRowPosition = where;
+    numberFollowed_++;
+    return true;
+  }
+  return false;
+}
 //  factorSparse.  Does sparse phase of factorization
 //return code is <0 error, 0= finished
 int
@@ -203,7 +414,11 @@ CoinFactorization::factorSparseSmall (  )
     int trials = 0;
     int * pivotColumn = pivotColumn_.array();
 
-    if ( count == 1 && firstCount[1] >= 0 &&!biasLU_) {
+    if ( nextFollow_ < numberFollow_ && firstCount[1] < 0 &&
+	 followPivot ( iPivotRow, iPivotColumn, pivotRowPosition ) ) {
+      // same pivot as last factorization - no search
+      look = -1;
+    } else if ( count == 1 && firstCount[1] >= 0 &&!biasLU_) {
       //do column singletons first to put more in U
       while ( look >= 0 ) {
         if ( look < numberRows_ ) {
@@ -338,6 +553,14 @@ CoinFactorization::factorSparseSmall (  )
     }				/* endwhile */
     if (iPivotRow>=0) {
       assert (iPivotRow<numberRows_);
+      // growth - largest of each column in pivot row is first
+      CoinBigIndex startGrowth = startRow[iPivotRow];
+      CoinBigIndex endGrowth = startGrowth + numberInRow[iPivotRow];
+      for (CoinBigIndex j = startGrowth; j < endGrowth; j++ ) {
+	double value = fabs(element[startColumn[indexColumn[j]]]);
+	if (value>growthFactor_)
+	  growthFactor_ = value;
+      }
       int numberDoRow = numberInRow[iPivotRow] - 1;
       int numberDoColumn = numberInColumn[iPivotColumn] - 1;
       
@@ -407,6 +630,13 @@ CoinFactorization::factorSparseSmall (  )
 	}
       }
       assert (nextRow_.array()[iPivotRow]==numberGoodU_);
+      if ( numberRecorded_ >= 0 ) {
+        // remember for next factorization
+        int * recorded = followOrder_.array() + 2 * numberRows_;
+        recorded[2*numberRecorded_] = iPivotRow;
+        recorded[2*numberRecorded_+1] = iPivotColumn;
+        numberRecorded_++;
+      }
       pivotColumn[numberGoodU_] = iPivotColumn;
       numberGoodU_++;
       // This should not need to be trapped here - but be safe
@@ -809,6 +1039,8 @@ CoinFactorization::saveFactorization (const char * file  ) const
 {
   FILE * fp = fopen(file,"wb");
   if (fp) {
+    // row copy of U must be complete
+    const_cast<CoinFactorization *>(this)->flushRowCopyU();
     // Save so we can pick up scalars
     const char * first = reinterpret_cast<const char *> ( &pivotTolerance_);
     const char * last = reinterpret_cast<const char *> ( &biasLU_);
@@ -1049,6 +1281,306 @@ CoinFactorization::restoreFactorization (const char * file , bool factorIt )
   }
   return 0;
 }
+/* Binary factorization file - header of magic, version, sizes of
+   CoinBigIndex and CoinFactorizationDouble and flags, then integer and
+   double scalars, then used parts of arrays in the order of
+   gutsOfCopyContents.  Byte order is native. */
+namespace {
+  const char factorMagic[8] = {'C','O','I','N','F','A','C','\0'};
+  const int factorVersion = 1;
+  const int numberFactorIntegers = 37;
+  const int numberFactorDoubles = 20;
+  template <class T> bool putFactorArray(FILE * fp, const T * array,
+					 CoinBigIndex number)
+  {
+    return number<=0||
+      fwrite(array,number*sizeof(T),1,fp)==1;
+  }
+  template <class T> bool getFactorArray(FILE * fp, T * array,
+					 CoinBigIndex number)
+  {
+    return number<=0||
+      fread(array,number*sizeof(T),1,fp)==1;
+  }
+}
+// Writes factorization to a binary file
+int
+CoinFactorization::writeFactorization (const char * file  ) const
+{
+  FILE * fp = fopen(file,"wb");
+  if (!fp)
+    return -1;
+  // row copy of U must be complete
+  const_cast<CoinFactorization *>(this)->flushRowCopyU();
+  const CoinBigIndex * startRowU = startRowU_.array();
+  const int * numberInRow = numberInRow_.array();
+  bool rowCopyU = (convertRowToColumnU_.array()!=NULL);
+  // extent of row copy of U
+  CoinBigIndex lengthRowU = 0;
+  if (rowCopyU) {
+    for (int iRow = 0; iRow < numberRowsExtra_; iRow++ ) 
+      lengthRowU = CoinMax(lengthRowU,startRowU[iRow]+numberInRow[iRow]);
+  }
+  int header[4];
+  header[0] = factorVersion;
+  header[1] = sizeof(CoinBigIndex);
+  header[2] = sizeof(CoinFactorizationDouble);
+  header[3] = rowCopyU ? 1 : 0;
+  CoinBigIndex integers[numberFactorIntegers+1] =
+    {numberTrials_, biggerDimension_, numberSlacks_, numberU_, maximumU_,
+     lengthU_, lengthAreaU_, numberL_, baseL_, lengthL_,
+     lengthAreaL_, numberR_, lengthR_, numberRows_, numberRowsExtra_,
+     maximumRowsExtra_, numberColumns_, numberColumnsExtra_,
+     maximumColumnsExtra_, maximumPivots_,
+     numberGoodU_, numberGoodL_, numberPivots_, messageLevel_,
+     totalElements_, factorElements_, status_, doForrestTomlin_ ? 1 : 0,
+     numberFtranCounts_, numberBtranCounts_,
+     biasLU_, sparseThreshold_, sparseThreshold2_, numberDense_,
+     denseThreshold_, supernodeThreshold_, adaptiveSparse_ ? 1 : 0,
+     lengthRowU};
+#ifndef COIN_FAST_CODE
+  double slackValue = slackValue_;
+#else
+  double slackValue = -1.0;
+#endif
+  double doubles[numberFactorDoubles] =
+    {pivotTolerance_, zeroTolerance_, slackValue, areaFactor_, relaxCheck_,
+     ftranCountInput_, ftranCountAfterL_, ftranCountAfterR_,
+     ftranCountAfterU_, btranCountInput_, btranCountAfterU_,
+     btranCountAfterR_, btranCountAfterL_,
+     ftranAverageAfterL_, ftranAverageAfterR_, ftranAverageAfterU_,
+     btranAverageAfterU_, btranAverageAfterR_, btranAverageAfterL_,
+     adaptiveRatioL_};
+  bool ok = fwrite(factorMagic,sizeof(factorMagic),1,fp)==1&&
+    putFactorArray(fp,header,4)&&
+    putFactorArray(fp,integers,numberFactorIntegers+1)&&
+    putFactorArray(fp,doubles,numberFactorDoubles);
+  if (ok&&numberRowsExtra_) {
+    int number = numberRowsExtra_ + 1;
+    if (rowCopyU) {
+      ok = ok&&putFactorArray(fp,startRowU,number)&&
+	putFactorArray(fp,numberInRow,number)&&
+	putFactorArray(fp,startRowU+maximumRowsExtra_,1);
+    }
+    ok = ok&&putFactorArray(fp,pivotRegion_.array(),numberRowsExtra_)&&
+      putFactorArray(fp,permuteBack_.array(),number)&&
+      putFactorArray(fp,permute_.array(),number)&&
+      putFactorArray(fp,pivotColumnBack_.array(),number)&&
+      putFactorArray(fp,firstCount_.array(),number)&&
+      putFactorArray(fp,startColumnU_.array(),number)&&
+      putFactorArray(fp,numberInColumn_.array(),number)&&
+      putFactorArray(fp,pivotColumn_.array(),number)&&
+      putFactorArray(fp,nextColumn_.array(),number)&&
+      putFactorArray(fp,lastColumn_.array(),number)&&
+      putFactorArray(fp,startColumnR_.array(),
+		     numberRowsExtra_ - numberColumns_ + 1)&&
+      putFactorArray(fp,startColumnU_.array()+maximumColumnsExtra_,1)&&
+      putFactorArray(fp,nextColumn_.array()+maximumColumnsExtra_,1)&&
+      putFactorArray(fp,lastColumn_.array()+maximumColumnsExtra_,1)&&
+      putFactorArray(fp,nextRow_.array(),number)&&
+      putFactorArray(fp,lastRow_.array(),number)&&
+      putFactorArray(fp,nextRow_.array()+maximumRowsExtra_,1)&&
+      putFactorArray(fp,lastRow_.array()+maximumRowsExtra_,1);
+  }
+  ok = ok&&putFactorArray(fp,elementR_,lengthR_)&&
+    putFactorArray(fp,indexRowR_,lengthR_)&&
+    putFactorArray(fp,elementU_.array(),maximumU_)&&
+    putFactorArray(fp,indexRowU_.array(),maximumU_);
+  if (rowCopyU) {
+    ok = ok&&putFactorArray(fp,indexColumnU_.array(),lengthRowU)&&
+      putFactorArray(fp,convertRowToColumnU_.array(),lengthRowU);
+  }
+  if (numberRows_)
+    ok = ok&&putFactorArray(fp,startColumnL_.array(),numberRows_+1);
+  ok = ok&&putFactorArray(fp,elementL_.array(),lengthL_)&&
+    putFactorArray(fp,indexRowL_.array(),lengthL_)&&
+    putFactorArray(fp,denseAreaAddress_,numberDense_*numberDense_)&&
+    putFactorArray(fp,densePermute_,numberDense_);
+  if (fclose(fp))
+    ok = false;
+  return ok ? 0 : -1;
+}
+// Restores factorization written by writeFactorization
+int
+CoinFactorization::readFactorization (const char * file  )
+{
+  FILE * fp = fopen(file,"rb");
+  if (!fp)
+    return -1;
+  char magic[8];
+  int header[4];
+  CoinBigIndex integers[numberFactorIntegers+1];
+  double doubles[numberFactorDoubles];
+  bool ok = fread(magic,sizeof(magic),1,fp)==1&&
+    !memcmp(magic,factorMagic,sizeof(magic))&&
+    getFactorArray(fp,header,4)&&
+    header[0]==factorVersion&&
+    header[1]==static_cast<int>(sizeof(CoinBigIndex))&&
+    header[2]==static_cast<int>(sizeof(CoinFactorizationDouble))&&
+    getFactorArray(fp,integers,numberFactorIntegers+1)&&
+    getFactorArray(fp,doubles,numberFactorDoubles);
+  bool rowCopyU = ok&&(header[3]&1)!=0;
+  CoinBigIndex lengthRowU = ok ? integers[numberFactorIntegers] : 0;
+  if (ok) {
+    // dimensions must fit together
+    for (int i=0;i<numberFactorIntegers+1;i++) {
+      if (integers[i]<0&&i!=26)
+	ok = false;
+    }
+    CoinBigIndex maximumU = integers[4];
+    CoinBigIndex lengthAreaU = integers[6];
+    CoinBigIndex lengthL = integers[9];
+    CoinBigIndex lengthAreaL = integers[10];
+    CoinBigIndex lengthR = integers[12];
+    CoinBigIndex numberRows = integers[13];
+    CoinBigIndex numberRowsExtra = integers[14];
+    CoinBigIndex maximumRowsExtra = integers[15];
+    CoinBigIndex numberColumns = integers[16];
+    CoinBigIndex maximumColumnsExtra = integers[18];
+    CoinBigIndex maximumPivots = integers[19];
+    CoinBigIndex numberDense = integers[33];
+    if (maximumU>lengthAreaU||lengthRowU>lengthAreaU||
+	lengthL+lengthR>lengthAreaL||numberRows>numberRowsExtra||
+	numberRowsExtra>maximumRowsExtra||
+	numberRowsExtra>maximumColumnsExtra||
+	numberRowsExtra-numberColumns>maximumPivots||
+	numberDense>numberRows||(!numberRowsExtra&&numberRows))
+      ok = false;
+  }
+  // get rid of current
+  gutsOfDestructor();
+  gutsOfInitialize(2);
+  if (ok) {
+    int n=0;
+    numberTrials_ = static_cast<int>(integers[n++]);
+    biggerDimension_ = static_cast<int>(integers[n++]);
+    numberSlacks_ = static_cast<int>(integers[n++]);
+    numberU_ = static_cast<int>(integers[n++]);
+    maximumU_ = integers[n++];
+    lengthU_ = integers[n++];
+    lengthAreaU_ = integers[n++];
+    numberL_ = integers[n++];
+    baseL_ = integers[n++];
+    lengthL_ = integers[n++];
+    lengthAreaL_ = integers[n++];
+    numberR_ = static_cast<int>(integers[n++]);
+    lengthR_ = integers[n++];
+    numberRows_ = static_cast<int>(integers[n++]);
+    numberRowsExtra_ = static_cast<int>(integers[n++]);
+    maximumRowsExtra_ = static_cast<int>(integers[n++]);
+    numberColumns_ = static_cast<int>(integers[n++]);
+    numberColumnsExtra_ = static_cast<int>(integers[n++]);
+    maximumColumnsExtra_ = static_cast<int>(integers[n++]);
+    maximumPivots_ = static_cast<int>(integers[n++]);
+    numberGoodU_ = static_cast<int>(integers[n++]);
+    numberGoodL_ = static_cast<int>(integers[n++]);
+    numberPivots_ = static_cast<int>(integers[n++]);
+    messageLevel_ = static_cast<int>(integers[n++]);
+    totalElements_ = integers[n++];
+    factorElements_ = integers[n++];
+    status_ = static_cast<int>(integers[n++]);
+    doForrestTomlin_ = integers[n++]!=0;
+    numberFtranCounts_ = static_cast<int>(integers[n++]);
+    numberBtranCounts_ = static_cast<int>(integers[n++]);
+    biasLU_ = static_cast<int>(integers[n++]);
+    sparseThreshold_ = static_cast<int>(integers[n++]);
+    sparseThreshold2_ = static_cast<int>(integers[n++]);
+    numberDense_ = static_cast<int>(integers[n++]);
+    denseThreshold_ = static_cast<int>(integers[n++]);
+    supernodeThreshold_ = static_cast<int>(integers[n++]);
+    adaptiveSparse_ = integers[n++]!=0;
+    assert (n==numberFactorIntegers);
+    n=0;
+    pivotTolerance_ = doubles[n++];
+    zeroTolerance_ = doubles[n++];
+#ifndef COIN_FAST_CODE
+    slackValue_ = doubles[n++];
+#else
+    n++;
+#endif
+    areaFactor_ = doubles[n++];
+    relaxCheck_ = doubles[n++];
+    ftranCountInput_ = doubles[n++];
+    ftranCountAfterL_ = doubles[n++];
+    ftranCountAfterR_ = doubles[n++];
+    ftranCountAfterU_ = doubles[n++];
+    btranCountInput_ = doubles[n++];
+    btranCountAfterU_ = doubles[n++];
+    btranCountAfterR_ = doubles[n++];
+    btranCountAfterL_ = doubles[n++];
+    ftranAverageAfterL_ = doubles[n++];
+    ftranAverageAfterR_ = doubles[n++];
+    ftranAverageAfterU_ = doubles[n++];
+    btranAverageAfterU_ = doubles[n++];
+    btranAverageAfterR_ = doubles[n++];
+    btranAverageAfterL_ = doubles[n++];
+    adaptiveRatioL_ = doubles[n++];
+    assert (n==numberFactorDoubles);
+    getCopyAreas(*this,rowCopyU,false);
+    lengthAreaR_ = lengthAreaL_ - lengthL_;
+    elementR_ = elementL_.array() + lengthL_;
+    indexRowR_ = indexRowL_.array() + lengthL_;
+    if (numberRowsExtra_) {
+      int number = numberRowsExtra_ + 1;
+      if (rowCopyU) {
+	ok = ok&&getFactorArray(fp,startRowU_.array(),number)&&
+	  getFactorArray(fp,numberInRow_.array(),number)&&
+	  getFactorArray(fp,startRowU_.array()+maximumRowsExtra_,1);
+      }
+      ok = ok&&getFactorArray(fp,pivotRegion_.array(),numberRowsExtra_)&&
+	getFactorArray(fp,permuteBack_.array(),number)&&
+	getFactorArray(fp,permute_.array(),number)&&
+	getFactorArray(fp,pivotColumnBack_.array(),number)&&
+	getFactorArray(fp,firstCount_.array(),number)&&
+	getFactorArray(fp,startColumnU_.array(),number)&&
+	getFactorArray(fp,numberInColumn_.array(),number)&&
+	getFactorArray(fp,pivotColumn_.array(),number)&&
+	getFactorArray(fp,nextColumn_.array(),number)&&
+	getFactorArray(fp,lastColumn_.array(),number)&&
+	getFactorArray(fp,startColumnR_.array(),
+		       numberRowsExtra_ - numberColumns_ + 1)&&
+	getFactorArray(fp,startColumnU_.array()+maximumColumnsExtra_,1)&&
+	getFactorArray(fp,nextColumn_.array()+maximumColumnsExtra_,1)&&
+	getFactorArray(fp,lastColumn_.array()+maximumColumnsExtra_,1)&&
+	getFactorArray(fp,nextRow_.array(),number)&&
+	getFactorArray(fp,lastRow_.array(),number)&&
+	getFactorArray(fp,nextRow_.array()+maximumRowsExtra_,1)&&
+	getFactorArray(fp,lastRow_.array()+maximumRowsExtra_,1);
+    }
+    ok = ok&&getFactorArray(fp,elementR_,lengthR_)&&
+      getFactorArray(fp,indexRowR_,lengthR_)&&
+      getFactorArray(fp,elementU_.array(),maximumU_)&&
+      getFactorArray(fp,indexRowU_.array(),maximumU_);
+    if (rowCopyU) {
+      ok = ok&&getFactorArray(fp,indexColumnU_.array(),lengthRowU)&&
+	getFactorArray(fp,convertRowToColumnU_.array(),lengthRowU);
+    }
+    if (numberRows_)
+      ok = ok&&getFactorArray(fp,startColumnL_.array(),numberRows_+1);
+    ok = ok&&getFactorArray(fp,elementL_.array(),lengthL_)&&
+      getFactorArray(fp,indexRowL_.array(),lengthL_);
+    if (ok&&numberDense_) {
+      denseArea_ = new double [numberDense_*numberDense_];
+      denseAreaAddress_ = denseArea_;
+      densePermute_ = new int [numberDense_];
+      ok = getFactorArray(fp,denseAreaAddress_,numberDense_*numberDense_)&&
+	getFactorArray(fp,densePermute_,numberDense_);
+    }
+  }
+  fclose(fp);
+  if (!ok) {
+    gutsOfDestructor();
+    gutsOfInitialize(2);
+    return -2;
+  }
+  if (sparseThreshold_) 
+    goSparse();
+  if (supernodeThreshold_&&!status_&&numberRows_)
+    findSupernodes();
+  if (!status_)
+    makeFloatFactors();
+  return 0;
+}
 //  factorSparse.  Does sparse phase of factorization
 //return code is <0 error, 0= finished
 int
@@ -1185,7 +1717,11 @@ CoinFactorization::factorSparseLarge (  )
     int trials = 0;
     int * pivotColumn = pivotColumn_.array();
 
-    if ( count == 1 && firstCount[1] >= 0 &&!biasLU_) {
+    if ( nextFollow_ < numberFollow_ && firstCount[1] < 0 &&
+	 followPivot ( iPivotRow, iPivotColumn, pivotRowPosition ) ) {
+      // same pivot as last factorization - no search
+      look = -1;
+    } else if ( count == 1 && firstCount[1] >= 0 &&!biasLU_) {
       //do column singletons first to put more in U
       while ( look >= 0 ) {
         if ( look < numberRows_ ) {
@@ -1320,6 +1856,14 @@ CoinFactorization::factorSparseLarge (  )
     }				/* endwhile */
     if (iPivotRow>=0) {
       if ( iPivotRow >= 0 ) {
+        // growth - largest of each column in pivot row is first
+        CoinBigIndex startGrowth = startRow[iPivotRow];
+        CoinBigIndex endGrowth = startGrowth + numberInRow[iPivotRow];
+        for (CoinBigIndex j = startGrowth; j < endGrowth; j++ ) {
+	  double value = fabs(element[startColumn[indexColumn[j]]]);
+	  if (value>growthFactor_)
+	    growthFactor_ = value;
+        }
         int numberDoRow = numberInRow[iPivotRow] - 1;
         int numberDoColumn = numberInColumn[iPivotColumn] - 1;
         
@@ -1390,6 +1934,13 @@ CoinFactorization::factorSparseLarge (  )
           }
         }
 	assert (nextRow_.array()[iPivotRow]==numberGoodU_);
+        if ( numberRecorded_ >= 0 ) {
+          // remember for next factorization
+          int * recorded = followOrder_.array() + 2 * numberRows_;
+          recorded[2*numberRecorded_] = iPivotRow;
+          recorded[2*numberRecorded_+1] = iPivotColumn;
+          numberRecorded_++;
+        }
         pivotColumn[numberGoodU_] = iPivotColumn;
         numberGoodU_++;
         // This should not need to be trapped here - but be safe
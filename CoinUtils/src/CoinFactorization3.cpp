@@ -16,9 +16,17 @@
 #include "CoinFactorization.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
+#include "CoinPermute.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFinite.hpp"
 #include "CoinTime.hpp"
+#include "CoinInstrument.hpp"
+#include "CoinThreadPool.hpp"
 #include <stdio.h>
 #include <iostream>
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 #if COIN_FACTORIZATION_DENSE_CODE==1 
 // using simple lapack interface
 extern "C" 
@@ -45,6 +53,8 @@ int clapack_dgetrs ( const enum CBLAS_ORDER Order,
 // Intel compiler
 #include "mkl_lapacke.h"
 #endif
+// Prefetch distance in long R etas
+#define COIN_R_PREFETCH 16
 // For semi-sparse
 #define BITS_PER_CHECK 8
 #define CHECK_SHIFT 3
@@ -91,6 +101,18 @@ int CoinFactorization::updateColumn ( CoinIndexedVector * regionSparse,
 				      bool noPermute) 
   const
 {
+  return updateColumnWork(regionSparse,regionSparse2,noPermute,
+			  sparse_.array());
+}
+/* As updateColumn but sparse work area is passed in
+   (so can be called from several threads at once) */
+int CoinFactorization::updateColumnWork ( CoinIndexedVector * regionSparse,
+					  CoinIndexedVector * regionSparse2,
+					  bool noPermute,
+					  int * COIN_RESTRICT sparseWork) 
+  const
+{
+  COIN_TIME_SCOPE("factorization.ftran");
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX=CoinCpuTime();
 #endif
@@ -108,58 +130,42 @@ int CoinFactorization::updateColumn ( CoinIndexedVector * regionSparse,
     double * COIN_RESTRICT array = regionSparse2->denseVector();
 #ifndef CLP_FACTORIZATION
     bool packed = regionSparse2->packedMode();
-    if (packed) {
-      for (int j = 0; j < numberNonZero; j ++ ) {
-	int iRow = index[j];
-	double value = array[j];
-	array[j]=0.0;
-	iRow = permute[iRow];
-	region[iRow] = value;
-	regionIndex[j] = iRow;
-      }
-    } else {
 #else
-      assert (!regionSparse2->packedMode());
-#endif
-      for (int j = 0; j < numberNonZero; j ++ ) {
-	int iRow = index[j];
-	double value = array[iRow];
-	array[iRow]=0.0;
-	iRow = permute[iRow];
-	region[iRow] = value;
-	regionIndex[j] = iRow;
-      }
-#ifndef CLP_FACTORIZATION
-    }
+    assert (!regionSparse2->packedMode());
+    bool packed = false;
 #endif
+    CoinPermuteScatter(permute,index,numberNonZero,array,packed,
+		       region,regionIndex);
     regionSparse->setNumElements ( numberNonZero );
 #ifndef CLP_FACTORIZATION
   } else {
     numberNonZero = regionSparse->getNumElements();
   }
 #endif
-  if (collectStatistics_) {
+  if (collectStatistics_&&sparseWork==sparse_.array()) {
     numberFtranCounts_++;
     ftranCountInput_ += numberNonZero;
   }
+  CoinChargeWork(numberNonZero);
     
   //  ******* L
-  updateColumnL ( regionSparse, regionIndex );
-  if (collectStatistics_) 
+  updateColumnL ( regionSparse, regionIndex, sparseWork, true );
+  if (collectStatistics_&&sparseWork==sparse_.array()) 
     ftranCountAfterL_ += regionSparse->getNumElements();
   //permute extra
   //row bits here
-  updateColumnR ( regionSparse );
-  if (collectStatistics_) 
+  updateColumnR ( regionSparse, sparseWork );
+  if (collectStatistics_&&sparseWork==sparse_.array()) 
     ftranCountAfterR_ += regionSparse->getNumElements();
   
   //update counts
   //  ******* U
-  updateColumnU ( regionSparse, regionIndex);
+  updateColumnU ( regionSparse, regionIndex, sparseWork, true);
   if (!doForrestTomlin_) {
     // Do PFI after everything else
     updateColumnPFI(regionSparse);
   }
+  CoinChargeWork(regionSparse->getNumElements());
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   numberUpdate++;
   timeInUpdate += CoinCpuTime()-startTimeX;
@@ -174,6 +180,221 @@ int CoinFactorization::updateColumn ( CoinIndexedVector * regionSparse,
     return regionSparse->getNumElements (  );
   }
 }
+/* Updates several columns (FTRAN) - densish ones go through
+   L, R and U together */
+int
+CoinFactorization::updateColumns ( CoinIndexedVector * regionSparse,
+				   int numberColumns,
+				   CoinIndexedVector ** regionSparse2) const
+{
+  if (numberColumns>16) {
+    // more regions than stay in cache together - do in groups
+    int totalNonZero = 0;
+    for (int i=0;i<numberColumns;i+=16)
+      totalNonZero += updateColumns(regionSparse,CoinMin(16,numberColumns-i),
+				    regionSparse2+i);
+    return totalNonZero;
+  }
+  COIN_TIME_SCOPE("factorization.ftran");
+  const int * COIN_RESTRICT permute = permute_.array();
+  double * COIN_RESTRICT region = regionSparse->denseVector();
+  int * COIN_RESTRICT regionIndex = regionSparse->getIndices();
+  int numberDensish = 0;
+  CoinIndexedVector ** densish = new CoinIndexedVector * [numberColumns];
+  //  ******* L
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = regionSparse2[i];
+    assert (!column->packedMode()&&column->capacity()>=maximumRowsExtra_);
+    int numberNonZero = column->getNumElements();
+    int * COIN_RESTRICT index = column->getIndices();
+    double * COIN_RESTRICT array = column->denseVector();
+    // permute in place (through region)
+    CoinPermuteScatter(permute,index,numberNonZero,array,false,
+		       region,regionIndex);
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = regionIndex[j];
+      array[iRow] = region[iRow];
+      region[iRow] = 0.0;
+      index[j] = iRow;
+    }
+    CoinChargeWork(numberNonZero);
+    if (!updateColumnLMethod(numberNonZero)) {
+      densish[numberDensish++] = column;
+      if (numberL_)
+	continue;
+    }
+    updateColumnL ( column, index, sparse_.array() );
+  }
+  if (numberL_) {
+    if (numberDensish>1) {
+      updateColumnsLDensish(numberDensish,densish);
+      for (int i=0;i<numberDensish;i++)
+	updateColumnLDense(densish[i],densish[i]->getIndices());
+    } else if (numberDensish) {
+      updateColumnL ( densish[0], densish[0]->getIndices(), sparse_.array() );
+    }
+  }
+  //  ******* R (densish ones by eta)
+  if (numberDensish>1) {
+    if (numberR_)
+      updateColumnsRByEta(numberDensish,densish);
+  } else {
+    numberDensish = 0;
+  }
+  int iDensish = 0;
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = regionSparse2[i];
+    if (iDensish<numberDensish&&densish[iDensish]==column)
+      iDensish++;
+    else
+      updateColumnR ( column, sparse_.array() );
+  }
+  //  ******* U
+  if (numberDensish)
+    updateColumnsUDensish(numberDensish,densish);
+  iDensish = 0;
+  int totalNonZero = 0;
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = regionSparse2[i];
+    if (iDensish<numberDensish&&densish[iDensish]==column)
+      iDensish++;
+    else
+      updateColumnU ( column, column->getIndices(), sparse_.array() );
+    if (!doForrestTomlin_) {
+      // Do PFI after everything else
+      updateColumnPFI(column);
+    }
+    // permute back (through region)
+    int numberNonZero = column->getNumElements();
+    const int * COIN_RESTRICT index = column->getIndices();
+    double * COIN_RESTRICT array = column->denseVector();
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      region[iRow] = array[iRow];
+      array[iRow] = 0.0;
+      regionIndex[j] = iRow;
+    }
+    regionSparse->setNumElements(numberNonZero);
+    column->setNumElements(0);
+    permuteBack(regionSparse,column);
+    CoinChargeWork(column->getNumElements());
+    totalNonZero += column->getNumElements();
+  }
+  delete [] densish;
+  return totalNonZero;
+}
+// Adds multiplier times correction into (unpacked) solution
+static void
+coinAddCorrection ( CoinIndexedVector * solution,
+		    const CoinIndexedVector & correction, double multiplier)
+{
+  double * COIN_RESTRICT x = solution->denseVector();
+  int * COIN_RESTRICT index = solution->getIndices();
+  int number = solution->getNumElements();
+  const double * COIN_RESTRICT array = correction.denseVector();
+  const int * COIN_RESTRICT indexC = correction.getIndices();
+  int numberC = correction.getNumElements();
+  for (int j=0;j<numberC;j++) {
+    int i = indexC[j];
+    double value = multiplier*array[i];
+    if (!x[i]) {
+      if (!value)
+	continue;
+      index[number++]=i;
+    }
+    x[i] += value;
+    if (!x[i])
+      x[i] = COIN_INDEXED_REALLY_TINY_ELEMENT;
+  }
+  solution->setNumElements(number);
+}
+/* Updates one column (FTRAN) as updateColumn and then refines the
+   solution against the basis taken from matrix */
+int 
+CoinFactorization::updateColumnRefined ( CoinIndexedVector * regionSparse,
+					 CoinIndexedVector * regionSparse2,
+					 const CoinPackedMatrix & matrix,
+					 const int rowIsBasic[],
+					 const int columnIsBasic[],
+					 int maximumPasses,
+					 double tolerance) const
+{
+  // works on dense values - give back in mode it came in
+  bool wasPacked = regionSparse2->packedMode();
+  regionSparse2->makeUnpacked();
+  int numberRows = numberRows_;
+  const int * row = matrix.getIndices();
+  const CoinBigIndex * columnStart = matrix.getVectorStarts();
+  const int * columnLength = matrix.getVectorLengths(); 
+  const double * elementByColumn = matrix.getElements();
+  int numberColumns = matrix.getNumCols();
+  double * rhs = new double [3*numberRows];
+  double * residual = rhs + numberRows;
+  double * scale = residual + numberRows;
+  CoinMemcpyN(regionSparse2->denseVector(),numberRows,rhs);
+  updateColumn(regionSparse,regionSparse2);
+  CoinIndexedVector correction;
+  correction.reserve(maximumRowsExtra_);
+  int numberPasses = 0;
+  int returnCode = -1;
+  double largestError = COIN_DBL_MAX;
+  while (true) {
+    // residual b-Bx and |B||x|+|b| (in double from original matrix)
+    const double * x = regionSparse2->denseVector();
+    for (int iRow=0;iRow<numberRows;iRow++) {
+      residual[iRow] = rhs[iRow];
+      scale[iRow] = fabs(rhs[iRow]);
+      int iSequence = rowIsBasic[iRow];
+      if (iSequence>=0&&x[iSequence]) {
+	double value = slackValue_*x[iSequence];
+	residual[iRow] -= value;
+	scale[iRow] += fabs(value);
+      }
+    }
+    for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+      int iSequence = columnIsBasic[iColumn];
+      if (iSequence>=0&&x[iSequence]) {
+	double value = x[iSequence];
+	for (CoinBigIndex j=columnStart[iColumn];
+	     j<columnStart[iColumn]+columnLength[iColumn];j++) {
+	  int iRow = row[j];
+	  double product = elementByColumn[j]*value;
+	  residual[iRow] -= product;
+	  scale[iRow] += fabs(product);
+	}
+      }
+    }
+    double error = 0.0;
+    for (int iRow=0;iRow<numberRows;iRow++) {
+      if (scale[iRow])
+	error = CoinMax(error,fabs(residual[iRow])/scale[iRow]);
+    }
+    if (error<=tolerance) {
+      returnCode = numberPasses;
+      break;
+    }
+    if (error>=largestError) {
+      // last correction did not help - take it off
+      coinAddCorrection(regionSparse2,correction,-1.0);
+      break;
+    }
+    if (numberPasses==maximumPasses)
+      break;
+    largestError = error;
+    correction.clear();
+    for (int iRow=0;iRow<numberRows;iRow++) {
+      if (residual[iRow])
+	correction.insert(iRow,residual[iRow]);
+    }
+    updateColumn(regionSparse,&correction);
+    coinAddCorrection(regionSparse2,correction,1.0);
+    numberPasses++;
+  }
+  delete [] rhs;
+  if (wasPacked)
+    regionSparse2->makePacked();
+  return returnCode;
+}
 // Permutes back at end of updateColumn
 void 
 CoinFactorization::permuteBack ( CoinIndexedVector * regionSparse, 
@@ -186,94 +407,80 @@ CoinFactorization::permuteBack ( CoinIndexedVector * regionSparse,
   int * COIN_RESTRICT outIndex = outVector->getIndices (  );
   double * COIN_RESTRICT out = outVector->denseVector();
   const int * COIN_RESTRICT permuteBack = pivotColumnBack();
-  int number=0;
-  if (outVector->packedMode()) {
-    for (int j = 0; j < oldNumber; j ++ ) {
-      int iRow = regionIndex[j];
-      double value = region[iRow];
-      region[iRow]=0.0;
-      if (fabs(value)>zeroTolerance_) {
-	iRow = permuteBack[iRow];
-	outIndex[number]=iRow;
-	out[number++] = value;
-      }
-    }
-  } else {
-    int j=0;
-    if ((oldNumber&1)!=0) {
-      int iRow = regionIndex[0];
-      j++;
-      double value = region[iRow];
-      region[iRow]=0.0;
-      if (fabs(value)>zeroTolerance_) {
-	iRow = permuteBack[iRow];
-	outIndex[number++]=iRow;
-	out[iRow] = value;
-      }
-    }
-    for (; j < oldNumber; j +=2 ) {
-      int iRow0 = regionIndex[j];
-      int iRow1 = regionIndex[j+1];
-      double value0 = region[iRow0];
-      bool good0 = fabs(value0)>zeroTolerance_;
-      double value1 = region[iRow1];
-      bool good1 = fabs(value1)>zeroTolerance_;
-      region[iRow0]=0.0;
-      region[iRow1]=0.0;
-      if (good0) {
-	iRow0 = permuteBack[iRow0];
-	outIndex[number++]=iRow0;
-	out[iRow0] = value0;
-      }
-      if (good1) {
-	iRow1 = permuteBack[iRow1];
-	outIndex[number++]=iRow1;
-	out[iRow1] = value1;
-      }
-    }
-  }
+  // drops values not above zeroTolerance_
+  int number = CoinPermuteGather(permuteBack,regionIndex,oldNumber,region,
+				 out,outVector->packedMode(),outIndex,
+				 zeroTolerance_,1);
   outVector->setNumElements(number);
   regionSparse->setNumElements(0);
 }
 //  updateColumnL.  Updates part of column (FTRANL)
 void
 CoinFactorization::updateColumnL ( CoinIndexedVector * regionSparse,
-					   int * COIN_RESTRICT regionIndex) const
+				   int * COIN_RESTRICT regionIndex,
+				   int * COIN_RESTRICT sparseWork,
+				   bool lowPrecision) const
 {
   if (numberL_) {
-    int number = regionSparse->getNumElements (  );
-    int goSparse;
-    // Guess at number at end
-    if (sparseThreshold_>0) {
-      if (ftranAverageAfterL_) {
-	int newNumber = static_cast<int> (number*ftranAverageAfterL_);
-	if (newNumber< sparseThreshold_&&(numberL_<<2)>newNumber)
-	  goSparse = 2;
-	else if (newNumber< sparseThreshold2_&&(numberL_<<1)>newNumber)
-	  goSparse = 1;
-	else
-	  goSparse = 0;
-      } else {
-	if (number<sparseThreshold_&&(numberL_<<2)>number) 
-	  goSparse = 2;
-	else
-	  goSparse = 0;
-      }
-    } else {
-      goSparse=0;
-    }
+    int goSparse = updateColumnLMethod(regionSparse->getNumElements (  ));
     switch (goSparse) {
+    case 3: // choose from history and reach
+      COIN_COUNT("factorization.ftran_l.adaptive");
+      updateColumnLAdaptive(regionSparse,regionIndex,sparseWork,
+			    lowPrecision);
+      break;
     case 0: // densish
-      updateColumnLDensish(regionSparse,regionIndex);
+      COIN_COUNT("factorization.ftran_l.densish");
+      if (lowPrecision&&elementLFloat_.array())
+	updateColumnLDensish(regionSparse,regionIndex,elementLFloat_.array());
+      else
+	updateColumnLDensish(regionSparse,regionIndex,elementL_.array());
       break;
     case 1: // middling
-      updateColumnLSparsish(regionSparse,regionIndex);
+      COIN_COUNT("factorization.ftran_l.sparsish");
+      updateColumnLSparsish(regionSparse,regionIndex,sparseWork);
       break;
     case 2: // sparse
-      updateColumnLSparse(regionSparse,regionIndex);
+      COIN_COUNT("factorization.ftran_l.sparse");
+      updateColumnLSparse(regionSparse,regionIndex,sparseWork);
       break;
     }
   }
+  updateColumnLDense(regionSparse,regionIndex);
+}
+// Which FTRAN L kernel - 0 densish, 1 sparsish, 2 sparse, 3 adaptive
+int
+CoinFactorization::updateColumnLMethod ( int number ) const
+{
+  int goSparse;
+  // Guess at number at end
+  if (sparseThreshold_>0) {
+    if (ftranAverageAfterL_) {
+      int newNumber = static_cast<int> (number*ftranAverageAfterL_);
+      if (newNumber< sparseThreshold_&&(numberL_<<2)>newNumber)
+	goSparse = 2;
+      else if (newNumber< sparseThreshold2_&&(numberL_<<1)>newNumber)
+	goSparse = 1;
+      else
+	goSparse = 0;
+    } else {
+      if (number<sparseThreshold_&&(numberL_<<2)>number) 
+	goSparse = 2;
+      else
+	goSparse = 0;
+    }
+  } else {
+    goSparse=0;
+  }
+  if (adaptiveSparse_&&sparseThreshold_>0)
+    goSparse = 3;
+  return goSparse;
+}
+// Updates dense part of L (FTRANL) after sparse part
+void
+CoinFactorization::updateColumnLDense ( CoinIndexedVector * regionSparse,
+					int * COIN_RESTRICT regionIndex) const
+{
 #ifdef COIN_FACTORIZATION_DENSE_CODE
   if (numberDense_) {
     //take off list
@@ -321,10 +528,68 @@ CoinFactorization::updateColumnL ( CoinIndexedVector * regionSparse,
   }
 #endif
 }
-// Updates part of column (FTRANL) when densish
-void 
+/* Subtracts up to four columns which share the same row pattern
+   (thisIndex) - element[k] is start of k'th column */
+template <class T> static inline void
+coinBlockUpdate ( double * COIN_RESTRICT region,
+		  const int * COIN_RESTRICT thisIndex, int numberIn,
+		  const T * const * element,
+		  const CoinFactorizationDouble * pivotValue, int numberInBlock)
+{
+  const T * COIN_RESTRICT element0 = element[0];
+  CoinFactorizationDouble pivotValue0 = pivotValue[0];
+  switch (numberInBlock) {
+  case 4:
+    {
+      const T * COIN_RESTRICT element1 = element[1];
+      const T * COIN_RESTRICT element2 = element[2];
+      const T * COIN_RESTRICT element3 = element[3];
+      CoinFactorizationDouble pivotValue1 = pivotValue[1];
+      CoinFactorizationDouble pivotValue2 = pivotValue[2];
+      CoinFactorizationDouble pivotValue3 = pivotValue[3];
+      for (int j = 0; j < numberIn; j ++ ) {
+	int iRow = thisIndex[j];
+	region[iRow] -= element0[j] * pivotValue0 + element1[j] * pivotValue1
+	  + element2[j] * pivotValue2 + element3[j] * pivotValue3;
+      }
+    }
+    break;
+  case 3:
+    {
+      const T * COIN_RESTRICT element1 = element[1];
+      const T * COIN_RESTRICT element2 = element[2];
+      CoinFactorizationDouble pivotValue1 = pivotValue[1];
+      CoinFactorizationDouble pivotValue2 = pivotValue[2];
+      for (int j = 0; j < numberIn; j ++ ) {
+	int iRow = thisIndex[j];
+	region[iRow] -= element0[j] * pivotValue0 + element1[j] * pivotValue1
+	  + element2[j] * pivotValue2;
+      }
+    }
+    break;
+  case 2:
+    {
+      const T * COIN_RESTRICT element1 = element[1];
+      CoinFactorizationDouble pivotValue1 = pivotValue[1];
+      for (int j = 0; j < numberIn; j ++ ) {
+	int iRow = thisIndex[j];
+	region[iRow] -= element0[j] * pivotValue0 + element1[j] * pivotValue1;
+      }
+    }
+    break;
+  case 1:
+    for (int j = 0; j < numberIn; j ++ ) {
+      int iRow = thisIndex[j];
+      region[iRow] -= element0[j] * pivotValue0;
+    }
+    break;
+  }
+}
+// Updates part of column (FTRANL) when densish (element is L or copy)
+template <class T> void 
 CoinFactorization::updateColumnLDensish ( CoinIndexedVector * regionSparse ,
-					  int * COIN_RESTRICT regionIndex)
+					  int * COIN_RESTRICT regionIndex,
+					  const T * COIN_RESTRICT element)
   const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
@@ -336,7 +601,6 @@ CoinFactorization::updateColumnLDensish ( CoinIndexedVector * regionSparse ,
   
   const CoinBigIndex * COIN_RESTRICT startColumn = startColumnL_.array();
   const int * COIN_RESTRICT indexRow = indexRowL_.array();
-  const CoinFactorizationDouble * COIN_RESTRICT element = elementL_.array();
   int last = numberRows_;
   assert ( last == baseL_ + numberL_);
 #if COIN_FACTORIZATION_DENSE_CODE
@@ -352,8 +616,39 @@ CoinFactorization::updateColumnLDensish ( CoinIndexedVector * regionSparse ,
     else
       regionIndex[numberNonZero++]=iPivot;
   }
+  const int * COIN_RESTRICT supernode = supernodeL_.array();
   // now others
   for (int i = smallestIndex; i < last; i++ ) {
+    if (supernode&&supernode[i]>1) {
+      // block of columns with same pattern
+      int iLast = i + supernode[i];
+      CoinBigIndex start = startColumn[i];
+      int numberIn = startColumn[i + 1] - start;
+      const int * thisIndex = indexRow + start;
+      const T * blockElement[4];
+      CoinFactorizationDouble blockPivot[4];
+      int numberInBlock = 0;
+      for ( ; i < iLast; i++ ) {
+	CoinFactorizationDouble pivotValue = region[i];
+	if ( fabs(pivotValue) > tolerance ) {
+	  blockElement[numberInBlock] = element + startColumn[i];
+	  blockPivot[numberInBlock++] = pivotValue;
+	  regionIndex[numberNonZero++] = i;
+	  if (numberInBlock==4) {
+	    coinBlockUpdate(region,thisIndex,numberIn,
+			    blockElement,blockPivot,4);
+	    numberInBlock=0;
+	  }
+	} else {
+	  region[i] = 0.0;
+	}
+      }
+      if (numberInBlock)
+	coinBlockUpdate(region,thisIndex,numberIn,
+			blockElement,blockPivot,numberInBlock);
+      i--;
+      continue;
+    }
     CoinFactorizationDouble pivotValue = region[i];
     
     if ( fabs(pivotValue) > tolerance ) {
@@ -382,10 +677,82 @@ CoinFactorization::updateColumnLDensish ( CoinIndexedVector * regionSparse ,
   }     
   regionSparse->setNumElements ( numberNonZero );
 } 
+/* Updates part of several columns (FTRANL) when densish - each column
+   of L is used for all regions while in cache */
+void
+CoinFactorization::updateColumnsLDensish ( int numberColumns,
+					   CoinIndexedVector ** regions) const
+{
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex * COIN_RESTRICT startColumn = startColumnL_.array();
+  const int * COIN_RESTRICT indexRow = indexRowL_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT element = elementL_.array();
+  int last = numberRows_;
+#if COIN_FACTORIZATION_DENSE_CODE
+  last -= numberDense_;
+#endif
+  double ** region = new double * [numberColumns];
+  int ** regionIndex = new int * [numberColumns];
+  int * numberNonZero = new int [numberColumns];
+  int smallestIndex = numberRowsExtra_;
+  // do easy ones
+  for (int k=0;k<numberColumns;k++) {
+    region[k] = regions[k]->denseVector();
+    int * COIN_RESTRICT thisIndex = regions[k]->getIndices();
+    regionIndex[k] = thisIndex;
+    int number = regions[k]->getNumElements();
+    int n = 0;
+    for (int j=0;j<number;j++) {
+      int iPivot=thisIndex[j];
+      if (iPivot>=baseL_) 
+	smallestIndex = CoinMin(iPivot,smallestIndex);
+      else
+	thisIndex[n++]=iPivot;
+    }
+    numberNonZero[k] = n;
+  }
+  // now others
+  for (int i = smallestIndex; i < last; i++ ) {
+    CoinBigIndex start = startColumn[i];
+    CoinBigIndex end = startColumn[i + 1];
+    for (int k=0;k<numberColumns;k++) {
+      double * COIN_RESTRICT thisRegion = region[k];
+      CoinFactorizationDouble pivotValue = thisRegion[i];
+      if ( fabs(pivotValue) > tolerance ) {
+	for (CoinBigIndex j = start; j < end; j ++ ) {
+	  int iRow = indexRow[j];
+	  CoinFactorizationDouble result = thisRegion[iRow];
+	  CoinFactorizationDouble value = element[j];
+	  thisRegion[iRow] = result - value * pivotValue;
+	}
+	regionIndex[k][numberNonZero[k]++] = i;
+      } else {
+	thisRegion[i] = 0.0;
+      }
+    }
+  }
+  for (int k=0;k<numberColumns;k++) {
+    double * COIN_RESTRICT thisRegion = region[k];
+    // and dense
+    for (int i=last ; i < numberRows_; i++ ) {
+      CoinFactorizationDouble pivotValue = thisRegion[i];
+      if ( fabs(pivotValue) > tolerance ) {
+	regionIndex[k][numberNonZero[k]++] = i;
+      } else {
+	thisRegion[i] = 0.0;
+      }       
+    }     
+    regions[k]->setNumElements ( numberNonZero[k] );
+  }
+  delete [] region;
+  delete [] regionIndex;
+  delete [] numberNonZero;
+}
 // Updates part of column (FTRANL) when sparsish
 void 
 CoinFactorization::updateColumnLSparsish ( CoinIndexedVector * regionSparse,
-					   int * COIN_RESTRICT regionIndex)
+					   int * COIN_RESTRICT regionIndex,
+					   int * COIN_RESTRICT sparseWork)
   const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
@@ -406,7 +773,7 @@ CoinFactorization::updateColumnLSparsish ( CoinIndexedVector * regionSparse,
 #endif
   // mark known to be zero
   int nInBig = sizeof(CoinBigIndex)/sizeof(int);
-  CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (sparse_.array()+(2+nInBig)*maximumRowsExtra_);
+  CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (sparseWork+(2+nInBig)*maximumRowsExtra_);
   int smallestIndex = numberRowsExtra_;
   // do easy ones
   for (int k=0;k<number;k++) {
@@ -528,7 +895,8 @@ CoinFactorization::updateColumnLSparsish ( CoinIndexedVector * regionSparse,
 // Updates part of column (FTRANL) when sparse
 void 
 CoinFactorization::updateColumnLSparse ( CoinIndexedVector * regionSparse ,
-					   int * COIN_RESTRICT regionIndex)
+					   int * COIN_RESTRICT regionIndex,
+					   int * COIN_RESTRICT sparseWork)
   const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
@@ -543,7 +911,7 @@ CoinFactorization::updateColumnLSparse ( CoinIndexedVector * regionSparse ,
   const CoinFactorizationDouble *element = elementL_.array();
   // use sparse_ as temporary area
   // mark known to be zero
-  int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+  int * COIN_RESTRICT stack = sparseWork;  /* pivot */
   int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
   CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
   char * COIN_RESTRICT mark = reinterpret_cast<char *> (next + maximumRowsExtra_);
@@ -617,6 +985,153 @@ CoinFactorization::updateColumnLSparse ( CoinIndexedVector * regionSparse ,
   }
   regionSparse->setNumElements ( numberNonZero );
 }
+/* Reach in L of indexIn (those >= baseL_) by depth first search.
+   Returns number in reach (list in sparseWork, last first in
+   topological order) or -1 if more than maximum */
+int
+CoinFactorization::reachL ( const int * COIN_RESTRICT indexIn, int number,
+			    int * COIN_RESTRICT sparseWork, int maximum) const
+{
+  const CoinBigIndex *startColumn = startColumnL_.array();
+  const int *indexRow = indexRowL_.array();
+  // same layout as updateColumnLSparse
+  int * COIN_RESTRICT stack = sparseWork;  /* pivot */
+  int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
+  CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
+  char * COIN_RESTRICT mark = reinterpret_cast<char *> (next + maximumRowsExtra_);
+  int nList=0;
+  for (int k=0;k<number;k++) {
+    int kPivot=indexIn[k];
+    if (kPivot>=baseL_&&!mark[kPivot]) {
+      stack[0]=kPivot;
+      CoinBigIndex j=startColumn[kPivot+1]-1;
+      int nStack=0;
+      while (nStack>=0) {
+	if (j>=startColumn[kPivot]) {
+	  int jPivot=indexRow[j--];
+	  next[nStack] =j;
+	  if (!mark[jPivot]) {
+	    kPivot=jPivot;
+	    j = startColumn[kPivot+1]-1;
+	    stack[++nStack]=kPivot;
+	    mark[kPivot]=1;
+	    next[nStack]=j;
+	  }
+	} else {
+	  list[nList++]=kPivot;
+	  mark[kPivot]=1;
+	  --nStack;
+	  if (nStack>=0) {
+	    kPivot=stack[nStack];
+	    j=next[nStack];
+	  }
+	}
+	if (nList+nStack>=maximum) {
+	  // too big - clean up marks and give up
+	  for (int i=0;i<nList;i++)
+	    mark[list[i]]=0;
+	  for (int i=0;i<=nStack;i++)
+	    mark[stack[i]]=0;
+	  return -1;
+	}
+      }
+    }
+  }
+  return nList;
+}
+// Updates part of column (FTRANL) choosing kernel from history and reach
+void 
+CoinFactorization::updateColumnLAdaptive ( CoinIndexedVector * regionSparse,
+					   int * COIN_RESTRICT regionIndex,
+					   int * COIN_RESTRICT sparseWork,
+					   bool lowPrecision)
+  const
+{
+  int number = regionSparse->getNumElements (  );
+  // only solves using sparse_ keep history (others may be in threads)
+  bool keepHistory = (sparseWork==sparse_.array());
+  double ratio = adaptiveRatioL_ ? adaptiveRatioL_ :
+    CoinMax(ftranAverageAfterL_,1.0);
+  double predicted = number*ratio;
+  int goSparse;
+  if (number<sparseThreshold_&&
+      (predicted<sparseThreshold_||number<=(sparseThreshold_>>4))) {
+    // try for reach
+    const int * COIN_RESTRICT list = NULL;
+    int nList = -1;
+    if (keepHistory&&reachInputL_==number&&
+	!memcmp(reachL_.array(),regionIndex,number*sizeof(int))) {
+      // same pattern as last time
+      list = reachL_.array()+number;
+      nList = reachNumberL_;
+    } else {
+      nList = reachL(regionIndex,number,sparseWork,sparseThreshold_);
+      if (nList>=0) {
+	list = sparseWork+maximumRowsExtra_;
+	if (keepHistory) {
+	  int * COIN_RESTRICT save = reachL_.conditionalNew(number+nList);
+	  CoinMemcpyN(regionIndex,number,save);
+	  CoinMemcpyN(list,nList,save+number);
+	  reachInputL_=number;
+	  reachNumberL_=nList;
+	}
+      }
+    }
+    if (nList>=0) {
+      double * COIN_RESTRICT region = regionSparse->denseVector (  );
+      double tolerance = zeroTolerance_;
+      const CoinBigIndex *startColumn = startColumnL_.array();
+      const int *indexRow = indexRowL_.array();
+      const CoinFactorizationDouble *element = elementL_.array();
+      char * COIN_RESTRICT mark = reinterpret_cast<char *>
+	(reinterpret_cast<CoinBigIndex *>(sparseWork+2*maximumRowsExtra_)
+	 + maximumRowsExtra_);
+      int numberNonZero=0;
+      for (int k=0;k<number;k++) {
+	int kPivot=regionIndex[k];
+	if (kPivot<baseL_) 
+	  regionIndex[numberNonZero++]=kPivot;
+      }
+      for (int i=nList-1;i>=0;i--) {
+	int iPivot = list[i];
+	mark[iPivot]=0;
+	CoinFactorizationDouble pivotValue = region[iPivot];
+	if ( fabs ( pivotValue ) > tolerance ) {
+	  regionIndex[numberNonZero++]=iPivot;
+	  for (CoinBigIndex j = startColumn[iPivot]; 
+	       j < startColumn[iPivot+1]; j ++ ) {
+	    int iRow = indexRow[j];
+	    CoinFactorizationDouble value = element[j];
+	    region[iRow] -= value * pivotValue;
+	  }
+	} else {
+	  region[iPivot]=0.0;
+	}
+      }
+      regionSparse->setNumElements ( numberNonZero );
+      goSparse = 2;
+    } else {
+      // at least sparseThreshold_ in reach
+      predicted = CoinMax(predicted,static_cast<double>(sparseThreshold_));
+      goSparse = -1;
+    }
+  } else {
+    goSparse = -1;
+  }
+  if (goSparse<0) {
+    if (predicted<sparseThreshold2_&&(numberL_<<1)>predicted) 
+      updateColumnLSparsish(regionSparse,regionIndex,sparseWork);
+    else if (lowPrecision&&elementLFloat_.array())
+      updateColumnLDensish(regionSparse,regionIndex,elementLFloat_.array());
+    else
+      updateColumnLDensish(regionSparse,regionIndex,elementL_.array());
+  }
+  if (keepHistory&&number) {
+    double thisRatio = static_cast<double>(regionSparse->getNumElements())/
+      static_cast<double>(number);
+    adaptiveRatioL_ = 0.9*ratio + 0.1*CoinMax(thisRatio,1.0);
+  }
+}
 /* Updates one column (FTRAN) from region2
    Tries to do FT update
    number returned is negative if no room.
@@ -628,6 +1143,7 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
 					CoinIndexedVector * regionSparse3,
 					bool noPermuteRegion3)
 {
+  COIN_TIME_SCOPE("factorization.ftran_two");
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX=CoinCpuTime();
 #endif
@@ -641,6 +1157,8 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
   CoinIndexedVector save2(*regionSparse2);
   CoinIndexedVector save3(*regionSparse3);
 #endif
+  CoinChargeWork(regionSparse2->getNumElements()+
+		 regionSparse3->getNumElements());
   CoinIndexedVector * regionFT ;
   CoinIndexedVector * regionUpdate ;
   int * COIN_RESTRICT regionIndex ;
@@ -648,6 +1166,7 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
   const int *permute = permute_.array();
   int * COIN_RESTRICT index ;
   double * COIN_RESTRICT region ;
+  bool region3WasPacked = regionSparse3->packedMode();
   if (!noPermuteRegion3) {
     regionFT = regionSparse3;
     regionUpdate = regionSparse1;
@@ -659,19 +1178,16 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
     numberNonZero = regionSparse3->getNumElements();
     int * COIN_RESTRICT index = regionSparse3->getIndices();
     double * COIN_RESTRICT array = regionSparse3->denseVector();
-    assert (!regionSparse3->packedMode());
-    for (int j = 0; j < numberNonZero; j ++ ) {
-      int iRow = index[j];
-      double value = array[iRow];
-      array[iRow]=0.0;
-      iRow = permute[iRow];
-      region[iRow] = value;
-      regionIndex[j] = iRow;
-    }
+    CoinPermuteScatter(permute,index,numberNonZero,array,
+		       regionSparse3->packedMode(),region,regionIndex);
     regionUpdate->setNumElements ( numberNonZero );
+    // now empty and used as dense work region
+    regionSparse3->setPackedMode(false);
   } else {
     regionFT = regionSparse1;
     regionUpdate = regionSparse3;
+    // updated in place so must be unpacked (packed again at end)
+    regionSparse3->makeUnpacked();
   }
   //permute and move indices into index array (in U)
   regionIndex = regionFT->getIndices (  );
@@ -684,32 +1200,9 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
   startColumnU[numberColumnsExtra_] = start;
   regionIndex = indexRowU_.array() + start;
 
-#ifndef ABC_USE_COIN_FACTORIZATION
-  assert(regionSparse2->packedMode());
-#else
-  if(regionSparse2->packedMode()) {
-#endif
-  for (int j = 0; j < numberNonZero; j ++ ) {
-    int iRow = index[j];
-    double value = array[j];
-    array[j]=0.0;
-    iRow = permute[iRow];
-    region[iRow] = value;
-    regionIndex[j] = iRow;
-  }
-#ifdef ABC_USE_COIN_FACTORIZATION
-  } else {
-    // not packed
-  for (int j = 0; j < numberNonZero; j ++ ) {
-    int iRow = index[j];
-    double value = array[iRow];
-    array[iRow]=0.0;
-    iRow = permute[iRow];
-    region[iRow] = value;
-    regionIndex[j] = iRow;
-  }
-  }
-#endif
+  // if not packed - answer will come back unpacked
+  CoinPermuteScatter(permute,index,numberNonZero,array,
+		     regionSparse2->packedMode(),region,regionIndex);
   regionFT->setNumElements ( numberNonZero );
   if (collectStatistics_) {
     numberFtranCounts_+=2;
@@ -718,15 +1211,15 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
   }
     
   //  ******* L
-  updateColumnL ( regionFT, regionIndex );
-  updateColumnL ( regionUpdate, regionUpdate->getIndices() );
+  updateColumnL ( regionFT, regionIndex, sparse_.array() );
+  updateColumnL ( regionUpdate, regionUpdate->getIndices(), sparse_.array() );
   if (collectStatistics_) 
     ftranCountAfterL_ += regionFT->getNumElements()+
       regionUpdate->getNumElements();
   //permute extra
   //row bits here
   updateColumnRFT ( regionFT, regionIndex );
-  updateColumnR ( regionUpdate );
+  updateColumnR ( regionUpdate, sparse_.array() );
   if (collectStatistics_) 
     ftranCountAfterR_ += regionFT->getNumElements()+
     regionUpdate->getNumElements();
@@ -778,13 +1271,18 @@ CoinFactorization::updateTwoColumnsFT ( CoinIndexedVector * regionSparse1,
     }
   } else {
     // sparse 
-    updateColumnU ( regionFT, regionIndex);
-    updateColumnU ( regionUpdate, regionUpdate->getIndices());
+    updateColumnU ( regionFT, regionIndex, sparse_.array());
+    updateColumnU ( regionUpdate, regionUpdate->getIndices(), sparse_.array());
   }
   permuteBack(regionFT,regionSparse2);
   if (!noPermuteRegion3) {
+    regionSparse3->setPackedMode(region3WasPacked);
     permuteBack(regionUpdate,regionSparse3);
+  } else if (region3WasPacked) {
+    regionSparse3->makePacked();
   }
+  CoinChargeWork(regionSparse2->getNumElements()+
+		 regionUpdate->getNumElements());
 #ifdef COIN_DEBUG
   int n2=regionSparse2->getNumElements();
   regionSparse1->checkClean();
@@ -960,6 +1458,90 @@ CoinFactorization::updateTwoColumnsUDensish (
   numberNonZero1=numberNonZeroA;
   numberNonZero2=numberNonZeroB;
 }
+/* Updates part of several columns (FTRANU) when densish - each column
+   of U is used for all regions with a nonzero pivot while in cache */
+void
+CoinFactorization::updateColumnsUDensish ( int numberColumns,
+					   CoinIndexedVector ** regions ) const
+{
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex * COIN_RESTRICT startColumn = startColumnU_.array();
+  const int * COIN_RESTRICT indexRow = indexRowU_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT element = elementU_.array();
+  const int * COIN_RESTRICT numberInColumn = numberInColumn_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT pivotRegion =
+    pivotRegion_.array();
+  double ** region = new double * [numberColumns];
+  int ** regionIndex = new int * [numberColumns];
+  int * numberNonZero = new int [numberColumns];
+  // regions with nonzero pivot and pivot values
+  double ** active = new double * [numberColumns];
+  int * whichActive = new int [numberColumns];
+  CoinFactorizationDouble * pivotValue =
+    new CoinFactorizationDouble [numberColumns];
+  for (int k=0;k<numberColumns;k++) {
+    region[k] = regions[k]->denseVector();
+    regionIndex[k] = regions[k]->getIndices();
+    numberNonZero[k] = 0;
+  }
+  for (int i = numberU_-1 ; i >= numberSlacks_; i-- ) {
+    int numberActive = 0;
+    for (int k=0;k<numberColumns;k++) {
+      CoinFactorizationDouble value = region[k][i];
+      if (value) {
+	region[k][i] = 0.0;
+	if ( fabs ( value ) > tolerance ) {
+	  active[numberActive] = region[k];
+	  whichActive[numberActive] = k;
+	  pivotValue[numberActive++] = value;
+	}
+      }
+    }
+    if (!numberActive)
+      continue;
+    CoinBigIndex start = startColumn[i];
+    const CoinFactorizationDouble * COIN_RESTRICT thisElement = element+start;
+    const int * COIN_RESTRICT thisIndex = indexRow+start;
+    for (CoinBigIndex j=numberInColumn[i]-1 ; j >=0; j-- ) {
+      int iRow = thisIndex[j];
+      CoinFactorizationDouble value = thisElement[j];
+      for (int a=0;a<numberActive;a++)
+	active[a][iRow] -= value * pivotValue[a];
+    }
+    for (int a=0;a<numberActive;a++) {
+      int k = whichActive[a];
+      active[a][i] = pivotValue[a] * pivotRegion[i];
+      regionIndex[k][numberNonZero[k]++] = i;
+    }
+  }
+  // now do slacks
+  for (int k=0;k<numberColumns;k++) {
+    double * COIN_RESTRICT thisRegion = region[k];
+    int * COIN_RESTRICT thisIndex = regionIndex[k];
+    int n = numberNonZero[k];
+    for (int i = numberSlacks_-1; i>=0;i--) {
+      double value = thisRegion[i];
+      if ( value ) {
+	if ( fabs(value) > tolerance ) {
+#ifndef COIN_FAST_CODE
+	  if (slackValue_==-1.0)
+#endif
+	    thisRegion[i]=-value;
+	  thisIndex[n++]=i;
+	} else {
+	  thisRegion[i]=0.0;
+	}
+      }
+    }
+    regions[k]->setNumElements(n);
+  }
+  delete [] region;
+  delete [] regionIndex;
+  delete [] numberNonZero;
+  delete [] active;
+  delete [] whichActive;
+  delete [] pivotValue;
+}
 #ifdef COIN_FACTORIZATION_DIAGNOSE
 static int numberTimesX=0;
 static int numberSparseX=0;
@@ -972,7 +1554,9 @@ double sumNumberDensishX=0.0;
 //  updateColumnU.  Updates part of column (FTRANU)
 void
 CoinFactorization::updateColumnU ( CoinIndexedVector * regionSparse,
-				   int * indexIn) const
+				   int * indexIn,
+				   int * COIN_RESTRICT sparseWork,
+				   bool lowPrecision) const
 {
   int numberNonZero = regionSparse->getNumElements (  );
 
@@ -1023,18 +1607,25 @@ CoinFactorization::updateColumnU ( CoinIndexedVector * regionSparse,
     {
       double *region = regionSparse->denseVector (  );
       int * regionIndex = regionSparse->getIndices();
-      int numberNonZero=updateColumnUDensish(region,regionIndex);
+      int numberNonZero;
+      // float copy only valid until U is modified
+      if (lowPrecision&&!numberPivots_&&elementUFloat_.array())
+	numberNonZero=updateColumnUDensish(region,regionIndex,
+					   elementUFloat_.array());
+      else
+	numberNonZero=updateColumnUDensish(region,regionIndex,
+					   elementU_.array());
       regionSparse->setNumElements ( numberNonZero );
     }
     break;
   case 1: // middling
-    updateColumnUSparsish(regionSparse,indexIn);
+    updateColumnUSparsish(regionSparse,indexIn,sparseWork);
     break;
   case 2: // sparse
-    updateColumnUSparse(regionSparse,indexIn);
+    updateColumnUSparse(regionSparse,indexIn,sparseWork);
     break;
   }
-  if (collectStatistics_) {
+  if (collectStatistics_&&sparseWork==sparse_.array()) {
     ftranCountAfterU_ += regionSparse->getNumElements (  );
 #ifdef CLP_FACTORIZATION_INSTRUMENT
     int numberNonZero=regionSparse->getNumElements();
@@ -1054,15 +1645,15 @@ double nU_DZ=0.0;
 double nnz_DZ=0.0;
 double nDone_DZ=0.0;
 #endif
-// Updates part of column (FTRANU) real work
-int 
+// Updates part of column (FTRANU) real work (element is U or copy)
+template <class T> int 
 CoinFactorization::updateColumnUDensish ( double * COIN_RESTRICT region, 
-					  int * COIN_RESTRICT regionIndex) const
+					  int * COIN_RESTRICT regionIndex,
+					  const T * element) const
 {
   double tolerance = zeroTolerance_;
   const CoinBigIndex *startColumn = startColumnU_.array();
   const int *indexRow = indexRowU_.array();
-  const CoinFactorizationDouble *element = elementU_.array();
   int numberNonZero = 0;
   const int *numberInColumn = numberInColumn_.array();
   const CoinFactorizationDouble *pivotRegion = pivotRegion_.array();
@@ -1073,7 +1664,42 @@ CoinFactorization::updateColumnUDensish ( double * COIN_RESTRICT region,
   nU_DZ += numberU_;
 #endif
   
+  // blocks only valid until U is modified
+  const int * COIN_RESTRICT supernode = 
+    numberPivots_ ? NULL : supernodeU_.array();
   for (int i = numberU_-1 ; i >= numberSlacks_; i-- ) {
+    if (supernode&&supernode[i]>1) {
+      // block of columns with same pattern
+      int iLast = i - supernode[i];
+      CoinBigIndex start = startColumn[i];
+      int numberIn = numberInColumn[i];
+      const int * thisIndex = indexRow + start;
+      const T * blockElement[4];
+      CoinFactorizationDouble blockPivot[4];
+      int numberInBlock = 0;
+      for ( ; i > iLast; i-- ) {
+	CoinFactorizationDouble pivotValue = region[i];
+	if (pivotValue) {
+	  region[i] = 0.0;
+	  if ( fabs ( pivotValue ) > tolerance ) {
+	    blockElement[numberInBlock] = element + startColumn[i];
+	    blockPivot[numberInBlock++] = pivotValue;
+	    region[i] = pivotValue * pivotRegion[i];
+	    regionIndex[numberNonZero++] = i;
+	    if (numberInBlock==4) {
+	      coinBlockUpdate(region,thisIndex,numberIn,
+			      blockElement,blockPivot,4);
+	      numberInBlock=0;
+	    }
+	  }
+	}
+      }
+      if (numberInBlock)
+	coinBlockUpdate(region,thisIndex,numberIn,
+			blockElement,blockPivot,numberInBlock);
+      i++;
+      continue;
+    }
     CoinFactorizationDouble pivotValue = region[i];
     if (pivotValue) {
 #ifdef COIN_DEVELOP
@@ -1082,7 +1708,7 @@ CoinFactorization::updateColumnUDensish ( double * COIN_RESTRICT region,
       region[i] = 0.0;
       if ( fabs ( pivotValue ) > tolerance ) {
 	CoinBigIndex start = startColumn[i];
-	const CoinFactorizationDouble * thisElement = element+start;
+	const T * thisElement = element+start;
 	const int * thisIndex = indexRow+start;
 #ifdef COIN_DEVELOP
 	nDone_DZ += numberInColumn[i];
@@ -1181,7 +1807,8 @@ CoinFactorization::updateColumnUDensish ( double * COIN_RESTRICT region,
 */
 void
 CoinFactorization::updateColumnUSparse ( CoinIndexedVector * regionSparse,
-					 int * COIN_RESTRICT indexIn) const
+					 int * COIN_RESTRICT indexIn,
+					 int * COIN_RESTRICT sparseWork) const
 {
   int numberNonZero = regionSparse->getNumElements (  );
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
@@ -1193,7 +1820,7 @@ CoinFactorization::updateColumnUSparse ( CoinIndexedVector * regionSparse,
   const CoinFactorizationDouble *pivotRegion = pivotRegion_.array();
   // use sparse_ as temporary area
   // mark known to be zero
-  int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+  int * COIN_RESTRICT stack = sparseWork;  /* pivot */
   int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
   CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
   char * COIN_RESTRICT mark = reinterpret_cast<char *> (next + maximumRowsExtra_);
@@ -1349,11 +1976,12 @@ double nDone_SZ=0.0;
 #endif
 void
 CoinFactorization::updateColumnUSparsish ( CoinIndexedVector * regionSparse,
-					   int * COIN_RESTRICT indexIn) const
+					   int * COIN_RESTRICT indexIn,
+					   int * COIN_RESTRICT sparseWork) const
 {
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
   // mark known to be zero
-  int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+  int * COIN_RESTRICT stack = sparseWork;  /* pivot */
   int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
   CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
   CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (next + maximumRowsExtra_);
@@ -1603,9 +2231,150 @@ CoinFactorization::updateColumnUSparsish ( CoinIndexedVector * regionSparse,
   }
 #endif
 }
+/* Does R etas in order as dot products (FTRANR) -
+   returns new number in regionIndex.  Blocks of etas (see makeBlockR)
+   gather their rows once */
+int
+CoinFactorization::updateColumnRByEta ( double * COIN_RESTRICT region,
+					int * COIN_RESTRICT regionIndex,
+					int numberNonZero ) const
+{
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
+  const int * indexRow = indexRowR_;
+  const CoinFactorizationDouble * element = elementR_;
+  const int * permute = permute_.array();
+  int iBlock = 0;
+  const int * block = blockR_.array();
+  const CoinBigIndex * startBlock = startBlockR_.array();
+  int firstInBlock = (numberBlocksR_) ? block[0] : numberRowsExtra_;
+  for (int i = numberRows_; i < numberRowsExtra_; i++ ) {
+    if ( i == firstInBlock ) {
+      int numberEtas = block[3*iBlock+1];
+      int numberIndices = block[3*iBlock+2];
+      const int * indexBlock = indexBlockR_.array() + startBlock[2*iBlock];
+      const CoinFactorizationDouble * elementBlock =
+	elementBlockR_.array() + startBlock[2*iBlock+1];
+      CoinFactorizationDouble pivotValue[32];
+      for (int k = 0; k < numberEtas; k++ ) {
+	int iRow = permute[i+k];
+	pivotValue[k] = region[iRow];
+	//zero out pre-permuted
+	region[iRow] = 0.0;
+      }
+      // one gather for each row
+      for (int k = 0; k < numberIndices; k++ ) {
+	CoinFactorizationDouble value = region[indexBlock[k]];
+	if ( value ) {
+	  for (int e = 0; e < numberEtas; e++ )
+	    pivotValue[e] -= elementBlock[e] * value;
+	}
+	elementBlock += numberEtas;
+      }
+      for (int k = 0; k < numberEtas; k++ ) {
+	if ( fabs ( pivotValue[k] ) > tolerance ) {
+	  region[i+k] = pivotValue[k];
+	  regionIndex[numberNonZero++] = i+k;
+	} else {
+	  region[i+k] = 0.0;
+	}
+      }
+      i += numberEtas-1;
+      iBlock++;
+      firstInBlock = (iBlock<numberBlocksR_) ? block[3*iBlock] : numberRowsExtra_;
+      continue;
+    }
+    //move using permute_ (stored in inverse fashion)
+    CoinBigIndex j = startColumn[i];
+    CoinBigIndex end = startColumn[i+1];
+    int iRow = permute[i];
+    CoinFactorizationDouble pivotValue = region[iRow];
+    //zero out pre-permuted
+    region[iRow] = 0.0;
+    // long etas - fetch scattered entries ahead
+    for ( ; j < end - COIN_R_PREFETCH; j ++ ) {
+      COIN_PREFETCH(region + indexRow[j+COIN_R_PREFETCH]);
+      CoinFactorizationDouble value = element[j];
+      int jRow = indexRow[j];
+      value *= region[jRow];
+      pivotValue -= value;
+    }
+    for ( ; j < end; j ++ ) {
+      CoinFactorizationDouble value = element[j];
+      int jRow = indexRow[j];
+      value *= region[jRow];
+      pivotValue -= value;
+    }
+    if ( fabs ( pivotValue ) > tolerance ) {
+      region[i] = pivotValue;
+      regionIndex[numberNonZero++] = i;
+    } else {
+      region[i] = 0.0;
+    }
+  }
+  return numberNonZero;
+}
+/* Updates part of several columns (FTRANR) as dot products -
+   each eta is used for all regions while in cache */
+void
+CoinFactorization::updateColumnsRByEta ( int numberColumns,
+					 CoinIndexedVector ** regions ) const
+{
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
+  const int * indexRow = indexRowR_;
+  const CoinFactorizationDouble * element = elementR_;
+  const int * permute = permute_.array();
+  double ** region = new double * [numberColumns];
+  CoinFactorizationDouble * pivotValue =
+    new CoinFactorizationDouble [numberColumns];
+  for (int k=0;k<numberColumns;k++)
+    region[k] = regions[k]->denseVector();
+  for (int i = numberRows_; i < numberRowsExtra_; i++ ) {
+    //move using permute_ (stored in inverse fashion)
+    int iRow = permute[i];
+    for (int k=0;k<numberColumns;k++) {
+      pivotValue[k] = region[k][iRow];
+      //zero out pre-permuted
+      region[k][iRow] = 0.0;
+    }
+    for (CoinBigIndex j = startColumn[i]; j < startColumn[i+1]; j ++ ) {
+      CoinFactorizationDouble value = element[j];
+      int jRow = indexRow[j];
+      for (int k=0;k<numberColumns;k++)
+	pivotValue[k] -= value * region[k][jRow];
+    }
+    for (int k=0;k<numberColumns;k++) {
+      if ( fabs ( pivotValue[k] ) > tolerance ) {
+	region[k][i] = pivotValue[k];
+	int * COIN_RESTRICT regionIndex = regions[k]->getIndices();
+	int numberNonZero = regions[k]->getNumElements();
+	regionIndex[numberNonZero] = i;
+	regions[k]->setNumElements(numberNonZero+1);
+      } else {
+	region[k][i] = 0.0;
+      }
+    }
+  }
+  // pack down (permuted ones were zeroed)
+  for (int k=0;k<numberColumns;k++) {
+    int * COIN_RESTRICT regionIndex = regions[k]->getIndices();
+    int n = regions[k]->getNumElements();
+    int numberNonZero=0;
+    for (int i=0;i<n;i++) {
+      int indexValue = regionIndex[i];
+      if (region[k][indexValue])
+	regionIndex[numberNonZero++]=indexValue;
+    }
+    regions[k]->setNumElements(numberNonZero);
+  }
+  delete [] region;
+  delete [] pivotValue;
+}
 //  updateColumnR.  Updates part of column (FTRANR)
 void
-CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse ) const
+CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse,
+				   int * COIN_RESTRICT sparseWork) const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
@@ -1615,9 +2384,6 @@ CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse ) const
     return;	//return if nothing to do
   double tolerance = zeroTolerance_;
 
-  const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
-  const int * indexRow = indexRowR_;
-  const CoinFactorizationDouble * element = elementR_;
   const int * permute = permute_.array();
 
   // Work out very dubious idea of what would be fastest
@@ -1647,7 +2413,7 @@ CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse ) const
   if (!numberInColumnPlus_.array()) {
     methodTime[0]=1.0e100;
     methodTime[1]=1.0e100;
-  } else if (!sparse_.array()) {
+  } else if (!sparseWork) {
     methodTime[0]=1.0e100;
   }
   double best=1.0e100;
@@ -1668,7 +2434,7 @@ CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse ) const
     {
       // use sparse_ as temporary area
       // mark known to be zero
-      int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+      int * COIN_RESTRICT stack = sparseWork;  /* pivot */
       int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
       CoinBigIndex * COIN_RESTRICT next = (CoinBigIndex *) (list + maximumRowsExtra_);  /* jnext */
       char * COIN_RESTRICT mark = (char *) (next + maximumRowsExtra_);
@@ -1767,7 +2533,7 @@ CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse ) const
       
       // use sparse_ as temporary area
       // mark known to be zero
-      int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+      int * COIN_RESTRICT stack = sparseWork;  /* pivot */
       int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
       CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
       char * COIN_RESTRICT mark = reinterpret_cast<char *> (next + maximumRowsExtra_);
@@ -1875,31 +2641,7 @@ CoinFactorization::updateColumnR ( CoinIndexedVector * regionSparse ) const
     }
     break;
   case 2:
-    {
-      CoinBigIndex start = startColumn[numberRows_];
-      for (int i = numberRows_; i < numberRowsExtra_; i++ ) {
-	//move using permute_ (stored in inverse fashion)
-	CoinBigIndex end = startColumn[i+1];
-	int iRow = permute[i];
-	CoinFactorizationDouble pivotValue = region[iRow];
-	//zero out pre-permuted
-	region[iRow] = 0.0;
-
-	for (CoinBigIndex j = start; j < end; j ++ ) {
-	  CoinFactorizationDouble value = element[j];
-	  int jRow = indexRow[j];
-	  value *= region[jRow];
-	  pivotValue -= value;
-	}
-	start=end;
-	if ( fabs ( pivotValue ) > tolerance ) {
-	  region[i] = pivotValue;
-	  regionIndex[numberNonZero++] = i;
-	} else {
-	region[i] = 0.0;
-	}
-      }
-    }
+    numberNonZero = updateColumnRByEta(region,regionIndex,numberNonZero);
     break;
   }
   if (method) {
@@ -1929,9 +2671,6 @@ CoinFactorization::updateColumnRFT ( CoinIndexedVector * regionSparse,
   if ( numberR_ ) {
     double tolerance = zeroTolerance_;
     
-    const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
-    const int * indexRow = indexRowR_;
-    const CoinFactorizationDouble * element = elementR_;
     const int * permute = permute_.array();
     
 
@@ -2107,31 +2846,7 @@ CoinFactorization::updateColumnRFT ( CoinIndexedVector * regionSparse,
       }
       break;
     case 2:
-      {
-	CoinBigIndex start = startColumn[numberRows_];
-	for (int i = numberRows_; i < numberRowsExtra_; i++ ) {
-	  //move using permute_ (stored in inverse fashion)
-	  CoinBigIndex end = startColumn[i+1];
-	  int iRow = permute[i];
-	  CoinFactorizationDouble pivotValue = region[iRow];
-	  //zero out pre-permuted
-	  region[iRow] = 0.0;
-	  
-	  for (CoinBigIndex j = start; j < end; j ++ ) {
-	    CoinFactorizationDouble value = element[j];
-	    int jRow = indexRow[j];
-	    value *= region[jRow];
-	    pivotValue -= value;
-	  }
-	  start=end;
-	  if ( fabs ( pivotValue ) > tolerance ) {
-	    region[i] = pivotValue;
-	    regionIndex[numberNonZero++] = i;
-	  } else {
-	    region[i] = 0.0;
-	  }
-	}
-      }
+      numberNonZero = updateColumnRByEta(region,regionIndex,numberNonZero);
       break;
     }
     if (method) {
@@ -2191,64 +2906,33 @@ CoinFactorization::updateColumnRFT ( CoinIndexedVector * regionSparse,
 int CoinFactorization::updateColumnFT ( CoinIndexedVector * regionSparse,
 					CoinIndexedVector * regionSparse2)
 {
+  COIN_TIME_SCOPE("factorization.ftran_ft");
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX=CoinCpuTime();
 #endif
   //permute and move indices into index array
-  int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
+  bool doFT;
+  int * COIN_RESTRICT regionIndex = reserveColumnFT(regionSparse,doFT);
   int numberNonZero = regionSparse2->getNumElements();
   const int *permute = permute_.array();
   int * COIN_RESTRICT index = regionSparse2->getIndices();
   double * COIN_RESTRICT region = regionSparse->denseVector();
   double * COIN_RESTRICT array = regionSparse2->denseVector();
-  CoinBigIndex * COIN_RESTRICT startColumnU = startColumnU_.array();
-  bool doFT=doForrestTomlin_;
-  // see if room
-  if (doFT) {
-    int iColumn = numberColumnsExtra_;
-    
-    startColumnU[iColumn] = startColumnU[maximumColumnsExtra_];
-    CoinBigIndex start = startColumnU[iColumn];
-    CoinBigIndex space = lengthAreaU_ - ( start + numberRowsExtra_ );
-    doFT = space>=0;
-    if (doFT) {
-      regionIndex = indexRowU_.array() + start;
-    } else {
-      startColumnU[maximumColumnsExtra_] = lengthAreaU_+1;
-    }
-  }
 
 #ifndef CLP_FACTORIZATION
   bool packed = regionSparse2->packedMode();
-  if (packed) {
 #else
-    assert (regionSparse2->packedMode());
-#endif
-    for (int j = 0; j < numberNonZero; j ++ ) {
-      int iRow = index[j];
-      double value = array[j];
-      array[j]=0.0;
-      iRow = permute[iRow];
-      region[iRow] = value;
-      regionIndex[j] = iRow;
-    }
-#ifndef CLP_FACTORIZATION
-  } else {
-    for (int j = 0; j < numberNonZero; j ++ ) {
-      int iRow = index[j];
-      double value = array[iRow];
-      array[iRow]=0.0;
-      iRow = permute[iRow];
-      region[iRow] = value;
-      regionIndex[j] = iRow;
-    }
-  }
+  assert (regionSparse2->packedMode());
+  bool packed = true;
 #endif
+  CoinPermuteScatter(permute,index,numberNonZero,array,packed,
+		     region,regionIndex);
   regionSparse->setNumElements ( numberNonZero );
   if (collectStatistics_) {
     numberFtranCounts_++;
     ftranCountInput_ += numberNonZero;
   }
+  CoinChargeWork(numberNonZero);
     
   //  ******* L
 #if 0
@@ -2262,7 +2946,7 @@ int CoinFactorization::updateColumnFT ( CoinIndexedVector * regionSparse,
     }
   }
 #endif
-  updateColumnL ( regionSparse, regionIndex );
+  updateColumnL ( regionSparse, regionIndex, sparse_.array() );
 #if 0
   {
     double *region = regionSparse->denseVector (  );
@@ -2276,31 +2960,198 @@ int CoinFactorization::updateColumnFT ( CoinIndexedVector * regionSparse,
 #endif
   if (collectStatistics_) 
     ftranCountAfterL_ += regionSparse->getNumElements();
+  int returnCode = updateColumnFTAfterL(regionSparse,regionSparse2,
+					regionIndex,doFT);
+  CoinChargeWork(regionSparse2->getNumElements());
+#ifdef CLP_FACTORIZATION_INSTRUMENT
+  numberUpdateFT++;
+  timeInUpdateFT += CoinCpuTime()-startTimeX;
+  averageLengthR += lengthR_;
+  averageLengthU += lengthU_;
+  averageLengthL += lengthL_;
+#endif
+  return returnCode;
+}
+/* Gets index array for FT update - in U if room (doFT true) otherwise
+   that of regionSparse */
+int *
+CoinFactorization::reserveColumnFT ( CoinIndexedVector * regionSparse,
+				     bool & doFT)
+{
+  int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
+  CoinBigIndex * COIN_RESTRICT startColumnU = startColumnU_.array();
+  doFT=doForrestTomlin_;
+  // see if room
+  if (doFT) {
+    int iColumn = numberColumnsExtra_;
+    
+    startColumnU[iColumn] = startColumnU[maximumColumnsExtra_];
+    CoinBigIndex start = startColumnU[iColumn];
+    CoinBigIndex space = lengthAreaU_ - ( start + numberRowsExtra_ );
+    doFT = space>=0;
+    if (doFT) {
+      regionIndex = indexRowU_.array() + start;
+    } else {
+      startColumnU[maximumColumnsExtra_] = lengthAreaU_+1;
+    }
+  }
+  return regionIndex;
+}
+/* Does R (storing partial update if doFT) and U parts of FT update
+   and permutes back into regionSparse2.  Returns as updateColumnFT */
+int
+CoinFactorization::updateColumnFTAfterL ( CoinIndexedVector * regionSparse,
+					  CoinIndexedVector * regionSparse2,
+					  int * COIN_RESTRICT regionIndex,
+					  bool doFT)
+{
   //permute extra
   //row bits here
   if ( doFT ) 
     updateColumnRFT ( regionSparse, regionIndex );
   else
-    updateColumnR ( regionSparse );
+    updateColumnR ( regionSparse, sparse_.array() );
   if (collectStatistics_) 
     ftranCountAfterR_ += regionSparse->getNumElements();
   //  ******* U
-  updateColumnU ( regionSparse, regionIndex);
+  updateColumnU ( regionSparse, regionIndex, sparse_.array());
   if (!doForrestTomlin_) {
     // Do PFI after everything else
     updateColumnPFI(regionSparse);
   }
   permuteBack(regionSparse,regionSparse2);
-#ifdef CLP_FACTORIZATION_INSTRUMENT
-  numberUpdateFT++;
-  timeInUpdateFT += CoinCpuTime()-startTimeX;
-  averageLengthR += lengthR_;
-  averageLengthU += lengthU_;
-  averageLengthL += lengthL_;
-#endif
   // will be negative if no room
   if ( doFT ) 
     return regionSparse2->getNumElements();
   else 
     return -regionSparse2->getNumElements();
 }
+// Shared information for a batch of updates
+typedef struct {
+  const CoinFactorization * factorization;
+  CoinIndexedVector ** regions;
+  int numberColumns;
+  // next column to be done
+  int next;
+  bool transpose;
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_t mutex;
+#endif
+} CoinFactorizationBatchInfo;
+// Private information for each worker in a batch of updates
+typedef struct {
+  CoinFactorizationBatchInfo * shared;
+  CoinIndexedVector * work;
+  int * sparseWork;
+  int numberNonZero;
+} CoinFactorizationBatchThread;
+// Body of each batch worker - takes next column until none left
+void * 
+CoinFactorization::batchWorker ( void * info )
+{
+  CoinFactorizationBatchThread * thread = 
+    reinterpret_cast<CoinFactorizationBatchThread *> (info);
+  CoinFactorizationBatchInfo * shared = thread->shared;
+  const CoinFactorization * factorization = shared->factorization;
+  while (true) {
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_lock(&shared->mutex);
+#endif
+    int iColumn = shared->next++;
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_unlock(&shared->mutex);
+#endif
+    if (iColumn>=shared->numberColumns)
+      break;
+    CoinIndexedVector * region = shared->regions[iColumn];
+    if (!shared->transpose)
+      thread->numberNonZero += 
+	factorization->updateColumnWork(thread->work,region,false,
+					thread->sparseWork);
+    else
+      thread->numberNonZero += 
+	factorization->updateColumnTransposeWork(thread->work,region,
+						 thread->sparseWork);
+  }
+  return NULL;
+}
+// Updates a batch of independent columns (FTRAN)
+int 
+CoinFactorization::updateColumnsBatch ( int numberColumns,
+					CoinIndexedVector ** regionSparse2,
+					int numberThreads) const
+{
+  return gutsOfBatch(numberColumns,regionSparse2,numberThreads,false);
+}
+// Updates a batch of independent columns (BTRAN)
+int 
+CoinFactorization::updateColumnsTransposeBatch ( int numberColumns,
+						 CoinIndexedVector ** regionSparse2,
+						 int numberThreads) const
+{
+  return gutsOfBatch(numberColumns,regionSparse2,numberThreads,true);
+}
+// Does work for batches of updates
+int 
+CoinFactorization::gutsOfBatch ( int numberColumns, 
+				 CoinIndexedVector ** regionSparse2,
+				 int numberThreads, bool transpose) const
+{
+  if (numberColumns<=0)
+    return 0;
+#ifndef COINUTILS_PTHREADS
+  numberThreads=1;
+#endif
+  // no sparse area means small problem - not worth the threads
+  if (!sparse_.array())
+    numberThreads=1;
+  numberThreads = CoinMax(1,CoinMin(numberThreads,numberColumns));
+  CoinFactorizationBatchInfo shared;
+  shared.factorization = this;
+  shared.regions = regionSparse2;
+  shared.numberColumns = numberColumns;
+  shared.next = 0;
+  shared.transpose = transpose;
+  CoinIndexedVector * work = new CoinIndexedVector [numberThreads];
+  CoinFactorizationBatchThread * thread = 
+    new CoinFactorizationBatchThread [numberThreads];
+  // first worker is this thread and can use sparse_
+  int sizeSparse = 0;
+  int * sparseArea = NULL;
+  if (numberThreads>1) {
+    // allow for stack, list, next and char map of mark (as goSparse)
+    int nRowIndex = (maximumRowsExtra_+CoinSizeofAsInt(int)-1)/
+      CoinSizeofAsInt(char);
+    int nInBig = static_cast<int>(sizeof(CoinBigIndex)/sizeof(int));
+    sizeSparse = (2+nInBig)*maximumRowsExtra_ + nRowIndex;
+    sparseArea = new int [sizeSparse*(numberThreads-1)];
+    // only mark needs to be zero but cheap compared to solves
+    CoinZeroN(sparseArea,sizeSparse*(numberThreads-1));
+  }
+  for (int i=0;i<numberThreads;i++) {
+    work[i].reserve(maximumRowsExtra_);
+    thread[i].shared = &shared;
+    thread[i].work = work+i;
+    thread[i].numberNonZero = 0;
+    // only first worker (using sparse_) collects statistics
+    if (!i)
+      thread[i].sparseWork = sparse_.array();
+    else
+      thread[i].sparseWork = sparseArea+(i-1)*sizeSparse;
+  }
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_init(&shared.mutex,NULL);
+#endif
+  CoinThreadPool::run(batchWorker,thread,
+		      sizeof(CoinFactorizationBatchThread),numberThreads);
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_destroy(&shared.mutex);
+#endif
+  int numberNonZero = 0;
+  for (int i=0;i<numberThreads;i++)
+    numberNonZero += thread[i].numberNonZero;
+  delete [] sparseArea;
+  delete [] thread;
+  delete [] work;
+  return numberNonZero;
+}
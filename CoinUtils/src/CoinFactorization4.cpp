@@ -16,7 +16,9 @@
 #include "CoinFactorization.hpp"
 #include "CoinIndexedVector.hpp"
 #include "CoinHelperFunctions.hpp"
+#include "CoinPermute.hpp"
 #include "CoinTime.hpp"
+#include "CoinInstrument.hpp"
 #include <stdio.h>
 #include <iostream>
 #if COIN_FACTORIZATION_DENSE_CODE==1 
@@ -45,6 +47,8 @@ int clapack_dgetrs ( const enum CBLAS_ORDER Order,
 // Intel compiler
 #include "mkl_lapacke.h"
 #endif
+// Prefetch distance in long R etas
+#define COIN_R_PREFETCH 16
 // For semi-sparse
 #define BITS_PER_CHECK 8
 #define CHECK_SHIFT 3
@@ -125,6 +129,43 @@ CoinFactorization::getRowSpaceIterate ( int iRow,
   startRow[maximumRowsExtra_] = put + extraNeeded + 4;
   return true;
 }
+//  flushRowCopyU.  Adds pending columns of U to row copy
+void
+CoinFactorization::flushRowCopyU (  )
+{
+  if (!numberPendingU_)
+    return;
+  const CoinBigIndex * COIN_RESTRICT startColumnU = startColumnU_.array();
+  const int * COIN_RESTRICT numberInColumn = numberInColumn_.array();
+  const int * COIN_RESTRICT indexRowU = indexRowU_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT elementU = elementU_.array();
+  int * COIN_RESTRICT numberInRow = numberInRow_.array();
+  CoinBigIndex * COIN_RESTRICT startRow = startRowU_.array();
+  int * COIN_RESTRICT indexColumn = indexColumnU_.array();
+  CoinBigIndex * COIN_RESTRICT convertRowToColumn = convertRowToColumnU_.array();
+  const int * COIN_RESTRICT nextRow = nextRow_.array();
+  for (int iColumn = numberRowsExtra_-numberPendingU_;
+       iColumn < numberRowsExtra_; iColumn++ ) {
+    CoinBigIndex start = startColumnU[iColumn];
+    CoinBigIndex end = start + numberInColumn[iColumn];
+    for (CoinBigIndex j = start; j < end; j++ ) {
+      // zeroed if pivot or row taken out since
+      if (!elementU[j])
+	continue;
+      int iRow = indexRowU[j];
+      int iNumberInRow = numberInRow[iRow];
+      CoinBigIndex put = startRow[iRow] + iNumberInRow;
+      if ( startRow[nextRow[iRow]] - put <= 0 ) {
+	getRowSpaceIterate ( iRow, iNumberInRow + 4 );
+	put = startRow[iRow] + iNumberInRow;
+      }
+      indexColumn[put] = iColumn;
+      convertRowToColumn[put] = j;
+      numberInRow[iRow] = iNumberInRow + 1;
+    }
+  }
+  numberPendingU_ = 0;
+}
 
 //  getColumnSpaceIterateR.  Gets space for one extra R element in Column
 //may have to do compression  (returns true)
@@ -293,6 +334,7 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
 				   bool checkBeforeModifying,
 				   double )
 {
+  COIN_TIME_SCOPE("factorization.replace");
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX=CoinCpuTime();
 #endif
@@ -402,9 +444,26 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
 	regionIndex[numberNonZero++] = iColumn;
       }
     }       
+    // and in columns not yet in row copy
+    const int * COIN_RESTRICT indexRowU = indexRowU_.array();
+    for (int iColumn = numberRowsExtra_-numberPendingU_;
+	 iColumn < numberRowsExtra_; iColumn++ ) {
+      CoinBigIndex startThis = startColumnU[iColumn];
+      CoinBigIndex endThis = startThis + numberInColumn[iColumn];
+      for (CoinBigIndex j = startThis; j < endThis; j++ ) {
+	if ( indexRowU[j] == realPivotRow && element[j] ) {
+	  smallestIndex = CoinMin(smallestIndex,iColumn);
+	  region[iColumn] = element[j];
+	  if (!checkBeforeModifying)
+	    element[j] = 0.0;
+	  regionIndex[numberNonZero++] = iColumn;
+	  break;
+	}
+      }
+    }
     //do BTRAN - finding first one to use
     regionSparse->setNumElements ( numberNonZero );
-    updateColumnTransposeU ( regionSparse, smallestIndex );
+    updateColumnTransposeU ( regionSparse, smallestIndex, sparse_.array() );
 #if COIN_ONE_ETA_COPY
   } else {
     // use R to save where elements are
@@ -466,6 +525,16 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
 	CoinBigIndex j = convertRowToColumn[i];
 	element[j] = 0.0;
       }
+      const int * COIN_RESTRICT indexRowU = indexRowU_.array();
+      for (int iColumn = numberRowsExtra_-numberPendingU_;
+	   iColumn < numberRowsExtra_; iColumn++ ) {
+	CoinBigIndex startThis = startColumnU[iColumn];
+	CoinBigIndex endThis = startThis + numberInColumn[iColumn];
+	for (CoinBigIndex j = startThis; j < endThis; j++ ) {
+	  if ( indexRowU[j] == realPivotRow )
+	    element[j] = 0.0;
+	}
+      }
 #if COIN_ONE_ETA_COPY
     } else {
       // delete elements
@@ -503,6 +572,8 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
   if ( lengthR_ >= lengthAreaR_ ) {
     //not enough room
     regionSparse->clear();
+    if (adaptiveRefactor_)
+      areaFactor_ = 1.1 * CoinMax(areaFactor_, 1.0);
     return 3;
   }       
 #if COIN_DEBUG>1
@@ -565,6 +636,8 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
   if ( lengthU_ >= lengthAreaU_ ) {
     //not enough room
     regionSparse->clear();
+    if (adaptiveRefactor_)
+      areaFactor_ = 1.1 * CoinMax(areaFactor_, 1.0);
     return 3;
   }
        
@@ -580,6 +653,8 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
 #if COIN_ONE_ETA_COPY
   if (convertRowToColumn) {
 #endif
+    // lazy row copy - column added later (or used by column)
+    bool deferRowCopy = (lazyRowCopyU_>0);
     for (CoinBigIndex i = 0; i < number; i++ ) {
       int iRow = indexU[i];
 #if COIN_DEBUG>1
@@ -588,7 +663,14 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
 #endif
       
       //assert ( fabs ( elementU[i] ) > zeroTolerance_ );
-      if ( iRow != realPivotRow ) {
+      if ( deferRowCopy ) {
+	if ( iRow != realPivotRow ) {
+	  saveFromU = saveFromU - elementU[i] * region[iRow];
+	} else {
+	  saveFromU += elementU[i];
+	  elementU[i] = 0.0;
+	}
+      } else if ( iRow != realPivotRow ) {
 	int next = nextRow[iRow];
 	int iNumberInRow = numberInRow[iRow];
 	CoinBigIndex space;
@@ -666,6 +748,14 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
     numberColumnsExtra_++;
     numberGoodU_++;
     numberPivots_++;
+    if (lazyRowCopyU_>0) {
+      numberPendingU_++;
+      if (numberPendingU_>=lazyRowCopyU_)
+	flushRowCopyU();
+    }
+    if (blockSizeR_&&
+	numberRowsExtra_-CoinMax(firstUnblockedR_,numberRows_)>=blockSizeR_)
+      makeBlockR();
   }       
   if ( numberRowsExtra_ > numberRows_ + 50 ) {
     CoinBigIndex extra = factorElements_ >> 1;
@@ -690,6 +780,19 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
       }
     }       
   }
+  if (adaptiveRefactor_) {
+    /* Each solve now passes added elements more than after factorization.
+       Average work per update is (refactor + sum of added)/updates - once
+       this update added more than that it is time to refactorize */
+    double added = static_cast<double> (totalElements_ - factorElements_);
+    updateWork_ += added;
+    double numberUpdates = numberRowsExtra_ - numberRows_;
+    if (numberUpdates * added >
+	updateWork_ + refactorWork_ * factorElements_)
+      refactorRecommended_ = true;
+    if (refactorRecommended_ && adaptiveRefactor_ > 1 && !status)
+      status = 3;
+  }
   if (numberInColumnPlus&&status<2) {
     // we are going to put another copy of R in R
     CoinFactorizationDouble * COIN_RESTRICT elementR = elementR_ + lengthAreaR_;
@@ -739,12 +842,126 @@ CoinFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
   return status;
 }
 
+/* Replaces numberColumns columns of basis one after another
+   returns 0=OK, 1=Probably OK, 2=singular, 3=no room, 5=too many pivots */
+int
+CoinFactorization::replaceColumns ( int numberColumns,
+				    CoinIndexedVector * regionSparse,
+				    CoinIndexedVector ** columns,
+				    const int pivotRow[],
+				    int & numberDone,
+				    bool checkBeforeModifying,
+				    double acceptablePivot)
+{
+  numberDone = 0;
+  // refuse whole burst before changing anything if too many
+  if (doForrestTomlin_) {
+    if ( numberColumnsExtra_ + numberColumns > maximumColumnsExtra_ )
+      return 5;
+  } else if ( numberPivots_ + numberColumns > maximumPivots_ ) {
+    return 5;
+  }
+  const int * COIN_RESTRICT permute = permute_.array();
+  double * COIN_RESTRICT region = regionSparse->denseVector();
+  int * COIN_RESTRICT regionIndex = regionSparse->getIndices();
+  /* L is not changed by updates so do all L parts first (columns are
+     put in permuted order) - densish ones together */
+  int numberDensish = 0;
+  CoinIndexedVector ** densish = new CoinIndexedVector * [numberColumns];
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = columns[i];
+    assert (!column->packedMode());
+    int numberNonZero = column->getNumElements();
+    int * COIN_RESTRICT index = column->getIndices();
+    double * COIN_RESTRICT array = column->denseVector();
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      double value = array[iRow];
+      array[iRow]=0.0;
+      iRow = permute[iRow];
+      region[iRow] = value;
+      regionIndex[j] = iRow;
+    }
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = regionIndex[j];
+      array[iRow] = region[iRow];
+      region[iRow] = 0.0;
+      index[j] = iRow;
+    }
+    if (collectStatistics_) {
+      numberFtranCounts_++;
+      ftranCountInput_ += numberNonZero;
+    }
+    if (numberL_&&!updateColumnLMethod(numberNonZero))
+      densish[numberDensish++] = column;
+    else
+      updateColumnL ( column, index, sparse_.array() );
+  }
+  if (numberDensish>1) {
+    updateColumnsLDensish(numberDensish,densish);
+    for (int i=0;i<numberDensish;i++)
+      updateColumnLDense(densish[i],densish[i]->getIndices());
+  } else if (numberDensish) {
+    updateColumnL ( densish[0], densish[0]->getIndices(), sparse_.array() );
+  }
+  delete [] densish;
+  int returnCode = 0;
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = columns[i];
+    int numberNonZero = column->getNumElements();
+    if (collectStatistics_) 
+      ftranCountAfterL_ += numberNonZero;
+    // rest of FT update with respect to current basis
+    bool doFT;
+    int * COIN_RESTRICT ftIndex = reserveColumnFT(regionSparse,doFT);
+    const int * COIN_RESTRICT index = column->getIndices();
+    double * COIN_RESTRICT array = column->denseVector();
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      region[iRow] = array[iRow];
+      array[iRow] = 0.0;
+      ftIndex[j] = iRow;
+    }
+    column->setNumElements(0);
+    regionSparse->setNumElements(numberNonZero);
+    updateColumnFTAfterL(regionSparse,column,ftIndex,doFT);
+    double alpha = column->denseVector()[pivotRow[i]];
+    int status;
+    if (doForrestTomlin_)
+      status = replaceColumn(regionSparse,pivotRow[i],alpha,
+			     checkBeforeModifying,acceptablePivot);
+    else
+      status = replaceColumnPFI(column,pivotRow[i],alpha);
+    returnCode = CoinMax(returnCode,status);
+    if (status>1) {
+      // leave rest empty
+      for (int k=i+1;k<numberColumns;k++)
+	columns[k]->clear();
+      break;
+    }
+    numberDone++;
+  }
+  return returnCode;
+}
 //  updateColumnTranspose.  Updates one column transpose (BTRAN)
 int
 CoinFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
                                           CoinIndexedVector * regionSparse2 ) 
   const
 {
+  return updateColumnTransposeWork(regionSparse,regionSparse2,
+				   sparse_.array());
+}
+/* As updateColumnTranspose but sparse work area is passed in
+   (so can be called from several threads at once) */
+int
+CoinFactorization::updateColumnTransposeWork ( CoinIndexedVector * regionSparse,
+					       CoinIndexedVector * regionSparse2,
+					       int * COIN_RESTRICT sparseWork) 
+  const
+{
+  COIN_TIME_SCOPE("factorization.btran");
+  CoinChargeWork(regionSparse2->getNumElements());
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   double startTimeX=CoinCpuTime();
 #endif
@@ -759,27 +976,29 @@ CoinFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
   //move indices into index array
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
   bool packed = regionSparse2->packedMode();
-  if (packed) {
-    for (int i = 0; i < numberNonZero; i ++ ) {
-      int iRow = index[i];
-      double value = vector[i];
-      iRow=pivotColumn[iRow];
-      vector[i]=0.0;
-      region[iRow] = value;
-      regionIndex[i] = iRow;
-    }
+  CoinFactorizationDouble * COIN_RESTRICT pivotRegion = pivotRegion_.array();
+  int smallestIndex=numberRowsExtra_;
+  // With Forrest-Tomlin nothing comes before U so apply pivot region as moved
+#if COIN_BIG_DOUBLE!=1
+  bool scaled = doForrestTomlin_;
+#else
+  bool scaled = false;
+#endif
+  if (scaled) {
+    int firstLast[2];
+    firstLast[0]=numberRowsExtra_;
+    firstLast[1]=0;
+#if COIN_BIG_DOUBLE!=1
+    CoinPermuteScatter(pivotColumn,index,numberNonZero,vector,packed,
+		       region,regionIndex,pivotRegion,firstLast);
+#endif
+    smallestIndex=firstLast[0];
   } else {
-    for (int i = 0; i < numberNonZero; i ++ ) {
-      int iRow = index[i];
-      double value = vector[iRow];
-      vector[iRow]=0.0;
-      iRow=pivotColumn[iRow];
-      region[iRow] = value;
-      regionIndex[i] = iRow;
-    }
+    CoinPermuteScatter(pivotColumn,index,numberNonZero,vector,packed,
+		       region,regionIndex);
   }
   regionSparse->setNumElements ( numberNonZero );
-  if (collectStatistics_) {
+  if (collectStatistics_&&sparseWork==sparse_.array()) {
     numberBtranCounts_++;
     btranCountInput_ += static_cast<double> (numberNonZero);
   }
@@ -789,25 +1008,24 @@ CoinFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
     numberNonZero = regionSparse->getNumElements();
   }
   //  ******* U
-  // Apply pivot region - could be combined for speed
-  CoinFactorizationDouble * COIN_RESTRICT pivotRegion = pivotRegion_.array();
-  
-  int smallestIndex=numberRowsExtra_;
-  for (int j = 0; j < numberNonZero; j++ ) {
-    int iRow = regionIndex[j];
-    smallestIndex = CoinMin(smallestIndex,iRow);
-    region[iRow] *= pivotRegion[iRow];
+  if (!scaled) {
+    // Apply pivot region
+    for (int j = 0; j < numberNonZero; j++ ) {
+      int iRow = regionIndex[j];
+      smallestIndex = CoinMin(smallestIndex,iRow);
+      region[iRow] *= pivotRegion[iRow];
+    }
   }
-  updateColumnTransposeU ( regionSparse,smallestIndex );
-  if (collectStatistics_) 
+  updateColumnTransposeU ( regionSparse,smallestIndex, sparseWork );
+  if (collectStatistics_&&sparseWork==sparse_.array()) 
     btranCountAfterU_ += static_cast<double> (regionSparse->getNumElements());
   //permute extra
   //row bits here
-  updateColumnTransposeR ( regionSparse );
+  updateColumnTransposeR ( regionSparse, sparseWork );
   //  ******* L
-  updateColumnTransposeL ( regionSparse );
+  updateColumnTransposeL ( regionSparse, sparseWork );
   numberNonZero = regionSparse->getNumElements (  );
-  if (collectStatistics_) { 
+  if (collectStatistics_&&sparseWork==sparse_.array()) { 
     btranCountAfterL_ += static_cast<double> (numberNonZero);
 #ifdef CLP_FACTORIZATION_INSTRUMENT
     scaledLengthDense += numberDense_*numberNonZero;
@@ -818,32 +1036,11 @@ CoinFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
 #endif
   }
   const int * permuteBack = pivotColumnBack();
-  int number=0;
-  if (packed) {
-    for (int i=0;i<numberNonZero;i++) {
-      int iRow=regionIndex[i];
-      double value = region[iRow];
-      region[iRow]=0.0;
-      //if (fabs(value)>zeroTolerance_) {
-	iRow=permuteBack[iRow];
-	vector[number]=value;
-	index[number++]=iRow;
-	//}
-    }
-  } else {
-    for (int i=0;i<numberNonZero;i++) {
-      int iRow=regionIndex[i];
-      double value = region[iRow];
-      region[iRow]=0.0;
-      //if (fabs(value)>zeroTolerance_) {
-	iRow=permuteBack[iRow];
-	vector[iRow]=value;
-	index[number++]=iRow;
-	//}
-    }
-  }
+  int number = CoinPermuteGather(permuteBack,regionIndex,numberNonZero,
+				 region,vector,packed,index);
   regionSparse->setNumElements(0);
   regionSparse2->setNumElements(number);
+  CoinChargeWork(number);
 #ifdef COIN_DEBUG
   for (i=0;i<numberRowsExtra_;i++) {
     assert (!region[i]);
@@ -859,6 +1056,132 @@ CoinFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
   return number;
 }
 
+/* Updates several columns transpose (BTRAN) - densish ones go through
+   U, R and L together */
+int
+CoinFactorization::updateColumnsTranspose ( CoinIndexedVector * regionSparse,
+					    int numberColumns,
+					    CoinIndexedVector ** regionSparse2) 
+  const
+{
+  COIN_TIME_SCOPE("factorization.btran");
+  const int * COIN_RESTRICT pivotColumn = pivotColumn_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT pivotRegion =
+    pivotRegion_.array();
+  double * COIN_RESTRICT region = regionSparse->denseVector();
+  int * COIN_RESTRICT regionIndex = regionSparse->getIndices();
+  int numberDensish = 0;
+  CoinIndexedVector ** densish = new CoinIndexedVector * [numberColumns];
+  int * smallestIndex = new int [numberColumns];
+  int smallestDensish = numberRowsExtra_;
+  //  ******* U
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = regionSparse2[i];
+    assert (!column->packedMode()&&column->capacity()>=maximumRowsExtra_);
+    int numberNonZero = column->getNumElements();
+    int * COIN_RESTRICT index = column->getIndices();
+    double * COIN_RESTRICT array = column->denseVector();
+    CoinChargeWork(numberNonZero);
+    // permute in place (through region)
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      double value = array[iRow];
+      array[iRow]=0.0;
+      iRow = pivotColumn[iRow];
+      region[iRow] = value;
+      regionIndex[j] = iRow;
+    }
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = regionIndex[j];
+      array[iRow] = region[iRow];
+      region[iRow] = 0.0;
+      index[j] = iRow;
+    }
+    if (!doForrestTomlin_) {
+      // Do PFI before everything else
+      updateColumnTransposePFI(column);
+      numberNonZero = column->getNumElements();
+    }
+    int smallest = numberRowsExtra_;
+    for (int j = 0; j < numberNonZero; j++ ) {
+      int iRow = index[j];
+      smallest = CoinMin(smallest,iRow);
+      array[iRow] *= pivotRegion[iRow];
+    }
+    smallestIndex[i] = smallest;
+    // densish as updateColumnTransposeU would judge
+    bool isDensish = true;
+    if (sparseThreshold_>0) {
+      if (btranAverageAfterU_) 
+	isDensish = static_cast<int> (numberNonZero*btranAverageAfterU_)
+	  >= sparseThreshold2_;
+      else
+	isDensish = numberNonZero >= sparseThreshold_;
+    }
+    if (isDensish) {
+      densish[numberDensish++] = column;
+      smallestDensish = CoinMin(smallestDensish,smallest);
+    }
+  }
+  if (numberDensish<2)
+    numberDensish = 0;
+  // columns not in row copy are done by column
+  bool fuseU = numberDensish && !numberPendingU_ 
+    && convertRowToColumnU_.array();
+  if (fuseU)
+    updateColumnsTransposeUDensish(numberDensish,densish,smallestDensish);
+  int iDensish = 0;
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = regionSparse2[i];
+    if (iDensish<numberDensish&&densish[iDensish]==column) {
+      iDensish++;
+      if (fuseU)
+	continue;
+    }
+    updateColumnTransposeU ( column, smallestIndex[i], sparse_.array() );
+  }
+  //  ******* R
+  if (numberDensish&&numberRowsExtra_>numberRows_)
+    updateColumnsTransposeRDensish(numberDensish,densish);
+  //  ******* L
+  if (numberDensish)
+    updateColumnsTransposeLDensish(numberDensish,densish);
+  iDensish = 0;
+  const int * COIN_RESTRICT permuteBack = pivotColumnBack();
+  int totalNonZero = 0;
+  for (int i=0;i<numberColumns;i++) {
+    CoinIndexedVector * column = regionSparse2[i];
+    if (iDensish<numberDensish&&densish[iDensish]==column) {
+      iDensish++;
+    } else {
+      updateColumnTransposeR ( column, sparse_.array() );
+      updateColumnTransposeL ( column, sparse_.array() );
+    }
+    // permute back (through region)
+    int numberNonZero = column->getNumElements();
+    int * COIN_RESTRICT index = column->getIndices();
+    double * COIN_RESTRICT array = column->denseVector();
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      region[iRow] = array[iRow];
+      array[iRow] = 0.0;
+      regionIndex[j] = iRow;
+    }
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = regionIndex[j];
+      double value = region[iRow];
+      region[iRow] = 0.0;
+      iRow = permuteBack[iRow];
+      array[iRow] = value;
+      index[j] = iRow;
+    }
+    CoinChargeWork(numberNonZero);
+    totalNonZero += numberNonZero;
+  }
+  delete [] densish;
+  delete [] smallestIndex;
+  return totalNonZero;
+}
 /* Updates part of column transpose (BTRANU) when densish,
    assumes index is sorted i.e. region is correct */
 void 
@@ -878,7 +1201,9 @@ CoinFactorization::updateColumnTransposeUDensish
   const int *indexColumn = indexColumnU_.array();
   
   const CoinFactorizationDouble * element = elementU_.array();
-  int last = numberU_;
+  // columns not in row copy are done afterwards
+  int last = numberPendingU_ ? CoinMin(numberU_,numberRowsExtra_-numberPendingU_)
+    : numberU_;
   
   const int *numberInRow = numberInRow_.array();
   numberNonZero = 0;
@@ -912,12 +1237,71 @@ CoinFactorization::updateColumnTransposeUDensish
   //set counts
   regionSparse->setNumElements ( numberNonZero );
 }
+/* Updates part of several columns transpose (BTRANU) when densish -
+   each row of U is used for all regions with a nonzero pivot */
+void 
+CoinFactorization::updateColumnsTransposeUDensish 
+                        ( int numberColumns,
+			  CoinIndexedVector ** regions,
+			  int smallestIndex) const
+{
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex * COIN_RESTRICT startRow = startRowU_.array();
+  const CoinBigIndex * COIN_RESTRICT convertRowToColumn =
+    convertRowToColumnU_.array();
+  const int * COIN_RESTRICT indexColumn = indexColumnU_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT element = elementU_.array();
+  const int * COIN_RESTRICT numberInRow = numberInRow_.array();
+  double ** region = new double * [numberColumns];
+  int ** regionIndex = new int * [numberColumns];
+  int * numberNonZero = new int [numberColumns];
+  // regions with nonzero pivot and pivot values
+  double ** active = new double * [numberColumns];
+  CoinFactorizationDouble * pivotValue =
+    new CoinFactorizationDouble [numberColumns];
+  for (int k=0;k<numberColumns;k++) {
+    region[k] = regions[k]->denseVector();
+    regionIndex[k] = regions[k]->getIndices();
+    numberNonZero[k] = 0;
+  }
+  for (int i=smallestIndex ; i < numberU_; i++ ) {
+    int numberActive = 0;
+    for (int k=0;k<numberColumns;k++) {
+      CoinFactorizationDouble value = region[k][i];
+      if ( fabs ( value ) > tolerance ) {
+	active[numberActive] = region[k];
+	pivotValue[numberActive++] = value;
+	regionIndex[k][numberNonZero[k]++] = i;
+      } else {
+	region[k][i] = 0.0;
+      }
+    }
+    if (!numberActive)
+      continue;
+    CoinBigIndex start = startRow[i];
+    CoinBigIndex end = start + numberInRow[i];
+    for (CoinBigIndex j = start ; j < end; j ++ ) {
+      int iRow = indexColumn[j];
+      CoinFactorizationDouble value = element[convertRowToColumn[j]];
+      for (int a=0;a<numberActive;a++)
+	active[a][iRow] -= value * pivotValue[a];
+    }
+  }
+  for (int k=0;k<numberColumns;k++)
+    regions[k]->setNumElements(numberNonZero[k]);
+  delete [] region;
+  delete [] regionIndex;
+  delete [] numberNonZero;
+  delete [] active;
+  delete [] pivotValue;
+}
 /* Updates part of column transpose (BTRANU) when sparsish,
       assumes index is sorted i.e. region is correct */
 void 
 CoinFactorization::updateColumnTransposeUSparsish 
                         ( CoinIndexedVector * regionSparse,
-			  int smallestIndex) const
+			  int smallestIndex,
+			  int * COIN_RESTRICT sparseWork) const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
   int numberNonZero = regionSparse->getNumElements (  );
@@ -931,13 +1315,15 @@ CoinFactorization::updateColumnTransposeUSparsish
   const int *indexColumn = indexColumnU_.array();
   
   const CoinFactorizationDouble * element = elementU_.array();
-  int last = numberU_;
+  // columns not in row copy are done afterwards
+  int last = numberPendingU_ ? CoinMin(numberU_,numberRowsExtra_-numberPendingU_)
+    : numberU_;
   
   const int *numberInRow = numberInRow_.array();
   
   // mark known to be zero
   int nInBig = sizeof(CoinBigIndex)/sizeof(int);
-  CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (sparse_.array()+(2+nInBig)*maximumRowsExtra_);
+  CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (sparseWork+(2+nInBig)*maximumRowsExtra_);
 
   for (int i=0;i<numberNonZero;i++) {
     int iPivot=regionIndex[i];
@@ -1020,7 +1406,8 @@ CoinFactorization::updateColumnTransposeUSparsish
    assumes index is sorted i.e. region is correct */
 void 
 CoinFactorization::updateColumnTransposeUSparse ( 
-		   CoinIndexedVector * regionSparse) const
+		   CoinIndexedVector * regionSparse,
+		   int * COIN_RESTRICT sparseWork) const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
   int numberNonZero = regionSparse->getNumElements (  );
@@ -1038,7 +1425,7 @@ CoinFactorization::updateColumnTransposeUSparse (
   
   // use sparse_ as temporary area
   // mark known to be zero
-  int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+  int * COIN_RESTRICT stack = sparseWork;  /* pivot */
   int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
   CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
   char * COIN_RESTRICT mark = reinterpret_cast<char *> (next + maximumRowsExtra_);
@@ -1119,7 +1506,8 @@ CoinFactorization::updateColumnTransposeUSparse (
 //does not sort by sign
 void
 CoinFactorization::updateColumnTransposeU ( CoinIndexedVector * regionSparse,
-					    int smallestIndex) const
+					    int smallestIndex,
+					    int * COIN_RESTRICT sparseWork) const
 {
 #if COIN_ONE_ETA_COPY
   CoinBigIndex *convertRowToColumn = convertRowToColumnU_.array();
@@ -1129,6 +1517,19 @@ CoinFactorization::updateColumnTransposeU ( CoinIndexedVector * regionSparse,
     return;
   }
 #endif
+  int firstPending = numberRowsExtra_-numberPendingU_;
+  if (numberPendingU_) {
+    // take out columns not in row copy - done by column at end
+    int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
+    int numberNonZero = regionSparse->getNumElements (  );
+    int number = 0;
+    for (int i = 0; i < numberNonZero; i++ ) {
+      int iRow = regionIndex[i];
+      if ( iRow < firstPending )
+	regionIndex[number++] = iRow;
+    }
+    regionSparse->setNumElements ( number );
+  }
   int number = regionSparse->getNumElements (  );
   int goSparse;
   // Guess at number at end
@@ -1155,12 +1556,45 @@ CoinFactorization::updateColumnTransposeU ( CoinIndexedVector * regionSparse,
     updateColumnTransposeUDensish(regionSparse,smallestIndex);
     break;
   case 1: // middling
-    updateColumnTransposeUSparsish(regionSparse,smallestIndex);
+    updateColumnTransposeUSparsish(regionSparse,smallestIndex,sparseWork);
     break;
   case 2: // sparse
-    updateColumnTransposeUSparse(regionSparse);
+    updateColumnTransposeUSparse(regionSparse,sparseWork);
     break;
   }
+  if (numberPendingU_)
+    updateColumnTransposeUPending(regionSparse);
+}
+/* Finishes BTRANU for columns of U not yet in row copy.
+   These are the last pivots so each is a dot product with
+   values already final */
+void
+CoinFactorization::updateColumnTransposeUPending 
+                        ( CoinIndexedVector * regionSparse ) const
+{
+  double * COIN_RESTRICT region = regionSparse->denseVector (  );
+  int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
+  int numberNonZero = regionSparse->getNumElements (  );
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex *startColumn = startColumnU_.array();
+  const int *indexRow = indexRowU_.array();
+  const CoinFactorizationDouble *element = elementU_.array();
+  const int *numberInColumn = numberInColumn_.array();
+  for (int i = numberRowsExtra_-numberPendingU_; i < numberRowsExtra_; i++ ) {
+    CoinFactorizationDouble pivotValue = region[i];
+    for (CoinBigIndex j = startColumn[i];
+	 j < startColumn[i]+numberInColumn[i]; j++ ) {
+      int iRow = indexRow[j];
+      pivotValue -= element[j] * region[iRow];
+    }
+    if ( fabs ( pivotValue ) > tolerance ) {
+      regionIndex[numberNonZero++] = i;
+      region[i] = pivotValue;
+    } else {
+      region[i] = 0.0;
+    }
+  }
+  regionSparse->setNumElements ( numberNonZero );
 }
 
 /*  updateColumnTransposeLDensish.  
@@ -1248,6 +1682,66 @@ CoinFactorization::updateColumnTransposeLDensish
   //set counts
   regionSparse->setNumElements ( numberNonZero );
 }
+/* Updates part of several columns transpose (BTRANL) when densish -
+   each column of L is used for all regions while in cache */
+void
+CoinFactorization::updateColumnsTransposeLDensish 
+     ( int numberColumns, CoinIndexedVector ** regions ) const
+{
+  double tolerance = zeroTolerance_;
+  const CoinBigIndex * COIN_RESTRICT startColumn = startColumnL_.array();
+  const int * COIN_RESTRICT indexRow = indexRowL_.array();
+  const CoinFactorizationDouble * COIN_RESTRICT element = elementL_.array();
+  double ** region = new double * [numberColumns];
+  CoinFactorizationDouble * pivotValue =
+    new CoinFactorizationDouble [numberColumns];
+  int first = -1;
+  for (int k=0;k<numberColumns;k++) {
+    region[k] = regions[k]->denseVector();
+    // dense part first
+    for (int i=numberRows_-numberDense_;i<numberRows_;i++) {
+      if (region[k][i]) {
+	updateColumnTransposeDense(region[k]);
+	break;
+      }
+    }
+    for (int i=numberRows_-1;i>first;i--) {
+      if (region[k][i]) {
+	first = i;
+	break;
+      }
+    }
+  }
+  int base = baseL_;
+  first = CoinMin(first,baseL_+numberL_-1);
+  for (int i = first ; i >= base; i-- ) {
+    for (int k=0;k<numberColumns;k++)
+      pivotValue[k] = region[k][i];
+    for (CoinBigIndex j = startColumn[i] ; j < startColumn[i+1]; j++ ) {
+      int iRow = indexRow[j];
+      CoinFactorizationDouble value = element[j];
+      for (int k=0;k<numberColumns;k++)
+	pivotValue[k] -= value * region[k][iRow];
+    }       
+    for (int k=0;k<numberColumns;k++)
+      region[k][i] = pivotValue[k];
+  }
+  // indices were lost in R
+  for (int k=0;k<numberColumns;k++) {
+    double * COIN_RESTRICT thisRegion = region[k];
+    int * COIN_RESTRICT regionIndex = regions[k]->getIndices();
+    int numberNonZero = 0;
+    for (int i = 0; i < numberRows_; i++ ) {
+      if ( fabs ( thisRegion[i] ) > tolerance ) 
+	regionIndex[numberNonZero++] = i;
+      else
+	thisRegion[i] = 0.0;
+    }
+    regions[k]->setNumElements(numberNonZero);
+  }
+  delete [] region;
+  delete [] pivotValue;
+}
 /*  updateColumnTransposeLByRow. 
     Updates part of column transpose (BTRANL) densish but by row */
 void
@@ -1289,7 +1783,7 @@ CoinFactorization::updateColumnTransposeLByRow
 // Updates part of column transpose (BTRANL) when sparsish by row
 void
 CoinFactorization::updateColumnTransposeLSparsish 
-    ( CoinIndexedVector * regionSparse ) const
+    ( CoinIndexedVector * regionSparse, int * COIN_RESTRICT sparseWork ) const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
@@ -1302,7 +1796,7 @@ CoinFactorization::updateColumnTransposeLSparsish
   const int * column = indexColumnL_.array();
   // mark known to be zero
   int nInBig = sizeof(CoinBigIndex)/sizeof(int);
-  CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (sparse_.array()+(2+nInBig)*maximumRowsExtra_);
+  CoinCheckZero * COIN_RESTRICT mark = reinterpret_cast<CoinCheckZero *> (sparseWork+(2+nInBig)*maximumRowsExtra_);
   for (int i=0;i<numberNonZero;i++) {
     int iPivot=regionIndex[i];
     int iWord = iPivot>>CHECK_SHIFT;
@@ -1382,7 +1876,7 @@ CoinFactorization::updateColumnTransposeLSparsish
     Updates part of column transpose (BTRANL) sparse */
 void
 CoinFactorization::updateColumnTransposeLSparse 
-    ( CoinIndexedVector * regionSparse ) const
+    ( CoinIndexedVector * regionSparse, int * COIN_RESTRICT sparseWork ) const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
@@ -1395,7 +1889,7 @@ CoinFactorization::updateColumnTransposeLSparse
   const int * column = indexColumnL_.array();
   // use sparse_ as temporary area
   // mark known to be zero
-  int * COIN_RESTRICT stack = sparse_.array();  /* pivot */
+  int * COIN_RESTRICT stack = sparseWork;  /* pivot */
   int * COIN_RESTRICT list = stack + maximumRowsExtra_;  /* final list */
   CoinBigIndex * COIN_RESTRICT next = reinterpret_cast<CoinBigIndex *> (list + maximumRowsExtra_);  /* jnext */
   char * COIN_RESTRICT mark = reinterpret_cast<char *> (next + maximumRowsExtra_);
@@ -1460,13 +1954,37 @@ CoinFactorization::updateColumnTransposeLSparse
   //set counts
   regionSparse->setNumElements ( numberNonZero );
 }
+// Updates dense part of column transpose (BTRAN) - region is whole region
+void
+CoinFactorization::updateColumnTransposeDense ( double * region ) const
+{
+#if COIN_FACTORIZATION_DENSE_CODE
+  region += numberRows_-numberDense_;
+#endif
+#if COIN_FACTORIZATION_DENSE_CODE==1
+  char trans = 'T';
+  int ione=1;
+  int info;
+  F77_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&ione,denseAreaAddress_,&numberDense_,
+			  densePermute_,region,&numberDense_,&info,1);
+#elif COIN_FACTORIZATION_DENSE_CODE==2
+  clapack_dgetrs ( CblasColMajor,CblasTrans,numberDense_,1,
+		   denseAreaAddress_,numberDense_,densePermute_,
+		   region,numberDense_);
+#elif COIN_FACTORIZATION_DENSE_CODE==3
+  LAPACKE_dgetrs ( LAPACK_COL_MAJOR,'T',numberDense_,1,
+		   denseAreaAddress_,numberDense_,densePermute_,
+		   region,numberDense_);
+#endif
+}
 //  updateColumnTransposeL.  Updates part of column transpose (BTRANL)
 void
-CoinFactorization::updateColumnTransposeL ( CoinIndexedVector * regionSparse ) const
+CoinFactorization::updateColumnTransposeL ( CoinIndexedVector * regionSparse,
+					    int * COIN_RESTRICT sparseWork) const
 {
   int number = regionSparse->getNumElements (  );
   if (!numberL_&&!numberDense_) {
-    if (sparse_.array()||number<numberRows_)
+    if (sparseWork||number<numberRows_)
       return;
   }
   int goSparse;
@@ -1527,21 +2045,7 @@ CoinFactorization::updateColumnTransposeL ( CoinIndexedVector * regionSparse ) c
     }
     if (doDense) {
       regionSparse->setNumElements(number);
-#if COIN_FACTORIZATION_DENSE_CODE==1
-      char trans = 'T';
-      int ione=1;
-      int info;
-      F77_FUNC(dgetrs,DGETRS)(&trans,&numberDense_,&ione,denseAreaAddress_,&numberDense_,
-			      densePermute_,region+lastSparse,&numberDense_,&info,1);
-#elif COIN_FACTORIZATION_DENSE_CODE==2
-      clapack_dgetrs ( CblasColMajor,CblasTrans,numberDense_,1,
-		       denseAreaAddress_,numberDense_,densePermute_,
-	region+lastSparse,numberDense_);
-#elif COIN_FACTORIZATION_DENSE_CODE==3
-      LAPACKE_dgetrs ( LAPACK_COL_MAJOR,'T',numberDense_,1,
-		       denseAreaAddress_,numberDense_,densePermute_,
-		       region+lastSparse,numberDense_);
-#endif
+      updateColumnTransposeDense(region);
       //and scan again
       if (goSparse>0||!numberL_)
 	regionSparse->scan(lastSparse,numberRows_,zeroTolerance_);
@@ -1560,16 +2064,20 @@ CoinFactorization::updateColumnTransposeL ( CoinIndexedVector * regionSparse ) c
     goSparse=0;
   switch (goSparse) {
   case -1: // No row copy
+    COIN_COUNT("factorization.btran_l.densish");
     updateColumnTransposeLDensish(regionSparse);
     break;
   case 0: // densish but by row
+    COIN_COUNT("factorization.btran_l.by_row");
     updateColumnTransposeLByRow(regionSparse);
     break;
   case 1: // middling(and by row)
-    updateColumnTransposeLSparsish(regionSparse);
+    COIN_COUNT("factorization.btran_l.sparsish");
+    updateColumnTransposeLSparsish(regionSparse,sparseWork);
     break;
   case 2: // sparse
-    updateColumnTransposeLSparse(regionSparse);
+    COIN_COUNT("factorization.btran_l.sparse");
+    updateColumnTransposeLSparse(regionSparse,sparseWork);
     break;
   }
 }
@@ -1706,14 +2214,62 @@ CoinFactorization::updateColumnTransposeRDensish
   const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
   //move using permute_ (stored in inverse fashion)
   const int * permute = permute_.array();
+  // blocks of etas (see makeBlockR) are done last first
+  int iBlock = numberBlocksR_-1;
+  const int * block = blockR_.array();
+  const CoinBigIndex * startBlock = startBlockR_.array();
+  int lastInBlock = (iBlock>=0) ? block[3*iBlock]+block[3*iBlock+1]-1 : -1;
   
   for (int i = last ; i >= numberRows_; i-- ) {
+    if ( i == lastInBlock ) {
+      int first = block[3*iBlock];
+      int numberEtas = block[3*iBlock+1];
+      int numberIndices = block[3*iBlock+2];
+      const int * indexBlock = indexBlockR_.array() + startBlock[2*iBlock];
+      const CoinFactorizationDouble * elementBlock =
+	elementBlockR_.array() + startBlock[2*iBlock+1];
+      CoinFactorizationDouble pivotValue[32];
+      bool any = false;
+      for (int k = 0; k < numberEtas; k++ ) {
+	pivotValue[k] = region[first+k];
+	region[first+k] = 0.0;
+	if ( pivotValue[k] )
+	  any = true;
+      }
+      if ( any ) {
+	// one scatter for each row
+	for (int k = 0; k < numberIndices; k++ ) {
+	  CoinFactorizationDouble value = 0.0;
+	  for (int e = 0; e < numberEtas; e++ )
+	    value += elementBlock[e] * pivotValue[e];
+	  elementBlock += numberEtas;
+	  region[indexBlock[k]] -= value;
+	}
+	for (int k = 0; k < numberEtas; k++ ) {
+	  if ( pivotValue[k] )
+	    region[permute[first+k]] = pivotValue[k];
+	}
+      }
+      i = first;
+      iBlock--;
+      lastInBlock = (iBlock>=0) ? block[3*iBlock]+block[3*iBlock+1]-1 : -1;
+      continue;
+    }
     int putRow = permute[i];
     CoinFactorizationDouble pivotValue = region[i];
     //zero out  old permuted
     region[i] = 0.0;
     if ( pivotValue ) {
-      for (CoinBigIndex j = startColumn[i]; j < startColumn[i+1]; j++ ) {
+      CoinBigIndex j = startColumn[i];
+      CoinBigIndex end = startColumn[i+1];
+      // long etas - fetch scattered entries ahead
+      for ( ; j < end - COIN_R_PREFETCH; j++ ) {
+	COIN_PREFETCH(region + indexRow[j+COIN_R_PREFETCH]);
+	CoinFactorizationDouble value = element[j];
+	int iRow = indexRow[j];
+	region[iRow] -= value * pivotValue;
+      }
+      for ( ; j < end; j++ ) {
 	CoinFactorizationDouble value = element[j];
 	int iRow = indexRow[j];
 	region[iRow] -= value * pivotValue;
@@ -1725,10 +2281,58 @@ CoinFactorization::updateColumnTransposeRDensish
     }
   }
 }
+/* Updates part of several columns transpose (BTRANR) when densish -
+   each eta is used for all regions with a nonzero pivot */
+void 
+CoinFactorization::updateColumnsTransposeRDensish 
+( int numberColumns, CoinIndexedVector ** regions ) const
+{
+  const int *indexRow = indexRowR_;
+  const CoinFactorizationDouble *element = elementR_;
+  const CoinBigIndex * startColumn = startColumnR_.array()-numberRows_;
+  //move using permute_ (stored in inverse fashion)
+  const int * permute = permute_.array();
+  double ** region = new double * [numberColumns];
+  // regions with nonzero pivot and pivot values
+  double ** active = new double * [numberColumns];
+  CoinFactorizationDouble * pivotValue =
+    new CoinFactorizationDouble [numberColumns];
+  for (int k=0;k<numberColumns;k++)
+    region[k] = regions[k]->denseVector();
+  for (int i = numberRowsExtra_-1 ; i >= numberRows_; i-- ) {
+    int numberActive = 0;
+    for (int k=0;k<numberColumns;k++) {
+      CoinFactorizationDouble value = region[k][i];
+      //zero out  old permuted
+      region[k][i] = 0.0;
+      if ( value ) {
+	active[numberActive] = region[k];
+	pivotValue[numberActive++] = value;
+      }
+    }
+    if (!numberActive)
+      continue;
+    for (CoinBigIndex j = startColumn[i]; j < startColumn[i+1]; j++ ) {
+      CoinFactorizationDouble value = element[j];
+      int iRow = indexRow[j];
+      for (int a=0;a<numberActive;a++)
+	active[a][iRow] -= value * pivotValue[a];
+    }
+    int putRow = permute[i];
+    for (int a=0;a<numberActive;a++)
+      active[a][putRow] = pivotValue[a];
+  }
+  // we have lost indices
+  for (int k=0;k<numberColumns;k++)
+    regions[k]->setNumElements (numberRows_+1);
+  delete [] region;
+  delete [] active;
+  delete [] pivotValue;
+}
 // Updates part of column transpose (BTRANR) when sparse
 void 
 CoinFactorization::updateColumnTransposeRSparse 
-( CoinIndexedVector * regionSparse ) const
+( CoinIndexedVector * regionSparse, int * COIN_RESTRICT sparseWork ) const
 {
   double * COIN_RESTRICT region = regionSparse->denseVector (  );
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
@@ -1748,7 +2352,7 @@ CoinFactorization::updateColumnTransposeRSparse
   const int * permute = permute_.array();
     
   // we can use sparse_ as temporary array
-  int * COIN_RESTRICT spare = sparse_.array();
+  int * COIN_RESTRICT spare = sparseWork;
   for (int i=0;i<numberNonZero;i++) {
     spare[regionIndex[i]]=i;
   }
@@ -1788,22 +2392,23 @@ CoinFactorization::updateColumnTransposeRSparse
 
 //  updateColumnTransposeR.  Updates part of column (FTRANR)
 void
-CoinFactorization::updateColumnTransposeR ( CoinIndexedVector * regionSparse ) const
+CoinFactorization::updateColumnTransposeR ( CoinIndexedVector * regionSparse,
+					    int * COIN_RESTRICT sparseWork) const
 {
   if (numberRowsExtra_==numberRows_)
     return;
   int numberNonZero = regionSparse->getNumElements (  );
 
   if (numberNonZero) {
-    if (numberNonZero < (sparseThreshold_<<2)||(!numberL_&&sparse_.array())) {
-      updateColumnTransposeRSparse ( regionSparse );
-      if (collectStatistics_) 
+    if (numberNonZero < (sparseThreshold_<<2)||(!numberL_&&sparseWork)) {
+      updateColumnTransposeRSparse ( regionSparse, sparseWork );
+      if (collectStatistics_&&sparseWork==sparse_.array()) 
 	btranCountAfterR_ += regionSparse->getNumElements();
     } else {
       updateColumnTransposeRDensish ( regionSparse );
       // we have lost indices
       // make sure won't try and go sparse again
-      if (collectStatistics_) 
+      if (collectStatistics_&&sparseWork==sparse_.array()) 
 	btranCountAfterR_ += CoinMin((numberNonZero<<1),numberRows_);
       regionSparse->setNumElements (numberRows_+1);
     }
@@ -2157,6 +2762,10 @@ CoinFactorization::replaceRow ( int whichRow, int iNumberInRow,
 {
   if (!iNumberInRow)
     return 0;
+  // U changes so blocks no longer valid
+  supernodeU_.conditionalDelete();
+  elementUFloat_.conditionalDelete();
+  flushRowCopyU();
   int next = nextRow_.array()[whichRow];
   int * numberInRow = numberInRow_.array();
 #ifndef NDEBUG
@@ -2278,6 +2887,12 @@ CoinFactorization::emptyRows(int numberToEmpty, const int which[])
   int i;
   int * delRow = new int [maximumRowsExtra_];
   int * indexRowU = indexRowU_.array();
+  // patterns change so blocks no longer valid
+  supernodeL_.conditionalDelete();
+  supernodeU_.conditionalDelete();
+  elementLFloat_.conditionalDelete();
+  elementUFloat_.conditionalDelete();
+  flushRowCopyU();
 #ifndef NDEBUG
   CoinFactorizationDouble * pivotRegion = pivotRegion_.array();
 #endif
@@ -2552,8 +3167,8 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
   indexColumnU_.allocate(other.indexColumnU_, other.lengthAreaU_*CoinSizeofAsInt(int) );
   nextRow_.allocate(other.nextRow_,(other.maximumRowsExtra_ + 1)*CoinSizeofAsInt(int));
   lastRow_.allocate( other.lastRow_,(other.maximumRowsExtra_ + 1 )*CoinSizeofAsInt(int));
-  const CoinBigIndex * convertUOther = other.convertRowToColumnU_.array();
 #if COIN_ONE_ETA_COPY
+  const CoinBigIndex * convertUOther = other.convertRowToColumnU_.array();
   if (convertUOther) {
 #endif
     convertRowToColumnU_.allocate(other.convertRowToColumnU_, other.lengthAreaU_*CoinSizeofAsInt(CoinBigIndex) );
@@ -2567,6 +3182,12 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
     indexColumnL_.allocate(other.indexColumnL_, other.lengthAreaL_ );
     startRowL_.allocate(other.startRowL_,other.numberRows_+1);
   }
+  gutsOfCopyContents(other);
+}
+// Copies scalars and factorization arrays (space already there)
+void CoinFactorization::gutsOfCopyContents(const CoinFactorization &other)
+{
+  const CoinBigIndex * convertUOther = other.convertRowToColumnU_.array();
   numberTrials_ = other.numberTrials_;
   biggerDimension_ = other.biggerDimension_;
   relaxCheck_ = other.relaxCheck_;
@@ -2629,6 +3250,32 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
 
   numberDense_ = other.numberDense_;
   denseThreshold_=other.denseThreshold_;
+  supernodeThreshold_=other.supernodeThreshold_;
+  adaptiveSparse_=other.adaptiveSparse_;
+  mixedPrecision_=other.mixedPrecision_;
+  lazyRowCopyU_=other.lazyRowCopyU_;
+  numberPendingU_=other.numberPendingU_;
+  adaptiveRefactor_=other.adaptiveRefactor_;
+  refactorRecommended_=other.refactorRecommended_;
+  refactorWork_=other.refactorWork_;
+  updateWork_=other.updateWork_;
+  basisNorm_=other.basisNorm_;
+  largestBasisElement_=other.largestBasisElement_;
+  growthFactor_=other.growthFactor_;
+  reusePivotOrder_=other.reusePivotOrder_;
+  numberFollowed_=other.numberFollowed_;
+  numberPivotOrder_=other.numberPivotOrder_;
+  searchedElements_=other.searchedElements_;
+  pivotOrder_.allocate(other.pivotOrder_, 2*numberPivotOrder_*CoinSizeofAsInt(int));
+  if (numberPivotOrder_)
+    CoinMemcpyN(other.pivotOrder_.array(),2*numberPivotOrder_,pivotOrder_.array());
+  // blocks of R are not copied - later etas may be merged
+  blockSizeR_=other.blockSizeR_;
+  numberBlocksR_=0;
+  firstUnblockedR_=other.numberRowsExtra_;
+  numberThreads_=other.numberThreads_;
+  adaptiveRatioL_=other.adaptiveRatioL_;
+  reachInputL_=-1;
   if (numberDense_) {
     denseArea_ = new double [numberDense_*numberDense_];
     denseAreaAddress_ = denseArea_;
@@ -2726,6 +3373,77 @@ void CoinFactorization::gutsOfCopy(const CoinFactorization &other)
   if (other.sparseThreshold_) {
     goSparse();
   }
+  supernodeL_.conditionalDelete();
+  supernodeU_.conditionalDelete();
+  if (supernodeThreshold_&&!status_&&numberRows_)
+    findSupernodes();
+  elementLFloat_.conditionalDelete();
+  elementUFloat_.conditionalDelete();
+  if (other.elementLFloat_.array()&&!status_)
+    makeFloatFactors();
+}
+/* Gets arrays needed to hold a factorization with dimensions of
+   sizes - keeps own arrays if persistent and big enough */
+void CoinFactorization::getCopyAreas(const CoinFactorization &sizes,
+				     bool rowCopyU, bool extraR)
+{
+  elementU_.conditionalNew(sizes.lengthAreaU_);
+  indexRowU_.conditionalNew(sizes.lengthAreaU_);
+  indexColumnU_.conditionalNew(sizes.lengthAreaU_);
+  elementL_.conditionalNew(sizes.lengthAreaL_);
+  indexRowL_.conditionalNew(sizes.lengthAreaL_);
+  startColumnL_.conditionalNew(sizes.numberRows_ + 1);
+  int extraSpace = sizes.maximumPivots_ + 1;
+  if (extraR)
+    extraSpace += sizes.maximumColumnsExtra_ + 1;
+  startColumnR_.conditionalNew(extraSpace);
+  int numberRows = sizes.maximumRowsExtra_ + 1;
+  pivotRegion_.conditionalNew(numberRows);
+  permuteBack_.conditionalNew(numberRows);
+  permute_.conditionalNew(numberRows);
+  pivotColumnBack_.conditionalNew(numberRows);
+  firstCount_.conditionalNew(numberRows);
+  nextRow_.conditionalNew(numberRows);
+  lastRow_.conditionalNew(numberRows);
+  int numberColumns = sizes.maximumColumnsExtra_ + 1;
+  startColumnU_.conditionalNew(numberColumns);
+  numberInColumn_.conditionalNew(numberColumns);
+  pivotColumn_.conditionalNew(numberColumns);
+  nextColumn_.conditionalNew(numberColumns);
+  lastColumn_.conditionalNew(numberColumns);
+  if (rowCopyU) {
+    convertRowToColumnU_.conditionalNew(sizes.lengthAreaU_);
+    startRowU_.conditionalNew(numberRows);
+    numberInRow_.conditionalNew(numberRows);
+  } else {
+    convertRowToColumnU_.conditionalDelete();
+    startRowU_.conditionalDelete();
+    numberInRow_.conditionalDelete();
+  }
+  // not used after a copy
+  numberInColumnPlus_.conditionalDelete();
+  if (sizes.sparseThreshold_) {
+    elementByRowL_.conditionalNew(sizes.lengthAreaL_);
+    indexColumnL_.conditionalNew(sizes.lengthAreaL_);
+    startRowL_.conditionalNew(sizes.numberRows_ + 1);
+  }
+}
+/* Copies factorization of other (as operator =) but keeps own arrays
+   where big enough */
+void CoinFactorization::cloneFactorization(const CoinFactorization &other)
+{
+  if (this == &other)
+    return;
+  if (!persistenceFlag_)
+    setPersistenceFlag(1);
+  delete [] denseArea_;
+  denseArea_ = NULL;
+  denseAreaAddress_ = NULL;
+  delete [] densePermute_;
+  densePermute_ = NULL;
+  getCopyAreas(other,other.convertRowToColumnU_.array()!=NULL,
+	       other.numberInColumnPlus_.array()!=NULL);
+  gutsOfCopyContents(other);
 }
 // See if worth going sparse
 void 
@@ -2771,6 +3489,117 @@ CoinFactorization::conditionNumber() const
   condition = CoinMax(fabs(condition),1.0e-50);
   return 1.0/condition;
 }
+// Estimate of 1-norm condition number of basis
+double 
+CoinFactorization::conditionEstimate ( CoinIndexedVector * regionSparse,
+				       CoinIndexedVector * regionSparse2,
+				       int maximumIterations) const
+{
+  return basisNorm_ * inverseNormEstimate(regionSparse, regionSparse2,
+					  maximumIterations);
+}
+/* Estimate of 1-norm of inverse of basis - Hager's method with Higham's
+   refinements (as LAPACK dlacon).  Looks for the column of the inverse
+   with largest norm by alternating FTRAN and BTRAN */
+double 
+CoinFactorization::inverseNormEstimate ( CoinIndexedVector * regionSparse,
+					 CoinIndexedVector * regionSparse2,
+					 int maximumIterations) const
+{
+  int numberRows = numberRows_;
+  if (!numberRows)
+    return 0.0;
+  assert (!regionSparse2->getNumElements());
+  // works on dense values - empty so mode can just be changed
+  bool wasPacked = regionSparse2->packedMode();
+  regionSparse2->setPackedMode(false);
+  double * COIN_RESTRICT region = regionSparse2->denseVector();
+  int * COIN_RESTRICT index = regionSparse2->getIndices();
+  // signs of last B^-1 x (1 if negative)
+  char * sign = new char [numberRows];
+  CoinZeroN(sign, numberRows);
+  double estimate = 0.0;
+  int i;
+  // start with x = e/n
+  for (i=0;i<numberRows;i++) {
+    region[i] = 1.0/numberRows;
+    index[i] = i;
+  }
+  regionSparse2->setNumElements(numberRows);
+  int jLast = -1;
+  for (int iteration=0;iteration<maximumIterations;iteration++) {
+    // y = B^-1 x
+    updateColumn(regionSparse, regionSparse2);
+    int number = regionSparse2->getNumElements();
+    double norm = 0.0;
+    for (i=0;i<number;i++)
+      norm += fabs(region[index[i]]);
+    if (iteration&&norm<=estimate)
+      break; // no better
+    estimate = norm;
+    // x = sign(y) - stop if signs as last time
+    bool same = iteration>0;
+    for (i=0;i<numberRows;i++) {
+      char negative = region[i]<0.0 ? 1 : 0;
+      if (negative!=sign[i]) {
+	sign[i] = negative;
+	same = false;
+      }
+      region[i] = negative ? -1.0 : 1.0;
+      index[i] = i;
+    }
+    regionSparse2->setNumElements(numberRows);
+    if (same)
+      break;
+    // z = B^-T x
+    updateColumnTranspose(regionSparse, regionSparse2);
+    number = regionSparse2->getNumElements();
+    int jLargest = -1;
+    double largest = 0.0;
+    double zx = 0.0;
+    for (i=0;i<number;i++) {
+      int j = index[i];
+      double value = region[j];
+      zx += value;
+      if (fabs(value)>largest) {
+	largest = fabs(value);
+	jLargest = j;
+      }
+    }
+    // z'x for last x
+    if (jLast>=0)
+      zx = region[jLast];
+    else
+      zx /= numberRows;
+    regionSparse2->clear();
+    if (jLargest<0||largest<=zx||jLargest==jLast)
+      break; // at local maximum
+    // x = unit vector
+    jLast = jLargest;
+    region[jLast] = 1.0;
+    index[0] = jLast;
+    regionSparse2->setNumElements(1);
+  }
+  regionSparse2->clear();
+  delete [] sign;
+  // alternating vector catches some cases above misses
+  for (i=0;i<numberRows;i++) {
+    double value = 1.0;
+    if (numberRows>1)
+      value += static_cast<double>(i)/(numberRows-1);
+    region[i] = (i&1)!=0 ? -value : value;
+    index[i] = i;
+  }
+  regionSparse2->setNumElements(numberRows);
+  updateColumn(regionSparse, regionSparse2);
+  int number = regionSparse2->getNumElements();
+  double norm = 0.0;
+  for (i=0;i<number;i++)
+    norm += fabs(region[index[i]]);
+  regionSparse2->clear();
+  regionSparse2->setPackedMode(wasPacked);
+  return CoinMax(estimate, (2.0*norm)/(3.0*numberRows));
+}
 #ifdef ABC_USE_COIN_FACTORIZATION
 /* Checks if can replace one Column to basis,
    returns update alpha
@@ -2781,6 +3610,7 @@ CoinFactorization::checkReplacePart1 (  CoinIndexedVector * regionSparse,
 					int pivotRow)
 {
   assert (numberU_<=numberRowsExtra_);
+  flushRowCopyU();
   CoinBigIndex * COIN_RESTRICT startColumnU = startColumnU_.array();
   CoinFactorizationDouble * COIN_RESTRICT element;
   int * COIN_RESTRICT numberInRow = numberInRow_.array();
@@ -2815,7 +3645,7 @@ CoinFactorization::checkReplacePart1 (  CoinIndexedVector * regionSparse,
   }
   //do BTRAN - finding first one to use
   regionSparse->setNumElements ( numberNonZero );
-  updateColumnTransposeU ( regionSparse, smallestIndex );
+  updateColumnTransposeU ( regionSparse, smallestIndex, sparse_.array() );
   numberNonZero = regionSparse->getNumElements (  );
   CoinFactorizationDouble saveFromU = 0.0;
 
@@ -2846,6 +3676,7 @@ CoinFactorization::checkReplacePart1 (  CoinIndexedVector * regionSparse,
 					CoinIndexedVector * partialUpdate,
 					int pivotRow)
 {
+  flushRowCopyU();
   CoinFactorizationDouble * COIN_RESTRICT element;
   int * COIN_RESTRICT numberInRow = numberInRow_.array();
   int realPivotRow;
@@ -2878,7 +3709,7 @@ CoinFactorization::checkReplacePart1 (  CoinIndexedVector * regionSparse,
   }
   //do BTRAN - finding first one to use
   regionSparse->setNumElements ( numberNonZero );
-  updateColumnTransposeU ( regionSparse, smallestIndex );
+  updateColumnTransposeU ( regionSparse, smallestIndex, sparse_.array() );
   numberNonZero = regionSparse->getNumElements (  );
   CoinFactorizationDouble saveFromU = 0.0;
   double tolerance = zeroTolerance_;
@@ -3276,14 +4107,25 @@ CoinFactorization::updateColumnFTPart1 ( CoinIndexedVector & regionSparse2X)
   } else {
     startColumnU[maximumColumnsExtra_] = lengthAreaU_+1;
   }
-  assert (!regionSparse2->packedMode());
-  for (int j = 0; j < numberNonZero; j ++ ) {
-    int iRow = index[j];
-    double value = array[iRow];
-    array[iRow]=0.0;
-    iRow = permute[iRow];
-    region[iRow] = value;
-    regionIndex[j] = iRow;
+  if (regionSparse2->packedMode()) {
+    // answer will come back packed from part 2
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      double value = array[j];
+      array[j]=0.0;
+      iRow = permute[iRow];
+      region[iRow] = value;
+      regionIndex[j] = iRow;
+    }
+  } else {
+    for (int j = 0; j < numberNonZero; j ++ ) {
+      int iRow = index[j];
+      double value = array[iRow];
+      array[iRow]=0.0;
+      iRow = permute[iRow];
+      region[iRow] = value;
+      regionIndex[j] = iRow;
+    }
   }
   regionSparse->setNumElements ( numberNonZero );
   if (collectStatistics_) {
@@ -3292,7 +4134,7 @@ CoinFactorization::updateColumnFTPart1 ( CoinIndexedVector & regionSparse2X)
   }
   
   //  ******* L
-  updateColumnL ( regionSparse, regionIndex );
+  updateColumnL ( regionSparse, regionIndex, sparse_.array() );
   if (collectStatistics_) 
     ftranCountAfterL_ += regionSparse->getNumElements();
   //permute extra
@@ -3300,7 +4142,7 @@ CoinFactorization::updateColumnFTPart1 ( CoinIndexedVector & regionSparse2X)
   if ( doFT ) 
     updateColumnRFT ( regionSparse, regionIndex );
   else
-    updateColumnR ( regionSparse );
+    updateColumnR ( regionSparse, sparse_.array() );
   if (collectStatistics_) 
     ftranCountAfterR_ += regionSparse->getNumElements();
   deleteFakeVector(&regionSparse2X,regionSparse);
@@ -3317,7 +4159,7 @@ CoinFactorization::updateColumnFTPart2 ( CoinIndexedVector & regionSparse2X)
   CoinIndexedVector * regionSparse2 = &regionSparse2X;
   //  ******* U
   int * COIN_RESTRICT regionIndex = regionSparse->getIndices (  );
-  updateColumnU ( regionSparse, regionIndex);
+  updateColumnU ( regionSparse, regionIndex, sparse_.array());
   permuteBack(regionSparse,regionSparse2);
   deleteFakeVector(&regionSparse2X,regionSparse);
 }
@@ -0,0 +1,277 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "CoinError.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinNumberIO.hpp"
+#include "CoinFactorizationTrace.hpp"
+
+/*
+  Layout of a trace file.  Every line is one record.
+
+    COINFACTORIZATIONTRACE 1
+    MATRIX rows columns elements
+    C length            one per column followed by length lines of
+    row value
+    F numberBasic       followed by numberBasic lines of sequence
+    P sequenceIn sequenceOut
+    END
+*/
+namespace {
+const char *traceMagic = "COINFACTORIZATIONTRACE";
+const int traceVersion = 1;
+const int traceLine = 256;
+}
+
+CoinFactorizationTrace::CoinFactorizationTrace()
+  : matrix_()
+{
+}
+
+CoinFactorizationTrace::CoinFactorizationTrace(const CoinFactorizationTrace &rhs)
+  : matrix_(rhs.matrix_),
+    type_(rhs.type_),
+    first_(rhs.first_),
+    second_(rhs.second_),
+    basis_(rhs.basis_)
+{
+}
+
+CoinFactorizationTrace &
+CoinFactorizationTrace::operator=(const CoinFactorizationTrace &rhs)
+{
+  if (this != &rhs) {
+    matrix_ = rhs.matrix_;
+    type_ = rhs.type_;
+    first_ = rhs.first_;
+    second_ = rhs.second_;
+    basis_ = rhs.basis_;
+  }
+  return *this;
+}
+
+CoinFactorizationTrace::~CoinFactorizationTrace()
+{
+}
+
+// Sets matrix and clears events
+void CoinFactorizationTrace::setMatrix(const CoinPackedMatrix &matrix)
+{
+  if (matrix.isColOrdered()) {
+    matrix_ = matrix;
+  } else {
+    matrix_.setExtraGap(0.0);
+    matrix_.setExtraMajor(0.0);
+    matrix_.reverseOrderedCopyOf(matrix);
+  }
+  matrix_.removeGaps();
+  clearEvents();
+}
+
+void CoinFactorizationTrace::addFactorize(int numberBasic, const int *sequence)
+{
+  type_.push_back(static_cast<char>(factorizeEvent));
+  first_.push_back(numberBasic);
+  second_.push_back(static_cast<int>(basis_.size()));
+  basis_.insert(basis_.end(), sequence, sequence + numberBasic);
+}
+
+void CoinFactorizationTrace::addPivot(int sequenceIn, int sequenceOut)
+{
+  type_.push_back(static_cast<char>(pivotEvent));
+  first_.push_back(sequenceIn);
+  second_.push_back(sequenceOut);
+}
+
+void CoinFactorizationTrace::clearEvents()
+{
+  type_.clear();
+  first_.clear();
+  second_.clear();
+  basis_.clear();
+}
+
+int CoinFactorizationTrace::numberFactorizations() const
+{
+  int n = 0;
+  for (size_t i = 0; i < type_.size(); i++) {
+    if (type_[i] == factorizeEvent)
+      n++;
+  }
+  return n;
+}
+
+int CoinFactorizationTrace::writeTrace(const char *filename) const
+{
+  std::string name(filename);
+  CoinFileOutput::Compression compression = CoinFileOutput::COMPRESS_NONE;
+  size_t length = name.length();
+  if (length > 3 && name.compare(length - 3, 3, ".gz") == 0)
+    compression = CoinFileOutput::COMPRESS_GZIP;
+  else if (length > 4 && name.compare(length - 4, 4, ".bz2") == 0)
+    compression = CoinFileOutput::COMPRESS_BZIP2;
+  else if (length > 4 && name.compare(length - 4, 4, ".zst") == 0)
+    compression = CoinFileOutput::COMPRESS_ZSTD;
+  else if (length > 4 && name.compare(length - 4, 4, ".lz4") == 0)
+    compression = CoinFileOutput::COMPRESS_LZ4;
+  if (!CoinFileOutput::compressionSupported(compression))
+    compression = CoinFileOutput::COMPRESS_NONE;
+  CoinFileOutput *output = NULL;
+  try {
+    output = CoinFileOutput::create(name, compression);
+  } catch (CoinError &) {
+    output = NULL;
+  }
+  if (!output)
+    return -1;
+  char line[traceLine];
+  bool ok = true;
+  sprintf(line, "%s %d\n", traceMagic, traceVersion);
+  ok = ok && output->puts(line);
+  int numberColumns = matrix_.getNumCols();
+  sprintf(line, "MATRIX %d %d %d\n", matrix_.getNumRows(), numberColumns,
+    static_cast<int>(matrix_.getNumElements()));
+  ok = ok && output->puts(line);
+  const CoinBigIndex *columnStart = matrix_.getVectorStarts();
+  const int *columnLength = matrix_.getVectorLengths();
+  const int *row = matrix_.getIndices();
+  const double *element = matrix_.getElements();
+  for (int iColumn = 0; iColumn < numberColumns && ok; iColumn++) {
+    sprintf(line, "C %d\n", columnLength[iColumn]);
+    ok = output->puts(line);
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn] && ok; j++) {
+      int n = sprintf(line, "%d ", row[j]);
+      n += CoinFormatDouble(element[j], line + n);
+      line[n++] = '\n';
+      line[n] = '\0';
+      ok = output->puts(line);
+    }
+  }
+  for (size_t i = 0; i < type_.size() && ok; i++) {
+    if (type_[i] == factorizeEvent) {
+      sprintf(line, "F %d\n", first_[i]);
+      ok = output->puts(line);
+      const int *sequence = &basis_[0] + second_[i];
+      for (int k = 0; k < first_[i] && ok; k++) {
+        sprintf(line, "%d\n", sequence[k]);
+        ok = output->puts(line);
+      }
+    } else {
+      sprintf(line, "P %d %d\n", first_[i], second_[i]);
+      ok = output->puts(line);
+    }
+  }
+  ok = ok && output->puts("END\n");
+  delete output;
+  return ok ? 0 : -1;
+}
+
+int CoinFactorizationTrace::readTrace(const char *filename)
+{
+  CoinFileInput *input = NULL;
+  try {
+    input = CoinFileInput::create(filename);
+  } catch (CoinError &) {
+    input = NULL;
+  }
+  if (!input)
+    return -1;
+  clearEvents();
+  matrix_ = CoinPackedMatrix();
+  char line[traceLine];
+  char word[traceLine];
+  int version = 0;
+  int numberRows = -1;
+  int numberColumns = -1;
+  int numberElements = -1;
+  bool ok = input->gets(line, traceLine) != NULL
+    && sscanf(line, "%s %d", word, &version) == 2
+    && !strcmp(word, traceMagic) && version == traceVersion;
+  ok = ok && input->gets(line, traceLine) != NULL
+    && sscanf(line, "MATRIX %d %d %d", &numberRows, &numberColumns,
+	      &numberElements) == 3
+    && numberRows >= 0 && numberColumns >= 0 && numberElements >= 0;
+  int *row = NULL;
+  double *element = NULL;
+  CoinBigIndex *columnStart = NULL;
+  if (ok) {
+    row = new int[numberElements];
+    element = new double[numberElements];
+    columnStart = new CoinBigIndex[numberColumns + 1];
+    CoinBigIndex put = 0;
+    columnStart[0] = 0;
+    for (int iColumn = 0; iColumn < numberColumns && ok; iColumn++) {
+      int length = -1;
+      ok = input->gets(line, traceLine) != NULL
+        && sscanf(line, "C %d", &length) == 1
+        && length >= 0 && put + length <= numberElements;
+      for (int k = 0; k < length && ok; k++) {
+        char *end = NULL;
+        ok = input->gets(line, traceLine) != NULL;
+        if (ok) {
+          row[put] = static_cast<int>(strtol(line, &end, 10));
+          element[put] = CoinStrtod(end, &end);
+          ok = end != line && row[put] >= 0 && row[put] < numberRows;
+          put++;
+        }
+      }
+      columnStart[iColumn + 1] = put;
+    }
+    ok = ok && put == numberElements;
+  }
+  if (ok) {
+    // matrix takes over arrays (and sets pointers to NULL)
+    int *length = NULL;
+    matrix_.assignMatrix(true, numberRows, numberColumns, numberElements,
+      element, row, columnStart, length);
+  }
+  delete[] row;
+  delete[] element;
+  delete[] columnStart;
+  int numberVariables = numberRows + numberColumns;
+  bool gotEnd = false;
+  while (ok && !gotEnd) {
+    ok = input->gets(line, traceLine) != NULL;
+    if (!ok)
+      break;
+    int a = -1;
+    int b = -1;
+    if (line[0] == 'P') {
+      ok = sscanf(line + 1, "%d %d", &a, &b) == 2
+        && a >= 0 && a < numberVariables && b >= 0 && b < numberVariables;
+      if (ok)
+        addPivot(a, b);
+    } else if (line[0] == 'F') {
+      ok = sscanf(line + 1, "%d", &a) == 1 && a >= 0 && a <= numberRows;
+      int *sequence = ok ? new int[a + 1] : NULL;
+      for (int k = 0; k < a && ok; k++) {
+        ok = input->gets(line, traceLine) != NULL
+          && sscanf(line, "%d", sequence + k) == 1
+          && sequence[k] >= 0 && sequence[k] < numberVariables;
+      }
+      if (ok)
+        addFactorize(a, sequence);
+      delete[] sequence;
+    } else if (!strncmp(line, "END", 3)) {
+      gotEnd = true;
+    } else {
+      ok = false;
+    }
+  }
+  delete input;
+  if (!ok) {
+    clearEvents();
+    matrix_ = CoinPackedMatrix();
+    return -2;
+  }
+  return 0;
+}
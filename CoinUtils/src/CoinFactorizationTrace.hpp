@@ -0,0 +1,139 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinFactorizationTrace_H
+#define CoinFactorizationTrace_H
+
+#include <vector>
+
+#include "CoinTypes.hpp"
+#include "CoinPackedMatrix.hpp"
+
+/** Record of the bases a simplex code factorized and the pivots it did
+    between factorizations, so the same work can be replayed later against
+    any factorization class.
+
+    Variables are numbered as in Clp - columns are 0 to numberColumns-1
+    and the slack on row i is numberColumns+i.  A solver sets the matrix
+    once, then calls addFactorize with the basic variables each time it
+    factorizes and addPivot after each replaceColumn.  Only sequence numbers
+    are kept, the columns themselves come from the matrix.
+
+    Traces are written as text (with numbers which read back exactly) so
+    they can be compressed, edited and kept in a corpus.
+*/
+class CoinFactorizationTrace {
+public:
+  /// Types of event
+  enum eventType {
+    /// Factorize basis given by basic variables
+    factorizeEvent = 0,
+    /// One variable in, one out
+    pivotEvent = 1
+  };
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinFactorizationTrace();
+  /// Copy constructor
+  CoinFactorizationTrace(const CoinFactorizationTrace &rhs);
+  /// Assignment operator
+  CoinFactorizationTrace &operator=(const CoinFactorizationTrace &rhs);
+  /// Destructor
+  ~CoinFactorizationTrace();
+  //@}
+
+  /**@name Recording */
+  //@{
+  /// Sets matrix (a column ordered copy is kept) and clears events
+  void setMatrix(const CoinPackedMatrix &matrix);
+  /// Adds factorization of basis with numberBasic variables in sequence
+  void addFactorize(int numberBasic, const int *sequence);
+  /// Adds pivot where sequenceIn replaced sequenceOut
+  void addPivot(int sequenceIn, int sequenceOut);
+  /// Clears events but keeps matrix
+  void clearEvents();
+  //@}
+
+  /**@name Input and output */
+  //@{
+  /** Writes trace to file (compressed if name ends in .gz, .bz2, .zst or .lz4 and
+      that is supported).  Returns 0 if OK, -1 if file could not be
+      opened */
+  int writeTrace(const char *filename) const;
+  /** Reads trace written by writeTrace.  Returns 0 if OK, -1 if file
+      could not be opened and -2 if it is not a valid trace (when trace
+      is left empty) */
+  int readTrace(const char *filename);
+  //@}
+
+  /**@name Gets */
+  //@{
+  /// Column ordered matrix
+  inline const CoinPackedMatrix *matrix() const
+  {
+    return &matrix_;
+  }
+  /// Number of rows
+  inline int numberRows() const
+  {
+    return matrix_.getNumRows();
+  }
+  /// Number of columns (not counting slacks)
+  inline int numberColumns() const
+  {
+    return matrix_.getNumCols();
+  }
+  /// Number of events
+  inline int numberEvents() const
+  {
+    return static_cast<int>(type_.size());
+  }
+  /// Type of event i
+  inline eventType event(int i) const
+  {
+    return static_cast<eventType>(type_[i]);
+  }
+  /** For factorizeEvent number of basic variables, for pivotEvent
+      variable coming in */
+  inline int first(int i) const
+  {
+    return first_[i];
+  }
+  /** For factorizeEvent offset of basic variables in basis(), for
+      pivotEvent variable going out */
+  inline int second(int i) const
+  {
+    return second_[i];
+  }
+  /// Basic variables of all factorizeEvents one after another
+  inline const int *basis() const
+  {
+    return basis_.size() ? &basis_[0] : NULL;
+  }
+  /// Number of factorizeEvents
+  int numberFactorizations() const;
+  /// Number of pivotEvents
+  inline int numberPivots() const
+  {
+    return numberEvents() - numberFactorizations();
+  }
+  //@}
+
+private:
+  /// Matrix (column ordered, no gaps)
+  CoinPackedMatrix matrix_;
+  /// Type of each event
+  std::vector<char> type_;
+  /// First number for each event
+  std::vector<int> first_;
+  /// Second number for each event
+  std::vector<int> second_;
+  /// Basic variables
+  std::vector<int> basis_;
+};
+
+#endif
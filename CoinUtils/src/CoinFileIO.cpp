@@ -12,7 +12,9 @@
 
 #include "CoinError.hpp"
 #include "CoinHelperFunctions.hpp"
+#include "CoinThreadPool.hpp"
 
+#include <map>
 #include <vector>
 #include <cstring>
 
@@ -36,10 +38,61 @@ const char *CoinFileIOBase::getFileName () const
 //   for plain text and compressed files
 // ------------------------------------------------------
 
-// ------ Input for plain text ------
-
 #include <stdio.h>
 
+#if defined(HAVE_UNISTD_H) && defined(HAVE_SYS_STAT_H) && !defined(_MSC_VER)
+#define COIN_HAS_MMAP
+#endif
+
+#ifdef COIN_HAS_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Size of reads from files (more if storage prefers larger blocks)
+#define COIN_READ_BUFFER (64*1024)
+#define COIN_READ_BUFFER_MAX (1024*1024)
+
+// Tells system file will be read from start to end and returns size of
+// reads suited to the storage it is on
+static int coinSequentialFile (int fd)
+{
+  int size = COIN_READ_BUFFER;
+#ifdef COIN_HAS_MMAP
+  struct stat status;
+  if (fd >= 0 && !fstat (fd, &status) && status.st_blksize > 0) {
+    // a good number of preferred blocks at a time
+    long blocks = 16 * static_cast<long>(status.st_blksize);
+    if (blocks > COIN_READ_BUFFER_MAX)
+      blocks = COIN_READ_BUFFER_MAX;
+    if (blocks > size)
+      size = static_cast<int>(blocks);
+  }
+#ifdef POSIX_FADV_SEQUENTIAL
+  if (fd >= 0)
+    posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+  return size;
+}
+
+// Same for stream (before anything is read)
+static int coinSequentialFile (FILE *f)
+{
+#ifdef COIN_HAS_MMAP
+  int size = coinSequentialFile (fileno (f));
+#else
+  int size = COIN_READ_BUFFER;
+#endif
+  setvbuf (f, NULL, _IOFBF, size);
+  return size;
+}
+
+// ------ Input for plain text ------
+
 // This reads plain text files
 class CoinPlainFileInput: public CoinFileInput
 {
@@ -54,6 +107,7 @@ public:
         throw CoinError ("Could not open file for reading!", 
                          "CoinPlainFileInput", 
                          "CoinPlainFileInput");
+      coinSequentialFile (f_);
     } else {
       f_ = stdin;
     }
@@ -79,13 +133,185 @@ private:
   FILE *f_;
 };
 
+// ------ Input for plain text using memory mapping ------
+
+#ifdef COIN_HAS_MMAP
+// Size of part of file mapped at any one time
+#define COIN_MAP_WINDOW (64*1024*1024)
+
+// This reads plain text files by mapping a window of the file into memory
+// (privately so lines can be terminated in place).  getsInPlace then hands
+// out lines without copying.  The window slides forward so memory used
+// does not grow with size of file.
+class CoinMappedFileInput: public CoinFileInput
+{
+public:
+  CoinMappedFileInput (const std::string &fileName, int fd, off_t fileSize):
+    CoinFileInput (fileName), fd_ (fd), fileSize_ (fileSize), 
+    position_ (0), window_ (0), windowStart_ (0), windowLength_ (0)
+  {
+    readType_="plain";
+    long pageSize = sysconf(_SC_PAGESIZE);
+    pageSize_ = pageSize>0 ? pageSize : 4096;
+    coinSequentialFile (fd_);
+    mapWindow();
+  }
+
+  virtual ~CoinMappedFileInput ()
+  {
+    if (window_)
+      munmap (window_, windowLength_);
+    close (fd_);
+  }
+
+  /// True if file could be mapped
+  inline bool mapped () const
+  { return window_ != 0; }
+
+  virtual int read (void *buffer, int size)
+  {
+    char *dest = static_cast<char *>(buffer);
+    int r = 0;
+    while (r < size && position_ < fileSize_) {
+      ensureWindow ();
+      off_t amount = windowStart_ + windowLength_ - position_;
+      if (amount > size - r)
+	amount = size - r;
+      CoinMemcpyN (window_ + (position_ - windowStart_), 
+		   static_cast<int>(amount), dest + r);
+      r += static_cast<int>(amount);
+      position_ += amount;
+    }
+    return r;
+  }
+
+  virtual char *gets (char *buffer, int size)
+  {
+    if (size <= 1 || position_ >= fileSize_)
+      return 0;
+    int n = 0;
+    while (n < size - 1 && position_ < fileSize_) {
+      ensureWindow ();
+      char *start = window_ + (position_ - windowStart_);
+      off_t available = windowStart_ + windowLength_ - position_;
+      if (available > size - 1 - n)
+	available = size - 1 - n;
+      char *newline = static_cast<char *>(memchr (start, '\n', available));
+      int amount = newline ? static_cast<int>(newline - start + 1) 
+	: static_cast<int>(available);
+      CoinMemcpyN (start, amount, buffer + n);
+      n += amount;
+      position_ += amount;
+      if (newline)
+	break;
+    }
+    if (!n)
+      return 0;
+    buffer[n] = '\0';
+    return buffer;
+  }
+
+  virtual char *getsInPlace (char *buffer, int size)
+  {
+    if (position_ >= fileSize_)
+      return 0;
+    ensureWindow ();
+    char *start = window_ + (position_ - windowStart_);
+    off_t available = windowStart_ + windowLength_ - position_;
+    char *newline = static_cast<char *>(memchr (start, '\n', available));
+    if (!newline && windowStart_ + windowLength_ < fileSize_) {
+      // line goes past window - move window to start of line
+      mapWindow ();
+      ensureWindow ();
+      start = window_ + (position_ - windowStart_);
+      available = windowStart_ + windowLength_ - position_;
+      newline = static_cast<char *>(memchr (start, '\n', available));
+    }
+    if (newline && newline - start + 1 < size) {
+      *newline = '\0';
+      position_ += newline - start + 1;
+      return start;
+    }
+    // last line without newline or too long - copy as gets does
+    return gets (buffer, size);
+  }
+
+  // rest of window in place
+  virtual char *readChunk (size_t &length)
+  {
+    length = 0;
+    if (position_ >= fileSize_)
+      return 0;
+    ensureWindow ();
+    char *start = window_ + (position_ - windowStart_);
+    length = static_cast<size_t>(windowStart_ + windowLength_ - position_);
+    position_ += length;
+    return start;
+  }
+
+private:
+  // Maps window starting at page containing position_
+  void mapWindow ()
+  {
+    if (window_)
+      munmap (window_, windowLength_);
+    window_ = 0;
+    windowStart_ = position_ - position_ % pageSize_;
+    windowLength_ = fileSize_ - windowStart_;
+    if (windowLength_ > COIN_MAP_WINDOW)
+      windowLength_ = COIN_MAP_WINDOW;
+    void *address = mmap (0, windowLength_, PROT_READ | PROT_WRITE,
+			  MAP_PRIVATE, fd_, windowStart_);
+    if (address == MAP_FAILED) {
+      windowLength_ = 0;
+      return;
+    }
+    window_ = static_cast<char *>(address);
+#ifdef MADV_SEQUENTIAL
+    madvise (address, windowLength_, MADV_SEQUENTIAL);
+#endif
+  }
+
+  // Makes sure position_ is in window
+  void ensureWindow ()
+  {
+    if (position_ < windowStart_ || position_ >= windowStart_ + windowLength_)
+      mapWindow ();
+    if (!window_)
+      throw CoinError ("Could not map file for reading!", 
+		       "ensureWindow", 
+		       "CoinMappedFileInput");
+  }
+
+  int fd_;
+  off_t fileSize_;
+  off_t position_; // position in file of next character
+  char *window_;
+  off_t windowStart_;
+  off_t windowLength_;
+  off_t pageSize_;
+};
+#endif
+
 // ------ helper class supporting buffered gets -------
 
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+// Number of blocks decompressed ahead
+#define COIN_READ_AHEAD_BLOCKS 4
+// Size of each block
+#define COIN_READ_AHEAD_SIZE (1024*1024)
+#endif
+
 // This is a CoinFileInput class to handle cases, where the gets method
 // is not easy to implement (i.e. bzlib has no equivalent to gets, and
 // zlib's gzgets is extremely slow). It's subclasses only have to implement
 // the readRaw method, while the read and gets methods are handled by this
 // class using an internal buffer.
+// If a subclass calls startReadAhead (only with COINUTILS_PTHREADS) readRaw
+// is called on another thread which fills a ring of blocks while the
+// caller works on earlier ones.  The subclass must then call stopReadAhead
+// in its destructor before readRaw can no longer be used.
 class CoinGetslessFileInput: public CoinFileInput
 {
 public:
@@ -94,6 +320,9 @@ public:
     dataBuffer_ (8*1024), 
     dataStart_ (&dataBuffer_[0]), 
     dataEnd_ (&dataBuffer_[0])
+#ifdef COINUTILS_PTHREADS
+    , readAhead_ (false)
+#endif
   {}
 
   virtual ~CoinGetslessFileInput () {}
@@ -126,6 +355,23 @@ public:
 	r = amount;
       }
 
+#ifdef COINUTILS_PTHREADS
+    // Data is coming through blocks so take from them
+    if (readAhead_) {
+      while (size > 0 && fill () > 0) {
+	int amount = static_cast<int>(dataEnd_ - dataStart_);
+	if (amount > size)
+	  amount = size;
+	CoinMemcpyN (dataStart_, amount, dest);
+	dest += amount;
+	size -= amount;
+	dataStart_ += amount;
+	r += amount;
+      }
+      return r;
+    }
+#endif
+
     // If we require more data, use readRaw.
     // We don't use the buffer here, as readRaw is ecpected to be efficient.
     if (size > 0)
@@ -140,42 +386,42 @@ public:
       return 0;
 
     char *dest = buffer;
-    char *destLast = dest + size - 2; // last position allowed to be written
-
-    bool initiallyEmpty = (dataStart_ == dataEnd_);
+    int room = size - 1; // characters which may still be written
     
     for (;;)
       {
 	// refill dataBuffer if needed
 	if (dataStart_ == dataEnd_)
 	  {
-	    dataStart_ = dataEnd_ = &dataBuffer_[0];
-	    int count = readRaw (dataStart_, static_cast<int>(dataBuffer_.size ()));
-
 	    // at EOF?
-	    if (count <= 0) 
+	    if (fill () <= 0)
 	      {
 		*dest = 0;
-		// if it was initially empty we had nothing written and should 
-		// return 0, otherwise at least the buffer contents were
-		// transfered and buffer has to be returned.
-		return initiallyEmpty ? 0 : buffer;
+		// if nothing was written return 0, otherwise the
+		// buffer contents were transfered and buffer has to
+		// be returned.
+		return dest == buffer ? 0 : buffer;
 	      }
-
-	    dataEnd_ = dataStart_ + count;
 	  }
 
-	// copy character from buffer
-	*dest = *dataStart_++;
+	// copy up to and including \n
+	int amount = static_cast<int>(dataEnd_ - dataStart_);
+	if (amount > room)
+	  amount = room;
+	char *newline = static_cast<char *>(memchr (dataStart_, '\n', amount));
+	if (newline)
+	  amount = static_cast<int>(newline - dataStart_ + 1);
+	CoinMemcpyN (dataStart_, amount, dest);
+	dataStart_ += amount;
+	dest += amount;
+	room -= amount;
 
 	// terminate, if character was \n or bufferEnd was reached
-	if (*dest == '\n' || dest == destLast)
+	if (newline || !room)
 	  {
-	    *++dest = 0;
+	    *dest = 0;
 	    return buffer;
 	  }
-
-	++dest;
       } 
 
     // we should never reach this place
@@ -184,18 +430,251 @@ public:
 		     "CoinGetslessFileInput");
   }
 
+  // rest of buffer (or next one) in place
+  virtual char *readChunk (size_t &length)
+  {
+    length = 0;
+    if (dataStart_ == dataEnd_ && fill () <= 0)
+      return 0;
+    char *start = dataStart_;
+    length = static_cast<size_t>(dataEnd_ - dataStart_);
+    dataStart_ = dataEnd_;
+    return start;
+  }
+
 protected:
+  // Sets size of buffer (before anything is read)
+  void setBufferSize (int size)
+  {
+    dataBuffer_.resize (size);
+    dataStart_ = dataEnd_ = &dataBuffer_[0];
+  }
+
   // This should be implemented by the subclasses. It essentially behaves
   // like fread: the location pointed to by buffer should be filled with
   // size bytes. Return value is the number of bytes written (0 indicates EOF).
   virtual int readRaw (void *buffer, int size) = 0;
 
+#ifdef COINUTILS_PTHREADS
+  // Starts thread calling readRaw ahead of use.  If the thread can not
+  // be started readRaw is called as needed as before.
+  void startReadAhead ()
+  {
+    first_ = 0;
+    number_ = 0;
+    atEnd_ = false;
+    stop_ = false;
+    pthread_mutex_init (&mutex_, NULL);
+    pthread_cond_init (&condition_, NULL);
+    if (!pthread_create (&thread_, NULL, readAheadWorker, this)) {
+      readAhead_ = true;
+    } else {
+      pthread_mutex_destroy (&mutex_);
+      pthread_cond_destroy (&condition_);
+    }
+  }
+
+  // Stops thread (if running)
+  void stopReadAhead ()
+  {
+    if (readAhead_) {
+      pthread_mutex_lock (&mutex_);
+      stop_ = true;
+      pthread_cond_broadcast (&condition_);
+      pthread_mutex_unlock (&mutex_);
+      pthread_join (thread_, NULL);
+      pthread_mutex_destroy (&mutex_);
+      pthread_cond_destroy (&condition_);
+      readAhead_ = false;
+    }
+  }
+#endif
+
 private:
+  // Refills dataBuffer_ and returns number of characters in it (0 at EOF)
+  int fill ()
+  {
+    int count;
+#ifdef COINUTILS_PTHREADS
+    if (readAhead_) {
+      // swap next block filled by thread with our buffer
+      pthread_mutex_lock (&mutex_);
+      while (!number_ && !atEnd_)
+	pthread_cond_wait (&condition_, &mutex_);
+      count = 0;
+      if (number_) {
+	dataBuffer_.swap (block_[first_]);
+	count = blockSize_[first_];
+	first_ = (first_ + 1) % COIN_READ_AHEAD_BLOCKS;
+	number_--;
+	pthread_cond_broadcast (&condition_);
+      }
+      pthread_mutex_unlock (&mutex_);
+      dataStart_ = dataEnd_ = &dataBuffer_[0];
+      dataEnd_ += count;
+      return count;
+    }
+#endif
+    dataStart_ = dataEnd_ = &dataBuffer_[0];
+    count = readRaw (dataStart_, static_cast<int>(dataBuffer_.size ()));
+    if (count <= 0)
+      return 0;
+    dataEnd_ = dataStart_ + count;
+    return count;
+  }
+
+#ifdef COINUTILS_PTHREADS
+  // Fills free blocks until end of file or stopped
+  static void *readAheadWorker (void *info)
+  {
+    CoinGetslessFileInput *input = static_cast<CoinGetslessFileInput *>(info);
+    pthread_mutex_lock (&input->mutex_);
+    for (;;) {
+      while (input->number_ == COIN_READ_AHEAD_BLOCKS && !input->stop_)
+	pthread_cond_wait (&input->condition_, &input->mutex_);
+      if (input->stop_)
+	break;
+      int which = (input->first_ + input->number_) % COIN_READ_AHEAD_BLOCKS;
+      pthread_mutex_unlock (&input->mutex_);
+      // block is not touched by caller until number_ says so
+      std::vector<char> &block = input->block_[which];
+      block.resize (COIN_READ_AHEAD_SIZE);
+      int count = 0;
+      while (count < COIN_READ_AHEAD_SIZE) {
+	int n = input->readRaw (&block[count], COIN_READ_AHEAD_SIZE - count);
+	if (n <= 0)
+	  break;
+	count += n;
+      }
+      pthread_mutex_lock (&input->mutex_);
+      if (!count) {
+	input->atEnd_ = true;
+	pthread_cond_broadcast (&input->condition_);
+	break;
+      }
+      input->blockSize_[which] = count;
+      input->number_++;
+      pthread_cond_broadcast (&input->condition_);
+    }
+    pthread_mutex_unlock (&input->mutex_);
+    return NULL;
+  }
+#endif
+
   std::vector<char> dataBuffer_; // memory used for buffering 
   char *dataStart_; // pointer to currently buffered data
   char *dataEnd_; // pointer to "one behind last data element"
+#ifdef COINUTILS_PTHREADS
+  bool readAhead_; // true if thread is running
+  bool atEnd_; // thread has reached end of file
+  bool stop_; // thread should stop
+  std::vector<char> block_[COIN_READ_AHEAD_BLOCKS]; // ring of blocks
+  int blockSize_[COIN_READ_AHEAD_BLOCKS]; // characters in each block
+  int first_; // first filled block
+  int number_; // number of filled blocks
+  pthread_t thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;
+#endif
+};
+
+#ifdef COINUTILS_PTHREADS
+#if defined(COIN_HAS_ZLIB) || defined(COIN_HAS_BZLIB)
+
+// ------ decompressing pieces of a file on several threads -------
+
+// Compressed size aimed at for a piece
+#define COIN_DECODE_PIECE (256*1024)
+
+// Decompresses length characters at input into output.  False if
+// input is not valid.
+typedef bool (*CoinPieceDecode) (const char *input, int length,
+				 std::vector<char> &output);
+
+// Part of a file which can be decompressed on its own
+typedef struct {
+  const char *input;
+  int length;
+  std::vector<char> output;
+  CoinPieceDecode decode;
+  bool ok;
+} CoinInputPiece;
+
+static void coinDecodePiece (CoinInputPiece &piece)
+{
+  piece.ok = piece.decode (piece.input, piece.length, piece.output);
+}
+
+static void *coinDecodeWorker (void *info)
+{
+  coinDecodePiece (*static_cast<CoinInputPiece *>(info));
+  return NULL;
+}
+
+// Decompresses pieces - one task each
+static void coinDecodePieces (std::vector<CoinInputPiece> &pieces,
+			      int numberPieces)
+{
+  CoinThreadPool::run (coinDecodeWorker, &pieces[0], sizeof (CoinInputPiece),
+		       numberPieces);
+}
+
+// Hands out output of decoded pieces in order.  Subclasses fill pieces_.
+class CoinPieceReader
+{
+public:
+  CoinPieceReader (FILE *f, int numberThreads):
+    f_ (f), numberThreads_ (numberThreads), pieces_ (numberThreads),
+    numberPieces_ (0), whichPiece_ (0), position_ (0), atEnd_ (false)
+  {}
+
+  virtual ~CoinPieceReader () {}
+
+  // Same as readRaw
+  virtual int read (char *buffer, int size)
+  {
+    int r = 0;
+    while (r < size) {
+      if (whichPiece_ == numberPieces_) {
+	whichPiece_ = 0;
+	position_ = 0;
+	numberPieces_ = 0;
+	if (atEnd_ || !nextPieces ())
+	  break;
+	continue;
+      }
+      const std::vector<char> &output = pieces_[whichPiece_].output;
+      int amount = static_cast<int>(output.size () - position_);
+      if (amount > size - r)
+	amount = size - r;
+      if (amount)
+	CoinMemcpyN (&output[position_], amount, buffer + r);
+      r += amount;
+      position_ += amount;
+      if (position_ == output.size ()) {
+	whichPiece_++;
+	position_ = 0;
+      }
+    }
+    return r;
+  }
+
+protected:
+  // Sets numberPieces_ decoded pieces.  False if there are none.
+  virtual bool nextPieces () = 0;
+
+  FILE *f_;
+  int numberThreads_;
+  std::vector<CoinInputPiece> pieces_;
+  int numberPieces_;
+  int whichPiece_; // piece being handed out
+  size_t position_; // position in its output
+  bool atEnd_; // nothing more after current pieces
 };
 
+#endif
+#endif
+
 
 // -------- input for gzip compressed files -------
 
@@ -204,26 +683,265 @@ private:
 
 #include <zlib.h>
 
+#ifdef COINUTILS_PTHREADS
+
+// Enough of a gzip header to recognize BGZF
+#define COIN_BGZF_HEADER 18
+
+// Length of BGZF block (gzip member with size in extra field as
+// written by bgzip) starting at header or 0 if not one
+static int coinBgzfBlockLength (const unsigned char *header, int available)
+{
+  if (available < 12 || header[0] != 0x1f || header[1] != 0x8b ||
+      header[2] != 8 || !(header[3] & 4))
+    return 0;
+  int extraLength = header[10] | (header[11] << 8);
+  if (available < 12 + extraLength)
+    return 0;
+  const unsigned char *extra = header + 12;
+  int i = 0;
+  while (i + 4 <= extraLength) {
+    int fieldLength = extra[i + 2] | (extra[i + 3] << 8);
+    if (extra[i] == 'B' && extra[i + 1] == 'C' && fieldLength == 2 &&
+	i + 6 <= extraLength)
+      return (extra[i + 4] | (extra[i + 5] << 8)) + 1;
+    i += 4 + fieldLength;
+  }
+  return 0;
+}
+
+static unsigned int coinLittleEndian32 (const unsigned char *value)
+{
+  return value[0] | (value[1] << 8) | (value[2] << 16) |
+    (static_cast<unsigned int>(value[3]) << 24);
+}
+
+// Decompresses a run of BGZF blocks
+static bool coinDecodeBgzf (const char *input, int length,
+			    std::vector<char> &output)
+{
+  output.clear ();
+  z_stream stream;
+  memset (&stream, 0, sizeof (stream));
+  if (inflateInit2 (&stream, -15) != Z_OK)
+    return false;
+  const unsigned char *data = reinterpret_cast<const unsigned char *>(input);
+  bool ok = true;
+  int position = 0;
+  while (position < length) {
+    const unsigned char *block = data + position;
+    int blockLength = coinBgzfBlockLength (block, length - position);
+    int extraLength = block[10] | (block[11] << 8);
+    if (!blockLength || blockLength > length - position ||
+	blockLength < 20 + extraLength) {
+      ok = false;
+      break;
+    }
+    const unsigned char *trailer = block + blockLength - 8;
+    unsigned int crc = coinLittleEndian32 (trailer);
+    unsigned int size = coinLittleEndian32 (trailer + 4);
+    size_t start = output.size ();
+    // one spare so an empty block still has somewhere to point
+    output.resize (start + size + 1);
+    inflateReset (&stream);
+    stream.next_in = const_cast<Bytef *>(block + 12 + extraLength);
+    stream.avail_in = blockLength - 20 - extraLength;
+    stream.next_out = reinterpret_cast<Bytef *>(&output[start]);
+    stream.avail_out = size + 1;
+    if (inflate (&stream, Z_FINISH) != Z_STREAM_END ||
+	stream.total_out != size ||
+	crc32 (crc32 (0, Z_NULL, 0),
+	       reinterpret_cast<const Bytef *>(&output[start]), size) != crc) {
+      ok = false;
+      break;
+    }
+    output.resize (start + size);
+    position += blockLength;
+  }
+  inflateEnd (&stream);
+  return ok;
+}
+
+// Reads BGZF files a batch of blocks at a time, the blocks being
+// split among threads.
+class CoinBgzfReader: public CoinPieceReader
+{
+public:
+  CoinBgzfReader (FILE *f, int numberThreads):
+    CoinPieceReader (f, numberThreads)
+  {}
+
+  // True if file starts with BGZF block (file is left at start)
+  static bool isBgzf (FILE *f)
+  {
+    unsigned char header[COIN_BGZF_HEADER];
+    int count = static_cast<int>(fread (header, 1, COIN_BGZF_HEADER, f));
+    rewind (f);
+    return coinBgzfBlockLength (header, count) != 0;
+  }
+
+protected:
+  virtual bool nextPieces ()
+  {
+    input_.clear ();
+    std::vector<int> start (numberThreads_ + 1, 0);
+    while (numberPieces_ < numberThreads_) {
+      // read blocks until piece big enough
+      while (!atEnd_ && static_cast<int>(input_.size ()) -
+	     start[numberPieces_] < COIN_DECODE_PIECE) {
+	if (!readBlock ())
+	  atEnd_ = true;
+      }
+      if (static_cast<int>(input_.size ()) == start[numberPieces_])
+	break;
+      numberPieces_++;
+      start[numberPieces_] = static_cast<int>(input_.size ());
+    }
+    if (!numberPieces_)
+      return false;
+    for (int i = 0; i < numberPieces_; i++) {
+      CoinInputPiece &piece = pieces_[i];
+      piece.input = &input_[0] + start[i];
+      piece.length = start[i + 1] - start[i];
+      piece.decode = coinDecodeBgzf;
+    }
+    coinDecodePieces (pieces_, numberPieces_);
+    // hand out up to first bad piece
+    for (int i = 0; i < numberPieces_; i++) {
+      if (!pieces_[i].ok) {
+	numberPieces_ = i;
+	atEnd_ = true;
+      }
+    }
+    return true;
+  }
+
+private:
+  // Adds next block to input_.  False at end of file or if not a BGZF
+  // block (gzread would have failed on those too)
+  bool readBlock ()
+  {
+    size_t start = input_.size ();
+    input_.resize (start + 12);
+    if (fread (&input_[start], 1, 12, f_) != 12) {
+      input_.resize (start);
+      return false;
+    }
+    int extraLength = static_cast<unsigned char>(input_[start + 10]) |
+      (static_cast<unsigned char>(input_[start + 11]) << 8);
+    input_.resize (start + 12 + extraLength);
+    int blockLength = 0;
+    if (fread (&input_[start + 12], 1, extraLength, f_) ==
+	static_cast<size_t>(extraLength))
+      blockLength = coinBgzfBlockLength
+	(reinterpret_cast<unsigned char *>(&input_[start]), 12 + extraLength);
+    if (blockLength < 20 + extraLength) {
+      input_.resize (start);
+      return false;
+    }
+    int rest = blockLength - 12 - extraLength;
+    input_.resize (start + blockLength);
+    if (fread (&input_[start + 12 + extraLength], 1, rest, f_) !=
+	static_cast<size_t>(rest)) {
+      input_.resize (start);
+      return false;
+    }
+    return true;
+  }
+
+  std::vector<char> input_; // compressed blocks of batch
+};
+#endif
+
 // This class handles gzip'ed files using libz.
 // While zlib offers the gzread and gzgets functions which do all we want, 
 // the gzgets is _very_ slow as it gets single bytes via the complex gzread.
 // So we use the CoinGetslessFileInput as base.
+// With more than one thread decompression is done ahead of use and BGZF
+// files (gzip files made of independent blocks) are decompressed in
+// parallel.  Other gzip files can not be split as the size of a member is
+// not known until it is decompressed.
+// If given an open stream (from a CoinFileSource) it is read with
+// inflate as gzread needs a file descriptor.
 class CoinGzipFileInput: public CoinGetslessFileInput
 {
 public:
-  CoinGzipFileInput (const std::string &fileName):
-    CoinGetslessFileInput (fileName), gzf_ (0)
+  CoinGzipFileInput (const std::string &fileName, int numberThreads,
+		     FILE *file = 0):
+    CoinGetslessFileInput (fileName), gzf_ (0), f_ (file), inflating_ (false),
+    atEnd_ (false)
+#ifdef COINUTILS_PTHREADS
+    , bgzf_ (0)
+#endif
   {
     readType_="zlib";
-    gzf_ = gzopen (fileName.c_str (), "r");
-    if (gzf_ == 0)
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads > 1) {
+      if (!f_)
+	f_ = fopen (fileName.c_str (), "rb");
+      if (f_ && CoinBgzfReader::isBgzf (f_)) {
+	bgzf_ = new CoinBgzfReader (f_, numberThreads);
+      } else if (f_ && !file) {
+	fclose (f_);
+	f_ = 0;
+      }
+    }
+    if (!bgzf_) {
+#endif
+    if (file) {
+      memset (&stream_, 0, sizeof (stream_));
+      // gzip header and any number of members as gzread
+      inflating_ = inflateInit2 (&stream_, 16 + MAX_WBITS) == Z_OK;
+      input_.resize (COIN_READ_BUFFER);
+      setBufferSize (COIN_READ_BUFFER);
+    } else {
+#ifdef COIN_HAS_MMAP
+      int fd = open (fileName.c_str (), O_RDONLY);
+      int size = coinSequentialFile (fd);
+      if (fd >= 0) {
+	gzf_ = gzdopen (fd, "r");
+	if (gzf_ == 0)
+	  close (fd);
+      }
+#else
+      int size = COIN_READ_BUFFER;
+      gzf_ = gzopen (fileName.c_str (), "r");
+#endif
+#if ZLIB_VERNUM >= 0x1240
+      // zlib reads 8K at a time otherwise
+      if (gzf_ != 0)
+	gzbuffer (gzf_, size);
+#endif
+      setBufferSize (size);
+    }
+#ifdef COINUTILS_PTHREADS
+    }
+#endif
+    if (gzf_ == 0 && !inflating_ && !reader ()) {
+      if (f_ != 0)
+	fclose (f_);
       throw CoinError ("Could not open file for reading!", 
 		       "CoinGzipFileInput", 
 		       "CoinGzipFileInput");
+    }
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads > 1)
+      startReadAhead ();
+#else
+    (void) numberThreads;
+#endif
   }
 
   virtual ~CoinGzipFileInput ()
   {
+#ifdef COINUTILS_PTHREADS
+    stopReadAhead ();
+    delete bgzf_;
+#endif
+    if (inflating_)
+      inflateEnd (&stream_);
+    if (f_ != 0)
+      fclose (f_);
     if (gzf_ != 0)
       gzclose (gzf_);
   }
@@ -231,11 +949,61 @@ public:
 protected:
   virtual int readRaw (void *buffer, int size)
   {
+#ifdef COINUTILS_PTHREADS
+    if (bgzf_)
+      return bgzf_->read (static_cast<char *>(buffer), size);
+#endif
+    if (inflating_)
+      return inflateRaw (static_cast<char *>(buffer), size);
     return gzread (gzf_, buffer, size);
   }
 
 private:
+  // Same as readRaw but decompressing from f_
+  int inflateRaw (char *buffer, int size)
+  {
+    stream_.next_out = reinterpret_cast<Bytef *>(buffer);
+    stream_.avail_out = size;
+    while (stream_.avail_out && !atEnd_) {
+      if (!stream_.avail_in) {
+	size_t count = fread (&input_[0], 1, input_.size (), f_);
+	if (!count) {
+	  atEnd_ = true;
+	  break;
+	}
+	stream_.next_in = reinterpret_cast<Bytef *>(&input_[0]);
+	stream_.avail_in = static_cast<uInt>(count);
+      }
+      int returnCode = inflate (&stream_, Z_NO_FLUSH);
+      // another member may follow
+      if (returnCode == Z_STREAM_END)
+	inflateReset (&stream_);
+      // Error is treated as end of file (as gzread)
+      else if (returnCode != Z_OK)
+	atEnd_ = true;
+    }
+    return size - static_cast<int>(stream_.avail_out);
+  }
+
+  // True if reading through threaded reader
+  inline bool reader () const
+  {
+#ifdef COINUTILS_PTHREADS
+    return bgzf_ != 0;
+#else
+    return false;
+#endif
+  }
+
   gzFile gzf_;
+  FILE *f_;
+  z_stream stream_; // used if inflating_
+  std::vector<char> input_; // compressed data for stream_
+  bool inflating_; // decompressing from f_ with inflate
+  bool atEnd_; // nothing more to come out of stream_
+#ifdef COINUTILS_PTHREADS
+  CoinBgzfReader *bgzf_;
+#endif
 };
 
 #endif // COIN_HAS_ZLIB
@@ -247,30 +1015,276 @@ private:
 
 #include <bzlib.h>
 
-// This class handles files compressed by bzip2 using libbz.
-// As bzlib has no builtin gets, we use the CoinGetslessFileInput.
-class CoinBzip2FileInput: public CoinGetslessFileInput
-{
-public:
-  CoinBzip2FileInput (const std::string &fileName):
-    CoinGetslessFileInput (fileName), f_ (0), bzf_ (0)
-  {
-    int bzError = BZ_OK;
-    readType_="bzlib";
+#ifdef COINUTILS_PTHREADS
 
-    f_ = fopen (fileName.c_str (), "r");
-    
-    if (f_ != 0)
-      bzf_ = BZ2_bzReadOpen (&bzError, f_, 0, 0, 0, 0);
+// Each stream starts with "BZh", block size and block magic
+static const unsigned char coinBzip2Magic[10] =
+  {'B', 'Z', 'h', '9', 0x31, 0x41, 0x59, 0x26, 0x53, 0x59};
 
-    if (f_ == 0 || bzError != BZ_OK || bzf_ == 0)
-      throw CoinError ("Could not open file for reading!", 
+// If no stream starts within this much the file is read serially
+#define COIN_BZIP2_SERIAL (16*1024*1024)
+
+// Decompresses one or more complete bzip2 streams
+static bool coinDecodeBzip2 (const char *input, int length,
+			     std::vector<char> &output)
+{
+  output.clear ();
+  bz_stream stream;
+  bool ok = true;
+  int position = 0;
+  size_t used = 0;
+  while (ok && position < length) {
+    memset (&stream, 0, sizeof (stream));
+    if (BZ2_bzDecompressInit (&stream, 0, 0) != BZ_OK)
+      return false;
+    stream.next_in = const_cast<char *>(input + position);
+    stream.avail_in = length - position;
+    int returnCode = BZ_OK;
+    while (returnCode == BZ_OK) {
+      if (used == output.size ())
+	output.resize (CoinMax (static_cast<size_t>(4 * length),
+				2 * output.size ()));
+      stream.next_out = &output[used];
+      stream.avail_out = static_cast<unsigned int>(output.size () - used);
+      returnCode = BZ2_bzDecompress (&stream);
+      used = output.size () - stream.avail_out;
+      // out of input before end of stream
+      if (returnCode == BZ_OK && !stream.avail_in && stream.avail_out)
+	returnCode = BZ_UNEXPECTED_EOF;
+    }
+    if (returnCode != BZ_STREAM_END)
+      ok = false;
+    position = length - stream.avail_in;
+    BZ2_bzDecompressEnd (&stream);
+  }
+  output.resize (used);
+  return ok;
+}
+
+// Reads bzip2 files made of several streams (as written by parallel
+// bzip2 programs) by splitting at starts of streams and decompressing
+// pieces on threads.  A false start (the magic can occur inside a
+// stream) shows up as a failed piece which is tried again without that
+// cut.  If no stream starts are found the rest of the file is read on
+// this thread.
+class CoinBzip2Reader: public CoinPieceReader
+{
+public:
+  CoinBzip2Reader (FILE *f, int numberThreads):
+    CoinPieceReader (f, numberThreads),
+    input_ (COIN_DECODE_PIECE), inputLength_ (0), inputStart_ (0),
+    minimumCut_ (1), fileEnd_ (false), serial_ (false), streamActive_ (false)
+  {}
+
+  virtual ~CoinBzip2Reader ()
+  {
+    if (streamActive_)
+      BZ2_bzDecompressEnd (&stream_);
+  }
+
+  virtual int read (char *buffer, int size)
+  {
+    int r = CoinPieceReader::read (buffer, size);
+    if (serial_ && r < size)
+      r += readSerial (buffer + r, size - r);
+    return r;
+  }
+
+protected:
+  virtual bool nextPieces ()
+  {
+    int target = numberThreads_ * COIN_DECODE_PIECE;
+    for (;;) {
+      // read enough for a piece per thread
+      while (inputLength_ < target && !fileEnd_) {
+	if (static_cast<int>(input_.size ()) < target)
+	  input_.resize (target);
+	size_t n = fread (&input_[inputLength_], 1,
+			  input_.size () - inputLength_, f_);
+	if (!n)
+	  fileEnd_ = true;
+	inputLength_ += static_cast<int>(n);
+      }
+      if (!inputLength_) {
+	atEnd_ = true;
+	return false;
+      }
+      // cut at starts of streams
+      std::vector<int> start (1, 0);
+      for (int i = CoinMax (minimumCut_, COIN_DECODE_PIECE);
+	   i + 10 <= inputLength_; i++) {
+	if (static_cast<int>(start.size ()) > numberThreads_)
+	  break;
+	if (input_[i] != 'B')
+	  continue;
+	const unsigned char *test =
+	  reinterpret_cast<const unsigned char *>(&input_[i]);
+	if (test[1] == 'Z' && test[2] == 'h' && test[3] >= '1' &&
+	    test[3] <= '9' && !memcmp (test + 4, coinBzip2Magic + 4, 6)) {
+	  start.push_back (i);
+	  // next piece at least as big
+	  i += COIN_DECODE_PIECE - 1;
+	}
+      }
+      if (fileEnd_ && static_cast<int>(start.size ()) <= numberThreads_)
+	start.push_back (inputLength_);
+      int numberCuts = static_cast<int>(start.size ()) - 1;
+      if (!numberCuts) {
+	if (inputLength_ >= COIN_BZIP2_SERIAL) {
+	  // give up on splitting
+	  serial_ = true;
+	  atEnd_ = true;
+	  return false;
+	}
+	target = 2 * inputLength_;
+	continue;
+      }
+      numberPieces_ = numberCuts;
+      for (int i = 0; i < numberPieces_; i++) {
+	CoinInputPiece &piece = pieces_[i];
+	piece.input = &input_[0] + start[i];
+	piece.length = start[i + 1] - start[i];
+	piece.decode = coinDecodeBzip2;
+      }
+      coinDecodePieces (pieces_, numberPieces_);
+      int numberGood = 0;
+      while (numberGood < numberPieces_ && pieces_[numberGood].ok)
+	numberGood++;
+      int used = start[numberGood];
+      minimumCut_ = 1;
+      if (numberGood < numberPieces_) {
+	if (start[numberGood + 1] == inputLength_ && fileEnd_) {
+	  // bad data - hand out what was good (as BZ2_bzRead would)
+	  atEnd_ = true;
+	} else {
+	  // cut was inside a stream - try again without it
+	  minimumCut_ = start[numberGood + 1] - used + 1;
+	}
+	numberPieces_ = numberGood;
+      }
+      // move rest to start
+      inputLength_ -= used;
+      if (inputLength_)
+	memmove (&input_[0], &input_[used], inputLength_);
+      if (numberPieces_ || atEnd_)
+	return numberPieces_ > 0;
+      target = CoinMax (target, minimumCut_ + COIN_DECODE_PIECE);
+      if (inputLength_ >= COIN_BZIP2_SERIAL) {
+	serial_ = true;
+	atEnd_ = true;
+	return false;
+      }
+    }
+  }
+
+private:
+  // Decompresses rest of input_ and file on this thread
+  int readSerial (char *buffer, int size)
+  {
+    int r = 0;
+    while (r < size) {
+      if (inputStart_ == inputLength_) {
+	inputStart_ = 0;
+	inputLength_ = 0;
+	if (!fileEnd_)
+	  inputLength_ = static_cast<int>(fread (&input_[0], 1,
+						 input_.size (), f_));
+	if (!inputLength_) {
+	  fileEnd_ = true;
+	  break;
+	}
+      }
+      if (!streamActive_) {
+	memset (&stream_, 0, sizeof (stream_));
+	if (BZ2_bzDecompressInit (&stream_, 0, 0) != BZ_OK)
+	  break;
+	streamActive_ = true;
+      }
+      stream_.next_in = &input_[inputStart_];
+      stream_.avail_in = inputLength_ - inputStart_;
+      stream_.next_out = buffer + r;
+      stream_.avail_out = size - r;
+      int returnCode = BZ2_bzDecompress (&stream_);
+      inputStart_ = inputLength_ - stream_.avail_in;
+      r = size - stream_.avail_out;
+      if (returnCode != BZ_OK) {
+	BZ2_bzDecompressEnd (&stream_);
+	streamActive_ = false;
+	if (returnCode != BZ_STREAM_END) {
+	  // Error - treat as end of file
+	  inputStart_ = inputLength_ = 0;
+	  fileEnd_ = true;
+	  break;
+	}
+      }
+    }
+    return r;
+  }
+
+  std::vector<char> input_; // compressed data not yet used
+  int inputLength_;
+  int inputStart_; // used by readSerial
+  int minimumCut_; // first position a cut may be made
+  bool fileEnd_; // all of file is in input_
+  bool serial_; // reading on this thread
+  bool streamActive_; // stream_ is in use
+  bz_stream stream_;
+};
+#endif
+
+// This class handles files compressed by bzip2 using libbz.
+// As bzlib has no builtin gets, we use the CoinGetslessFileInput.
+// Files of several streams are read to the end.  With more than one
+// thread decompression is done ahead of use and such files are
+// decompressed in parallel.
+class CoinBzip2FileInput: public CoinGetslessFileInput
+{
+public:
+  CoinBzip2FileInput (const std::string &fileName, int numberThreads,
+		      FILE *file = 0):
+    CoinGetslessFileInput (fileName), f_ (0), bzf_ (0)
+#ifdef COINUTILS_PTHREADS
+    , reader_ (0)
+#endif
+  {
+    int bzError = BZ_OK;
+    readType_="bzlib";
+
+    f_ = file ? file : fopen (fileName.c_str (), "r");
+    if (f_ != 0)
+      setBufferSize (coinSequentialFile (f_));
+    
+#ifdef COINUTILS_PTHREADS
+    if (f_ != 0 && numberThreads > 1)
+      reader_ = new CoinBzip2Reader (f_, numberThreads);
+    else
+#endif
+    if (f_ != 0)
+      bzf_ = BZ2_bzReadOpen (&bzError, f_, 0, 0, 0, 0);
+
+    if (f_ == 0 || bzError != BZ_OK || (bzf_ == 0 && !reader ())) {
+      if (bzf_ != 0)
+	BZ2_bzReadClose (&bzError, bzf_);
+      if (f_ != 0)
+	fclose (f_);
+      throw CoinError ("Could not open file for reading!", 
 		       "CoinBzip2FileInput", 
 		       "CoinBzip2FileInput");
+    }
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads > 1)
+      startReadAhead ();
+#else
+    (void) numberThreads;
+#endif
   }
 
   virtual ~CoinBzip2FileInput ()
   {
+#ifdef COINUTILS_PTHREADS
+    stopReadAhead ();
+    delete reader_;
+#endif
     int bzError = BZ_OK;
     if (bzf_ != 0)
       BZ2_bzReadClose (&bzError, bzf_);
@@ -282,22 +1296,990 @@ public:
 protected:
   virtual int readRaw (void *buffer, int size)
   {
-    int bzError = BZ_OK;
-    int count = BZ2_bzRead (&bzError, bzf_, buffer, size);
-
-    if (bzError == BZ_OK || bzError == BZ_STREAM_END)
-      return count;
-    
-    // Error?
+#ifdef COINUTILS_PTHREADS
+    if (reader_)
+      return reader_->read (static_cast<char *>(buffer), size);
+#endif
+    while (bzf_) {
+      int bzError = BZ_OK;
+      int count = BZ2_bzRead (&bzError, bzf_, buffer, size);
+
+      if (bzError == BZ_OK)
+	return count;
+      if (bzError != BZ_STREAM_END)
+	return 0; // Error?
+      // another stream may follow
+      nextStream ();
+      if (count)
+	return count;
+    }
     return 0;
   }
 
 private:
+  // Closes finished stream and opens next one (if any)
+  void nextStream ()
+  {
+    int bzError = BZ_OK;
+    void *unused = 0;
+    int numberUnused = 0;
+    char saved[BZ_MAX_UNUSED];
+    BZ2_bzReadGetUnused (&bzError, bzf_, &unused, &numberUnused);
+    if (bzError == BZ_OK && numberUnused > 0)
+      memcpy (saved, unused, numberUnused);
+    else
+      numberUnused = 0;
+    BZ2_bzReadClose (&bzError, bzf_);
+    bzf_ = 0;
+    if (!numberUnused) {
+      int c = fgetc (f_);
+      if (c == EOF)
+	return;
+      ungetc (c, f_);
+    }
+    bzf_ = BZ2_bzReadOpen (&bzError, f_, 0, 0, saved, numberUnused);
+    if (bzError != BZ_OK) {
+      if (bzf_)
+	BZ2_bzReadClose (&bzError, bzf_);
+      bzf_ = 0;
+    }
+  }
+
+  // True if reading through threaded reader
+  inline bool reader () const
+  {
+#ifdef COINUTILS_PTHREADS
+    return reader_ != 0;
+#else
+    return false;
+#endif
+  }
+
   FILE *f_;
   BZFILE *bzf_;
+#ifdef COINUTILS_PTHREADS
+  CoinBzip2Reader *reader_;
+#endif
 };
 
-#endif // COIN_HAS_BZLIB
+#endif // COIN_HAS_BZLIB
+
+// ------- input for zstd compressed files ------
+
+#ifdef COIN_HAS_ZSTD
+
+#include <zstd.h>
+
+// This class handles zstd compressed files (of any number of frames)
+// using the streaming interface of libzstd.  With more than one thread
+// decompression is done ahead of use.
+class CoinZstdFileInput: public CoinGetslessFileInput
+{
+public:
+  CoinZstdFileInput (const std::string &fileName, int numberThreads,
+		     FILE *file = 0):
+    CoinGetslessFileInput (fileName), f_ (0), stream_ (0),
+    input_ (ZSTD_DStreamInSize ()), inputStart_ (0), inputEnd_ (0),
+    fileEnd_ (false), atEnd_ (false)
+  {
+    readType_="zstd";
+    f_ = file ? file : fopen (fileName.c_str (), "rb");
+    if (f_ != 0) {
+      size_t size = coinSequentialFile (f_);
+      setBufferSize (static_cast<int>(size));
+      if (size > input_.size ())
+	input_.resize (size);
+      stream_ = ZSTD_createDStream ();
+    }
+    if (f_ == 0 || stream_ == 0 || ZSTD_isError (ZSTD_initDStream (stream_))) {
+      if (stream_ != 0)
+	ZSTD_freeDStream (stream_);
+      if (f_ != 0)
+	fclose (f_);
+      throw CoinError ("Could not open file for reading!",
+		       "CoinZstdFileInput",
+		       "CoinZstdFileInput");
+    }
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads > 1)
+      startReadAhead ();
+#else
+    (void) numberThreads;
+#endif
+  }
+
+  virtual ~CoinZstdFileInput ()
+  {
+#ifdef COINUTILS_PTHREADS
+    stopReadAhead ();
+#endif
+    ZSTD_freeDStream (stream_);
+    fclose (f_);
+  }
+
+protected:
+  virtual int readRaw (void *buffer, int size)
+  {
+    ZSTD_outBuffer output = { buffer, static_cast<size_t>(size), 0 };
+    while (output.pos < output.size && !atEnd_) {
+      if (inputStart_ == inputEnd_ && !fileEnd_) {
+	inputStart_ = 0;
+	inputEnd_ = fread (&input_[0], 1, input_.size (), f_);
+	if (!inputEnd_)
+	  fileEnd_ = true;
+      }
+      ZSTD_inBuffer input = { &input_[inputStart_], inputEnd_ - inputStart_, 0 };
+      size_t before = output.pos;
+      size_t returnCode = ZSTD_decompressStream (stream_, &output, &input);
+      inputStart_ += input.pos;
+      // Error is treated as end of file (as for gzip and bzip2)
+      if (ZSTD_isError (returnCode) || (fileEnd_ && output.pos == before))
+	atEnd_ = true;
+    }
+    return static_cast<int>(output.pos);
+  }
+
+private:
+  FILE *f_;
+  ZSTD_DStream *stream_;
+  std::vector<char> input_; // compressed data
+  size_t inputStart_;
+  size_t inputEnd_;
+  bool fileEnd_; // all of file has been read
+  bool atEnd_; // nothing more to come out
+};
+
+#endif // COIN_HAS_ZSTD
+
+
+// ------- input for lz4 compressed files ------
+
+#ifdef COIN_HAS_LZ4
+
+#include <lz4frame.h>
+
+// Size of chunks read and written by lz4 classes
+#define COIN_LZ4_CHUNK (64*1024)
+
+// This class handles lz4 compressed files (frame format as written by the
+// lz4 program, any number of frames) using the lz4frame interface.  With
+// more than one thread decompression is done ahead of use.
+class CoinLz4FileInput: public CoinGetslessFileInput
+{
+public:
+  CoinLz4FileInput (const std::string &fileName, int numberThreads,
+		    FILE *file = 0):
+    CoinGetslessFileInput (fileName), f_ (0), context_ (0),
+    input_ (COIN_LZ4_CHUNK), inputStart_ (0), inputEnd_ (0),
+    fileEnd_ (false), atEnd_ (false)
+  {
+    readType_="lz4";
+    f_ = file ? file : fopen (fileName.c_str (), "rb");
+    if (f_ != 0) {
+      size_t size = coinSequentialFile (f_);
+      setBufferSize (static_cast<int>(size));
+      if (size > input_.size ())
+	input_.resize (size);
+    }
+    if (f_ == 0 ||
+	LZ4F_isError (LZ4F_createDecompressionContext (&context_,
+						       LZ4F_VERSION))) {
+      if (f_ != 0)
+	fclose (f_);
+      throw CoinError ("Could not open file for reading!",
+		       "CoinLz4FileInput",
+		       "CoinLz4FileInput");
+    }
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads > 1)
+      startReadAhead ();
+#else
+    (void) numberThreads;
+#endif
+  }
+
+  virtual ~CoinLz4FileInput ()
+  {
+#ifdef COINUTILS_PTHREADS
+    stopReadAhead ();
+#endif
+    LZ4F_freeDecompressionContext (context_);
+    fclose (f_);
+  }
+
+protected:
+  virtual int readRaw (void *buffer, int size)
+  {
+    char *output = static_cast<char *>(buffer);
+    int r = 0;
+    while (r < size && !atEnd_) {
+      if (inputStart_ == inputEnd_ && !fileEnd_) {
+	inputStart_ = 0;
+	inputEnd_ = fread (&input_[0], 1, input_.size (), f_);
+	if (!inputEnd_)
+	  fileEnd_ = true;
+      }
+      size_t inputSize = inputEnd_ - inputStart_;
+      size_t outputSize = size - r;
+      size_t returnCode = LZ4F_decompress (context_, output + r, &outputSize,
+					   &input_[inputStart_], &inputSize,
+					   NULL);
+      inputStart_ += inputSize;
+      r += static_cast<int>(outputSize);
+      // Error is treated as end of file (as for gzip and bzip2)
+      if (LZ4F_isError (returnCode) || (fileEnd_ && !outputSize))
+	atEnd_ = true;
+    }
+    return r;
+  }
+
+private:
+  FILE *f_;
+  LZ4F_decompressionContext_t context_;
+  std::vector<char> input_; // compressed data
+  size_t inputStart_;
+  size_t inputEnd_;
+  bool fileEnd_; // all of file has been read
+  bool atEnd_; // nothing more to come out
+};
+
+#endif // COIN_HAS_LZ4
+
+
+// ------- input from a CoinFileSource ------
+
+// Size of ranges asked for from a source
+#define COIN_SOURCE_RANGE (4*1024*1024)
+// Times a range is asked for before an error is taken as end of file
+#define COIN_SOURCE_TRIES 3
+
+// Range of a source (one task when asked for in parallel)
+typedef struct {
+  CoinFileSource *source;
+  CoinInt64 offset;
+  int length; // asked for
+  int count; // read
+  std::vector<char> data;
+} CoinSourceRange;
+
+static void *coinSourceWorker (void *info)
+{
+  CoinSourceRange *range = static_cast<CoinSourceRange *>(info);
+  range->data.resize (range->length);
+  range->count = 0;
+  int tries = 0;
+  while (range->count < range->length) {
+    int count = range->source->readRange (range->offset + range->count,
+					  &range->data[range->count],
+					  range->length - range->count);
+    if (count > 0) {
+      range->count += count;
+      tries = 0;
+    } else if (!count || ++tries == COIN_SOURCE_TRIES) {
+      break;
+    }
+  }
+  return NULL;
+}
+
+// Reads a source from start to end a batch of ranges at a time.  With
+// more than one thread (and size known) the ranges of a batch are asked
+// for in parallel, one task each.  Owns the source.
+class CoinSourceReader
+{
+public:
+  CoinSourceReader (CoinFileSource *source, int numberThreads):
+    source_ (source), size_ (source->size ()),
+    ranges_ (size_ >= 0 ? CoinMax (numberThreads, 1) : 1),
+    numberRanges_ (0), whichRange_ (0), position_ (0), offset_ (0),
+    current_ (0), atEnd_ (false)
+  {}
+
+  ~CoinSourceReader ()
+  {
+    delete source_;
+  }
+
+  // Same as readRaw
+  int read (char *buffer, int size)
+  {
+    int r = 0;
+    while (r < size) {
+      if (whichRange_ == numberRanges_ && !nextRanges ())
+	break;
+      const CoinSourceRange &range = ranges_[whichRange_];
+      int amount = CoinMin (range.count - position_, size - r);
+      if (amount)
+	CoinMemcpyN (&range.data[position_], amount, buffer + r);
+      r += amount;
+      position_ += amount;
+      if (position_ == range.count) {
+	whichRange_++;
+	position_ = 0;
+      }
+    }
+    current_ += r;
+    return r;
+  }
+
+  // Carries on from offset
+  void seek (CoinInt64 offset)
+  {
+    numberRanges_ = whichRange_ = position_ = 0;
+    offset_ = current_ = offset;
+    atEnd_ = false;
+  }
+
+  // Offset of next byte to be read
+  inline CoinInt64 position () const
+  { return current_;}
+
+  // Size of source (-1 if not known)
+  inline CoinInt64 size () const
+  { return size_;}
+
+private:
+  // Reads next batch of ranges.  False if there are none.
+  bool nextRanges ()
+  {
+    numberRanges_ = whichRange_ = position_ = 0;
+    int number = static_cast<int>(ranges_.size ());
+    while (!atEnd_ && numberRanges_ < number) {
+      CoinInt64 length = COIN_SOURCE_RANGE;
+      if (size_ >= 0 && size_ - offset_ < length)
+	length = size_ - offset_;
+      if (length <= 0) {
+	atEnd_ = true;
+	break;
+      }
+      CoinSourceRange &range = ranges_[numberRanges_++];
+      range.source = source_;
+      range.offset = offset_;
+      range.length = static_cast<int>(length);
+      offset_ += length;
+    }
+    if (!numberRanges_)
+      return false;
+    if (numberRanges_ > 1)
+      CoinThreadPool::run (coinSourceWorker, &ranges_[0],
+			   sizeof (CoinSourceRange), numberRanges_);
+    else
+      coinSourceWorker (&ranges_[0]);
+    // hand out up to end of first short range
+    for (int i = 0; i < numberRanges_; i++) {
+      if (ranges_[i].count < ranges_[i].length) {
+	numberRanges_ = i + 1;
+	atEnd_ = true;
+	break;
+      }
+    }
+    return true;
+  }
+
+  CoinFileSource *source_;
+  CoinInt64 size_;
+  std::vector<CoinSourceRange> ranges_;
+  int numberRanges_;
+  int whichRange_; // range being handed out
+  int position_; // position in its data
+  CoinInt64 offset_; // start of next range to be asked for
+  CoinInt64 current_; // offset of next byte handed out
+  bool atEnd_; // nothing more after current ranges
+};
+
+// Moves reader as fseek would.  Returns new offset or -1
+static CoinInt64 coinSourceSeek (void *cookie, CoinInt64 offset, int whence)
+{
+  CoinSourceReader *reader = static_cast<CoinSourceReader *>(cookie);
+  if (whence == SEEK_CUR) {
+    offset += reader->position ();
+  } else if (whence == SEEK_END) {
+    if (reader->size () < 0)
+      return -1;
+    offset += reader->size ();
+  }
+  if (offset < 0)
+    return -1;
+  if (offset != reader->position ())
+    reader->seek (offset);
+  return offset;
+}
+
+static int coinSourceClose (void *cookie)
+{
+  delete static_cast<CoinSourceReader *>(cookie);
+  return 0;
+}
+
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+#define COIN_SOURCE_STREAM
+static ssize_t coinSourceRead (void *cookie, char *buffer, size_t size)
+{
+  if (size > COIN_READ_BUFFER_MAX)
+    size = COIN_READ_BUFFER_MAX;
+  return static_cast<CoinSourceReader *>(cookie)->read
+    (buffer, static_cast<int>(size));
+}
+
+static int coinSourceSeek (void *cookie, off64_t *offset, int whence)
+{
+  CoinInt64 position = coinSourceSeek (cookie, *offset, whence);
+  if (position < 0)
+    return -1;
+  *offset = position;
+  return 0;
+}
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+  defined(__OpenBSD__) || defined(__DragonFly__)
+#define COIN_SOURCE_STREAM
+static int coinSourceRead (void *cookie, char *buffer, int size)
+{
+  return static_cast<CoinSourceReader *>(cookie)->read (buffer, size);
+}
+
+static fpos_t coinSourceSeek (void *cookie, fpos_t offset, int whence)
+{
+  return coinSourceSeek (cookie, static_cast<CoinInt64>(offset), whence);
+}
+#endif
+
+// Stream reading through reader so the classes for compressed files can
+// read from a source as from a file (0 if reading a file by name).
+// Closing the stream deletes reader.
+static FILE *coinSourceFile (CoinSourceReader *reader)
+{
+  if (!reader)
+    return 0;
+  FILE *f = 0;
+#ifdef COIN_SOURCE_STREAM
+#ifdef __GLIBC__
+  cookie_io_functions_t functions;
+  functions.read = coinSourceRead;
+  functions.write = NULL;
+  functions.seek = coinSourceSeek;
+  functions.close = coinSourceClose;
+  f = fopencookie (reader, "rb", functions);
+#else
+  f = funopen (reader, coinSourceRead, NULL, coinSourceSeek,
+	       coinSourceClose);
+#endif
+#endif
+  if (!f) {
+    delete reader;
+    throw CoinError ("Could not read compressed data from source "
+		     "(no fopencookie or funopen)!",
+		     "create",
+		     "CoinFileInput");
+  }
+  return f;
+}
+
+// This reads plain text from a CoinFileSource.  With more than one thread
+// ranges are asked for ahead of use.
+class CoinSourceFileInput: public CoinGetslessFileInput
+{
+public:
+  CoinSourceFileInput (const std::string &fileName, CoinSourceReader *reader,
+		       int numberThreads):
+    CoinGetslessFileInput (fileName), reader_ (reader)
+  {
+    readType_="source";
+    setBufferSize (COIN_READ_BUFFER);
+#ifdef COINUTILS_PTHREADS
+    if (numberThreads > 1)
+      startReadAhead ();
+#else
+    (void) numberThreads;
+#endif
+  }
+
+  virtual ~CoinSourceFileInput ()
+  {
+#ifdef COINUTILS_PTHREADS
+    stopReadAhead ();
+#endif
+    delete reader_;
+  }
+
+protected:
+  virtual int readRaw (void *buffer, int size)
+  {
+    return reader_->read (static_cast<char *>(buffer), size);
+  }
+
+private:
+  CoinSourceReader *reader_;
+};
+
+#ifdef COIN_HAS_MMAP
+// file://path - a local file read as a source
+class CoinLocalFileSource: public CoinFileSource
+{
+public:
+  CoinLocalFileSource (const std::string &fileName):
+    fd_ (open (fileName.c_str (), O_RDONLY)), size_ (-1)
+  {
+    struct stat status;
+    if (fd_ >= 0 && !fstat (fd_, &status) && S_ISREG (status.st_mode))
+      size_ = status.st_size;
+    if (size_ < 0) {
+      if (fd_ >= 0)
+	close (fd_);
+      throw CoinError ("Could not open file for reading!",
+		       "CoinLocalFileSource",
+		       "CoinLocalFileSource");
+    }
+  }
+
+  virtual ~CoinLocalFileSource ()
+  {
+    close (fd_);
+  }
+
+  virtual CoinInt64 size ()
+  {
+    return size_;
+  }
+
+  virtual int readRange (CoinInt64 offset, void *buffer, int size)
+  {
+    return static_cast<int>(pread (fd_, buffer, size,
+				   static_cast<off_t>(offset)));
+  }
+
+private:
+  int fd_;
+  CoinInt64 size_;
+};
+
+static CoinFileSource *coinOpenLocalSource (const std::string &name)
+{
+  return new CoinLocalFileSource (name.substr (7));
+}
+#endif
+
+#ifdef COIN_HAS_CURL
+
+#include <curl/curl.h>
+
+// What a GET of a range has put in the caller's buffer.  A server which
+// ignores the range sends all of the file so the part before is skipped.
+typedef struct {
+  CURL *handle;
+  char *buffer;
+  int size; // room in buffer
+  int count; // put in buffer
+  CoinInt64 skip; // still to be skipped if whole file is coming
+  bool started; // response code has been looked at
+} CoinCurlTransfer;
+
+static size_t coinCurlWrite (char *data, size_t size, size_t number,
+			     void *info)
+{
+  CoinCurlTransfer *transfer = static_cast<CoinCurlTransfer *>(info);
+  size_t length = size * number;
+  if (!transfer->started) {
+    transfer->started = true;
+    long response = 0;
+    curl_easy_getinfo (transfer->handle, CURLINFO_RESPONSE_CODE, &response);
+    // partial content is just the range asked for
+    if (response == 206)
+      transfer->skip = 0;
+  }
+  size_t used = 0;
+  if (transfer->skip) {
+    used = static_cast<size_t>(CoinMin (transfer->skip,
+					static_cast<CoinInt64>(length)));
+    transfer->skip -= used;
+  }
+  size_t amount = CoinMin (length - used, static_cast<size_t>
+			   (transfer->size - transfer->count));
+  if (amount)
+    memcpy (transfer->buffer + transfer->count, data + used, amount);
+  transfer->count += static_cast<int>(amount);
+  // less than length stops transfer (once buffer is full)
+  return used + amount;
+}
+
+// Picks size of file out of a Content-Range header
+static size_t coinCurlHeader (char *data, size_t size, size_t number,
+			      void *info)
+{
+  size_t length = size * number;
+  const char *name = "content-range:";
+  size_t i;
+  for (i = 0; name[i] && i < length; i++) {
+    if (tolower (static_cast<unsigned char>(data[i])) != name[i])
+      break;
+  }
+  if (!name[i]) {
+    std::string value (data + i, length - i);
+    size_t slash = value.find ('/');
+    if (slash != std::string::npos && value[slash + 1] != '*')
+      *static_cast<CoinInt64 *>(info) = strtoll (value.c_str () + slash + 1,
+						 NULL, 10);
+  }
+  return length;
+}
+
+#ifdef _MSC_VER
+#define coinCurlSeek _fseeki64
+#define coinCurlTell _ftelli64
+#else
+#define coinCurlSeek fseeko
+#define coinCurlTell ftello
+#endif
+
+// Copies all of a response into a FILE (server ignoring ranges)
+static size_t coinCurlSpool (char *data, size_t size, size_t number,
+			     void *info)
+{
+  return fwrite (data, size, number, static_cast<FILE *>(info)) * size;
+}
+
+// curl_global_init is not thread safe so is done when first source is
+// opened
+static void coinCurlInitialize ()
+{
+  static bool initialized = false;
+  if (!initialized) {
+    curl_global_init (CURL_GLOBAL_DEFAULT);
+    initialized = true;
+  }
+}
+
+// Reads http and https URLs with libcurl.  Each range is a GET with a
+// Range header.  Handles are kept for reuse so connections stay open.
+// The size is found by asking for the first byte (HEAD may not be allowed
+// by a presigned URL).  If that comes back as 200 with no Content-Range
+// the server ignores ranges, so rather than send all of the file for each
+// range the file is read once into a temporary file and ranges are read
+// from that.
+class CoinCurlSource: public CoinFileSource
+{
+public:
+  // signing is as for CURLOPT_AWS_SIGV4 (empty if not signed) with
+  // user as key:secret and token (if any) the session token
+  CoinCurlSource (const std::string &url, const std::string &signing,
+		  const std::string &user, const std::string &token):
+    url_ (url), signing_ (signing), user_ (user), headers_ (NULL), size_ (-1),
+    spool_ (NULL)
+  {
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_init (&mutex_, NULL);
+#endif
+    if (!token.empty ())
+      headers_ = curl_slist_append (headers_, ("x-amz-security-token: " +
+					       token).c_str ());
+    if (!signing.empty ())
+      headers_ = curl_slist_append (headers_,
+				    "x-amz-content-sha256: UNSIGNED-PAYLOAD");
+    CURL *handle = takeHandle ();
+    char byte;
+    CoinCurlTransfer transfer = { handle, &byte, 1, 0, 0, false };
+    CoinInt64 total = -1;
+    long response = 0;
+    CURLcode code = CURLE_FAILED_INIT;
+    if (handle) {
+      curl_easy_setopt (handle, CURLOPT_HEADERFUNCTION, coinCurlHeader);
+      curl_easy_setopt (handle, CURLOPT_HEADERDATA, &total);
+      code = get (0, transfer, response);
+      curl_easy_setopt (handle, CURLOPT_HEADERFUNCTION, NULL);
+      curl_easy_setopt (handle, CURLOPT_HEADERDATA, NULL);
+    }
+    if (response == 206) {
+      size_ = total;
+    } else if (response == 200) {
+      // whole file was coming - range ignored
+      spool_ = tmpfile ();
+      if (spool_) {
+	curl_easy_setopt (handle, CURLOPT_RANGE, NULL);
+	curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, coinCurlSpool);
+	curl_easy_setopt (handle, CURLOPT_WRITEDATA, spool_);
+	code = curl_easy_perform (handle);
+	curl_easy_getinfo (handle, CURLINFO_RESPONSE_CODE, &response);
+	curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, coinCurlWrite);
+	if (code == CURLE_OK && !fflush (spool_)) {
+	  coinCurlSeek (spool_, 0, SEEK_END);
+	  size_ = coinCurlTell (spool_);
+	}
+      }
+      if (size_ < 0) {
+	std::string text = "Could not read " + url + " (server ignores "
+	  "ranges and whole file could not be read into a temporary file)!";
+	giveBack (handle);
+	gutsOfDelete ();
+	throw CoinError (text, "CoinCurlSource", "CoinCurlSource");
+      }
+    } else if (response == 416) {
+      // nothing to give
+      size_ = 0;
+    }
+    giveBack (handle);
+    if (response != 416 && code != CURLE_OK && code != CURLE_WRITE_ERROR) {
+      char status[32];
+      sprintf (status, ", status %ld)!", response);
+      std::string text = "Could not open " + url + " for reading (" +
+	curl_easy_strerror (code) + status;
+      gutsOfDelete ();
+      throw CoinError (text, "CoinCurlSource", "CoinCurlSource");
+    }
+  }
+
+  virtual ~CoinCurlSource ()
+  {
+    gutsOfDelete ();
+  }
+
+  virtual CoinInt64 size ()
+  {
+    return size_;
+  }
+
+  virtual int readRange (CoinInt64 offset, void *buffer, int size)
+  {
+    if (spool_) {
+      if (offset >= size_)
+	return 0;
+#ifdef COINUTILS_PTHREADS
+      pthread_mutex_lock (&mutex_);
+#endif
+      int count = -1;
+      if (!coinCurlSeek (spool_, offset, SEEK_SET))
+	count = static_cast<int>(fread (buffer, 1, size, spool_));
+#ifdef COINUTILS_PTHREADS
+      pthread_mutex_unlock (&mutex_);
+#endif
+      return count;
+    }
+    CURL *handle = takeHandle ();
+    if (!handle)
+      return -1;
+    CoinCurlTransfer transfer = { handle, static_cast<char *>(buffer), size,
+				  0, offset, false };
+    long response = 0;
+    CURLcode code = get (offset, transfer, response);
+    giveBack (handle);
+    // asked for past end
+    if (response == 416)
+      return 0;
+    if (code == CURLE_OK ||
+	(code == CURLE_WRITE_ERROR && transfer.count == size))
+      return transfer.count;
+    return -1;
+  }
+
+private:
+  // GETs range from offset into transfer
+  CURLcode get (CoinInt64 offset, CoinCurlTransfer &transfer, long &response)
+  {
+    char range[64];
+    sprintf (range, "%lld-%lld", static_cast<long long>(offset),
+	     static_cast<long long>(offset + transfer.size - 1));
+    CURL *handle = transfer.handle;
+    curl_easy_setopt (handle, CURLOPT_RANGE, range);
+    curl_easy_setopt (handle, CURLOPT_WRITEDATA, &transfer);
+    CURLcode code = curl_easy_perform (handle);
+    response = 0;
+    curl_easy_getinfo (handle, CURLINFO_RESPONSE_CODE, &response);
+    return code;
+  }
+
+  // Idle handle or new one (0 if none can be made)
+  CURL *takeHandle ()
+  {
+    CURL *handle = NULL;
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_lock (&mutex_);
+#endif
+    if (!idle_.empty ()) {
+      handle = idle_.back ();
+      idle_.pop_back ();
+    }
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_unlock (&mutex_);
+#endif
+    if (!handle) {
+      handle = curl_easy_init ();
+      if (handle) {
+	curl_easy_setopt (handle, CURLOPT_URL, url_.c_str ());
+	curl_easy_setopt (handle, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt (handle, CURLOPT_FAILONERROR, 1L);
+	// ranges are read on several threads
+	curl_easy_setopt (handle, CURLOPT_NOSIGNAL, 1L);
+	// give up on a stalled connection (range is then tried again)
+	curl_easy_setopt (handle, CURLOPT_LOW_SPEED_LIMIT, 1L);
+	curl_easy_setopt (handle, CURLOPT_LOW_SPEED_TIME, 60L);
+	curl_easy_setopt (handle, CURLOPT_WRITEFUNCTION, coinCurlWrite);
+	if (headers_)
+	  curl_easy_setopt (handle, CURLOPT_HTTPHEADER, headers_);
+#if LIBCURL_VERSION_NUM >= 0x074b00
+	if (!signing_.empty ()) {
+	  curl_easy_setopt (handle, CURLOPT_AWS_SIGV4, signing_.c_str ());
+	  curl_easy_setopt (handle, CURLOPT_USERPWD, user_.c_str ());
+	}
+#endif
+      }
+    }
+    return handle;
+  }
+
+  // Keeps handle for next range
+  void giveBack (CURL *handle)
+  {
+    if (!handle)
+      return;
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_lock (&mutex_);
+#endif
+    idle_.push_back (handle);
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_unlock (&mutex_);
+#endif
+  }
+
+  void gutsOfDelete ()
+  {
+    for (size_t i = 0; i < idle_.size (); i++)
+      curl_easy_cleanup (idle_[i]);
+    curl_slist_free_all (headers_);
+    if (spool_)
+      fclose (spool_);
+#ifdef COINUTILS_PTHREADS
+    pthread_mutex_destroy (&mutex_);
+#endif
+  }
+
+  std::string url_;
+  std::string signing_;
+  std::string user_;
+  struct curl_slist *headers_;
+  CoinInt64 size_;
+  std::vector<CURL *> idle_; // handles not in use
+  FILE *spool_; // all of file if server ignores ranges
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_t mutex_;
+#endif
+};
+
+static CoinFileSource *coinOpenCurlSource (const std::string &name)
+{
+  coinCurlInitialize ();
+  return new CoinCurlSource (name, "", "", "");
+}
+
+// s3://bucket/key as path style URL at AWS_ENDPOINT_URL_S3 or
+// AWS_ENDPOINT_URL, or virtual hosted at amazonaws.com
+static CoinFileSource *coinOpenS3Source (const std::string &name)
+{
+  std::string path = name.substr (5);
+  size_t slash = path.find ('/');
+  if (slash == std::string::npos || !slash || slash + 1 == path.size ())
+    throw CoinError ("Name should be s3://bucket/key!",
+		     "create",
+		     "CoinFileInput");
+  std::string bucket = path.substr (0, slash);
+  std::string key = path.substr (slash + 1);
+  const char *value = getenv ("AWS_REGION");
+  if (!value)
+    value = getenv ("AWS_DEFAULT_REGION");
+  std::string region = value ? value : "us-east-1";
+  std::string url;
+  value = getenv ("AWS_ENDPOINT_URL_S3");
+  if (!value)
+    value = getenv ("AWS_ENDPOINT_URL");
+  if (value && *value) {
+    url = value;
+    if (url[url.size () - 1] != '/')
+      url += '/';
+    url += bucket + "/" + key;
+  } else {
+    url = "https://" + bucket + ".s3." + region + ".amazonaws.com/" + key;
+  }
+  std::string signing;
+  std::string user;
+  std::string token;
+  const char *id = getenv ("AWS_ACCESS_KEY_ID");
+  const char *secret = getenv ("AWS_SECRET_ACCESS_KEY");
+  if (id && secret) {
+#if LIBCURL_VERSION_NUM >= 0x074b00
+    signing = "aws:amz:" + region + ":s3";
+    user = std::string (id) + ":" + secret;
+    value = getenv ("AWS_SESSION_TOKEN");
+    if (value)
+      token = value;
+#else
+    throw CoinError ("Signed s3 requests need libcurl 7.75 or later!",
+		     "create",
+		     "CoinFileInput");
+#endif
+  }
+  coinCurlInitialize ();
+  return new CoinCurlSource (url, signing, user, token);
+}
+
+#endif // COIN_HAS_CURL
+
+// Open functions by scheme
+typedef std::map<std::string, CoinFileSourceOpen> CoinSourceMap;
+
+static CoinSourceMap &coinSources ()
+{
+  static CoinSourceMap sources;
+  static bool builtIn = false;
+  if (!builtIn) {
+    builtIn = true;
+#ifdef COIN_HAS_MMAP
+    sources["file"] = coinOpenLocalSource;
+#endif
+#ifdef COIN_HAS_CURL
+    sources["http"] = coinOpenCurlSource;
+    sources["https"] = coinOpenCurlSource;
+    sources["s3"] = coinOpenS3Source;
+#endif
+  }
+  return sources;
+}
+
+// Scheme (in lower case) if name is scheme://... otherwise empty.  One
+// letter would be a drive.
+static std::string coinSourceScheme (const std::string &name)
+{
+  size_t end = name.find ("://");
+  if (end == std::string::npos || end < 2)
+    return std::string ();
+  std::string scheme = name.substr (0, end);
+  for (size_t i = 0; i < end; i++) {
+    char c = scheme[i];
+    if (c >= 'A' && c <= 'Z')
+      scheme[i] = static_cast<char>(c - 'A' + 'a');
+    else if (!(c >= 'a' && c <= 'z') &&
+	     !(i && ((c >= '0' && c <= '9') || c == '+' || c == '-' ||
+		     c == '.')))
+      return std::string ();
+  }
+  return scheme;
+}
+
+// True if name has a registered scheme
+static bool coinIsSource (const std::string &name)
+{
+  std::string scheme = coinSourceScheme (name);
+  return !scheme.empty () && coinSources ().count (scheme);
+}
+
+// Opens source if name has a registered scheme (0 if not)
+static CoinFileSource *coinOpenSource (const std::string &name)
+{
+  if (!coinIsSource (name))
+    return 0;
+  CoinFileSource *source = coinSources ()[coinSourceScheme (name)] (name);
+  if (!source)
+    throw CoinError ("Could not open file for reading!",
+		     "create",
+		     "CoinFileInput");
+  return source;
+}
 
 
 // ----- implementation of CoinFileInput's methods
@@ -320,12 +2302,62 @@ bool CoinFileInput::haveBzip2Support() {
 #endif
 }
 
-CoinFileInput *CoinFileInput::create (const std::string &fileName)
+/// indicates whether CoinFileInput supports zstd compressed files
+bool CoinFileInput::haveZstdSupport() {
+#ifdef COIN_HAS_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// indicates whether CoinFileInput supports lz4 compressed files
+bool CoinFileInput::haveLz4Support() {
+#ifdef COIN_HAS_LZ4
+  return true;
+#else
+  return false;
+#endif
+}
+
+/// indicates whether http, https and s3 sources are built in
+bool CoinFileInput::haveCurlSupport() {
+#ifdef COIN_HAS_CURL
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CoinFileInput::registerSource (const std::string &scheme,
+				    CoinFileSourceOpen open)
+{
+  std::string key = coinSourceScheme (scheme + "://");
+  if (key.empty ())
+    throw CoinError ("Not a valid scheme!",
+		     "registerSource",
+		     "CoinFileInput");
+  if (open)
+    coinSources ()[key] = open;
+  else
+    coinSources ().erase (key);
+}
+
+CoinFileInput *CoinFileInput::create (const std::string &fileName,
+				      int numberThreads)
 {
   // first try to open file, and read first bytes 
   unsigned char header[4];
   size_t count ; // So stdin will be plain file
-  if (fileName!="stdin") {
+  CoinSourceReader *reader = 0;
+  CoinFileSource *source = coinOpenSource (fileName);
+  if (source) {
+    // remote file (or other source) - compressed data is read through
+    // a stream made by coinSourceFile
+    reader = new CoinSourceReader (source, numberThreads);
+    count = reader->read (reinterpret_cast<char *>(header), 4);
+    reader->seek (0);
+  } else if (fileName!="stdin") {
     FILE *f = fopen (fileName.c_str (), "r");
 
     if (f == 0)
@@ -342,8 +2374,10 @@ CoinFileInput *CoinFileInput::create (const std::string &fileName)
   if (count >= 2 && header[0] == 0x1f && header[1] == 0x8b)
     {
 #ifdef COIN_HAS_ZLIB
-      return new CoinGzipFileInput (fileName);
+      return new CoinGzipFileInput (fileName, numberThreads,
+				    coinSourceFile (reader));
 #else
+      delete reader;
       throw CoinError ("Cannot read gzip'ed file because zlib was "
 		       "not compiled into COIN!",
 		       "create",
@@ -355,8 +2389,10 @@ CoinFileInput *CoinFileInput::create (const std::string &fileName)
   if (count >= 3 && header[0] == 'B' && header[1] == 'Z' && header[2] == 'h')
     {
 #ifdef COIN_HAS_BZLIB
-      return new CoinBzip2FileInput (fileName);
+      return new CoinBzip2FileInput (fileName, numberThreads,
+				     coinSourceFile (reader));
 #else
+      delete reader;
       throw CoinError ("Cannot read bzip2'ed file because bzlib was "
 		       "not compiled into COIN!",
 		       "create",
@@ -364,16 +2400,103 @@ CoinFileInput *CoinFileInput::create (const std::string &fileName)
 #endif
     }
 
+  // zstd frames start with 0x28 0xb5 0x2f 0xfd
+  if (count >= 4 && header[0] == 0x28 && header[1] == 0xb5 &&
+      header[2] == 0x2f && header[3] == 0xfd)
+    {
+#ifdef COIN_HAS_ZSTD
+      return new CoinZstdFileInput (fileName, numberThreads,
+				    coinSourceFile (reader));
+#else
+      delete reader;
+      throw CoinError ("Cannot read zstd compressed file because zstd was "
+		       "not compiled into COIN!",
+		       "create",
+		       "CoinFileInput");
+#endif
+    }
+
+  // lz4 frames start with 0x04 0x22 0x4d 0x18
+  if (count >= 4 && header[0] == 0x04 && header[1] == 0x22 &&
+      header[2] == 0x4d && header[3] == 0x18)
+    {
+#ifdef COIN_HAS_LZ4
+      return new CoinLz4FileInput (fileName, numberThreads,
+				   coinSourceFile (reader));
+#else
+      delete reader;
+      throw CoinError ("Cannot read lz4 compressed file because lz4 was "
+		       "not compiled into COIN!",
+		       "create",
+		       "CoinFileInput");
+#endif
+    }
+
+  if (reader)
+    return new CoinSourceFileInput (fileName, reader, numberThreads);
+
+#ifdef COIN_HAS_MMAP
+  // plain regular file - map if possible
+  if (fileName!="stdin") {
+    int fd = open (fileName.c_str (), O_RDONLY);
+    struct stat status;
+    if (fd >= 0 && !fstat (fd, &status) && S_ISREG (status.st_mode) &&
+	status.st_size > 0) {
+      CoinMappedFileInput *input = 
+	new CoinMappedFileInput (fileName, fd, status.st_size);
+      if (input->mapped ())
+	return input;
+      // destructor closes file
+      delete input;
+    } else if (fd >= 0) {
+      close (fd);
+    }
+  }
+#endif
+
   // fallback: probably plain text file
   return new CoinPlainFileInput (fileName);
 }
 
 CoinFileInput::CoinFileInput (const std::string &fileName): 
-  CoinFileIOBase (fileName)
+  CoinFileIOBase (fileName), chunk_ (0)
 {}
 
 CoinFileInput::~CoinFileInput () 
-{}
+{
+  delete [] chunk_;
+}
+
+size_t CoinFileInput::readLarge (void *buffer, size_t size)
+{
+  char *dest = static_cast<char *>(buffer);
+  size_t done = 0;
+  while (done < size) {
+    // in pieces read can take
+    size_t piece = size - done;
+    if (piece > COIN_READ_BUFFER_MAX)
+      piece = COIN_READ_BUFFER_MAX;
+    int count = read (dest + done, static_cast<int>(piece));
+    if (count <= 0)
+      break;
+    done += count;
+  }
+  return done;
+}
+
+char *CoinFileInput::readChunk (size_t &length)
+{
+  if (!chunk_)
+    chunk_ = new char [COIN_READ_BUFFER];
+  int count = read (chunk_, COIN_READ_BUFFER);
+  length = count > 0 ? count : 0;
+  return length ? chunk_ : 0;
+}
+
+char *CoinFileInput::getsInPlace (char *buffer, int size)
+{
+  return gets (buffer, size);
+}
 
 
 // ------------------------------------------------------
@@ -404,19 +2527,37 @@ public:
 
   virtual ~CoinPlainFileOutput () 
   {
-    if (f_ != 0 && f_ != stdout)
-      fclose (f_);
+    close ();
   }
 
   virtual int write (const void *buffer, int size)
   {
+    if (f_ == 0)
+      return 0;
     return static_cast<int>(fwrite (buffer, 1, size, f_));
   }
 
   // we have something better than the default implementation
   virtual bool puts (const char *s)
   {
-    return fputs (s, f_) >= 0;
+    return f_ != 0 && fputs (s, f_) >= 0;
+  }
+
+  virtual bool flush ()
+  {
+    return f_ != 0 && fflush (f_) == 0;
+  }
+
+  // stdout is only flushed
+  virtual bool close ()
+  {
+    if (f_ == 0)
+      return true;
+    bool ok = flush ();
+    if (f_ != stdout && fclose (f_) != 0)
+      ok = false;
+    f_ = 0;
+    return ok;
   }
 
 private:
@@ -446,14 +2587,30 @@ public:
 
   virtual ~CoinGzipFileOutput () 
   {
-    if (gzf_ != 0)
-      gzclose (gzf_);
+    close ();
   }
 
   virtual int write (const void * buffer, int size)
   {
+    if (gzf_ == 0)
+      return 0;
     return gzwrite (gzf_, const_cast<void *> (buffer), size);
   }
+
+  // Z_SYNC_FLUSH so that everything so far can be decompressed
+  virtual bool flush ()
+  {
+    return gzf_ != 0 && gzflush (gzf_, Z_SYNC_FLUSH) == Z_OK;
+  }
+
+  virtual bool close ()
+  {
+    if (gzf_ == 0)
+      return true;
+    bool ok = gzclose (gzf_) == Z_OK;
+    gzf_ = 0;
+    return ok;
+  }
   
   // as zlib's gzputs is no more clever than our own, there's
   // no need to replace the default.
@@ -499,20 +2656,37 @@ public:
 
   virtual ~CoinBzip2FileOutput () 
   {
-    int bzError = BZ_OK;
-    if (bzf_ != 0)
-      BZ2_bzWriteClose (&bzError, bzf_, 0, 0, 0);
-
-    if (f_ != 0)
-      fclose (f_);
+    close ();
   }
 
   virtual int write (const void *buffer, int size)
   {
+    if (bzf_ == 0)
+      return 0;
     int bzError = BZ_OK;
     BZ2_bzWrite (&bzError, bzf_, const_cast<void *> (buffer), size);
     return (bzError == BZ_OK) ? size : 0;
   }
+
+  // bzlib cannot end a block early, so only what is compressed is pushed out
+  virtual bool flush ()
+  {
+    return f_ != 0 && fflush (f_) == 0;
+  }
+
+  virtual bool close ()
+  {
+    if (f_ == 0)
+      return true;
+    int bzError = BZ_OK;
+    BZ2_bzWriteClose (&bzError, bzf_, 0, 0, 0);
+    bool ok = bzError == BZ_OK;
+    if (fclose (f_) != 0)
+      ok = false;
+    f_ = 0;
+    bzf_ = 0;
+    return ok;
+  }
   
 private:
   FILE *f_;
@@ -521,6 +2695,342 @@ private:
 
 #endif // COIN_HAS_BZLIB
 
+// ------- CoinZstdFileOutput -------
+
+#ifdef COIN_HAS_ZSTD
+
+// no need to include the header, as this was done for the input class
+
+// Output with zstd compression.  Several threads compress if asked for
+// and the zstd library was built with threads.
+class CoinZstdFileOutput: public CoinFileOutput
+{
+public:
+  CoinZstdFileOutput (const std::string &fileName, int numberThreads):
+    CoinFileOutput (fileName), f_ (0), context_ (0),
+    output_ (ZSTD_CStreamOutSize ())
+  {
+    f_ = fopen (fileName.c_str (), "wb");
+    if (f_ != 0)
+      context_ = ZSTD_createCCtx ();
+    if (f_ == 0 || context_ == 0) {
+      if (f_ != 0)
+	fclose (f_);
+      throw CoinError ("Could not open file for writing!",
+		       "CoinZstdFileOutput",
+		       "CoinZstdFileOutput");
+    }
+    ZSTD_CCtx_setParameter (context_, ZSTD_c_compressionLevel,
+			    ZSTD_CLEVEL_DEFAULT);
+    // fails harmlessly if library has no threads
+    if (numberThreads > 1)
+      ZSTD_CCtx_setParameter (context_, ZSTD_c_nbWorkers, numberThreads);
+  }
+
+  virtual ~CoinZstdFileOutput ()
+  {
+    close ();
+  }
+
+  virtual int write (const void *buffer, int size)
+  {
+    if (f_ == 0)
+      return 0;
+    ZSTD_inBuffer input = { buffer, static_cast<size_t>(size), 0 };
+    return compress (input, ZSTD_e_continue) ? size : 0;
+  }
+
+  virtual bool flush ()
+  {
+    ZSTD_inBuffer input = { NULL, 0, 0 };
+    return f_ != 0 && compress (input, ZSTD_e_flush) && fflush (f_) == 0;
+  }
+
+  virtual bool close ()
+  {
+    if (f_ == 0)
+      return true;
+    ZSTD_inBuffer input = { NULL, 0, 0 };
+    bool ok = compress (input, ZSTD_e_end);
+    ZSTD_freeCCtx (context_);
+    if (fclose (f_) != 0)
+      ok = false;
+    f_ = 0;
+    context_ = 0;
+    return ok;
+  }
+
+private:
+  // Compresses all of input (and all held back if flushing or ending)
+  bool compress (ZSTD_inBuffer &input, ZSTD_EndDirective mode)
+  {
+    for (;;) {
+      ZSTD_outBuffer output = { &output_[0], output_.size (), 0 };
+      size_t returnCode = ZSTD_compressStream2 (context_, &output, &input,
+						mode);
+      if (ZSTD_isError (returnCode) ||
+	  fwrite (&output_[0], 1, output.pos, f_) != output.pos)
+	return false;
+      if (mode == ZSTD_e_continue ? input.pos == input.size : !returnCode)
+	return true;
+    }
+  }
+
+  FILE *f_;
+  ZSTD_CCtx *context_;
+  std::vector<char> output_;
+};
+
+#endif // COIN_HAS_ZSTD
+
+
+// ------- CoinLz4FileOutput -------
+
+#ifdef COIN_HAS_LZ4
+
+// Output with lz4 compression (frame format)
+class CoinLz4FileOutput: public CoinFileOutput
+{
+public:
+  CoinLz4FileOutput (const std::string &fileName):
+    CoinFileOutput (fileName), f_ (0), context_ (0),
+    output_ (LZ4F_compressBound (COIN_LZ4_CHUNK, NULL))
+  {
+    f_ = fopen (fileName.c_str (), "wb");
+    if (f_ == 0 ||
+	LZ4F_isError (LZ4F_createCompressionContext (&context_,
+						     LZ4F_VERSION))) {
+      if (f_ != 0)
+	fclose (f_);
+      throw CoinError ("Could not open file for writing!",
+		       "CoinLz4FileOutput",
+		       "CoinLz4FileOutput");
+    }
+    size_t length = LZ4F_compressBegin (context_, &output_[0],
+					output_.size (), NULL);
+    if (!LZ4F_isError (length))
+      fwrite (&output_[0], 1, length, f_);
+  }
+
+  virtual ~CoinLz4FileOutput ()
+  {
+    close ();
+  }
+
+  virtual int write (const void *buffer, int size)
+  {
+    if (f_ == 0)
+      return 0;
+    const char *input = static_cast<const char *>(buffer);
+    for (int done = 0; done < size; done += COIN_LZ4_CHUNK) {
+      size_t length = LZ4F_compressUpdate (context_, &output_[0],
+					   output_.size (), input + done,
+					   CoinMin (size - done, COIN_LZ4_CHUNK),
+					   NULL);
+      if (LZ4F_isError (length) ||
+	  fwrite (&output_[0], 1, length, f_) != length)
+	return 0;
+    }
+    return size;
+  }
+
+  virtual bool flush ()
+  {
+    if (f_ == 0)
+      return false;
+    size_t length = LZ4F_flush (context_, &output_[0], output_.size (), NULL);
+    return !LZ4F_isError (length) &&
+      fwrite (&output_[0], 1, length, f_) == length && fflush (f_) == 0;
+  }
+
+  virtual bool close ()
+  {
+    if (f_ == 0)
+      return true;
+    size_t length = LZ4F_compressEnd (context_, &output_[0],
+				      output_.size (), NULL);
+    bool ok = !LZ4F_isError (length) &&
+      fwrite (&output_[0], 1, length, f_) == length;
+    LZ4F_freeCompressionContext (context_);
+    if (fclose (f_) != 0)
+      ok = false;
+    f_ = 0;
+    return ok;
+  }
+
+private:
+  FILE *f_;
+  LZ4F_compressionContext_t context_;
+  std::vector<char> output_;
+};
+
+#endif // COIN_HAS_LZ4
+
+
+// ------- CoinAsyncFileOutput -------
+
+#ifdef COINUTILS_PTHREADS
+
+#define COIN_ASYNC_BLOCK (1<<20)
+#define COIN_ASYNC_QUEUE 2
+
+// Collects output in blocks which a thread then compresses and writes
+// through another CoinFileOutput.  When COIN_ASYNC_QUEUE blocks are waiting
+// the caller blocks until the thread has caught up.  Errors from the
+// thread show up in the next write, flush or close.
+class CoinAsyncFileOutput: public CoinFileOutput
+{
+public:
+  CoinAsyncFileOutput (CoinFileOutput *target):
+    CoinFileOutput (target->getFileName ()), target_ (target),
+    first_ (0), numberQueued_ (0), threaded_ (false), stop_ (false),
+    error_ (false), closed_ (false)
+  {
+    fill_.reserve (COIN_ASYNC_BLOCK);
+    pthread_mutex_init (&mutex_, NULL);
+    pthread_cond_init (&condition_, NULL);
+    // if no thread then just write synchronously
+    threaded_ = !pthread_create (&thread_, NULL, writeWorker, this);
+  }
+
+  virtual ~CoinAsyncFileOutput ()
+  {
+    close ();
+    pthread_mutex_destroy (&mutex_);
+    pthread_cond_destroy (&condition_);
+    delete target_;
+  }
+
+  virtual int write (const void *buffer, int size)
+  {
+    if (closed_)
+      return 0;
+    const char *data = static_cast<const char *>(buffer);
+    for (int done = 0; done < size;) {
+      int length = CoinMin (size - done,
+			    COIN_ASYNC_BLOCK - static_cast<int>(fill_.size ()));
+      fill_.insert (fill_.end (), data + done, data + done + length);
+      done += length;
+      if (fill_.size () == COIN_ASYNC_BLOCK && !handOver ())
+	return 0;
+    }
+    return size;
+  }
+
+  virtual bool flush ()
+  {
+    if (closed_)
+      return false;
+    bool ok = fill_.empty () || handOver ();
+    ok = drain () && ok;
+    // thread is idle so target is ours
+    return target_->flush () && ok;
+  }
+
+  virtual bool close ()
+  {
+    if (closed_)
+      return !error_;
+    bool ok = flush ();
+    if (threaded_) {
+      pthread_mutex_lock (&mutex_);
+      stop_ = true;
+      pthread_cond_broadcast (&condition_);
+      pthread_mutex_unlock (&mutex_);
+      pthread_join (thread_, NULL);
+      threaded_ = false;
+    }
+    closed_ = true;
+    ok = target_->close () && ok;
+    if (!ok)
+      error_ = true;
+    return ok;
+  }
+
+private:
+  // Queues fill_ for the thread (waiting for room); false if an error is known
+  bool handOver ()
+  {
+    bool ok;
+    if (!threaded_) {
+      int size = static_cast<int>(fill_.size ());
+      ok = !error_ && target_->write (&fill_[0], size) == size;
+      if (!ok)
+	error_ = true;
+    } else {
+      pthread_mutex_lock (&mutex_);
+      while (numberQueued_ == COIN_ASYNC_QUEUE)
+	pthread_cond_wait (&condition_, &mutex_);
+      ok = !error_;
+      if (ok) {
+	queue_[(first_ + numberQueued_) % COIN_ASYNC_QUEUE].swap (fill_);
+	numberQueued_++;
+	pthread_cond_broadcast (&condition_);
+      }
+      pthread_mutex_unlock (&mutex_);
+    }
+    fill_.clear ();
+    return ok;
+  }
+
+  // Waits until the thread has written everything queued
+  bool drain ()
+  {
+    if (!threaded_)
+      return !error_;
+    pthread_mutex_lock (&mutex_);
+    while (numberQueued_)
+      pthread_cond_wait (&condition_, &mutex_);
+    bool ok = !error_;
+    pthread_mutex_unlock (&mutex_);
+    return ok;
+  }
+
+  static void *writeWorker (void *arg)
+  {
+    CoinAsyncFileOutput *output = static_cast<CoinAsyncFileOutput *>(arg);
+    pthread_mutex_lock (&output->mutex_);
+    for (;;) {
+      while (!output->numberQueued_ && !output->stop_)
+	pthread_cond_wait (&output->condition_, &output->mutex_);
+      if (!output->numberQueued_)
+	break;
+      // block stays counted (so is not reused) until written
+      std::vector<char> &block = output->queue_[output->first_];
+      bool skip = output->error_;
+      pthread_mutex_unlock (&output->mutex_);
+      int size = static_cast<int>(block.size ());
+      bool ok = skip || output->target_->write (&block[0], size) == size;
+      block.clear ();
+      pthread_mutex_lock (&output->mutex_);
+      if (!ok)
+	output->error_ = true;
+      output->first_ = (output->first_ + 1) % COIN_ASYNC_QUEUE;
+      output->numberQueued_--;
+      pthread_cond_broadcast (&output->condition_);
+    }
+    pthread_mutex_unlock (&output->mutex_);
+    return NULL;
+  }
+
+  CoinFileOutput *target_;
+  // block being filled by caller
+  std::vector<char> fill_;
+  // blocks waiting for (or being written by) thread
+  std::vector<char> queue_[COIN_ASYNC_QUEUE];
+  int first_;
+  int numberQueued_;
+  bool threaded_;
+  bool stop_;
+  bool error_;
+  bool closed_;
+  pthread_t thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;
+};
+
+#endif // COINUTILS_PTHREADS
+
 
 // ------- implementation of CoinFileOutput's methods
 
@@ -545,14 +3055,33 @@ bool CoinFileOutput::compressionSupported (Compression compression)
       return false;
 #endif
 
+    case COMPRESS_ZSTD:
+#ifdef COIN_HAS_ZSTD
+      return true;
+#else
+      return false;
+#endif
+
+    case COMPRESS_LZ4:
+#ifdef COIN_HAS_LZ4
+      return true;
+#else
+      return false;
+#endif
+
     default:
       return false;
     }
 }
 
 CoinFileOutput *CoinFileOutput::create (const std::string &fileName, 
-					Compression compression)
+					Compression compression,
+					int numberThreads)
 {
+  // only zstd compresses in threads
+#ifndef COIN_HAS_ZSTD
+  (void) numberThreads;
+#endif
   switch (compression)
     {
     case COMPRESS_NONE: 
@@ -570,6 +3099,18 @@ CoinFileOutput *CoinFileOutput::create (const std::string &fileName,
 #endif
       break;
 
+    case COMPRESS_ZSTD:
+#ifdef COIN_HAS_ZSTD
+      return new CoinZstdFileOutput (fileName, numberThreads);
+#endif
+      break;
+
+    case COMPRESS_LZ4:
+#ifdef COIN_HAS_LZ4
+      return new CoinLz4FileOutput (fileName);
+#endif
+      break;
+
     default:
       break;
     }
@@ -579,6 +3120,17 @@ CoinFileOutput *CoinFileOutput::create (const std::string &fileName,
 		   "CoinFileOutput");
 }
 
+CoinFileOutput *CoinFileOutput::createAsync (const std::string &fileName,
+					     Compression compression,
+					     int numberThreads)
+{
+  CoinFileOutput *output = create (fileName, compression, numberThreads);
+#ifdef COINUTILS_PTHREADS
+  output = new CoinAsyncFileOutput (output);
+#endif
+  return output;
+}
+
 CoinFileOutput::CoinFileOutput (const std::string &fileName):
   CoinFileIOBase (fileName)
 {}
@@ -595,6 +3147,16 @@ bool CoinFileOutput::puts (const char *s)
   return write (s, len) == len;
 }
 
+bool CoinFileOutput::flush ()
+{
+  return true;
+}
+
+bool CoinFileOutput::close ()
+{
+  return flush ();
+}
+
 /*
   Tests if the given string looks like an absolute path to a file.
     - unix:	string begins with `/'
@@ -629,6 +3191,16 @@ bool fileAbsPath (const std::string &path)
 */
 bool fileCoinReadable(std::string & fileName, const std::string &dfltPrefix)
 {
+  // Sources are opened to see if they are there
+  if (coinIsSource (fileName)) {
+    try {
+      delete coinOpenSource (fileName);
+      return true;
+    }
+    catch (CoinError &) {
+      return false;
+    }
+  }
   if (fileName != "stdin")
   { const char dirsep =  CoinFindDirSeparator();
     std::string directory ;
@@ -681,6 +3253,24 @@ bool fileCoinReadable(std::string & fileName, const std::string &dfltPrefix)
     if (fp)
       fileName=fname;
   }
+#endif
+#ifdef COIN_HAS_ZSTD
+  if (!fp) {
+    std::string fname = fileName;
+    fname += ".zst";
+    fp = fopen ( fname.c_str(), "r" );
+    if (fp)
+      fileName=fname;
+  }
+#endif
+#ifdef COIN_HAS_LZ4
+  if (!fp) {
+    std::string fname = fileName;
+    fname += ".lz4";
+    fp = fopen ( fname.c_str(), "r" );
+    if (fp)
+      fileName=fname;
+  }
 #endif
   if (!fp) {
     return false;
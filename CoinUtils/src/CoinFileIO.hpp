@@ -5,8 +5,11 @@
 #ifndef CoinFileIO_H
 #define CoinFileIO_H
 
+#include <cstddef>
 #include <string>
 
+#include "CoinTypes.hpp"
+
 /// Base class for FileIO classes.
 class CoinFileIOBase
 {
@@ -33,6 +36,46 @@ private:
   std::string fileName_;
 };
 
+/** Source of the bytes of a file which is not on a local file system
+
+    CoinFileInput::create passes names of the form scheme://rest, where
+    scheme has been registered with CoinFileInput::registerSource, to the
+    open function registered for it.  The source it returns is read in
+    ranges from start to end; if create was asked for more than one thread
+    the next few ranges are asked for at the same time on different
+    threads, so readRange must be safe to call from several threads at
+    once.  What comes back is recognized and decompressed just as for a
+    file, so MPS and LP files can be read straight from a server.
+
+    Built in are file:// (to a local file) and, if configure found
+    libcurl, http://, https:// and s3://bucket/key.  s3 names go to
+    AWS_ENDPOINT_URL_S3 or AWS_ENDPOINT_URL (path style) if one is set
+    and otherwise to the bucket's virtual host at amazonaws.com in
+    AWS_REGION (us-east-1 if not set).  s3 requests are signed if
+    AWS_ACCESS_KEY_ID and AWS_SECRET_ACCESS_KEY are set (with
+    AWS_SESSION_TOKEN if that is set too).
+*/
+class CoinFileSource
+{
+public:
+  /// Destructor.
+  virtual ~CoinFileSource () {}
+
+  /// Size of file in bytes, or -1 if not known (ranges are then asked
+  /// for one at a time until one comes back empty).
+  virtual CoinInt64 size () = 0;
+
+  /// Reads up to size bytes starting at offset into buffer.
+  /// @return Number of bytes read (may be fewer than size), 0 at end of
+  /// file or negative on error (the range is tried again a few times
+  /// before being taken as end of file).
+  virtual int readRange (CoinInt64 offset, void *buffer, int size) = 0;
+};
+
+/// Opens the source named (the whole name, including scheme://).
+/// Should throw a CoinError or return 0 if it can not.
+typedef CoinFileSource *(*CoinFileSourceOpen) (const std::string &name);
+
 /// Abstract base class for file input classes.
 class CoinFileInput: public CoinFileIOBase
 {
@@ -41,15 +84,34 @@ public:
   static bool haveGzipSupport();
   /// indicates whether CoinFileInput supports bzip2'ed files
   static bool haveBzip2Support();
+  /// indicates whether CoinFileInput supports zstd compressed files
+  static bool haveZstdSupport();
+  /// indicates whether CoinFileInput supports lz4 compressed files
+  static bool haveLz4Support();
+  /// indicates whether http, https and s3 sources are built in (libcurl)
+  static bool haveCurlSupport();
+
+  /// Registers the function opening names of the form scheme://...
+  /// (scheme is not case sensitive).  An open function of 0 removes the
+  /// scheme.  Registering is not thread safe with create.
+  static void registerSource (const std::string &scheme,
+			      CoinFileSourceOpen open);
 
   /// Factory method, that creates a CoinFileInput (more precisely
   /// a subclass of it) for the file specified. This method reads the 
   /// first few bytes of the file and determines if this is a compressed
   /// or a plain file and returns the correct subclass to handle it.
   /// If the file does not exist or uses a compression not compiled in
-  /// an exception is thrown.
+  /// an exception is thrown.  Names of the form scheme://... with a
+  /// registered scheme are read from a CoinFileSource.
   /// @param fileName The file that should be read.
-  static CoinFileInput *create (const std::string &fileName);
+  /// @param numberThreads If more than one (and built with
+  /// COINUTILS_PTHREADS) compressed files are decompressed ahead of use
+  /// on another thread, and bzip2 files of several streams and BGZF
+  /// gzip files are decompressed using up to this many threads.  Sources
+  /// are read ahead of use with up to this many ranges asked for at once.
+  static CoinFileInput *create (const std::string &fileName,
+				int numberThreads=1);
 
   /// Constructor (don't use this, use the create method instead).
   /// @param fileName The name of the file used by this object.
@@ -74,6 +136,36 @@ public:
   /// @param size The size of the buffer in characters.
   /// @return buffer on success, or 0 if no characters have been read.
   virtual char *gets (char *buffer, int size) = 0;
+
+  /// As gets, but may return a pointer to the line in place (instead of
+  /// copying into buffer), with the newline replaced by '\0'.
+  /// The line may be modified up to the '\0' but is only valid until
+  /// the next call.  The default implementation just calls gets.
+  /// @param buffer The buffer to use if the line has to be copied.
+  /// @param size The size of the buffer in characters.
+  /// @return line on success, or 0 if no characters have been read.
+  virtual char *getsInPlace (char *buffer, int size);
+
+  /// As read, but for sizes too large for an int.
+  /// The default implementation calls read in pieces.
+  /// @param buffer Address of a buffer to store the data into.
+  /// @param size Number of bytes to read (buffer should be large enough).
+  /// @return Number of bytes read.
+  virtual size_t readLarge (void *buffer, size_t size);
+
+  /// Returns the next part of the file in place, so a parser can work
+  /// on it without it being copied into caller memory.  Parts carry on
+  /// from whatever read or gets have used and are as large as this
+  /// object's buffer (or window for mapped files).  The part may be
+  /// modified but is only valid until the next call.
+  /// The default implementation reads into a buffer held here.
+  /// @param length Set to number of bytes in part.
+  /// @return start of part, or 0 at end of file.
+  virtual char *readChunk (size_t &length);
+
+private:
+  /// Buffer used by default readChunk
+  char *chunk_;
 };
 
 /// Abstract base class for file output classes.
@@ -85,7 +177,9 @@ public:
   enum Compression { 
     COMPRESS_NONE = 0, ///< No compression.
     COMPRESS_GZIP = 1, ///< gzip compression.
-    COMPRESS_BZIP2 = 2 ///< bzip2 compression.
+    COMPRESS_BZIP2 = 2, ///< bzip2 compression.
+    COMPRESS_ZSTD = 3, ///< zstd compression.
+    COMPRESS_LZ4 = 4 ///< lz4 (frame format) compression.
   };
 
   /// Returns whether the specified compression method is supported 
@@ -102,8 +196,21 @@ public:
   /// here instead of polluting other files.
   /// @param fileName The file that should be read.
   /// @param compression Compression method used.
+  /// @param numberThreads Number of threads zstd may use to compress
+  /// (if the zstd library was built with threads).
   static CoinFileOutput *create (const std::string &fileName, 
-				 Compression compression);
+				 Compression compression,
+				 int numberThreads=1);
+
+  /// Factory method like create, but the CoinFileOutput returned only
+  /// collects output in blocks; a background thread compresses and writes
+  /// them (if COINUTILS_PTHREADS, otherwise this is just create).  If the
+  /// thread falls behind by two 1MB blocks, write waits for it.  A failed
+  /// write by the thread is reported by the next write, flush or close, so
+  /// check the return code of close before trusting the file.
+  static CoinFileOutput *createAsync (const std::string &fileName,
+				      Compression compression,
+				      int numberThreads=1);
 
   /// Constructor (don't use this, use the create method instead).
   /// @param fileName The name of the file used by this object.
@@ -132,6 +239,20 @@ public:
   {
     return puts (s.c_str ());
   } 
+
+  /// Push everything written so far out to the file (for compressed files
+  /// this may end a compression block; bzip2 only pushes out what it has
+  /// already compressed).
+  /// The default implementation does nothing.
+  /// @return true on success, false on error (including earlier errors
+  /// from an asynchronous writer).
+  virtual bool flush ();
+
+  /// Finish the file and close it.  Later writes fail.  The destructor
+  /// closes as well but then errors are lost.
+  /// The default implementation just calls flush.
+  /// @return true if all output reached the file.
+  virtual bool close ();
 };
 
 /*! \relates CoinFileInput
@@ -159,6 +280,10 @@ bool fileAbsPath (const std::string &path) ;
    with support for compressed files, fileCoinReadable will try any
    standard extensions for supported compressed files.
 
+   A name of the form scheme://... with a registered scheme (see
+   CoinFileInput::registerSource) is not modified; it is readable if its
+   source can be opened.
+
    The value returned in \p name is the file name that actually worked.
 */
 bool fileCoinReadable(std::string &name,
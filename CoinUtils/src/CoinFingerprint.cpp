@@ -0,0 +1,276 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinFingerprint.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinThreadPool.hpp"
+
+//#############################################################################
+// Mixes 64 bits (splitmix64 finalizer)
+static inline CoinUInt64
+coinFingerprintMix(CoinUInt64 value)
+{
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+// Mixes 64 bits differently (murmur3 finalizer) for the other half
+static inline CoinUInt64
+coinFingerprintMix2(CoinUInt64 value)
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+// What a piece is, so pieces of different kinds do not match
+#define COIN_FINGERPRINT_ENTRY 0x0000000000000000ULL
+#define COIN_FINGERPRINT_PATTERN 0x3c6ef372fe94f82bULL
+#define COIN_FINGERPRINT_ARRAY 0xa54ff53a5f1d36f1ULL
+#define COIN_FINGERPRINT_DIMENSIONS 0x510e527fade682d1ULL
+#define COIN_FINGERPRINT_ORIENTATION 0x9b05688c2b3e6c1fULL
+// Bits of value with -0.0 as 0.0 and all infinities the same
+static inline CoinUInt64
+coinFingerprintBits(double value)
+{
+  if (value == 0.0)
+    value = 0.0;
+  else if (value >= 1.0e30)
+    value = COIN_DBL_MAX;
+  else if (value <= -1.0e30)
+    value = -COIN_DBL_MAX;
+  CoinUInt64 bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+// Adds one piece - key says where it is and bits what it is
+static inline void
+coinFingerprintAdd(CoinUInt64 key, CoinUInt64 bits,
+		   CoinUInt64 & low, CoinUInt64 & high)
+{
+  const CoinUInt64 mixedKey = coinFingerprintMix(key);
+  low += coinFingerprintMix(mixedKey ^ coinFingerprintMix2(bits));
+  high += coinFingerprintMix2((mixedKey ^ 0x9e3779b97f4a7c15ULL) +
+			      coinFingerprintMix(bits ^ 0x632be59bd9b4e019ULL));
+}
+static inline CoinUInt64
+coinFingerprintPosition(int row, int column)
+{
+  return (static_cast<CoinUInt64>(static_cast<unsigned int>(row)) << 32) |
+    static_cast<unsigned int>(column);
+}
+
+// Work for one thread of addMatrix or addPattern
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  int first;
+  int last;
+  // number added to major index
+  int offset;
+  // true if major vectors are columns
+  bool byColumn;
+  // true if pattern (all entries, no values)
+  bool pattern;
+  CoinUInt64 low;
+  CoinUInt64 high;
+} CoinFingerprintThread;
+
+static void *
+coinFingerprintWorker(void * info)
+{
+  CoinFingerprintThread * thread =
+    reinterpret_cast<CoinFingerprintThread *>(info);
+  const CoinBigIndex * start = thread->start;
+  const int * length = thread->length;
+  const int * index = thread->index;
+  const double * element = thread->element;
+  CoinUInt64 low = 0;
+  CoinUInt64 high = 0;
+  for (int i = thread->first; i < thread->last; i++) {
+    const int major = i + thread->offset;
+    const CoinBigIndex end = start[i] + length[i];
+    for (CoinBigIndex j = start[i]; j < end; j++) {
+      CoinUInt64 key = thread->byColumn ?
+	coinFingerprintPosition(index[j], major) :
+	coinFingerprintPosition(major, index[j]);
+      if (thread->pattern) {
+	coinFingerprintAdd(key ^ COIN_FINGERPRINT_PATTERN, 0, low, high);
+      } else if (element[j]) {
+	coinFingerprintAdd(key ^ COIN_FINGERPRINT_ENTRY,
+			   coinFingerprintBits(element[j]), low, high);
+      }
+    }
+  }
+  thread->low = low;
+  thread->high = high;
+  return NULL;
+}
+
+// Adds entries of matrix and any tail (split between threads)
+static void
+coinFingerprintMatrix(const CoinPackedMatrix & matrix, bool pattern,
+		      int numberThreads, CoinUInt64 & low, CoinUInt64 & high)
+{
+  const int numberMajor = matrix.getMajorDim();
+  // threads only worth it if plenty of elements each
+  numberThreads =
+    CoinMax(1, CoinMin(numberThreads,
+		       static_cast<int>(matrix.getNumElements() / 20000)));
+  numberThreads = CoinMax(1, CoinMin(numberThreads, numberMajor));
+  const CoinPackedMatrix * tail = matrix.getTail();
+  CoinFingerprintThread * thread =
+    new CoinFingerprintThread [numberThreads + 1];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i].start = matrix.getVectorStarts();
+    thread[i].length = matrix.getVectorLengths();
+    thread[i].index = matrix.getIndices();
+    thread[i].element = matrix.getElements();
+    thread[i].first = static_cast<int>((static_cast<double>(numberMajor) * i)
+				       / numberThreads);
+    thread[i].last = static_cast<int>((static_cast<double>(numberMajor)
+				       * (i+1)) / numberThreads);
+    thread[i].offset = 0;
+    thread[i].byColumn = matrix.isColOrdered();
+    thread[i].pattern = pattern;
+  }
+  thread[numberThreads-1].last = numberMajor;
+  CoinThreadPool::run(coinFingerprintWorker, thread,
+		      sizeof(CoinFingerprintThread), numberThreads);
+  if (tail) {
+    // major vectors of tail are last minor vectors of matrix
+    CoinFingerprintThread & tailThread = thread[numberThreads];
+    tailThread.start = tail->getVectorStarts();
+    tailThread.length = tail->getVectorLengths();
+    tailThread.index = tail->getIndices();
+    tailThread.element = tail->getElements();
+    tailThread.first = 0;
+    tailThread.last = tail->getMajorDim();
+    tailThread.offset = matrix.getMinorDim() - tail->getMajorDim();
+    tailThread.byColumn = !matrix.isColOrdered();
+    tailThread.pattern = pattern;
+    coinFingerprintWorker(&tailThread);
+    numberThreads++;
+  }
+  for (int i = 0; i < numberThreads; i++) {
+    low += thread[i].low;
+    high += thread[i].high;
+  }
+  delete [] thread;
+}
+
+//#############################################################################
+
+void
+CoinFingerprint::addDimensions(int numberRows, int numberColumns)
+{
+  coinFingerprintAdd(COIN_FINGERPRINT_DIMENSIONS,
+		     coinFingerprintPosition(numberRows, numberColumns),
+		     low_, high_);
+}
+
+void
+CoinFingerprint::addEntry(int row, int column, double value)
+{
+  if (value)
+    coinFingerprintAdd(coinFingerprintPosition(row, column) ^
+		       COIN_FINGERPRINT_ENTRY,
+		       coinFingerprintBits(value), low_, high_);
+}
+
+void
+CoinFingerprint::addMatrix(const CoinPackedMatrix & matrix,
+			   bool anyOrientation, int numberThreads)
+{
+  addDimensions(matrix.getNumRows(), matrix.getNumCols());
+  if (!anyOrientation)
+    coinFingerprintAdd(COIN_FINGERPRINT_ORIENTATION,
+		       matrix.isColOrdered() ? 1 : 0, low_, high_);
+  coinFingerprintMatrix(matrix, false, numberThreads, low_, high_);
+}
+
+void
+CoinFingerprint::addPattern(const CoinPackedMatrix & matrix,
+			    int numberThreads)
+{
+  addDimensions(matrix.getNumRows(), matrix.getNumCols());
+  coinFingerprintAdd(COIN_FINGERPRINT_ORIENTATION,
+		     matrix.isColOrdered() ? 1 : 0, low_, high_);
+  coinFingerprintMatrix(matrix, true, numberThreads, low_, high_);
+}
+
+void
+CoinFingerprint::addArray(Section section, int number, const double * values)
+{
+  if (!values)
+    return;
+  // zeros left out so NULL is same as all zero
+  for (int i = 0; i < number; i++) {
+    if (values[i])
+      coinFingerprintAdd(coinFingerprintPosition(section, i) ^
+			 COIN_FINGERPRINT_ARRAY,
+			 coinFingerprintBits(values[i]), low_, high_);
+  }
+}
+
+void
+CoinFingerprint::addIntegers(int number, const char * isInteger)
+{
+  if (!isInteger)
+    return;
+  for (int i = 0; i < number; i++) {
+    if (isInteger[i])
+      coinFingerprintAdd(coinFingerprintPosition(integerSection, i) ^
+			 COIN_FINGERPRINT_ARRAY, 1, low_, high_);
+  }
+}
+
+void
+CoinFingerprint::addIntegers(int number, const int * isInteger)
+{
+  if (!isInteger)
+    return;
+  for (int i = 0; i < number; i++) {
+    if (isInteger[i])
+      coinFingerprintAdd(coinFingerprintPosition(integerSection, i) ^
+			 COIN_FINGERPRINT_ARRAY, 1, low_, high_);
+  }
+}
+
+void
+CoinFingerprint::addModelArrays(int numberRows, int numberColumns,
+				const double * columnLower,
+				const double * columnUpper,
+				const double * objective,
+				const double * rowLower, const double * rowUpper)
+{
+  addArray(columnLowerSection, numberColumns, columnLower);
+  addArray(columnUpperSection, numberColumns, columnUpper);
+  addArray(objectiveSection, numberColumns, objective);
+  addArray(rowLowerSection, numberRows, rowLower);
+  addArray(rowUpperSection, numberRows, rowUpper);
+}
+
+void
+CoinFingerprint::toString(char * buffer) const
+{
+  sprintf(buffer, "%016llx%016llx", static_cast<unsigned long long>(high_),
+	  static_cast<unsigned long long>(low_));
+}
@@ -0,0 +1,106 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinFingerprint_H
+#define CoinFingerprint_H
+
+#include "CoinTypes.hpp"
+
+class CoinPackedMatrix;
+
+/** 128 bit fingerprint of model content
+
+    Each piece of data (a matrix entry, or entry i of a bound or cost
+    array) is mixed with its position and what it is into two 64 bit
+    values which are added into the fingerprint.  As addition does not
+    care about order, pieces can be streamed in any order - for instance
+    a matrix by rows or by columns, or its entries as triples - and a
+    matrix can be split between threads (see CoinThreadPool) with the
+    same result for any number of threads.
+
+    Values are taken as they are except that -0.0 is 0.0 and anything
+    1.0e30 or more in size is infinite.  Zero matrix entries are left out
+    of content fingerprints (addMatrix, addEntry) so a stored zero does
+    not change the model; addPattern is for the sparsity pattern itself.
+
+    CoinModel, CoinMpsIO and CoinSnapshot all have a fingerprint method
+    which gives the same answer for the same matrix, bounds, objective
+    and integer columns, however they were read or built.  Names,
+    objective offset and sense are not included.
+*/
+class CoinFingerprint {
+public:
+  /// Arrays which can be added (so the same values in two differ)
+  enum Section {
+    columnLowerSection = 1,
+    columnUpperSection,
+    objectiveSection,
+    rowLowerSection,
+    rowUpperSection,
+    integerSection
+  };
+
+  /**@name Adding data */
+  //@{
+  /// Adds size of matrix
+  void addDimensions(int numberRows, int numberColumns);
+  /// Adds one matrix entry (nothing if value is zero)
+  void addEntry(int row, int column, double value);
+  /** Adds dimensions and non zero entries of matrix (including any tail
+      block).  If anyOrientation is false a row ordered matrix gives a
+      different fingerprint from the same matrix column ordered. */
+  void addMatrix(const CoinPackedMatrix & matrix, bool anyOrientation = false,
+		 int numberThreads = 1);
+  /** Adds orientation, dimensions and positions of all stored entries
+      (zero or not) but not their values */
+  void addPattern(const CoinPackedMatrix & matrix, int numberThreads = 1);
+  /// Adds array of one of the sections (nothing if values NULL)
+  void addArray(Section section, int number, const double * values);
+  /// Adds which columns are integer (non zero) - nothing if NULL
+  void addIntegers(int number, const char * isInteger);
+  /// Adds which columns are integer (non zero) - nothing if NULL
+  void addIntegers(int number, const int * isInteger);
+  /// Adds bounds and objective (any may be NULL)
+  void addModelArrays(int numberRows, int numberColumns,
+		      const double * columnLower, const double * columnUpper,
+		      const double * objective,
+		      const double * rowLower, const double * rowUpper);
+  /// Adds another fingerprint
+  inline void add(const CoinFingerprint & other)
+  { low_ += other.low_; high_ += other.high_;}
+  //@}
+
+  /**@name Value */
+  //@{
+  /// Low 64 bits
+  inline CoinUInt64 low() const
+  { return low_;}
+  /// High 64 bits
+  inline CoinUInt64 high() const
+  { return high_;}
+  /// Writes 32 hex digits and a terminating null into buffer
+  void toString(char * buffer) const;
+  inline bool operator==(const CoinFingerprint & rhs) const
+  { return low_ == rhs.low_ && high_ == rhs.high_;}
+  inline bool operator!=(const CoinFingerprint & rhs) const
+  { return low_ != rhs.low_ || high_ != rhs.high_;}
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Fingerprint of nothing
+  CoinFingerprint()
+    : low_(0), high_(0) {}
+  //@}
+
+private:
+  /**@name Private member data */
+  //@{
+  CoinUInt64 low_;
+  CoinUInt64 high_;
+  //@}
+};
+
+#endif
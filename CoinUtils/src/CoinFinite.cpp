@@ -47,3 +47,39 @@ bool CoinIsnan(double val)
     return false;
 #endif
 }
+
+// Same as CoinFinite but with no call or branch
+static inline bool coinQuickFinite(double val)
+{
+#ifdef COIN_C_FINITE
+  // false for infinities and NaN
+  return fabs(val) <= DBL_MAX;
+#else
+  return fabs(val) != DBL_MAX;
+#endif
+}
+
+int CoinFirstNotFinite(const double * array, int size)
+{
+  int i = 0;
+  for ( ; i + 8 <= size; i += 8) {
+    bool finite = true;
+    for (int k = 0; k < 8; k++)
+      finite &= coinQuickFinite(array[i+k]);
+    if (!finite)
+      break;
+  }
+  for ( ; i < size; i++) {
+    if (!coinQuickFinite(array[i]))
+      return i;
+  }
+  return size;
+}
+
+int CoinCountAbove(const double * array, int size, double tolerance)
+{
+  int count = 0;
+  for (int i = 0; i < size; i++)
+    count += fabs(array[i]) > tolerance;
+  return count;
+}
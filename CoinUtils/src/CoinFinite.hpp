@@ -3,7 +3,8 @@
 // Corporation and others.  All Rights Reserved.
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
-/* Defines COIN_DBL_MAX and relatives and provides CoinFinite and CoinIsnan. */
+/* Defines COIN_DBL_MAX and relatives and provides CoinFinite and CoinIsnan
+   (and array checks built on them). */
 
 #ifndef CoinFinite_H
 #define CoinFinite_H
@@ -31,4 +32,14 @@ extern bool CoinFinite(double val);
 /** checks if a double value is not a number */
 extern bool CoinIsnan(double val);
 
+/** Position of the first value in array which is not finite (in the sense
+    of CoinFinite), or size if all are.  Blocks of values are tested
+    without branches so the loop vectorises; a check of a whole model
+    costs little more than reading it. */
+extern int CoinFirstNotFinite(const double * array, int size);
+
+/** Number of values in array with absolute value greater than tolerance
+    (NaNs are not counted) */
+extern int CoinCountAbove(const double * array, int size, double tolerance);
+
 #endif
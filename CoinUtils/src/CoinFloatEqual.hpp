@@ -55,6 +55,38 @@ class CoinAbsFltEq
     if (f1 == f2) return true ;
     return (fabs(f1-f2) < epsilon_) ; } 
 
+  /*! \brief First position where two arrays differ
+
+    Returns the first i < size for which <code>(*this)(a[i],b[i])</code> is
+    false, or size if all are equal.  Blocks of eight are tested without
+    branches, so the loop vectorises, and the scan stops in the first block
+    with a difference.
+  */
+
+  inline int firstDifferent (const double * a, const double * b,
+			     const int size) const
+
+  { int i = 0 ;
+    for ( ; i+8 <= size ; i += 8) {
+      bool equal = true ;
+      for (int k = 0 ; k < 8 ; k++)
+	equal &= quickEqual(a[i+k],b[i+k]) ;
+      if (!equal) break ;
+    }
+    for ( ; i < size ; i++)
+      if (!(*this)(a[i],b[i])) return i ;
+    return size ; }
+
+  //! Number of positions where two arrays differ (no branches)
+
+  inline int countDifferent (const double * a, const double * b,
+			     const int size) const
+
+  { int count = 0 ;
+    for (int i = 0 ; i < size ; i++)
+      count += !quickEqual(a[i],b[i]) ;
+    return count ; }
+
   /*! \name Constructors and destructors */
   //@{
 
@@ -97,6 +129,11 @@ class CoinAbsFltEq
 
   //@}
 
+  //! As operator() but without branches
+
+  inline bool quickEqual (const double f1, const double f2) const
+  { return (f1 == f2) | (fabs(f1-f2) < epsilon_) ; }
+
 } ;
 
 
@@ -123,6 +160,51 @@ class CoinRelFltEq
 
     return (fabs(f1-f2) <= epsilon_*(1+tol)) ; }
 
+  /*! \brief First position where two arrays differ
+
+    Returns the first i < size for which <code>(*this)(a[i],b[i])</code> is
+    false, or size if all are equal.  Blocks of eight are tested without
+    branches, so the loop vectorises; a block which may have a difference
+    (or holds infinities) is looked at one by one.
+  */
+
+  inline int firstDifferent (const double * a, const double * b,
+			     const int size) const
+
+  { int i = 0 ;
+    for ( ; i+8 <= size ; i += 8) {
+      bool equal = true ;
+      for (int k = 0 ; k < 8 ; k++)
+	equal &= quickEqual(a[i+k],b[i+k]) ;
+      if (!equal) {
+	for (int k = 0 ; k < 8 ; k++)
+	  if (!(*this)(a[i+k],b[i+k])) return i+k ;
+      }
+    }
+    for ( ; i < size ; i++)
+      if (!(*this)(a[i],b[i])) return i ;
+    return size ; }
+
+  //! Number of positions where two arrays differ
+
+  inline int countDifferent (const double * a, const double * b,
+			     const int size) const
+
+  { int count = 0 ;
+    int i = 0 ;
+    for ( ; i+8 <= size ; i += 8) {
+      int maybe = 0 ;
+      for (int k = 0 ; k < 8 ; k++)
+	maybe += !quickEqual(a[i+k],b[i+k]) ;
+      if (maybe) {
+	for (int k = 0 ; k < 8 ; k++)
+	  count += !(*this)(a[i+k],b[i+k]) ;
+      }
+    }
+    for ( ; i < size ; i++)
+      count += !(*this)(a[i],b[i]) ;
+    return count ; }
+
   /*! \name Constructors and destructors */
   //@{
 
@@ -172,6 +254,45 @@ private:
 
   //@}
 
+  /*! \brief As operator() but without branches
+
+    True only if operator() is true.  Pairs which are not identical and
+    involve an infinity, a NaN or <code>DBL_MAX</code> give false.
+  */
+
+  inline bool quickEqual (const double f1, const double f2) const
+  { const double tol = (fabs(f1)>fabs(f2))?fabs(f1):fabs(f2) ;
+    return (f1 == f2) |
+      ((fabs(f1-f2) <= epsilon_*(1+tol)) & (tol < COIN_DBL_MAX)) ; }
+
 } ;
 
+/*! \brief First position where two arrays differ under \p eq
+
+  Returns the first i < size for which <code>eq(a[i],b[i])</code> is false,
+  or size if all are equal.  For CoinAbsFltEq and CoinRelFltEq this is
+  their (vectorised) firstDifferent; any other function object is called
+  one value at a time.
+*/
+template <class FloatEqual> inline int
+CoinFirstDifferent (const FloatEqual & eq, const double * a,
+		    const double * b, const int size)
+{ for (int i = 0 ; i < size ; i++)
+    if (!eq(a[i],b[i])) return i ;
+  return size ; }
+
+//! CoinFirstDifferent for CoinAbsFltEq
+
+inline int
+CoinFirstDifferent (const CoinAbsFltEq & eq, const double * a,
+		    const double * b, const int size)
+{ return eq.firstDifferent(a,b,size) ; }
+
+//! CoinFirstDifferent for CoinRelFltEq
+
+inline int
+CoinFirstDifferent (const CoinRelFltEq & eq, const double * a,
+		    const double * b, const int size)
+{ return eq.firstDifferent(a,b,size) ; }
+
 #endif
@@ -0,0 +1,245 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinThreadPool.hpp"
+#if defined(__SSE2__) || defined(_M_X64)
+#define COIN_STREAMING_STORES
+#include <emmintrin.h>
+#endif
+
+//#############################################################################
+// Bulk copy and fill behind CoinMemcpyN, CoinFillN and CoinZeroN
+
+static size_t coinStreamingThreshold = 1 << 20;
+
+void CoinSetStreamingThreshold(size_t bytes)
+{
+  coinStreamingThreshold = bytes;
+}
+
+size_t CoinStreamingThreshold()
+{
+  return coinStreamingThreshold;
+}
+
+#ifdef COIN_STREAMING_STORES
+/* Bytes to do before put is on a 16 byte boundary.  Caller must do them
+   with ordinary stores (count is multiple of unit so fills keep phase) */
+static inline size_t
+coinStreamHead(const char *put, size_t unit)
+{
+  size_t head = (16 - (reinterpret_cast< size_t >(put) & 15)) & 15;
+  return head % unit == 0 ? head : static_cast< size_t >(-1);
+}
+
+// Stores pattern to numberBlocks*64 bytes starting on 16 byte boundary
+static inline void
+coinStreamPattern(char *put, size_t numberBlocks, __m128i pattern)
+{
+  for (size_t i = 0; i < numberBlocks; i++, put += 64) {
+    _mm_stream_si128(reinterpret_cast< __m128i * >(put), pattern);
+    _mm_stream_si128(reinterpret_cast< __m128i * >(put + 16), pattern);
+    _mm_stream_si128(reinterpret_cast< __m128i * >(put + 32), pattern);
+    _mm_stream_si128(reinterpret_cast< __m128i * >(put + 48), pattern);
+  }
+  _mm_sfence();
+}
+#endif
+
+void CoinCopyBytes(void *to, const void *from, size_t bytes)
+{
+#ifdef COIN_STREAMING_STORES
+  if (bytes >= coinStreamingThreshold) {
+    char *put = static_cast< char * >(to);
+    const char *get = static_cast< const char * >(from);
+    size_t head = coinStreamHead(put, 1);
+    std::memcpy(put, get, head);
+    put += head;
+    get += head;
+    bytes -= head;
+    size_t numberBlocks = bytes >> 6;
+    for (size_t i = 0; i < numberBlocks; i++, put += 64, get += 64) {
+      const __m128i *get128 = reinterpret_cast< const __m128i * >(get);
+      __m128i a = _mm_loadu_si128(get128);
+      __m128i b = _mm_loadu_si128(get128 + 1);
+      __m128i c = _mm_loadu_si128(get128 + 2);
+      __m128i d = _mm_loadu_si128(get128 + 3);
+      _mm_stream_si128(reinterpret_cast< __m128i * >(put), a);
+      _mm_stream_si128(reinterpret_cast< __m128i * >(put + 16), b);
+      _mm_stream_si128(reinterpret_cast< __m128i * >(put + 32), c);
+      _mm_stream_si128(reinterpret_cast< __m128i * >(put + 48), d);
+    }
+    _mm_sfence();
+    std::memcpy(put, get, bytes & 63);
+    return;
+  }
+#endif
+  std::memcpy(to, from, bytes);
+}
+
+void CoinZeroBytes(void *to, size_t bytes)
+{
+#ifdef COIN_STREAMING_STORES
+  if (bytes >= coinStreamingThreshold) {
+    char *put = static_cast< char * >(to);
+    size_t head = coinStreamHead(put, 1);
+    std::memset(put, 0, head);
+    put += head;
+    bytes -= head;
+    coinStreamPattern(put, bytes >> 6, _mm_setzero_si128());
+    std::memset(put + (bytes & ~static_cast< size_t >(63)), 0, bytes & 63);
+    return;
+  }
+#endif
+  std::memset(to, 0, bytes);
+}
+
+void CoinFillBytes(void *to, size_t count, const void *value,
+  size_t sizeofValue)
+{
+  char *put = static_cast< char * >(to);
+  // all zero bits (0, 0.0 or NULL) is the common case
+  bool zero = true;
+  for (size_t i = 0; i < sizeofValue; i++) {
+    if (static_cast< const char * >(value)[i]) {
+      zero = false;
+      break;
+    }
+  }
+  if (zero) {
+    CoinZeroBytes(to, count * sizeofValue);
+    return;
+  }
+  size_t bytes = count * sizeofValue;
+#ifdef COIN_STREAMING_STORES
+  size_t head = (sizeofValue == 4 || sizeofValue == 8)
+    ? coinStreamHead(put, sizeofValue)
+    : static_cast< size_t >(-1);
+  if (bytes >= coinStreamingThreshold && head < 16) {
+    for (size_t i = 0; i < head; i += sizeofValue)
+      std::memcpy(put + i, value, sizeofValue);
+    put += head;
+    bytes -= head;
+    __m128i pattern;
+    if (sizeofValue == 4) {
+      int value4;
+      std::memcpy(&value4, value, 4);
+      pattern = _mm_set1_epi32(value4);
+    } else {
+      double value8;
+      std::memcpy(&value8, value, 8);
+      pattern = _mm_castpd_si128(_mm_set1_pd(value8));
+    }
+    coinStreamPattern(put, bytes >> 6, pattern);
+    put += bytes & ~static_cast< size_t >(63);
+    bytes &= 63;
+  }
+#endif
+  // ordinary stores - compilers vectorize these for fixed sizes
+  switch (sizeofValue) {
+  case 4: {
+    int value4;
+    std::memcpy(&value4, value, 4);
+    int *put4 = reinterpret_cast< int * >(put);
+    for (size_t i = 0; i < bytes / 4; i++)
+      put4[i] = value4;
+  } break;
+  case 8: {
+    double value8;
+    std::memcpy(&value8, value, 8);
+    double *put8 = reinterpret_cast< double * >(put);
+    for (size_t i = 0; i < bytes / 8; i++)
+      put8[i] = value8;
+  } break;
+  default:
+    for (size_t i = 0; i < bytes; i += sizeofValue)
+      std::memcpy(put + i, value, sizeofValue);
+    break;
+  }
+}
+
+//#############################################################################
+// Index map for deletions
+
+// Smallest array numbered in parallel
+#define COIN_DELETION_PARALLEL 200000
+
+namespace {
+// One block of a parallel deletion map
+typedef struct {
+  int *newIndex;
+  int first;
+  int last;
+  // kept in block, then position of first kept
+  int number;
+  int pass;
+} CoinDeletionBlock;
+
+void *coinDeletionWorker(void *info)
+{
+  CoinDeletionBlock *block = static_cast< CoinDeletionBlock * >(info);
+  int *newIndex = block->newIndex;
+  if (!block->pass) {
+    int n = 0;
+    for (int i = block->first; i < block->last; i++)
+      n += newIndex[i] + 1;
+    block->number = n;
+  } else {
+    int put = block->number;
+    for (int i = block->first; i < block->last; i++)
+      newIndex[i] = newIndex[i] ? -1 : put++;
+  }
+  return NULL;
+}
+}
+
+int CoinDeletionMap(int size, int number, const int *which, int *newIndex)
+{
+  if (size <= 0)
+    return 0;
+  // mark as -1 (deleted) or 0
+  CoinZeroN(newIndex, size);
+  for (int k = 0; k < number; k++) {
+    int i = which[k];
+    if (i >= 0 && i < size)
+      newIndex[i] = -1;
+  }
+  int numberBlocks = CoinMin(CoinThreadPool::numberThreads(),
+    size / (COIN_DELETION_PARALLEL / 2));
+  if (numberBlocks < 2 || size < COIN_DELETION_PARALLEL
+    || CoinThreadPool::inTask()) {
+    int put = 0;
+    for (int i = 0; i < size; i++)
+      newIndex[i] = newIndex[i] ? -1 : put++;
+    return put;
+  }
+  CoinDeletionBlock *block = new CoinDeletionBlock[numberBlocks];
+  int chunk = (size + numberBlocks - 1) / numberBlocks;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    block[iBlock].newIndex = newIndex;
+    block[iBlock].first = CoinMin(iBlock * chunk, size);
+    block[iBlock].last = CoinMin(block[iBlock].first + chunk, size);
+    block[iBlock].pass = 0;
+  }
+  CoinThreadPool::run(coinDeletionWorker, block, sizeof(CoinDeletionBlock),
+    numberBlocks);
+  int put = 0;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    int n = block[iBlock].number;
+    block[iBlock].number = put;
+    block[iBlock].pass = 1;
+    put += n;
+  }
+  CoinThreadPool::run(coinDeletionWorker, block, sizeof(CoinDeletionBlock),
+    numberBlocks);
+  delete[] block;
+  return put;
+}
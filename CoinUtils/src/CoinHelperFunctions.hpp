@@ -20,6 +20,7 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <algorithm>
 #include "CoinTypes.hpp"
 #include "CoinError.hpp"
@@ -33,6 +34,67 @@
 #endif
 #endif
 
+// Hint that memory at address will be read soon (no effect if unknown)
+#ifndef COIN_PREFETCH
+#if defined(__GNUC__)
+#define COIN_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define COIN_PREFETCH(address)
+#endif
+#endif
+
+//#############################################################################
+
+/**@name Bulk copy and fill
+
+   CoinCopyN, CoinMemcpyN, CoinFillN and CoinZeroN work in three tiers
+   when entries can be moved as bytes (arithmetic types and pointers).
+   Below COIN_BULK_MINIMUM entries the inline loops are used, as a call
+   costs more than the work.  Larger arrays go to libc, except that above
+   the streaming threshold (default 1MB, roughly L2) copies, zeroing and
+   fills of 4 and 8 byte values use non-temporal stores where available,
+   so clearing a big work array does not evict the factorization from
+   cache.  Other types always use the loops.
+*/
+//@{
+#ifndef COIN_BULK_MINIMUM
+#define COIN_BULK_MINIMUM 32
+#endif
+/// True if T can be copied, filled and zeroed as bytes
+template <class T> struct CoinIsBitwise { enum { value = 0 }; };
+template <class T> struct CoinIsBitwise<T*> { enum { value = 1 }; };
+template <class T> struct CoinIsBitwise<const T> { enum { value = CoinIsBitwise<T>::value }; };
+#define COIN_BITWISE_TYPE(T) \
+template <> struct CoinIsBitwise<T> { enum { value = 1 }; }
+COIN_BITWISE_TYPE(bool);
+COIN_BITWISE_TYPE(char);
+COIN_BITWISE_TYPE(signed char);
+COIN_BITWISE_TYPE(unsigned char);
+COIN_BITWISE_TYPE(short);
+COIN_BITWISE_TYPE(unsigned short);
+COIN_BITWISE_TYPE(int);
+COIN_BITWISE_TYPE(unsigned int);
+COIN_BITWISE_TYPE(long);
+COIN_BITWISE_TYPE(unsigned long);
+COIN_BITWISE_TYPE(long long);
+COIN_BITWISE_TYPE(unsigned long long);
+COIN_BITWISE_TYPE(float);
+COIN_BITWISE_TYPE(double);
+#undef COIN_BITWISE_TYPE
+/// Sets size in bytes above which non-temporal stores are used
+void CoinSetStreamingThreshold(size_t bytes);
+/// Size in bytes above which non-temporal stores are used
+size_t CoinStreamingThreshold();
+/// Copies bytes between arrays which do not overlap
+void CoinCopyBytes(void * to, const void * from, size_t bytes);
+/// Zeroes bytes
+void CoinZeroBytes(void * to, size_t bytes);
+/** Fills count entries of size sizeofValue (which should be 4 or 8 to be
+    fast) with value */
+void CoinFillBytes(void * to, size_t count, const void * value,
+		   size_t sizeofValue);
+//@}
+
 //#############################################################################
 
 /** This helper function copies an array to another location using Duff's
@@ -51,6 +113,11 @@ CoinCopyN(register const T* from, const int size, register T* to)
 	throw CoinError("trying to copy negative number of entries",
 			"CoinCopyN", "");
 #endif
+    if (CoinIsBitwise<T>::value && size >= COIN_BULK_MINIMUM) {
+	// may overlap so no streaming
+	std::memmove(to, from, size * sizeof(T));
+	return;
+    }
 
     register int n = (size + 7) / 8;
     if (to > from) {
@@ -286,6 +353,10 @@ CoinMemcpyN(register const T* from, const int size, register T* to)
 	throw CoinError("trying to copy negative number of entries",
 			"CoinMemcpyN", "");
 #endif
+    if (CoinIsBitwise<T>::value && size >= COIN_BULK_MINIMUM) {
+	CoinCopyBytes(to, from, size * sizeof(T));
+	return;
+    }
 
 #if 0
     /* There is no point to do this test. If to and from are from different
@@ -328,6 +399,10 @@ CoinMemcpyN(const T * COIN_RESTRICT from, int size, T* COIN_RESTRICT to)
 #ifdef USE_MEMCPY
   std::memcpy(to,from,size*sizeof(T));
 #else
+  if (CoinIsBitwise<T>::value && size >= COIN_BULK_MINIMUM) {
+    CoinCopyBytes(to, from, size * sizeof(T));
+    return;
+  }
   T * COIN_RESTRICT put =  to;
   const T * COIN_RESTRICT get = from;
   for ( ; 0<size ; --size)
@@ -368,6 +443,12 @@ CoinFillN(register T* to, const int size, register const T value)
 	throw CoinError("trying to fill negative number of entries",
 			"CoinFillN", "");
 #endif
+    if (CoinIsBitwise<T>::value && size >= COIN_BULK_MINIMUM) {
+	// value is register so can not have its address taken
+	const T fill = value;
+	CoinFillBytes(to, size, &fill, sizeof(T));
+	return;
+    }
 #if 1
     for (register int n = size / 8; n > 0; --n, to += 8) {
 	to[0] = value;
@@ -447,6 +528,10 @@ CoinZeroN(register T* to, const int size)
 	throw CoinError("trying to fill negative number of entries",
 			"CoinZeroN", "");
 #endif
+    if (CoinIsBitwise<T>::value && size >= COIN_BULK_MINIMUM) {
+	CoinZeroBytes(to, size * sizeof(T));
+	return;
+    }
 #if 1
     for (register int n = size / 8; n > 0; --n, to += 8) {
 	to[0] = 0;
@@ -750,6 +835,15 @@ CoinDeleteEntriesFromArray(register T * arrayFirst, register T * arrayLast,
     return arrayFirst + size;
 }
 
+/** Index map for deleting entries from arrays of \p size entries.
+    Sets newIndex[i] to the position of entry i once the entries in
+    \p which (any order; duplicates and indices out of range are ignored)
+    are deleted, or to -1 if i is deleted, and returns the number kept.
+    One pass over \p which and one over newIndex, with no sorting; large
+    arrays are numbered in blocks on CoinThreadPool (a prefix sum of the
+    numbers kept in each block). */
+int CoinDeletionMap(int size, int number, const int * which, int * newIndex);
+
 //#############################################################################
 
 #define COIN_OWN_RANDOM_32
@@ -1103,6 +1197,100 @@ protected:
   //@}
 };
 #endif
+
+/** Counter based random numbers in independent, reproducible streams
+
+  Value n of a stream is a 64 bit mix (the splitmix64 finaliser) of the
+  stream key plus n times an odd constant, so values do not depend on each
+  other: jump() is a single add, any value can be had with at(), and
+  fillDoubles() is a loop the compiler can unroll or vectorise. The key
+  comes from a seed and a stream number; substream() derives a new key, so
+  parallel workers or search tree nodes can each take a stream (say by
+  thread or node number) and get the same numbers on every run, whatever
+  the scheduling.
+
+  Unlike CoinThreadRandom the numbers have 52 random bits and pass the
+  usual statistical batteries. Doubles are in the open interval (0,1).
+*/
+class CoinCounterRandom  {
+public:
+  /**@name Constructors */
+  //@{
+  /** Default constructor. */
+  CoinCounterRandom()
+  { setSeed(12345678);}
+  /** Constructor with seed and stream number. */
+  CoinCounterRandom(CoinUInt64 seed, CoinUInt64 stream=0)
+  { setSeed(seed,stream);}
+  //@}
+
+  /**@name Sets/gets */
+  //@{
+  /** Set seed and stream number and go to start of stream. */
+  inline void setSeed(CoinUInt64 seed, CoinUInt64 stream=0)
+  {
+    key_ = mix(mix(seed+0x9e3779b97f4a7c15ULL)^(stream*0xd1b54a32d192ed03ULL));
+    counter_ = 0;
+  }
+  /// Key of stream
+  inline CoinUInt64 key() const
+  { return key_;}
+  /// Position in stream (number of values taken)
+  inline CoinUInt64 position() const
+  { return counter_;}
+  /// Go to position \p n in stream
+  inline void setPosition(CoinUInt64 n)
+  { counter_ = n;}
+  /// Skip \p n values
+  inline void jump(CoinUInt64 n)
+  { counter_ += n;}
+  /// Independent stream \p id derived from this one (starting at 0)
+  inline CoinCounterRandom substream(CoinUInt64 id) const
+  {
+    CoinCounterRandom stream(*this);
+    stream.key_ = mix(key_^mix(id+0x632be59bd9b4e019ULL));
+    stream.counter_ = 0;
+    return stream;
+  }
+  //@}
+
+  /**@name Numbers */
+  //@{
+  /// Value \p n of stream (position is not changed)
+  inline CoinUInt64 at(CoinUInt64 n) const
+  { return mix(key_+(n+1)*0x9e3779b97f4a7c15ULL);}
+  /// Next 64 random bits
+  inline CoinUInt64 randomInteger()
+  { return at(counter_++);}
+  /// Next random number in (0,1)
+  inline double randomDouble()
+  { return toDouble(at(counter_++));}
+  /// Fill \p values with the next \p n random numbers in (0,1)
+  inline void fillDoubles(double * COIN_RESTRICT values, int n)
+  {
+    const CoinUInt64 base = key_+(counter_+1)*0x9e3779b97f4a7c15ULL;
+    for (int i=0;i<n;i++)
+      values[i] = toDouble(mix(base+static_cast<CoinUInt64>(i)*0x9e3779b97f4a7c15ULL));
+    counter_ += n;
+  }
+  /// Map 64 bits to a double in (0,1) (with 53 bits the top one rounds to 1)
+  static inline double toDouble(CoinUInt64 bits)
+  { return (static_cast<double>(bits>>12)+0.5)*(1.0/4503599627370496.0);}
+  /// The mixing function
+  static inline CoinUInt64 mix(CoinUInt64 z)
+  {
+    z = (z^(z>>30))*0xbf58476d1ce4e5b9ULL;
+    z = (z^(z>>27))*0x94d049bb133111ebULL;
+    return z^(z>>31);
+  }
+  //@}
+
+private:
+  /// Stream key
+  CoinUInt64 key_;
+  /// Values taken
+  CoinUInt64 counter_;
+};
 #ifndef COIN_DETAIL
 #define COIN_DETAIL_PRINT(s) {}
 #else
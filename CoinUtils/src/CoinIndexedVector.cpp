@@ -7,17 +7,362 @@
 // Turn off compiler warning about long names
 #  pragma warning(disable:4786)
 #endif
+
+#include "CoinUtilsConfig.h"
   
 #include <cassert>
 #include <cstdio>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 #include "CoinTypes.hpp"
 #include "CoinFloatEqual.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinIndexedVector.hpp"
+#include "CoinThreadPool.hpp"
 #include "CoinTypes.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 //#############################################################################
 #define WARN_USELESS 0
+/* Vectorized scans of dense region.  COIN_INDEXED_SIMD 2 allows AVX-512F
+   or AVX2, 1 only AVX2 and 0 switches off.  Instruction set is chosen at
+   run time so library can still be built for generic x86.
+   Each kernel does as many complete blocks as it can from start and
+   updates start - caller finishes off with scalar code.
+   type - 1 tolerance, 2 pack (elements moved down and dense zeroed) */
+#ifndef COIN_INDEXED_SIMD
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+  && (defined(__x86_64__) || defined(__i386__))
+#define COIN_INDEXED_SIMD 2
+#else
+#define COIN_INDEXED_SIMD 0
+#endif
+#endif
+#if COIN_INDEXED_SIMD
+#include <immintrin.h>
+// For each mask of four doubles - positions of set ones (as floats)
+static const int coinScanPermute[16][8] = {
+  {0,1,0,1,0,1,0,1},
+  {0,1,2,3,2,3,2,3},
+  {2,3,0,1,0,1,0,1},
+  {0,1,2,3,4,5,4,5},
+  {4,5,0,1,0,1,0,1},
+  {0,1,4,5,2,3,2,3},
+  {2,3,4,5,0,1,0,1},
+  {0,1,2,3,4,5,6,7},
+  {6,7,0,1,0,1,0,1},
+  {0,1,6,7,2,3,2,3},
+  {2,3,6,7,0,1,0,1},
+  {0,1,2,3,6,7,4,5},
+  {4,5,6,7,0,1,0,1},
+  {0,1,4,5,6,7,2,3},
+  {2,3,4,5,6,7,0,1},
+  {0,1,2,3,4,5,6,7}
+};
+// And same as offsets for indices
+static const int coinScanOffset[16][4] = {
+  {0,0,0,0},{0,1,1,1},{1,0,0,0},{0,1,2,2},
+  {2,0,0,0},{0,2,1,1},{1,2,0,0},{0,1,2,3},
+  {3,0,0,0},{0,3,1,1},{1,3,0,0},{0,1,3,2},
+  {2,3,0,0},{0,2,3,1},{1,2,3,0},{0,1,2,3}
+};
+__attribute__((target("avx2"))) static int 
+coinScanAvx2(double * COIN_RESTRICT elements, int & start, int end,
+	     int * COIN_RESTRICT indices, int room, double tolerance, int type)
+{
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d tol = _mm256_set1_pd(tolerance);
+  const __m256d absMask = 
+    _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+  // packed elements can only overwrite zeros if starting at beginning
+  if ((type&2)!=0&&start)
+    return 0;
+  int number = 0;
+  int i = start;
+  for ( ; i + 4 <= end && number + 4 <= room; i += 4) {
+    __m256d value = _mm256_loadu_pd(elements+i);
+    int nonZero = 
+      _mm256_movemask_pd(_mm256_cmp_pd(value,zero,_CMP_NEQ_UQ));
+    if (!nonZero)
+      continue;
+    int mask;
+    __m256d keep;
+    if ((type&1)!=0) {
+      keep = _mm256_cmp_pd(_mm256_and_pd(value,absMask),tol,_CMP_GE_OQ);
+      mask = _mm256_movemask_pd(keep);
+      if ((type&2)==0) {
+	mask &= nonZero;
+	if (mask!=nonZero)
+	  _mm256_storeu_pd(elements+i,_mm256_and_pd(value,keep));
+      }
+    } else {
+      keep = _mm256_cmp_pd(value,zero,_CMP_NEQ_UQ);
+      mask = nonZero;
+    }
+    if ((type&2)!=0) {
+      _mm256_storeu_pd(elements+i,zero);
+      if (mask) {
+	// rejected lanes are zero so padding just stores zeros
+	__m256i permute = 
+	  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(coinScanPermute[mask]));
+	__m256d packed = _mm256_castps_pd
+	  (_mm256_permutevar8x32_ps(_mm256_castpd_ps(_mm256_and_pd(value,keep)),
+				    permute));
+	_mm256_storeu_pd(elements+number,packed);
+      }
+    }
+    if (mask) {
+      __m128i offset = 
+	_mm_loadu_si128(reinterpret_cast<const __m128i *>(coinScanOffset[mask]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(indices+number),
+		       _mm_add_epi32(offset,_mm_set1_epi32(i)));
+      number += __builtin_popcount(mask);
+    }
+  }
+  start = i;
+  return number;
+}
+#if COIN_INDEXED_SIMD > 1
+__attribute__((target("avx512f"))) static int 
+coinScanAvx512(double * COIN_RESTRICT elements, int & start, int end,
+	       int * COIN_RESTRICT indices, double tolerance, int type)
+{
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d tol = _mm512_set1_pd(tolerance);
+  const __m512i absMask = _mm512_set1_epi64(0x7fffffffffffffffLL);
+  const __m512i step = _mm512_setr_epi32(0,1,2,3,4,5,6,7,
+					 8,9,10,11,12,13,14,15);
+  int number = 0;
+  int i = start;
+  for ( ; i + 16 <= end; i += 16) {
+    __m512d value0 = _mm512_loadu_pd(elements+i);
+    __m512d value1 = _mm512_loadu_pd(elements+i+8);
+    __mmask8 nonZero0 = _mm512_cmp_pd_mask(value0,zero,_CMP_NEQ_UQ);
+    __mmask8 nonZero1 = _mm512_cmp_pd_mask(value1,zero,_CMP_NEQ_UQ);
+    if (!(nonZero0|nonZero1))
+      continue;
+    __mmask8 mask0 = nonZero0;
+    __mmask8 mask1 = nonZero1;
+    if ((type&1)!=0) {
+      mask0 = _mm512_cmp_pd_mask(_mm512_castsi512_pd
+				 (_mm512_and_epi64(_mm512_castpd_si512(value0),
+						   absMask)),
+				 tol,_CMP_GE_OQ);
+      mask1 = _mm512_cmp_pd_mask(_mm512_castsi512_pd
+				 (_mm512_and_epi64(_mm512_castpd_si512(value1),
+						   absMask)),
+				 tol,_CMP_GE_OQ);
+      if ((type&2)==0) {
+	mask0 &= nonZero0;
+	mask1 &= nonZero1;
+	_mm512_mask_storeu_pd(elements+i,nonZero0&~mask0,zero);
+	_mm512_mask_storeu_pd(elements+i+8,nonZero1&~mask1,zero);
+      }
+    }
+    if ((type&2)!=0) {
+      _mm512_storeu_pd(elements+i,zero);
+      _mm512_storeu_pd(elements+i+8,zero);
+      _mm512_mask_compressstoreu_pd(elements+number,mask0,value0);
+      _mm512_mask_compressstoreu_pd(elements+number+__builtin_popcount(mask0),
+				    mask1,value1);
+    }
+    __mmask16 mask = static_cast<__mmask16>(mask0 | (mask1<<8));
+    _mm512_mask_compressstoreu_epi32(indices+number,mask,
+				     _mm512_add_epi32(step,_mm512_set1_epi32(i)));
+    number += __builtin_popcount(mask);
+  }
+  start = i;
+  return number;
+}
+#endif
+// 0 not known, 1 none, 2 AVX2, 3 AVX-512F
+static int coinScanLevel = 0;
+static inline int 
+coinSimdLevel()
+{
+  if (!coinScanLevel) {
+    int level = 1;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      level = 2;
+#if COIN_INDEXED_SIMD > 1
+    if (__builtin_cpu_supports("avx512f"))
+      level = 3;
+#endif
+    coinScanLevel = level;
+  }
+  return coinScanLevel;
+}
+static int 
+coinScanSimd(double * elements, int & start, int end,
+	     int * indices, int room, double tolerance, int type)
+{
+  // zero tolerance when packing would keep zeros so leave to scalar code
+  if (end - start < 16 || (type==3 && !(tolerance>0.0)))
+    return 0;
+  coinSimdLevel();
+#if COIN_INDEXED_SIMD > 1
+  if (coinScanLevel==3)
+    return coinScanAvx512(elements,start,end,indices,tolerance,type);
+#endif
+  if (coinScanLevel==2)
+    return coinScanAvx2(elements,start,end,indices,room,tolerance,type);
+  return 0;
+}
+/* Up to four dot products of x (on index list) with dense y[k] in one
+   sweep using gathers.  Does complete blocks of four and returns number
+   done - caller finishes off. */
+__attribute__((target("avx2"))) static int 
+coinDotsAvx2(const double * COIN_RESTRICT x, const int * COIN_RESTRICT index,
+	     int n, bool packed, int numberY,
+	     const double * const * y, double * result)
+{
+  __m256d sum0 = _mm256_setzero_pd();
+  __m256d sum1 = _mm256_setzero_pd();
+  __m256d sum2 = _mm256_setzero_pd();
+  __m256d sum3 = _mm256_setzero_pd();
+  const double * y0 = y[0];
+  const double * y1 = numberY>1 ? y[1] : y0;
+  const double * y2 = numberY>2 ? y[2] : y0;
+  const double * y3 = numberY>3 ? y[3] : y0;
+  int i = 0;
+  for ( ; i + 4 <= n; i += 4) {
+    __m128i which = _mm_loadu_si128(reinterpret_cast<const __m128i *>(index+i));
+    __m256d value = packed ? _mm256_loadu_pd(x+i) 
+      : _mm256_i32gather_pd(x,which,8);
+    sum0 = _mm256_add_pd(sum0,_mm256_mul_pd(value,
+					    _mm256_i32gather_pd(y0,which,8)));
+    if (numberY>1)
+      sum1 = _mm256_add_pd(sum1,_mm256_mul_pd(value,
+					      _mm256_i32gather_pd(y1,which,8)));
+    if (numberY>2)
+      sum2 = _mm256_add_pd(sum2,_mm256_mul_pd(value,
+					      _mm256_i32gather_pd(y2,which,8)));
+    if (numberY>3)
+      sum3 = _mm256_add_pd(sum3,_mm256_mul_pd(value,
+					      _mm256_i32gather_pd(y3,which,8)));
+  }
+  __m256d sum[4] = {sum0,sum1,sum2,sum3};
+  for (int k = 0; k < numberY; k++) {
+    double part[4];
+    _mm256_storeu_pd(part,sum[k]);
+    result[k] = (part[0]+part[1])+(part[2]+part[3]);
+  }
+  return i;
+}
+/* First position from start on (complete blocks of four only) with
+   score above threshold - start of last incomplete block if none */
+__attribute__((target("avx2"))) static int 
+coinNextAboveAvx2(const double * COIN_RESTRICT score, int start, int end,
+		  double threshold)
+{
+  const __m256d limit = _mm256_set1_pd(threshold);
+  int i = start;
+  for ( ; i + 4 <= end; i += 4) {
+    int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(score+i),
+						limit,_CMP_GT_OQ));
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+  return i;
+}
+#endif
+// First position from start on with score above threshold (end if none)
+static inline int 
+coinNextAbove(const double * COIN_RESTRICT score, int start, int end,
+	      double threshold, bool simd)
+{
+  int i = start;
+#if COIN_INDEXED_SIMD
+  if (simd) {
+    i = coinNextAboveAvx2(score,start,end,threshold);
+    if (i+4<=end)
+      return i;
+  }
+#endif
+  for ( ; i < end; i++) {
+    if (score[i]>threshold)
+      break;
+  }
+  return i;
+}
+/* Largest number entries of n (packed or not) by |value|, or by
+   value*value/weights[index] if weights given, and only those above
+   tolerance.  Indices go in which (and scores in best if not NULL),
+   largest first.  Returns number found */
+static int 
+coinSelectLargest(const double * COIN_RESTRICT elements,
+		  const int * COIN_RESTRICT indices, int n, bool packed,
+		  const double * COIN_RESTRICT weights, double tolerance,
+		  int number, int * COIN_RESTRICT which,
+		  double * COIN_RESTRICT best)
+{
+  if (number<=0||n<=0)
+    return 0;
+  double * COIN_RESTRICT score = new double [n];
+  for (int i=0;i<n;i++) {
+    int j=indices[i];
+    double value = packed ? elements[i] : elements[j];
+    score[i] = weights ? value*value/weights[j] : fabs(value);
+  }
+  typedef CoinPair<double,int> CoinScorePair;
+  std::vector<CoinScorePair> candidates;
+  CoinFirstGreater_2<double,int> greater;
+  if (number*8>=n) {
+    // wanted is large part - partition all candidates
+    candidates.reserve(n);
+    for (int i=0;i<n;i++) {
+      if (score[i]>tolerance)
+	candidates.push_back(CoinScorePair(score[i],i));
+    }
+    if (static_cast<int>(candidates.size())>number) {
+      std::nth_element(candidates.begin(),candidates.begin()+number,
+		       candidates.end(),greater);
+      candidates.erase(candidates.begin()+number,candidates.end());
+    }
+  } else {
+    /* keep best so far in heap (smallest at front) - once full only
+       entries above smallest need looking at and most are skipped
+       four at a time */
+    bool simd = false;
+#if COIN_INDEXED_SIMD
+    simd = coinSimdLevel()>=2;
+#endif
+    candidates.reserve(number);
+    double threshold = tolerance;
+    for (int i=coinNextAbove(score,0,n,threshold,simd);i<n;
+	 i=coinNextAbove(score,i+1,n,threshold,simd)) {
+      if (static_cast<int>(candidates.size())<number) {
+	candidates.push_back(CoinScorePair(score[i],i));
+	std::push_heap(candidates.begin(),candidates.end(),greater);
+	if (static_cast<int>(candidates.size())<number)
+	  continue;
+      } else {
+	std::pop_heap(candidates.begin(),candidates.end(),greater);
+	candidates.back() = CoinScorePair(score[i],i);
+	std::push_heap(candidates.begin(),candidates.end(),greater);
+      }
+      threshold = candidates.front().first;
+    }
+  }
+  std::sort(candidates.begin(),candidates.end(),greater);
+  int numberFound = static_cast<int>(candidates.size());
+  for (int k=0;k<numberFound;k++) {
+    which[k] = indices[candidates[k].second];
+    if (best)
+      best[k] = candidates[k].first;
+  }
+  delete [] score;
+  return numberFound;
+}
 void
 CoinIndexedVector::clear()
 {
@@ -37,6 +382,10 @@ CoinIndexedVector::clear()
     printf("Vector said it had %d nonzeros - but is already empty\n",
 	   nElements_);
 #endif
+  if (bitmap_) {
+    clearBitmap();
+    return;
+  }
   if (!packedMode_) {
     if (3*nElements_<capacity_) {
       int i=0;
@@ -66,6 +415,8 @@ CoinIndexedVector::clear()
 void
 CoinIndexedVector::empty()
 {
+  if (bitmap_)
+    resizeBitmap(0);
   delete [] indices_;
   indices_=NULL;
   if (elements_)
@@ -113,6 +464,8 @@ CoinIndexedVector::copy(const CoinIndexedVector & rhs, double multiplier)
         elements_[index]=value;
         indices_[nElements_++]=index;
       }
+      if (bitmap_)
+	markBitmap();
     } else {
       for (int i=0;i<rhs.nElements_;i++) {
         int index = rhs.indices_[i];
@@ -148,10 +501,14 @@ void
 CoinIndexedVector::borrowVector(int size, int numberIndices, int* inds, double* elems)
 {
   empty();
+  if (bitmap_)
+    resizeBitmap(size);
   capacity_=size;
   nElements_ = numberIndices;
   indices_ = inds;  
   elements_ = elems;
+  if (bitmap_)
+    markBitmap();
   
   // whole point about borrowvector is that it is lightweight so no testing is done
 }
@@ -161,6 +518,8 @@ CoinIndexedVector::borrowVector(int size, int numberIndices, int* inds, double*
 void
 CoinIndexedVector::returnVector()
 {
+  if (bitmap_)
+    resizeBitmap(0);
   indices_=NULL;
   elements_=NULL;
   nElements_ = 0;
@@ -217,6 +576,8 @@ CoinIndexedVector::setFull(int size, const double * elems)
       indices_[nElements_++]=indexValue;
     }
   }
+  if (bitmap_)
+    markBitmap();
 }
 //#############################################################################
 
@@ -266,6 +627,8 @@ CoinIndexedVector::insert( int index, double element )
 #endif
   indices_[nElements_++] = index;
   elements_[index] = element;
+  if (bitmap_)
+    markIndex(index);
 }
 
 //#############################################################################
@@ -290,6 +653,8 @@ CoinIndexedVector::add( int index, double element )
     indices_[nElements_++] = index;
     assert (nElements_<=capacity_);
     elements_[index] = element;
+    if (bitmap_)
+      markIndex(index);
    }
 }
 
@@ -435,6 +800,8 @@ CoinIndexedVector::append(const CoinPackedVectorBase & caboose)
       }
     }
   }
+  if (bitmap_)
+    markBitmap();
   if (numberDuplicates)
     throw CoinError("duplicate index", "append", "CoinIndexedVector");
 }
@@ -461,6 +828,20 @@ CoinIndexedVector::swap(int i, int j)
   indices_[j] = isave;
 }
 
+//-----------------------------------------------------------------------------
+
+void
+CoinIndexedVector::swap(CoinIndexedVector & rhs) 
+{
+  std::swap(indices_,rhs.indices_);
+  std::swap(elements_,rhs.elements_);
+  std::swap(nElements_,rhs.nElements_);
+  std::swap(capacity_,rhs.capacity_);
+  std::swap(offset_,rhs.offset_);
+  std::swap(bitmap_,rhs.bitmap_);
+  std::swap(packedMode_,rhs.packedMode_);
+}
+
 //#############################################################################
 
 void
@@ -560,6 +941,8 @@ CoinIndexedVector::reserve(int n)
     nElements_=nNew;
   } else if (n>capacity_) {
     
+    if (bitmap_)
+      resizeBitmap(n);
     // save pointers to existing data
     int * tempIndices = indices_;
     double * tempElements = elements_;
@@ -608,6 +991,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {
 }
@@ -619,6 +1003,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {
   // Get space
@@ -634,6 +1019,7 @@ CoinIndexedVector::CoinIndexedVector(int size,
   nElements_(0),
   capacity_(0),
   offset_(0),
+  bitmap_(NULL),
   packedMode_(false)
 {
   gutsOfSetVector(size, inds, elems);
@@ -648,6 +1034,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {
 gutsOfSetConstant(size, inds, value);
@@ -661,6 +1048,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {
   setFull(size, element);
@@ -674,6 +1062,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {  
   gutsOfSetVector(rhs.getNumElements(), 
@@ -688,6 +1077,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {
   if (!rhs.packedMode_)
@@ -704,6 +1094,7 @@ elements_(NULL),
 nElements_(0),
 capacity_(0),
 offset_(0),
+bitmap_(NULL),
 packedMode_(false)
 {  
   if (!rhs->packedMode_)
@@ -714,8 +1105,34 @@ packedMode_(false)
 
 //-----------------------------------------------------------------------------
 
+#if COIN_HAS_MOVE
+CoinIndexedVector::CoinIndexedVector(CoinIndexedVector && rhs) COIN_NOEXCEPT :
+indices_(NULL),
+elements_(NULL),
+nElements_(0),
+capacity_(0),
+offset_(0),
+bitmap_(NULL),
+packedMode_(false)
+{  
+  swap(rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+CoinIndexedVector &
+CoinIndexedVector::operator=(CoinIndexedVector && rhs) COIN_NOEXCEPT
+{
+  swap(rhs);
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+#endif
+
 CoinIndexedVector::~CoinIndexedVector ()
 {
+  delete [] bitmap_;
   delete [] indices_;
   if (elements_)
     delete [] (elements_-offset_);
@@ -1038,6 +1455,8 @@ CoinIndexedVector::gutsOfSetVector(int size,
       }
     }
   }
+  if (bitmap_)
+    markBitmap();
   if (numberDuplicates)
     throw CoinError("duplicate index", "setVector", "CoinIndexedVector");
 }
@@ -1098,6 +1517,8 @@ CoinIndexedVector::gutsOfSetVector(int size, int numberIndices,
       }
     }
   }
+  if (bitmap_)
+    markBitmap();
   if (numberDuplicates)
     throw CoinError("duplicate index", "setVector", "CoinIndexedVector");
 }
@@ -1195,6 +1616,8 @@ CoinIndexedVector::gutsOfSetConstant(int size,
       }
     }
   }
+  if (bitmap_)
+    markBitmap();
   if (numberDuplicates)
     throw CoinError("duplicate index", "setConstant", "CoinIndexedVector");
 }
@@ -1250,6 +1673,8 @@ CoinIndexedVector::append(const CoinIndexedVector & caboose)
       }
     }
   }
+  if (bitmap_)
+    markBitmap();
   if (numberDuplicates)
     throw CoinError("duplicate index", "append", "CoinIndexedVector");
 }
@@ -1329,6 +1754,8 @@ CoinIndexedVector::append(CoinIndexedVector & other,int adjustIndex, bool zapEle
   nElements_ += cs;
   if (zapElements)
     other.nElements_=0;
+  if (bitmap_)
+    markBitmap(nElements_-cs);
 }
 #ifndef CLP_NO_VECTOR
 /* Equal. Returns true if vectors have same length and corresponding
@@ -1570,10 +1997,16 @@ CoinIndexedVector::scan(int start, int end)
   int i;
   int number = 0;
   int * indices = indices_+nElements_;
+#if COIN_INDEXED_SIMD
+  number = coinScanSimd(elements_,start,end,indices,
+			capacity_-nElements_,0.0,0);
+#endif
   for (i=start;i<end;i++) 
     if (elements_[i])
       indices[number++] = i;
   nElements_ += number;
+  if (bitmap_)
+    markBitmap(nElements_-number);
   return number;
 }
 // Scan dense region and set up indices with tolerance
@@ -1593,6 +2026,10 @@ CoinIndexedVector::scan(int start, int end, double tolerance)
   int i;
   int number = 0;
   int * indices = indices_+nElements_;
+#if COIN_INDEXED_SIMD
+  number = coinScanSimd(elements_,start,end,indices,
+			capacity_-nElements_,tolerance,1);
+#endif
   for (i=start;i<end;i++) {
     double value = elements_[i];
     if (value) {
@@ -1603,6 +2040,8 @@ CoinIndexedVector::scan(int start, int end, double tolerance)
     }
   }
   nElements_ += number;
+  if (bitmap_)
+    markBitmap(nElements_-number);
   return number;
 }
 // These pack down
@@ -1688,6 +2127,10 @@ CoinIndexedVector::scanAndPack(int start, int end)
   int i;
   int number = 0;
   int * indices = indices_+nElements_;
+#if COIN_INDEXED_SIMD
+  number = coinScanSimd(elements_,start,end,indices,
+			capacity_-nElements_,0.0,2);
+#endif
   for (i=start;i<end;i++) {
     double value = elements_[i];
     elements_[i]=0.0;
@@ -1717,6 +2160,10 @@ CoinIndexedVector::scanAndPack(int start, int end, double tolerance)
   int i;
   int number = 0;
   int * indices = indices_+nElements_;
+#if COIN_INDEXED_SIMD
+  number = coinScanSimd(elements_,start,end,indices,
+			capacity_-nElements_,tolerance,3);
+#endif
   for (i=start;i<end;i++) {
     double value = elements_[i];
     elements_[i]=0.0;
@@ -1733,19 +2180,58 @@ CoinIndexedVector::scanAndPack(int start, int end, double tolerance)
 void 
 CoinIndexedVector::expand()
 {
-  if (nElements_&&packedMode_) {
-    double * temp = new double[capacity_];
-    int i;
-    for (i=0;i<nElements_;i++) 
-      temp[indices_[i]]=elements_[i];
-    CoinZeroN(elements_,nElements_);
-    for (i=0;i<nElements_;i++) {
-      int iRow = indices_[i];
-      elements_[iRow]=temp[iRow];
-    }
-    delete [] temp;
+  if (packedMode_)
+    makeUnpacked();
+  else if (bitmap_)
+    markBitmap();
+}
+// Converts to packed mode keeping values
+void 
+CoinIndexedVector::makePacked()
+{
+  if (packedMode_)
+    return;
+  COIN_COUNT("indexed.pack");
+  packedMode_=true;
+  if (!nElements_)
+    return;
+  // packed positions may be unpacked positions of other elements
+  double * temp = new double[nElements_];
+  int i;
+  for (i=0;i<nElements_;i++) {
+    int iRow = indices_[i];
+    temp[i]=elements_[iRow];
+    elements_[iRow]=0.0;
   }
+  CoinMemcpyN(temp,nElements_,elements_);
+  delete [] temp;
+}
+// Converts to unpacked mode keeping values
+void 
+CoinIndexedVector::makeUnpacked()
+{
+  if (!packedMode_)
+    return;
+  COIN_COUNT("indexed.unpack");
   packedMode_=false;
+  if (!nElements_)
+    return;
+  double * temp = CoinCopyOfArray(elements_,nElements_);
+  CoinZeroN(elements_,nElements_);
+  for (int i=0;i<nElements_;i++) 
+    elements_[indices_[i]]=temp[i];
+  delete [] temp;
+  if (bitmap_)
+    markBitmap();
+}
+// Converts to whichever mode suits density
+void 
+CoinIndexedVector::adaptMode()
+{
+  if ((nElements_<<4)<capacity_)
+    makePacked();
+  else
+    makeUnpacked();
 }
 // Create packed array
 void 
@@ -1769,6 +2255,8 @@ CoinIndexedVector::createUnpacked(int number, const int * indices,
     indices_[i]=iRow;
     elements_[iRow]=elements[i];
   }
+  if (bitmap_)
+    markBitmap();
 }
 // Create unpacked singleton
 void 
@@ -1778,6 +2266,202 @@ CoinIndexedVector::createOneUnpackedElement(int index, double element)
   packedMode_=false;
   indices_[0]=index;
   elements_[index]=element;
+  if (bitmap_)
+    markIndex(index);
+}
+//#############################################################################
+// Dot products with several dense arrays in one sweep
+void 
+CoinIndexedVector::dotProducts(int numberArrays, const double * const * arrays,
+			       double * results) const
+{
+  const double * COIN_RESTRICT x = elements_;
+  const int * COIN_RESTRICT index = indices_;
+  int n = nElements_;
+  for (int base=0;base<numberArrays;base+=4) {
+    int numberY = CoinMin(numberArrays-base,4);
+    const double * const * y = arrays+base;
+    double sum[4]={0.0,0.0,0.0,0.0};
+    int i=0;
+#if COIN_INDEXED_SIMD
+    // gathers only pay when there is something to amortize them over
+    if (n>=64&&coinSimdLevel()>=2)
+      i = coinDotsAvx2(x,index,n,packedMode_,numberY,y,sum);
+#endif
+    if (numberY==1) {
+      const double * COIN_RESTRICT y0 = y[0];
+      for (;i<n;i++) {
+	int j=index[i];
+	sum[0] += (packedMode_ ? x[i] : x[j])*y0[j];
+      }
+    } else {
+      for (;i<n;i++) {
+	int j=index[i];
+	double value = packedMode_ ? x[i] : x[j];
+	for (int k=0;k<numberY;k++)
+	  sum[k] += value*y[k][j];
+      }
+    }
+    for (int k=0;k<numberY;k++)
+      results[base+k]=sum[k];
+  }
+}
+// y += alpha * this and dot product with z in one sweep
+double 
+CoinIndexedVector::axpyDot(double alpha, double * y, const double * z) const
+{
+  const double * COIN_RESTRICT x = elements_;
+  const int * COIN_RESTRICT index = indices_;
+  int n = nElements_;
+  double sum=0.0;
+  if (packedMode_) {
+    for (int i=0;i<n;i++) {
+      int j=index[i];
+      double value = x[i];
+      sum += value*z[j];
+      y[j] += alpha*value;
+    }
+  } else {
+    for (int i=0;i<n;i++) {
+      int j=index[i];
+      double value = x[j];
+      sum += value*z[j];
+      y[j] += alpha*value;
+    }
+  }
+  return sum;
+}
+// Largest entries without sorting whole vector
+int 
+CoinIndexedVector::selectLargest(int number, int * which,
+				 const double * weights, double tolerance) const
+{
+  return coinSelectLargest(elements_,indices_,nElements_,packedMode_,
+			   weights,tolerance,number,which,NULL);
+}
+//#############################################################################
+// Position of lowest set bit (word must be nonzero)
+static inline int 
+coinLowestBit(CoinUInt64 word)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#else
+  int n=0;
+  while (!(word&1)) {
+    word >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+// Switch bitmap on or off
+void 
+CoinIndexedVector::setBitmap(bool yesNo)
+{
+  if (yesNo) {
+    if (!bitmap_) {
+      int numberWords = (capacity_+63)>>6;
+      bitmap_ = new CoinUInt64 [numberWords+1];
+      CoinZeroN(bitmap_,numberWords+1);
+      markBitmap();
+    }
+  } else {
+    delete [] bitmap_;
+    bitmap_=NULL;
+  }
+}
+// Mark entries from first in index list in bitmap
+void 
+CoinIndexedVector::markBitmap(int first)
+{
+  if (packedMode_)
+    return;
+  const int * COIN_RESTRICT indices = indices_;
+  CoinUInt64 * COIN_RESTRICT bitmap = bitmap_;
+  for (int i=first;i<nElements_;i++) {
+    int index = indices[i];
+    bitmap[index>>6] |= static_cast<CoinUInt64>(1)<<(index&63);
+  }
+}
+// Resize bitmap (before capacity_ changes)
+void 
+CoinIndexedVector::resizeBitmap(int newCapacity)
+{
+  int numberWords = (newCapacity+63)>>6;
+  CoinUInt64 * bitmap = new CoinUInt64 [numberWords+1];
+  CoinZeroN(bitmap,numberWords+1);
+  // only keep if growing - bits must never be beyond capacity
+  if (newCapacity>=capacity_)
+    CoinMemcpyN(bitmap_,(capacity_+63)>>6,bitmap);
+  delete [] bitmap_;
+  bitmap_=bitmap;
+}
+// Clear using bitmap
+void 
+CoinIndexedVector::clearBitmap()
+{
+  double * COIN_RESTRICT elements = elements_;
+  CoinUInt64 * COIN_RESTRICT bitmap = bitmap_;
+  int numberWords = (capacity_+63)>>6;
+  if (packedMode_) {
+    CoinZeroN(elements,nElements_);
+    CoinZeroN(bitmap,numberWords);
+  } else if (nElements_<numberWords) {
+    // very sparse - go through index list
+    const int * COIN_RESTRICT indices = indices_;
+    for (int i=0;i<nElements_;i++) {
+      int index = indices[i];
+      elements[index]=0.0;
+      bitmap[index>>6]=0;
+    }
+  } else {
+    for (int iWord=0;iWord<numberWords;iWord++) {
+      CoinUInt64 word = bitmap[iWord];
+      if (word) {
+	double * COIN_RESTRICT block = elements+(iWord<<6);
+	bitmap[iWord]=0;
+	while (word) {
+	  block[coinLowestBit(word)]=0.0;
+	  word &= word-1;
+	}
+      }
+    }
+  }
+  nElements_ = 0;
+  packedMode_=false;
+}
+// Set up indices from occupancy bitmap
+int 
+CoinIndexedVector::scanBitmap(double tolerance)
+{
+  assert(!packedMode_&&bitmap_);
+  double * COIN_RESTRICT elements = elements_;
+  int * COIN_RESTRICT indices = indices_;
+  CoinUInt64 * COIN_RESTRICT bitmap = bitmap_;
+  int numberWords = (capacity_+63)>>6;
+  int number=0;
+  for (int iWord=0;iWord<numberWords;iWord++) {
+    CoinUInt64 word = bitmap[iWord];
+    if (word) {
+      CoinUInt64 keep = word;
+      int base = iWord<<6;
+      while (word) {
+	int iBit = coinLowestBit(word);
+	word &= word-1;
+	double value = elements[base+iBit];
+	if (value&&fabs(value)>=tolerance) {
+	  indices[number++]=base+iBit;
+	} else {
+	  elements[base+iBit]=0.0;
+	  keep &= ~(static_cast<CoinUInt64>(1)<<iBit);
+	}
+      }
+      bitmap[iWord]=keep;
+    }
+  }
+  nElements_=number;
+  return number;
 }
 //  Print out
 void 
@@ -1801,30 +2485,64 @@ CoinArrayWithLength::clear()
   assert ((size_>0&&array_)||!array_);
   memset (array_,0,size_);
 }
+/* Arrays of at least this many bytes go on huge pages (0 off).
+   Huge pages are 2MB on x86_64 and for most aarch64 kernels. */
+static CoinBigIndex coinHugePageThreshold = 0;
+#define COIN_HUGE_PAGE (2*1024*1024)
+void 
+CoinArrayWithLength::setHugePageThreshold(CoinBigIndex numberBytes)
+{
+  coinHugePageThreshold = CoinMax(numberBytes,static_cast<CoinBigIndex>(0));
+}
+CoinBigIndex 
+CoinArrayWithLength::hugePageThreshold()
+{
+  return coinHugePageThreshold;
+}
+/* All arrays come from here and go back through coinFreeArray, so
+   alignment and huge pages need no bookkeeping in the arrays */
+static char * 
+coinAlignedArray(CoinBigIndex size, int alignment)
+{
+  size_t align = static_cast<size_t>(1)
+    << CoinMax(alignment,COIN_ARRAY_ALIGNMENT);
+  size_t bytes = size;
+  bool huge = coinHugePageThreshold>0 && size>=coinHugePageThreshold;
+  if (huge) {
+    align = CoinMax(align,static_cast<size_t>(COIN_HUGE_PAGE));
+    bytes = (bytes+COIN_HUGE_PAGE-1) & ~static_cast<size_t>(COIN_HUGE_PAGE-1);
+  }
+  void * array;
+#if defined(_WIN32)
+  array = _aligned_malloc(bytes,align);
+#else
+  if (posix_memalign(&array,align,bytes))
+    array = NULL;
+#endif
+  if (!array)
+    throw std::bad_alloc();
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // only advice - ignore failure (e.g. huge pages switched off)
+  if (huge)
+    madvise(array,bytes,MADV_HUGEPAGE);
+#endif
+  return reinterpret_cast<char *> (array);
+}
+static void 
+coinFreeArray(char * array)
+{
+#if defined(_WIN32)
+  _aligned_free(array);
+#else
+  free(array);
+#endif
+}
 // Get array with alignment
 void 
 CoinArrayWithLength::getArray(int size)
 {
   if (size>0) {
-    if(alignment_>2) {
-      offset_ = 1<<alignment_;
-    } else {
-      offset_=0;
-    }
-    assert (size>0);
-    char * array = new char [size+offset_];
-    if (offset_) {
-      // need offset
-      CoinInt64 xx = reinterpret_cast<CoinInt64>(array);
-      int iBottom = static_cast<int>(xx & ((offset_-1)));
-      if (iBottom)
-	offset_ = offset_-iBottom;
-      else
-	offset_ = 0;
-      array_ = array + offset_;;
-    } else {
-      array_=array;
-    }
+    array_ = coinAlignedArray(size,alignment_);
     if (size_!=-1)
       size_=size;
   } else {
@@ -1836,9 +2554,7 @@ void
 CoinArrayWithLength::conditionalDelete()
 {
   if (size_==-1) {
-    char * charArray = reinterpret_cast<char *> (array_);
-    if (charArray)
-      delete [] (charArray-offset_);
+    coinFreeArray(array_);
     array_=NULL;
   } else if (size_>=0) {
     size_ = -size_-2;
@@ -1848,9 +2564,7 @@ CoinArrayWithLength::conditionalDelete()
 void 
 CoinArrayWithLength::reallyFreeArray()
 {
-  char * charArray = reinterpret_cast<char *> (array_);
-  if (charArray)
-    delete [] (charArray-offset_);
+  coinFreeArray(array_);
   array_=NULL;
   size_=-1;
 }
@@ -1875,8 +2589,10 @@ CoinArrayWithLength::getCapacity(int numberBytes,int numberNeeded)
    If abs(mode) >2 then align on that as power of 2
 */
 CoinArrayWithLength::CoinArrayWithLength(int size, int mode)
+  : array_(NULL),size_(-1),alignment_(COIN_ARRAY_ALIGNMENT)
 {
-  alignment_=abs(mode);
+  if (abs(mode)>2)
+    alignment_=abs(mode);
   getArray(size);
   if (mode>0&&array_) 
     memset(array_,0,size);
@@ -1884,8 +2600,7 @@ CoinArrayWithLength::CoinArrayWithLength(int size, int mode)
 }
 CoinArrayWithLength::~CoinArrayWithLength ()
 { 
-  if (array_)
-    delete [] (array_-offset_); 
+  coinFreeArray(array_);
 }
 // Conditionally gets new array
 char * 
@@ -1903,8 +2618,9 @@ CoinArrayWithLength::conditionalNew(long sizeWanted)
 }
 /* Copy constructor. */
 CoinArrayWithLength::CoinArrayWithLength(const CoinArrayWithLength & rhs)
+  : array_(NULL),size_(rhs.size_),alignment_(rhs.alignment_)
 {
-  assert (capacity()>=0);
+  assert (rhs.capacity()>=0);
   getArray(rhs.capacity());
   if (size_>0)
     CoinMemcpyN(rhs.array_,size_,array_);
@@ -1912,9 +2628,9 @@ CoinArrayWithLength::CoinArrayWithLength(const CoinArrayWithLength & rhs)
 
 /* Copy constructor.2 */
 CoinArrayWithLength::CoinArrayWithLength(const CoinArrayWithLength * rhs)
+  : array_(NULL),size_(rhs->size_),alignment_(rhs->alignment_)
 {
   assert (rhs->capacity()>=0);
-  size_=rhs->size_;
   getArray(rhs->capacity());
   if (size_>0)
     CoinMemcpyN(rhs->array_,size_,array_);
@@ -1962,7 +2678,7 @@ CoinArrayWithLength::allocate(const CoinArrayWithLength & rhs, int numberBytes)
   } else {
     assert (numberBytes>=0);
     if (size_==-1) {
-      delete [] array_;
+      coinFreeArray(array_);
       array_=NULL;
     } else {
       size_=-1;
@@ -1972,7 +2688,7 @@ CoinArrayWithLength::allocate(const CoinArrayWithLength & rhs, int numberBytes)
     assert (numberBytes>=0);
     assert (!array_);
     if (numberBytes)
-      array_ = new char[numberBytes];
+      array_ = coinAlignedArray(numberBytes,alignment_);
   }
 }
 // Does what is needed to set persistence
@@ -2008,9 +2724,6 @@ CoinArrayWithLength::swap(CoinArrayWithLength & other)
   int swapSize = other.size_;
   other.size_=size_;
   size_=swapSize;
-  int swapOffset = other.offset_;
-  other.offset_=offset_;
-  offset_=swapOffset;
 }
 // Extend a persistent array keeping data (size in bytes)
 void 
@@ -2020,10 +2733,11 @@ CoinArrayWithLength::extend(int newSize)
   assert (size_>=0); // not much point otherwise
   if (newSize>size_) {
     char * temp = array_;
+    int oldSize = size_;
     getArray(newSize);
     if (temp) {
-      CoinMemcpyN(array_,size_,temp);
-      delete [] (temp-offset_);
+      CoinMemcpyN(temp,oldSize,array_);
+      coinFreeArray(temp);
     }
     size_=newSize;
   }
@@ -2072,10 +2786,123 @@ CoinPartitionedVector::computeNumberElements()
     nElements_=n;
   }
 }
+//#############################################################################
+/* Partition work for one thread.  Each thread does partitions first to
+   last-1 using only the public interface so nothing is shared but the
+   vector's arrays (in disjoint pieces). */
+typedef enum {
+  partitionScan = 0,
+  partitionClear,
+  partitionGather,
+  partitionScatter,
+  partitionSelect
+} CoinPartitionOperation;
+typedef struct {
+  CoinPartitionedVector * vector;
+  CoinPartitionOperation operation;
+  int first;
+  int last;
+  double tolerance;
+  // for compact - where each partition goes and somewhere to put it
+  const int * offset;
+  int * scratchIndices;
+  double * scratchElements;
+  // for selectLargest - number wanted from each partition and where
+  int number;
+  const double * weights;
+  int * selectWhich;
+  double * selectBest;
+  int * numberSelected;
+} CoinPartitionThread;
+static void * 
+coinPartitionWorker(void * info)
+{
+  CoinPartitionThread * thread = reinterpret_cast<CoinPartitionThread *>(info);
+  CoinPartitionedVector * vector = thread->vector;
+  double * COIN_RESTRICT elements = vector->denseVector();
+  int * COIN_RESTRICT indices = vector->getIndices();
+  for (int i = thread->first; i < thread->last; i++) {
+    int start = vector->startPartition(i);
+    int n = vector->getNumElements(i);
+    int offset = thread->offset ? thread->offset[i] : 0;
+    switch (thread->operation) {
+    case partitionScan:
+      vector->scan(i, thread->tolerance);
+      break;
+    case partitionClear:
+      vector->clearPartition(i);
+      break;
+    case partitionGather:
+      // to scratch and clean up source
+      CoinMemcpyN(indices + start, n, thread->scratchIndices + offset);
+      CoinMemcpyN(elements + start, n, thread->scratchElements + offset);
+      CoinZeroN(elements + start, n);
+      break;
+    case partitionScatter:
+      CoinMemcpyN(thread->scratchIndices + offset, n, indices + offset);
+      CoinMemcpyN(thread->scratchElements + offset, n, elements + offset);
+      break;
+    case partitionSelect:
+      thread->numberSelected[i] = 
+	coinSelectLargest(elements + start, indices + start, n, true,
+			  thread->weights, thread->tolerance, thread->number,
+			  thread->selectWhich + i * thread->number,
+			  thread->selectBest + i * thread->number);
+      break;
+    }
+  }
+  return NULL;
+}
+// Splits partitions between threads and runs them on shared pool
+static void 
+coinPartitionRun(CoinPartitionThread & base, int numberPartitions,
+		 int numberThreads)
+{
+  numberThreads = CoinMax(CoinMin(numberThreads, numberPartitions), 1);
+#ifndef COINUTILS_PTHREADS
+  numberThreads = 1;
+#endif
+  CoinPartitionThread thread[COIN_PARTITIONS];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i] = base;
+    thread[i].first = (i * numberPartitions) / numberThreads;
+    thread[i].last = ((i + 1) * numberPartitions) / numberThreads;
+  }
+  CoinThreadPool::run(coinPartitionWorker, thread,
+    sizeof(CoinPartitionThread), numberThreads);
+}
 // Add up number of elements in partitions and pack and get rid of partitions
 void 
-CoinPartitionedVector::compact()
+CoinPartitionedVector::compact(int numberThreads)
 {
+  if (numberPartitions_&&numberThreads>1) {
+    // prefix sum gives where each partition ends up
+    int offset[COIN_PARTITIONS+1];
+    offset[0]=0;
+    for (int i=0;i<numberPartitions_;i++)
+      offset[i+1]=offset[i]+numberElementsPartition_[i];
+    int n=offset[numberPartitions_];
+    // partitions may overlap where others go so go via scratch
+    int * scratchIndices = new int [n+1];
+    double * scratchElements = new double [n+1];
+    CoinPartitionThread base;
+    memset(&base,0,sizeof(base));
+    base.vector=this;
+    base.offset=offset;
+    base.scratchIndices=scratchIndices;
+    base.scratchElements=scratchElements;
+    base.operation=partitionGather;
+    coinPartitionRun(base,numberPartitions_,numberThreads);
+    base.operation=partitionScatter;
+    coinPartitionRun(base,numberPartitions_,numberThreads);
+    delete [] scratchIndices;
+    delete [] scratchElements;
+    memset(numberElementsPartition_,0,numberPartitions_*sizeof(int));
+    nElements_=n;
+    packedMode_=true;
+    numberPartitions_=0;
+    return;
+  }
   if (numberPartitions_) {
     int n=numberElementsPartition_[0];
     numberElementsPartition_[0]=0;
@@ -2139,15 +2966,12 @@ CoinPartitionedVector::setPartitions(int number,const int * starts)
 }
 // Reset the vector (as if were just created an empty vector). Gets rid of partitions
 void 
-CoinPartitionedVector::clearAndReset()
+CoinPartitionedVector::clearAndReset(int numberThreads)
 {
   if (numberPartitions_) {
     assert (packedMode_||!nElements_);
-    for (int i=0;i<numberPartitions_;i++) {
-      int n=numberElementsPartition_[i];
-      memset(elements_+startPartition_[i],0,n*sizeof(double));
-      numberElementsPartition_[i]=0;
-    }
+    packedMode_=true;
+    clearAndKeep(numberThreads);
   } else {
     memset(elements_,0,nElements_*sizeof(double));
   }
@@ -2158,13 +2982,21 @@ CoinPartitionedVector::clearAndReset()
 }
 // Reset the vector (as if were just created an empty vector). Keeps partitions
 void 
-CoinPartitionedVector::clearAndKeep()
+CoinPartitionedVector::clearAndKeep(int numberThreads)
 {
   assert (packedMode_);
-  for (int i=0;i<numberPartitions_;i++) {
-    int n=numberElementsPartition_[i];
-    memset(elements_+startPartition_[i],0,n*sizeof(double));
-    numberElementsPartition_[i]=0;
+  if (numberThreads>1) {
+    CoinPartitionThread base;
+    memset(&base,0,sizeof(base));
+    base.vector=this;
+    base.operation=partitionClear;
+    coinPartitionRun(base,numberPartitions_,numberThreads);
+  } else {
+    for (int i=0;i<numberPartitions_;i++) {
+      int n=numberElementsPartition_[i];
+      memset(elements_+startPartition_[i],0,n*sizeof(double));
+      numberElementsPartition_[i]=0;
+    }
   }
   nElements_=0;
 }
@@ -2271,6 +3103,72 @@ CoinPartitionedVector::scan(int partition, double tolerance)
   numberElementsPartition_[partition]=n;
   return n;
 }
+// Scan all partitions (returns number found)
+int 
+CoinPartitionedVector::scanAll(double tolerance, int numberThreads)
+{
+  assert (packedMode_);
+  if (numberThreads>1) {
+    CoinPartitionThread base;
+    memset(&base,0,sizeof(base));
+    base.vector=this;
+    base.operation=partitionScan;
+    base.tolerance=tolerance;
+    coinPartitionRun(base,numberPartitions_,numberThreads);
+  } else {
+    for (int i=0;i<numberPartitions_;i++)
+      scan(i,tolerance);
+  }
+  computeNumberElements();
+  return nElements_;
+}
+// Largest entries - best of each partition and then best of those
+int 
+CoinPartitionedVector::selectLargest(int number, int * which,
+				     const double * weights, double tolerance,
+				     int numberThreads) const
+{
+  if (!numberPartitions_)
+    return CoinIndexedVector::selectLargest(number,which,weights,tolerance);
+  if (number<=0)
+    return 0;
+  assert (packedMode_);
+  int * selectWhich = new int [numberPartitions_*number];
+  double * selectBest = new double [numberPartitions_*number];
+  int numberSelected[COIN_PARTITIONS];
+  CoinPartitionThread base;
+  memset(&base,0,sizeof(base));
+  // workers only read
+  base.vector=const_cast<CoinPartitionedVector *>(this);
+  base.operation=partitionSelect;
+  base.tolerance=tolerance;
+  base.number=number;
+  base.weights=weights;
+  base.selectWhich=selectWhich;
+  base.selectBest=selectBest;
+  base.numberSelected=numberSelected;
+  coinPartitionRun(base,numberPartitions_,numberThreads);
+  typedef CoinPair<double,int> CoinScorePair;
+  std::vector<CoinScorePair> candidates;
+  for (int i=0;i<numberPartitions_;i++) {
+    for (int k=0;k<numberSelected[i];k++)
+      candidates.push_back(CoinScorePair(selectBest[i*number+k],
+					 i*number+k));
+  }
+  CoinFirstGreater_2<double,int> greater;
+  if (static_cast<int>(candidates.size())>number) {
+    std::nth_element(candidates.begin(),candidates.begin()+number,
+		     candidates.end(),greater);
+    candidates.erase(candidates.begin()+number,candidates.end());
+  }
+  std::sort(candidates.begin(),candidates.end(),greater);
+  int numberFound = static_cast<int>(candidates.size());
+  for (int k=0;k<numberFound;k++)
+    which[k] = selectWhich[candidates[k].second];
+  delete [] selectWhich;
+  delete [] selectBest;
+  return numberFound;
+}
 //  Print out
 void 
 CoinPartitionedVector::print() const
@@ -2310,3 +3208,107 @@ CoinPartitionedVector::sort()
     CoinSort_2(indices,indices+numberElementsPartition_[partition],elements);
   }
 }
+//#############################################################################
+CoinIndexedVectorPool::CoinIndexedVectorPool(int maximumPerSize)
+  : maximumPerSize_(maximumPerSize),
+    numberHits_(0),
+    numberMisses_(0)
+{
+}
+CoinIndexedVectorPool::~CoinIndexedVectorPool()
+{
+  clear();
+}
+// Clean vector with capacity at least capacity
+CoinIndexedVector * 
+CoinIndexedVectorPool::get(int capacity)
+{
+  std::map<int, std::vector<CoinIndexedVector *> >::iterator it =
+    free_.lower_bound(capacity);
+  // only take one which is not too big (it might be memset later)
+  for (;it!=free_.end()&&it->first<=2*capacity+16;++it) {
+    if (!it->second.empty()) {
+      CoinIndexedVector * vector = it->second.back();
+      it->second.pop_back();
+      numberHits_++;
+      return vector;
+    }
+  }
+  numberMisses_++;
+  CoinIndexedVector * vector = new CoinIndexedVector();
+  vector->reserve(capacity);
+  return vector;
+}
+// Give vector (from get or new) back to pool
+void 
+CoinIndexedVectorPool::release(CoinIndexedVector * vector)
+{
+  if (!vector)
+    return;
+  // user should have cleaned - this is cheap if so
+  if (vector->getNumElements())
+    vector->clear();
+  vector->setPackedMode(false);
+#ifndef NDEBUG
+  vector->checkClear();
+#endif
+  if (vector->capacity()) {
+    std::vector<CoinIndexedVector *> & pooled = free_[vector->capacity()];
+    if (static_cast<int>(pooled.size())<maximumPerSize_) {
+      pooled.push_back(vector);
+      return;
+    }
+  }
+  delete vector;
+}
+// Delete all pooled vectors
+void 
+CoinIndexedVectorPool::clear()
+{
+  std::map<int, std::vector<CoinIndexedVector *> >::iterator it;
+  for (it=free_.begin();it!=free_.end();++it) {
+    for (size_t i=0;i<it->second.size();i++)
+      delete it->second[i];
+  }
+  free_.clear();
+}
+// Number of vectors currently in pool
+int 
+CoinIndexedVectorPool::numberPooled() const
+{
+  int n=0;
+  std::map<int, std::vector<CoinIndexedVector *> >::const_iterator it;
+  for (it=free_.begin();it!=free_.end();++it)
+    n += static_cast<int>(it->second.size());
+  return n;
+}
+#ifdef COINUTILS_PTHREADS
+static pthread_key_t coinPoolKey;
+static pthread_once_t coinPoolOnce = PTHREAD_ONCE_INIT;
+static void coinDeletePool(void * pool)
+{
+  delete reinterpret_cast<CoinIndexedVectorPool *> (pool);
+}
+static void coinCreatePoolKey()
+{
+  pthread_key_create(&coinPoolKey,coinDeletePool);
+}
+#endif
+// Pool for this thread (deleted when thread exits)
+CoinIndexedVectorPool * 
+CoinIndexedVectorPool::threadPool()
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_once(&coinPoolOnce,coinCreatePoolKey);
+  CoinIndexedVectorPool * pool = reinterpret_cast<CoinIndexedVectorPool *>
+    (pthread_getspecific(coinPoolKey));
+  if (!pool) {
+    pool = new CoinIndexedVectorPool();
+    pthread_setspecific(coinPoolKey,pool);
+  }
+  return pool;
+#else
+  static CoinIndexedVectorPool pool;
+  return &pool;
+#endif
+}
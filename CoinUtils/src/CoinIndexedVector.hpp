@@ -12,7 +12,9 @@
 #endif
 
 #include <map>
+#include <vector>
 #include "CoinFinite.hpp"
+#include "CoinTypes.hpp"
 #ifndef CLP_NO_VECTOR
 #include "CoinPackedVectorBase.hpp"
 #endif
@@ -196,6 +198,8 @@ public:
 		 indices_[nElements_++] = index;
 		 assert (nElements_<=capacity_);
 		 elements_[index] = element;
+		 if (bitmap_)
+		   markIndex(index);
 	       }
    /** Insert or if exists add an element into the vector
        Any resulting zero elements will be made tiny */
@@ -216,6 +220,8 @@ public:
 		   indices_[nElements_++] = index;
 		   assert (nElements_<=capacity_);
 		   elements_[index] = element;
+		   if (bitmap_)
+		     markIndex(index);
 		 }
 	       }
    /** Insert or if exists add an element into the vector
@@ -236,6 +242,8 @@ public:
 		   indices_[nElements_++] = index;
 		   assert (nElements_<=capacity_);
 		   elements_[index] = element;
+		   if (bitmap_)
+		     markIndex(index);
 		 }
 	       }
    /** Makes nonzero tiny.
@@ -277,6 +285,10 @@ public:
        returns number found.  Only >= tolerance
    */
    int scan(int start, int end, double tolerance);
+   /** Set up indices in increasing order from occupancy bitmap (only
+       touches dense entries whose bits are set).  Only ones >= tolerance
+       are kept - others are zeroed.  Returns number found */
+   int scanBitmap(double tolerance=0.0);
    /// These are same but pack down
    int scanAndPack();
    int scanAndPack(int start, int end);
@@ -303,6 +315,8 @@ public:
 
    /// Swap values in positions i and j of indices and elements
    void swap(int i, int j); 
+   /// Exchange contents with \p rhs (no copying)
+   void swap(CoinIndexedVector & rhs); 
 
    /// Throw away all entries in rows >= newSize
    void truncate(int newSize); 
@@ -321,6 +335,31 @@ public:
    void operator/=(double value);
    //@}
 
+   /**@name Fused kernels
+
+   These go through the index list once however many dense arrays are
+   involved, so there is only one pass over this vector.  Dense arrays
+   are indexed as the full storage vector (packed mode is allowed).
+   */
+   //@{
+   /** results[k] = this . arrays[k] for k < numberArrays.  Done four
+       arrays at a time (with gathers if AVX2 is available) */
+   void dotProducts(int numberArrays, const double * const * arrays,
+		    double * results) const;
+   /** Returns this . z while doing y += alpha * this.  z is read before
+       y is updated so z may be y */
+   double axpyDot(double alpha, double * y, const double * z) const;
+   /** Finds the number largest entries by absolute value, or by
+       value*value/weights[index] if weights given (as for steepest edge
+       pricing), ignoring any not above tolerance.  Their indices go in
+       which, largest first, and number found is returned (ties in any
+       order).  Does not sort the whole vector - a heap of the best so far
+       when few are wanted (most entries are then skipped four at a time
+       against its smallest) or nth_element when many */
+   int selectLargest(int number, int * which,
+		     const double * weights=NULL, double tolerance=0.0) const;
+   //@}
+
    /**@name Comparison operators on two indexed vectors */
    //@{
 #ifndef CLP_NO_VECTOR
@@ -350,12 +389,15 @@ public:
 
    /**@name Sorting */
    //@{ 
-   /** Sort the indexed storage vector (increasing indices). */
+   /** Sort the indexed storage vector (increasing indices).
+       If not packed and there is a bitmap which is not very sparse then
+       indices are regenerated from bitmap */
    void sort()
-   { std::sort(indices_,indices_+nElements_); }
+   { if (bitmap_&&!packedMode_&&(nElements_<<6)>capacity_) scanBitmap();
+     else std::sort(indices_,indices_+nElements_); }
 
    void sortIncrIndex()
-   { std::sort(indices_,indices_+nElements_); }
+   { sort(); }
 
    void sortDecrIndex();
   
@@ -426,6 +468,44 @@ void operator/=(const CoinIndexedVector& op2);
    /// Gets packed mode
    inline bool packedMode() const
    { return packedMode_;}
+   /** Converts to packed mode keeping values (unlike setPackedMode which
+       just changes flag).  Costs O(number of elements) - nothing if
+       already packed */
+   void makePacked();
+   /// Converts to unpacked mode keeping values (as makePacked)
+   void makeUnpacked();
+   /** Converts to whichever mode suits density - packed if fewer than
+       one in sixteen entries are in use, otherwise unpacked */
+   void adaptMode();
+   //@}
+
+   /**@name Occupancy bitmap
+
+   Optionally one bit per dense entry can be kept.  It is for vectors of
+   middling density (say 5-30%) where it is cheaper to go through bitmap
+   words than either the whole dense array or an unsorted index list -
+   clear() and scanBitmap() (and so sort()) then only touch entries whose
+   bits are set.  Bits are only meaningful when not packed.
+
+   Every entry in index list has its bit set (there may be a few more).
+   Methods which add indices keep this true, but if the dense vector
+   is written directly then either scan() (which marks what it finds)
+   or markIndex() must be used.
+   */
+   //@{
+   /// Switch bitmap on or off
+   void setBitmap(bool yesNo);
+   /// Whether there is a bitmap
+   inline bool hasBitmap() const
+   { return bitmap_!=NULL; }
+   /// Bitmap (64 entries per word) or NULL
+   inline const CoinUInt64 * bitmap() const
+   { return bitmap_; }
+   /// Mark entry in bitmap (which must exist)
+   inline void markIndex(int index)
+   { bitmap_[index>>6] |= static_cast<CoinUInt64>(1)<<(index&63); }
+   /// Mark entries from first in index list in bitmap
+   void markBitmap(int first=0);
    //@}
 
    /**@name Constructors and destructors */
@@ -445,6 +525,13 @@ void operator/=(const CoinIndexedVector& op2);
    CoinIndexedVector(const CoinIndexedVector &);
    /** Copy constructor.2 */
    CoinIndexedVector(const CoinIndexedVector *);
+#if COIN_HAS_MOVE
+   /** Move constructor.  Takes the arrays of \p rhs, which is left
+       empty with no capacity. */
+   CoinIndexedVector(CoinIndexedVector && rhs) COIN_NOEXCEPT;
+   /** Move assignment (exchanges contents with \p rhs). */
+   CoinIndexedVector & operator=(CoinIndexedVector && rhs) COIN_NOEXCEPT;
+#endif
 #ifndef CLP_NO_VECTOR
    /** Copy constructor <em>from a PackedVectorBase</em>. */
    CoinIndexedVector(const CoinPackedVectorBase & rhs);
@@ -466,6 +553,10 @@ private:
    ///
    void gutsOfSetConstant(int size,
 			  const int * inds, double value);
+   /// Resize bitmap (before capacity_ changes)
+   void resizeBitmap(int newCapacity);
+   /// Clear using bitmap
+   void clearBitmap();
    //@}
 
 protected:
@@ -481,6 +572,8 @@ protected:
    int capacity_;
    ///  Offset to get where new allocated array
    int offset_;
+   /// Occupancy bitmap (NULL if off)
+   CoinUInt64 * bitmap_;
    /// If true then is operating in packed mode
    bool packedMode_;
    //@}
@@ -509,7 +602,15 @@ CoinIndexedVectorUnitTest();
     and updates number of bytes
     CoinConditionalDelete sets number of bytes = -size-2 and then array 
     returns NULL
+
+    Arrays are aligned on at least COIN_ARRAY_ALIGNMENT (as a power of 2,
+    default 64 bytes) so they can be used with aligned SIMD loads.  Arrays
+    of at least hugePageThreshold() bytes are also aligned on 2MB and
+    (on Linux) advised to use transparent huge pages.
 */
+#ifndef COIN_ARRAY_ALIGNMENT
+#define COIN_ARRAY_ALIGNMENT 6
+#endif
 class CoinArrayWithLength {
   
 public:
@@ -543,8 +644,9 @@ public:
   /// Set the size to -1
   inline void switchOff() 
   { size_ = -1; }
-  /// Set the size to -2 and alignment
-  inline void switchOn(int alignment=3) 
+  /** Set the size to -2 and alignment (power of 2 - never less than
+      COIN_ARRAY_ALIGNMENT) */
+  inline void switchOn(int alignment=COIN_ARRAY_ALIGNMENT) 
   { size_ = -2; alignment_=alignment;}
   /// Does what is needed to set persistence
   void setPersistence(int flag,int currentLength);
@@ -563,17 +665,26 @@ public:
   /// Conditionally deletes
   void conditionalDelete();
   //@}
+
+  /**@name Huge page policy (shared by all arrays) */
+  //@{
+  /** Arrays of at least this many bytes are aligned on 2MB and advised
+      to use huge pages.  0 (default) switches this off */
+  static void setHugePageThreshold(CoinBigIndex numberBytes);
+  /// Get huge page threshold
+  static CoinBigIndex hugePageThreshold();
+  //@}
   
   /**@name Constructors and destructors */
   //@{
   /** Default constructor - NULL*/
   inline CoinArrayWithLength()
-    : array_(NULL),size_(-1),offset_(0),alignment_(0)
+    : array_(NULL),size_(-1),alignment_(COIN_ARRAY_ALIGNMENT)
   { }
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinArrayWithLength(int size)
-    : size_(-1),offset_(0),alignment_(0)
-  { array_=new char [size];}
+    : array_(NULL),size_(-1),alignment_(COIN_ARRAY_ALIGNMENT)
+  { getArray(size);}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       mode>0 size_ set to size and zeroed
@@ -608,8 +719,6 @@ protected:
   char * array_;
   /// Size of array in bytes
   CoinBigIndex size_;
-  /// Offset of array
-  int offset_;
   /// Alignment wanted (power of 2)
   int alignment_;
   //@}
@@ -650,7 +759,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinDoubleArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(double)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(double));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -704,7 +813,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinFactorizationDoubleArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(CoinFactorizationDouble)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(CoinFactorizationDouble));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -758,7 +867,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinFactorizationLongDoubleArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(long double)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(long double));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -776,6 +885,60 @@ public:
   { CoinArrayWithLength::operator=(rhs);  return *this;}
   //@}
 };
+/// float * version
+
+class CoinFloatArrayWithLength : public CoinArrayWithLength {
+  
+public:
+  /**@name Get methods. */
+  //@{
+  /// Get the size
+  inline int getSize() const 
+  { return size_/CoinSizeofAsInt(float); }
+  /// Get Array
+  inline float * array() const 
+  { return reinterpret_cast<float *> ((size_>-2) ? array_ : NULL); }
+  //@}
+  
+  /**@name Set methods */
+  //@{
+  /// Set the size
+  inline void setSize(int value) 
+  { size_ = value*CoinSizeofAsInt(float); }
+  //@}
+  
+  /**@name Condition methods */
+  //@{
+  /// Conditionally gets new array
+  inline float * conditionalNew(int sizeWanted)
+  { return reinterpret_cast<float *> ( CoinArrayWithLength::conditionalNew(sizeWanted>=0 ? static_cast<long> ((sizeWanted)*CoinSizeofAsInt(float)) : -1)); }
+  //@}
+  
+  /**@name Constructors and destructors */
+  //@{
+  /** Default constructor - NULL*/
+  inline CoinFloatArrayWithLength()
+  { array_=NULL; size_=-1;}
+  /** Alternate Constructor - length in bytes - size_ -1 */
+  inline CoinFloatArrayWithLength(int size)
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(float));}
+  /** Alternate Constructor - length in bytes 
+      mode -  0 size_ set to size
+      1 size_ set to size and zeroed
+  */
+  inline CoinFloatArrayWithLength(int size, int mode)
+    : CoinArrayWithLength(size*CoinSizeofAsInt(float),mode) {}
+  /** Copy constructor. */
+  inline CoinFloatArrayWithLength(const CoinFloatArrayWithLength & rhs)
+    : CoinArrayWithLength(rhs) {}
+  /** Copy constructor.2 */
+  inline CoinFloatArrayWithLength(const CoinFloatArrayWithLength * rhs)
+    : CoinArrayWithLength(rhs) {}
+  /** Assignment operator. */
+  inline CoinFloatArrayWithLength& operator=(const CoinFloatArrayWithLength & rhs)
+  { CoinArrayWithLength::operator=(rhs);  return *this;}
+  //@}
+};
 /// int * version
 
 class CoinIntArrayWithLength : public CoinArrayWithLength {
@@ -812,7 +975,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinIntArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(int)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(int));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -866,7 +1029,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinBigIndexArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(CoinBigIndex)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(CoinBigIndex));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -920,7 +1083,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinUnsignedIntArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(unsigned int)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(unsigned int));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -974,7 +1137,7 @@ public:
   { array_=NULL; size_=-1;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinVoidStarArrayWithLength(int size)
-  { array_=new char [size*CoinSizeofAsInt(void *)]; size_=-1;}
+  { array_=NULL; size_=-1; getArray(size*CoinSizeofAsInt(void *));}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -1029,7 +1192,7 @@ public:
   { array_=NULL; size_=-1;lengthInBytes_=length;}
   /** Alternate Constructor - length in bytes - size_ -1 */
   inline CoinArbitraryArrayWithLength(int length, int size)
-  { array_=new char [size*length]; size_=-1; lengthInBytes_=length;}
+  { array_=NULL; size_=-1; lengthInBytes_=length; getArray(size*length);}
   /** Alternate Constructor - length in bytes 
       mode -  0 size_ set to size
       1 size_ set to size and zeroed
@@ -1091,17 +1254,21 @@ public:
     numberElementsPartition_[partition]=value; }
   /// Add up number of elements in partitions
   void computeNumberElements();
-  /// Add up number of elements in partitions and pack and get rid of partitions
-  void compact();
+  /** Add up number of elements in partitions and pack and get rid of
+      partitions.  With numberThreads>1 (and COINUTILS_PTHREADS) partitions
+      are moved by several threads to offsets given by prefix sum of sizes */
+  void compact(int numberThreads=1);
    /** Reserve space.
    */
    void reserve(int n);
   /// Setup partitions (needs end as well)
   void setPartitions(int number,const int * starts);
-   /// Reset the vector (as if were just created an empty vector). Gets rid of partitions
-   void clearAndReset();
-   /// Reset the vector (as if were just created an empty vector). Keeps partitions
-   void clearAndKeep();
+   /** Reset the vector (as if were just created an empty vector). Gets rid
+       of partitions.  Partitions are cleared by up to numberThreads threads */
+   void clearAndReset(int numberThreads=1);
+   /** Reset the vector (as if were just created an empty vector). Keeps
+       partitions.  Partitions are cleared by up to numberThreads threads */
+   void clearAndKeep(int numberThreads=1);
    /// Clear a partition.
    void clearPartition(int partition);
 #ifndef NDEBUG
@@ -1115,6 +1282,14 @@ public:
 #endif
    /// Scan dense region and set up indices (returns number found)
   int scan(int partition, double tolerance=0.0);
+  /** Scan all partitions using up to numberThreads threads and set
+      number of elements (returns number found) */
+  int scanAll(double tolerance=0.0, int numberThreads=1);
+  /** As CoinIndexedVector::selectLargest but each partition is done
+      (by up to numberThreads threads) and then best of those taken */
+  int selectLargest(int number, int * which,
+		    const double * weights=NULL, double tolerance=0.0,
+		    int numberThreads=1) const;
    /** Scan dense region from start to < end and set up indices
        returns number found
    */
@@ -1161,4 +1336,105 @@ protected:
   int numberPartitions_;
    //@}
 };
+//#############################################################################
+/** Pool of clean CoinIndexedVectors for scratch work.
+
+    Vectors are kept by capacity.  get(n) hands back a pooled vector with
+    capacity at least n (and not more than twice n) if there is one,
+    otherwise a new one.  release() takes it back.  As elsewhere a work
+    vector must be clean (all zero) after use - release() only clears the
+    elements it knows about (and checks in debug mode), so a hit costs no
+    malloc and no memset.
+
+    A pool is not thread safe - threadPool() gives each thread its own.
+*/
+class CoinIndexedVectorPool {
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor - keeps at most maximumPerSize vectors of a size
+  CoinIndexedVectorPool(int maximumPerSize=8);
+  /// Destructor (deletes pooled vectors)
+  ~CoinIndexedVectorPool();
+  //@}
+
+  /**@name Use */
+  //@{
+  /// Clean vector with capacity at least capacity
+  CoinIndexedVector * get(int capacity);
+  /// Give vector (from get or new) back to pool
+  void release(CoinIndexedVector * vector);
+  /// Delete all pooled vectors
+  void clear();
+  /// Pool for this thread (deleted when thread exits)
+  static CoinIndexedVectorPool * threadPool();
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Number of vectors currently in pool
+  int numberPooled() const;
+  /// Number of get() calls satisfied from pool
+  inline int numberHits() const
+  { return numberHits_; }
+  /// Number of get() calls which had to allocate
+  inline int numberMisses() const
+  { return numberMisses_; }
+  /// Maximum number of vectors kept of any one capacity
+  inline int maximumPerSize() const
+  { return maximumPerSize_; }
+  inline void setMaximumPerSize(int value)
+  { maximumPerSize_ = value; }
+  //@}
+
+private:
+  /// Not copyable
+  CoinIndexedVectorPool(const CoinIndexedVectorPool &);
+  CoinIndexedVectorPool & operator=(const CoinIndexedVectorPool &);
+  /// Pooled vectors by capacity
+  std::map<int, std::vector<CoinIndexedVector *> > free_;
+  /// Maximum kept of one capacity
+  int maximumPerSize_;
+  /// Statistics
+  int numberHits_;
+  int numberMisses_;
+};
+
+/** Lease of a clean work vector from a CoinIndexedVectorPool.
+
+    Gets vector in constructor and gives it back in destructor, e.g.
+    \code
+    CoinIndexedVectorLease work(numberRows);
+    work->insert(iRow, value);
+    ...
+    work->clear();
+    \endcode
+*/
+class CoinIndexedVectorLease {
+public:
+  /// Leases vector of capacity at least capacity (pool NULL - threadPool)
+  inline CoinIndexedVectorLease(int capacity,
+				CoinIndexedVectorPool * pool=NULL)
+    : pool_(pool ? pool : CoinIndexedVectorPool::threadPool())
+  { vector_ = pool_->get(capacity); }
+  /// Gives vector back
+  inline ~CoinIndexedVectorLease()
+  { pool_->release(vector_); }
+  /// Vector
+  inline CoinIndexedVector * vector() const
+  { return vector_; }
+  inline CoinIndexedVector * operator->() const
+  { return vector_; }
+  inline CoinIndexedVector & operator*() const
+  { return *vector_; }
+
+private:
+  /// Not copyable
+  CoinIndexedVectorLease(const CoinIndexedVectorLease &);
+  CoinIndexedVectorLease & operator=(const CoinIndexedVectorLease &);
+  /// Pool
+  CoinIndexedVectorPool * pool_;
+  /// Vector
+  CoinIndexedVector * vector_;
+};
 #endif
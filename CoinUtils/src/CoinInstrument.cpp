@@ -0,0 +1,172 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinInstrument.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+COIN_INSTRUMENT_TLS CoinInstrumentSlot *coinInstrumentSlots = NULL;
+
+//#############################################################################
+// Names and the slots of every thread (plain statics - usable at any time)
+
+typedef struct coinInstrumentBlock {
+  CoinInstrumentSlot slots[COIN_INSTRUMENT_MAX];
+  coinInstrumentBlock *next;
+} coinInstrumentBlock;
+
+static const char *coinInstrumentNames[COIN_INSTRUMENT_MAX] = { "instrument.overflow" };
+static bool coinInstrumentTimers[COIN_INSTRUMENT_MAX] = { false };
+static int coinInstrumentNumber = 1;
+static coinInstrumentBlock *coinInstrumentBlocks = NULL;
+#ifdef COINUTILS_PTHREADS
+static pthread_mutex_t coinInstrumentMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static inline void
+coinInstrumentLock()
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_lock(&coinInstrumentMutex);
+#endif
+}
+
+static inline void
+coinInstrumentUnlock()
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_unlock(&coinInstrumentMutex);
+#endif
+}
+
+//#############################################################################
+
+int CoinInstrument::registerName(const char *name, bool timer)
+{
+  coinInstrumentLock();
+  int id = 0;
+  for (int i = 1; i < coinInstrumentNumber; i++) {
+    if (!strcmp(coinInstrumentNames[i], name)) {
+      id = i;
+      break;
+    }
+  }
+  if (!id && coinInstrumentNumber < COIN_INSTRUMENT_MAX) {
+    id = coinInstrumentNumber;
+    char *copy = static_cast<char *>(malloc(strlen(name) + 1));
+    strcpy(copy, name);
+    coinInstrumentNames[id] = copy;
+    coinInstrumentNumber++;
+  }
+  if (timer)
+    coinInstrumentTimers[id] = true;
+  coinInstrumentUnlock();
+  return id;
+}
+
+CoinInstrumentSlot *CoinInstrument::newSlots()
+{
+  coinInstrumentBlock *block = static_cast<coinInstrumentBlock *>(calloc(1, sizeof(coinInstrumentBlock)));
+  coinInstrumentLock();
+  block->next = coinInstrumentBlocks;
+  coinInstrumentBlocks = block;
+  coinInstrumentUnlock();
+  coinInstrumentSlots = block->slots;
+  return block->slots;
+}
+
+//#############################################################################
+
+int CoinInstrument::numberNames()
+{
+  coinInstrumentLock();
+  int number = coinInstrumentNumber;
+  coinInstrumentUnlock();
+  return number;
+}
+
+const char *CoinInstrument::name(int id)
+{
+  coinInstrumentLock();
+  const char *name = (id >= 0 && id < coinInstrumentNumber) ? coinInstrumentNames[id] : NULL;
+  coinInstrumentUnlock();
+  return name;
+}
+
+void CoinInstrument::totals(int id, CoinUInt64 &count, double &seconds)
+{
+  CoinUInt64 ticks = 0;
+  count = 0;
+  coinInstrumentLock();
+  for (coinInstrumentBlock *block = coinInstrumentBlocks; block; block = block->next) {
+    count += block->slots[id].count;
+    ticks += block->slots[id].ticks;
+  }
+  coinInstrumentUnlock();
+  seconds = ticks ? static_cast<double>(ticks) / ticksPerSecond() : 0.0;
+}
+
+void CoinInstrument::report(std::string &out, CoinInstrumentFormat format,
+  const char *prefix)
+{
+  const int number = numberNames();
+  char line[256];
+  bool first = true;
+  if (format == CoinInstrumentJson)
+    out += "{";
+  for (int id = 0; id < number; id++) {
+    CoinUInt64 count;
+    double seconds;
+    totals(id, count, seconds);
+    if (!count)
+      continue;
+    const char *name = coinInstrumentNames[id];
+    const bool timer = coinInstrumentTimers[id];
+    if (format == CoinInstrumentJson) {
+      out += first ? "\"" : ",\"";
+      out += name;
+      if (timer)
+        sprintf(line, "\":{\"count\":%llu,\"seconds\":%.9g}",
+          static_cast<unsigned long long>(count), seconds);
+      else
+        sprintf(line, "\":{\"count\":%llu}",
+          static_cast<unsigned long long>(count));
+      out += line;
+    } else {
+      std::string metric = prefix ? prefix : "";
+      if (!metric.empty())
+        metric += "_";
+      for (const char *c = name; *c; c++) {
+        const bool ok = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_';
+        metric += ok ? *c : '_';
+      }
+      sprintf(line, " counter\n%s_total %llu\n", metric.c_str(),
+        static_cast<unsigned long long>(count));
+      out += "# TYPE " + metric + "_total" + line;
+      if (timer) {
+        sprintf(line, " counter\n%s_seconds_total %.9g\n", metric.c_str(),
+          seconds);
+        out += "# TYPE " + metric + "_seconds_total" + line;
+      }
+    }
+    first = false;
+  }
+  if (format == CoinInstrumentJson)
+    out += "}";
+}
+
+void CoinInstrument::reset()
+{
+  coinInstrumentLock();
+  for (coinInstrumentBlock *block = coinInstrumentBlocks; block; block = block->next)
+    memset(block->slots, 0, sizeof(block->slots));
+  coinInstrumentUnlock();
+}
@@ -0,0 +1,173 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinInstrument_H
+#define CoinInstrument_H
+
+#include <string>
+
+#include "CoinUtilsConfig.h"
+#include "CoinTypes.hpp"
+#include "CoinTime.hpp"
+
+/*! \file CoinInstrument.hpp
+  \brief Named counters and timers for hot paths
+
+  A counter or timer is a name (by convention "area.what", for example
+  "factorization.ftran") given to one of the macros
+
+  \code
+    COIN_COUNT("presolve.doubleton.removed");
+    COIN_COUNT_ADD("mps.read.elements", numberElements);
+    COIN_TIME_SCOPE("factorization.factor"); // to end of enclosing block
+  \endcode
+
+  The name is looked up once per place in the code (a static local); after
+  that a count is an add to a slot of the calling thread, and a timer two
+  reads of CoinCycleCount().  Threads never share a slot, so there is no
+  locking or atomic add on the hot path.  Slots of a thread are kept after it ends.
+
+  CoinInstrument::report() sums the slots of all threads and writes them as
+  JSON or Prometheus text.  Sums taken while other threads are counting
+  are approximate.
+
+  Building with COIN_NO_INSTRUMENT defined turns the macros into nothing.
+*/
+
+/// Maximum number of names (further names share the overflow slot 0)
+#define COIN_INSTRUMENT_MAX 512
+
+/// Export formats of CoinInstrument::report()
+enum CoinInstrumentFormat {
+  /// {"name":{"count":n,"seconds":s},...}
+  CoinInstrumentJson = 0,
+  /// name_total and name_seconds_total lines with # TYPE comments
+  CoinInstrumentPrometheus = 1
+};
+
+/// Figures of one name in one thread
+typedef struct {
+  CoinUInt64 count;
+  CoinUInt64 ticks;
+} CoinInstrumentSlot;
+
+#ifdef COINUTILS_PTHREADS
+#ifdef _MSC_VER
+#define COIN_INSTRUMENT_TLS __declspec(thread)
+#else
+#define COIN_INSTRUMENT_TLS __thread
+#endif
+#else
+#define COIN_INSTRUMENT_TLS
+#endif
+
+/// Slots of the calling thread (NULL until it first counts)
+extern COIN_INSTRUMENT_TLS CoinInstrumentSlot *coinInstrumentSlots;
+
+/** Registry and export of counters and timers.
+
+  All static; the macros above are the usual way in.
+*/
+class CoinInstrument {
+public:
+  /**@name Collecting */
+  //@{
+  /** Id of \p name, registering it if new (\p timer says whether it has
+      a time). Thread safe. Returns 0 (the overflow slot) once
+      COIN_INSTRUMENT_MAX names are in use. */
+  static int registerName(const char *name, bool timer = false);
+  /// Slots of the calling thread
+  static inline CoinInstrumentSlot *slots()
+  {
+    CoinInstrumentSlot *slots = coinInstrumentSlots;
+    return slots ? slots : newSlots();
+  }
+  /// Add \p number to count of \p id
+  static inline void add(int id, CoinUInt64 number = 1)
+  {
+    slots()[id].count += number;
+  }
+  /// Add one call taking \p ticks to timer \p id
+  static inline void addTime(int id, CoinUInt64 ticks)
+  {
+    CoinInstrumentSlot &slot = slots()[id];
+    slot.count++;
+    slot.ticks += ticks;
+  }
+  /// Time stamp (CoinCycleCount())
+  static inline CoinUInt64 ticks()
+  {
+    return CoinCycleCount();
+  }
+  /// Ticks in a second (CoinCyclesPerSecond())
+  static inline double ticksPerSecond()
+  {
+    return CoinCyclesPerSecond();
+  }
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Number of names registered (including the overflow slot)
+  static int numberNames();
+  /// Name of \p id
+  static const char *name(int id);
+  /// Count and seconds of \p id summed over threads
+  static void totals(int id, CoinUInt64 &count, double &seconds);
+  /** Append figures of all names which have counted to \p out. In
+      Prometheus text names are prefixed with \p prefix and an underscore
+      and characters other than letters, digits and _ become _. */
+  static void report(std::string &out,
+    CoinInstrumentFormat format = CoinInstrumentJson,
+    const char *prefix = "coin");
+  /// Zero all slots of all threads
+  static void reset();
+  //@}
+
+private:
+  /// Allocate and register slots of the calling thread
+  static CoinInstrumentSlot *newSlots();
+};
+
+/// Times the rest of the enclosing block
+class CoinInstrumentTimer {
+public:
+  CoinInstrumentTimer(int id)
+    : id_(id)
+    , start_(CoinInstrument::ticks())
+  {
+  }
+  ~CoinInstrumentTimer()
+  {
+    CoinInstrument::addTime(id_, CoinInstrument::ticks() - start_);
+  }
+
+private:
+  int id_;
+  CoinUInt64 start_;
+};
+
+#define COIN_INSTRUMENT_JOIN2(a, b) a##b
+#define COIN_INSTRUMENT_JOIN(a, b) COIN_INSTRUMENT_JOIN2(a, b)
+
+#ifndef COIN_NO_INSTRUMENT
+#define COIN_COUNT_ADD(name, number)                                       \
+  do {                                                                     \
+    static const int coinInstrumentId = CoinInstrument::registerName(name); \
+    CoinInstrument::add(coinInstrumentId, number);                         \
+  } while (0)
+#define COIN_TIME_SCOPE(name)                                          \
+  static const int COIN_INSTRUMENT_JOIN(coinInstrumentId, __LINE__) = \
+    CoinInstrument::registerName(name, true);                         \
+  CoinInstrumentTimer COIN_INSTRUMENT_JOIN(coinInstrumentTimer, __LINE__)(COIN_INSTRUMENT_JOIN(coinInstrumentId, __LINE__))
+#else
+#define COIN_COUNT_ADD(name, number) \
+  do {                               \
+  } while (0)
+#define COIN_TIME_SCOPE(name)
+#endif
+#define COIN_COUNT(name) COIN_COUNT_ADD(name, 1)
+
+#endif
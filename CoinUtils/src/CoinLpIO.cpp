@@ -27,11 +27,163 @@
 #include "CoinMpsIO.hpp"
 #include "CoinFinite.hpp"
 #include "CoinSort.hpp"
+#include "CoinNumberIO.hpp"
+#include "CoinNameHash.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinInstrument.hpp"
+#include "CoinThreadPool.hpp"
 
 using namespace std;
 
 //#define LPIO_DEBUG
 
+/************************************************************************/
+/** Splits an Lp file into whitespace separated tokens
+
+    The file is read a block at a time into a buffer and each token is
+    null terminated where it lies, so tokens are used without copying and
+    are valid until next() is called again.  A token starting with '/' or
+    '\' is a comment and the rest of its line is skipped.  Reads plain,
+    gzip'ed or bzip2'ed files through CoinFileInput or an open FILE.
+*/
+class CoinLpTokenizer {
+public:
+  /// Reads from input which is deleted at end
+  explicit CoinLpTokenizer(CoinFileInput * input)
+    : input_(input), fp_(NULL)
+  { initialize();}
+  /// Reads from fp which is not closed at end
+  explicit CoinLpTokenizer(FILE * fp)
+    : input_(NULL), fp_(fp)
+  { initialize();}
+  ~CoinLpTokenizer()
+  { delete input_; delete [] buffer_;}
+  /// Moves to next token.  Returns false at end of file
+  bool next();
+  /// Current token (null terminated)
+  inline char * token() const
+  { return buffer_+token_;}
+  /// Length of current token
+  inline int length() const
+  { return length_;}
+private:
+  /// Not implemented
+  CoinLpTokenizer(const CoinLpTokenizer &);
+  CoinLpTokenizer & operator=(const CoinLpTokenizer &);
+  void initialize();
+  /** Moves bytes from keep on to start of buffer (making buffer larger if
+      it is full) and reads more.  keep is updated.  Returns false if
+      nothing more could be read */
+  bool fill(int & keep);
+  CoinFileInput * input_;
+  FILE * fp_;
+  /// Buffer (one more than size_ so a token at end can be terminated)
+  char * buffer_;
+  int size_;
+  /// Bytes in buffer
+  int end_;
+  /// Next byte to look at
+  int position_;
+  /// Start and length of current token
+  int token_;
+  int length_;
+  bool eof_;
+};
+
+void
+CoinLpTokenizer::initialize()
+{
+  size_ = 65536;
+  buffer_ = new char [size_+1];
+  buffer_[0] = '\0';
+  end_ = 0;
+  position_ = 0;
+  token_ = 0;
+  length_ = 0;
+  eof_ = false;
+}
+
+bool
+CoinLpTokenizer::fill(int & keep)
+{
+  if (eof_)
+    return false;
+  int numberKeep = end_-keep;
+  if (numberKeep == size_) {
+    // token fills buffer
+    char * temp = new char [2*size_+1];
+    memcpy(temp, buffer_, size_);
+    delete [] buffer_;
+    buffer_ = temp;
+    size_ *= 2;
+  } else if (keep) {
+    memmove(buffer_, buffer_+keep, numberKeep);
+  }
+  position_ -= keep;
+  end_ = numberKeep;
+  keep = 0;
+  int n;
+  if (input_)
+    n = input_->read(buffer_+end_, size_-end_);
+  else
+    n = static_cast<int>(fread(buffer_+end_, 1, size_-end_, fp_));
+  if (n <= 0) {
+    eof_ = true;
+    return false;
+  }
+  end_ += n;
+  return true;
+}
+
+bool
+CoinLpTokenizer::next()
+{
+  while (true) {
+    // skip white space
+    while (true) {
+      while (position_ < end_ && isspace(static_cast<unsigned char>
+					 (buffer_[position_])))
+	position_++;
+      if (position_ < end_)
+	break;
+      int keep = end_;
+      if (!fill(keep)) {
+	token_ = position_;
+	buffer_[token_] = '\0';
+	length_ = 0;
+	return false;
+      }
+    }
+    int start = position_;
+    if (buffer_[start] == '/' || buffer_[start] == '\\') {
+      // comment - skip to end of line
+      while (true) {
+	while (position_ < end_ && buffer_[position_] != '\n')
+	  position_++;
+	if (position_ < end_) 
+	  break;
+	int keep = end_;
+	if (!fill(keep))
+	  break;
+      }
+      continue;
+    }
+    while (true) {
+      while (position_ < end_ && !isspace(static_cast<unsigned char>
+					  (buffer_[position_])))
+	position_++;
+      if (position_ < end_ || !fill(start))
+	break;
+    }
+    token_ = start;
+    length_ = position_-start;
+    buffer_[position_] = '\0';
+    if (position_ < end_)
+      position_++;
+    return true;
+  }
+}
+
 /************************************************************************/
 
 CoinLpIO::CoinLpIO() :
@@ -57,7 +209,9 @@ CoinLpIO::CoinLpIO() :
   infinity_(COIN_DBL_MAX),
   epsilon_(1e-5),
   numberAcross_(10),
-  decimals_(5)
+  decimals_(5),
+  numberThreads_(1),
+  modelCache_(NULL)
 {
   for (int j = 0; j < MAX_OBJECTIVES; j++){
      objective_[j] = NULL;
@@ -106,7 +260,10 @@ CoinLpIO::CoinLpIO(const CoinLpIO& rhs)
     fileName_(CoinStrdup("")),
     infinity_(COIN_DBL_MAX),
     epsilon_(1e-5),
-    numberAcross_(10)
+    numberAcross_(10),
+    decimals_(5),
+    numberThreads_(1),
+    modelCache_(NULL)
 {
     num_objectives_ = rhs.num_objectives_;
     for (int j = 0; j < MAX_OBJECTIVES; j++){
@@ -205,6 +362,7 @@ void CoinLpIO::gutsOfCopy(const CoinLpIO& rhs)
     maxHash_[1] = rhs.maxHash_[1];
     infinity_ = rhs.infinity_;
     numberAcross_ = rhs.numberAcross_;
+    numberThreads_ = rhs.numberThreads_;
     for (int j = 0; j < num_objectives_; j++){
        objectiveOffset_[j] = rhs.objectiveOffset_[j];
     }
@@ -222,8 +380,7 @@ void CoinLpIO::gutsOfCopy(const CoinLpIO& rhs)
              names[i] = CoinStrdup(names2[i]);
           }
  
-          hash_[section] = new CoinHashLink[maxHash_[section]];
-          std::memcpy(hash_[section], rhs.hash_[section], maxHash_[section]*sizeof(CoinHashLink));
+          hash_[section] = new CoinNameHash(*rhs.hash_[section]);
        }
     }
  }
@@ -710,6 +867,17 @@ void CoinLpIO::setDecimals(const int value)
   }
 }
 
+/************************************************************************/
+void CoinLpIO::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value,1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
+
 /************************************************************************/
 double CoinLpIO::objectiveOffset() const
 {
@@ -929,6 +1097,329 @@ CoinLpIO::loadSOS(int numberSets,const CoinSet ** sets)
   }
 }
 
+/************************************************************************/
+/** Where writeLp puts text - a FILE or a (maybe compressed) CoinFileOutput
+ */
+class CoinLpOutput {
+public:
+  /// Writes to output which is deleted at end
+  explicit CoinLpOutput(CoinFileOutput * output)
+    : output_(output), fp_(NULL) {}
+  /// Writes to fp which is not closed at end
+  explicit CoinLpOutput(FILE * fp)
+    : output_(NULL), fp_(fp) {}
+  ~CoinLpOutput()
+  { delete output_;}
+  void write(const char * text, size_t length)
+  {
+    if (output_)
+      output_->write(text, static_cast<int>(length));
+    else
+      fwrite(text, 1, length, fp_);
+  }
+private:
+  /// Not implemented
+  CoinLpOutput(const CoinLpOutput &);
+  CoinLpOutput & operator=(const CoinLpOutput &);
+  CoinFileOutput * output_;
+  FILE * fp_;
+};
+
+namespace {
+
+/* Text being built up for writeLp.  Each thread has its own so rows can
+   be formatted in parallel and written in order. */
+class CoinLpText {
+public:
+  CoinLpText() : text_(NULL), size_(0), capacity_(0) {}
+  ~CoinLpText()
+  { delete [] text_;}
+  inline void clear()
+  { size_ = 0;}
+  inline const char * text() const
+  { return text_;}
+  inline size_t size() const
+  { return size_;}
+  /// Makes sure there is room for n more characters
+  inline char * reserve(size_t n)
+  {
+    if (size_+n > capacity_) {
+      capacity_ = CoinMax(2*capacity_, size_+n+4096);
+      char * temp = new char [capacity_];
+      CoinMemcpyN(text_, size_, temp);
+      delete [] text_;
+      text_ = temp;
+    }
+    return text_+size_;
+  }
+  inline void add(const char * string)
+  {
+    size_t n = strlen(string);
+    memcpy(reserve(n), string, n);
+    size_ += n;
+  }
+  inline void add(char c)
+  {
+    *reserve(1) = c;
+    size_++;
+  }
+  /// Appends value as sprintf "%.*f" would
+  void addFixed(double value, int decimals);
+  /// Appends coefficient as CoinLpIO::out_coeff would
+  void addCoeff(double v, int print_1, double lp_eps, int decimals)
+  {
+    if(!print_1) {
+      if(fabs(v-1) < lp_eps) {
+	return;
+      }
+      if(fabs(v+1) < lp_eps) {
+	add(" -");
+	return;
+      }
+    }
+    double frac = v - floor(v);
+    add(' ');
+    if(frac < lp_eps) {
+      addFixed(floor(v), 0);
+    }
+    else {
+      if(frac > 1 - lp_eps) {
+	addFixed(floor(v+0.5), 0);
+      }
+      else {
+	addFixed(v, decimals);
+      }
+    }
+  }
+private:
+  CoinLpText(const CoinLpText &);
+  CoinLpText & operator=(const CoinLpText &);
+  char * text_;
+  size_t size_;
+  size_t capacity_;
+};
+
+/* Fixed point formatting is done with integer arithmetic when the scaled
+   value is small enough to be exact and not too near a rounding tie,
+   otherwise by sprintf, so output is always as sprintf would give. */
+void
+CoinLpText::addFixed(double value, int decimals)
+{
+  static const double powerTen[16] = 
+    {1.0e0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,1.0e6,1.0e7,1.0e8,1.0e9,
+     1.0e10,1.0e11,1.0e12,1.0e13,1.0e14,1.0e15};
+  if (decimals < 16) {
+    double scaled = fabs(value)*powerTen[decimals];
+    if (scaled < 1.0e15) {
+      double whole = floor(scaled);
+      double frac = scaled - whole;
+      // product may be out by half an ulp (at most scaled*2^-53)
+      if (fabs(frac-0.5) > scaled*2.3e-16) {
+	CoinInt64 n = static_cast<CoinInt64>(whole);
+	if (frac > 0.5)
+	  n++;
+	char digits[40];
+	int nDigits = 0;
+	for (int i = 0; i < decimals; i++) {
+	  digits[nDigits++] = static_cast<char>('0' + n % 10);
+	  n /= 10;
+	}
+	if (decimals)
+	  digits[nDigits++] = '.';
+	do {
+	  digits[nDigits++] = static_cast<char>('0' + n % 10);
+	  n /= 10;
+	} while (n);
+	if (value < 0.0 || (value == 0.0 && 1.0/value < 0.0))
+	  digits[nDigits++] = '-';
+	char * put = reserve(nDigits);
+	for (int i = 0; i < nDigits; i++)
+	  put[i] = digits[nDigits-1-i];
+	size_ += nDigits;
+	return;
+      }
+    }
+  }
+  // at most 309 digits before point
+  char * put = reserve(decimals+320);
+  size_ += sprintf(put, "%.*f", decimals, value);
+}
+
+/* Shared data for formatting rows or bounds.  The caller's thread does
+   the first chunk of a round and others (if any) the rest */
+struct CoinLpWriteChunk {
+  // 0 rows, 1 bounds
+  int type;
+  int first;
+  int last;
+  const CoinPackedMatrix * matrix;
+  const double * lower;
+  const double * upper;
+  char const * const * rowNames;
+  char const * const * colNames;
+  double lp_eps;
+  double lp_inf;
+  int numberAcross;
+  int decimals;
+  bool useRowNames;
+  CoinLpText * text;
+};
+
+// Appends monomials of row as writeLp always has
+void
+coinLpAddRow(CoinLpText & text, const CoinLpWriteChunk & info, int iRow)
+{
+  const CoinPackedMatrix * matrix = info.matrix;
+  const int * indices = matrix->getIndices();
+  const double * elements = matrix->getElements();
+  double lp_eps = info.lp_eps;
+  int cnt_print = 0;
+  for(CoinBigIndex j=matrix->getVectorFirst(iRow); 
+      j<matrix->getVectorLast(iRow); j++) {
+    if((cnt_print > 0) && (elements[j] > lp_eps)) {
+      text.add(" +");
+    }
+    if(fabs(elements[j]) > lp_eps) {
+      text.addCoeff(elements[j], 0, lp_eps, info.decimals);
+      text.add(' ');
+      text.add(info.colNames[indices[j]]);
+      cnt_print++;
+      if(cnt_print % info.numberAcross == 0) {
+	text.add('\n');
+      }
+    }
+  }
+}
+
+void
+coinLpFormatChunk(const CoinLpWriteChunk & info)
+{
+  CoinLpText & text = *info.text;
+  double lp_eps = info.lp_eps;
+  double lp_inf = info.lp_inf;
+  int decimals = info.decimals;
+  text.clear();
+  if (!info.type) {
+    const double *rowlow = info.lower;
+    const double *rowup = info.upper;
+    for(int i=info.first; i<info.last; i++) {
+      if(info.useRowNames) {
+	text.add(info.rowNames[i]);
+	text.add(": ");
+      }
+      coinLpAddRow(text, info, i);
+      if(rowup[i] - rowlow[i] < lp_eps) {
+	text.add(" =");
+	text.addCoeff(rowlow[i], 1, lp_eps, decimals);
+	text.add('\n');
+      }
+      else {
+	if(rowup[i] < lp_inf) {
+	  text.add(" <=");
+	  text.addCoeff(rowup[i], 1, lp_eps, decimals);
+	  text.add('\n');
+	  if(rowlow[i] > -lp_inf) {
+	    if(info.useRowNames) {
+	      text.add(info.rowNames[i]);
+	      text.add("_low:");
+	    }
+	    coinLpAddRow(text, info, i);
+	    text.add(" >=");
+	    text.addCoeff(rowlow[i], 1, lp_eps, decimals);
+	    text.add('\n');
+	  }
+	}
+	else {
+	  text.add(" >=");
+	  text.addCoeff(rowlow[i], 1, lp_eps, decimals);
+	  text.add('\n');
+	}
+      }
+    }
+  } else {
+    const double *collow = info.lower;
+    const double *colup = info.upper;
+    char const * const * colNames = info.colNames;
+    for(int j=info.first; j<info.last; j++) {
+      if((collow[j] > -lp_inf) && (colup[j] < lp_inf)) {
+	text.addCoeff(collow[j], 1, lp_eps, decimals);
+	text.add(" <= ");
+	text.add(colNames[j]);
+	text.add(" <=");
+	text.addCoeff(colup[j], 1, lp_eps, decimals);
+	text.add('\n');
+      }
+      if((collow[j] == -lp_inf) && (colup[j] < lp_inf)) {
+	text.add(colNames[j]);
+	text.add(" <=");
+	text.addCoeff(colup[j], 1, lp_eps, decimals);
+	text.add('\n');
+      }
+      if((collow[j] > -lp_inf) && (colup[j] == lp_inf)) {
+	if(fabs(collow[j]) > lp_eps) { 
+	  text.addCoeff(collow[j], 1, lp_eps, decimals);
+	  text.add(" <= ");
+	  text.add(colNames[j]);
+	  text.add('\n');
+	}
+      }
+      if(collow[j] == -lp_inf) {
+	text.add(' ');
+	text.add(colNames[j]);
+	text.add(" Free\n");
+      }
+    }
+  }
+}
+
+void *
+coinLpFormatWorker(void * info)
+{
+  coinLpFormatChunk(*reinterpret_cast<CoinLpWriteChunk *>(info));
+  return NULL;
+}
+
+/* Formats rows (type 0) or bounds (type 1) in rounds of up to
+   numberThreads chunks and writes each round in order.  A chunk is
+   about chunkSize elements (rows) or columns (bounds) so memory used
+   does not grow with the model. */
+void
+coinLpWriteSection(CoinLpWriteChunk & info, int number, int numberThreads,
+		   CoinLpOutput & output)
+{
+  const int chunkSize = 50000;
+  CoinLpText * text = new CoinLpText [numberThreads];
+  CoinLpWriteChunk * chunk = new CoinLpWriteChunk [numberThreads];
+  const int * length = info.type ? NULL : info.matrix->getVectorLengths();
+  int next = 0;
+  while (next < number) {
+    int numberChunks = 0;
+    while (numberChunks < numberThreads && next < number) {
+      CoinLpWriteChunk & thisChunk = chunk[numberChunks];
+      thisChunk = info;
+      thisChunk.text = text+numberChunks;
+      thisChunk.first = next;
+      if (length) {
+	int count = 0;
+	while (next < number && count < chunkSize)
+	  count += length[next++]+1;
+      } else {
+	next = CoinMin(number, next+chunkSize);
+      }
+      thisChunk.last = next;
+      numberChunks++;
+    }
+    CoinThreadPool::run(coinLpFormatWorker, chunk, sizeof(CoinLpWriteChunk),
+			numberChunks);
+    for (int i = 0; i < numberChunks; i++)
+      output.write(text[i].text(), text[i].size());
+  }
+  delete [] chunk;
+  delete [] text;
+}
+
+} // end of anonymous namespace
+
 /************************************************************************/
 void
 CoinLpIO::out_coeff(FILE *fp, const double v, const int print_1) const {
@@ -997,31 +1488,103 @@ CoinLpIO::writeLp(FILE *fp, const double epsilon,
 int
 CoinLpIO::writeLp(const char *filename, const bool useRowNames)
 {
-  FILE *fp = NULL;
-  fp = fopen(filename,"w");
-  if (!fp) {
+  return writeLp(filename, useRowNames, 0);
+}
+
+/************************************************************************/
+int
+CoinLpIO::writeLp(const char *filename, const bool useRowNames,
+		  int compression)
+{
+  int possibleCompression=0;
+#ifdef COIN_HAS_ZLIB
+  possibleCompression =1;
+#endif
+#ifdef COIN_HAS_BZLIB
+  possibleCompression += 2;
+#endif
+  // zstd or lz4 if possible, otherwise as gzip
+  if ((compression==3&&
+       !CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_ZSTD))||
+      (compression==4&&
+       !CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_LZ4))||
+      compression>4)
+    compression=1;
+  if (compression<3&&(compression&possibleCompression)==0) {
+    // switch to other if possible
+    if (compression&&possibleCompression)
+      compression = 3-compression;
+    else
+      compression=0;
+  }
+  std::string name = filename;
+  CoinFileOutput *fileOutput = NULL;
+  try {
+    switch (compression) {
+    case 1:
+      if (name.size() < 3 || name.compare(name.size()-3, 3, ".gz") != 0) {
+	name += ".gz";
+      }
+      fileOutput = CoinFileOutput::create(name, CoinFileOutput::COMPRESS_GZIP);
+      break;
+
+    case 2:
+      if (name.size() < 4 || name.compare(name.size()-4, 4, ".bz2") != 0) {
+	name += ".bz2";
+      }
+      fileOutput = CoinFileOutput::create(name, CoinFileOutput::COMPRESS_BZIP2);
+      break;
+
+    case 3:
+      if (name.size() < 4 || name.compare(name.size()-4, 4, ".zst") != 0) {
+	name += ".zst";
+      }
+      fileOutput = CoinFileOutput::create(name, CoinFileOutput::COMPRESS_ZSTD,
+					  numberThreads_);
+      break;
+
+    case 4:
+      if (name.size() < 4 || name.compare(name.size()-4, 4, ".lz4") != 0) {
+	name += ".lz4";
+      }
+      fileOutput = CoinFileOutput::create(name, CoinFileOutput::COMPRESS_LZ4);
+      break;
+
+    case 0:
+    default:
+      fileOutput = CoinFileOutput::create(name, CoinFileOutput::COMPRESS_NONE);
+      break;
+    }
+  }
+  catch (CoinError &) {
     char str[8192];
-    sprintf(str,"### ERROR: unable to open file %s\n", filename);
+    sprintf(str,"### ERROR: unable to open file %s\n", name.c_str());
     throw CoinError(str, "writeLP", "CoinLpIO", __FILE__, __LINE__);
   }
-  int nerr = writeLp(fp, useRowNames);
-  fclose(fp);
-  return(nerr);
+  CoinLpOutput output(fileOutput);
+  return write_lp(output, useRowNames);
 }
 
 /************************************************************************/
 int
 CoinLpIO::writeLp(FILE *fp, const bool useRowNames)
+{
+  CoinLpOutput output(fp);
+  return write_lp(output, useRowNames);
+}
+
+/************************************************************************/
+int
+CoinLpIO::write_lp(CoinLpOutput & output, const bool useRowNames)
 {
    double lp_eps = getEpsilon();
    double lp_inf = getInfinity();
    int numberAcross = getNumberAcross();
+   int decimals = getDecimals();
 
-   int i, j, cnt_print, loc_row_names = 0, loc_col_names = 0;
+   int j, cnt_print, loc_row_names = 0, loc_col_names = 0;
    char **prowNames = NULL, **pcolNames = NULL;
 
-   const int *indices = matrixByRow_->getIndices();
-   const double *elements  = matrixByRow_->getElements();
    int ncol = getNumCols();
    int nrow = getNumRows();
    const double *collow = getColLower();
@@ -1062,145 +1625,79 @@ CoinLpIO::writeLp(FILE *fp, const bool useRowNames)
 	  nrow, ncol);
 #endif
  
-   fprintf(fp, "\\Problem name: %s\n\n", getProblemName());
-   fprintf(fp, "Minimize\n");
+   CoinLpText text;
+   text.add("\\Problem name: ");
+   text.add(getProblemName());
+   text.add("\n\nMinimize\n");
 
    for (int k = 0; k < num_objectives_; k++){
       if(useRowNames) {
-	 fprintf(fp, "%s:", objName_[k]);
+	 text.add(objName_[k]);
+	 text.add(':');
       }
 
       cnt_print = 0;
       for(j=0; j<ncol; j++) {
 	 if((cnt_print > 0) && (objective_[k][j] > lp_eps)) {
-	    fprintf(fp, " +");
+	    text.add(" +");
 	 }
 	 if(fabs(objective_[k][j]) > lp_eps) {
-	    out_coeff(fp, objective_[k][j], 0);
-	    fprintf(fp, " %s", colNames[j]);
+	    text.addCoeff(objective_[k][j], 0, lp_eps, decimals);
+	    text.add(' ');
+	    text.add(colNames[j]);
 	    cnt_print++;
 	    if(cnt_print % numberAcross == 0) {
-	       fprintf(fp, "\n");
+	       text.add('\n');
 	    }
 	 }
       }
  
       if((cnt_print > 0) && (objectiveOffset_[k] > lp_eps)) {
-	 fprintf(fp, " +");
+	 text.add(" +");
       }
       if(fabs(objectiveOffset_[k]) > lp_eps) {
-	 out_coeff(fp, objectiveOffset_[k], 1);
+	 text.addCoeff(objectiveOffset_[k], 1, lp_eps, decimals);
 	 cnt_print++;
       }
       if((cnt_print == 0) || (cnt_print % numberAcross != 0)) {
-	 fprintf(fp, "\n");
+	 text.add('\n');
       }
    
    }
 
-   fprintf(fp, "Subject To\n");
-   
-   int cnt_out_rows = 0;
-
-   for(i=0; i<nrow; i++) {
-     cnt_print = 0;
-     
-     if(useRowNames) {
-       fprintf(fp, "%s: ", rowNames[i]);
-     }
-     cnt_out_rows++;
-
-     for(j=matrixByRow_->getVectorFirst(i); 
-	 j<matrixByRow_->getVectorLast(i); j++) {
-       if((cnt_print > 0) && (elements[j] > lp_eps)) {
-	 fprintf(fp, " +");
-       }
-       if(fabs(elements[j]) > lp_eps) {
-	 out_coeff(fp, elements[j], 0);
-	 fprintf(fp, " %s", colNames[indices[j]]);
-	 cnt_print++;
-	 if(cnt_print % numberAcross == 0) {
-	   fprintf(fp, "\n");
-	 }
-       }
-     }
-
-     if(rowup[i] - rowlow[i] < lp_eps) {
-          fprintf(fp, " =");
-	  out_coeff(fp, rowlow[i], 1);
-	  fprintf(fp, "\n");
-     }
-     else {
-       if(rowup[i] < lp_inf) {
-	 fprintf(fp, " <=");
-	 out_coeff(fp, rowup[i], 1);	 
-	 fprintf(fp, "\n");
-
-	 if(rowlower_[i] > -lp_inf) {
-
-	   cnt_print = 0;
-
-	   if(useRowNames) {
-	     fprintf(fp, "%s_low:", rowNames[i]);
-	   }
-	   cnt_out_rows++;
-	   
-	   for(j=matrixByRow_->getVectorFirst(i); 
-	       j<matrixByRow_->getVectorLast(i); j++) {
-	     if((cnt_print>0) && (elements[j] > lp_eps)) {
-	       fprintf(fp, " +");
-	     }
-	     if(fabs(elements[j]) > lp_eps) {
-	       out_coeff(fp, elements[j], 0);
-	       fprintf(fp, " %s", colNames[indices[j]]);
-	       cnt_print++;
-	       if(cnt_print % numberAcross == 0) {
-		 fprintf(fp, "\n");
-	       }
-	     }
-	   }
-	   fprintf(fp, " >=");
-	   out_coeff(fp, rowlow[i], 1);
-	   fprintf(fp, "\n");
-	 }
-
-       }
-       else {
-	 fprintf(fp, " >=");
-	 out_coeff(fp, rowlow[i], 1);	 
-	 fprintf(fp, "\n");
-       }
-     }
-   }
+   text.add("Subject To\n");
+   output.write(text.text(), text.size());
+   text.clear();
+
+   // rows and bounds are formatted in chunks (maybe by several threads)
+   CoinLpWriteChunk info;
+   info.type = 0;
+   info.first = 0;
+   info.last = 0;
+   info.matrix = matrixByRow_;
+   info.lower = rowlow;
+   info.upper = rowup;
+   info.rowNames = rowNames;
+   info.colNames = colNames;
+   info.lp_eps = lp_eps;
+   info.lp_inf = lp_inf;
+   info.numberAcross = numberAcross;
+   info.decimals = decimals;
+   info.useRowNames = useRowNames;
+   info.text = NULL;
+   coinLpWriteSection(info, nrow, numberThreads_, output);
 
 #ifdef LPIO_DEBUG
    printf("CoinLpIO::writeLp(): Done with constraints\n");
 #endif
 
-   fprintf(fp, "Bounds\n");
-   
-   for(j=0; j<ncol; j++) {
-     if((collow[j] > -lp_inf) && (colup[j] < lp_inf)) {
-       out_coeff(fp, collow[j], 1);
-       fprintf(fp, " <= %s <=", colNames[j]); 
-       out_coeff(fp, colup[j], 1);
-       fprintf(fp, "\n");
-     }
-     if((collow[j] == -lp_inf) && (colup[j] < lp_inf)) {
-       fprintf(fp, "%s <=", colNames[j]);
-       out_coeff(fp, colup[j], 1);
-       fprintf(fp, "\n");
-     }
-     if((collow[j] > -lp_inf) && (colup[j] == lp_inf)) {
-       if(fabs(collow[j]) > lp_eps) { 
-	 out_coeff(fp, collow[j], 1);
-	 fprintf(fp, " <= %s\n", colNames[j]);
-       }
-     }
-     if(collow[j] == -lp_inf) {
-       fprintf(fp, " %s Free\n", colNames[j]); 
-     }
-   }
+   text.add("Bounds\n");
+   output.write(text.text(), text.size());
+   text.clear();
+   info.type = 1;
+   info.lower = collow;
+   info.upper = colup;
+   coinLpWriteSection(info, ncol, numberThreads_, output);
 
 #ifdef LPIO_DEBUG
    printf("CoinLpIO::writeLp(): Done with bounds\n");
@@ -1213,20 +1710,21 @@ CoinLpIO::writeLp(FILE *fp, const bool useRowNames)
        if(integerType[j] == 1) {
 
 	 if(first_int) {
-	   fprintf(fp, "Integers\n");
+	   text.add("Integers\n");
 	   first_int = 0;
 	 }
 
-	 fprintf(fp, "%s ", colNames[j]);
+	 text.add(colNames[j]);
+	 text.add(' ');
 	 cnt_print++;
 	 if(cnt_print % numberAcross == 0) {
-	   fprintf(fp, "\n");
+	   text.add('\n');
 	 }
        }
      }
 
      if(cnt_print % numberAcross != 0) {
-       fprintf(fp, "\n");
+       text.add('\n');
      }
    }
 
@@ -1235,45 +1733,44 @@ CoinLpIO::writeLp(FILE *fp, const bool useRowNames)
 #endif
 
    if(set_ != NULL) {
-     fprintf(fp, "SOS\n");
-     double lp_eps = getEpsilon();
-     int decimals = getDecimals();
-     char form[15];
-     sprintf(form, "%%.%df", decimals);
+     text.add("SOS\n");
      for (int iSet=0;iSet<numberSets_;iSet++) {
        cnt_print = 0;
        const CoinSet * set = set_[iSet];
        // no space as readLp gets marginally confused
-       fprintf(fp,"set%d:S%c::",iSet,'0'+set->setType());
+       sprintf(buff,"set%d:S%c::",iSet,'0'+set->setType());
+       text.add(buff);
        const int * which = set->which();
        const double * weights = set->weights();
        int numberEntries = set->numberEntries();
        for(j=0; j<numberEntries; j++) {
 	 int iColumn = which[j];
-	 fprintf(fp, " %s:", colNames[iColumn]);
+	 text.add(' ');
+	 text.add(colNames[iColumn]);
+	 text.add(':');
 	 // modified out_coeff (no leading space)
 	 double v = weights[j];
 	 double frac = v - floor(v);
 	 
 	 if(frac < lp_eps) {
-	   fprintf(fp,"%.0f", floor(v));
+	   text.addFixed(floor(v), 0);
 	 }
 	 else {
 	   if(frac > 1 - lp_eps) {
-	     fprintf(fp, "%.0f", floor(v+0.5));
+	     text.addFixed(floor(v+0.5), 0);
 	   }
 	   else {
-	   fprintf(fp, form, v);
+	     text.addFixed(v, decimals);
 	   }
 	 }
 	 cnt_print++;
 	 if(cnt_print % numberAcross == 0) {
-	   fprintf(fp, "\n");
+	   text.add('\n');
 	 }
        }
        
        if(cnt_print % numberAcross != 0) {
-	 fprintf(fp, "\n");
+	 text.add('\n');
        }
      }
    }
@@ -1282,7 +1779,8 @@ CoinLpIO::writeLp(FILE *fp, const bool useRowNames)
    printf("CoinLpIO::writeLp(): Done with SOS\n");
 #endif
 
-   fprintf(fp, "End\n");
+   text.add("End\n");
+   output.write(text.text(), text.size());
 
    if(loc_row_names) {
      for(j=0; j<nrow+1; j++) {
@@ -1298,37 +1796,28 @@ CoinLpIO::writeLp(FILE *fp, const bool useRowNames)
      free(pcolNames);
    }
    return 0;
-} /* writeLp */
+} /* write_lp */
 
 /*************************************************************************/
 int 
-CoinLpIO::find_obj(FILE *fp) const {
+CoinLpIO::find_obj(CoinLpTokenizer & tokens) const {
 
-  char buff[1024];
-
-  sprintf(buff, "aa");
-  size_t lbuff = strlen(buff);
+  while(tokens.next()) {
+    const char * buff = tokens.token();
+    int lbuff = tokens.length();
 
-  while(((lbuff != 8) || (CoinStrNCaseCmp(buff, "minimize", 8) != 0)) &&
-	((lbuff != 3) || (CoinStrNCaseCmp(buff, "min", 3) != 0)) &&
-	((lbuff != 8) || (CoinStrNCaseCmp(buff, "maximize", 8) != 0)) &&
-	((lbuff != 3) || (CoinStrNCaseCmp(buff, "max", 3) != 0))) {
-
-    scan_next(buff, fp);
-    lbuff = strlen(buff);
-    
-    if(feof(fp)) {
-      char str[8192];
-      sprintf(str,"### ERROR: Unable to locate objective function\n");
-      throw CoinError(str, "find_obj", "CoinLpIO", __FILE__, __LINE__);
+    if(((lbuff == 8) && (CoinStrNCaseCmp(buff, "minimize", 8) == 0)) ||
+       ((lbuff == 3) && (CoinStrNCaseCmp(buff, "min", 3) == 0))) {
+      return(1);
+    }
+    if(((lbuff == 8) && (CoinStrNCaseCmp(buff, "maximize", 8) == 0)) ||
+       ((lbuff == 3) && (CoinStrNCaseCmp(buff, "max", 3) == 0))) {
+      return(-1);
     }
   }
-
-  if(((lbuff == 8) && (CoinStrNCaseCmp(buff, "minimize", 8) == 0)) ||
-     ((lbuff == 3) && (CoinStrNCaseCmp(buff, "min", 3) == 0))) {
-    return(1);
-  }
-  return(-1);
+  char str[8192];
+  sprintf(str,"### ERROR: Unable to locate objective function\n");
+  throw CoinError(str, "find_obj", "CoinLpIO", __FILE__, __LINE__);
 } /* find_obj */
 
 /*************************************************************************/
@@ -1421,44 +1910,30 @@ CoinLpIO::is_comment(const char *buff) const {
 } /* is_comment */
 
 /*************************************************************************/
-void
-CoinLpIO::skip_comment(char *buff, FILE *fp) const {
+char *
+CoinLpIO::scan_next(CoinLpTokenizer & tokens) const {
 
-  while(strcspn(buff, "\n") == strlen(buff)) { // end of line not read yet
-    if(feof(fp)) {
-      char str[8192];
-      sprintf(str,"### ERROR: end of file reached while skipping comment\n");
-      throw CoinError(str, "skip_comment", "CoinLpIO", __FILE__, __LINE__);
-    }
-    if(ferror(fp)) {
-      char str[8192];
-      sprintf(str,"### ERROR: error while skipping comment\n");
-      throw CoinError(str, "skip_comment", "CoinLpIO", __FILE__, __LINE__);
-    }
-    char * x=fgets(buff, sizeof(buff), fp);    
-    if (!x)
-      throw("bad fgets");
-  } 
-} /* skip_comment */
-
-/*************************************************************************/
-void
-CoinLpIO::scan_next(char *buff, FILE *fp) const {
-
-  int x=fscanf(fp, "%s", buff);
-  if (x<=0)
-    throw("bad fscanf");
-  while(is_comment(buff)) {
-    skip_comment(buff, fp);
-    x=fscanf(fp, "%s", buff);
-    if (x<=0)
-      throw("bad fscanf");
+  if(!tokens.next()) {
+    char str[8192];
+    sprintf(str,"### ERROR: Unexpected end of file\n");
+    throw CoinError(str, "scan_next", "CoinLpIO", __FILE__, __LINE__);
   }
 
 #ifdef LPIO_DEBUG
-  printf("CoinLpIO::scan_next: (%s)\n", buff);
+  printf("CoinLpIO::scan_next: (%s)\n", tokens.token());
 #endif
 
+  return tokens.token();
+} /* scan_next */
+
+/*************************************************************************/
+void
+CoinLpIO::scan_next(char *buff, CoinLpTokenizer & tokens) const {
+
+  const char * token = scan_next(tokens);
+  int length = CoinMin(tokens.length(), 1023);
+  memcpy(buff, token, length);
+  buff[length] = '\0';
 } /* scan_next */
 
 /*************************************************************************/
@@ -1487,7 +1962,7 @@ CoinLpIO::is_invalid_name(const char *name,
   }
   if(lname > valid_lname) {
 	char printBuffer[512];
-	sprintf(printBuffer,"### CoinLpIO::is_invalid_name(): Name %s is too long", 
+	sprintf(printBuffer,"### CoinLpIO::is_invalid_name(): Name %.100s... is too long", 
 	   name);
 	handler_->message(COIN_GENERAL_WARNING,messages_)<<printBuffer
 							 <<CoinMessageEol;
@@ -1544,7 +2019,7 @@ CoinLpIO::are_invalid_names(char const * const * const vnames,
     flag = is_invalid_name(vnames[i], is_ranged);
     if(flag) {
       char printBuffer[512];
-      sprintf(printBuffer,"### CoinLpIO::are_invalid_names(): Invalid name: vnames[%d]: %s",
+      sprintf(printBuffer,"### CoinLpIO::are_invalid_names(): Invalid name: vnames[%d]: %.100s",
 	      i, vnames[i]);
       handler_->message(COIN_GENERAL_WARNING,messages_)<<printBuffer
 						       <<CoinMessageEol;
@@ -1556,23 +2031,19 @@ CoinLpIO::are_invalid_names(char const * const * const vnames,
 
 /*************************************************************************/
 int 
-CoinLpIO::read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt, 
+CoinLpIO::read_monom_obj(CoinLpTokenizer & tokens, double *coeff, 
+			 int *colIndex, int *cnt, 
 			 char **obj_name, int *num_objectives, int *obj_starts) {
 
   double mult;
-  char buff[1024] = "aa", loc_name[1024], *start;
+  char *buff, *start;
   int read_st = 0;
 
-  scan_next(buff, fp);
-
-  if(feof(fp)) {
-    char str[8192];
-    sprintf(str,"### ERROR: Unable to read objective function\n");
-    throw CoinError(str, "read_monom_obj", "CoinLpIO", __FILE__, __LINE__);
-  }
+  buff = scan_next(tokens);
+  int lbuff = tokens.length();
 
-  if(buff[strlen(buff)-1] == ':') {
-    buff[strlen(buff)-1] = '\0';
+  if(buff[lbuff-1] == ':') {
+    buff[lbuff-1] = '\0';
 
 #ifdef LPIO_DEBUG
     printf("CoinLpIO: read_monom_obj(): obj_name: %s\n", buff);
@@ -1607,8 +2078,8 @@ CoinLpIO::read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt,
   mult = 1;
   if(buff[0] == '+') {
     mult = 1;
-    if(strlen(buff) == 1) {
-      scan_next(buff, fp);
+    if(tokens.length() == 1) {
+      buff = scan_next(tokens);
       start = buff;
     }
     else {
@@ -1618,8 +2089,8 @@ CoinLpIO::read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt,
   
   if(buff[0] == '-') {
     mult = -1;
-    if(strlen(buff) == 1) {
-      scan_next(buff, fp);
+    if(tokens.length() == 1) {
+      buff = scan_next(tokens);
       start = buff;
     }
     else {
@@ -1628,19 +2099,17 @@ CoinLpIO::read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt,
   }
   
   if(first_is_number(start)) {
-     coeff[*cnt] = atof(start);       
-    sprintf(loc_name, "aa");
-    scan_next(loc_name, fp);
+    coeff[*cnt] = CoinStrtod(start,NULL);       
+    start = scan_next(tokens);
   }
   else {
     coeff[*cnt] = 1;
-    strcpy(loc_name, start);
   }
 
-  read_st = is_subject_to(loc_name);
+  read_st = is_subject_to(start);
 
 #ifdef LPIO_DEBUG
-  printf("read_monom_obj: second buff: (%s)\n", buff);
+  printf("read_monom_obj: second buff: (%s)\n", start);
 #endif
 
   if(read_st > 0) {
@@ -1654,10 +2123,10 @@ CoinLpIO::read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt,
   }
 
   coeff[*cnt] *= mult;
-  name[*cnt] = CoinStrdup(loc_name);
+  colIndex[*cnt] = insertHash(start, 1);
 
 #ifdef LPIO_DEBUG
-  printf("read_monom_obj: (%f)  (%s)\n", coeff[*cnt], name[*cnt]);
+  printf("read_monom_obj: (%f)  (%s)\n", coeff[*cnt], start);
 #endif
 
   (*cnt)++;
@@ -1667,15 +2136,15 @@ CoinLpIO::read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt,
 
 /*************************************************************************/
 int 
-CoinLpIO::read_monom_row(FILE *fp, char *start_str, 
-			 double *coeff, char **name, 
-			 int cnt_coeff) const {
+CoinLpIO::read_monom_row(CoinLpTokenizer & tokens,
+			 double *coeff, int *colIndex, 
+			 int cnt_coeff) {
 
   double mult;
-  char buff[1024], loc_name[1024], *start;
+  char *buff, *start;
   int read_sense = -1;
 
-  sprintf(buff, "%s", start_str);
+  buff = tokens.token();
   read_sense = is_sense(buff);
   if(read_sense > -1) {
     return(read_sense);
@@ -1685,8 +2154,8 @@ CoinLpIO::read_monom_row(FILE *fp, char *start_str,
   mult = 1;
   if(buff[0] == '+') {
     mult = 1;
-    if(strlen(buff) == 1) {
-      scan_next(buff, fp);
+    if(tokens.length() == 1) {
+      buff = scan_next(tokens);
       start = buff;
     }
     else {
@@ -1696,8 +2165,8 @@ CoinLpIO::read_monom_row(FILE *fp, char *start_str,
   
   if(buff[0] == '-') {
     mult = -1;
-    if(strlen(buff) == 1) {
-      scan_next(buff, fp);
+    if(tokens.length() == 1) {
+      buff = scan_next(tokens);
       start = buff;
     }
     else {
@@ -1706,52 +2175,58 @@ CoinLpIO::read_monom_row(FILE *fp, char *start_str,
   }
   
   if(first_is_number(start)) {
-    coeff[cnt_coeff] = atof(start);       
-    scan_next(loc_name, fp);
+    coeff[cnt_coeff] = CoinStrtod(start,NULL);       
+    start = scan_next(tokens);
   }
   else {
     coeff[cnt_coeff] = 1;
-    strcpy(loc_name, start);
   }
 
   coeff[cnt_coeff] *= mult;
 #ifdef KILL_ZERO_READLP
   if (fabs(coeff[cnt_coeff])>epsilon_)
-    name[cnt_coeff] = CoinStrdup(loc_name);
+    colIndex[cnt_coeff] = insertHash(start, 1);
   else
     read_sense=-2; // effectively zero
 #else
-  name[cnt_coeff] = CoinStrdup(loc_name);
+  colIndex[cnt_coeff] = insertHash(start, 1);
 #endif
 
 #ifdef LPIO_DEBUG
   printf("CoinLpIO: read_monom_row: (%f)  (%s)\n", 
-	 coeff[cnt_coeff], name[cnt_coeff]);
+	 coeff[cnt_coeff], start);
 #endif  
   return(read_sense);
 } /* read_monom_row */
 
 /*************************************************************************/
 void
-CoinLpIO::realloc_coeff(double **coeff, char ***colNames, 
+CoinLpIO::realloc_coeff(double **coeff, int **colIndex, 
 			int *maxcoeff) const {
   
-  *maxcoeff *= 5;
-
-  *colNames = reinterpret_cast<char **> (realloc ((*colNames), (*maxcoeff+1) * sizeof(char *)));
-  *coeff = reinterpret_cast<double *> (realloc ((*coeff), (*maxcoeff+1) * sizeof(double)));
+  // grow by half - arrays end up in matrix so keep slack down
+  int newMax = *maxcoeff + (*maxcoeff >> 1) + 100;
+
+  int *newIndex = new int [newMax+1];
+  CoinMemcpyN(*colIndex, *maxcoeff, newIndex);
+  delete [] *colIndex;
+  *colIndex = newIndex;
+  double *newCoeff = new double [newMax+1];
+  CoinMemcpyN(*coeff, *maxcoeff, newCoeff);
+  delete [] *coeff;
+  *coeff = newCoeff;
+  *maxcoeff = newMax;
 
 } /* realloc_coeff */
 
 /*************************************************************************/
 void
-CoinLpIO::realloc_row(char ***rowNames, int **start, double **rhs, 
+CoinLpIO::realloc_row(char ***rowNames, CoinBigIndex **start,
 		      double **rowlow, double **rowup, int *maxrow) const {
 
-  *maxrow *= 5;
-  *rowNames = reinterpret_cast<char **> (realloc ((*rowNames), (*maxrow+1) * sizeof(char *)));
-  *start = reinterpret_cast<int *> (realloc ((*start), (*maxrow+1) * sizeof(int)));
-  *rhs = reinterpret_cast<double *> (realloc ((*rhs), (*maxrow+1) * sizeof(double)));
+  *maxrow *= 2;
+  *rowNames = reinterpret_cast<char **> (realloc ((*rowNames), (*maxrow+MAX_OBJECTIVES) * sizeof(char *)));
+  *start = reinterpret_cast<CoinBigIndex *> (realloc ((*start), (*maxrow+1) * sizeof(CoinBigIndex)));
   *rowlow = reinterpret_cast<double *> (realloc ((*rowlow), (*maxrow+1) * sizeof(double)));
   *rowup = reinterpret_cast<double *> (realloc ((*rowup), (*maxrow+1) * sizeof(double)));
 
@@ -1777,33 +2252,28 @@ CoinLpIO::realloc_col(double **collow, double **colup, char **is_int,
 
 /*************************************************************************/
 void 
-CoinLpIO::read_row(FILE *fp, char *buff,
-		   double **pcoeff, char ***pcolNames, 
+CoinLpIO::read_row(CoinLpTokenizer & tokens,
+		   double **pcoeff, int **pcolIndex, 
 		   int *cnt_coeff,
 		   int *maxcoeff,
-		   double *rhs, double *rowlow, double *rowup, 
-		   int *cnt_row, double inf) const {
+		   double *rowlow, double *rowup, 
+		   int *cnt_row, double inf) {
 
   int read_sense = -1;
-  char start_str[1024];
-  
-  sprintf(start_str, "%s", buff);
 
   while(read_sense < 0) {
 
     if((*cnt_coeff) == (*maxcoeff)) {
-      realloc_coeff(pcoeff, pcolNames, maxcoeff);
+      realloc_coeff(pcoeff, pcolIndex, maxcoeff);
     }
-    read_sense = read_monom_row(fp, start_str, 
-				*pcoeff, *pcolNames, *cnt_coeff);
+    read_sense = read_monom_row(tokens, 
+				*pcoeff, *pcolIndex, *cnt_coeff);
 #ifdef KILL_ZERO_READLP
     if (read_sense!=-2) // see if zero
 #endif
       (*cnt_coeff)++;
 
-    scan_next(start_str, fp);
-
-    if(feof(fp)) {
+    if(!tokens.next()) {
       char str[8192];
       sprintf(str,"### ERROR: Unable to read row monomial\n");
       throw CoinError(str, "read_monom_row", "CoinLpIO", __FILE__, __LINE__);
@@ -1811,14 +2281,14 @@ CoinLpIO::read_row(FILE *fp, char *buff,
   }
   (*cnt_coeff)--;
 
-  rhs[*cnt_row] = atof(start_str);
+  double rhs = CoinStrtod(tokens.token(),NULL);
 
   switch(read_sense) {
-  case 0: rowlow[*cnt_row] = -inf; rowup[*cnt_row] = rhs[*cnt_row];
+  case 0: rowlow[*cnt_row] = -inf; rowup[*cnt_row] = rhs;
     break;
-  case 1: rowlow[*cnt_row] = rhs[*cnt_row]; rowup[*cnt_row] = rhs[*cnt_row];
+  case 1: rowlow[*cnt_row] = rhs; rowup[*cnt_row] = rhs;
     break;
-  case 2: rowlow[*cnt_row] = rhs[*cnt_row]; rowup[*cnt_row] = inf; 
+  case 2: rowlow[*cnt_row] = rhs; rowup[*cnt_row] = inf; 
     break;
   default: break;
   }
@@ -1882,14 +2352,85 @@ CoinLpIO::readLp(const char *filename, const double epsilon)
 void
 CoinLpIO::readLp(const char *filename)
 {
-  FILE *fp = fopen(filename, "r");
-  if(!fp) {
+  if (modelCache_) {
+    Coin::SmartPtr<CoinCachedModel> model = viewLp(filename);
+    if (model.IsValid()) {
+      copyModel(*model->lp());
+      return;
+    }
+  }
+  CoinFileInput *input = NULL;
+  try {
+    input = CoinFileInput::create(filename, numberThreads_);
+  }
+  catch (CoinError & e) {
     char str[8192];
-    sprintf(str,"### ERROR: Unable to open file %s for reading\n", filename);
+    sprintf(str,"### ERROR: Unable to open file %s for reading (%s)\n", 
+	    filename, e.message().c_str());
     throw CoinError(str, "readLp", "CoinLpIO", __FILE__, __LINE__);
   }
-  readLp(fp);
-  fclose(fp);
+  CoinLpTokenizer tokens(input);
+  read_lp(tokens);
+}
+
+/*************************************************************************/
+Coin::SmartPtr<CoinCachedModel>
+CoinLpIO::viewLp(const char *filename) const
+{
+  Coin::SmartPtr<CoinCachedModel> model;
+  if (!modelCache_||!filename)
+    return model;
+  // everything which changes what is read
+  char settings[100];
+  sprintf(settings,"lp %.17g %.17g",epsilon_,infinity_);
+  std::string key = CoinModelCache::key(filename,settings);
+  if (key.empty())
+    return model;
+  model = modelCache_->find(key);
+  if (model.IsValid())
+    return model;
+  CoinLpIO * reader = new CoinLpIO();
+  reader->infinity_ = infinity_;
+  reader->epsilon_ = epsilon_;
+  reader->numberThreads_ = numberThreads_;
+  // messages go to our handler while reading
+  delete reader->handler_;
+  reader->handler_ = handler_;
+  reader->defaultHandler_ = false;
+  reader->messages_ = messages_;
+  try {
+    reader->readLp(filename);
+  } catch (...) {
+    reader->handler_ = NULL;
+    delete reader;
+    throw;
+  }
+  reader->handler_ = new CoinMessageHandler();
+  reader->defaultHandler_ = true;
+  model = new CoinCachedModel(reader);
+  // keep if file not changed while reading
+  if (CoinModelCache::key(filename,settings)==key)
+    modelCache_->insert(key,model.GetRawPtr());
+  return model;
+}
+
+/*************************************************************************/
+void
+CoinLpIO::copyModel(const CoinLpIO & rhs)
+{
+  if (this == &rhs)
+    return;
+  bool defaultHandler = defaultHandler_;
+  int numberThreads = numberThreads_;
+  stopHash(0);
+  stopHash(1);
+  freeAll();
+  num_objectives_ = rhs.num_objectives_;
+  for (int j = 0; j < num_objectives_; j++)
+    objName_[j] = CoinStrdup(rhs.objName_[j]);
+  gutsOfCopy(rhs);
+  defaultHandler_ = defaultHandler;
+  numberThreads_ = numberThreads;
 }
 
 /*************************************************************************/
@@ -1904,8 +2445,18 @@ CoinLpIO::readLp(FILE* fp, const double epsilon)
 void
 CoinLpIO::readLp(FILE* fp)
 {
+  CoinLpTokenizer tokens(fp);
+  read_lp(tokens);
+}
+
+/*************************************************************************/
+void
+CoinLpIO::read_lp(CoinLpTokenizer & tokens)
+{
+  COIN_TIME_SCOPE("lp.read");
 
   int maxrow = 1000;
+  int maxobj = 1000;
   int maxcoeff = 40000;
   double lp_eps = getEpsilon();
   double lp_inf = getInfinity();
@@ -1916,16 +2467,19 @@ CoinLpIO::readLp(FILE* fp)
   int num_objectives = 0;
   char *objName[MAX_OBJECTIVES] = {NULL, NULL};
   int obj_starts[MAX_OBJECTIVES+1];
-  char **colNames = reinterpret_cast<char **> 
-     (malloc ((maxcoeff+1) * sizeof(char *)));
-  double *coeff = reinterpret_cast<double *> 
-     (malloc ((maxcoeff+1) * sizeof(double)));
+  int *objIndex = new int [maxobj+1];
+  double *objCoeff = new double [maxobj+1];
+  /*
+    Constraint coefficients go straight into the arrays which the row
+    copy will own (allocated by new[] as assignMatrix wants), so the
+    matrix is never copied.
+  */
+  int *colIndex = new int [maxcoeff+1];
+  double *coeff = new double [maxcoeff+1];
   char **rowNames = reinterpret_cast<char **> 
      (malloc ((maxrow+MAX_OBJECTIVES) * sizeof(char *)));
-  int *start = reinterpret_cast<int *> 
-     (malloc ((maxrow+MAX_OBJECTIVES) * sizeof(int)));
-  double *rhs = reinterpret_cast<double *> 
-     (malloc ((maxrow+1) * sizeof(double)));
+  CoinBigIndex *start = reinterpret_cast<CoinBigIndex *> 
+     (malloc ((maxrow+MAX_OBJECTIVES) * sizeof(CoinBigIndex)));
   double *rowlow = reinterpret_cast<double *> 
      (malloc ((maxrow+1) * sizeof(double)));
   double *rowup = reinterpret_cast<double *> 
@@ -1933,68 +2487,69 @@ CoinLpIO::readLp(FILE* fp)
 
   int i;
 
-  objsense = find_obj(fp);
+  // column names are entered in order of first appearance as read
+  stopHash(1);
+  startHash(NULL, 0, 1);
+
+  objsense = find_obj(tokens);
 
   int read_st = 0;
   while(!read_st) {
-     read_st = read_monom_obj(fp, coeff, colNames, &cnt_obj, objName, &num_objectives, obj_starts);
+     read_st = read_monom_obj(tokens, objCoeff, objIndex, &cnt_obj, objName, &num_objectives, obj_starts);
 
-    if(cnt_obj == maxcoeff) {
-      realloc_coeff(&coeff, &colNames, &maxcoeff);
+    if(cnt_obj == maxobj) {
+      realloc_coeff(&objCoeff, &objIndex, &maxobj);
     }
   }
   
   obj_starts[num_objectives] = cnt_obj;
-  start[0] = cnt_obj;
-  cnt_coeff = cnt_obj;
+  start[0] = 0;
 
   if(read_st == 2) {
-    int x=fscanf(fp, "%s", buff);
-    if (x<=0)
-      throw("bad fscanf");
-    size_t lbuff = strlen(buff);
+    const char * to = scan_next(tokens);
 
-    if((lbuff != 2) || (CoinStrNCaseCmp(buff, "to", 2) != 0)) {
+    if((tokens.length() != 2) || (CoinStrNCaseCmp(to, "to", 2) != 0)) {
       char str[8192];
       sprintf(str,"### ERROR: Can not locate keyword 'Subject To'\n");
       throw CoinError(str, "readLp", "CoinLpIO", __FILE__, __LINE__);
     }
   }
   
-  scan_next(buff, fp);
+  char *token = scan_next(tokens);
 
-  while(!is_keyword(buff)) {
-    if(buff[strlen(buff)-1] == ':') {
-      buff[strlen(buff)-1] = '\0';
+  while(!is_keyword(token)) {
+    int ltoken = tokens.length();
+    if(token[ltoken-1] == ':') {
+      token[ltoken-1] = '\0';
 
 #ifdef LPIO_DEBUG
-      printf("CoinLpIO::readLp(): rowName[%d]: %s\n", cnt_row, buff);
+      printf("CoinLpIO::readLp(): rowName[%d]: %s\n", cnt_row, token);
 #endif
 
-      rowNames[cnt_row] = CoinStrdup(buff);
-      scan_next(buff, fp);
+      rowNames[cnt_row] = CoinStrdup(token);
+      scan_next(tokens);
     }
     else {
       char rname[15];
       sprintf(rname, "cons%d", cnt_row); 
       rowNames[cnt_row] = CoinStrdup(rname);
     }
-    read_row(fp, buff, 
-	     &coeff, &colNames, &cnt_coeff, &maxcoeff, rhs, rowlow, rowup, 
+    read_row(tokens, 
+	     &coeff, &colIndex, &cnt_coeff, &maxcoeff, rowlow, rowup, 
 	     &cnt_row, lp_inf);
-    scan_next(buff, fp);
+    token = scan_next(tokens);
     start[cnt_row] = cnt_coeff;
 
     if(cnt_row == maxrow) {
-      realloc_row(&rowNames, &start, &rhs, &rowlow, &rowup, &maxrow);
+      realloc_row(&rowNames, &start, &rowlow, &rowup, &maxrow);
     }
 
   }
 
   numberRows_ = cnt_row;
-
-  stopHash(1);
-  startHash(colNames, cnt_coeff, 1);
+  // rest of file is small so tokens are copied
+  strncpy(buff, token, 1023);
+  buff[1023] = '\0';
   
   COINColumnIndex icol;
   int read_sense1,  read_sense2;
@@ -2019,7 +2574,7 @@ CoinLpIO::readLp(FILE* fp)
     switch(is_keyword(buff)) {
 
     case 1: /* Bounds section */ 
-      scan_next(buff, fp);
+      scan_next(buff, tokens);
 
       while(is_keyword(buff) == 0) {
 
@@ -2031,7 +2586,7 @@ CoinLpIO::readLp(FILE* fp)
 	if(buff[0] == '-' || buff[0] == '+') {
 	  mult = (buff[0] == '-') ? -1 : +1;
 	  if(strlen(buff) == 1) {
-	    scan_next(buff, fp);
+	    scan_next(buff, tokens);
 	    start_str = buff;
 	  }
 	  else {
@@ -2041,7 +2596,7 @@ CoinLpIO::readLp(FILE* fp)
 
 	int scan_sense = 0;
 	if(first_is_number(start_str)) {
-	  bnd1 = mult * atof(start_str);
+	  bnd1 = mult * CoinStrtod(start_str,NULL);
 	  scan_sense = 1;
 	}
 	else {
@@ -2051,14 +2606,14 @@ CoinLpIO::readLp(FILE* fp)
 	  }
 	}
 	if(scan_sense) {
-	  scan_next(buff, fp);
+	  scan_next(buff, tokens);
 	  read_sense1 = is_sense(buff);
 	  if(read_sense1 < 0) {
 	    char str[8192];
 	    sprintf(str,"### ERROR: Bounds; expect a sense, get: %s\n", buff);
 	    throw CoinError(str, "readLp", "CoinLpIO", __FILE__, __LINE__);
 	  }
-	  scan_next(buff, fp);
+	  scan_next(buff, tokens);
 	}
 
 	icol = findHash(buff, 1);
@@ -2067,29 +2622,28 @@ CoinLpIO::readLp(FILE* fp)
 	  sprintf(printBuffer,"### CoinLpIO::readLp(): Variable %s does not appear in objective function or constraints", buff);
 	  handler_->message(COIN_GENERAL_WARNING,messages_)<<printBuffer
 							   <<CoinMessageEol;
-	  insertHash(buff, 1);
-	  icol = findHash(buff, 1);
+	  icol = insertHash(buff, 1);
 	  if(icol == maxcol) {
 	    realloc_col(&collow, &colup, &is_int, &maxcol);
 	  }
 	}
 
-	scan_next(buff, fp);
+	scan_next(buff, tokens);
 	if(is_free(buff)) {
 	  collow[icol] = -lp_inf;
-	  scan_next(buff, fp);
+	  scan_next(buff, tokens);
 	}
        	else {
 	  read_sense2 = is_sense(buff);
 	  if(read_sense2 > -1) {
-	    scan_next(buff, fp);
+	    scan_next(buff, tokens);
 	    mult = 1;
 	    start_str = buff;
 
 	    if(buff[0] == '-'||buff[0] == '+') {
 	      mult = (buff[0] == '-') ? -1 : +1;
 	      if(strlen(buff) == 1) {
-		scan_next(buff, fp);
+		scan_next(buff, tokens);
 		start_str = buff;
 	      }
 	      else {
@@ -2097,13 +2651,13 @@ CoinLpIO::readLp(FILE* fp)
 	      }
 	    }
 	    if(first_is_number(start_str)) {
-	      bnd2 = mult * atof(start_str);
-	      scan_next(buff, fp);
+	      bnd2 = mult * CoinStrtod(start_str,NULL);
+	      scan_next(buff, tokens);
 	    }
 	    else {
 	      if(is_inf(start_str)) {
 		bnd2 = mult * lp_inf;
-		scan_next(buff, fp);
+		scan_next(buff, tokens);
 	      }
 	      else {
 		char str[8192];
@@ -2164,7 +2718,7 @@ CoinLpIO::readLp(FILE* fp)
 
     case 2: /* Integers/Generals section */
 
-      scan_next(buff, fp);
+      scan_next(buff, tokens);
     
       while(is_keyword(buff) == 0) {
       
@@ -2180,8 +2734,7 @@ CoinLpIO::readLp(FILE* fp)
 	  sprintf(printBuffer,"### CoinLpIO::readLp(): Integer variable %s does not appear in objective function or constraints", buff);
 	  handler_->message(COIN_GENERAL_WARNING,messages_)<<printBuffer
 							   <<CoinMessageEol;
-	  insertHash(buff, 1);
-	  icol = findHash(buff, 1);
+	  icol = insertHash(buff, 1);
 	  if(icol == maxcol) {
 	    realloc_col(&collow, &colup, &is_int, &maxcol);
 	  }
@@ -2194,13 +2747,13 @@ CoinLpIO::readLp(FILE* fp)
 	}
 	is_int[icol] = 1;
 	has_int = 1;
-	scan_next(buff, fp);
+	scan_next(buff, tokens);
       };
       break;
 
     case 3: /* Binaries section */
   
-      scan_next(buff, fp);
+      scan_next(buff, tokens);
       
       while(is_keyword(buff) == 0) {
 
@@ -2216,8 +2769,7 @@ CoinLpIO::readLp(FILE* fp)
 	  sprintf(printBuffer,"### CoinLpIO::readLp(): Binary variable %s does not appear in objective function or constraints", buff);
 	  handler_->message(COIN_GENERAL_WARNING,messages_)<<printBuffer
 							   <<CoinMessageEol;
-	  insertHash(buff, 1);
-	  icol = findHash(buff, 1);
+	  icol = insertHash(buff, 1);
 	  if(icol == maxcol) {
 	    realloc_col(&collow, &colup, &is_int, &maxcol);
 	  }
@@ -2236,7 +2788,7 @@ CoinLpIO::readLp(FILE* fp)
 	if(colup[icol] > 1) {
 	  colup[icol] = 1;
 	}
-	scan_next(buff, fp);
+	scan_next(buff, tokens);
       }
       break;
 
@@ -2250,7 +2802,7 @@ CoinLpIO::readLp(FILE* fp)
 	int * which = new int [maxEntries];
 	char printBuffer[512];
 	int numberBad=0;
-	scan_next(buff, fp);
+	scan_next(buff, tokens);
 	while (true) {
 	  int numberEntries=0;
 	  int setType = -1;
@@ -2268,7 +2820,7 @@ CoinLpIO::readLp(FILE* fp)
 		    int length=strlen(buff);
 		    if (buff[length-1]==':') {
 		      goodLine=1;
-		      scan_next(buff,fp); // try again
+		      scan_next(buff,tokens); // try again
 		      continue;
 		    } else {
 		      goodLine=0;
@@ -2304,7 +2856,7 @@ CoinLpIO::readLp(FILE* fp)
 	      endLine=true;
 	    }
 	    while (!endLine) {
-	      scan_next(buff, fp);
+	      scan_next(buff, tokens);
 	      if(is_keyword(buff) == 0 && !strstr(buff,"::")) {
 		// expect pair
 		char * start_str=buff;
@@ -2320,14 +2872,14 @@ CoinLpIO::readLp(FILE* fp)
 		    int length=strlen(next+1);
 		    if (!length) {
 		      // assume user put in spaces
-		      scan_next(buff, fp);
+		      scan_next(buff, tokens);
 		      if(is_keyword(buff) != 0 || strstr(buff,"::")) {
 			goodLine=0;
 		      } else {
 			next=buff-1;
 		      }
 		    }
-		    double value = atof(next+1);
+		    double value = CoinStrtod(next+1,NULL);
 		    if (numberEntries==maxEntries) {
 		      maxEntries = 2*maxEntries;
 		      double * tempD = new double[maxEntries];
@@ -2429,25 +2981,8 @@ CoinLpIO::readLp(FILE* fp)
   printf("CoinLpIO::readLp(): Done with reading the Lp file\n");
 #endif
 
-  int *ind = reinterpret_cast<int *> (malloc ((maxcoeff+1) * sizeof(int)));
-
-  for(i=0; i<cnt_coeff; i++) {
-    ind[i] = findHash(colNames[i], 1);
-
-#ifdef LPIO_DEBUG
-    printf("CoinLpIO::readLp(): name[%d]: (%s)   ind: %d\n", 
-	   i, colNames[i], ind[i]);
-#endif
-
-    if(ind[i] < 0) {
-      char str[8192];
-      sprintf(str,"### ERROR: Hash table: %s not found\n", colNames[i]);
-      throw CoinError(str, "readLp", "CoinLpIO", __FILE__, __LINE__);
-    }
-  }
-  
   numberColumns_ = numberHash_[1];
-  numberElements_ = cnt_coeff - start[0];
+  numberElements_ = cnt_coeff;
 
   double *obj[MAX_OBJECTIVES];
 
@@ -2456,13 +2991,7 @@ CoinLpIO::readLp(FILE* fp)
      memset(obj[j], 0, numberColumns_ * sizeof(double));
 
      for(i=obj_starts[j]; i<obj_starts[j+1]; i++) {
-       icol = findHash(colNames[i], 1);
-       if(icol < 0) {
-         char str[8192];
-         sprintf(str,"### ERROR: Hash table: %s (obj) not found\n", colNames[i]);
-         throw CoinError(str, "readLp", "CoinLpIO", __FILE__, __LINE__);
-       }
-       obj[j][icol] = objsense * coeff[i];
+       obj[j][objIndex[i]] = objsense * objCoeff[i];
      }
   }
 
@@ -2476,17 +3005,25 @@ CoinLpIO::readLp(FILE* fp)
   }
 
 
-  for(i=0; i<cnt_row+1; i++) {
-    start[i] -= cnt_obj;
+  // give back slack from growing if worth it
+  if (cnt_coeff && maxcoeff - cnt_coeff > (cnt_coeff >> 3) + 100) {
+    int *tempIndex = CoinCopyOfArray(colIndex, cnt_coeff);
+    delete [] colIndex;
+    colIndex = tempIndex;
+    double *tempCoeff = CoinCopyOfArray(coeff, cnt_coeff);
+    delete [] coeff;
+    coeff = tempCoeff;
+    maxcoeff = cnt_coeff;
   }
-
-  CoinPackedMatrix *matrix = 
-    new CoinPackedMatrix(false,
-			 numberColumns_, numberRows_, numberElements_,
-			 &(coeff[cnt_obj]), &(ind[cnt_obj]), start, NULL);
+  CoinBigIndex *rowStart = CoinCopyOfArray(start, cnt_row+1);
+  int *rowLength = NULL;
+  CoinPackedMatrix matrix;
+  matrix.assignMatrix(false, numberColumns_, numberRows_, numberElements_,
+		      coeff, colIndex, rowStart, rowLength,
+		      numberRows_, maxcoeff);
 
 #ifdef LPIO_DEBUG
-  matrix->dumpMatrix();  
+  matrix.dumpMatrix();  
 #endif
   // save sets
   CoinSet ** saveSet = set_;
@@ -2494,9 +3031,13 @@ CoinLpIO::readLp(FILE* fp)
   set_ = NULL;
   numberSets_ = 0;
 
-  setLpDataWithoutRowAndColNames(*matrix, collow, colup,
+  // only dimensions are copied - the row copy is then swapped in
+  CoinPackedMatrix shell(false, 0.0, 0.0);
+  shell.setDimensions(numberRows_, numberColumns_);
+  setLpDataWithoutRowAndColNames(shell, collow, colup,
 				 const_cast<const double **>(obj), 
 				 num_objectives, has_int ? is_int : 0, rowlow, rowup);
+  matrixByRow_->swap(matrix);
 
   set_ = saveSet;
   numberSets_ = saveNumberSets;
@@ -2519,12 +3060,7 @@ CoinLpIO::readLp(FILE* fp)
 						     <<CoinMessageEol;
   } 
   
-  for(i=0; i<cnt_coeff; i++) {
-    free(colNames[i]);
-  }
-  free(colNames);
-
-  for(i=0; i<cnt_row+1; i++) {
+  for(i=0; i<cnt_row+num_objectives; i++) {
     free(rowNames[i]);
   }
   free(rowNames);
@@ -2538,21 +3074,19 @@ CoinLpIO::readLp(FILE* fp)
   printf("CoinLpIO::readLp(): read Lp file written in file readlp.xxx\n");
 #endif
 
-  free(coeff);
+  delete [] objCoeff;
+  delete [] objIndex;
   free(start);
-  free(ind);
   free(colup);
   free(collow);
-  free(rhs);
   free(rowlow);
   free(rowup);
   free(is_int);
   for (int j = 0; j < num_objectives; j++){
     free(obj[j]);
   }
-  delete matrix;
 
- } /* readLp */
+ } /* read_lp */
 
 /*************************************************************************/
 void
@@ -2616,37 +3150,6 @@ CoinLpIO::print() const {
 } /* print */
 
 
-/*************************************************************************/
-// Hash functions slightly modified from CoinMpsIO.cpp
-
-namespace {
-  const int mmult[] = {
-    262139, 259459, 256889, 254291, 251701, 249133, 246709, 244247,
-    241667, 239179, 236609, 233983, 231289, 228859, 226357, 223829,
-    221281, 218849, 216319, 213721, 211093, 208673, 206263, 203773,
-    201233, 198637, 196159, 193603, 191161, 188701, 186149, 183761,
-    181303, 178873, 176389, 173897, 171469, 169049, 166471, 163871,
-    161387, 158941, 156437, 153949, 151531, 149159, 146749, 144299,
-    141709, 139369, 136889, 134591, 132169, 129641, 127343, 124853,
-    122477, 120163, 117757, 115361, 112979, 110567, 108179, 105727,
-    103387, 101021, 98639, 96179, 93911, 91583, 89317, 86939, 84521,
-    82183, 79939, 77587, 75307, 72959, 70793, 68447, 66103
-  };
- int compute_hash(const char *name, int maxsiz, int length)
-{
-  
-  int n = 0;
-  int j;
-
-  for ( j = 0; j < length; ++j ) {
-    int iname = name[j];
-
-    n += mmult[j] * iname;
-  }
-  return ( abs ( n ) % maxsiz );	/* integer abs */
-}
-} // end file-local namespace
-
 /************************************************************************/
 //  startHash.  Creates hash list for names
 //  setup names_[section] with names in the same order as in the parameter, 
@@ -2658,115 +3161,30 @@ CoinLpIO::startHash(char const * const * const names,
 {
   maxHash_[section] = 4 * number;
   int maxhash = maxHash_[section];
-  COINColumnIndex i, ipos, iput;
 
   names_[section] = reinterpret_cast<char **> (malloc(maxhash * sizeof(char *)));
-  hash_[section] = new CoinHashLink[maxhash];
+  hash_[section] = new CoinNameHash();
   
-  CoinHashLink * hashThis = hash_[section];
+  CoinNameHash * hashThis = hash_[section];
   char **hashNames = names_[section];
-  
-  for ( i = 0; i < maxhash; i++ ) {
-    hashThis[i].index = -1;
-    hashThis[i].next = -1;
-  }
-  
-  /*
-   * Initialize the hash table.  Only the index of the first name that
-   * hashes to a value is entered in the table; subsequent names that
-   * collide with it are not entered.
-   */
-  
-  for (i=0; i<number; i++) {
-    const char *thisName = names[i];
-    int length = CoinStrlenAsInt(thisName);
-    
-    ipos = compute_hash(thisName, maxhash, length);
-    if (hashThis[ipos].index == -1) {
-      hashThis[ipos].index = i; // will be changed below
-    }
-  }
-  
+  hashThis->reserve(number);
+
   /*
-   * Now take care of the names that collided in the preceding loop,
-   * by finding some other entry in the table for them.
-   * Since there are as many entries in the table as there are names,
-   * there must be room for them.
-   * Also setting up hashNames.
+   * Names are entered as they are first seen so duplicates are dropped
+   * and the others renumbered consecutively.
    */
 
   int cnt_distinct = 0;
   
-  iput = -1;
-  for (i=0; i<number; i++) {
+  for (COINColumnIndex i=0; i<number; i++) {
     const char *thisName = names[i];
-    int length = CoinStrlenAsInt(thisName);
-    
-    ipos = compute_hash(thisName, maxhash, length);
-    
-    while (1) {
-      COINColumnIndex j1 = hashThis[ipos].index;
-      
-      if(j1 == i) {
-
-	// first occurence of thisName in the parameter "names"
 
-	hashThis[ipos].index = cnt_distinct;
-	hashNames[cnt_distinct] = CoinStrdup(thisName);
-	cnt_distinct++;
-	break;
-      }
-      else {
-
-#ifdef LPIO_DEBUG
-	if(j1 > i) {
-	  char str[8192];
-	  sprintf(str,"### ERROR: Hash table: j1: %d  i: %d\n", j1, i);
-	  throw CoinError(str, "startHash", "CoinLpIO", __FILE__, __LINE__);
-	}
-#endif
-
-	if (strcmp(thisName, hashNames[j1]) == 0) {
-
-	  // thisName already entered
-
-	  break;
-	}
-	else {
-	  // Collision; check if thisName already entered
-
-	  COINColumnIndex k = hashThis[ipos].next;
-
-	  if (k == -1) {
-
-	    // thisName not found; enter it
-
-	    while (1) {
-	      ++iput;
-	      if (iput > maxhash) {
-		char str[8192];
-		sprintf(str,"### ERROR: Hash table: too many names\n");
-		throw CoinError(str, "startHash", "CoinLpIO", __FILE__, __LINE__);
-		break;
-	      }
-	      if (hashThis[iput].index == -1) {
-		break;
-	      }
-	    }
-	    hashThis[ipos].next = iput;
-	    hashThis[iput].index = cnt_distinct;
-	    hashNames[cnt_distinct] = CoinStrdup(thisName);
-	    cnt_distinct++;
-	    break;
-	  } 
-	  else {
-	    ipos = k;
+    if (hashThis->add(cnt_distinct, thisName) == cnt_distinct) {
 
-	    // continue the check with names in collision 
+      // first occurence of thisName in the parameter "names"
 
-	  }
-	}
-      }
+      hashNames[cnt_distinct] = CoinStrdup(thisName);
+      cnt_distinct++;
     }
   }
 
@@ -2783,7 +3201,7 @@ CoinLpIO::stopHash(int section)
   previous_names_[section] = names_[section];
   card_previous_names_[section] = numberHash_[section];
 
-  delete[] hash_[section];
+  delete hash_[section];
   hash_[section] = NULL;
 
   maxHash_[section] = 0;
@@ -2804,104 +3222,32 @@ CoinLpIO::stopHash(int section)
 COINColumnIndex
 CoinLpIO::findHash(const char *name, int section) const
 {
-  COINColumnIndex found = -1;
-
-  char ** names = names_[section];
-  CoinHashLink * hashThis = hash_[section];
-  COINColumnIndex maxhash = maxHash_[section];
-  COINColumnIndex ipos;
-
   /* default if we don't find anything */
-  if (!maxhash)
+  if (!hash_[section])
     return -1;
 
-  int length = CoinStrlenAsInt(name);
-
-  ipos = compute_hash(name, maxhash, length);
-  while (1) {
-    COINColumnIndex j1 = hashThis[ipos].index;
-
-    if (j1 >= 0) {
-      char *thisName2 = names[j1];
-
-      if (strcmp (name, thisName2) != 0) {
-	COINColumnIndex k = hashThis[ipos].next;
-
-	if (k != -1)
-	  ipos = k;
-	else
-	  break;
-      } 
-      else {
-	found = j1;
-	break;
-      }
-    } 
-    else {
-      found = -1;
-      break;
-    }
-  }
-  return found;
+  return hash_[section]->find(name);
 } /* findHash */
 
 /*********************************************************************/
-void
+COINColumnIndex
 CoinLpIO::insertHash(const char *thisName, int section)
 {
 
   int number = numberHash_[section];
   int maxhash = maxHash_[section];
 
-  CoinHashLink * hashThis = hash_[section];
-  char **hashNames = names_[section];
-
-  int iput = -1;
-  int length = CoinStrlenAsInt(thisName);
-
-  int ipos = compute_hash(thisName, maxhash, length);
-
-  while (1) {
-    COINColumnIndex j1 = hashThis[ipos].index;
-    
-    if (j1 == -1) {
-      hashThis[ipos].index = number;
-      break;
-    }
-    else {
-      char *thisName2 = hashNames[j1];
-      
-      if ( strcmp (thisName, thisName2) != 0 ) {
-	COINColumnIndex k = hashThis[ipos].next;
-
-	if (k == -1) {
-	  while (1) {
-	    ++iput;
-	    if (iput == maxhash) {
-	      char str[8192];
-	      sprintf(str,"### ERROR: Hash table: too many names\n");
-	      throw CoinError(str, "insertHash", "CoinLpIO", __FILE__, __LINE__);
-	      break;
-	    }
-	    if (hashThis[iput].index == -1) {
-	      break;
-	    }
-	  }
-	  hashThis[ipos].next = iput;
-	  hashThis[iput].index = number;
-	  break;
-	} 
-	else {
-	  ipos = k;
-	  /* nothing worked - try it again */
-	}
-      }
+  int index = hash_[section]->add(number, thisName);
+  if (index == number) {
+    if (number == maxhash) {
+      maxHash_[section] = 2 * maxhash + 100;
+      names_[section] = reinterpret_cast<char **> 
+	(realloc(names_[section], maxHash_[section] * sizeof(char *)));
     }
+    names_[section][number] = CoinStrdup(thisName);
+    (numberHash_[section])++;
   }
-
-  hashNames[number] = CoinStrdup(thisName);
-  (numberHash_[section])++;
-
+  return index;
 }
 // Pass in Message handler (not deleted at end)
 void 
@@ -19,7 +19,11 @@
 
 #include "CoinPackedMatrix.hpp"
 #include "CoinMessage.hpp"
+#include "CoinModelCache.hpp"
 class CoinSet;
+class CoinNameHash;
+class CoinLpTokenizer;
+class CoinLpOutput;
 
 const int MAX_OBJECTIVES = 2;
 
@@ -323,6 +327,23 @@ public:
   /// Set decimals.
   /// Default: 5
   void setDecimals(const int);
+
+  /// Number of threads used to format rows and bounds when writing
+  /// and to decompress compressed files when reading
+  inline int numberThreads() const
+  { return numberThreads_;}
+
+  /// Set number of threads (1 unless thread aware build).
+  /// Default: 1
+  void setNumberThreads(int value);
+
+  /// Cache which readLp(filename) uses for local files (see
+  /// CoinModelCache).  Not owned or copied.
+  /// Default: NULL (none)
+  inline CoinModelCache * modelCache() const
+  { return modelCache_;}
+  inline void setModelCache(CoinModelCache * cache)
+  { modelCache_ = cache;}
   //@}
 
   /**@name Public methods */
@@ -463,6 +484,16 @@ public:
   /// Write objective function name and row names if useRowNames = true.
   int writeLp(FILE *fp, const bool useRowNames = true);
 
+  /// Write the data in Lp format in the file with name filename,
+  /// compressed if compression is 1 (gzip, ".gz" added to filename if
+  /// not there), 2 (bzip2, ".bz2" added), 3 (zstd, ".zst" added) or
+  /// 4 (lz4, ".lz4" added).  If the library was not compiled with zstd
+  /// or lz4 gzip is asked for instead, and if not with gzip or bzip2 the
+  /// other one is used if possible, otherwise a plain file is written
+  /// (as CoinMpsIO::writeMps).
+  /// Write objective function name and row names if useRowNames = true.
+  int writeLp(const char *filename, const bool useRowNames, int compression);
+
   /// Read the data in Lp format from the file with name filename, using
   /// the given value for epsilon. If the original problem is
   /// a maximization problem, the objective function is immediadtly 
@@ -470,11 +501,24 @@ public:
   void readLp(const char *filename, const double epsilon);
 
   /// Read the data in Lp format from the file with name filename.
+  /// The file may be compressed with gzip or bzip2 if support for
+  /// these was compiled in.
   /// If the original problem is
   /// a maximization problem, the objective function is immediadtly 
   /// flipped to get a minimization problem.  
   void readLp(const char *filename);
 
+  /// Cached model of the file as readLp(filename) would read it, reading
+  /// it into the model cache if needed.  Not copied and shared with other
+  /// callers, so read only.  This object is not changed (but messages go
+  /// to its handler).  NULL if there is no cache or the file can not be
+  /// cached.  Throws as readLp.
+  Coin::SmartPtr<CoinCachedModel> viewLp(const char *filename) const;
+
+  /// Replaces model by a copy of that in rhs (as after readLp).
+  /// Message handler, number of threads and cache are kept.
+  void copyModel(const CoinLpIO & rhs);
+
   /// Read the data in Lp format from the file stream, using
   /// the given value for epsilon.
   /// If the original problem is
@@ -616,6 +660,12 @@ protected:
   /// Number of decimals printed for coefficients
   int decimals_;
 
+  /// Number of threads used when writing
+  int numberThreads_;
+
+  /// Model cache (not owned)
+  CoinModelCache * modelCache_;
+
   /// Objective function name
   char *objName_[MAX_OBJECTIVES];
 
@@ -639,11 +689,7 @@ protected:
   /// section = 1 for column names. 
   char **names_[2];
 
-  typedef struct {
-    int index, next;
-  } CoinHashLink;
-
-  /// Maximum number of entries in a hash table section.
+  /// Maximum number of entries in a hash table section (size of names_).
   /// section = 0 for row names, 
   /// section = 1 for column names. 
   int maxHash_[2];
@@ -656,7 +702,7 @@ protected:
   /// Hash tables with two sections.
   /// section = 0 for row names (including objective function name), 
   /// section = 1 for column names. 
-  mutable CoinHashLink *hash_[2];
+  mutable CoinNameHash *hash_[2];
 
   /// Build the hash table for the given names. The parameter number is
   /// the cardinality of parameter names. Remove duplicate names. 
@@ -679,19 +725,22 @@ protected:
   COINColumnIndex findHash(const char *name, int section) const;
 
   /// Insert thisName in the hash table if not present yet; does nothing
-  /// if the name is already in.
+  /// if the name is already in. Return the index of the name.
   /// section = 0 for row names, 
   /// section = 1 for column names. 
-  void insertHash(const char *thisName, int section);
+  COINColumnIndex insertHash(const char *thisName, int section);
 
   /// Write a coefficient.
   /// print_1 = 0 : do not print the value 1.
   void out_coeff(FILE *fp, double v, int print_1) const;
 
+  /// Write the data in Lp format to output (used by writeLp()).
+  int write_lp(CoinLpOutput & output, const bool useRowNames);
+
   /// Locate the objective function. 
   /// Return 1 if found the keyword "Minimize" or one of its variants, 
   /// -1 if found keyword "Maximize" or one of its variants.
-  int find_obj(FILE *fp) const;
+  int find_obj(CoinLpTokenizer & tokens) const;
 
   /// Return an integer indicating if the keyword "subject to" or one
   /// of its variants has been read.
@@ -708,11 +757,12 @@ protected:
   /// Return 0 otherwise.
   int is_comment(const char *buff) const;
 
-  /// Read the file fp until buff contains an end of line
-  void skip_comment(char *buff, FILE *fp) const;
+  /// Move to the next string that is not part of a comment and return it.
+  /// The string may be changed but is only valid until tokens is next used.
+  char * scan_next(CoinLpTokenizer & tokens) const;
 
   /// Put in buff the next string that is not part of a comment
-  void scan_next(char *buff, FILE *fp) const;
+  void scan_next(char *buff, CoinLpTokenizer & tokens) const;
 
   /// Return 1 if buff is the keyword "free" or one of its variants.
   /// Return 0 otherwise.
@@ -743,33 +793,39 @@ protected:
   int is_keyword(const char *buff) const;
 
   /// Read a monomial of the objective function.
+  /// The column is entered in the hash table and its index put in colIndex.
   /// Return 1 if "subject to" or one of its variants has been read.
-  int read_monom_obj(FILE *fp, double *coeff, char **name, int *cnt, 
-		     char **obj_name, int *num_objectives, int *obj_starts);
+  int read_monom_obj(CoinLpTokenizer & tokens, double *coeff, int *colIndex,
+		     int *cnt, char **obj_name, int *num_objectives,
+		     int *obj_starts);
 
-  /// Read a monomial of a constraint.
+  /// Read a monomial of a constraint starting at the current string.
+  /// The column is entered in the hash table and its index put in colIndex.
   /// Return a positive number if the sense of the inequality has been 
   /// read (see method is_sense() for the return code).
   /// Return -1 otherwise.
-  int read_monom_row(FILE *fp, char *start_str, double *coeff, char **name, 
-		     int cnt_coeff) const;
+  int read_monom_row(CoinLpTokenizer & tokens, double *coeff, int *colIndex,
+		     int cnt_coeff);
 
   /// Reallocate vectors related to number of coefficients.
-  void realloc_coeff(double **coeff, char ***colNames, int *maxcoeff) const;
+  void realloc_coeff(double **coeff, int **colIndex, int *maxcoeff) const;
 
   /// Reallocate vectors related to rows.
-  void realloc_row(char ***rowNames, int **start, double **rhs, 
+  void realloc_row(char ***rowNames, CoinBigIndex **start,
 		   double **rowlow, double **rowup, int *maxrow) const;
     
   /// Reallocate vectors related to columns.
   void realloc_col(double **collow, double **colup, char **is_int,
 		   int *maxcol) const;
 
-  /// Read a constraint.
-  void read_row(FILE *fp, char *buff, double **pcoeff, char ***pcolNames, 
+  /// Read a constraint starting at the current string.
+  void read_row(CoinLpTokenizer & tokens, double **pcoeff, int **pcolIndex, 
 		int *cnt_coeff, int *maxcoeff,
-		     double *rhs, double *rowlow, double *rowup, 
-		     int *cnt_row, double inf) const;
+		     double *rowlow, double *rowup, 
+		     int *cnt_row, double inf);
+
+  /// Read an Lp file from tokens (used by readLp()).
+  void read_lp(CoinLpTokenizer & tokens);
 
   /** Check that current objective name and all row names are distinct
       including row names obtained by adding "_low" for ranged constraints.
@@ -49,6 +49,7 @@ static Coin_message us_english[]=
   {COIN_PRESOLVE_POSTSOLVE,511,1,"After Postsolve, objective %g, infeasibilities - dual %g (%d), primal %g (%d)"},
   {COIN_PRESOLVE_NEEDS_CLEANING,512,1,"Presolved model was optimal, full model needs cleaning up"},
   {COIN_PRESOLVE_PASS,513,3,"%d rows dropped after presolve pass %d"},
+  {COIN_PRESOLVE_PROFILE,519,1,"Presolve %s called %d times in %g seconds removed %d rows, %d columns and %d elements - postsolve %g seconds"},
 # if PRESOLVE_DEBUG
   { COIN_PRESOLDBG_FIRSTCHECK,514,3,"First occurrence of %s checks." },
   { COIN_PRESOLDBG_RCOSTACC,515,3,
@@ -55,6 +55,7 @@ enum COIN_Message
   COIN_PRESOLVE_POSTSOLVE,
   COIN_PRESOLVE_NEEDS_CLEANING,
   COIN_PRESOLVE_PASS,
+  COIN_PRESOLVE_PROFILE,
 # if PRESOLVE_DEBUG
   COIN_PRESOLDBG_FIRSTCHECK,
   COIN_PRESOLDBG_RCOSTACC,
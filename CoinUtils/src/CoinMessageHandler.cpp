@@ -178,6 +178,18 @@ CoinMessages::operator=(const CoinMessages & rhs)
   }
   return *this;
 }
+// Exchange messages (packed ones point into their own block)
+void 
+CoinMessages::swap(CoinMessages & rhs)
+{
+  std::swap(numberMessages_,rhs.numberMessages_);
+  std::swap(language_,rhs.language_);
+  for (int i=0;i<5;i++)
+    std::swap(source_[i],rhs.source_[i]);
+  std::swap(class_,rhs.class_);
+  std::swap(lengthMessages_,rhs.lengthMessages_);
+  std::swap(message_,rhs.message_);
+}
 // Puts message in correct place
 void 
 CoinMessages::addMessage(int messageNumber, const CoinOneMessage & message)
@@ -471,7 +483,11 @@ CoinMessageHandler::CoinMessageHandler() :
   format_(NULL),
   printStatus_(0),
   highestNumber_(-1),
-  fp_(stdout)
+  fp_(stdout),
+  threadSafe_(false),
+  deferred_(NULL),
+  deferredSource_(NULL),
+  binaryLog_(NULL)
 {
   const char* g_default = "%.8g";
 
@@ -493,7 +509,11 @@ CoinMessageHandler::CoinMessageHandler(FILE * fp) :
   format_(NULL),
   printStatus_(0),
   highestNumber_(-1),
-  fp_(fp)
+  fp_(fp),
+  threadSafe_(false),
+  deferred_(NULL),
+  deferredSource_(NULL),
+  binaryLog_(NULL)
 {
   const char* g_default = "%.8g";
   
@@ -546,6 +566,11 @@ CoinMessageHandler::gutsOfCopy(const CoinMessageHandler& rhs)
   source_ = rhs.source_;
   strcpy(g_format_,rhs.g_format_);
   g_precision_ = rhs.g_precision_ ;
+  threadSafe_ = false;
+  deferred_ = rhs.deferred_;
+  deferredSource_ = rhs.deferredSource_;
+  binaryLog_ = rhs.binaryLog_;
+  binaryRecord_ = rhs.binaryRecord_;
 }
 /* The copy constructor */
 CoinMessageHandler::CoinMessageHandler(const CoinMessageHandler& rhs)
@@ -582,58 +607,91 @@ CoinMessageHandler::clone() const
   this is used in a scheme where individual bits enable particular debug
   output.
 */
-void CoinMessageHandler::calcPrintStatus (int msglvl, int msgclass)
+int CoinMessageHandler::printStatusFor (int msglvl, int msgclass) const
 {
-  printStatus_ = 0 ;
   if (logLevels_[0] == -1000) {
     if (msglvl >= 8 && logLevel_ >= 0) {
       if ((msglvl&logLevel_) == 0)
-	printStatus_ = 3 ;
+	return 3 ;
     } else if (logLevel_ < msglvl) {
-      printStatus_ = 3 ;
+      return 3 ;
     }
   } else if (logLevels_[msgclass] < msglvl) {
-    printStatus_ = 3;
+    return 3 ;
   }
+  return 0 ;
 }
 
 /*
   Start a message using a standard CoinOneMessage.
+
+  The print decision comes first, so a suppressed message costs a lookup
+  and a comparison. Only if it is later turned on (message(loglvl)) is it
+  set up.
 */
 CoinMessageHandler & 
 CoinMessageHandler::message (int messageNumber,
 			     const CoinMessages &normalMessages)
 {
+  if (threadSafe_)
+    return localHandler()->message(messageNumber,normalMessages) ;
   // Deal with the previous message, if there is one.
   if (messageOut_ != messageBuffer_) {
     internalPrint() ;
   }
+  if (!binaryRecord_.empty())
+    writeBinary() ;
   // Acquire the new message
   internalNumber_ = messageNumber ;
-  currentMessage_ = *(normalMessages.message_[messageNumber]) ;
-  source_ = normalMessages.source_ ;
-  format_ = currentMessage_.message_ ;
-  highestNumber_ = CoinMax(highestNumber_,currentMessage_.externalNumber_);
+  const CoinOneMessage * oneMessage = normalMessages.message_[messageNumber] ;
+  highestNumber_ = CoinMax(highestNumber_,oneMessage->externalNumber_);
+  deferred_ = oneMessage ;
+  deferredSource_ = normalMessages.source_ ;
 
   // Initialise the message construction buffer
   messageBuffer_[0] = '\0' ;
   messageOut_ = messageBuffer_ ;
+  format_ = NULL ;
 
   // Decide whether or not to print (sets printStatus_)
-  calcPrintStatus(currentMessage_.detail_,normalMessages.class_) ;
+  calcPrintStatus(oneMessage->detail_,normalMessages.class_) ;
 
   // If we're printing, initialise the message
-  if (!printStatus_) {
-    if (prefix_) {
-      sprintf(messageOut_,"%s%4.4d%c ",source_.c_str(),
-	      currentMessage_.externalNumber_,
-	      currentMessage_.severity_) ;
-      messageOut_ += strlen(messageOut_) ;
-    }
-    format_ = nextPerCent(format_,true) ;
-  }
+  if (!printStatus_)
+    startMessage() ;
   return (*this) ;
 }
+/*
+  Set up the deferred standard message - prefix and text to first format
+  code, or the start of a binary record.
+*/
+void
+CoinMessageHandler::startMessage ()
+{
+  const CoinOneMessage * oneMessage = deferred_ ;
+  deferred_ = NULL ;
+  source_ = deferredSource_ ;
+  if (binaryLog_) {
+    // just what checkSeverity needs
+    currentMessage_.externalNumber_ = oneMessage->externalNumber_ ;
+    currentMessage_.severity_ = oneMessage->severity_ ;
+    currentMessage_.detail_ = oneMessage->detail_ ;
+    printStatus_ = 4 ;
+    binaryRecord_.assign(sizeof(int),0) ;
+    binaryAppend('M',&internalNumber_,sizeof(int)) ;
+    binaryAppend(deferredSource_,strlen(deferredSource_)+1) ;
+    return ;
+  }
+  currentMessage_ = *oneMessage ;
+  format_ = currentMessage_.message_ ;
+  if (prefix_) {
+    sprintf(messageOut_,"%s%4.4d%c ",source_.c_str(),
+	    currentMessage_.externalNumber_,
+	    currentMessage_.severity_) ;
+    messageOut_ += strlen(messageOut_) ;
+  }
+  format_ = nextPerCent(format_,true) ;
+}
 /*
   Start a message, providing the full message, information to generate
   a prefix, a severity code, and an optional log level.
@@ -643,10 +701,15 @@ CoinMessageHandler &
 CoinMessageHandler::message (int externalNumber, const char *source,
 			     const char *msg, char severity, int loglvl)
 {
+  if (threadSafe_)
+    return localHandler()->message(externalNumber,source,msg,severity,loglvl) ;
   // Deal with the previous message, if there is one.
   if (messageOut_ != messageBuffer_) {
     internalPrint() ;
   }
+  if (!binaryRecord_.empty())
+    writeBinary() ;
+  deferred_ = NULL ;
   // Set up a dummy message.
   internalNumber_ = externalNumber ;
   char detail = ((loglvl >= 0)?(static_cast<char>(loglvl)):'\000') ;
@@ -664,7 +727,14 @@ CoinMessageHandler::message (int externalNumber, const char *source,
     compatibility (previously there was no provision for a log level).
   */
   if (loglvl >= 0) calcPrintStatus(loglvl,0) ;
-  if (!printStatus_) {
+  if (!printStatus_ && binaryLog_) {
+    printStatus_ = 5 ;
+    binaryRecord_.assign(sizeof(int),0) ;
+    binaryAppend('T',&externalNumber,sizeof(int)) ;
+    binaryRecord_.push_back(severity) ;
+    binaryAppend(source,strlen(source)+1) ;
+    binaryAppend(msg,strlen(msg)+1) ;
+  } else if (!printStatus_) {
     printStatus_ = 2 ;
     if (prefix_) {
       sprintf(messageOut_,"%s%4.4d%c ",source_.c_str(),
@@ -682,8 +752,22 @@ CoinMessageHandler::message (int externalNumber, const char *source,
 CoinMessageHandler & 
 CoinMessageHandler::message(int loglvl)
 {
+  if (threadSafe_)
+    return localHandler()->message(loglvl) ;
   // Adjust print status?
-  if (loglvl >= 0) calcPrintStatus(loglvl,0) ;
+  if (loglvl >= 0) {
+    const int oldStatus = printStatus_ ;
+    calcPrintStatus(loglvl,0) ;
+    if (oldStatus >= 4) {
+      // binary record under way - keep or drop it
+      if (printStatus_ == 3)
+	binaryRecord_.clear() ;
+      else
+	printStatus_ = oldStatus ;
+    } else if (oldStatus == 3 && !printStatus_ && deferred_) {
+      startMessage() ;
+    }
+  }
 
   return (*this) ;
 }
@@ -694,6 +778,12 @@ CoinMessageHandler::message(int loglvl)
 CoinMessageHandler & 
 CoinMessageHandler::printing(bool onOff)
 {
+  if (threadSafe_)
+    return localHandler()->printing(onOff);
+  if (printStatus_ == 4) {
+    char on = onOff ? 1 : 0 ;
+    binaryAppend('p',&on,1) ;
+  }
   // has no effect if skipping or whole message in
   if (printStatus_ < 2) {
     assert(format_[1]=='?');
@@ -715,12 +805,18 @@ CoinMessageHandler::printing(bool onOff)
 int 
 CoinMessageHandler::finish()
 {
+  if (threadSafe_)
+    return localHandler()->finish();
   // Deal with the collected message
   if (printStatus_ < 3 && messageOut_ != messageBuffer_) {
     internalPrint();
+  } else if (printStatus_ >= 4 && !binaryRecord_.empty()) {
+    writeBinary();
+    checkSeverity();
   }
   // Clean up for the next message.
   internalNumber_ = -1 ;
+  deferred_ = NULL ;
   format_ = NULL ;
   messageBuffer_[0] = '\0' ;
   messageOut_ = messageBuffer_ ;
@@ -785,10 +881,19 @@ CoinMessageHandler::nextPerCent(char * start , const bool initial)
 }
 // Adds into message
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (int intvalue)
+CoinMessageHandler::addValue (int intvalue)
 {
+  if (threadSafe_)
+    return *localHandler() << intvalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4) {
+      int value = intvalue;
+      binaryAppend('i',&value,sizeof(value));
+    }
+    return *this;
+  }
   longValue_.push_back(intvalue);
   if (printStatus_<2) {
     if (format_) {
@@ -809,10 +914,19 @@ CoinMessageHandler::operator<< (int intvalue)
   return *this;
 }
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (double doublevalue)
+CoinMessageHandler::addValue (double doublevalue)
 {
+  if (threadSafe_)
+    return *localHandler() << doublevalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4) {
+      double value = doublevalue;
+      binaryAppend('d',&value,sizeof(value));
+    }
+    return *this;
+  }
   doubleValue_.push_back(doublevalue);
 
   if (printStatus_<2) {
@@ -848,10 +962,19 @@ CoinMessageHandler::operator<< (double doublevalue)
 }
 #if COIN_BIG_INDEX==1
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (long longvalue)
+CoinMessageHandler::addValue (long longvalue)
 {
+  if (threadSafe_)
+    return *localHandler() << longvalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4) {
+      long long value = longvalue;
+      binaryAppend('l',&value,sizeof(value));
+    }
+    return *this;
+  }
   longValue_.push_back(longvalue);
   if (printStatus_<2) {
     if (format_) {
@@ -874,10 +997,19 @@ CoinMessageHandler::operator<< (long longvalue)
 #endif
 #if COIN_BIG_INDEX==2
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (long long longvalue)
+CoinMessageHandler::addValue (long long longvalue)
 {
+  if (threadSafe_)
+    return *localHandler() << longvalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4) {
+      long long value = longvalue;
+      binaryAppend('l',&value,sizeof(value));
+    }
+    return *this;
+  }
   longValue_.push_back(longvalue);
   if (printStatus_<2) {
     if (format_) {
@@ -899,10 +1031,17 @@ CoinMessageHandler::operator<< (long long longvalue)
 }
 #endif
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (const std::string& stringvalue)
+CoinMessageHandler::addValue (const std::string& stringvalue)
 {
+  if (threadSafe_)
+    return *localHandler() << stringvalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4)
+      binaryAppend('s',stringvalue.c_str(),stringvalue.size()+1);
+    return *this;
+  }
   stringValue_.push_back(stringvalue);
   if (printStatus_<2) {
     if (format_) {
@@ -923,10 +1062,19 @@ CoinMessageHandler::operator<< (const std::string& stringvalue)
   return *this;
 }
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (char charvalue)
+CoinMessageHandler::addValue (char charvalue)
 {
+  if (threadSafe_)
+    return *localHandler() << charvalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4) {
+      char value = charvalue;
+      binaryAppend('c',&value,sizeof(value));
+    }
+    return *this;
+  }
   charValue_.push_back(charvalue);
   if (printStatus_<2) {
     if (format_) {
@@ -947,10 +1095,17 @@ CoinMessageHandler::operator<< (char charvalue)
   return *this;
 }
 CoinMessageHandler & 
-CoinMessageHandler::operator<< (const char *stringvalue)
+CoinMessageHandler::addValue (const char *stringvalue)
 {
+  if (threadSafe_)
+    return *localHandler() << stringvalue;
   if (printStatus_==3)
     return *this; // not doing this message
+  if (printStatus_>=4) {
+    if (printStatus_==4)
+      binaryAppend('s',stringvalue,strlen(stringvalue)+1);
+    return *this;
+  }
   stringValue_.push_back(stringvalue);
   if (printStatus_<2) {
     if (format_) {
@@ -978,13 +1133,17 @@ CoinMessageHandler::operator<< (const char *stringvalue)
 CoinMessageHandler & 
 CoinMessageHandler::operator<< (CoinMessageMarker marker)
 {
+  if (threadSafe_)
+    return *localHandler() << marker;
   switch (marker) {
     case CoinMessageEol: {
       finish() ;
       break ;
     }
     case CoinMessageNewline: {
-      if (printStatus_ != 3) {
+      if (printStatus_ == 4) {
+	binaryRecord_.push_back('n') ;
+      } else if (printStatus_ < 3) {
 	strcat(messageOut_,"\n") ;
 	messageOut_++ ;
       }
@@ -993,3 +1152,145 @@ CoinMessageHandler::operator<< (CoinMessageMarker marker)
   }
   return (*this) ;
 }
+
+// Write binary record (if any) and clear it
+void
+CoinMessageHandler::writeBinary ()
+{
+  if (binaryRecord_.size() > sizeof(int)) {
+    int length = static_cast<int>(binaryRecord_.size()-sizeof(int)) ;
+    memcpy(&binaryRecord_[0],&length,sizeof(int)) ;
+    fwrite(&binaryRecord_[0],1,binaryRecord_.size(),binaryLog_) ;
+  }
+  binaryRecord_.clear() ;
+}
+
+/*
+  Format the records of a binary log. Each record is an int length and
+  then 'M', internal number, source and tagged values, or 'T', external
+  number, severity, source and text.
+*/
+int
+CoinMessageHandler::replayBinaryLog (FILE * fp,
+				     const CoinMessages * const * messages,
+				     int numberMessages)
+{
+  FILE * saveLog = binaryLog_ ;
+  binaryLog_ = NULL ;
+  int numberRecords = 0 ;
+  std::vector<char> record ;
+  int length ;
+  while (fread(&length,sizeof(int),1,fp) == 1) {
+    if (length <= 0) {
+      numberRecords = -1 ;
+      break ;
+    }
+    record.resize(length+1) ;
+    if (fread(&record[0],1,length,fp) != static_cast<size_t>(length)) {
+      numberRecords = -1 ;
+      break ;
+    }
+    record[length] = '\0' ;
+    const char * at = &record[0] ;
+    const char * end = at+length ;
+    const char kind = *at++ ;
+    int number ;
+    if (kind == 'T') {
+      if (end-at < static_cast<int>(sizeof(int))+1) {
+	numberRecords = -1 ;
+	break ;
+      }
+      memcpy(&number,at,sizeof(int)) ;
+      at += sizeof(int) ;
+      const char severity = *at++ ;
+      const char * source = at ;
+      at += strlen(at)+1 ;
+      if (at >= end) {
+	numberRecords = -1 ;
+	break ;
+      }
+      message(number,source,at,severity) ;
+      finish() ;
+      numberRecords++ ;
+      continue ;
+    }
+    if (kind != 'M' || end-at < static_cast<int>(sizeof(int))) {
+      numberRecords = -1 ;
+      break ;
+    }
+    memcpy(&number,at,sizeof(int)) ;
+    at += sizeof(int) ;
+    const char * source = at ;
+    at += strlen(at)+1 ;
+    const CoinMessages * theseMessages = NULL ;
+    for (int i = 0 ; i < numberMessages ; i++) {
+      if (!strcmp(messages[i]->source_,source)) {
+	theseMessages = messages[i] ;
+	break ;
+      }
+    }
+    if (!theseMessages || number < 0 ||
+	number >= theseMessages->numberMessages_)
+      continue ;
+    message(number,*theseMessages) ;
+    bool ok = true ;
+    while (ok && at < end) {
+      const char tag = *at++ ;
+      switch (tag) {
+	case 'i': {
+	  int value ;
+	  memcpy(&value,at,sizeof(value)) ;
+	  at += sizeof(value) ;
+	  *this << value ;
+	  break ;
+	}
+	case 'l': {
+	  long long value ;
+	  memcpy(&value,at,sizeof(value)) ;
+	  at += sizeof(value) ;
+#if COIN_BIG_INDEX==2
+	  *this << value ;
+#elif COIN_BIG_INDEX==1
+	  *this << static_cast<long>(value) ;
+#else
+	  *this << static_cast<int>(value) ;
+#endif
+	  break ;
+	}
+	case 'd': {
+	  double value ;
+	  memcpy(&value,at,sizeof(value)) ;
+	  at += sizeof(value) ;
+	  *this << value ;
+	  break ;
+	}
+	case 's':
+	  *this << at ;
+	  at += strlen(at)+1 ;
+	  break ;
+	case 'c':
+	  *this << *at++ ;
+	  break ;
+	case 'p':
+	  printing(*at++ != 0) ;
+	  break ;
+	case 'n':
+	  *this << CoinMessageNewline ;
+	  break ;
+	default:
+	  ok = false ;
+	  break ;
+      }
+      if (at > end)
+	ok = false ;
+    }
+    finish() ;
+    if (!ok) {
+      numberRecords = -1 ;
+      break ;
+    }
+    numberRecords++ ;
+  }
+  binaryLog_ = saveLog ;
+  return (numberRecords) ;
+}
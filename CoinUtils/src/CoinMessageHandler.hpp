@@ -149,6 +149,8 @@ public:
   CoinMessages(const CoinMessages&);
   /** assignment operator. */
   CoinMessages& operator=(const CoinMessages&);
+  /** Exchange messages with \p rhs (no copying). */
+  void swap(CoinMessages & rhs);
   //@}
 
   /**@name Useful stuff */
@@ -337,6 +339,11 @@ public:
   /** Check message severity - if too bad then abort
   */
   virtual void checkSeverity() ;
+  /** Handler which formats messages for the calling thread.  This one
+      unless the handler is thread safe (see CoinThreadMessageHandler).
+  */
+  virtual CoinMessageHandler * localHandler()
+  { return this;}
    //@}
 
   /**@name Constructors etc */
@@ -473,6 +480,18 @@ public:
   
   /**@name Actions to create a message  */
   //@{
+  /*! \brief True if message \p messageNumber would print (or go to the
+    binary log) at the current log levels.
+
+    Lets callers skip computing the values of a message which will not be
+    used.  message() makes the same test before it does anything else, and
+    the << operators do nothing for a suppressed message.
+  */
+  inline bool wouldPrint(int messageNumber,
+			 const CoinMessages &messages) const
+  { return printStatusFor(messages.message_[messageNumber]->detail_,
+			  messages.class_)==0;}
+
   /*! \brief Start a message
 
     Look up the specified message. A prefix will be generated if enabled.
@@ -517,41 +536,48 @@ public:
 
     The default format code is `%d'.
   */
-  CoinMessageHandler & operator<< (int intvalue);
+  inline CoinMessageHandler & operator<< (int intvalue)
+  { return (printStatus_==3) ? *this : addValue(intvalue);}
 #if COIN_BIG_INDEX==1
   /*! \brief Process a long integer parameter value.
 
     The default format code is `%ld'.
   */
-  CoinMessageHandler & operator<< (long longvalue);
+  inline CoinMessageHandler & operator<< (long longvalue)
+  { return (printStatus_==3) ? *this : addValue(longvalue);}
 #endif
 #if COIN_BIG_INDEX==2
   /*! \brief Process a long long integer parameter value.
 
     The default format code is `%ld'.
   */
-  CoinMessageHandler & operator<< (long long longvalue);
+  inline CoinMessageHandler & operator<< (long long longvalue)
+  { return (printStatus_==3) ? *this : addValue(longvalue);}
 #endif
   /*! \brief Process a double parameter value.
 
     The default format code is `%d'.
   */
-  CoinMessageHandler & operator<< (double doublevalue);
+  inline CoinMessageHandler & operator<< (double doublevalue)
+  { return (printStatus_==3) ? *this : addValue(doublevalue);}
   /*! \brief Process a STL string parameter value.
 
     The default format code is `%g'.
   */
-  CoinMessageHandler & operator<< (const std::string& stringvalue);
+  inline CoinMessageHandler & operator<< (const std::string& stringvalue)
+  { return (printStatus_==3) ? *this : addValue(stringvalue);}
   /*! \brief Process a char parameter value.
 
     The default format code is `%s'.
   */
-  CoinMessageHandler & operator<< (char charvalue);
+  inline CoinMessageHandler & operator<< (char charvalue)
+  { return (printStatus_==3) ? *this : addValue(charvalue);}
   /*! \brief Process a C-style string parameter value.
 
     The default format code is `%c'.
   */
-  CoinMessageHandler & operator<< (const char *stringvalue);
+  inline CoinMessageHandler & operator<< (const char *stringvalue)
+  { return (printStatus_==3) ? *this : addValue(stringvalue);}
   /*! \brief Process a marker.
 
     The default format code is `%s'.
@@ -575,6 +601,32 @@ public:
 
   //@}
 
+  /**@name Binary log
+
+    With a binary log set, a message which passes the log level test is not
+    formatted: its number, source and the raw values given to it are
+    written as one record to the binary log.  replayBinaryLog() formats the
+    records later, through this or any other handler.  Messages given as
+    complete text (the message(externalNumber,source,msg,...) form) are
+    recorded as text.  Each record is written with one fwrite, so threads
+    may share the file.  The format is that of the machine which wrote it.
+  */
+  //@{
+  /// Send messages to \p fp as binary records (NULL to format as usual)
+  inline void setBinaryLog(FILE * fp)
+  { binaryLog_ = fp;}
+  /// Binary log or NULL
+  inline FILE * binaryLog() const
+  { return binaryLog_;}
+  /** Format the records of binary log \p fp through this handler, looking
+      up standard messages by source in \p messages (\p numberMessages
+      sets).  Records with an unknown source are skipped.  Returns the
+      number of records formatted, or -1 if the log is damaged.
+  */
+  int replayBinaryLog(FILE * fp, const CoinMessages * const * messages,
+		      int numberMessages);
+  //@}
+
   /** Log levels will be by type and will then use type
       given in CoinMessage::class_
 
@@ -619,6 +671,8 @@ protected:
 	  as noops.
       3 - do nothing except look for CoinMessageEol (i.e., the message
           detail level was not sufficient to cause it to print).
+      4 - Binary log: record values.
+      5 - Binary log: a complete message was provided.
   */
   int printStatus_;
   /// Highest message number (indicates any errors)
@@ -629,6 +683,17 @@ protected:
   char g_format_[8];
   /// Current number of significant digits for floating point numbers
   int g_precision_ ;
+  /** True if the message methods pass on to localHandler() - set by
+      thread safe handlers, never copied */
+  bool threadSafe_;
+  /// Suppressed standard message (copied only if it is turned on)
+  const CoinOneMessage * deferred_;
+  /// Source of deferred_
+  const char * deferredSource_;
+  /// Binary log
+  FILE * binaryLog_;
+  /// Binary record being built
+  std::vector<char> binaryRecord_;
    //@}
 
 private:
@@ -649,7 +714,38 @@ private:
   int internalPrint() ;
 
   /// Decide if this message should print.
-  void calcPrintStatus(int msglvl, int msgclass) ;
+  inline void calcPrintStatus(int msglvl, int msgclass)
+  { printStatus_ = printStatusFor(msglvl,msgclass);}
+  /// 0 if a message of this level and class prints, else 3
+  int printStatusFor(int msglvl, int msgclass) const ;
+  /// Set up the standard message deferred_ for output
+  void startMessage() ;
+
+  /**@name Values (the << operators after the suppression test) */
+  //@{
+  CoinMessageHandler & addValue(int intvalue);
+#if COIN_BIG_INDEX==1
+  CoinMessageHandler & addValue(long longvalue);
+#endif
+#if COIN_BIG_INDEX==2
+  CoinMessageHandler & addValue(long long longvalue);
+#endif
+  CoinMessageHandler & addValue(double doublevalue);
+  CoinMessageHandler & addValue(const std::string& stringvalue);
+  CoinMessageHandler & addValue(char charvalue);
+  CoinMessageHandler & addValue(const char *stringvalue);
+  //@}
+
+  /// Append bytes to binary record
+  inline void binaryAppend(const void * data, size_t length)
+  { const char * bytes = static_cast<const char *>(data);
+    binaryRecord_.insert(binaryRecord_.end(),bytes,bytes+length);}
+  /// Append a tagged value to binary record
+  inline void binaryAppend(char tag, const void * data, size_t length)
+  { binaryRecord_.push_back(tag);
+    binaryAppend(data,length);}
+  /// Write binary record (if any) and clear it
+  void writeBinary() ;
     
 
 };
@@ -6,6 +6,7 @@
 #include "CoinUtilsConfig.h"
 #include "CoinHelperFunctions.hpp"
 #include "CoinModel.hpp"
+#include "CoinArena.hpp"
 #include "CoinMessage.hpp"
 #include "CoinSort.hpp"
 #include "CoinMpsIO.hpp"
@@ -74,6 +75,48 @@ CoinBaseModel::operator=(const CoinBaseModel& rhs)
   }
   return *this;
 }
+#if COIN_HAS_MOVE
+//-------------------------------------------------------------------
+// Move constructor 
+//-------------------------------------------------------------------
+CoinBaseModel::CoinBaseModel (CoinBaseModel && rhs) COIN_NOEXCEPT
+  : numberRows_(0),
+    numberColumns_(0),
+    optimizationDirection_(1.0),
+    objectiveOffset_(0.0),
+    handler_(NULL),
+    logLevel_(0)
+{
+  swap(rhs);
+}
+
+//----------------------------------------------------------------
+// Move assignment operator 
+//-------------------------------------------------------------------
+CoinBaseModel &
+CoinBaseModel::operator=(CoinBaseModel&& rhs) COIN_NOEXCEPT
+{
+  swap(rhs);
+  return *this;
+}
+#endif
+// Exchange base data (no copying)
+void 
+CoinBaseModel::swap(CoinBaseModel & rhs)
+{
+  if (this != &rhs) {
+    std::swap(numberRows_,rhs.numberRows_);
+    std::swap(numberColumns_,rhs.numberColumns_);
+    std::swap(optimizationDirection_,rhs.optimizationDirection_);
+    std::swap(objectiveOffset_,rhs.objectiveOffset_);
+    problemName_.swap(rhs.problemName_);
+    rowBlockName_.swap(rhs.rowBlockName_);
+    columnBlockName_.swap(rhs.columnBlockName_);
+    std::swap(handler_,rhs.handler_);
+    messages_.swap(rhs.messages_);
+    std::swap(logLevel_,rhs.logLevel_);
+  }
+}
 void 
 CoinBaseModel::setLogLevel(int value)
 {
@@ -141,7 +184,8 @@ CoinModel::CoinModel ()
      moreInfo_(NULL),
      type_(-1),
      noNames_(false),
-     links_(0)
+     links_(0),
+     arena_(NULL)
 {
 }
 /* Constructor with sizes. */
@@ -181,7 +225,8 @@ CoinModel::CoinModel(int firstRows, int firstColumns, int firstElements,bool noN
      moreInfo_(NULL),
      type_(-1),
      noNames_(noNames),
-     links_(0)
+     links_(0),
+     arena_(NULL)
 {
   if (!firstRows) {
     if (firstColumns) {
@@ -235,7 +280,8 @@ CoinModel::CoinModel(const char *fileName, int allowStrings)
     moreInfo_(NULL),
     type_(-1),
     noNames_(false),
-    links_(0)
+    links_(0),
+    arena_(NULL)
 {
   rowBlockName_ = "row_master";
   columnBlockName_ = "column_master";
@@ -364,7 +410,13 @@ CoinModel::CoinModel(const char *fileName, int allowStrings)
       }
     }
     // get quadratic part
-    if (m.reader()->whichSection (  ) == COIN_QUAD_SECTION ) {
+    if (m.reader()->whichSection (  ) == COIN_QUAD_SECTION &&
+	!ifStrings&&allowStrings!=13) {
+      // no strings - keep as quadratic objective
+      status=m.readQuadraticMps(NULL,quadraticObjective_);
+      if (status)
+	quadraticObjective_.clear();
+    } else if (m.reader()->whichSection (  ) == COIN_QUAD_SECTION ) {
       int * start=NULL;
       int * column = NULL;
       double * element = NULL;
@@ -380,75 +432,55 @@ CoinModel::CoinModel(const char *fileName, int allowStrings)
 	  double minusOne=-1.0;
 	  addRow(1,&objColumn,&minusOne,-COIN_DBL_MAX,0.0,"objrow");
 	}
-	if (!ifStrings&&!numberIntegers) {
-	  // no strings - add to quadratic (not done yet)
-	  for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
-	    for (CoinBigIndex j = start[iColumn];j<start[iColumn+1];j++) {
-	      int jColumn = column[j];
-	      double value = element[j];
-	      // what about diagonal etc
-	      if (jColumn==iColumn) {
-		printf("diag %d %d %g\n",iColumn,jColumn,value);
-		setQuadraticElement(iColumn,jColumn,0.5*value);
-	      } else if (jColumn>iColumn) {
-		printf("above diag %d %d %g\n",iColumn,jColumn,value);
-	      } else if (jColumn<iColumn) {
-		printf("below diag %d %d %g\n",iColumn,jColumn,value);
-		setQuadraticElement(iColumn,jColumn,value);
-	      }
-	    }
+	// add in as strings
+	for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
+	  char temp[20000];
+	  temp[0]='\0';
+	  int put=0;
+	  int n=0;
+	  bool ifFirst=true;
+	  double value = getColumnObjective(iColumn);
+	  if (value&&objRow<0) {
+	    sprintf(temp,"%g",value);
+	    ifFirst=false;
+	    /* static cast is safe, temp is at most 20000 chars */
+	    put = CoinStrlenAsInt(temp);
 	  }
-	} else {
-	  // add in as strings
-	  for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
-	    char temp[20000];
-	    temp[0]='\0';
-	    int put=0;
-	    int n=0;
-	    bool ifFirst=true;
-	    double value = getColumnObjective(iColumn);
-	    if (value&&objRow<0) {
-	      sprintf(temp,"%g",value);
-	      ifFirst=false;
-              /* static cast is safe, temp is at most 20000 chars */
-	      put = CoinStrlenAsInt(temp);
+	  for (CoinBigIndex j = start[iColumn];j<start[iColumn+1];j++) {
+	    int jColumn = column[j];
+	    double value = element[j];
+	    // what about diagonal etc
+	    if (jColumn==iColumn) {
+	      //printf("diag %d %d %g\n",iColumn,jColumn,value);
+	      value *= 0.5;
+	    } else if (jColumn>iColumn) {
+	      //printf("above diag %d %d %g\n",iColumn,jColumn,value);
+	    } else if (jColumn<iColumn) {
+	      //printf("below diag %d %d %g\n",iColumn,jColumn,value);
+	      value=0.0;
 	    }
-	    for (CoinBigIndex j = start[iColumn];j<start[iColumn+1];j++) {
-	      int jColumn = column[j];
-	      double value = element[j];
-	      // what about diagonal etc
-	      if (jColumn==iColumn) {
-		//printf("diag %d %d %g\n",iColumn,jColumn,value);
-		value *= 0.5;
-	      } else if (jColumn>iColumn) {
-		//printf("above diag %d %d %g\n",iColumn,jColumn,value);
-	      } else if (jColumn<iColumn) {
-		//printf("below diag %d %d %g\n",iColumn,jColumn,value);
-		value=0.0;
-	      }
-	      if (value) {
-		n++;
-		const char * name = columnName(jColumn);
-		if (value==1.0) {
-		  sprintf(temp+put,"%s%s",ifFirst ? "" : "+",name);
-		} else {
-		  if (ifFirst||value<0.0)
-		    sprintf(temp+put,"%g*%s",value,name);
-		  else
-		    sprintf(temp+put,"+%g*%s",value,name);
-		}
-		put += CoinStrlenAsInt(temp+put);
-		assert (put<20000);
-		ifFirst=false;
+	    if (value) {
+	      n++;
+	      const char * name = columnName(jColumn);
+	      if (value==1.0) {
+		sprintf(temp+put,"%s%s",ifFirst ? "" : "+",name);
+	      } else {
+		if (ifFirst||value<0.0)
+		  sprintf(temp+put,"%g*%s",value,name);
+		else
+		  sprintf(temp+put,"+%g*%s",value,name);
 	      }
+	      put += CoinStrlenAsInt(temp+put);
+	      assert (put<20000);
+	      ifFirst=false;
 	    }
-	    if (n) {
-	      if (objRow<0)
-		setObjective(iColumn,temp);
-	      else
-		setElement(objRow,iColumn,temp);
-	      //printf("el for objective column c%7.7d is %s\n",iColumn,temp);
-	    }
+	  }
+	  if (n) {
+	    if (objRow<0)
+	      setObjective(iColumn,temp);
+	    else
+	      setElement(objRow,iColumn,temp);
+	    //printf("el for objective column c%7.7d is %s\n",iColumn,temp);
 	  }
 	}
       } 
@@ -494,7 +526,8 @@ CoinModel::CoinModel(int numberRows, int numberColumns,
      moreInfo_(NULL),
      type_(-1),
      noNames_(false),
-     links_(0)
+     links_(0),
+     arena_(NULL)
 {
   numberRows_ = numberRows;
   numberColumns_ = numberColumns;
@@ -530,11 +563,13 @@ CoinModel::CoinModel (const CoinModel & rhs)
     sortSize_(rhs.sortSize_),
     quadraticRowList_(rhs.quadraticRowList_),
     quadraticColumnList_(rhs.quadraticColumnList_),
+    quadraticObjective_(rhs.quadraticObjective_),
     sizeAssociated_(rhs.sizeAssociated_),
     numberSOS_(rhs.numberSOS_),
     type_(rhs.type_),
     noNames_(rhs.noNames_),
-    links_(rhs.links_)
+    links_(rhs.links_),
+    arena_(NULL)
 {
   rowLower_ = CoinCopyOfArray(rhs.rowLower_,maximumRows_);
   rowUpper_ = CoinCopyOfArray(rhs.rowUpper_,maximumRows_);
@@ -606,6 +641,26 @@ CoinModel::~CoinModel ()
   delete [] priority_;
   delete [] cut_;
   delete packedMatrix_;
+  if (arena_) {
+    // names in arena must go first
+    rowName_ = CoinModelHash();
+    columnName_ = CoinModelHash();
+    string_ = CoinModelHash();
+    rowName_.setArena(NULL);
+    columnName_.setArena(NULL);
+    string_.setArena(NULL);
+    delete arena_;
+  }
+}
+// Take names and strings from an arena
+void 
+CoinModel::useArena()
+{
+  if (!arena_)
+    arena_ = new CoinArena();
+  rowName_.setArena(arena_);
+  columnName_.setArena(arena_);
+  string_.setArena(arena_);
 }
 // Clone
 CoinBaseModel *
@@ -660,6 +715,7 @@ CoinModel::operator=(const CoinModel& rhs)
     rowList_ = rhs.rowList_;
     quadraticColumnList_ = rhs.quadraticColumnList_;
     quadraticRowList_ = rhs.quadraticRowList_;
+    quadraticObjective_ = rhs.quadraticObjective_;
     columnList_ = rhs.columnList_;
     sizeAssociated_= rhs.sizeAssociated_;
     numberSOS_ = rhs.numberSOS_;
@@ -707,9 +763,127 @@ CoinModel::operator=(const CoinModel& rhs)
     sortIndices_ = CoinCopyOfArray(rhs.sortIndices_,sortSize_);
     sortElements_ = CoinCopyOfArray(rhs.sortElements_,sortSize_);
     associated_ = CoinCopyOfArray(rhs.associated_,sizeAssociated_);
+    expressions_.clear();
   }
   return *this;
 }
+#if COIN_HAS_MOVE
+//-------------------------------------------------------------------
+// Move constructor 
+//-------------------------------------------------------------------
+CoinModel::CoinModel (CoinModel && rhs) COIN_NOEXCEPT
+  :  CoinBaseModel(static_cast<CoinBaseModel &&>(rhs)),
+     maximumRows_(0),
+     maximumColumns_(0),
+     numberElements_(0),
+     maximumElements_(0),
+     numberQuadraticElements_(0),
+     maximumQuadraticElements_(0),
+     rowLower_(NULL),
+     rowUpper_(NULL),
+     rowType_(NULL),
+     objective_(NULL),
+     columnLower_(NULL),
+     columnUpper_(NULL),
+     integerType_(NULL),
+     columnType_(NULL),
+     start_(NULL),
+     elements_(NULL),
+     packedMatrix_(NULL),
+     quadraticElements_(NULL),
+     sortIndices_(NULL),
+     sortElements_(NULL),
+     sortSize_(0),
+     sizeAssociated_(0),
+     associated_(NULL),
+     numberSOS_(0),
+     startSOS_(NULL),
+     memberSOS_(NULL),
+     typeSOS_(NULL),
+     prioritySOS_(NULL),
+     referenceSOS_(NULL),
+     priority_(NULL),
+     cut_(NULL),
+     moreInfo_(NULL),
+     type_(-1),
+     noNames_(false),
+     links_(0),
+     arena_(NULL)
+{
+  gutsOfSwap(rhs);
+}
+
+//----------------------------------------------------------------
+// Move assignment operator 
+//-------------------------------------------------------------------
+CoinModel &
+CoinModel::operator=(CoinModel&& rhs) COIN_NOEXCEPT
+{
+  swap(rhs);
+  return *this;
+}
+#endif
+// Exchange contents (no copying)
+void 
+CoinModel::swap(CoinModel & rhs)
+{
+  if (this != &rhs) {
+    CoinBaseModel::swap(rhs);
+    gutsOfSwap(rhs);
+  }
+}
+// Exchanges CoinModel data - names stay with their arena
+void 
+CoinModel::gutsOfSwap(CoinModel & rhs)
+{
+  std::swap(maximumRows_,rhs.maximumRows_);
+  std::swap(maximumColumns_,rhs.maximumColumns_);
+  std::swap(numberElements_,rhs.numberElements_);
+  std::swap(maximumElements_,rhs.maximumElements_);
+  std::swap(numberQuadraticElements_,rhs.numberQuadraticElements_);
+  std::swap(maximumQuadraticElements_,rhs.maximumQuadraticElements_);
+  std::swap(rowLower_,rhs.rowLower_);
+  std::swap(rowUpper_,rhs.rowUpper_);
+  rowName_.swap(rhs.rowName_);
+  std::swap(rowType_,rhs.rowType_);
+  std::swap(objective_,rhs.objective_);
+  std::swap(columnLower_,rhs.columnLower_);
+  std::swap(columnUpper_,rhs.columnUpper_);
+  columnName_.swap(rhs.columnName_);
+  std::swap(integerType_,rhs.integerType_);
+  string_.swap(rhs.string_);
+  std::swap(columnType_,rhs.columnType_);
+  std::swap(start_,rhs.start_);
+  std::swap(elements_,rhs.elements_);
+  std::swap(packedMatrix_,rhs.packedMatrix_);
+  hashElements_.swap(rhs.hashElements_);
+  rowList_.swap(rhs.rowList_);
+  columnList_.swap(rhs.columnList_);
+  std::swap(quadraticElements_,rhs.quadraticElements_);
+  hashQuadraticElements_.swap(rhs.hashQuadraticElements_);
+  std::swap(sortIndices_,rhs.sortIndices_);
+  std::swap(sortElements_,rhs.sortElements_);
+  std::swap(sortSize_,rhs.sortSize_);
+  quadraticRowList_.swap(rhs.quadraticRowList_);
+  quadraticColumnList_.swap(rhs.quadraticColumnList_);
+  quadraticObjective_.swap(rhs.quadraticObjective_);
+  std::swap(sizeAssociated_,rhs.sizeAssociated_);
+  std::swap(associated_,rhs.associated_);
+  expressions_.swap(rhs.expressions_);
+  std::swap(numberSOS_,rhs.numberSOS_);
+  std::swap(startSOS_,rhs.startSOS_);
+  std::swap(memberSOS_,rhs.memberSOS_);
+  std::swap(typeSOS_,rhs.typeSOS_);
+  std::swap(prioritySOS_,rhs.prioritySOS_);
+  std::swap(referenceSOS_,rhs.referenceSOS_);
+  std::swap(priority_,rhs.priority_);
+  std::swap(cut_,rhs.cut_);
+  std::swap(moreInfo_,rhs.moreInfo_);
+  std::swap(type_,rhs.type_);
+  std::swap(noNames_,rhs.noNames_);
+  std::swap(links_,rhs.links_);
+  std::swap(arena_,rhs.arena_);
+}
 /* add a row -  numberInRow may be zero */
 void 
 CoinModel::addRow(int numberInRow, const int * columns,
@@ -721,8 +895,8 @@ CoinModel::addRow(int numberInRow, const int * columns,
     type_=0;
     resize(100,0,1000);
   } else if (type_==1) {
-    // mixed - do linked lists for rows
-    createList(1);
+    // mixed - lists are created when wanted
+    type_=2;
   } else if (type_==3) {
     badType();
   }
@@ -819,10 +993,14 @@ CoinModel::addRow(int numberInRow, const int * columns,
     }
     start_[numberRows_+1]=put;
     numberElements_+=numberInRow;
+  } else if (!links_) {
+    // no lists yet so just add to end
+    bool doHash = hashElements_.numberItems()!=0;
+    for (int i=0;i<numberInRow;i++) 
+      addTriple(numberRows_,sortIndices_[i],sortElements_[i],doHash);
   } else {
     if (numberInRow) {
       // must update at least one link
-      assert (links_);
       if (links_==1||links_==3) {
         int first = rowList_.addEasy(numberRows_,numberInRow,sortIndices_,sortElements_,elements_,
                                      hashElements_);
@@ -855,8 +1033,8 @@ CoinModel::addColumn(int numberInColumn, const int * rows,
     type_=1;
     resize(0,100,1000);
   } else if (type_==0) {
-    // mixed - do linked lists for columns
-    createList(2);
+    // mixed - lists are created when wanted
+    type_=2;
   } else if (type_==3) {
     badType();
   }
@@ -958,10 +1136,14 @@ CoinModel::addColumn(int numberInColumn, const int * rows,
     }
     start_[numberColumns_+1]=put;
     numberElements_+=numberInColumn;
+  } else if (!links_) {
+    // no lists yet so just add to end
+    bool doHash = hashElements_.numberItems()!=0;
+    for (int i=0;i<numberInColumn;i++) 
+      addTriple(sortIndices_[i],numberColumns_,sortElements_[i],doHash);
   } else {
     if (numberInColumn) {
       // must update at least one link
-      assert (links_);
       if (links_==2||links_==3) {
         int first = columnList_.addEasy(numberColumns_,numberInColumn,sortIndices_,sortElements_,elements_,
                                         hashElements_);
@@ -985,21 +1167,16 @@ void
 CoinModel::setElement(int i,int j,double value) 
 {
   if (type_==-1) {
-    // initial
-    type_=0;
+    // initial - elements are kept as triples until lists are wanted
+    type_=2;
     resize(100,100,1000);
-    createList(2);
   } else if (type_==3) {
     badType();
-  } else if (!links_) {
-    if (type_==0||type_==2) {
-      createList(1);
-    } else if(type_==1) {
-      createList(2);
-    }
   }
-  if (!hashElements_.maximumItems()) {
-    hashElements_.resize(maximumElements_,elements_);
+  if (!hashElements_.numberItems()) {
+    // set up number of items
+    hashElements_.setNumberItems(numberElements_);
+    hashElements_.resize(maximumElements_,elements_,true);
   }
   int position = hashElements_.hash(i,j,elements_);
   if (position>=0) {
@@ -1029,8 +1206,11 @@ CoinModel::setElement(int i,int j,double value)
     fillColumns(j,false);
     // If rows extended - take care of that
     fillRows(i,false);
-    // treat as addRow unless only columnList_ exists
-    if ((links_&1)!=0) {
+    if (!links_) {
+      // no lists yet so just add to end
+      addTriple(i,j,value,true);
+    } else if ((links_&1)!=0) {
+      // treat as addRow unless only columnList_ exists
       int first = rowList_.addEasy(i,1,&j,&value,elements_,hashElements_);
       if (links_==3)
         columnList_.addHard(first,elements_,rowList_.firstFree(),rowList_.lastFree(),
@@ -1048,11 +1228,16 @@ CoinModel::setElement(int i,int j,double value)
 }
 // Sets quadratic value for column i and j 
 void 
-CoinModel::setQuadraticElement(int ,int ,double ) 
+CoinModel::setQuadraticElement(int i,int j,double value) 
 {
-  printf("not written yet\n");
-  abort();
-  return;
+  assert (i>=0&&j>=0);
+  quadraticObjective_.setElement(i,j,value);
+}
+// Replaces quadratic objective
+void 
+CoinModel::setQuadraticObjective(const CoinQuadraticMatrix & quadratic) 
+{
+  quadraticObjective_ = quadratic;
 }
 // Sets value for row i and column j as string
 void 
@@ -1060,23 +1245,16 @@ CoinModel::setElement(int i,int j,const char * value)
 {
   double dummyValue=1.0;
   if (type_==-1) {
-    // initial
-    type_=0;
+    // initial - elements are kept as triples until lists are wanted
+    type_=2;
     resize(100,100,1000);
-    createList(2);
   } else if (type_==3) {
     badType();
-  } else if (!links_) {
-    if (type_==0||type_==2) {
-      createList(1);
-    } else if(type_==1) {
-      createList(2);
-    }
   }
-  if (!hashElements_.maximumItems()) {
+  if (!hashElements_.numberItems()) {
     // set up number of items
     hashElements_.setNumberItems(numberElements_);
-    hashElements_.resize(maximumElements_,elements_);
+    hashElements_.resize(maximumElements_,elements_,true);
   }
   int position = hashElements_.hash(i,j,elements_);
   if (position>=0) {
@@ -1107,8 +1285,11 @@ CoinModel::setElement(int i,int j,const char * value)
     fillColumns(j,false);
     // If rows extended - take care of that
     fillRows(i,false);
-    // treat as addRow unless only columnList_ exists
-    if ((links_&1)!=0) {
+    if (!links_) {
+      // no lists yet so just add to end
+      addTriple(i,j,dummyValue,true);
+    } else if ((links_&1)!=0) {
+      // treat as addRow unless only columnList_ exists
       int first = rowList_.addEasy(i,1,&j,&dummyValue,elements_,hashElements_);
       if (links_==3)
         columnList_.addHard(first,elements_,rowList_.firstFree(),rowList_.lastFree(),
@@ -1655,51 +1836,7 @@ CoinModel::packRows()
       rowName_.setNumberItems(numberRows_);
       rowName_.resize(rowName_.maximumItems(),true);
     }
-    if (hashElements_.numberItems()) {
-      hashElements_.setNumberItems(numberElements_);
-      hashElements_.resize(hashElements_.maximumItems(),elements_,true);
-    }
-    if (start_) {
-      int last=-1;
-      if (type_==0) {
-        for (i=0;i<numberElements_;i++) {
-          int now = rowInTriple(elements_[i]);
-          assert (now>=last);
-          if (now>last) {
-            start_[last+1]=numberElements_;
-            for (int j=last+1;j<now;j++)
-              start_[j+1]=numberElements_;
-            last=now;
-          }
-        }
-        for (int j=last+1;j<numberRows_;j++)
-          start_[j+1]=numberElements_;
-      } else {
-        assert (type_==1);
-        for (i=0;i<numberElements_;i++) {
-          int now = elements_[i].column;
-          assert (now>=last);
-          if (now>last) {
-            start_[last+1]=numberElements_;
-            for (int j=last+1;j<now;j++)
-              start_[j+1]=numberElements_;
-            last=now;
-          }
-        }
-        for (int j=last+1;j<numberColumns_;j++)
-          start_[j+1]=numberElements_;
-      }
-    }
-    if ((links_&1)!=0) {
-      rowList_ = CoinModelLinkedList();
-      links_ &= ~1;
-      createList(1);
-    }
-    if ((links_&2)!=0) {
-      columnList_ = CoinModelLinkedList();
-      links_ &= ~2;
-      createList(2);
-    }
+    rebuildAfterPack();
   }
   delete [] newRow;
   return numberDeleted;
@@ -1765,55 +1902,188 @@ CoinModel::packColumns()
       columnName_.setNumberItems(numberColumns_);
       columnName_.resize(columnName_.maximumItems(),true);
     }
-    if (hashElements_.numberItems()) {
-      hashElements_.setNumberItems(numberElements_);
-      hashElements_.resize(hashElements_.maximumItems(),elements_,true);
-    }
-    if (start_) {
-      int last=-1;
-      if (type_==0) {
-        for (i=0;i<numberElements_;i++) {
-          int now = rowInTriple(elements_[i]);
-          assert (now>=last);
-          if (now>last) {
-            start_[last+1]=numberElements_;
-            for (int j=last+1;j<now;j++)
-              start_[j+1]=numberElements_;
-            last=now;
+    rebuildAfterPack();
+  }
+  delete [] newColumn;
+  return numberDeleted;
+}
+/* Deletes rows permanently (with all their elements).  Out of range and
+   duplicate indices are ignored.  If newIndex given then it is set to new
+   position of each old row (-1 if deleted).  Returns number of rows deleted. */
+int 
+CoinModel::deleteRows(int number, const int * which, int * newIndex)
+{
+  if (type_==3) 
+    badType();
+  if (numberRows_<=0)
+    return 0;
+  int * newRow = newIndex ? newIndex : new int[numberRows_];
+  int n = CoinDeletionMap(numberRows_,number,which,newRow);
+  int numberDeleted = numberRows_-n;
+  if (numberDeleted) {
+    int iRow;
+    int numberNames = rowName_.numberItems();
+    int newNumberNames = 0;
+    for (iRow=0;iRow<numberRows_;iRow++) {
+      int put = newRow[iRow];
+      if (put<0) {
+        if (iRow<numberNames)
+          rowName_.deleteHash(iRow);
+      } else {
+        if (put!=iRow) {
+          if (rowLower_) {
+            rowLower_[put]=rowLower_[iRow];
+            rowUpper_[put]=rowUpper_[iRow];
+            rowType_[put]=rowType_[iRow];
           }
+          if (cut_)
+            cut_[put]=cut_[iRow];
+          if (iRow<numberNames)
+            rowName_.setName(put,rowName_.getName(iRow));
+        }
+        if (iRow<numberNames)
+          newNumberNames = put+1;
+      }
+    }
+    numberRows_=n;
+    // elements of deleted rows go (as do free entries)
+    n=0;
+    int i;
+    for ( i=0;i<numberElements_;i++) {
+      if (elements_[i].column>=0) {
+        int put = newRow[rowInTriple(elements_[i])];
+        if (put>=0) {
+          elements_[n]=elements_[i];
+          setRowInTriple(elements_[n],put);
+          n++;
         }
-        for (int j=last+1;j<numberRows_;j++)
-          start_[j+1]=numberElements_;
+      }
+    }
+    numberElements_=n;
+    if (numberNames) {
+      rowName_.setNumberItems(newNumberNames);
+      rowName_.resize(rowName_.maximumItems(),true);
+    }
+    rebuildAfterPack();
+  }
+  if (!newIndex)
+    delete [] newRow;
+  return numberDeleted;
+}
+/* Deletes columns permanently (with all their elements).  As deleteRows. */
+int 
+CoinModel::deleteColumns(int number, const int * which, int * newIndex)
+{
+  if (type_==3) 
+    badType();
+  if (numberColumns_<=0)
+    return 0;
+  int * newColumn = newIndex ? newIndex : new int[numberColumns_];
+  int n = CoinDeletionMap(numberColumns_,number,which,newColumn);
+  int numberDeleted = numberColumns_-n;
+  if (numberDeleted) {
+    int iColumn;
+    int numberNames = columnName_.numberItems();
+    int newNumberNames = 0;
+    for (iColumn=0;iColumn<numberColumns_;iColumn++) {
+      int put = newColumn[iColumn];
+      if (put<0) {
+        if (iColumn<numberNames)
+          columnName_.deleteHash(iColumn);
       } else {
-        assert (type_==1);
-        for (i=0;i<numberElements_;i++) {
-          int now = elements_[i].column;
-          assert (now>=last);
-          if (now>last) {
-            start_[last+1]=numberElements_;
-            for (int j=last+1;j<now;j++)
-              start_[j+1]=numberElements_;
-            last=now;
+        if (put!=iColumn) {
+          if (columnLower_) {
+            columnLower_[put]=columnLower_[iColumn];
+            columnUpper_[put]=columnUpper_[iColumn];
+            objective_[put]=objective_[iColumn];
+            integerType_[put]=integerType_[iColumn];
+            columnType_[put]=columnType_[iColumn];
           }
+          if (priority_)
+            priority_[put]=priority_[iColumn];
+          if (iColumn<numberNames)
+            columnName_.setName(put,columnName_.getName(iColumn));
         }
-        for (int j=last+1;j<numberColumns_;j++)
-          start_[j+1]=numberElements_;
+        if (iColumn<numberNames)
+          newNumberNames = put+1;
       }
     }
-    if ((links_&1)!=0) {
-      rowList_ = CoinModelLinkedList();
-      links_ &= ~1;
-      createList(1);
+    numberColumns_=n;
+    n=0;
+    int i;
+    for ( i=0;i<numberElements_;i++) {
+      if (elements_[i].column>=0) {
+        int put = newColumn[elements_[i].column];
+        if (put>=0) {
+          elements_[n]=elements_[i];
+          elements_[n].column = put;
+          n++;
+        }
+      }
     }
-    if ((links_&2)!=0) {
-      columnList_ = CoinModelLinkedList();
-      links_ &= ~2;
-      createList(2);
+    numberElements_=n;
+    if (numberNames) {
+      columnName_.setNumberItems(newNumberNames);
+      columnName_.resize(columnName_.maximumItems(),true);
     }
+    rebuildAfterPack();
   }
-  delete [] newColumn;
+  if (!newIndex)
+    delete [] newColumn;
   return numberDeleted;
 }
+/* After rows or columns have been packed down - elements_ compacted and
+   renumbered - redoes element hash, starts and linked lists */
+void
+CoinModel::rebuildAfterPack()
+{
+  int i;
+  if (hashElements_.numberItems()) {
+    hashElements_.setNumberItems(numberElements_);
+    hashElements_.resize(hashElements_.maximumItems(),elements_,true);
+  }
+  if (start_) {
+    int last=-1;
+    if (type_==0) {
+      for (i=0;i<numberElements_;i++) {
+        int now = rowInTriple(elements_[i]);
+        assert (now>=last);
+        if (now>last) {
+          start_[last+1]=i;
+          for (int j=last+1;j<now;j++)
+            start_[j+1]=i;
+          last=now;
+        }
+      }
+      for (int j=last+1;j<numberRows_;j++)
+        start_[j+1]=numberElements_;
+    } else {
+      assert (type_==1);
+      for (i=0;i<numberElements_;i++) {
+        int now = elements_[i].column;
+        assert (now>=last);
+        if (now>last) {
+          start_[last+1]=i;
+          for (int j=last+1;j<now;j++)
+            start_[j+1]=i;
+          last=now;
+        }
+      }
+      for (int j=last+1;j<numberColumns_;j++)
+        start_[j+1]=numberElements_;
+    }
+  }
+  if ((links_&1)!=0) {
+    rowList_ = CoinModelLinkedList();
+    links_ &= ~1;
+    createList(1);
+  }
+  if ((links_&2)!=0) {
+    columnList_ = CoinModelLinkedList();
+    links_ &= ~2;
+    createList(2);
+  }
+}
 /* Packs down all rows and columns.  i.e. removes empty rows and columns permanently.
    Empty rows have no elements and feasible bounds.
    Empty columns have no elements and no objective.
@@ -1834,60 +2104,68 @@ CoinModel::createPackedMatrix(CoinPackedMatrix & matrix,
   // Set to say all parts
   type_=2;
   resize(numberRows_,numberColumns_,numberElements_);
-  // Do counts for CoinPackedMatrix
+  /* Counting sort of triples - bucket by row then scatter into columns
+     so rows come out in order in each column and there is no sort */
+  double * value = new double[CoinMax(numberElements_,1)];
+  int * rowStart = new int[numberRows_+1];
   int * length = new int[numberColumns_];
+  CoinZeroN(rowStart,numberRows_+1);
   CoinZeroN(length,numberColumns_);
-  int i;
-  int numberElements=0;
-  for (i=0;i<numberElements_;i++) {
-    int column = elements_[i].column;
-    if (column>=0) {
-      length[column]++;
-      numberElements++;
-    }
-  }
   int numberErrors=0;
-  CoinBigIndex * start = new int[numberColumns_+1];
-  int * row = new int[numberElements];
-  double * element = new double[numberElements];
-  start[0]=0;
-  for (i=0;i<numberColumns_;i++) {
-    start[i+1]=start[i]+length[i];
-    length[i]=0;
-  }
-  numberElements=0;
+  int numberElements=0;
+  int i;
   for (i=0;i<numberElements_;i++) {
     int column = elements_[i].column;
     if (column>=0) {
-      double value = elements_[i].value;
+      double thisValue = elements_[i].value;
       if (stringInTriple(elements_[i])) {
-        int position = static_cast<int> (value);
+        int position = static_cast<int> (thisValue);
         assert (position<sizeAssociated_);
-        value = associated[position];
-        if (value==unsetValue()) {
+        thisValue = associated[position];
+        if (thisValue==unsetValue()) {
           numberErrors++;
-          value=0.0;
+          thisValue=0.0;
         }
       }
-      if (value) {
+      value[i]=thisValue;
+      if (thisValue) {
         numberElements++;
-        int put=start[column]+length[column];
-        row[put]=rowInTriple(elements_[i]);
-        element[put]=value;
+        rowStart[rowInTriple(elements_[i])+1]++;
         length[column]++;
       }
+    } else {
+      value[i]=0.0;
     }
   }
+  for (i=0;i<numberRows_;i++) 
+    rowStart[i+1] += rowStart[i];
+  int * byRow = new int[CoinMax(numberElements,1)];
+  for (i=0;i<numberElements_;i++) {
+    if (value[i]) 
+      byRow[rowStart[rowInTriple(elements_[i])]++]=i;
+  }
+  delete [] rowStart;
+  CoinBigIndex * start = new CoinBigIndex[numberColumns_+1];
+  int * row = new int[CoinMax(numberElements,1)];
+  double * element = new double[CoinMax(numberElements,1)];
+  start[0]=0;
   for (i=0;i<numberColumns_;i++) {
-    int put = start[i];
-    CoinSort_2(row+put,row+put+length[i],element+put);
+    start[i+1]=start[i]+length[i];
+    length[i]=0;
   }
-  matrix=CoinPackedMatrix(true,numberRows_,numberColumns_,numberElements,
-                          element,row,start,length,0.0,0.0);
-  delete [] start;
-  delete [] length;
-  delete [] row;
-  delete [] element;
+  for (i=0;i<numberElements;i++) {
+    int k = byRow[i];
+    int column = elements_[k].column;
+    CoinBigIndex put=start[column]+length[column];
+    row[put]=rowInTriple(elements_[k]);
+    element[put]=value[k];
+    length[column]++;
+  }
+  delete [] byRow;
+  delete [] value;
+  // matrix takes the arrays
+  matrix.assignMatrix(true,numberRows_,numberColumns_,numberElements,
+                      element,row,start,length);
   return numberErrors;
 }
 /* Fills in startPositive and startNegative with counts for +-1 matrix.
@@ -1999,17 +2277,9 @@ CoinModel::createPlusMinusOne(CoinBigIndex * startPositive, CoinBigIndex * start
 // Fills in all associated - returning number of errors
 int CoinModel::computeAssociated(double * associated)
 {
-  CoinYacc info;
-  info.length=0;
-  int numberErrors=0;
-  for (int i=0;i<string_.numberItems();i++) {
-    if (string_.name(i)&&associated[i]==unsetValue()) {
-      associated[i] = getDoubleFromString(info,string_.name(i));
-      if (associated[i]==unsetValue())
-        numberErrors++;
-    }
-  }
-  return numberErrors;
+  // strings are compiled once and only those using changed values redone
+  return expressions_.compute(string_,associated_,sizeAssociated_,
+                              associated,unsetValue(),logLevel_);
 }
 // Creates copies of various arrays - return number of errors
 int 
@@ -2096,6 +2366,32 @@ CoinModel::createArrays(double * & rowLower, double * &  rowUpper,
 int 
 CoinModel::writeMps(const char *filename, int compression,
                     int formatType , int numberAcross , bool keepStrings) 
+{
+  CoinMpsIO writer;
+  fillMpsIO(writer,keepStrings);
+  CoinPackedMatrix * quadratic = NULL;
+  if (quadraticObjective_.getNumElements()) {
+    // QUADOBJ is upper triangle
+    quadratic = quadraticObjective_.packedMatrix();
+    quadratic->setDimensions(numberColumns_,numberColumns_);
+  }
+  int returnCode = writer.writeMps(filename, compression, formatType,
+				   numberAcross, quadratic);
+  delete quadratic;
+  return returnCode;
+}
+/* Write the problem as a binary snapshot (see CoinMpsIO::writeBinary).
+ */
+int 
+CoinModel::writeBinary(const char *filename) 
+{
+  CoinMpsIO writer;
+  fillMpsIO(writer,false);
+  return writer.writeBinary(filename);
+}
+// Loads CoinMpsIO with model (as used by writeMps)
+void 
+CoinModel::fillMpsIO(CoinMpsIO & writer, bool keepStrings) 
 {
   int numberErrors = 0;
   // Set arrays for normal use
@@ -2120,7 +2416,7 @@ CoinModel::writeMps(const char *filename, int compression,
   char* integrality = new char[numberColumns_];
   bool hasInteger = false;
   for (int i = 0; i < numberColumns_; i++) {
-    if (integerType[i]) {
+    if (integerType && integerType[i]) {
       integrality[i] = 1;
       hasInteger = true;
     } else {
@@ -2128,7 +2424,6 @@ CoinModel::writeMps(const char *filename, int compression,
     }
   }
 
-  CoinMpsIO writer;
   writer.setInfinity(COIN_DBL_MAX);
   const char *const * rowNames=NULL;
   if (rowName_.numberItems())
@@ -2159,7 +2454,46 @@ CoinModel::writeMps(const char *filename, int compression,
     // load up strings - sorted by column and row
     writer.copyStringElements(this);
   }
-  return writer.writeMps(filename, compression, formatType, numberAcross);
+}
+/* Read a problem written by writeBinary - any existing model is
+   discarded.
+ */
+int 
+CoinModel::readBinary(const char *filename) 
+{
+  CoinMpsIO m;
+  int status = m.readBinary(filename);
+  if (status)
+    return status;
+  // keep handler and log level
+  CoinMessageHandler * handler = handler_;
+  int logLevel = logLevel_;
+  *this = CoinModel();
+  handler_ = handler;
+  logLevel_ = logLevel;
+  problemName_ = m.getProblemName();
+  objectiveOffset_ = m.objectiveOffset();
+  int numberRows = m.getNumRows();
+  int numberColumns = m.getNumCols();
+  const CoinPackedMatrix * matrix = m.getMatrixByCol();
+  const double * element = matrix->getElements();
+  const int * row = matrix->getIndices();
+  const CoinBigIndex * columnStart = matrix->getVectorStarts();
+  const int * columnLength = matrix->getVectorLengths();
+  const double * rowLower = m.getRowLower();
+  const double * rowUpper = m.getRowUpper();
+  const double * columnLower = m.getColLower();
+  const double * columnUpper = m.getColUpper();
+  const double * objective = m.getObjCoefficients();
+  // rows first so they all exist
+  for (int iRow=0;iRow<numberRows;iRow++)
+    addRow(0,NULL,NULL,rowLower[iRow],rowUpper[iRow],m.rowName(iRow));
+  for (int iColumn=0;iColumn<numberColumns;iColumn++)
+    addColumn(columnLength[iColumn],row+columnStart[iColumn],
+	      element+columnStart[iColumn],columnLower[iColumn],
+	      columnUpper[iColumn],objective[iColumn],
+	      m.columnName(iColumn),m.isInteger(iColumn));
+  return 0;
 }
 /* Check two models against each other.  Return nonzero if different.
    Ignore names if that set.
@@ -2337,13 +2671,39 @@ CoinModel::getElement(const char * rowName,const char * columnName) const
     return 0.0;
   }
 }
+// Fingerprint of matrix, bounds, objective and integer columns
+CoinFingerprint 
+CoinModel::fingerprint(int numberThreads) const
+{
+  CoinFingerprint result;
+  if (packedMatrix_) {
+    result.addMatrix(*packedMatrix_,true,numberThreads);
+  } else {
+    result.addDimensions(numberRows_,numberColumns_);
+    for (CoinBigIndex i=0;i<numberElements_;i++) {
+      int column = elements_[i].column;
+      if (column>=0) {
+        double value = elements_[i].value;
+        if (stringInTriple(elements_[i])) {
+          int position = static_cast<int> (value);
+          value = position<sizeAssociated_ ? associated_[position] : 0.0;
+          if (value==unsetValue())
+            value=0.0;
+        }
+        result.addEntry(rowInTriple(elements_[i]),column,value);
+      }
+    }
+  }
+  result.addModelArrays(numberRows_,numberColumns_,columnLower_,
+                        columnUpper_,objective_,rowLower_,rowUpper_);
+  result.addIntegers(numberColumns_,integerType_);
+  return result;
+}
 // Returns quadratic value for columns i and j
 double 
-CoinModel::getQuadraticElement(int ,int ) const
+CoinModel::getQuadraticElement(int i,int j) const
 {
-  printf("not written yet\n");
-  abort();
-  return 0.0;
+  return quadraticObjective_.getElement(i,j);
 }
 // Returns value for row i and column j as string
 const char * 
@@ -3033,8 +3393,8 @@ CoinModel::fillRows(int whichRow, bool forceCreation,bool fromAddRow)
       delete [] start_;
       start_ = NULL;
       assert (!links_);
-      // mixed - do linked lists for rows
-      createList(1);
+      // mixed - lists are created when wanted
+      type_=2;
     }
   }
 }
@@ -3083,8 +3443,8 @@ CoinModel::fillColumns(int whichColumn,bool forceCreation,bool fromAddColumn)
       delete [] start_;
       start_ = NULL;
       assert (!links_);
-      // mixed - do linked lists for columns
-      createList(2);
+      // mixed - lists are created when wanted
+      type_=2;
     }
   }
 }
@@ -3219,6 +3579,19 @@ CoinModel::createList(int type) const
     links_ |= 2;
   }
 }
+// Adds element at end of triples when there are no lists
+void 
+CoinModel::addTriple(int row, int column, double value, bool doHash)
+{
+  assert (!links_&&numberElements_<maximumElements_);
+  int put = numberElements_;
+  setRowAndStringInTriple(elements_[put],row,false);
+  elements_[put].column=column;
+  elements_[put].value=value;
+  if (doHash)
+    hashElements_.addHash(put,row,column,elements_);
+  numberElements_++;
+}
 // Checks that links are consistent
 void 
 CoinModel::validateLinks() const
@@ -3412,6 +3785,24 @@ CoinModel::quadraticRow(int rowNumber,double * linearRow,
       delete [] element;
       return newMatrix;
     }
+  } else if (quadraticObjective_.getNumElements()) {
+    // objective held as matrix - as with strings lower triangle by
+    // column with half of diagonal
+    CoinMemcpyN(objective_,numberColumns_,linearRow);
+    CoinPackedMatrix * upper = quadraticObjective_.packedMatrix();
+    const int * row = upper->getIndices();
+    const CoinBigIndex * columnStart = upper->getVectorStarts();
+    double * element = upper->getMutableElements();
+    int numberLook = upper->getNumCols();
+    for (int jColumn=0;jColumn<numberLook;jColumn++) {
+      // diagonal is last
+      CoinBigIndex j = columnStart[jColumn+1]-1;
+      if (j>=columnStart[jColumn]&&row[j]==jColumn)
+	element[j] *= 0.5;
+    }
+    upper->transpose();
+    upper->reverseOrdering();
+    return upper;
   } else {
     // objective
     int iColumn;
@@ -3545,6 +3936,7 @@ CoinModel::replaceQuadraticRow(int rowNumber,const double * linearRow, const Coi
     }
   } else {
     // objective
+    quadraticObjective_.clear();
     int iColumn;
     for (iColumn=0;iColumn<numberColumns_;iColumn++) {
       setColumnObjective(iColumn,0.0);
@@ -4023,6 +4415,158 @@ CoinModel::loadBlock(const int numcols, const int numrows,
   delete[] rowlb;
   delete[] rowub;
 }
+//-----------------------------------------------------------------------------
+
+void
+CoinModel::loadArrays(int numberRows, int numberColumns, bool columnOrdered,
+		      const CoinBigIndex * start, const int * index,
+		      const double * element,
+		      const double * rowLower, const double * rowUpper,
+		      const double * columnLower, const double * columnUpper,
+		      const double * objective, const char * integerType,
+		      const char * const * rowNames,
+		      const char * const * columnNames)
+{
+  int numberMajor = columnOrdered ? numberColumns : numberRows;
+  int numberMinor = columnOrdered ? numberRows : numberColumns;
+  CoinBigIndex numberElements = start[numberMajor]-start[0];
+  CoinBigIndex * newStart = new CoinBigIndex [numberMajor+1];
+  int * length = new int [numberMajor];
+  for (int i=0;i<numberMajor;i++) {
+    newStart[i]=start[i]-start[0];
+    length[i]=static_cast<int>(start[i+1]-start[i]);
+  }
+  newStart[numberMajor]=numberElements;
+  int * newIndex = CoinCopyOfArray(index+start[0],numberElements);
+  double * newElement = CoinCopyOfArray(element+start[0],numberElements);
+  CoinPackedMatrix * matrix = new CoinPackedMatrix();
+  // matrix takes the arrays
+  matrix->assignMatrix(columnOrdered,numberMinor,numberMajor,numberElements,
+		       newElement,newIndex,newStart,length);
+  loadPacked(matrix,rowLower,rowUpper,columnLower,columnUpper,objective,
+	     integerType,rowNames,columnNames);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinModel::loadTriplets(int numberRows, int numberColumns,
+			CoinBigIndex numberElements, const int * rowIndex,
+			const int * columnIndex, const double * element,
+			const double * rowLower, const double * rowUpper,
+			const double * columnLower, const double * columnUpper,
+			const double * objective, const char * integerType,
+			const char * const * rowNames,
+			const char * const * columnNames)
+{
+  // counting sort by column
+  CoinBigIndex * start = new CoinBigIndex [numberColumns+1];
+  int * length = new int [numberColumns];
+  CoinZeroN(length,numberColumns);
+  for (CoinBigIndex k=0;k<numberElements;k++) {
+    int iColumn = columnIndex[k];
+    int iRow = rowIndex[k];
+    if (iColumn<0||iColumn>=numberColumns||iRow<0||iRow>=numberRows) {
+      delete [] start;
+      delete [] length;
+      throw CoinError("index out of range","loadTriplets","CoinModel");
+    }
+    length[iColumn]++;
+  }
+  CoinBigIndex put=0;
+  for (int i=0;i<numberColumns;i++) {
+    start[i]=put;
+    put += length[i];
+  }
+  start[numberColumns]=put;
+  int * newIndex = new int [numberElements];
+  double * newElement = new double [numberElements];
+  for (CoinBigIndex k=0;k<numberElements;k++) {
+    CoinBigIndex j = start[columnIndex[k]]++;
+    newIndex[j]=rowIndex[k];
+    newElement[j]=element[k];
+  }
+  for (int i=0;i<numberColumns;i++) 
+    start[i] -= length[i];
+  CoinPackedMatrix * matrix = new CoinPackedMatrix();
+  // matrix takes the arrays
+  matrix->assignMatrix(true,numberRows,numberColumns,numberElements,
+		       newElement,newIndex,start,length);
+  loadPacked(matrix,rowLower,rowUpper,columnLower,columnUpper,objective,
+	     integerType,rowNames,columnNames);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinModel::loadPacked(CoinPackedMatrix * matrix,
+		      const double * rowLower, const double * rowUpper,
+		      const double * columnLower, const double * columnUpper,
+		      const double * objective, const char * integerType,
+		      const char * const * rowNames,
+		      const char * const * columnNames)
+{
+  assert ((type_==-1||type_==3)&&!numberElements_&&!links_);
+  delete packedMatrix_;
+  packedMatrix_ = matrix;
+  type_=3;
+  int numberRows = matrix->getNumRows();
+  int numberColumns = matrix->getNumCols();
+  numberRows_ = numberRows;
+  numberColumns_ = numberColumns;
+  maximumRows_ = numberRows;
+  maximumColumns_ = numberColumns;
+  numberElements_ = matrix->getNumElements();
+  maximumElements_ = numberElements_;
+  delete [] rowLower_;
+  delete [] rowUpper_;
+  delete [] rowType_;
+  delete [] objective_;
+  delete [] columnLower_;
+  delete [] columnUpper_;
+  delete [] integerType_;
+  delete [] columnType_;
+  rowLower_ = new double [numberRows];
+  rowUpper_ = new double [numberRows];
+  rowType_ = new int [numberRows];
+  objective_ = new double [numberColumns];
+  columnLower_ = new double [numberColumns];
+  columnUpper_ = new double [numberColumns];
+  integerType_ = new int [numberColumns];
+  columnType_ = new int [numberColumns];
+  if (rowLower)
+    CoinMemcpyN(rowLower,numberRows,rowLower_);
+  else
+    CoinFillN(rowLower_,numberRows,-COIN_DBL_MAX);
+  if (rowUpper)
+    CoinMemcpyN(rowUpper,numberRows,rowUpper_);
+  else
+    CoinFillN(rowUpper_,numberRows,COIN_DBL_MAX);
+  CoinZeroN(rowType_,numberRows);
+  if (objective)
+    CoinMemcpyN(objective,numberColumns,objective_);
+  else
+    CoinZeroN(objective_,numberColumns);
+  if (columnLower)
+    CoinMemcpyN(columnLower,numberColumns,columnLower_);
+  else
+    CoinZeroN(columnLower_,numberColumns);
+  if (columnUpper)
+    CoinMemcpyN(columnUpper,numberColumns,columnUpper_);
+  else
+    CoinFillN(columnUpper_,numberColumns,COIN_DBL_MAX);
+  if (integerType) {
+    for (int i=0;i<numberColumns;i++)
+      integerType_[i] = integerType[i] ? 1 : 0;
+  } else {
+    CoinZeroN(integerType_,numberColumns);
+  }
+  CoinZeroN(columnType_,numberColumns);
+  if (rowNames&&!noNames_)
+    rowName_.addNames(numberRows,rowNames);
+  if (columnNames&&!noNames_)
+    columnName_.addNames(numberColumns,columnNames);
+}
 /* Returns which parts of model are set
    1 - matrix
    2 - rhs
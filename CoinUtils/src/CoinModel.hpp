@@ -7,9 +7,11 @@
 #define CoinModel_H
 
 #include "CoinModelUseful.hpp"
+#include "CoinQuadraticMatrix.hpp"
 #include "CoinMessageHandler.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
+class CoinMpsIO;
 class CoinBaseModel {
 
 public:
@@ -25,6 +27,12 @@ public:
    
   /// Assignment operator 
   CoinBaseModel & operator=( const CoinBaseModel& rhs);
+#if COIN_HAS_MOVE
+  /// Move constructor (rhs is left with no names or messages)
+  CoinBaseModel ( CoinBaseModel &&rhs) COIN_NOEXCEPT;
+  /// Move assignment (exchanges with rhs)
+  CoinBaseModel & operator=( CoinBaseModel&& rhs) COIN_NOEXCEPT;
+#endif
 
   /// Clone
   virtual CoinBaseModel * clone() const=0;
@@ -118,6 +126,8 @@ protected:
   */
   int logLevel_;
    //@}
+  /// Exchange base data with rhs (no copying)
+  void swap(CoinBaseModel & rhs);
   /// data
 
 };
@@ -132,7 +142,7 @@ protected:
     1) A matrix of doubles (or strings - see note A)
     2) Column information including integer information and names
     3) Row information including names
-    4) Quadratic objective (not implemented - but see A)
+    4) Quadratic objective (as CoinQuadraticMatrix - or see A)
 
     This class is meant to make it more efficient to build a model.  It is at
     its most efficient when all additions are done as addRow or as addCol but
@@ -198,8 +208,14 @@ public:
       Returns number of elements
   */
   int getColumn(int whichColumn, int * column, double * element);
-  /// Sets quadratic value for column i and j 
+  /** Sets Q(i,j) (and Q(j,i)) of quadratic objective c'x + 1/2 x'Qx.
+      Changes are merged when the matrix is next used */
   void setQuadraticElement(int i,int j,double value) ;
+  /// Replaces quadratic objective
+  void setQuadraticObjective(const CoinQuadraticMatrix & quadratic);
+  /// Quadratic objective (upper triangle, no elements if none)
+  inline const CoinQuadraticMatrix & quadraticObjective() const
+  { return quadraticObjective_;}
   /// Sets value for row i and column j as string
   inline void operator() (int i,int j,const char * value) 
   { setElement(i,j,value);}
@@ -345,6 +361,15 @@ public:
   int deleteElement(int row, int column);
   /// Takes element out of matrix when position known
   void deleteThisElement(int row, int column,int position);
+  /** Deletes rows permanently, with their elements, in one pass.  Indices
+      may be in any order; duplicates and indices out of range are ignored.
+      If newIndex is given (one entry per row) it is set to the new position
+      of each row or -1 if deleted - e.g. for CoinWarmStartBasis::remapRows.
+      Returns number of rows deleted. */
+  int deleteRows(int number, const int * which, int * newIndex=NULL);
+  /** Deletes columns permanently, with their elements (as deleteRows).
+      Quadratic objective terms are not changed. */
+  int deleteColumns(int number, const int * which, int * newIndex=NULL);
   /** Packs down all rows i.e. removes empty rows permanently.  Empty rows
       have no elements and feasible bounds. returns number of rows deleted. */
   int packRows();
@@ -387,15 +412,17 @@ public:
 
   /** Write the problem in MPS format to a file with the given filename.
       
-  \param compression can be set to three values to indicate what kind
+  \param compression can be set to five values to indicate what kind
   of file should be written
   <ul>
   <li> 0: plain text (default)
   <li> 1: gzip compressed (.gz is appended to \c filename)
   <li> 2: bzip2 compressed (.bz2 is appended to \c filename) (TODO)
+  <li> 3: zstd compressed (.zst is appended to \c filename)
+  <li> 4: lz4 compressed (.lz4 is appended to \c filename)
   </ul>
   If the library was not compiled with the requested compression then
-  writeMps falls back to writing a plain text file.
+  writeMps falls back as CoinMpsIO::writeMps does.
   
   \param formatType specifies the precision to used for values in the
   MPS file
@@ -412,6 +439,18 @@ public:
   */
   int writeMps(const char *filename, int compression = 0,
                int formatType = 0, int numberAcross = 2, bool keepStrings=false) ;
+
+  /** Write the problem as a binary snapshot (see CoinMpsIO::writeBinary).
+      Returns 0 if OK.
+      not const as may change model e.g. fill in default bounds
+  */
+  int writeBinary(const char *filename) ;
+
+  /** Read a problem written by writeBinary, replacing current model.
+      Returns 0 if OK, -1 if the file can not be opened and -2 if it is
+      not a valid snapshot.
+  */
+  int readBinary(const char *filename) ;
   
   /** Check two models against each other.  Return nonzero if different.
       Ignore names if that set.
@@ -458,7 +497,12 @@ public:
   { return getElement(rowName,columnName);}
   /// Returns value for row rowName and column columnName
   double getElement(const char * rowName,const char * columnName) const;
-  /// Returns quadratic value for columns i and j
+  /** Fingerprint of matrix, bounds, objective and integer columns - the
+      same as CoinMpsIO::fingerprint and CoinSnapshot::fingerprint for
+      the same problem.  String elements use their associated values;
+      string bounds and costs are as stored. */
+  CoinFingerprint fingerprint(int numberThreads = 1) const;
+  /// Returns Q(i,j) of quadratic objective
   double getQuadraticElement(int i,int j) const;
   /** Returns value for row i and column j as string.
       Returns NULL if does not exist.
@@ -710,6 +754,11 @@ public:
   /// Reset column names
   inline void zapColumnNames()
   { columnName_=CoinModelHash();}
+  /** Takes row, column names and strings added from now on from an arena
+      owned by the model.  Saves a malloc per name when building large
+      models; names deleted before the model is are not reclaimed until
+      then. */
+  void useArena();
   /// Returns array of 0 or nonzero if can be a cut (or returns NULL)
   inline const int * cutMarker() const
   { return cut_;}
@@ -819,6 +868,43 @@ public:
 		  const char* rowsen, const double* rowrhs,   
 		  const double* rowrng) ;
 
+  /*! \brief Load a whole problem from arrays in one call.
+
+    For bulk input of data which is already in arrays.  The matrix is
+    given by gap free vectors (start has numberMajor+1 entries) which are
+    columns if columnOrdered, else rows.  It goes straight into the packed
+    form of a block model; no linked lists, element hash or strings are
+    made, so (as after loadBlock) the matrix can not be changed element by
+    element afterwards.  The model must be empty.
+
+    NULL bounds and objective give the same defaults as loadBlock,
+    integerType may be NULL (all continuous) and names may be NULL (no
+    names) or have NULL entries.  Duplicate names abort as in addRow.
+  */
+  void loadArrays(int numberRows, int numberColumns, bool columnOrdered,
+		  const CoinBigIndex * start, const int * index,
+		  const double * element,
+		  const double * rowLower, const double * rowUpper,
+		  const double * columnLower, const double * columnUpper,
+		  const double * objective, const char * integerType = NULL,
+		  const char * const * rowNames = NULL,
+		  const char * const * columnNames = NULL);
+  /*! \brief Load a whole problem with the matrix as triplets.
+
+    As loadArrays but element k is at row rowIndex[k] and column
+    columnIndex[k] (in any order, no duplicates).  The column ordered form
+    is built by a counting sort.  Throws CoinError if an index is out of
+    range.
+  */
+  void loadTriplets(int numberRows, int numberColumns,
+		    CoinBigIndex numberElements, const int * rowIndex,
+		    const int * columnIndex, const double * element,
+		    const double * rowLower, const double * rowUpper,
+		    const double * columnLower, const double * columnUpper,
+		    const double * objective, const char * integerType = NULL,
+		    const char * const * rowNames = NULL,
+		    const char * const * columnNames = NULL);
+
    //@}
 
   /**@name Constructors, destructor */
@@ -853,6 +939,15 @@ public:
    CoinModel(const CoinModel&);
   /// =
    CoinModel& operator=(const CoinModel&);
+#if COIN_HAS_MOVE
+  /** Move constructor.  Takes all the arrays of \p rhs, which is left
+      as an empty model. */
+   CoinModel(CoinModel&&) COIN_NOEXCEPT;
+  /// Move assignment (exchanges contents with rhs)
+   CoinModel& operator=(CoinModel&&) COIN_NOEXCEPT;
+#endif
+  /// Exchange contents with \p rhs (no copying)
+   void swap(CoinModel & rhs);
    //@}
 
    /**@name For debug */
@@ -874,6 +969,9 @@ private:
       type 1 for row 2 for column
       Marked as const as list is mutable */
   void createList(int type) const;
+  /** Adds element (not already there) at end of triples when there are
+      no lists (room must be there) */
+  void addTriple(int row, int column, double value, bool doHash);
   /// Adds one string, returns index
   int addString(const char * string);
   /** Gets a double from a string possibly containing named strings,
@@ -882,8 +980,15 @@ private:
   double getDoubleFromString(CoinYacc & info, const char * string);
   /// Frees value memory
   void freeStringMemory(CoinYacc & info);
+  /// Exchanges CoinModel (not CoinBaseModel) data with rhs
+  void gutsOfSwap(CoinModel & rhs);
+  /** After rows or columns are packed down (elements compacted and
+      renumbered) redoes element hash, starts and linked lists */
+  void rebuildAfterPack();
 public:
-  /// Fills in all associated - returning number of errors
+  /** Fills in all associated - returning number of errors.
+      Strings are compiled on first use and kept, so after associating
+      new values only strings using changed values are computed again */
   int computeAssociated(double * associated);
   /** Gets correct form for a quadratic row - user to delete
       If row is not quadratic then returns which other variables are involved
@@ -930,6 +1035,15 @@ private:
   int decodeBit(char * phrase, char * & nextPhrase, double & coefficient, bool ifFirst) const;
   /// Aborts with message about packedMatrix
   void badType() const;
+  /// Loads a CoinMpsIO with model (for writeMps and writeBinary)
+  void fillMpsIO(CoinMpsIO & writer, bool keepStrings);
+  /// Sets block model from matrix (taken over) and arrays (see loadArrays)
+  void loadPacked(CoinPackedMatrix * matrix,
+		  const double * rowLower, const double * rowUpper,
+		  const double * columnLower, const double * columnUpper,
+		  const double * objective, const char * integerType,
+		  const char * const * rowNames,
+		  const char * const * columnNames);
   /**@name Data members */
    //@{
   /// Maximum number of rows
@@ -1006,10 +1120,14 @@ private:
   mutable CoinModelLinkedList quadraticRowList_;
   /// Linked list for quadratic columns
   mutable CoinModelLinkedList quadraticColumnList_;
+  /// Quadratic objective
+  CoinQuadraticMatrix quadraticObjective_;
   /// Size of associated values
   int sizeAssociated_;
   /// Associated values
   double * associated_;
+  /// Compiled strings and their values
+  CoinModelExpressions expressions_;
   /// Number of SOS - all these are done in one go e.g. from ampl
   int numberSOS_;
   /// SOS starts
@@ -1032,7 +1150,7 @@ private:
       -1 unset,
       0 for row, 
       1 for column,
-      2 linked.
+      2 mixed - just triples until row or column lists are wanted (links_).
       3 matrix is CoinPackedMatrix (and at present can't be modified);
   */
   mutable int type_;
@@ -1045,6 +1163,8 @@ private:
       3 - both
   */
   mutable int links_;
+  /// Arena for names and strings (see useArena)
+  CoinArena * arena_;
    //@}
 };
 /// Just function of single variable x
@@ -0,0 +1,332 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CoinUtilsConfig.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "CoinModelCache.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinLpIO.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinInstrument.hpp"
+
+#ifdef HAVE_SYS_STAT_H
+#include <sys/types.h>
+#include <sys/stat.h>
+#define COIN_HAS_STAT
+#endif
+
+//#############################################################################
+// Cached models
+//#############################################################################
+
+namespace {
+  // Memory of a matrix (both copies) and bounds etc of rows and columns
+  size_t modelBytes(int numberRows, int numberColumns,
+		    CoinBigIndex numberElements)
+  {
+    size_t bytes = 2*static_cast<size_t>(numberElements)*
+      (sizeof(double)+sizeof(int));
+    bytes += static_cast<size_t>(numberColumns)*
+      (4*sizeof(double)+2*sizeof(CoinBigIndex)+sizeof(int)+1);
+    bytes += static_cast<size_t>(numberRows)*
+      (5*sizeof(double)+2*sizeof(CoinBigIndex)+sizeof(int)+1);
+    return bytes;
+  }
+  // Memory of a name (string, pointer and hash entry)
+  inline size_t nameBytes(const char * name)
+  {
+    return (name ? strlen(name)+1 : 0)+sizeof(char *)+4*sizeof(int);
+  }
+}
+
+CoinCachedModel::CoinCachedModel(CoinMpsIO * model, int returnCode)
+  : mps_(model),
+    lp_(NULL),
+    returnCode_(returnCode),
+    bytes_(sizeof(CoinMpsIO))
+{
+  // make everything built on demand now, so it is never built while shared
+  model->getMatrixByCol();
+  model->getMatrixByRow();
+  model->getRowSense();
+  model->getRightHandSide();
+  model->getRowRange();
+  model->rowIndex("");
+  model->columnIndex("");
+  int numberRows = model->getNumRows();
+  int numberColumns = model->getNumCols();
+  bytes_ += modelBytes(numberRows,numberColumns,model->getNumElements());
+  for (int i=0;i<numberRows;i++)
+    bytes_ += nameBytes(model->rowName(i));
+  for (int i=0;i<numberColumns;i++)
+    bytes_ += nameBytes(model->columnName(i));
+}
+
+CoinCachedModel::CoinCachedModel(CoinLpIO * model)
+  : mps_(NULL),
+    lp_(model),
+    returnCode_(0),
+    bytes_(sizeof(CoinLpIO))
+{
+  model->getMatrixByCol();
+  model->getRowSense();
+  model->getRightHandSide();
+  model->getRowRange();
+  int numberRows = model->getNumRows();
+  int numberColumns = model->getNumCols();
+  bytes_ += modelBytes(numberRows,numberColumns,model->getNumElements());
+  bytes_ += static_cast<size_t>(numberColumns)*sizeof(double)*
+    (model->getNumObjectives()-1);
+  for (int i=0;i<numberRows;i++)
+    bytes_ += nameBytes(model->rowName(i));
+  for (int i=0;i<numberColumns;i++)
+    bytes_ += nameBytes(model->columnName(i));
+}
+
+CoinCachedModel::~CoinCachedModel()
+{
+  delete mps_;
+  delete lp_;
+}
+
+//#############################################################################
+// Keys
+//#############################################################################
+
+namespace {
+  // Bytes looked at by fingerprint at each place
+  const int fingerprintBlock = 4096;
+
+  // FNV-1a
+  CoinUInt64 fingerprint(const unsigned char * data, size_t n,
+			 CoinUInt64 hash)
+  {
+    for (size_t i=0;i<n;i++) {
+      hash ^= data[i];
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+}
+
+std::string
+CoinModelCache::key(const std::string & fileName, const std::string & settings)
+{
+#ifdef COIN_HAS_STAT
+  if (fileName=="stdin"||fileName=="-"||
+      fileName.find("://")!=std::string::npos)
+    return std::string();
+  std::string name = fileName;
+  if (!fileCoinReadable(name)||name.find("://")!=std::string::npos)
+    return std::string();
+  struct stat status;
+  if (stat(name.c_str(),&status)||!S_ISREG(status.st_mode))
+    return std::string();
+  FILE * fp = fopen(name.c_str(),"rb");
+  if (!fp)
+    return std::string();
+  CoinInt64 size = status.st_size;
+  CoinUInt64 hash = 14695981039346656037ULL;
+  unsigned char buffer[fingerprintBlock];
+  CoinInt64 where[3];
+  where[0] = 0;
+  where[1] = (size-fingerprintBlock)/2;
+  where[2] = size-fingerprintBlock;
+  for (int i=0;i<3;i++) {
+    if (i&&where[i]<=0)
+      break;
+    if (fseek(fp,static_cast<long>(where[i]),SEEK_SET)) {
+      fclose(fp);
+      return std::string();
+    }
+    size_t n = fread(buffer,1,fingerprintBlock,fp);
+    hash = fingerprint(buffer,n,hash);
+  }
+  fclose(fp);
+  char line[200];
+  sprintf(line,"\n%lld %lld %llx\n",static_cast<long long>(size),
+	  static_cast<long long>(status.st_mtime),
+	  static_cast<unsigned long long>(hash));
+  return name+line+settings;
+#else
+  return std::string();
+#endif
+}
+
+//#############################################################################
+// Cache
+//#############################################################################
+
+CoinModelCache::CoinModelCache(size_t maximumBytes)
+  : maximumBytes_(maximumBytes),
+    bytes_(0),
+    hits_(0),
+    misses_(0),
+    evictions_(0)
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_init(&mutex_,NULL);
+#endif
+}
+
+CoinModelCache::~CoinModelCache()
+{
+  clear();
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+void
+CoinModelCache::lock() const
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_lock(&mutex_);
+#endif
+}
+
+void
+CoinModelCache::unlock() const
+{
+#ifdef COINUTILS_PTHREADS
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+
+Coin::SmartPtr<CoinCachedModel>
+CoinModelCache::find(const std::string & key)
+{
+  Coin::SmartPtr<CoinCachedModel> model;
+  lock();
+  std::map<std::string,CoinModelCacheEntry>::iterator found =
+    models_.find(key);
+  if (found!=models_.end()) {
+    model = found->second.model;
+    // now most recently used
+    order_.splice(order_.begin(),order_,found->second.where);
+    hits_++;
+  } else {
+    misses_++;
+  }
+  unlock();
+  if (model.IsValid()) {
+    COIN_COUNT("modelcache.hit");
+  } else {
+    COIN_COUNT("modelcache.miss");
+  }
+  return model;
+}
+
+void
+CoinModelCache::insert(const std::string & key, CoinCachedModel * model)
+{
+  Coin::SmartPtr<CoinCachedModel> keep = model;
+  // old model (if any) released after unlocking
+  Coin::SmartPtr<CoinCachedModel> old;
+  lock();
+  std::map<std::string,CoinModelCacheEntry>::iterator found =
+    models_.find(key);
+  if (found!=models_.end()) {
+    old = found->second.model;
+    bytes_ -= old->bytes();
+    found->second.model = keep;
+    order_.splice(order_.begin(),order_,found->second.where);
+  } else {
+    order_.push_front(key);
+    CoinModelCacheEntry & entry = models_[key];
+    entry.model = keep;
+    entry.where = order_.begin();
+  }
+  bytes_ += model->bytes();
+  evict();
+  unlock();
+}
+
+// Called locked
+void
+CoinModelCache::evict()
+{
+  while (bytes_>maximumBytes_&&!order_.empty()) {
+    std::map<std::string,CoinModelCacheEntry>::iterator found =
+      models_.find(order_.back());
+    bytes_ -= found->second.model->bytes();
+    models_.erase(found);
+    order_.pop_back();
+    evictions_++;
+    COIN_COUNT("modelcache.evict");
+  }
+}
+
+void
+CoinModelCache::clear()
+{
+  lock();
+  models_.clear();
+  order_.clear();
+  bytes_ = 0;
+  unlock();
+}
+
+void
+CoinModelCache::setMaximumBytes(size_t value)
+{
+  lock();
+  maximumBytes_ = value;
+  evict();
+  unlock();
+}
+
+size_t
+CoinModelCache::bytes() const
+{
+  lock();
+  size_t value = bytes_;
+  unlock();
+  return value;
+}
+
+int
+CoinModelCache::numberModels() const
+{
+  lock();
+  int value = static_cast<int>(models_.size());
+  unlock();
+  return value;
+}
+
+CoinInt64
+CoinModelCache::hits() const
+{
+  lock();
+  CoinInt64 value = hits_;
+  unlock();
+  return value;
+}
+
+CoinInt64
+CoinModelCache::misses() const
+{
+  lock();
+  CoinInt64 value = misses_;
+  unlock();
+  return value;
+}
+
+CoinInt64
+CoinModelCache::evictions() const
+{
+  lock();
+  CoinInt64 value = evictions_;
+  unlock();
+  return value;
+}
@@ -0,0 +1,162 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinModelCache_H
+#define CoinModelCache_H
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "CoinUtilsConfig.h"
+#include "CoinSmartPtr.hpp"
+
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+class CoinMpsIO;
+class CoinLpIO;
+
+/** A parsed model held by a CoinModelCache
+
+    Owns one CoinMpsIO or CoinLpIO which is never changed once cached.
+    Row copies, row senses and name hash tables are made before it is
+    shared, so const methods may be used from several threads at once
+    (except names made up for a model read without names, see
+    CoinMpsIO::setKeepNames).  Reference counted - it lives while the
+    cache or any caller holds a Coin::SmartPtr to it.
+*/
+class CoinCachedModel : public Coin::AtomicReferencedObject {
+public:
+  /// Takes ownership of a model read with readMps (with its return code)
+  CoinCachedModel(CoinMpsIO * model, int returnCode);
+  /// Takes ownership of a model read with readLp
+  explicit CoinCachedModel(CoinLpIO * model);
+  /// Destructor
+  virtual ~CoinCachedModel();
+
+  /// Model if read as MPS (else NULL)
+  inline const CoinMpsIO * mps() const
+  { return mps_;}
+  /// Model if read as LP (else NULL)
+  inline const CoinLpIO * lp() const
+  { return lp_;}
+  /// Return code of readMps (0 for LP)
+  inline int returnCode() const
+  { return returnCode_;}
+  /// Approximate memory used
+  inline size_t bytes() const
+  { return bytes_;}
+
+private:
+  /// Not copyable
+  CoinCachedModel(const CoinCachedModel &);
+  CoinCachedModel & operator=(const CoinCachedModel &);
+
+  CoinMpsIO * mps_;
+  CoinLpIO * lp_;
+  int returnCode_;
+  size_t bytes_;
+};
+
+/** In-process cache of parsed models
+
+    Given to CoinMpsIO::setModelCache or CoinLpIO::setModelCache, readMps
+    and readLp of a local file first look in the cache.  A model is found
+    again if the file name, size, modification time and a fingerprint of
+    its contents (64 bit hash of 4KB at the start, middle and end) are the
+    same, and so are the reader settings which change what is parsed
+    (infinity, tolerances and so on).  On a hit the reader gets a copy of
+    the cached model (memcpy of its arrays, no parsing); CoinMpsIO::viewMps
+    and CoinLpIO::viewLp hand out the cached model itself with no copy at
+    all.  A modified file gets a new key and so is read again - the old
+    entry ages out.  Changing only a few bytes in the middle of a file
+    without changing its size or modification time would not be seen.
+
+    stdin and files read through sources (scheme://...) are never cached.
+    Only MPS files read with return code 0 are kept.
+
+    Least recently used models are dropped once the models held take more
+    than maximumBytes() (a single model bigger than that is not kept).
+    Callers still holding a dropped model keep it until they let go.
+
+    Lookups are counted as "modelcache.hit" and "modelcache.miss", drops as
+    "modelcache.evict" (see CoinInstrument) as well as by hits() etc.
+
+    Thread safe if built with COINUTILS_PTHREADS.  Readers using a cache
+    do not own it, it must outlive them.
+*/
+class CoinModelCache {
+public:
+  /**@name Models */
+  //@{
+  /** Key of \p fileName read with \p settings, or empty if it can not
+      be cached.  fileCoinReadable is used to find the file */
+  static std::string key(const std::string & fileName,
+			 const std::string & settings);
+  /// Model with key (NULL if none) - counted as hit or miss
+  Coin::SmartPtr<CoinCachedModel> find(const std::string & key);
+  /// Adds (or replaces) model with key, dropping old models if needed
+  void insert(const std::string & key, CoinCachedModel * model);
+  /// Drops all models (statistics are kept)
+  void clear();
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  inline size_t maximumBytes() const
+  { return maximumBytes_;}
+  /// Sets bound on memory, dropping models if needed
+  void setMaximumBytes(size_t value);
+  /// Memory used by models held
+  size_t bytes() const;
+  /// Number of models held
+  int numberModels() const;
+  /// Lookups which found a model
+  CoinInt64 hits() const;
+  /// Lookups which did not
+  CoinInt64 misses() const;
+  /// Models dropped to keep within maximumBytes()
+  CoinInt64 evictions() const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Cache holding up to maximumBytes of models (default 1GB)
+  explicit CoinModelCache(size_t maximumBytes = 1024*1024*1024);
+  /// Destructor (models still used elsewhere live on)
+  ~CoinModelCache();
+  //@}
+
+private:
+  /// Not copyable
+  CoinModelCache(const CoinModelCache &);
+  CoinModelCache & operator=(const CoinModelCache &);
+  /// Drops least recently used models down to maximumBytes_ (locked)
+  void evict();
+  void lock() const;
+  void unlock() const;
+
+  typedef std::list<std::string> CoinModelCacheList;
+  typedef struct {
+    Coin::SmartPtr<CoinCachedModel> model;
+    CoinModelCacheList::iterator where;
+  } CoinModelCacheEntry;
+  /// Models by key
+  std::map<std::string,CoinModelCacheEntry> models_;
+  /// Keys, most recently used first
+  CoinModelCacheList order_;
+  size_t maximumBytes_;
+  size_t bytes_;
+  CoinInt64 hits_;
+  CoinInt64 misses_;
+  CoinInt64 evictions_;
+#ifdef COINUTILS_PTHREADS
+  mutable pthread_mutex_t mutex_;
+#endif
+};
+
+#endif
@@ -0,0 +1,948 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinError.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinModel.hpp"
+#include "CoinModelDelta.hpp"
+
+/* Delta format (version 1).  All values little-endian.
+
+   Header of 128 bytes
+     0  "COINDLT" and '\0'
+     8  int32 version, int32 header size
+    16  int64 base rows, base columns, rows, columns
+    48  int64 row changes, column changes, element changes
+    72  int64 row names, column names, bytes of names
+    96  int64 flags (1 - objective offset)
+   104  double objective offset
+   112  reserved (zero)
+   then sections, each padded to multiple of 8 bytes
+     int32 rows, double lower, upper (row changes),
+     int32 columns, double lower, upper, objective, char integer
+       (column changes),
+     int32 rows, int32 columns, double elements (element changes),
+     int32 row then column of each name, int64 name offsets (names+1)
+       and name characters, each '\0' terminated.
+*/
+namespace {
+  const char deltaMagic[8] = {'C','O','I','N','D','L','T','\0'};
+  const int deltaVersion = 1;
+  const int deltaHeaderSize = 128;
+  // Chunk so int sizes in CoinFileIO are fine
+  const int deltaChunk = 1<<24;
+
+  typedef struct {
+    char magic[8];
+    int version;
+    int headerSize;
+    CoinInt64 baseRows;
+    CoinInt64 baseColumns;
+    CoinInt64 numberRows;
+    CoinInt64 numberColumns;
+    CoinInt64 rowChanges;
+    CoinInt64 columnChanges;
+    CoinInt64 elementChanges;
+    CoinInt64 rowNames;
+    CoinInt64 columnNames;
+    CoinInt64 nameBytes;
+    CoinInt64 flags;
+    double objectiveOffset;
+    CoinInt64 reserved[2];
+  } CoinModelDeltaHeader;
+
+  bool deltaLittleEndian()
+  {
+    int one = 1;
+    return *reinterpret_cast<char *>(&one)==1;
+  }
+  void deltaSwap(char * data, size_t number, int size)
+  {
+    for (size_t i=0;i<number;i++) {
+      char * item = data + i*size;
+      for (int j=0;j<size/2;j++) {
+	char temp = item[j];
+	item[j] = item[size-1-j];
+	item[size-1-j] = temp;
+      }
+    }
+  }
+  inline size_t deltaPadded(size_t bytes)
+  { return (bytes+7)&~static_cast<size_t>(7);}
+  // Bytes for given numbers of changes
+  size_t deltaBytes(size_t rows, size_t columns, size_t elements,
+		    size_t names, size_t nameBytes)
+  {
+    return deltaHeaderSize +
+      deltaPadded(4*rows) + 16*rows +
+      deltaPadded(4*columns) + 24*columns + deltaPadded(columns) +
+      2*deltaPadded(4*elements) + 8*elements +
+      deltaPadded(4*names) + 8*(names+1) + deltaPadded(nameBytes);
+  }
+  // Copies number items of size to put and pads to 8
+  void deltaPut(char * & put, const void * data, size_t number, int size)
+  {
+    size_t bytes = number*size;
+    if (bytes)
+      memcpy(put,data,bytes);
+    if (size>1&&!deltaLittleEndian())
+      deltaSwap(put,number,size);
+    size_t padded = deltaPadded(bytes);
+    memset(put+bytes,0,padded-bytes);
+    put += padded;
+  }
+  // Reads what deltaPut wrote - returns false if not enough
+  bool deltaGet(const char * & get, const char * end, void * data,
+		size_t number, int size)
+  {
+    size_t bytes = number*size;
+    size_t padded = deltaPadded(bytes);
+    if (static_cast<size_t>(end-get)<padded)
+      return false;
+    if (bytes)
+      memcpy(data,get,bytes);
+    if (size>1&&!deltaLittleEndian())
+      deltaSwap(reinterpret_cast<char *>(data),number,size);
+    get += padded;
+    return true;
+  }
+  inline double deltaValue(const double * array, int i, double value)
+  { return array ? array[i] : value;}
+  inline int deltaValue(const int * array, int i)
+  { return array ? array[i] : 0;}
+}
+
+//#############################################################################
+
+CoinModelDelta::CoinModelDelta() :
+  baseRows_(0),
+  baseColumns_(0),
+  numberRows_(0),
+  numberColumns_(0),
+  flags_(0),
+  objectiveOffset_(0.0),
+  numberRowChanges_(0),
+  rowIndex_(NULL),
+  rowLower_(NULL),
+  rowUpper_(NULL),
+  numberColumnChanges_(0),
+  columnIndex_(NULL),
+  columnLower_(NULL),
+  columnUpper_(NULL),
+  objective_(NULL),
+  integerType_(NULL),
+  numberElementChanges_(0),
+  elementRow_(NULL),
+  elementColumn_(NULL),
+  element_(NULL),
+  numberRowNames_(0),
+  numberColumnNames_(0),
+  nameIndex_(NULL),
+  nameOffset_(NULL),
+  nameString_(NULL)
+{
+}
+
+CoinModelDelta::CoinModelDelta(CoinModel & base, CoinModel & model) :
+  baseRows_(0),
+  baseColumns_(0),
+  numberRows_(0),
+  numberColumns_(0),
+  flags_(0),
+  objectiveOffset_(0.0),
+  numberRowChanges_(0),
+  rowIndex_(NULL),
+  rowLower_(NULL),
+  rowUpper_(NULL),
+  numberColumnChanges_(0),
+  columnIndex_(NULL),
+  columnLower_(NULL),
+  columnUpper_(NULL),
+  objective_(NULL),
+  integerType_(NULL),
+  numberElementChanges_(0),
+  elementRow_(NULL),
+  elementColumn_(NULL),
+  element_(NULL),
+  numberRowNames_(0),
+  numberColumnNames_(0),
+  nameIndex_(NULL),
+  nameOffset_(NULL),
+  nameString_(NULL)
+{
+  CoinModel * models[2] = {&base, &model};
+  double * rowLower[2];
+  double * rowUpper[2];
+  double * columnLower[2];
+  double * columnUpper[2];
+  double * objective[2];
+  int * integerType[2];
+  double * associated[2];
+  CoinPackedMatrix matrix[2];
+  const CoinPackedMatrix * useMatrix[2];
+  for (int k=0;k<2;k++) {
+    CoinModel * thisModel = models[k];
+    rowLower[k] = thisModel->rowLowerArray();
+    rowUpper[k] = thisModel->rowUpperArray();
+    columnLower[k] = thisModel->columnLowerArray();
+    columnUpper[k] = thisModel->columnUpperArray();
+    objective[k] = thisModel->objectiveArray();
+    integerType[k] = thisModel->integerTypeArray();
+    associated[k] = thisModel->associatedArray();
+    // If strings then do copies
+    if (thisModel->stringsExist())
+      thisModel->createArrays(rowLower[k], rowUpper[k], columnLower[k],
+			      columnUpper[k], objective[k], integerType[k],
+			      associated[k]);
+    if (thisModel->type()==3) {
+      useMatrix[k] = thisModel->packedMatrix();
+    } else {
+      thisModel->createPackedMatrix(matrix[k],associated[k]);
+      useMatrix[k] = matrix + k;
+    }
+    // matrix may not know about empty rows and columns
+    if (useMatrix[k]->getNumRows()!=thisModel->numberRows()||
+	useMatrix[k]->getNumCols()!=thisModel->numberColumns()) {
+      if (useMatrix[k]!=matrix+k) {
+	matrix[k] = *useMatrix[k];
+	useMatrix[k] = matrix + k;
+      }
+      matrix[k].setDimensions(thisModel->numberRows(),
+			      thisModel->numberColumns());
+    }
+  }
+  try {
+    compute(*useMatrix[0], columnLower[0], columnUpper[0], objective[0],
+	    rowLower[0], rowUpper[0], integerType[0],
+	    *useMatrix[1], columnLower[1], columnUpper[1], objective[1],
+	    rowLower[1], rowUpper[1], integerType[1]);
+  }
+  catch (CoinError &) {
+    for (int k=0;k<2;k++) {
+      if (rowLower[k]!=models[k]->rowLowerArray()) {
+	delete [] rowLower[k];
+	delete [] rowUpper[k];
+	delete [] columnLower[k];
+	delete [] columnUpper[k];
+	delete [] objective[k];
+	delete [] integerType[k];
+	delete [] associated[k];
+      }
+    }
+    throw;
+  }
+  for (int k=0;k<2;k++) {
+    if (rowLower[k]!=models[k]->rowLowerArray()) {
+      delete [] rowLower[k];
+      delete [] rowUpper[k];
+      delete [] columnLower[k];
+      delete [] columnUpper[k];
+      delete [] objective[k];
+      delete [] integerType[k];
+      delete [] associated[k];
+    }
+  }
+  if (base.objectiveOffset()!=model.objectiveOffset()) {
+    flags_ |= 1;
+    objectiveOffset_ = model.objectiveOffset();
+  }
+  // Names which are new or different
+  int numberNames = 0;
+  size_t nameBytes = 0;
+  for (int iPass=0;iPass<2;iPass++) {
+    for (int type=0;type<2;type++) {
+      int number = type ? numberColumns_ : numberRows_;
+      int numberBase = type ? baseColumns_ : baseRows_;
+      for (int i=0;i<number;i++) {
+	const char * name = type ? model.columnName(i) : model.rowName(i);
+	if (!name)
+	  continue;
+	const char * baseName = NULL;
+	if (i<numberBase)
+	  baseName = type ? base.columnName(i) : base.rowName(i);
+	if (baseName&&!strcmp(name,baseName))
+	  continue;
+	size_t length = strlen(name)+1;
+	if (!iPass) {
+	  if (type)
+	    numberColumnNames_++;
+	  else
+	    numberRowNames_++;
+	  nameBytes += length;
+	} else {
+	  nameIndex_[numberNames] = i;
+	  nameOffset_[numberNames] = static_cast<CoinBigIndex>(nameBytes);
+	  memcpy(nameString_+nameBytes,name,length);
+	  nameBytes += length;
+	  numberNames++;
+	}
+      }
+    }
+    if (!iPass) {
+      if (!nameBytes)
+	break;
+      numberNames = numberRowNames_+numberColumnNames_;
+      nameIndex_ = new int [numberNames];
+      nameOffset_ = new CoinBigIndex [numberNames+1];
+      nameString_ = new char [nameBytes];
+      nameOffset_[numberNames] = static_cast<CoinBigIndex>(nameBytes);
+      numberNames = 0;
+      nameBytes = 0;
+    }
+  }
+}
+
+CoinModelDelta::CoinModelDelta(const CoinPackedMatrix & baseMatrix,
+			       const double * baseColumnLower,
+			       const double * baseColumnUpper,
+			       const double * baseObjective,
+			       const double * baseRowLower,
+			       const double * baseRowUpper,
+			       const CoinPackedMatrix & matrix,
+			       const double * columnLower,
+			       const double * columnUpper,
+			       const double * objective,
+			       const double * rowLower,
+			       const double * rowUpper,
+			       const char * baseIntegerType,
+			       const char * integerType) :
+  baseRows_(0),
+  baseColumns_(0),
+  numberRows_(0),
+  numberColumns_(0),
+  flags_(0),
+  objectiveOffset_(0.0),
+  numberRowChanges_(0),
+  rowIndex_(NULL),
+  rowLower_(NULL),
+  rowUpper_(NULL),
+  numberColumnChanges_(0),
+  columnIndex_(NULL),
+  columnLower_(NULL),
+  columnUpper_(NULL),
+  objective_(NULL),
+  integerType_(NULL),
+  numberElementChanges_(0),
+  elementRow_(NULL),
+  elementColumn_(NULL),
+  element_(NULL),
+  numberRowNames_(0),
+  numberColumnNames_(0),
+  nameIndex_(NULL),
+  nameOffset_(NULL),
+  nameString_(NULL)
+{
+  int * integer[2] = {NULL, NULL};
+  const char * marker[2] = {baseIntegerType, integerType};
+  int number[2] = {baseMatrix.getNumCols(), matrix.getNumCols()};
+  for (int k=0;k<2;k++) {
+    if (marker[k]) {
+      integer[k] = new int [number[k]];
+      for (int i=0;i<number[k];i++)
+	integer[k][i] = marker[k][i];
+    }
+  }
+  try {
+    compute(baseMatrix, baseColumnLower, baseColumnUpper, baseObjective,
+	    baseRowLower, baseRowUpper, integer[0],
+	    matrix, columnLower, columnUpper, objective,
+	    rowLower, rowUpper, integer[1]);
+  }
+  catch (CoinError &) {
+    delete [] integer[0];
+    delete [] integer[1];
+    throw;
+  }
+  delete [] integer[0];
+  delete [] integer[1];
+}
+
+CoinModelDelta::CoinModelDelta(const CoinModelDelta & rhs) :
+  baseRows_(0),
+  baseColumns_(0),
+  numberRows_(0),
+  numberColumns_(0),
+  flags_(0),
+  objectiveOffset_(0.0),
+  numberRowChanges_(0),
+  rowIndex_(NULL),
+  rowLower_(NULL),
+  rowUpper_(NULL),
+  numberColumnChanges_(0),
+  columnIndex_(NULL),
+  columnLower_(NULL),
+  columnUpper_(NULL),
+  objective_(NULL),
+  integerType_(NULL),
+  numberElementChanges_(0),
+  elementRow_(NULL),
+  elementColumn_(NULL),
+  element_(NULL),
+  numberRowNames_(0),
+  numberColumnNames_(0),
+  nameIndex_(NULL),
+  nameOffset_(NULL),
+  nameString_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinModelDelta &
+CoinModelDelta::operator=(const CoinModelDelta & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinModelDelta::~CoinModelDelta()
+{
+  gutsOfDelete();
+}
+
+void
+CoinModelDelta::gutsOfDelete()
+{
+  delete [] rowIndex_;
+  delete [] rowLower_;
+  delete [] rowUpper_;
+  delete [] columnIndex_;
+  delete [] columnLower_;
+  delete [] columnUpper_;
+  delete [] objective_;
+  delete [] integerType_;
+  delete [] elementRow_;
+  delete [] elementColumn_;
+  delete [] element_;
+  delete [] nameIndex_;
+  delete [] nameOffset_;
+  delete [] nameString_;
+  rowIndex_ = NULL;
+  rowLower_ = NULL;
+  rowUpper_ = NULL;
+  columnIndex_ = NULL;
+  columnLower_ = NULL;
+  columnUpper_ = NULL;
+  objective_ = NULL;
+  integerType_ = NULL;
+  elementRow_ = NULL;
+  elementColumn_ = NULL;
+  element_ = NULL;
+  nameIndex_ = NULL;
+  nameOffset_ = NULL;
+  nameString_ = NULL;
+  baseRows_ = 0;
+  baseColumns_ = 0;
+  numberRows_ = 0;
+  numberColumns_ = 0;
+  flags_ = 0;
+  objectiveOffset_ = 0.0;
+  numberRowChanges_ = 0;
+  numberColumnChanges_ = 0;
+  numberElementChanges_ = 0;
+  numberRowNames_ = 0;
+  numberColumnNames_ = 0;
+}
+
+void
+CoinModelDelta::gutsOfCopy(const CoinModelDelta & rhs)
+{
+  baseRows_ = rhs.baseRows_;
+  baseColumns_ = rhs.baseColumns_;
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  flags_ = rhs.flags_;
+  objectiveOffset_ = rhs.objectiveOffset_;
+  allocate(rhs.numberRowChanges_,rhs.numberColumnChanges_,
+	   rhs.numberElementChanges_);
+  CoinMemcpyN(rhs.rowIndex_,numberRowChanges_,rowIndex_);
+  CoinMemcpyN(rhs.rowLower_,numberRowChanges_,rowLower_);
+  CoinMemcpyN(rhs.rowUpper_,numberRowChanges_,rowUpper_);
+  CoinMemcpyN(rhs.columnIndex_,numberColumnChanges_,columnIndex_);
+  CoinMemcpyN(rhs.columnLower_,numberColumnChanges_,columnLower_);
+  CoinMemcpyN(rhs.columnUpper_,numberColumnChanges_,columnUpper_);
+  CoinMemcpyN(rhs.objective_,numberColumnChanges_,objective_);
+  CoinMemcpyN(rhs.integerType_,numberColumnChanges_,integerType_);
+  CoinMemcpyN(rhs.elementRow_,numberElementChanges_,elementRow_);
+  CoinMemcpyN(rhs.elementColumn_,numberElementChanges_,elementColumn_);
+  CoinMemcpyN(rhs.element_,numberElementChanges_,element_);
+  numberRowNames_ = rhs.numberRowNames_;
+  numberColumnNames_ = rhs.numberColumnNames_;
+  int numberNames = numberRowNames_+numberColumnNames_;
+  if (numberNames) {
+    nameIndex_ = CoinCopyOfArray(rhs.nameIndex_,numberNames);
+    nameOffset_ = CoinCopyOfArray(rhs.nameOffset_,numberNames+1);
+    nameString_ = CoinCopyOfArray(rhs.nameString_,nameOffset_[numberNames]);
+  }
+}
+
+void
+CoinModelDelta::allocate(int numberRowChanges, int numberColumnChanges,
+			 CoinBigIndex numberElementChanges)
+{
+  numberRowChanges_ = numberRowChanges;
+  numberColumnChanges_ = numberColumnChanges;
+  numberElementChanges_ = numberElementChanges;
+  if (numberRowChanges) {
+    rowIndex_ = new int [numberRowChanges];
+    rowLower_ = new double [numberRowChanges];
+    rowUpper_ = new double [numberRowChanges];
+  }
+  if (numberColumnChanges) {
+    columnIndex_ = new int [numberColumnChanges];
+    columnLower_ = new double [numberColumnChanges];
+    columnUpper_ = new double [numberColumnChanges];
+    objective_ = new double [numberColumnChanges];
+    integerType_ = new char [numberColumnChanges];
+  }
+  if (numberElementChanges) {
+    elementRow_ = new int [numberElementChanges];
+    elementColumn_ = new int [numberElementChanges];
+    element_ = new double [numberElementChanges];
+  }
+}
+
+bool
+CoinModelDelta::isEmpty() const
+{
+  return !numberRowChanges_&&!numberColumnChanges_&&!numberElementChanges_&&
+    !numberRowNames_&&!numberColumnNames_&&!flags_&&
+    numberRows_==baseRows_&&numberColumns_==baseColumns_;
+}
+
+/* Finds changes.  Rows and columns past the end of base are always
+   changes so they are created when applied */
+void
+CoinModelDelta::compute(const CoinPackedMatrix & baseMatrix,
+			const double * baseColumnLower,
+			const double * baseColumnUpper,
+			const double * baseObjective,
+			const double * baseRowLower,
+			const double * baseRowUpper,
+			const int * baseIntegerType,
+			const CoinPackedMatrix & matrix,
+			const double * columnLower,
+			const double * columnUpper,
+			const double * objective,
+			const double * rowLower,
+			const double * rowUpper,
+			const int * integerType)
+{
+  baseRows_ = baseMatrix.getNumRows();
+  baseColumns_ = baseMatrix.getNumCols();
+  numberRows_ = matrix.getNumRows();
+  numberColumns_ = matrix.getNumCols();
+  if (numberRows_<baseRows_||numberColumns_<baseColumns_) {
+    gutsOfDelete();
+    throw CoinError("Model has fewer rows or columns than base",
+		    "CoinModelDelta", "CoinModelDelta");
+  }
+  int * which = new int [CoinMax(numberRows_,numberColumns_)];
+  int numberRowChanges = 0;
+  for (int i=0;i<numberRows_;i++) {
+    if (i>=baseRows_||
+	deltaValue(rowLower,i,-COIN_DBL_MAX)!=
+	deltaValue(baseRowLower,i,-COIN_DBL_MAX)||
+	deltaValue(rowUpper,i,COIN_DBL_MAX)!=
+	deltaValue(baseRowUpper,i,COIN_DBL_MAX))
+      which[numberRowChanges++] = i;
+  }
+  int * whichColumn = new int [numberColumns_];
+  int numberColumnChanges = 0;
+  for (int i=0;i<numberColumns_;i++) {
+    if (i>=baseColumns_||
+	deltaValue(columnLower,i,0.0)!=deltaValue(baseColumnLower,i,0.0)||
+	deltaValue(columnUpper,i,COIN_DBL_MAX)!=
+	deltaValue(baseColumnUpper,i,COIN_DBL_MAX)||
+	deltaValue(objective,i,0.0)!=deltaValue(baseObjective,i,0.0)||
+	deltaValue(integerType,i)!=deltaValue(baseIntegerType,i))
+      whichColumn[numberColumnChanges++] = i;
+  }
+  // Elements - compare column by column using dense work array
+  CoinPackedMatrix * copy[2] = {NULL, NULL};
+  const CoinPackedMatrix * byColumn[2] = {&baseMatrix, &matrix};
+  for (int k=0;k<2;k++) {
+    if (!byColumn[k]->isColOrdered()) {
+      copy[k] = new CoinPackedMatrix();
+      copy[k]->reverseOrderedCopyOf(*byColumn[k]);
+      byColumn[k] = copy[k];
+    }
+  }
+  const CoinBigIndex * baseStart = byColumn[0]->getVectorStarts();
+  const int * baseLength = byColumn[0]->getVectorLengths();
+  const int * baseRow = byColumn[0]->getIndices();
+  const double * baseElement = byColumn[0]->getElements();
+  const CoinBigIndex * start = byColumn[1]->getVectorStarts();
+  const int * length = byColumn[1]->getVectorLengths();
+  const int * row = byColumn[1]->getIndices();
+  const double * element = byColumn[1]->getElements();
+  CoinBigIndex maximumChanges = byColumn[0]->getNumElements()+
+    byColumn[1]->getNumElements();
+  int * changeRow = new int [CoinMax(maximumChanges,1)];
+  int * changeColumn = new int [CoinMax(maximumChanges,1)];
+  double * change = new double [CoinMax(maximumChanges,1)];
+  CoinBigIndex numberElementChanges = 0;
+  double * work = new double [CoinMax(numberRows_,1)];
+  // 0 not in base, 1 in base, 2 in both
+  char * mark = new char [CoinMax(numberRows_,1)];
+  CoinZeroN(mark,numberRows_);
+  for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
+    CoinBigIndex baseEnd = 0;
+    if (iColumn<baseColumns_) {
+      baseEnd = baseStart[iColumn]+baseLength[iColumn];
+      for (CoinBigIndex j=baseStart[iColumn];j<baseEnd;j++) {
+	int iRow = baseRow[j];
+	work[iRow] = baseElement[j];
+	mark[iRow] = 1;
+      }
+    }
+    for (CoinBigIndex j=start[iColumn];j<start[iColumn]+length[iColumn];j++) {
+      int iRow = row[j];
+      double value = element[j];
+      if (mark[iRow]) {
+	mark[iRow] = 2;
+	if (value==work[iRow])
+	  continue;
+      } else if (!value) {
+	continue;
+      }
+      changeRow[numberElementChanges] = iRow;
+      changeColumn[numberElementChanges] = iColumn;
+      change[numberElementChanges++] = value;
+    }
+    if (iColumn<baseColumns_) {
+      for (CoinBigIndex j=baseStart[iColumn];j<baseEnd;j++) {
+	int iRow = baseRow[j];
+	if (mark[iRow]==1&&work[iRow]) {
+	  // gone
+	  changeRow[numberElementChanges] = iRow;
+	  changeColumn[numberElementChanges] = iColumn;
+	  change[numberElementChanges++] = 0.0;
+	}
+	mark[iRow] = 0;
+      }
+    }
+  }
+  delete [] work;
+  delete [] mark;
+  delete copy[0];
+  delete copy[1];
+  allocate(numberRowChanges,numberColumnChanges,numberElementChanges);
+  for (int k=0;k<numberRowChanges;k++) {
+    int i = which[k];
+    rowIndex_[k] = i;
+    rowLower_[k] = deltaValue(rowLower,i,-COIN_DBL_MAX);
+    rowUpper_[k] = deltaValue(rowUpper,i,COIN_DBL_MAX);
+  }
+  for (int k=0;k<numberColumnChanges;k++) {
+    int i = whichColumn[k];
+    columnIndex_[k] = i;
+    columnLower_[k] = deltaValue(columnLower,i,0.0);
+    columnUpper_[k] = deltaValue(columnUpper,i,COIN_DBL_MAX);
+    objective_[k] = deltaValue(objective,i,0.0);
+    integerType_[k] = static_cast<char>(deltaValue(integerType,i));
+  }
+  CoinMemcpyN(changeRow,numberElementChanges,elementRow_);
+  CoinMemcpyN(changeColumn,numberElementChanges,elementColumn_);
+  CoinMemcpyN(change,numberElementChanges,element_);
+  delete [] which;
+  delete [] whichColumn;
+  delete [] changeRow;
+  delete [] changeColumn;
+  delete [] change;
+}
+
+int
+CoinModelDelta::apply(CoinModel & model) const
+{
+  if (model.numberRows()!=baseRows_||model.numberColumns()!=baseColumns_)
+    return -1;
+  // elements of a passed in matrix can not be changed
+  if (model.type()==3&&numberElementChanges_)
+    return -1;
+  for (int k=0;k<numberRowChanges_;k++)
+    model.setRowBounds(rowIndex_[k],rowLower_[k],rowUpper_[k]);
+  for (int k=0;k<numberColumnChanges_;k++) {
+    int iColumn = columnIndex_[k];
+    model.setColumnBounds(iColumn,columnLower_[k],columnUpper_[k]);
+    model.setColumnObjective(iColumn,objective_[k]);
+    model.setColumnIsInteger(iColumn,integerType_[k]!=0);
+  }
+  for (CoinBigIndex k=0;k<numberElementChanges_;k++) {
+    if (element_[k])
+      model.setElement(elementRow_[k],elementColumn_[k],element_[k]);
+    else
+      model.deleteElement(elementRow_[k],elementColumn_[k]);
+  }
+  for (int k=0;k<numberRowNames_;k++)
+    model.setRowName(nameIndex_[k],nameString_+nameOffset_[k]);
+  for (int k=numberRowNames_;k<numberRowNames_+numberColumnNames_;k++)
+    model.setColumnName(nameIndex_[k],nameString_+nameOffset_[k]);
+  if ((flags_&1)!=0)
+    model.setObjectiveOffset(objectiveOffset_);
+  return 0;
+}
+
+int
+CoinModelDelta::apply(CoinPackedMatrix & matrix, double * columnLower,
+		      double * columnUpper, double * objective,
+		      double * rowLower, double * rowUpper,
+		      char * integerType) const
+{
+  if (matrix.getNumRows()!=baseRows_||matrix.getNumCols()!=baseColumns_)
+    return -1;
+  if (numberRows_!=baseRows_||numberColumns_!=baseColumns_)
+    matrix.setDimensions(numberRows_,numberColumns_);
+  for (int k=0;k<numberRowChanges_;k++) {
+    int iRow = rowIndex_[k];
+    rowLower[iRow] = rowLower_[k];
+    rowUpper[iRow] = rowUpper_[k];
+  }
+  for (int k=0;k<numberColumnChanges_;k++) {
+    int iColumn = columnIndex_[k];
+    columnLower[iColumn] = columnLower_[k];
+    columnUpper[iColumn] = columnUpper_[k];
+    objective[iColumn] = objective_[k];
+    if (integerType)
+      integerType[iColumn] = integerType_[k];
+  }
+  if (numberElementChanges_)
+    matrix.modifyCoefficients(static_cast<int>(numberElementChanges_),
+			      elementRow_,elementColumn_,element_);
+  return 0;
+}
+
+size_t
+CoinModelDelta::bufferSize() const
+{
+  int numberNames = numberRowNames_+numberColumnNames_;
+  size_t nameBytes = numberNames ? nameOffset_[numberNames] : 0;
+  return deltaBytes(numberRowChanges_,numberColumnChanges_,
+		    numberElementChanges_,numberNames,nameBytes);
+}
+
+void
+CoinModelDelta::toBuffer(char * buffer) const
+{
+  int numberNames = numberRowNames_+numberColumnNames_;
+  CoinBigIndex nameBytes = numberNames ? nameOffset_[numberNames] : 0;
+  CoinModelDeltaHeader header;
+  assert (sizeof(header)==deltaHeaderSize);
+  memset(&header,0,sizeof(header));
+  memcpy(header.magic,deltaMagic,8);
+  header.version = deltaVersion;
+  header.headerSize = deltaHeaderSize;
+  header.baseRows = baseRows_;
+  header.baseColumns = baseColumns_;
+  header.numberRows = numberRows_;
+  header.numberColumns = numberColumns_;
+  header.rowChanges = numberRowChanges_;
+  header.columnChanges = numberColumnChanges_;
+  header.elementChanges = numberElementChanges_;
+  header.rowNames = numberRowNames_;
+  header.columnNames = numberColumnNames_;
+  header.nameBytes = nameBytes;
+  header.flags = flags_;
+  header.objectiveOffset = objectiveOffset_;
+  memcpy(buffer,&header,deltaHeaderSize);
+  if (!deltaLittleEndian()) {
+    deltaSwap(buffer+8,2,4);
+    deltaSwap(buffer+16,12,8);
+  }
+  char * put = buffer+deltaHeaderSize;
+  deltaPut(put,rowIndex_,numberRowChanges_,4);
+  deltaPut(put,rowLower_,numberRowChanges_,8);
+  deltaPut(put,rowUpper_,numberRowChanges_,8);
+  deltaPut(put,columnIndex_,numberColumnChanges_,4);
+  deltaPut(put,columnLower_,numberColumnChanges_,8);
+  deltaPut(put,columnUpper_,numberColumnChanges_,8);
+  deltaPut(put,objective_,numberColumnChanges_,8);
+  deltaPut(put,integerType_,numberColumnChanges_,1);
+  deltaPut(put,elementRow_,numberElementChanges_,4);
+  deltaPut(put,elementColumn_,numberElementChanges_,4);
+  deltaPut(put,element_,numberElementChanges_,8);
+  deltaPut(put,nameIndex_,numberNames,4);
+  CoinInt64 * offset = new CoinInt64 [numberNames+1];
+  offset[0] = 0;
+  for (int i=0;i<numberNames;i++)
+    offset[i+1] = nameOffset_[i+1];
+  deltaPut(put,offset,numberNames+1,8);
+  delete [] offset;
+  deltaPut(put,nameString_,nameBytes,1);
+  assert (static_cast<size_t>(put-buffer)==bufferSize());
+}
+
+int
+CoinModelDelta::fromBuffer(const char * buffer, size_t size)
+{
+  gutsOfDelete();
+  CoinModelDeltaHeader header;
+  if (size<static_cast<size_t>(deltaHeaderSize))
+    return -2;
+  memcpy(&header,buffer,deltaHeaderSize);
+  if (!deltaLittleEndian()) {
+    deltaSwap(reinterpret_cast<char *>(&header.version),2,4);
+    deltaSwap(reinterpret_cast<char *>(&header.baseRows),12,8);
+  }
+  if (memcmp(header.magic,deltaMagic,8)||header.version!=deltaVersion||
+      header.headerSize!=deltaHeaderSize)
+    return -2;
+  CoinInt64 counts[] = {header.baseRows, header.baseColumns,
+			header.numberRows, header.numberColumns,
+			header.rowChanges, header.columnChanges,
+			header.elementChanges, header.rowNames,
+			header.columnNames, header.nameBytes};
+  for (int i=0;i<10;i++) {
+    if (counts[i]<0||counts[i]>COIN_INT_MAX)
+      return -2;
+  }
+  if (header.numberRows<header.baseRows||
+      header.numberColumns<header.baseColumns||
+      header.rowChanges>header.numberRows||
+      header.columnChanges>header.numberColumns||
+      header.rowNames>header.numberRows||
+      header.columnNames>header.numberColumns)
+    return -2;
+  int numberNames = static_cast<int>(header.rowNames+header.columnNames);
+  if (size!=deltaBytes(static_cast<size_t>(header.rowChanges),
+		       static_cast<size_t>(header.columnChanges),
+		       static_cast<size_t>(header.elementChanges),
+		       numberNames,static_cast<size_t>(header.nameBytes)))
+    return -2;
+  baseRows_ = static_cast<int>(header.baseRows);
+  baseColumns_ = static_cast<int>(header.baseColumns);
+  numberRows_ = static_cast<int>(header.numberRows);
+  numberColumns_ = static_cast<int>(header.numberColumns);
+  flags_ = static_cast<int>(header.flags&1);
+  objectiveOffset_ = header.objectiveOffset;
+  allocate(static_cast<int>(header.rowChanges),
+	   static_cast<int>(header.columnChanges),
+	   static_cast<CoinBigIndex>(header.elementChanges));
+  const char * get = buffer+deltaHeaderSize;
+  const char * end = buffer+size;
+  bool ok = true;
+  ok = ok && deltaGet(get,end,rowIndex_,numberRowChanges_,4);
+  ok = ok && deltaGet(get,end,rowLower_,numberRowChanges_,8);
+  ok = ok && deltaGet(get,end,rowUpper_,numberRowChanges_,8);
+  ok = ok && deltaGet(get,end,columnIndex_,numberColumnChanges_,4);
+  ok = ok && deltaGet(get,end,columnLower_,numberColumnChanges_,8);
+  ok = ok && deltaGet(get,end,columnUpper_,numberColumnChanges_,8);
+  ok = ok && deltaGet(get,end,objective_,numberColumnChanges_,8);
+  ok = ok && deltaGet(get,end,integerType_,numberColumnChanges_,1);
+  ok = ok && deltaGet(get,end,elementRow_,numberElementChanges_,4);
+  ok = ok && deltaGet(get,end,elementColumn_,numberElementChanges_,4);
+  ok = ok && deltaGet(get,end,element_,numberElementChanges_,8);
+  numberRowNames_ = static_cast<int>(header.rowNames);
+  numberColumnNames_ = static_cast<int>(header.columnNames);
+  CoinInt64 * offset = new CoinInt64 [numberNames+1];
+  if (numberNames) {
+    nameIndex_ = new int [numberNames];
+    nameOffset_ = new CoinBigIndex [numberNames+1];
+    nameString_ = new char [header.nameBytes];
+  }
+  ok = ok && deltaGet(get,end,nameIndex_,numberNames,4);
+  ok = ok && deltaGet(get,end,offset,numberNames+1,8);
+  ok = ok && deltaGet(get,end,nameString_,
+		      static_cast<size_t>(header.nameBytes),1);
+  // check everything is in range
+  ok = ok && offset[0]==0 && offset[numberNames]==header.nameBytes;
+  for (int i=0;ok&&i<numberNames;i++) {
+    ok = offset[i+1]>offset[i]&&offset[i+1]<=header.nameBytes&&
+      !nameString_[offset[i+1]-1];
+    nameOffset_[i] = static_cast<CoinBigIndex>(offset[i]);
+    int limit = (i<numberRowNames_) ? numberRows_ : numberColumns_;
+    ok = ok && nameIndex_[i]>=0 && nameIndex_[i]<limit;
+  }
+  if (ok&&numberNames)
+    nameOffset_[numberNames] = static_cast<CoinBigIndex>(header.nameBytes);
+  delete [] offset;
+  for (int k=0;ok&&k<numberRowChanges_;k++)
+    ok = rowIndex_[k]>=0 && rowIndex_[k]<numberRows_;
+  for (int k=0;ok&&k<numberColumnChanges_;k++)
+    ok = columnIndex_[k]>=0 && columnIndex_[k]<numberColumns_;
+  for (CoinBigIndex k=0;ok&&k<numberElementChanges_;k++)
+    ok = elementRow_[k]>=0 && elementRow_[k]<numberRows_ &&
+      elementColumn_[k]>=0 && elementColumn_[k]<numberColumns_;
+  if (!ok) {
+    gutsOfDelete();
+    return -2;
+  }
+  return 0;
+}
+
+int
+CoinModelDelta::writeDelta(const char * filename) const
+{
+  CoinFileOutput * output = NULL;
+  try {
+    output = CoinFileOutput::create(filename,CoinFileOutput::COMPRESS_NONE);
+  }
+  catch (CoinError &) {
+    output = NULL;
+  }
+  if (!output)
+    return -1;
+  size_t size = bufferSize();
+  char * buffer = new char [size];
+  toBuffer(buffer);
+  bool ok = true;
+  for (size_t done=0;ok&&done<size;) {
+    int n = static_cast<int>(CoinMin(size-done,
+				     static_cast<size_t>(deltaChunk)));
+    ok = output->write(buffer+done,n)==n;
+    done += n;
+  }
+  delete [] buffer;
+  delete output;
+  return ok ? 0 : -1;
+}
+
+int
+CoinModelDelta::readDelta(const char * filename)
+{
+  CoinFileInput * input = NULL;
+  try {
+    input = CoinFileInput::create(filename);
+  }
+  catch (CoinError &) {
+    input = NULL;
+  }
+  if (!input)
+    return -1;
+  // read whole file as may be compressed
+  size_t size = 0;
+  size_t maximumSize = deltaChunk;
+  char * buffer = new char [maximumSize];
+  while (true) {
+    if (size==maximumSize) {
+      maximumSize *= 2;
+      char * temp = new char [maximumSize];
+      memcpy(temp,buffer,size);
+      delete [] buffer;
+      buffer = temp;
+    }
+    int n = static_cast<int>(CoinMin(maximumSize-size,
+				     static_cast<size_t>(deltaChunk)));
+    n = input->read(buffer+size,n);
+    if (n<=0)
+      break;
+    size += n;
+  }
+  delete input;
+  int returnCode = fromBuffer(buffer,size);
+  delete [] buffer;
+  return returnCode;
+}
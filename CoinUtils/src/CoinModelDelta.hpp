@@ -0,0 +1,205 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinModelDelta_H
+#define CoinModelDelta_H
+
+#include <cstddef>
+
+#include "CoinTypes.hpp"
+
+class CoinModel;
+class CoinPackedMatrix;
+
+/** Changes which turn one model into another
+
+    Holds only what differs between a base model and a changed one - row
+    bounds, column bounds, objective and integer markers, elements, names
+    and objective offset - so a large model can be brought up to date, or
+    a copy held elsewhere sent the changes, at a cost in proportion to the
+    changes rather than the model.  Computing a delta has to look at both
+    models so is in proportion to their size.
+
+    Rows and columns may be added at the end but not removed (a row can be
+    freed instead).  A changed row or column keeps all its values and a
+    changed element its new value (zero if removed) so applying a delta
+    twice does no harm.  Quadratic objectives and strings are not held -
+    strings are evaluated when the delta is computed.
+
+    A delta may be written to a buffer or file (little-endian, sections
+    padded to 8 bytes as in CoinMpsIO::writeBinary) and read back on any
+    machine.
+*/
+class CoinModelDelta {
+public:
+  /**@name Applying */
+  //@{
+  /** Applies changes to model which must have base number of rows and
+      columns.  Returns 0 if OK, -1 if model is wrong size */
+  int apply(CoinModel & model) const;
+  /** Applies changes to matrix and arrays.  The matrix must have base
+      number of rows and columns and is made larger if needed, the arrays
+      must be long enough for the new sizes.  integerType may be NULL.
+      Names and objective offset are not applied.  Returns 0 if OK, -1 if
+      matrix is wrong size */
+  int apply(CoinPackedMatrix & matrix, double * columnLower,
+	    double * columnUpper, double * objective, double * rowLower,
+	    double * rowUpper, char * integerType = NULL) const;
+  //@}
+
+  /**@name Writing and reading */
+  //@{
+  /// Number of bytes needed by toBuffer
+  size_t bufferSize() const;
+  /// Writes delta to buffer of bufferSize() bytes
+  void toBuffer(char * buffer) const;
+  /** Replaces delta by one written by toBuffer.  Returns 0 if OK, -2 if
+      buffer is not a valid delta (this is then empty) */
+  int fromBuffer(const char * buffer, size_t size);
+  /// Writes delta to file.  Returns 0 if OK, -1 if it can not be written
+  int writeDelta(const char * filename) const;
+  /** Replaces delta by one written by writeDelta.  Returns 0 if OK, -1 if
+      the file can not be opened and -2 if it is not a valid delta */
+  int readDelta(const char * filename);
+  //@}
+
+  /**@name Access */
+  //@{
+  /// Number of rows of base model
+  inline int baseRows() const
+  { return baseRows_;}
+  /// Number of columns of base model
+  inline int baseColumns() const
+  { return baseColumns_;}
+  /// Number of rows after changes
+  inline int numberRows() const
+  { return numberRows_;}
+  /// Number of columns after changes
+  inline int numberColumns() const
+  { return numberColumns_;}
+  /// Number of changed (or new) rows
+  inline int numberRowChanges() const
+  { return numberRowChanges_;}
+  /// Number of changed (or new) columns
+  inline int numberColumnChanges() const
+  { return numberColumnChanges_;}
+  /// Number of changed elements
+  inline CoinBigIndex numberElementChanges() const
+  { return numberElementChanges_;}
+  /// Number of changed names (rows then columns)
+  inline int numberNameChanges() const
+  { return numberRowNames_+numberColumnNames_;}
+  /// True if there are no changes
+  bool isEmpty() const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor (no changes)
+  CoinModelDelta();
+  /** Changes from base to model.  Throws CoinError if model has fewer
+      rows or columns than base.  May tidy both models as differentModel
+      does */
+  CoinModelDelta(CoinModel & base, CoinModel & model);
+  /** Changes from base matrix and arrays to matrix and arrays.  Integer
+      markers may be NULL.  Throws CoinError if matrix has fewer rows or
+      columns than baseMatrix */
+  CoinModelDelta(const CoinPackedMatrix & baseMatrix,
+		 const double * baseColumnLower,
+		 const double * baseColumnUpper,
+		 const double * baseObjective,
+		 const double * baseRowLower, const double * baseRowUpper,
+		 const CoinPackedMatrix & matrix,
+		 const double * columnLower, const double * columnUpper,
+		 const double * objective,
+		 const double * rowLower, const double * rowUpper,
+		 const char * baseIntegerType = NULL,
+		 const char * integerType = NULL);
+  /// Copy constructor
+  CoinModelDelta(const CoinModelDelta & rhs);
+  /// Assignment
+  CoinModelDelta & operator=(const CoinModelDelta & rhs);
+  /// Destructor
+  ~CoinModelDelta();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays and sets to no changes
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinModelDelta & rhs);
+  /// Allocates arrays for given numbers of changes
+  void allocate(int numberRowChanges, int numberColumnChanges,
+		CoinBigIndex numberElementChanges);
+  /** Finds changes in bounds, objective, integer markers and elements.
+      Missing arrays are taken as defaults */
+  void compute(const CoinPackedMatrix & baseMatrix,
+	       const double * baseColumnLower, const double * baseColumnUpper,
+	       const double * baseObjective, const double * baseRowLower,
+	       const double * baseRowUpper, const int * baseIntegerType,
+	       const CoinPackedMatrix & matrix,
+	       const double * columnLower, const double * columnUpper,
+	       const double * objective, const double * rowLower,
+	       const double * rowUpper, const int * integerType);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Number of rows of base
+  int baseRows_;
+  /// Number of columns of base
+  int baseColumns_;
+  /// Number of rows after changes
+  int numberRows_;
+  /// Number of columns after changes
+  int numberColumns_;
+  /// 1 bit - objective offset changed
+  int flags_;
+  /// New objective offset
+  double objectiveOffset_;
+  /// Number of changed rows
+  int numberRowChanges_;
+  /// Changed rows
+  int * rowIndex_;
+  /// Their lower bounds
+  double * rowLower_;
+  /// Their upper bounds
+  double * rowUpper_;
+  /// Number of changed columns
+  int numberColumnChanges_;
+  /// Changed columns
+  int * columnIndex_;
+  /// Their lower bounds
+  double * columnLower_;
+  /// Their upper bounds
+  double * columnUpper_;
+  /// Their objective coefficients
+  double * objective_;
+  /// Their integer markers
+  char * integerType_;
+  /// Number of changed elements
+  CoinBigIndex numberElementChanges_;
+  /// Rows of changed elements
+  int * elementRow_;
+  /// Columns of changed elements (in increasing order)
+  int * elementColumn_;
+  /// New values (zero if removed)
+  double * element_;
+  /// Number of changed row names
+  int numberRowNames_;
+  /// Number of changed column names
+  int numberColumnNames_;
+  /// Row (then column) of each changed name
+  int * nameIndex_;
+  /// Offset of each name in nameString_ (one more than names)
+  CoinBigIndex * nameOffset_;
+  /// Names (each followed by a null)
+  char * nameString_;
+  //@}
+};
+
+#endif
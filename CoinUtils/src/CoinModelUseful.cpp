@@ -16,6 +16,7 @@
 #include "CoinHelperFunctions.hpp"
 
 #include "CoinModelUseful.hpp"
+#include "CoinArena.hpp"
 
 
 //#############################################################################
@@ -69,22 +70,6 @@ CoinModelLink::operator=(const CoinModelLink& rhs)
   return *this;
 }
 
-namespace {
- const int mmult[] = {
-    262139, 259459, 256889, 254291, 251701, 249133, 246709, 244247,
-    241667, 239179, 236609, 233983, 231289, 228859, 226357, 223829,
-    221281, 218849, 216319, 213721, 211093, 208673, 206263, 203773,
-    201233, 198637, 196159, 193603, 191161, 188701, 186149, 183761,
-    181303, 178873, 176389, 173897, 171469, 169049, 166471, 163871,
-    161387, 158941, 156437, 153949, 151531, 149159, 146749, 144299,
-    141709, 139369, 136889, 134591, 132169, 129641, 127343, 124853,
-    122477, 120163, 117757, 115361, 112979, 110567, 108179, 105727,
-    103387, 101021, 98639, 96179, 93911, 91583, 89317, 86939, 84521,
-    82183, 79939, 77587, 75307, 72959, 70793, 68447, 66103
-  };
-  const int lengthMult = static_cast<int> (sizeof(mmult) / sizeof(int));
-}
-
 //#############################################################################
 // Constructors / Destructor / Assignment
 //#############################################################################
@@ -94,10 +79,9 @@ namespace {
 //-------------------------------------------------------------------
 CoinModelHash::CoinModelHash () 
   : names_(NULL),
-    hash_(NULL),
     numberItems_(0),
     maximumItems_(0),
-    lastSlot_(-1)
+    arena_(NULL)
 {
 }
 
@@ -106,17 +90,16 @@ CoinModelHash::CoinModelHash ()
 //-------------------------------------------------------------------
 CoinModelHash::CoinModelHash (const CoinModelHash & rhs) 
   : names_(NULL),
-    hash_(NULL),
+    index_(rhs.index_),
     numberItems_(rhs.numberItems_),
     maximumItems_(rhs.maximumItems_),
-    lastSlot_(rhs.lastSlot_)
+    arena_(NULL)
 {
   if (maximumItems_) {
     names_ = new char * [maximumItems_];
     for (int i=0;i<maximumItems_;i++) {
       names_[i]=CoinStrdup(rhs.names_[i]);
     }
-    hash_ = CoinCopyOfArray(rhs.hash_,4*maximumItems_);
   }
 }
 
@@ -126,9 +109,8 @@ CoinModelHash::CoinModelHash (const CoinModelHash & rhs)
 CoinModelHash::~CoinModelHash ()
 {
   for (int i=0;i<maximumItems_;i++) 
-    free(names_[i]);
+    freeName(names_[i]);
   delete [] names_;
-  delete [] hash_;
 }
 
 //----------------------------------------------------------------
@@ -139,30 +121,40 @@ CoinModelHash::operator=(const CoinModelHash& rhs)
 {
   if (this != &rhs) {
     for (int i=0;i<maximumItems_;i++) 
-      free(names_[i]);
+      freeName(names_[i]);
     delete [] names_;
-    delete [] hash_;
+    index_ = rhs.index_;
     numberItems_ = rhs.numberItems_;
     maximumItems_ = rhs.maximumItems_;
-    lastSlot_ = rhs.lastSlot_;
     if (maximumItems_) {
       names_ = new char * [maximumItems_];
       for (int i=0;i<maximumItems_;i++) {
         names_[i]=CoinStrdup(rhs.names_[i]);
       }
-      hash_ = CoinCopyOfArray(rhs.hash_,4*maximumItems_);
     } else {
       names_ = NULL;
-      hash_ = NULL;
     }
   }
   return *this;
 }
+// Exchange contents (no copying)
+void 
+CoinModelHash::swap(CoinModelHash & rhs)
+{
+  std::swap(names_,rhs.names_);
+  index_.swap(rhs.index_);
+  std::swap(numberItems_,rhs.numberItems_);
+  std::swap(maximumItems_,rhs.maximumItems_);
+  std::swap(arena_,rhs.arena_);
+}
 // Set number of items
 void 
 CoinModelHash::setNumberItems(int number)
 {
   assert (number>=0&&number<=numberItems_);
+  // names past end have been moved down (or deleted) so must not be freed
+  for (int i=number;i<numberItems_;i++)
+    names_[i]=NULL;
   numberItems_=number;
 }
 // Resize hash (also re-hashs)
@@ -173,91 +165,30 @@ CoinModelHash::resize(int maxItems,bool forceReHash)
   if (maxItems<=maximumItems_&&!forceReHash)
     return;
   int n=maximumItems_;
-  maximumItems_=maxItems;
-  char ** names = new char * [maximumItems_];
-  int i;
-  for ( i=0;i<n;i++) 
-    names[i]=names_[i];
-  for ( ;i<maximumItems_;i++) 
-    names[i]=NULL;
-  delete [] names_;
-  names_ = names;
-  delete [] hash_;
-  int maxHash = 4 * maximumItems_;
-  hash_ = new CoinModelHashLink [maxHash];
-  int ipos;
-
-  for ( i = 0; i < maxHash; i++ ) {
-    hash_[i].index = -1;
-    hash_[i].next = -1;
-  }
-
-  /*
-   * Initialize the hash table.  Only the index of the first name that
-   * hashes to a value is entered in the table; subsequent names that
-   * collide with it are not entered.
-   */
-  for ( i = 0; i < numberItems_; ++i ) {
-    if (names_[i]) {
-      ipos = hashValue ( names_[i]);
-      if ( hash_[ipos].index == -1 ) {
-        hash_[ipos].index = i;
-      }
-    }
+  maximumItems_=CoinMax(maxItems,n);
+  if (maximumItems_>n) {
+    char ** names = new char * [maximumItems_];
+    int i;
+    for ( i=0;i<n;i++) 
+      names[i]=names_[i];
+    for ( ;i<maximumItems_;i++) 
+      names[i]=NULL;
+    delete [] names_;
+    names_ = names;
   }
-
-  /*
-   * Now take care of the names that collided in the preceding loop,
-   * by finding some other entry in the table for them.
-   * Since there are as many entries in the table as there are names,
-   * there must be room for them.
-   */
-  lastSlot_ = -1;
-  for ( i = 0; i < numberItems_; ++i ) {
-    if (!names_[i]) 
-      continue;
-    char *thisName = names[i];
-    ipos = hashValue ( thisName);
-
-    while ( true ) {
-      int j1 = hash_[ipos].index;
-
-      if ( j1 == i )
-	break;
-      else {
-	char *thisName2 = names[j1];
-
-	if ( strcmp ( thisName, thisName2 ) == 0 ) {
-	  printf ( "** duplicate name %s\n", names[i] );
-          abort();
-	  break;
-	} else {
-	  int k = hash_[ipos].next;
-
-	  if ( k == -1 ) {
-	    while ( true ) {
-	      ++lastSlot_;
-	      if ( lastSlot_ > numberItems_ ) {
-		printf ( "** too many names\n" );
-                abort();
-		break;
-	      }
-	      if ( hash_[lastSlot_].index == -1 ) {
-		break;
-	      }
-	    }
-	    hash_[ipos].next = lastSlot_;
-	    hash_[lastSlot_].index = i;
-	    break;
-	  } else {
-	    ipos = k;
-	    /* nothing worked - try it again */
-	  }
-	}
+  index_.reserve(maximumItems_);
+  if (!forceReHash)
+    return;
+  // names may have been moved so enter all again
+  index_.clear();
+  if (index_.add(numberItems_,names_)) {
+    for (int i = 0; i < numberItems_; ++i ) {
+      if (names_[i]&&index_.find(names_[i])!=i) {
+        printf ( "** duplicate name %s\n", names_[i] );
+        abort();
       }
     }
   }
-  
 }
 // validate
 void 
@@ -273,42 +204,10 @@ CoinModelHash::validateHash() const
 int 
 CoinModelHash::hash(const char * name) const
 {
-  int found = -1;
-
-  int ipos;
-
   /* default if we don't find anything */
   if ( !numberItems_ )
     return -1;
-
-  ipos = hashValue ( name );
-  while ( true ) {
-    int j1 = hash_[ipos].index;
-
-    if ( j1 >= 0 ) {
-      char *thisName2 = names_[j1];
-
-      if ( strcmp ( name, thisName2 ) != 0 ) {
-	int k = hash_[ipos].next;
-
-	if ( k != -1 )
-	  ipos = k;
-	else
-	  break;
-      } else {
-	found = j1;
-	break;
-      }
-    } else {
-      int k = hash_[ipos].next;
-      
-      if ( k != -1 )
-        ipos = k;
-      else
-        break;
-    }
-  }
-  return found;
+  return index_.find(name);
 }
 // Adds to hash
 void 
@@ -318,74 +217,45 @@ CoinModelHash::addHash(int index, const char * name)
   if (numberItems_>=maximumItems_) 
     resize(1000+3*numberItems_/2);
   assert (!names_[index]);
-  names_[index]=CoinStrdup(name);
-  int ipos = hashValue ( name);
+  if (index_.add(index,name)!=index) {
+    printf ( "** duplicate name %s\n", name );
+    abort();
+  }
+  names_[index] = arena_ ? arena_->strdup(name) : CoinStrdup(name);
   numberItems_ = CoinMax(numberItems_,index+1);
-  if ( hash_[ipos].index <0 ) {
-    hash_[ipos].index = index;
-  } else {
-    while ( true ) {
-      int j1 = hash_[ipos].index;
-      
-      if ( j1 == index )
-	break; // duplicate?
-      else {
-        if (j1>=0) {
-          char *thisName2 = names_[j1];
-          if ( strcmp ( name, thisName2 ) == 0 ) {
-            printf ( "** duplicate name %s\n", names_[index] );
-            abort();
-            break;
-          } else {
-            int k = hash_[ipos].next;
-            
-            if ( k == -1 ) {
-              while ( true ) {
-                ++lastSlot_;
-                if ( lastSlot_ > numberItems_ ) {
-                  printf ( "** too many names\n" );
-                  abort();
-                  break;
-                }
-                if ( hash_[lastSlot_].index <0 && hash_[lastSlot_].next<0) {
-                  break;
-                }
-              }
-              hash_[ipos].next = lastSlot_;
-              hash_[lastSlot_].index = index;
-              hash_[lastSlot_].next=-1;
-              break;
-            } else {
-              ipos = k;
-            }
-          }
-        } else {
-          //slot available
-          hash_[ipos].index = index;
-        }
+}
+// Adds names of items 0 to number-1 in one go
+void 
+CoinModelHash::addNames(int number, const char * const * names)
+{
+  assert (!numberItems_);
+  resize(number);
+  if (index_.add(number,names)) {
+    for (int i = 0; i < number; ++i ) {
+      if (names[i]&&index_.find(names[i])!=i) {
+        printf ( "** duplicate name %s\n", names[i] );
+        abort();
       }
     }
   }
+  for (int i = 0; i < number; ++i ) {
+    if (names[i])
+      names_[i] = arena_ ? arena_->strdup(names[i]) : CoinStrdup(names[i]);
+  }
+  numberItems_ = number;
 }
 // Deletes from hash
 void 
 CoinModelHash::deleteHash(int index)
 {
   if (index<numberItems_&&names_[index]) {
-    
-    int ipos = hashValue ( names_[index] );
-
-    while ( ipos>=0 ) {
-      int j1 = hash_[ipos].index;
-      if ( j1!=index) {
-        ipos = hash_[ipos].next;
-      } else {
-        hash_[ipos].index=-1; // available
-        break;
-      }
-    }
-    assert (ipos>=0);
-    free(names_[index]);
+#ifndef NDEBUG
+    bool found = index_.remove(index);
+    assert (found);
+#else
+    index_.remove(index);
+#endif
+    freeName(names_[index]);
     names_[index]=NULL;
   }
 }
@@ -414,26 +284,12 @@ CoinModelHash::setName(int which,char * name )
   if (which<numberItems_)
     names_[which]=name;
 }
-// Returns a hash value
-int 
-CoinModelHash::hashValue(const char * name) const
+// Frees a name unless it is in arena
+void 
+CoinModelHash::freeName(char * name) const
 {
-  
-  int n = 0;
-  int j;
-  int length =  static_cast<int> (strlen(name));
-  // may get better spread with unsigned
-  const unsigned char * name2 = reinterpret_cast<const unsigned char *> (name);
-  while (length) {
-    int length2 = CoinMin( length,lengthMult);
-    for ( j = 0; j < length2; ++j ) {
-      n += mmult[j] * name2[j];
-    }
-    name+=length2;
-    length-=length2;
-  }
-  int maxHash = 4 * maximumItems_;
-  return ( abs ( n ) % maxHash );	/* integer abs */
+  if (!arena_||!arena_->owns(name))
+    free(name);
 }
 //#############################################################################
 // Constructors / Destructor / Assignment
@@ -445,7 +301,8 @@ CoinModelHash2::CoinModelHash2 ()
  :   hash_(NULL),
     numberItems_(0),
     maximumItems_(0),
-    lastSlot_(-1)
+    numberSlots_(0),
+    shift_(64)
 {
 }
 
@@ -456,10 +313,11 @@ CoinModelHash2::CoinModelHash2 (const CoinModelHash2 & rhs)
   : hash_(NULL),
     numberItems_(rhs.numberItems_),
     maximumItems_(rhs.maximumItems_),
-    lastSlot_(rhs.lastSlot_)
+    numberSlots_(rhs.numberSlots_),
+    shift_(rhs.shift_)
 {
-  if (maximumItems_) {
-    hash_ = CoinCopyOfArray(rhs.hash_,4*maximumItems_);
+  if (numberSlots_) {
+    hash_ = CoinCopyOfArray(rhs.hash_,numberSlots_);
   }
 }
 
@@ -481,15 +339,26 @@ CoinModelHash2::operator=(const CoinModelHash2& rhs)
     delete [] hash_;
     numberItems_ = rhs.numberItems_;
     maximumItems_ = rhs.maximumItems_;
-    lastSlot_ = rhs.lastSlot_;
-    if (maximumItems_) {
-      hash_ = CoinCopyOfArray(rhs.hash_,4*maximumItems_);
+    numberSlots_ = rhs.numberSlots_;
+    shift_ = rhs.shift_;
+    if (numberSlots_) {
+      hash_ = CoinCopyOfArray(rhs.hash_,numberSlots_);
     } else {
       hash_ = NULL;
     }
   }
   return *this;
 }
+// Exchange contents (no copying)
+void 
+CoinModelHash2::swap(CoinModelHash2 & rhs)
+{
+  std::swap(hash_,rhs.hash_);
+  std::swap(numberItems_,rhs.numberItems_);
+  std::swap(maximumItems_,rhs.maximumItems_);
+  std::swap(numberSlots_,rhs.numberSlots_);
+  std::swap(shift_,rhs.shift_);
+}
 // Set number of items
 void 
 CoinModelHash2::setNumberItems(int number)
@@ -497,6 +366,45 @@ CoinModelHash2::setNumberItems(int number)
   assert (number>=0&&(number<=numberItems_||!numberItems_));
   numberItems_=number;
 }
+// Makes room for maxItems items keeping entries
+void 
+CoinModelHash2::grow(int maxItems)
+{
+  maximumItems_=CoinMax(maxItems,maximumItems_);
+  // keep at most half full
+  if (2*maximumItems_<=numberSlots_)
+    return;
+  int numberSlots = CoinMax(numberSlots_,16);
+  int shift = 60;
+  while (numberSlots<2*maximumItems_) {
+    numberSlots *= 2;
+  }
+  for (int i=16;i<numberSlots;i*=2)
+    shift--;
+  CoinModelHash2Slot * oldHash = hash_;
+  int oldSlots = numberSlots_;
+  hash_ = new CoinModelHash2Slot [numberSlots];
+  numberSlots_ = numberSlots;
+  shift_ = shift;
+  for (int i = 0; i < numberSlots; i++ ) 
+    hash_[i].index = -1;
+  for (int i = 0; i < oldSlots; i++ ) {
+    if (oldHash[i].index>=0)
+      insert(oldHash[i].index,oldHash[i].key);
+  }
+  delete [] oldHash;
+}
+// Enters key as index (no check for duplicates)
+void 
+CoinModelHash2::insert(int index, CoinUInt64 key)
+{
+  const int mask = numberSlots_-1;
+  int ipos = hashValue(key);
+  while (hash_[ipos].index>=0)
+    ipos = (ipos+1)&mask;
+  hash_[ipos].key = key;
+  hash_[ipos].index = index;
+}
 // Resize hash (also re-hashs)
 void 
 CoinModelHash2::resize(int maxItems, const CoinModelTriple * triples,bool forceReHash)
@@ -504,128 +412,46 @@ CoinModelHash2::resize(int maxItems, const CoinModelTriple * triples,bool forceR
   assert (numberItems_<=maximumItems_||!maximumItems_);
   if (maxItems<=maximumItems_&&!forceReHash)
     return;
-  if (maxItems>maximumItems_) {
-    maximumItems_=maxItems;
-    delete [] hash_;
-    hash_ = new CoinModelHashLink [4*maximumItems_];
+  if (!forceReHash&&numberSlots_) {
+    // entries are in table
+    grow(maxItems);
+    return;
   }
-  int maxHash = 4 * maximumItems_;
-  int ipos;
-  int i;
-  for ( i = 0; i < maxHash; i++ ) {
+  grow(CoinMax(maxItems,numberItems_));
+  for (int i = 0; i < numberSlots_; i++ ) 
     hash_[i].index = -1;
-    hash_[i].next = -1;
-  }
-
-  /*
-   * Initialize the hash table.  Only the index of the first name that
-   * hashes to a value is entered in the table; subsequent names that
-   * collide with it are not entered.
-   */
-  for ( i = 0; i < numberItems_; ++i ) {
+  for (int i = 0; i < numberItems_; ++i ) {
     int row = static_cast<int> (rowInTriple(triples[i]));
     int column = triples[i].column;
     if (column>=0) {
-      ipos = hashValue ( row, column);
-      if ( hash_[ipos].index == -1 ) {
-        hash_[ipos].index = i;
+      const CoinUInt64 thisKey = key(row,column);
+      if (hash(row,column,triples)>=0) {
+        printf ( "** duplicate entry %d %d\n", row,column );
+        abort();
       }
+      insert(i,thisKey);
     }
   }
-
-  /*
-   * Now take care of the entries that collided in the preceding loop,
-   * by finding some other entry in the table for them.
-   * Since there are as many entries in the table as there are entries,
-   * there must be room for them.
-   */
-  lastSlot_ = -1;
-  for ( i = 0; i < numberItems_; ++i ) {
-    int row = static_cast<int> (rowInTriple(triples[i]));
-    int column = triples[i].column;
-    if (column>=0) {
-      ipos = hashValue ( row, column);
-
-      while ( true ) {
-        int j1 = hash_[ipos].index;
-        
-        if ( j1 == i )
-          break;
-        else {
-          int row2 = static_cast<int> (rowInTriple(triples[j1]));
-          int column2 = triples[j1].column;
-          if ( row==row2&&column==column2 ) {
-            printf ( "** duplicate entry %d %d\n", row,column );
-            abort();
-            break;
-          } else {
-            int k = hash_[ipos].next;
-            
-            if ( k == -1 ) {
-              while ( true ) {
-                ++lastSlot_;
-                if ( lastSlot_ > numberItems_ ) {
-                  printf ( "** too many entries\n" );
-                  abort();
-                  break;
-                }
-                if ( hash_[lastSlot_].index == -1 ) {
-                  break;
-                }
-              }
-              hash_[ipos].next = lastSlot_;
-              hash_[lastSlot_].index = i;
-              break;
-            } else {
-              ipos = k;
-            }
-          }
-	}
-      }
-    }
-  }
-  
 }
 // Returns index or -1
 int 
-CoinModelHash2::hash(int row, int column, const CoinModelTriple * triples) const
+CoinModelHash2::hash(int row, int column, const CoinModelTriple * ) const
 {
-  int found = -1;
-
-  int ipos;
-
   /* default if we don't find anything */
-  if ( !numberItems_ )
+  if ( !numberItems_ || !numberSlots_ )
     return -1;
 
-  ipos = hashValue ( row, column );
+  const CoinUInt64 thisKey = key(row,column);
+  const int mask = numberSlots_-1;
+  int ipos = hashValue ( thisKey );
   while ( true ) {
     int j1 = hash_[ipos].index;
-
-    if ( j1 >= 0 ) {
-      int row2 = static_cast<int> (rowInTriple(triples[j1]));
-      int column2 = triples[j1].column;
-      if ( row!=row2||column!=column2 ) {
-	int k = hash_[ipos].next;
-        
-	if ( k != -1 )
-	  ipos = k;
-	else
-	  break;
-      } else {
-	found = j1;
-	break;
-      }
-    } else {
-      int k = hash_[ipos].next;
-      
-      if ( k != -1 )
-        ipos = k;
-      else
-        break;
-    }
+    if (j1<0)
+      return -1;
+    if (hash_[ipos].key==thisKey)
+      return j1;
+    ipos = (ipos+1)&mask;
   }
-  return found;
 }
 // Adds to hash
 void 
@@ -634,124 +460,47 @@ CoinModelHash2::addHash(int index, int row, int column, const CoinModelTriple *
   // resize if necessary
   if (numberItems_>=maximumItems_||index+1>=maximumItems_) 
     resize(CoinMax(1000+3*numberItems_/2,index+1), triples);
-  int ipos = hashValue ( row, column);
   numberItems_ = CoinMax(numberItems_,index+1);
   assert (numberItems_<=maximumItems_);
-  if ( hash_[ipos].index <0 ) {
-    hash_[ipos].index = index;
-  } else {
-    while ( true ) {
-      int j1 = hash_[ipos].index;
-      
-      if ( j1 == index ) {
-	break; // duplicate??
-      } else {
-        if (j1 >=0 ) {
-          int row2 = static_cast<int> (rowInTriple(triples[j1]));
-          int column2 = triples[j1].column;
-          if ( row==row2&&column==column2 ) {
-            printf ( "** duplicate entry %d %d\n", row, column );
-            abort();
-            break;
-          } else {
-            int k = hash_[ipos].next;
-            
-            if ( k ==-1 ) {
-              while ( true ) {
-                ++lastSlot_;
-                if ( lastSlot_ > numberItems_ ) {
-                  printf ( "** too many entrys\n" );
-                  abort();
-                  break;
-                }
-                if ( hash_[lastSlot_].index <0 ) {
-                  break;
-                }
-              }
-              hash_[ipos].next = lastSlot_;
-              hash_[lastSlot_].index = index;
-              hash_[lastSlot_].next=-1;
-              break;
-            } else {
-              ipos = k;
-            }
-          }
-        } else {
-          // slot available
-          hash_[ipos].index = index;
-        }
-      }
-    }
+  int j1 = hash(row,column,triples);
+  if (j1==index) {
+    return; // duplicate??
+  } else if (j1>=0) {
+    printf ( "** duplicate entry %d %d\n", row, column );
+    abort();
   }
+  insert(index,key(row,column));
 }
 // Deletes from hash
 void 
 CoinModelHash2::deleteHash(int index,int row, int column)
 {
-  if (index<numberItems_) {
-    
-    int ipos = hashValue ( row, column );
-
-    while ( ipos>=0 ) {
-      int j1 = hash_[ipos].index;
-      if ( j1!=index) {
-        ipos = hash_[ipos].next;
-      } else {
-        hash_[ipos].index=-1; // available
+  if (index<numberItems_&&numberSlots_) {
+    const CoinUInt64 thisKey = key(row,column);
+    const int mask = numberSlots_-1;
+    int ipos = hashValue ( thisKey );
+    while ( hash_[ipos].index>=0 ) {
+      if (hash_[ipos].index==index) 
         break;
-      }
+      ipos = (ipos+1)&mask;
     }
-  }
-}
-namespace {
-  const int mmult2[] = {
-    262139, 259459, 256889, 254291, 251701, 249133, 246709, 244247,
-    241667, 239179, 236609, 233983, 231289, 228859, 226357, 223829
-  };
-}
-// Returns a hash value
-int 
-CoinModelHash2::hashValue(int row, int column) const
-{
-  
-  // Optimizer should take out one side of if
-  if (sizeof(int)==4*sizeof(char)) {
-    unsigned char tempChar[4];
-    
-    unsigned int n = 0;
-    int * temp = reinterpret_cast<int *> (tempChar);
-    *temp=row;
-    n += mmult2[0] * tempChar[0];
-    n += mmult2[1] * tempChar[1];
-    n += mmult2[2] * tempChar[2];
-    n += mmult[3] * tempChar[3];
-    *temp=column;
-    n += mmult2[0+8] * tempChar[0];
-    n += mmult2[1+8] * tempChar[1];
-    n += mmult2[2+8] * tempChar[2];
-    n += mmult2[3+8] * tempChar[3];
-    return n % (maximumItems_<<1);
-  } else {
-    // ints are 8
-    unsigned char tempChar[8];
-    
-    int n = 0;
-    unsigned int j;
-    int * temp = reinterpret_cast<int *> (tempChar);
-    *temp=row;
-    for ( j = 0; j < sizeof(int); ++j ) {
-      int itemp = tempChar[j];
-      n += mmult2[j] * itemp;
-    }
-    *temp=column;
-    for ( j = 0; j < sizeof(int); ++j ) {
-      int itemp = tempChar[j];
-      n += mmult2[j+8] * itemp;
+    if (hash_[ipos].index<0)
+      return;
+    // shift back later entries which may not be left past hole
+    int hole = ipos;
+    while ( true ) {
+      ipos = (ipos+1)&mask;
+      if (hash_[ipos].index<0)
+        break;
+      int home = hashValue(hash_[ipos].key);
+      bool stay = (hole<=ipos) ? (home>hole&&home<=ipos) :
+        (home>hole||home<=ipos);
+      if (!stay) {
+        hash_[hole] = hash_[ipos];
+        hole = ipos;
+      }
     }
-    int maxHash = 4 * maximumItems_;
-    int absN = abs(n);
-    int returnValue = absN % maxHash;
-    return returnValue;
+    hash_[hole].index = -1;
   }
 }
 //#############################################################################
@@ -838,6 +587,20 @@ CoinModelLinkedList::operator=(const CoinModelLinkedList& rhs)
   }
   return *this;
 }
+// Exchange contents (no copying)
+void 
+CoinModelLinkedList::swap(CoinModelLinkedList & rhs)
+{
+  std::swap(previous_,rhs.previous_);
+  std::swap(next_,rhs.next_);
+  std::swap(first_,rhs.first_);
+  std::swap(last_,rhs.last_);
+  std::swap(numberMajor_,rhs.numberMajor_);
+  std::swap(maximumMajor_,rhs.maximumMajor_);
+  std::swap(numberElements_,rhs.numberElements_);
+  std::swap(maximumElements_,rhs.maximumElements_);
+  std::swap(type_,rhs.type_);
+}
 // Resize list - for row list maxMajor is maximum rows
 void 
 CoinModelLinkedList::resize(int maxMajor,int maxElements)
@@ -17,6 +17,9 @@
 
 
 #include "CoinPragma.hpp"
+#include "CoinNameHash.hpp"
+
+class CoinArena;
 
 /**
    This is for various structures/classes needed by CoinModel.
@@ -125,10 +128,6 @@ inline void setRowAndStringInTriple(CoinModelTriple & triple,
 { triple.row = (string ? 0x80000000 : 0)|iRow;}
 /// for names and hashing
 // for hashing
-typedef struct {
-  int index, next;
-} CoinModelHashLink;
-
 /* Function type.  */
 typedef double (*func_t) (double);
 
@@ -194,6 +193,8 @@ public:
   CoinModelHash(const CoinModelHash&);
   /// =
   CoinModelHash& operator=(const CoinModelHash&);
+  /// Exchange contents (no copying)
+  void swap(CoinModelHash & rhs);
   //@}
 
   /**@name sizing (just increases) */
@@ -203,7 +204,8 @@ public:
   /// Number of items i.e. rows if just row names
   inline int numberItems() const
   { return numberItems_;}
-  /// Set number of items
+  /** Set number of items.  Names past number are forgotten (not freed)
+      as they are assumed to have been moved down with setName */
   void setNumberItems(int number);
   /// Maximum number of items
   inline int maximumItems() const
@@ -219,6 +221,9 @@ public:
   int hash(const char * name) const;
   /// Adds to hash
   void addHash(int index, const char * name);
+  /** Adds names of items 0 to number-1 in one go (hash must be empty,
+      NULL names are skipped) */
+  void addNames(int number, const char * const * names);
   /// Deletes from hash
   void deleteHash(int index);
   /// Returns name at position (or NULL)
@@ -230,26 +235,44 @@ public:
   /// Validates
   void validateHash() const;
 private:
-  /// Returns a hash value
-  int hashValue(const char * name) const;
+  /// Frees a name unless it is in arena
+  void freeName(char * name) const;
 public:
   //@}
+
+  /**@name Arena */
+  //@{
+  /** Names added from now on come from arena (not owned, may be NULL).
+      They are not freed individually so the arena must outlive them.
+      Copies of the hash do not use the arena. */
+  inline void setArena(CoinArena * arena)
+  { arena_ = arena;}
+  /// Arena for names (or NULL)
+  inline CoinArena * arena() const
+  { return arena_;}
+  //@}
 private:
   /**@name Data members */
   //@{
   /// Names
   char ** names_;
-  /// hash
-  CoinModelHashLink * hash_;
+  /// Index from names
+  CoinNameHash index_;
   /// Number of items 
   int numberItems_;
   /// Maximum number of items
   int maximumItems_;
-  /// Last slot looked at
-  int lastSlot_;
+  /// Arena for names (or NULL)
+  CoinArena * arena_;
   //@}
 };
-/// For int,int hashing
+/** For int,int hashing
+
+    Open addressing (linear probing) on 64 bit row and column keys which
+    are kept in the table, so probes do not touch the triples.  The table
+    has at least twice as many slots as maximumItems() and doubles by
+    moving its own keys.  Deleted entries are removed by backward shifting.
+*/
 class CoinModelHash2 {
   
 public:
@@ -267,6 +290,8 @@ public:
   CoinModelHash2(const CoinModelHash2&);
   /// =
   CoinModelHash2& operator=(const CoinModelHash2&);
+  /// Exchange contents (no copying)
+  void swap(CoinModelHash2 & rhs);
   //@}
 
   /**@name sizing (just increases) */
@@ -292,21 +317,39 @@ public:
   /// Deletes from hash
   void deleteHash(int index, int row, int column);
 private:
-  /// Returns a hash value
-  int hashValue(int row, int column) const;
+  /// Returns key for row and column
+  inline static CoinUInt64 key(int row, int column)
+  { return (static_cast<CoinUInt64>(static_cast<unsigned int>(row))<<32)|
+      static_cast<unsigned int>(column);}
+  /// Returns first slot to look at for key
+  inline int hashValue(CoinUInt64 key) const
+  { return static_cast<int>((key*0x9e3779b97f4a7c15ULL)>>shift_);}
+  /// Makes room for maxItems items keeping entries
+  void grow(int maxItems);
+  /// Enters key as index (no check for duplicates)
+  void insert(int index, CoinUInt64 key);
 public:
   //@}
 private:
   /**@name Data members */
   //@{
+  /// Slot of table
+  typedef struct {
+    /// Row in high and column in low half
+    CoinUInt64 key;
+    /// Index or -1 if empty
+    int index;
+  } CoinModelHash2Slot;
   /// hash
-  CoinModelHashLink * hash_;
+  CoinModelHash2Slot * hash_;
   /// Number of items 
   int numberItems_;
   /// Maximum number of items
   int maximumItems_;
-  /// Last slot looked at
-  int lastSlot_;
+  /// Number of slots (power of two)
+  int numberSlots_;
+  /// Shift to get slot from multiplied key
+  int shift_;
   //@}
 };
 class CoinModelLinkedList {
@@ -326,6 +369,8 @@ public:
   CoinModelLinkedList(const CoinModelLinkedList&);
   /// =
   CoinModelLinkedList& operator=(const CoinModelLinkedList&);
+  /// Exchange contents (no copying)
+  void swap(CoinModelLinkedList & rhs);
   //@}
 
   /**@name sizing (just increases) */
@@ -438,4 +483,103 @@ private:
   //@}
 };
 
+/// One instruction of a compiled string
+typedef struct {
+  /** 0 number, 1 associated value, 2 function,
+      3 add, 4 subtract, 5 multiply, 6 divide, 7 negate, 8 power */
+  int type;
+  /// Index of associated value or function
+  int index;
+  /// Number
+  double value;
+} CoinModelInstruction;
+/** Compiled strings of a CoinModel
+
+    Each string is parsed once into a postfix program whose variables are
+    indices into the associated values.  The value of each string is kept
+    together with the associated values it was computed from, so after
+    some values are changed (e.g. one parameter of a parametrized model)
+    only the strings using them are computed again.
+
+    Strings with names not yet known are parsed each time, as are all
+    strings if any of them assigns to a name.  Copies start empty as the
+    programs are rebuilt when first needed.
+*/
+class CoinModelExpressions {
+  
+public:
+  /**@name Constructors, destructor */
+  //@{
+  /** Default constructor. */
+  CoinModelExpressions();
+  /** Destructor */
+  ~CoinModelExpressions();
+  //@}
+  
+  /**@name Copy method */
+  //@{
+  /** The copy constructor (gives empty cache). */
+  CoinModelExpressions(const CoinModelExpressions&);
+  /// = (gives empty cache)
+  CoinModelExpressions& operator=(const CoinModelExpressions&);
+  /// Exchange contents including cache (no copying)
+  void swap(CoinModelExpressions & rhs);
+  //@}
+
+  /**@name does work */
+  //@{
+  /** Fills in associated[i] for each string i which has associated[i]
+      unset, using input (sizeInput long) as the values of names.
+      Returns number of strings which could not be computed */
+  int compute(const CoinModelHash & strings, const double * input,
+	      int sizeInput, double * associated, double unsetValue,
+	      int logLevel);
+  /// Forgets all programs and values
+  void clear();
+  /// Number of strings compiled
+  inline int numberStrings() const
+  { return numberStrings_;}
+  //@}
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Compiles strings from numberStrings_ on
+  void compile(const CoinModelHash & strings, double unsetValue);
+  /// Computes value of compiled string (returns false if unset)
+  bool evaluate(int which, const double * input, int sizeInput,
+		double unsetValue, double * stack, double & value) const;
+  //@}
+  /**@name Data members */
+  //@{
+  /// Number of strings compiled
+  int numberStrings_;
+  /// Space for strings
+  int maximumStrings_;
+  /// Start of program of each string in code_ (numberStrings_+1)
+  CoinBigIndex * start_;
+  /// 0 compiled, 1 syntax error, 2 must be parsed each time
+  char * status_;
+  /// Nonzero if value_ must be computed again
+  char * dirty_;
+  /// Value of each string when last computed
+  double * value_;
+  /// Associated value of each string when value_ computed
+  double * input_;
+  /// Start of strings using each string in use_ (numberStrings_+1)
+  int * useStart_;
+  /// Strings using each string
+  int * use_;
+  /// Instructions of all programs
+  CoinModelInstruction * code_;
+  /// Space for instructions
+  CoinBigIndex maximumCode_;
+  /// Longest program
+  int maximumLength_;
+  /// True if some string assigns to a name
+  bool assignment_;
+  //@}
+};
+
 #endif
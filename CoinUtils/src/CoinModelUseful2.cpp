@@ -909,6 +909,33 @@ static     int
      }
 
 
+/* Program being recorded while parsing (as reductions are in postfix
+   order each one just appends an instruction) */
+typedef struct {
+  CoinModelInstruction * code;
+  int number;
+  int maximum;
+  /// Name not in strings
+  bool unknown;
+  /// Name assigned to
+  bool assignment;
+} CoinYaccProgram;
+static void
+coinYaccRecord(CoinYaccProgram * program, int type, int index, double value)
+{
+  if (program->number==program->maximum) {
+    program->maximum = 2*program->maximum+10;
+    CoinModelInstruction * temp = new CoinModelInstruction [program->maximum];
+    CoinMemcpyN(program->code,program->number,temp);
+    delete [] program->code;
+    program->code = temp;
+  }
+  CoinModelInstruction & instruction = program->code[program->number++];
+  instruction.type=type;
+  instruction.index=index;
+  instruction.value=value;
+}
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -916,7 +943,8 @@ static     int
 static double yyparse ( symrec *& symtable, const char * line, char * & symbuf, int & length,
                         const double * associated, const CoinModelHash & string, int & error,
                         double unsetValue,
-                        int & yychar, YYSTYPE &yylval, int & yynerrs)
+                        int & yychar, YYSTYPE &yylval, int & yynerrs,
+                        CoinYaccProgram * program)
 {
   
   int position=0;
@@ -1179,42 +1207,72 @@ yyreduce:
 
   case 7:
     { yyval.val = yyvsp[0].val;                         ;}
+    if (program)
+      coinYaccRecord(program,0,0,yyvsp[0].val);
     break;
 
   case 8:
     { yyval.val = yyvsp[0].tptr->value.var;              ;}
+    if (program) {
+      int find = string.hash(yyvsp[0].tptr->name);
+      if (find<0)
+        program->unknown=true;
+      coinYaccRecord(program,1,find,0.0);
+    }
     break;
 
   case 9:
     { yyval.val = yyvsp[0].val; yyvsp[-2].tptr->value.var = yyvsp[0].val;     ;}
+    if (program)
+      program->assignment=true;
     break;
 
   case 10:
     { yyval.val = (*(yyvsp[-3].tptr->value.fnctptr))(yyvsp[-1].val); ;}
+    if (program) {
+      int k;
+      for (k=0;arith_fncts[k].fname;k++) {
+        if (arith_fncts[k].fnct==yyvsp[-3].tptr->value.fnctptr)
+          break;
+      }
+      coinYaccRecord(program,2,k,0.0);
+    }
     break;
 
   case 11:
     { yyval.val = yyvsp[-2].val + yyvsp[0].val;                    ;}
+    if (program)
+      coinYaccRecord(program,3,0,0.0);
     break;
 
   case 12:
     { yyval.val = yyvsp[-2].val - yyvsp[0].val;                    ;}
+    if (program)
+      coinYaccRecord(program,4,0,0.0);
     break;
 
   case 13:
     { yyval.val = yyvsp[-2].val * yyvsp[0].val;                    ;}
+    if (program)
+      coinYaccRecord(program,5,0,0.0);
     break;
 
   case 14:
     { yyval.val = yyvsp[-2].val / yyvsp[0].val;                    ;}
+    if (program)
+      coinYaccRecord(program,6,0,0.0);
     break;
 
   case 15:
     { yyval.val = -yyvsp[0].val;                        ;}
+    if (program)
+      coinYaccRecord(program,7,0,0.0);
     break;
 
   case 16:
     { yyval.val = pow (yyvsp[-2].val, yyvsp[0].val);               ;}
+    if (program)
+      coinYaccRecord(program,8,0,0.0);
     break;
 
   case 17:
@@ -1449,16 +1507,21 @@ yyreturn:
   return yyresult;
 }
 
-double
-CoinModel::getDoubleFromString(CoinYacc & info,const char * string)
+/* Parses string, returns value (unset if error) and error code
+   (1 names found but unset value, 2 syntax error, 3 name not found) */
+static double
+coinParseString(CoinYacc & info, const char * string,
+                const double * associated, const CoinModelHash & strings,
+                double unsetValue, int logLevel, int & error,
+                CoinYaccProgram * program)
 {
-  if (!info.length) {
-    info.symtable=NULL;
+  if (!info.symtable) {
     info.symbuf=NULL;
+    info.length=0;
     init_table ( info.symtable);
-    info.unsetValue=unsetValue();
+    info.unsetValue=unsetValue;
   }
-  int error=0;
+  error=0;
 
   // Here to make thread safe
   /* The lookahead symbol.  */
@@ -1471,22 +1534,29 @@ CoinModel::getDoubleFromString(CoinYacc & info,const char * string)
   int yynerrs;
 
   double value = yyparse ( info.symtable, string,info.symbuf,info.length,
-                           associated_,string_,error,info.unsetValue,
-                           yychar, yylval,  yynerrs);
+                           associated,strings,error,info.unsetValue,
+                           yychar, yylval,  yynerrs, program);
 
   if (error){
     // 1 means strings found but unset value
     // 2 syntax error
     // 3 string not found
-    if (logLevel_>=1)
+    if (logLevel>=1)
       printf("string %s returns value %g and error-code %d\n",
              string,value,error);
     value = info.unsetValue;
-  } else if (logLevel_>=2) {
+  } else if (logLevel>=2) {
     printf("%s computes as %g\n",string,value);
   }
   return value;
 }
+double
+CoinModel::getDoubleFromString(CoinYacc & info,const char * string)
+{
+  int error;
+  return coinParseString(info,string,associated_,string_,unsetValue(),
+                         logLevel_,error,NULL);
+}
 // Frees value memory
 void 
 CoinModel::freeStringMemory(CoinYacc & info)
@@ -1539,7 +1609,7 @@ getFunctionValueFromString(const char * string, const char * x, double xValue)
 
   double value = yyparse ( info.symtable, string,info.symbuf,info.length,
                            associated,stringX,error,info.unsetValue,
-                           yychar, yylval,  yynerrs);
+                           yychar, yylval,  yynerrs, NULL);
 
   int logLevel_=2;
   if (error){
@@ -1558,3 +1628,320 @@ getFunctionValueFromString(const char * string, const char * x, double xValue)
 }
 
 
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+//-------------------------------------------------------------------
+// Default Constructor 
+//-------------------------------------------------------------------
+CoinModelExpressions::CoinModelExpressions () 
+  : numberStrings_(0),
+    maximumStrings_(0),
+    start_(NULL),
+    status_(NULL),
+    dirty_(NULL),
+    value_(NULL),
+    input_(NULL),
+    useStart_(NULL),
+    use_(NULL),
+    code_(NULL),
+    maximumCode_(0),
+    maximumLength_(0),
+    assignment_(false)
+{
+}
+
+//-------------------------------------------------------------------
+// Copy constructor 
+//-------------------------------------------------------------------
+CoinModelExpressions::CoinModelExpressions (const CoinModelExpressions &) 
+  : numberStrings_(0),
+    maximumStrings_(0),
+    start_(NULL),
+    status_(NULL),
+    dirty_(NULL),
+    value_(NULL),
+    input_(NULL),
+    useStart_(NULL),
+    use_(NULL),
+    code_(NULL),
+    maximumCode_(0),
+    maximumLength_(0),
+    assignment_(false)
+{
+}
+
+//-------------------------------------------------------------------
+// Destructor 
+//-------------------------------------------------------------------
+CoinModelExpressions::~CoinModelExpressions ()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator 
+//-------------------------------------------------------------------
+CoinModelExpressions &
+CoinModelExpressions::operator=(const CoinModelExpressions& rhs)
+{
+  if (this != &rhs) 
+    clear();
+  return *this;
+}
+// Exchange contents including cache (no copying)
+void
+CoinModelExpressions::swap(CoinModelExpressions & rhs)
+{
+  std::swap(numberStrings_,rhs.numberStrings_);
+  std::swap(maximumStrings_,rhs.maximumStrings_);
+  std::swap(start_,rhs.start_);
+  std::swap(status_,rhs.status_);
+  std::swap(dirty_,rhs.dirty_);
+  std::swap(value_,rhs.value_);
+  std::swap(input_,rhs.input_);
+  std::swap(useStart_,rhs.useStart_);
+  std::swap(use_,rhs.use_);
+  std::swap(code_,rhs.code_);
+  std::swap(maximumCode_,rhs.maximumCode_);
+  std::swap(maximumLength_,rhs.maximumLength_);
+  std::swap(assignment_,rhs.assignment_);
+}
+// Frees all arrays
+void
+CoinModelExpressions::gutsOfDelete()
+{
+  delete [] start_;
+  delete [] status_;
+  delete [] dirty_;
+  delete [] value_;
+  delete [] input_;
+  delete [] useStart_;
+  delete [] use_;
+  delete [] code_;
+  start_=NULL;
+  status_=NULL;
+  dirty_=NULL;
+  value_=NULL;
+  input_=NULL;
+  useStart_=NULL;
+  use_=NULL;
+  code_=NULL;
+  maximumStrings_=0;
+  maximumCode_=0;
+}
+// Forgets all programs and values
+void
+CoinModelExpressions::clear()
+{
+  gutsOfDelete();
+  numberStrings_=0;
+  maximumLength_=0;
+  assignment_=false;
+}
+// Compiles strings from numberStrings_ on
+void
+CoinModelExpressions::compile(const CoinModelHash & strings, double unsetValue)
+{
+  int numberStrings = strings.numberItems();
+  if (numberStrings>maximumStrings_) {
+    int newSize = CoinMax(numberStrings,2*maximumStrings_);
+    CoinBigIndex * start = new CoinBigIndex [newSize+1];
+    if (start_)
+      CoinMemcpyN(start_,numberStrings_+1,start);
+    else
+      start[0]=0;
+    delete [] start_;
+    start_ = start;
+    char * temp = CoinCopyOfArrayPartial(status_,newSize,numberStrings_);
+    delete [] status_;
+    status_ = temp;
+    temp = CoinCopyOfArrayPartial(dirty_,newSize,numberStrings_);
+    delete [] dirty_;
+    dirty_ = temp;
+    double * temp2 = CoinCopyOfArrayPartial(value_,newSize,numberStrings_);
+    delete [] value_;
+    value_ = temp2;
+    temp2 = CoinCopyOfArrayPartial(input_,newSize,numberStrings_);
+    delete [] input_;
+    input_ = temp2;
+    maximumStrings_=newSize;
+  }
+  CoinYacc info;
+  CoinYaccProgram program;
+  program.code=NULL;
+  program.maximum=0;
+  // all names are known so values are not needed
+  double * dummy = new double [numberStrings];
+  CoinFillN(dummy,numberStrings,0.0);
+  for (int i=numberStrings_;i<numberStrings;i++) {
+    const char * string = strings.name(i);
+    program.number=0;
+    program.unknown=false;
+    program.assignment=false;
+    int error=0;
+    if (string)
+      coinParseString(info,string,dummy,strings,unsetValue,0,error,&program);
+    else
+      error=2;
+    if (program.assignment)
+      assignment_=true;
+    if (error==3||program.unknown||program.assignment) {
+      status_[i]=2;
+      program.number=0;
+    } else if (error) {
+      status_[i]=1;
+      program.number=0;
+    } else {
+      status_[i]=0;
+    }
+    CoinBigIndex start = start_[i];
+    if (start+program.number>maximumCode_) {
+      maximumCode_ = CoinMax(start+program.number,2*maximumCode_+100);
+      CoinModelInstruction * temp = new CoinModelInstruction [maximumCode_];
+      CoinMemcpyN(code_,start,temp);
+      delete [] code_;
+      code_ = temp;
+    }
+    CoinMemcpyN(program.code,program.number,code_+start);
+    start_[i+1]=start+program.number;
+    maximumLength_ = CoinMax(maximumLength_,program.number);
+    dirty_[i]=1;
+    value_[i]=unsetValue;
+    input_[i]=unsetValue;
+  }
+  delete [] program.code;
+  delete [] dummy;
+  numberStrings_=numberStrings;
+  // strings using each string
+  delete [] useStart_;
+  delete [] use_;
+  useStart_ = new int [numberStrings_+1];
+  CoinZeroN(useStart_,numberStrings_+1);
+  for (int i=0;i<numberStrings_;i++) {
+    for (CoinBigIndex j=start_[i];j<start_[i+1];j++) {
+      if (code_[j].type==1)
+        useStart_[code_[j].index+1]++;
+    }
+  }
+  for (int i=0;i<numberStrings_;i++)
+    useStart_[i+1] += useStart_[i];
+  use_ = new int [useStart_[numberStrings_]+1];
+  int * put = new int [numberStrings_];
+  CoinMemcpyN(useStart_,numberStrings_,put);
+  for (int i=0;i<numberStrings_;i++) {
+    for (CoinBigIndex j=start_[i];j<start_[i+1];j++) {
+      if (code_[j].type==1)
+        use_[put[code_[j].index]++]=i;
+    }
+  }
+  delete [] put;
+}
+// Computes value of compiled string (returns false if unset)
+bool
+CoinModelExpressions::evaluate(int which, const double * input, int sizeInput,
+                               double unsetValue, double * stack,
+                               double & value) const
+{
+  value = unsetValue;
+  if (status_[which])
+    return false;
+  int n=0;
+  for (CoinBigIndex j=start_[which];j<start_[which+1];j++) {
+    const CoinModelInstruction & instruction = code_[j];
+    switch (instruction.type) {
+    case 0:
+      stack[n++]=instruction.value;
+      break;
+    case 1:
+      if (instruction.index>=sizeInput||
+          input[instruction.index]==unsetValue)
+        return false;
+      stack[n++]=input[instruction.index];
+      break;
+    case 2:
+      stack[n-1] = arith_fncts[instruction.index].fnct(stack[n-1]);
+      break;
+    case 3:
+      n--;
+      stack[n-1] += stack[n];
+      break;
+    case 4:
+      n--;
+      stack[n-1] -= stack[n];
+      break;
+    case 5:
+      n--;
+      stack[n-1] *= stack[n];
+      break;
+    case 6:
+      n--;
+      stack[n-1] /= stack[n];
+      break;
+    case 7:
+      stack[n-1] = -stack[n-1];
+      break;
+    case 8:
+      n--;
+      stack[n-1] = pow(stack[n-1],stack[n]);
+      break;
+    }
+  }
+  assert (n==1);
+  value = stack[0];
+  return true;
+}
+/* Fills in associated[i] for each string i which has associated[i]
+   unset - returns number of errors */
+int
+CoinModelExpressions::compute(const CoinModelHash & strings,
+                              const double * input, int sizeInput,
+                              double * associated, double unsetValue,
+                              int logLevel)
+{
+  int numberStrings = strings.numberItems();
+  if (numberStrings<numberStrings_)
+    clear();
+  if (numberStrings>numberStrings_)
+    compile(strings,unsetValue);
+  // strings using changed values must be computed again
+  for (int i=0;i<numberStrings_;i++) {
+    double value = (i<sizeInput) ? input[i] : unsetValue;
+    if (value!=input_[i]) {
+      input_[i]=value;
+      for (int j=useStart_[i];j<useStart_[i+1];j++)
+        dirty_[use_[j]]=1;
+    }
+  }
+  CoinYacc info;
+  double * stack = new double [maximumLength_+1];
+  int numberErrors=0;
+  for (int i=0;i<numberStrings_;i++) {
+    const char * string = strings.name(i);
+    if (string&&associated[i]==unsetValue) {
+      double value;
+      if (assignment_||status_[i]==2) {
+        int error;
+        value = coinParseString(info,string,input,strings,unsetValue,
+                                logLevel,error,NULL);
+      } else {
+        if (dirty_[i]) {
+          if (!evaluate(i,input,sizeInput,unsetValue,stack,value_[i])) {
+            if (logLevel>=1)
+              printf("string %s can not be computed\n",string);
+          } else if (logLevel>=2) {
+            printf("%s computes as %g\n",string,value_[i]);
+          }
+          dirty_[i]=0;
+        }
+        value = value_[i];
+      }
+      associated[i] = value;
+      if (value==unsetValue)
+        numberErrors++;
+    }
+  }
+  delete [] stack;
+  return numberErrors;
+}
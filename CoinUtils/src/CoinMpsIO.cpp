@@ -14,6 +14,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <cfloat>
+#include <limits>
 #include <string>
 #include <cstdio>
 #include <iostream>
@@ -22,23 +23,20 @@
 #include "CoinMessage.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinModel.hpp"
+#include "CoinNameHash.hpp"
+#include "CoinQuadraticMatrix.hpp"
 #include "CoinSort.hpp"
+#include "CoinNumberIO.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "CoinInstrument.hpp"
+#include "CoinThreadPool.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 
 //#############################################################################
 // type - 0 normal, 1 INTEL IEEE, 2 other IEEE
 
-namespace {
-
-  const double fraction[]=
-  {1.0,1.0e-1,1.0e-2,1.0e-3,1.0e-4,1.0e-5,1.0e-6,1.0e-7,1.0e-8,
-   1.0e-9,1.0e-10,1.0e-11,1.0e-12,1.0e-13,1.0e-14,1.0e-15,1.0e-16,
-   1.0e-17,1.0e-18,1.0e-19,1.0e-20,1.0e-21,1.0e-22,1.0e-23};
-
-  const double exponent[]=
-  {1.0e-9,1.0e-8,1.0e-7,1.0e-6,1.0e-5,1.0e-4,1.0e-3,1.0e-2,1.0e-1,
-   1.0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,1.0e6,1.0e7,1.0e8,1.0e9};
-
-} // end file-local namespace
 double CoinMpsCardReader::osi_strtod(char * ptr, char ** output, int type) 
 {
 
@@ -60,79 +58,16 @@ double CoinMpsCardReader::osi_strtod(char * ptr, char ** output, int type)
     // more white space
     while (*ptr==' '||*ptr=='\t')
       ptr++;
-    char thisChar=0;
-    while (value<1.0e30) {
-      thisChar = *ptr;
-      ptr++;
-      if (thisChar>='0'&&thisChar<='9') 
-	value = value*10.0+thisChar-'0';
-      else
-	break;
-    }
-    if (value<1.0e30) {
-      if (thisChar=='.') {
-	// do fraction
-	double value2 = 0.0;
-	int nfrac=0;
-	while (nfrac<24) {
-	  thisChar = *ptr;
-	  ptr++;
-	  if (thisChar>='0'&&thisChar<='9') {
-	    value2 = value2*10.0+thisChar-'0';
-	    nfrac++;
-	  } else {
-	    break;
-	  }
-	}
-	if (nfrac<24) {
-	  value += value2*fraction[nfrac];
-	} else {
-	  thisChar='x'; // force error
-	}
-      }
-      if (thisChar=='e'||thisChar=='E') {
-	// exponent
-	int sign2=1;
-	// do + or -
-	if (*ptr=='-') {
-	  sign2=-1;
-	  ptr++;
-	} else if (*ptr=='+') {
-	  ptr++;
-	}
-	int value3 = 0;
-	while (value3<1000) {
-	  thisChar = *ptr;
-	  ptr++;
-	  if (thisChar>='0'&&thisChar<='9') {
-	    value3 = value3*10+thisChar-'0';
-	  } else {
-	    break;
-	  }
-	}
-	if (value3<300) {
-	  value3 *= sign2; // power of 10
-	  if (abs(value3)<10) {
-	    // do most common by lookup (for accuracy?)
-	    value *= exponent[value3+9];
-	  } else {
-	    value *= pow(10.0,value3);
-	  }
-	} else if (sign2<0.0) {
-	  value = 0.0; // force zero
-	} else {
-	  value = COIN_DBL_MAX;
-	}
-      } 
-      if (thisChar==0||thisChar=='\t'||thisChar==' ') {
-	// okay
-	*output=ptr;
-      } else {
-	value = osi_strtod(save,output);
-	sign1=1.0;
-      }
+    char * after = ptr;
+    if ((*ptr>='0'&&*ptr<='9')||*ptr=='.')
+      value = CoinStrtod(ptr,&after);
+    char thisChar = *after;
+    if (after>ptr&&(thisChar==0||thisChar=='\t'||thisChar==' ')) {
+      // okay
+      if (value>COIN_DBL_MAX)
+	value = COIN_DBL_MAX;
+      *output=after;
     } else {
-      // bad value
       value = osi_strtod(save,output);
       sign1=1.0;
     }
@@ -274,16 +209,139 @@ const static char *mpsTypes[] = {
   "X1", "X2", "BS", "XL", "XU", "LL", "UL", "  "
 };
 
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define COIN_MPS_SIMD
+#endif
+#ifdef COIN_MPS_SIMD
+/* Cards are classified sixteen bytes at a time.  Loads are aligned so
+   never go into another page, but may read a little before start or
+   past end of card - those bits are masked off (and address sanitizer
+   told not to look) */
+#if defined(__clang__) || __GNUC__ >= 5
+#define COIN_MPS_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define COIN_MPS_NO_SANITIZE
+#endif
+// One bit per byte of block
+typedef struct {
+  // space or tab
+  int blank;
+  int tab;
+  // control characters other than tab (so end of card)
+  int control;
+  int zero;
+} CoinCardMasks;
+COIN_MPS_NO_SANITIZE static inline void
+coinCardMasks(const char * block, CoinCardMasks & masks)
+{
+  __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i *>(block));
+  __m128i tab = _mm_cmpeq_epi8(bytes,_mm_set1_epi8('\t'));
+  __m128i space = _mm_cmpeq_epi8(bytes,_mm_set1_epi8(' '));
+  // unsigned bytes below space
+  __m128i low = 
+    _mm_cmpeq_epi8(_mm_min_epu8(bytes,_mm_set1_epi8(0x1f)),bytes);
+  masks.tab = _mm_movemask_epi8(tab);
+  masks.blank = masks.tab|_mm_movemask_epi8(space);
+  masks.control = _mm_movemask_epi8(low)&~masks.tab;
+  masks.zero = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes,_mm_setzero_si128()));
+}
+/* End of card (first control character other than tab) with last non
+   blank before it and whether there were tabs */
+COIN_MPS_NO_SANITIZE static char *
+coinScanCard(char * card, char * & lastNonBlank, bool & tabs)
+{
+  int offset = static_cast<int>(reinterpret_cast<size_t>(card)&15);
+  const char * block = card - offset;
+  // bytes of first block which are in card
+  int valid = (0xffff<<offset)&0xffff;
+  lastNonBlank = card-1;
+  tabs = false;
+  CoinCardMasks masks;
+  while (true) {
+    coinCardMasks(block,masks);
+    int end = masks.control&valid;
+    int inCard = end ? valid&((end&-end)-1) : valid;
+    if ((masks.tab&inCard)!=0)
+      tabs = true;
+    int nonBlank = ~masks.blank&inCard;
+    if (nonBlank)
+      lastNonBlank = const_cast<char *>(block) + 31 - __builtin_clz(nonBlank);
+    if (end)
+      return const_cast<char *>(block) + __builtin_ctz(end);
+    block += 16;
+    valid = 0xffff;
+  }
+}
+// First blank or end of string at or after image
+COIN_MPS_NO_SANITIZE static char *
+coinNextBlankOrZero(char * image)
+{
+  int offset = static_cast<int>(reinterpret_cast<size_t>(image)&15);
+  const char * block = image - offset;
+  int valid = (0xffff<<offset)&0xffff;
+  CoinCardMasks masks;
+  while (true) {
+    coinCardMasks(block,masks);
+    int found = (masks.blank|masks.zero)&valid;
+    if (found)
+      return const_cast<char *>(block) + __builtin_ctz(found);
+    block += 16;
+    valid = 0xffff;
+  }
+}
+// First character at or after image which is not blank
+COIN_MPS_NO_SANITIZE static char *
+coinSkipBlanks(char * image)
+{
+  int offset = static_cast<int>(reinterpret_cast<size_t>(image)&15);
+  const char * block = image - offset;
+  int valid = (0xffff<<offset)&0xffff;
+  CoinCardMasks masks;
+  while (true) {
+    coinCardMasks(block,masks);
+    int found = ~masks.blank&valid;
+    if (found)
+      return const_cast<char *>(block) + __builtin_ctz(found);
+    block += 16;
+    valid = 0xffff;
+  }
+}
+#else
+// First character at or after image which is not blank
+static char *
+coinSkipBlanks(char * image)
+{
+  while ( *image == ' ' || *image == '\t' )
+    image++;
+  return image;
+}
+#endif
+// As coinSkipBlanks but not past end
+static inline char *
+coinSkipBlanks(char * image, char * end)
+{
+  char * next = coinSkipBlanks(image);
+  return next<end ? next : end;
+}
+
 int CoinMpsCardReader::cleanCard()
 {
   char * getit;
-  getit = input_->gets ( card_, MAX_CARD_LENGTH);
+  getit = input_->getsInPlace ( cardBuffer_, MAX_CARD_LENGTH);
 
   if ( getit ) {
+    card_ = getit;
     cardNumber_++;
+    bool tabs=false;
+#ifdef COIN_MPS_SIMD
+    char * lastNonBlankChar;
+    coinScanCard(card_,lastNonBlankChar,tabs);
+    unsigned char * lastNonBlank = 
+      reinterpret_cast<unsigned char *> (lastNonBlankChar);
+#else
     unsigned char * lastNonBlank = reinterpret_cast<unsigned char *> (card_-1);
     unsigned char * image = reinterpret_cast<unsigned char *> (card_);
-    bool tabs=false;
     while ( *image != '\0' ) {
       if ( *image != '\t' && *image < ' ' ) {
 	break;
@@ -294,7 +352,18 @@ int CoinMpsCardReader::cleanCard()
       }
       image++;
     }
+#endif
     *(lastNonBlank+1)='\0';
+    if (card_!=cardBuffer_) {
+      /* Short cards (fixed format code may look a few characters past end)
+	 and ones with tabs are worked on in buffer */
+      int length = static_cast<int>(lastNonBlank+1-
+				    reinterpret_cast<unsigned char *>(card_));
+      if (length<16||tabs) {
+	memcpy(cardBuffer_,card_,length+1);
+	card_ = cardBuffer_;
+      }
+    }
     if (tabs&&section_ == COIN_BOUNDS_SECTION&&!freeFormat_&&eightChar_) {
       int length = static_cast<int>(lastNonBlank+1-
       				    reinterpret_cast<unsigned char *>(card_));
@@ -330,6 +399,11 @@ char *
 CoinMpsCardReader::nextBlankOr ( char *image )
 {
   char * saveImage=image;
+#ifdef COIN_MPS_SIMD
+  image = coinNextBlankOrZero(image);
+  if ( *image == '\0' )
+    return NULL;
+#else
   while ( 1 ) {
     if ( *image == ' ' || *image == '\t' ) {
       break;
@@ -338,11 +412,10 @@ CoinMpsCardReader::nextBlankOr ( char *image )
       return NULL;
     image++;
   }
+#endif
   // Allow for floating - or +.  Will fail if user has that as row name!!
   if (image-saveImage==1&&(*saveImage=='+'||*saveImage=='-')) {
-    while ( *image == ' ' || *image == '\t' ) {
-      image++;
-    }
+    image=coinSkipBlanks(image);
     image=nextBlankOr(image);
   }
   return image;
@@ -425,28 +498,45 @@ CoinMpsCardReader::readToNextSection (  )
       break;
     } else if ( card_[0] != '*' && card_[0] != '#' ) {
       // not a comment
-      int i;
+      sectionFromCard();
+      break;
+    }
+  }
+  return section_;
+}
 
-      handler_->message(COIN_MPS_LINE,messages_)<<cardNumber_
-					       <<card_<<CoinMessageEol;
-      for ( i = COIN_ROW_SECTION; i < COIN_UNKNOWN_SECTION; i++ ) {
-	if ( !strncmp ( card_, section[i], strlen ( section[i] ) ) ) {
-	  break;
-	}
-      }
-      position_ = card_;
-      eol_ = card_;
-      section_ = static_cast< COINSectionType > (i);
+// Sets section from current card
+COINSectionType
+CoinMpsCardReader::sectionFromCard (  )
+{
+  int i;
+
+  handler_->message(COIN_MPS_LINE,messages_)<<cardNumber_
+					   <<card_<<CoinMessageEol;
+  for ( i = COIN_ROW_SECTION; i < COIN_UNKNOWN_SECTION; i++ ) {
+    if ( !strncmp ( card_, section[i], strlen ( section[i] ) ) ) {
       break;
     }
   }
+  // QMATRIX is QUADOBJ with both halves of matrix (flag kept after
+  // section so can be looked at when at ENDATA)
+  if (i == COIN_QUAD_SECTION) {
+    fullQuadratic_ = false;
+  } else if (i == COIN_UNKNOWN_SECTION && !strncmp ( card_, "QMATRIX", 7 ) ) {
+    i = COIN_QUAD_SECTION;
+    fullQuadratic_ = true;
+  }
+  position_ = card_;
+  eol_ = card_;
+  section_ = static_cast<COINSectionType> (i);
   return section_;
 }
 
 CoinMpsCardReader::CoinMpsCardReader (  CoinFileInput *input, 
 					CoinMpsIO * reader)
 {
-  memset ( card_, 0, MAX_CARD_LENGTH );
+  memset ( cardBuffer_, 0, MAX_CARD_LENGTH );
+  card_ = cardBuffer_;
   position_ = card_;
   eol_ = card_;
   mpsType_ = COIN_UNKNOWN_MPS_TYPE;
@@ -464,6 +554,7 @@ CoinMpsCardReader::CoinMpsCardReader (  CoinFileInput *input,
   messages_ = reader_->messages();
   memset ( valueString_, 0, COIN_MAX_FIELD_LENGTH );
   stringsAllowed_=false;
+  fullQuadratic_=false;
 }
 //  ~CoinMpsCardReader.  Destructor
 CoinMpsCardReader::~CoinMpsCardReader (  )
@@ -496,13 +587,7 @@ CoinMpsCardReader::nextField (  )
   // find next non blank character
   char *next = position_;
 
-  while ( next != eol_ ) {
-    if ( *next == ' ' || *next == '\t' ) {
-      next++;
-    } else {
-      break;
-    }
-  }
+  next = coinSkipBlanks ( next, eol_ );
   bool gotCard;
 
   if ( next == eol_ ) {
@@ -523,13 +608,7 @@ CoinMpsCardReader::nextField (  )
       // get mps type and column name
       // scan to first non blank
       next = card_;
-      while ( next != eol_ ) {
-	if ( *next == ' ' || *next == '\t' ) {
-	  next++;
-	} else {
-	  break;
-	}
-      }
+      next = coinSkipBlanks ( next, eol_ );
       if ( next != eol_ ) {
 	char *nextBlank = nextBlankOr ( next );
 	int nchar;
@@ -569,13 +648,7 @@ CoinMpsCardReader::nextField (  )
 	    if ( mpsType_ != COIN_BLANK_COLUMN ) {
 	      //we know all we need so we can skip over
 	      next = nextBlank;
-	      while ( next != eol_ ) {
-		if ( *next == ' ' || *next == '\t' ) {
-		  next++;
-		} else {
-		  break;
-		}
-	      }
+	      next = coinSkipBlanks ( next, eol_ );
 	      if ( next == eol_ ) {
 		// error
 		position_ = eol_;
@@ -590,13 +663,7 @@ CoinMpsCardReader::nextField (  )
                 mpsType_ = COIN_S3_COLUMN;
                 //we know all we need so we can skip over
                 next = nextBlank;
-                while ( next != eol_ ) {
-                  if ( *next == ' ' || *next == '\t' ) {
-                    next++;
-                  } else {
-                    break;
-                  }
-                }
+                next = coinSkipBlanks ( next, eol_ );
                 if ( next == eol_ ) {
                   // error
                   position_ = eol_;
@@ -645,13 +712,7 @@ CoinMpsCardReader::nextField (  )
 	      // blank bounds name
 	      strcpy ( columnName_, "        " );
 	    }
-	    while ( next != eol_ ) {
-	      if ( *next == ' ' || *next == '\t' ) {
-		next++;
-	      } else {
-		break;
-	      }
-	    }
+	    next = coinSkipBlanks ( next, eol_ );
 	    if ( next == eol_ ) {
 	      // error unless row section or conic section
 	      position_ = eol_;
@@ -694,13 +755,7 @@ CoinMpsCardReader::nextField (  )
 	      } else {
 		next = eol_;
 	      }
-	      while ( next != eol_ ) {
-		if ( *next == ' ' || *next == '\t' ) {
-		  next++;
-		} else {
-		  break;
-		}
-	      }
+	      next = coinSkipBlanks ( next, eol_ );
 	      // special coding for markers
 	      if ( section_ == COIN_COLUMN_SECTION &&
 		   !strncmp ( rowName_, "'MARKER'", 8 ) && next != eol_ ) {
@@ -785,13 +840,7 @@ CoinMpsCardReader::nextField (  )
 	  } else {
 	    next = eol_;
 	  }
-	  while ( next != eol_ ) {
-	    if ( *next == ' ' || *next == '\t' ) {
-	      next++;
-	    } else {
-	      break;
-	    }
-	  }
+	  next = coinSkipBlanks ( next, eol_ );
 	  if ( next == eol_ ) {
 	    // error 
 	    position_ = eol_;
@@ -829,19 +878,7 @@ CoinMpsCardReader::nextField (  )
       return section_;
     } else if ( card_[0] != '*' ) {
       // not a comment
-      int i;
-
-      handler_->message(COIN_MPS_LINE,messages_)<<cardNumber_
-					       <<card_<<CoinMessageEol;
-      for ( i = COIN_ROW_SECTION; i < COIN_UNKNOWN_SECTION; i++ ) {
-	if ( !strncmp ( card_, section[i], strlen ( section[i] ) ) ) {
-	  break;
-	}
-      }
-      position_ = card_;
-      eol_ = card_;
-      section_ = static_cast<COINSectionType> (i);
-      return section_;
+      return sectionFromCard();
     } else {
       // comment
     }
@@ -877,13 +914,7 @@ CoinMpsCardReader::nextField (  )
     } else {
       next = eol_;
     }
-    while ( next != eol_ ) {
-      if ( *next == ' ' || *next == '\t' ) {
-	next++;
-      } else {
-	break;
-      }
-    }
+    next = coinSkipBlanks ( next, eol_ );
     if ( next == eol_ && section_ != COIN_SOS_SECTION) {
       // error
       position_ = eol_;
@@ -1184,35 +1215,6 @@ CoinMpsCardReader::nextGmsField ( int expectedType )
 
 //#############################################################################
 
-namespace {
-const int mmult[] = {
-    262139, 259459, 256889, 254291, 251701, 249133, 246709, 244247,
-    241667, 239179, 236609, 233983, 231289, 228859, 226357, 223829,
-    221281, 218849, 216319, 213721, 211093, 208673, 206263, 203773,
-    201233, 198637, 196159, 193603, 191161, 188701, 186149, 183761,
-    181303, 178873, 176389, 173897, 171469, 169049, 166471, 163871,
-    161387, 158941, 156437, 153949, 151531, 149159, 146749, 144299,
-    141709, 139369, 136889, 134591, 132169, 129641, 127343, 124853,
-    122477, 120163, 117757, 115361, 112979, 110567, 108179, 105727,
-    103387, 101021, 98639, 96179, 93911, 91583, 89317, 86939, 84521,
-    82183, 79939, 77587, 75307, 72959, 70793, 68447, 66103
-  };
-
-int hash ( const char *name, int maxsiz, int length )
-{
-  
-  int n = 0;
-  int j;
-
-  for ( j = 0; j < length; ++j ) {
-    int iname = name[j];
-
-    n += mmult[j] * iname;
-  }
-  return ( abs ( n ) % maxsiz );	/* integer abs */
-}
-} // end file-local namespace
-
 // Define below if you are reading a Cnnnnnn file 
 // Will not do row names (for electricfence)
 //#define NONAMES
@@ -1230,91 +1232,28 @@ CoinMpsIO::startHash ( int section ) const
 {
   char ** names = names_[section];
   COINColumnIndex number = numberHash_[section];
-  COINColumnIndex i;
-  COINColumnIndex maxhash = 4 * number;
-  COINColumnIndex ipos, iput;
-
-  //hash_=(CoinHashLink *) malloc(maxhash*sizeof(CoinHashLink));
-  hash_[section] = new CoinHashLink[maxhash];
-  
-  CoinHashLink * hashThis = hash_[section];
-
-  for ( i = 0; i < maxhash; i++ ) {
-    hashThis[i].index = -1;
-    hashThis[i].next = -1;
-  }
 
+  hash_[section] = new CoinNameHash();
+  CoinNameHash * hashThis = hash_[section];
   /*
-   * Initialize the hash table.  Only the index of the first name that
-   * hashes to a value is entered in the table; subsequent names that
-   * collide with it are not entered.
+   * Enter all names at once.  Only the first of any duplicate names is
+   * entered so findHash returns that one.
    */
-  for ( i = 0; i < number; ++i ) {
-    char *thisName = names[i];
-    int length = static_cast<int>(strlen(thisName));
-
-    ipos = hash ( thisName, maxhash, length );
-    if ( hashThis[ipos].index == -1 ) {
-      hashThis[ipos].index = i;
-    }
-  }
-
-  /*
-   * Now take care of the names that collided in the preceding loop,
-   * by finding some other entry in the table for them.
-   * Since there are as many entries in the table as there are names,
-   * there must be room for them.
-   */
-  iput = -1;
-  for ( i = 0; i < number; ++i ) {
-    char *thisName = names[i];
-    int length = static_cast<int>(strlen(thisName));
-
-    ipos = hash ( thisName, maxhash, length );
-
-    while ( 1 ) {
-      COINColumnIndex j1 = hashThis[ipos].index;
-
-      if ( j1 == i )
-	break;
-      else {
-	char *thisName2 = names[j1];
-
-	if ( strcmp ( thisName, thisName2 ) == 0 ) {
-	  printf ( "** duplicate name %s\n", names[i] );
-	  break;
-	} else {
-	  COINColumnIndex k = hashThis[ipos].next;
-
-	  if ( k == -1 ) {
-	    while ( 1 ) {
-	      ++iput;
-	      if ( iput > number ) {
-		printf ( "** too many names\n" );
-		break;
-	      }
-	      if ( hashThis[iput].index == -1 ) {
-		break;
-	      }
-	    }
-	    hashThis[ipos].next = iput;
-	    hashThis[iput].index = i;
-	    break;
-	  } else {
-	    ipos = k;
-	    /* nothing worked - try it again */
-	  }
-	}
-      }
+  int * existing = new int [CoinMax(number,1)];
+  if ( hashThis->add ( number, names, 0, existing ) ) {
+    for ( COINColumnIndex i = 0; i < number; ++i ) {
+      if ( existing[i] >= 0 )
+	printf ( "** duplicate name %s\n", names[i] );
     }
   }
+  delete [] existing;
 }
 
 //  stopHash.  Deletes hash storage
 void
 CoinMpsIO::stopHash ( int section )
 {
-  delete [] hash_[section];
+  delete hash_[section];
   hash_[section] = NULL;
 }
 
@@ -1322,42 +1261,20 @@ CoinMpsIO::stopHash ( int section )
 COINColumnIndex
 CoinMpsIO::findHash ( const char *name , int section ) const
 {
-  COINColumnIndex found = -1;
-
-  char ** names = names_[section];
-  CoinHashLink * hashThis = hash_[section];
-  COINColumnIndex maxhash = 4 * numberHash_[section];
-  COINColumnIndex ipos;
-
   /* default if we don't find anything */
-  if ( !maxhash )
+  if ( !hash_[section] )
     return -1;
-  int length = static_cast<int>(strlen(name));
-
-  ipos = hash ( name, maxhash, length );
-  while ( 1 ) {
-    COINColumnIndex j1 = hashThis[ipos].index;
-
-    if ( j1 >= 0 ) {
-      char *thisName2 = names[j1];
-
-      if ( strcmp ( name, thisName2 ) != 0 ) {
-	COINColumnIndex k = hashThis[ipos].next;
+  return hash_[section]->find ( name );
+}
 
-	if ( k != -1 )
-	  ipos = k;
-	else
-	  break;
-      } else {
-	found = j1;
-	break;
-      }
-    } else {
-      found = -1;
-      break;
-    }
-  }
-  return found;
+void
+CoinMpsIO::findHash ( int number, const char * const * names, int * indices,
+		      int section ) const
+{
+  if ( hash_[section] )
+    hash_[section]->find ( number, names, indices );
+  else
+    CoinFillN ( indices, number, -1 );
 }
 #else
 // Version when we know images are C/Rnnnnnn
@@ -1388,6 +1305,14 @@ CoinMpsIO::findHash ( const char *name , int section ) const
     found = numberHash_[section]-1;
   return found;
 }
+
+void
+CoinMpsIO::findHash ( int number, const char * const * names, int * indices,
+		      int section ) const
+{
+  for (int i=0;i<number;i++)
+    indices[i] = findHash ( names[i], section );
+}
 #endif
 //------------------------------------------------------------------
 // Get value for infinity
@@ -1421,6 +1346,37 @@ const char * CoinMpsIO::getFileName() const
 {
   return fileName_;
 }
+// Name of file - filename with .extension unless it has one (or stdin)
+static void
+mpsFileName(const char * filename, const char * extension, char * newName)
+{
+  if (strcmp(filename,"stdin")&&strcmp(filename,"-")) {
+    if (extension&&strlen(extension)) {
+      // There was an extension - but see if user gave .xxx
+      int i = static_cast<int>(strlen(filename))-1;
+      strcpy(newName,filename);
+      bool foundDot=false; 
+      for (;i>=0;i--) {
+	char character = filename[i];
+	if (character=='/'||character=='\\') {
+	  break;
+	} else if (character=='.') {
+	  foundDot=true;
+	  break;
+	}
+      }
+      if (!foundDot) {
+	strcat(newName,".");
+	strcat(newName,extension);
+      }
+    } else {
+      // no extension
+      strcpy(newName,filename);
+    }
+  } else {
+    strcpy(newName,"stdin");    
+  }
+}
 // Deal with filename - +1 if new, 0 if same as before, -1 if error
 int
 CoinMpsIO::dealWithFileName(const char * filename,  const char * extension,
@@ -1433,7 +1389,7 @@ CoinMpsIO::dealWithFileName(const char * filename,  const char * extension,
 
   int goodFile=0;
 
-  if (!fileName_||(filename!=NULL&&strcmp(filename,fileName_))) {
+  if (!fileName_||!cardReader_||(filename!=NULL&&strcmp(filename,fileName_))) {
     if (filename==NULL) {
       handler_->message(COIN_MPS_FILE,messages_)<<"NULL"
 						<<CoinMessageEol;
@@ -1442,34 +1398,9 @@ CoinMpsIO::dealWithFileName(const char * filename,  const char * extension,
     goodFile=-1;
     // looks new name
     char newName[400];
-    if (strcmp(filename,"stdin")&&strcmp(filename,"-")) {
-      if (extension&&strlen(extension)) {
-	// There was an extension - but see if user gave .xxx
-	int i = static_cast<int>(strlen(filename))-1;
-	strcpy(newName,filename);
-	bool foundDot=false; 
-	for (;i>=0;i--) {
-	  char character = filename[i];
-	  if (character=='/'||character=='\\') {
-	    break;
-	  } else if (character=='.') {
-	    foundDot=true;
-	    break;
-	  }
-	}
-	if (!foundDot) {
-	  strcat(newName,".");
-	  strcat(newName,extension);
-	}
-      } else {
-	// no extension
-	strcpy(newName,filename);
-      }
-    } else {
-      strcpy(newName,"stdin");    
-    }
-    // See if new name
-    if (fileName_&&!strcmp(newName,fileName_)) {
+    mpsFileName(filename,extension,newName);
+    // See if new name (a copied model has no file open)
+    if (fileName_&&cardReader_&&!strcmp(newName,fileName_)) {
       // old name
       return 0;
     } else {
@@ -1485,7 +1416,7 @@ CoinMpsIO::dealWithFileName(const char * filename,  const char * extension,
 	  goodFile = -1;
 	else
 	  {
-	    input = CoinFileInput::create (fname);
+	    input = CoinFileInput::create (fname, numberThreads_);
 	    goodFile = 1;
 	  }
       } else {
@@ -1531,11 +1462,29 @@ int CoinMpsIO::getDefaultBound() const
 {
   return defaultBound_;
 }
+// Sets number of threads for COLUMNS section
+void CoinMpsIO::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value,1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
 //------------------------------------------------------------------
 // Read mps files
 //------------------------------------------------------------------
 int CoinMpsIO::readMps(const char * filename,  const char * extension)
 {
+  if (modelCache_&&!callback_&&filename&&
+      (!extension||(strcmp(extension,"gms")&&!strstr(filename,".gms")))) {
+    Coin::SmartPtr<CoinCachedModel> model = viewMps(filename,extension);
+    if (model.IsValid()) {
+      copyModel(*model->mps());
+      return model->returnCode();
+    }
+  }
   // Deal with filename - +1 if new, 0 if same as before, -1 if error
 
   CoinFileInput *input = 0;
@@ -1572,6 +1521,103 @@ int CoinMpsIO::readMps(const char * filename,  const char * extension,
   }
   return readMps(numberSets,sets);
 }
+int CoinMpsIO::readMps(const char * filename,  const char * extension,
+		       CoinMpsCallback & callback)
+{
+  callback_ = &callback;
+  int returnCode;
+  try {
+    returnCode = readMps(filename,extension);
+  } catch (...) {
+    callback_ = NULL;
+    throw;
+  }
+  callback_ = NULL;
+  if (returnCode<0||returnCode>=100000)
+    return returnCode;
+  if (extension&&(!strcmp(extension,"gms")||strstr(filename,".gms"))) {
+    // GAMS reader keeps matrix so pass on now
+    callback.rows(numberRows_,names_[0]);
+    const CoinPackedMatrix * matrix = getMatrixByCol();
+    const int * row = matrix->getIndices();
+    const double * element = matrix->getElements();
+    const CoinBigIndex * start = matrix->getVectorStarts();
+    const int * length = matrix->getVectorLengths();
+    for (int i=0;i<numberColumns_;i++)
+      callback.column(i,columnName(i),objective_[i],length[i],
+		      row+start[i],element+start[i],isInteger(i));
+  }
+  for (int i=0;i<numberRows_;i++)
+    callback.rowBounds(i,rowlower_[i],rowupper_[i]);
+  for (int i=0;i<numberColumns_;i++)
+    callback.columnBounds(i,collower_[i],colupper_[i],isInteger(i));
+  return returnCode;
+}
+// Cached model of file (read into cache if not there)
+Coin::SmartPtr<CoinCachedModel>
+CoinMpsIO::viewMps(const char * filename,  const char * extension) const
+{
+  Coin::SmartPtr<CoinCachedModel> model;
+  if (!modelCache_||!filename)
+    return model;
+  char newName[400];
+  mpsFileName(filename,extension,newName);
+  // everything which changes what is read
+  char settings[200];
+  sprintf(settings,"mps %.17g %.17g %d %d %d %d",infinity_,smallElement_,
+	  defaultBound_,keepNames_,allowStringElements_,
+	  convertObjective_ ? 1 : 0);
+  std::string key = CoinModelCache::key(newName,settings);
+  if (key.empty())
+    return model;
+  model = modelCache_->find(key);
+  if (model.IsValid())
+    return model;
+  CoinMpsIO * reader = new CoinMpsIO();
+  reader->defaultBound_ = defaultBound_;
+  reader->infinity_ = infinity_;
+  reader->smallElement_ = smallElement_;
+  reader->numberThreads_ = numberThreads_;
+  reader->keepNames_ = keepNames_;
+  reader->convertObjective_ = convertObjective_;
+  reader->allowStringElements_ = allowStringElements_;
+  // messages go to our handler while reading
+  delete reader->handler_;
+  reader->handler_ = handler_;
+  reader->defaultHandler_ = false;
+  reader->messages_ = messages_;
+  int returnCode;
+  try {
+    returnCode = reader->readMps(newName,"");
+  } catch (...) {
+    reader->handler_ = NULL;
+    delete reader;
+    throw;
+  }
+  reader->handler_ = new CoinMessageHandler();
+  reader->defaultHandler_ = true;
+  delete reader->cardReader_;
+  reader->cardReader_ = NULL;
+  model = new CoinCachedModel(reader,returnCode);
+  // keep if good and file not changed while reading
+  if (!returnCode&&CoinModelCache::key(newName,settings)==key)
+    modelCache_->insert(key,model.GetRawPtr());
+  return model;
+}
+// Copy of another model
+void CoinMpsIO::copyModel(const CoinMpsIO & rhs)
+{
+  if (this==&rhs)
+    return;
+  bool defaultHandler = defaultHandler_;
+  int numberThreads = numberThreads_;
+  freeAll();
+  delete cardReader_;
+  cardReader_ = NULL;
+  gutsOfCopy(rhs);
+  defaultHandler_ = defaultHandler;
+  numberThreads_ = numberThreads;
+}
 int CoinMpsIO::readMps()
 {
   int numberSets=0;
@@ -1582,8 +1628,368 @@ int CoinMpsIO::readMps()
   delete [] sets;
   return returnCode;
 }
+//#############################################################################
+/* Parsing of COLUMNS section.  With one thread fields come straight from
+   the card reader.  With more, cards are read in batches (only copied, not
+   tokenized), each batch is split into one chunk per thread and every chunk
+   is tokenized - and row names looked up in the (read only) row hash - by
+   its own card reader.  Fields are then handed back in order so readMps
+   sees exactly the same sequence and gives the same messages.
+*/
+namespace {
+  // Input which hands out cards already in memory
+  class CoinMpsChunkInput : public CoinFileInput {
+  public:
+    CoinMpsChunkInput(char * text, const int * cardStart, int numberCards)
+      : CoinFileInput(""), text_(text), cardStart_(cardStart),
+	numberCards_(numberCards), next_(0) {}
+    virtual int read(void *, int)
+    { return 0;}
+    virtual char * gets(char * buffer, int size) {
+      char * card = getsInPlace(buffer,size);
+      if (card) {
+	strncpy(buffer,card,size-1);
+	buffer[size-1]='\0';
+	card = buffer;
+      }
+      return card;
+    }
+    virtual char * getsInPlace(char *, int) {
+      if (next_==numberCards_)
+	return NULL;
+      return text_ + cardStart_[next_++];
+    }
+  private:
+    char * text_;
+    const int * cardStart_;
+    int numberCards_;
+    int next_;
+  };
+  // One field as found by a worker
+  typedef struct {
+    double value;
+    COINMpsType type;
+    // -1 not found, -2 not looked up (tiny)
+    int row;
+    // card within batch
+    int card;
+    // offsets in names of chunk (row name only kept if not found)
+    int columnName;
+    int rowName;
+  } CoinMpsColumnField;
+  // Cards and fields for one thread
+  typedef struct {
+    CoinMpsColumnField * field;
+    char * names;
+    int numberFields;
+    int maximumFields;
+    int sizeNames;
+    int maximumNames;
+    int firstCard;
+    int lastCard;
+    bool eightCharIn;
+    bool eightCharOut;
+  } CoinMpsColumnChunk;
+}
+
+class CoinMpsColumnReader {
+public:
+  CoinMpsColumnReader(CoinMpsIO * model, CoinMpsCardReader * cardReader,
+		      char ** rowName, int numberThreads);
+  ~CoinMpsColumnReader();
+  /// As CoinMpsCardReader::nextField
+  COINSectionType nextField();
+  inline COINMpsType mpsType() const
+  { return field_ ? field_->type : cardReader_->mpsType();}
+  inline double value() const
+  { return field_ ? field_->value : cardReader_->value();}
+  inline const char * valueString() const
+  { return cardReader_->valueString();}
+  inline const char * columnName() const
+  { return field_ ? chunk_[whichChunk_].names + field_->columnName :
+      cardReader_->columnName();}
+  const char * rowName() const;
+  /// Row number (from hash) of current field
+  inline int row() const
+  { return field_ ? field_->row : model_->findHash(cardReader_->rowName(),0);}
+  inline CoinBigIndex cardNumber() const
+  { return field_ ? firstCardNumber_ + field_->card : cardReader_->cardNumber();}
+  inline const char * card() const
+  { return field_ ? text_ + cardStart_[field_->card] : cardReader_->card();}
+  /// Tokenizes one chunk
+  void parseChunk(int iChunk);
+private:
+  /// Reads next batch of cards and parses them
+  void readBatch();
+  /// Adds name to chunk and returns offset
+  int addName(CoinMpsColumnChunk & chunk, const char * name);
+
+  CoinMpsIO * model_;
+  CoinMpsCardReader * cardReader_;
+  char ** rowName_;
+  int numberThreads_;
+  // current field (NULL if serial)
+  CoinMpsColumnField * field_;
+  CoinMpsColumnChunk * chunk_;
+  int whichChunk_;
+  int whichField_;
+  // cards of batch
+  char * text_;
+  int * cardStart_;
+  int numberCards_;
+  int sizeText_;
+  int maximumText_;
+  CoinBigIndex firstCardNumber_;
+  // section after COLUMNS (COIN_COLUMN_SECTION while still going)
+  COINSectionType section_;
+};
+
+// Number of cards in a batch for each thread
+#define COIN_MPS_BATCH 65536
+
+CoinMpsColumnReader::CoinMpsColumnReader(CoinMpsIO * model,
+					 CoinMpsCardReader * cardReader,
+					 char ** rowName, int numberThreads)
+  : model_(model),
+    cardReader_(cardReader),
+    rowName_(rowName),
+    numberThreads_(numberThreads),
+    field_(NULL),
+    chunk_(NULL),
+    whichChunk_(0),
+    whichField_(0),
+    text_(NULL),
+    cardStart_(NULL),
+    numberCards_(0),
+    sizeText_(0),
+    maximumText_(0),
+    firstCardNumber_(0),
+    section_(COIN_COLUMN_SECTION)
+{
+  // strings need the card reader's copy so do serially
+  if (model->allowStringElements())
+    numberThreads_ = 1;
+  if (numberThreads_>1) {
+    chunk_ = new CoinMpsColumnChunk [numberThreads_];
+    memset(chunk_,0,numberThreads_*sizeof(CoinMpsColumnChunk));
+    cardStart_ = new int [numberThreads_*COIN_MPS_BATCH];
+    whichChunk_ = numberThreads_;
+  }
+}
+
+CoinMpsColumnReader::~CoinMpsColumnReader()
+{
+  if (chunk_) {
+    for (int i=0;i<numberThreads_;i++) {
+      free(chunk_[i].field);
+      free(chunk_[i].names);
+    }
+    delete [] chunk_;
+  }
+  free(text_);
+  delete [] cardStart_;
+}
+
+const char *
+CoinMpsColumnReader::rowName() const
+{
+  if (!field_)
+    return cardReader_->rowName();
+  else if (field_->rowName>=0)
+    return chunk_[whichChunk_].names + field_->rowName;
+  else if (field_->row>=0&&rowName_[field_->row])
+    return rowName_[field_->row];
+  else
+    return "";
+}
+
+int
+CoinMpsColumnReader::addName(CoinMpsColumnChunk & chunk, const char * name)
+{
+  int length = static_cast<int>(strlen(name))+1;
+  if (chunk.sizeNames+length>chunk.maximumNames) {
+    chunk.maximumNames = 2*chunk.maximumNames + length + 1000;
+    chunk.names = reinterpret_cast<char *>
+      (realloc(chunk.names,chunk.maximumNames));
+  }
+  int put = chunk.sizeNames;
+  memcpy(chunk.names+put,name,length);
+  chunk.sizeNames += length;
+  return put;
+}
+
+void
+CoinMpsColumnReader::parseChunk(int iChunk)
+{
+  CoinMpsColumnChunk & chunk = chunk_[iChunk];
+  chunk.numberFields = 0;
+  chunk.sizeNames = 0;
+  CoinMpsCardReader reader(new CoinMpsChunkInput(text_,
+						 cardStart_+chunk.firstCard,
+						 chunk.lastCard-chunk.firstCard),
+			   model_);
+  reader.setWhichSection(COIN_COLUMN_SECTION);
+  reader.setFreeFormat(cardReader_->freeFormat());
+  reader.setIeeeFormat(cardReader_->ieeeFormat());
+  reader.setEightChar(chunk.eightCharIn);
+  double smallElement = model_->getSmallElementValue();
+  int lastName = -1;
+  while (reader.nextField()==COIN_COLUMN_SECTION) {
+    if (chunk.numberFields==chunk.maximumFields) {
+      chunk.maximumFields = 2*chunk.maximumFields + 1000;
+      chunk.field = reinterpret_cast<CoinMpsColumnField *>
+	(realloc(chunk.field,chunk.maximumFields*sizeof(CoinMpsColumnField)));
+    }
+    CoinMpsColumnField & field = chunk.field[chunk.numberFields++];
+    field.type = reader.mpsType();
+    field.value = reader.value();
+    field.card = chunk.firstCard + reader.cardNumber() - 1;
+    field.row = -2;
+    field.columnName = 0;
+    field.rowName = -1;
+    if (field.type==COIN_BLANK_COLUMN) {
+      const char * name = reader.columnName();
+      if (lastName<0||strcmp(chunk.names+lastName,name))
+	lastName = addName(chunk,name);
+      field.columnName = lastName;
+      if (fabs(field.value)>smallElement) {
+	field.row = model_->findHash(reader.rowName(),0);
+	if (field.row<0)
+	  field.rowName = addName(chunk,reader.rowName());
+      }
+    }
+  }
+  if (!chunk.sizeNames)
+    addName(chunk,"");
+  chunk.eightCharOut = reader.eightChar();
+}
+
+// Work for one thread
+typedef struct {
+  CoinMpsColumnReader * reader;
+  int iChunk;
+} CoinMpsColumnThread;
+
+static void *
+coinMpsColumnWorker(void * info)
+{
+  CoinMpsColumnThread * thread = reinterpret_cast<CoinMpsColumnThread *>(info);
+  thread->reader->parseChunk(thread->iChunk);
+  return NULL;
+}
+
+void
+CoinMpsColumnReader::readBatch()
+{
+  numberCards_ = 0;
+  sizeText_ = 0;
+  firstCardNumber_ = cardReader_->cardNumber()+1;
+  int maximumCards = numberThreads_*COIN_MPS_BATCH;
+  // just copy cards (comments as well so card numbers stay right)
+  while (numberCards_<maximumCards) {
+    if (cardReader_->cleanCard()) {
+      section_ = COIN_EOF_SECTION;
+      break;
+    }
+    const char * card = cardReader_->card();
+    if (card[0]!=' '&&card[0]!='\0'&&card[0]!='*') {
+      section_ = cardReader_->sectionFromCard();
+      break;
+    }
+    int length = static_cast<int>(strlen(card))+1;
+    if (sizeText_+length>maximumText_) {
+      maximumText_ = 2*maximumText_ + MAX_CARD_LENGTH;
+      text_ = reinterpret_cast<char *> (realloc(text_,maximumText_));
+    }
+    memcpy(text_+sizeText_,card,length);
+    cardStart_[numberCards_++] = sizeText_;
+    sizeText_ += length;
+  }
+  // split so each thread gets about same number of characters
+  int numberChunks = 0;
+  int iCard = 0;
+  for (int i=0;i<numberThreads_;i++) {
+    CoinMpsColumnChunk & chunk = chunk_[i];
+    chunk.firstCard = iCard;
+    if (i<numberThreads_-1) {
+      int target = static_cast<int>((static_cast<double>(sizeText_)*(i+1))
+				    /numberThreads_);
+      while (iCard<numberCards_&&cardStart_[iCard]<target)
+	iCard++;
+    } else {
+      iCard = numberCards_;
+    }
+    chunk.lastCard = iCard;
+    chunk.eightCharIn = cardReader_->eightChar();
+    chunk.numberFields = 0;
+    if (chunk.lastCard>chunk.firstCard)
+      numberChunks = i+1;
+  }
+  CoinMpsColumnThread * thread = new CoinMpsColumnThread [numberThreads_];
+  for (int i=0;i<numberChunks;i++) {
+    thread[i].reader = this;
+    thread[i].iChunk = i;
+  }
+  CoinThreadPool::run(coinMpsColumnWorker,thread,sizeof(CoinMpsColumnThread),
+		      numberChunks);
+  delete [] thread;
+  /* A chunk may have found a long name - then later chunks have to be
+     done again as serial code would have done them */
+  bool eightChar = cardReader_->eightChar();
+  for (int i=0;i<numberChunks;i++) {
+    if (chunk_[i].eightCharIn!=eightChar) {
+      chunk_[i].eightCharIn = eightChar;
+      parseChunk(i);
+    }
+    eightChar = chunk_[i].eightCharOut;
+  }
+  cardReader_->setEightChar(eightChar);
+  whichChunk_ = 0;
+  whichField_ = -1;
+}
+
+COINSectionType
+CoinMpsColumnReader::nextField()
+{
+  if (numberThreads_<=1)
+    return cardReader_->nextField();
+  field_ = NULL;
+  while (true) {
+    if (whichChunk_<numberThreads_) {
+      CoinMpsColumnChunk & chunk = chunk_[whichChunk_];
+      if (++whichField_<chunk.numberFields) {
+	field_ = chunk.field + whichField_;
+	return COIN_COLUMN_SECTION;
+      }
+      whichChunk_++;
+      whichField_ = -1;
+    } else if (section_==COIN_COLUMN_SECTION) {
+      readBatch();
+    } else {
+      return section_;
+    }
+  }
+}
+
+/* Index of name if default name (first then at least 7 digits, as
+   written by "%c%7.7d") within number, otherwise -1 */
+static int
+defaultNameIndex(const char * name, char first, int number)
+{
+  int length = static_cast<int>(strlen(name));
+  if (name[0]!=first||length<8||length>11||(length>8&&name[1]=='0'))
+    return -1;
+  CoinInt64 n=0;
+  for (int j=1;j<length;j++) {
+    if (name[j]<'0'||name[j]>'9')
+      return -1;
+    n = 10*n + (name[j]-'0');
+  }
+  return n<number ? static_cast<int>(n) : -1;
+}
 int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 {
+  COIN_TIME_SCOPE("mps.read");
   bool ifmps;
 
   cardReader_->readToNextSection();
@@ -1619,6 +2025,8 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
   COINRowIndex *row;
   double *element;
   objectiveOffset_ = 0.0;
+  // elements passed to callback_
+  CoinBigIndex numberPassed = 0;
 
   int numberErrors = 0;
   int i;
@@ -1759,6 +2167,8 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 #endif
 
     startHash ( rowName, numberRows_ + 1 + numberOtherFreeRows , 0 );
+    if (callback_)
+      callback_->rows(numberRows_,rowName);
     COINColumnIndex maxColumns = 1000 + numberRows_ / 5;
     CoinBigIndex maxElements = 5000 + numberRows_ / 2;
     COINMpsType *columnType = reinterpret_cast<COINMpsType *>
@@ -1788,10 +2198,11 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
     bool inIntegerSet = false;
     COINColumnIndex numberIntegers = 0;
 
-    while ( cardReader_->nextField (  ) == COIN_COLUMN_SECTION ) {
-      switch ( cardReader_->mpsType (  ) ) {
+    CoinMpsColumnReader columnReader(this,cardReader_,rowName,numberThreads_);
+    while ( columnReader.nextField (  ) == COIN_COLUMN_SECTION ) {
+      switch ( columnReader.mpsType (  ) ) {
       case COIN_BLANK_COLUMN:
-	if ( strcmp ( lastColumn, cardReader_->columnName (  ) ) ) {
+	if ( strcmp ( lastColumn, columnReader.columnName (  ) ) ) {
 	  // new column
 
 	  // reset old column and take out tiny
@@ -1810,6 +2221,14 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	      rowUsed[irow] = -1;
 	    }
 	    //numberElements_ = k;
+	    if (callback_) {
+	      // pass on and forget elements
+	      callback_->column(column,columnName[column],objective_[column],
+				numberElements_-k,row+k,element+k,
+				columnType[column]==COIN_INTORG);
+	      numberPassed += numberElements_-k;
+	      numberElements_ = k;
+	    }
 	  }
 	  column = numberColumns_;
 	  if ( numberColumns_ == maxColumns ) {
@@ -1832,28 +2251,37 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	    numberIntegers++;
 	  }
 #ifndef NONAMES
-	  columnName[column] = CoinStrdup ( cardReader_->columnName (  ) );
+	  columnName[column] = CoinStrdup ( columnReader.columnName (  ) );
 #else
           columnName[column]=NULL;
 #endif
-	  strcpy ( lastColumn, cardReader_->columnName (  ) );
+	  strcpy ( lastColumn, columnReader.columnName (  ) );
 	  objective_[column] = 0.0;
 	  start[column] = numberElements_;
 	  numberColumns_++;
 	}
-	if ( fabs ( cardReader_->value (  ) ) > smallElement_ ) {
+	if ( fabs ( columnReader.value (  ) ) > smallElement_ ) {
 	  if ( numberElements_ == maxElements ) {
-	    maxElements = ( 3 * maxElements ) / 2 + 1000;
+	    // grow in 64 bits so CoinBigIndex can not wrap
+	    const CoinBigIndex64 limit =
+	      std::numeric_limits<CoinBigIndex>::max();
+	    if ( maxElements == limit )
+	      throw CoinError("too many elements for CoinBigIndex - "
+			      "read with CoinPackedMatrix64::readMps",
+			      "readMps","CoinMpsIO");
+	    maxElements = static_cast<CoinBigIndex>
+	      (CoinMin(( 3 * static_cast<CoinBigIndex64>(maxElements) ) / 2
+		       + 1000, limit));
 	    row = reinterpret_cast<COINRowIndex *>
 	      (realloc ( row, maxElements * sizeof ( COINRowIndex )));
 	    element = reinterpret_cast<double *>
 	      (realloc ( element, maxElements * sizeof ( double )));
 	  }
 	  // get row number
-	  COINRowIndex irow = findHash ( cardReader_->rowName (  ) , 0 );
+	  COINRowIndex irow = columnReader.row (  );
 
 	  if ( irow >= 0 ) {
-	    double value = cardReader_->value (  );
+	    double value = columnReader.value (  );
 
 	    // check for duplicates
 	    if ( irow == numberRows_ ) {
@@ -1862,7 +2290,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 		numberErrors++;
 		if ( numberErrors < 100 ) {
 		  handler_->message(COIN_MPS_DUPOBJ,messages_)
-		    <<cardReader_->cardNumber()<<cardReader_->card()
+		    <<columnReader.cardNumber()<<columnReader.card()
 		    <<CoinMessageEol;
 		} else if (numberErrors > 100000) {
 		  handler_->message(COIN_MPS_RETURNING,messages_)
@@ -1883,8 +2311,8 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 		numberErrors++;
 		if ( numberErrors < 100 ) {
 		  handler_->message(COIN_MPS_DUPROW,messages_)
-		    <<cardReader_->rowName()<<cardReader_->cardNumber()
-		    <<cardReader_->card()
+		    <<columnReader.rowName()<<columnReader.cardNumber()
+		    <<columnReader.card()
 		    <<CoinMessageEol;
 		} else if (numberErrors > 100000) {
 		  handler_->message(COIN_MPS_RETURNING,messages_)
@@ -1902,19 +2330,19 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	    numberErrors++;
 	    if ( numberErrors < 100 ) {
 		  handler_->message(COIN_MPS_NOMATCHROW,messages_)
-		    <<cardReader_->rowName()<<cardReader_->cardNumber()<<cardReader_->card()
+		    <<columnReader.rowName()<<columnReader.cardNumber()<<columnReader.card()
 		    <<CoinMessageEol;
 	    } else if (numberErrors > 100000) {
 	      handler_->message(COIN_MPS_RETURNING,messages_)<<CoinMessageEol;
 	      return numberErrors;
 	    }
 	  }
-	} else if (cardReader_->value () == STRING_VALUE ) {
+	} else if (columnReader.value () == STRING_VALUE ) {
 	  // tiny element - string
-	  const char * s = cardReader_->valueString();
+	  const char * s = columnReader.valueString();
 	  assert (*s=='=');
 	  // get row number
-	  COINRowIndex irow = findHash ( cardReader_->rowName (  ) , 0 );
+	  COINRowIndex irow = columnReader.row (  );
 
 	  if ( irow >= 0 ) {
 	    addString(irow,column,s+1);
@@ -1922,7 +2350,7 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	    numberErrors++;
 	    if ( numberErrors < 100 ) {
 		  handler_->message(COIN_MPS_NOMATCHROW,messages_)
-		    <<cardReader_->rowName()<<cardReader_->cardNumber()<<cardReader_->card()
+		    <<columnReader.rowName()<<columnReader.cardNumber()<<columnReader.card()
 		    <<CoinMessageEol;
 	    } else if (numberErrors > 100000) {
 	      handler_->message(COIN_MPS_RETURNING,messages_)<<CoinMessageEol;
@@ -1947,8 +2375,8 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
       default:
 	numberErrors++;
 	if ( numberErrors < 100 ) {
-	  handler_->message(COIN_MPS_BADIMAGE,messages_)<<cardReader_->cardNumber()
-						       <<cardReader_->card()
+	  handler_->message(COIN_MPS_BADIMAGE,messages_)<<columnReader.cardNumber()
+						       <<columnReader.card()
 						       <<CoinMessageEol;
 	} else if (numberErrors > 100000) {
 	  handler_->message(COIN_MPS_RETURNING,messages_)<<CoinMessageEol;
@@ -1956,6 +2384,14 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	}
       }
     }
+    if (callback_&&numberColumns_) {
+      CoinBigIndex k = start[column];
+      callback_->column(column,columnName[column],objective_[column],
+			numberElements_-k,row+k,element+k,
+			columnType[column]==COIN_INTORG);
+      numberPassed += numberElements_-k;
+      numberElements_ = k;
+    }
     start[numberColumns_] = numberElements_;
     delete[]rowUsed;
     if ( cardReader_->whichSection (  ) != COIN_RHS_SECTION ) {
@@ -2741,6 +3177,14 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
 	numberElements_++;
       }
       start[i + 1] = numberElements_;
+      if (callback_) {
+	// no names in this format
+	callback_->column(i,NULL,objective_[i],numberElements_-start[i],
+			  row+start[i],element+start[i],false);
+	numberPassed += numberElements_-start[i];
+	numberElements_ = start[i];
+	start[i + 1] = numberElements_;
+      }
     }
   }
   // construct packed matrix
@@ -2755,8 +3199,23 @@ int CoinMpsIO::readMps(int & numberSets,CoinSet ** &sets)
   handler_->message(COIN_MPS_STATS,messages_)<<problemName_
 					    <<numberRows_
 					    <<numberColumns_
-					    <<numberElements_
+					    <<numberElements_+numberPassed
 					    <<CoinMessageEol;
+  // drop names not wanted
+  if (keepNames_) {
+    bool dropRows = true;
+    bool dropColumns = true;
+    if (keepNames_==1) {
+      for (i=0;i<numberRows_&&dropRows&&names_[0];i++)
+	dropRows = defaultNameIndex(names_[0][i],'R',numberRows_)==i;
+      for (i=0;i<numberColumns_&&dropColumns&&names_[1];i++)
+	dropColumns = defaultNameIndex(names_[1][i],'C',numberColumns_)==i;
+    }
+    if (dropRows)
+      releaseRowNames();
+    if (dropColumns)
+      releaseColumnNames();
+  }
   return numberErrors;
 }
 #ifdef COIN_HAS_GLPK
@@ -3522,6 +3981,47 @@ int CoinMpsIO::readGms(int & /*numberSets*/,CoinSet ** &/*sets*/)
            numberTiny,smallElement_,numberLarge,largeElement);
   return numberErrors;
 }
+// Number of basis cards whose names are looked up together
+#define COIN_BASIS_BATCH 1024
+/* Sets status (as CoinWarmStartBasis but one per char) and solution
+   value for one basis card - nothing if column not found */
+static void
+setBasisStatus(COINMpsType type, int iColumn, int iRow, double value,
+	       double * solution, unsigned char * rowStatus,
+	       unsigned char * columnStatus)
+{
+  // below matches CoinWarmStartBasis,
+  const unsigned char basic = 0x01;
+  const unsigned char atLowerBound = 0x03;
+  const unsigned char atUpperBound = 0x02;
+  if (iColumn<0)
+    return;
+  if (solution && value>-1.0e50)
+    solution[iColumn]=value;
+  switch ( type ) {
+  case COIN_BS_BASIS:
+    columnStatus[iColumn]=  basic;
+    break;
+  case COIN_XL_BASIS:
+    columnStatus[iColumn]= basic;
+    if ( iRow >= 0 )
+      rowStatus[iRow] = atLowerBound;
+    break;
+  case COIN_XU_BASIS:
+    columnStatus[iColumn]= basic;
+    if ( iRow >= 0 )
+      rowStatus[iRow] = atUpperBound;
+    break;
+  case COIN_LL_BASIS:
+    columnStatus[iColumn]= atLowerBound;
+    break;
+  case COIN_UL_BASIS:
+    columnStatus[iColumn]= atUpperBound;
+    break;
+  default:
+    break;
+  }
+}
 /* Read a basis in MPS format from the given filename.
    If VALUES on NAME card and solution not NULL fills in solution
    status values as for CoinWarmStartBasis (but one per char)
@@ -3596,75 +4096,64 @@ CoinMpsIO::readBasis(const char *filename, const char *extension ,
   }
   cardReader_->setWhichSection(COIN_BASIS_SECTION);
   cardReader_->setFreeFormat(true);
-  // below matches CoinWarmStartBasis,
-  const unsigned char basic = 0x01;
-  const unsigned char atLowerBound = 0x03;
-  const unsigned char atUpperBound = 0x02;
-  while ( cardReader_->nextField (  ) == COIN_BASIS_SECTION ) {
-    // Get type and column number
-    int iColumn;
-    if (gotNames) {
-      iColumn = findHash (cardReader_->columnName(),1);
-    } else {
+  // With names cards are saved and names looked up a batch at a time
+  int numberBatch = 0;
+  COINMpsType batchType[COIN_BASIS_BATCH];
+  double batchValue[COIN_BASIS_BATCH];
+  std::string batchName[2][COIN_BASIS_BATCH];
+  const char * names[COIN_BASIS_BATCH];
+  int found[2][COIN_BASIS_BATCH];
+  bool more = true;
+  while (more) {
+    more = cardReader_->nextField (  ) == COIN_BASIS_SECTION;
+    if (more && !gotNames) {
       // few checks 
+      int iColumn;
       char check;
       sscanf(cardReader_->columnName(),"%c%d",&check,&iColumn);
       assert (check=='C'&&iColumn>=0);
       if (iColumn>=numberColumns_)
 	iColumn=-1;
-    }
-    if (iColumn>=0) {
-      double value = cardReader_->value (  );
-      if (solution && value>-1.0e50)
-	solution[iColumn]=value;
       int iRow=-1;
-      switch ( cardReader_->mpsType (  ) ) {
-      case COIN_BS_BASIS:
-	columnStatus[iColumn]=  basic;
-	break;
-      case COIN_XL_BASIS:
-	columnStatus[iColumn]= basic;
-	// get row number
-	if (gotNames) {
-	  iRow = findHash (cardReader_->rowName(),0);
-	} else {
-	  // few checks 
-	  char check;
-	  sscanf(cardReader_->rowName(),"%c%d",&check,&iRow);
-	  assert (check=='R'&&iRow>=0);
-	  if (iRow>=numberRows_)
-	    iRow=-1;
-	}
-	if ( iRow >= 0 ) {
-	  rowStatus[iRow] = atLowerBound;
-	}
-	break;
-      case COIN_XU_BASIS:
-	columnStatus[iColumn]= basic;
-	// get row number
-	if (gotNames) {
-	  iRow = findHash (cardReader_->rowName(),0);
-	} else {
-	  // few checks 
-	  char check;
-	  sscanf(cardReader_->rowName(),"%c%d",&check,&iRow);
-	  assert (check=='R'&&iRow>=0);
-	  if (iRow>=numberRows_)
-	    iRow=-1;
-	}
-	if ( iRow >= 0 ) {
-	  rowStatus[iRow] = atUpperBound;
-	}
-	break;
-      case COIN_LL_BASIS:
-	columnStatus[iColumn]= atLowerBound;
-	break;
-      case COIN_UL_BASIS:
-	columnStatus[iColumn]= atUpperBound;
-	break;
-      default:
-	break;
+      COINMpsType type = cardReader_->mpsType (  );
+      if (type==COIN_XL_BASIS||type==COIN_XU_BASIS) {
+	sscanf(cardReader_->rowName(),"%c%d",&check,&iRow);
+	assert (check=='R'&&iRow>=0);
+	if (iRow>=numberRows_)
+	  iRow=-1;
       }
+      setBasisStatus(type,iColumn,iRow,cardReader_->value (  ),
+		     solution,rowStatus,columnStatus);
+    } else if (more) {
+      batchType[numberBatch] = cardReader_->mpsType (  );
+      batchValue[numberBatch] = cardReader_->value (  );
+      batchName[1][numberBatch] = cardReader_->columnName();
+      if (batchType[numberBatch]==COIN_XL_BASIS||
+	  batchType[numberBatch]==COIN_XU_BASIS)
+	batchName[0][numberBatch] = cardReader_->rowName();
+      numberBatch++;
+    }
+    if (numberBatch==COIN_BASIS_BATCH||(!more&&numberBatch)) {
+      int i;
+      for (i=0;i<numberBatch;i++)
+	names[i] = batchName[1][i].c_str();
+      findHash(numberBatch,names,found[1],1);
+      // rows only for XL and XU
+      int numberRows = 0;
+      for (i=0;i<numberBatch;i++) {
+	if (batchType[i]==COIN_XL_BASIS||batchType[i]==COIN_XU_BASIS)
+	  names[numberRows++] = batchName[0][i].c_str();
+      }
+      findHash(numberRows,names,found[0],0);
+      numberRows = 0;
+      for (i=0;i<numberBatch;i++) {
+	int iRow = -1;
+	if (batchType[i]==COIN_XL_BASIS||batchType[i]==COIN_XU_BASIS)
+	  iRow = found[0][numberRows++];
+	setBasisStatus(batchType[i],found[1][i],iRow,batchValue[i],
+		       solution,rowStatus,columnStatus);
+      }
+      numberBatch = 0;
     }
   }
   if (gotNames) {
@@ -3676,8 +4165,8 @@ CoinMpsIO::readBasis(const char *filename, const char *extension ,
     free(names_[1]);
     names_[1]=NULL;
     numberHash_[1]=0;
-    delete[] hash_[0];
-    delete[] hash_[1];
+    delete hash_[0];
+    delete hash_[1];
     hash_[0]=0;
     hash_[1]=0;
   }
@@ -3844,16 +4333,8 @@ CoinConvertDouble(int section, int formatType, double value, char outputValue[24
     outputValue[12]='\0';
   } else if (formatType==1) {
     if (fabs(value)<1.0e40) {
-      memset(outputValue,' ',24);
-      sprintf(outputValue,"%.16g",value);
-      // take out blanks
-      int i=0;
-      int j;
-      for (j=0;j<23;j++) {
-	if (outputValue[j]!=' ')
-	  outputValue[i++]=outputValue[j];
-      }
-      outputValue[i]='\0';
+      // shortest which reads back exactly
+      CoinFormatDouble(value,outputValue);
     } else {
       if (section==2) {
         outputValue[0]= '\0'; // needs no value
@@ -3915,23 +4396,177 @@ CoinConvertDouble(int section, int formatType, double value, char outputValue[24
     }
   }
 }
+// Text size at which writeMps passes text on
+#define COIN_MPS_WRITE_BLOCK 65536
+// Blocks which may wait for writer thread
+#define COIN_MPS_WRITE_QUEUE 4
+namespace {
+/* Passes text from writeMps to CoinFileOutput in order.  If asked (and
+   built with COINUTILS_PTHREADS) a writer thread does the output - so
+   also any compression - while more text is being formatted */
+class CoinMpsWriter {
+public:
+  CoinMpsWriter(CoinFileOutput * output, bool useThread);
+  ~CoinMpsWriter();
+  /// Text being built up
+  inline std::string & text()
+  { return text_;}
+  /// Passes text on if a block has been built up
+  inline void check()
+  { if (text_.size()>=COIN_MPS_WRITE_BLOCK) flush();}
+  /// Passes on text and then block (which is left empty)
+  void take(std::string & block);
+  /// Passes on text
+  void flush();
+  /// Passes on text and waits until everything is written
+  void finish();
+private:
+  /// Writes or queues block (which is left empty)
+  void write(std::string & block);
+#ifdef COINUTILS_PTHREADS
+  static void * worker(void * info);
+#endif
+  CoinFileOutput * output_;
+  std::string text_;
+#ifdef COINUTILS_PTHREADS
+  // blocks waiting for writer thread
+  std::string queue_[COIN_MPS_WRITE_QUEUE];
+  int first_;
+  int number_;
+  bool done_;
+  bool threaded_;
+  pthread_t thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;
+#endif
+};
+}
+
+CoinMpsWriter::CoinMpsWriter(CoinFileOutput * output, bool useThread)
+  : output_(output)
+{
+#ifdef COINUTILS_PTHREADS
+  first_ = 0;
+  number_ = 0;
+  done_ = false;
+  threaded_ = false;
+  if (useThread) {
+    pthread_mutex_init(&mutex_,NULL);
+    pthread_cond_init(&condition_,NULL);
+    if (!pthread_create(&thread_,NULL,worker,this)) {
+      threaded_ = true;
+    } else {
+      // just write from this thread
+      pthread_cond_destroy(&condition_);
+      pthread_mutex_destroy(&mutex_);
+    }
+  }
+#else
+  (void) useThread;
+#endif
+}
+
+CoinMpsWriter::~CoinMpsWriter()
+{
+  finish();
+}
+
+void
+CoinMpsWriter::take(std::string & block)
+{
+  flush();
+  write(block);
+}
+
+void
+CoinMpsWriter::flush()
+{
+  if (!text_.empty())
+    write(text_);
+}
+
+void
+CoinMpsWriter::finish()
+{
+  flush();
+#ifdef COINUTILS_PTHREADS
+  if (threaded_) {
+    pthread_mutex_lock(&mutex_);
+    done_ = true;
+    pthread_cond_broadcast(&condition_);
+    pthread_mutex_unlock(&mutex_);
+    pthread_join(thread_,NULL);
+    pthread_cond_destroy(&condition_);
+    pthread_mutex_destroy(&mutex_);
+    threaded_ = false;
+  }
+#endif
+}
+
+void
+CoinMpsWriter::write(std::string & block)
+{
+#ifdef COINUTILS_PTHREADS
+  if (threaded_) {
+    pthread_mutex_lock(&mutex_);
+    while (number_==COIN_MPS_WRITE_QUEUE)
+      pthread_cond_wait(&condition_,&mutex_);
+    // swap so no copy - block gets back an empty string
+    queue_[(first_+number_)%COIN_MPS_WRITE_QUEUE].swap(block);
+    number_++;
+    pthread_cond_broadcast(&condition_);
+    pthread_mutex_unlock(&mutex_);
+    block.clear();
+    return;
+  }
+#endif
+  if (output_ && !block.empty())
+    output_->write(block.data(),static_cast<int>(block.size()));
+  block.clear();
+}
+
+#ifdef COINUTILS_PTHREADS
+void *
+CoinMpsWriter::worker(void * info)
+{
+  CoinMpsWriter * writer = static_cast<CoinMpsWriter *>(info);
+  std::string block;
+  pthread_mutex_lock(&writer->mutex_);
+  while (true) {
+    while (!writer->number_&&!writer->done_)
+      pthread_cond_wait(&writer->condition_,&writer->mutex_);
+    if (!writer->number_)
+      break;
+    block.swap(writer->queue_[writer->first_]);
+    writer->first_ = (writer->first_+1)%COIN_MPS_WRITE_QUEUE;
+    writer->number_--;
+    pthread_cond_broadcast(&writer->condition_);
+    pthread_mutex_unlock(&writer->mutex_);
+    if (writer->output_)
+      writer->output_->write(block.data(),static_cast<int>(block.size()));
+    block.clear();
+    pthread_mutex_lock(&writer->mutex_);
+  }
+  pthread_mutex_unlock(&writer->mutex_);
+  return NULL;
+}
+#endif
+
 static void
-writeString(CoinFileOutput *output, const char* str)
+writeString(CoinMpsWriter & output, const char* str)
 {
-   if (output != 0) {
-      output->puts (str);
-   }
+  output.text() += str;
+  output.check();
 }
 
-// Put out card image
-static void outputCard(int formatType,int numberFields,
-		       CoinFileOutput *output,
-		       std::string head, const char * name,
-		       const char outputValue[2][24],
-		       const char outputRow[2][100])
+// Add card image to text
+static void addCard(int formatType,int numberFields,
+		    std::string & line,
+		    const char * head, const char * name,
+		    const char outputValue[2][24],
+		    const char outputRow[2][100])
 {
-   // fprintf(fp,"%s",head.c_str());
-   std::string line = head;
+   line += head;
    int i;
    if (formatType==0||(formatType>=2&&formatType<8)) {
       char outputColumn[9];
@@ -3943,34 +4578,38 @@ static void outputCard(int formatType,int numberFields,
       for (;i<8;i++) 
 	 outputColumn[i]=' ';
       outputColumn[8]='\0';
-      // fprintf(fp,"%s  ",outputColumn);
       line += outputColumn;
       line += "  ";
       for (i=0;i<numberFields;i++) {
-	 // fprintf(fp,"%s  %s",outputRow[i],outputValue[i]);
 	 line += outputRow[i];
 	 line += "  ";
 	 line += outputValue[i];
 	 if (i<numberFields-1) {
-	    // fprintf(fp,"   ");
 	    line += "   ";
 	 }
       }
    } else {
-      // fprintf(fp,"%s",name);
       line += name;
       for (i=0;i<numberFields;i++) {
-	 // fprintf(fp," %s %s",outputRow[i],outputValue[i]);
 	 line += " ";
 	 line += outputRow[i];
 	 line += " ";
 	 line += outputValue[i];
       }
    }
-   
-   // fprintf(fp,"\n");
    line += "\n";
-   writeString(output, line.c_str());
+}
+
+// Put out card image
+static void outputCard(int formatType,int numberFields,
+		       CoinMpsWriter & output,
+		       const char * head, const char * name,
+		       const char outputValue[2][24],
+		       const char outputRow[2][100])
+{
+  addCard(formatType,numberFields,output.text(),head,name,
+	  outputValue,outputRow);
+  output.check();
 }
 static int
 makeUniqueNames(char ** names,int number,char first)
@@ -4038,11 +4677,329 @@ makeUniqueNames(char ** names,int number,char first)
     return 0;
   }
 }
-static void
-strcpyeq(char * output, const char * input)
+static void
+strcpyeq(char * output, const char * input)
+{
+  output[0]='=';
+  strcpy(output+1,input);
+}
+
+// Right hand side put out for row
+static inline double
+rhsValue(char sense, double lower, double upper)
+{
+  switch (sense) {
+  case 'E':
+  case 'G':
+    return lower;
+  case 'R':
+  case 'L':
+    return upper;
+  default:
+    return 0.0;
+  }
+}
+
+// Add COLUMNS cards for a column without strings
+static void
+addColumnCards(int formatType, int numberAcross, std::string & text,
+	       const char * name, const char * objrow, double objValue,
+	       int numberEntries, const int * rows, const double * elements,
+	       const char * const * rowNames, int * tempRow, double * tempValue)
+{
+  char outputValue[2][24];
+  char outputRow[2][100];
+  int numberFields=0;
+  if (objValue) {
+    convertDouble(0,formatType,objValue,outputValue[0],
+		  objrow,outputRow[0]);
+    numberFields=1;
+  }
+  if (numberFields==numberAcross) {
+    addCard(formatType,numberFields,text,"    ",name,outputValue,outputRow);
+    numberFields=0;
+  }
+  // put out rows in order
+  memcpy(tempRow,rows,numberEntries*sizeof(int));
+  memcpy(tempValue,elements,numberEntries*sizeof(double));
+  CoinSort_2(tempRow,tempRow+numberEntries,tempValue);
+  for (int j=0;j<numberEntries;j++) {
+    double value = tempValue[j];
+    if (value) {
+      convertDouble(0,formatType,value,outputValue[numberFields],
+		    rowNames[tempRow[j]],outputRow[numberFields]);
+      numberFields++;
+      if (numberFields==numberAcross) {
+	addCard(formatType,numberFields,text,"    ",name,
+		outputValue,outputRow);
+	numberFields=0;
+      }
+    }
+  }
+  if (numberFields)
+    addCard(formatType,numberFields,text,"    ",name,outputValue,outputRow);
+}
+
+// Add BOUNDS cards for a column if it needs any
+static void
+addBoundCards(int formatType, std::string & text, const char * name,
+	      double lowerValue, double upperValue, bool integer,
+	      double largeValue)
+{
+  if (!lowerValue&&upperValue>=largeValue&&!integer)
+    return;
+  if (integer) {
+    // Old argument - what are correct ranges for integer variables
+    lowerValue = CoinMax(lowerValue, -MAX_INTEGER);
+    upperValue = CoinMin(upperValue, MAX_INTEGER);
+  }
+  int numberFields=1;
+  const char * header[2];
+  double value[2];
+  if (lowerValue<=-largeValue) {
+    // FR or MI
+    if (upperValue>=largeValue&&!integer) {
+      header[0]=" FR ";
+      value[0] = largeValue;
+    } else {
+      header[0]=" MI ";
+      value[0] = -largeValue;
+      if (!integer)
+	header[1]=" UP ";
+      else
+	header[1]=" UI ";
+      if (upperValue<largeValue) 
+	value[1] = upperValue;
+      else
+	value[1] = largeValue;
+      numberFields=2;
+    }
+  } else if (fabs(upperValue-lowerValue)<1.0e-8) {
+    header[0]=" FX ";
+    value[0] = lowerValue;
+  } else {
+    // do LO if needed
+    if (lowerValue) {
+      // LO
+      header[0]=" LO ";
+      value[0] = lowerValue;
+      if (integer) {
+	// Integer variable so UI
+	header[1]=" UI ";
+	if (upperValue<largeValue) 
+	  value[1] = upperValue;
+	else
+	  value[1] = largeValue;
+	numberFields=2;
+      } else if (upperValue<largeValue) {
+	// UP
+	header[1]=" UP ";
+	value[1] = upperValue;
+	numberFields=2;
+      }
+    } else {
+      if (integer) {
+	// Integer variable so BV or UI
+	if (fabs(upperValue-1.0)<1.0e-8) {
+	  // BV
+	  header[0]=" BV ";
+	  value[0] = 1.0;
+	} else {
+	  // UI
+	  header[0]=" UI ";
+	  if (upperValue<largeValue) 
+	    value[0] = upperValue;
+	  else
+	    value[0] = largeValue;
+	}
+      } else {
+	// UP
+	header[0]=" UP ";
+	value[0] = upperValue;
+      }
+    }
+  }
+  // put out fields
+  char outputValue[2][24];
+  char outputRow[2][100];
+  for (int j=0;j<numberFields;j++) {
+    convertDouble(2,formatType,value[j],outputValue[0],name,outputRow[0]);
+    addCard(formatType,1,text,header[j],"BOUND",outputValue,outputRow);
+  }
+}
+
+// Elements (or rows or columns) in a chunk of writeMps section
+#define COIN_MPS_WRITE_CHUNK 50000
+namespace {
+// What writeMps sections need (model must have no strings)
+typedef struct {
+  int formatType;
+  int numberAcross;
+  int numberRows;
+  int numberColumns;
+  double largeValue;
+  double objectiveOffset;
+  const char * objrow;
+  const char * const * rowNames;
+  const char * const * columnNames;
+  const char * sense;
+  const char * integerType;
+  const double * rowLower;
+  const double * rowUpper;
+  const double * columnLower;
+  const double * columnUpper;
+  const double * objective;
+  const double * elements;
+  const int * rows;
+  const CoinBigIndex * starts;
+  const int * lengths;
+} CoinMpsWriteInfo;
+// A chunk of section to be formatted
+struct CoinMpsWriteChunk {
+  const CoinMpsWriteInfo * info;
+  // 0 - COLUMNS, 1 - RHS, 2 - BOUNDS
+  int type;
+  int first;
+  int last;
+  // COLUMNS - bounds needed, RHS - ranges needed
+  bool flag;
+  std::string text;
+};
+}
+
+// Formats a chunk of a section
+static void
+coinMpsFormatChunk(CoinMpsWriteChunk & chunk)
+{
+  const CoinMpsWriteInfo & info = *chunk.info;
+  std::string & text = chunk.text;
+  int formatType = info.formatType;
+  const char * integerType = info.integerType;
+  if (chunk.type==0) {
+    // COLUMNS
+    int maximumLength = 0;
+    for (int i=chunk.first;i<chunk.last;i++)
+      maximumLength = CoinMax(maximumLength,info.lengths[i]);
+    int * tempRow = new int [maximumLength];
+    double * tempValue = new double [maximumLength];
+    for (int i=chunk.first;i<chunk.last;i++) {
+      if (info.objective[i]||info.lengths[i]) {
+	// see if bound will be needed
+	if (info.columnLower[i]||info.columnUpper[i]<info.largeValue||
+	    (integerType&&integerType[i]))
+	  chunk.flag=true;
+	CoinBigIndex start = info.starts[i];
+	addColumnCards(formatType,info.numberAcross,text,
+		       info.columnNames[i],info.objrow,info.objective[i],
+		       info.lengths[i],info.rows+start,info.elements+start,
+		       info.rowNames,tempRow,tempValue);
+      }
+    }
+    delete [] tempRow;
+    delete [] tempValue;
+  } else if (chunk.type==1) {
+    // RHS - chunks start on new card
+    char outputValue[2][24];
+    char outputRow[2][100];
+    int numberFields = 0;
+    if (!chunk.first&&info.objectiveOffset) {
+      convertDouble(1,formatType,info.objectiveOffset,
+		    outputValue[0],info.objrow,outputRow[0]);
+      numberFields++;
+      if (numberFields==info.numberAcross) {
+	addCard(formatType,numberFields,text,"    ","RHS",
+		outputValue,outputRow);
+	numberFields=0;
+      }
+    }
+    for (int i=chunk.first;i<chunk.last;i++) {
+      if (info.sense[i]=='R')
+	chunk.flag=true;
+      double value = rhsValue(info.sense[i],info.rowLower[i],info.rowUpper[i]);
+      if (value != 0.0) {
+	convertDouble(1,formatType,value,outputValue[numberFields],
+		      info.rowNames[i],outputRow[numberFields]);
+	numberFields++;
+	if (numberFields==info.numberAcross) {
+	  addCard(formatType,numberFields,text,"    ","RHS",
+		  outputValue,outputRow);
+	  numberFields=0;
+	}
+      }
+    }
+    if (numberFields)
+      addCard(formatType,numberFields,text,"    ","RHS",
+	      outputValue,outputRow);
+  } else {
+    // BOUNDS
+    for (int i=chunk.first;i<chunk.last;i++) {
+      if (info.objective[i]||info.lengths[i])
+	addBoundCards(formatType,text,info.columnNames[i],
+		      info.columnLower[i],info.columnUpper[i],
+		      integerType&&integerType[i],info.largeValue);
+    }
+  }
+}
+
+static void *
+coinMpsWriteWorker(void * info)
 {
-  output[0]='=';
-  strcpy(output+1,input);
+  coinMpsFormatChunk(*static_cast<CoinMpsWriteChunk *>(info));
+  return NULL;
+}
+
+/* Formats COLUMNS (type 0), RHS (1) or BOUNDS (2) in chunks, up to
+   numberThreads at a time, and passes text on in order.  Returns true
+   if COLUMNS needs BOUNDS or RHS needs RANGES */
+static bool
+coinMpsWriteSection(const CoinMpsWriteInfo & info, int type,
+		    int numberThreads, CoinMpsWriter & output)
+{
+  int number = (type==1) ? info.numberRows : info.numberColumns;
+  CoinMpsWriteChunk * chunk = new CoinMpsWriteChunk [numberThreads];
+  bool flag = false;
+  // fields of RHS so far so chunks can start on new card
+  int numberFields = (info.objectiveOffset) ? 1 : 0;
+  int next = 0;
+  // always one chunk so objective offset goes out
+  bool firstChunk = true;
+  while (firstChunk||next<number) {
+    int numberChunks = 0;
+    while (numberChunks<numberThreads&&(firstChunk||next<number)) {
+      firstChunk = false;
+      CoinMpsWriteChunk & thisChunk = chunk[numberChunks++];
+      thisChunk.info = &info;
+      thisChunk.type = type;
+      thisChunk.first = next;
+      thisChunk.flag = false;
+      int size = 0;
+      if (type==0) {
+	while (next<number&&size<COIN_MPS_WRITE_CHUNK)
+	  size += info.lengths[next++]+1;
+      } else if (type==1) {
+	while (next<number&&(size<COIN_MPS_WRITE_CHUNK||
+			     (info.numberAcross==2&&(numberFields&1)!=0))) {
+	  if (rhsValue(info.sense[next],info.rowLower[next],
+		       info.rowUpper[next]))
+	    numberFields++;
+	  next++;
+	  size++;
+	}
+      } else {
+	next = CoinMin(next+COIN_MPS_WRITE_CHUNK,number);
+      }
+      thisChunk.last = next;
+    }
+    CoinThreadPool::run(coinMpsWriteWorker,chunk,sizeof(CoinMpsWriteChunk),
+			numberChunks);
+    for (int i=0;i<numberChunks;i++) {
+      if (chunk[i].flag)
+	flag = true;
+      output.take(chunk[i].text);
+    }
+  }
+  delete [] chunk;
+  return flag;
 }
 
 int
@@ -4063,7 +5020,14 @@ CoinMpsIO::writeMps(const char *filename, int compression,
 #ifdef COIN_HAS_BZLIB
   possibleCompression += 2;
 #endif
-  if ((compression&possibleCompression)==0) {
+  // zstd or lz4 if possible, otherwise as gzip
+  if ((compression==3&&
+       !CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_ZSTD))||
+      (compression==4&&
+       !CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_LZ4))||
+      compression>4)
+    compression=1;
+  if (compression<3&&(compression&possibleCompression)==0) {
     // switch to other if possible
     if (compression&&possibleCompression)
       compression = 3-compression;
@@ -4071,40 +5035,74 @@ CoinMpsIO::writeMps(const char *filename, int compression,
       compression=0;
   }
   std::string line = filename;
-   CoinFileOutput *output = 0;
+   CoinFileOutput *fileOutput = 0;
    switch (compression) {
    case 1:
      if (strcmp(line.c_str() +(line.size()-3), ".gz") != 0) {
        line += ".gz";
      }
-     output = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_GZIP);
+     fileOutput = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_GZIP);
      break;
 
    case 2:
      if (strcmp(line.c_str() +(line.size()-4), ".bz2") != 0) {
        line += ".bz2";
      }
-     output = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_BZIP2);
+     fileOutput = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_BZIP2);
+     break;
+
+   case 3:
+     if (strcmp(line.c_str() +(line.size()-4), ".zst") != 0) {
+       line += ".zst";
+     }
+     fileOutput = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_ZSTD,
+					  numberThreads_);
+     break;
+
+   case 4:
+     if (strcmp(line.c_str() +(line.size()-4), ".lz4") != 0) {
+       line += ".lz4";
+     }
+     fileOutput = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_LZ4);
      break;
 
    case 0:
    default:
-     output = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_NONE);
+     fileOutput = CoinFileOutput::create (line, CoinFileOutput::COMPRESS_NONE);
      break;
    }
+   // text goes out in order (from another thread if threads)
+   CoinMpsWriter output(fileOutput,numberThreads_>1);
 
-   const char * const * const rowNames = names_[0];
-   const char * const * const columnNames = names_[1];
+   // default names if names were not kept
+   char ** defaultNames[2] = {NULL,NULL};
    int i;
+   for (int section=0;section<2;section++) {
+     int number = section ? numberColumns_ : numberRows_;
+     if (!names_[section]) {
+       defaultNames[section] =
+	 reinterpret_cast<char **> (malloc(number*sizeof(char *)));
+       for (i=0;i<number;i++) {
+	 // room for any int
+	 defaultNames[section][i] = reinterpret_cast<char *> (malloc(16));
+	 snprintf(defaultNames[section][i],16,"%c%7.7d",
+		  section ? 'C' : 'R',i);
+       }
+     }
+   }
+   char ** const rowNameArray = names_[0] ? names_[0] : defaultNames[0];
+   char ** const columnNameArray = names_[1] ? names_[1] : defaultNames[1];
+   const char * const * const rowNames = rowNameArray;
+   const char * const * const columnNames = columnNameArray;
    unsigned int length = 8;
    bool freeFormat = (formatType==1);
    // Check names for uniqueness if default
    int nChanged;
-   nChanged=makeUniqueNames(names_[0],numberRows_,'R');
+   nChanged=makeUniqueNames(rowNameArray,numberRows_,'R');
    if (nChanged)
      handler_->message(COIN_MPS_CHANGED,messages_)<<"row"<<nChanged
                                                   <<CoinMessageEol;
-   nChanged=makeUniqueNames(names_[1],numberColumns_,'C');
+   nChanged=makeUniqueNames(columnNameArray,numberColumns_,'C');
    if (nChanged)
      handler_->message(COIN_MPS_CHANGED,messages_)<<"column"<<nChanged
                                                   <<CoinMessageEol;
@@ -4219,6 +5217,28 @@ CoinMpsIO::writeMps(const char *filename, int compression,
 
    char outputValue[2][24];
    char outputRow[2][100];
+   // without strings sections can be formatted in chunks
+   CoinMpsWriteInfo info;
+   info.formatType = formatType;
+   info.numberAcross = numberAcross;
+   info.numberRows = numberRows_;
+   info.numberColumns = numberColumns_;
+   info.largeValue = largeValue;
+   info.objectiveOffset = objectiveOffset_;
+   info.objrow = objrow;
+   info.rowNames = rowNames;
+   info.columnNames = columnNames;
+   info.sense = sense;
+   info.integerType = integerType_;
+   info.rowLower = rowLower;
+   info.rowUpper = rowUpper;
+   info.columnLower = columnLower;
+   info.columnUpper = columnUpper;
+   info.objective = objective;
+   info.elements = elements;
+   info.rows = rows;
+   info.starts = starts;
+   info.lengths = lengths;
    // strings
    int nextRowString=numberRows_+10;
    int nextColumnString=numberColumns_+10;
@@ -4234,8 +5254,11 @@ CoinMpsIO::writeMps(const char *filename, int compression,
    int * tempRow = new int [numberRows_];
    double * tempValue = new double [numberRows_];
 
-   // Through columns (only put out if elements or objective value)
-   for (i=0;i<numberColumns_;i++) {
+   if (!numberStringElements_)
+     ifBounds = coinMpsWriteSection(info,0,numberThreads_,output);
+   /* Through columns (only put out if elements or objective value).
+      With strings this and RHS and BOUNDS are done here in order */
+   for (i=0;i<numberColumns_&&numberStringElements_;i++) {
      if (i==nextColumnString) {
        // set up
        int k=whichString;
@@ -4342,8 +5365,10 @@ CoinMpsIO::writeMps(const char *filename, int compression,
    writeString(output, "RHS\n");
 
    int numberFields = 0;
+   if (!numberStringElements_)
+     ifRange = coinMpsWriteSection(info,1,numberThreads_,output);
    // If there is any offset - then do that
-   if (objectiveOffset_ ) {
+   if (objectiveOffset_&&numberStringElements_) {
      convertDouble(1,formatType,objectiveOffset_,
 		   outputValue[0],
 		   objrow,
@@ -4359,7 +5384,7 @@ CoinMpsIO::writeMps(const char *filename, int compression,
        numberFields=0;
      }
    }
-   for (i=0;i<numberRows_;i++) {
+   for (i=0;i<numberRows_&&numberStringElements_;i++) {
       double value;
       switch (sense[i]) {
       case 'E':
@@ -4449,7 +5474,9 @@ CoinMpsIO::writeMps(const char *filename, int compression,
       // BOUNDS
       writeString(output, "BOUNDS\n");
 
-      for (i=0;i<numberColumns_;i++) {
+      if (!numberStringElements_)
+	coinMpsWriteSection(info,2,numberThreads_,output);
+      for (i=0;i<numberColumns_&&numberStringElements_;i++) {
 	if (i==nextColumnString) {
 	  // just lo and up
 	  if (columnLower[i]==STRING_VALUE) {
@@ -4512,96 +5539,9 @@ CoinMpsIO::writeMps(const char *filename, int compression,
 	  continue;
 	}
 	 if (objective[i]||lengths[i]) {
-	    // see if bound will be needed
-	    if (columnLower[i]||columnUpper[i]<largeValue||isInteger(i)) {
-	      double lowerValue = columnLower[i];
-	      double upperValue = columnUpper[i];
-	      if (isInteger(i)) {
-		// Old argument - what are correct ranges for integer variables
-		lowerValue = CoinMax(lowerValue, -MAX_INTEGER);
-		upperValue = CoinMin(upperValue, MAX_INTEGER);
-	      }
-	       int numberFields=1;
-	       std::string header[2];
-	       double value[2];
-	       if (lowerValue<=-largeValue) {
-		  // FR or MI
-		  if (upperValue>=largeValue&&!isInteger(i)) {
-		     header[0]=" FR ";
-		     value[0] = largeValue;
-		  } else {
-		     header[0]=" MI ";
-		     value[0] = -largeValue;
-                     if (!isInteger(i))
-                       header[1]=" UP ";
-                     else
-                       header[1]=" UI ";
-                     if (upperValue<largeValue) 
-                       value[1] = upperValue;
-                     else
-                       value[1] = largeValue;
-		     numberFields=2;
-		  }
-	       } else if (fabs(upperValue-lowerValue)<1.0e-8) {
-		  header[0]=" FX ";
-		  value[0] = lowerValue;
-	       } else {
-		  // do LO if needed
-		  if (lowerValue) {
-		     // LO
-		     header[0]=" LO ";
-		     value[0] = lowerValue;
-		     if (isInteger(i)) {
-			// Integer variable so UI
-			header[1]=" UI ";
-                        if (upperValue<largeValue) 
-                          value[1] = upperValue;
-                        else
-                          value[1] = largeValue;
-			numberFields=2;
-		     } else if (upperValue<largeValue) {
-			// UP
-			header[1]=" UP ";
-			value[1] = upperValue;
-			numberFields=2;
-		     }
-		  } else {
-		     if (isInteger(i)) {
-			// Integer variable so BV or UI
-			if (fabs(upperValue-1.0)<1.0e-8) {
-			   // BV
-			   header[0]=" BV ";
-			   value[0] = 1.0;
-			} else {
-			   // UI
-			   header[0]=" UI ";
-                           if (upperValue<largeValue) 
-                             value[0] = upperValue;
-                           else
-                             value[0] = largeValue;
-			}
-		     } else {
-			// UP
-			header[0]=" UP ";
-			value[0] = upperValue;
-		     }
-		  }
-	       }
-	       // put out fields
-	       int j;
-	       for (j=0;j<numberFields;j++) {
-		  convertDouble(2,formatType,value[j],
-				outputValue[0],
-				columnNames[i],
-				outputRow[0]);
-		  // put out card
-		  outputCard(formatType, 1,
-			     output, header[j],
-			     "BOUND",
-			     outputValue,
-			     outputRow);
-	       }
-	    }
+	   addBoundCards(formatType,output.text(),columnNames[i],
+			 columnLower[i],columnUpper[i],isInteger(i),largeValue);
+	   output.check();
 	 }
       }
    }
@@ -4676,9 +5616,568 @@ CoinMpsIO::writeMps(const char *filename, int compression,
 
    free(objrow);
 
-   delete output;
+   output.finish();
+   delete fileOutput;
+   for (int section=0;section<2;section++) {
+     if (defaultNames[section]) {
+       int number = section ? numberColumns_ : numberRows_;
+       for (i=0;i<number;i++)
+	 free(defaultNames[section][i]);
+       free(defaultNames[section]);
+     }
+   }
    return 0;
 }
+
+//#############################################################################
+/* Binary snapshot format (version 1).  All values little-endian.
+
+   Header of 128 bytes
+     0  "COINBIN" and '\0'
+     8  int32 version, int32 header size
+    16  int64 rows, int64 columns, int64 elements, int64 bytes of names
+    48  int64 flags (1 - integer markers, 2 - names)
+    56  double objective offset, double infinity
+    72  reserved (zero)
+   then sections, each padded to multiple of 8 bytes so can be mapped
+     int64 column starts (columns+1), int32 column lengths (columns),
+     int32 row indices (elements), double elements (elements),
+     double column lower, column upper, objective (columns),
+     double row lower, row upper (rows),
+     char integer markers (columns) if flag 1,
+     int64 name offsets (2+rows+columns+1) and name characters if flag 2 -
+     names are problem, objective, rows then columns, each '\0' terminated.
+*/
+namespace {
+  const char binaryMagic[8] = {'C','O','I','N','B','I','N','\0'};
+  const int binaryVersion = 1;
+  const int binaryHeaderSize = 128;
+  // Chunk so int sizes in CoinFileIO are fine
+  const int binaryChunk = 1<<24;
+
+  bool binaryLittleEndian()
+  {
+    int one = 1;
+    return *reinterpret_cast<char *>(&one)==1;
+  }
+  void binarySwap(char * data, size_t number, int size)
+  {
+    for (size_t i=0;i<number;i++) {
+      char * item = data + i*size;
+      for (int j=0;j<size/2;j++) {
+	char temp = item[j];
+	item[j] = item[size-1-j];
+	item[size-1-j] = temp;
+      }
+    }
+  }
+  // Writes number items of size then pads to 8 - returns false on error
+  bool binaryWrite(CoinFileOutput * output, const void * data,
+		   size_t number, int size)
+  {
+    const char * get = reinterpret_cast<const char *>(data);
+    size_t bytes = number*size;
+    bool swap = size>1&&!binaryLittleEndian();
+    char * buffer = swap ? new char [binaryChunk] : NULL;
+    bool ok = true;
+    while (bytes&&ok) {
+      int n = static_cast<int>(CoinMin(bytes,static_cast<size_t>(binaryChunk)));
+      if (swap) {
+	memcpy(buffer,get,n);
+	binarySwap(buffer,n/size,size);
+	ok = output->write(buffer,n)==n;
+      } else {
+	ok = output->write(get,n)==n;
+      }
+      get += n;
+      bytes -= n;
+    }
+    delete [] buffer;
+    int pad = static_cast<int>((8-((number*size)&7))&7);
+    if (ok&&pad) {
+      char zero[8] = {0,0,0,0,0,0,0,0};
+      ok = output->write(zero,pad)==pad;
+    }
+    return ok;
+  }
+  // Reads what binaryWrite wrote - returns false on error
+  bool binaryRead(CoinFileInput * input, void * data,
+		  size_t number, int size)
+  {
+    char * put = reinterpret_cast<char *>(data);
+    size_t bytes = number*size;
+    while (bytes) {
+      int n = static_cast<int>(CoinMin(bytes,static_cast<size_t>(binaryChunk)));
+      if (input->read(put,n)!=n)
+	return false;
+      put += n;
+      bytes -= n;
+    }
+    if (size>1&&!binaryLittleEndian())
+      binarySwap(reinterpret_cast<char *>(data),number,size);
+    int pad = static_cast<int>((8-((number*size)&7))&7);
+    if (pad) {
+      char zero[8];
+      if (input->read(zero,pad)!=pad)
+	return false;
+    }
+    return true;
+  }
+  // Header as written
+  typedef struct {
+    char magic[8];
+    int version;
+    int headerSize;
+    CoinInt64 numberRows;
+    CoinInt64 numberColumns;
+    CoinInt64 numberElements;
+    CoinInt64 nameBytes;
+    CoinInt64 flags;
+    double objectiveOffset;
+    double infinity;
+    CoinInt64 reserved[7];
+  } CoinMpsBinaryHeader;
+}
+
+int
+CoinMpsIO::writeBinary(const char * filename) const
+{
+  CoinFileOutput * output = NULL;
+  try {
+    output = CoinFileOutput::create(filename,CoinFileOutput::COMPRESS_NONE);
+  }
+  catch (CoinError &) {
+    output = NULL;
+  }
+  if (!output)
+    return -1;
+  int returnCode = writeBinary(output);
+  if (!output->close())
+    returnCode = -1;
+  delete output;
+  return returnCode;
+}
+
+int
+CoinMpsIO::writeBinary(CoinFileOutput * output) const
+{
+  // make sure no gaps
+  CoinPackedMatrix empty;
+  const CoinPackedMatrix * matrix = matrixByColumn_ ? matrixByColumn_ : &empty;
+  CoinPackedMatrix * noGaps = NULL;
+  if (matrix->hasGaps()) {
+    noGaps = new CoinPackedMatrix(*matrix);
+    noGaps->removeGaps();
+    matrix = noGaps;
+  }
+  CoinMpsBinaryHeader header;
+  memset(&header,0,sizeof(header));
+  assert (sizeof(header)==binaryHeaderSize);
+  memcpy(header.magic,binaryMagic,8);
+  header.version = binaryVersion;
+  header.headerSize = binaryHeaderSize;
+  header.numberRows = numberRows_;
+  header.numberColumns = numberColumns_;
+  header.numberElements = matrix->getNumElements();
+  header.flags = (integerType_ ? 1 : 0) + (names_[0]&&names_[1] ? 2 : 0);
+  header.objectiveOffset = objectiveOffset_;
+  header.infinity = infinity_;
+  // name offsets
+  int numberNames = 2+numberRows_+numberColumns_;
+  CoinInt64 * nameOffset = NULL;
+  if ((header.flags&2)!=0) {
+    nameOffset = new CoinInt64 [numberNames+1];
+    CoinInt64 offset = 0;
+    for (int i=0;i<numberNames;i++) {
+      nameOffset[i] = offset;
+      offset += strlen(binaryName(i))+1;
+    }
+    nameOffset[numberNames] = offset;
+    header.nameBytes = offset;
+  }
+  bool ok = true;
+  if (!binaryLittleEndian()) {
+    CoinMpsBinaryHeader copy = header;
+    binarySwap(reinterpret_cast<char *>(&copy.version),2,4);
+    binarySwap(reinterpret_cast<char *>(&copy.numberRows),7,8);
+    ok = output->write(&copy,binaryHeaderSize)==binaryHeaderSize;
+  } else {
+    ok = output->write(&header,binaryHeaderSize)==binaryHeaderSize;
+  }
+  int numberColumns = matrix->getNumCols();
+  CoinInt64 * start = new CoinInt64 [numberColumns_+1];
+  int * length = new int [numberColumns_];
+  const CoinBigIndex * columnStart = matrix->getVectorStarts();
+  const int * columnLength = matrix->getVectorLengths();
+  for (int i=0;i<numberColumns_;i++) {
+    start[i] = i<numberColumns ? columnStart[i] : header.numberElements;
+    length[i] = i<numberColumns ? columnLength[i] : 0;
+  }
+  start[numberColumns_] = header.numberElements;
+  size_t numberElements = static_cast<size_t>(header.numberElements);
+  ok = ok && binaryWrite(output,start,numberColumns_+1,8);
+  ok = ok && binaryWrite(output,length,numberColumns_,4);
+  ok = ok && binaryWrite(output,matrix->getIndices(),numberElements,4);
+  ok = ok && binaryWrite(output,matrix->getElements(),numberElements,8);
+  delete [] start;
+  delete [] length;
+  delete noGaps;
+  ok = ok && binaryWrite(output,collower_,numberColumns_,8);
+  ok = ok && binaryWrite(output,colupper_,numberColumns_,8);
+  ok = ok && binaryWrite(output,objective_,numberColumns_,8);
+  ok = ok && binaryWrite(output,rowlower_,numberRows_,8);
+  ok = ok && binaryWrite(output,rowupper_,numberRows_,8);
+  if ((header.flags&1)!=0)
+    ok = ok && binaryWrite(output,integerType_,numberColumns_,1);
+  if (nameOffset) {
+    ok = ok && binaryWrite(output,nameOffset,numberNames+1,8);
+    for (int i=0;i<numberNames&&ok;i++) {
+      const char * name = binaryName(i);
+      int n = static_cast<int>(nameOffset[i+1]-nameOffset[i]);
+      ok = output->write(name,n)==n;
+    }
+    int pad = static_cast<int>((8-(header.nameBytes&7))&7);
+    if (ok&&pad) {
+      char zero[8] = {0,0,0,0,0,0,0,0};
+      ok = output->write(zero,pad)==pad;
+    }
+    delete [] nameOffset;
+  }
+  return ok ? 0 : -1;
+}
+
+// Name i in binary name order
+const char *
+CoinMpsIO::binaryName(int i) const
+{
+  const char * name;
+  if (!i)
+    name = problemName_;
+  else if (i==1)
+    name = objectiveName_;
+  else if (i<2+numberRows_)
+    name = names_[0][i-2];
+  else
+    name = names_[1][i-2-numberRows_];
+  return name ? name : "";
+}
+
+int
+CoinMpsIO::readBinary(const char * filename)
+{
+  CoinFileInput * input = NULL;
+  try {
+    input = CoinFileInput::create(filename, numberThreads_);
+  }
+  catch (CoinError &) {
+    input = NULL;
+  }
+  if (!input) {
+    handler_->message(COIN_MPS_FILE,messages_)<<filename
+					      <<CoinMessageEol;
+    return -1;
+  }
+  CoinMpsBinaryHeader header;
+  bool ok = input->read(&header,binaryHeaderSize)==binaryHeaderSize;
+  if (ok&&!binaryLittleEndian()) {
+    binarySwap(reinterpret_cast<char *>(&header.version),2,4);
+    binarySwap(reinterpret_cast<char *>(&header.numberRows),7,8);
+  }
+  if (!ok||memcmp(header.magic,binaryMagic,8)||
+      header.version!=binaryVersion||header.headerSize!=binaryHeaderSize||
+      header.numberRows<0||header.numberColumns<0||header.numberElements<0||
+      header.numberRows>COIN_INT_MAX||header.numberColumns>COIN_INT_MAX) {
+    delete input;
+    handler_->message(COIN_MPS_BADFILE1,messages_)<<"(binary)"<<1
+						  <<filename<<CoinMessageEol;
+    return -2;
+  }
+  freeAll();
+  stringElements_ = NULL;
+  numberStringElements_ = 0;
+  numberRows_ = static_cast<int>(header.numberRows);
+  numberColumns_ = static_cast<int>(header.numberColumns);
+  numberElements_ = static_cast<CoinBigIndex>(header.numberElements);
+  objectiveOffset_ = header.objectiveOffset;
+  size_t numberElements = static_cast<size_t>(header.numberElements);
+  CoinBigIndex * start = new CoinBigIndex [numberColumns_+1];
+  int * length = new int [numberColumns_];
+  int * row = new int [numberElements];
+  double * element = new double [numberElements];
+  if (sizeof(CoinBigIndex)==8) {
+    ok = binaryRead(input,start,numberColumns_+1,8);
+  } else {
+    CoinInt64 * start64 = new CoinInt64 [numberColumns_+1];
+    ok = binaryRead(input,start64,numberColumns_+1,8);
+    for (int i=0;i<=numberColumns_;i++)
+      start[i] = static_cast<CoinBigIndex>(start64[i]);
+    delete [] start64;
+  }
+  ok = ok && binaryRead(input,length,numberColumns_,4);
+  ok = ok && binaryRead(input,row,numberElements,4);
+  ok = ok && binaryRead(input,element,numberElements,8);
+  // column starts, lengths and row indices must fit header sizes
+  bool badMatrix = false;
+  if (ok) {
+    badMatrix = start[0]<0||start[numberColumns_]>numberElements_||
+      static_cast<CoinInt64>(numberElements_)!=header.numberElements;
+    for (int i=0;i<numberColumns_&&!badMatrix;i++) {
+      if (length[i]<0||start[i]>start[i+1]||
+	  length[i]>start[i+1]-start[i]) {
+	badMatrix = true;
+      } else {
+	for (CoinBigIndex j=start[i];j<start[i]+length[i];j++) {
+	  if (row[j]<0||row[j]>=numberRows_) {
+	    badMatrix = true;
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  if (!ok||badMatrix) {
+    delete [] start;
+    delete [] length;
+    delete [] row;
+    delete [] element;
+    delete input;
+    freeAll();
+    problemName_ = CoinStrdup("");
+    objectiveName_ = CoinStrdup("");
+    rhsName_ = CoinStrdup("");
+    rangeName_ = CoinStrdup("");
+    boundName_ = CoinStrdup("");
+    numberRows_ = 0;
+    numberColumns_ = 0;
+    numberElements_ = 0;
+    handler_->message(COIN_MPS_BADFILE1,messages_)<<"(binary)"<<1
+						  <<filename<<CoinMessageEol;
+    return badMatrix ? -3 : -2;
+  }
+  matrixByColumn_ = new CoinPackedMatrix();
+  matrixByColumn_->assignMatrix(true,numberRows_,numberColumns_,
+				numberElements_,element,row,start,length);
+  collower_ = reinterpret_cast<double *> (malloc(numberColumns_*sizeof(double)));
+  colupper_ = reinterpret_cast<double *> (malloc(numberColumns_*sizeof(double)));
+  objective_ = reinterpret_cast<double *> (malloc(numberColumns_*sizeof(double)));
+  rowlower_ = reinterpret_cast<double *> (malloc(numberRows_*sizeof(double)));
+  rowupper_ = reinterpret_cast<double *> (malloc(numberRows_*sizeof(double)));
+  ok = ok && binaryRead(input,collower_,numberColumns_,8);
+  ok = ok && binaryRead(input,colupper_,numberColumns_,8);
+  ok = ok && binaryRead(input,objective_,numberColumns_,8);
+  ok = ok && binaryRead(input,rowlower_,numberRows_,8);
+  ok = ok && binaryRead(input,rowupper_,numberRows_,8);
+  if ((header.flags&1)!=0) {
+    integerType_ = reinterpret_cast<char *> (malloc(numberColumns_*sizeof(char)));
+    ok = ok && binaryRead(input,integerType_,numberColumns_,1);
+  }
+  if (header.infinity!=infinity_) {
+    // put in our infinity
+    double * array[] = {collower_,colupper_,rowlower_,rowupper_};
+    int number[] = {numberColumns_,numberColumns_,numberRows_,numberRows_};
+    for (int k=0;k<4;k++) {
+      for (int i=0;i<number[k];i++) {
+	if (array[k][i]>=header.infinity)
+	  array[k][i] = infinity_;
+	else if (array[k][i]<=-header.infinity)
+	  array[k][i] = -infinity_;
+      }
+    }
+  }
+  rhsName_ = CoinStrdup("");
+  rangeName_ = CoinStrdup("");
+  boundName_ = CoinStrdup("");
+  if (ok&&(header.flags&2)!=0) {
+    int numberNames = 2+numberRows_+numberColumns_;
+    CoinInt64 * nameOffset = new CoinInt64 [numberNames+1];
+    ok = binaryRead(input,nameOffset,numberNames+1,8);
+    char * nameBlob = NULL;
+    for (int i=0;ok&&i<numberNames;i++)
+      ok = nameOffset[i]>=0&&nameOffset[i]<header.nameBytes;
+    if (ok&&nameOffset[numberNames]==header.nameBytes&&header.nameBytes>0) {
+      nameBlob = new char [header.nameBytes];
+      ok = binaryRead(input,nameBlob,static_cast<size_t>(header.nameBytes),1);
+      ok = ok && nameBlob[header.nameBytes-1]=='\0';
+    } else {
+      ok = false;
+    }
+    if (ok) {
+      problemName_ = CoinStrdup(nameBlob+nameOffset[0]);
+      objectiveName_ = CoinStrdup(nameBlob+nameOffset[1]);
+      names_[0] = reinterpret_cast<char **> (malloc(numberRows_*sizeof(char *)));
+      names_[1] = reinterpret_cast<char **> (malloc(numberColumns_*sizeof(char *)));
+      numberHash_[0] = numberRows_;
+      numberHash_[1] = numberColumns_;
+      for (int i=0;i<numberRows_;i++)
+	names_[0][i] = CoinStrdup(nameBlob+nameOffset[2+i]);
+      for (int i=0;i<numberColumns_;i++)
+	names_[1][i] = CoinStrdup(nameBlob+nameOffset[2+numberRows_+i]);
+    }
+    delete [] nameBlob;
+    delete [] nameOffset;
+  } else if (ok) {
+    problemName_ = CoinStrdup("");
+    objectiveName_ = CoinStrdup("");
+    setMpsDataColAndRowNames(static_cast<const char * const *>(NULL),NULL);
+  }
+  delete input;
+  if (!ok) {
+    freeAll();
+    problemName_ = CoinStrdup("");
+    objectiveName_ = CoinStrdup("");
+    rhsName_ = CoinStrdup("");
+    rangeName_ = CoinStrdup("");
+    boundName_ = CoinStrdup("");
+    numberRows_ = 0;
+    numberColumns_ = 0;
+    numberElements_ = 0;
+    handler_->message(COIN_MPS_BADFILE1,messages_)<<"(binary)"<<1
+						  <<filename<<CoinMessageEol;
+    return -2;
+  }
+  fileName_ = CoinStrdup(filename);
+  handler_->message(COIN_MPS_STATS,messages_)<<problemName_
+					    <<numberRows_
+					    <<numberColumns_
+					    <<numberElements_
+					    <<CoinMessageEol;
+  return 0;
+}
+
+/* Binary basis format (version 1).  Header of 64 bytes
+     0  "COINBAS" and '\0'
+     8  int32 version, int32 header size
+    16  int64 structurals, int64 artificials, int64 checksum (FNV-1a
+        of the status bytes), reserved (zero)
+   then structural status then artificial status, packed as in
+   CoinWarmStartBasis ((n+3)/4 bytes each) and padded to 8 bytes.
+*/
+namespace {
+  const char basisMagic[8] = {'C','O','I','N','B','A','S','\0'};
+  const int basisVersion = 1;
+  const int basisHeaderSize = 64;
+  typedef struct {
+    char magic[8];
+    int version;
+    int headerSize;
+    CoinInt64 numberStructural;
+    CoinInt64 numberArtificial;
+    CoinInt64 checksum;
+    CoinInt64 reserved[3];
+  } CoinMpsBasisHeader;
+  CoinInt64 basisChecksum(const CoinWarmStartBasis & basis)
+  {
+    CoinUInt64 hash = 14695981039346656037ULL;
+    const unsigned char * status[2] = {
+      reinterpret_cast<const unsigned char *>(basis.getStructuralStatus()),
+      reinterpret_cast<const unsigned char *>(basis.getArtificialStatus())};
+    int number[2] = {(basis.getNumStructural()+3)>>2,
+		     (basis.getNumArtificial()+3)>>2};
+    for (int k=0;k<2;k++) {
+      for (int i=0;i<number[k];i++) {
+	hash ^= status[k][i];
+	hash *= 1099511628211ULL;
+      }
+    }
+    return static_cast<CoinInt64>(hash);
+  }
+}
+
+int
+CoinMpsIO::writeBasisBinary(const char * filename,
+			    const CoinWarmStartBasis & basis) const
+{
+  CoinFileOutput * output = NULL;
+  try {
+    output = CoinFileOutput::create(filename,CoinFileOutput::COMPRESS_NONE);
+  }
+  catch (CoinError &) {
+    output = NULL;
+  }
+  if (!output)
+    return -1;
+  CoinMpsBasisHeader header;
+  memset(&header,0,sizeof(header));
+  assert (sizeof(header)==basisHeaderSize);
+  memcpy(header.magic,basisMagic,8);
+  header.version = basisVersion;
+  header.headerSize = basisHeaderSize;
+  header.numberStructural = basis.getNumStructural();
+  header.numberArtificial = basis.getNumArtificial();
+  header.checksum = basisChecksum(basis);
+  bool ok;
+  if (!binaryLittleEndian()) {
+    binarySwap(reinterpret_cast<char *>(&header.version),2,4);
+    binarySwap(reinterpret_cast<char *>(&header.numberStructural),6,8);
+  }
+  ok = output->write(&header,basisHeaderSize)==basisHeaderSize;
+  ok = ok && binaryWrite(output,basis.getStructuralStatus(),
+			 (basis.getNumStructural()+3)>>2,1);
+  ok = ok && binaryWrite(output,basis.getArtificialStatus(),
+			 (basis.getNumArtificial()+3)>>2,1);
+  ok = output->close() && ok;
+  delete output;
+  return ok ? 0 : -1;
+}
+
+int
+CoinMpsIO::readBasisBinary(const char * filename, CoinWarmStartBasis & basis)
+{
+  CoinFileInput * input = NULL;
+  try {
+    input = CoinFileInput::create(filename);
+  }
+  catch (CoinError &) {
+    input = NULL;
+  }
+  if (!input) {
+    handler_->message(COIN_MPS_FILE,messages_)<<filename
+					      <<CoinMessageEol;
+    return -1;
+  }
+  CoinMpsBasisHeader header;
+  bool ok = input->read(&header,basisHeaderSize)==basisHeaderSize;
+  if (ok&&!binaryLittleEndian()) {
+    binarySwap(reinterpret_cast<char *>(&header.version),2,4);
+    binarySwap(reinterpret_cast<char *>(&header.numberStructural),6,8);
+  }
+  ok = ok && !memcmp(header.magic,basisMagic,8) &&
+    header.version==basisVersion&&header.headerSize==basisHeaderSize&&
+    header.numberStructural>=0&&header.numberArtificial>=0&&
+    header.numberStructural<=COIN_INT_MAX&&
+    header.numberArtificial<=COIN_INT_MAX;
+  if (ok) {
+    int numberStructural = static_cast<int>(header.numberStructural);
+    int numberArtificial = static_cast<int>(header.numberArtificial);
+    // allocated as CoinWarmStartBasis would
+    int sizeStructural = 4*((numberStructural+15)>>4);
+    int sizeArtificial = 4*((numberArtificial+15)>>4);
+    char * structuralStatus = new char [CoinMax(sizeStructural,1)];
+    char * artificialStatus = new char [CoinMax(sizeArtificial,1)];
+    CoinZeroN(structuralStatus,sizeStructural);
+    CoinZeroN(artificialStatus,sizeArtificial);
+    ok = binaryRead(input,structuralStatus,(numberStructural+3)>>2,1);
+    ok = ok && binaryRead(input,artificialStatus,(numberArtificial+3)>>2,1);
+    if (ok) {
+      CoinWarmStartBasis read;
+      read.assignBasisStatus(numberStructural,numberArtificial,
+			     structuralStatus,artificialStatus);
+      ok = basisChecksum(read)==header.checksum;
+      if (ok)
+	basis = read;
+    } else {
+      delete [] structuralStatus;
+      delete [] artificialStatus;
+    }
+  }
+  delete input;
+  if (!ok) {
+    handler_->message(COIN_MPS_BADFILE1,messages_)<<"(basis)"<<1
+						  <<filename<<CoinMessageEol;
+    return -2;
+  }
+  return 0;
+}
    
 //------------------------------------------------------------------
 // Problem name
@@ -5148,6 +6647,19 @@ const char * CoinMpsIO::integerColumns() const
 {
   return integerType_;
 }
+// Fingerprint of matrix, bounds, objective and integer columns
+CoinFingerprint CoinMpsIO::fingerprint() const
+{
+  CoinFingerprint result;
+  if (matrixByColumn_)
+    result.addMatrix(*matrixByColumn_, true, numberThreads_);
+  else
+    result.addDimensions(numberRows_, numberColumns_);
+  result.addModelArrays(numberRows_, numberColumns_, collower_, colupper_,
+			objective_, rowlower_, rowupper_);
+  result.addIntegers(numberColumns_, integerType_);
+  return result;
+}
 // Pass in array saying if each variable integer
 void 
 CoinMpsIO::copyInIntegerInformation(const char * integerType)
@@ -5165,6 +6677,10 @@ CoinMpsIO::copyInIntegerInformation(const char * integerType)
 const char * CoinMpsIO::rowName(int index) const
 {
   if (index>=0&&index<numberRows_) {
+    if (!names_[0]) {
+      snprintf(defaultName_,sizeof(defaultName_),"R%7.7d",index);
+      return defaultName_;
+    }
     return names_[0][index];
   } else {
     return NULL;
@@ -5173,6 +6689,10 @@ const char * CoinMpsIO::rowName(int index) const
 const char * CoinMpsIO::columnName(int index) const
 {
   if (index>=0&&index<numberColumns_) {
+    if (!names_[1]) {
+      snprintf(defaultName_,sizeof(defaultName_),"C%7.7d",index);
+      return defaultName_;
+    }
     return names_[1][index];
   } else {
     return NULL;
@@ -5181,6 +6701,8 @@ const char * CoinMpsIO::columnName(int index) const
 // names - returns -1 if name not found
 int CoinMpsIO::rowIndex(const char * name) const
 {
+  if (!names_[0])
+    return defaultNameIndex(name,'R',numberRows_);
   if (!hash_[0]) {
     if (numberRows_) {
       startHash(0);
@@ -5192,6 +6714,8 @@ int CoinMpsIO::rowIndex(const char * name) const
 }
     int CoinMpsIO::columnIndex(const char * name) const
 {
+  if (!names_[1])
+    return defaultNameIndex(name,'C',numberColumns_);
   if (!hash_[1]) {
     if (numberColumns_) {
       startHash(1);
@@ -5289,13 +6813,17 @@ fileName_(CoinStrdup("????")),
 defaultBound_(1),
 infinity_(COIN_DBL_MAX),
 smallElement_(1.0e-14),
+numberThreads_(1),
+keepNames_(0),
+callback_(NULL),
 defaultHandler_(true),
 cardReader_(NULL),
 convertObjective_(false),
 allowStringElements_(0),
 maximumStringElements_(0),
 numberStringElements_(0),
-stringElements_(NULL)
+stringElements_(NULL),
+modelCache_(NULL)
 {
   numberHash_[0]=0;
   hash_[0]=NULL;
@@ -5336,12 +6864,16 @@ fileName_(CoinStrdup("????")),
 defaultBound_(1),
 infinity_(COIN_DBL_MAX),
 smallElement_(1.0e-14),
+numberThreads_(1),
+keepNames_(0),
+callback_(NULL),
 defaultHandler_(true),
 cardReader_(NULL),
 allowStringElements_(rhs.allowStringElements_),
 maximumStringElements_(rhs.maximumStringElements_),
 numberStringElements_(rhs.numberStringElements_),
-stringElements_(NULL)
+stringElements_(NULL),
+modelCache_(NULL)
 {
   numberHash_[0]=0;
   hash_[0]=NULL;
@@ -5406,6 +6938,8 @@ void CoinMpsIO::gutsOfCopy(const CoinMpsIO & rhs)
   numberHash_[1]=rhs.numberHash_[1];
   defaultBound_=rhs.defaultBound_;
   infinity_=rhs.infinity_;
+  numberThreads_=rhs.numberThreads_;
+  keepNames_=rhs.keepNames_;
   smallElement_ = rhs.smallElement_;
   objectiveOffset_=rhs.objectiveOffset_;
   int section;
@@ -5462,6 +6996,119 @@ CoinMpsIO::operator=(const CoinMpsIO& rhs)
   return *this;
 }
 
+#if COIN_HAS_MOVE
+//-------------------------------------------------------------------
+// Move constructor 
+//-------------------------------------------------------------------
+CoinMpsIO::CoinMpsIO(CoinMpsIO && rhs) COIN_NOEXCEPT
+:
+problemName_(NULL),
+objectiveName_(NULL),
+rhsName_(NULL),
+rangeName_(NULL),
+boundName_(NULL),
+numberRows_(0),
+numberColumns_(0),
+numberElements_(0),
+rowsense_(NULL),
+rhs_(NULL),
+rowrange_(NULL),
+matrixByRow_(NULL),
+matrixByColumn_(NULL),
+rowlower_(NULL),
+rowupper_(NULL),
+collower_(NULL),
+colupper_(NULL),
+objective_(NULL),
+objectiveOffset_(0.0),
+integerType_(NULL),
+fileName_(NULL),
+defaultBound_(1),
+infinity_(COIN_DBL_MAX),
+smallElement_(1.0e-14),
+numberThreads_(1),
+keepNames_(0),
+callback_(NULL),
+handler_(NULL),
+defaultHandler_(true),
+messages_(),
+cardReader_(NULL),
+convertObjective_(false),
+allowStringElements_(0),
+maximumStringElements_(0),
+numberStringElements_(0),
+stringElements_(NULL),
+modelCache_(NULL)
+{
+  numberHash_[0]=0;
+  hash_[0]=NULL;
+  names_[0]=NULL;
+  numberHash_[1]=0;
+  hash_[1]=NULL;
+  names_[1]=NULL;
+  swap(rhs);
+}
+
+//----------------------------------------------------------------
+// Move assignment operator 
+//-------------------------------------------------------------------
+CoinMpsIO &
+CoinMpsIO::operator=(CoinMpsIO&& rhs) COIN_NOEXCEPT
+{
+  swap(rhs);
+  return *this;
+}
+#endif
+
+//-------------------------------------------------------------------
+// Exchange problems - card reader points back to its CoinMpsIO so stays
+//-------------------------------------------------------------------
+void CoinMpsIO::swap(CoinMpsIO & rhs)
+{
+  if (this == &rhs)
+    return;
+  std::swap(problemName_,rhs.problemName_);
+  std::swap(objectiveName_,rhs.objectiveName_);
+  std::swap(rhsName_,rhs.rhsName_);
+  std::swap(rangeName_,rhs.rangeName_);
+  std::swap(boundName_,rhs.boundName_);
+  std::swap(numberRows_,rhs.numberRows_);
+  std::swap(numberColumns_,rhs.numberColumns_);
+  std::swap(numberElements_,rhs.numberElements_);
+  std::swap(rowsense_,rhs.rowsense_);
+  std::swap(rhs_,rhs.rhs_);
+  std::swap(rowrange_,rhs.rowrange_);
+  std::swap(matrixByRow_,rhs.matrixByRow_);
+  std::swap(matrixByColumn_,rhs.matrixByColumn_);
+  std::swap(rowlower_,rhs.rowlower_);
+  std::swap(rowupper_,rhs.rowupper_);
+  std::swap(collower_,rhs.collower_);
+  std::swap(colupper_,rhs.colupper_);
+  std::swap(objective_,rhs.objective_);
+  std::swap(objectiveOffset_,rhs.objectiveOffset_);
+  std::swap(integerType_,rhs.integerType_);
+  std::swap(fileName_,rhs.fileName_);
+  for (int section=0;section<2;section++) {
+    std::swap(names_[section],rhs.names_[section]);
+    std::swap(numberHash_[section],rhs.numberHash_[section]);
+    std::swap(hash_[section],rhs.hash_[section]);
+  }
+  std::swap(defaultBound_,rhs.defaultBound_);
+  std::swap(infinity_,rhs.infinity_);
+  std::swap(smallElement_,rhs.smallElement_);
+  std::swap(numberThreads_,rhs.numberThreads_);
+  std::swap(keepNames_,rhs.keepNames_);
+  std::swap(handler_,rhs.handler_);
+  std::swap(defaultHandler_,rhs.defaultHandler_);
+  messages_.swap(rhs.messages_);
+  std::swap(convertObjective_,rhs.convertObjective_);
+  std::swap(allowStringElements_,rhs.allowStringElements_);
+  std::swap(maximumStringElements_,rhs.maximumStringElements_);
+  std::swap(numberStringElements_,rhs.numberStringElements_);
+  std::swap(stringElements_,rhs.stringElements_);
+  std::swap(modelCache_,rhs.modelCache_);
+}
+
 //-------------------------------------------------------------------
 void CoinMpsIO::gutsOfDestructor()
 {  
@@ -5523,8 +7170,8 @@ void CoinMpsIO::releaseRedundantInformation()
   rowsense_=NULL;
   rhs_=NULL;
   rowrange_=NULL;
-  delete [] hash_[0];
-  delete [] hash_[1];
+  delete hash_[0];
+  delete hash_[1];
   hash_[0]=0;
   hash_[1]=0;
   delete matrixByRow_;
@@ -5546,20 +7193,19 @@ CoinMpsIO::newLanguage(CoinMessages::Language language)
   messages_ = CoinMessage(language);
 }
 
-/* Read in a quadratic objective from the given filename.  
-   If filename is NULL then continues reading from previous file.  If
-   not then the previous file is closed.
-   
-   No assumption is made on symmetry, positive definite etc.
-   No check is made for duplicates or non-triangular
-   
-   Returns number of errors
+/* Reads quadratic section as triples (arrays from malloc, to be freed
+   by caller whatever the return code).  Returns as readQuadraticMps
+   before any symmetry checks.
 */
 int 
-CoinMpsIO::readQuadraticMps(const char * filename,
-			    int * &columnStart, int * &column2, double * &elements,
-			    int checkSymmetry)
+CoinMpsIO::readQuadraticTriples(const char * filename,
+				int * &column, int * &column2Temp,
+				double * &elementTemp, int & numberElements)
 {
+  column = NULL;
+  column2Temp = NULL;
+  elementTemp = NULL;
+  numberElements = 0;
   // Deal with filename - +1 if new, 0 if same as before, -1 if error
   CoinFileInput *input = 0;
   int returnCode = dealWithFileName(filename,"",input);
@@ -5602,12 +7248,11 @@ CoinMpsIO::readQuadraticMps(const char * filename,
   // Guess at size of data
   int maximumNonZeros = 5 *numberColumns_;
   // Use malloc so can use realloc
-  int * column = reinterpret_cast<int *> (malloc(maximumNonZeros*sizeof(int)));
-  int * column2Temp = reinterpret_cast<int *> (malloc(maximumNonZeros*sizeof(int)));
-  double * elementTemp = reinterpret_cast<double *> (malloc(maximumNonZeros*sizeof(double)));
+  column = reinterpret_cast<int *> (malloc(maximumNonZeros*sizeof(int)));
+  column2Temp = reinterpret_cast<int *> (malloc(maximumNonZeros*sizeof(int)));
+  elementTemp = reinterpret_cast<double *> (malloc(maximumNonZeros*sizeof(double)));
 
   startHash(1);
-  int numberElements=0;
 
   while ( cardReader_->nextField (  ) == COIN_QUAD_SECTION ) {
     switch ( cardReader_->mpsType (  ) ) {
@@ -5678,6 +7323,34 @@ CoinMpsIO::readQuadraticMps(const char * filename,
     }
 
   stopHash(1);
+  return numberErrors;
+}
+/* Read in a quadratic objective from the given filename.  
+   If filename is NULL then continues reading from previous file.  If
+   not then the previous file is closed.
+   
+   No assumption is made on symmetry, positive definite etc.
+   No check is made for duplicates or non-triangular
+   
+   Returns number of errors
+*/
+int 
+CoinMpsIO::readQuadraticMps(const char * filename,
+			    int * &columnStart, int * &column2, double * &elements,
+			    int checkSymmetry)
+{
+  int * column;
+  int * column2Temp;
+  double * elementTemp;
+  int numberElements;
+  int numberErrors = readQuadraticTriples(filename,column,column2Temp,
+					  elementTemp,numberElements);
+  if (numberErrors<0||numberErrors>=100000) {
+    free(column);
+    free(column2Temp);
+    free(elementTemp);
+    return numberErrors;
+  }
   // Do arrays as new [] and make column ordered
   columnStart = new int [numberColumns_+1];
   // for counts
@@ -5775,6 +7448,26 @@ CoinMpsIO::readQuadraticMps(const char * filename,
   delete [] count;
   return numberErrors;
 }
+/* Read in a quadratic objective (QUADOBJ or QMATRIX) into a
+   CoinQuadraticMatrix */
+int 
+CoinMpsIO::readQuadraticMps(const char * filename,
+			    CoinQuadraticMatrix & quadratic)
+{
+  int * column;
+  int * column2;
+  double * element;
+  int numberElements;
+  int numberErrors = readQuadraticTriples(filename,column,column2,
+					  element,numberElements);
+  if (numberErrors>=0&&numberErrors<100000)
+    quadratic.setTriples(numberColumns_,numberElements,column2,column,
+			 element,cardReader_->fullQuadratic());
+  free(column);
+  free(column2);
+  free(element);
+  return numberErrors;
+}
 /* Read in a list of cones from the given filename.  
    If filename is NULL (or same) then continues reading from previous file.
    If not then the previous file is closed.  Code should be added to
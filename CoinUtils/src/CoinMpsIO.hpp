@@ -18,7 +18,11 @@
 #include "CoinPackedMatrix.hpp"
 #include "CoinMessageHandler.hpp"
 #include "CoinFileIO.hpp"
+#include "CoinModelCache.hpp"
 class CoinModel;
+class CoinNameHash;
+class CoinWarmStartBasis;
+class CoinQuadraticMatrix;
 
 /// The following lengths are in decreasing order (for 64 bit etc)
 /// Large enough to contain element index
@@ -99,6 +103,9 @@ public:
   inline void setWhichSection(COINSectionType section  ) {
     section_=section;
   }
+  /// True if quadratic section is QMATRIX (both halves of Q given)
+  inline bool fullQuadratic() const
+  { return fullQuadratic_;}
   /// Sees if free format. 
   inline bool freeFormat() const
   { return freeFormat_;}
@@ -153,6 +160,20 @@ public:
   /// Sets whether strings allowed
   inline void setStringsAllowed()
   { stringsAllowed_=true;}
+  /// Whether all names <= 8 characters (so embedded blanks allowed)
+  inline bool eightChar() const
+  { return eightChar_;}
+  /// Sets whether all names <= 8 characters
+  inline void setEightChar(bool yesNo)
+  { eightChar_=yesNo;}
+  /// IEEE format - 0 no, 1 INTEL, 2 not INTEL
+  inline int ieeeFormat() const
+  { return ieeeFormat_;}
+  /// Sets IEEE format
+  inline void setIeeeFormat(int value)
+  { ieeeFormat_=value;}
+  /// Sets section from current card (which must be a section card)
+  COINSectionType sectionFromCard();
   //@}
 
 ////////////////// data //////////////////
@@ -162,8 +183,10 @@ protected:
   //@{
   /// Current value
   double value_;
-  /// Current card image
-  char card_[MAX_CARD_LENGTH];
+  /// Current card image (may point directly into file input)
+  char *card_;
+  /// Buffer for card image when it has to be copied
+  char cardBuffer_[MAX_CARD_LENGTH];
   /// Current position within card image
   char *position_;
   /// End of card
@@ -196,6 +219,8 @@ protected:
   char valueString_[COIN_MAX_FIELD_LENGTH];
   /// Whether strings allowed
   bool stringsAllowed_;
+  /// Whether quadratic section is QMATRIX (both halves given)
+  bool fullQuadratic_;
   //@}
 public:
   /**@name methods */
@@ -315,6 +340,38 @@ protected:
 
 //#############################################################################
 
+/** Callbacks for reading an MPS file a column at a time
+
+    Passed to CoinMpsIO::readMps so a caller can build its own matrix (or
+    skip columns) without CoinMpsIO holding a copy of all the elements.
+    Each column is handed over as soon as all its cards have been read and
+    its elements are then thrown away, so only one column is held at a time.
+    Row and column bounds are handed over once the file has been read.
+    Derive from this and override what is wanted.
+*/
+class CoinMpsCallback {
+public:
+  virtual ~CoinMpsCallback() {}
+  /// Called when ROWS section has been read (objective not included)
+  virtual void rows(int /*numberRows*/, const char * const * /*rowNames*/)
+  { }
+  /** Called for each column when read.  Rows are in order found in file
+      with duplicates added together.  Integer is from MARKER cards only -
+      columnBounds gives final value */
+  virtual void column(int iColumn, const char * name, double objective,
+		      int numberElements, const int * rows,
+		      const double * elements, bool integer) = 0;
+  /// Called for each row after file is read
+  virtual void rowBounds(int /*iRow*/, double /*lower*/, double /*upper*/)
+  { }
+  /// Called for each column after file is read
+  virtual void columnBounds(int /*iColumn*/, double /*lower*/,
+			    double /*upper*/, bool /*integer*/)
+  { }
+};
+
+//#############################################################################
+
 /** MPS IO Interface
 
     This class can be used to read in mps files without a solver.  After
@@ -328,6 +385,7 @@ protected:
 
 class CoinMpsIO {
    friend void CoinMpsIOUnitTest(const std::string & mpsDir);
+   friend class CoinMpsColumnReader;
 
 public:
 
@@ -428,15 +486,26 @@ public:
     */
     const char * integerColumns() const;
 
+    /** Fingerprint of matrix, bounds, objective and integer columns -
+	the same as CoinModel::fingerprint and CoinSnapshot::fingerprint
+	for the same problem.  The matrix is hashed using numberThreads()
+	threads. */
+    CoinFingerprint fingerprint() const;
+
     /** Returns the row name for the specified index.
 
 	Returns 0 if the index is out of range.
+	If row names were not kept (see setKeepNames) the default name
+	(R0000001 style) is returned, which is only valid until the
+	next call.
     */
     const char * rowName(int index) const;
 
     /** Returns the column name for the specified index.
 
 	Returns 0 if the index is out of range.
+	If column names were not kept the default name (C0000001 style)
+	is returned, which is only valid until the next call.
     */
     const char * columnName(int index) const;
 
@@ -564,6 +633,35 @@ public:
     { return smallElement_;}
     inline void setSmallElementValue(double value)
     { smallElement_=value;} 
+    /** Number of threads used to parse COLUMNS section and to format
+        COLUMNS, RHS and BOUNDS in writeMps (default 1).  With more than
+        one writeMps also writes (and compresses) on its own thread and
+        compressed files are decompressed ahead on other threads.
+        More than one only has an effect if built with COINUTILS_PTHREADS */
+    inline int numberThreads() const
+    { return numberThreads_;}
+    /// Set number of threads (1 if not built with threads)
+    void setNumberThreads(int value);
+    /** Which row and column names readMps keeps once the file has been
+        cross-referenced (default 0).
+        - 0 all names
+        - 1 rows (or columns) are only dropped if every name is the
+            default one for its index (R0000000, R0000001, ...), so
+            nothing is lost
+        - 2 no names
+        Dropped names cost no memory; rowName, columnName, rowIndex,
+        columnIndex and writeMps then use default names. */
+    inline int keepNames() const
+    { return keepNames_;}
+    inline void setKeepNames(int value)
+    { keepNames_=value;}
+    /** Cache which readMps(filename,extension) uses for local files
+        (NULL - the default - for none).  Not owned or copied.  See
+        CoinModelCache */
+    inline CoinModelCache * modelCache() const
+    { return modelCache_;}
+    inline void setModelCache(CoinModelCache * cache)
+    { modelCache_=cache;}
 //@}
 
 
@@ -597,6 +695,18 @@ public:
     */
     int readMps(const char *filename, const char *extension = "mps");
 
+    /** Cached model of the file as readMps(filename,extension) would
+	read it, reading it into the model cache if needed.  Not copied
+	and shared with other callers, so read only.  This object is not
+	changed (but messages go to its handler).  NULL if there is no
+	cache or the file can not be cached.
+    */
+    Coin::SmartPtr<CoinCachedModel> viewMps(const char *filename,
+					    const char *extension = "mps") const;
+    /** Replaces model by a copy of that in rhs (as after readMps).
+	Message handler, number of threads and cache are kept */
+    void copyModel(const CoinMpsIO & rhs);
+
     /** Read a problem in MPS format from the given filename.
 
       Use "stdin" or "-" to read from stdin.
@@ -618,6 +728,14 @@ public:
     int readMps();
     /// and
     int readMps(int & numberSets, CoinSet **& sets);
+    /** Read a problem in MPS format passing columns to callback as they
+	are read rather than keeping a matrix.  Afterwards this object has
+	names, bounds and objective but no elements.  Returns as readMps.
+	Bounds are only passed on if the file was read (return code
+	0 or number of errors).
+    */
+    int readMps(const char *filename, const char *extension,
+		CoinMpsCallback & callback);
     /** Read a basis in MPS format from the given filename.
 	If VALUES on NAME card and solution not NULL fills in solution
 	status values as for CoinWarmStartBasis (but one per char)
@@ -625,7 +743,8 @@ public:
 
       Use "stdin" or "-" to read from stdin.
 
-      If sizes of names incorrect - read without names
+      If sizes of names incorrect - read without names.
+      Names are looked up in batches.
     */
     int readBasis(const char *filename, const char *extension ,
 		  double * solution, unsigned char *rowStatus, unsigned char *columnStatus,
@@ -662,14 +781,18 @@ public:
 
     /** Write the problem in MPS format to a file with the given filename.
 
-	\param compression can be set to three values to indicate what kind
+	\param compression can be set to five values to indicate what kind
 	of file should be written
 	<ul>
 	  <li> 0: plain text (default)
 	  <li> 1: gzip compressed (.gz is appended to \c filename)
 	  <li> 2: bzip2 compressed (.bz2 is appended to \c filename) (TODO)
+	  <li> 3: zstd compressed (.zst is appended to \c filename) -
+	  using numberThreads() threads if zstd was built with threads
+	  <li> 4: lz4 compressed (.lz4 is appended to \c filename)
 	</ul>
-	If the library was not compiled with the requested compression then
+	If the library was not compiled with zstd or lz4 then gzip is tried,
+	if not with gzip or bzip2 then the other one, and if neither then
 	writeMps falls back to writing a plain text file.
 
 	\param formatType specifies the precision to used for values in the
@@ -690,6 +813,51 @@ public:
 		 CoinPackedMatrix * quadratic = NULL,
 		 int numberSOS=0,const CoinSet * setInfo=NULL) const;
 
+    /** Write the problem as a binary snapshot to the given filename.
+
+	The snapshot holds matrix, bounds, objective, integer markers and
+	names in native little-endian arrays padded to 8 bytes, so it can be
+	read back (with readBinary) without any text conversion.  Values are
+	written exactly.  Returns 0 if OK, -1 if the file can not be written.
+    */
+    int writeBinary(const char *filename) const;
+
+    /** Write the binary snapshot to \p output (which is left open).
+	Lets the snapshot go somewhere other than a file, e.g. a shared
+	memory segment (see CoinSharedModel).  Returns 0 if OK, -1 if a
+	write failed.
+    */
+    int writeBinary(CoinFileOutput * output) const;
+
+    /** Read a problem written by writeBinary.
+
+	Any current problem is discarded.  Bounds at or beyond the infinity
+	in the file are set to this object's infinity.  Returns 0 if OK,
+	-1 if the file can not be opened, -2 if it is not a valid
+	snapshot and -3 if column starts, lengths or row indices do not
+	fit the sizes in the header (nothing is then loaded).
+    */
+    int readBinary(const char *filename);
+
+    /** Write a basis as a binary file.
+
+	Status is written as packed in CoinWarmStartBasis (2 bits per
+	variable, structurals then artificials) after a header with the
+	sizes and a checksum of the status bytes.  No names are needed.
+	Returns 0 if OK, -1 if the file can not be written.
+    */
+    int writeBasisBinary(const char *filename,
+			 const CoinWarmStartBasis & basis) const;
+
+    /** Read a basis written by writeBasisBinary (the file may have been
+	compressed since).
+
+	Returns 0 if OK, -1 if the file can not be opened and -2 if it is
+	not a valid basis file or the checksum does not match (basis is
+	then unchanged).
+    */
+    int readBasisBinary(const char *filename, CoinWarmStartBasis & basis);
+
     /// Return card reader object so can see what last card was e.g. QUADOBJ
     inline const CoinMpsCardReader * reader() const
     { return cardReader_;}
@@ -725,6 +893,15 @@ public:
 			 int * &columnStart, int * &column, double * &elements,
 			 int checkSymmetry);
 
+    /** Read in a quadratic objective (QUADOBJ or QMATRIX section) into
+	quadratic, which is then column ordered upper triangle with
+	duplicates added.  For QMATRIX (both halves of Q given) the
+	symmetric part is kept.  filename is as for readQuadraticMps above
+	and so are return codes except there is no symmetry checking.
+    */
+    int readQuadraticMps(const char * filename,
+			 CoinQuadraticMatrix & quadratic);
+
     /** Read in a list of cones from the given filename.  
 
       If filename is NULL (or the same as the currently open file) then
@@ -764,6 +941,19 @@ public:
     /// Assignment operator 
     CoinMpsIO & operator=(const CoinMpsIO& rhs);
   
+#if COIN_HAS_MOVE
+    /** Move constructor.  Takes the problem (and message handler) of
+	\p rhs, which may then only be assigned to or destroyed. */
+    CoinMpsIO (CoinMpsIO && rhs) COIN_NOEXCEPT;
+  
+    /// Move assignment (exchanges problems with rhs)
+    CoinMpsIO & operator=(CoinMpsIO&& rhs) COIN_NOEXCEPT;
+  
+#endif
+    /** Exchange problem, names, parameters and message handler with
+	\p rhs.  An open card reader stays with its CoinMpsIO. */
+    void swap(CoinMpsIO & rhs);
+  
     /// Destructor 
     ~CoinMpsIO ();
 //@}
@@ -856,6 +1046,15 @@ protected:
     /// Clears problem data from the CoinMpsIO object.
     void freeAll();
 
+    /// Name i in binary snapshot order (problem, objective, rows, columns)
+    const char * binaryName(int i) const;
+
+    /** Reads quadratic section as triples (malloc'ed, caller frees
+	whatever the return code).  Returns as readQuadraticMps */
+    int readQuadraticTriples(const char * filename,
+			     int * &column, int * &column2,
+			     double * &element, int & numberElements);
+
 
     /** A quick inlined function to convert from lb/ub style constraint
 	definition to sense/rhs/range style */
@@ -893,11 +1092,6 @@ protected:
   //@}
 
   
-  // for hashing
-  typedef struct {
-    int index, next;
-  } CoinHashLink;
-
   /**@name Hash table methods */
   //@{
   /// Creates hash list for names (section = 0 for rows, 1 columns)
@@ -908,6 +1102,9 @@ protected:
   void stopHash ( int section );
   /// Finds match using hash,  -1 not found
   int findHash ( const char *name , int section ) const;
+  /// Finds matches for number names using hash (-1 not found)
+  void findHash ( int number, const char * const * names, int * indices,
+		  int section ) const;
   //@}
 
     /**@name Cached problem information */
@@ -992,7 +1189,7 @@ protected:
       int numberHash_[2];
 
       /// Hash tables (two sections, 0 - row names, 1 - column names)
-      mutable CoinHashLink *hash_[2];
+      mutable CoinNameHash *hash_[2];
     //@}
 
     /** @name CoinMpsIO object parameters */
@@ -1004,6 +1201,14 @@ protected:
       double infinity_;
       /// Small element value
       double smallElement_;
+      /// Number of threads for parsing COLUMNS section
+      int numberThreads_;
+      /// Which names readMps keeps (0 all, 1 all but default, 2 none)
+      int keepNames_;
+      /// Space for a default name when names were not kept
+      mutable char defaultName_[16];
+      /// Where columns go while reading (NULL if kept in matrix)
+      CoinMpsCallback * callback_;
 
       /// Message handler
       CoinMessageHandler * handler_;
@@ -1027,6 +1232,8 @@ protected:
       int numberStringElements_;
       /// String elements
       char ** stringElements_;
+      /// Model cache (not owned)
+      CoinModelCache * modelCache_;
     //@}
 
 };
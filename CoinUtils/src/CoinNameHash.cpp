@@ -0,0 +1,426 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinError.hpp"
+#include "CoinNameHash.hpp"
+
+// Names are hashed in blocks of this size by the batch methods
+#define COIN_NAME_HASH_BLOCK 64
+
+//#############################################################################
+
+CoinNameHash::CoinNameHash() :
+  slot_(NULL),
+  hash_(NULL),
+  offset_(NULL),
+  length_(NULL),
+  string_(NULL),
+  stringSize_(0),
+  stringUsed_(0),
+  stringWasted_(0),
+  numberSlots_(0),
+  maximumIndex_(0),
+  numberNames_(0)
+{
+}
+
+CoinNameHash::CoinNameHash(const CoinNameHash & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinNameHash &
+CoinNameHash::operator=(const CoinNameHash & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+void
+CoinNameHash::swap(CoinNameHash & rhs)
+{
+  std::swap(slot_, rhs.slot_);
+  std::swap(hash_, rhs.hash_);
+  std::swap(offset_, rhs.offset_);
+  std::swap(length_, rhs.length_);
+  std::swap(string_, rhs.string_);
+  std::swap(stringSize_, rhs.stringSize_);
+  std::swap(stringUsed_, rhs.stringUsed_);
+  std::swap(stringWasted_, rhs.stringWasted_);
+  std::swap(numberSlots_, rhs.numberSlots_);
+  std::swap(maximumIndex_, rhs.maximumIndex_);
+  std::swap(numberNames_, rhs.numberNames_);
+}
+
+CoinNameHash::~CoinNameHash()
+{
+  gutsOfDelete();
+}
+
+void
+CoinNameHash::gutsOfDelete()
+{
+  delete [] slot_;
+  delete [] hash_;
+  delete [] offset_;
+  delete [] length_;
+  delete [] string_;
+  slot_ = NULL;
+  hash_ = NULL;
+  offset_ = NULL;
+  length_ = NULL;
+  string_ = NULL;
+  stringSize_ = 0;
+  stringUsed_ = 0;
+  stringWasted_ = 0;
+  numberSlots_ = 0;
+  maximumIndex_ = 0;
+  numberNames_ = 0;
+}
+
+void
+CoinNameHash::gutsOfCopy(const CoinNameHash & rhs)
+{
+  numberSlots_ = rhs.numberSlots_;
+  maximumIndex_ = rhs.maximumIndex_;
+  numberNames_ = rhs.numberNames_;
+  stringSize_ = rhs.stringUsed_;
+  stringUsed_ = rhs.stringUsed_;
+  stringWasted_ = rhs.stringWasted_;
+  slot_ = CoinCopyOfArray(rhs.slot_, numberSlots_);
+  hash_ = CoinCopyOfArray(rhs.hash_, maximumIndex_);
+  offset_ = CoinCopyOfArray(rhs.offset_, maximumIndex_);
+  length_ = CoinCopyOfArray(rhs.length_, maximumIndex_);
+  string_ = CoinCopyOfArray(rhs.string_, stringUsed_);
+}
+
+//#############################################################################
+
+/* 64 bit multiply and shift hash (as MurmurHash64A) taking eight
+   characters at a time.  Values may differ between platforms of different
+   byte order but are only used within one process. */
+CoinUInt64
+CoinNameHash::hashValue(const char * name, int length)
+{
+  const CoinUInt64 multiplier = 0xc6a4a7935bd1e995ULL;
+  const int shift = 47;
+  CoinUInt64 hash = 0x9e3779b97f4a7c15ULL ^
+    (static_cast<CoinUInt64>(length) * multiplier);
+  const char * end = name + (length & ~7);
+  for (; name < end; name += 8) {
+    CoinUInt64 value;
+    memcpy(&value, name, 8);
+    value *= multiplier;
+    value ^= value >> shift;
+    value *= multiplier;
+    hash ^= value;
+    hash *= multiplier;
+  }
+  const int left = length & 7;
+  if (left) {
+    CoinUInt64 value = 0;
+    memcpy(&value, name, left);
+    hash ^= value;
+    hash *= multiplier;
+  }
+  hash ^= hash >> shift;
+  hash *= multiplier;
+  hash ^= hash >> shift;
+  return hash;
+}
+
+//#############################################################################
+
+void
+CoinNameHash::growIndex(int index)
+{
+  if (index < maximumIndex_)
+    return;
+  const int newMaximum = CoinMax(CoinMax(index + 1, 2 * maximumIndex_), 16);
+  CoinUInt64 * hash = new CoinUInt64 [newMaximum];
+  CoinBigIndex * offset = new CoinBigIndex [newMaximum];
+  int * length = new int [newMaximum];
+  CoinMemcpyN(hash_, maximumIndex_, hash);
+  CoinMemcpyN(offset_, maximumIndex_, offset);
+  CoinMemcpyN(length_, maximumIndex_, length);
+  CoinFillN(offset + maximumIndex_, newMaximum - maximumIndex_,
+	    static_cast<CoinBigIndex>(-1));
+  CoinZeroN(length + maximumIndex_, newMaximum - maximumIndex_);
+  delete [] hash_;
+  delete [] offset_;
+  delete [] length_;
+  hash_ = hash;
+  offset_ = offset;
+  length_ = length;
+  maximumIndex_ = newMaximum;
+}
+
+void
+CoinNameHash::growTable(int numberNames)
+{
+  // keep at most half full
+  if (2 * numberNames <= numberSlots_)
+    return;
+  int newSlots = CoinMax(numberSlots_, 16);
+  while (newSlots < 2 * numberNames)
+    newSlots *= 2;
+  delete [] slot_;
+  slot_ = new CoinNameHashSlot [newSlots];
+  numberSlots_ = newSlots;
+  for (int i = 0; i < newSlots; i++)
+    slot_[i].index = -1;
+  const int mask = newSlots - 1;
+  for (int index = 0; index < maximumIndex_; index++) {
+    if (offset_[index] < 0)
+      continue;
+    const CoinUInt64 hash = hash_[index];
+    int iSlot = static_cast<int>(hash & mask);
+    while (slot_[iSlot].index >= 0)
+      iSlot = (iSlot + 1) & mask;
+    slot_[iSlot].index = index;
+    slot_[iSlot].tag = static_cast<unsigned int>(hash >> 32);
+  }
+}
+
+void
+CoinNameHash::growString(CoinBigIndex length)
+{
+  if (stringUsed_ + length <= stringSize_)
+    return;
+  // copy live names (so space of removed ones is recovered)
+  const CoinBigIndex live = stringUsed_ - stringWasted_;
+  const CoinBigIndex newSize =
+    CoinMax(2 * (live + length), static_cast<CoinBigIndex>(1024));
+  char * string = new char [newSize];
+  CoinBigIndex put = 0;
+  for (int index = 0; index < maximumIndex_; index++) {
+    if (offset_[index] < 0)
+      continue;
+    const int size = length_[index] + 1;
+    memcpy(string + put, string_ + offset_[index], size);
+    offset_[index] = put;
+    put += size;
+  }
+  assert (put == live);
+  delete [] string_;
+  string_ = string;
+  stringSize_ = newSize;
+  stringUsed_ = put;
+  stringWasted_ = 0;
+}
+
+int
+CoinNameHash::slotOf(int index) const
+{
+  const int mask = numberSlots_ - 1;
+  int iSlot = static_cast<int>(hash_[index] & mask);
+  while (slot_[iSlot].index != index) {
+    assert (slot_[iSlot].index >= 0);
+    iSlot = (iSlot + 1) & mask;
+  }
+  return iSlot;
+}
+
+int
+CoinNameHash::lookup(const char * name, int length, CoinUInt64 hash) const
+{
+  if (!numberNames_)
+    return -1;
+  const int mask = numberSlots_ - 1;
+  const unsigned int tag = static_cast<unsigned int>(hash >> 32);
+  const CoinNameHashSlot * COIN_RESTRICT slot = slot_;
+  int iSlot = static_cast<int>(hash & mask);
+  while (true) {
+    const int index = slot[iSlot].index;
+    if (index < 0)
+      return -1;
+    if (slot[iSlot].tag == tag && length_[index] == length &&
+	!memcmp(string_ + offset_[index], name, length))
+      return index;
+    iSlot = (iSlot + 1) & mask;
+  }
+}
+
+void
+CoinNameHash::insert(int index, const char * name, int length,
+		     CoinUInt64 hash)
+{
+  assert (index < maximumIndex_ && offset_[index] < 0);
+  assert (2 * (numberNames_ + 1) <= numberSlots_);
+  growString(length + 1);
+  offset_[index] = stringUsed_;
+  memcpy(string_ + stringUsed_, name, length);
+  string_[stringUsed_ + length] = '\0';
+  stringUsed_ += length + 1;
+  length_[index] = length;
+  hash_[index] = hash;
+  const int mask = numberSlots_ - 1;
+  int iSlot = static_cast<int>(hash & mask);
+  while (slot_[iSlot].index >= 0)
+    iSlot = (iSlot + 1) & mask;
+  slot_[iSlot].index = index;
+  slot_[iSlot].tag = static_cast<unsigned int>(hash >> 32);
+  numberNames_++;
+}
+
+//#############################################################################
+
+int
+CoinNameHash::add(int index, const char * name)
+{
+  if (index < 0)
+    throw CoinError("bad index", "add", "CoinNameHash");
+  const int length = CoinStrlenAsInt(name);
+  const CoinUInt64 hash = hashValue(name, length);
+  const int found = lookup(name, length, hash);
+  if (found >= 0)
+    return found;
+  growIndex(index);
+  if (offset_[index] >= 0)
+    remove(index);
+  growTable(numberNames_ + 1);
+  insert(index, name, length, hash);
+  return index;
+}
+
+int
+CoinNameHash::add(int number, const char * const * names, int first,
+		  int * existing)
+{
+  if (number <= 0)
+    return 0;
+  if (first < 0)
+    throw CoinError("bad index", "add", "CoinNameHash");
+  growIndex(first + number - 1);
+  growTable(numberNames_ + number);
+  int numberDuplicates = 0;
+  CoinUInt64 hash[COIN_NAME_HASH_BLOCK];
+  int length[COIN_NAME_HASH_BLOCK];
+  for (int iBlock = 0; iBlock < number; iBlock += COIN_NAME_HASH_BLOCK) {
+    const int n = CoinMin(number - iBlock, COIN_NAME_HASH_BLOCK);
+    const char * const * blockNames = names + iBlock;
+    // hash whole block before probing
+    for (int i = 0; i < n; i++) {
+      if (blockNames[i]) {
+	length[i] = CoinStrlenAsInt(blockNames[i]);
+	hash[i] = hashValue(blockNames[i], length[i]);
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      const int index = first + iBlock + i;
+      int found = -1;
+      if (blockNames[i]) {
+	found = lookup(blockNames[i], length[i], hash[i]);
+	if (found < 0) {
+	  if (offset_[index] >= 0)
+	    remove(index);
+	  insert(index, blockNames[i], length[i], hash[i]);
+	} else if (found == index) {
+	  found = -1;
+	} else {
+	  numberDuplicates++;
+	}
+      }
+      if (existing)
+	existing[iBlock + i] = found;
+    }
+  }
+  return numberDuplicates;
+}
+
+bool
+CoinNameHash::remove(int index)
+{
+  if (index < 0 || index >= maximumIndex_ || offset_[index] < 0)
+    return false;
+  // shift back later entries of cluster which may not be left past hole
+  const int mask = numberSlots_ - 1;
+  int iHole = slotOf(index);
+  int iSlot = iHole;
+  while (true) {
+    iSlot = (iSlot + 1) & mask;
+    const int jIndex = slot_[iSlot].index;
+    if (jIndex < 0)
+      break;
+    const int iHome = static_cast<int>(hash_[jIndex] & mask);
+    // can move if home is not cyclically in (iHole,iSlot]
+    const bool stay = (iHole <= iSlot) ?
+      (iHome > iHole && iHome <= iSlot) : (iHome > iHole || iHome <= iSlot);
+    if (!stay) {
+      slot_[iHole] = slot_[iSlot];
+      iHole = iSlot;
+    }
+  }
+  slot_[iHole].index = -1;
+  stringWasted_ += length_[index] + 1;
+  offset_[index] = -1;
+  length_[index] = 0;
+  numberNames_--;
+  if (!numberNames_) {
+    stringUsed_ = 0;
+    stringWasted_ = 0;
+  }
+  return true;
+}
+
+void
+CoinNameHash::clear()
+{
+  CoinFillN(offset_, maximumIndex_, static_cast<CoinBigIndex>(-1));
+  CoinZeroN(length_, maximumIndex_);
+  for (int i = 0; i < numberSlots_; i++)
+    slot_[i].index = -1;
+  stringUsed_ = 0;
+  stringWasted_ = 0;
+  numberNames_ = 0;
+}
+
+void
+CoinNameHash::reserve(int numberNames, CoinBigIndex numberBytes)
+{
+  if (numberNames > 0) {
+    growIndex(numberNames - 1);
+    growTable(numberNames);
+  }
+  if (numberBytes > 0)
+    growString(numberBytes);
+}
+
+//#############################################################################
+
+int
+CoinNameHash::find(const char * name) const
+{
+  const int length = CoinStrlenAsInt(name);
+  return lookup(name, length, hashValue(name, length));
+}
+
+void
+CoinNameHash::find(int number, const char * const * names,
+		   int * indices) const
+{
+  CoinUInt64 hash[COIN_NAME_HASH_BLOCK];
+  int length[COIN_NAME_HASH_BLOCK];
+  for (int iBlock = 0; iBlock < number; iBlock += COIN_NAME_HASH_BLOCK) {
+    const int n = CoinMin(number - iBlock, COIN_NAME_HASH_BLOCK);
+    const char * const * blockNames = names + iBlock;
+    for (int i = 0; i < n; i++) {
+      length[i] = CoinStrlenAsInt(blockNames[i]);
+      hash[i] = hashValue(blockNames[i], length[i]);
+    }
+    for (int i = 0; i < n; i++)
+      indices[iBlock + i] = lookup(blockNames[i], length[i], hash[i]);
+  }
+}
@@ -0,0 +1,139 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinNameHash_H
+#define CoinNameHash_H
+
+#include <cstddef>
+
+#include "CoinTypes.hpp"
+
+/** Hash index from names to integer indices
+
+    Shared by CoinModel, CoinMpsIO and CoinLpIO for row and column names.
+    Names are copied into one contiguous character buffer and the table
+    uses open addressing with linear probing (kept at most half full), so
+    a lookup is normally one slot and one name compare.  Each slot keeps
+    32 bits of the 64 bit hash as a tag and each index its name length, so
+    names which only collide in the table are nearly always rejected
+    without touching the characters.
+
+    Each index has at most one name and each name at most one index.
+    Names are removed by backward shifting so there are no tombstones.
+    Lookups do not change the object so may be done from several threads.
+*/
+class CoinNameHash {
+public:
+  /**@name Adding and removing names */
+  //@{
+  /** Adds name as index.  If an equal name is already in the hash its
+      index is returned and nothing is added, else index is returned.  Any
+      old name of index is removed first.  name must not be one returned
+      by name() as the buffer may move */
+  int add(int index, const char * name);
+  /** Adds names[i] as index first+i (NULL names are skipped).  If
+      existing is given existing[i] is set to index of an equal name
+      already in the hash (names[i] not added) or -1.  Returns number not
+      added because of duplicates */
+  int add(int number, const char * const * names, int first = 0,
+	  int * existing = NULL);
+  /// Removes name of index.  Returns false if it had none
+  bool remove(int index);
+  /// Removes all names (keeps space)
+  void clear();
+  /// Makes room for numberNames names with numberBytes characters in all
+  void reserve(int numberNames, CoinBigIndex numberBytes = 0);
+  //@}
+
+  /**@name Lookups */
+  //@{
+  /// Returns index of name or -1
+  int find(const char * name) const;
+  /// Sets indices[i] to index of names[i] or -1
+  void find(int number, const char * const * names, int * indices) const;
+  /// Name of index (or NULL)
+  inline const char * name(int index) const
+  { return (index >= 0 && index < maximumIndex_ && offset_[index] >= 0) ?
+      string_ + offset_[index] : NULL;}
+  /// Number of names
+  inline int numberNames() const
+  { return numberNames_;}
+  /// One more than largest index which may have a name
+  inline int maximumIndex() const
+  { return maximumIndex_;}
+  /// Hash value of name of given length
+  static CoinUInt64 hashValue(const char * name, int length);
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinNameHash();
+  /// Copy constructor
+  CoinNameHash(const CoinNameHash & rhs);
+  /// Assignment
+  CoinNameHash & operator=(const CoinNameHash & rhs);
+  /// Exchange contents (no copying)
+  void swap(CoinNameHash & rhs);
+  /// Destructor
+  ~CoinNameHash();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinNameHash & rhs);
+  /// Makes index valid
+  void growIndex(int index);
+  /// Makes room in table for numberNames names
+  void growTable(int numberNames);
+  /// Makes room for length more characters (compacting if worth it)
+  void growString(CoinBigIndex length);
+  /// Slot holding index (which must have a name)
+  int slotOf(int index) const;
+  /// Index of name with given hash and length or -1
+  int lookup(const char * name, int length, CoinUInt64 hash) const;
+  /// Adds name with given hash and length (not in hash) as index
+  void insert(int index, const char * name, int length, CoinUInt64 hash);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Slot of table
+  typedef struct {
+    /// Index or -1 if empty
+    int index;
+    /// High 32 bits of hash
+    unsigned int tag;
+  } CoinNameHashSlot;
+  /// Table (power of two slots)
+  CoinNameHashSlot * slot_;
+  /// Hash of name of each index
+  CoinUInt64 * hash_;
+  /// Offset of name of each index in string_ (or -1)
+  CoinBigIndex * offset_;
+  /// Length of name of each index
+  int * length_;
+  /// Names (each followed by a null)
+  char * string_;
+  /// Characters in string_
+  CoinBigIndex stringSize_;
+  /// Characters used in string_
+  CoinBigIndex stringUsed_;
+  /// Characters used in string_ by removed names
+  CoinBigIndex stringWasted_;
+  /// Number of slots
+  int numberSlots_;
+  /// Size of index arrays
+  int maximumIndex_;
+  /// Number of names
+  int numberNames_;
+  //@}
+};
+
+#endif
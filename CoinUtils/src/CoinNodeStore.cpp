@@ -0,0 +1,183 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinArena.hpp"
+#include "CoinNodeStore.hpp"
+#include "CoinSearchTree.hpp"
+
+//#############################################################################
+
+CoinNodeStore::CoinNodeStore(size_t memoryCap)
+  : records_()
+  , freeHandles_()
+  , arena_(new CoinArena)
+  , spill_(NULL)
+  , spillName_(NULL)
+  , spillEnd_(0)
+  , memoryCap_(memoryCap)
+  , numberLive_(0)
+  , numberLiveFile_(0)
+  , liveMemory_(0)
+  , deadMemory_(0)
+  , liveFile_(0)
+  , numberSpilled_(0)
+{
+}
+
+CoinNodeStore::~CoinNodeStore()
+{
+  delete arena_;
+  if (spill_) {
+    fclose(spill_);
+    if (spillName_)
+      remove(spillName_);
+  }
+  delete[] spillName_;
+}
+
+void CoinNodeStore::setSpillFile(const char *name)
+{
+  assert(!spill_);
+  delete[] spillName_;
+  spillName_ = NULL;
+  if (name) {
+    spillName_ = new char[strlen(name) + 1];
+    strcpy(spillName_, name);
+  }
+}
+
+bool CoinNodeStore::openSpill()
+{
+  if (!spill_) {
+    if (spillName_)
+      spill_ = fopen(spillName_, "w+b");
+    else
+      spill_ = tmpfile();
+  }
+  return spill_ != NULL;
+}
+
+//#############################################################################
+
+int CoinNodeStore::store(const void *data, int bytes)
+{
+  record r;
+  r.data = NULL;
+  r.offset = -1;
+  r.size = bytes;
+  /*
+    Spill if over the cap (and the file can be had), else keep in memory.
+  */
+  bool toFile = false;
+  if (memoryCap_ && liveMemory_ + bytes > memoryCap_ && openSpill()) {
+    if (!numberLiveFile_)
+      spillEnd_ = 0;
+    if (fseek(spill_, spillEnd_, SEEK_SET) == 0 && fwrite(data, 1, bytes, spill_) == static_cast<size_t>(bytes)) {
+      r.offset = spillEnd_;
+      spillEnd_ += bytes;
+      numberLiveFile_++;
+      liveFile_ += bytes;
+      numberSpilled_++;
+      toFile = true;
+    }
+  }
+  if (!toFile) {
+    r.data = static_cast<char *>(arena_->allocate(bytes > 0 ? bytes : 1, 8));
+    memcpy(r.data, data, bytes);
+    liveMemory_ += bytes;
+  }
+  numberLive_++;
+  int handle;
+  if (freeHandles_.empty()) {
+    handle = static_cast<int>(records_.size());
+    records_.push_back(r);
+  } else {
+    handle = freeHandles_.back();
+    freeHandles_.pop_back();
+    records_[handle] = r;
+  }
+  return handle;
+}
+
+void CoinNodeStore::load(int handle, void *data) const
+{
+  const record &r = records_[handle];
+  if (r.data) {
+    memcpy(data, r.data, r.size);
+  } else {
+    bool ok = fseek(spill_, r.offset, SEEK_SET) == 0 && fread(data, 1, r.size, spill_) == static_cast<size_t>(r.size);
+    assert(ok);
+    if (!ok)
+      memset(data, 0, r.size);
+  }
+}
+
+void CoinNodeStore::release(int handle)
+{
+  record &r = records_[handle];
+  if (r.data) {
+    liveMemory_ -= r.size;
+    deadMemory_ += r.size;
+  } else {
+    numberLiveFile_--;
+    liveFile_ -= r.size;
+  }
+  r.data = NULL;
+  r.offset = -1;
+  r.size = 0;
+  numberLive_--;
+  freeHandles_.push_back(handle);
+  if (deadMemory_ > liveMemory_ && deadMemory_ > 65536)
+    compact();
+}
+
+void CoinNodeStore::compact()
+{
+  CoinArena *arena = new CoinArena;
+  for (size_t i = 0; i < records_.size(); i++) {
+    record &r = records_[i];
+    if (r.data) {
+      char *data = static_cast<char *>(arena->allocate(r.size > 0 ? r.size : 1, 8));
+      memcpy(data, r.data, r.size);
+      r.data = data;
+    }
+  }
+  delete arena_;
+  arena_ = arena;
+  deadMemory_ = 0;
+}
+
+//#############################################################################
+
+bool CoinNodeStore::storeNode(CoinTreeNode *node)
+{
+  if (node->storeHandle_ >= 0)
+    return false;
+  const int bytes = node->packedSize();
+  if (bytes < 0)
+    return false;
+  char *data = new char[bytes > 0 ? bytes : 1];
+  node->pack(data);
+  node->storeHandle_ = store(data, bytes);
+  delete[] data;
+  return true;
+}
+
+void CoinNodeStore::unstoreNode(CoinTreeNode *node)
+{
+  const int handle = node->storeHandle_;
+  if (handle < 0)
+    return;
+  const int bytes = size(handle);
+  char *data = new char[bytes > 0 ? bytes : 1];
+  load(handle, data);
+  release(handle);
+  node->storeHandle_ = -1;
+  node->unpack(data, bytes);
+  delete[] data;
+}
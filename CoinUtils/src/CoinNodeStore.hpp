@@ -0,0 +1,138 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinNodeStore_H
+#define CoinNodeStore_H
+
+#include <cstdio>
+#include <vector>
+
+class CoinArena;
+class CoinTreeNode;
+
+/** Packed storage for search tree nodes which are not needed for a while.
+
+    A node which supports packing (CoinTreeNode::packedSize() is not
+    negative) writes its description - typically the bound changes and the
+    warm start diff against its parent - as bytes, and frees it. The bytes
+    go into a CoinArena; once the arena holds more than the memory cap,
+    new records go to a spill file instead. unstoreNode() reads the record
+    back and hands it to CoinTreeNode::unpack().
+
+    A search tree given a store (CoinSearchTreeBase::setNodeStore) packs
+    the nodes it pushes below the top once it holds more than a given
+    number, and unpacks a node when it reaches the top, so the rest of
+    the code never sees a packed node. Node depth, quality and so on stay
+    in memory for the comparisons.
+
+    Space of released records is reused: the arena is compacted when more
+    than half of it is dead, and the spill file is rewound when no record
+    in it is live. Not thread safe - use one store per tree.
+*/
+class CoinNodeStore {
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /** Default constructor. With \p memoryCap 0 (the default) nothing is
+      spilled to file. */
+  CoinNodeStore(size_t memoryCap = 0);
+  /// Destructor - closes and removes the spill file
+  ~CoinNodeStore();
+  //@}
+
+  /**@name Records */
+  //@{
+  /// Store \p bytes bytes and return the handle
+  int store(const void *data, int bytes);
+  /// Size of record
+  inline int size(int handle) const
+  {
+    return records_[handle].size;
+  }
+  /// Copy record to data (size(handle) bytes)
+  void load(int handle, void *data) const;
+  /// Forget record
+  void release(int handle);
+  //@}
+
+  /**@name Nodes */
+  //@{
+  /** Pack node and free its description. Returns false (and does
+      nothing) if the node does not support packing or is stored. */
+  bool storeNode(CoinTreeNode *node);
+  /// Unpack node if it is stored
+  void unstoreNode(CoinTreeNode *node);
+  //@}
+
+  /**@name Settings and statistics */
+  //@{
+  /// Bytes kept in memory before spilling (0 never spill)
+  inline void setMemoryCap(size_t value)
+  {
+    memoryCap_ = value;
+  }
+  inline size_t memoryCap() const
+  {
+    return memoryCap_;
+  }
+  /** Spill to file \p name rather than an anonymous temporary file. Must
+      be set before anything is spilled. */
+  void setSpillFile(const char *name);
+  /// Number of live records
+  inline int numberRecords() const
+  {
+    return numberLive_;
+  }
+  /// Bytes in live records in memory
+  inline size_t bytesInMemory() const
+  {
+    return liveMemory_;
+  }
+  /// Bytes in live records on file
+  inline size_t bytesOnFile() const
+  {
+    return liveFile_;
+  }
+  /// Records ever written to file
+  inline int numberSpilled() const
+  {
+    return numberSpilled_;
+  }
+  //@}
+
+private:
+  CoinNodeStore(const CoinNodeStore &);
+  CoinNodeStore &operator=(const CoinNodeStore &);
+
+  /// One record - in memory (data) or on file (offset)
+  struct record {
+    char *data;
+    long offset;
+    int size;
+  };
+  /// Copies live records to a new arena
+  void compact();
+  /// Opens the spill file if not open
+  bool openSpill();
+
+  std::vector<record> records_;
+  /// Handles free for reuse
+  std::vector<int> freeHandles_;
+  CoinArena *arena_;
+  FILE *spill_;
+  /// Name if spill file not anonymous
+  char *spillName_;
+  /// End of data in spill file
+  long spillEnd_;
+  size_t memoryCap_;
+  int numberLive_;
+  int numberLiveFile_;
+  size_t liveMemory_;
+  size_t deadMemory_;
+  size_t liveFile_;
+  int numberSpilled_;
+};
+
+#endif
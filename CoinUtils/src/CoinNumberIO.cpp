@@ -0,0 +1,293 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+
+#include "CoinPragma.hpp"
+#include "CoinTypes.hpp"
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinNumberIO.hpp"
+
+namespace {
+  // Powers of ten which are exact as doubles
+  const double exactPower[] =
+  {1.0e0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,1.0e6,1.0e7,1.0e8,1.0e9,1.0e10,
+   1.0e11,1.0e12,1.0e13,1.0e14,1.0e15,1.0e16,1.0e17,1.0e18,1.0e19,1.0e20,
+   1.0e21,1.0e22};
+  // 2^53 - all integers up to this are exact
+  const double twoTo53 = 9007199254740992.0;
+  // Significant digits kept (so fits in signed 64 bit as well)
+  const int maximumDigits = 18;
+#if defined(LDBL_MANT_DIG) && LDBL_MANT_DIG >= 64
+#define COIN_NUMBER_LONG_DOUBLE
+  // Powers of ten which are exact in 64 bit mantissa
+  const long double exactLongPower[] =
+  {1.0e0L,1.0e1L,1.0e2L,1.0e3L,1.0e4L,1.0e5L,1.0e6L,1.0e7L,1.0e8L,1.0e9L,
+   1.0e10L,1.0e11L,1.0e12L,1.0e13L,1.0e14L,1.0e15L,1.0e16L,1.0e17L,1.0e18L,
+   1.0e19L,1.0e20L,1.0e21L,1.0e22L,1.0e23L,1.0e24L,1.0e25L,1.0e26L,1.0e27L};
+  /* Mantissa is exact in long double as is power so one rounding to
+     64 bits.  Rounding that to 53 bits is then correct unless extra 11
+     bits are next to half way.  Returns false if not sure. */
+  bool longDoubleValue(CoinUInt64 mantissa, int exponent, double & value)
+  {
+    if (exponent<-27||exponent>27)
+      return false;
+    long double result = static_cast<long double>(mantissa);
+    if (exponent>=0)
+      result *= exactLongPower[exponent];
+    else
+      result /= exactLongPower[-exponent];
+    int power;
+    long double fraction = frexpl(result,&power);
+    CoinUInt64 bits = static_cast<CoinUInt64>(ldexpl(fraction,62));
+    int extra = static_cast<int>(bits&511);
+    if (extra>=255&&extra<=257)
+      return false;
+    value = static_cast<double>(result);
+    return true;
+  }
+#endif
+}
+
+double CoinStrtod(const char * string, char ** end)
+{
+  const char * ptr = string;
+  while (*ptr==' '||*ptr=='\t')
+    ptr++;
+  bool negative = false;
+  if (*ptr=='-') {
+    negative = true;
+    ptr++;
+  } else if (*ptr=='+') {
+    ptr++;
+  }
+  // leave hex and anything odd to library
+  if (ptr[0]=='0'&&(ptr[1]=='x'||ptr[1]=='X'))
+    return strtod(string,end);
+  CoinUInt64 mantissa = 0;
+  int numberDigits = 0;
+  int exponent = 0;
+  bool anyDigits = false;
+  // true if non zero digits have been dropped
+  bool truncated = false;
+  while (*ptr>='0'&&*ptr<='9') {
+    anyDigits = true;
+    int digit = *ptr - '0';
+    if (numberDigits<maximumDigits) {
+      mantissa = 10*mantissa + digit;
+      if (mantissa)
+	numberDigits++;
+    } else {
+      exponent++;
+      if (digit)
+	truncated = true;
+    }
+    ptr++;
+  }
+  if (*ptr=='.') {
+    ptr++;
+    while (*ptr>='0'&&*ptr<='9') {
+      anyDigits = true;
+      int digit = *ptr - '0';
+      if (numberDigits<maximumDigits) {
+	mantissa = 10*mantissa + digit;
+	if (mantissa)
+	  numberDigits++;
+	exponent--;
+      } else if (digit) {
+	truncated = true;
+      }
+      ptr++;
+    }
+  }
+  if (!anyDigits)
+    return strtod(string,end);
+  if (*ptr=='e'||*ptr=='E') {
+    const char * ePtr = ptr + 1;
+    bool negativeExponent = false;
+    if (*ePtr=='-') {
+      negativeExponent = true;
+      ePtr++;
+    } else if (*ePtr=='+') {
+      ePtr++;
+    }
+    if (*ePtr>='0'&&*ePtr<='9') {
+      int value = 0;
+      while (*ePtr>='0'&&*ePtr<='9') {
+	if (value<100000)
+	  value = 10*value + (*ePtr - '0');
+	ePtr++;
+      }
+      exponent += negativeExponent ? -value : value;
+      ptr = ePtr;
+    }
+  }
+  if (end)
+    *end = const_cast<char *>(ptr);
+  double value;
+  if (!mantissa) {
+    value = 0.0;
+  } else {
+    bool done = false;
+    if (!truncated&&static_cast<double>(mantissa)<=twoTo53) {
+      if (exponent>22&&exponent<=22+15) {
+	// may be able to move some of power into mantissa
+	while (exponent>22&&static_cast<double>(mantissa)<=twoTo53*0.1) {
+	  mantissa *= 10;
+	  exponent--;
+	}
+      }
+      if (exponent>=0&&exponent<=22) {
+	value = static_cast<double>(mantissa)*exactPower[exponent];
+	done = true;
+      } else if (exponent<0&&exponent>=-22) {
+	value = static_cast<double>(mantissa)/exactPower[-exponent];
+	done = true;
+      }
+    }
+#ifdef COIN_NUMBER_LONG_DOUBLE
+    if (!done&&!truncated)
+      done = longDoubleValue(mantissa,exponent,value);
+#endif
+    if (!done) {
+      // slow but correctly rounded
+      char * dummy;
+      value = fabs(strtod(string,&dummy));
+    }
+  }
+  return negative ? -value : value;
+}
+
+namespace {
+  // Puts digits of value (non zero) backwards and returns number
+  int putDigits(CoinUInt64 value, char * buffer)
+  {
+    int n = 0;
+    while (value) {
+      buffer[n++] = static_cast<char>('0' + static_cast<int>(value%10));
+      value /= 10;
+    }
+    return n;
+  }
+}
+
+int CoinFormatDouble(double value, char * buffer)
+{
+  if (!CoinFinite(value))
+    return sprintf(buffer,"%g",value);
+  char * put = buffer;
+  double absValue = fabs(value);
+  if (value<0.0||(value==0.0&&1.0/value<0.0))
+    *put++ = '-';
+  if (!absValue) {
+    *put++ = '0';
+    *put = '\0';
+    return static_cast<int>(put-buffer);
+  }
+  if (absValue>=1.0e-5&&absValue<twoTo53) {
+    /* Find fewest decimal places which read back exactly - as mantissa is
+       below 2^53 and power at most 22 the check is the same division
+       CoinStrtod (or any correct strtod) would do */
+    for (int places=0;places<=22;places++) {
+      double scaled = absValue*exactPower[places];
+      if (scaled>=twoTo53)
+	break;
+      CoinUInt64 mantissa = static_cast<CoinUInt64>(scaled+0.5);
+      if (static_cast<double>(mantissa)/exactPower[places]!=absValue)
+	continue;
+      char digits[24];
+      int numberDigits = putDigits(mantissa,digits);
+      // leading 0. and zeros if needed
+      int length = numberDigits>places ? numberDigits : places+1;
+      if (places)
+	length++;
+      if (length+(put-buffer)>23)
+	break;
+      int i = numberDigits>places ? numberDigits : places+1;
+      while (i>places) {
+	i--;
+	*put++ = i<numberDigits ? digits[i] : '0';
+      }
+      if (places) {
+	*put++ = '.';
+	for (i=places-1;i>=0;i--)
+	  *put++ = i<numberDigits ? digits[i] : '0';
+      }
+      *put = '\0';
+      return static_cast<int>(put-buffer);
+    }
+  }
+  // Large, tiny or awkward - use library and see how many digits needed
+  char temp[40];
+  // denormals may need few digits
+  for (int precision=absValue<COIN_DBL_MIN ? 1 : 15;precision<=17;precision++) {
+    sprintf(temp,"%.*e",precision-1,absValue);
+    if (precision==17||strtod(temp,NULL)==absValue)
+      break;
+  }
+  // mantissa digits without point
+  char digits[24];
+  int numberDigits = 0;
+  const char * get = temp;
+  for (;*get!='e';get++) {
+    if (*get!='.')
+      digits[numberDigits++] = *get;
+  }
+  int exponent = atoi(get+1);
+  // drop trailing zeros
+  while (numberDigits>1&&digits[numberDigits-1]=='0')
+    numberDigits--;
+  if (exponent>=-5&&exponent<17) {
+    // no exponent needed
+    int length = exponent>=0 ? CoinMax(numberDigits,exponent+1) : numberDigits-exponent;
+    if (length+(numberDigits>exponent+1 ? 1 : 0)+(put-buffer)<=23) {
+      if (exponent<0) {
+	*put++ = '0';
+	*put++ = '.';
+	for (int i=-1;i>exponent;i--)
+	  *put++ = '0';
+	memcpy(put,digits,numberDigits);
+	put += numberDigits;
+      } else {
+	for (int i=0;i<=exponent;i++)
+	  *put++ = i<numberDigits ? digits[i] : '0';
+	if (numberDigits>exponent+1) {
+	  *put++ = '.';
+	  memcpy(put,digits+exponent+1,numberDigits-exponent-1);
+	  put += numberDigits-exponent-1;
+	}
+      }
+      *put = '\0';
+      return static_cast<int>(put-buffer);
+    }
+  }
+  // d.ddde-x unless too long in which case dddde-y
+  char tail[8];
+  int tailLength = sprintf(tail,"%d",exponent);
+  if ((put-buffer)+numberDigits+(numberDigits>1 ? 1 : 0)+1+tailLength>23) {
+    exponent -= numberDigits-1;
+    tailLength = sprintf(tail,"%d",exponent);
+    memcpy(put,digits,numberDigits);
+    put += numberDigits;
+  } else {
+    *put++ = digits[0];
+    if (numberDigits>1) {
+      *put++ = '.';
+      memcpy(put,digits+1,numberDigits-1);
+      put += numberDigits-1;
+    }
+  }
+  *put++ = 'e';
+  memcpy(put,tail,tailLength+1);
+  put += tailLength;
+  return static_cast<int>(put-buffer);
+}
@@ -0,0 +1,31 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+/* Fast conversion of decimal numbers to and from text for the model
+   readers and writers.  Both are exact - CoinStrtod is correctly rounded
+   and CoinFormatDouble gives a string which reads back to the same
+   double.  Common cases are done with integer arithmetic and one
+   floating point operation; anything else goes to the C library. */
+
+#ifndef CoinNumberIO_H
+#define CoinNumberIO_H
+
+/** As strtod (decimal numbers), but faster.
+
+    Numbers with at most 18 significant digits which are exactly a double
+    times a power of ten up to 22 are converted directly (Clinger's fast
+    path), otherwise strtod is called.  Leading blanks and tabs are
+    skipped.  If end is not NULL it is set to the first character not used
+    (to string if no number was found).
+*/
+double CoinStrtod(const char * string, char ** end);
+
+/** Writes shortest string which CoinStrtod (or strtod) reads back as
+    value.  Output uses no blanks and at most 23 characters, so buffer
+    must have room for 24.  Returns length of string.
+*/
+int CoinFormatDouble(double value, char * buffer);
+
+#endif
@@ -418,6 +418,17 @@ CoinOslFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
 #endif
   return returnCode;
 }
+// Makes sure there is room for a factorization with this many rows
+void 
+CoinOslWorkArea::reserve(int numberRows)
+{
+  if (numberRows>numberRows_) {
+    // nonzero marks must start as zero
+    nonzero_ = CoinArrayWithLength(numberRows+2,1);
+    spare_ = CoinIntArrayWithLength(3*numberRows+6,0);
+    numberRows_ = numberRows;
+  }
+}
 /* This version has same effect as above with FTUpdate==false
    so number returned is always >=0 */
 int 
@@ -435,12 +446,33 @@ CoinOslFactorization::updateColumn ( CoinIndexedVector * regionSparse,
       assert (dluval[mcstrt[ndo]+1]<1.0e50);
   }
 #endif
+  return updateColumn(factInfo_,regionSparse,regionSparse2);
+}
+/* As updateColumn but all scratch is in regionSparse and work
+   so several threads may do this at once */
+int 
+CoinOslFactorization::updateColumn ( CoinIndexedVector * regionSparse,
+				     CoinIndexedVector * regionSparse2,
+				     CoinOslWorkArea & work) const
+{
+  work.reserve(numberRows_);
+  EKKfactinfo fact = factInfo_;
+  fact.nonzero = work.nonzero();
+  fact.kp1adr = reinterpret_cast<EKKHlink *>(work.spare());
+  return updateColumn(fact,regionSparse,regionSparse2);
+}
+// Does FTRAN with given copy of factorization information
+int 
+CoinOslFactorization::updateColumn ( const EKKfactinfo & fact,
+				     CoinIndexedVector * regionSparse,
+				     CoinIndexedVector * regionSparse2) const
+{
   assert (numberRows_==numberColumns_);
   double *region2 = regionSparse2->denseVector (  );
   int *regionIndex2 = regionSparse2->getIndices (  );
   int numberNonZero = regionSparse2->getNumElements (  );
   double *region = regionSparse->denseVector (  );
-  //const int * permuteIn = factInfo_.mpermu+1;
+  //const int * permuteIn = fact.mpermu+1;
   // Stuff is put one up so won't get illegal read
   assert (!region[numberRows_]);
   assert (!regionSparse2->packedMode());
@@ -454,7 +486,7 @@ CoinOslFactorization::updateColumn ( CoinIndexedVector * regionSparse,
     region2[jRow]=0.0;
   }
 #endif
-  numberNonZero=c_ekkftrn(&factInfo_,
+  numberNonZero=c_ekkftrn(&fact,
 			region2-1,region,regionIndex2,numberNonZero);
   regionSparse2->setNumElements(numberNonZero);
   return 0;
@@ -546,6 +578,28 @@ CoinOslFactorization::updateTwoColumnsFT(CoinIndexedVector * regionSparse1,
 int  
 CoinOslFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
 						CoinIndexedVector * regionSparse2) const
+{
+  EKKfactinfo fact = factInfo_;
+  return updateColumnTranspose(fact,regionSparse,regionSparse2);
+}
+/* As updateColumnTranspose but all scratch is in regionSparse and work
+   so several threads may do this at once */
+int  
+CoinOslFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
+					      CoinIndexedVector * regionSparse2,
+					      CoinOslWorkArea & work) const
+{
+  work.reserve(numberRows_);
+  EKKfactinfo fact = factInfo_;
+  fact.nonzero = work.nonzero();
+  fact.kp1adr = reinterpret_cast<EKKHlink *>(work.spare());
+  return updateColumnTranspose(fact,regionSparse,regionSparse2);
+}
+// Does BTRAN with given copy of factorization information
+int  
+CoinOslFactorization::updateColumnTranspose ( EKKfactinfo & fact,
+					      CoinIndexedVector * regionSparse,
+					      CoinIndexedVector * regionSparse2) const
 {
   assert (numberRows_==numberColumns_);
   double *region2 = regionSparse2->denseVector (  );
@@ -553,31 +607,30 @@ CoinOslFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
   int numberNonZero = regionSparse2->getNumElements (  );
   //double *region = regionSparse->denseVector (  );
   /*int *regionIndex = regionSparse->getIndices (  );*/
-  const int * permuteIn = factInfo_.mpermu+1;
-  factInfo_.packedMode = regionSparse2->packedMode() ? 1 : 0;
+  const int * permuteIn = fact.mpermu+1;
+  fact.packedMode = regionSparse2->packedMode() ? 1 : 0;
   // Use region instead of dpermu
-  double * save =factInfo_.kadrpm;
-  factInfo_.kadrpm=regionSparse->denseVector()-1;
+  fact.kadrpm=regionSparse->denseVector()-1;
   // use internal one for now (address is one off)
-  double * region = factInfo_.kadrpm;
+  double * region = fact.kadrpm;
   if (numberNonZero<2) {
     if (numberNonZero) {
       int ipivrw=regionIndex2[0];
-      if (factInfo_.packedMode) {
+      if (fact.packedMode) {
 	double value=region2[0];
 	region2[0]=0.0;
 	region2[ipivrw]=value;
       }
-      numberNonZero=c_ekkbtrn_ipivrw(&factInfo_, region2-1,
+      numberNonZero=c_ekkbtrn_ipivrw(&fact, region2-1,
 				   regionIndex2-1,ipivrw+1,
-				   reinterpret_cast<int *>(factInfo_.kp1adr));
+				   reinterpret_cast<int *>(fact.kp1adr));
     }
   } else {
 #ifndef NDEBUG    
     {
-      int *mcstrt	= factInfo_.xcsadr;
-      int * hpivco_new=factInfo_.kcpadr+1;
-      int nrow=factInfo_.nrow;
+      int *mcstrt	= fact.xcsadr;
+      int * hpivco_new=fact.kcpadr+1;
+      int nrow=fact.nrow;
       int i;
       int ipiv = hpivco_new[0];
       int last = mcstrt[ipiv];
@@ -590,9 +643,9 @@ CoinOslFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
 #endif
     int iSmallest = COIN_INT_MAX;
     int iPiv=0;
-    const int *mcstrt	= factInfo_.xcsadr;
+    const int *mcstrt	= fact.xcsadr;
     // permute and save where nonzeros are
-    if (!factInfo_.packedMode) {
+    if (!fact.packedMode) {
       if ((numberRows_<200||(numberNonZero<<4)>numberRows_)) {
 	for (int j=0;j<numberNonZero;j++) {
 	  int jRow = regionIndex2[j];
@@ -624,10 +677,8 @@ CoinOslFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
       }
     }
     assert (iPiv>=0);
-    numberNonZero=c_ekkbtrn(&factInfo_, region2-1,regionIndex2-1,iPiv);
+    numberNonZero=c_ekkbtrn(&fact, region2-1,regionIndex2-1,iPiv);
   }
-  factInfo_.kadrpm=save;
-  factInfo_.packedMode=0;
   regionSparse2->setNumElements(numberNonZero);
   return 0;
 }
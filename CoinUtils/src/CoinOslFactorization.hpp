@@ -103,6 +103,33 @@ typedef struct _EKKfactinfo {
   int maxNNetas;
 } EKKfactinfo;
 
+/** Scratch used by solves of a CoinOslFactorization.
+    Factorization itself keeps one copy of this so plain solves use it.
+    To solve from several threads against one factorization (which is not
+    being changed) give each thread its own CoinOslWorkArea and use
+    the updateColumn and updateColumnTranspose methods which take it.
+*/
+class CoinOslWorkArea {
+public:
+  /// Default constructor
+  CoinOslWorkArea() : numberRows_(0) {}
+  /// Makes sure there is room for a factorization with this many rows
+  void reserve(int numberRows);
+  /// Nonzero marks (must be zero between solves)
+  inline char * nonzero() const
+  { return numberRows_ ? const_cast<char *>(nonzero_.array()) : NULL; }
+  /// Lists and stacks for sparse solves
+  inline int * spare() const
+  { return numberRows_ ? spare_.array() : NULL; }
+private:
+  /// Number of rows there is room for
+  int numberRows_;
+  /// Nonzero marks (numberRows_+2)
+  CoinArrayWithLength nonzero_;
+  /// Integer work (3*numberRows_+6)
+  CoinIntArrayWithLength spare_;
+};
+
 class CoinOslFactorization : public CoinOtherFactorization {
    friend void CoinOslFactorizationUnitTest( const std::string & mpsDir );
 
@@ -161,6 +188,10 @@ public:
   virtual inline int numberElements (  ) const {
     return numberRows_*(numberColumns_+numberPivots_);
   }
+  /// Number of nonzeros in L and U (including updates)
+  virtual inline CoinBigIndex numberNonZeros (  ) const {
+    return factInfo_.nnentl+factInfo_.nnentu;
+  }
   /// Returns array to put basis elements in
   virtual CoinFactorizationDouble * elements() const;
   /// Returns pivot row 
@@ -240,6 +271,16 @@ public:
   */
   virtual int updateColumnTranspose ( CoinIndexedVector * regionSparse,
 			      CoinIndexedVector * regionSparse2) const;
+  /** As updateColumn but all scratch is in regionSparse and work
+      so several threads may do this at once */
+  int updateColumn ( CoinIndexedVector * regionSparse,
+		     CoinIndexedVector * regionSparse2,
+		     CoinOslWorkArea & work) const;
+  /** As updateColumnTranspose but all scratch is in regionSparse and work
+      so several threads may do this at once */
+  int updateColumnTranspose ( CoinIndexedVector * regionSparse,
+			      CoinIndexedVector * regionSparse2,
+			      CoinOslWorkArea & work) const;
   //@}
   /// *** Below this user may not want to know about
 
@@ -268,6 +309,16 @@ protected:
   /** Returns accuracy status of replaceColumn
       returns 0=OK, 1=Probably OK, 2=singular */
   int checkPivot(double saveFromU, double oldPivot) const;
+  /** Does FTRAN with given copy of factorization information
+      (which has scratch pointers for this solve) */
+  int updateColumn ( const EKKfactinfo & fact,
+		     CoinIndexedVector * regionSparse,
+		     CoinIndexedVector * regionSparse2) const;
+  /** Does BTRAN with given copy of factorization information
+      (which has scratch pointers for this solve) */
+  int updateColumnTranspose ( EKKfactinfo & fact,
+			      CoinIndexedVector * regionSparse,
+			      CoinIndexedVector * regionSparse2) const;
 ////////////////// data //////////////////
 protected:
 
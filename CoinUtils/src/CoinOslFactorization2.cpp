@@ -15,6 +15,7 @@
 #include "CoinOslFactorization.hpp"
 #include "CoinOslC.h"
 #include "CoinFinite.hpp"
+#include "CoinPermute.hpp"
 
 #ifndef NDEBUG
 extern int ets_count;
@@ -28,103 +29,284 @@ extern int ets_check;
 #else
 # define COIN_RESTRICT2
 #endif
-static int c_ekkshfpo_scan2zero(COIN_REGISTER const EKKfactinfo * COIN_RESTRICT2 fact,const int * COIN_RESTRICT mpermu,
-		       double *COIN_RESTRICT worki, double *COIN_RESTRICT worko, int * COIN_RESTRICT mptr)
+/* Vectorized versions of dense triangular loops and of scan routine
+   (permutes use CoinPermute).  COIN_OSL_SIMD 2 allows AVX-512F or AVX2,
+   1 only AVX2 and 0 switches off.  Instruction set is chosen at run
+   time so library can still be built for generic x86.
+   Each kernel does as many complete blocks as it can and returns number
+   done - caller finishes off with scalar code.  Sums are accumulated in
+   a different order so results may differ in last bits. */
+#ifndef COIN_OSL_SIMD
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+  && (defined(__x86_64__) || defined(__i386__))
+#define COIN_OSL_SIMD 2
+#else
+#define COIN_OSL_SIMD 0
+#endif
+#endif
+#if COIN_OSL_SIMD
+#include <immintrin.h>
+// 0 not known, 1 none, 2 AVX2, 3 AVX-512F
+static int coinOslSimdLevel = 0;
+static inline int coinOslSimd()
 {
-  
-  /* Local variables */
-  int irow;
-  double tolerance = fact->zeroTolerance;
-  int nin=fact->nrow;
-  int * COIN_RESTRICT mptrX=mptr;
-  if ((nin&1)!=0) {
-    irow=1;
-    if (fact->packedMode) {
-      int irow0= *mpermu;
-      double dval;
-      assert (irow0>=1&&irow0<=nin);
-      mpermu++;
-      dval=worki[irow0];
-      if (NOT_ZERO(dval)) {
-	worki[irow0]=0.0;
-	if (fabs(dval) >= tolerance) {
-	  *(worko++)=dval;
-	  *(mptrX++) = 0;
-	}
-      }
-    } else {
-      int irow0= *mpermu;
-      double dval;
-      assert (irow0>=1&&irow0<=nin);
-      mpermu++;
-      dval=worki[irow0];
-      if (NOT_ZERO(dval)) {
-	worki[irow0]=0.0;
-	if (fabs(dval) >= tolerance) {
-	  *worko=dval;
-	  *(mptrX++) = 0;
-	}
-      }
-      worko++;
+  if (!coinOslSimdLevel) {
+    int level = 1;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      level = 2;
+#if COIN_OSL_SIMD > 1
+    if (__builtin_cpu_supports("avx512f"))
+      level = 3;
+#endif
+    coinOslSimdLevel = level;
+  }
+  return coinOslSimdLevel;
+}
+// sum1 += a[k]*x[k], sum2 += b[k]*x[k]
+__attribute__((target("avx2"))) static int
+coinOslDot2Avx2(const double * COIN_RESTRICT a, const double * COIN_RESTRICT b,
+		const double * COIN_RESTRICT x, int n,
+		double & sum1, double & sum2)
+{
+  __m256d s1 = _mm256_setzero_pd();
+  __m256d s2 = _mm256_setzero_pd();
+  int k = 0;
+  for ( ; k + 4 <= n; k += 4) {
+    __m256d xk = _mm256_loadu_pd(x+k);
+    s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(a+k), xk));
+    s2 = _mm256_add_pd(s2, _mm256_mul_pd(_mm256_loadu_pd(b+k), xk));
+  }
+  double t1[4], t2[4];
+  _mm256_storeu_pd(t1, s1);
+  _mm256_storeu_pd(t2, s2);
+  sum1 += (t1[0] + t1[1]) + (t1[2] + t1[3]);
+  sum2 += (t2[0] + t2[1]) + (t2[2] + t2[3]);
+  return k;
+}
+// As coinOslDot2Avx2 but x[k] is xEnd[-k]
+__attribute__((target("avx2"))) static int
+coinOslDot2ReverseAvx2(const double * COIN_RESTRICT a, 
+		       const double * COIN_RESTRICT b,
+		       const double * COIN_RESTRICT xEnd, int n,
+		       double & sum1, double & sum2)
+{
+  __m256d s1 = _mm256_setzero_pd();
+  __m256d s2 = _mm256_setzero_pd();
+  int k = 0;
+  for ( ; k + 4 <= n; k += 4) {
+    __m256d xk = _mm256_permute4x64_pd(_mm256_loadu_pd(xEnd-k-3), 0x1b);
+    s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(a+k), xk));
+    s2 = _mm256_add_pd(s2, _mm256_mul_pd(_mm256_loadu_pd(b+k), xk));
+  }
+  double t1[4], t2[4];
+  _mm256_storeu_pd(t1, s1);
+  _mm256_storeu_pd(t2, s2);
+  sum1 += (t1[0] + t1[1]) + (t1[2] + t1[3]);
+  sum2 += (t2[0] + t2[1]) + (t2[2] + t2[3]);
+  return k;
+}
+// y[k] -= value1*a[k]+value2*b[k] (b may be NULL)
+__attribute__((target("avx2"))) static int
+coinOslAxpyAvx2(double * COIN_RESTRICT y, int n,
+		double value1, const double * COIN_RESTRICT a,
+		double value2, const double * COIN_RESTRICT b)
+{
+  __m256d v1 = _mm256_set1_pd(value1);
+  int k = 0;
+  if (b) {
+    __m256d v2 = _mm256_set1_pd(value2);
+    for ( ; k + 4 <= n; k += 4) {
+      __m256d yk = _mm256_loadu_pd(y+k);
+      yk = _mm256_sub_pd(yk, _mm256_mul_pd(v1, _mm256_loadu_pd(a+k)));
+      yk = _mm256_sub_pd(yk, _mm256_mul_pd(v2, _mm256_loadu_pd(b+k)));
+      _mm256_storeu_pd(y+k, yk);
     }
   } else {
-    irow=0;
+    for ( ; k + 4 <= n; k += 4) {
+      __m256d yk = _mm256_loadu_pd(y+k);
+      yk = _mm256_sub_pd(yk, _mm256_mul_pd(v1, _mm256_loadu_pd(a+k)));
+      _mm256_storeu_pd(y+k, yk);
+    }
   }
-  if (fact->packedMode) {
-    for (; irow < nin; irow+=2) {
-      int irow0,irow1;
-      double dval0,dval1;
-      irow0=mpermu[0];
-      irow1=mpermu[1];
-      assert (irow0>=1&&irow0<=nin);
-      assert (irow1>=1&&irow1<=nin);
-      dval0=worki[irow0];
-      dval1=worki[irow1];
-      if (NOT_ZERO(dval0)) {
-	worki[irow0]=0.0;
-	if (fabs(dval0) >= tolerance) {
-	  *(worko++)=dval0;
-	  *(mptrX++) = irow+0;
-	}
-      }
-      if (NOT_ZERO(dval1)) {
-	worki[irow1]=0.0;
-	if (fabs(dval1) >= tolerance) {
-	  *(worko++)=dval1;
-	  *(mptrX++) = irow+1;
-	}
-      }
-      mpermu+=2;
+  return k;
+}
+#if COIN_OSL_SIMD > 1
+__attribute__((target("avx512f"))) static int
+coinOslDot2Avx512(const double * COIN_RESTRICT a, 
+		  const double * COIN_RESTRICT b,
+		  const double * COIN_RESTRICT x, int n,
+		  double & sum1, double & sum2)
+{
+  __m512d s1 = _mm512_setzero_pd();
+  __m512d s2 = _mm512_setzero_pd();
+  int k = 0;
+  for ( ; k + 8 <= n; k += 8) {
+    __m512d xk = _mm512_loadu_pd(x+k);
+    s1 = _mm512_add_pd(s1, _mm512_mul_pd(_mm512_loadu_pd(a+k), xk));
+    s2 = _mm512_add_pd(s2, _mm512_mul_pd(_mm512_loadu_pd(b+k), xk));
+  }
+  sum1 += _mm512_reduce_add_pd(s1);
+  sum2 += _mm512_reduce_add_pd(s2);
+  return k;
+}
+__attribute__((target("avx512f"))) static int
+coinOslDot2ReverseAvx512(const double * COIN_RESTRICT a, 
+			 const double * COIN_RESTRICT b,
+			 const double * COIN_RESTRICT xEnd, int n,
+			 double & sum1, double & sum2)
+{
+  const __m512i reverse = _mm512_setr_epi64(7,6,5,4,3,2,1,0);
+  __m512d s1 = _mm512_setzero_pd();
+  __m512d s2 = _mm512_setzero_pd();
+  int k = 0;
+  for ( ; k + 8 <= n; k += 8) {
+    __m512d xk = _mm512_permutexvar_pd(reverse, _mm512_loadu_pd(xEnd-k-7));
+    s1 = _mm512_add_pd(s1, _mm512_mul_pd(_mm512_loadu_pd(a+k), xk));
+    s2 = _mm512_add_pd(s2, _mm512_mul_pd(_mm512_loadu_pd(b+k), xk));
+  }
+  sum1 += _mm512_reduce_add_pd(s1);
+  sum2 += _mm512_reduce_add_pd(s2);
+  return k;
+}
+__attribute__((target("avx512f"))) static int
+coinOslAxpyAvx512(double * COIN_RESTRICT y, int n,
+		  double value1, const double * COIN_RESTRICT a,
+		  double value2, const double * COIN_RESTRICT b)
+{
+  __m512d v1 = _mm512_set1_pd(value1);
+  int k = 0;
+  if (b) {
+    __m512d v2 = _mm512_set1_pd(value2);
+    for ( ; k + 8 <= n; k += 8) {
+      __m512d yk = _mm512_loadu_pd(y+k);
+      yk = _mm512_sub_pd(yk, _mm512_mul_pd(v1, _mm512_loadu_pd(a+k)));
+      yk = _mm512_sub_pd(yk, _mm512_mul_pd(v2, _mm512_loadu_pd(b+k)));
+      _mm512_storeu_pd(y+k, yk);
     }
   } else {
-    for (; irow < nin; irow+=2) {
-      int irow0,irow1;
-      double dval0,dval1;
-      irow0=mpermu[0];
-      irow1=mpermu[1];
-      assert (irow0>=1&&irow0<=nin);
-      assert (irow1>=1&&irow1<=nin);
-      dval0=worki[irow0];
-      dval1=worki[irow1];
-      if (NOT_ZERO(dval0)) {
-	worki[irow0]=0.0;
-	if (fabs(dval0) >= tolerance) {
-	  worko[0]=dval0;
-	  *(mptrX++) = irow+0;
-	}
-      }
-      if (NOT_ZERO(dval1)) {
-	worki[irow1]=0.0;
-	if (fabs(dval1) >= tolerance) {
-	  worko[1]=dval1;
-	  *(mptrX++) = irow+1;
-	}
-      }
-      mpermu+=2;
-      worko+=2;
+    for ( ; k + 8 <= n; k += 8) {
+      __m512d yk = _mm512_loadu_pd(y+k);
+      yk = _mm512_sub_pd(yk, _mm512_mul_pd(v1, _mm512_loadu_pd(a+k)));
+      _mm512_storeu_pd(y+k, yk);
     }
   }
-  return static_cast<int>(mptrX-mptr);
+  return k;
+}
+#ifdef NO_SHIFT
+/* Scan and pack - see c_ekkscmv.  Values below tolerance are zeroed.
+   Returns number packed, done gives number scanned */
+__attribute__((target("avx512f"))) static int
+coinOslScanAvx512(double * COIN_RESTRICT dwork, int n, double tolerance,
+		  int * COIN_RESTRICT mptr, double * COIN_RESTRICT dwork2,
+		  int & done)
+{
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d tol = _mm512_set1_pd(tolerance);
+  const __m512i absMask = _mm512_set1_epi64(0x7fffffffffffffffLL);
+  const __m512i step = _mm512_setr_epi32(0,1,2,3,4,5,6,7,
+					 8,9,10,11,12,13,14,15);
+  int number = 0;
+  int i = 0;
+  for ( ; i + 16 <= n; i += 16) {
+    __m512d value0 = _mm512_loadu_pd(dwork+i);
+    __m512d value1 = _mm512_loadu_pd(dwork+i+8);
+    __mmask8 nonZero0 = _mm512_cmp_pd_mask(value0,zero,_CMP_NEQ_UQ);
+    __mmask8 nonZero1 = _mm512_cmp_pd_mask(value1,zero,_CMP_NEQ_UQ);
+    if (!(nonZero0|nonZero1))
+      continue;
+    __mmask8 keep0 = _mm512_cmp_pd_mask
+      (_mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(value0),
+					    absMask)), tol, _CMP_GE_OQ);
+    __mmask8 keep1 = _mm512_cmp_pd_mask
+      (_mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(value1),
+					    absMask)), tol, _CMP_GE_OQ);
+    _mm512_mask_storeu_pd(dwork+i, nonZero0 & ~keep0, zero);
+    _mm512_mask_storeu_pd(dwork+i+8, nonZero1 & ~keep1, zero);
+    __mmask16 keep = static_cast<__mmask16>(keep0 | (keep1<<8));
+    if (!keep)
+      continue;
+    _mm512_mask_compressstoreu_epi32(mptr+number, keep,
+				     _mm512_add_epi32(step,_mm512_set1_epi32(i+1)));
+    _mm512_mask_compressstoreu_pd(dwork2+number, keep0, value0);
+    number += __builtin_popcount(keep0);
+    _mm512_mask_compressstoreu_pd(dwork2+number, keep1, value1);
+    number += __builtin_popcount(keep1);
+  }
+  done = i;
+  return number;
+}
+#endif
+#endif
+#endif
+/* Dispatchers - return number done by vector code (0 if none) */
+static inline int coinOslDot2(const double * a, const double * b,
+			      const double * x, int n,
+			      double & sum1, double & sum2)
+{
+#if COIN_OSL_SIMD
+  if (n >= 8) {
+    int level = coinOslSimd();
+#if COIN_OSL_SIMD > 1
+    if (level==3)
+      return coinOslDot2Avx512(a, b, x, n, sum1, sum2);
+#endif
+    if (level==2)
+      return coinOslDot2Avx2(a, b, x, n, sum1, sum2);
+  }
+#endif
+  return 0;
+}
+static inline int coinOslDot2Reverse(const double * a, const double * b,
+				     const double * xEnd, int n,
+				     double & sum1, double & sum2)
+{
+#if COIN_OSL_SIMD
+  if (n >= 8) {
+    int level = coinOslSimd();
+#if COIN_OSL_SIMD > 1
+    if (level==3)
+      return coinOslDot2ReverseAvx512(a, b, xEnd, n, sum1, sum2);
+#endif
+    if (level==2)
+      return coinOslDot2ReverseAvx2(a, b, xEnd, n, sum1, sum2);
+  }
+#endif
+  return 0;
+}
+static inline int coinOslAxpy(double * y, int n,
+			      double value1, const double * a,
+			      double value2, const double * b)
+{
+#if COIN_OSL_SIMD
+  if (n >= 8) {
+    int level = coinOslSimd();
+#if COIN_OSL_SIMD > 1
+    if (level==3)
+      return coinOslAxpyAvx512(y, n, value1, a, value2, b);
+#endif
+    if (level==2)
+      return coinOslAxpyAvx2(y, n, value1, a, value2, b);
+  }
+#endif
+  return 0;
+}
+static inline int coinOslScan(double * dwork, int n, double tolerance,
+			      int * mptr, double * dwork2, int & done)
+{
+  done = 0;
+#if COIN_OSL_SIMD > 1 && defined(NO_SHIFT)
+  if (n >= 32 && coinOslSimd()==3)
+    return coinOslScanAvx512(dwork, n, tolerance, mptr, dwork2, done);
+#endif
+  return 0;
+}
+static int c_ekkshfpo_scan2zero(COIN_REGISTER const EKKfactinfo * COIN_RESTRICT2 fact,const int * COIN_RESTRICT mpermu,
+		       double *COIN_RESTRICT worki, double *COIN_RESTRICT worko, int * COIN_RESTRICT mptr)
+{
+  /* mptr gets position in mpermu, zeros and small values are dropped */
+  return CoinPermuteGather(NULL,mpermu,fact->nrow,worki,worko,
+			   fact->packedMode!=0,mptr,fact->zeroTolerance,2);
 }
 /*
  * c_ekkshfpi_list executes the following loop:
@@ -142,40 +324,14 @@ static int c_ekkshfpi_list(const int *COIN_RESTRICT mpermu,
 			   const int * COIN_RESTRICT mptr, int nincol,
 			   int * lastNonZero)
 {
-  int i,k,irow0,irow1;
-  int first=COIN_INT_MAX;
-  int last=0;
+  int firstLast[2];
+  firstLast[0]=COIN_INT_MAX;
+  firstLast[1]=0;
   /* worko was zeroed out outside */
-  k = nincol;
-  i = 0;
-  if ((k&1)!=0) {
-    int ipt=mptr[i];
-    irow0=mpermu[ipt];
-    first = CoinMin(irow0,first);
-    last = CoinMax(irow0,last);
-    i++;
-    worko[irow0]=*worki;
-    *worki++=0.0;
-  }
-  k=k>>1;
-  for (; k; k--) {
-    int ipt0 = mptr[i];
-    int ipt1 = mptr[i+1];
-    irow0 = mpermu[ipt0];
-    irow1 = mpermu[ipt1];
-    i+=2;
-    first = CoinMin(irow0,first);
-    last = CoinMax(irow0,last);
-    first = CoinMin(irow1,first);
-    last = CoinMax(irow1,last);
-    worko[irow0] = worki[0];
-    worko[irow1] = worki[1];
-    worki[0]=0.0;
-    worki[1]=0.0;
-    worki+=2;
-  }
-  *lastNonZero=last;
-  return first;
+  CoinPermuteScatter(mpermu,mptr,nincol,worki,true,worko,NULL,NULL,
+		     firstLast);
+  *lastNonZero=firstLast[1];
+  return firstLast[0];
 }
 /*
  * c_ekkshfpi_list2 executes the following loop:
@@ -191,53 +347,14 @@ static int c_ekkshfpi_list2(const int *COIN_RESTRICT mpermu, double *COIN_RESTRI
 			    const int * COIN_RESTRICT mptr, int nincol,
 			   int * lastNonZero)
 {
-#if 1
-  int i,k,irow0,irow1;
-  int first=COIN_INT_MAX;
-  int last=0;
+  int firstLast[2];
+  firstLast[0]=COIN_INT_MAX;
+  firstLast[1]=0;
   /* worko was zeroed out outside */
-  k = nincol;
-  i = 0;
-  if ((k&1)!=0) {
-    int ipt=mptr[i];
-    irow0=mpermu[ipt];
-    first = CoinMin(irow0,first);
-    last = CoinMax(irow0,last);
-    i++;
-    worko[irow0]=worki[ipt];
-    worki[ipt]=0.0;
-  }
-  k=k>>1;
-  for (; k; k--) {
-    int ipt0 = mptr[i];
-    int ipt1 = mptr[i+1];
-    irow0 = mpermu[ipt0];
-    irow1 = mpermu[ipt1];
-    i+=2;
-    first = CoinMin(irow0,first);
-    last = CoinMax(irow0,last);
-    first = CoinMin(irow1,first);
-    last = CoinMax(irow1,last);
-    worko[irow0] = worki[ipt0];
-    worko[irow1] = worki[ipt1];
-    worki[ipt0]=0.0;
-    worki[ipt1]=0.0;
-  }
-#else
-  int first=COIN_INT_MAX;
-  int last=0;
-  /* worko was zeroed out outside */
-  for (int i=0; i<nincol; i++) {
-    int ipt = mptr[i];
-    int irow = mpermu[ipt];
-    first = CoinMin(irow,first);
-    last = CoinMax(irow,last);
-    worko[irow] = worki[ipt];
-    worki[ipt]=0.0;
-  }
-#endif
-  *lastNonZero=last;
-  return first;
+  CoinPermuteScatter(mpermu,mptr,nincol,worki,false,worko,NULL,NULL,
+		     firstLast);
+  *lastNonZero=firstLast[1];
+  return firstLast[0];
 }
 /*
  * c_ekkshfpi_list3 executes the following loop:
@@ -254,33 +371,8 @@ static void c_ekkshfpi_list3(const int *COIN_RESTRICT mpermu,
 		    double *COIN_RESTRICT worki, double *COIN_RESTRICT worko,
 		    int * COIN_RESTRICT mptr, int nincol)
 {
-  int i,k,irow0,irow1;
   /* worko was zeroed out outside */
-  k = nincol;
-  i = 0;
-  if ((k&1)!=0) {
-    int ipt=mptr[i];
-    irow0=mpermu[ipt];
-    mptr[i] = irow0;
-    i++;
-    worko[irow0]=*worki;
-    *worki++=0.0;
-  }
-  k=k>>1;
-  for (; k; k--) {
-    int ipt0 = mptr[i];
-    int ipt1 = mptr[i+1];
-    irow0 = mpermu[ipt0];
-    irow1 = mpermu[ipt1];
-    mptr[i] = irow0;
-    mptr[i+1] = irow1;
-    i+=2;
-    worko[irow0] = worki[0];
-    worko[irow1] = worki[1];
-    worki[0]=0.0;
-    worki[1]=0.0;
-    worki+=2;
-  }
+  CoinPermuteScatter(mpermu,mptr,nincol,worki,true,worko,mptr);
 }
 static int c_ekkscmv(COIN_REGISTER const EKKfactinfo * COIN_RESTRICT2 fact,int n, double *COIN_RESTRICT dwork, int *COIN_RESTRICT mptr, 
 		   double *COIN_RESTRICT dwork2)
@@ -289,19 +381,25 @@ static int c_ekkscmv(COIN_REGISTER const EKKfactinfo * COIN_RESTRICT2 fact,int n
   int irow;
   const int * COIN_RESTRICT mptrsave = mptr;
   double * COIN_RESTRICT dwhere = dwork+1;
+  int done;
+  int number = coinOslScan(dwhere,n,tolerance,mptr+1,dwork2+1,done);
+  mptr += number;
+  dwork2 += number;
+  dwhere += done;
+  n -= done;
   if ((n&1)!=0) {
     if (NOT_ZERO(*dwhere)) {
       if (fabs(*dwhere) >= tolerance) {
 	*++dwork2 = *dwhere;
-	*++mptr = SHIFT_INDEX(1);
+	*++mptr = SHIFT_INDEX(done+1);
       } else {
 	*dwhere = 0.0;
       }
     }
     dwhere++;
-    irow=2;
+    irow=done+2;
   } else {
-    irow=1;
+    irow=done+1;
   }
   for (n=n>>1;n;n--) {
     int second = NOT_ZERO(*(dwhere+1));
@@ -502,7 +600,8 @@ static int c_ekkbtj4p_dense(const int nrow,const double * COIN_RESTRICT dluval,
     dv1=densew[1];
     dlu2=dlu1+nincol;
     dv2=densew[0];
-    for (k=0;k<nincol;k++) {
+    k = coinOslDot2Reverse(dlu1,dlu2,densew+nincol+1,nincol,dv1,dv2);
+    for (;k<nincol;k++) {
 #ifdef DEBUG
       int kk=dlu1-dluval;
       int jj = (densew+(nincol-k+1))-dwork1;
@@ -877,19 +976,16 @@ static void c_ekkbtju_dense(const int nrow,
 			    const double * COIN_RESTRICT dluval,
 			    const int * COIN_RESTRICT hrowi,
 			    const int * COIN_RESTRICT mcstrt, 
-			    int * COIN_RESTRICT hpivco, 
+			    const int * COIN_RESTRICT hpivco, 
 			    double * COIN_RESTRICT dwork1,
 			    int * COIN_RESTRICT start,int last,int offset,
 			    double * COIN_RESTRICT densew)
 {
   /* Local variables */
   int ipiv1,ipiv2;
-  int save=hpivco[last];
-  
-  hpivco[last]=nrow+1;
-  
+  /* stop at last without marking hpivco (may be shared by threads) */
   ipiv1=*start;
-  ipiv2=hpivco[ipiv1];
+  ipiv2=(ipiv1!=last) ? hpivco[ipiv1] : nrow+1;
   while(ipiv2<last) {
     int iel,k;
     const int   kx1	= mcstrt[ipiv1];
@@ -915,7 +1011,12 @@ static void c_ekkbtju_dense(const int nrow,
     for (iel = kx2; iel < k2; ++iel) {
       dv2 -= SHIFT_REF(dwork1, hrowi[iel]) * dluval[iel];
     }
-    for (k=0;k<n1;k++) {
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    k = coinOslDot2(dlu1,dlu2,densew,n1,sum1,sum2);
+    dv1 -= sum1;
+    dv2 -= sum2;
+    for (;k<n1;k++) {
       dv1 -= dlu1[k] * densew[k];
       dv2 -= dlu2[k] * densew[k];
     }
@@ -924,9 +1025,8 @@ static void c_ekkbtju_dense(const int nrow,
     dwork1[ipiv1] = dv1;
     dwork1[ipiv2] = dv2*dpiv2;
     ipiv1 = hpivco[ipiv2];
-    ipiv2 = hpivco[ipiv1];
+    ipiv2 = (ipiv1!=last) ? hpivco[ipiv1] : nrow+1;
   }
-  hpivco[last]=save;
   
   *start=ipiv1;
   return;
@@ -1089,7 +1189,7 @@ static void c_ekkbtju(COIN_REGISTER2 const EKKfactinfo * COIN_RESTRICT2 fact,
 	n++;
       }
     }
-    c_ekkbtju_dense(nrow,dluval,hrowi,mcstrt,const_cast<int *> (hpivco_new),
+    c_ekkbtju_dense(nrow,dluval,hrowi,mcstrt,hpivco_new,
 		  dwork1,&ipiv,last_dense, n - first_dense, densew);
   }
   
@@ -3253,11 +3353,12 @@ static void c_ekkftju_dense(const double *dluval,
 	   *   densew[k]-=dv1*dlu1[k]+dv2*dlu2[k];
 	   * }
 	   */
-          if ((k&1)==0) {
+          int kDone = coinOslAxpy(densew,k+1,dv1,dlu1,dv2,dlu2);
+          if (((k-kDone)&1)==0) {
             densew[k]-=dv1*dlu1[k]+dv2*dlu2[k];
             k--;
           }
-          for (; k >=0 ; k-=2) {
+          for (; k >=kDone ; k-=2) {
             double da,db;
             da=densew[k];
             db=densew[k-1];
@@ -3268,6 +3369,8 @@ static void c_ekkftju_dense(const double *dluval,
             densew[k]=da;
             densew[k-1]=db;
           }
+          /* vector part did first kDone */
+          k-=kDone;
 	  /* end loop */
 	  
 	  /*
@@ -3306,11 +3409,13 @@ static void c_ekkftju_dense(const double *dluval,
           ipiv2=ipiv;
           if (ipiv<last) {
 	    k--;
-	    for (; k >=0 ; k--) {
+	    int kDone = coinOslAxpy(densew,k+1,dv1,dlu1,0.0,NULL);
+	    for (; k >=kDone ; k--) {
 	      double dval;
 	      dval=dv1*dlu1[k];
 	      densew[k]=densew[k]-dval;
 	    }
+	    k-=kDone;
 	  }
         }
       }
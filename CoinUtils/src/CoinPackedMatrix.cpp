@@ -20,6 +20,9 @@
 #endif
 #include "CoinFloatEqual.hpp"
 #include "CoinPackedMatrix.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinTime.hpp"
+#include "CoinThreadPool.hpp"
 
 #if !defined(COIN_COINUTILS_CHECKLEVEL)
 #define COIN_COINUTILS_CHECKLEVEL 0
@@ -114,6 +117,8 @@ CoinPackedMatrix::reserve(const int newMaxMajorDim, const CoinBigIndex newMaxSiz
 void
 CoinPackedMatrix::clear()
 {
+   invalidateReverse();
+   discardTail();
    majorDim_ = 0;
    minorDim_ = 0;
    size_ = 0;
@@ -125,6 +130,8 @@ CoinPackedMatrix::clear()
 void
 CoinPackedMatrix::setDimensions(int newnumrows, int newnumcols)
 {
+  if (tail_)
+    compactTail();
   const int numrows = getNumRows();
   if (newnumrows < 0)
     newnumrows = numrows;
@@ -154,7 +161,10 @@ CoinPackedMatrix::setDimensions(int newnumrows, int newnumcols)
     delete[] lengths;
     majorDim_ += numplus; //forgot to change majorDim_
   }
-
+  if (reverse_) {
+    reverse_->setDimensions(newnumrows, newnumcols);
+    checkReverse();
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -188,6 +198,10 @@ CoinPackedMatrix::appendCol(const CoinPackedVectorBase& vec)
       appendMajorVector(vec);
    else
       appendMinorVector(vec);
+   if (reverse_) {
+      reverse_->appendCol(vec);
+      checkReverse();
+   }
 }
 #endif
 //-----------------------------------------------------------------------------
@@ -201,6 +215,10 @@ CoinPackedMatrix::appendCol(const int vecsize,
       appendMajorVector(vecsize, vecind, vecelem);
    else
       appendMinorVector(vecsize, vecind, vecelem);
+   if (reverse_) {
+      reverse_->appendCol(vecsize, vecind, vecelem);
+      checkReverse();
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -213,6 +231,10 @@ CoinPackedMatrix::appendCols(const int numcols,
       appendMajorVectors(numcols, cols);
    else
       appendMinorVectors(numcols, cols);
+   if (reverse_) {
+      reverse_->appendCols(numcols, cols);
+      checkReverse();
+   }
 }
 #endif
 //-----------------------------------------------------------------------------
@@ -228,6 +250,10 @@ CoinPackedMatrix::appendCols(const int numcols,
   } else {
     numberErrors=appendMinor(numcols, columnStarts, row, element, numberRows);
   }
+  if (reverse_) {
+    reverse_->appendCols(numcols, columnStarts, row, element, numberRows);
+    checkReverse();
+  }
   return numberErrors;
 }
 //-----------------------------------------------------------------------------
@@ -239,6 +265,10 @@ CoinPackedMatrix::appendRow(const CoinPackedVectorBase& vec)
       appendMinorVector(vec);
    else
       appendMajorVector(vec);
+   if (reverse_) {
+      reverse_->appendRow(vec);
+      checkReverse();
+   }
 }
 #endif
 //-----------------------------------------------------------------------------
@@ -252,6 +282,10 @@ CoinPackedMatrix::appendRow(const int vecsize,
       appendMinorVector(vecsize, vecind, vecelem);
    else
       appendMajorVector(vecsize, vecind, vecelem);
+   if (reverse_) {
+      reverse_->appendRow(vecsize, vecind, vecelem);
+      checkReverse();
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -286,6 +320,10 @@ CoinPackedMatrix::appendRows(const int numrows,
   } else {
     appendMajorVectors(numrows, rows);
   }
+  if (reverse_) {
+    reverse_->appendRows(numrows, rows);
+    checkReverse();
+  }
 }
 #endif
 //-----------------------------------------------------------------------------
@@ -301,6 +339,10 @@ CoinPackedMatrix::appendRows(const int numrows,
   } else {
     numberErrors=appendMajor(numrows, rowStarts, column, element, numberColumns);
   }
+  if (reverse_) {
+    reverse_->appendRows(numrows, rowStarts, column, element, numberColumns);
+    checkReverse();
+  }
   return numberErrors;
 }
 
@@ -309,6 +351,11 @@ CoinPackedMatrix::appendRows(const int numrows,
 void
 CoinPackedMatrix::rightAppendPackedMatrix(const CoinPackedMatrix& matrix)
 {
+   if (matrix.tail_) {
+      CoinPackedMatrix full(matrix);
+      rightAppendPackedMatrix(full);
+      return;
+   }
    if (colOrdered_) {
       if (matrix.colOrdered_) {
 	 majorAppendSameOrdered(matrix);
@@ -322,6 +369,10 @@ CoinPackedMatrix::rightAppendPackedMatrix(const CoinPackedMatrix& matrix)
 	 minorAppendSameOrdered(matrix);
       }
    }
+   if (reverse_) {
+      reverse_->rightAppendPackedMatrix(matrix);
+      checkReverse();
+   }
 }
 
 //-----------------------------------------------------------------------------
@@ -329,6 +380,11 @@ CoinPackedMatrix::rightAppendPackedMatrix(const CoinPackedMatrix& matrix)
 void
 CoinPackedMatrix::bottomAppendPackedMatrix(const CoinPackedMatrix& matrix)
 {
+   if (matrix.tail_) {
+      CoinPackedMatrix full(matrix);
+      bottomAppendPackedMatrix(full);
+      return;
+   }
    if (colOrdered_) {
       if (matrix.colOrdered_) {
 	 minorAppendSameOrdered(matrix);
@@ -342,6 +398,10 @@ CoinPackedMatrix::bottomAppendPackedMatrix(const CoinPackedMatrix& matrix)
 	 majorAppendSameOrdered(matrix);
       }
    }
+   if (reverse_) {
+      reverse_->bottomAppendPackedMatrix(matrix);
+      checkReverse();
+   }
 }
 
 //#############################################################################
@@ -350,10 +410,16 @@ void
 CoinPackedMatrix::deleteCols(const int numDel, const int * indDel)
 {
   if (numDel) {
+    if (tail_)
+      compactTail();
     if (colOrdered_)
       deleteMajorVectors(numDel, indDel);
     else
       deleteMinorVectors(numDel, indDel);
+    if (reverse_) {
+      reverse_->deleteCols(numDel, indDel);
+      checkReverse();
+    }
   }
 }
 
@@ -363,10 +429,16 @@ void
 CoinPackedMatrix::deleteRows(const int numDel, const int * indDel)
 {
   if (numDel) {
+    if (tail_)
+      compactTail();
     if (colOrdered_)
       deleteMinorVectors(numDel, indDel);
     else
       deleteMajorVectors(numDel, indDel);
+    if (reverse_) {
+      reverse_->deleteRows(numDel, indDel);
+      checkReverse();
+    }
   }
 }
 
@@ -379,9 +451,12 @@ CoinPackedMatrix::replaceVector(const int index,
 			       const int numReplace, 
 			       const double * newElements)
 {
+  if (tail_)
+    compactTail();
   if (index >= 0 && index < majorDim_) {
     int length = (length_[index] < numReplace) ? length_[index] : numReplace;
     CoinMemcpyN(newElements, length, element_ + start_[index]);
+    invalidateReverse();
   } else {
 #ifdef COIN_DEBUG
     throw CoinError("bad index", "replaceVector", "CoinPackedMatrix");
@@ -395,6 +470,17 @@ void
 CoinPackedMatrix::modifyCoefficient(int row, int column, double newElement,
 				    bool keepZero)
 {
+  if (tail_)
+    compactTail();
+  if (reverse_) {
+    reverse_->modifyCoefficient(row, column, newElement, keepZero);
+    CoinPackedMatrix * reverse = reverse_;
+    reverse_ = NULL;
+    modifyCoefficient(row, column, newElement, keepZero);
+    reverse_ = reverse;
+    checkReverse();
+    return;
+  }
   int minorIndex,majorIndex;
   if (colOrdered_) {
     majorIndex=column;
@@ -464,12 +550,121 @@ CoinPackedMatrix::modifyCoefficient(int row, int column, double newElement,
 #endif
   }
 }
+/* Modify several elements of packed matrix.  Existing elements are
+   replaced (or deleted) in place first, then room is made for all new
+   elements with at most one resize. */
+void
+CoinPackedMatrix::modifyCoefficients(int number, const int * rows,
+				     const int * columns,
+				     const double * newElements,
+				     bool keepZero)
+{
+  if (tail_)
+    compactTail();
+  if (reverse_) {
+    reverse_->modifyCoefficients(number, rows, columns, newElements, keepZero);
+    CoinPackedMatrix * reverse = reverse_;
+    reverse_ = NULL;
+    modifyCoefficients(number, rows, columns, newElements, keepZero);
+    reverse_ = reverse;
+    checkReverse();
+    return;
+  }
+  const int * major = colOrdered_ ? columns : rows;
+  const int * minor = colOrdered_ ? rows : columns;
+  int * addedEntries = NULL;
+  int * added = NULL;
+  int numberAdded = 0;
+  for (int i = 0; i < number; i++) {
+    const int majorIndex = major[i];
+    const int minorIndex = minor[i];
+    if (majorIndex < 0 || majorIndex >= majorDim_ ||
+	minorIndex < 0 || minorIndex >= minorDim_) {
+#ifdef COIN_DEBUG
+      delete [] addedEntries;
+      delete [] added;
+      throw CoinError("bad index", "modifyCoefficients",
+		      "CoinPackedMatrix");
+#endif
+      continue;
+    }
+    CoinBigIndex j;
+    CoinBigIndex end = start_[majorIndex]+length_[majorIndex];
+    for (j = start_[majorIndex]; j < end; j++) {
+      if (index_[j] == minorIndex)
+	break;
+    }
+    if (j < end) {
+      if (newElements[i] || keepZero) {
+	element_[j] = newElements[i];
+      } else {
+	// pack down
+	length_[majorIndex]--;
+	end--;
+	size_--;
+	for (; j < end; j++) {
+	  element_[j] = element_[j+1];
+	  index_[j] = index_[j+1];
+	}
+      }
+    } else if (newElements[i] || keepZero) {
+      if (!addedEntries) {
+	addedEntries = new int[majorDim_];
+	CoinZeroN(addedEntries, majorDim_);
+	added = new int[number];
+      }
+      addedEntries[majorIndex]++;
+      added[numberAdded++] = i;
+    }
+  }
+  if (numberAdded) {
+    bool enough = true;
+    for (int k = 0; k < numberAdded; k++) {
+      const int majorIndex = major[added[k]];
+      if (start_[majorIndex]+length_[majorIndex]+addedEntries[majorIndex] >
+	  start_[majorIndex+1])
+	enough = false;
+    }
+    if (!enough)
+      resizeForAddingMinorVectors(addedEntries);
+    // insert keeping minor order if it was in order
+    for (int k = 0; k < numberAdded; k++) {
+      const int i = added[k];
+      const int majorIndex = major[i];
+      const int minorIndex = minor[i];
+      const CoinBigIndex start = start_[majorIndex];
+      CoinBigIndex j;
+      for (j = start+length_[majorIndex]-1; j >= start; --j) {
+	if (index_[j] < minorIndex)
+	  break;
+	index_[j+1] = index_[j];
+	element_[j+1] = element_[j];
+      }
+      ++j;
+      index_[j] = minorIndex;
+      element_[j] = newElements[i];
+      size_++;
+      length_[majorIndex]++;
+    }
+  }
+  delete [] addedEntries;
+  delete [] added;
+}
 /* Return one element of packed matrix.
    This works for either ordering
    If it is not present will return 0.0 */
 double 
 CoinPackedMatrix::getCoefficient(int row, int column) const
 {
+  if (tail_) {
+    const int first = minorDim_ - tail_->majorDim_;
+    if (colOrdered_ && row >= first && row < minorDim_)
+      return (column >= 0 && column < tail_->minorDim_) ?
+	tail_->getCoefficient(row - first, column) : 0.0;
+    if (!colOrdered_ && column >= first && column < minorDim_)
+      return (row >= 0 && row < tail_->minorDim_) ?
+	tail_->getCoefficient(row, column - first) : 0.0;
+  }
   int minorIndex,majorIndex;
   if (colOrdered_) {
     majorIndex=column;
@@ -504,6 +699,237 @@ CoinPackedMatrix::getCoefficient(int row, int column) const
   return value;
 }
 
+//#############################################################################
+// Threaded clean up.  Each thread cleans a block of major vectors in place
+// (each vector stays where it starts), then if the matrix is to be packed
+// the new starts are summed and each thread copies its block to new arrays.
+// Each vector gets the same operations in the same order as in the serial
+// code, so the result is the same.
+
+// Threads used for clean up
+static int coinCleanThreads = 1;
+// Fewer elements than this are always cleaned serially
+static const CoinBigIndex coinCleanMinimum = 200000;
+
+typedef struct {
+  CoinBigIndex * start;
+  int * length;
+  int * index;
+  double * element;
+  // major vectors for this thread
+  int firstMajor;
+  int lastMajor;
+  int numberMinor;
+  double threshold;
+  // copy
+  const CoinBigIndex * newStart;
+  int * newIndex;
+  double * newElement;
+  CoinBigIndex numberEliminated;
+  /* 0 - compress, 1 - eliminateDuplicates, 2 - same and sort,
+     3 - remove elements not above threshold, 4 - copy */
+  int type;
+} CoinCleanThread;
+
+static void *
+coinCleanWorker(void * info)
+{
+  CoinCleanThread * thread = reinterpret_cast<CoinCleanThread *>(info);
+  const CoinBigIndex * start = thread->start;
+  int * COIN_RESTRICT length = thread->length;
+  int * COIN_RESTRICT index = thread->index;
+  double * COIN_RESTRICT element = thread->element;
+  const double threshold = thread->threshold;
+  CoinBigIndex numberEliminated = 0;
+  switch (thread->type) {
+  case 0:
+    {
+      int maximumLength = 0;
+      for (int i = thread->firstMajor; i < thread->lastMajor; i++)
+	maximumLength = CoinMax(maximumLength, length[i]);
+      int * eliminatedIndex = new int[maximumLength];
+      double * eliminatedElement = new double[maximumLength];
+      for (int i = thread->firstMajor; i < thread->lastMajor; i++) {
+	CoinBigIndex k = start[i];
+	int kbad = 0;
+	for (CoinBigIndex j = start[i]; j < start[i] + length[i]; j++) {
+	  if (fabs(element[j]) >= threshold) {
+	    element[k] = element[j];
+	    index[k++] = index[j];
+	  } else {
+	    eliminatedElement[kbad] = element[j];
+	    eliminatedIndex[kbad++] = index[j];
+	  }
+	}
+	if (kbad) {
+	  numberEliminated += kbad;
+	  length[i] = k - start[i];
+	  memcpy(index + k, eliminatedIndex, kbad * sizeof(int));
+	  memcpy(element + k, eliminatedElement, kbad * sizeof(double));
+	}
+      }
+      delete [] eliminatedIndex;
+      delete [] eliminatedElement;
+    }
+    break;
+  case 1:
+  case 2:
+    {
+      int * mark = new int [thread->numberMinor];
+      for (int i = 0; i < thread->numberMinor; i++)
+	mark[i] = -1;
+      for (int i = thread->firstMajor; i < thread->lastMajor; i++) {
+	CoinBigIndex k = start[i];
+	CoinBigIndex end = k + length[i];
+	CoinBigIndex j;
+	for (j = k; j < end; j++) {
+	  int iMinor = index[j];
+	  if (mark[iMinor] == -1) {
+	    mark[iMinor] = j;
+	  } else {
+	    // duplicate
+	    int jj = mark[iMinor];
+	    element[jj] += element[j];
+	    element[j] = 0.0;
+	  }
+	}
+	for (j = k; j < end; j++) {
+	  int iMinor = index[j];
+	  mark[iMinor] = -1;
+	  if (fabs(element[j]) >= threshold) {
+	    element[k] = element[j];
+	    index[k++] = index[j];
+	  }
+	}
+	numberEliminated += end - k;
+	length[i] = k - start[i];
+	if (thread->type == 2)
+	  CoinSort_2(index + start[i], index + k, element + start[i]);
+      }
+      delete [] mark;
+    }
+    break;
+  case 3:
+    for (int i = thread->firstMajor; i < thread->lastMajor; i++) {
+      CoinBigIndex k = start[i];
+      CoinBigIndex end = k + length[i];
+      for (CoinBigIndex j = k; j < end; j++) {
+	double value = element[j];
+	if (fabs(value) > threshold) {
+	  index[k] = index[j];
+	  element[k++] = value;
+	}
+      }
+      numberEliminated += end - k;
+      length[i] = k - start[i];
+    }
+    break;
+  case 4:
+    {
+      const CoinBigIndex * newStart = thread->newStart;
+      int * COIN_RESTRICT newIndex = thread->newIndex;
+      double * COIN_RESTRICT newElement = thread->newElement;
+      for (int i = thread->firstMajor; i < thread->lastMajor; i++) {
+	CoinMemcpyN(index + start[i], length[i], newIndex + newStart[i]);
+	CoinMemcpyN(element + start[i], length[i], newElement + newStart[i]);
+      }
+    }
+    break;
+  }
+  thread->numberEliminated = numberEliminated;
+  return NULL;
+}
+// Number of threads to clean matrix (1 if not worth it)
+static int
+coinCleanThreadCount(CoinBigIndex size, int majorDim, int minorDim)
+{
+  int numberThreads = size >= coinCleanMinimum ?
+    CoinMin(coinCleanThreads, majorDim) : 1;
+  // marks for each thread should not be more than the elements
+  while (numberThreads > 1 &&
+	 static_cast<CoinBigIndex>(numberThreads) * minorDim > size)
+    numberThreads--;
+  return numberThreads;
+}
+// Blocks of major vectors with about the same number of elements
+static CoinCleanThread *
+coinCleanSplit(int numberThreads, CoinBigIndex * start, int * length,
+	       int * index, double * element, int majorDim, int minorDim,
+	       CoinBigIndex size, double threshold)
+{
+  CoinCleanThread * thread = new CoinCleanThread [numberThreads];
+  const CoinBigIndex perThread = size / numberThreads + 1;
+  int iMajor = 0;
+  for (int i = 0; i < numberThreads; i++) {
+    CoinCleanThread & info = thread[i];
+    info.start = start;
+    info.length = length;
+    info.index = index;
+    info.element = element;
+    info.firstMajor = iMajor;
+    CoinBigIndex n = 0;
+    while (iMajor < majorDim && (n < perThread || i == numberThreads - 1))
+      n += length[iMajor++];
+    info.lastMajor = iMajor;
+    info.numberMinor = minorDim;
+    info.threshold = threshold;
+    info.newStart = NULL;
+    info.newIndex = NULL;
+    info.newElement = NULL;
+    info.numberEliminated = 0;
+    info.type = 0;
+  }
+  return thread;
+}
+// Runs all threads and returns number of elements eliminated
+static CoinBigIndex
+coinCleanRun(CoinCleanThread * thread, int numberThreads, int type)
+{
+  for (int i = 0; i < numberThreads; i++)
+    thread[i].type = type;
+  CoinThreadPool::run(coinCleanWorker, thread, sizeof(CoinCleanThread),
+		      numberThreads);
+  CoinBigIndex numberEliminated = 0;
+  for (int i = 0; i < numberThreads; i++)
+    numberEliminated += thread[i].numberEliminated;
+  return numberEliminated;
+}
+// Copies vectors to new arrays with no gaps and returns new starts
+static CoinBigIndex *
+coinCleanPack(CoinCleanThread * thread, int numberThreads, int majorDim,
+	      int * newIndex, double * newElement)
+{
+  const int * length = thread[0].length;
+  CoinBigIndex * newStart = new CoinBigIndex [majorDim + 1];
+  newStart[0] = 0;
+  for (int i = 0; i < majorDim; i++)
+    newStart[i+1] = newStart[i] + length[i];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i].newStart = newStart;
+    thread[i].newIndex = newIndex;
+    thread[i].newElement = newElement;
+  }
+  coinCleanRun(thread, numberThreads, 4);
+  return newStart;
+}
+
+void
+CoinPackedMatrix::setCleanThreads(int numberThreads)
+{
+#ifdef COINUTILS_PTHREADS
+  coinCleanThreads = CoinMax(numberThreads, 1);
+#else
+  coinCleanThreads = 1;
+  (void) numberThreads;
+#endif
+}
+
+int
+CoinPackedMatrix::cleanThreads()
+{
+  return coinCleanThreads;
+}
+
 //#############################################################################
 /* Eliminate all elements in matrix whose 
    absolute value is less than threshold.
@@ -513,6 +939,19 @@ CoinPackedMatrix::getCoefficient(int row, int column) const
 int 
 CoinPackedMatrix::compress(double threshold)
 {
+  if (tail_)
+    compactTail();
+  invalidateReverse();
+  const int numberThreads = coinCleanThreadCount(size_, majorDim_, 0);
+  if (numberThreads > 1) {
+    CoinCleanThread * thread =
+      coinCleanSplit(numberThreads, start_, length_, index_, element_,
+		     majorDim_, minorDim_, size_, threshold);
+    CoinBigIndex numberEliminated = coinCleanRun(thread, numberThreads, 0);
+    delete [] thread;
+    size_ -= numberEliminated;
+    return numberEliminated;
+  }
   CoinBigIndex numberEliminated =0;
   // space for eliminated
   int * eliminatedIndex = new int[minorDim_];
@@ -553,6 +992,19 @@ CoinPackedMatrix::compress(double threshold)
 int 
 CoinPackedMatrix::eliminateDuplicates(double threshold)
 {
+  if (tail_)
+    compactTail();
+  invalidateReverse();
+  const int numberThreads = coinCleanThreadCount(size_, majorDim_, minorDim_);
+  if (numberThreads > 1) {
+    CoinCleanThread * thread =
+      coinCleanSplit(numberThreads, start_, length_, index_, element_,
+		     majorDim_, minorDim_, size_, threshold);
+    CoinBigIndex numberEliminated = coinCleanRun(thread, numberThreads, 1);
+    delete [] thread;
+    size_ -= numberEliminated;
+    return numberEliminated;
+  }
   CoinBigIndex numberEliminated =0;
   // space for eliminated
   int * mark = new int [minorDim_];
@@ -594,6 +1046,31 @@ CoinPackedMatrix::eliminateDuplicates(double threshold)
 void
 CoinPackedMatrix::removeGaps(double removeValue)
 {
+  if (tail_)
+    compactTail();
+  if (removeValue>=0.0)
+    invalidateReverse();
+  const int numberThreads = (removeValue>=0.0 || size_<start_[majorDim_]) ?
+    coinCleanThreadCount(size_, majorDim_, 0) : 1;
+  if (numberThreads > 1) {
+    CoinCleanThread * thread =
+      coinCleanSplit(numberThreads, start_, length_, index_, element_,
+		     majorDim_, minorDim_, size_, removeValue);
+    if (removeValue>=0.0)
+      size_ -= coinCleanRun(thread, numberThreads, 3);
+    int * newIndex = new int [maxSize_];
+    double * newElement = new double [maxSize_];
+    CoinBigIndex * newStart =
+      coinCleanPack(thread, numberThreads, majorDim_, newIndex, newElement);
+    delete [] thread;
+    CoinMemcpyN(newStart, majorDim_+1, start_);
+    delete [] newStart;
+    delete [] index_;
+    index_ = newIndex;
+    delete [] element_;
+    element_ = newElement;
+    return;
+  }
   if (removeValue<0.0) {
     if (size_<start_[majorDim_]) {
 #if 1
@@ -674,11 +1151,41 @@ CoinPackedMatrix::removeGaps(double removeValue)
 int 
 CoinPackedMatrix::cleanMatrix(double threshold)
 {
+  if (tail_)
+    compactTail();
+  invalidateReverse();
   if (!majorDim_) {
     extraGap_=0.0;
     extraMajor_=0.0;
     return 0;
   }
+  const int numberThreads = coinCleanThreadCount(size_, majorDim_, minorDim_);
+  if (numberThreads > 1) {
+    CoinCleanThread * thread =
+      coinCleanSplit(numberThreads, start_, length_, index_, element_,
+		     majorDim_, minorDim_, size_, threshold);
+    CoinBigIndex numberEliminated = coinCleanRun(thread, numberThreads, 2);
+    size_ -= numberEliminated;
+    int * newIndex = new int [size_];
+    double * newElement = new double [size_];
+    CoinBigIndex * newStart =
+      coinCleanPack(thread, numberThreads, majorDim_, newIndex, newElement);
+    delete [] thread;
+    extraGap_=0.0;
+    extraMajor_=0.0;
+    maxMajorDim_=majorDim_;
+    maxSize_=size_;
+    int * temp = CoinCopyOfArray(length_,majorDim_);
+    delete [] length_;
+    length_ = temp;
+    delete [] start_;
+    start_ = newStart;
+    delete [] index_;
+    index_ = newIndex;
+    delete [] element_;
+    element_ = newElement;
+    return numberEliminated;
+  }
   CoinBigIndex numberEliminated =0;
   // space for eliminated
   int * mark = new int [minorDim_];
@@ -746,11 +1253,18 @@ void
 CoinPackedMatrix::submatrixOf(const CoinPackedMatrix& matrix,
 			     const int numMajor, const int * indMajor)
 {
+   if (matrix.tail_) {
+      CoinPackedMatrix full(matrix);
+      submatrixOf(full, numMajor, indMajor);
+      return;
+   }
    int i;
    int* sortedIndPtr = CoinTestIndexSet(numMajor, indMajor, matrix.majorDim_,
 				       "submatrixOf");
    const int * sortedInd = sortedIndPtr == 0 ? indMajor : sortedIndPtr;
 
+   invalidateReverse();
+   discardTail();
    gutsOfDestructor();
 
    // Count how many nonzeros there'll be
@@ -793,8 +1307,15 @@ void
 CoinPackedMatrix::submatrixOfWithDuplicates(const CoinPackedMatrix& matrix,
 			     const int numMajor, const int * indMajor)
 {
+  if (matrix.tail_) {
+    CoinPackedMatrix full(matrix);
+    submatrixOfWithDuplicates(full, numMajor, indMajor);
+    return;
+  }
   int i;
   // we allow duplicates - can be useful
+  invalidateReverse();
+  discardTail();
 #ifndef NDEBUG
   for (i=0; i<numMajor;i++) {
     if (indMajor[i]<0||indMajor[i]>=matrix.majorDim_)
@@ -848,11 +1369,14 @@ void
 CoinPackedMatrix::copyOf(const CoinPackedMatrix& rhs)
 {
    if (this != &rhs) {
+      invalidateReverse();
+      discardTail();
       gutsOfDestructor();
       gutsOfCopyOf(rhs.colOrdered_,
 		   rhs.minorDim_, rhs.majorDim_, rhs.size_,
 		   rhs.element_, rhs.index_, rhs.start_, rhs.length_,
 		   rhs.extraMajor_, rhs.extraGap_);
+      copyTailOf(rhs);
    }
 }
 
@@ -866,6 +1390,8 @@ CoinPackedMatrix::copyOf(const bool colordered,
 			const CoinBigIndex * start, const int * len,
 			const double extraMajor, const double extraGap)
 {
+   invalidateReverse();
+   discardTail();
    gutsOfDestructor();
    gutsOfCopyOf(colordered, minor, major, numels, elem, ind, start, len,
 		extraMajor, extraGap);
@@ -878,6 +1404,13 @@ void
 CoinPackedMatrix::copyReuseArrays(const CoinPackedMatrix& rhs)
 {
   assert (colOrdered_==rhs.colOrdered_);
+  if (rhs.tail_) {
+    CoinPackedMatrix full(rhs);
+    copyReuseArrays(full);
+    return;
+  }
+  invalidateReverse();
+  discardTail();
   if (maxMajorDim_>=rhs.majorDim_&&maxSize_>=rhs.size_) {
     majorDim_ = rhs.majorDim_;
     minorDim_ = rhs.minorDim_;
@@ -903,6 +1436,151 @@ CoinPackedMatrix::copyReuseArrays(const CoinPackedMatrix& rhs)
   }
 }
 
+//#############################################################################
+// Threaded reverse ordered copy.  Each thread counts the entries of a block
+// of major vectors of the source, so per-thread offsets within each new major
+// vector keep the entries in source order and the result is the same as the
+// serial one.
+
+// Threads used for reverse ordered copies
+static int coinTransposeThreads = 1;
+// Fewer elements than this are always copied serially
+static const CoinBigIndex coinTransposeMinimum = 200000;
+
+typedef struct {
+  // source
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  // source major vectors for this thread
+  int firstMajor;
+  int lastMajor;
+  // new major vectors for this thread
+  int firstMinor;
+  int lastMinor;
+  // numberThreads blocks of counts (later positions) for each new major
+  CoinBigIndex * counts;
+  int numberThreads;
+  int which;
+  int numberMinor;
+  double extraGap;
+  // copy
+  int * newLength;
+  CoinBigIndex * newStart;
+  int * newIndex;
+  double * newElement;
+  // space needed by new majors of thread (then where it starts)
+  CoinBigIndex blockSize;
+  /* 0 - count, 1 - lengths and offsets within vectors,
+     2 - starts and positions, 3 - scatter */
+  int type;
+} CoinTransposeThread;
+
+static void *
+coinTransposeWorker(void * info)
+{
+  CoinTransposeThread * thread =
+    reinterpret_cast<CoinTransposeThread *>(info);
+  const int numberMinor = thread->numberMinor;
+  const int numberThreads = thread->numberThreads;
+  switch (thread->type) {
+  case 0:
+    {
+      CoinBigIndex * COIN_RESTRICT count =
+	thread->counts + thread->which * numberMinor;
+      CoinZeroN(count, numberMinor);
+      const int * COIN_RESTRICT index = thread->index;
+      for (int i = thread->firstMajor; i < thread->lastMajor; i++) {
+	const CoinBigIndex end = thread->start[i] + thread->length[i];
+	for (CoinBigIndex j = thread->start[i]; j < end; j++)
+	  count[index[j]]++;
+      }
+    }
+    break;
+  case 1:
+    {
+      CoinBigIndex * COIN_RESTRICT counts = thread->counts;
+      int * COIN_RESTRICT newLength = thread->newLength;
+      const double extraGap = thread->extraGap;
+      CoinBigIndex size = 0;
+      for (int i = thread->firstMinor; i < thread->lastMinor; i++) {
+	CoinBigIndex total = 0;
+	for (int k = 0; k < numberThreads; k++) {
+	  CoinBigIndex n = counts[k * numberMinor + i];
+	  counts[k * numberMinor + i] = total;
+	  total += n;
+	}
+	newLength[i] = static_cast<int>(total);
+	size += extraGap ? CoinLengthWithExtra(total, extraGap) : total;
+      }
+      thread->blockSize = size;
+    }
+    break;
+  case 2:
+    {
+      CoinBigIndex * COIN_RESTRICT counts = thread->counts;
+      const int * COIN_RESTRICT newLength = thread->newLength;
+      CoinBigIndex * COIN_RESTRICT newStart = thread->newStart;
+      const double extraGap = thread->extraGap;
+      CoinBigIndex put = thread->blockSize;
+      for (int i = thread->firstMinor; i < thread->lastMinor; i++) {
+	newStart[i] = put;
+	for (int k = 0; k < numberThreads; k++)
+	  counts[k * numberMinor + i] += put;
+	put += extraGap ? CoinLengthWithExtra(static_cast<CoinBigIndex>(newLength[i]),
+					      extraGap) : newLength[i];
+      }
+    }
+    break;
+  case 3:
+    {
+      CoinBigIndex * COIN_RESTRICT position =
+	thread->counts + thread->which * numberMinor;
+      const int * COIN_RESTRICT index = thread->index;
+      const double * COIN_RESTRICT element = thread->element;
+      int * COIN_RESTRICT newIndex = thread->newIndex;
+      double * COIN_RESTRICT newElement = thread->newElement;
+      for (int i = thread->firstMajor; i < thread->lastMajor; i++) {
+	const CoinBigIndex end = thread->start[i] + thread->length[i];
+	for (CoinBigIndex j = thread->start[i]; j < end; j++) {
+	  const CoinBigIndex put = position[index[j]]++;
+	  newElement[put] = element[j];
+	  newIndex[put] = i;
+	}
+      }
+    }
+    break;
+  }
+  return NULL;
+}
+// Runs all threads - first one in this thread
+static void
+coinTransposeRun(CoinTransposeThread * thread, int numberThreads, int type)
+{
+  for (int i = 0; i < numberThreads; i++)
+    thread[i].type = type;
+  CoinThreadPool::run(coinTransposeWorker, thread, sizeof(CoinTransposeThread),
+		      numberThreads);
+}
+
+void
+CoinPackedMatrix::setTransposeThreads(int numberThreads)
+{
+#ifdef COINUTILS_PTHREADS
+  coinTransposeThreads = CoinMax(numberThreads, 1);
+#else
+  coinTransposeThreads = 1;
+  (void) numberThreads;
+#endif
+}
+
+int
+CoinPackedMatrix::transposeThreads()
+{
+  return coinTransposeThreads;
+}
+
 //#############################################################################
 
 // This method is essentially the same as minorAppendOrthoOrdered(). However,
@@ -915,6 +1593,13 @@ CoinPackedMatrix::reverseOrderedCopyOf(const CoinPackedMatrix& rhs)
       reverseOrdering();
       return;
    }
+   if (rhs.tail_) {
+      CoinPackedMatrix full(rhs);
+      reverseOrderedCopyOf(full);
+      return;
+   }
+   invalidateReverse();
+   discardTail();
 
    int i;
    colOrdered_ = !rhs.colOrdered_;
@@ -954,18 +1639,72 @@ CoinPackedMatrix::reverseOrderedCopyOf(const CoinPackedMatrix& rhs)
       start_ = new CoinBigIndex[maxMajorDim_ + 1];
       length_ = new int[maxMajorDim_];
    }
-   // first compute how long each major-dimension vector will be
-   int * COIN_RESTRICT orthoLength = length_;
-   rhs.countOrthoLength(orthoLength);
-
-   start_[0] = 0;
-   if (extraGap_ == 0) {
-      for (i = 0; i < majorDim_; ++i)
-	 start_[i+1] = start_[i] + orthoLength[i];
+   int numberThreads = rhs.size_ >= coinTransposeMinimum ?
+     CoinMin(coinTransposeThreads, rhs.majorDim_) : 1;
+   // counts for each thread should not be more than the elements
+   while (numberThreads > 1 &&
+	  static_cast<CoinBigIndex>(numberThreads) * majorDim_ > rhs.size_)
+     numberThreads--;
+   CoinTransposeThread * thread = NULL;
+   if (numberThreads > 1) {
+      /* Blocks of source vectors with about the same number of elements,
+	 blocks of new vectors with about the same number of vectors */
+      thread = new CoinTransposeThread [numberThreads];
+      CoinBigIndex * counts =
+	new CoinBigIndex [static_cast<CoinBigIndex>(numberThreads) * majorDim_];
+      const CoinBigIndex perThread = rhs.size_ / numberThreads + 1;
+      int iMajor = 0;
+      for (i = 0; i < numberThreads; i++) {
+	CoinTransposeThread & info = thread[i];
+	info.start = rhs.start_;
+	info.length = rhs.length_;
+	info.index = rhs.index_;
+	info.element = rhs.element_;
+	info.firstMajor = iMajor;
+	CoinBigIndex n = 0;
+	while (iMajor < rhs.majorDim_ &&
+	       (n < perThread || i == numberThreads - 1))
+	  n += rhs.length_[iMajor++];
+	info.lastMajor = iMajor;
+	info.firstMinor = static_cast<int>((static_cast<CoinBigIndex>(majorDim_) * i) /
+					   numberThreads);
+	info.lastMinor = static_cast<int>((static_cast<CoinBigIndex>(majorDim_) * (i + 1)) /
+					  numberThreads);
+	info.counts = counts;
+	info.numberThreads = numberThreads;
+	info.which = i;
+	info.numberMinor = majorDim_;
+	info.extraGap = extraGap_;
+	info.newLength = length_;
+	info.newStart = start_;
+	info.newIndex = NULL;
+	info.newElement = NULL;
+	info.blockSize = 0;
+      }
+      coinTransposeRun(thread, numberThreads, 0);
+      coinTransposeRun(thread, numberThreads, 1);
+      CoinBigIndex size = 0;
+      for (i = 0; i < numberThreads; i++) {
+	CoinBigIndex n = thread[i].blockSize;
+	thread[i].blockSize = size;
+	size += n;
+      }
+      coinTransposeRun(thread, numberThreads, 2);
+      start_[majorDim_] = size;
    } else {
-      const double eg = extraGap_;
-      for (i = 0; i < majorDim_; ++i)
-	start_[i+1] = start_[i] + CoinLengthWithExtra(orthoLength[i], eg);
+      // first compute how long each major-dimension vector will be
+      int * COIN_RESTRICT orthoLength = length_;
+      rhs.countOrthoLength(orthoLength);
+
+      start_[0] = 0;
+      if (extraGap_ == 0) {
+         for (i = 0; i < majorDim_; ++i)
+	    start_[i+1] = start_[i] + orthoLength[i];
+      } else {
+         const double eg = extraGap_;
+         for (i = 0; i < majorDim_; ++i)
+	    start_[i+1] = start_[i] + CoinLengthWithExtra(orthoLength[i], eg);
+      }
    }
 
    const CoinBigIndex newMaxSize =
@@ -986,6 +1725,16 @@ CoinPackedMatrix::reverseOrderedCopyOf(const CoinPackedMatrix& rhs)
    // now insert the entries of matrix
    
    minorDim_ = rhs.majorDim_;
+   if (thread) {
+      for (i = 0; i < numberThreads; i++) {
+	thread[i].newIndex = index_;
+	thread[i].newElement = element_;
+      }
+      coinTransposeRun(thread, numberThreads, 3);
+      delete [] thread[0].counts;
+      delete [] thread;
+      return;
+   }
    const CoinBigIndex * COIN_RESTRICT start = rhs.start_;
    const int * COIN_RESTRICT index = rhs.index_;
    const int * COIN_RESTRICT length = rhs.length_;
@@ -1045,6 +1794,8 @@ CoinPackedMatrix::assignMatrix(const bool colordered,
 			      CoinBigIndex *& start, int *& len,
 			      const int maxmajor, const CoinBigIndex maxsize)
 {
+   invalidateReverse();
+   discardTail();
    gutsOfDestructor();
    colOrdered_ = colordered;
    element_ = elem;
@@ -1059,7 +1810,8 @@ CoinPackedMatrix::assignMatrix(const bool colordered,
      delete [] length_;
      length_ = new int[maxMajorDim_];
      std::adjacent_difference(start + 1, start + (major + 1), length_);
-     length_[0] -= start[0];
+     if (major)
+       length_[0] -= start[0];
    } else {
      length_ = len;
    }
@@ -1069,31 +1821,115 @@ CoinPackedMatrix::assignMatrix(const bool colordered,
    len = NULL;
 }
 
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::releaseMatrix(double *& elem, int *& ind,
+			       CoinBigIndex *& start, int *& len,
+			       int & maxmajor, CoinBigIndex & maxsize)
+{
+   compactTail();
+   invalidateReverse();
+   if (borrowed_) {
+      // caller must own what it gets
+      const CoinBigIndex last = start_[majorDim_];
+      elem = CoinCopyOfArray(element_, last);
+      ind = CoinCopyOfArray(index_, last);
+      start = CoinCopyOfArray(start_, majorDim_ + 1);
+      len = CoinCopyOfArray(length_, majorDim_);
+      maxmajor = majorDim_;
+      maxsize = last;
+   } else {
+      elem = element_;
+      ind = index_;
+      start = start_;
+      len = length_;
+      maxmajor = maxMajorDim_;
+      maxsize = maxSize_;
+   }
+   element_ = NULL;
+   index_ = NULL;
+   length_ = NULL;
+   borrowed_ = false;
+   start_ = new CoinBigIndex[1];
+   start_[0] = 0;
+   majorDim_ = 0;
+   minorDim_ = 0;
+   size_ = 0;
+   maxMajorDim_ = 0;
+   maxSize_ = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::borrowMatrix(const bool colordered,
+			      const int minor, const int major,
+			      const CoinBigIndex numels,
+			      const double * elem, const int * ind,
+			      const CoinBigIndex * start, const int * len)
+{
+   invalidateReverse();
+   discardTail();
+   gutsOfDestructor();
+   colOrdered_ = colordered;
+   // never written or freed while borrowed_
+   element_ = const_cast<double *>(elem);
+   index_ = const_cast<int *>(ind);
+   start_ = const_cast<CoinBigIndex *>(start);
+   length_ = const_cast<int *>(len);
+   majorDim_ = major;
+   minorDim_ = minor;
+   size_ = numels;
+   maxMajorDim_ = major;
+   maxSize_ = numels;
+   borrowed_ = true;
+}
+
 //#############################################################################
 
 CoinPackedMatrix &
 CoinPackedMatrix::operator=(const CoinPackedMatrix& rhs)
 {
    if (this != &rhs) {
+      invalidateReverse();
+      discardTail();
       gutsOfDestructor();
       extraGap_=rhs.extraGap_;
       extraMajor_=rhs.extraMajor_;
       gutsOfOpEqual(rhs.colOrdered_,
 		    rhs.minorDim_,  rhs.majorDim_, rhs.size_,
 		    rhs.element_, rhs.index_, rhs.start_, rhs.length_);
+      copyTailOf(rhs);
    }
    return *this;
 }
 
+//-----------------------------------------------------------------------------
+
+#if COIN_HAS_MOVE
+CoinPackedMatrix &
+CoinPackedMatrix::operator=(CoinPackedMatrix&& rhs) COIN_NOEXCEPT
+{
+   swap(rhs);
+   return *this;
+}
+#endif
+
 //#############################################################################
 
 void
 CoinPackedMatrix::reverseOrdering()
 {
+   if (tail_)
+      compactTail();
    CoinPackedMatrix m;
    m.extraGap_ = extraMajor_;
    m.extraMajor_ = extraGap_;
    m.reverseOrderedCopyOf(*this);
+   m.dualOrientation_ = dualOrientation_;
+   m.blockAppend_ = blockAppend_;
+   m.tailFraction_ = tailFraction_;
    swap(m);
 }
 
@@ -1102,6 +1938,9 @@ CoinPackedMatrix::reverseOrdering()
 void
 CoinPackedMatrix::transpose()
 {
+   if (tail_)
+      compactTail();
+   invalidateReverse();
    colOrdered_ = ! colOrdered_;
 }
 
@@ -1122,8 +1961,186 @@ CoinPackedMatrix::swap(CoinPackedMatrix& m)
    std::swap(size_,	   m.size_);
    std::swap(maxMajorDim_, m.maxMajorDim_);
    std::swap(maxSize_,     m.maxSize_);
+   std::swap(dualOrientation_, m.dualOrientation_);
+   std::swap(reverse_,     m.reverse_);
+   std::swap(blockAppend_, m.blockAppend_);
+   std::swap(tailFraction_, m.tailFraction_);
+   std::swap(tail_,        m.tail_);
+   std::swap(borrowed_,    m.borrowed_);
 }
 
+//#############################################################################
+
+void
+CoinPackedMatrix::setDualOrientation(bool yesNo)
+{
+   dualOrientation_ = yesNo;
+   if (!yesNo)
+      invalidateReverse();
+}
+
+//-----------------------------------------------------------------------------
+
+const CoinPackedMatrix *
+CoinPackedMatrix::getReverseOrderedCopy() const
+{
+   if (!dualOrientation_)
+      return NULL;
+   checkReverse();
+   if (!reverse_) {
+      // same extra space as reverseOrdering so both copies can grow
+      reverse_ = new CoinPackedMatrix(!colOrdered_, extraGap_, extraMajor_);
+      reverse_->reverseOrderedCopyOf(*this);
+   }
+   return reverse_;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::invalidateReverse() const
+{
+   delete reverse_;
+   reverse_ = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::checkReverse() const
+{
+   // anything not kept up to date shows up as a change in size
+   if (reverse_ &&
+       (reverse_->getNumRows() != getNumRows() ||
+	reverse_->getNumCols() != getNumCols() ||
+	reverse_->getNumElements() != size_ + (tail_ ? tail_->size_ : 0)))
+      invalidateReverse();
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrix::setBlockAppend(bool yesNo, double maximumFraction)
+{
+   if (maximumFraction < 0.0)
+      throw CoinError("negative maximum fraction",
+		      "setBlockAppend", "CoinPackedMatrix");
+   tailFraction_ = maximumFraction;
+   if (!yesNo && tail_)
+      compactTail();
+   blockAppend_ = yesNo;
+   if (tail_)
+      checkTail();
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::compactTail()
+{
+   if (!tail_)
+      return;
+   CoinPackedMatrix * tail = tail_;
+   tail_ = NULL;
+   tail->minorDim_ = majorDim_;
+   minorDim_ -= tail->majorDim_;
+   // one pass over matrix for all tail vectors
+   const bool saveBlockAppend = blockAppend_;
+   blockAppend_ = false;
+   minorAppendOrthoOrdered(*tail);
+   blockAppend_ = saveBlockAppend;
+   delete tail;
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrix *
+CoinPackedMatrix::tail()
+{
+   if (!tail_)
+      tail_ = new CoinPackedMatrix(!colOrdered_, 1.0, 0.0);
+   // minor vectors in tail may have entries in any major vector
+   tail_->minorDim_ = CoinMax(tail_->minorDim_, majorDim_);
+   return tail_;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::checkTail()
+{
+   if (tail_ && tail_->size_ > tailFraction_ * size_)
+      compactTail();
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::discardTail()
+{
+   delete tail_;
+   tail_ = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::copyTailOf(const CoinPackedMatrix & rhs)
+{
+   if (rhs.tail_) {
+      tail_ = new CoinPackedMatrix(*rhs.tail_);
+      compactTail();
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::timesTail(const double * x, double * y,
+			    bool afterMajor) const
+{
+   const int first = minorDim_ - tail_->majorDim_;
+   if (afterMajor) {
+      // y over minor vectors - dot products for the tail ones
+      tail_->timesMinor(x, y + first);
+   } else {
+      // x over minor vectors - scatter the tail ones
+      for (int k = 0; k < tail_->majorDim_; k++) {
+	 const double x_k = x[first + k];
+	 if (x_k != 0.0) {
+	    const CoinBigIndex last = tail_->getVectorLast(k);
+	    for (CoinBigIndex j = tail_->getVectorFirst(k); j < last; ++j)
+	       y[tail_->index_[j]] += x_k * tail_->element_[j];
+	 }
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+#ifndef CLP_NO_VECTOR
+void
+CoinPackedMatrix::timesTail(const CoinPackedVectorBase& x, double * y,
+			    bool afterMajor) const
+{
+   const int first = minorDim_ - tail_->majorDim_;
+   if (afterMajor) {
+      tail_->timesMinor(x, y + first);
+   } else {
+      const int * index = x.getIndices();
+      const double * element = x.getElements();
+      for (int i = x.getNumElements() - 1; i >= 0; --i) {
+	 const int k = index[i] - first;
+	 const double x_k = element[i];
+	 if (k >= 0 && x_k != 0.0) {
+	    const CoinBigIndex last = tail_->getVectorLast(k);
+	    for (CoinBigIndex j = tail_->getVectorFirst(k); j < last; ++j)
+	       y[tail_->index_[j]] += x_k * tail_->element_[j];
+	 }
+      }
+   }
+}
+#endif
+
 //#############################################################################
 //#############################################################################
 
@@ -1134,6 +2151,9 @@ CoinPackedMatrix::times(const double * x, double * y) const
       timesMajor(x, y);
    else
       timesMinor(x, y);
+   if (tail_)
+      timesTail(x, y, colOrdered_);
+   CoinChargeWork(static_cast<double>(size_));
 }
 
 //-----------------------------------------------------------------------------
@@ -1145,6 +2165,9 @@ CoinPackedMatrix::times(const CoinPackedVectorBase& x, double * y) const
       timesMajor(x, y);
    else
       timesMinor(x, y);
+   if (tail_)
+      timesTail(x, y, colOrdered_);
+   CoinChargeWork(static_cast<double>(size_));
 }
 #endif
 //-----------------------------------------------------------------------------
@@ -1156,6 +2179,9 @@ CoinPackedMatrix::transposeTimes(const double * x, double * y) const
       timesMinor(x, y);
    else
       timesMajor(x, y);
+   if (tail_)
+      timesTail(x, y, !colOrdered_);
+   CoinChargeWork(static_cast<double>(size_));
 }
 
 //-----------------------------------------------------------------------------
@@ -1167,8 +2193,37 @@ CoinPackedMatrix::transposeTimes(const CoinPackedVectorBase& x, double * y) cons
       timesMinor(x, y);
    else
       timesMajor(x, y);
+   if (tail_)
+      timesTail(x, y, !colOrdered_);
+   CoinChargeWork(static_cast<double>(size_));
 }
 #endif
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::times(const CoinIndexedVector & x,
+			CoinIndexedVector & y) const
+{
+   if (colOrdered_)
+      timesMajor(x, y);
+   else
+      timesMinor(x, y);
+   CoinChargeWork(x.getNumElements()+y.getNumElements());
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::transposeTimes(const CoinIndexedVector & x,
+				 CoinIndexedVector & y) const
+{
+   if (colOrdered_)
+      timesMinor(x, y);
+   else
+      timesMajor(x, y);
+   CoinChargeWork(x.getNumElements()+y.getNumElements());
+}
 //#############################################################################
 //#############################################################################
 /* Count the number of entries in every minor-dimension vector and
@@ -1309,6 +2364,12 @@ CoinPackedMatrix::appendMinorVector(const int vecsize,
 				   const int *vecind,
 				   const double *vecelem)
 {
+  if (blockAppend_) {
+    tail()->appendMajorVector(vecsize, vecind, vecelem);
+    ++minorDim_;
+    checkTail();
+    return;
+  }
   if (vecsize == 0) {
     ++minorDim_; // empty row/column - still need to increase
     return;
@@ -1378,6 +2439,12 @@ CoinPackedMatrix::appendMinorVectors(const int numvecs,
 {
   if (numvecs == 0)
     return;
+  if (blockAppend_) {
+    tail()->appendMajorVectors(numvecs, vecs);
+    minorDim_ += numvecs;
+    checkTail();
+    return;
+  }
 
   int i;
 
@@ -1479,6 +2546,12 @@ CoinPackedMatrix::minorAppendSameOrdered(const CoinPackedMatrix& matrix)
    }
    if (matrix.minorDim_ == 0)
       return;
+   if (blockAppend_) {
+      tail()->majorAppendOrthoOrdered(matrix);
+      minorDim_ += matrix.minorDim_;
+      checkTail();
+      return;
+   }
 
    int i;
    for (i = majorDim_ - 1; i >= 0; --i) {
@@ -1576,6 +2649,12 @@ CoinPackedMatrix::minorAppendOrthoOrdered(const CoinPackedMatrix& matrix)
       }
    if (matrix.majorDim_ == 0)
       return;
+   if (blockAppend_) {
+      tail()->majorAppendSameOrdered(matrix);
+      minorDim_ += matrix.majorDim_;
+      checkTail();
+      return;
+   }
 
    int i;
    // first compute how many entries will be added to each major-dimension
@@ -1876,6 +2955,138 @@ CoinPackedMatrix::timesMinor(const CoinPackedVectorBase& x, double * y) const
    }
 }
 #endif
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::timesMajor(const CoinIndexedVector & x,
+			     CoinIndexedVector & y) const
+{
+   y.clear();
+   if (y.capacity() < minorDim_)
+      y.reserve(minorDim_);
+   const int number = x.getNumElements();
+   const int * which = x.getIndices();
+   const double * COIN_RESTRICT xValue = x.denseVector();
+   const bool packed = x.packedMode();
+   // work (and most possible nonzeros in y)
+   CoinBigIndex work = 0;
+   for (int k = 0; k < number; k++)
+      work += length_[which[k]];
+   if (4 * work < minorDim_) {
+      // sparse - add to index list as we go
+      for (int k = 0; k < number; k++) {
+	 const int i = which[k];
+	 const double x_i = packed ? xValue[k] : xValue[i];
+	 if (x_i != 0.0) {
+	    const CoinBigIndex last = getVectorLast(i);
+	    for (CoinBigIndex j = getVectorFirst(i); j < last; ++j)
+	       y.quickAdd(index_[j], x_i * element_[j]);
+	 }
+      }
+      y.clean(COIN_INDEXED_TINY_ELEMENT);
+   } else {
+      // dense - accumulate then one scan
+      double * COIN_RESTRICT yValue = y.denseVector();
+      for (int k = 0; k < number; k++) {
+	 const int i = which[k];
+	 const double x_i = packed ? xValue[k] : xValue[i];
+	 if (x_i != 0.0) {
+	    const CoinBigIndex last = getVectorLast(i);
+	    for (CoinBigIndex j = getVectorFirst(i); j < last; ++j)
+	       yValue[index_[j]] += x_i * element_[j];
+	 }
+      }
+      y.scan(0, minorDim_, COIN_INDEXED_TINY_ELEMENT);
+   }
+   if (tail_) {
+      // dot products for minor vectors in tail
+      const int first = minorDim_ - tail_->majorDim_;
+      double * expanded = NULL;
+      if (packed) {
+	 expanded = new double [majorDim_];
+	 CoinZeroN(expanded, majorDim_);
+	 for (int k = 0; k < number; k++)
+	    expanded[which[k]] = xValue[k];
+	 xValue = expanded;
+      }
+      for (int k = 0; k < tail_->majorDim_; k++) {
+	 double y_k = 0.0;
+	 const CoinBigIndex last = tail_->getVectorLast(k);
+	 for (CoinBigIndex j = tail_->getVectorFirst(k); j < last; ++j)
+	    y_k += xValue[tail_->index_[j]] * tail_->element_[j];
+	 if (fabs(y_k) >= COIN_INDEXED_TINY_ELEMENT)
+	    y.quickInsert(first + k, y_k);
+      }
+      delete [] expanded;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix::timesMinor(const CoinIndexedVector & x,
+			     CoinIndexedVector & y) const
+{
+   if (dualOrientation_) {
+      // scatter over reverse copy if that touches much less of matrix
+      const CoinPackedMatrix * reverse = getReverseOrderedCopy();
+      const int number = x.getNumElements();
+      const int * which = x.getIndices();
+      const int * reverseLength = reverse->getVectorLengths();
+      CoinBigIndex work = 0;
+      for (int k = 0; k < number; k++)
+	 work += reverseLength[which[k]];
+      if (3 * work < size_) {
+	 reverse->timesMajor(x, y);
+	 return;
+      }
+   }
+   y.clear();
+   if (y.capacity() < majorDim_)
+      y.reserve(majorDim_);
+   const double * xValue = x.denseVector();
+   double * expanded = NULL;
+   if (x.packedMode()) {
+      // need x by minor index
+      expanded = new double [minorDim_];
+      CoinZeroN(expanded, minorDim_);
+      const int number = x.getNumElements();
+      const int * which = x.getIndices();
+      for (int k = 0; k < number; k++)
+	 expanded[which[k]] = xValue[k];
+      xValue = expanded;
+   }
+   for (int i = 0; i < majorDim_; ++i) {
+      double y_i = 0;
+      const CoinBigIndex last = getVectorLast(i);
+      for (CoinBigIndex j = getVectorFirst(i); j < last; ++j)
+	 y_i += xValue[index_[j]] * element_[j];
+      if (fabs(y_i) >= COIN_INDEXED_TINY_ELEMENT)
+	 y.quickInsert(i, y_i);
+   }
+   delete [] expanded;
+   if (tail_) {
+      // scatter minor vectors in tail
+      const int first = minorDim_ - tail_->majorDim_;
+      const int number = x.getNumElements();
+      const int * which = x.getIndices();
+      const double * value = x.denseVector();
+      bool added = false;
+      for (int k = 0; k < number; k++) {
+	 const int i = which[k];
+	 const double x_i = x.packedMode() ? value[k] : value[i];
+	 if (i >= first && x_i != 0.0) {
+	    const CoinBigIndex last = tail_->getVectorLast(i - first);
+	    for (CoinBigIndex j = tail_->getVectorFirst(i - first); j < last; ++j)
+	       y.quickAdd(tail_->index_[j], x_i * tail_->element_[j]);
+	    added = true;
+	 }
+      }
+      if (added)
+	 y.clean(COIN_INDEXED_TINY_ELEMENT);
+   }
+}
 //#############################################################################
 //#############################################################################
 
@@ -1890,7 +3101,13 @@ CoinPackedMatrix::CoinPackedMatrix() :
    minorDim_(0),
    size_(0),
    maxMajorDim_(0),
-   maxSize_(0) 
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
   start_ = new CoinBigIndex[1];
   start_[0] = 0;
@@ -1911,7 +3128,13 @@ CoinPackedMatrix::CoinPackedMatrix(const bool colordered,
    minorDim_(0),
    size_(0),
    maxMajorDim_(0),
-   maxSize_(0)
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
   start_ = new CoinBigIndex[1];
   start_[0] = 0;
@@ -1937,7 +3160,13 @@ CoinPackedMatrix::CoinPackedMatrix(const bool colordered,
    minorDim_(0),
    size_(0),
    maxMajorDim_(0),
-   maxSize_(0)
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
    gutsOfOpEqual(colordered, minor, major, numels, elem, ind, start, len);
 }
@@ -1960,7 +3189,13 @@ CoinPackedMatrix::CoinPackedMatrix(const bool colordered,
    minorDim_(0),
    size_(0),
    maxMajorDim_(0),
-   maxSize_(0)
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
      gutsOfOpEqual(colordered, minor, major, numels, elem, ind, start, len);
 }
@@ -2019,7 +3254,13 @@ CoinPackedMatrix::CoinPackedMatrix(
      minorDim_(0),
      size_(0),
      maxMajorDim_(0),
-     maxSize_(0)
+     maxSize_(0),
+     dualOrientation_(false),
+     reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
      CoinAbsFltEq eq;
        int * colIndices = new int[numberElements];
@@ -2184,7 +3425,13 @@ CoinPackedMatrix::CoinPackedMatrix (const CoinPackedMatrix & rhs) :
    minorDim_(0),
    size_(0),
    maxMajorDim_(0),
-   maxSize_(0)
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
   bool hasGaps = rhs.size_<rhs.start_[rhs.majorDim_];
   if (!hasGaps&&!rhs.extraMajor_) {
@@ -2197,7 +3444,35 @@ CoinPackedMatrix::CoinPackedMatrix (const CoinPackedMatrix & rhs) :
 		rhs.element_, rhs.index_, rhs.start_, rhs.length_,
 		rhs.extraMajor_, rhs.extraGap_);
   }
+  copyTailOf(rhs);
 }
+
+//-----------------------------------------------------------------------------
+
+#if COIN_HAS_MOVE
+CoinPackedMatrix::CoinPackedMatrix (CoinPackedMatrix && rhs) COIN_NOEXCEPT :
+   colOrdered_(true),
+   extraGap_(0.0),
+   extraMajor_(0.0),
+   element_(0), 
+   index_(0),
+   start_(0),
+   length_(0),
+   majorDim_(0),
+   minorDim_(0),
+   size_(0),
+   maxMajorDim_(0),
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
+{
+  swap(rhs);
+}
+#endif
 /* Copy constructor - fine tuning - allowing extra space and/or reverse
    ordering.
 
@@ -2219,8 +3494,20 @@ CoinPackedMatrix::CoinPackedMatrix (const CoinPackedMatrix& rhs,
    minorDim_(rhs.minorDim_),
    size_(rhs.size_),
    maxMajorDim_(0),
-   maxSize_(0)
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
+  if (rhs.tail_) {
+    CoinPackedMatrix full(rhs);
+    CoinPackedMatrix copy(full, extraForMajor, extraElements, reverseOrdering);
+    swap(copy);
+    return;
+  }
   if (!reverseOrdering) {
     if (extraForMajor>=0) {
       maxMajorDim_ = majorDim_+ extraForMajor;
@@ -2364,8 +3651,21 @@ CoinPackedMatrix::CoinPackedMatrix (const CoinPackedMatrix & rhs,
    minorDim_(0),
    size_(0),
    maxMajorDim_(0),
-   maxSize_(0)
+   maxSize_(0),
+   dualOrientation_(false),
+   reverse_(NULL),
+   blockAppend_(false),
+   tailFraction_(0.5),
+   tail_(NULL),
+   borrowed_(false)
 {
+  if (rhs.tail_) {
+    CoinPackedMatrix full(rhs);
+    CoinPackedMatrix copy(full, numberRows, whichRow, numberColumns,
+			  whichColumn);
+    swap(copy);
+    return;
+  }
   if (numberRows<=0||numberColumns<=0) {
     start_ = new CoinBigIndex[1];
     start_[0] = 0;
@@ -2566,6 +3866,8 @@ CoinPackedMatrix::CoinPackedMatrix (const CoinPackedMatrix & rhs,
 CoinPackedMatrix::~CoinPackedMatrix ()
 {
    gutsOfDestructor();
+   delete reverse_;
+   delete tail_;
 }
 
 //#############################################################################
@@ -2575,10 +3877,13 @@ CoinPackedMatrix::~CoinPackedMatrix ()
 void
 CoinPackedMatrix::gutsOfDestructor()
 {
-   delete[] length_;
-   delete[] start_;
-   delete[] index_;
-   delete[] element_;
+   if (!borrowed_) {
+      delete[] length_;
+      delete[] start_;
+      delete[] index_;
+      delete[] element_;
+   }
+   borrowed_ = false;
    length_ = 0;
    start_ = 0;
    index_ = 0;
@@ -3032,6 +4337,9 @@ CoinPackedMatrix::isEquivalent(const CoinPackedMatrix& rhs, const CoinRelFltEq&
       (getNumElements() != rhs.getNumElements()))
     return false;
   
+  if (patternFingerprint() != rhs.patternFingerprint())
+    return false;
+  
   const int major = getMajorDim();
   const int minor = getMinorDim();
   double * values = new double[minor];
@@ -3042,6 +4350,14 @@ CoinPackedMatrix::isEquivalent(const CoinPackedMatrix& rhs, const CoinRelFltEq&
     if (length!=rhs.length_[i]) {
       same=false;
       break;
+    } else if (!memcmp(index_+start_[i],rhs.index_+rhs.start_[i],
+		       length*sizeof(int))) {
+      // same indices in same order - compare elements directly
+      if (eq.firstDifferent(element_+start_[i],rhs.element_+rhs.start_[i],
+			    length)<length) {
+	same=false;
+	break;
+      }
     } else {
       CoinBigIndex j;
       for ( j = start_[i]; j < start_[i] + length; ++j) {
@@ -3069,10 +4385,28 @@ bool CoinPackedMatrix::isEquivalent(const CoinPackedMatrix& rhs) const
 {
    return isEquivalent(rhs,CoinRelFltEq());
 }
+
+CoinFingerprint
+CoinPackedMatrix::fingerprint(bool anyOrientation, int numberThreads) const
+{
+   CoinFingerprint result;
+   result.addMatrix(*this, anyOrientation, numberThreads);
+   return result;
+}
+
+CoinFingerprint
+CoinPackedMatrix::patternFingerprint(int numberThreads) const
+{
+   CoinFingerprint result;
+   result.addPattern(*this, numberThreads);
+   return result;
+}
 /* Sort all columns so indices are increasing.in each column */
 void 
 CoinPackedMatrix::orderMatrix()
 {
+  if (tail_)
+    compactTail();
   for (int i=0;i<majorDim_;i++) {
     CoinBigIndex start = start_[i];
     CoinBigIndex end = start + length_[i];
@@ -3300,6 +4634,24 @@ CoinPackedMatrix::appendMinor(const int number,
 {
   int i;
   int numberErrors=0;
+  if (blockAppend_) {
+    if (numberOther <= 0) {
+      int largest = majorDim_-1;
+      for (CoinBigIndex j = 0; j < starts[number]; j++)
+	largest = CoinMax(largest,index[j]);
+      if (largest+1>majorDim_) {
+	if (isColOrdered())
+	  setDimensions(-1,largest+1);
+	else 
+	  setDimensions(largest+1,-1);
+      }
+    }
+    numberErrors = tail()->appendMajor(number, starts, index, element,
+				       numberOther > 0 ? majorDim_ : -1);
+    minorDim_ += number;
+    checkTail();
+    return numberErrors;
+  }
   // first compute how many entries will be added to each major-dimension
   // vector, and if needed, resize the matrix to accommodate all
   int * addedEntries = NULL;
@@ -3396,6 +4748,10 @@ CoinPackedMatrix::appendMinorFast(const int number,
 				  const CoinBigIndex * starts, const int * index,
 				  const double * element)
 {
+  if (blockAppend_) {
+    appendMinor(number, starts, index, element, majorDim_);
+    return;
+  }
 #ifdef ADD_ROW_ANALYZE
   xxxxxx[0]++;
 #endif
@@ -8,12 +8,15 @@
 
 #include "CoinError.hpp"
 #include "CoinTypes.hpp"
+#include "CoinFingerprint.hpp"
 #ifndef CLP_NO_VECTOR
 #include "CoinPackedVectorBase.hpp"
 #include "CoinShallowPackedVector.hpp"
+#include "CoinPackedVectorSpan.hpp"
 #else
 class CoinRelFltEq;
 #endif
+class CoinIndexedVector;
 
 /** Sparse Matrix Base Class
 
@@ -198,6 +201,18 @@ public:
   				    false);
     }
 #endif
+    /** The i'th vector in matrix as a span (no virtual methods, so
+	<code>for (auto e : m.getVectorSpan(i))</code> is as fast as going
+	through the arrays). */
+    inline CoinPackedVectorSpan getVectorSpan(int i) const {
+#ifndef COIN_FAST_CODE
+      if (i < 0 || i >= majorDim_)
+	throw CoinError("bad index", "vectorSpan", "CoinPackedMatrix");
+#endif
+      return CoinPackedVectorSpan(length_[i],
+				  index_ + start_[i],
+				  element_ + start_[i]);
+    }
     /** Returns an array containing major indices.  The array is
 	  getNumElements long and if getVectorStarts() is 0,2,5 then
 	  the array would start 0,0,1,1,1,2...
@@ -326,6 +341,13 @@ public:
 	keepZero true */
     void modifyCoefficient(int row, int column, double newElement,
 			   bool keepZero=false);
+    /** Modify number elements of packed matrix as modifyCoefficient but
+        making room for all new elements at most once, so cost is in
+        proportion to number and the vectors touched.  Each element
+        should appear at most once */
+    void modifyCoefficients(int number, const int * rows,
+			    const int * columns, const double * newElements,
+			    bool keepZero=false);
     /** Return one element of packed matrix.
         This works for either ordering
 	If it is not present will return 0.0 */
@@ -352,6 +374,16 @@ public:
 	returns number of elements eliminated
     */
     int cleanMatrix(double threshold=1.0e-20);
+    /*! \brief Set threads used by #compress, #eliminateDuplicates,
+	       #removeGaps and #cleanMatrix for all matrices.
+
+      Large matrices are cleaned in blocks of major vectors, one per
+      thread, and then packed; the result is the same as with one thread.
+      Always 1 if not built with COINUTILS_PTHREADS.
+    */
+    static void setCleanThreads(int numberThreads);
+    /// Threads used by #cleanMatrix and the like
+    static int cleanThreads();
   //@}
 
   //---------------------------------------------------------------------------
@@ -404,6 +436,16 @@ public:
       (Cf. #reverseOrdering, which does the same thing in place.)
     */
     void reverseOrderedCopyOf(const CoinPackedMatrix& rhs);
+    /*! \brief Set threads used by #reverseOrderedCopyOf (and so
+	       #reverseOrdering) for all matrices.
+
+      Large matrices are counted and scattered in blocks of major vectors,
+      one per thread; the copy is the same as with one thread.  Always 1 if
+      not built with COINUTILS_PTHREADS.
+    */
+    static void setTransposeThreads(int numberThreads);
+    /// Threads used by #reverseOrderedCopyOf
+    static int transposeThreads();
 
     /** Assign the arguments to the matrix. If <code>len</code> is a NULL
 	pointer then the matrix is assumed to have no gaps in it and
@@ -419,12 +461,43 @@ public:
  		     double *& elem, int *& ind,
  		     CoinBigIndex *& start, int *& len,
  		     const int maxmajor = -1, const CoinBigIndex maxsize = -1);
+
+    /** The reverse of assignMatrix: hand the arrays to the caller, who
+	must delete them with <code>delete[]</code>, leaving the matrix
+	empty.  Any tail block is merged first and borrowed arrays are
+	copied.  <code>maxmajor</code> and <code>maxsize</code> return the
+	capacity of the arrays (<code>start</code> has
+	<code>maxmajor+1</code> entries), so a matrix made with
+	<code>reserve</code> can move straight into a structure which wants
+	room to grow. */
+    void releaseMatrix(double *& elem, int *& ind,
+		       CoinBigIndex *& start, int *& len,
+		       int & maxmajor, CoinBigIndex & maxsize);
+
+    /** Point the matrix at arrays it does not own, for instance arrays in
+	a shared memory segment (see CoinSharedModel).  Nothing is copied
+	and the arrays are never freed.  Until the matrix is assigned to or
+	destroyed it must only be used through const methods (anything which
+	changes it would free or write to the arrays).  Copies of the matrix
+	own their arrays in the usual way. */
+    void borrowMatrix(const bool colordered,
+		      const int minor, const int major,
+		      const CoinBigIndex numels,
+		      const double * elem, const int * ind,
+		      const CoinBigIndex * start, const int * len);
+    /// True if the arrays are borrowed (see borrowMatrix)
+    inline bool isBorrowed() const { return borrowed_; }
  
  
  
     /** Assignment operator. This copies out the data, but uses the current
         matrix's extra space parameters. */
     CoinPackedMatrix & operator=(const CoinPackedMatrix& rhs);
+#if COIN_HAS_MOVE
+    /** Move assignment.  Exchanges contents with \p rhs (see #swap), so
+        nothing is copied. */
+    CoinPackedMatrix & operator=(CoinPackedMatrix&& rhs) COIN_NOEXCEPT;
+#endif
  
     /*! \brief Reverse the ordering of the packed matrix.
 
@@ -450,6 +523,63 @@ public:
    
   //@}
 
+  //---------------------------------------------------------------------------
+  /*! \name Dual orientation
+
+    A matrix in dual orientation mode also owns a copy in the other
+    orientation (as from #reverseOrderedCopyOf).  appendRows, appendCols,
+    deleteRows, deleteCols, modifyCoefficient, setDimensions and the
+    right/bottom appends update both copies, so the reverse copy costs a
+    major-dimension update rather than a transpose.  The extra space
+    parameters are reversed for the copy so that appends use the existing
+    #extraGap_ slack.  Anything else which changes the matrix discards the
+    reverse copy and it is rebuilt when next asked for.
+
+    Changes made through the helper functions (appendMajorVector etc.)
+    or the mutable arrays are only noticed if they change the dimensions
+    or the number of elements; call setDualOrientation(false) and back
+    after such changes.
+  */
+  //@{
+    /// Turn dual orientation mode on or off (off frees the reverse copy)
+    void setDualOrientation(bool yesNo);
+    /// True if in dual orientation mode
+    inline bool dualOrientation() const { return dualOrientation_; }
+    /*! \brief The matrix in the other orientation
+
+      NULL unless in dual orientation mode.  The copy is owned by this
+      matrix and is only valid until the next change to it.
+    */
+    const CoinPackedMatrix * getReverseOrderedCopy() const;
+  //@}
+
+  /*! \name Block append
+
+    Appending minor-dimension vectors (rows of a column ordered matrix,
+    e.g. cuts) has to find room in every major vector they touch, which
+    usually means moving the whole matrix.  In block append mode they are
+    instead kept in a tail block, a matrix ordered the other way (so
+    appending to it costs just the new entries), whose vectors follow the
+    ones in the packed arrays.
+
+    The dimensions include the tail, and times, transposeTimes,
+    getCoefficient, copies and the appends handle it, but getNumElements,
+    the packed arrays (getElements etc.) and the other query methods only
+    cover the main block.  The tail is merged by compactTail(), which is
+    done automatically once it has more than maximumFraction times as many
+    elements as the main block and before any other change to the matrix.
+  */
+  //@{
+    /// Turn block append mode on or off (off compacts)
+    void setBlockAppend(bool yesNo, double maximumFraction = 0.5);
+    /// True if in block append mode
+    inline bool blockAppend() const { return blockAppend_; }
+    /// Merge tail block into packed arrays
+    void compactTail();
+    /// Tail block (NULL if none) - ordered the other way from this matrix
+    inline const CoinPackedMatrix * getTail() const { return tail_; }
+  //@}
+
   //---------------------------------------------------------------------------
   /**@name Matrix times vector methods */
   //@{
@@ -471,6 +601,15 @@ public:
         method, just <code>x</code> is given in the form of a packed vector. */
     void transposeTimes(const CoinPackedVectorBase& x, double * y) const;
 #endif
+    /** Return <code>A * x</code> in <code>y</code> for sparse vectors.
+        y is cleared first (and made big enough) and only nonzeros are
+        kept in its index list.  See timesMajor and timesMinor for how
+        the algorithm is chosen. */
+    void times(const CoinIndexedVector & x, CoinIndexedVector & y) const;
+    /** Return <code>x * A</code> in <code>y</code> for sparse vectors
+        (e.g. a row of the tableau in dual simplex). */
+    void transposeTimes(const CoinIndexedVector & x,
+                        CoinIndexedVector & y) const;
   //@}
 
   //---------------------------------------------------------------------------
@@ -638,6 +777,18 @@ public:
 	  given in the form of a packed vector. */
       void timesMinor(const CoinPackedVectorBase& x, double * y) const;
 #endif
+      /** Return <code>A * x</code> in <code>y</code> where x is indexed by
+	  major vectors.  Only major vectors in x's index list are
+	  touched.  If the expected output is sparse each result is added
+	  to y's index list as it appears, otherwise y is accumulated
+	  densely and the index list made by one scan. */
+      void timesMajor(const CoinIndexedVector & x, CoinIndexedVector & y) const;
+      /** Return <code>A * x</code> in <code>y</code> where x is indexed by
+	  minor vectors.  With dual orientation on (see
+	  setDualOrientation) and x sparse enough this scatters over the
+	  reverse ordered copy so only touches x's nonzeros, otherwise it
+	  forms a dot product with every major vector. */
+      void timesMinor(const CoinIndexedVector & x, CoinIndexedVector & y) const;
       //@}
    //@}
 
@@ -650,7 +801,8 @@ public:
        Two matrices are equivalent if they are both row- or column-ordered,
        they have the same dimensions, and each (major) vector is equivalent.
        The operator used to test for equality can be specified using the
-       \p FloatEqual template parameter.
+       \p FloatEqual template parameter.  Fingerprints of the sparsity
+       patterns are compared first (see #patternFingerprint).
    */
    template <class FloatEqual> bool 
    isEquivalent(const CoinPackedMatrix& rhs, const FloatEqual& eq) const
@@ -661,6 +813,8 @@ public:
 	  (getNumRows() != rhs.getNumRows()) ||
 	  (getNumElements() != rhs.getNumElements()))
 	 return false;
+      if (patternFingerprint() != rhs.patternFingerprint())
+	 return false;
      
       for (int i=getMajorDim()-1; i >= 0; --i) {
         CoinShallowPackedVector pv = getVector(i);
@@ -686,6 +840,7 @@ public:
        This method is optimised for speed. CoinPackedVector#isEquivalent is
        replaced with more efficient code for repeated comparison of
        equal-length vectors. The CoinRelFltEq operator is used. 
+       Fingerprints of the sparsity patterns are compared first.
    */
   bool isEquivalent(const CoinPackedMatrix& rhs, const CoinRelFltEq & eq) const;
 #endif
@@ -694,6 +849,22 @@ public:
      The test for element equality is the default CoinRelFltEq operator.
    */
    bool isEquivalent(const CoinPackedMatrix& rhs) const;
+   /*! \brief Fingerprint of dimensions and non zero entries.
+
+     Orientation is part of it unless \p anyOrientation is true, in which
+     case a matrix and its reverse ordered copy give the same answer.
+     Entries are hashed in parallel if built with COINUTILS_PTHREADS
+     (see CoinFingerprint).
+   */
+   CoinFingerprint fingerprint(bool anyOrientation = false,
+			       int numberThreads = 1) const;
+   /*! \brief Fingerprint of orientation, dimensions and where entries
+     are stored (not their values).
+
+     Equivalent matrices (to any tolerance) have the same pattern
+     fingerprint.
+   */
+   CoinFingerprint patternFingerprint(int numberThreads = 1) const;
    //@}
 
    //--------------------------------------------------------------------------
@@ -786,6 +957,11 @@ public:
 
    /// Copy constructor 
    CoinPackedMatrix(const CoinPackedMatrix& m);
+#if COIN_HAS_MOVE
+   /** Move constructor.  Takes the arrays of \p m, which is left with
+       none and may then only be assigned to or destroyed. */
+   CoinPackedMatrix(CoinPackedMatrix&& m) COIN_NOEXCEPT;
+#endif
 
   /*! \brief Copy constructor with fine tuning
   
@@ -890,6 +1066,25 @@ private:
    inline CoinBigIndex getLastStart() const {
       return majorDim_ == 0 ? 0 : start_[majorDim_];
    }
+   /// Frees reverse copy (it is rebuilt on demand)
+   void invalidateReverse() const;
+   /// Frees reverse copy if it no longer matches this matrix
+   void checkReverse() const;
+   /// Tail block for appends (created if needed)
+   CoinPackedMatrix * tail();
+   /// Compacts tail if it has got too big
+   void checkTail();
+   /// Frees tail without merging it (matrix is being replaced)
+   void discardTail();
+   /// Copies and merges tail of rhs
+   void copyTailOf(const CoinPackedMatrix & rhs);
+   /// Adds tail part of product (afterMajor true if timesMajor was used)
+   void timesTail(const double * x, double * y, bool afterMajor) const;
+#ifndef CLP_NO_VECTOR
+   /// Adds tail part of product for packed x
+   void timesTail(const CoinPackedVectorBase& x, double * y,
+		  bool afterMajor) const;
+#endif
 
    //--------------------------------------------------------------------------
 protected:
@@ -930,6 +1125,18 @@ protected:
    int maxMajorDim_;
    /// max space allocated for entries
    CoinBigIndex maxSize_;
+   /// True if reverse ordered copy is kept (see getReverseOrderedCopy)
+   bool dualOrientation_;
+   /// Reverse ordered copy (NULL if none or out of date)
+   mutable CoinPackedMatrix * reverse_;
+   /// True if minor vectors are appended to tail block
+   bool blockAppend_;
+   /// Tail is compacted when it has more than this fraction of size_
+   double tailFraction_;
+   /// Appended minor vectors as major vectors of reverse ordered matrix
+   CoinPackedMatrix * tail_;
+   /// True if element_, index_, start_ and length_ are not owned
+   bool borrowed_;
    //@}
 };
 
@@ -0,0 +1,384 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cstring>
+#include <limits>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinPackedMatrix64.hpp"
+
+namespace {
+  // Largest number of elements a CoinPackedMatrix can hold
+  const CoinBigIndex64 maximumBigIndex =
+    static_cast<CoinBigIndex64>(std::numeric_limits<CoinBigIndex>::max());
+
+  // Appends each column read to matrix
+  class CoinMatrix64Callback : public CoinMpsCallback {
+  public:
+    CoinMatrix64Callback(CoinPackedMatrix64 & matrix) :
+      matrix_(matrix) {}
+    virtual void rows(int numberRows, const char * const * /*rowNames*/)
+    { matrix_.setMinorDim(numberRows); }
+    virtual void column(int /*iColumn*/, const char * /*name*/,
+			double /*objective*/, int numberElements,
+			const int * rows, const double * elements,
+			bool /*integer*/)
+    { matrix_.appendMajorVector(numberElements, rows, elements); }
+  private:
+    CoinPackedMatrix64 & matrix_;
+  };
+}
+
+//#############################################################################
+
+bool
+CoinPackedMatrix64::fitsPackedMatrix() const
+{
+  return getNumElements() <= maximumBigIndex;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::appendMajorVector(int number, const int * index,
+				      const double * element)
+{
+  int maxIndex = minorDim_ - 1;
+  for (int i = 0; i < number; i++) {
+    if (index[i] < 0)
+      throw CoinError("negative index", "appendMajorVector",
+		      "CoinPackedMatrix64");
+    maxIndex = CoinMax(maxIndex, index[i]);
+  }
+  const CoinBigIndex64 put = start_[majorDim_];
+  if (majorDim_ == maxMajorDim_ || put + number > maxSize_) {
+    // grow by half as much again
+    int newMajor = majorDim_ < maxMajorDim_ ? maxMajorDim_ :
+      maxMajorDim_ + maxMajorDim_ / 2 + 100;
+    CoinBigIndex64 newSize = put + number <= maxSize_ ? maxSize_ :
+      CoinMax(put + number, maxSize_ + maxSize_ / 2 + 1000);
+    resize(newMajor, newSize);
+  }
+  CoinMemcpyN(index, number, index_ + put);
+  CoinMemcpyN(element, number, element_ + put);
+  majorDim_++;
+  start_[majorDim_] = put + number;
+  minorDim_ = maxIndex + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::reserve(int numberMajor, CoinBigIndex64 numberElements)
+{
+  if (numberMajor > maxMajorDim_ || numberElements > maxSize_)
+    resize(CoinMax(numberMajor, maxMajorDim_),
+	   CoinMax(numberElements, maxSize_));
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::setMinorDim(int number)
+{
+  const CoinBigIndex64 numberElements = getNumElements();
+  int maxIndex = -1;
+  for (CoinBigIndex64 j = 0; j < numberElements; j++)
+    maxIndex = CoinMax(maxIndex, index_[j]);
+  if (number <= maxIndex)
+    throw CoinError("minor dimension less than largest index",
+		    "setMinorDim", "CoinPackedMatrix64");
+  minorDim_ = number;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::clear(bool colOrdered)
+{
+  colOrdered_ = colOrdered;
+  majorDim_ = 0;
+  minorDim_ = 0;
+  start_[0] = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+int
+CoinPackedMatrix64::readMps(CoinMpsIO & reader, const char * filename,
+			    const char * extension)
+{
+  clear(true);
+  CoinMatrix64Callback callback(*this);
+  const int returnCode = reader.readMps(filename, extension, callback);
+  if (returnCode >= 0 && returnCode < 100000) {
+    // no more columns to come - and rows may be empty
+    if (minorDim_ < reader.getNumRows())
+      minorDim_ = reader.getNumRows();
+  }
+  return returnCode;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrix64::times(const double * x, double * y) const
+{
+  if (colOrdered_)
+    scatterTimes(x, y);
+  else
+    gatherTimes(x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::transposeTimes(const double * x, double * y) const
+{
+  if (colOrdered_)
+    gatherTimes(x, y);
+  else
+    scatterTimes(x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::gatherTimes(const double * x, double * y) const
+{
+  for (int i = 0; i < majorDim_; i++) {
+    double value = 0.0;
+    const CoinBigIndex64 end = start_[i+1];
+    for (CoinBigIndex64 j = start_[i]; j < end; j++)
+      value += x[index_[j]] * element_[j];
+    y[i] = value;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::scatterTimes(const double * x, double * y) const
+{
+  CoinZeroN(y, minorDim_);
+  for (int i = 0; i < majorDim_; i++) {
+    const double value = x[i];
+    if (value) {
+      const CoinBigIndex64 end = start_[i+1];
+      for (CoinBigIndex64 j = start_[i]; j < end; j++)
+	y[index_[j]] += value * element_[j];
+    }
+  }
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrix64::copyTo(CoinPackedMatrix & matrix) const
+{
+  const int all = -1;
+  extractMajor(all, NULL, matrix);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::extractMajor(int number, const int * which,
+				 CoinPackedMatrix & matrix) const
+{
+  // number of -1 (from copyTo) means all in order
+  const bool all = number < 0;
+  if (all)
+    number = majorDim_;
+  CoinBigIndex64 numberElements = 0;
+  for (int i = 0; i < number; i++) {
+    const int iMajor = all ? i : which[i];
+    if (iMajor < 0 || iMajor >= majorDim_)
+      throw CoinError("bad major index", "extractMajor",
+		      "CoinPackedMatrix64");
+    numberElements += start_[iMajor+1] - start_[iMajor];
+  }
+  if (numberElements > maximumBigIndex)
+    throw CoinError("too many elements for CoinBigIndex", "extractMajor",
+		    "CoinPackedMatrix64");
+  const CoinBigIndex64 size = CoinMax(numberElements,
+				      static_cast<CoinBigIndex64>(1));
+  double * element = new double [size];
+  int * index = new int [size];
+  CoinBigIndex * start = new CoinBigIndex [number+1];
+  int * length = new int [CoinMax(number, 1)];
+  CoinBigIndex put = 0;
+  start[0] = 0;
+  for (int i = 0; i < number; i++) {
+    const int iMajor = all ? i : which[i];
+    const int n = getVectorSize(iMajor);
+    CoinMemcpyN(index_ + start_[iMajor], n, index + put);
+    CoinMemcpyN(element_ + start_[iMajor], n, element + put);
+    put += n;
+    start[i+1] = put;
+    length[i] = n;
+  }
+  matrix.assignMatrix(colOrdered_, minorDim_, number, put,
+		      element, index, start, length);
+}
+
+//#############################################################################
+
+CoinPackedMatrix64::CoinPackedMatrix64() :
+  element_(NULL),
+  index_(NULL),
+  start_(NULL),
+  maxSize_(0),
+  maxMajorDim_(0),
+  majorDim_(0),
+  minorDim_(0),
+  colOrdered_(true)
+{
+  start_ = new CoinBigIndex64 [1];
+  start_[0] = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrix64::CoinPackedMatrix64(bool colOrdered, int minorDim) :
+  element_(NULL),
+  index_(NULL),
+  start_(NULL),
+  maxSize_(0),
+  maxMajorDim_(0),
+  majorDim_(0),
+  minorDim_(CoinMax(minorDim, 0)),
+  colOrdered_(colOrdered)
+{
+  start_ = new CoinBigIndex64 [1];
+  start_[0] = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrix64::CoinPackedMatrix64(const CoinPackedMatrix & rhs) :
+  element_(NULL),
+  index_(NULL),
+  start_(NULL),
+  maxSize_(0),
+  maxMajorDim_(0),
+  majorDim_(0),
+  minorDim_(rhs.getMinorDim()),
+  colOrdered_(rhs.isColOrdered())
+{
+  if (rhs.getTail())
+    throw CoinError("matrix has block append tail",
+		    "CoinPackedMatrix64", "CoinPackedMatrix64");
+  const int numberMajor = rhs.getMajorDim();
+  const CoinBigIndex * start = rhs.getVectorStarts();
+  const int * length = rhs.getVectorLengths();
+  const int * index = rhs.getIndices();
+  const double * element = rhs.getElements();
+  start_ = new CoinBigIndex64 [1];
+  start_[0] = 0;
+  resize(numberMajor, rhs.getNumElements());
+  CoinBigIndex64 put = 0;
+  for (int i = 0; i < numberMajor; i++) {
+    CoinMemcpyN(index + start[i], length[i], index_ + put);
+    CoinMemcpyN(element + start[i], length[i], element_ + put);
+    put += length[i];
+    start_[i+1] = put;
+  }
+  majorDim_ = numberMajor;
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrix64::CoinPackedMatrix64(const CoinPackedMatrix64 & rhs) :
+  element_(NULL),
+  index_(NULL),
+  start_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrix64 &
+CoinPackedMatrix64::operator=(const CoinPackedMatrix64 & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrix64::~CoinPackedMatrix64()
+{
+  gutsOfDelete();
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrix64::gutsOfDelete()
+{
+  delete [] element_;
+  delete [] index_;
+  delete [] start_;
+  element_ = NULL;
+  index_ = NULL;
+  start_ = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::gutsOfCopy(const CoinPackedMatrix64 & rhs)
+{
+  colOrdered_ = rhs.colOrdered_;
+  majorDim_ = rhs.majorDim_;
+  minorDim_ = rhs.minorDim_;
+  maxMajorDim_ = rhs.majorDim_;
+  maxSize_ = rhs.getNumElements();
+  start_ = CoinCopyOfArray(rhs.start_, majorDim_ + 1);
+  if (maxSize_) {
+    element_ = new double [maxSize_];
+    index_ = new int [maxSize_];
+    // CoinMemcpyN counts in int
+    memcpy(element_, rhs.element_, maxSize_ * sizeof(double));
+    memcpy(index_, rhs.index_, maxSize_ * sizeof(int));
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrix64::resize(int numberMajor, CoinBigIndex64 numberElements)
+{
+  const CoinBigIndex64 numberNow = start_[majorDim_];
+  if (numberMajor > maxMajorDim_) {
+    CoinBigIndex64 * start = new CoinBigIndex64 [numberMajor + 1];
+    CoinMemcpyN(start_, majorDim_ + 1, start);
+    delete [] start_;
+    start_ = start;
+    maxMajorDim_ = numberMajor;
+  }
+  if (numberElements > maxSize_) {
+    double * element = new double [numberElements];
+    int * index = new int [numberElements];
+    if (numberNow) {
+      memcpy(element, element_, numberNow * sizeof(double));
+      memcpy(index, index_, numberNow * sizeof(int));
+    }
+    delete [] element_;
+    delete [] index_;
+    element_ = element;
+    index_ = index;
+    maxSize_ = numberElements;
+  }
+}
@@ -0,0 +1,179 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrix64_H
+#define CoinPackedMatrix64_H
+
+#include "CoinTypes.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinShallowPackedVector.hpp"
+
+class CoinMpsIO;
+
+/** Packed matrix with 64 bit element counts
+
+    CoinBigIndex is fixed when CoinUtils is built and is normally an int,
+    so a CoinPackedMatrix cannot hold more than 2^31-1 elements.  Building
+    everything with a wider CoinBigIndex makes the start arrays of every
+    matrix bigger.  This class holds just the matrices which need it: vector
+    starts are CoinBigIndex64 while indices stay int, so an element still
+    costs 12 bytes.
+
+    Storage is gap free (major vector i is from start[i] to start[i+1]) and
+    is built by appending major vectors or by readMps, which goes through
+    the CoinMpsIO column callback so no 32 bit matrix is ever made.  It
+    converts to and from CoinPackedMatrix: the elements are copied and only
+    the starts converted.  A factorization works on a basis, so
+    extractMajor gives the chosen columns as an ordinary CoinPackedMatrix
+    for CoinFactorization and the like.
+*/
+class CoinPackedMatrix64 {
+public:
+  /**@name Queries */
+  //@{
+  /// Whether matrix is column ordered
+  inline bool isColOrdered() const
+  { return colOrdered_;}
+  /// Number of major vectors
+  inline int getMajorDim() const
+  { return majorDim_;}
+  /// Number of minor vectors
+  inline int getMinorDim() const
+  { return minorDim_;}
+  /// Number of rows
+  inline int getNumRows() const
+  { return colOrdered_ ? minorDim_ : majorDim_;}
+  /// Number of columns
+  inline int getNumCols() const
+  { return colOrdered_ ? majorDim_ : minorDim_;}
+  /// Number of elements
+  inline CoinBigIndex64 getNumElements() const
+  { return start_[majorDim_];}
+  /// Elements
+  inline const double * getElements() const
+  { return element_;}
+  /// Minor indices
+  inline const int * getIndices() const
+  { return index_;}
+  /// Starts of major vectors (getMajorDim()+1 of them)
+  inline const CoinBigIndex64 * getVectorStarts() const
+  { return start_;}
+  /// Start of major vector i
+  inline CoinBigIndex64 getVectorFirst(int i) const
+  { return start_[i];}
+  /// One past end of major vector i
+  inline CoinBigIndex64 getVectorLast(int i) const
+  { return start_[i+1];}
+  /// Number of elements in major vector i
+  inline int getVectorSize(int i) const
+  { return static_cast<int>(start_[i+1]-start_[i]);}
+  /// Major vector i (no copy)
+  inline const CoinShallowPackedVector getVector(int i) const
+  { return CoinShallowPackedVector(getVectorSize(i),index_+start_[i],
+				   element_+start_[i],false);}
+  /// Major vector i as a span (no copy, no virtual methods)
+  inline CoinPackedVectorSpan getVectorSpan(int i) const
+  { return CoinPackedVectorSpan(getVectorSize(i),index_+start_[i],
+				element_+start_[i]);}
+  /// Whether the elements would fit in a CoinPackedMatrix
+  bool fitsPackedMatrix() const;
+  //@}
+
+  /**@name Building */
+  //@{
+  /** Append a major vector.  The minor dimension grows to take the
+      largest index.  Throws CoinError for a negative index */
+  void appendMajorVector(int number, const int * index,
+			 const double * element);
+  /// Make room for major vectors and elements
+  void reserve(int numberMajor, CoinBigIndex64 numberElements);
+  /** Set minor dimension (it may not be less than the largest index) */
+  void setMinorDim(int number);
+  /// Empty matrix with given ordering
+  void clear(bool colOrdered = true);
+  /** Read an MPS file.  The elements go straight into this (column
+      ordered) matrix; names, bounds and objective are left in \p reader.
+      Returns as CoinMpsIO::readMps */
+  int readMps(CoinMpsIO & reader, const char * filename,
+	      const char * extension = "mps");
+  //@}
+
+  /**@name Products */
+  //@{
+  /** Return <code>A * x</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumCols()</code>
+      @pre <code>y</code> must be of size <code>getNumRows()</code> */
+  void times(const double * x, double * y) const;
+  /** Return <code>x * A</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumRows()</code>
+      @pre <code>y</code> must be of size <code>getNumCols()</code> */
+  void transposeTimes(const double * x, double * y) const;
+  //@}
+
+  /**@name Conversion */
+  //@{
+  /** Copies into \p matrix (same ordering, no gaps).  Throws CoinError if
+      there are too many elements for CoinBigIndex */
+  void copyTo(CoinPackedMatrix & matrix) const;
+  /** Major vectors \p which (in that order) into \p matrix, e.g. the basis
+      columns to factorize.  Throws CoinError for a bad index or if there
+      are too many elements for CoinBigIndex */
+  void extractMajor(int number, const int * which,
+		    CoinPackedMatrix & matrix) const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor - empty column ordered matrix
+  CoinPackedMatrix64();
+  /// Empty matrix with given ordering and minor dimension
+  CoinPackedMatrix64(bool colOrdered, int minorDim);
+  /// Copy of an ordinary matrix (gaps removed)
+  explicit CoinPackedMatrix64(const CoinPackedMatrix & rhs);
+  /// Copy constructor
+  CoinPackedMatrix64(const CoinPackedMatrix64 & rhs);
+  /// Assignment
+  CoinPackedMatrix64 & operator=(const CoinPackedMatrix64 & rhs);
+  /// Destructor
+  ~CoinPackedMatrix64();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrix64 & rhs);
+  /// Makes room for at least so many major vectors and elements
+  void resize(int numberMajor, CoinBigIndex64 numberElements);
+  /// y[i] = major vector i times x
+  void gatherTimes(const double * x, double * y) const;
+  /// y = sum of x[i] times major vector i
+  void scatterTimes(const double * x, double * y) const;
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Elements
+  double * element_;
+  /// Minor indices
+  int * index_;
+  /// Starts (majorDim_+1)
+  CoinBigIndex64 * start_;
+  /// Room for elements
+  CoinBigIndex64 maxSize_;
+  /// Room for major vectors
+  int maxMajorDim_;
+  /// Number of major vectors
+  int majorDim_;
+  /// Number of minor vectors
+  int minorDim_;
+  /// Column ordered
+  bool colOrdered_;
+  //@}
+};
+
+#endif
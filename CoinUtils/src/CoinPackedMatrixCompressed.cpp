@@ -0,0 +1,323 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrixCompressed.hpp"
+
+//#############################################################################
+// Element values for the kernels
+
+namespace {
+  // Code into table of up to 256 values
+  struct CoinValue8 {
+    const unsigned char * code;
+    const double * values;
+    inline double operator()(CoinBigIndex j) const
+    { return values[code[j]];}
+  };
+  // Code into table of up to 65536 values
+  struct CoinValue16 {
+    const unsigned short * code;
+    const double * values;
+    inline double operator()(CoinBigIndex j) const
+    { return values[code[j]];}
+  };
+  // Every element the same
+  struct CoinValueConstant {
+    double value;
+    inline double operator()(CoinBigIndex) const
+    { return value;}
+  };
+  // Every element 1.0 - the multiply goes
+  struct CoinValueOne {
+    inline double operator()(CoinBigIndex) const
+    { return 1.0;}
+  };
+}
+
+// Scatter along major vectors (as CoinPackedMatrix::timesMajor)
+template <class Value> static void
+coinCompressedScatter(int majorDim, int minorDim,
+		      const CoinBigIndex * COIN_RESTRICT start,
+		      const int * COIN_RESTRICT index, Value value,
+		      const double * COIN_RESTRICT x, double * COIN_RESTRICT y)
+{
+  memset(y, 0, minorDim * sizeof(double));
+  for (int i = majorDim - 1; i >= 0; --i) {
+    const double x_i = x[i];
+    if (x_i != 0.0) {
+      const CoinBigIndex last = start[i+1];
+      for (CoinBigIndex j = start[i]; j < last; ++j)
+	y[index[j]] += x_i * value(j);
+    }
+  }
+}
+
+// Gather along major vectors (as CoinPackedMatrix::timesMinor)
+template <class Value> static void
+coinCompressedGather(int majorDim, int minorDim,
+		     const CoinBigIndex * COIN_RESTRICT start,
+		     const int * COIN_RESTRICT index, Value value,
+		     const double * COIN_RESTRICT x, double * COIN_RESTRICT y)
+{
+  (void) minorDim;
+  for (int i = majorDim - 1; i >= 0; --i) {
+    double y_i = 0;
+    const CoinBigIndex last = start[i+1];
+    for (CoinBigIndex j = start[i]; j < last; ++j)
+      y_i += x[index[j]] * value(j);
+    y[i] = y_i;
+  }
+}
+
+/* Puts sorted distinct values of matrix in values and returns how many
+   (-1 if more than maximum).  The table is kept sorted as it grows, which
+   is cheap as matrices worth compressing have very few values. */
+static int
+coinSortedValues(const CoinPackedMatrix & matrix, int maximum, double * values)
+{
+  const CoinBigIndex * start = matrix.getVectorStarts();
+  const int * length = matrix.getVectorLengths();
+  const double * element = matrix.getElements();
+  const int majorDim = matrix.getMajorDim();
+  int numberValues = 0;
+  for (int i = 0; i < majorDim; i++) {
+    const CoinBigIndex last = start[i] + length[i];
+    for (CoinBigIndex j = start[i]; j < last; j++) {
+      const double value = element[j];
+      double * where = std::lower_bound(values, values + numberValues, value);
+      if (where == values + numberValues || *where != value) {
+	if (numberValues == maximum)
+	  return -1;
+	memmove(where + 1, where,
+		(values + numberValues - where) * sizeof(double));
+	*where = value;
+	numberValues++;
+      }
+    }
+  }
+  return numberValues;
+}
+
+//#############################################################################
+
+CoinPackedMatrixCompressed::CoinPackedMatrixCompressed() :
+  start_(NULL),
+  index_(NULL),
+  code8_(NULL),
+  code16_(NULL),
+  values_(NULL),
+  numberValues_(0),
+  majorDim_(0),
+  minorDim_(0),
+  size_(0),
+  colOrdered_(true)
+{
+  start_ = new CoinBigIndex [1];
+  start_[0] = 0;
+}
+
+CoinPackedMatrixCompressed::CoinPackedMatrixCompressed(const CoinPackedMatrix & matrix) :
+  start_(NULL),
+  index_(NULL),
+  code8_(NULL),
+  code16_(NULL),
+  values_(NULL),
+  numberValues_(0),
+  majorDim_(matrix.getMajorDim()),
+  minorDim_(matrix.getMinorDim()),
+  size_(matrix.getNumElements()),
+  colOrdered_(matrix.isColOrdered())
+{
+  const CoinBigIndex * start = matrix.getVectorStarts();
+  const int * length = matrix.getVectorLengths();
+  const int * index = matrix.getIndices();
+  const double * element = matrix.getElements();
+  // distinct values
+  double * values = new double [65536];
+  numberValues_ = coinSortedValues(matrix, 65536, values);
+  if (numberValues_ < 0) {
+    delete [] values;
+    throw CoinError("too many distinct values",
+		    "CoinPackedMatrixCompressed", "CoinPackedMatrixCompressed");
+  }
+  values_ = CoinCopyOfArray(values, numberValues_);
+  delete [] values;
+  // gap free starts and indices, codes if more than one value
+  start_ = new CoinBigIndex [majorDim_+1];
+  index_ = new int [size_];
+  if (numberValues_ > 256)
+    code16_ = new unsigned short [size_];
+  else if (numberValues_ > 1)
+    code8_ = new unsigned char [size_];
+  CoinBigIndex n = 0;
+  start_[0] = 0;
+  for (int i = 0; i < majorDim_; i++) {
+    const CoinBigIndex last = start[i] + length[i];
+    for (CoinBigIndex j = start[i]; j < last; j++) {
+      index_[n] = index[j];
+      if (numberValues_ > 1) {
+	int code = static_cast<int>(std::lower_bound(values_, values_ + numberValues_,
+						     element[j]) - values_);
+	if (code8_)
+	  code8_[n] = static_cast<unsigned char>(code);
+	else
+	  code16_[n] = static_cast<unsigned short>(code);
+      }
+      n++;
+    }
+    start_[i+1] = n;
+  }
+}
+
+CoinPackedMatrixCompressed::CoinPackedMatrixCompressed(const CoinPackedMatrixCompressed & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixCompressed &
+CoinPackedMatrixCompressed::operator=(const CoinPackedMatrixCompressed & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixCompressed::~CoinPackedMatrixCompressed()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixCompressed::gutsOfDelete()
+{
+  delete [] start_;
+  delete [] index_;
+  delete [] code8_;
+  delete [] code16_;
+  delete [] values_;
+  start_ = NULL;
+  index_ = NULL;
+  code8_ = NULL;
+  code16_ = NULL;
+  values_ = NULL;
+}
+
+void
+CoinPackedMatrixCompressed::gutsOfCopy(const CoinPackedMatrixCompressed & rhs)
+{
+  numberValues_ = rhs.numberValues_;
+  majorDim_ = rhs.majorDim_;
+  minorDim_ = rhs.minorDim_;
+  size_ = rhs.size_;
+  colOrdered_ = rhs.colOrdered_;
+  start_ = CoinCopyOfArray(rhs.start_, majorDim_+1);
+  index_ = CoinCopyOfArray(rhs.index_, size_);
+  code8_ = CoinCopyOfArray(rhs.code8_, size_);
+  code16_ = CoinCopyOfArray(rhs.code16_, size_);
+  values_ = CoinCopyOfArray(rhs.values_, numberValues_);
+}
+
+//#############################################################################
+
+int
+CoinPackedMatrixCompressed::countValues(const CoinPackedMatrix & matrix,
+					int maximum)
+{
+  double * values = new double [maximum];
+  int numberValues = coinSortedValues(matrix, maximum, values);
+  delete [] values;
+  return numberValues;
+}
+
+size_t
+CoinPackedMatrixCompressed::memoryBytes() const
+{
+  size_t bytes = (majorDim_ + 1) * sizeof(CoinBigIndex) + size_ * sizeof(int)
+    + numberValues_ * sizeof(double);
+  if (code8_)
+    bytes += size_;
+  else if (code16_)
+    bytes += size_ * sizeof(unsigned short);
+  return bytes;
+}
+
+CoinPackedMatrix *
+CoinPackedMatrixCompressed::expand() const
+{
+  double * element = new double [size_];
+  for (CoinBigIndex j = 0; j < size_; j++)
+    element[j] = this->element(j);
+  CoinPackedMatrix * matrix =
+    new CoinPackedMatrix(colOrdered_, minorDim_, majorDim_, size_,
+			 element, index_, start_, NULL);
+  delete [] element;
+  return matrix;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixCompressed::times(const double * x, double * y) const
+{
+  if (colOrdered_)
+    timesMajor(x, y);
+  else
+    timesMinor(x, y);
+}
+
+void
+CoinPackedMatrixCompressed::transposeTimes(const double * x, double * y) const
+{
+  if (colOrdered_)
+    timesMinor(x, y);
+  else
+    timesMajor(x, y);
+}
+
+void
+CoinPackedMatrixCompressed::timesMajor(const double * x, double * y) const
+{
+  if (code8_) {
+    CoinValue8 value = { code8_, values_ };
+    coinCompressedScatter(majorDim_, minorDim_, start_, index_, value, x, y);
+  } else if (code16_) {
+    CoinValue16 value = { code16_, values_ };
+    coinCompressedScatter(majorDim_, minorDim_, start_, index_, value, x, y);
+  } else if (allOnes()) {
+    coinCompressedScatter(majorDim_, minorDim_, start_, index_,
+			  CoinValueOne(), x, y);
+  } else {
+    CoinValueConstant value = { numberValues_ ? values_[0] : 0.0 };
+    coinCompressedScatter(majorDim_, minorDim_, start_, index_, value, x, y);
+  }
+}
+
+void
+CoinPackedMatrixCompressed::timesMinor(const double * x, double * y) const
+{
+  if (code8_) {
+    CoinValue8 value = { code8_, values_ };
+    coinCompressedGather(majorDim_, minorDim_, start_, index_, value, x, y);
+  } else if (code16_) {
+    CoinValue16 value = { code16_, values_ };
+    coinCompressedGather(majorDim_, minorDim_, start_, index_, value, x, y);
+  } else if (allOnes()) {
+    coinCompressedGather(majorDim_, minorDim_, start_, index_,
+			 CoinValueOne(), x, y);
+  } else {
+    CoinValueConstant value = { numberValues_ ? values_[0] : 0.0 };
+    coinCompressedGather(majorDim_, minorDim_, start_, index_, value, x, y);
+  }
+}
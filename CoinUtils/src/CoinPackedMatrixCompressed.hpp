@@ -0,0 +1,128 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixCompressed_H
+#define CoinPackedMatrixCompressed_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Compact copy of a CoinPackedMatrix with few distinct element values
+
+    Many matrices have only a handful of distinct coefficients (0/1
+    incidence, +/-1 network arcs, small integers).  This class keeps a
+    gap free copy of the starts and indices and, instead of a double per
+    element, a one or two byte code into a table of values.  If every
+    element is 1.0 there are no codes at all.  That is 5 (or 6 or 4) bytes
+    per element instead of 12.
+
+    The products give the same results as CoinPackedMatrix::times and
+    CoinPackedMatrix::transposeTimes (same order of operations).  The copy
+    is independent of the original matrix, which may then be deleted;
+    expand() gives back an ordinary matrix.
+*/
+class CoinPackedMatrixCompressed {
+public:
+  /**@name Products */
+  //@{
+  /** Return <code>A * x</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumCols()</code>
+      @pre <code>y</code> must be of size <code>getNumRows()</code> */
+  void times(const double * x, double * y) const;
+  /** Return <code>x * A</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumRows()</code>
+      @pre <code>y</code> must be of size <code>getNumCols()</code> */
+  void transposeTimes(const double * x, double * y) const;
+  /// As CoinPackedMatrix::timesMajor
+  void timesMajor(const double * x, double * y) const;
+  /// As CoinPackedMatrix::timesMinor
+  void timesMinor(const double * x, double * y) const;
+  //@}
+
+  /**@name Queries */
+  //@{
+  /// Number of distinct values a matrix has (-1 if more than maximum)
+  static int countValues(const CoinPackedMatrix & matrix,
+			 int maximum = 65536);
+  /// Whether column ordered
+  inline bool isColOrdered() const
+  { return colOrdered_;}
+  /// Number of rows
+  inline int getNumRows() const
+  { return colOrdered_ ? minorDim_ : majorDim_;}
+  /// Number of columns
+  inline int getNumCols() const
+  { return colOrdered_ ? majorDim_ : minorDim_;}
+  /// Number of elements
+  inline CoinBigIndex getNumElements() const
+  { return size_;}
+  /// Number of distinct values (0 if empty)
+  inline int numberValues() const
+  { return numberValues_;}
+  /// Table of distinct values (sorted)
+  inline const double * values() const
+  { return values_;}
+  /// True if every element is 1.0 (no codes stored)
+  inline bool allOnes() const
+  { return numberValues_ == 1 && values_[0] == 1.0;}
+  /// Bytes used by the arrays
+  size_t memoryBytes() const;
+  /// Makes an ordinary (gap free) matrix with the same elements
+  CoinPackedMatrix * expand() const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixCompressed();
+  /** Constructor from matrix.  Throws CoinError if the matrix has more
+      than 65536 distinct values (see countValues) */
+  CoinPackedMatrixCompressed(const CoinPackedMatrix & matrix);
+  /// Copy constructor
+  CoinPackedMatrixCompressed(const CoinPackedMatrixCompressed & rhs);
+  /// Assignment
+  CoinPackedMatrixCompressed & operator=(const CoinPackedMatrixCompressed & rhs);
+  /// Destructor
+  ~CoinPackedMatrixCompressed();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixCompressed & rhs);
+  /// Value of element j
+  inline double element(CoinBigIndex j) const
+  { return code8_ ? values_[code8_[j]] :
+      (code16_ ? values_[code16_[j]] : values_[0]);}
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Start of each major vector (majorDim_+1)
+  CoinBigIndex * start_;
+  /// Minor indices
+  int * index_;
+  /// Codes if at most 256 values (else NULL)
+  unsigned char * code8_;
+  /// Codes if more than 256 values (else NULL)
+  unsigned short * code16_;
+  /// Distinct values
+  double * values_;
+  /// Number of distinct values
+  int numberValues_;
+  /// Number of major vectors
+  int majorDim_;
+  /// Size of other dimension
+  int minorDim_;
+  /// Number of elements
+  CoinBigIndex size_;
+  /// Whether column ordered
+  bool colOrdered_;
+  //@}
+};
+
+#endif
@@ -0,0 +1,425 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#include "CoinPackedMatrixDuplicates.hpp"
+#include "CoinThreadPool.hpp"
+
+//#############################################################################
+// Mixes 64 bits (splitmix64 finalizer)
+static inline CoinUInt64
+coinDuplicatesMix(CoinUInt64 value)
+{
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+// Work for one thread
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  const int * candidates;
+  CoinUInt64 * hash;
+  int first;
+  int last;
+} CoinPackedMatrixDuplicatesThread;
+
+static void *
+coinDuplicatesWorker(void * info)
+{
+  CoinPackedMatrixDuplicatesThread * thread =
+    reinterpret_cast<CoinPackedMatrixDuplicatesThread *>(info);
+  const CoinBigIndex * start = thread->start;
+  const int * length = thread->length;
+  const int * candidates = thread->candidates;
+  for (int i = thread->first; i < thread->last; i++) {
+    const int iVector = candidates ? candidates[i] : i;
+    const CoinBigIndex j = start[iVector];
+    thread->hash[i] =
+      CoinPackedMatrixDuplicates::hashVector(length[iVector],
+					     thread->index + j,
+					     thread->element + j);
+  }
+  return NULL;
+}
+// Runs all threads - first one in this thread
+static void
+coinDuplicatesRun(CoinPackedMatrixDuplicatesThread * thread,
+		  int numberThreads)
+{
+  CoinThreadPool::run(coinDuplicatesWorker, thread,
+		      sizeof(CoinPackedMatrixDuplicatesThread), numberThreads);
+}
+
+// Exact check of hash groups for one thread
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  const CoinUInt64 * sortHash;
+  const int * which;
+  int numberMinor;
+  // positions in sorted order (first is start of a group, last end of one)
+  int first;
+  int last;
+  // results - members of classes, first member and start of each class
+  int * member;
+  int * classFirst;
+  int * classStart;
+  int numberMembers;
+  int numberClasses;
+} CoinPackedMatrixDuplicatesCheck;
+
+static void *
+coinDuplicatesCheckWorker(void * info)
+{
+  CoinPackedMatrixDuplicatesCheck * check =
+    reinterpret_cast<CoinPackedMatrixDuplicatesCheck *>(info);
+  const CoinBigIndex * start = check->start;
+  const int * length = check->length;
+  const int * index = check->index;
+  const double * element = check->element;
+  const CoinUInt64 * sortHash = check->sortHash;
+  const int * which = check->which;
+  const int numberMinor = check->numberMinor;
+  const int n = check->last - check->first;
+  int * member = check->member;
+  int numberMembers = 0;
+  int numberClasses = 0;
+  double * dense = new double [CoinMax(numberMinor, 1)];
+  int * mark = new int [CoinMax(numberMinor, 1)];
+  for (int i = 0; i < numberMinor; i++)
+    mark[i] = -1;
+  int stamp = 0;
+  char * used = new char [CoinMax(n, 1)];
+  memset(used, 0, n);
+  // used is indexed from check->first
+  used -= check->first;
+  for (int first = check->first; first < check->last;) {
+    int last = first + 1;
+    while (last < check->last && sortHash[last] == sortHash[first])
+      last++;
+    for (int p = first; p < last - 1; p++) {
+      if (used[p])
+	continue;
+      const int iVector = which[p];
+      const int nEl = length[iVector];
+      const CoinBigIndex jStart = start[iVector];
+      for (int j = 0; j < nEl; j++) {
+	const int iMinor = index[jStart + j];
+	mark[iMinor] = stamp;
+	dense[iMinor] = element[jStart + j];
+      }
+      const int startMembers = numberMembers;
+      for (int q = p + 1; q < last; q++) {
+	if (used[q])
+	  continue;
+	const int jVector = which[q];
+	if (length[jVector] != nEl)
+	  continue;
+	const CoinBigIndex kStart = start[jVector];
+	int j;
+	for (j = 0; j < nEl; j++) {
+	  const int iMinor = index[kStart + j];
+	  if (mark[iMinor] != stamp || dense[iMinor] != element[kStart + j])
+	    break;
+	}
+	if (j == nEl) {
+	  used[q] = 1;
+	  if (numberMembers == startMembers)
+	    member[numberMembers++] = iVector;
+	  member[numberMembers++] = jVector;
+	}
+      }
+      stamp++;
+      if (numberMembers > startMembers) {
+	std::sort(member + startMembers, member + numberMembers);
+	check->classFirst[numberClasses] = member[startMembers];
+	check->classStart[numberClasses++] = startMembers;
+      }
+    }
+    first = last;
+  }
+  used += check->first;
+  delete [] used;
+  delete [] mark;
+  delete [] dense;
+  check->numberMembers = numberMembers;
+  check->numberClasses = numberClasses;
+  return NULL;
+}
+// Runs all checks - first one in this thread
+static void
+coinDuplicatesRunCheck(CoinPackedMatrixDuplicatesCheck * check,
+		       int numberThreads)
+{
+  CoinThreadPool::run(coinDuplicatesCheckWorker, check,
+		      sizeof(CoinPackedMatrixDuplicatesCheck), numberThreads);
+}
+
+//#############################################################################
+
+CoinPackedMatrixDuplicates::CoinPackedMatrixDuplicates() :
+  classStart_(NULL),
+  classMember_(NULL),
+  hash_(NULL),
+  numberClasses_(0),
+  numberCandidates_(0),
+  numberThreads_(1)
+{
+  classStart_ = new int [1];
+  classStart_[0] = 0;
+}
+
+CoinPackedMatrixDuplicates::CoinPackedMatrixDuplicates(const CoinPackedMatrixDuplicates & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixDuplicates &
+CoinPackedMatrixDuplicates::operator=(const CoinPackedMatrixDuplicates & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixDuplicates::~CoinPackedMatrixDuplicates()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixDuplicates::gutsOfDelete()
+{
+  delete [] classStart_;
+  delete [] classMember_;
+  delete [] hash_;
+  classStart_ = NULL;
+  classMember_ = NULL;
+  hash_ = NULL;
+}
+
+void
+CoinPackedMatrixDuplicates::gutsOfCopy(const CoinPackedMatrixDuplicates & rhs)
+{
+  numberClasses_ = rhs.numberClasses_;
+  numberCandidates_ = rhs.numberCandidates_;
+  numberThreads_ = rhs.numberThreads_;
+  classStart_ = CoinCopyOfArray(rhs.classStart_, numberClasses_+1);
+  classMember_ = CoinCopyOfArray(rhs.classMember_,
+				 rhs.classStart_[numberClasses_]);
+  hash_ = CoinCopyOfArray(rhs.hash_, numberCandidates_);
+}
+
+void
+CoinPackedMatrixDuplicates::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value, 1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
+
+//#############################################################################
+
+CoinUInt64
+CoinPackedMatrixDuplicates::hashVector(int number, const int * index,
+				       const double * element)
+{
+  // sum of mixed entries so order does not matter
+  CoinUInt64 hash = coinDuplicatesMix(static_cast<CoinUInt64>(number));
+  for (int j = 0; j < number; j++) {
+    double value = element[j];
+    if (value == 0.0)
+      value = 0.0; // -0.0 hashes as 0.0
+    CoinUInt64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const CoinUInt64 key =
+      static_cast<CoinUInt64>(static_cast<unsigned int>(index[j]))
+      * 0x9e3779b97f4a7c15ULL;
+    hash += coinDuplicatesMix(key ^ coinDuplicatesMix(bits));
+  }
+  return hash;
+}
+
+void
+CoinPackedMatrixDuplicates::find(int numberMinor, const CoinBigIndex * start,
+				 const int * length, const int * index,
+				 const double * element,
+				 int numberCandidates, const int * candidates)
+{
+  gutsOfDelete();
+  numberClasses_ = 0;
+  numberCandidates_ = CoinMax(numberCandidates, 0);
+  const int n = numberCandidates_;
+  hash_ = new CoinUInt64 [n];
+  // hashes - threads only worth it if plenty of vectors each
+  int numberThreads = CoinMax(1, CoinMin(numberThreads_, n / 1000));
+  CoinPackedMatrixDuplicatesThread * thread =
+    new CoinPackedMatrixDuplicatesThread [numberThreads];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i].start = start;
+    thread[i].length = length;
+    thread[i].index = index;
+    thread[i].element = element;
+    thread[i].candidates = candidates;
+    thread[i].hash = hash_;
+    thread[i].first = static_cast<int>((static_cast<double>(n) * i)
+				       / numberThreads);
+    thread[i].last = static_cast<int>((static_cast<double>(n) * (i+1))
+				      / numberThreads);
+  }
+  thread[numberThreads-1].last = n;
+  coinDuplicatesRun(thread, numberThreads);
+  delete [] thread;
+  // sort by hash
+  CoinUInt64 * sortHash = CoinCopyOfArray(hash_, n);
+  int * which = new int [n];
+  for (int i = 0; i < n; i++)
+    which[i] = candidates ? candidates[i] : i;
+  CoinSort_2(sortHash, sortHash + n, which);
+  /*
+    Check each group with same hash exactly.  Groups are independent so
+    with threads the sorted list is split into blocks at group boundaries;
+    classes are put in order of first member below so the result is the
+    same for any number of threads.
+  */
+  CoinPackedMatrixDuplicatesCheck * check =
+    new CoinPackedMatrixDuplicatesCheck [numberThreads];
+  int * member = new int [CoinMax(n, 1)];
+  int * classFirst = new int [n / 2 + numberThreads];
+  int * classStart = new int [n / 2 + numberThreads];
+  int boundary = 0;
+  for (int i = 0; i < numberThreads; i++) {
+    CoinPackedMatrixDuplicatesCheck & block = check[i];
+    block.start = start;
+    block.length = length;
+    block.index = index;
+    block.element = element;
+    block.sortHash = sortHash;
+    block.which = which;
+    block.numberMinor = numberMinor;
+    block.first = boundary;
+    if (i == numberThreads - 1) {
+      boundary = n;
+    } else {
+      boundary = CoinMax(boundary, static_cast<int>(
+	  (static_cast<double>(n) * (i+1)) / numberThreads));
+      while (boundary > block.first && boundary < n &&
+	     sortHash[boundary] == sortHash[boundary-1])
+	boundary++;
+    }
+    block.last = boundary;
+    // a block of m positions has at most m members and m/2 classes
+    block.member = member + block.first;
+    block.classFirst = classFirst + block.first / 2 + i;
+    block.classStart = classStart + block.first / 2 + i;
+  }
+  coinDuplicatesRunCheck(check, numberThreads);
+  delete [] which;
+  delete [] sortHash;
+  // gather results of blocks
+  int numberMembers = 0;
+  int numberClasses = 0;
+  for (int i = 0; i < numberThreads; i++) {
+    const CoinPackedMatrixDuplicatesCheck & block = check[i];
+    for (int k = 0; k < block.numberClasses; k++) {
+      classFirst[numberClasses] = block.classFirst[k];
+      classStart[numberClasses++] = block.classStart[k] + numberMembers;
+    }
+    memmove(member + numberMembers, block.member,
+	    block.numberMembers * sizeof(int));
+    numberMembers += block.numberMembers;
+  }
+  delete [] check;
+  // classes in order of first member
+  int * order = new int [numberClasses];
+  for (int i = 0; i < numberClasses; i++)
+    order[i] = i;
+  CoinSort_2(classFirst, classFirst + numberClasses, order);
+  numberClasses_ = numberClasses;
+  classStart_ = new int [numberClasses + 1];
+  classMember_ = new int [numberMembers];
+  classStart_[0] = 0;
+  int put = 0;
+  for (int i = 0; i < numberClasses; i++) {
+    const int iClass = order[i];
+    const int end = iClass + 1 < numberClasses ? classStart[iClass+1]
+      : numberMembers;
+    for (int k = classStart[iClass]; k < end; k++)
+      classMember_[put++] = member[k];
+    classStart_[i+1] = put;
+  }
+  delete [] order;
+  delete [] classStart;
+  delete [] classFirst;
+  delete [] member;
+}
+
+void
+CoinPackedMatrixDuplicates::findMajor(const CoinPackedMatrix & matrix,
+				      int numberCandidates,
+				      const int * candidates)
+{
+  if (matrix.getTail()) {
+    // block append tail - look at merged copy
+    CoinPackedMatrix copy(matrix);
+    findMajor(copy, numberCandidates, candidates);
+    return;
+  }
+  if (!candidates && numberCandidates < 0)
+    numberCandidates = matrix.getMajorDim();
+  find(matrix.getMinorDim(), matrix.getVectorStarts(),
+       matrix.getVectorLengths(), matrix.getIndices(), matrix.getElements(),
+       numberCandidates, candidates);
+}
+
+void
+CoinPackedMatrixDuplicates::findColumns(const CoinPackedMatrix & matrix,
+					int numberCandidates,
+					const int * candidates)
+{
+  if (matrix.isColOrdered()) {
+    findMajor(matrix, numberCandidates, candidates);
+  } else {
+    CoinPackedMatrix reverse;
+    reverse.reverseOrderedCopyOf(matrix);
+    findMajor(reverse, numberCandidates, candidates);
+  }
+}
+
+void
+CoinPackedMatrixDuplicates::findRows(const CoinPackedMatrix & matrix,
+				     int numberCandidates,
+				     const int * candidates)
+{
+  if (!matrix.isColOrdered()) {
+    findMajor(matrix, numberCandidates, candidates);
+  } else {
+    CoinPackedMatrix reverse;
+    reverse.reverseOrderedCopyOf(matrix);
+    findMajor(reverse, numberCandidates, candidates);
+  }
+}
@@ -0,0 +1,122 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixDuplicates_H
+#define CoinPackedMatrixDuplicates_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Finds identical rows or columns of a matrix
+
+    Each candidate vector gets a 64 bit hash of its (index, value) pairs.
+    The hash does not depend on the order of the entries, so vectors need
+    not be sorted.  Vectors are then sorted by hash and each group with
+    the same hash is checked exactly (same length, indices and values),
+    so classes only hold true duplicates.  Hashes are computed, and groups
+    checked, in parallel if built with COINUTILS_PTHREADS and
+    setNumberThreads is used; the classes found do not depend on the
+    number of threads.
+
+    The same engine serves presolve (duplicate rows and columns, working
+    on the presolve arrays through find) and cut pools (hashVector on a
+    new cut, or find over the pool).
+*/
+class CoinPackedMatrixDuplicates {
+public:
+  /**@name Finding duplicates */
+  //@{
+  /** Duplicate columns of matrix among candidates (all columns if
+      candidates NULL and numberCandidates < 0) */
+  void findColumns(const CoinPackedMatrix & matrix,
+		   int numberCandidates = -1, const int * candidates = NULL);
+  /// Duplicate rows of matrix among candidates (as findColumns)
+  void findRows(const CoinPackedMatrix & matrix,
+		int numberCandidates = -1, const int * candidates = NULL);
+  /** Duplicate vectors among candidates of a packed structure.  Vector i
+      has length[i] entries starting at start[i]; indices are less than
+      numberMinor and are not repeated within a vector.  If candidates is
+      NULL the candidates are 0 to numberCandidates-1. */
+  void find(int numberMinor, const CoinBigIndex * start, const int * length,
+	    const int * index, const double * element,
+	    int numberCandidates, const int * candidates = NULL);
+  /// Hash of a vector (same for any order of entries, -0.0 same as 0.0)
+  static CoinUInt64 hashVector(int number, const int * index,
+			       const double * element);
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Number of classes of duplicates (each with at least two vectors)
+  inline int numberClasses() const
+  { return numberClasses_;}
+  /** Start of each class in classMembers (numberClasses()+1).  Classes
+      are in order of their first member */
+  inline const int * classStarts() const
+  { return classStart_;}
+  /// Vectors in each class (increasing order in a class)
+  inline const int * classMembers() const
+  { return classMember_;}
+  /// Number of vectors which duplicate an earlier one
+  inline int numberDuplicates() const
+  { return classStart_[numberClasses_] - numberClasses_;}
+  /// Number of candidates looked at
+  inline int numberCandidates() const
+  { return numberCandidates_;}
+  /// Hash of each candidate (in order of candidates)
+  inline const CoinUInt64 * hashes() const
+  { return hash_;}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Number of threads for hashing and checking
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (1 if not built with threads)
+  void setNumberThreads(int value);
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixDuplicates();
+  /// Copy constructor
+  CoinPackedMatrixDuplicates(const CoinPackedMatrixDuplicates & rhs);
+  /// Assignment
+  CoinPackedMatrixDuplicates & operator=(const CoinPackedMatrixDuplicates & rhs);
+  /// Destructor
+  ~CoinPackedMatrixDuplicates();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixDuplicates & rhs);
+  /// Duplicate major vectors of matrix
+  void findMajor(const CoinPackedMatrix & matrix,
+		 int numberCandidates, const int * candidates);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Start of each class (numberClasses_+1)
+  int * classStart_;
+  /// Members of classes
+  int * classMember_;
+  /// Hash of each candidate
+  CoinUInt64 * hash_;
+  /// Number of classes
+  int numberClasses_;
+  /// Number of candidates
+  int numberCandidates_;
+  /// Number of threads
+  int numberThreads_;
+  //@}
+};
+
+#endif
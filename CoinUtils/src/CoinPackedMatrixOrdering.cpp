@@ -0,0 +1,676 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#include "CoinError.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrixOrdering.hpp"
+
+//#############################################################################
+
+// Bipartite graph - nodes are columns then rows
+typedef struct {
+  const int * row;
+  const CoinBigIndex * columnStart;
+  const int * columnLength;
+  const int * column;
+  const CoinBigIndex * rowStart;
+  const int * rowLength;
+  int numberColumns;
+} CoinOrderingGraph;
+
+// Returns number of neighbours of node (list[j]+offset)
+static inline int
+coinNeighbours(const CoinOrderingGraph & graph, int node,
+	       const int *& list, int & offset)
+{
+  if (node < graph.numberColumns) {
+    list = graph.row + graph.columnStart[node];
+    offset = graph.numberColumns;
+    return graph.columnLength[node];
+  } else {
+    node -= graph.numberColumns;
+    list = graph.column + graph.rowStart[node];
+    offset = 0;
+    return graph.rowLength[node];
+  }
+}
+
+/* Breadth first search from start over nodes not done.  Returns number of
+   levels and sets last to a node of least degree in last level.  level
+   must be -1 for all nodes and is left that way */
+static int
+coinLevels(const CoinOrderingGraph & graph, int start, const char * done,
+	   const int * degree, int * level, int * queue, int & last)
+{
+  int nQueue = 0;
+  queue[nQueue++] = start;
+  level[start] = 0;
+  for (int k = 0; k < nQueue; k++) {
+    const int node = queue[k];
+    const int * list;
+    int offset;
+    const int n = coinNeighbours(graph, node, list, offset);
+    for (int j = 0; j < n; j++) {
+      const int other = list[j] + offset;
+      if (!done[other] && level[other] < 0) {
+	level[other] = level[node] + 1;
+	queue[nQueue++] = other;
+      }
+    }
+  }
+  const int lastLevel = level[queue[nQueue-1]];
+  last = queue[nQueue-1];
+  for (int k = nQueue - 1; k >= 0 && level[queue[k]] == lastLevel; k--) {
+    if (degree[queue[k]] < degree[last])
+      last = queue[k];
+  }
+  for (int k = 0; k < nQueue; k++)
+    level[queue[k]] = -1;
+  return lastLevel + 1;
+}
+
+// Orders nodes by degree then index
+class CoinOrderingDegreeLess {
+public:
+  explicit CoinOrderingDegreeLess(const int * degree) : degree_(degree) {}
+  inline bool operator()(int a, int b) const
+  { return degree_[a] < degree_[b] || (degree_[a] == degree_[b] && a < b);}
+private:
+  const int * degree_;
+};
+
+// Orders columns by their sorted rows (empty ones last) then index
+class CoinOrderingRowsLess {
+public:
+  CoinOrderingRowsLess(const CoinBigIndex * start, const int * row)
+    : start_(start), row_(row) {}
+  inline bool operator()(int a, int b) const
+  {
+    const int na = static_cast<int>(start_[a+1] - start_[a]);
+    const int nb = static_cast<int>(start_[b+1] - start_[b]);
+    if (!na || !nb) {
+      if (na != nb)
+	return na > nb;
+      return a < b;
+    }
+    const int * rowA = row_ + start_[a];
+    const int * rowB = row_ + start_[b];
+    const int n = CoinMin(na, nb);
+    for (int i = 0; i < n; i++) {
+      if (rowA[i] != rowB[i])
+	return rowA[i] < rowB[i];
+    }
+    if (na != nb)
+      return na < nb;
+    return a < b;
+  }
+private:
+  const CoinBigIndex * start_;
+  const int * row_;
+};
+
+// Gain in cut rows if column with rows moves from one part to another
+static int
+coinMoveGain(const int * rows, int n, const int * countFrom,
+	     const int * countTo)
+{
+  int gain = 0;
+  for (int j = 0; j < n; j++) {
+    const int iRow = rows[j];
+    if (countFrom[iRow] == 1 && countTo[iRow])
+      gain++;
+    else if (!countTo[iRow] && countFrom[iRow] > 1)
+      gain--;
+  }
+  return gain;
+}
+
+// Sets column and row ordered copies (reverse and merged used if needed)
+static void
+coinOrderingCopies(const CoinPackedMatrix & matrix, CoinPackedMatrix & reverse,
+		   CoinPackedMatrix & merged,
+		   const CoinPackedMatrix *& columnCopy,
+		   const CoinPackedMatrix *& rowCopy)
+{
+  const CoinPackedMatrix * same = &matrix;
+  const CoinPackedMatrix * other = matrix.getReverseOrderedCopy();
+  if (matrix.getTail()) {
+    // block append tail - use merged copy
+    merged = matrix;
+    same = &merged;
+    other = NULL;
+  }
+  if (!other) {
+    reverse.reverseOrderedCopyOf(*same);
+    other = &reverse;
+  }
+  columnCopy = matrix.isColOrdered() ? same : other;
+  rowCopy = matrix.isColOrdered() ? other : same;
+}
+
+// Largest span of column positions in a row (positions NULL if in order)
+static int
+coinBandwidth(const CoinPackedMatrix & rowCopy, const int * columnPosition)
+{
+  const int * column = rowCopy.getIndices();
+  const CoinBigIndex * rowStart = rowCopy.getVectorStarts();
+  const int * rowLength = rowCopy.getVectorLengths();
+  int bandwidth = 0;
+  for (int iRow = 0; iRow < rowCopy.getMajorDim(); iRow++) {
+    if (!rowLength[iRow])
+      continue;
+    int first = COIN_INT_MAX;
+    int last = -1;
+    const CoinBigIndex end = rowStart[iRow] + rowLength[iRow];
+    for (CoinBigIndex j = rowStart[iRow]; j < end; j++) {
+      const int position = columnPosition ? columnPosition[column[j]]
+	: column[j];
+      first = CoinMin(first, position);
+      last = CoinMax(last, position);
+    }
+    bandwidth = CoinMax(bandwidth, last - first);
+  }
+  return bandwidth;
+}
+
+//#############################################################################
+
+CoinPackedMatrixOrdering::CoinPackedMatrixOrdering() :
+  rowOrder_(NULL),
+  columnOrder_(NULL),
+  columnPartStart_(NULL),
+  rowPartStart_(NULL),
+  numberRows_(0),
+  numberColumns_(0),
+  numberParts_(0)
+{
+}
+
+CoinPackedMatrixOrdering::CoinPackedMatrixOrdering(const CoinPackedMatrixOrdering & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixOrdering &
+CoinPackedMatrixOrdering::operator=(const CoinPackedMatrixOrdering & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixOrdering::~CoinPackedMatrixOrdering()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixOrdering::gutsOfDelete()
+{
+  delete [] rowOrder_;
+  delete [] columnOrder_;
+  delete [] columnPartStart_;
+  delete [] rowPartStart_;
+  rowOrder_ = NULL;
+  columnOrder_ = NULL;
+  columnPartStart_ = NULL;
+  rowPartStart_ = NULL;
+}
+
+void
+CoinPackedMatrixOrdering::gutsOfCopy(const CoinPackedMatrixOrdering & rhs)
+{
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  numberParts_ = rhs.numberParts_;
+  rowOrder_ = CoinCopyOfArray(rhs.rowOrder_, numberRows_);
+  columnOrder_ = CoinCopyOfArray(rhs.columnOrder_, numberColumns_);
+  columnPartStart_ = CoinCopyOfArray(rhs.columnPartStart_,
+				     rhs.columnPartStart_ ? numberParts_+1 : 0);
+  rowPartStart_ = CoinCopyOfArray(rhs.rowPartStart_,
+				  rhs.rowPartStart_ ? numberParts_+2 : 0);
+}
+
+void
+CoinPackedMatrixOrdering::setDimensions(const CoinPackedMatrix & matrix)
+{
+  gutsOfDelete();
+  numberRows_ = matrix.getNumRows();
+  numberColumns_ = matrix.getNumCols();
+  numberParts_ = 0;
+  rowOrder_ = new int [numberRows_];
+  columnOrder_ = new int [numberColumns_];
+}
+
+int
+CoinPackedMatrixOrdering::bandwidth(const CoinPackedMatrix & matrix)
+{
+  CoinPackedMatrix reverse;
+  CoinPackedMatrix merged;
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  coinOrderingCopies(matrix, reverse, merged, columnCopy, rowCopy);
+  return coinBandwidth(*rowCopy, NULL);
+}
+
+//#############################################################################
+
+int
+CoinPackedMatrixOrdering::cuthillMcKee(const CoinPackedMatrix & columnCopy,
+				       const CoinPackedMatrix & rowCopy,
+				       int & numberRowsUsed)
+{
+  CoinOrderingGraph graph;
+  graph.row = columnCopy.getIndices();
+  graph.columnStart = columnCopy.getVectorStarts();
+  graph.columnLength = columnCopy.getVectorLengths();
+  graph.column = rowCopy.getIndices();
+  graph.rowStart = rowCopy.getVectorStarts();
+  graph.rowLength = rowCopy.getVectorLengths();
+  graph.numberColumns = numberColumns_;
+  const int numberNodes = numberColumns_ + numberRows_;
+  int * degree = new int [numberNodes];
+  CoinMemcpyN(graph.columnLength, numberColumns_, degree);
+  CoinMemcpyN(graph.rowLength, numberRows_, degree + numberColumns_);
+  int * list = new int [numberNodes];
+  int * queue = new int [numberNodes];
+  int * level = new int [numberNodes];
+  char * done = new char [numberNodes];
+  CoinFillN(level, numberNodes, -1);
+  CoinZeroN(done, numberNodes);
+  const CoinOrderingDegreeLess degreeLess(degree);
+  int nList = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (done[iColumn] || !degree[iColumn])
+      continue;
+    // pseudo-peripheral start - go to far end while that gets further
+    int start = iColumn;
+    int last;
+    int numberLevels = coinLevels(graph, start, done, degree, level, queue,
+				  last);
+    for (int pass = 0; pass < 10; pass++) {
+      int next;
+      const int n = coinLevels(graph, last, done, degree, level, queue, next);
+      if (n <= numberLevels)
+	break;
+      start = last;
+      last = next;
+      numberLevels = n;
+    }
+    // Cuthill-McKee
+    const int first = nList;
+    list[nList++] = start;
+    done[start] = 1;
+    for (int k = first; k < nList; k++) {
+      const int * neighbours;
+      int offset;
+      const int n = coinNeighbours(graph, list[k], neighbours, offset);
+      const int firstNew = nList;
+      for (int j = 0; j < n; j++) {
+	const int other = neighbours[j] + offset;
+	if (!done[other]) {
+	  done[other] = 1;
+	  list[nList++] = other;
+	}
+      }
+      std::sort(list + firstNew, list + nList, degreeLess);
+    }
+  }
+  int numberColumnsUsed = 0;
+  numberRowsUsed = 0;
+  for (int k = 0; k < nList; k++) {
+    if (list[k] < numberColumns_)
+      columnOrder_[numberColumnsUsed++] = list[k];
+    else
+      rowOrder_[numberRowsUsed++] = list[k] - numberColumns_;
+  }
+  // empty ones last
+  int n = numberColumnsUsed;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (!degree[iColumn])
+      columnOrder_[n++] = iColumn;
+  }
+  assert (n == numberColumns_);
+  n = numberRowsUsed;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (!degree[iRow + numberColumns_])
+      rowOrder_[n++] = iRow;
+  }
+  assert (n == numberRows_);
+  delete [] done;
+  delete [] level;
+  delete [] queue;
+  delete [] list;
+  delete [] degree;
+  return numberColumnsUsed;
+}
+
+int
+CoinPackedMatrixOrdering::reverseCuthillMcKee(const CoinPackedMatrix & matrix)
+{
+  setDimensions(matrix);
+  CoinPackedMatrix reverse;
+  CoinPackedMatrix merged;
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  coinOrderingCopies(matrix, reverse, merged, columnCopy, rowCopy);
+  int numberRowsUsed;
+  const int numberColumnsUsed = cuthillMcKee(*columnCopy, *rowCopy,
+					     numberRowsUsed);
+  std::reverse(columnOrder_, columnOrder_ + numberColumnsUsed);
+  std::reverse(rowOrder_, rowOrder_ + numberRowsUsed);
+  int * columnPosition = new int [numberColumns_];
+  for (int i = 0; i < numberColumns_; i++)
+    columnPosition[columnOrder_[i]] = i;
+  const int bandwidth = coinBandwidth(*rowCopy, columnPosition);
+  delete [] columnPosition;
+  return bandwidth;
+}
+
+//#############################################################################
+
+int
+CoinPackedMatrixOrdering::partition(const CoinPackedMatrix & matrix,
+				    int numberParts, double imbalance)
+{
+  if (numberParts < 1)
+    throw CoinError("number of parts must be positive", "partition",
+		    "CoinPackedMatrixOrdering");
+  setDimensions(matrix);
+  CoinPackedMatrix reverse;
+  CoinPackedMatrix merged;
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  coinOrderingCopies(matrix, reverse, merged, columnCopy, rowCopy);
+  int numberRowsUsed;
+  cuthillMcKee(*columnCopy, *rowCopy, numberRowsUsed);
+  numberParts_ = numberParts;
+  const int * row = columnCopy->getIndices();
+  const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+  const int * columnLength = columnCopy->getVectorLengths();
+  const int * column = rowCopy->getIndices();
+  const CoinBigIndex * rowStart = rowCopy->getVectorStarts();
+  const int * rowLength = rowCopy->getVectorLengths();
+  // split Cuthill-McKee order where middle of column falls
+  int * part = new int [numberColumns_];
+  CoinBigIndex * weight = new CoinBigIndex [numberParts];
+  int * start = new int [numberParts+1];
+  CoinZeroN(weight, numberParts);
+  CoinBigIndex total = numberColumns_;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+    total += columnLength[iColumn];
+  CoinBigIndex sum = 0;
+  int iPart = 0;
+  start[0] = 0;
+  for (int k = 0; k < numberColumns_; k++) {
+    const int iColumn = columnOrder_[k];
+    const CoinBigIndex w = columnLength[iColumn] + 1;
+    int jPart = static_cast<int>((static_cast<double>(2*sum + w) * numberParts) /
+				 (2.0 * total));
+    jPart = CoinMin(jPart, numberParts - 1);
+    while (iPart < jPart)
+      start[++iPart] = k;
+    part[iColumn] = iPart;
+    weight[iPart] += w;
+    sum += w;
+  }
+  while (iPart < numberParts)
+    start[++iPart] = numberColumns_;
+  /* move columns across each boundary if fewer rows are then in both
+     parts.  Columns in part p may have come from p-1 so counts start
+     there.  A column is only moved once */
+  const double maximumWeight = (1.0 + imbalance) * total / numberParts;
+  int * countP = new int [numberRows_];
+  int * countQ = new int [numberRows_];
+  char * moved = new char [numberColumns_];
+  CoinZeroN(countP, numberRows_);
+  CoinZeroN(countQ, numberRows_);
+  CoinZeroN(moved, numberColumns_);
+  for (int p = 0; p < numberParts - 1; p++) {
+    const int q = p + 1;
+    const int first = start[CoinMax(p - 1, 0)];
+    const int last = start[q+1];
+    for (int k = first; k < last; k++) {
+      const int iColumn = columnOrder_[k];
+      int * count = part[iColumn] == p ? countP :
+	(part[iColumn] == q ? countQ : NULL);
+      if (!count)
+	continue;
+      const CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+      for (CoinBigIndex j = columnStart[iColumn]; j < end; j++)
+	count[row[j]]++;
+    }
+    for (int pass = 0; pass < 2; pass++) {
+      // first from end of p to q, then from start of q to p
+      const int from = pass ? q : p;
+      const int to = pass ? p : q;
+      int * countFrom = pass ? countQ : countP;
+      int * countTo = pass ? countP : countQ;
+      const int kStart = pass ? start[q] : start[q] - 1;
+      const int kEnd = pass ? start[q+1] : start[p] - 1;
+      const int kStep = pass ? 1 : -1;
+      for (int k = kStart; k != kEnd; k += kStep) {
+	const int iColumn = columnOrder_[k];
+	if (part[iColumn] != from || moved[iColumn])
+	  continue;
+	const CoinBigIndex w = columnLength[iColumn] + 1;
+	if (weight[to] + w > maximumWeight)
+	  continue;
+	const int * rows = row + columnStart[iColumn];
+	const int n = columnLength[iColumn];
+	if (coinMoveGain(rows, n, countFrom, countTo) <= 0)
+	  continue;
+	for (int j = 0; j < n; j++) {
+	  countFrom[rows[j]]--;
+	  countTo[rows[j]]++;
+	}
+	part[iColumn] = to;
+	weight[from] -= w;
+	weight[to] += w;
+	moved[iColumn] = 1;
+      }
+    }
+    for (int k = first; k < last; k++) {
+      const int iColumn = columnOrder_[k];
+      const CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+      for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+	countP[row[j]] = 0;
+	countQ[row[j]] = 0;
+      }
+    }
+  }
+  delete [] moved;
+  delete [] countQ;
+  delete [] countP;
+  delete [] start;
+  delete [] weight;
+  // columns by part keeping Cuthill-McKee order
+  int * order = new int [CoinMax(numberColumns_, numberRows_)];
+  columnPartStart_ = new int [numberParts+1];
+  CoinZeroN(columnPartStart_, numberParts+1);
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+    columnPartStart_[part[iColumn]+1]++;
+  for (int p = 0; p < numberParts; p++)
+    columnPartStart_[p+1] += columnPartStart_[p];
+  int * put = new int [numberParts+1];
+  CoinMemcpyN(columnPartStart_, numberParts, put);
+  for (int k = 0; k < numberColumns_; k++) {
+    const int iColumn = columnOrder_[k];
+    order[put[part[iColumn]]++] = iColumn;
+  }
+  CoinMemcpyN(order, numberColumns_, columnOrder_);
+  // rows by part (numberParts if cut)
+  int * rowPart = new int [numberRows_];
+  int numberCut = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int jPart = 0;
+    if (rowLength[iRow]) {
+      const CoinBigIndex end = rowStart[iRow] + rowLength[iRow];
+      jPart = part[column[rowStart[iRow]]];
+      for (CoinBigIndex j = rowStart[iRow] + 1; j < end; j++) {
+	if (part[column[j]] != jPart) {
+	  jPart = numberParts;
+	  numberCut++;
+	  break;
+	}
+      }
+    }
+    rowPart[iRow] = jPart;
+  }
+  rowPartStart_ = new int [numberParts+2];
+  CoinZeroN(rowPartStart_, numberParts+2);
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    rowPartStart_[rowPart[iRow]+1]++;
+  for (int p = 0; p <= numberParts; p++)
+    rowPartStart_[p+1] += rowPartStart_[p];
+  CoinMemcpyN(rowPartStart_, numberParts+1, put);
+  for (int k = 0; k < numberRows_; k++) {
+    const int iRow = rowOrder_[k];
+    order[put[rowPart[iRow]]++] = iRow;
+  }
+  CoinMemcpyN(order, numberRows_, rowOrder_);
+  delete [] rowPart;
+  delete [] put;
+  delete [] order;
+  delete [] part;
+  return numberCut;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixOrdering::clusterColumns(const CoinPackedMatrix & matrix)
+{
+  setDimensions(matrix);
+  CoinPackedMatrix reverse;
+  CoinPackedMatrix merged;
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  coinOrderingCopies(matrix, reverse, merged, columnCopy, rowCopy);
+  const int * row = columnCopy->getIndices();
+  const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+  const int * columnLength = columnCopy->getVectorLengths();
+  // sorted rows of each column with no gaps
+  CoinBigIndex * start = new CoinBigIndex [numberColumns_+1];
+  start[0] = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+    start[iColumn+1] = start[iColumn] + columnLength[iColumn];
+  int * sortedRow = new int [start[numberColumns_]];
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    CoinMemcpyN(row + columnStart[iColumn], columnLength[iColumn],
+		sortedRow + start[iColumn]);
+    std::sort(sortedRow + start[iColumn], sortedRow + start[iColumn+1]);
+  }
+  CoinIotaN(columnOrder_, numberColumns_, 0);
+  std::sort(columnOrder_, columnOrder_ + numberColumns_,
+	    CoinOrderingRowsLess(start, sortedRow));
+  // rows in order first used
+  char * used = new char [numberRows_];
+  CoinZeroN(used, numberRows_);
+  int n = 0;
+  for (int k = 0; k < numberColumns_; k++) {
+    const int iColumn = columnOrder_[k];
+    for (CoinBigIndex j = start[iColumn]; j < start[iColumn+1]; j++) {
+      const int iRow = sortedRow[j];
+      if (!used[iRow]) {
+	used[iRow] = 1;
+	rowOrder_[n++] = iRow;
+      }
+    }
+  }
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (!used[iRow])
+      rowOrder_[n++] = iRow;
+  }
+  assert (n == numberRows_);
+  delete [] used;
+  delete [] sortedRow;
+  delete [] start;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixOrdering::apply(CoinPackedMatrix & matrix) const
+{
+  if (!rowOrder_ || matrix.getNumRows() != numberRows_ ||
+      matrix.getNumCols() != numberColumns_)
+    throw CoinError("ordering does not match matrix", "apply",
+		    "CoinPackedMatrixOrdering");
+  if (matrix.getTail())
+    matrix.compactTail();
+  const bool colOrdered = matrix.isColOrdered();
+  const int majorDim = matrix.getMajorDim();
+  const int minorDim = matrix.getMinorDim();
+  const int * majorOrder = colOrdered ? columnOrder_ : rowOrder_;
+  const int * minorOrder = colOrdered ? rowOrder_ : columnOrder_;
+  int * minorPosition = new int [minorDim];
+  for (int i = 0; i < minorDim; i++)
+    minorPosition[minorOrder[i]] = i;
+  const int * oldIndex = matrix.getIndices();
+  const double * oldElement = matrix.getElements();
+  const CoinBigIndex size = matrix.getNumElements();
+  CoinBigIndex * start = new CoinBigIndex [majorDim+1];
+  int * length = new int [majorDim];
+  int * index = new int [size];
+  double * element = new double [size];
+  CoinBigIndex n = 0;
+  for (int k = 0; k < majorDim; k++) {
+    const int i = majorOrder[k];
+    const CoinBigIndex first = matrix.getVectorFirst(i);
+    const int number = matrix.getVectorSize(i);
+    start[k] = n;
+    for (int j = 0; j < number; j++) {
+      index[n + j] = minorPosition[oldIndex[first + j]];
+      element[n + j] = oldElement[first + j];
+    }
+    length[k] = number;
+    CoinSort_2(index + n, index + n + number, element + n);
+    n += number;
+  }
+  start[majorDim] = n;
+  assert (n == size);
+  delete [] minorPosition;
+  matrix.assignMatrix(colOrdered, minorDim, majorDim, size,
+		      element, index, start, length);
+}
+
+void
+CoinPackedMatrixOrdering::orderRows(const double * in, double * out) const
+{
+  for (int i = 0; i < numberRows_; i++)
+    out[i] = in[rowOrder_[i]];
+}
+
+void
+CoinPackedMatrixOrdering::unorderRows(const double * in, double * out) const
+{
+  for (int i = 0; i < numberRows_; i++)
+    out[rowOrder_[i]] = in[i];
+}
+
+void
+CoinPackedMatrixOrdering::orderColumns(const double * in, double * out) const
+{
+  for (int i = 0; i < numberColumns_; i++)
+    out[i] = in[columnOrder_[i]];
+}
+
+void
+CoinPackedMatrixOrdering::unorderColumns(const double * in, double * out) const
+{
+  for (int i = 0; i < numberColumns_; i++)
+    out[columnOrder_[i]] = in[i];
+}
@@ -0,0 +1,137 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixOrdering_H
+#define CoinPackedMatrixOrdering_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Row and column orderings of a CoinPackedMatrix for locality
+
+    Each method sets a new order of rows and of columns (rowOrder()[i] is
+    the row which goes to position i).  apply permutes a matrix in place
+    and orderRows etc. move vectors to and from the new order.
+
+    <ul>
+    <li> reverseCuthillMcKee - breadth first search of the bipartite
+         graph with a node for each row and column, neighbours taken in
+         order of increasing number of elements, from a pseudo-peripheral
+         start in each connected component; the order is then reversed.
+         Elements end up near a diagonal so the parts of x and y used
+         by times and transposeTimes move slowly through cache.
+    <li> partition - columns are split into parts of about the same
+         number of elements (column-net hypergraph model) for parallel
+         products.  Columns are split in Cuthill-McKee order and columns
+         at each boundary are moved if that puts fewer rows in both parts.
+         Rows only in one part come first part by part, then the cut rows
+         which need adding up across parts.  This is a single level method
+         so cuts are not as small as those of a multilevel partitioner.
+    <li> clusterColumns - columns with the same rows are put next to each
+         other (ordered by their lists of rows) and rows are ordered by
+         the first column they are in.
+    </ul>
+    Empty rows and columns go last.  Time is about linear in the number
+    of elements except for the sort in clusterColumns.
+*/
+class CoinPackedMatrixOrdering {
+public:
+  /**@name Orderings */
+  //@{
+  /// Reverse Cuthill-McKee.  Returns bandwidth of reordered matrix
+  int reverseCuthillMcKee(const CoinPackedMatrix & matrix);
+  /** Splits columns into numberParts parts each with no more than
+      (1+imbalance) times its share of elements (plus one for each
+      column).  Returns number of cut rows */
+  int partition(const CoinPackedMatrix & matrix, int numberParts,
+		double imbalance = 0.03);
+  /// Columns ordered by their rows, rows by first column
+  void clusterColumns(const CoinPackedMatrix & matrix);
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Row in each position
+  inline const int * rowOrder() const
+  { return rowOrder_;}
+  /// Column in each position
+  inline const int * columnOrder() const
+  { return columnOrder_;}
+  /// Number of parts (0 if last ordering was not a partition)
+  inline int numberParts() const
+  { return numberParts_;}
+  /// Start of each part in columnOrder (numberParts()+1)
+  inline const int * columnPartStart() const
+  { return columnPartStart_;}
+  /** Start of each part in rowOrder (numberParts()+2).  Rows from
+      rowPartStart()[numberParts()] on are cut rows */
+  inline const int * rowPartStart() const
+  { return rowPartStart_;}
+  /** Largest difference in position between first and last column of a
+      row */
+  static int bandwidth(const CoinPackedMatrix & matrix);
+  //@}
+
+  /**@name Applying orderings */
+  //@{
+  /** Permutes matrix in place (throws CoinError if sizes do not match).
+      Vectors come out sorted and with no gaps */
+  void apply(CoinPackedMatrix & matrix) const;
+  /// out[i] = in[rowOrder()[i]]
+  void orderRows(const double * in, double * out) const;
+  /// out[rowOrder()[i]] = in[i]
+  void unorderRows(const double * in, double * out) const;
+  /// out[i] = in[columnOrder()[i]]
+  void orderColumns(const double * in, double * out) const;
+  /// out[columnOrder()[i]] = in[i]
+  void unorderColumns(const double * in, double * out) const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixOrdering();
+  /// Copy constructor
+  CoinPackedMatrixOrdering(const CoinPackedMatrixOrdering & rhs);
+  /// Assignment
+  CoinPackedMatrixOrdering & operator=(const CoinPackedMatrixOrdering & rhs);
+  /// Destructor
+  ~CoinPackedMatrixOrdering();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixOrdering & rhs);
+  /// Sets dimensions and gets order arrays
+  void setDimensions(const CoinPackedMatrix & matrix);
+  /** Cuthill-McKee order into rowOrder_ and columnOrder_.  Returns number
+      of columns with elements (rows with elements in numberRowsUsed) */
+  int cuthillMcKee(const CoinPackedMatrix & columnCopy,
+		   const CoinPackedMatrix & rowCopy, int & numberRowsUsed);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Row in each position
+  int * rowOrder_;
+  /// Column in each position
+  int * columnOrder_;
+  /// Start of each part in columnOrder
+  int * columnPartStart_;
+  /// Start of each part in rowOrder
+  int * rowPartStart_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of parts
+  int numberParts_;
+  //@}
+};
+
+#endif
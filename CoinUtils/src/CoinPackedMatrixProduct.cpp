@@ -0,0 +1,741 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrixProduct.hpp"
+#include "CoinThreadPool.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#if defined(__linux__) && defined(_GNU_SOURCE)
+#include <sched.h>
+#define COIN_HAS_AFFINITY
+#endif
+#endif
+
+// Arrays of one thread (placePartitioned) - block is vectors first to last
+struct CoinPackedMatrixProductBlock {
+  // gap free starts (last-first+1) from 0
+  CoinBigIndex * start;
+  int * length;
+  int * index;
+  double * element;
+  // work vector for reduction (threads other than first)
+  double * work;
+};
+
+//#############################################################################
+// Work for one thread
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  const double * x;
+  double * y;
+  // other work vectors for reduction
+  double * const * work;
+  int numberWork;
+  int first;
+  int last;
+  // entries of y to zero first (scatter) or of work vector (placing)
+  int numberClear;
+  // arrays to make (placing)
+  CoinPackedMatrixProductBlock * block;
+  // vectors interleaved in x and y (gathers)
+  int numberVectors;
+  /* 0 - gather over major vectors, 1 - scatter over major vectors,
+     2 - add in work vectors, 3 - gather over transposed copy,
+     4 - copy first to last into block */
+  int type;
+} CoinPackedMatrixProductThread;
+
+static void *
+coinProductWorker(void * info)
+{
+  CoinPackedMatrixProductThread * thread =
+    reinterpret_cast<CoinPackedMatrixProductThread *>(info);
+  const CoinBigIndex * COIN_RESTRICT start = thread->start;
+  const int * COIN_RESTRICT length = thread->length;
+  const int * COIN_RESTRICT index = thread->index;
+  const double * COIN_RESTRICT element = thread->element;
+  const double * COIN_RESTRICT x = thread->x;
+  double * COIN_RESTRICT y = thread->y;
+  int first = thread->first;
+  int last = thread->last;
+  switch (thread->type) {
+  case 0:
+    if (thread->numberVectors > 1) {
+      // each element used for all vectors as it is read
+      const size_t k = thread->numberVectors;
+      for (int i = first; i < last; i++) {
+	double * COIN_RESTRICT y_i = y + i * k;
+	for (size_t v = 0; v < k; v++)
+	  y_i[v] = 0.0;
+	const CoinBigIndex end = start[i] + length[i];
+	for (CoinBigIndex j = start[i]; j < end; ++j) {
+	  const double * COIN_RESTRICT x_j = x + index[j] * k;
+	  const double value = element[j];
+	  for (size_t v = 0; v < k; v++)
+	    y_i[v] += x_j[v] * value;
+	}
+      }
+      break;
+    }
+    for (int i = last - 1; i >= first; --i) {
+      double y_i = 0;
+      const CoinBigIndex end = start[i] + length[i];
+      for (CoinBigIndex j = start[i]; j < end; ++j)
+	y_i += x[index[j]] * element[j];
+      y[i] = y_i;
+    }
+    break;
+  case 1:
+    memset(y, 0, thread->numberClear * sizeof(double));
+    for (int i = last - 1; i >= first; --i) {
+      const double x_i = x[i];
+      if (x_i != 0.0) {
+	const CoinBigIndex end = start[i] + length[i];
+	for (CoinBigIndex j = start[i]; j < end; ++j)
+	  y[index[j]] += x_i * element[j];
+      }
+    }
+    break;
+  case 2:
+    for (int k = 0; k < thread->numberWork; k++) {
+      const double * COIN_RESTRICT work = thread->work[k];
+      for (int i = first; i < last; i++)
+	y[i] += work[i];
+    }
+    break;
+  case 3:
+    if (thread->numberVectors > 1) {
+      const size_t k = thread->numberVectors;
+      for (int i = first; i < last; i++) {
+	double * COIN_RESTRICT y_i = y + i * k;
+	for (size_t v = 0; v < k; v++)
+	  y_i[v] = 0.0;
+	for (CoinBigIndex j = start[i]; j < start[i+1]; ++j) {
+	  const double * COIN_RESTRICT x_j = x + index[j] * k;
+	  const double value = element[j];
+	  for (size_t v = 0; v < k; v++)
+	    y_i[v] += x_j[v] * value;
+	}
+      }
+      break;
+    }
+    for (int i = first; i < last; i++) {
+      double y_i = 0;
+      for (CoinBigIndex j = start[i]; j < start[i+1]; ++j) {
+	const double x_j = x[index[j]];
+	if (x_j != 0.0)
+	  y_i += x_j * element[j];
+      }
+      y[i] = y_i;
+    }
+    break;
+  case 4:
+    {
+      // allocated and written here so pages are local to this thread
+      CoinPackedMatrixProductBlock * block = thread->block;
+      const int number = last - first;
+      CoinBigIndex numberElements = 0;
+      for (int i = first; i < last; i++)
+	numberElements += length ? length[i] : start[i+1] - start[i];
+      block->start = new CoinBigIndex [number + 1];
+      block->length = new int [number];
+      block->index = new int [numberElements];
+      block->element = new double [numberElements];
+      CoinBigIndex put = 0;
+      for (int i = first; i < last; i++) {
+	const int n = length ? length[i] :
+	  static_cast<int>(start[i+1] - start[i]);
+	block->start[i - first] = put;
+	block->length[i - first] = n;
+	CoinMemcpyN(index + start[i], n, block->index + put);
+	CoinMemcpyN(element + start[i], n, block->element + put);
+	put += n;
+      }
+      block->start[number] = put;
+      if (thread->numberClear) {
+	block->work = new double [thread->numberClear];
+	CoinZeroN(block->work, thread->numberClear);
+      } else {
+	block->work = NULL;
+      }
+    }
+    break;
+  }
+  return NULL;
+}
+/* Runs all threads - first one in this thread.  If cpus are given the
+   others get their own threads bound to them (so blocks they first touch
+   stay on their memory), otherwise tasks go to the shared pool. */
+static void
+coinProductRun(CoinPackedMatrixProductThread * thread, int numberThreads,
+	       const int * cpu = NULL, int numberCpus = 0)
+{
+  if (!numberCpus) {
+    CoinThreadPool::run(coinProductWorker, thread,
+			sizeof(CoinPackedMatrixProductThread), numberThreads);
+    return;
+  }
+#ifdef COINUTILS_PTHREADS
+  if (numberThreads > 1) {
+    pthread_t * threadId = new pthread_t [numberThreads];
+    int numberStarted = 1;
+    for (int i = 1; i < numberThreads; i++) {
+      pthread_attr_t attributes;
+      pthread_attr_init(&attributes);
+#ifdef COIN_HAS_AFFINITY
+      if (i < numberCpus && cpu[i] >= 0 && cpu[i] < CPU_SETSIZE) {
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu[i], &cpus);
+	pthread_attr_setaffinity_np(&attributes, sizeof(cpus), &cpus);
+      }
+#else
+      (void) cpu;
+      (void) numberCpus;
+#endif
+      int returnCode = pthread_create(threadId + i, &attributes,
+				      coinProductWorker, thread + i);
+      pthread_attr_destroy(&attributes);
+      if (returnCode)
+	break;
+      numberStarted++;
+    }
+    coinProductWorker(thread);
+    for (int i = 1; i < numberStarted; i++)
+      pthread_join(threadId[i], NULL);
+    // any which could not be started
+    for (int i = numberStarted; i < numberThreads; i++)
+      coinProductWorker(thread + i);
+    delete [] threadId;
+    return;
+  }
+#else
+  (void) cpu;
+  (void) numberCpus;
+#endif
+  for (int i = 0; i < numberThreads; i++)
+    coinProductWorker(thread + i);
+}
+
+//#############################################################################
+
+CoinPackedMatrixProduct::CoinPackedMatrixProduct() :
+  matrix_(NULL),
+  majorBlock_(NULL),
+  minorBlock_(NULL),
+  transposeStart_(NULL),
+  transposeIndex_(NULL),
+  transposeElement_(NULL),
+  work_(NULL),
+  block_(NULL),
+  cpu_(NULL),
+  numberThreads_(1),
+  numberCpus_(0),
+  deterministic_(false),
+  placement_(placeShared)
+{
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrixProduct::CoinPackedMatrixProduct(const CoinPackedMatrix & matrix,
+						 int numberThreads,
+						 bool deterministic) :
+  matrix_(&matrix),
+  majorBlock_(NULL),
+  minorBlock_(NULL),
+  transposeStart_(NULL),
+  transposeIndex_(NULL),
+  transposeElement_(NULL),
+  work_(NULL),
+  block_(NULL),
+  cpu_(NULL),
+  numberThreads_(1),
+  numberCpus_(0),
+  deterministic_(deterministic),
+  placement_(placeShared)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(numberThreads, 1);
+#else
+  (void) numberThreads;
+#endif
+  refresh();
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrixProduct::CoinPackedMatrixProduct(const CoinPackedMatrixProduct & rhs) :
+  matrix_(NULL),
+  majorBlock_(NULL),
+  minorBlock_(NULL),
+  transposeStart_(NULL),
+  transposeIndex_(NULL),
+  transposeElement_(NULL),
+  work_(NULL),
+  block_(NULL),
+  cpu_(NULL),
+  numberThreads_(1),
+  numberCpus_(0),
+  deterministic_(false),
+  placement_(placeShared)
+{
+  gutsOfCopy(rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrixProduct &
+CoinPackedMatrixProduct::operator=(const CoinPackedMatrixProduct & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedMatrixProduct::~CoinPackedMatrixProduct()
+{
+  gutsOfDelete();
+  delete [] cpu_;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::gutsOfDelete()
+{
+  delete [] majorBlock_;
+  delete [] minorBlock_;
+  delete [] transposeStart_;
+  delete [] transposeIndex_;
+  delete [] transposeElement_;
+  delete [] work_;
+  if (block_) {
+    for (int i = 0; i < 2 * numberThreads_; i++) {
+      delete [] block_[i].start;
+      delete [] block_[i].length;
+      delete [] block_[i].index;
+      delete [] block_[i].element;
+      delete [] block_[i].work;
+    }
+    delete [] block_;
+  }
+  majorBlock_ = NULL;
+  minorBlock_ = NULL;
+  transposeStart_ = NULL;
+  transposeIndex_ = NULL;
+  transposeElement_ = NULL;
+  work_ = NULL;
+  block_ = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::gutsOfCopy(const CoinPackedMatrixProduct & rhs)
+{
+  matrix_ = rhs.matrix_;
+  numberThreads_ = rhs.numberThreads_;
+  deterministic_ = rhs.deterministic_;
+  placement_ = rhs.placement_;
+  delete [] cpu_;
+  cpu_ = CoinCopyOfArray(rhs.cpu_, rhs.numberCpus_);
+  numberCpus_ = rhs.numberCpus_;
+  // cheaper to redo than work out what to copy
+  if (matrix_)
+    refresh();
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  value = CoinMax(value, 1);
+#else
+  value = 1;
+#endif
+  if (value != numberThreads_) {
+    // blocks are freed with old number
+    gutsOfDelete();
+    numberThreads_ = value;
+    if (matrix_)
+      refresh();
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::setDeterministic(bool yesNo)
+{
+  if (yesNo != deterministic_) {
+    deterministic_ = yesNo;
+    if (matrix_)
+      refresh();
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::setPlacement(Placement value)
+{
+  if (value != placement_) {
+    placement_ = value;
+    if (matrix_)
+      refresh();
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::setThreadCpus(const int * cpu)
+{
+  delete [] cpu_;
+  cpu_ = CoinCopyOfArray(cpu, numberThreads_);
+  numberCpus_ = cpu ? numberThreads_ : 0;
+  // blocks must be made again by bound threads
+  if (matrix_ && block_)
+    refresh();
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::partition(int number, const CoinBigIndex * start,
+				   const int * length, int * which) const
+{
+  double total = 0.0;
+  for (int i = 0; i < number; i++)
+    total += length ? length[i] : start[i+1] - start[i];
+  // count each vector as a bit of work even if empty
+  total += number;
+  which[0] = 0;
+  int iThread = 1;
+  double sum = 0.0;
+  for (int i = 0; i < number && iThread < numberThreads_; i++) {
+    sum += 1.0 + (length ? length[i] : start[i+1] - start[i]);
+    while (iThread < numberThreads_ && sum >= (total * iThread) / numberThreads_)
+      which[iThread++] = i + 1;
+  }
+  while (iThread <= numberThreads_)
+    which[iThread++] = number;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::refresh()
+{
+  gutsOfDelete();
+  assert (matrix_);
+  const int majorDim = matrix_->getMajorDim();
+  const int minorDim = matrix_->getMinorDim();
+  const CoinBigIndex * start = matrix_->getVectorStarts();
+  const int * length = matrix_->getVectorLengths();
+  majorBlock_ = new int [numberThreads_ + 1];
+  minorBlock_ = new int [numberThreads_ + 1];
+  partition(majorDim, start, length, majorBlock_);
+  if (deterministic_) {
+    // transposed copy with major indices descending as in serial scatter
+    const int * index = matrix_->getIndices();
+    const double * element = matrix_->getElements();
+    transposeStart_ = new CoinBigIndex [minorDim + 1];
+    CoinZeroN(transposeStart_, minorDim + 1);
+    for (int i = 0; i < majorDim; i++) {
+      const CoinBigIndex end = start[i] + length[i];
+      for (CoinBigIndex j = start[i]; j < end; j++)
+	transposeStart_[index[j]+1]++;
+    }
+    for (int i = 0; i < minorDim; i++)
+      transposeStart_[i+1] += transposeStart_[i];
+    const CoinBigIndex numberElements = transposeStart_[minorDim];
+    transposeIndex_ = new int [numberElements];
+    transposeElement_ = new double [numberElements];
+    CoinBigIndex * put = new CoinBigIndex [minorDim];
+    CoinMemcpyN(transposeStart_, minorDim, put);
+    for (int i = majorDim - 1; i >= 0; i--) {
+      const CoinBigIndex end = start[i] + length[i];
+      for (CoinBigIndex j = start[i]; j < end; j++) {
+	CoinBigIndex k = put[index[j]]++;
+	transposeIndex_[k] = i;
+	transposeElement_[k] = element[j];
+      }
+    }
+    delete [] put;
+    partition(minorDim, transposeStart_, NULL, minorBlock_);
+  } else {
+    // reduction just splits evenly
+    for (int i = 0; i <= numberThreads_; i++)
+      minorBlock_[i] = static_cast<int>((static_cast<double>(minorDim) * i)
+					/ numberThreads_);
+    if (numberThreads_ > 1 && placement_ != placePartitioned)
+      work_ = new double [(numberThreads_ - 1) * minorDim];
+  }
+  if (placement_ == placePartitioned)
+    place();
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::place()
+{
+  CoinPackedMatrixProductThread * thread =
+    new CoinPackedMatrixProductThread [numberThreads_];
+  // major blocks then (if deterministic) blocks of transposed copy
+  block_ = new CoinPackedMatrixProductBlock [2 * numberThreads_];
+  memset(block_, 0, 2 * numberThreads_ * sizeof(CoinPackedMatrixProductBlock));
+  const int minorDim = matrix_->getMinorDim();
+  for (int pass = 0; pass < (deterministic_ ? 2 : 1); pass++) {
+    for (int i = 0; i < numberThreads_; i++) {
+      if (pass) {
+	thread[i].start = transposeStart_;
+	thread[i].length = NULL;
+	thread[i].index = transposeIndex_;
+	thread[i].element = transposeElement_;
+	thread[i].first = minorBlock_[i];
+	thread[i].last = minorBlock_[i+1];
+	thread[i].numberClear = 0;
+      } else {
+	thread[i].start = matrix_->getVectorStarts();
+	thread[i].length = matrix_->getVectorLengths();
+	thread[i].index = matrix_->getIndices();
+	thread[i].element = matrix_->getElements();
+	thread[i].first = majorBlock_[i];
+	thread[i].last = majorBlock_[i+1];
+	thread[i].numberClear = (i && !deterministic_) ? minorDim : 0;
+      }
+      thread[i].x = NULL;
+      thread[i].y = NULL;
+      thread[i].work = NULL;
+      thread[i].numberWork = 0;
+      thread[i].block = block_ + pass * numberThreads_ + i;
+      thread[i].numberVectors = 1;
+      thread[i].type = 4;
+    }
+    coinProductRun(thread, numberThreads_, cpu_, numberCpus_);
+  }
+  delete [] thread;
+  // only blocks are used now
+  delete [] transposeStart_;
+  delete [] transposeIndex_;
+  delete [] transposeElement_;
+  transposeStart_ = NULL;
+  transposeIndex_ = NULL;
+  transposeElement_ = NULL;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixProduct::times(const double * x, double * y) const
+{
+  if (matrix_->isColOrdered())
+    timesMajor(x, y);
+  else
+    timesMinor(x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::transposeTimes(const double * x, double * y) const
+{
+  if (matrix_->isColOrdered())
+    timesMinor(x, y);
+  else
+    timesMajor(x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::timesBatch(int number, const double * x,
+				    double * y) const
+{
+  if (matrix_->isColOrdered())
+    timesMajorBatch(number, x, y);
+  else
+    timesMinorBatch(number, x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::transposeTimesBatch(int number, const double * x,
+					     double * y) const
+{
+  if (matrix_->isColOrdered())
+    timesMinorBatch(number, x, y);
+  else
+    timesMajorBatch(number, x, y);
+}
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::timesMajor(const double * x, double * y) const
+{
+  timesMajorBatch(1, x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::timesMajorBatch(int number, const double * x,
+					 double * y) const
+{
+  const int minorDim = matrix_->getMinorDim();
+  if (number > 1 && !deterministic_) {
+    // scatter has no batched form - one vector at a time
+    const int majorDim = matrix_->getMajorDim();
+    double * xOne = new double [majorDim];
+    double * yOne = new double [minorDim];
+    for (int v = 0; v < number; v++) {
+      for (int i = 0; i < majorDim; i++)
+	xOne[i] = x[static_cast<size_t>(i) * number + v];
+      timesMajorBatch(1, xOne, yOne);
+      for (int i = 0; i < minorDim; i++)
+	y[static_cast<size_t>(i) * number + v] = yOne[i];
+    }
+    delete [] xOne;
+    delete [] yOne;
+    return;
+  }
+  CoinPackedMatrixProductThread * thread =
+    new CoinPackedMatrixProductThread [numberThreads_];
+  double ** work = new double * [numberThreads_];
+  for (int i = 0; i < numberThreads_; i++) {
+    thread[i].start = matrix_->getVectorStarts();
+    thread[i].length = matrix_->getVectorLengths();
+    thread[i].index = matrix_->getIndices();
+    thread[i].element = matrix_->getElements();
+    thread[i].x = x;
+    thread[i].work = work + 1;
+    thread[i].numberWork = numberThreads_ - 1;
+    thread[i].numberClear = 0;
+    thread[i].block = NULL;
+    thread[i].numberVectors = number;
+  }
+  if (deterministic_) {
+    for (int i = 0; i < numberThreads_; i++) {
+      thread[i].start = transposeStart_;
+      thread[i].length = NULL;
+      thread[i].index = transposeIndex_;
+      thread[i].element = transposeElement_;
+      thread[i].y = y;
+      thread[i].first = minorBlock_[i];
+      thread[i].last = minorBlock_[i+1];
+      thread[i].type = 3;
+      if (block_) {
+	// own block of transposed copy indexed from 0
+	const CoinPackedMatrixProductBlock & block = block_[numberThreads_ + i];
+	thread[i].start = block.start;
+	thread[i].index = block.index;
+	thread[i].element = block.element;
+	thread[i].y = y + static_cast<size_t>(minorBlock_[i]) * number;
+	thread[i].first = 0;
+	thread[i].last = minorBlock_[i+1] - minorBlock_[i];
+      }
+    }
+    coinProductRun(thread, numberThreads_, cpu_, numberCpus_);
+  } else {
+    // each thread scatters into own vector (cleared by that thread)
+    work[0] = y;
+    for (int i = 1; i < numberThreads_; i++)
+      work[i] = block_ ? block_[i].work : work_ + (i - 1) * minorDim;
+    for (int i = 0; i < numberThreads_; i++) {
+      thread[i].y = work[i];
+      thread[i].first = majorBlock_[i];
+      thread[i].last = majorBlock_[i+1];
+      thread[i].numberClear = minorDim;
+      thread[i].type = 1;
+      if (block_) {
+	thread[i].start = block_[i].start;
+	thread[i].length = block_[i].length;
+	thread[i].index = block_[i].index;
+	thread[i].element = block_[i].element;
+	thread[i].x = x + majorBlock_[i];
+	thread[i].first = 0;
+	thread[i].last = majorBlock_[i+1] - majorBlock_[i];
+      }
+    }
+    coinProductRun(thread, numberThreads_, cpu_, numberCpus_);
+    if (numberThreads_ > 1) {
+      for (int i = 0; i < numberThreads_; i++) {
+	thread[i].y = y;
+	thread[i].first = minorBlock_[i];
+	thread[i].last = minorBlock_[i+1];
+	thread[i].type = 2;
+      }
+      coinProductRun(thread, numberThreads_, cpu_, numberCpus_);
+    }
+  }
+  delete [] work;
+  delete [] thread;
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::timesMinor(const double * x, double * y) const
+{
+  timesMinorBatch(1, x, y);
+}
+
+//-----------------------------------------------------------------------------
+
+void
+CoinPackedMatrixProduct::timesMinorBatch(int number, const double * x,
+					 double * y) const
+{
+  CoinPackedMatrixProductThread * thread =
+    new CoinPackedMatrixProductThread [numberThreads_];
+  for (int i = 0; i < numberThreads_; i++) {
+    thread[i].start = matrix_->getVectorStarts();
+    thread[i].length = matrix_->getVectorLengths();
+    thread[i].index = matrix_->getIndices();
+    thread[i].element = matrix_->getElements();
+    thread[i].x = x;
+    thread[i].y = y;
+    thread[i].work = NULL;
+    thread[i].numberWork = 0;
+    thread[i].numberClear = 0;
+    thread[i].block = NULL;
+    thread[i].numberVectors = number;
+    thread[i].first = majorBlock_[i];
+    thread[i].last = majorBlock_[i+1];
+    thread[i].type = 0;
+    if (block_) {
+      // own block indexed from 0
+      thread[i].start = block_[i].start;
+      thread[i].length = block_[i].length;
+      thread[i].index = block_[i].index;
+      thread[i].element = block_[i].element;
+      thread[i].y = y + static_cast<size_t>(majorBlock_[i]) * number;
+      thread[i].first = 0;
+      thread[i].last = majorBlock_[i+1] - majorBlock_[i];
+    }
+  }
+  coinProductRun(thread, numberThreads_, cpu_, numberCpus_);
+  delete [] thread;
+}
@@ -0,0 +1,180 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixProduct_H
+#define CoinPackedMatrixProduct_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Threaded matrix times vector for a CoinPackedMatrix
+
+    Keeps a pointer to a matrix and does the same products as
+    CoinPackedMatrix::times and CoinPackedMatrix::transposeTimes, but
+    splits the work over several threads (if built with
+    COINUTILS_PTHREADS).  Major vectors are partitioned into contiguous
+    blocks with about the same number of nonzeros.
+
+    Products which gather along major vectors (timesMinor) are trivially
+    parallel.  Products which scatter along major vectors (timesMajor) have
+    write conflicts; by default each thread accumulates into its own work
+    vector and these are summed at the end.  If deterministic is set then
+    a transposed copy of the matrix is made once and the scatter is done as
+    a gather over that, in the same order as the serial code, so results
+    are bit for bit the same as CoinPackedMatrix whatever the number of
+    threads.
+
+    The matrix is not copied - if it is modified then refresh() must be
+    called before the next product.
+
+    On a machine with several memory nodes a page is placed on the node of
+    the thread which first writes it, so the arrays of a matrix built by
+    one thread all sit on one node and threads on other sockets read them
+    across the interconnect.  With placePartitioned each thread gets its
+    own copy of its block of the matrix (and its own work vector), made by
+    that thread, so it is local to where the thread runs.  For that to
+    hold threads must stay put - setThreadCpus binds each thread to a cpu
+    (where the system allows).  This costs one extra copy of the matrix;
+    when deterministic the transposed copy is then kept only in blocks.
+*/
+struct CoinPackedMatrixProductBlock;
+
+class CoinPackedMatrixProduct {
+public:
+  /// Where the arrays used by the threads live
+  enum Placement {
+    /// Threads use the arrays of the matrix
+    placeShared = 0,
+    /// Each thread makes and uses its own copy of its block
+    placePartitioned = 1
+  };
+
+  /**@name Products */
+  //@{
+  /** Return <code>A * x</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>numColumns()</code>
+      @pre <code>y</code> must be of size <code>numRows()</code> */
+  void times(const double * x, double * y) const;
+  /** Return <code>x * A</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>numRows()</code>
+      @pre <code>y</code> must be of size <code>numColumns()</code> */
+  void transposeTimes(const double * x, double * y) const;
+  /// As CoinPackedMatrix::timesMajor
+  void timesMajor(const double * x, double * y) const;
+  /// As CoinPackedMatrix::timesMinor
+  void timesMinor(const double * x, double * y) const;
+  //@}
+
+  /**@name Batched products
+
+     Products with \p number vectors at once, for methods which spend
+     their time in repeated products with several vectors.  Vectors are
+     interleaved: entry i of vector v is at <code>x[i*number+v]</code>
+     (and the same for y), so each element of the matrix is read once and
+     used for all vectors.  Each vector gets the same result as a product
+     on its own.  Products which scatter (timesMajor) are only batched if
+     deterministic - there the transposed copy is gathered over, so the
+     matrix is held in both orderings; otherwise they are done one vector
+     at a time. */
+  //@{
+  /// <code>A * X</code> (see times)
+  void timesBatch(int number, const double * x, double * y) const;
+  /// <code>X * A</code> (see transposeTimes)
+  void transposeTimesBatch(int number, const double * x, double * y) const;
+  /// As timesMajor for \p number vectors
+  void timesMajorBatch(int number, const double * x, double * y) const;
+  /// As timesMinor for \p number vectors
+  void timesMinorBatch(int number, const double * x, double * y) const;
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Matrix used
+  inline const CoinPackedMatrix * matrix() const
+  { return matrix_;}
+  /// Number of threads
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (1 if not built with threads)
+  void setNumberThreads(int value);
+  /// Whether results are same as serial
+  inline bool deterministic() const
+  { return deterministic_;}
+  /// Set whether results must be same as serial
+  void setDeterministic(bool yesNo);
+  /// Placement of arrays
+  inline Placement placement() const
+  { return placement_;}
+  /// Set placement of arrays (placePartitioned is copied by the threads)
+  void setPlacement(Placement value);
+  /** Bind thread i (for i > 0) to cpu[i] (cpu[0] is ignored as block 0 is
+      done by the calling thread).  NULL to unbind.  The array should have
+      numberThreads() entries, and is used only where affinity can be set */
+  void setThreadCpus(const int * cpu);
+  /// Redo partitions (and transpose) after matrix has been modified
+  void refresh();
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixProduct();
+  /// Constructor from matrix (which must stay in existence)
+  CoinPackedMatrixProduct(const CoinPackedMatrix & matrix,
+			  int numberThreads=1, bool deterministic=false);
+  /// Copy constructor
+  CoinPackedMatrixProduct(const CoinPackedMatrixProduct & rhs);
+  /// Assignment
+  CoinPackedMatrixProduct & operator=(const CoinPackedMatrixProduct & rhs);
+  /// Destructor
+  ~CoinPackedMatrixProduct();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixProduct & rhs);
+  /// Splits 0 to number into numberThreads_ blocks of about equal work
+  void partition(int number, const CoinBigIndex * start,
+		 const int * length, int * which) const;
+  /// Makes block_ - each thread copies its own block
+  void place();
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Matrix
+  const CoinPackedMatrix * matrix_;
+  /// Major vectors for each thread (numberThreads_+1)
+  int * majorBlock_;
+  /// Minor vectors for each thread (numberThreads_+1)
+  int * minorBlock_;
+  /// Start of each minor vector in transposed copy
+  CoinBigIndex * transposeStart_;
+  /// Major index in transposed copy (descending in each minor vector)
+  int * transposeIndex_;
+  /// Elements in transposed copy
+  double * transposeElement_;
+  /// Work vectors for threads other than first
+  mutable double * work_;
+  /** Arrays of each thread if placePartitioned (major blocks then blocks
+      of transposed copy) */
+  CoinPackedMatrixProductBlock * block_;
+  /// Cpu of each thread (NULL if not bound)
+  int * cpu_;
+  /// Number of threads
+  int numberThreads_;
+  /// Number of entries in cpu_
+  int numberCpus_;
+  /// Whether results are same as serial
+  bool deterministic_;
+  /// Placement of arrays
+  Placement placement_;
+  //@}
+};
+
+#endif
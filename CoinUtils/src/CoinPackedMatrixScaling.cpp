@@ -0,0 +1,378 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cmath>
+#include <cfloat>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrixScaling.hpp"
+#include "CoinThreadPool.hpp"
+
+//#############################################################################
+// Work for one thread
+typedef struct {
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  const double * otherScale;
+  double * scale;
+  // largest distance of largest element from one (ruiz)
+  double distance;
+  int first;
+  int last;
+  // 0 - geometric, 1 - largest, 2 - ruiz
+  int type;
+} CoinPackedMatrixScalingThread;
+
+static void *
+coinScalingWorker(void * info)
+{
+  CoinPackedMatrixScalingThread * thread =
+    reinterpret_cast<CoinPackedMatrixScalingThread *>(info);
+  const CoinBigIndex * start = thread->start;
+  const int * length = thread->length;
+  const int * COIN_RESTRICT index = thread->index;
+  const double * COIN_RESTRICT element = thread->element;
+  const double * COIN_RESTRICT otherScale = thread->otherScale;
+  double * COIN_RESTRICT scale = thread->scale;
+  const int type = thread->type;
+  double distance = 0.0;
+  for (int i = thread->first; i < thread->last; i++) {
+    double largest = 0.0;
+    double smallest = COIN_DBL_MAX;
+    const CoinBigIndex end = start[i] + length[i];
+    for (CoinBigIndex j = start[i]; j < end; j++) {
+      const double value = fabs(element[j]) * otherScale[index[j]];
+      if (value) {
+	largest = CoinMax(largest, value);
+	smallest = CoinMin(smallest, value);
+      }
+    }
+    if (!largest) {
+      // empty vector
+      if (type != 2)
+	scale[i] = 1.0;
+      continue;
+    }
+    if (type == 0) {
+      scale[i] = 1.0 / sqrt(smallest * largest);
+    } else if (type == 1) {
+      scale[i] = 1.0 / largest;
+    } else {
+      largest *= scale[i];
+      distance = CoinMax(distance, fabs(largest - 1.0));
+      scale[i] /= sqrt(largest);
+    }
+  }
+  thread->distance = distance;
+  return NULL;
+}
+// Runs all threads - first one in this thread
+static void
+coinScalingRun(CoinPackedMatrixScalingThread * thread, int numberThreads)
+{
+  CoinThreadPool::run(coinScalingWorker, thread,
+		      sizeof(CoinPackedMatrixScalingThread), numberThreads);
+}
+// Nearest power of two (in ratio)
+static inline double
+coinScalingPowerOfTwo(double value)
+{
+  int exponent;
+  const double fraction = frexp(value, &exponent);
+  // value is fraction * 2^exponent with fraction in [0.5,1)
+  return ldexp(1.0, fraction >= 0.7071067811865476 ? exponent : exponent - 1);
+}
+
+//#############################################################################
+
+CoinPackedMatrixScaling::CoinPackedMatrixScaling(Method method) :
+  rowScale_(NULL),
+  columnScale_(NULL),
+  ratioBefore_(0.0),
+  ratioAfter_(0.0),
+  tolerance_(1.0e-2),
+  numberRows_(0),
+  numberColumns_(0),
+  numberPasses_(method == ruiz ? 20 : 4),
+  passesDone_(0),
+  numberThreads_(1),
+  method_(method),
+  powerOfTwo_(true)
+{
+}
+
+CoinPackedMatrixScaling::CoinPackedMatrixScaling(const CoinPackedMatrixScaling & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixScaling &
+CoinPackedMatrixScaling::operator=(const CoinPackedMatrixScaling & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixScaling::~CoinPackedMatrixScaling()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixScaling::gutsOfDelete()
+{
+  delete [] rowScale_;
+  delete [] columnScale_;
+  rowScale_ = NULL;
+  columnScale_ = NULL;
+}
+
+void
+CoinPackedMatrixScaling::gutsOfCopy(const CoinPackedMatrixScaling & rhs)
+{
+  ratioBefore_ = rhs.ratioBefore_;
+  ratioAfter_ = rhs.ratioAfter_;
+  tolerance_ = rhs.tolerance_;
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  numberPasses_ = rhs.numberPasses_;
+  passesDone_ = rhs.passesDone_;
+  numberThreads_ = rhs.numberThreads_;
+  method_ = rhs.method_;
+  powerOfTwo_ = rhs.powerOfTwo_;
+  rowScale_ = CoinCopyOfArray(rhs.rowScale_, numberRows_);
+  columnScale_ = CoinCopyOfArray(rhs.columnScale_, numberColumns_);
+}
+
+void
+CoinPackedMatrixScaling::setNumberPasses(int value)
+{
+  numberPasses_ = CoinMax(value, 1);
+}
+
+void
+CoinPackedMatrixScaling::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value, 1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
+
+//#############################################################################
+
+double
+CoinPackedMatrixScaling::pass(const CoinPackedMatrix & matrix, int type,
+			      const double * otherScale, double * scale) const
+{
+  const int number = matrix.getMajorDim();
+  // threads only worth it if plenty of vectors each
+  const int numberThreads = CoinMax(1, CoinMin(numberThreads_, number / 1000));
+  CoinPackedMatrixScalingThread * thread =
+    new CoinPackedMatrixScalingThread [numberThreads];
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i].start = matrix.getVectorStarts();
+    thread[i].length = matrix.getVectorLengths();
+    thread[i].index = matrix.getIndices();
+    thread[i].element = matrix.getElements();
+    thread[i].otherScale = otherScale;
+    thread[i].scale = scale;
+    thread[i].distance = 0.0;
+    thread[i].first = static_cast<int>((static_cast<double>(number) * i)
+				       / numberThreads);
+    thread[i].last = static_cast<int>((static_cast<double>(number) * (i+1))
+				      / numberThreads);
+    thread[i].type = type;
+  }
+  thread[numberThreads-1].last = number;
+  coinScalingRun(thread, numberThreads);
+  double distance = 0.0;
+  for (int i = 0; i < numberThreads; i++)
+    distance = CoinMax(distance, thread[i].distance);
+  delete [] thread;
+  return distance;
+}
+
+double
+CoinPackedMatrixScaling::ratio(const CoinPackedMatrix & matrix,
+			       const double * majorScale,
+			       const double * minorScale) const
+{
+  const CoinBigIndex * start = matrix.getVectorStarts();
+  const int * length = matrix.getVectorLengths();
+  const int * index = matrix.getIndices();
+  const double * element = matrix.getElements();
+  double largest = 0.0;
+  double smallest = COIN_DBL_MAX;
+  for (int i = 0; i < matrix.getMajorDim(); i++) {
+    const double scale = majorScale ? majorScale[i] : 1.0;
+    const CoinBigIndex end = start[i] + length[i];
+    for (CoinBigIndex j = start[i]; j < end; j++) {
+      double value = fabs(element[j]) * scale;
+      if (minorScale)
+	value *= minorScale[index[j]];
+      if (value) {
+	largest = CoinMax(largest, value);
+	smallest = CoinMin(smallest, value);
+      }
+    }
+  }
+  return largest ? largest / smallest : 1.0;
+}
+
+void
+CoinPackedMatrixScaling::findScales(const CoinPackedMatrix & matrix)
+{
+  if (matrix.getTail()) {
+    // block append tail - look at merged copy
+    CoinPackedMatrix copy(matrix);
+    findScales(copy);
+    return;
+  }
+  gutsOfDelete();
+  numberRows_ = matrix.getNumRows();
+  numberColumns_ = matrix.getNumCols();
+  passesDone_ = 0;
+  rowScale_ = new double [numberRows_];
+  columnScale_ = new double [numberColumns_];
+  CoinFillN(rowScale_, numberRows_, 1.0);
+  CoinFillN(columnScale_, numberColumns_, 1.0);
+  // row and column ordered copies
+  CoinPackedMatrix reverse;
+  const CoinPackedMatrix * other = matrix.getReverseOrderedCopy();
+  if (!other) {
+    reverse.reverseOrderedCopyOf(matrix);
+    other = &reverse;
+  }
+  const CoinPackedMatrix * rowCopy = matrix.isColOrdered() ? other : &matrix;
+  const CoinPackedMatrix * columnCopy = matrix.isColOrdered() ? &matrix : other;
+  ratioBefore_ = ratio(*columnCopy, NULL, NULL);
+  switch (method_) {
+  case geometric:
+    for (int iPass = 0; iPass < numberPasses_; iPass++) {
+      pass(*rowCopy, 0, columnScale_, rowScale_);
+      pass(*columnCopy, 0, rowScale_, columnScale_);
+      passesDone_++;
+    }
+    break;
+  case equilibrium:
+    pass(*rowCopy, 1, columnScale_, rowScale_);
+    pass(*columnCopy, 1, rowScale_, columnScale_);
+    passesDone_ = 1;
+    break;
+  case ruiz:
+    for (int iPass = 0; iPass < numberPasses_; iPass++) {
+      double distance = pass(*rowCopy, 2, columnScale_, rowScale_);
+      distance = CoinMax(distance,
+			 pass(*columnCopy, 2, rowScale_, columnScale_));
+      passesDone_++;
+      if (distance <= tolerance_)
+	break;
+    }
+    break;
+  }
+  if (powerOfTwo_) {
+    for (int i = 0; i < numberRows_; i++)
+      rowScale_[i] = coinScalingPowerOfTwo(rowScale_[i]);
+    for (int i = 0; i < numberColumns_; i++)
+      columnScale_[i] = coinScalingPowerOfTwo(columnScale_[i]);
+  }
+  ratioAfter_ = ratio(*columnCopy, columnScale_, rowScale_);
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixScaling::applyScales(CoinPackedMatrix & matrix,
+				     bool inverse) const
+{
+  if (matrix.getNumRows() != numberRows_ ||
+      matrix.getNumCols() != numberColumns_)
+    throw CoinError("matrix does not match scales",
+		    inverse ? "unscale" : "scale", "CoinPackedMatrixScaling");
+  if (matrix.getTail())
+    matrix.compactTail();
+  // reverse copy would not see changes to elements
+  const bool dual = matrix.dualOrientation();
+  if (dual)
+    matrix.setDualOrientation(false);
+  const double * majorScale = matrix.isColOrdered() ? columnScale_ : rowScale_;
+  const double * minorScale = matrix.isColOrdered() ? rowScale_ : columnScale_;
+  const CoinBigIndex * start = matrix.getVectorStarts();
+  const int * length = matrix.getVectorLengths();
+  const int * index = matrix.getIndices();
+  double * element = matrix.getMutableElements();
+  for (int i = 0; i < matrix.getMajorDim(); i++) {
+    const double scale = majorScale[i];
+    const CoinBigIndex end = start[i] + length[i];
+    if (inverse) {
+      for (CoinBigIndex j = start[i]; j < end; j++)
+	element[j] /= scale * minorScale[index[j]];
+    } else {
+      for (CoinBigIndex j = start[i]; j < end; j++)
+	element[j] *= scale * minorScale[index[j]];
+    }
+  }
+  if (dual)
+    matrix.setDualOrientation(true);
+}
+
+void
+CoinPackedMatrixScaling::scale(CoinPackedMatrix & matrix) const
+{
+  applyScales(matrix, false);
+}
+
+void
+CoinPackedMatrixScaling::unscale(CoinPackedMatrix & matrix) const
+{
+  applyScales(matrix, true);
+}
+
+void
+CoinPackedMatrixScaling::times(const CoinPackedMatrix & matrix,
+			       const double * x, double * y) const
+{
+  if (matrix.getNumRows() != numberRows_ ||
+      matrix.getNumCols() != numberColumns_)
+    throw CoinError("matrix does not match scales",
+		    "times", "CoinPackedMatrixScaling");
+  double * work = new double [numberColumns_];
+  for (int i = 0; i < numberColumns_; i++)
+    work[i] = columnScale_[i] * x[i];
+  matrix.times(work, y);
+  for (int i = 0; i < numberRows_; i++)
+    y[i] *= rowScale_[i];
+  delete [] work;
+}
+
+void
+CoinPackedMatrixScaling::transposeTimes(const CoinPackedMatrix & matrix,
+					const double * x, double * y) const
+{
+  if (matrix.getNumRows() != numberRows_ ||
+      matrix.getNumCols() != numberColumns_)
+    throw CoinError("matrix does not match scales",
+		    "transposeTimes", "CoinPackedMatrixScaling");
+  double * work = new double [numberRows_];
+  for (int i = 0; i < numberRows_; i++)
+    work[i] = rowScale_[i] * x[i];
+  matrix.transposeTimes(work, y);
+  for (int i = 0; i < numberColumns_; i++)
+    y[i] *= columnScale_[i];
+  delete [] work;
+}
@@ -0,0 +1,179 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixScaling_H
+#define CoinPackedMatrixScaling_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Row and column scale factors for a CoinPackedMatrix
+
+    Finds rowScale and columnScale so that the scaled matrix with elements
+    <code>rowScale[i] * a[i][j] * columnScale[j]</code> has elements close
+    to one.  Methods are
+    <ul>
+    <li> geometric - each row (then column) is scaled by
+         1/sqrt(smallest*largest), repeated numberPasses times
+    <li> equilibrium - each row (then column) is scaled so its largest
+         element is one
+    <li> ruiz - each row (then column) is scaled by 1/sqrt(largest) and this
+         is repeated until all largest elements are within tolerance of one
+         or numberPasses is reached
+    </ul>
+    Each pass is over major vectors of the matrix or of a row ordered (or
+    column ordered) copy, and the vectors are shared among threads if
+    built with COINUTILS_PTHREADS and setNumberThreads is used.
+
+    With power of two rounding (the default) each scale is rounded to the
+    nearest power of two, so scaling and unscaling are exact.
+
+    Scales may be applied in place (scale, unscale) or lazily through
+    times and transposeTimes, which leave the matrix alone.
+*/
+class CoinPackedMatrixScaling {
+public:
+  /// Scaling methods
+  enum Method {
+    geometric = 0,
+    equilibrium,
+    ruiz
+  };
+
+  /**@name Finding and using scales */
+  //@{
+  /// Finds scales for matrix (any previous scales are forgotten)
+  void findScales(const CoinPackedMatrix & matrix);
+  /** Scales matrix in place.  Throws CoinError if its dimensions do not
+      match the scales */
+  void scale(CoinPackedMatrix & matrix) const;
+  /// Undoes scale (as scale)
+  void unscale(CoinPackedMatrix & matrix) const;
+  /** Return <code>R * A * C * x</code> in <code>y</code>, where R and C
+      are the row and column scales (matrix is not scaled) */
+  void times(const CoinPackedMatrix & matrix, const double * x,
+	     double * y) const;
+  /** Return <code>x * R * A * C</code> in <code>y</code> (matrix is not
+      scaled) */
+  void transposeTimes(const CoinPackedMatrix & matrix, const double * x,
+		      double * y) const;
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Number of rows
+  inline int getNumRows() const
+  { return numberRows_;}
+  /// Number of columns
+  inline int getNumCols() const
+  { return numberColumns_;}
+  /// Row scales (one if no elements in a row)
+  inline const double * rowScale() const
+  { return rowScale_;}
+  /// Column scales (one if no elements in a column)
+  inline const double * columnScale() const
+  { return columnScale_;}
+  /// Largest over smallest absolute element before scaling
+  inline double ratioBefore() const
+  { return ratioBefore_;}
+  /// Largest over smallest absolute element after scaling
+  inline double ratioAfter() const
+  { return ratioAfter_;}
+  /// Number of passes done by last findScales
+  inline int passesDone() const
+  { return passesDone_;}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Method
+  inline Method method() const
+  { return method_;}
+  /// Set method
+  inline void setMethod(Method value)
+  { method_ = value;}
+  /// Most passes (geometric and ruiz)
+  inline int numberPasses() const
+  { return numberPasses_;}
+  /// Set most passes (at least one)
+  void setNumberPasses(int value);
+  /// Tolerance on largest elements for ruiz
+  inline double tolerance() const
+  { return tolerance_;}
+  /// Set tolerance on largest elements for ruiz
+  inline void setTolerance(double value)
+  { tolerance_ = value;}
+  /// True if scales are rounded to powers of two
+  inline bool powerOfTwo() const
+  { return powerOfTwo_;}
+  /// Set whether scales are rounded to powers of two
+  inline void setPowerOfTwo(bool yesNo)
+  { powerOfTwo_ = yesNo;}
+  /// Number of threads
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (1 if not built with threads)
+  void setNumberThreads(int value);
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixScaling(Method method = geometric);
+  /// Copy constructor
+  CoinPackedMatrixScaling(const CoinPackedMatrixScaling & rhs);
+  /// Assignment
+  CoinPackedMatrixScaling & operator=(const CoinPackedMatrixScaling & rhs);
+  /// Destructor
+  ~CoinPackedMatrixScaling();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixScaling & rhs);
+  /** One pass over major vectors of matrix - type 0 geometric, 1 largest,
+      2 ruiz.  Returns largest distance of largest element from one (ruiz) */
+  double pass(const CoinPackedMatrix & matrix, int type,
+	      const double * otherScale, double * scale) const;
+  /// Multiplies matrix by scales (or divides if inverse)
+  void applyScales(CoinPackedMatrix & matrix, bool inverse) const;
+  /// Largest over smallest absolute scaled element
+  double ratio(const CoinPackedMatrix & matrix, const double * majorScale,
+	       const double * minorScale) const;
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Row scales
+  double * rowScale_;
+  /// Column scales
+  double * columnScale_;
+  /// Ratio before scaling
+  double ratioBefore_;
+  /// Ratio after scaling
+  double ratioAfter_;
+  /// Tolerance for ruiz
+  double tolerance_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Most passes
+  int numberPasses_;
+  /// Passes done
+  int passesDone_;
+  /// Number of threads
+  int numberThreads_;
+  /// Method
+  Method method_;
+  /// Round to powers of two
+  bool powerOfTwo_;
+  //@}
+};
+
+#endif
@@ -0,0 +1,257 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#include "CoinPackedMatrixSliced.hpp"
+
+//#############################################################################
+
+CoinPackedMatrixSliced::CoinPackedMatrixSliced() :
+  numberElements_(0),
+  sliceHeight_(8),
+  sortWindow_(256)
+{
+  Slices * both[2] = { &rows_, &columns_ };
+  for (int i = 0; i < 2; i++) {
+    Slices & slices = *both[i];
+    slices.number = 0;
+    slices.numberSlices = 0;
+    slices.permute = NULL;
+    slices.start = new CoinBigIndex [1];
+    slices.start[0] = 0;
+    slices.index = NULL;
+    slices.element = NULL;
+  }
+}
+
+CoinPackedMatrixSliced::CoinPackedMatrixSliced(const CoinPackedMatrix & matrix,
+					       int sliceHeight, int sortWindow) :
+  numberElements_(matrix.getNumElements()),
+  sliceHeight_(sliceHeight),
+  sortWindow_(sortWindow)
+{
+  if (sliceHeight < 1 || sortWindow < 1)
+    throw CoinError("bad slice height or sort window",
+		    "CoinPackedMatrixSliced", "CoinPackedMatrixSliced");
+  CoinPackedMatrix reverse;
+  reverse.reverseOrderedCopyOf(matrix);
+  if (matrix.isColOrdered()) {
+    build(rows_, reverse);
+    build(columns_, matrix);
+  } else {
+    build(rows_, matrix);
+    build(columns_, reverse);
+  }
+}
+
+CoinPackedMatrixSliced::CoinPackedMatrixSliced(const CoinPackedMatrixSliced & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixSliced &
+CoinPackedMatrixSliced::operator=(const CoinPackedMatrixSliced & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixSliced::~CoinPackedMatrixSliced()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixSliced::gutsOfDelete()
+{
+  Slices * both[2] = { &rows_, &columns_ };
+  for (int i = 0; i < 2; i++) {
+    Slices & slices = *both[i];
+    delete [] slices.permute;
+    delete [] slices.start;
+    delete [] slices.index;
+    delete [] slices.element;
+    slices.permute = NULL;
+    slices.start = NULL;
+    slices.index = NULL;
+    slices.element = NULL;
+  }
+}
+
+void
+CoinPackedMatrixSliced::gutsOfCopy(const CoinPackedMatrixSliced & rhs)
+{
+  numberElements_ = rhs.numberElements_;
+  sliceHeight_ = rhs.sliceHeight_;
+  sortWindow_ = rhs.sortWindow_;
+  Slices * both[2] = { &rows_, &columns_ };
+  const Slices * rhsBoth[2] = { &rhs.rows_, &rhs.columns_ };
+  for (int i = 0; i < 2; i++) {
+    Slices & slices = *both[i];
+    const Slices & from = *rhsBoth[i];
+    const CoinBigIndex size = from.start[from.numberSlices];
+    slices.number = from.number;
+    slices.numberSlices = from.numberSlices;
+    slices.permute = CoinCopyOfArray(from.permute, from.number);
+    slices.start = CoinCopyOfArray(from.start, from.numberSlices+1);
+    slices.index = CoinCopyOfArray(from.index, size);
+    slices.element = CoinCopyOfArray(from.element, size);
+  }
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixSliced::build(Slices & slices, const CoinPackedMatrix & matrix)
+{
+  const CoinBigIndex * start = matrix.getVectorStarts();
+  const int * length = matrix.getVectorLengths();
+  const int * index = matrix.getIndices();
+  const double * element = matrix.getElements();
+  const int number = matrix.getMajorDim();
+  const int height = sliceHeight_;
+  slices.number = number;
+  slices.numberSlices = (number + height - 1) / height;
+  slices.permute = new int [number];
+  // sort by decreasing length within each window
+  int * sortLength = new int [number];
+  for (int i = 0; i < number; i++) {
+    slices.permute[i] = i;
+    sortLength[i] = length[i];
+  }
+  if (sortWindow_ > 1) {
+    for (int first = 0; first < number; first += sortWindow_) {
+      const int last = CoinMin(first + sortWindow_, number);
+      CoinSort_2(sortLength + first, sortLength + last,
+		 slices.permute + first, CoinFirstGreater_2<int,int>());
+    }
+  }
+  // each slice is as wide as its longest vector
+  slices.start = new CoinBigIndex [slices.numberSlices+1];
+  slices.start[0] = 0;
+  for (int iSlice = 0; iSlice < slices.numberSlices; iSlice++) {
+    const int first = iSlice * height;
+    const int last = CoinMin(first + height, number);
+    int width = 0;
+    for (int i = first; i < last; i++)
+      width = CoinMax(width, sortLength[i]);
+    slices.start[iSlice+1] = slices.start[iSlice] + width * height;
+  }
+  delete [] sortLength;
+  const CoinBigIndex size = slices.start[slices.numberSlices];
+  slices.index = new int [size];
+  slices.element = new double [size];
+  for (int iSlice = 0; iSlice < slices.numberSlices; iSlice++) {
+    const CoinBigIndex base = slices.start[iSlice];
+    const int width =
+      static_cast<int>((slices.start[iSlice+1] - base) / height);
+    for (int r = 0; r < height; r++) {
+      const int position = iSlice * height + r;
+      int n = 0;
+      const int * vectorIndex = NULL;
+      const double * vectorElement = NULL;
+      if (position < number) {
+	const int iVector = slices.permute[position];
+	n = length[iVector];
+	vectorIndex = index + start[iVector];
+	vectorElement = element + start[iVector];
+      }
+      // padding repeats last index (or 0 for empty and dummy vectors)
+      const int padIndex = n ? vectorIndex[n-1] : 0;
+      for (int k = 0; k < width; k++) {
+	const CoinBigIndex put = base + k * height + r;
+	if (k < n) {
+	  slices.index[put] = vectorIndex[k];
+	  slices.element[put] = vectorElement[k];
+	} else {
+	  slices.index[put] = padIndex;
+	  slices.element[put] = 0.0;
+	}
+      }
+    }
+  }
+}
+
+void
+CoinPackedMatrixSliced::multiply(const Slices & slices, int numberVectors,
+				 int numberIn, const double * x,
+				 double * y) const
+{
+  const int height = sliceHeight_;
+  const int number = slices.number;
+  const CoinBigIndex * start = slices.start;
+  const int * COIN_RESTRICT index = slices.index;
+  const double * COIN_RESTRICT element = slices.element;
+  const int * permute = slices.permute;
+  const int numberSums = height * numberVectors;
+  double stackSums[256];
+  double * COIN_RESTRICT sums =
+    numberSums <= 256 ? stackSums : new double [numberSums];
+  for (int iSlice = 0; iSlice < slices.numberSlices; iSlice++) {
+    const CoinBigIndex base = start[iSlice];
+    const int width = static_cast<int>((start[iSlice+1] - base) / height);
+    memset(sums, 0, numberSums * sizeof(double));
+    for (int k = 0; k < width; k++) {
+      const int * COIN_RESTRICT sliceIndex = index + base + k * height;
+      const double * COIN_RESTRICT sliceElement = element + base + k * height;
+      for (int v = 0; v < numberVectors; v++) {
+	const double * COIN_RESTRICT xv = x + v * numberIn;
+	double * COIN_RESTRICT sumsV = sums + v * height;
+	// fixed length - independent sums
+	for (int r = 0; r < height; r++)
+	  sumsV[r] += sliceElement[r] * xv[sliceIndex[r]];
+      }
+    }
+    const int first = iSlice * height;
+    const int last = CoinMin(first + height, number);
+    for (int v = 0; v < numberVectors; v++) {
+      double * yv = y + v * number;
+      const double * sumsV = sums + v * height;
+      for (int i = first; i < last; i++)
+	yv[permute[i]] = sumsV[i - first];
+    }
+  }
+  if (sums != stackSums)
+    delete [] sums;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixSliced::times(const double * x, double * y) const
+{
+  multiply(rows_, 1, columns_.number, x, y);
+}
+
+void
+CoinPackedMatrixSliced::transposeTimes(const double * x, double * y) const
+{
+  multiply(columns_, 1, rows_.number, x, y);
+}
+
+void
+CoinPackedMatrixSliced::timesMultiple(int numberVectors, const double * x,
+				      double * y) const
+{
+  multiply(rows_, numberVectors, columns_.number, x, y);
+}
+
+void
+CoinPackedMatrixSliced::transposeTimesMultiple(int numberVectors,
+					       const double * x,
+					       double * y) const
+{
+  multiply(columns_, numberVectors, rows_.number, x, y);
+}
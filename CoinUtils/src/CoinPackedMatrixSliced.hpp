@@ -0,0 +1,140 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixSliced_H
+#define CoinPackedMatrixSliced_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Sliced ELLPACK (SELL-C-sigma) copy of a CoinPackedMatrix for products
+
+    The loops in CoinPackedMatrix::times are over vectors of irregular
+    length, which vector units do little with.  Here the rows (for times)
+    and the columns (for transposeTimes) are cut into slices of
+    sliceHeight vectors.  Within a window of sortWindow vectors they are
+    first sorted by decreasing length so vectors in a slice are about as
+    long as each other.  Each slice is padded to its longest vector and
+    stored element by element across the slice, so the inner loop is a
+    fixed length gather over sliceHeight independent sums.
+
+    Padding has value 0.0 and repeats the last index of its vector, so
+    results are the same as CoinPackedMatrix up to rounding (the order of
+    summation is by increasing index) as long as x is finite.
+
+    timesMultiple and transposeTimesMultiple do several products at once,
+    which reads the matrix only once for all vectors.
+
+    The copy is read only and independent of the original matrix.
+*/
+class CoinPackedMatrixSliced {
+public:
+  /**@name Products */
+  //@{
+  /** Return <code>A * x</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumCols()</code>
+      @pre <code>y</code> must be of size <code>getNumRows()</code> */
+  void times(const double * x, double * y) const;
+  /** Return <code>x * A</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumRows()</code>
+      @pre <code>y</code> must be of size <code>getNumCols()</code> */
+  void transposeTimes(const double * x, double * y) const;
+  /** numberVectors products <code>A * x</code>.  Vector k of x starts
+      at x+k*getNumCols() and its result at y+k*getNumRows() */
+  void timesMultiple(int numberVectors, const double * x, double * y) const;
+  /** numberVectors products <code>x * A</code>.  Vector k of x starts
+      at x+k*getNumRows() and its result at y+k*getNumCols() */
+  void transposeTimesMultiple(int numberVectors, const double * x,
+			      double * y) const;
+  //@}
+
+  /**@name Queries */
+  //@{
+  /// Number of rows
+  inline int getNumRows() const
+  { return rows_.number;}
+  /// Number of columns
+  inline int getNumCols() const
+  { return columns_.number;}
+  /// Number of elements (not counting padding)
+  inline CoinBigIndex getNumElements() const
+  { return numberElements_;}
+  /// Vectors in a slice
+  inline int sliceHeight() const
+  { return sliceHeight_;}
+  /// Vectors sorted together by length
+  inline int sortWindow() const
+  { return sortWindow_;}
+  /// Stored elements (with padding) in row slices
+  inline CoinBigIndex rowPaddedElements() const
+  { return rows_.start[rows_.numberSlices];}
+  /// Stored elements (with padding) in column slices
+  inline CoinBigIndex columnPaddedElements() const
+  { return columns_.start[columns_.numberSlices];}
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixSliced();
+  /** Constructor from matrix.  sliceHeight should be a multiple of the
+      number of doubles in a vector register (8 suits AVX-512) and
+      sortWindow a multiple of sliceHeight (1 for no sorting).  Throws
+      CoinError if either is less than 1 */
+  CoinPackedMatrixSliced(const CoinPackedMatrix & matrix,
+			 int sliceHeight = 8, int sortWindow = 256);
+  /// Copy constructor
+  CoinPackedMatrixSliced(const CoinPackedMatrixSliced & rhs);
+  /// Assignment
+  CoinPackedMatrixSliced & operator=(const CoinPackedMatrixSliced & rhs);
+  /// Destructor
+  ~CoinPackedMatrixSliced();
+  //@}
+
+private:
+  /// Slices for one orientation
+  struct Slices {
+    /// Number of vectors
+    int number;
+    /// Number of slices
+    int numberSlices;
+    /// Vector at each position (after sorting)
+    int * permute;
+    /// Start of each slice (numberSlices+1)
+    CoinBigIndex * start;
+    /// Indices (element k of vector r of slice s at start[s]+k*height+r)
+    int * index;
+    /// Elements (same layout as index)
+    double * element;
+  };
+
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixSliced & rhs);
+  /// Makes slices from major vectors of matrix
+  void build(Slices & slices, const CoinPackedMatrix & matrix);
+  /// Products over slices of one orientation
+  void multiply(const Slices & slices, int numberVectors, int numberIn,
+		const double * x, double * y) const;
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Slices of rows (for times)
+  Slices rows_;
+  /// Slices of columns (for transposeTimes)
+  Slices columns_;
+  /// Number of elements
+  CoinBigIndex numberElements_;
+  /// Vectors in a slice
+  int sliceHeight_;
+  /// Vectors sorted together by length
+  int sortWindow_;
+  //@}
+};
+
+#endif
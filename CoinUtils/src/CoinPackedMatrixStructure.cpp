@@ -0,0 +1,529 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinPackedMatrixStructure.hpp"
+
+//#############################################################################
+
+CoinPackedMatrixStructure::CoinPackedMatrixStructure() :
+  rowComponent_(NULL),
+  columnComponent_(NULL),
+  rowMatch_(NULL),
+  columnMatch_(NULL),
+  rowOrder_(NULL),
+  columnOrder_(NULL),
+  rowBlockStart_(NULL),
+  columnBlockStart_(NULL),
+  numberRows_(0),
+  numberColumns_(0),
+  numberComponents_(0),
+  numberMatched_(0),
+  numberBlocks_(0)
+{
+}
+
+CoinPackedMatrixStructure::CoinPackedMatrixStructure(const CoinPackedMatrixStructure & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixStructure &
+CoinPackedMatrixStructure::operator=(const CoinPackedMatrixStructure & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixStructure::~CoinPackedMatrixStructure()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixStructure::gutsOfDelete()
+{
+  delete [] rowComponent_;
+  delete [] columnComponent_;
+  delete [] rowMatch_;
+  delete [] columnMatch_;
+  delete [] rowOrder_;
+  delete [] columnOrder_;
+  delete [] rowBlockStart_;
+  delete [] columnBlockStart_;
+  rowComponent_ = NULL;
+  columnComponent_ = NULL;
+  rowMatch_ = NULL;
+  columnMatch_ = NULL;
+  rowOrder_ = NULL;
+  columnOrder_ = NULL;
+  rowBlockStart_ = NULL;
+  columnBlockStart_ = NULL;
+}
+
+void
+CoinPackedMatrixStructure::gutsOfCopy(const CoinPackedMatrixStructure & rhs)
+{
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  numberComponents_ = rhs.numberComponents_;
+  numberMatched_ = rhs.numberMatched_;
+  numberBlocks_ = rhs.numberBlocks_;
+  rowComponent_ = CoinCopyOfArray(rhs.rowComponent_, numberRows_);
+  columnComponent_ = CoinCopyOfArray(rhs.columnComponent_, numberColumns_);
+  rowMatch_ = CoinCopyOfArray(rhs.rowMatch_, numberRows_);
+  columnMatch_ = CoinCopyOfArray(rhs.columnMatch_, numberColumns_);
+  rowOrder_ = CoinCopyOfArray(rhs.rowOrder_, numberRows_);
+  columnOrder_ = CoinCopyOfArray(rhs.columnOrder_, numberColumns_);
+  rowBlockStart_ = CoinCopyOfArray(rhs.rowBlockStart_,
+				   rhs.rowBlockStart_ ? numberBlocks_+1 : 0);
+  columnBlockStart_ = CoinCopyOfArray(rhs.columnBlockStart_,
+				      rhs.columnBlockStart_ ?
+				      numberBlocks_+1 : 0);
+}
+
+void
+CoinPackedMatrixStructure::setDimensions(const CoinPackedMatrix & matrix)
+{
+  if (matrix.getNumRows() != numberRows_ ||
+      matrix.getNumCols() != numberColumns_) {
+    // old results mean nothing
+    gutsOfDelete();
+    numberRows_ = matrix.getNumRows();
+    numberColumns_ = matrix.getNumCols();
+    numberComponents_ = 0;
+    numberMatched_ = 0;
+    numberBlocks_ = 0;
+  }
+}
+
+void
+CoinPackedMatrixStructure::getCopies(const CoinPackedMatrix & matrix,
+				     CoinPackedMatrix & reverse,
+				     CoinPackedMatrix & merged,
+				     const CoinPackedMatrix *& columnCopy,
+				     const CoinPackedMatrix *& rowCopy) const
+{
+  const CoinPackedMatrix * same = &matrix;
+  const CoinPackedMatrix * other = matrix.getReverseOrderedCopy();
+  if (matrix.getTail()) {
+    // block append tail - use merged copy
+    merged = matrix;
+    same = &merged;
+    other = NULL;
+  }
+  if (!other) {
+    reverse.reverseOrderedCopyOf(*same);
+    other = &reverse;
+  }
+  columnCopy = matrix.isColOrdered() ? same : other;
+  rowCopy = matrix.isColOrdered() ? other : same;
+}
+
+//#############################################################################
+
+int
+CoinPackedMatrixStructure::findComponents(const CoinPackedMatrix & matrix,
+					  const char * ignoreRow)
+{
+  setDimensions(matrix);
+  CoinPackedMatrix reverse;
+  CoinPackedMatrix merged;
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  getCopies(matrix, reverse, merged, columnCopy, rowCopy);
+  const int * row = columnCopy->getIndices();
+  const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+  const int * columnLength = columnCopy->getVectorLengths();
+  const int * column = rowCopy->getIndices();
+  const CoinBigIndex * rowStart = rowCopy->getVectorStarts();
+  const int * rowLength = rowCopy->getVectorLengths();
+  delete [] rowComponent_;
+  delete [] columnComponent_;
+  rowComponent_ = new int [numberRows_];
+  columnComponent_ = new int [numberColumns_];
+  // -2 not yet looked at
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    rowComponent_[iRow] = (ignoreRow && ignoreRow[iRow]) ? -1 : -2;
+  CoinFillN(columnComponent_, numberColumns_, -2);
+  int * stack = new int [numberRows_];
+  numberComponents_ = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (columnComponent_[iColumn] != -2)
+      continue;
+    const int iComponent = numberComponents_;
+    int nStack = 0;
+    CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+    for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+      const int iRow = row[j];
+      if (rowComponent_[iRow] == -2) {
+	rowComponent_[iRow] = iComponent;
+	stack[nStack++] = iRow;
+      }
+    }
+    if (!nStack) {
+      // only in rows left out (or empty)
+      columnComponent_[iColumn] = -1;
+      continue;
+    }
+    numberComponents_++;
+    columnComponent_[iColumn] = iComponent;
+    while (nStack) {
+      const int iRow = stack[--nStack];
+      end = rowStart[iRow] + rowLength[iRow];
+      for (CoinBigIndex k = rowStart[iRow]; k < end; k++) {
+	const int jColumn = column[k];
+	if (columnComponent_[jColumn] != -2)
+	  continue;
+	columnComponent_[jColumn] = iComponent;
+	const CoinBigIndex jEnd = columnStart[jColumn] + columnLength[jColumn];
+	for (CoinBigIndex j = columnStart[jColumn]; j < jEnd; j++) {
+	  const int jRow = row[j];
+	  if (rowComponent_[jRow] == -2) {
+	    rowComponent_[jRow] = iComponent;
+	    stack[nStack++] = jRow;
+	  }
+	}
+      }
+    }
+  }
+  delete [] stack;
+  // empty rows
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (rowComponent_[iRow] == -2)
+      rowComponent_[iRow] = -1;
+  }
+  return numberComponents_;
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixStructure::transversal(const CoinPackedMatrix & columnCopy)
+{
+  const int * row = columnCopy.getIndices();
+  const CoinBigIndex * columnStart = columnCopy.getVectorStarts();
+  const int * columnLength = columnCopy.getVectorLengths();
+  delete [] rowMatch_;
+  delete [] columnMatch_;
+  rowMatch_ = new int [numberRows_];
+  columnMatch_ = new int [numberColumns_];
+  CoinFillN(rowMatch_, numberRows_, -1);
+  CoinFillN(columnMatch_, numberColumns_, -1);
+  numberMatched_ = 0;
+  // cheap start
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    const CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+    for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+      const int iRow = row[j];
+      if (rowMatch_[iRow] < 0) {
+	rowMatch_[iRow] = iColumn;
+	columnMatch_[iColumn] = iRow;
+	numberMatched_++;
+	break;
+      }
+    }
+  }
+  // Hopcroft-Karp phases
+  const int infinite = COIN_INT_MAX;
+  int * distance = new int [numberColumns_];
+  int * queue = new int [numberColumns_];
+  CoinBigIndex * next = new CoinBigIndex [numberColumns_];
+  int * stack = new int [numberColumns_];
+  int * stackRow = new int [numberColumns_];
+  while (numberMatched_ < CoinMin(numberRows_, numberColumns_)) {
+    // layers by breadth first search from free columns
+    int nQueue = 0;
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (columnMatch_[iColumn] < 0) {
+	distance[iColumn] = 0;
+	queue[nQueue++] = iColumn;
+      } else {
+	distance[iColumn] = infinite;
+      }
+    }
+    bool found = false;
+    for (int k = 0; k < nQueue; k++) {
+      const int iColumn = queue[k];
+      const CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+      for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+	const int jColumn = rowMatch_[row[j]];
+	if (jColumn < 0) {
+	  found = true;
+	} else if (distance[jColumn] == infinite) {
+	  distance[jColumn] = distance[iColumn] + 1;
+	  queue[nQueue++] = jColumn;
+	}
+      }
+    }
+    if (!found)
+      break;
+    // disjoint shortest augmenting paths by depth first search
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+      next[iColumn] = columnStart[iColumn];
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (columnMatch_[iColumn] >= 0 || distance[iColumn])
+	continue;
+      int nStack = 0;
+      stack[nStack++] = iColumn;
+      while (nStack) {
+	const int jColumn = stack[nStack-1];
+	if (next[jColumn] == columnStart[jColumn] + columnLength[jColumn]) {
+	  // dead end
+	  distance[jColumn] = infinite;
+	  nStack--;
+	  continue;
+	}
+	const int iRow = row[next[jColumn]++];
+	const int kColumn = rowMatch_[iRow];
+	if (kColumn < 0) {
+	  // augment along stack
+	  stackRow[nStack-1] = iRow;
+	  for (int k = 0; k < nStack; k++) {
+	    rowMatch_[stackRow[k]] = stack[k];
+	    columnMatch_[stack[k]] = stackRow[k];
+	  }
+	  numberMatched_++;
+	  break;
+	} else if (distance[kColumn] == distance[jColumn] + 1) {
+	  stackRow[nStack-1] = iRow;
+	  stack[nStack++] = kColumn;
+	}
+      }
+    }
+  }
+  delete [] stackRow;
+  delete [] stack;
+  delete [] next;
+  delete [] queue;
+  delete [] distance;
+}
+
+int
+CoinPackedMatrixStructure::findTransversal(const CoinPackedMatrix & matrix)
+{
+  setDimensions(matrix);
+  if (matrix.isColOrdered() && !matrix.getTail()) {
+    transversal(matrix);
+  } else {
+    CoinPackedMatrix columnCopy;
+    if (matrix.isColOrdered())
+      columnCopy = matrix;
+    else
+      columnCopy.reverseOrderedCopyOf(matrix);
+    transversal(columnCopy);
+  }
+  return numberMatched_;
+}
+
+//#############################################################################
+
+int
+CoinPackedMatrixStructure::findBlockTriangular(const CoinPackedMatrix & matrix)
+{
+  setDimensions(matrix);
+  CoinPackedMatrix reverse;
+  CoinPackedMatrix merged;
+  const CoinPackedMatrix * columnCopy;
+  const CoinPackedMatrix * rowCopy;
+  getCopies(matrix, reverse, merged, columnCopy, rowCopy);
+  transversal(*columnCopy);
+  const int * row = columnCopy->getIndices();
+  const CoinBigIndex * columnStart = columnCopy->getVectorStarts();
+  const int * columnLength = columnCopy->getVectorLengths();
+  const int * column = rowCopy->getIndices();
+  const CoinBigIndex * rowStart = rowCopy->getVectorStarts();
+  const int * rowLength = rowCopy->getVectorLengths();
+  // part - 0 under-determined, 1 square, 2 over-determined
+  int * columnPart = new int [numberColumns_];
+  int * rowPart = new int [numberRows_];
+  CoinFillN(columnPart, numberColumns_, 1);
+  CoinFillN(rowPart, numberRows_, 1);
+  int * queue = new int [CoinMax(numberRows_, numberColumns_)];
+  // alternating paths from unmatched columns
+  int nQueue = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (columnMatch_[iColumn] < 0) {
+      columnPart[iColumn] = 0;
+      queue[nQueue++] = iColumn;
+    }
+  }
+  for (int k = 0; k < nQueue; k++) {
+    const int iColumn = queue[k];
+    const CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+    for (CoinBigIndex j = columnStart[iColumn]; j < end; j++) {
+      const int iRow = row[j];
+      if (rowPart[iRow] == 0)
+	continue;
+      rowPart[iRow] = 0;
+      const int jColumn = rowMatch_[iRow];
+      assert (jColumn >= 0);
+      if (columnPart[jColumn]) {
+	columnPart[jColumn] = 0;
+	queue[nQueue++] = jColumn;
+      }
+    }
+  }
+  // alternating paths from unmatched rows
+  nQueue = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (rowMatch_[iRow] < 0) {
+      rowPart[iRow] = 2;
+      queue[nQueue++] = iRow;
+    }
+  }
+  for (int k = 0; k < nQueue; k++) {
+    const int iRow = queue[k];
+    const CoinBigIndex end = rowStart[iRow] + rowLength[iRow];
+    for (CoinBigIndex j = rowStart[iRow]; j < end; j++) {
+      const int iColumn = column[j];
+      if (columnPart[iColumn] == 2)
+	continue;
+      assert (columnPart[iColumn] == 1);
+      columnPart[iColumn] = 2;
+      const int jRow = columnMatch_[iColumn];
+      assert (jRow >= 0);
+      if (rowPart[jRow] != 2) {
+	rowPart[jRow] = 2;
+	queue[nQueue++] = jRow;
+      }
+    }
+  }
+  delete [] queue;
+  /* Square part - strongly connected components of graph with an arc
+     from column i to column j if the row matched to i has an element in
+     column j (Tarjan, without recursion) */
+  int * block = new int [numberColumns_];
+  int * number = new int [numberColumns_];
+  int * low = new int [numberColumns_];
+  CoinBigIndex * next = new CoinBigIndex [numberColumns_];
+  int * stack = new int [numberColumns_];
+  int * path = new int [numberColumns_];
+  char * onStack = new char [numberColumns_];
+  CoinFillN(number, numberColumns_, -1);
+  CoinFillN(block, numberColumns_, -1);
+  CoinZeroN(onStack, numberColumns_);
+  int count = 0;
+  int nStack = 0;
+  int numberFound = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (columnPart[iColumn] != 1 || number[iColumn] >= 0)
+      continue;
+    int nPath = 0;
+    path[nPath++] = iColumn;
+    number[iColumn] = low[iColumn] = count++;
+    next[iColumn] = rowStart[columnMatch_[iColumn]];
+    stack[nStack++] = iColumn;
+    onStack[iColumn] = 1;
+    while (nPath) {
+      const int jColumn = path[nPath-1];
+      const int jRow = columnMatch_[jColumn];
+      if (next[jColumn] < rowStart[jRow] + rowLength[jRow]) {
+	const int kColumn = column[next[jColumn]++];
+	if (columnPart[kColumn] != 1)
+	  continue;
+	if (number[kColumn] < 0) {
+	  number[kColumn] = low[kColumn] = count++;
+	  next[kColumn] = rowStart[columnMatch_[kColumn]];
+	  stack[nStack++] = kColumn;
+	  onStack[kColumn] = 1;
+	  path[nPath++] = kColumn;
+	} else if (onStack[kColumn]) {
+	  low[jColumn] = CoinMin(low[jColumn], number[kColumn]);
+	}
+      } else {
+	nPath--;
+	if (nPath)
+	  low[path[nPath-1]] = CoinMin(low[path[nPath-1]], low[jColumn]);
+	if (low[jColumn] == number[jColumn]) {
+	  // root of a component
+	  int kColumn;
+	  do {
+	    kColumn = stack[--nStack];
+	    onStack[kColumn] = 0;
+	    block[kColumn] = numberFound;
+	  } while (kColumn != jColumn);
+	  numberFound++;
+	}
+      }
+    }
+  }
+  delete [] onStack;
+  delete [] path;
+  delete [] stack;
+  delete [] next;
+  delete [] low;
+  delete [] number;
+  // components come out last block first
+  numberBlocks_ = numberFound;
+  delete [] rowOrder_;
+  delete [] columnOrder_;
+  delete [] rowBlockStart_;
+  delete [] columnBlockStart_;
+  rowOrder_ = new int [numberRows_];
+  columnOrder_ = new int [numberColumns_];
+  rowBlockStart_ = new int [numberBlocks_+1];
+  columnBlockStart_ = new int [numberBlocks_+1];
+  int nRow = 0;
+  int nColumn = 0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (!columnPart[iColumn])
+      columnOrder_[nColumn++] = iColumn;
+  }
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (!rowPart[iRow])
+      rowOrder_[nRow++] = iRow;
+  }
+  // counts of blocks
+  CoinZeroN(columnBlockStart_, numberBlocks_+1);
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (block[iColumn] >= 0)
+      columnBlockStart_[numberBlocks_-1-block[iColumn]]++;
+  }
+  int put = nColumn;
+  for (int iBlock = 0; iBlock <= numberBlocks_; iBlock++) {
+    const int n = columnBlockStart_[iBlock];
+    columnBlockStart_[iBlock] = put;
+    put += n;
+  }
+  const int rowOffset = nRow - nColumn;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (block[iColumn] >= 0) {
+      const int position = columnBlockStart_[numberBlocks_-1-block[iColumn]]++;
+      columnOrder_[position] = iColumn;
+      rowOrder_[position + rowOffset] = columnMatch_[iColumn];
+    }
+  }
+  // starts were moved on by one block
+  for (int iBlock = numberBlocks_; iBlock > 0; iBlock--)
+    columnBlockStart_[iBlock] = columnBlockStart_[iBlock-1];
+  columnBlockStart_[0] = nColumn;
+  for (int iBlock = 0; iBlock <= numberBlocks_; iBlock++)
+    rowBlockStart_[iBlock] = columnBlockStart_[iBlock] + rowOffset;
+  nColumn = columnBlockStart_[numberBlocks_];
+  nRow = rowBlockStart_[numberBlocks_];
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (columnPart[iColumn] == 2)
+      columnOrder_[nColumn++] = iColumn;
+  }
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (rowPart[iRow] == 2)
+      rowOrder_[nRow++] = iRow;
+  }
+  assert (nColumn == numberColumns_ && nRow == numberRows_);
+  delete [] block;
+  delete [] rowPart;
+  delete [] columnPart;
+  return numberBlocks_;
+}
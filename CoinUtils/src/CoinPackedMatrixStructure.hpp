@@ -0,0 +1,157 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixStructure_H
+#define CoinPackedMatrixStructure_H
+
+#include "CoinPackedMatrix.hpp"
+
+/** Structure of the row/column graph of a CoinPackedMatrix
+
+    <ul>
+    <li> findComponents - connected components of the bipartite graph
+         with a node for each row and column and an edge for each element.
+         Rows may be left out (e.g. linking rows of a Dantzig-Wolfe
+         master) so blocks joined only by them come out separately.
+         Components are independent problems which may be given to
+         different workers.  Time is linear in the number of elements.
+    <li> findTransversal - a maximum matching of rows to columns
+         (Hopcroft-Karp, at most sqrt(rows+columns) phases each linear).
+    <li> findBlockTriangular - Dulmage-Mendelsohn decomposition.  Rows
+         and columns are ordered with first the under-determined part
+         (more columns than rows), then the square part as blocks in
+         upper block triangular form and last the over-determined part
+         (more rows than columns).  In the square part the rows of each
+         block only have elements in that block or later ones and the
+         diagonal is the matching.  Blocks come from Tarjan's strongly
+         connected components so time is linear after the transversal.
+    </ul>
+*/
+class CoinPackedMatrixStructure {
+public:
+  /**@name Analysis */
+  //@{
+  /** Finds connected components.  Rows with ignoreRow[i] nonzero are left
+      out.  Returns number of components */
+  int findComponents(const CoinPackedMatrix & matrix,
+		     const char * ignoreRow = NULL);
+  /// Finds a maximum transversal.  Returns number of matched pairs
+  int findTransversal(const CoinPackedMatrix & matrix);
+  /** Finds Dulmage-Mendelsohn decomposition (and transversal).  Returns
+      number of blocks in the square part */
+  int findBlockTriangular(const CoinPackedMatrix & matrix);
+  //@}
+
+  /**@name Components */
+  //@{
+  /// Number of components
+  inline int numberComponents() const
+  { return numberComponents_;}
+  /** Component of each row (-1 if empty or left out).  Components are
+      numbered in order of their first column */
+  inline const int * rowComponent() const
+  { return rowComponent_;}
+  /// Component of each column (-1 if no elements in rows used)
+  inline const int * columnComponent() const
+  { return columnComponent_;}
+  //@}
+
+  /**@name Transversal */
+  //@{
+  /// Number of matched rows (and columns)
+  inline int numberMatched() const
+  { return numberMatched_;}
+  /// Column matched to each row (or -1)
+  inline const int * rowMatch() const
+  { return rowMatch_;}
+  /// Row matched to each column (or -1)
+  inline const int * columnMatch() const
+  { return columnMatch_;}
+  //@}
+
+  /**@name Block triangular form */
+  //@{
+  /// Number of blocks in square part
+  inline int numberBlocks() const
+  { return numberBlocks_;}
+  /// Rows in new order
+  inline const int * rowOrder() const
+  { return rowOrder_;}
+  /// Columns in new order
+  inline const int * columnOrder() const
+  { return columnOrder_;}
+  /** Start of each square block in rowOrder (numberBlocks()+1).  Rows
+      before the first block are the under-determined part and rows after
+      the last the over-determined part */
+  inline const int * rowBlockStart() const
+  { return rowBlockStart_;}
+  /// Start of each square block in columnOrder (numberBlocks()+1)
+  inline const int * columnBlockStart() const
+  { return columnBlockStart_;}
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixStructure();
+  /// Copy constructor
+  CoinPackedMatrixStructure(const CoinPackedMatrixStructure & rhs);
+  /// Assignment
+  CoinPackedMatrixStructure & operator=(const CoinPackedMatrixStructure & rhs);
+  /// Destructor
+  ~CoinPackedMatrixStructure();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixStructure & rhs);
+  /// Sets dimensions (and frees arrays if they change)
+  void setDimensions(const CoinPackedMatrix & matrix);
+  /** Sets column and row ordered copies (reverse and merged used if
+      needed) */
+  void getCopies(const CoinPackedMatrix & matrix, CoinPackedMatrix & reverse,
+		 CoinPackedMatrix & merged,
+		 const CoinPackedMatrix *& columnCopy,
+		 const CoinPackedMatrix *& rowCopy) const;
+  /// Maximum transversal on column ordered copy
+  void transversal(const CoinPackedMatrix & columnCopy);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Component of each row
+  int * rowComponent_;
+  /// Component of each column
+  int * columnComponent_;
+  /// Column matched to each row
+  int * rowMatch_;
+  /// Row matched to each column
+  int * columnMatch_;
+  /// Rows in new order
+  int * rowOrder_;
+  /// Columns in new order
+  int * columnOrder_;
+  /// Start of each block in rowOrder
+  int * rowBlockStart_;
+  /// Start of each block in columnOrder
+  int * columnBlockStart_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of components
+  int numberComponents_;
+  /// Number matched
+  int numberMatched_;
+  /// Number of square blocks
+  int numberBlocks_;
+  //@}
+};
+
+#endif
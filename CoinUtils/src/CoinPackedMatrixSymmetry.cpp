@@ -0,0 +1,571 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSnapshot.hpp"
+#include "CoinPackedMatrixSymmetry.hpp"
+
+//#############################################################################
+// Mixes 64 bits (splitmix64 finalizer)
+static inline CoinUInt64
+coinSymmetryMix(CoinUInt64 value)
+{
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+namespace {
+/* Coloured graph and ordered partition of its nodes (columns then rows).
+   Cells are ranges of lab, known by their first position.  Splits are
+   kept on a trail so a partition can go back to an earlier one. */
+class CoinSymmetryGraph {
+public:
+  // Graph
+  int numberNodes;
+  std::vector<CoinBigIndex> start;
+  std::vector<int> adjacent;
+  // colour of each edge (number and mixed for signatures)
+  std::vector<int> edgeColour;
+  std::vector<CoinUInt64> edgeMix;
+  // Partition
+  std::vector<int> lab;
+  std::vector<int> pos;
+  std::vector<int> cellOf;
+  std::vector<int> cellSize;
+  int numberCells;
+  std::vector<int> trail;
+  // Work for refinement
+  std::vector<int> queue;
+  std::vector<char> inQueue;
+  std::vector<CoinUInt64> signature;
+  std::vector<char> mark;
+  std::vector<int> touched;
+  std::vector<int> cells;
+  std::vector<int> cellTouched;
+  std::vector<int> pieces;
+  std::vector<std::pair<CoinUInt64, int> > sortCell;
+
+  void pushCell(int iCell)
+  {
+    if (!inQueue[iCell]) {
+      inQueue[iCell] = 1;
+      queue.push_back(iCell);
+    }
+  }
+  /* Splits cell by signatures in order of signature.  The last
+     numberTouched nodes of the cell are those touched by the splitter;
+     the rest have signature zero so come first */
+  void splitCell(int iCell, int numberTouched)
+  {
+    const int size = cellSize[iCell];
+    const int firstTouched = iCell + size - numberTouched;
+    sortCell.clear();
+    for (int i = firstTouched; i < iCell + size; i++)
+      sortCell.push_back(std::make_pair(signature[lab[i]], lab[i]));
+    std::sort(sortCell.begin(), sortCell.end());
+    for (int i = 0; i < numberTouched; i++) {
+      lab[firstTouched+i] = sortCell[i].second;
+      pos[sortCell[i].second] = firstTouched + i;
+    }
+    // pieces - any signatures of zero go with nodes not touched
+    pieces.clear();
+    int i = 0;
+    while (i < numberTouched && !sortCell[i].first)
+      i++;
+    if (firstTouched + i > iCell)
+      pieces.push_back(iCell);
+    for (; i < numberTouched; i++) {
+      if (!i || sortCell[i].first != sortCell[i-1].first)
+	pieces.push_back(firstTouched + i);
+    }
+    const int numberPieces = static_cast<int>(pieces.size());
+    if (numberPieces == 1)
+      return;
+    pieces.push_back(iCell + size);
+    // first largest piece need not be a splitter if cell was not one
+    const bool wasQueued = inQueue[iCell] != 0;
+    int largest = 0;
+    for (int k = 1; k < numberPieces; k++) {
+      if (pieces[k+1] - pieces[k] > pieces[largest+1] - pieces[largest])
+	largest = k;
+    }
+    for (int k = 0; k < numberPieces; k++) {
+      const int newCell = pieces[k];
+      cellSize[newCell] = pieces[k+1] - newCell;
+      if (newCell != iCell) {
+	for (int j = newCell; j < pieces[k+1]; j++)
+	  cellOf[lab[j]] = newCell;
+	trail.push_back(newCell);
+	numberCells++;
+      }
+      if (wasQueued || k != largest)
+	pushCell(newCell);
+    }
+  }
+  // Refines until equitable
+  void refine()
+  {
+    size_t next = 0;
+    while (next < queue.size()) {
+      const int splitter = queue[next++];
+      inQueue[splitter] = 0;
+      touched.clear();
+      for (int i = splitter; i < splitter + cellSize[splitter]; i++) {
+	const int node = lab[i];
+	for (CoinBigIndex j = start[node]; j < start[node+1]; j++) {
+	  const int other = adjacent[j];
+	  if (!mark[other]) {
+	    mark[other] = 1;
+	    touched.push_back(other);
+	  }
+	  signature[other] += edgeMix[j];
+	}
+      }
+      // move touched nodes to end of their cells
+      cells.clear();
+      for (size_t k = 0; k < touched.size(); k++) {
+	const int node = touched[k];
+	const int iCell = cellOf[node];
+	if (cellSize[iCell] == 1)
+	  continue;
+	if (!cellTouched[iCell])
+	  cells.push_back(iCell);
+	const int put = iCell + cellSize[iCell] - 1 - cellTouched[iCell];
+	const int other = lab[put];
+	lab[pos[node]] = other;
+	pos[other] = pos[node];
+	lab[put] = node;
+	pos[node] = put;
+	cellTouched[iCell]++;
+      }
+      // split in order of position
+      std::sort(cells.begin(), cells.end());
+      for (size_t k = 0; k < cells.size(); k++) {
+	splitCell(cells[k], cellTouched[cells[k]]);
+	cellTouched[cells[k]] = 0;
+      }
+      for (size_t k = 0; k < touched.size(); k++) {
+	signature[touched[k]] = 0;
+	mark[touched[k]] = 0;
+      }
+    }
+    queue.clear();
+  }
+  // Makes node a cell of its own and refines
+  void individualize(int node)
+  {
+    const int iCell = cellOf[node];
+    const int size = cellSize[iCell];
+    const int other = lab[iCell];
+    lab[pos[node]] = other;
+    pos[other] = pos[node];
+    lab[iCell] = node;
+    pos[node] = iCell;
+    cellSize[iCell] = 1;
+    cellSize[iCell+1] = size - 1;
+    for (int i = iCell + 1; i < iCell + size; i++)
+      cellOf[lab[i]] = iCell + 1;
+    trail.push_back(iCell + 1);
+    numberCells++;
+    pushCell(iCell);
+    refine();
+  }
+  // Goes back to partition when trail had mark entries
+  void undo(int markTrail)
+  {
+    while (static_cast<int>(trail.size()) > markTrail) {
+      const int iCell = trail.back();
+      trail.pop_back();
+      const int previous = cellOf[lab[iCell-1]];
+      for (int i = iCell; i < iCell + cellSize[iCell]; i++)
+	cellOf[lab[i]] = previous;
+      cellSize[previous] += cellSize[iCell];
+      numberCells--;
+    }
+  }
+  // First cell with more than one node (-1 if none)
+  int target() const
+  {
+    int i = 0;
+    while (i < numberNodes) {
+      if (cellSize[i] > 1)
+	return i;
+      i += cellSize[i];
+    }
+    return -1;
+  }
+  // True if perm (of all nodes) maps columns' edges to edges
+  bool isAutomorphism(const int * perm, int numberColumns,
+		      std::vector<int> & colourOf) const
+  {
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      const int image = perm[iColumn];
+      if (start[image+1] - start[image] != start[iColumn+1] - start[iColumn])
+	return false;
+      for (CoinBigIndex j = start[image]; j < start[image+1]; j++)
+	colourOf[adjacent[j]] = edgeColour[j] + 1;
+      bool good = true;
+      for (CoinBigIndex j = start[iColumn]; j < start[iColumn+1]; j++) {
+	if (colourOf[perm[adjacent[j]]] != edgeColour[j] + 1) {
+	  good = false;
+	  break;
+	}
+      }
+      for (CoinBigIndex j = start[image]; j < start[image+1]; j++)
+	colourOf[adjacent[j]] = 0;
+      if (!good)
+	return false;
+    }
+    return true;
+  }
+};
+
+// Colour of a node - type (column 0, row 1) then data
+typedef struct {
+  int type;
+  double value[3];
+  int integer;
+} CoinSymmetryColour;
+
+bool
+coinSymmetryLess(const CoinSymmetryColour & a, const CoinSymmetryColour & b)
+{
+  if (a.type != b.type)
+    return a.type < b.type;
+  for (int i = 0; i < 3; i++) {
+    if (a.value[i] != b.value[i])
+      return a.value[i] < b.value[i];
+  }
+  return a.integer < b.integer;
+}
+
+// Sorts nodes by colour
+class CoinSymmetryCompare {
+public:
+  explicit CoinSymmetryCompare(const std::vector<CoinSymmetryColour> & colour)
+    : colour_(colour) {}
+  bool operator()(int a, int b) const
+  { return coinSymmetryLess(colour_[a], colour_[b]);}
+private:
+  const std::vector<CoinSymmetryColour> & colour_;
+};
+
+int
+coinSymmetryFind(std::vector<int> & parent, int node)
+{
+  while (parent[node] != node) {
+    parent[node] = parent[parent[node]];
+    node = parent[node];
+  }
+  return node;
+}
+} // end of anonymous namespace
+
+//#############################################################################
+
+CoinPackedMatrixSymmetry::CoinPackedMatrixSymmetry() :
+  numberColumns_(0),
+  maximumNodes_(100000),
+  numberNodes_(0),
+  complete_(true)
+{
+  generatorStart_.assign(1, 0);
+  orbitStart_.assign(1, 0);
+}
+
+int
+CoinPackedMatrixSymmetry::find(const CoinSnapshot & snapshot)
+{
+  const CoinPackedMatrix * matrix = snapshot.getMatrixByCol();
+  if (!matrix)
+    matrix = snapshot.getMatrixByRow();
+  assert (matrix);
+  return find(*matrix, snapshot.getColLower(), snapshot.getColUpper(),
+	      snapshot.getObjCoefficients(), snapshot.getColType(),
+	      snapshot.getRowLower(), snapshot.getRowUpper());
+}
+
+int
+CoinPackedMatrixSymmetry::find(const CoinPackedMatrix & matrix,
+			       const double * columnLower,
+			       const double * columnUpper,
+			       const double * objective,
+			       const char * integerType,
+			       const double * rowLower, const double * rowUpper)
+{
+  CoinPackedMatrix columnCopy;
+  const CoinPackedMatrix * byColumn = &matrix;
+  if (!matrix.isColOrdered()) {
+    columnCopy.reverseOrderedCopyOf(matrix);
+    byColumn = &columnCopy;
+  }
+  const int numberColumns = byColumn->getMajorDim();
+  const int numberRows = byColumn->getMinorDim();
+  const CoinBigIndex * columnStart = byColumn->getVectorStarts();
+  const int * columnLength = byColumn->getVectorLengths();
+  const int * row = byColumn->getIndices();
+  const double * element = byColumn->getElements();
+  numberColumns_ = numberColumns;
+  generatorStart_.assign(1, 0);
+  generatorColumn_.clear();
+  generatorImage_.clear();
+  numberNodes_ = 0;
+  complete_ = true;
+  // graph - edge colours are numbers of distinct values
+  CoinSymmetryGraph graph;
+  const int numberNodes = numberColumns + numberRows;
+  graph.numberNodes = numberNodes;
+  std::vector<double> values;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    for (CoinBigIndex j = columnStart[iColumn];
+	 j < columnStart[iColumn] + columnLength[iColumn]; j++)
+      values.push_back(element[j] ? element[j] : 0.0);
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  graph.start.assign(numberNodes + 1, 0);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    graph.start[iColumn+1] = columnLength[iColumn];
+    for (CoinBigIndex j = columnStart[iColumn];
+	 j < columnStart[iColumn] + columnLength[iColumn]; j++)
+      graph.start[numberColumns+row[j]+1]++;
+  }
+  for (int i = 0; i < numberNodes; i++)
+    graph.start[i+1] += graph.start[i];
+  const CoinBigIndex numberEdges = graph.start[numberNodes];
+  graph.adjacent.resize(numberEdges);
+  graph.edgeColour.resize(numberEdges);
+  graph.edgeMix.resize(numberEdges);
+  std::vector<CoinBigIndex> put(graph.start.begin(), graph.start.end() - 1);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    for (CoinBigIndex j = columnStart[iColumn];
+	 j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      const double value = element[j] ? element[j] : 0.0;
+      const int colour = static_cast<int>(
+	std::lower_bound(values.begin(), values.end(), value) -
+	values.begin());
+      const int iRow = numberColumns + row[j];
+      const CoinUInt64 mixed =
+	coinSymmetryMix(static_cast<CoinUInt64>(colour) + 1);
+      CoinBigIndex k = put[iColumn]++;
+      graph.adjacent[k] = iRow;
+      graph.edgeColour[k] = colour;
+      graph.edgeMix[k] = mixed;
+      k = put[iRow]++;
+      graph.adjacent[k] = iColumn;
+      graph.edgeColour[k] = colour;
+      graph.edgeMix[k] = mixed;
+    }
+  }
+  // first partition by colours of nodes
+  std::vector<CoinSymmetryColour> colour(numberNodes);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    CoinSymmetryColour & thisColour = colour[iColumn];
+    thisColour.type = 0;
+    thisColour.value[0] = objective ? objective[iColumn] : 0.0;
+    thisColour.value[1] = columnLower[iColumn];
+    thisColour.value[2] = columnUpper[iColumn];
+    thisColour.integer = integerType ? integerType[iColumn] : 0;
+  }
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    CoinSymmetryColour & thisColour = colour[numberColumns+iRow];
+    thisColour.type = 1;
+    thisColour.value[0] = rowLower[iRow];
+    thisColour.value[1] = rowUpper[iRow];
+    thisColour.value[2] = 0.0;
+    thisColour.integer = 0;
+  }
+  graph.lab.resize(numberNodes);
+  for (int i = 0; i < numberNodes; i++)
+    graph.lab[i] = i;
+  std::stable_sort(graph.lab.begin(), graph.lab.end(),
+		   CoinSymmetryCompare(colour));
+  graph.pos.resize(numberNodes);
+  graph.cellOf.resize(numberNodes);
+  graph.cellSize.assign(numberNodes, 0);
+  graph.inQueue.assign(numberNodes, 0);
+  graph.signature.assign(numberNodes, 0);
+  graph.mark.assign(numberNodes, 0);
+  graph.cellTouched.assign(numberNodes, 0);
+  graph.numberCells = 0;
+  int iCell = 0;
+  for (int i = 0; i < numberNodes; i++) {
+    const int node = graph.lab[i];
+    graph.pos[node] = i;
+    if (i && coinSymmetryLess(colour[graph.lab[i-1]], colour[node])) {
+      graph.cellSize[iCell] = i - iCell;
+      iCell = i;
+    }
+    graph.cellOf[node] = iCell;
+  }
+  if (numberNodes) {
+    graph.cellSize[iCell] = numberNodes - iCell;
+    for (int i = 0; i < numberNodes; i += graph.cellSize[i]) {
+      graph.numberCells++;
+      graph.pushCell(i);
+    }
+  }
+  graph.refine();
+  // first path
+  std::vector<int> levelTarget;
+  std::vector<int> levelNode;
+  std::vector<int> levelMark;
+  int target;
+  while ((target = graph.target()) >= 0) {
+    levelTarget.push_back(target);
+    levelNode.push_back(graph.lab[target]);
+    levelMark.push_back(static_cast<int>(graph.trail.size()));
+    graph.individualize(graph.lab[target]);
+  }
+  levelMark.push_back(static_cast<int>(graph.trail.size()));
+  const int depth = static_cast<int>(levelTarget.size());
+  const std::vector<int> firstLeaf(graph.lab);
+  const std::vector<int> firstTrail(graph.trail);
+  std::vector<int> parent(numberNodes);
+  for (int i = 0; i < numberNodes; i++)
+    parent[i] = i;
+  std::vector<int> perm(numberNodes);
+  std::vector<int> colourOf(numberNodes, 0);
+  // search stack - level and nodes of its cell to try
+  std::vector<int> stackLevel;
+  std::vector<int> stackMark;
+  std::vector<int> stackNext;
+  std::vector<int> stackStart;
+  std::vector<int> candidates;
+  std::vector<int> failed;
+  for (int level = depth - 1; level >= 0 && complete_; level--) {
+    graph.undo(levelMark[level]);
+    const int iTarget = levelTarget[level];
+    const int firstNode = levelNode[level];
+    const std::vector<int> tryNodes(graph.lab.begin() + iTarget,
+				    graph.lab.begin() + iTarget +
+				    graph.cellSize[iTarget]);
+    failed.clear();
+    for (size_t k = 0; k < tryNodes.size() && complete_; k++) {
+      const int node = tryNodes[k];
+      const int root = coinSymmetryFind(parent, node);
+      if (root == coinSymmetryFind(parent, firstNode))
+	continue;
+      bool skip = false;
+      for (size_t f = 0; f < failed.size(); f++) {
+	if (coinSymmetryFind(parent, failed[f]) == root) {
+	  skip = true;
+	  break;
+	}
+      }
+      if (skip)
+	continue;
+      // depth first search for leaf matching first path
+      bool found = false;
+      stackLevel.assign(1, level);
+      stackMark.assign(1, levelMark[level]);
+      stackNext.assign(1, 0);
+      stackStart.assign(1, 0);
+      candidates.assign(1, node);
+      while (!stackLevel.empty()) {
+	const int top = static_cast<int>(stackLevel.size()) - 1;
+	const int thisLevel = stackLevel[top];
+	const int end = (top < static_cast<int>(stackStart.size()) - 1) ?
+	  stackStart[top+1] : static_cast<int>(candidates.size());
+	graph.undo(stackMark[top]);
+	if (stackStart[top] + stackNext[top] >= end) {
+	  stackLevel.pop_back();
+	  stackMark.pop_back();
+	  stackNext.pop_back();
+	  candidates.resize(stackStart[top]);
+	  stackStart.pop_back();
+	  continue;
+	}
+	const int tryNode = candidates[stackStart[top] + stackNext[top]];
+	stackNext[top]++;
+	if (++numberNodes_ > maximumNodes_) {
+	  complete_ = false;
+	  break;
+	}
+	graph.individualize(tryNode);
+	// must split exactly as first path did
+	const int first = levelMark[thisLevel];
+	const int last = levelMark[thisLevel+1];
+	bool same = static_cast<int>(graph.trail.size()) - stackMark[top] ==
+	  last - first;
+	for (int i = 0; same && i < last - first; i++)
+	  same = graph.trail[stackMark[top]+i] == firstTrail[first+i];
+	if (!same)
+	  continue;
+	if (thisLevel == depth - 1) {
+	  for (int i = 0; i < numberNodes; i++)
+	    perm[firstLeaf[i]] = graph.lab[i];
+	  if (graph.isAutomorphism(&perm[0], numberColumns, colourOf)) {
+	    found = true;
+	    break;
+	  }
+	  continue;
+	}
+	// go down a level
+	const int nextTarget = levelTarget[thisLevel+1];
+	stackLevel.push_back(thisLevel + 1);
+	stackMark.push_back(static_cast<int>(graph.trail.size()));
+	stackNext.push_back(0);
+	stackStart.push_back(static_cast<int>(candidates.size()));
+	for (int i = nextTarget; i < nextTarget + graph.cellSize[nextTarget];
+	     i++)
+	  candidates.push_back(graph.lab[i]);
+      }
+      graph.undo(levelMark[level]);
+      if (found) {
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  if (perm[iColumn] != iColumn) {
+	    generatorColumn_.push_back(iColumn);
+	    generatorImage_.push_back(perm[iColumn]);
+	  }
+	}
+	generatorStart_.push_back(static_cast<int>(generatorColumn_.size()));
+	for (int i = 0; i < numberNodes; i++) {
+	  const int root1 = coinSymmetryFind(parent, i);
+	  const int root2 = coinSymmetryFind(parent, perm[i]);
+	  if (root1 != root2)
+	    parent[CoinMax(root1, root2)] = CoinMin(root1, root2);
+	}
+      } else {
+	failed.push_back(node);
+      }
+    }
+  }
+  // orbits - roots are smallest nodes so smallest columns
+  columnOrbit_.resize(numberColumns);
+  std::vector<int> orbitSize(numberColumns, 0);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    columnOrbit_[iColumn] = coinSymmetryFind(parent, iColumn);
+    orbitSize[columnOrbit_[iColumn]]++;
+  }
+  orbitStart_.assign(1, 0);
+  orbitMember_.clear();
+  std::vector<int> orbitPut(numberColumns, -1);
+  int numberInOrbits = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    if (columnOrbit_[iColumn] == iColumn && orbitSize[iColumn] > 1) {
+      orbitPut[iColumn] = numberInOrbits;
+      numberInOrbits += orbitSize[iColumn];
+      orbitStart_.push_back(numberInOrbits);
+    }
+  }
+  orbitMember_.resize(numberInOrbits);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    const int orbit = columnOrbit_[iColumn];
+    if (orbitPut[orbit] >= 0)
+      orbitMember_[orbitPut[orbit]++] = iColumn;
+  }
+  return numberGenerators();
+}
@@ -0,0 +1,137 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixSymmetry_H
+#define CoinPackedMatrixSymmetry_H
+
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+
+class CoinSnapshot;
+
+/** Symmetries of a problem - column orbits and generators
+
+    A symmetry is a permutation of columns (with one of rows) which maps
+    the problem to itself: columns go to columns with the same objective,
+    bounds and type, rows to rows with the same bounds, and each element
+    to an element with the same value.  These are the automorphisms of the
+    bipartite graph with a node for each row and column and an edge for
+    each element, nodes coloured by their data and edges by their values.
+
+    find works as nauty and saucy do.  The graph is refined to an
+    equitable partition - cells split by how many edges of each colour
+    their nodes have to each other cell - and a first path individualizes
+    the first node of the first cell with more than one node, refining
+    each time, until all cells are single nodes.  Then, from the deepest
+    level up, every other node of each such cell not already in the
+    orbit of the first is tried, searching for a leaf which matches the
+    first path; each match is checked to be a symmetry before it is kept
+    as a generator, so generators are always right.  The generators found
+    generate the whole group unless the search ran out of nodes
+    (maximumNodes), in which case complete() is false and orbits may be
+    smaller than the true ones.
+
+    Refinement follows the order of cells and not of node numbers, so
+    the same problem with columns in another order has the same orbits.
+    Orbits are what orbital fixing and orbitopal branching need; the
+    generators (as permutations of columns) are for symmetry handling
+    constraints.
+*/
+class CoinPackedMatrixSymmetry {
+public:
+  /**@name Finding symmetries */
+  //@{
+  /** Finds symmetries of problem.  integerType may be NULL (all
+      continuous); any different values give different types.  Returns
+      number of generators */
+  int find(const CoinPackedMatrix & matrix,
+	   const double * columnLower, const double * columnUpper,
+	   const double * objective, const char * integerType,
+	   const double * rowLower, const double * rowUpper);
+  /// Finds symmetries of problem in snapshot
+  int find(const CoinSnapshot & snapshot);
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Number of columns
+  inline int numberColumns() const
+  { return numberColumns_;}
+  /// Number of generators
+  inline int numberGenerators() const
+  { return static_cast<int>(generatorStart_.size()) - 1;}
+  /** Start of each generator in generatorColumns and generatorImages
+      (numberGenerators()+1) */
+  inline const int * generatorStarts() const
+  { return &generatorStart_[0];}
+  /// Columns moved by generators (increasing order in a generator)
+  inline const int * generatorColumns() const
+  { return generatorColumn_.size() ? &generatorColumn_[0] : NULL;}
+  /// Images of columns moved by generators
+  inline const int * generatorImages() const
+  { return generatorImage_.size() ? &generatorImage_[0] : NULL;}
+  /// Orbit of each column (smallest column in it)
+  inline const int * columnOrbit() const
+  { return columnOrbit_.size() ? &columnOrbit_[0] : NULL;}
+  /// Number of orbits with more than one column
+  inline int numberOrbits() const
+  { return static_cast<int>(orbitStart_.size()) - 1;}
+  /// Start of each orbit with more than one column in orbitMembers
+  inline const int * orbitStarts() const
+  { return &orbitStart_[0];}
+  /// Columns of orbits with more than one column (increasing order)
+  inline const int * orbitMembers() const
+  { return orbitMember_.size() ? &orbitMember_[0] : NULL;}
+  /// True if search finished (so orbits are exact)
+  inline bool complete() const
+  { return complete_;}
+  /// Nodes of search used
+  inline int numberNodes() const
+  { return numberNodes_;}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Most nodes of search (default 100000)
+  inline int maximumNodes() const
+  { return maximumNodes_;}
+  inline void setMaximumNodes(int value)
+  { maximumNodes_ = value;}
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Default constructor
+  CoinPackedMatrixSymmetry();
+  //@}
+
+private:
+  /**@name Private member data */
+  //@{
+  /// Starts of generators
+  std::vector<int> generatorStart_;
+  /// Columns moved by generators
+  std::vector<int> generatorColumn_;
+  /// Images of columns moved by generators
+  std::vector<int> generatorImage_;
+  /// Orbit of each column
+  std::vector<int> columnOrbit_;
+  /// Starts of nontrivial orbits
+  std::vector<int> orbitStart_;
+  /// Members of nontrivial orbits
+  std::vector<int> orbitMember_;
+  /// Number of columns
+  int numberColumns_;
+  /// Most nodes of search
+  int maximumNodes_;
+  /// Nodes used
+  int numberNodes_;
+  /// True if search finished
+  bool complete_;
+  //@}
+};
+
+#endif
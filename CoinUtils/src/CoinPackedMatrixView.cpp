@@ -0,0 +1,251 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrixView.hpp"
+
+//#############################################################################
+
+CoinPackedMatrixView::CoinPackedMatrixView(const CoinPackedMatrix & parent,
+					   int numMajor, const int * indMajor,
+					   int numMinor, const int * indMinor) :
+  parent_(&parent),
+  major_(NULL),
+  minorMap_(NULL),
+  numberElements_(0),
+  numberMajor_(CoinMax(numMajor, 0)),
+  numberMinor_(parent.getMinorDim())
+{
+  if (parent.getTail())
+    throw CoinError("parent has block append tail",
+		    "CoinPackedMatrixView", "CoinPackedMatrixView");
+  const int parentMajor = parent.getMajorDim();
+  const int parentMinor = parent.getMinorDim();
+  for (int i = 0; i < numberMajor_; i++) {
+    if (indMajor[i] < 0 || indMajor[i] >= parentMajor)
+      throw CoinError("bad major index",
+		      "CoinPackedMatrixView", "CoinPackedMatrixView");
+  }
+  major_ = CoinCopyOfArray(indMajor, numberMajor_);
+  const CoinBigIndex * start = parent.getVectorStarts();
+  const int * length = parent.getVectorLengths();
+  if (indMinor) {
+    numberMinor_ = CoinMax(numMinor, 0);
+    minorMap_ = new int [CoinMax(parentMinor, 1)];
+    CoinFillN(minorMap_, parentMinor, -1);
+    for (int i = 0; i < numberMinor_; i++) {
+      const int iMinor = indMinor[i];
+      if (iMinor < 0 || iMinor >= parentMinor || minorMap_[iMinor] >= 0) {
+	delete [] major_;
+	delete [] minorMap_;
+	throw CoinError("bad or repeated minor index",
+			"CoinPackedMatrixView", "CoinPackedMatrixView");
+      }
+      minorMap_[iMinor] = i;
+    }
+    const int * index = parent.getIndices();
+    for (int i = 0; i < numberMajor_; i++) {
+      const int iMajor = major_[i];
+      const CoinBigIndex end = start[iMajor] + length[iMajor];
+      for (CoinBigIndex j = start[iMajor]; j < end; j++) {
+	if (minorMap_[index[j]] >= 0)
+	  numberElements_++;
+      }
+    }
+  } else {
+    for (int i = 0; i < numberMajor_; i++)
+      numberElements_ += length[major_[i]];
+  }
+}
+
+CoinPackedMatrixView::CoinPackedMatrixView(const CoinPackedMatrixView & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinPackedMatrixView &
+CoinPackedMatrixView::operator=(const CoinPackedMatrixView & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+CoinPackedMatrixView::~CoinPackedMatrixView()
+{
+  gutsOfDelete();
+}
+
+void
+CoinPackedMatrixView::gutsOfDelete()
+{
+  delete [] major_;
+  delete [] minorMap_;
+  major_ = NULL;
+  minorMap_ = NULL;
+}
+
+void
+CoinPackedMatrixView::gutsOfCopy(const CoinPackedMatrixView & rhs)
+{
+  parent_ = rhs.parent_;
+  numberElements_ = rhs.numberElements_;
+  numberMajor_ = rhs.numberMajor_;
+  numberMinor_ = rhs.numberMinor_;
+  major_ = CoinCopyOfArray(rhs.major_, numberMajor_);
+  minorMap_ = CoinCopyOfArray(rhs.minorMap_, parent_->getMinorDim());
+}
+
+//#############################################################################
+
+CoinPackedVector
+CoinPackedMatrixView::getVector(int i) const
+{
+#ifndef COIN_FAST_CODE
+  if (i < 0 || i >= numberMajor_)
+    throw CoinError("bad index", "getVector", "CoinPackedMatrixView");
+#endif
+  const int iMajor = major_[i];
+  const CoinBigIndex start = parent_->getVectorStarts()[iMajor];
+  const int length = parent_->getVectorLengths()[iMajor];
+  const int * index = parent_->getIndices() + start;
+  const double * element = parent_->getElements() + start;
+  if (!minorMap_)
+    return CoinPackedVector(length, index, element, false);
+  CoinPackedVector vector(false);
+  vector.reserve(length);
+  for (int j = 0; j < length; j++) {
+    const int iMinor = minorMap_[index[j]];
+    if (iMinor >= 0)
+      vector.insert(iMinor, element[j]);
+  }
+  return vector;
+}
+
+const CoinShallowPackedVector
+CoinPackedMatrixView::getParentVector(int i) const
+{
+#ifndef COIN_FAST_CODE
+  if (i < 0 || i >= numberMajor_)
+    throw CoinError("bad index", "getParentVector", "CoinPackedMatrixView");
+#endif
+  return parent_->getVector(major_[i]);
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixView::gatherTimes(const double * x, double * y) const
+{
+  const CoinBigIndex * start = parent_->getVectorStarts();
+  const int * length = parent_->getVectorLengths();
+  const int * COIN_RESTRICT index = parent_->getIndices();
+  const double * COIN_RESTRICT element = parent_->getElements();
+  const int * COIN_RESTRICT minorMap = minorMap_;
+  for (int i = 0; i < numberMajor_; i++) {
+    const int iMajor = major_[i];
+    const CoinBigIndex end = start[iMajor] + length[iMajor];
+    double value = 0.0;
+    if (minorMap) {
+      for (CoinBigIndex j = start[iMajor]; j < end; j++) {
+	const int iMinor = minorMap[index[j]];
+	if (iMinor >= 0)
+	  value += x[iMinor] * element[j];
+      }
+    } else {
+      for (CoinBigIndex j = start[iMajor]; j < end; j++)
+	value += x[index[j]] * element[j];
+    }
+    y[i] = value;
+  }
+}
+
+void
+CoinPackedMatrixView::scatterTimes(const double * x, double * y) const
+{
+  const CoinBigIndex * start = parent_->getVectorStarts();
+  const int * length = parent_->getVectorLengths();
+  const int * COIN_RESTRICT index = parent_->getIndices();
+  const double * COIN_RESTRICT element = parent_->getElements();
+  const int * COIN_RESTRICT minorMap = minorMap_;
+  CoinZeroN(y, numberMinor_);
+  for (int i = 0; i < numberMajor_; i++) {
+    const double value = x[i];
+    if (!value)
+      continue;
+    const int iMajor = major_[i];
+    const CoinBigIndex end = start[iMajor] + length[iMajor];
+    if (minorMap) {
+      for (CoinBigIndex j = start[iMajor]; j < end; j++) {
+	const int iMinor = minorMap[index[j]];
+	if (iMinor >= 0)
+	  y[iMinor] += value * element[j];
+      }
+    } else {
+      for (CoinBigIndex j = start[iMajor]; j < end; j++)
+	y[index[j]] += value * element[j];
+    }
+  }
+}
+
+void
+CoinPackedMatrixView::times(const double * x, double * y) const
+{
+  if (isColOrdered())
+    scatterTimes(x, y);
+  else
+    gatherTimes(x, y);
+}
+
+void
+CoinPackedMatrixView::transposeTimes(const double * x, double * y) const
+{
+  if (isColOrdered())
+    gatherTimes(x, y);
+  else
+    scatterTimes(x, y);
+}
+
+//#############################################################################
+
+void
+CoinPackedMatrixView::materialize(CoinPackedMatrix & matrix) const
+{
+  const CoinBigIndex * start = parent_->getVectorStarts();
+  const int * length = parent_->getVectorLengths();
+  const int * index = parent_->getIndices();
+  const double * element = parent_->getElements();
+  CoinBigIndex * newStart = new CoinBigIndex [numberMajor_+1];
+  int * newLength = new int [numberMajor_];
+  int * newIndex = new int [numberElements_];
+  double * newElement = new double [numberElements_];
+  CoinBigIndex put = 0;
+  newStart[0] = 0;
+  for (int i = 0; i < numberMajor_; i++) {
+    const int iMajor = major_[i];
+    const CoinBigIndex end = start[iMajor] + length[iMajor];
+    for (CoinBigIndex j = start[iMajor]; j < end; j++) {
+      const int iMinor = minorMap_ ? minorMap_[index[j]] : index[j];
+      if (iMinor >= 0) {
+	newIndex[put] = iMinor;
+	newElement[put++] = element[j];
+      }
+    }
+    newStart[i+1] = put;
+    newLength[i] = static_cast<int>(put - newStart[i]);
+  }
+  assert (put == numberElements_);
+  // matrix takes the arrays
+  matrix.assignMatrix(isColOrdered(), numberMinor_, numberMajor_,
+		      numberElements_, newElement, newIndex, newStart,
+		      newLength);
+}
@@ -0,0 +1,131 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedMatrixView_H
+#define CoinPackedMatrixView_H
+
+#include "CoinPackedMatrix.hpp"
+#include "CoinPackedVector.hpp"
+
+/** Read only submatrix of a CoinPackedMatrix without copying it
+
+    CoinPackedMatrix::submatrixOf copies the chosen vectors.  A view only
+    keeps the list of chosen major vectors and (optionally) a map from the
+    minor indices of the parent to those of the view, and reads elements
+    from the parent's arrays.  Major vectors may be repeated and are kept
+    in the given order (as submatrixOfWithDuplicates); minor vectors are
+    numbered in the order given and must not be repeated.
+
+    The view is valid only while the parent is not changed.  A parent in
+    block append mode must have its tail compacted first.  materialize
+    makes an ordinary matrix when a copy is wanted after all.
+*/
+class CoinPackedMatrixView {
+public:
+  /**@name Queries */
+  //@{
+  /// Whether the parent (and so the view) is column ordered
+  inline bool isColOrdered() const
+  { return parent_->isColOrdered();}
+  /// Number of major vectors in view
+  inline int getMajorDim() const
+  { return numberMajor_;}
+  /// Number of minor vectors in view
+  inline int getMinorDim() const
+  { return numberMinor_;}
+  /// Number of rows
+  inline int getNumRows() const
+  { return isColOrdered() ? numberMinor_ : numberMajor_;}
+  /// Number of columns
+  inline int getNumCols() const
+  { return isColOrdered() ? numberMajor_ : numberMinor_;}
+  /// Number of elements in view
+  inline CoinBigIndex getNumElements() const
+  { return numberElements_;}
+  /// Parent matrix
+  inline const CoinPackedMatrix * parent() const
+  { return parent_;}
+  /// Parent major index of each major vector of view
+  inline const int * parentMajor() const
+  { return major_;}
+  /** Map from parent minor index to view minor index (-1 if not in
+      view), NULL if all minor vectors are in view */
+  inline const int * minorMap() const
+  { return minorMap_;}
+  /** Major vector i of view, with view minor indices (in order of
+      parent).  Only this vector is copied */
+  CoinPackedVector getVector(int i) const;
+  /** Major vector i of view as it is stored in parent (no copy).  Indices
+      are those of parent and if there is a minor map may include entries
+      which are not in view */
+  const CoinShallowPackedVector getParentVector(int i) const;
+  //@}
+
+  /**@name Products */
+  //@{
+  /** Return <code>A * x</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumCols()</code>
+      @pre <code>y</code> must be of size <code>getNumRows()</code> */
+  void times(const double * x, double * y) const;
+  /** Return <code>x * A</code> in <code>y</code>.
+      @pre <code>x</code> must be of size <code>getNumRows()</code>
+      @pre <code>y</code> must be of size <code>getNumCols()</code> */
+  void transposeTimes(const double * x, double * y) const;
+  //@}
+
+  /**@name Copying */
+  //@{
+  /// Copies view into matrix (same ordering as parent, no gaps)
+  void materialize(CoinPackedMatrix & matrix) const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /** Constructor.  The view has major vectors indMajor of parent and, if
+      indMinor is given, minor vectors indMinor (else all).  Throws
+      CoinError for a bad or repeated minor index, a bad major index or a
+      parent with a block append tail */
+  CoinPackedMatrixView(const CoinPackedMatrix & parent,
+		       int numMajor, const int * indMajor,
+		       int numMinor = -1, const int * indMinor = NULL);
+  /// Copy constructor
+  CoinPackedMatrixView(const CoinPackedMatrixView & rhs);
+  /// Assignment
+  CoinPackedMatrixView & operator=(const CoinPackedMatrixView & rhs);
+  /// Destructor
+  ~CoinPackedMatrixView();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs
+  void gutsOfCopy(const CoinPackedMatrixView & rhs);
+  /// y[i] = major vector i times x (x over view minor)
+  void gatherTimes(const double * x, double * y) const;
+  /// y (over view minor) = sum of x[i] times major vector i
+  void scatterTimes(const double * x, double * y) const;
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Parent
+  const CoinPackedMatrix * parent_;
+  /// Parent major index of each major vector
+  int * major_;
+  /// Parent minor to view minor (or NULL)
+  int * minorMap_;
+  /// Number of elements
+  CoinBigIndex numberElements_;
+  /// Number of major vectors
+  int numberMajor_;
+  /// Number of minor vectors
+  int numberMinor_;
+  //@}
+};
+
+#endif
@@ -82,11 +82,9 @@ CoinPackedVector::assignVector(int size, int*& inds, double*& elems,
   if ( size != 0 ) {
 		  //reserve(size); //This is a BUG!!!
     nElements_ = size;
-    if (indices_ != NULL) delete[] indices_;
+    freeStorage();
     indices_ = inds;    inds = NULL;
-    if (elements_ != NULL) delete[] elements_;
     elements_ = elems;  elems = NULL;
-    if (origIndices_ != NULL) delete[] origIndices_;
     origIndices_ = new int[size];
     CoinIotaN(origIndices_, size, 0);
     capacity_ = size;
@@ -330,29 +328,91 @@ CoinPackedVector::reserve(int n)
    // don't make allocated space smaller
    if ( n <= capacity_ )
       return;
+
+   int * newIndices;
+   int * newOrigIndices;
+   double * newElements;
+   double * newBlock = NULL;
+   if (n <= inlineCapacity) {
+      newIndices = inlineIndices_;
+      newOrigIndices = inlineOrigIndices_;
+      newElements = inlineElements_;
+   } else {
+      // elements first so all are aligned
+      const size_t intsAsDoubles =
+	 (2 * n * sizeof(int) + sizeof(double) - 1) / sizeof(double);
+      newBlock = new double [n + intsAsDoubles];
+      newElements = newBlock;
+      newIndices = reinterpret_cast<int *>(newBlock + n);
+      newOrigIndices = newIndices + n;
+   }
+   if (newElements != elements_) {
+      // copy data to new space
+      if (nElements_ > 0) {
+	 CoinDisjointCopyN(indices_, nElements_, newIndices);
+	 CoinDisjointCopyN(origIndices_, nElements_, newOrigIndices);
+	 CoinDisjointCopyN(elements_, nElements_, newElements);
+      }
+      freeStorage();
+      indices_ = newIndices;
+      origIndices_ = newOrigIndices;
+      elements_ = newElements;
+      block_ = newBlock;
+   }
    capacity_ = n;
+}
+
+//-----------------------------------------------------------------------------
 
-   // save pointers to existing data
-   int * tempIndices = indices_;
-   int * tempOrigIndices = origIndices_;
-   double * tempElements = elements_;
-
-   // allocate new space
-   indices_ = new int [capacity_];
-   origIndices_ = new int [capacity_];
-   elements_ = new double [capacity_];
-
-   // copy data to new space
-   if (nElements_ > 0) {
-      CoinDisjointCopyN(tempIndices, nElements_, indices_);
-      CoinDisjointCopyN(tempOrigIndices, nElements_, origIndices_);
-      CoinDisjointCopyN(tempElements, nElements_, elements_);
+void
+CoinPackedVector::freeStorage()
+{
+   if (block_) {
+      delete [] block_;
+   } else if (elements_ != inlineElements_) {
+      // handed over by assignVector
+      delete [] indices_;
+      delete [] origIndices_;
+      delete [] elements_;
    }
+   block_ = NULL;
+   indices_ = NULL;
+   origIndices_ = NULL;
+   elements_ = NULL;
+}
+
+//-----------------------------------------------------------------------------
 
-   // free old data
-   delete [] tempElements;
-   delete [] tempOrigIndices;
-   delete [] tempIndices;
+void
+CoinPackedVector::gutsOfMove(CoinPackedVector & rhs)
+{
+   // duplicates were checked (if wanted) as rhs was built
+   CoinPackedVectorBase::setTestForDuplicateIndexWhenTrue(
+      rhs.testForDuplicateIndex());
+   CoinPackedVectorBase::copyMaxMinIndex(rhs);
+   nElements_ = rhs.nElements_;
+   capacity_ = rhs.capacity_;
+   if (rhs.elements_ == rhs.inlineElements_) {
+      indices_ = inlineIndices_;
+      origIndices_ = inlineOrigIndices_;
+      elements_ = inlineElements_;
+      CoinDisjointCopyN(rhs.indices_, nElements_, indices_);
+      CoinDisjointCopyN(rhs.origIndices_, nElements_, origIndices_);
+      CoinDisjointCopyN(rhs.elements_, nElements_, elements_);
+      block_ = NULL;
+   } else {
+      indices_ = rhs.indices_;
+      origIndices_ = rhs.origIndices_;
+      elements_ = rhs.elements_;
+      block_ = rhs.block_;
+   }
+   rhs.indices_ = NULL;
+   rhs.origIndices_ = NULL;
+   rhs.elements_ = NULL;
+   rhs.block_ = NULL;
+   rhs.nElements_ = 0;
+   rhs.capacity_ = 0;
+   rhs.clearBase();
 }
 
 //#############################################################################
@@ -363,7 +423,8 @@ CoinPackedVector::CoinPackedVector (bool testForDuplicateIndex) :
    elements_(NULL),
    nElements_(0),
    origIndices_(NULL),
-   capacity_(0)
+   capacity_(0),
+   block_(NULL)
 {
    // This won't fail, the packed vector is empty. There can't be duplicate
    // indices.
@@ -380,7 +441,8 @@ CoinPackedVector::CoinPackedVector(int size,
    elements_(NULL),
    nElements_(0),
    origIndices_(NULL),
-   capacity_(0)
+   capacity_(0),
+   block_(NULL)
 {
    gutsOfSetVector(size, inds, elems, testForDuplicateIndex,
 		   "constructor for array value");
@@ -396,7 +458,8 @@ CoinPackedVector::CoinPackedVector(int size,
    elements_(NULL),
    nElements_(0),
    origIndices_(NULL),
-   capacity_(0)
+   capacity_(0),
+   block_(NULL)
 {
    gutsOfSetConstant(size, inds, value, testForDuplicateIndex,
 		     "constructor for constant value");
@@ -412,7 +475,8 @@ CoinPackedVector::CoinPackedVector(int capacity, int size,
     elements_(elems),
     nElements_(size),
     origIndices_(NULL),
-    capacity_(capacity)
+    capacity_(capacity),
+    block_(NULL)
 {
    assert( size <= capacity );
    inds = NULL;
@@ -430,7 +494,8 @@ CoinPackedVector::CoinPackedVector(int size, const double * element,
    elements_(NULL),
    nElements_(0),
    origIndices_(NULL),
-   capacity_(0)
+   capacity_(0),
+   block_(NULL)
 {
    setFull(size, element, testForDuplicateIndex);
 }
@@ -443,7 +508,8 @@ CoinPackedVector::CoinPackedVector(const CoinPackedVectorBase & rhs) :
    elements_(NULL),
    nElements_(0),
    origIndices_(NULL),
-   capacity_(0)
+   capacity_(0),
+   block_(NULL)
 {  
    gutsOfSetVector(rhs.getNumElements(), rhs.getIndices(), rhs.getElements(),
 		   rhs.testForDuplicateIndex(), "copy constructor from base");
@@ -457,7 +523,8 @@ CoinPackedVector::CoinPackedVector(const CoinPackedVector & rhs) :
    elements_(NULL),
    nElements_(0),
    origIndices_(NULL),
-   capacity_(0)
+   capacity_(0),
+   block_(NULL)
 {  
    gutsOfSetVector(rhs.getVectorNumElements(), rhs.getVectorIndices(), rhs.getVectorElements(),
 		   rhs.testForDuplicateIndex(), "copy constructor");
@@ -465,11 +532,38 @@ CoinPackedVector::CoinPackedVector(const CoinPackedVector & rhs) :
 
 //-----------------------------------------------------------------------------
 
+#if COIN_HAS_MOVE
+CoinPackedVector::CoinPackedVector(CoinPackedVector && rhs) COIN_NOEXCEPT :
+   CoinPackedVectorBase(),
+   indices_(NULL),
+   elements_(NULL),
+   nElements_(0),
+   origIndices_(NULL),
+   capacity_(0),
+   block_(NULL)
+{
+   gutsOfMove(rhs);
+}
+
+//-----------------------------------------------------------------------------
+
+CoinPackedVector &
+CoinPackedVector::operator=(CoinPackedVector && rhs) COIN_NOEXCEPT
+{
+   if (this != &rhs) {
+      freeStorage();
+      clear();
+      gutsOfMove(rhs);
+   }
+   return *this;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
 CoinPackedVector::~CoinPackedVector ()
 {
-   delete [] indices_;
-   delete [] origIndices_;
-   delete [] elements_;
+   freeStorage();
 }
 
 //#############################################################################
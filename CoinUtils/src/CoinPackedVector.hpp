@@ -9,6 +9,7 @@
 #include <map>
 
 #include "CoinPragma.hpp"
+#include "CoinTypes.hpp"
 #include "CoinPackedVectorBase.hpp"
 #include "CoinSort.hpp"
 
@@ -304,6 +305,13 @@ public:
    CoinPackedVector(const CoinPackedVector &);
    /** Copy constructor <em>from a PackedVectorBase</em>. */
    CoinPackedVector(const CoinPackedVectorBase & rhs);
+#if COIN_HAS_MOVE
+   /** Move constructor.  Takes the storage of \p rhs (a small vector is
+       copied), which is left empty. */
+   CoinPackedVector(CoinPackedVector && rhs) COIN_NOEXCEPT;
+   /** Move assignment, as move constructor. */
+   CoinPackedVector & operator=(CoinPackedVector && rhs) COIN_NOEXCEPT;
+#endif
    /** Destructor */
    virtual ~CoinPackedVector ();
    //@}
@@ -321,8 +329,16 @@ private:
 			  const int * inds, double value,
 			  bool testForDuplicateIndex,
 			  const char * method);
+   /// Frees storage (pointers become NULL, capacity is not changed)
+   void freeStorage();
+   /// Takes storage of rhs, leaving it empty
+   void gutsOfMove(CoinPackedVector & rhs);
    //@}
 
+   /** Vectors with capacity up to this keep their arrays in the object;
+       larger ones have all three arrays in one allocation */
+   enum { inlineCapacity = 4 };
+
 private:
    /**@name Private member data */
    //@{
@@ -336,6 +352,15 @@ private:
    int * origIndices_;
    /// Amount of memory allocated for indices_, origIndices_, and elements_.
    int capacity_;
+   /** Single allocation holding elements_, indices_ and origIndices_
+       (NULL if inline or if arrays were handed over by assignVector) */
+   double * block_;
+   /// Inline elements
+   double inlineElements_[inlineCapacity];
+   /// Inline indices
+   int inlineIndices_[inlineCapacity];
+   /// Inline original indices
+   int inlineOrigIndices_[inlineCapacity];
    //@}
 };
 
@@ -10,6 +10,54 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinFloatEqual.hpp"
 
+namespace {
+  /* Vectors up to this size are searched directly. Larger ones go through
+     an open addressing table holding position+1 (0 for empty) of each
+     index, sized to a power of two at least twice the number of indices.
+  */
+  const int smallVector = 16;
+
+  inline unsigned int hashIndex(int index, unsigned int mask)
+  {
+    return (static_cast<unsigned int>(index) * 2654435761U) & mask;
+  }
+
+  inline int hashSize(int n)
+  {
+    int size = 32;
+    while (size < 2 * n)
+      size <<= 1;
+    return size;
+  }
+
+  // True if an index occurs twice
+  bool hasDuplicate(const int * inds, int n)
+  {
+    if (n <= smallVector) {
+      for (int i = 1; i < n; ++i) {
+	for (int j = 0; j < i; ++j) {
+	  if (inds[i] == inds[j])
+	    return true;
+	}
+      }
+      return false;
+    }
+    const int size = hashSize(n);
+    const unsigned int mask = size - 1;
+    std::vector<int> table(size, 0);
+    for (int i = 0; i < n; ++i) {
+      unsigned int k = hashIndex(inds[i], mask);
+      while (table[k]) {
+	if (inds[table[k] - 1] == inds[i])
+	  return true;
+	k = (k + 1) & mask;
+      }
+      table[k] = i + 1;
+    }
+    return false;
+  }
+}
+
 //#############################################################################
 
 double *
@@ -37,19 +85,8 @@ CoinPackedVectorBase::operator[](int i) const
    if (! testedDuplicateIndex_)
       duplicateIndex("operator[]", "CoinPackedVectorBase");
 
-   // Get a reference to a map of full storage indices to 
-   // packed storage location.
-   const std::set<int> & sv = *indexSet("operator[]", "CoinPackedVectorBase");
-#if 1
-   if (sv.find(i) == sv.end())
-      return 0.0;
-   return getElements()[findIndex(i)];
-#else
-   // LL: suggested change, somthing is wrong with this
-   const size_t ind = std::distance(sv.begin(), sv.find(i));
-   return (ind == sv.size()) ? 0.0 : getElements()[ind];
-#endif
-      
+   const int pos = findIndex(i);
+   return (pos < 0) ? 0.0 : getElements()[pos];
 }
 
 //#############################################################################
@@ -100,8 +137,16 @@ void
 CoinPackedVectorBase::duplicateIndex(const char* methodName,
 				    const char * className) const
 {
-   if (testForDuplicateIndex())
-      indexSet(methodName, className);
+   // An existing index set has no duplicates
+   if (testForDuplicateIndex() && indexSetPtr_ == NULL &&
+       hasDuplicate(getIndices(), getNumElements())) {
+      testedDuplicateIndex_ = false;
+      if (methodName != NULL)
+	 throw CoinError("Duplicate index found", methodName, className);
+      else
+	 throw CoinError("Duplicate index found",
+			 "duplicateIndex", "CoinPackedVectorBase");
+   }
    testedDuplicateIndex_ = true;
 }
 
@@ -113,8 +158,7 @@ CoinPackedVectorBase::isExistingIndex(int i) const
    if (! testedDuplicateIndex_)
       duplicateIndex("indexExists", "CoinPackedVectorBase");
 
-   const std::set<int> & sv = *indexSet("indexExists", "CoinPackedVectorBase");
-   return sv.find(i) != sv.end();
+   return findIndex(i) >= 0;
 }
 
 
@@ -176,6 +220,57 @@ CoinPackedVectorBase::isEquivalent(const CoinPackedVectorBase& rhs) const
    return isEquivalent(rhs,  CoinRelFltEq());
 }
 
+//-----------------------------------------------------------------------------
+
+bool
+CoinPackedVectorBase::matchIndices(const CoinPackedVectorBase& rhs,
+				   int * position) const
+{
+   const int n = getNumElements();
+   const int * inds = getIndices();
+   const int * indsRhs = rhs.getIndices();
+   if (n <= smallVector) {
+      unsigned int used = 0;
+      for (int i = 0; i < n; ++i) {
+	 int j;
+	 for (j = 0; j < n; ++j) {
+	    if (indsRhs[j] == inds[i] && !(used & (1U << j)))
+	       break;
+	 }
+	 if (j == n)
+	    return false;
+	 used |= 1U << j;
+	 position[i] = j;
+      }
+      return true;
+   }
+   const int size = hashSize(n);
+   const unsigned int mask = size - 1;
+   std::vector<int> table(size, 0);
+   for (int j = 0; j < n; ++j) {
+      unsigned int k = hashIndex(indsRhs[j], mask);
+      while (table[k])
+	 k = (k + 1) & mask;
+      table[k] = j + 1;
+   }
+   // A matched entry is negated so each is used once
+   for (int i = 0; i < n; ++i) {
+      unsigned int k = hashIndex(inds[i], mask);
+      for (;;) {
+	 const int j = table[k];
+	 if (!j)
+	    return false;
+	 if (j > 0 && indsRhs[j - 1] == inds[i]) {
+	    table[k] = -j;
+	    position[i] = j - 1;
+	    break;
+	 }
+	 k = (k + 1) & mask;
+      }
+   }
+   return true;
+}
+
 //#############################################################################
 
 double
@@ -240,22 +335,6 @@ CoinPackedVectorBase::sum() const
    return std::accumulate(getElements(), getElements() + getNumElements(), 0.0);
 }
 
-//#############################################################################
-
-CoinPackedVectorBase::CoinPackedVectorBase() :
-   maxIndex_(-COIN_INT_MAX/*0*/),
-   minIndex_(COIN_INT_MAX/*0*/),
-   indexSetPtr_(NULL),
-   testForDuplicateIndex_(true),
-   testedDuplicateIndex_(false) {}
-
-//-----------------------------------------------------------------------------
-
-CoinPackedVectorBase::~CoinPackedVectorBase()
-{
-   delete indexSetPtr_;
-}
-
 //#############################################################################
 //#############################################################################
 
@@ -6,10 +6,14 @@
 #ifndef CoinPackedVectorBase_H
 #define CoinPackedVectorBase_H
 
+#include <cstring>
 #include <set>
 #include <map>
+#include <vector>
 #include "CoinPragma.hpp"
 #include "CoinError.hpp"
+#include "CoinFinite.hpp"
+#include "CoinFloatEqual.hpp"
 
 class CoinPackedVector;
 
@@ -133,41 +137,32 @@ public:
        are still equivalent no matter how they are sorted.
        In this method the FloatEqual function operator can be specified. The
        default equivalence test is that the entries are relatively equal.<br> 
-       <strong>NOTE</strong>: This is a relatively expensive method as it
-       sorts the two shallow packed vectors.
+       Vectors with identical index arrays are compared element by element
+       (see CoinFirstDifferent);
+       otherwise the indices are matched through a hash table (linear in
+       the number of elements).
    */
    template <class FloatEqual> bool
    isEquivalent(const CoinPackedVectorBase& rhs, const FloatEqual& eq) const
    {
-      if (getNumElements() != rhs.getNumElements())
+      const int n = getNumElements();
+      if (n != rhs.getNumElements())
 	 return false;
 
       duplicateIndex("equivalent", "CoinPackedVector");
       rhs.duplicateIndex("equivalent", "CoinPackedVector");
 
-      std::map<int,double> mv;
-      const int * inds = getIndices();
       const double * elems = getElements();
+      const double * elemsRhs = rhs.getElements();
       int i;
-      for ( i = getNumElements() - 1; i >= 0; --i) {
-	 mv.insert(std::make_pair(inds[i], elems[i]));
-      }
-
-      std::map<int,double> mvRhs;
-      inds = rhs.getIndices();
-      elems = rhs.getElements();
-      for ( i = getNumElements() - 1; i >= 0; --i) {
-	 mvRhs.insert(std::make_pair(inds[i], elems[i]));
-      }
-
-      std::map<int,double>::const_iterator mvI = mv.begin();
-      std::map<int,double>::const_iterator mvIlast = mv.end();
-      std::map<int,double>::const_iterator mvIrhs = mvRhs.begin();
-      while (mvI != mvIlast) {
-	 if (mvI->first != mvIrhs->first || ! eq(mvI->second, mvIrhs->second))
+      if (!memcmp(getIndices(), rhs.getIndices(), n * sizeof(int)))
+	 return CoinFirstDifferent(eq, elems, elemsRhs, n) == n;
+      std::vector<int> position(n);
+      if (!matchIndices(rhs, &position[0]))
+	 return false;
+      for (i = 0; i < n; ++i) {
+	 if (! eq(elems[i], elemsRhs[position[i]]))
 	    return false;
-	 ++mvI;
-	 ++mvIrhs;
       }
       return true;
    }
@@ -203,12 +198,17 @@ protected:
       <strong>NOTE</strong>: All constructors are protected. There's no need
       to expose them, after all, this is an abstract class. */
    //@{
-   /** Default constructor. */
-   CoinPackedVectorBase();
+   /** Default constructor (inline as shallow vectors are made often). */
+   CoinPackedVectorBase() :
+      maxIndex_(-COIN_INT_MAX),
+      minIndex_(COIN_INT_MAX),
+      indexSetPtr_(NULL),
+      testForDuplicateIndex_(true),
+      testedDuplicateIndex_(false) {}
 
 public:
    /** Destructor */
-   virtual ~CoinPackedVectorBase();
+   virtual ~CoinPackedVectorBase() { delete indexSetPtr_; }
    //@}
 
 private:
@@ -237,6 +237,10 @@ protected:
    std::set<int> * indexSet(const char* methodName = NULL,
 			    const char * className = NULL) const;
 
+   /** Positions in \p rhs (with as many elements) of the indices of this
+       vector into \p position. Returns false if the indices differ. */
+   bool matchIndices(const CoinPackedVectorBase& rhs, int * position) const;
+
    /// Delete the indexSet
    void clearIndexSet() const;
    void clearBase() const;
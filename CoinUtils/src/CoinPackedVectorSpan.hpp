@@ -0,0 +1,155 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPackedVectorSpan_H
+#define CoinPackedVectorSpan_H
+
+#include <cstddef>
+#include <iterator>
+
+/// One entry of a packed vector (as CoinModelTriple - just data)
+typedef struct {
+  /// Index
+  int index;
+  /// Value
+  double value;
+} CoinPackedEntry;
+
+/** Read only view of a packed vector held elsewhere
+
+    A span is just two pointers and a length.  Unlike
+    CoinShallowPackedVector it has no virtual methods and no duplicate
+    index state, so making one costs nothing and a loop over it
+    \code
+    for (CoinPackedVectorSpan::const_iterator it = span.begin();
+	 it != span.end(); ++it)
+      sum += x[it->index] * it->value;
+    \endcode
+    or in C++11
+    \code
+    for (auto e : matrix.getVectorSpan(i))
+      sum += x[e.index] * e.value;
+    \endcode
+    compiles to the loop over getIndices() and getElements() which it
+    replaces.  It is valid only while the arrays it points into are not
+    changed or moved.
+*/
+class CoinPackedVectorSpan {
+public:
+  /** Iterator giving a CoinPackedEntry (by value) for each position */
+  class const_iterator {
+  public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef CoinPackedEntry value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const CoinPackedEntry * pointer;
+    typedef CoinPackedEntry reference;
+    /// Default (singular) iterator
+    const_iterator() : index_(NULL), element_(NULL) {}
+    /// Iterator at given position
+    const_iterator(const int * index, const double * element) :
+      index_(index), element_(element) {}
+    /// Entry at this position
+    inline CoinPackedEntry operator*() const
+    { CoinPackedEntry entry; entry.index = *index_;
+      entry.value = *element_; return entry;}
+    /// Proxy so it->index and it->value work
+    class arrow {
+    public:
+      arrow(const CoinPackedEntry & entry) : entry_(entry) {}
+      const CoinPackedEntry * operator->() const { return &entry_;}
+    private:
+      CoinPackedEntry entry_;
+    };
+    /// Member access to entry
+    inline arrow operator->() const
+    { return arrow(**this);}
+    /// Index at this position
+    inline int index() const
+    { return *index_;}
+    /// Value at this position
+    inline double value() const
+    { return *element_;}
+    /// Next position
+    inline const_iterator & operator++()
+    { ++index_; ++element_; return *this;}
+    /// Next position (postfix)
+    inline const_iterator operator++(int)
+    { const_iterator old(*this); ++index_; ++element_; return old;}
+    inline bool operator==(const const_iterator & rhs) const
+    { return index_ == rhs.index_;}
+    inline bool operator!=(const const_iterator & rhs) const
+    { return index_ != rhs.index_;}
+  private:
+    const int * index_;
+    const double * element_;
+  };
+  typedef const_iterator iterator;
+
+  /**@name Queries */
+  //@{
+  /// Number of entries
+  inline int size() const
+  { return size_;}
+  /// True if no entries
+  inline bool empty() const
+  { return size_ == 0;}
+  /// Indices
+  inline const int * indices() const
+  { return index_;}
+  /// Values
+  inline const double * elements() const
+  { return element_;}
+  /// Index in position i
+  inline int index(int i) const
+  { return index_[i];}
+  /// Value in position i
+  inline double element(int i) const
+  { return element_[i];}
+  /// First position
+  inline const_iterator begin() const
+  { return const_iterator(index_, element_);}
+  /// One past last position
+  inline const_iterator end() const
+  { return const_iterator(index_ + size_, element_ + size_);}
+  //@}
+
+  /**@name Arithmetic */
+  //@{
+  /// Dot product with a dense vector
+  inline double dot(const double * dense) const
+  {
+    double value = 0.0;
+    for (int i = 0; i < size_; i++)
+      value += dense[index_[i]] * element_[i];
+    return value;
+  }
+  /// dense += multiplier * this
+  inline void addTo(double multiplier, double * dense) const
+  {
+    for (int i = 0; i < size_; i++)
+      dense[index_[i]] += multiplier * element_[i];
+  }
+  //@}
+
+  /**@name Constructors */
+  //@{
+  /// Empty span
+  CoinPackedVectorSpan() : index_(NULL), element_(NULL), size_(0) {}
+  /// Span over size entries of given arrays
+  CoinPackedVectorSpan(int size, const int * index, const double * element) :
+    index_(index), element_(element), size_(size) {}
+  //@}
+
+private:
+  /// Indices
+  const int * index_;
+  /// Values
+  const double * element_;
+  /// Number of entries
+  int size_;
+};
+
+#endif
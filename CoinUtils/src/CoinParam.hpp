@@ -15,6 +15,7 @@
 
 #include <vector>
 #include <string>
+#include <map>
 #include <cstdio>
 
 /*! \class CoinParam
@@ -304,6 +305,10 @@ public:
 
   inline void setName(std::string name) { name_ = name ; processName() ; } 
 
+  /*! \brief Return the minimum match length of the parameter keyword */
+
+  inline size_t lengthMatch() const { return (lengthMatch_) ; } 
+
   /*! \brief Check if the specified string matches the parameter keyword (name)
 	     string
   
@@ -428,6 +433,125 @@ private:
 */
 typedef std::vector<CoinParam*> CoinParamVec ;
 
+/*! \relatesalso CoinParam
+    \brief One `keyword value' pair of a parsed parameter script.
+
+    \p index is the position of the parameter in the parameter vector, or
+    -1 if \p keyword did not match a single parameter. \p value is empty for
+    action parameters.
+*/
+struct CoinParamSetting {
+  int index ;
+  std::string keyword ;
+  std::string value ;
+} ;
+
+/*! \relatesalso CoinParam
+    \brief A type for a parsed parameter script.
+*/
+typedef std::vector<CoinParamSetting> CoinParamSettings ;
+
+/*! \class CoinParamIndex
+    \brief A keyword index over a parameter vector.
+
+  CoinParamUtils::matchParam and CoinParamUtils::lookupParam compare the name
+  against every parameter in the vector. A CoinParamIndex is built once over
+  the vector (a trie of the lower-cased keywords, with the match counts of
+  every prefix stored at its node) and then answers the same question by
+  walking the characters of the name. The answers are exactly those of the
+  linear scan, including the counts of short and multiple matches.
+
+  The index also caches parsed parameter scripts: parse() splits a script
+  into settings once and returns the cached result when the same script is
+  seen again. apply() loads a parsed script into the parameters.
+
+  The index refers to parameters by position; rebuild it (build()) if the
+  vector or the names of its parameters change.
+*/
+class CoinParamIndex {
+
+public:
+
+/*! \name Constructors and destructors */
+//@{
+  /*! \brief Default constructor (an empty index) */
+  CoinParamIndex() ;
+
+  /*! \brief Build an index over \p paramVec */
+  CoinParamIndex(const CoinParamVec &paramVec) ;
+//@}
+
+/*! \name Indexing and matching */
+//@{
+  /*! \brief (Re)build the index over \p paramVec; clears the script cache */
+  void build(const CoinParamVec &paramVec) ;
+
+  /*! \brief Number of parameters in the indexed vector (including nulls) */
+  inline int size() const { return (vecLen_) ; }
+
+  /*! \brief Minimal match of \p name, with the results of
+	     CoinParamUtils::matchParam
+
+    Takes time proportional to the length of \p name.
+  */
+  int match(const std::string &name, int &matchNdx, int &shortCnt) const ;
+//@}
+
+/*! \name Parsed parameter scripts */
+//@{
+  /*! \brief Parse (or find in the cache) a parameter script
+
+    \p script is a sequence of white space separated fields of the form
+    `keyword value', as on a command line. Leading `-' or `--' is removed
+    from keywords and action parameters take no value. A keyword that does
+    not match exactly one parameter gives a setting with index -1 and no
+    value. The returned reference stays valid until the index is rebuilt or
+    the cache cleared.
+  */
+  const CoinParamSettings &parse(const std::string &script) ;
+
+  /*! \brief Load \p settings into the parameters of \p paramVec
+
+    Integer, double, string and keyword parameters are given their values;
+    actions and unmatched settings are skipped (the caller processes them).
+    Returns the number of settings loaded, or -1 if a value would not
+    convert (parameters before it are loaded).
+  */
+  static int apply(const CoinParamSettings &settings, CoinParamVec &paramVec) ;
+
+  /*! \brief Number of cached scripts */
+  inline int cachedScripts() const { return (static_cast<int>(cache_.size())) ; }
+
+  /*! \brief Drop all cached scripts */
+  inline void clearCache() { cache_.clear() ; }
+//@}
+
+private:
+
+/*! \name Private index data */
+//@{
+  /// Length of the indexed vector
+  int vecLen_ ;
+  /// Action parameters (by position), needed to parse scripts
+  std::vector<bool> isAction_ ;
+  /*! \brief Trie nodes (node 0 is the empty prefix)
+
+    Children of a node are a list: firstChild_ of the node, then nextSibling_.
+  */
+  std::vector<int> firstChild_ ;
+  std::vector<int> nextSibling_ ;
+  std::vector<char> char_ ;
+  /// Matches meeting the minimum match length, for each prefix
+  std::vector<int> matchCnt_ ;
+  /// Matches short of the minimum match length, for each prefix
+  std::vector<int> shortCnt_ ;
+  /// Last parameter meeting the minimum match length, for each prefix
+  std::vector<int> matchNdx_ ;
+  /// Parsed scripts, by script text
+  std::map<std::string,CoinParamSettings> cache_ ;
+//@}
+} ;
+
 /*! \relatesalso CoinParam
     \brief A stream output function for a CoinParam object.
 */
@@ -504,6 +628,12 @@ namespace CoinParamUtils {
   int matchParam(const CoinParamVec &paramVec, std::string name,
 		 int &matchNdx, int &shortCnt) ;
 
+  /*! \relatesalso CoinParam
+      \brief matchParam using an index built over the parameter vector.
+  */
+  int matchParam(const CoinParamIndex &index, std::string name,
+		 int &matchNdx, int &shortCnt) ;
+
   /*! \relatesalso CoinParam
       \brief Get the next command keyword (name)
 
@@ -577,6 +707,14 @@ namespace CoinParamUtils {
   int lookupParam(std::string name, CoinParamVec &paramVec, 
 		  int *matchCnt = 0, int *shortCnt = 0, int *queryCnt = 0) ;
 
+  /*! \relatesalso CoinParam
+      \brief lookupParam using \p index (built over \p paramVec) to match
+	     the name.
+  */
+  int lookupParam(std::string name, CoinParamVec &paramVec,
+		  const CoinParamIndex &index,
+		  int *matchCnt = 0, int *shortCnt = 0, int *queryCnt = 0) ;
+
   /*! \relatesalso CoinParam
       \brief Utility to print a long message as filled lines of text
 
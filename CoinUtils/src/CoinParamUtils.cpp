@@ -4,6 +4,7 @@
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
 #include <cassert>
+#include <cctype>
 #include <cerrno>
 #include <iostream>
 
@@ -279,10 +280,14 @@ std::string getCommand (int argc, const char *argv[],
 
   The final three parameters (matchCnt, shortCnt, queryCnt) are optional and
   default to null. Use them if you want more detail on the match.
+
+  The work is done by doLookup, which matches through index if one is given
+  and by scanning paramVec otherwise.
 */
 
-int lookupParam (std::string name, CoinParamVec &paramVec,
-		 int *matchCntp, int *shortCntp, int *queryCntp)
+static int doLookup (std::string name, CoinParamVec &paramVec,
+		     const CoinParamIndex *index,
+		     int *matchCntp, int *shortCntp, int *queryCntp)
 
 {
   int retval = -3 ;
@@ -335,7 +340,11 @@ int lookupParam (std::string name, CoinParamVec &paramVec,
 */
   int matchNdx = -1 ;
   int shortCnt = 0 ;
-  int matchCnt = CoinParamUtils::matchParam(paramVec,name,matchNdx,shortCnt) ;
+  int matchCnt ;
+  if (index != 0)
+  { matchCnt = index->match(name,matchNdx,shortCnt) ; }
+  else
+  { matchCnt = CoinParamUtils::matchParam(paramVec,name,matchNdx,shortCnt) ; }
 /*
   Set up return values before we get into further processing.
 */
@@ -394,6 +403,18 @@ int lookupParam (std::string name, CoinParamVec &paramVec,
 
   return (retval) ; }
 
+int lookupParam (std::string name, CoinParamVec &paramVec,
+		 int *matchCntp, int *shortCntp, int *queryCntp)
+
+{ return (doLookup(name,paramVec,0,matchCntp,shortCntp,queryCntp)) ; }
+
+int lookupParam (std::string name, CoinParamVec &paramVec,
+		 const CoinParamIndex &index,
+		 int *matchCntp, int *shortCntp, int *queryCntp)
+
+{ assert (index.size() == static_cast<int>(paramVec.size())) ;
+  return (doLookup(name,paramVec,&index,matchCntp,shortCntp,queryCntp)) ; }
+
 
 /*
   Utility functions to acquire parameter values from the command line. For
@@ -555,6 +576,15 @@ int matchParam (const CoinParamVec &paramVec, std::string name,
   return (matchCnt) ;
 }
 
+/*
+  As above, but through an index built over the parameter vector.
+*/
+
+int matchParam (const CoinParamIndex &index, std::string name,
+		int &matchNdx, int &shortCnt)
+
+{ return (index.match(name,matchNdx,shortCnt)) ; }
+
 /*
   Now a bunch of routines that are useful in the context of generating help
   messages.
@@ -798,3 +828,187 @@ void printHelp (CoinParamVec &paramVec, int firstParam, int lastParam,
   return ; }   
 
 } // end namespace CoinParamUtils
+
+
+/*
+  CoinParamIndex: a trie over the lower-cased parameter names. Each node is a
+  prefix; it records how many parameters the prefix matches in full (meets the
+  minimum match length) and short, and the last full match, exactly as
+  matchParam would count them for that prefix. Matching a name is then a walk
+  down the trie, one node per character.
+*/
+
+CoinParamIndex::CoinParamIndex ()
+  : vecLen_(0)
+{ build(CoinParamVec()) ; }
+
+CoinParamIndex::CoinParamIndex (const CoinParamVec &paramVec)
+  : vecLen_(0)
+{ build(paramVec) ; }
+
+void CoinParamIndex::build (const CoinParamVec &paramVec)
+
+{ vecLen_ = static_cast<int>(paramVec.size()) ;
+  isAction_.assign(vecLen_,false) ;
+  firstChild_.assign(1,-1) ;
+  nextSibling_.assign(1,-1) ;
+  char_.assign(1,'\0') ;
+  matchCnt_.assign(1,0) ;
+  shortCnt_.assign(1,0) ;
+  matchNdx_.assign(1,-1) ;
+  cache_.clear() ;
+/*
+  The quirk of matchParam: the first full match of `?' is taken as unique and
+  ends the scan. queryNode is the node for `?' once that has happened.
+*/
+  int queryNode = -1 ;
+
+  for (int i = 0 ; i < vecLen_ ; i++)
+  { const CoinParam *param = paramVec[i] ;
+    if (param == 0) continue ;
+    isAction_[i] = (param->type() == CoinParam::coinParamAct) ;
+    std::string name = param->name() ;
+    size_t lengthName = name.length() ;
+    size_t lengthMatch = param->lengthMatch() ;
+    int node = 0 ;
+    for (size_t k = 0 ; k <= lengthName ; k++)
+    { if (k > 0)
+      { char c = static_cast<char>(tolower(static_cast<unsigned char>(name[k-1]))) ;
+	int child = firstChild_[node] ;
+	while (child >= 0 && char_[child] != c)
+	{ child = nextSibling_[child] ; }
+	if (child < 0)
+	{ child = static_cast<int>(char_.size()) ;
+	  firstChild_.push_back(-1) ;
+	  nextSibling_.push_back(firstChild_[node]) ;
+	  char_.push_back(c) ;
+	  matchCnt_.push_back(0) ;
+	  shortCnt_.push_back(0) ;
+	  matchNdx_.push_back(-1) ;
+	  firstChild_[node] = child ; }
+	node = child ; }
+      if (node == queryNode) continue ;
+      if (k >= lengthMatch)
+      { matchCnt_[node]++ ;
+	matchNdx_[node] = i ;
+	if (k == 1 && char_[node] == '?')
+	{ matchCnt_[node] = 1 ;
+	  queryNode = node ; } }
+      else
+      { shortCnt_[node]++ ; } } }
+
+  return ; }
+
+int CoinParamIndex::match (const std::string &name,
+			   int &matchNdx, int &shortCnt) const
+
+{ int node = 0 ;
+  size_t length = name.length() ;
+  for (size_t k = 0 ; k < length && node >= 0 ; k++)
+  { char c = static_cast<char>(tolower(static_cast<unsigned char>(name[k]))) ;
+    node = firstChild_[node] ;
+    while (node >= 0 && char_[node] != c)
+    { node = nextSibling_[node] ; } }
+
+  if (node < 0)
+  { matchNdx = -1 ;
+    shortCnt = 0 ;
+    return (0) ; }
+  matchNdx = matchNdx_[node] ;
+  shortCnt = shortCnt_[node] ;
+  return (matchCnt_[node]) ; }
+
+/*
+  Split a script into settings. Fields are separated by white space; a
+  keyword may carry its value as keyword=value, as on the command line.
+*/
+
+const CoinParamSettings &CoinParamIndex::parse (const std::string &script)
+
+{ std::map<std::string,CoinParamSettings>::iterator found =
+      cache_.find(script) ;
+  if (found != cache_.end())
+  { return (found->second) ; }
+
+  std::vector<std::string> fields ;
+  { const char *white = " \t\n\r" ;
+    std::string::size_type start = script.find_first_not_of(white) ;
+    while (start != std::string::npos)
+    { std::string::size_type end = script.find_first_of(white,start) ;
+      fields.push_back(script.substr(start,end-start)) ;
+      start = (end == std::string::npos) ?
+	  end : script.find_first_not_of(white,end) ; } }
+
+  CoinParamSettings &settings = cache_[script] ;
+  int numFields = static_cast<int>(fields.size()) ;
+  for (int f = 0 ; f < numFields ; f++)
+  { CoinParamSetting setting ;
+    std::string field = fields[f] ;
+    if (field.length() > 1 && field[0] == '-')
+    { field = field.substr((field[1] == '-') ? 2 : 1) ; }
+    std::string::size_type eqPos = field.find('=') ;
+    bool haveValue = (eqPos != std::string::npos) ;
+    if (haveValue)
+    { setting.value = field.substr(eqPos+1) ;
+      field = field.substr(0,eqPos) ; }
+    setting.keyword = field ;
+    int matchNdx ;
+    int shortCnt ;
+    int matchCnt = match(field,matchNdx,shortCnt) ;
+    if (matchCnt == 1 && shortCnt == 0)
+    { setting.index = matchNdx ;
+      if (isAction_[matchNdx])
+      { setting.value = "" ; }
+      else
+      if (!haveValue && f+1 < numFields)
+      { setting.value = fields[++f] ; } }
+    else
+    { setting.index = -1 ;
+      setting.value = "" ; }
+    settings.push_back(setting) ; }
+
+  return (settings) ; }
+
+int CoinParamIndex::apply (const CoinParamSettings &settings,
+			   CoinParamVec &paramVec)
+
+{ int numLoaded = 0 ;
+  int vecLen = static_cast<int>(paramVec.size()) ;
+  int numSettings = static_cast<int>(settings.size()) ;
+
+  for (int s = 0 ; s < numSettings ; s++)
+  { const CoinParamSetting &setting = settings[s] ;
+    if (setting.index < 0 || setting.index >= vecLen) continue ;
+    CoinParam *param = paramVec[setting.index] ;
+    if (param == 0) continue ;
+    const char *value = setting.value.c_str() ;
+    char *after = 0 ;
+    switch (param->type())
+    { case CoinParam::coinParamInt:
+      { errno = 0 ;
+	long ival = strtol(value,&after,10) ;
+	if (*value == '\0' || *after != '\0' || errno != 0)
+	{ return (-1) ; }
+	param->setIntVal(static_cast<int>(ival)) ;
+	break ; }
+      case CoinParam::coinParamDbl:
+      { errno = 0 ;
+	double dval = strtod(value,&after) ;
+	if (*value == '\0' || *after != '\0' || errno != 0)
+	{ return (-1) ; }
+	param->setDblVal(dval) ;
+	break ; }
+      case CoinParam::coinParamStr:
+      { param->setStrVal(setting.value) ;
+	break ; }
+      case CoinParam::coinParamKwd:
+      { int kwd = param->kwdIndex(setting.value) ;
+	if (kwd < 0)
+	{ return (-1) ; }
+	param->setKwdVal(kwd) ;
+	break ; }
+      default:
+      { continue ; } }
+    numLoaded++ ; }
+
+  return (numLoaded) ; }
@@ -0,0 +1,221 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CoinUtilsConfig.h"
+
+#include <cmath>
+
+#include "CoinPermute.hpp"
+#include "CoinHelperFunctions.hpp"
+
+/* COIN_PERMUTE_SIMD 1 allows AVX-512F and 0 switches off.  Instruction
+   set is chosen at run time so library can still be built for generic
+   x86.  Each kernel does as many complete blocks of 16 as it can and
+   returns number done - caller finishes off with scalar code. */
+#ifndef COIN_PERMUTE_SIMD
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+  && (defined(__x86_64__) || defined(__i386__))
+#define COIN_PERMUTE_SIMD 1
+#else
+#define COIN_PERMUTE_SIMD 0
+#endif
+#endif
+// Vector code only pays for itself on longer lists
+#define COIN_PERMUTE_SIMD_MINIMUM 32
+#if COIN_PERMUTE_SIMD
+#include <immintrin.h>
+// 0 not known, 1 no, 2 AVX-512F
+static int coinPermuteSimdLevel = 0;
+static inline bool coinPermuteSimd()
+{
+  if (!coinPermuteSimdLevel) {
+    __builtin_cpu_init();
+    coinPermuteSimdLevel = __builtin_cpu_supports("avx512f") ? 2 : 1;
+  }
+  return coinPermuteSimdLevel==2;
+}
+__attribute__((target("avx512f"))) static int
+coinPermuteScatterAvx512(const int * COIN_RESTRICT permute,
+			 const int * index, int number,
+			 double * COIN_RESTRICT in, bool packed,
+			 double * COIN_RESTRICT out, int * outIndex,
+			 const double * COIN_RESTRICT scale,
+			 int * firstLast)
+{
+  const __m512d zero = _mm512_setzero_pd();
+  __m512i vFirst = _mm512_set1_epi32(firstLast ? firstLast[0] : 0);
+  __m512i vLast = _mm512_set1_epi32(firstLast ? firstLast[1] : 0);
+  int j = 0;
+  for ( ; j + 16 <= number; j += 16) {
+    __m512i ipt = _mm512_loadu_si512(index+j);
+    __m512i irow = _mm512_i32gather_epi32(ipt, permute, 4);
+    __m256i ipt0 = _mm512_castsi512_si256(ipt);
+    __m256i ipt1 = _mm512_extracti64x4_epi64(ipt, 1);
+    __m256i irow0 = _mm512_castsi512_si256(irow);
+    __m256i irow1 = _mm512_extracti64x4_epi64(irow, 1);
+    __m512d value0;
+    __m512d value1;
+    if (packed) {
+      value0 = _mm512_loadu_pd(in+j);
+      value1 = _mm512_loadu_pd(in+j+8);
+      _mm512_storeu_pd(in+j, zero);
+      _mm512_storeu_pd(in+j+8, zero);
+    } else {
+      value0 = _mm512_i32gather_pd(ipt0, in, 8);
+      value1 = _mm512_i32gather_pd(ipt1, in, 8);
+      _mm512_i32scatter_pd(in, ipt0, zero, 8);
+      _mm512_i32scatter_pd(in, ipt1, zero, 8);
+    }
+    if (scale) {
+      value0 = _mm512_mul_pd(value0, _mm512_i32gather_pd(irow0, scale, 8));
+      value1 = _mm512_mul_pd(value1, _mm512_i32gather_pd(irow1, scale, 8));
+    }
+    _mm512_i32scatter_pd(out, irow0, value0, 8);
+    _mm512_i32scatter_pd(out, irow1, value1, 8);
+    if (outIndex)
+      _mm512_storeu_si512(outIndex+j, irow);
+    vFirst = _mm512_min_epi32(vFirst, irow);
+    vLast = _mm512_max_epi32(vLast, irow);
+  }
+  if (firstLast) {
+    firstLast[0] = _mm512_reduce_min_epi32(vFirst);
+    firstLast[1] = _mm512_reduce_max_epi32(vLast);
+  }
+  return j;
+}
+/* Returns number kept, done gives number looked at */
+__attribute__((target("avx512f"))) static int
+coinPermuteGatherAvx512(const int * COIN_RESTRICT permute,
+			const int * COIN_RESTRICT index, int number,
+			double * COIN_RESTRICT in, double * COIN_RESTRICT out,
+			bool packed, int * COIN_RESTRICT outIndex,
+			double tolerance, int type, int & done)
+{
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d tol = _mm512_set1_pd(tolerance);
+  const __m512i absMask = _mm512_set1_epi64(0x7fffffffffffffffLL);
+  const __m512i step = _mm512_setr_epi32(0,1,2,3,4,5,6,7,
+					 8,9,10,11,12,13,14,15);
+  int numberKept = 0;
+  int j = 0;
+  for ( ; j + 16 <= number; j += 16) {
+    __m512i ipt = _mm512_loadu_si512(index+j);
+    __m256i ipt0 = _mm512_castsi512_si256(ipt);
+    __m256i ipt1 = _mm512_extracti64x4_epi64(ipt, 1);
+    __m512d value0 = _mm512_i32gather_pd(ipt0, in, 8);
+    __m512d value1 = _mm512_i32gather_pd(ipt1, in, 8);
+    _mm512_i32scatter_pd(in, ipt0, zero, 8);
+    _mm512_i32scatter_pd(in, ipt1, zero, 8);
+    __mmask8 keep0 = 0xff;
+    __mmask8 keep1 = 0xff;
+    if (type) {
+      __m512d abs0 = _mm512_castsi512_pd
+	(_mm512_and_epi64(_mm512_castpd_si512(value0), absMask));
+      __m512d abs1 = _mm512_castsi512_pd
+	(_mm512_and_epi64(_mm512_castpd_si512(value1), absMask));
+      if (type==1) {
+	keep0 = _mm512_cmp_pd_mask(abs0, tol, _CMP_GT_OQ);
+	keep1 = _mm512_cmp_pd_mask(abs1, tol, _CMP_GT_OQ);
+      } else {
+	keep0 = _mm512_cmp_pd_mask(abs0, tol, _CMP_GE_OQ);
+	keep1 = _mm512_cmp_pd_mask(abs1, tol, _CMP_GE_OQ);
+	keep0 = _mm512_mask_cmp_pd_mask(keep0, abs0, zero, _CMP_NEQ_OQ);
+	keep1 = _mm512_mask_cmp_pd_mask(keep1, abs1, zero, _CMP_NEQ_OQ);
+      }
+    }
+    __mmask16 keep = static_cast<__mmask16>(keep0 | (keep1<<8));
+    if (!keep)
+      continue;
+    __m512i irow;
+    if (permute)
+      irow = _mm512_mask_i32gather_epi32(ipt, keep, ipt, permute, 4);
+    else
+      irow = _mm512_add_epi32(step, _mm512_set1_epi32(j));
+    _mm512_mask_compressstoreu_epi32(outIndex+numberKept, keep, irow);
+    if (packed) {
+      _mm512_mask_compressstoreu_pd(out+numberKept, keep0, value0);
+      numberKept += __builtin_popcount(keep0);
+      _mm512_mask_compressstoreu_pd(out+numberKept, keep1, value1);
+      numberKept += __builtin_popcount(keep1);
+    } else {
+      _mm512_mask_i32scatter_pd(out, keep0, _mm512_castsi512_si256(irow),
+				value0, 8);
+      _mm512_mask_i32scatter_pd(out, keep1,
+				_mm512_extracti64x4_epi64(irow, 1),
+				value1, 8);
+      numberKept += __builtin_popcount(keep);
+    }
+  }
+  done = j;
+  return numberKept;
+}
+#endif
+
+void CoinPermuteScatter(const int * permute, const int * index, int number,
+			double * in, bool packed, double * out,
+			int * outIndex, const double * scale, int * firstLast)
+{
+  int j = 0;
+#if COIN_PERMUTE_SIMD
+  if (number >= COIN_PERMUTE_SIMD_MINIMUM && coinPermuteSimd())
+    j = coinPermuteScatterAvx512(permute, index, number, in, packed, out,
+				 outIndex, scale, firstLast);
+#endif
+  int first = firstLast ? firstLast[0] : 0;
+  int last = firstLast ? firstLast[1] : 0;
+  for ( ; j < number; j++) {
+    int iRow = index[j];
+    int where = packed ? j : iRow;
+    double value = in[where];
+    in[where] = 0.0;
+    iRow = permute[iRow];
+    if (scale)
+      value *= scale[iRow];
+    out[iRow] = value;
+    if (outIndex)
+      outIndex[j] = iRow;
+    first = CoinMin(first, iRow);
+    last = CoinMax(last, iRow);
+  }
+  if (firstLast) {
+    firstLast[0] = first;
+    firstLast[1] = last;
+  }
+}
+
+int CoinPermuteGather(const int * permute, const int * index, int number,
+		      double * in, double * out, bool packed, int * outIndex,
+		      double tolerance, int type)
+{
+  int j = 0;
+  int numberKept = 0;
+#if COIN_PERMUTE_SIMD
+  if (number >= COIN_PERMUTE_SIMD_MINIMUM && coinPermuteSimd())
+    numberKept = coinPermuteGatherAvx512(permute, index, number, in, out,
+					 packed, outIndex, tolerance, type, j);
+#endif
+  for ( ; j < number; j++) {
+    int iRow = index[j];
+    double value = in[iRow];
+    in[iRow] = 0.0;
+    if (type==1) {
+      if (!(fabs(value) > tolerance))
+	continue;
+    } else if (type==2) {
+      if (!value || !(fabs(value) >= tolerance))
+	continue;
+    }
+    iRow = permute ? permute[iRow] : j;
+    outIndex[numberKept] = iRow;
+    out[packed ? numberKept : iRow] = value;
+    numberKept++;
+  }
+  return numberKept;
+}
@@ -0,0 +1,44 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPermute_H
+#define CoinPermute_H
+
+/*! \file CoinPermute.hpp
+  \brief Permutation of sparse lists between dense arrays
+
+  The passes at the start and end of FTRAN and BTRAN in the factorizations
+  move each entry of a list through a permutation from one dense array to
+  another and zero where it came from.  These functions do that for lists
+  of any length; with 32 or more entries they use AVX-512F gathers and
+  scatters if the machine has them (chosen at run time - building with
+  COIN_PERMUTE_SIMD defined as 0 switches that off).  AVX2 has no scatter
+  so only the scalar loop is used there.
+
+  Entries of \p index must be distinct and \p permute one to one, so no two
+  lanes of a scatter go to the same place.  \p in and \p out must be
+  different arrays.
+*/
+
+/** For each j < number with i = index[j] and k = permute[i]:
+    out[k] = in[packed ? j : i] (times scale[k] if \p scale), the entry of
+    \p in is zeroed and, if \p outIndex, outIndex[j] = k (outIndex may be
+    index).  If \p firstLast it is updated with the smallest (firstLast[0])
+    and largest (firstLast[1]) k. */
+void CoinPermuteScatter(const int * permute, const int * index, int number,
+			double * in, bool packed, double * out,
+			int * outIndex = 0, const double * scale = 0,
+			int * firstLast = 0);
+
+/** For each j < number with i = index[j]: value = in[i] and in[i] is
+    zeroed.  If value is kept, k = permute ? permute[i] : j is added to
+    outIndex and value put in out[packed ? position in outIndex : k].
+    \p type says what is kept - 0 everything, 1 fabs(value) > tolerance
+    and 2 nonzero with fabs(value) >= tolerance.  Returns number kept. */
+int CoinPermuteGather(const int * permute, const int * index, int number,
+		      double * in, double * out, bool packed, int * outIndex,
+		      double tolerance = 0.0, int type = 0);
+
+#endif
@@ -58,6 +58,24 @@ CoinPostsolveMatrix::~CoinPostsolveMatrix()
 
   return ; }
 
+/*
+  Postsolve transforms take a missing dual array to mean that only primal
+  values are wanted, and a missing status array to mean no basis. rowstat_
+  shares its block with colstat_.
+*/
+
+void CoinPostsolveMatrix::setPrimalOnly ()
+
+{ delete[] rowduals_ ;
+  rowduals_ = 0 ;
+  delete[] rcosts_ ;
+  rcosts_ = 0 ;
+  delete[] colstat_ ;
+  colstat_ = 0 ;
+  rowstat_ = 0 ;
+
+  return ; }
+
 /*
   This routine loads a CoinPostsolveMatrix object from a CoinPresolveMatrix
   object. The CoinPresolveMatrix object will be stripped, its components
@@ -140,6 +158,7 @@ CoinPostsolveMatrix::assignPresolveToPostsolve (CoinPresolveMatrix *&preObj)
   handler_ = preObj->handler_ ;
   preObj->defaultHandler_ = false ;
   messages_ = preObj->messages_ ;
+  profile_ = preObj->profile_ ;
 /*
   Initialise the postsolve portions of this object. Which amounts to setting
   up the thread links to match the column-major matrix representation. This
@@ -82,7 +82,8 @@ CoinPrePostsolveMatrix::CoinPrePostsolveMatrix
 
     handler_(0),
     defaultHandler_(false),
-    messages_()
+    messages_(),
+    profile_(0)
 
 { handler_ = new CoinMessageHandler() ;
   defaultHandler_ = true ;
@@ -0,0 +1,321 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <stdio.h>
+#include <math.h>
+
+#include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveFixed.hpp"
+#include "CoinPresolveDominated.hpp"
+#include "CoinInstrument.hpp"
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#if PRESOLVE_DEBUG || PRESOLVE_CONSISTENCY
+#include "CoinPresolvePsdebug.hpp"
+#endif
+
+namespace {
+
+/*
+  Row types, with each row written as a <= constraint.
+*/
+const int ROW_LE = 1 ;		// only the upper bound is finite
+const int ROW_GE = -1 ;		// only the lower bound is finite
+const int ROW_EQ = 0 ;		// both finite (equality or range)
+const int ROW_FREE = 2 ;	// neither finite
+
+/*
+  Type of row i, from its bounds.
+*/
+inline int row_type (int i, const double *rlo, const double *rup)
+{
+  const bool finiteLo = (rlo[i] > -PRESOLVE_INF) ;
+  const bool finiteUp = (rup[i] < PRESOLVE_INF) ;
+  if (finiteLo && finiteUp)
+    return (ROW_EQ) ;
+  else if (finiteUp)
+    return (ROW_LE) ;
+  else if (finiteLo)
+    return (ROW_GE) ;
+  else
+    return (ROW_FREE) ;
+}
+
+/*
+  Check a(ij) against a(ik) in a row of the given type.
+*/
+inline bool row_ok (int rowType, double aij, double aik)
+{
+  if (rowType == ROW_EQ)
+    return (fabs(aij-aik) <= ZTOLDP) ;
+  else if (rowType == ROW_LE)
+    return (aij <= aik+ZTOLDP) ;
+  else if (rowType == ROW_GE)
+    return (aij >= aik-ZTOLDP) ;
+  else
+    return (true) ;
+}
+
+/*
+  Row signatures of x(j). Bit (i mod 64) of pos is set if x(j) has a
+  positive coefficient in some row i written as <=, of neg if negative. Rows
+  with two finite bounds go in both, as the coefficients must be equal.
+*/
+void signature (int j, const CoinBigIndex *mcstrt, const int *hincol,
+		const int *hrow, const double *colels,
+		const double *rlo, const double *rup,
+		CoinUInt64 &pos, CoinUInt64 &neg)
+{
+  pos = 0 ;
+  neg = 0 ;
+  const CoinBigIndex kjs = mcstrt[j] ;
+  const CoinBigIndex kje = kjs+hincol[j] ;
+  for (CoinBigIndex kj = kjs ; kj < kje ; kj++) {
+    const int i = hrow[kj] ;
+    const CoinUInt64 bit = static_cast<CoinUInt64>(1)<<(i&63) ;
+    const double aij = colels[kj] ;
+    const int rowType = row_type(i,rlo,rup) ;
+    if (rowType == ROW_EQ) {
+      pos |= bit ;
+      neg |= bit ;
+    } else if (rowType != ROW_FREE) {
+      if (rowType*aij > 0.0)
+	pos |= bit ;
+      else if (rowType*aij < 0.0)
+	neg |= bit ;
+    }
+  }
+}
+
+/*
+  Check whether x(j) dominates x(k) row by row. Both columns must be sorted
+  by row index, so that they can be merged. A zero coefficient counts as an
+  absent one.
+*/
+bool dominates (int j, int k,
+		const CoinBigIndex *mcstrt, const int *hincol,
+		const int *hrow, const double *colels,
+		const double *rlo, const double *rup)
+{
+  CoinBigIndex kj = mcstrt[j] ;
+  const CoinBigIndex kje = kj+hincol[j] ;
+  CoinBigIndex kk = mcstrt[k] ;
+  const CoinBigIndex kke = kk+hincol[k] ;
+  while (kj < kje || kk < kke) {
+    const int ij = (kj < kje) ? hrow[kj] : COIN_INT_MAX ;
+    const int ik = (kk < kke) ? hrow[kk] : COIN_INT_MAX ;
+    double aij = 0.0 ;
+    double aik = 0.0 ;
+    int i ;
+    if (ij <= ik) {
+      i = ij ;
+      aij = colels[kj++] ;
+      if (ij == ik)
+	aik = colels[kk++] ;
+    } else {
+      i = ik ;
+      aik = colels[kk++] ;
+    }
+    if (!row_ok(row_type(i,rlo,rup),aij,aik))
+      return (false) ;
+  }
+  return (true) ;
+}
+
+}	// end unnamed namespace
+
+const char *dominated_col_action::name () const
+{
+  return ("dominated_col_action") ;
+}
+
+const CoinPresolveAction
+  *dominated_col_action::presolve (CoinPresolveMatrix *prob,
+				   const CoinPresolveAction *next,
+				   int maxRowLength)
+{
+  COIN_TIME_SCOPE("presolve.dominated_col");
+  if (prob->workExhausted()) return (next) ;
+
+# if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
+# if PRESOLVE_DEBUG > 0
+  std::cout << "Entering dominated_col_action::presolve." << std::endl ;
+# endif
+  presolve_consistent(prob) ;
+  presolve_links_ok(prob) ;
+  presolve_check_sol(prob) ;
+  presolve_check_nbasic(prob) ;
+# endif
+
+  double *colels = prob->colels_ ;
+  int *hrow = prob->hrow_ ;
+  const CoinBigIndex *mcstrt = prob->mcstrt_ ;
+  const int *hincol = prob->hincol_ ;
+
+  const int *hcol = prob->hcol_ ;
+  const CoinBigIndex *mrstrt = prob->mrstrt_ ;
+  const int *hinrow = prob->hinrow_ ;
+
+  const double *clo = prob->clo_ ;
+  const double *cup = prob->cup_ ;
+  const double *rlo = prob->rlo_ ;
+  const double *rup = prob->rup_ ;
+  const double *cost = prob->cost_ ;
+  const double maxmin = prob->maxmin_ ;
+  const unsigned char *integerType = prob->integerType_ ;
+
+/*
+  Look at each column x(k) on the ToDo list as the dominated column, with
+  candidates for x(j) taken from the shortest constrained row of x(k).
+  Nothing here is proportional to the size of the matrix, so a late pass
+  with a short ToDo list is cheap.
+*/
+  const int numberLook = prob->numberColsToDo_ ;
+  const int *look = prob->colsToDo_ ;
+  action *actions = new action [numberLook] ;
+  int nactions = 0 ;
+  int *fixLower = new int [numberLook] ;
+  int nFixLower = 0 ;
+  int *fixUpper = new int [numberLook] ;
+  int nFixUpper = 0 ;
+  for (int iLook = 0 ; iLook < numberLook ; iLook++) {
+    if (prob->workExhausted()) break ;
+    const int k = look[iLook] ;
+    const int lenk = hincol[k] ;
+    if (lenk == 0 || prob->colProhibited2(k) || prob->colUsed(k) ||
+	clo[k] == cup[k]) continue ;
+    const CoinBigIndex kks = mcstrt[k] ;
+    const CoinBigIndex kke = kks+lenk ;
+    int bestRow = -1 ;
+    int bestLength = maxRowLength+1 ;
+    for (CoinBigIndex kk = kks ; kk < kke ; kk++) {
+      const int i = hrow[kk] ;
+      if (row_type(i,rlo,rup) != ROW_FREE && hinrow[i] < bestLength) {
+	bestRow = i ;
+	bestLength = hinrow[i] ;
+      }
+    }
+    if (bestRow < 0) continue ;
+    prob->addWork(lenk+bestLength) ;
+
+    const double ck = cost[k]*maxmin ;
+    const bool lowerFinite = (clo[k] > -PRESOLVE_INF) ;
+    CoinUInt64 posk ;
+    CoinUInt64 negk ;
+    signature(k,mcstrt,hincol,hrow,colels,rlo,rup,posk,negk) ;
+    bool sortedk = false ;
+
+    const CoinBigIndex krs = mrstrt[bestRow] ;
+    const CoinBigIndex kre = krs+hinrow[bestRow] ;
+    for (CoinBigIndex kr = krs ; kr < kre ; kr++) {
+      const int j = hcol[kr] ;
+      if (j == k || prob->colProhibited2(j) || prob->colUsed(j) ||
+	  clo[j] == cup[j]) continue ;
+/*
+  Is there a reduction to be had if x(j) dominates x(k)?
+*/
+      const bool upperFinite = (cup[j] < PRESOLVE_INF) ;
+      if (lowerFinite == upperFinite) continue ;
+      if (lowerFinite && integerType[j] && !integerType[k]) continue ;
+      if (upperFinite && integerType[k] && !integerType[j]) continue ;
+      if (cost[j]*maxmin > ck+ZTOLDP) continue ;
+      CoinUInt64 posj ;
+      CoinUInt64 negj ;
+      signature(j,mcstrt,hincol,hrow,colels,rlo,rup,posj,negj) ;
+      prob->addWork(hincol[j]) ;
+      if ((posj&~posk) != 0 || (negk&~negj) != 0)
+	continue ;
+/*
+  Sort both columns by row index (the order within a column doesn't matter
+  to presolve) and merge them.
+*/
+      if (!sortedk) {
+	CoinSort_2(hrow+kks,hrow+kke,colels+kks) ;
+	sortedk = true ;
+      }
+      CoinSort_2(hrow+mcstrt[j],hrow+mcstrt[j]+hincol[j],colels+mcstrt[j]) ;
+      prob->addWork(hincol[j]+lenk) ;
+      if (!dominates(j,k,mcstrt,hincol,hrow,colels,rlo,rup))
+	continue ;
+
+      PRESOLVE_DETAIL_PRINT(printf("pre_dominated %dC %dC E\n",k,j)) ;
+      action &f = actions[nactions++] ;
+      f.dominated = k ;
+      f.dominating = j ;
+      if (lowerFinite)
+	fixLower[nFixLower++] = k ;
+      else
+	fixUpper[nFixUpper++] = j ;
+      prob->setColUsed(k) ;
+      prob->setColUsed(j) ;
+      break ;
+    }
+  }
+
+  for (int i = 0 ; i < nactions ; i++) {
+    prob->unsetColUsed(actions[i].dominated) ;
+    prob->unsetColUsed(actions[i].dominating) ;
+  }
+
+# if PRESOLVE_SUMMARY || PRESOLVE_DEBUG
+  if (nactions > 0)
+  { printf("DOMINATED COLS: %d lb, %d ub\n",nFixLower,nFixUpper) ; }
+# endif
+/*
+  Fix the columns. The make_fixed_action objects are kept inside this one
+  rather than linked into the postsolve list.
+*/
+  if (nactions) {
+    const CoinPresolveAction *lower = 0 ;
+    const CoinPresolveAction *upper = 0 ;
+    if (nFixLower)
+      lower = make_fixed_action::presolve(prob,fixLower,nFixLower,true,0) ;
+    if (nFixUpper)
+      upper = make_fixed_action::presolve(prob,fixUpper,nFixUpper,false,0) ;
+    next = new dominated_col_action(nactions,
+				    CoinPresolveCopyOfArray(prob,actions,nactions),
+				    lower,upper,next) ;
+  }
+  deleteAction(actions,action*) ;
+  delete [] fixLower ;
+  delete [] fixUpper ;
+
+# if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
+  presolve_consistent(prob) ;
+  presolve_links_ok(prob) ;
+  presolve_check_sol(prob) ;
+  presolve_check_nbasic(prob) ;
+# if PRESOLVE_DEBUG > 0
+  std::cout << "Leaving dominated_col_action::presolve." << std::endl ;
+# endif
+# endif
+
+  return (next) ;
+}
+
+/*
+  Undo the fixings in the reverse of the order they were made.
+*/
+void dominated_col_action::postsolve (CoinPostsolveMatrix *prob) const
+{
+# if PRESOLVE_DEBUG > 0
+  std::cout
+    << "Entering dominated_col_action::postsolve, " << nactions_
+    << " pairs." << std::endl ;
+# endif
+  if (fixUpper_) fixUpper_->postsolve(prob) ;
+  if (fixLower_) fixLower_->postsolve(prob) ;
+# if PRESOLVE_DEBUG > 0
+  std::cout << "Leaving dominated_col_action::postsolve." << std::endl ;
+# endif
+}
+
+dominated_col_action::~dominated_col_action ()
+{
+  delete fixLower_ ;
+  delete fixUpper_ ;
+  deleteAction(actions_,action*) ;
+}
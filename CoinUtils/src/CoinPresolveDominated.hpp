@@ -0,0 +1,96 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPresolveDominated_H
+#define CoinPresolveDominated_H
+
+#include "CoinPresolveMatrix.hpp"
+
+/*!
+  \file
+*/
+
+#define	DOMINATED_COL	12
+
+/*! \class dominated_col_action
+    \brief Detect dominated columns and fix them at a bound
+
+    Write each row with a single finite bound as a <= constraint. Column
+    x(j) dominates column x(k) if c(j) <= c(k) (for minimisation),
+    a(ij) <= a(ik) in every such row, and a(ij) = a(ik) in every row with
+    two finite bounds (equalities and ranges). Moving some amount from
+    x(k) to x(j) then keeps every row feasible and doesn't make the
+    objective worse, so there is an optimal solution with x(j) at its upper
+    bound or x(k) at its lower bound. That gives two reductions:
+    <ul>
+      <li> if u(j) is infinite and l(k) finite, fix x(k) at l(k);
+      <li> if l(k) is infinite and u(j) finite, fix x(j) at u(j).
+    </ul>
+    If x(j) is integer, x(k) must be integer for the first; if x(k) is
+    integer, x(j) must be integer for the second.
+
+    Only columns which share a row are compared. Candidates x(k) are the
+    columns on the column ToDo list, and for each we look along its
+    shortest constrained row. Each column carries two
+    64-bit row signatures (rows where the normalised coefficient is
+    positive, and negative); a pair goes on to the full comparison only if
+    the positive signature of x(j) is contained in that of x(k) and the
+    negative signature of x(k) in that of x(j). A column takes part in at
+    most one reduction per call.
+
+    The fixing itself is done by make_fixed_action, and postsolve hands
+    back to it. The reduced cost of the fixed column has the right sign:
+    d(k) >= d(j) >= 0 in the first case, d(j) <= d(k) <= 0 in the second.
+*/
+
+class dominated_col_action : public CoinPresolveAction {
+  dominated_col_action();
+  dominated_col_action(const dominated_col_action& rhs);
+  dominated_col_action& operator=(const dominated_col_action& rhs);
+
+  /// A dominated pair: \p dominated fixed at lower, or \p dominating at upper
+  struct action {
+    int dominated;
+    int dominating;
+  };
+
+  const int nactions_;
+  // actions_ is owned by the class and must be deleted at destruction
+  const action *const actions_;
+  /// Fixes to lower bound (may be NULL)
+  const CoinPresolveAction *fixLower_;
+  /// Fixes to upper bound, made after fixLower_ (may be NULL)
+  const CoinPresolveAction *fixUpper_;
+
+  dominated_col_action(int nactions, const action *actions,
+		       const CoinPresolveAction *fixLower,
+		       const CoinPresolveAction *fixUpper,
+		       const CoinPresolveAction *next) :
+      CoinPresolveAction(next),
+      nactions_(nactions),
+      actions_(actions),
+      fixLower_(fixLower),
+      fixUpper_(fixUpper) {}
+
+ public:
+  /// Returns string "dominated_col_action".
+  const char *name() const;
+
+  /*! \brief Look for dominated columns and fix them
+
+    Rows with more than \p maxRowLength coefficients are not used to find
+    candidates.
+  */
+  static const CoinPresolveAction *presolve(CoinPresolveMatrix *prob,
+					 const CoinPresolveAction *next,
+					 int maxRowLength = 100);
+
+  void postsolve(CoinPostsolveMatrix *prob) const;
+
+  virtual ~dominated_col_action();
+
+};
+
+#endif
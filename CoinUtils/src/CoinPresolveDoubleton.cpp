@@ -9,6 +9,7 @@
 #include "CoinFinite.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
+#include "CoinInstrument.hpp"
 
 #include "CoinPresolveEmpty.hpp"	// for DROP_COL/DROP_ROW
 #include "CoinPresolveZeros.hpp"
@@ -69,7 +70,7 @@ bool elim_doubleton (const char *DBGPARAM(msg),
 		     double *colels,
 		     int *hrow, int *hcol,
 		     int *hinrow, int *hincol,
-		     presolvehlink *clink, int ncols,
+		     presolvehlink *clink, presolvehspace *cspace, int ncols,
 		     CoinBigIndex *mrstrt, double *rowels,
 		     double coeff_factor,
 		     double bounds_factor,
@@ -123,7 +124,7 @@ bool elim_doubleton (const char *DBGPARAM(msg),
 */
     } else {
       const bool no_mem = presolve_expand_col(mcstrt,colels,hrow,hincol,
-					      clink,ncols,icolx) ;
+					      clink,ncols,icolx,cspace) ;
       if (no_mem) return (true) ;
 	  
       kcsx = mcstrt[icolx] ;
@@ -242,6 +243,7 @@ const CoinPresolveAction
 			      const CoinPresolveAction *next)
 
 {
+  COIN_TIME_SCOPE("presolve.doubleton");
 # if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 # if PRESOLVE_DEBUG > 0
   std::cout
@@ -725,7 +727,7 @@ const CoinPresolveAction
     bool no_mem = elim_doubleton("ELIMD",
 				 colStarts,rlo,rup,colCoeffs,
 				 rowIndices,colIndices,rowLengths,colLengths,
-				 clink,n, 
+				 clink,&prob->cspace_,n, 
 				 rowStarts,rowCoeffs,
 				 -coeffx/coeffy,
 				 rhs/coeffy,
@@ -759,7 +761,7 @@ const CoinPresolveAction
 #   if PRESOLVE_SUMMARY > 0
     printf("NDOUBLETONS:  %d\n", nactions) ;
 #   endif
-    action *actions1 = new action[nactions] ;
+    action *actions1 = CoinPresolveNewArray<action>(prob, nactions) ;
     CoinMemcpyN(actions, nactions, actions1) ;
 
     next = new doubleton_action(nactions, actions1, next) ;
@@ -1001,7 +1003,8 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 
 	acts[i] += (yValue*rhs)/coeffy ;
 
-	djy -= rowduals[i]*yValue ;
+	if (rowduals)
+	  djy -= rowduals[i]*yValue ;
 /*
   Link the coefficient into column y: Acquire the first free slot in the
   bulk arrays and store the row index and coefficient. Then link the slot
@@ -1073,7 +1076,8 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	  colels[kcs] = value ;
 	  last_nonzero = kcs ;
 	  kcs = link[kcs] ;
-	  djx -= rowduals[i]*value ;
+	  if (rowduals)
+	    djx -= rowduals[i]*value ;
 
 #         if PRESOLVE_DEBUG > 4
 	  std::cout
@@ -1115,7 +1119,7 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	double xValue = element1[i] ;
 	element1[i] = 0.0 ;
 	if (fabs(xValue) >= 1.0e-15) {
-	  if (i != irow)
+	  if (rowduals && i != irow)
 	    djx -= rowduals[i]*xValue ;
 	  numberInColumn++ ;
 	  CoinBigIndex kfree = free_list ;
@@ -1203,7 +1207,8 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	link[k] = xstart ;
 	xstart = k ;
 
-	djx -= rowduals[i]*xValue ;
+	if (rowduals)
+	  djx -= rowduals[i]*xValue ;
 
 	xValue = (xValue*coeffy)/coeffx ;
 	if (!element1[i]) {
@@ -1290,7 +1295,8 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	  
 	  acts[row] += (coeff*rhs)/coeffy ;
 	  
-	  djy -= rowduals[row]*coeff ;
+	  if (rowduals)
+	    djy -= rowduals[row]*coeff ;
 	}
       }
     }
@@ -1403,7 +1409,7 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
       assert(!prob->columnIsBasic(jcoly) || (fabs(rcosts[jcoly]) < 1.0e-5)) ;
 */
 #     endif
-    } else {
+    } else if (rowduals) {
       // No status array
       // this is the coefficient we need to force col y's reduced cost to 0.0 ;
       // for example, this is obviously true if y is a singleton column
@@ -1424,7 +1430,7 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 /*
   Confirm accuracy of reduced cost for columns x and y.
 */
-    {
+    if (rowduals) {
       CoinBigIndex k = mcstrt[jcolx] ;
       const int nx = hincol[jcolx] ;
       double dj = maxmin*dcost[jcolx] ;
@@ -1440,7 +1446,7 @@ void doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	       irow,jcolx,rcosts[jcolx],dj) ;
       rcosts[jcolx] = dj ;
     }
-    {
+    if (rowduals) {
       CoinBigIndex k = mcstrt[jcoly] ;
       const int ny = hincol[jcoly] ;
       double dj = maxmin*dcost[jcoly] ;
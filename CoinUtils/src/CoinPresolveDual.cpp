@@ -9,6 +9,7 @@
 #include "CoinPresolveMatrix.hpp"
 #include "CoinPresolveFixed.hpp"
 #include "CoinPresolveDual.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinMessage.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinFloatEqual.hpp"
@@ -132,6 +133,7 @@ const CoinPresolveAction
   *remove_dual_action::presolve (CoinPresolveMatrix *prob,
 				 const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.remove_dual");
 # if PRESOLVE_DEBUG > 0
   std::cout
     << "Entering remove_dual_action::presolve, " << prob->nrows_ 
@@ -1531,7 +1533,7 @@ const CoinPresolveAction
   the postsolve object.
 */
   if (makeEqCnt > 0) {
-    action *bndRecords = new action[makeEqCnt] ;
+    action *bndRecords = CoinPresolveNewArray<action>(prob, makeEqCnt) ;
     for (int k = 0 ; k < makeEqCnt ; k++) {
       const int i = canFix[k+nrows] ;
 #     if PRESOLVE_DEBUG > 1
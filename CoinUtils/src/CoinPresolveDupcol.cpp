@@ -12,33 +12,29 @@
 #include "CoinPresolveMatrix.hpp"
 #include "CoinPresolveFixed.hpp"
 #include "CoinPresolveDupcol.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinSort.hpp"
 #include "CoinFinite.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveUseless.hpp"
+#include "CoinPackedMatrixDuplicates.hpp"
 #include "CoinMessage.hpp"
 #if PRESOLVE_DEBUG || PRESOLVE_CONSISTENCY
 #include "CoinPresolvePsdebug.hpp"
 #endif
 
-#define DSEED2 2147483647.0
+#define USE_LBS 0
+#define SWAP_SIGNS 0
 // Can be used from anywhere
 void coin_init_random_vec(double *work, int n)
 {
-  double deseed = 12345678.0;
-
-  for (int i = 0; i < n; ++i) {
-    deseed *= 16807.;
-    int jseed = static_cast<int> (deseed /    DSEED2);
-    deseed -= static_cast<double> (jseed) * DSEED2;
-    double random = deseed /  DSEED2;
-
-    work[i]=random;
-  }
+  CoinCounterRandom random(12345678) ;
+  random.fillDoubles(work,n) ;
 }
 
 namespace {	// begin unnamed file-local namespace
 
+#if SWAP_SIGNS
 /*
   For each candidate major-dimension vector in majcands, calculate the sum
   over the vector, with each minor dimension weighted by a random amount.
@@ -66,6 +62,7 @@ namespace {	// begin unnamed file-local namespace
     majsums[cndx] = value ; }
 
   return ; }
+#endif
 
 
 void create_col (int col, int n, double *els,
@@ -127,6 +124,7 @@ const CoinPresolveAction
     *dupcol_action::presolve (CoinPresolveMatrix *prob,
 			      const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.dupcol");
 # if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 # if PRESOLVE_DEBUG > 0
   std::cout
@@ -138,6 +136,9 @@ const CoinPresolveAction
   presolve_check_nbasic(prob) ;
 # endif
 
+  if (prob->workExhausted())
+    return (next) ;
+
 # if PRESOLVE_DEBUG > 0 || COIN_PRESOLVE_TUNING > 0
   int startEmptyRows = 0 ;
   int startEmptyColumns = 0 ;
@@ -179,8 +180,10 @@ const CoinPresolveAction
   bool allowIntegers = ((prob->presolveOptions_&0x01) != 0) ;
   int *sort = prob->usefulColumnInt_; //new int[ncols] ;
   int nlook = 0 ;
+  double work = 0.0 ;
   for (int j = 0 ; j < ncols ; j++) {
     if (hincol[j] == 0) continue ;
+    work += hincol[j] ;
     // sort
     CoinSort_2(hrow+mcstrt[j],hrow+mcstrt[j]+hincol[j],
 	       colels+mcstrt[j]);
@@ -208,10 +211,17 @@ const CoinPresolveAction
     if (prob->isInteger(j)&&!allowIntegers) continue ;
 #endif
     sort[nlook++] = j ; }
+/*
+  Count the scan, and finding candidate classes (another pass over the same
+  coefficients).
+*/
+  prob->addWork(2.0*work) ;
   if (nlook == 0)
     { //delete[] sort ;
       //delete [] rhs;
     return (next) ; }
+  double *colsum = prob->usefulColumnDouble_; //new double[ncols] ;
+#if SWAP_SIGNS
 /*
   Prep: add the coefficients of each candidate column. To reduce false
   positives, multiply each row by a `random' multiplier when forming the
@@ -219,7 +229,6 @@ const CoinPresolveAction
   indices and column sums, respectively, of candidate columns.  The pair of
   arrays are then sorted by sum so that equal sums are adjacent.
 */
-  double *colsum = prob->usefulColumnDouble_; //new double[ncols] ;
   double *rowmul;
   if (!prob->randomNumber_) {
     rowmul = new double[nrows] ;
@@ -228,9 +237,6 @@ const CoinPresolveAction
     rowmul = prob->randomNumber_;
   }
   compute_sums(ncols,hincol,mcstrt,hrow,colels,rowmul,sort,colsum,nlook) ;
-#define USE_LBS 0
-#define SWAP_SIGNS 0
-#if SWAP_SIGNS
   int nPiece=0;
   // array to chain piecewise linear
   int * piece = new int [ncols];
@@ -244,8 +250,28 @@ const CoinPresolveAction
     compute_sums(ncols,hincol,mcstrt,hrow,colels,rowmul,sort+nlook,colsum+nlook,nlook) ;
     nlook += nlook;
   }
-#endif
   CoinSort_2(colsum,colsum+nlook,sort) ;
+#else
+/*
+  Prep: find the classes of candidate columns which are identical (hashed
+  and then checked exactly by CoinPackedMatrixDuplicates). Columns which
+  have no twin are dropped. On return sort holds the members of each class
+  next to each other and colsum the class number, so equal sums are
+  adjacent as the code below expects.
+*/
+  { CoinPackedMatrixDuplicates duplicates ;
+    duplicates.setNumberThreads(prob->numberThreads_) ;
+    duplicates.find(nrows,mcstrt,hincol,hrow,colels,nlook,sort) ;
+    const int *classStart = duplicates.classStarts() ;
+    const int *classMember = duplicates.classMembers() ;
+    nlook = 0 ;
+    for (int iClass = 0 ; iClass < duplicates.numberClasses() ; iClass++)
+    { for (int k = classStart[iClass] ; k < classStart[iClass+1] ; k++)
+      { sort[nlook] = classMember[k] ;
+	colsum[nlook++] = iClass ; } } }
+  if (nlook == 0)
+    return (next) ;
+#endif
 /*
   General prep --- unpack the various vectors we'll need, and allocate arrays
   to record the results.
@@ -312,7 +338,9 @@ const CoinPresolveAction
   int isorted = -1 ;
   int tgt = 0 ;
   for (int jj = 1 ;  jj < nlook ; jj++)
-    { if (colsum[jj] != colsum[jj-1]) {
+    { if (prob->workExhausted())
+	break ;
+      if (colsum[jj] != colsum[jj-1]) {
       tgt = jj; // Must update before continuing
       continue ;
     }
@@ -325,6 +353,7 @@ const CoinPresolveAction
     if (len2 != len1)
     { tgt = jj ;
       continue ; }
+    prob->addWork(len1+len2) ;
 /*
   The final test: sort the columns by row index and compare each index and
   coefficient.
@@ -809,9 +838,9 @@ const CoinPresolveAction
   What's left? Deallocate vectors, and call make_fixed_action to handle any
   variables that were fixed to bound.
 */
+#if SWAP_SIGNS
   if (rowmul != prob->randomNumber_)
     delete[] rowmul ;
-#if SWAP_SIGNS
   if (nPiece) {
     nPiece=0;
     int nTotal=0;
@@ -903,7 +932,7 @@ const CoinPresolveAction
 	   nactions,nfixed_down,nfixed_up) ; }
 # endif
   if (nactions)
-  { next = new dupcol_action(nactions,CoinCopyOfArray(actions,nactions),next) ;
+  { next = new dupcol_action(nactions,CoinPresolveCopyOfArray(prob,actions,nactions),next) ;
     // we can't go round again in integer
     prob->presolveOptions_ |= 0x80000000;
 }
@@ -960,6 +989,7 @@ void dupcol_action::postsolve(CoinPostsolveMatrix *prob) const
   int *link		= prob->link_;
 
   double *rcosts	= prob->rcosts_;
+  unsigned char *colstat = prob->colstat_;
   double tolerance = prob->ztolzb_;
 
   for (const action *f = &actions[nactions-1]; actions<=f; f--) {
@@ -990,37 +1020,45 @@ void dupcol_action::postsolve(CoinPostsolveMatrix *prob) const
 				 icol2,clo[icol2],sol[icol2],cup[icol2]));
     if (l_j>-PRESOLVE_INF&& x_k_sol-l_j>=l_k-tolerance&&x_k_sol-l_j<=u_k+tolerance) {
       // j at lb, leave k
-      prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atLowerBound);
+      if (colstat)
+	prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atLowerBound);
       sol[icol] = l_j;
       sol[icol2] = x_k_sol - sol[icol];
     } else if (u_j<PRESOLVE_INF&& x_k_sol-u_j>=l_k-tolerance&&x_k_sol-u_j<=u_k+tolerance) {
       // j at ub, leave k
-      prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atUpperBound);
+      if (colstat)
+	prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atUpperBound);
       sol[icol] = u_j;
       sol[icol2] = x_k_sol - sol[icol];
     } else if (l_k>-PRESOLVE_INF&& x_k_sol-l_k>=l_j-tolerance&&x_k_sol-l_k<=u_j+tolerance) {
       // k at lb make j basic
-      prob->setColumnStatus(icol,prob->getColumnStatus(icol2));
+      if (colstat)
+	prob->setColumnStatus(icol,prob->getColumnStatus(icol2));
       sol[icol2] = l_k;
       sol[icol] = x_k_sol - l_k;
-      prob->setColumnStatus(icol2,CoinPrePostsolveMatrix::atLowerBound);
+      if (colstat)
+	prob->setColumnStatus(icol2,CoinPrePostsolveMatrix::atLowerBound);
     } else if (u_k<PRESOLVE_INF&& x_k_sol-u_k>=l_j-tolerance&&x_k_sol-u_k<=u_j+tolerance) {
       // k at ub make j basic
-      prob->setColumnStatus(icol,prob->getColumnStatus(icol2));
+      if (colstat)
+	prob->setColumnStatus(icol,prob->getColumnStatus(icol2));
       sol[icol2] = u_k;
       sol[icol] = x_k_sol - u_k;
-      prob->setColumnStatus(icol2,CoinPrePostsolveMatrix::atUpperBound);
+      if (colstat)
+	prob->setColumnStatus(icol2,CoinPrePostsolveMatrix::atUpperBound);
     } else {
       // both free!  superbasic time
       sol[icol] = 0.0;	// doesn't matter
-      prob->setColumnStatus(icol,CoinPrePostsolveMatrix::isFree);
+      if (colstat)
+	prob->setColumnStatus(icol,CoinPrePostsolveMatrix::isFree);
     }
     PRESOLVE_DETAIL_PRINT(printf("post2 icol %d %g icol2 %d %g\n",
 	   icol,sol[icol],
 				 icol2,sol[icol2]));
     // row activity doesn't change
     // dj of both variables is the same
-    rcosts[icol] = rcosts[icol2];
+    if (rcosts)
+      rcosts[icol] = rcosts[icol2];
     // leave until destructor
     //    deleteAction(f->colels,double *);
 
@@ -1066,6 +1104,9 @@ const CoinPresolveAction
     *duprow_action::presolve (CoinPresolveMatrix *prob,
 			      const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.duprow");
+  if (prob->workExhausted())
+    return (next) ;
   double startTime = 0.0;
   int startEmptyRows=0;
   int startEmptyColumns = 0;
@@ -1090,28 +1131,40 @@ const CoinPresolveAction
 */
   int *sort = new int[nrows] ;
   int nlook = 0 ;
+  double work = 0.0 ;
   for (int i = 0 ; i < nrows ; i++)
   { if (hinrow[i] == 0) continue ;
     if (prob->rowProhibited2(i)) continue ;
     // sort
     CoinSort_2(hcol+mrstrt[i],hcol+mrstrt[i]+hinrow[i],
 	       rowels+mrstrt[i]);
+    work += hinrow[i] ;
     sort[nlook++] = i ; }
+  // the scan, and finding classes
+  prob->addWork(2.0*work) ;
   if (nlook == 0)
   { delete[] sort ;
     return (next) ; }
 
+/*
+  Find the classes of identical candidate rows. Members of a class go next
+  to each other in sort, with the class number in workrow.
+*/
   double * workrow = new double[nrows+1];
-
-  double * workcol;
-  if (!prob->randomNumber_) {
-    workcol = new double[ncols+1];
-    coin_init_random_vec(workcol, ncols);
-  } else {
-    workcol = prob->randomNumber_;
-  }
-  compute_sums(nrows,hinrow,mrstrt,hcol,rowels,workcol,sort,workrow,nlook);
-  CoinSort_2(workrow,workrow+nlook,sort);
+  { CoinPackedMatrixDuplicates duplicates ;
+    duplicates.setNumberThreads(prob->numberThreads_) ;
+    duplicates.find(ncols,mrstrt,hinrow,hcol,rowels,nlook,sort) ;
+    const int *classStart = duplicates.classStarts() ;
+    const int *classMember = duplicates.classMembers() ;
+    nlook = 0 ;
+    for (int iClass = 0 ; iClass < duplicates.numberClasses() ; iClass++)
+    { for (int k = classStart[iClass] ; k < classStart[iClass+1] ; k++)
+      { sort[nlook] = classMember[k] ;
+	workrow[nlook++] = iClass ; } } }
+  if (nlook == 0)
+  { delete[] workrow ;
+    delete[] sort ;
+    return (next) ; }
 
   double *rlo	= prob->rlo_;
   double *rup	= prob->rup_;
@@ -1140,11 +1193,14 @@ const CoinPresolveAction
   }
   double dval = workrow[0];
   for (int jj = 1; jj < nlook; jj++) {
+    if (prob->workExhausted())
+      break ;
     if (workrow[jj]==dval) {
       int ithis=sort[jj];
       int ilast=sort[jj-1];
       CoinBigIndex krs = mrstrt[ithis];
       CoinBigIndex kre = krs + hinrow[ithis];
+      prob->addWork(2*hinrow[ithis]) ;
       if (hinrow[ithis] == hinrow[ilast]) {
 	int ishift = mrstrt[ilast] - krs;
 	CoinBigIndex k;
@@ -1257,8 +1313,6 @@ const CoinPresolveAction
   }
 
   delete[]workrow;
-  if(workcol != prob->randomNumber_)
-    delete[]workcol;
 
 
   if (nuseless_rows) {
@@ -1305,6 +1359,7 @@ const CoinPresolveAction
     *duprow3_action::presolve (CoinPresolveMatrix *prob,
 			      const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.duprow3");
   double startTime = 0.0;
   if (prob->tuning_) {
     startTime = CoinCpuTime();
@@ -1567,6 +1622,7 @@ const CoinPresolveAction
     *gubrow_action::presolve (CoinPresolveMatrix *prob,
 			      const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.gubrow");
   double startTime = 0.0;
   int droppedElements=0;
   int affectedRows=0;
@@ -1707,6 +1763,7 @@ const CoinPresolveAction
     *twoxtwo_action::presolve (CoinPresolveMatrix *prob,
 			      const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.twoxtwo");
   double startTime = 0.0;
   int startEmptyRows=0;
   int startEmptyColumns = 0;
@@ -2109,6 +2166,7 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
   double *rcosts	= prob->rcosts_;
   double * rowacts = prob->acts_;
   double * dual = prob->rowduals_;
+  unsigned char *colstat = prob->colstat_;
   double tolerance = prob->ztolzb_;
   const double maxmin	= prob->maxmin_;
   for (int iAction=0;iAction<nactions_;iAction++) {
@@ -2139,7 +2197,8 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
 	els1[0]=colels[nextEl];
       nextEl=link[nextEl];
     }
-    prob->setRowStatus(row1,CoinPrePostsolveMatrix::basic);
+    if (colstat)
+      prob->setRowStatus(row1,CoinPrePostsolveMatrix::basic);
     // put stuff back
     rlo[row1]=boundRecord.lbound_row;
     rup[row1]=boundRecord.ubound_row;
@@ -2196,14 +2255,18 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
     }
     if (lowerBoundPossible&&cost[icol]>=0.0) {
       // set to lower bound
-      prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atLowerBound);
+      if (colstat)
+	prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atLowerBound);
       sol[icol]=clo[icol];
-      rcosts[icol]=maxmin*cost[icol]-dual[row0]*els0real[1];
+      if (dual)
+	rcosts[icol]=maxmin*cost[icol]-dual[row0]*els0real[1];
     } else if (upperBoundPossible&&cost[icol]<=0.0) {
       // set to upper bound
-      prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atUpperBound);
+      if (colstat)
+	prob->setColumnStatus(icol,CoinPrePostsolveMatrix::atUpperBound);
       sol[icol]=cup[icol];
-      rcosts[icol]=maxmin*cost[icol]-dual[row0]*els0real[1];
+      if (dual)
+	rcosts[icol]=maxmin*cost[icol]-dual[row0]*els0real[1];
     } else {
       // need to make basic
       // we shouldn't get here (at present) if zero cost
@@ -2228,6 +2291,11 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
 	}
       }
       sol[icol]=value;
+      if (!colstat) {
+	// primal only - activity of row1 from its two columns
+	rowacts[row1]=els1real[0]*valueOther+els1real[1]*value;
+	continue;
+      }
 #if 0
       printf("row %d status %d, row %d status %d, col %d status %d, col %d status %d - binding0 %c\n",
 	     row0,prob->getRowStatus(row0),
@@ -2237,7 +2305,7 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
 #endif
       if (prob->getColumnStatus(icol)==CoinPrePostsolveMatrix::basic) {
 	//printf("col %d above was basic\n",icol);
-	if (prob->getRowStatus(row0)!=CoinPrePostsolveMatrix::basic) {
+	if (dual&&prob->getRowStatus(row0)!=CoinPrePostsolveMatrix::basic) {
 	  // adjust dual
 	  dual[row0]=maxmin*((cost[icol]-oldCost)/els0real[1]);
 	}
@@ -2246,7 +2314,8 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
       //if (binding0)
       //printf("Says row0 %d binding?\n",row0);
       prob->setColumnStatus(icol,CoinPrePostsolveMatrix::basic);
-      rcosts[icol]=0.0;
+      if (dual)
+	rcosts[icol]=0.0;
       //printf("row1 %d taken out of basis\n",row1);
       if (!swapSigns1) {
 	prob->setRowStatus(row1,CoinPrePostsolveMatrix::atUpperBound);
@@ -2255,7 +2324,8 @@ void twoxtwo_action::postsolve(CoinPostsolveMatrix * prob) const
 	prob->setRowStatus(row1,CoinPrePostsolveMatrix::atLowerBound);
 	rowacts[row1]=rlo[row1];
       }
-      dual[row1]=maxmin*((cost[icol]-oldCost)/els1real[1]);
+      if (dual)
+	dual[row1]=maxmin*((cost[icol]-oldCost)/els1real[1]);
       if (iAction==-1)
 	abort();
     }
@@ -9,6 +9,7 @@
 #include "CoinFinite.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
+#include "CoinInstrument.hpp"
 
 #include "CoinPresolveEmpty.hpp"
 #include "CoinMessage.hpp"
@@ -40,6 +41,7 @@ const CoinPresolveAction
 				     int necols,
 				     const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.drop_empty_cols");
 
 # if PRESOLVE_CONSISTENCY > 0
   presolve_links_ok(prob) ;
@@ -404,6 +406,7 @@ const CoinPresolveAction
   *drop_empty_rows_action::presolve (CoinPresolveMatrix *prob,
 				     const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.drop_empty_rows");
 # if PRESOLVE_DEBUG > 0
   std::cout << "Entering drop_empty_rows_action::presolve." << std::endl ;
 # endif
@@ -590,7 +593,8 @@ void drop_empty_rows_action::postsolve(CoinPostsolveMatrix *prob) const
       rlo[i] = rlo[nrows] ;
       rup[i] = rup[nrows] ;
       acts[i] = acts[nrows] ;
-      rowduals[i] = rowduals[nrows] ;
+      if (rowduals)
+	rowduals[i] = rowduals[nrows] ;
       if (rowstat)
 	rowstat[i] = rowstat[nrows] ;
 #     if PRESOLVE_DEBUG > 0
@@ -632,7 +636,8 @@ void drop_empty_rows_action::postsolve(CoinPostsolveMatrix *prob) const
     acts[i] = 0.0 ;
     if (rowstat)
       prob->setRowStatus(i,CoinPrePostsolveMatrix::basic) ;
-    rowduals[i] = 0.0 ;
+    if (rowduals)
+      rowduals[i] = 0.0 ;
 #   if PRESOLVE_DEBUG > 0
     rdone[i] = DROP_ROW;
 #   if PRESOLVE_DEBUG > 1
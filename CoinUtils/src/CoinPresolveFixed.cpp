@@ -8,6 +8,7 @@
 
 #include "CoinPresolveMatrix.hpp"
 #include "CoinPresolveFixed.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinFinite.hpp"
 
@@ -54,6 +55,7 @@ const remove_fixed_action*
 				 int *fcols, int nfcols,
 				 const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.remove_fixed");
   double *colels	= prob->colels_;
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt	= prob->mcstrt_;
@@ -303,6 +305,25 @@ remove_fixed_action::~remove_fixed_action()
  * so it might not compute to 0.
  */
 void remove_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
+{
+  postsolveWithFreeList(prob,prob->free_list_) ;
+}
+
+bool remove_fixed_action::postsolveFootprint (std::vector<int> &rows,
+					      std::vector<int> &columns,
+					      CoinBigIndex &entries) const
+{
+  const int start = actions_[0].start ;
+  const int end = actions_[nactions_].start ;
+  for (int i = 0 ; i < nactions_ ; i++)
+    columns.push_back(actions_[i].col) ;
+  rows.insert(rows.end(),colrows_+start,colrows_+end) ;
+  entries = end-start ;
+  return (true) ;
+}
+
+void remove_fixed_action::postsolveWithFreeList (CoinPostsolveMatrix *prob,
+						 CoinBigIndex &free_list) const
 {
   action * actions	= actions_;
   const int nactions	= nactions_;
@@ -312,7 +333,6 @@ void remove_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
   CoinBigIndex *mcstrt	= prob->mcstrt_;
   int *hincol		= prob->hincol_;
   int *link		= prob->link_;
-  CoinBigIndex &free_list = prob->free_list_;
 
   double *clo	= prob->clo_;
   double *cup	= prob->cup_;
@@ -395,7 +415,8 @@ void remove_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
 	rup[row] += coeff * thesol;
       acts[row] += coeff * thesol;
       
-      dj -= rowduals[row] * coeff;
+      if (rowduals)
+	dj -= rowduals[row] * coeff;
     }
 
 #   if PRESOLVE_CONSISTENCY > 0
@@ -404,7 +425,8 @@ void remove_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
       
     mcstrt[icol] = cs;
     
-    rcosts[icol] = dj;
+    if (rcosts)
+      rcosts[icol] = dj;
     hincol[icol] = end-start;
     end=start;
 
@@ -608,6 +630,12 @@ make_fixed_action::presolve (CoinPresolveMatrix *prob,
   still viable (we can potentially eliminate the bound here).
 */
 void make_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
+{
+  postsolveWithFreeList(prob,prob->free_list_) ;
+}
+
+void make_fixed_action::postsolveWithFreeList (CoinPostsolveMatrix *prob,
+					       CoinBigIndex &freeList) const
 {
   const action *const actions = actions_;
   const int nactions = nactions_;
@@ -631,7 +659,7 @@ void make_fixed_action::postsolve(CoinPostsolveMatrix *prob) const
   Repopulate the columns.
 */
   assert(nactions == faction_->nactions_) ;
-  faction_->postsolve(prob);
+  faction_->postsolveWithFreeList(prob,freeList);
 /*
   Walk the actions: restore each bound and check that the status is still
   appropriate. Given that we're unfixing a fixed variable, it's safe to assume
@@ -67,6 +67,14 @@ class remove_fixed_action : public CoinPresolveAction {
 
   void postsolve(CoinPostsolveMatrix *prob) const;
 
+  /// The columns, and the rows of their coefficients
+  bool postsolveFootprint(std::vector<int> &rows, std::vector<int> &columns,
+			  CoinBigIndex &entries) const;
+
+  /// Postsolve taking coefficients from \p freeList
+  void postsolveWithFreeList(CoinPostsolveMatrix *prob,
+			     CoinBigIndex &freeList) const;
+
   /// Destructor
   virtual ~remove_fixed_action();
 };
@@ -149,6 +157,15 @@ class make_fixed_action : public CoinPresolveAction {
   */
   void postsolve(CoinPostsolveMatrix *prob) const;
 
+  /// The footprint of the remove_fixed_action which repopulates the columns
+  bool postsolveFootprint(std::vector<int> &rows, std::vector<int> &columns,
+			  CoinBigIndex &entries) const
+  { return (faction_->postsolveFootprint(rows,columns,entries)) ; }
+
+  /// Postsolve taking coefficients from \p freeList
+  void postsolveWithFreeList(CoinPostsolveMatrix *prob,
+			     CoinBigIndex &freeList) const;
+
   /// Destructor
   virtual ~make_fixed_action() {
     deleteAction(actions_,action*); 
@@ -7,6 +7,7 @@
 #include <math.h>
 
 #include "CoinPresolveMatrix.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinPresolveEmpty.hpp"	// for DROP_COL/DROP_ROW
 #include "CoinPresolveFixed.hpp"
 #include "CoinPresolveSubst.hpp"
@@ -83,6 +84,149 @@ void implied_row_bounds (const double *els,
   maxdnp = (neginf)?-PRESOLVE_INF:maxdown ;
 }
 
+/*
+  What forcing_constraint_action::presolve should do with a row.
+*/
+enum forcingRowType { FORCING_NOTHING = 0, FORCING_INFEASIBLE,
+		      FORCING_USELESS, FORCING_AT_LOWER, FORCING_AT_UPPER } ;
+
+/*
+  Decide whether row irow is infeasible, useless or forcing, given the
+  current column bounds. Reads prob only, so rows can be classified in
+  parallel.
+*/
+forcingRowType classify_row (const CoinPresolveMatrix *prob, int irow,
+			     bool fixInfeasibility)
+{
+  const CoinBigIndex krs = prob->mrstrt_[irow] ;
+  const CoinBigIndex kre = krs+prob->hinrow_[irow] ;
+  const int *hcol = prob->hcol_ ;
+  const double rlo = prob->rlo_[irow] ;
+  const double rup = prob->rup_[irow] ;
+
+  const double tol = ZTOLDP ;
+  const double inftol = prob->feasibilityTolerance_ ;
+  // for redundant rows be safe
+  const double inftol2 = 0.01*prob->feasibilityTolerance_ ;
+/*
+  If the row activity bounds cache is in use, see if it shows (allowing for
+  rounding error) that every test below must fail. If so, there's no need to
+  walk the row. Anything else is settled by the exact calculation.
+*/
+  double finDown, finUp ;
+  int infDown, infUp ;
+  if (prob->rowActivityBounds(irow,finDown,infDown,finUp,infUp)) {
+    const double err = prob->rowActivityError(irow) ;
+    const bool feasible = fixInfeasibility ||
+      ((infUp || finUp-err+inftol >= rlo) &&
+       (infDown || rup >= finDown+err-inftol)) ;
+    const bool notUseless =
+      (-PRESOLVE_INF < rlo && (infDown || rlo > finDown+err+inftol2)) ||
+      (rup < PRESOLVE_INF && (infUp || rup < finUp-err-inftol2)) ;
+    const bool notForcing =
+      (infUp || fabs(rlo-finUp) >= tol+err) &&
+      (infDown || fabs(rup-finDown) >= tol+err) ;
+    if (feasible && notUseless && notForcing)
+      return (FORCING_NOTHING) ;
+  }
+/*
+  Calculate upper and lower bounds on the row activity based on upper and lower
+  bounds on the variables. If these are finite and incompatible with the given
+  row bounds, we have infeasibility.
+*/
+  double maxup, maxdown ;
+  implied_row_bounds(prob->rowels_,prob->clo_,prob->cup_,hcol,krs,kre,
+		     maxup,maxdown) ;
+# if PRESOLVE_DEBUG > 2
+  std::cout
+    << "  considering row " << irow << ", rlo " << rlo
+    << " LB " << maxdown << " UB " << maxup << " rup " << rup ;
+# endif
+/*
+  If the maximum lhs value is less than L(i) or the minimum lhs value is
+  greater than U(i), we're infeasible.
+*/
+  if (maxup < PRESOLVE_INF &&
+      maxup+inftol < rlo && !fixInfeasibility) {
+#   if PRESOLVE_DEBUG > 2
+    std::cout << "; infeasible." << std::endl ;
+#   endif
+    return (FORCING_INFEASIBLE) ;
+  }
+  if (-PRESOLVE_INF < maxdown &&
+      rup < maxdown-inftol && !fixInfeasibility) {
+#   if PRESOLVE_DEBUG > 2
+    std::cout << "; infeasible." << std::endl ;
+#   endif
+    return (FORCING_INFEASIBLE) ;
+  }
+/*
+  We've dealt with prima facie infeasibility. Now check if the constraint
+  is trivially satisfied. If so, it's useless.
+
+  The reason we require maxdown and maxup to be finite if the row bound is
+  finite is to guard against some subsequent transform changing a column
+  bound from infinite to finite. Once finite, bounds continue to tighten,
+  so we're safe.
+*/
+  /* Test changed to use +small tolerance rather than -tolerance
+     as test fails often */
+  forcingRowType type = FORCING_NOTHING ;
+  if (((rlo <= -PRESOLVE_INF) ||
+       (-PRESOLVE_INF < maxdown && rlo <= maxdown+inftol2)) &&
+      ((rup >= PRESOLVE_INF) ||
+       (maxup < PRESOLVE_INF && rup >= maxup-inftol2))) {
+    type = FORCING_USELESS ;
+#   if PRESOLVE_DEBUG > 2
+    std::cout << "; useless." << std::endl ;
+#   endif
+  } else {
+/*
+  Is it the case that we can just barely attain L(i) or U(i)? If so, we have a
+  forcing constraint. As explained above, we need maxup and maxdown to be
+  finite in order for the test to be valid.
+*/
+    const bool tightAtLower = ((maxup < PRESOLVE_INF) &&
+			       (fabs(rlo-maxup) < tol)) ;
+    const bool tightAtUpper = ((-PRESOLVE_INF < maxdown) &&
+			       (fabs(rup-maxdown) < tol)) ;
+#   if PRESOLVE_DEBUG > 2
+    if (tightAtLower || tightAtUpper) std::cout << "; forcing." ;
+    std::cout << std::endl ;
+#   endif
+    if (tightAtLower)
+      type = FORCING_AT_LOWER ;
+    else if (tightAtUpper)
+      type = FORCING_AT_UPPER ;
+  }
+  // check none prohibited
+  if (type != FORCING_NOTHING && prob->anyProhibited_) {
+    for (CoinBigIndex k = krs ; k < kre ; k++) {
+      if (prob->colProhibited(hcol[k]))
+	return (FORCING_NOTHING) ;	// skip row
+    }
+  }
+  return (type) ;
+}
+
+/*
+  presolve_scan_function for presolve_parallel_scan. Info is the
+  fixInfeasibility flag.
+*/
+void classify_rows (const CoinPresolveMatrix *prob, const int *look,
+		    int first, int last, const void *info, char *result)
+{
+  const bool fixInfeasibility = *reinterpret_cast<const bool *>(info) ;
+  const int *hinrow = prob->hinrow_ ;
+  for (int k = first ; k < last ; k++) {
+    const int irow = look[k] ;
+    if (hinrow[irow] > 0)
+      result[k] = static_cast<char>(classify_row(prob,irow,fixInfeasibility)) ;
+    else
+      result[k] = FORCING_NOTHING ;
+  }
+}
+
 }	// end file-local namespace
 
 
@@ -138,6 +282,7 @@ const CoinPresolveAction*
   forcing_constraint_action::presolve (CoinPresolveMatrix *prob,
   				       const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.forcing_constraint");
 # if PRESOLVE_DEBUG > 0 || COIN_PRESOLVE_TUNING
   int startEmptyRows = 0 ;
   int startEmptyColumns = 0 ;
@@ -175,10 +320,6 @@ const CoinPresolveAction*
   const double *rlo = prob->rlo_ ;
   const double *rup = prob->rup_ ;
 
-  const double tol = ZTOLDP ;
-  const double inftol = prob->feasibilityTolerance_ ;
-  // for redundant rows be safe
-  const double inftol2 = 0.01*prob->feasibilityTolerance_ ;
   const int ncols = prob->ncols_ ;
 
   int *fixed_cols = new int[ncols] ;
@@ -194,6 +335,22 @@ const CoinPresolveAction*
   int *look = prob->rowsToDo_ ;
 
   bool fixInfeasibility = ((prob->presolveOptions_&0x4000) != 0) ;
+  prob->syncRowActivity() ;
+/*
+  With threads, classify all the rows of interest in parallel first. Rows
+  are still acted on in order below; a row with a column already fixed by an
+  earlier forcing row in this pass is classified again with the new bounds,
+  so the outcome is the same as the serial scan.
+*/
+  char *rowType = NULL ;
+  char *touched = NULL ;
+  if (prob->numberThreads_ > 1 && numberLook > 1000) {
+    rowType = new char [numberLook] ;
+    presolve_parallel_scan(prob,classify_rows,look,numberLook,hinrow,
+			   &fixInfeasibility,rowType) ;
+    touched = new char [ncols] ;
+    CoinZeroN(touched,ncols) ;
+  }
 /*
   Open a loop to scan the constraints of interest. There must be variables
   left in the row.
@@ -204,106 +361,31 @@ const CoinPresolveAction*
 
     const CoinBigIndex krs = mrstrt[irow] ;
     const CoinBigIndex kre = krs+hinrow[irow] ;
-/*
-  Calculate upper and lower bounds on the row activity based on upper and lower
-  bounds on the variables. If these are finite and incompatible with the given
-  row bounds, we have infeasibility.
-*/
-    double maxup, maxdown ;
-    implied_row_bounds(rowels,clo,cup,hcol,krs,kre,maxup,maxdown) ;
-#   if PRESOLVE_DEBUG > 2
-    std::cout
-      << "  considering row " << irow << ", rlo " << rlo[irow]
-      << " LB " << maxdown << " UB " << maxup << " rup " << rup[irow] ;
-#   endif
-/*
-  If the maximum lhs value is less than L(i) or the minimum lhs value is
-  greater than U(i), we're infeasible.
-*/
-    if (maxup < PRESOLVE_INF &&
-        maxup+inftol < rlo[irow] && !fixInfeasibility) {
-      CoinMessageHandler *hdlr = prob->messageHandler() ;
-      prob->status_|= 1 ;
-      hdlr->message(COIN_PRESOLVE_ROWINFEAS,prob->messages())
-	 << irow << rlo[irow] << rup[irow] << CoinMessageEol ;
-#     if PRESOLVE_DEBUG > 2
-      std::cout << "; infeasible." << std::endl ;
-#     endif
-      break ;
+    bool classified = (rowType != NULL) ;
+    if (classified && nactions) {
+      for (CoinBigIndex k = krs ; k < kre ; k++) {
+	if (touched[hcol[k]]) {
+	  classified = false ;
+	  break ;
+	}
+      }
     }
-    if (-PRESOLVE_INF < maxdown &&
-        rup[irow] < maxdown-inftol && !fixInfeasibility) {
+    const forcingRowType type = classified ?
+      static_cast<forcingRowType>(rowType[iLook]) :
+      classify_row(prob,irow,fixInfeasibility) ;
+    if (type == FORCING_INFEASIBLE) {
       CoinMessageHandler *hdlr = prob->messageHandler() ;
       prob->status_|= 1 ;
       hdlr->message(COIN_PRESOLVE_ROWINFEAS,prob->messages())
 	 << irow << rlo[irow] << rup[irow] << CoinMessageEol ;
-#     if PRESOLVE_DEBUG > 2
-      std::cout << "; infeasible." << std::endl ;
-#     endif
       break ;
     }
-/*
-  We've dealt with prima facie infeasibility. Now check if the constraint
-  is trivially satisfied. If so, add it to the list of useless rows and move
-  on.
-
-  The reason we require maxdown and maxup to be finite if the row bound is
-  finite is to guard against some subsequent transform changing a column
-  bound from infinite to finite. Once finite, bounds continue to tighten,
-  so we're safe.
-*/
-    /* Test changed to use +small tolerance rather than -tolerance
-       as test fails often */
-    if (((rlo[irow] <= -PRESOLVE_INF) ||
-	 (-PRESOLVE_INF < maxdown && rlo[irow] <= maxdown+inftol2)) &&
-	((rup[irow] >= PRESOLVE_INF) ||
-	 (maxup < PRESOLVE_INF && rup[irow] >= maxup-inftol2))) {
-      // check none prohibited
-      if (prob->anyProhibited_) {
-	bool anyProhibited=false;
-	for (int k=krs; k<kre; k++) {
-	  int jcol = hcol[k];
-	  if (prob->colProhibited(jcol)) {
-	    anyProhibited=true;
-	    break;
-	  }
-	}
-	if (anyProhibited)
-	  continue; // skip row
-      }
+    if (type == FORCING_USELESS) {
       useless_rows[nuseless_rows++] = irow ;
-#     if PRESOLVE_DEBUG > 2
-      std::cout << "; useless." << std::endl ;
-#     endif
       continue ;
     }
-/*
-  Is it the case that we can just barely attain L(i) or U(i)? If so, we have a
-  forcing constraint. As explained above, we need maxup and maxdown to be
-  finite in order for the test to be valid.
-*/
-    const bool tightAtLower = ((maxup < PRESOLVE_INF) &&
-    			       (fabs(rlo[irow]-maxup) < tol)) ;
-    const bool tightAtUpper = ((-PRESOLVE_INF < maxdown) &&
-			       (fabs(rup[irow]-maxdown) < tol)) ;
-#   if PRESOLVE_DEBUG > 2
-    if (tightAtLower || tightAtUpper) std::cout << "; forcing." ;
-    std::cout << std::endl ;
-#   endif
-    if (!(tightAtLower || tightAtUpper)) continue ;
-    // check none prohibited
-    if (prob->anyProhibited_) {
-      bool anyProhibited=false;
-      for (int k=krs; k<kre; k++) {
-	int jcol = hcol[k];
-	if (prob->colProhibited(jcol)) {
-	  anyProhibited=true;
-	  break;
-	}
-      }
-      if (anyProhibited)
-	continue; // skip row
-    }
+    if (type == FORCING_NOTHING) continue ;
+    const bool tightAtLower = (type == FORCING_AT_LOWER) ;
 /*
   We have a forcing constraint.
   Get down to the business of fixing the variables at the appropriate bound.
@@ -312,8 +394,8 @@ const CoinPresolveAction*
   from the start, variables fixed at u<j> from the end. Add the column to
   the list of columns to be processed further.
 */
-    double *bounds = new double[hinrow[irow]] ;
-    int *rowcols = new int[hinrow[irow]] ;
+    double *bounds = CoinPresolveNewArray<double>(prob,hinrow[irow]) ;
+    int *rowcols = CoinPresolveNewArray<int>(prob,hinrow[irow]) ;
     CoinBigIndex lk = krs ;
     CoinBigIndex uk = kre ;
     for (CoinBigIndex k = krs ; k < kre ; k++) {
@@ -344,12 +426,15 @@ const CoinPresolveAction*
 	}
 	cup[j] = lj ;
       }
+      prob->updateColumnActivity(j) ;
 /*
   Only add a column to the list of fixed columns the first time it's fixed.
 */
       if (lj != uj) {
 	fixed_cols[nfixed_cols++] = j ;
 	prob->addCol(j) ;
+	if (touched)
+	  touched[j] = 1 ;
       }
     }
     PRESOLVEASSERT(uk == lk) ;
@@ -386,7 +471,7 @@ const CoinPresolveAction*
 */
     if (nactions) {
       next = new forcing_constraint_action(nactions, 
-				 CoinCopyOfArray(actions,nactions),next) ;
+				 CoinPresolveCopyOfArray(prob,actions,nactions),next) ;
     }
 /*
   Hand off the job of dealing with the useless rows to a specialist.
@@ -422,6 +507,8 @@ const CoinPresolveAction*
   deleteAction(actions,action*) ;
   delete [] useless_rows ;
   delete [] fixed_cols ;
+  delete [] rowType ;
+  delete [] touched ;
 
 # if COIN_PRESOLVE_TUNING
   double thisTime = 0.0;
@@ -491,6 +578,7 @@ void forcing_constraint_action::postsolve(CoinPostsolveMatrix *prob) const
 
   double *acts = prob->acts_ ;
   double *rowduals = prob->rowduals_ ;
+  const unsigned char *colstat = prob->colstat_ ;
 
   const double ztoldj = prob->ztoldj_ ;
   const double ztolzb = prob->ztolzb_ ;
@@ -524,6 +612,18 @@ void forcing_constraint_action::postsolve(CoinPostsolveMatrix *prob) const
       << " variables." << std::endl ;
 #   endif
 
+/*
+  Without status (primal values only) the variables simply stay at the
+  bounds presolve forced them to; restore the relaxed bounds and move on.
+*/
+    if (!colstat) {
+      for (int k = 0 ; k < nlo ; k++)
+	cup[rowcols[k]] = bounds[k] ;
+      for (int k = nlo ; k < ninrow ; k++)
+	clo[rowcols[k]] = bounds[k] ;
+      continue ;
+    }
+
     PRESOLVEASSERT(prob->getRowStatus(irow) == CoinPrePostsolveMatrix::basic) ;
     PRESOLVEASSERT(rowduals[irow] == 0.0) ;
 /*
@@ -16,6 +16,8 @@
 
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveProfile.hpp"
+#include "CoinThreadPool.hpp"
 
 
 /*! \defgroup PMMDVX Packed Matrix Major Dimension Vector Expansion
@@ -49,11 +51,15 @@
 
   compact_rep compacts the major vectors in the storage areas to
   leave a single block of free space at the end.
+
+  If presolve_expand is given a presolvehspace object, the space left behind
+  by a moved vector is recorded there and offered to the next vector that
+  needs to move, before the free space at the end is used.
 */
 //@{
 
 /*
-  This first function doesn't need to be known outside of this file.
+  These functions don't need to be known outside of this file.
 */
 namespace {
 
@@ -63,22 +69,44 @@ namespace {
   This routine compacts the major vectors in the bulk storage area,
   leaving a single block of free space at the end. The vectors are not
   reordered, just shifted down to remove gaps.
+
+  Shifting every vector costs time proportional to the size of the matrix.
+  If needed > 0, only the vectors at the end of the storage order are shifted,
+  starting far enough back to recover needed positions plus a sixteenth of
+  the bulk storage. If that takes us back to the first vector, it's a full
+  compaction.
 */
 
 void compact_rep (double *elems, int *indices,
 		  CoinBigIndex *starts, const int *lengths, int n,
-		  const presolvehlink *link)
+		  const presolvehlink *link, CoinBigIndex needed = 0,
+		  presolvehspace *space = 0)
 {
 # if PRESOLVE_SUMMARY
   printf("****COMPACTING****\n") ;
 # endif
-
-  // for now, just look for the first element of the list
+/*
+  Walk back from the end adding up the gaps until we've recovered enough
+  space or run out of vectors. i is the first vector to shift, j the position
+  it's shifted to.
+*/
+  const CoinBigIndex target = (needed > 0)?needed+starts[n]/16:starts[n]+1 ;
+  CoinBigIndex recovered = 0 ;
+  CoinBigIndex j = 0 ;
   int i = n ;
-  while (link[i].pre != NO_LINK)
-    i = link[i].pre ;
+  bool full = true ;
+  for (int ipre = link[i].pre ; ipre >= 0 ; ipre = link[i].pre) {
+    const CoinBigIndex prevEnd = starts[ipre]+lengths[ipre] ;
+    recovered += starts[i]-prevEnd ;
+    if (recovered >= target) {
+      j = prevEnd ;
+      full = false ;
+      break ;
+    }
+    i = ipre ;
+  }
 
-  CoinBigIndex j = 0 ;
+  CoinBigIndex moved = 0 ;
   for (; i != n; i = link[i].suc) {
     CoinBigIndex s = starts[i] ;
     CoinBigIndex e = starts[i] + lengths[i] ;
@@ -90,9 +118,67 @@ void compact_rep (double *elems, int *indices,
       indices[j] = indices[k] ;
       j++ ;
    }
+    moved += e-s ;
+  }
+
+  if (space) {
+    space->compactedEntries_ += moved ;
+    if (full) {
+      space->fullCompactions_++ ;
+      space->clearFree() ;
+    } else {
+      space->partialCompactions_++ ;
+    }
   }
 }
 
+/*
+  Record the space from start to the beginning of the vector following
+  owner as a gap.
+*/
+
+void record_gap (presolvehspace *space, const CoinBigIndex *starts,
+		 const presolvehlink *link, int owner, CoinBigIndex start)
+{
+  if (!space || owner < 0) return ;
+  presolvehspace::gap g ;
+  g.start = start ;
+  g.size = starts[link[owner].suc]-start ;
+  g.owner = owner ;
+  if (g.size >= 2)
+    space->free_[presolvehspace::sizeClass(g.size)].push_back(g) ;
+}
+
+/*
+  Look for a recorded gap which will hold a vector of length len with room
+  for one more coefficient. Gaps which are no longer free are dropped as
+  they're found. Returns true and fills in found if we have a gap.
+*/
+
+bool find_gap (presolvehspace *space, const CoinBigIndex *starts,
+	       const int *lengths, const presolvehlink *link,
+	       CoinBigIndex len, presolvehspace::gap &found)
+{
+  const CoinBigIndex want = len+2 ;
+  for (int c = presolvehspace::sizeClass(want) ;
+       c < presolvehspace::numberClasses ; c++) {
+    std::vector<presolvehspace::gap> &gaps = space->free_[c] ;
+    while (!gaps.empty()) {
+      const presolvehspace::gap &g = gaps.back() ;
+      const int suc = link[g.owner].suc ;
+      if (suc == NO_LINK || starts[g.owner]+lengths[g.owner] > g.start ||
+	  starts[suc] < g.start+g.size) {
+	gaps.pop_back() ;
+	continue ;
+      }
+      if (g.size < want) break ;
+      found = g ;
+      gaps.pop_back() ;
+      return (true) ;
+    }
+  }
+  return (false) ;
+}
 
 } /* end unnamed namespace */
 
@@ -142,7 +228,7 @@ void presolve_make_memlists (/*CoinBigIndex *starts,*/ int *lengths,
   link[n].suc = NO_LINK ;
 }
 
-
+
 
 /*
   presolve_expand_major
@@ -150,16 +236,18 @@ void presolve_make_memlists (/*CoinBigIndex *starts,*/ int *lengths,
   The routine looks at the space currently occupied by major-dimension vector
   k and makes sure that there's room to add one coefficient.
 
-  This may require moving the vector to the vacant area at the end of the
-  bulk storage array. If there's no room left at the end of the array, an
-  attempt is made to compact the existing vectors to make space.
+  This may require moving the vector to a recorded gap (if space is
+  supplied) or to the vacant area at the end of the bulk storage array. If
+  there's no room left at the end of the array, an attempt is made to
+  compact the existing vectors to make space.
 
   Returns true for failure, false for success.
 */
 
 bool presolve_expand_major (CoinBigIndex *majstrts, double *els,
 			    int *minndxs, int *majlens,
-			    presolvehlink *majlinks, int nmaj, int k)
+			    presolvehlink *majlinks, int nmaj, int k,
+			    presolvehspace *space)
 
 { const CoinBigIndex bulkCap = majstrts[nmaj] ;
 
@@ -170,23 +258,39 @@ bool presolve_expand_major (CoinBigIndex *majstrts, double *els,
   CoinBigIndex kcsx = majstrts[k] ;
   CoinBigIndex kcex = kcsx + majlens[k] ;
   int nextcol = majlinks[k].suc ;
+  presolvehspace::gap reuse ;
 /*
   Do we have room to add one coefficient in place?
 */
   if (kcex+1 < majstrts[nextcol])
-  { /* no action required */ }
+  { return (false) ; }
+  if (space) space->expansions_++ ;
 /*
   Is k the last non-empty column? In that case, attempt to compact the
   bulk storage. This will move k, so update the column start and end.
   If we still have no space, it's a fatal error.
 */
-  else
   if (nextcol == nmaj)
-  { compact_rep(els,minndxs,majstrts,majlens,nmaj,majlinks) ;
+  { compact_rep(els,minndxs,majstrts,majlens,nmaj,majlinks,2,space) ;
     kcsx = majstrts[k] ;
     kcex = kcsx + majlens[k] ;
     if (kcex+1 >= bulkCap)
     { return (true) ; } }
+/*
+  Is there a recorded gap that will hold k? Then move k there, and record
+  the space it leaves behind in its place.
+*/
+  else
+  if (space && find_gap(space,majstrts,majlens,majlinks,majlens[k],reuse))
+  { memcpy(reinterpret_cast<void *>(&minndxs[reuse.start]),
+	   reinterpret_cast<void *>(&minndxs[kcsx]),majlens[k]*sizeof(int)) ;
+    memcpy(reinterpret_cast<void *>(&els[reuse.start]),
+	   reinterpret_cast<void *>(&els[kcsx]),majlens[k]*sizeof(double)) ;
+    majstrts[k] = reuse.start ;
+    PRESOLVE_REMOVE_LINK(majlinks,k) ;
+    PRESOLVE_INSERT_LINK(majlinks,k,reuse.owner) ;
+    record_gap(space,majstrts,majlinks,majlinks[nextcol].pre,kcsx) ;
+    space->reuses_++ ; }
 /*
   The most complicated case --- we need to move k from its current location
   to empty space at the end of the bulk storage. And we may need to make that!
@@ -198,7 +302,8 @@ bool presolve_expand_major (CoinBigIndex *majstrts, double *els,
     int newkcex = newkcsx+majlens[k] ;
 
     if (newkcex+1 >= bulkCap)
-    { compact_rep(els,minndxs,majstrts,majlens,nmaj,majlinks) ;
+    { compact_rep(els,minndxs,majstrts,majlens,nmaj,majlinks,
+		  majlens[k]+2,space) ;
       kcsx = majstrts[k] ;
       kcex = kcsx + majlens[k] ;
       newkcsx = majstrts[lastcol]+majlens[lastcol] ;
@@ -212,6 +317,7 @@ bool presolve_expand_major (CoinBigIndex *majstrts, double *els,
 /*
   Moving the vector requires three actions. First we move the data, then
   update the packed matrix vector start, then relink the storage order list,
+  noting the space left behind.
 */
     memcpy(reinterpret_cast<void *>(&minndxs[newkcsx]),
 	   reinterpret_cast<void *>(&minndxs[kcsx]),majlens[k]*sizeof(int)) ;
@@ -220,11 +326,15 @@ bool presolve_expand_major (CoinBigIndex *majstrts, double *els,
     majstrts[k] = newkcsx ;
     PRESOLVE_REMOVE_LINK(majlinks,k) ;
     PRESOLVE_INSERT_LINK(majlinks,k,lastcol) ;
+    if (space) {
+      space->moves_++ ;
+      record_gap(space,majstrts,majlinks,majlinks[nextcol].pre,kcsx) ;
+    }
     if (newkcex+1 >= bulkCap) {
       // compact - faking extra one
       //majlens[k]++;
       //majstrts[nmaj]=newkcex;
-      compact_rep(els,minndxs,majstrts,majlens,nmaj,majlinks) ;
+      compact_rep(els,minndxs,majstrts,majlens,nmaj,majlinks,0,space) ;
       //majlens[k]--;
       //majstrts[nmaj]=bulkCap;
       kcsx = majstrts[k] ;
@@ -234,7 +344,7 @@ bool presolve_expand_major (CoinBigIndex *majstrts, double *els,
 	return (true) ;
       }
     }
-  } 
+  }
 /*
   Success --- the vector has room for one more coefficient.
 */
@@ -467,3 +577,266 @@ void presolve_delete_from_major2 (int majndx, int minndx,
   return ;
 }
 
+/*! \defgroup PMMPS Parallel detection scans
+    \brief Run read-only detection over a candidate list with threads.
+
+  Transforms spend most of their time looking at rows or columns which turn
+  out to need nothing done. That part only reads the matrix, so it can be
+  split into blocks and run in parallel; the transforms themselves are then
+  applied serially, in list order, so the result does not depend on the
+  number of threads.
+*/
+//@{
+
+namespace {
+
+typedef struct {
+  const CoinPresolveMatrix *prob ;
+  presolve_scan_function scan ;
+  const int *look ;
+  int first ;
+  int last ;
+  const void *info ;
+  char *result ;
+} presolve_scan_block ;
+
+void *presolve_scan_worker (void *voidBlock)
+{
+  presolve_scan_block *block = reinterpret_cast<presolve_scan_block *>(voidBlock) ;
+  block->scan(block->prob,block->look,block->first,block->last,
+	      block->info,block->result) ;
+  return NULL ;
+}
+
+}	// end unnamed namespace
+
+void presolve_parallel_scan (const CoinPresolveMatrix *prob,
+			     presolve_scan_function scan,
+			     const int *look, int numberLook,
+			     const int *length, const void *info,
+			     char *result)
+{
+  int numberThreads = CoinMin(prob->numberThreads_,numberLook) ;
+  if (numberThreads <= 1) {
+    if (numberLook > 0)
+      scan(prob,look,0,numberLook,info,result) ;
+    return ;
+  }
+/*
+  Split so each block has about the same number of coefficients (plus one
+  for each candidate so empty ones count for something).
+*/
+  double total = 0.0 ;
+  for (int k = 0 ; k < numberLook ; k++)
+    total += length[look[k]]+1 ;
+  presolve_scan_block *block = new presolve_scan_block [numberThreads] ;
+  double target = total/numberThreads ;
+  double sum = 0.0 ;
+  int k = 0 ;
+  for (int i = 0 ; i < numberThreads ; i++) {
+    block[i].prob = prob ;
+    block[i].scan = scan ;
+    block[i].look = look ;
+    block[i].info = info ;
+    block[i].result = result ;
+    block[i].first = k ;
+    if (i == numberThreads-1) {
+      k = numberLook ;
+    } else {
+      while (k < numberLook && sum < (i+1)*target)
+	sum += length[look[k++]]+1 ;
+    }
+    block[i].last = k ;
+  }
+  CoinThreadPool::run(presolve_scan_worker,block,sizeof(block[0]),
+		      numberThreads) ;
+  delete [] block ;
+}
+
+//@}
+
+/*! \defgroup PMPPS Parallel postsolve
+    \brief Postsolve independent actions with threads.
+
+  Consecutive actions which use disjoint rows and columns can be postsolved
+  in any order, so a run of them is split into blocks which are postsolved
+  in parallel. Each block gets its own chain of entries, taken from the
+  front of the free list, so threads don't contend for it.
+*/
+//@{
+
+namespace {
+
+typedef struct {
+  CoinPostsolveMatrix *prob ;
+  const CoinPresolveAction *const *actions ;
+  int first ;
+  int last ;
+  CoinBigIndex freeList ;
+} postsolve_block ;
+
+void *postsolve_worker (void *voidBlock)
+{
+  postsolve_block *block = reinterpret_cast<postsolve_block *>(voidBlock) ;
+  for (int i = block->first ; i < block->last ; i++)
+    block->actions[i]->postsolveWithFreeList(block->prob,block->freeList) ;
+  return NULL ;
+}
+
+/*
+  Postsolve a group of independent actions, in list order if we're not
+  going to use threads. entries[i] and weight[i] are the free list entries
+  needed and the size of the footprint of actions[i].
+*/
+void postsolve_group (CoinPostsolveMatrix *prob,
+		      const std::vector<const CoinPresolveAction *> &actions,
+		      const std::vector<CoinBigIndex> &entries,
+		      const std::vector<int> &weight, int numberThreads)
+{
+  const int numberActions = static_cast<int>(actions.size()) ;
+# ifndef COINUTILS_PTHREADS
+  numberThreads = 1 ;
+# endif
+  numberThreads = CoinMin(numberThreads,numberActions) ;
+  if (numberThreads <= 1) {
+    for (int i = 0 ; i < numberActions ; i++)
+      actions[i]->postsolve(prob) ;
+    return ;
+  }
+/*
+  Split so each block has about the same footprint, then give each block
+  the free list entries it will need. If the free list is too short, give
+  up and do it serially.
+*/
+  double total = 0.0 ;
+  for (int i = 0 ; i < numberActions ; i++)
+    total += weight[i]+1 ;
+  postsolve_block *block = new postsolve_block [numberThreads] ;
+  const double target = total/numberThreads ;
+  double sum = 0.0 ;
+  int k = 0 ;
+  CoinBigIndex *link = prob->link_ ;
+  CoinBigIndex &free_list = prob->free_list_ ;
+  bool enough = true ;
+  for (int i = 0 ; i < numberThreads ; i++) {
+    block[i].prob = prob ;
+    block[i].actions = &actions[0] ;
+    block[i].first = k ;
+    CoinBigIndex needed = 0 ;
+    if (i == numberThreads-1) {
+      for (; k < numberActions ; k++)
+	needed += entries[k] ;
+    } else {
+      while (k < numberActions && sum < (i+1)*target) {
+	sum += weight[k]+1 ;
+	needed += entries[k++] ;
+      }
+    }
+    block[i].last = k ;
+    block[i].freeList = NO_LINK ;
+    if (needed && enough) {
+      CoinBigIndex kend = free_list ;
+      for (CoinBigIndex j = 1 ; j < needed && kend != NO_LINK ; j++)
+	kend = link[kend] ;
+      if (kend == NO_LINK) {
+	enough = false ;
+      } else {
+	block[i].freeList = free_list ;
+	free_list = link[kend] ;
+	link[kend] = NO_LINK ;
+      }
+    }
+  }
+  if (enough)
+    CoinThreadPool::run(postsolve_worker,block,sizeof(block[0]),
+			numberThreads) ;
+/*
+  Return whatever is left of each block's chain to the free list. If
+  there wasn't enough to go round, that's all of it, and we go serially.
+*/
+  for (int i = 0 ; i < numberThreads ; i++) {
+    CoinBigIndex kend = block[i].freeList ;
+    if (kend == NO_LINK) continue ;
+    while (link[kend] != NO_LINK)
+      kend = link[kend] ;
+    link[kend] = free_list ;
+    free_list = block[i].freeList ;
+  }
+  if (!enough) {
+    for (int i = 0 ; i < numberActions ; i++)
+      actions[i]->postsolve(prob) ;
+  }
+  delete [] block ;
+}
+
+}	// end unnamed namespace
+
+void presolve_parallel_postsolve (const CoinPresolveAction *paction,
+				  CoinPostsolveMatrix *prob,
+				  int numberThreads)
+{
+# if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
+  numberThreads = 1 ;
+# endif
+  if (numberThreads <= 1 || prob->profile_) {
+    CoinPresolveProfile *profile = prob->profile_ ;
+    for (; paction ; paction = paction->next) {
+      if (profile)
+	profile->postsolve(paction,prob) ;
+      else
+	paction->postsolve(prob) ;
+    }
+    return ;
+  }
+/*
+  mark[] holds, for each row and column, the number of the group which last
+  used it. Rows are at the front, columns after.
+*/
+  const int nrows0 = prob->nrows0_ ;
+  int *mark = new int [nrows0+prob->ncols0_] ;
+  CoinFillN(mark,nrows0+prob->ncols0_,-1) ;
+  int group = 0 ;
+  std::vector<const CoinPresolveAction *> actions ;
+  std::vector<CoinBigIndex> entries ;
+  std::vector<int> weight ;
+  std::vector<int> rows ;
+  std::vector<int> columns ;
+
+  for (; paction ; paction = paction->next) {
+    rows.clear() ;
+    columns.clear() ;
+    CoinBigIndex needed = 0 ;
+    if (!paction->postsolveFootprint(rows,columns,needed)) {
+      postsolve_group(prob,actions,entries,weight,numberThreads) ;
+      actions.clear() ;
+      entries.clear() ;
+      weight.clear() ;
+      group++ ;
+      paction->postsolve(prob) ;
+      continue ;
+    }
+    bool clash = false ;
+    for (size_t i = 0 ; i < rows.size() && !clash ; i++)
+      clash = (mark[rows[i]] == group) ;
+    for (size_t i = 0 ; i < columns.size() && !clash ; i++)
+      clash = (mark[nrows0+columns[i]] == group) ;
+    if (clash) {
+      postsolve_group(prob,actions,entries,weight,numberThreads) ;
+      actions.clear() ;
+      entries.clear() ;
+      weight.clear() ;
+      group++ ;
+    }
+    for (size_t i = 0 ; i < rows.size() ; i++)
+      mark[rows[i]] = group ;
+    for (size_t i = 0 ; i < columns.size() ; i++)
+      mark[nrows0+columns[i]] = group ;
+    actions.push_back(paction) ;
+    entries.push_back(needed) ;
+    weight.push_back(static_cast<int>(rows.size()+columns.size())) ;
+  }
+  postsolve_group(prob,actions,entries,weight,numberThreads) ;
+  delete [] mark ;
+}
+
+//@}
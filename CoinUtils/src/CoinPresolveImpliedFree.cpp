@@ -13,6 +13,7 @@
 #include "CoinPresolveImpliedFree.hpp"
 #include "CoinPresolveUseless.hpp"
 #include "CoinPresolveForcing.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinMessage.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinSort.hpp"
@@ -113,6 +114,7 @@ int check_row (CoinBigIndex *mrstrt,
 const CoinPresolveAction *implied_free_action::presolve (
     CoinPresolveMatrix *prob, const CoinPresolveAction *next, int &fill_level)
 {
+  COIN_TIME_SCOPE("presolve.implied_free");
 # if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 # if PRESOLVE_DEBUG > 0
   std::cout
@@ -211,7 +213,9 @@ const CoinPresolveAction *implied_free_action::presolve (
     fill_level = 2 ;
     return (next) ;
   }
+  if (prob->workExhausted()) return (next) ;
 
+  prob->syncRowActivity() ;
 /*
   Set up to collect implied_free actions.
 */
@@ -310,6 +314,8 @@ const CoinPresolveAction *implied_free_action::presolve (
     const int tgtcol_len = colLengths[tgtcol] ;
 
     if (tgtcol_len <= 0 || tgtcol_len > maxLook) continue ;
+    if (prob->workExhausted()) break ;
+    prob->addWork(tgtcol_len) ;
 /*
   Set up to reconnoiter the column.
 
@@ -391,6 +397,7 @@ const CoinPresolveAction *implied_free_action::presolve (
 
       const double ait = colCoeffs[kcol] ;
       const int leni = rowLengths[i] ;
+      prob->addWork(leni) ;
       const double rloi = rlo[i] ;
       const double rupi = rup[i] ;
 /*
@@ -415,29 +422,34 @@ const CoinPresolveAction *implied_free_action::presolve (
       const CoinBigIndex kre = krs+leni ;
 
       if (infiniteUp[i] == -1) {
-	for (CoinBigIndex krow = krs ; krow < kre ; ++krow) {
-	  const double aik = rowCoeffs[krow] ;
-	  const int k = colIndices[krow] ;
-	  const double lk = clo[k] ;
-	  const double uk = cup[k] ;
-	  if (aik > 0.0) {
-	    if (uk < large) 
-	      maxUi += uk*aik ;
-	    else
-	      ++infUi ;
-	    if (lk > -large) 
-	      maxLi += lk*aik ;
-	    else
-	      ++infLi ;
-	  } else if (aik < 0.0) {
-	    if (uk < large) 
-	      maxLi += uk*aik ;
-	    else
-	      ++infLi ;
-	    if (lk > -large) 
-	      maxUi += lk*aik ;
-	    else
-	      ++infUi ;
+/*
+  The row activity bounds cache, if it's in use, spares us the walk.
+*/
+	if (!prob->rowActivityBounds(i,maxLi,infLi,maxUi,infUi)) {
+	  for (CoinBigIndex krow = krs ; krow < kre ; ++krow) {
+	    const double aik = rowCoeffs[krow] ;
+	    const int k = colIndices[krow] ;
+	    const double lk = clo[k] ;
+	    const double uk = cup[k] ;
+	    if (aik > 0.0) {
+	      if (uk < large) 
+		maxUi += uk*aik ;
+	      else
+		++infUi ;
+	      if (lk > -large) 
+		maxLi += lk*aik ;
+	      else
+		++infLi ;
+	    } else if (aik < 0.0) {
+	      if (uk < large) 
+		maxLi += uk*aik ;
+	      else
+		++infLi ;
+	      if (lk > -large) 
+		maxUi += lk*aik ;
+	      else
+		++infUi ;
+	    }
 	  }
 	}
 	const double maxUinf = maxUi+infUi*1.0e31 ;
@@ -761,7 +773,7 @@ const CoinPresolveAction *implied_free_action::presolve (
 	}
       }
       assert(fabs(tgtrow_rhs) <= large) ;
-      double *save_costs = new double[tgtrow_len] ;
+      double *save_costs = CoinPresolveNewArray<double>(prob,tgtrow_len) ;
 
       for (CoinBigIndex krow = krs ; krow < kre ; krow++) {
 	const int j = colIndices[krow] ;
@@ -802,7 +814,7 @@ const CoinPresolveAction *implied_free_action::presolve (
 #   if PRESOLVE_SUMMARY > 0 || PRESOLVE_DEBUG > 0
     printf("NIMPLIED FREE:  %d\n", nactions) ;
 #   endif
-    action *actions1 = new action[nactions] ;
+    action *actions1 = CoinPresolveNewArray<action>(prob, nactions) ;
     CoinMemcpyN(actions, nactions, actions1) ;
     next = new implied_free_action(nactions,actions1,next) ;
   } 
@@ -1126,6 +1138,7 @@ void implied_free_action::postsolve(CoinPostsolveMatrix *prob) const
   double *rcosts = prob->rcosts_ ;
   double *acts = prob->acts_ ;
   double *rowduals = prob->rowduals_ ;
+  const unsigned char *colstat = prob->colstat_ ;
 /*
   In your dreams ... hardwired to minimisation.
 */
@@ -1182,7 +1195,7 @@ void implied_free_action::postsolve(CoinPostsolveMatrix *prob) const
 	colLengths[j] = 1 ;
 	clo[tgtcol] = f->clo ;
 	cup[tgtcol] = f->cup ;
-	rcosts[j] = -cost[tgtcol]/atj ;
+	if (rcosts) rcosts[j] = -cost[tgtcol]/atj ;
 	tgt_coeff = atj ;
       } else {
 	colLengths[j]++ ;
@@ -1269,26 +1282,30 @@ void implied_free_action::postsolve(CoinPostsolveMatrix *prob) const
 */
     const double ct = maxmin*cost[tgtcol] ;
     double possibleDual = ct/tgt_coeff ;
-    rowduals[tgtrow] = possibleDual ;
+    if (rowduals) rowduals[tgtrow] = possibleDual ;
     if (possibleDual >= 0 && rlo[tgtrow] > -large) {
       sol[tgtcol] = (rlo[tgtrow]-tgtrow_act)/tgt_coeff ;
       acts[tgtrow] = rlo[tgtrow] ;
-      prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atUpperBound) ;
+      if (colstat)
+	prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atUpperBound) ;
     } else
     if (possibleDual <= 0 && rup[tgtrow] < large) {
       sol[tgtcol] = (rup[tgtrow]-tgtrow_act)/tgt_coeff ;
       acts[tgtrow] = rup[tgtrow] ;
-      prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atLowerBound) ;
+      if (colstat)
+	prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atLowerBound) ;
     } else {
       assert(rup[tgtrow] < large || rlo[tgtrow] > -large) ;
       if (rup[tgtrow] < large) {
 	sol[tgtcol] = (rup[tgtrow]-tgtrow_act)/tgt_coeff ;
 	acts[tgtrow] = rup[tgtrow] ;
-	prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atLowerBound) ;
+	if (colstat)
+	  prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atLowerBound) ;
       } else {
 	sol[tgtcol] = (rlo[tgtrow]-tgtrow_act)/tgt_coeff ;
 	acts[tgtrow] = rlo[tgtrow] ;
-	prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atUpperBound) ;
+	if (colstat)
+	  prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atUpperBound) ;
       }
 #     if PRESOLVE_DEBUG > 0
       std::cout
@@ -1300,8 +1317,10 @@ void implied_free_action::postsolve(CoinPostsolveMatrix *prob) const
 	<< "." << std::endl ;
 #     endif
     }
-    prob->setColumnStatus(tgtcol,CoinPrePostsolveMatrix::basic) ;
-    rcosts[tgtcol] = 0.0 ;
+    if (colstat)
+      prob->setColumnStatus(tgtcol,CoinPrePostsolveMatrix::basic) ;
+    if (rcosts)
+      rcosts[tgtcol] = 0.0 ;
 
 #   if PRESOLVE_DEBUG > 2
     std::cout
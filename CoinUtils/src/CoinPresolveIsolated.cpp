@@ -8,6 +8,7 @@
 
 #include "CoinPresolveMatrix.hpp"
 #include "CoinPresolveIsolated.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinHelperFunctions.hpp"
 
 #if PRESOLVE_DEBUG || PRESOLVE_CONSISTENCY
@@ -24,6 +25,7 @@ const CoinPresolveAction *isolated_constraint_action::presolve(CoinPresolveMatri
 							    int irow,
 							    const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.isolated_constraint");
   int *hincol	= prob->hincol_;
   const CoinBigIndex *mcstrt	= prob->mcstrt_;
   int *hrow	= prob->hrow_;
@@ -186,7 +188,9 @@ void isolated_constraint_action::postsolve(CoinPostsolveMatrix *prob) const
 # endif
 
   // ???
-  prob->setRowStatus(irow,CoinPrePostsolveMatrix::basic);
+  if (prob->colstat_)
+    prob->setRowStatus(irow,CoinPrePostsolveMatrix::basic);
+  if (rowduals)
     rowduals[irow] = 0.0;
 
   rowacts[irow] = rowact;
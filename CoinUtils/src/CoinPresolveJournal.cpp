@@ -0,0 +1,266 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveJournal.hpp"
+
+/*! \file
+
+  This file contains methods for CoinPresolveJournal, used to record the
+  decisions made by presolve and replay them on a model with the same
+  structure.
+*/
+
+namespace {
+
+/*
+  Fold the values in v into the hash h (FNV-1a on ints).
+*/
+unsigned int hash_lengths (unsigned int h, const int *v, int n)
+{
+  for (int i = 0 ; i < n ; i++) {
+    h ^= static_cast<unsigned int>(v[i]) ;
+    h *= 16777619u ;
+  }
+  return (h) ;
+}
+
+/*
+  Collect the actions from first up to (not including) stop, oldest first.
+*/
+void collect_actions (const CoinPresolveAction *first,
+		      const CoinPresolveAction *stop,
+		      std::vector<const CoinPresolveAction *> &actions)
+{
+  actions.clear() ;
+  for (const CoinPresolveAction *paction = first ;
+       paction && paction != stop ; paction = paction->next)
+    actions.push_back(paction) ;
+  for (size_t i = 0, j = actions.size() ; i+1 < j ; i++, j--) {
+    const CoinPresolveAction *t = actions[i] ;
+    actions[i] = actions[j-1] ;
+    actions[j-1] = t ;
+  }
+}
+
+void write_ints (FILE *fp, const std::vector<int> &v)
+{
+  fprintf(fp,"%d",static_cast<int>(v.size())) ;
+  for (size_t i = 0 ; i < v.size() ; i++)
+    fprintf(fp," %d",v[i]) ;
+  fprintf(fp,"\n") ;
+}
+
+bool read_ints (FILE *fp, std::vector<int> &v)
+{
+  int n ;
+  if (fscanf(fp,"%d",&n) != 1 || n < 0)
+    return (false) ;
+  v.resize(n) ;
+  for (int i = 0 ; i < n ; i++) {
+    if (fscanf(fp,"%d",&v[i]) != 1)
+      return (false) ;
+  }
+  return (true) ;
+}
+
+}	// end unnamed namespace
+
+CoinPresolveJournal::CoinPresolveJournal ()
+  : numberRows_(0),
+    numberColumns_(0),
+    numberElements_(0),
+    signature_(0)
+{ }
+
+unsigned int CoinPresolveJournal::signature (const CoinPresolveMatrix *prob)
+{
+  unsigned int h = 2166136261u ;
+  h = hash_lengths(h,prob->hincol_,prob->ncols_) ;
+  h = hash_lengths(h,prob->hinrow_,prob->nrows_) ;
+  return (h) ;
+}
+
+void CoinPresolveJournal::startRecording (const CoinPresolveMatrix *prob)
+{
+  steps_.clear() ;
+  numberRows_ = prob->nrows_ ;
+  numberColumns_ = prob->ncols_ ;
+  numberElements_ = prob->nelems_ ;
+  signature_ = signature(prob) ;
+}
+
+void CoinPresolveJournal::makeStep (const CoinPresolveMatrix *prob,
+				    const CoinPresolveAction *action,
+				    CoinPresolveJournalStep &step)
+{
+  step.name = action->name() ;
+  step.rows.clear() ;
+  step.columns.clear() ;
+  step.rowLengths.clear() ;
+  step.columnLengths.clear() ;
+  CoinBigIndex entries = 0 ;
+  step.complete = action->postsolveFootprint(step.rows,step.columns,entries) ;
+  if (!step.complete) {
+    step.rows.clear() ;
+    step.columns.clear() ;
+    return ;
+  }
+  for (size_t k = 0 ; k < step.rows.size() ; k++)
+    step.rowLengths.push_back(prob->hinrow_[step.rows[k]]) ;
+  for (size_t k = 0 ; k < step.columns.size() ; k++)
+    step.columnLengths.push_back(prob->hincol_[step.columns[k]]) ;
+}
+
+void CoinPresolveJournal::record (const CoinPresolveMatrix *prob,
+				  const CoinPresolveAction *first,
+				  const CoinPresolveAction *stop)
+{
+  std::vector<const CoinPresolveAction *> actions ;
+  collect_actions(first,stop,actions) ;
+  for (size_t i = 0 ; i < actions.size() ; i++) {
+    steps_.push_back(CoinPresolveJournalStep()) ;
+    makeStep(prob,actions[i],steps_.back()) ;
+  }
+}
+
+bool CoinPresolveJournal::startReplay (const CoinPresolveMatrix *prob) const
+{
+  return (prob->nrows_ == numberRows_ &&
+	  prob->ncols_ == numberColumns_ &&
+	  prob->nelems_ == numberElements_ &&
+	  signature(prob) == signature_) ;
+}
+
+/*
+  Replace the ToDo lists with the rows and columns of the step (a footprint
+  may list a row more than once). The NextToDo lists are left alone, so
+  anything queued by earlier steps is still there when the driver falls back
+  to a normal presolve loop.
+*/
+bool CoinPresolveJournal::prepareStep (CoinPresolveMatrix *prob, int i) const
+{
+  const CoinPresolveJournalStep &step = steps_[i] ;
+  if (!step.complete) {
+    prob->initColsToDo() ;
+    prob->initRowsToDo() ;
+    return (true) ;
+  }
+  const int ncols = prob->ncols_ ;
+  const int nrows = prob->nrows_ ;
+  std::vector<int> which(step.columns) ;
+  std::sort(which.begin(),which.end()) ;
+  which.erase(std::unique(which.begin(),which.end()),which.end()) ;
+  int n = 0 ;
+  for (size_t k = 0 ; k < which.size() ; k++) {
+    const int j = which[k] ;
+    if (j < 0 || j >= ncols || prob->colProhibited(j))
+      return (false) ;
+    prob->colsToDo_[n++] = j ;
+  }
+  prob->numberColsToDo_ = n ;
+  which = step.rows ;
+  std::sort(which.begin(),which.end()) ;
+  which.erase(std::unique(which.begin(),which.end()),which.end()) ;
+  n = 0 ;
+  for (size_t k = 0 ; k < which.size() ; k++) {
+    const int r = which[k] ;
+    if (r < 0 || r >= nrows || prob->rowProhibited(r))
+      return (false) ;
+    prob->rowsToDo_[n++] = r ;
+  }
+  prob->numberRowsToDo_ = n ;
+  return (true) ;
+}
+
+int CoinPresolveJournal::checkStep (const CoinPresolveMatrix *prob, int i,
+				    const CoinPresolveAction *first,
+				    const CoinPresolveAction *stop) const
+{
+  std::vector<const CoinPresolveAction *> actions ;
+  collect_actions(first,stop,actions) ;
+  if (actions.empty() || i+actions.size() > steps_.size())
+    return (0) ;
+  for (size_t k = 0 ; k < actions.size() ; k++) {
+    const CoinPresolveJournalStep &step = steps_[i+k] ;
+    CoinPresolveJournalStep now ;
+    makeStep(prob,actions[k],now) ;
+    if (!(now.name == step.name &&
+	  now.complete == step.complete &&
+	  now.rows == step.rows &&
+	  now.columns == step.columns &&
+	  now.rowLengths == step.rowLengths &&
+	  now.columnLengths == step.columnLengths))
+      return (0) ;
+  }
+  return (static_cast<int>(actions.size())) ;
+}
+
+/*
+  The file is plain text: a header line, the size and signature, the number
+  of steps, then for each step a line with the name and complete flag
+  followed by four lines of counted integer lists.
+*/
+int CoinPresolveJournal::write (const char *filename) const
+{
+  FILE *fp = fopen(filename,"w") ;
+  if (!fp)
+    return (-1) ;
+  fprintf(fp,"CoinPresolveJournal 1\n") ;
+  fprintf(fp,"%d %d %ld %u\n",numberRows_,numberColumns_,
+	  static_cast<long>(numberElements_),signature_) ;
+  fprintf(fp,"%d\n",numberSteps()) ;
+  for (size_t i = 0 ; i < steps_.size() ; i++) {
+    const CoinPresolveJournalStep &step = steps_[i] ;
+    fprintf(fp,"%s %d\n",step.name.c_str(),step.complete ? 1 : 0) ;
+    write_ints(fp,step.rows) ;
+    write_ints(fp,step.columns) ;
+    write_ints(fp,step.rowLengths) ;
+    write_ints(fp,step.columnLengths) ;
+  }
+  fclose(fp) ;
+  return (0) ;
+}
+
+int CoinPresolveJournal::read (const char *filename)
+{
+  FILE *fp = fopen(filename,"r") ;
+  if (!fp)
+    return (-1) ;
+  char name[256] ;
+  int version = 0 ;
+  long elements = 0 ;
+  int number = 0 ;
+  bool ok = (fscanf(fp,"%255s %d",name,&version) == 2 &&
+	     !strcmp(name,"CoinPresolveJournal") && version == 1) ;
+  ok = ok && fscanf(fp,"%d %d %ld %u",&numberRows_,&numberColumns_,
+		    &elements,&signature_) == 4 ;
+  ok = ok && fscanf(fp,"%d",&number) == 1 && number >= 0 ;
+  numberElements_ = static_cast<CoinBigIndex>(elements) ;
+  steps_.clear() ;
+  for (int i = 0 ; ok && i < number ; i++) {
+    CoinPresolveJournalStep step ;
+    int complete = 0 ;
+    ok = fscanf(fp,"%255s %d",name,&complete) == 2 ;
+    step.name = name ;
+    step.complete = (complete != 0) ;
+    ok = ok && read_ints(fp,step.rows) && read_ints(fp,step.columns) &&
+	 read_ints(fp,step.rowLengths) && read_ints(fp,step.columnLengths) ;
+    if (ok)
+      steps_.push_back(step) ;
+  }
+  fclose(fp) ;
+  if (!ok) {
+    steps_.clear() ;
+    return (-2) ;
+  }
+  return (0) ;
+}
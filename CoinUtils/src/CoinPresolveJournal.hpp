@@ -0,0 +1,148 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPresolveJournal_H
+#define CoinPresolveJournal_H
+
+#include <string>
+#include <vector>
+
+#include "CoinTypes.hpp"
+
+class CoinPresolveAction ;
+class CoinPresolveMatrix ;
+
+/*! \brief One structural decision made by a presolve transform */
+typedef struct {
+  /// Name of action class (CoinPresolveAction::name())
+  std::string name ;
+  /*! \brief Rows and columns the action covers
+
+    Taken from CoinPresolveAction::postsolveFootprint. Empty, with
+    #complete false, for an action which doesn't report a footprint.
+  */
+  std::vector<int> rows ;
+  std::vector<int> columns ;
+  /// Row and column lengths after the transform, in the same order
+  std::vector<int> rowLengths ;
+  std::vector<int> columnLengths ;
+  /// True if rows and columns are the whole footprint
+  bool complete ;
+} CoinPresolveJournalStep ;
+
+/*!
+  \brief Record of presolve decisions for replay on a similar model
+
+  A model solved over and over with new data but the same structure tends
+  to be presolved the same way each time. The journal records, in order,
+  the actions each transform created and the rows and columns they cover,
+  so that later presolves can aim each transform at the same candidates
+  instead of scanning the whole matrix.
+
+  Recording: call startRecording() once the CoinPresolveMatrix is loaded,
+  then record() after each transform with the action list before and after
+  the call. write() and read() keep the journal between runs.
+
+  Replay: startReplay() checks that the new model has the same size and
+  sparsity pattern as the recorded one. Then for each step in turn the
+  driver calls prepareStep(), which loads the step's rows and columns as
+  the ToDo lists, runs the transform named by stepName(), and calls
+  checkStep() on the actions it created to find the next step. Validation
+  costs time in proportion to the rows and columns of the step. If any of
+  these fail,
+  the problem is still valid (every action taken is a genuine presolve
+  action on the new data); the driver should stop replaying, call
+  CoinPresolveMatrix::initColsToDo and initRowsToDo, and continue with
+  its normal presolve loop.
+
+  Steps for an action which doesn't report a footprint can't be aimed;
+  prepareStep() loads every row and column and checkStep() compares only
+  the action name.
+*/
+class CoinPresolveJournal
+{
+public:
+  /*! \name Recording */
+  //@{
+  /// Clear the journal and note the size and structure of \p prob
+  void startRecording(const CoinPresolveMatrix *prob) ;
+  /*! \brief Record the actions created by one transform
+
+    \p first is the head of the action list after the transform,
+    \p stop the head before it. Actions are recorded in the order they
+    were created.
+  */
+  void record(const CoinPresolveMatrix *prob,
+	      const CoinPresolveAction *first,
+	      const CoinPresolveAction *stop) ;
+  //@}
+
+  /*! \name Replay */
+  //@{
+  /// True if \p prob has the size and structure recorded
+  bool startReplay(const CoinPresolveMatrix *prob) const ;
+  /// Number of steps
+  inline int numberSteps() const
+  { return static_cast<int>(steps_.size()) ; }
+  /// Step i
+  inline const CoinPresolveJournalStep &step(int i) const
+  { return (steps_[i]) ; }
+  /// Name of the transform which created the action for step i
+  inline const char *stepName(int i) const
+  { return (steps_[i].name.c_str()) ; }
+  /*! \brief Load the ToDo lists for step i
+
+    Returns false if a recorded row or column is out of range or
+    prohibited.
+  */
+  bool prepareStep(CoinPresolveMatrix *prob, int i) const ;
+  /*! \brief Check the actions created for step i
+
+    \p first and \p stop are as for record(). The actions must match
+    steps i, i+1, ... in class and footprint and leave the recorded
+    lengths. Returns the number of steps matched (the driver carries on
+    from step i plus that number), or 0 if the transform created nothing
+    or anything that doesn't match.
+  */
+  int checkStep(const CoinPresolveMatrix *prob, int i,
+		const CoinPresolveAction *first,
+		const CoinPresolveAction *stop) const ;
+  //@}
+
+  /*! \name Saving */
+  //@{
+  /** Writes the journal as text.
+      Returns 0 if OK, -1 if the file can not be opened. */
+  int write(const char *filename) const ;
+  /** Reads a journal written by write().
+      Returns 0 if OK, -1 if the file can not be opened, -2 if it is not
+      a journal. */
+  int read(const char *filename) ;
+  //@}
+
+  /*! \name Constructor */
+  //@{
+  /// Default constructor
+  CoinPresolveJournal() ;
+  //@}
+
+private:
+  /// Structure signature of prob
+  static unsigned int signature(const CoinPresolveMatrix *prob) ;
+  /// Fill in a step from an action
+  static void makeStep(const CoinPresolveMatrix *prob,
+		       const CoinPresolveAction *action,
+		       CoinPresolveJournalStep &step) ;
+
+  /// Rows, columns, coefficients and signature when recording started
+  int numberRows_ ;
+  int numberColumns_ ;
+  CoinBigIndex numberElements_ ;
+  unsigned int signature_ ;
+  /// Steps in the order the actions were created
+  std::vector<CoinPresolveJournalStep> steps_ ;
+} ;
+
+#endif
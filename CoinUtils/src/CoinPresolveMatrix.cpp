@@ -4,13 +4,16 @@
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
 #include <stdio.h>
+#include <math.h>
 
 #include <cassert>
 #include <iostream>
 
+#include "CoinFinite.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
 #include "CoinTime.hpp"
+#include "CoinThreadPool.hpp"
 
 /*! \file
 
@@ -58,6 +61,10 @@ CoinPresolveMatrix::CoinPresolveMatrix
     status_(-1),
     pass_(0),
     maxSubstLevel_(3),
+    workDone_(0.0),
+    workLimit_(COIN_DBL_MAX),
+    techniqueWorkLimit_(COIN_DBL_MAX),
+    techniqueWorkStart_(0.0),
     colChanged_(0),
     colsToDo_(0),
     numberColsToDo_(0),
@@ -71,6 +78,8 @@ CoinPresolveMatrix::CoinPresolveMatrix
     numberNextRowsToDo_(0),
     presolveOptions_(0),
     anyProhibited_(false),
+    numberThreads_(1),
+    arena_(NULL),
     usefulRowInt_(NULL),
     usefulRowDouble_(NULL),
     usefulColumnInt_(NULL),
@@ -79,7 +88,18 @@ CoinPresolveMatrix::CoinPresolveMatrix
     infiniteUp_(NULL),
     sumUp_(NULL),
     infiniteDown_(NULL),
-    sumDown_(NULL)
+    sumDown_(NULL),
+    activityDown_(NULL),
+    activityUp_(NULL),
+    activityInfDown_(NULL),
+    activityInfUp_(NULL),
+    activityHuge_(NULL),
+    activityNorm_(NULL),
+    activityUpdates_(NULL),
+    activityRowLength_(NULL),
+    activityColLength_(NULL),
+    activityColLower_(NULL),
+    activityColUpper_(NULL)
 
 { /* nothing to do here */ 
 
@@ -115,11 +135,56 @@ CoinPresolveMatrix::~CoinPresolveMatrix()
   delete[] sumUp_;
   delete[] infiniteDown_;
   delete[] sumDown_;
+  stopRowActivity() ;
 
   return ; }
 
 
 
+namespace {
+
+/*
+  A block of columns for the parallel row-major copy. The first pass counts
+  the coefficients of the block in each row; the second drops them into
+  place, count then holding where the block starts in each row.
+*/
+typedef struct {
+  const CoinBigIndex *mcstrt ;
+  const int *hincol ;
+  const int *hrow ;
+  const double *colels ;
+  int *hcol ;
+  double *rowels ;
+  CoinBigIndex *count ;
+  int first ;
+  int last ;
+  bool scatter ;
+} presolve_row_block ;
+
+void *presolve_row_worker (void *voidBlock)
+{
+  presolve_row_block *block = reinterpret_cast<presolve_row_block *>(voidBlock) ;
+  CoinBigIndex *count = block->count ;
+  for (int j = block->first ; j < block->last ; j++) {
+    const int *rowIndices = block->hrow+block->mcstrt[j] ;
+    const double *colCoeffs = block->colels+block->mcstrt[j] ;
+    int lenj = block->hincol[j] ;
+    if (!block->scatter) {
+      for (int k = 0 ; k < lenj ; k++)
+	count[rowIndices[k]]++ ;
+    } else {
+      for (int k = 0 ; k < lenj ; k++) {
+	CoinBigIndex l = count[rowIndices[k]]++ ;
+	block->rowels[l] = colCoeffs[k] ;
+	block->hcol[l] = j ;
+      }
+    }
+  }
+  return NULL ;
+}
+
+}	// end unnamed namespace
+
 /*
   This routine loads a CoinPackedMatrix and proceeds to do the bulk of the
   initialisation for the PrePostsolve and Presolve objects.
@@ -171,11 +236,6 @@ void CoinPresolveMatrix::setMatrix (const CoinPackedMatrix *mtx)
   if (hincol_ == 0) hincol_ = new int [ncols0_+1] ;
   if (hrow_ == 0) hrow_ = new int [bulk0_] ;
   if (colels_ == 0) colels_ = new double [bulk0_] ;
-
-  if (mrstrt_ == 0) mrstrt_ = new CoinBigIndex [nrows0_+1] ;
-  if (hinrow_ == 0) hinrow_ = new int [nrows0_+1] ;
-  if (hcol_ == 0) hcol_ = new int [bulk0_] ;
-  if (rowels_ == 0) rowels_ = new double [bulk0_] ;
 /*
   Grab the corresponding vectors from the source matrix.
 */
@@ -200,40 +260,166 @@ void CoinPresolveMatrix::setMatrix (const CoinPackedMatrix *mtx)
     CoinBigIndex offset = mcstrt_[j] ;
     CoinMemcpyN(src_colels+offset,lenj,colels_+offset) ;
     CoinMemcpyN(src_hrow+offset,lenj,hrow_+offset) ; }
+  finishMatrix() ;
+  return ; }
+
+/*
+  As setMatrix, but the coefficient arrays of the source are taken rather
+  than copied. If they already have room for bulk0_ coefficients they become
+  hrow_ and colels_ as they are; otherwise they are copied into bulk storage
+  and freed at once, before the row-major copy is made, so the source and
+  both presolve copies are never held together.
+*/
+
+void CoinPresolveMatrix::moveMatrix (CoinPackedMatrix &mtx)
+
+{
+  if (mtx.isColOrdered() == false)
+  { throw CoinError("source matrix must be column ordered",
+		    "moveMatrix","CoinPrePostsolveMatrix") ; }
+  mtx.compactTail() ;
+  int numCols = mtx.getNumCols() ;
+  if (numCols > ncols0_)
+  { throw CoinError("source matrix exceeds allocated capacity",
+		    "moveMatrix","CoinPrePostsolveMatrix") ; }
+  ncols_ = numCols ;
+  nrows_ = mtx.getNumRows() ;
+  nelems_ = mtx.getNumElements() ;
+  bulk0_ = static_cast<CoinBigIndex> (bulkRatio_*nelems0_) ;
+
+  double *src_colels ;
+  int *src_hrow ;
+  CoinBigIndex *src_mcstrt ;
+  int *src_hincol ;
+  int maxMajor ;
+  CoinBigIndex maxSize ;
+  mtx.releaseMatrix(src_colels,src_hrow,src_mcstrt,src_hincol,
+		    maxMajor,maxSize) ;
+  assert(src_mcstrt[ncols_] <= bulk0_) ;
+
+  if (mcstrt_ == 0) mcstrt_ = new CoinBigIndex [ncols0_+1] ;
+  if (hincol_ == 0) hincol_ = new int [ncols0_+1] ;
+  CoinMemcpyN(src_mcstrt,ncols_+1,mcstrt_) ;
+  CoinMemcpyN(src_hincol,ncols_,hincol_) ;
+  delete [] src_mcstrt ;
+  delete [] src_hincol ;
+  if (maxSize >= bulk0_ && hrow_ == 0 && colels_ == 0) {
+    hrow_ = src_hrow ;
+    colels_ = src_colels ;
+  } else {
+    if (hrow_ == 0) hrow_ = new int [bulk0_] ;
+    for (int j = 0 ; j < ncols_ ; j++)
+      CoinMemcpyN(src_hrow+mcstrt_[j],hincol_[j],hrow_+mcstrt_[j]) ;
+    delete [] src_hrow ;
+    if (colels_ == 0) colels_ = new double [bulk0_] ;
+    for (int j = 0 ; j < ncols_ ; j++)
+      CoinMemcpyN(src_colels+mcstrt_[j],hincol_[j],colels_+mcstrt_[j]) ;
+    delete [] src_colels ;
+  }
+  finishMatrix() ;
+  return ; }
+
+/*
+  Make the row-major copy from the column-major one, then set up the rest of
+  the structures which depend on the matrix.
+*/
+
+void CoinPresolveMatrix::finishMatrix ()
+
+{
+  if (mrstrt_ == 0) mrstrt_ = new CoinBigIndex [nrows0_+1] ;
+  if (hinrow_ == 0) hinrow_ = new int [nrows0_+1] ;
+  if (hcol_ == 0) hcol_ = new int [bulk0_] ;
+  if (rowels_ == 0) rowels_ = new double [bulk0_] ;
+  int j ;
+  int i ;
+  int numberThreads = CoinMin(numberThreads_,ncols_) ;
+  if (numberThreads > 1) {
+/*
+  Split the columns into blocks with about the same number of coefficients.
+  Each block counts its coefficients in each row; the counts then become the
+  place where the block starts in each row, so the blocks scatter in
+  parallel and the copy is the same as the serial one.
+*/
+    presolve_row_block *block = new presolve_row_block [numberThreads] ;
+    CoinBigIndex *count = new CoinBigIndex [numberThreads*nrows_] ;
+    CoinZeroN(count,numberThreads*nrows_) ;
+    double target = static_cast<double>(nelems_+ncols_)/numberThreads ;
+    double sum = 0.0 ;
+    j = 0 ;
+    for (int t = 0 ; t < numberThreads ; t++) {
+      presolve_row_block &b = block[t] ;
+      b.mcstrt = mcstrt_ ;
+      b.hincol = hincol_ ;
+      b.hrow = hrow_ ;
+      b.colels = colels_ ;
+      b.hcol = hcol_ ;
+      b.rowels = rowels_ ;
+      b.count = count+t*nrows_ ;
+      b.first = j ;
+      if (t == numberThreads-1) {
+	j = ncols_ ;
+      } else {
+	while (j < ncols_ && sum < (t+1)*target)
+	  sum += hincol_[j++]+1 ;
+      }
+      b.last = j ;
+      b.scatter = false ;
+    }
+    CoinThreadPool::run(presolve_row_worker,block,sizeof(block[0]),
+			numberThreads) ;
+    CoinBigIndex totalCoeffs = 0 ;
+    for (i = 0 ; i < nrows_ ; i++) {
+      mrstrt_[i] = totalCoeffs ;
+      for (int t = 0 ; t < numberThreads ; t++) {
+	CoinBigIndex n = count[t*nrows_+i] ;
+	count[t*nrows_+i] = totalCoeffs ;
+	totalCoeffs += n ;
+      }
+      hinrow_[i] = static_cast<int>(totalCoeffs-mrstrt_[i]) ;
+    }
+    mrstrt_[nrows_] = totalCoeffs ;
+    for (int t = 0 ; t < numberThreads ; t++)
+      block[t].scatter = true ;
+    CoinThreadPool::run(presolve_row_worker,block,sizeof(block[0]),
+			numberThreads) ;
+    delete [] count ;
+    delete [] block ;
+  } else {
 /*
   Now make a row-major copy. Start by counting the number of coefficients in
   each row; we can do this directly in hinrow. Given the number of
   coefficients in a row, we know how to lay out the bulk storage area.
 */
-  CoinZeroN(hinrow_,nrows0_+1) ;
-  for ( j = 0 ; j < ncols_ ; j++)
-  { int *rowIndices = hrow_+mcstrt_[j] ;
-    int lenj = hincol_[j] ;
-    for (int k = 0 ; k < lenj ; k++)
-    { int i = rowIndices[k] ;
-      hinrow_[i]++ ; } }
+    CoinZeroN(hinrow_,nrows0_+1) ;
+    for ( j = 0 ; j < ncols_ ; j++)
+    { int *rowIndices = hrow_+mcstrt_[j] ;
+      int lenj = hincol_[j] ;
+      for (int k = 0 ; k < lenj ; k++)
+      { int i = rowIndices[k] ;
+        hinrow_[i]++ ; } }
 /*
   Initialize mrstrt[i] to the start of row i+1. As we drop each coefficient
   and column index into the bulk storage arrays, we'll decrement and store.
   When we're done, mrstrt[i] will point to the start of row i, as it should.
 */
-  int totalCoeffs = 0 ;
-  int i;
-  for ( i = 0 ; i < nrows_ ; i++)
-  { totalCoeffs += hinrow_[i] ;
-    mrstrt_[i] = totalCoeffs ; }
-  mrstrt_[nrows_] = totalCoeffs ;
-  for ( j = ncols_-1 ; j >= 0 ; j--)
-  { int lenj = hincol_[j] ;
-    double *colCoeffs = colels_+mcstrt_[j] ;
-    int *rowIndices = hrow_+mcstrt_[j] ;
-    for (int k = 0 ; k < lenj ; k++)
-    { int ri;
-      ri = rowIndices[k] ;
-      double aij = colCoeffs[k] ;
-      CoinBigIndex l = --mrstrt_[ri] ;
-      rowels_[l] = aij ;
-      hcol_[l] = j ; } }
+    int totalCoeffs = 0 ;
+    for ( i = 0 ; i < nrows_ ; i++)
+    { totalCoeffs += hinrow_[i] ;
+      mrstrt_[i] = totalCoeffs ; }
+    mrstrt_[nrows_] = totalCoeffs ;
+    for ( j = ncols_-1 ; j >= 0 ; j--)
+    { int lenj = hincol_[j] ;
+      double *colCoeffs = colels_+mcstrt_[j] ;
+      int *rowIndices = hrow_+mcstrt_[j] ;
+      for (int k = 0 ; k < lenj ; k++)
+      { int ri;
+        ri = rowIndices[k] ;
+        double aij = colCoeffs[k] ;
+        CoinBigIndex l = --mrstrt_[ri] ;
+        rowels_[l] = aij ;
+        hcol_[l] = j ; } }
+  }
 /*
   Now the support structures. The entry for original column j should start
   out as j; similarly for row i. originalColumn_ and originalRow_ belong to
@@ -256,6 +442,8 @@ void CoinPresolveMatrix::setMatrix (const CoinPackedMatrix *mtx)
   if (rlink_ == 0) rlink_ = new presolvehlink [nrows0_+1] ;
   presolve_make_memlists(/*mcstrt_,*/hincol_,clink_,ncols_) ;
   presolve_make_memlists(/*mrstrt_,*/hinrow_,rlink_,nrows_) ;
+  cspace_.clearFree() ;
+  rspace_.clearFree() ;
   mcstrt_[ncols_] = bulk0_ ;
   mrstrt_[nrows_] = bulk0_ ;
 /*
@@ -446,6 +634,231 @@ void CoinPresolveMatrix::deleteStuff()
   sumDown_ = NULL;
 }
 
+/*
+  Row activity bounds cache.
+*/
+
+namespace {
+
+/*
+  Add (sign = 1) or remove (sign = -1) the contribution of a(ij)x(j), with
+  l(j) <= x(j) <= u(j), to the lower (down) and upper (up) bounds on the
+  activity of a row. Removal must see the same a(ij), l(j), u(j) as the
+  addition did. The norm only ever grows.
+*/
+inline void activityTerm (double aij, double lj, double uj, int sign,
+			  double &down, double &up, int &infDown, int &infUp,
+			  int &huge, double &norm)
+{
+  const double hugeBound = 1.0e10 ;
+  if (aij == 0.0) {
+    huge += sign ;
+    return ;
+  }
+  const double bDown = (aij > 0.0)?lj:uj ;
+  const double bUp = (aij > 0.0)?uj:lj ;
+  if ((aij > 0.0)?(lj <= -PRESOLVE_INF):(uj >= PRESOLVE_INF)) {
+    infDown += sign ;
+  } else if (fabs(bDown) >= hugeBound) {
+    huge += sign ;
+  } else {
+    const double value = aij*bDown ;
+    if (sign > 0) {
+      down += value ;
+      norm += fabs(value) ;
+    } else {
+      down -= value ;
+    }
+  }
+  if ((aij > 0.0)?(uj >= PRESOLVE_INF):(lj <= -PRESOLVE_INF)) {
+    infUp += sign ;
+  } else if (fabs(bUp) >= hugeBound) {
+    huge += sign ;
+  } else {
+    const double value = aij*bUp ;
+    if (sign > 0) {
+      up += value ;
+      norm += fabs(value) ;
+    } else {
+      up -= value ;
+    }
+  }
+}
+
+/*
+  Incremental updates to a row before it's recomputed, to keep the rounding
+  error within rowActivityError.
+*/
+const int maxActivityUpdates = 32 ;
+
+}	// end file-local namespace
+
+void CoinPresolveMatrix::startRowActivity ()
+{
+  stopRowActivity() ;
+  activityDown_ = new double [nrows_] ;
+  activityUp_ = new double [nrows_] ;
+  activityInfDown_ = new int [nrows_] ;
+  activityInfUp_ = new int [nrows_] ;
+  activityHuge_ = new int [nrows_] ;
+  activityNorm_ = new double [nrows_] ;
+  activityUpdates_ = new int [nrows_] ;
+  activityRowLength_ = new int [nrows_] ;
+  activityColLength_ = CoinCopyOfArray(hincol_,ncols_) ;
+  activityColLower_ = CoinCopyOfArray(clo_,ncols_) ;
+  activityColUpper_ = CoinCopyOfArray(cup_,ncols_) ;
+  for (int i = 0 ; i < nrows_ ; i++)
+    computeRowActivity(i) ;
+}
+
+void CoinPresolveMatrix::stopRowActivity ()
+{
+  delete[] activityDown_ ;
+  delete[] activityUp_ ;
+  delete[] activityInfDown_ ;
+  delete[] activityInfUp_ ;
+  delete[] activityHuge_ ;
+  delete[] activityNorm_ ;
+  delete[] activityUpdates_ ;
+  delete[] activityRowLength_ ;
+  delete[] activityColLength_ ;
+  delete[] activityColLower_ ;
+  delete[] activityColUpper_ ;
+  activityDown_ = NULL ;
+  activityUp_ = NULL ;
+  activityInfDown_ = NULL ;
+  activityInfUp_ = NULL ;
+  activityHuge_ = NULL ;
+  activityNorm_ = NULL ;
+  activityUpdates_ = NULL ;
+  activityRowLength_ = NULL ;
+  activityColLength_ = NULL ;
+  activityColLower_ = NULL ;
+  activityColUpper_ = NULL ;
+}
+
+/*
+  Recompute row i from the column bounds the cache has seen, so that a later
+  updateColumnActivity applies the right change.
+*/
+void CoinPresolveMatrix::computeRowActivity (int i)
+{
+  if (!activityUpdates_) return ;
+  double down = 0.0 ;
+  double up = 0.0 ;
+  int infDown = 0 ;
+  int infUp = 0 ;
+  int huge = 0 ;
+  double norm = 0.0 ;
+  const CoinBigIndex krs = mrstrt_[i] ;
+  const CoinBigIndex kre = krs+hinrow_[i] ;
+  for (CoinBigIndex k = krs ; k < kre ; k++) {
+    const int j = hcol_[k] ;
+    activityTerm(rowels_[k],activityColLower_[j],activityColUpper_[j],1,
+		 down,up,infDown,infUp,huge,norm) ;
+  }
+  activityDown_[i] = down ;
+  activityUp_[i] = up ;
+  activityInfDown_[i] = infDown ;
+  activityInfUp_[i] = infUp ;
+  activityHuge_[i] = huge ;
+  activityNorm_[i] = norm ;
+  activityUpdates_[i] = 0 ;
+  activityRowLength_[i] = hinrow_[i] ;
+}
+
+/*
+  Swap the old bounds of column j for the new ones in each up to date row.
+*/
+void CoinPresolveMatrix::updateColumnActivityGuts (int j)
+{
+  const double lj = clo_[j] ;
+  const double uj = cup_[j] ;
+  const double oldlj = activityColLower_[j] ;
+  const double olduj = activityColUpper_[j] ;
+  const CoinBigIndex kcs = mcstrt_[j] ;
+  const CoinBigIndex kce = kcs+hincol_[j] ;
+  for (CoinBigIndex k = kcs ; k < kce ; k++) {
+    const int i = hrow_[k] ;
+    if (activityUpdates_[i] < 0) continue ;
+    const double aij = colels_[k] ;
+    activityTerm(aij,oldlj,olduj,-1,activityDown_[i],activityUp_[i],
+		 activityInfDown_[i],activityInfUp_[i],activityHuge_[i],
+		 activityNorm_[i]) ;
+    activityTerm(aij,lj,uj,1,activityDown_[i],activityUp_[i],
+		 activityInfDown_[i],activityInfUp_[i],activityHuge_[i],
+		 activityNorm_[i]) ;
+    if (++activityUpdates_[i] > maxActivityUpdates)
+      activityUpdates_[i] = -1 ;
+  }
+  activityColLower_[j] = lj ;
+  activityColUpper_[j] = uj ;
+}
+
+/*
+  Mark rows whose entries may have changed, fold in bound changes for the
+  remaining rows, then recompute the marked rows. The work is O(nrows+ncols)
+  plus the lengths of changed columns and rows.
+*/
+void CoinPresolveMatrix::syncRowActivity ()
+{
+  if (!activityUpdates_) return ;
+  for (int i = 0 ; i < nrows_ ; i++) {
+    if (hinrow_[i] != activityRowLength_[i])
+      activityUpdates_[i] = -1 ;
+  }
+  for (int j = 0 ; j < ncols_ ; j++) {
+    if (hincol_[j] != activityColLength_[j]) {
+      const CoinBigIndex kcs = mcstrt_[j] ;
+      const CoinBigIndex kce = kcs+hincol_[j] ;
+      for (CoinBigIndex k = kcs ; k < kce ; k++)
+	activityUpdates_[hrow_[k]] = -1 ;
+      activityColLength_[j] = hincol_[j] ;
+      activityColLower_[j] = clo_[j] ;
+      activityColUpper_[j] = cup_[j] ;
+    } else if (clo_[j] != activityColLower_[j] ||
+	       cup_[j] != activityColUpper_[j]) {
+      updateColumnActivityGuts(j) ;
+    }
+  }
+  for (int i = 0 ; i < nrows_ ; i++) {
+    if (activityUpdates_[i] < 0)
+      computeRowActivity(i) ;
+  }
+# if PRESOLVE_CONSISTENCY > 0
+  assert(!checkRowActivity()) ;
+# endif
+}
+
+int CoinPresolveMatrix::checkRowActivity () const
+{
+  if (!activityUpdates_) return (0) ;
+  int numberBad = 0 ;
+  for (int i = 0 ; i < nrows_ ; i++) {
+    if (activityUpdates_[i] < 0 || activityRowLength_[i] != hinrow_[i])
+      continue ;
+    double down = 0.0 ;
+    double up = 0.0 ;
+    int infDown = 0 ;
+    int infUp = 0 ;
+    int huge = 0 ;
+    double norm = 0.0 ;
+    const CoinBigIndex krs = mrstrt_[i] ;
+    const CoinBigIndex kre = krs+hinrow_[i] ;
+    for (CoinBigIndex k = krs ; k < kre ; k++) {
+      const int j = hcol_[k] ;
+      activityTerm(rowels_[k],clo_[j],cup_[j],1,
+		   down,up,infDown,infUp,huge,norm) ;
+    }
+    const double error = rowActivityError(i) ;
+    if (infDown != activityInfDown_[i] || infUp != activityInfUp_[i] ||
+	huge != activityHuge_[i] || fabs(down-activityDown_[i]) > error ||
+	fabs(up-activityUp_[i]) > error)
+      numberBad++ ;
+  }
+  return (numberBad) ;
+}
+
 
 /*
   These functions set integer type information. The first expects an array with
@@ -565,6 +978,25 @@ int CoinPresolveMatrix::stepColsToDo ()
 
   return (numberColsToDo_) ; }
 
+int CoinPresolveMatrix::changedCols (int *cols) const
+/*
+  Collect the columns on either ToDo list. Columns on nextColsToDo_ all have
+  the changed bit set; a column on colsToDo_ with the bit set has been added
+  again and is taken from nextColsToDo_.
+*/
+{ int n = 0 ;
+
+  for (int k = 0 ; k < numberNextColsToDo_ ; k++)
+  { int j = nextColsToDo_[k] ;
+    if (!colProhibited2(j))
+    { cols[n++] = j ; } }
+  for (int k = 0 ; k < numberColsToDo_ ; k++)
+  { int j = colsToDo_[k] ;
+    if (!colChanged(j) && !colProhibited2(j))
+    { cols[n++] = j ; } }
+
+  return (n) ; }
+
 int CoinPresolveMatrix::stepRowsToDo ()
 /*
   This routine transfers the contents of NextToDo to ToDo, simultaneously
@@ -588,6 +1020,17 @@ CoinPresolveMatrix::statistics()
   tuning_=true;
   startTime_ = CoinCpuTime();
 }
+// Sets number of threads for detection scans
+void 
+CoinPresolveMatrix::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value,1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
 #ifdef PRESOLVE_DEBUG
 #include "CoinPresolvePsdebug.cpp"
 #endif
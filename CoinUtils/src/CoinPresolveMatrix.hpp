@@ -10,10 +10,13 @@
 #include "CoinPackedMatrix.hpp"
 #include "CoinMessage.hpp"
 #include "CoinTime.hpp"
+#include "CoinArena.hpp"
+#include "CoinHelperFunctions.hpp"
 
 #include <cmath>
 #include <cassert>
 #include <cfloat>
+#include <vector>
 #include <cassert>
 #include <cstdlib>
 
@@ -30,13 +33,23 @@
 */
 
 
+/*! \brief Free an array which may have come from a presolve arena
+
+  Arrays from CoinPresolveNewArray or CoinPresolveCopyOfArray live in the
+  arena (if any) and are freed when it is released; anything else is freed
+  with delete[].  Postsolve objects must be deleted before their arena is
+  released.
+*/
+template <class T> inline void CoinPresolveDeleteArray (T *array)
+{ if (!CoinArena::anyOwns(array)) delete [] array ; }
+
 #if defined(_MSC_VER)
 // Avoid MS Compiler problem in recognizing type to delete
 // by casting to type.
 // Is this still necessary? -- lh, 111202 --
-#define deleteAction(array,type) delete [] ((type) array)
+#define deleteAction(array,type) CoinPresolveDeleteArray((type) array)
 #else
-#define deleteAction(array,type) delete [] array
+#define deleteAction(array,type) CoinPresolveDeleteArray(array)
 #endif
 
 /*
@@ -103,6 +116,7 @@ const double ZTOLDP2 = 1e-10 ;
 
 
 class CoinPostsolveMatrix ;
+class CoinPresolveProfile ;
 
 /*! \class CoinPresolveAction
     \brief Abstract base class of all presolve routines.
@@ -192,6 +206,33 @@ class CoinPresolveAction
   */
   virtual void postsolve(CoinPostsolveMatrix *prob) const = 0;
 
+  /*! \brief Rows and columns used by postsolve
+
+    Used by presolve_parallel_postsolve to find consecutive actions which
+    can be postsolved at the same time. Append to \p rows and \p columns
+    every row and column whose data postsolve reads or writes, and set
+    \p entries to the number of coefficients postsolve takes from the free
+    list. Return false (the default) if postsolve may use anything else
+    (the matrix as a whole, or problem-wide values); the action is then
+    always postsolved on its own.
+  */
+  virtual bool postsolveFootprint(std::vector<int> &/*rows*/,
+				  std::vector<int> &/*columns*/,
+				  CoinBigIndex &/*entries*/) const
+  { return (false) ; }
+
+  /*! \brief Apply postsolve, taking coefficients from \p freeList
+
+    Called (possibly from a thread) in place of #postsolve for an action
+    whose #postsolveFootprint returned true. It must take free entries from
+    \p freeList rather than CoinPostsolveMatrix::free_list_, and must not
+    touch rows or columns outside its footprint. An action which reports a
+    footprint must override this.
+  */
+  virtual void postsolveWithFreeList(CoinPostsolveMatrix *prob,
+				     CoinBigIndex &/*freeList*/) const
+  { postsolve(prob) ; }
+
   /*! \brief Virtual destructor. */
   virtual ~CoinPresolveAction() {}
 };
@@ -237,9 +278,11 @@ class CoinWarmStartBasis ;
 
     The second is addressed by a generous allocation of extra (empty) space
     for the arrays used to hold coefficients and row indices. When columns
-    must be expanded, they are moved into the empty space. When it is used up,
-    the arrays are compacted. When compaction fails to produce sufficient
-    space, presolve/postsolve will fail.
+    must be expanded, they are moved into the empty space, or into space
+    left behind by an earlier move (see presolvehspace). When it is used up,
+    the arrays are compacted, starting from the end and going only as far
+    back as needed. When compaction fails to produce sufficient space,
+    presolve/postsolve will fail.
 
     CoinPrePostsolveMatrix isn't really intended to be used `bare' --- the
     expectation is that it'll be used through CoinPresolveMatrix or
@@ -535,6 +578,20 @@ class CoinPrePostsolveMatrix
   { return messages_; }
   //@}
 
+  /*! \name Profiling */
+  //@{
+  /// Return profile (NULL if none)
+  inline CoinPresolveProfile *profile() const
+  { return profile_; }
+  /*! \brief Set profile to collect time and effectiveness figures
+
+    The client retains responsibility for the profile --- it will not be
+    destroyed with the \c CoinPrePostsolveMatrix object.
+  */
+  inline void setProfile(CoinPresolveProfile *profile)
+  { profile_ = profile ; }
+  //@}
+
   /*! \name Current and Allocated Size
 
     During pre- and postsolve, the matrix will change in size. During presolve
@@ -704,6 +761,9 @@ class CoinPrePostsolveMatrix
   CoinMessage messages_; 
   //@}
 
+  /// Profile for presolve transforms (not owned)
+  CoinPresolveProfile *profile_;
+
 };
 
 /*! \relates CoinPrePostsolveMatrix
@@ -801,6 +861,78 @@ inline void PRESOLVE_MOVE_LINK(presolvehlink *link, int i, int j)
   link[i].pre = NO_LINK, link[i].suc = NO_LINK;
 }
 
+/*! \class presolvehspace
+    \brief Free space and statistics for bulk storage management
+
+   When a major-dimension vector is moved to the end of the bulk storage
+   arrays to make room for expansion, the space it occupied is left behind
+   as a gap. presolve_expand_major records these gaps here, sorted into size
+   classes by powers of two, and will move another vector into a gap big
+   enough to hold it before it resorts to the end of the bulk storage.
+
+   Each gap is recorded along with the vector which preceded it in memory
+   order. Nothing is done to keep the lists up to date as vectors move and
+   grow; a gap is checked when it's taken off a list and is discarded if
+   it's no longer free (i.e., no longer lies between the end of its owner
+   and the start of the owner's successor).
+
+   The counts let a client see how hard the storage is being worked. One
+   object is needed for each of the column-major and row-major
+   representations.
+*/
+
+class presolvehspace
+{ public:
+  /// A gap in the bulk storage arrays
+  struct gap {
+    /// First free position
+    CoinBigIndex start ;
+    /// Number of free positions
+    CoinBigIndex size ;
+    /// Vector immediately preceding the gap in memory order
+    int owner ;
+  } ;
+
+  /// Number of size classes
+  enum { numberClasses = 32 } ;
+
+  /// Constructor
+  presolvehspace() { clearStatistics() ; }
+
+  /// Forget all recorded gaps
+  inline void clearFree()
+  { for (int c = 0 ; c < numberClasses ; c++) free_[c].clear() ; }
+  /// Reset the statistics
+  inline void clearStatistics()
+  { expansions_ = 0 ; moves_ = 0 ; reuses_ = 0 ;
+    partialCompactions_ = 0 ; fullCompactions_ = 0 ; compactedEntries_ = 0 ; }
+
+  /// Size class for a gap of \p size positions
+  static inline int sizeClass(CoinBigIndex size)
+  { int c = 0 ;
+    while (size > 1 && c < numberClasses-1) { size >>= 1 ; c++ ; }
+    return (c) ; }
+
+  /*! \name Statistics */
+  //@{
+  /// Vectors which needed more room than they had in place
+  int expansions_ ;
+  /// Vectors moved to the end of bulk storage
+  int moves_ ;
+  /// Vectors moved into a recorded gap
+  int reuses_ ;
+  /// Compactions of part of the bulk storage
+  int partialCompactions_ ;
+  /// Compactions of all of the bulk storage
+  int fullCompactions_ ;
+  /// Coefficients moved by compaction
+  CoinBigIndex compactedEntries_ ;
+  //@}
+
+  /// Recorded gaps, by size class
+  std::vector<gap> free_[numberClasses] ;
+} ;
+
 
 /*! \class CoinPresolveMatrix
     \brief Augments CoinPrePostsolveMatrix with information about the problem
@@ -910,6 +1042,18 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   */
   void setMatrix(const CoinPackedMatrix *mtx) ;
 
+  /*! \brief Load the coefficient matrix, taking its arrays.
+
+    As setMatrix, but the coefficients are moved out of \p mtx (see
+    CoinPackedMatrix::releaseMatrix), which is left empty. If \p mtx already
+    has room for bulkRatio_ times the allocated number of coefficients (made
+    with CoinPackedMatrix::reserve, say) nothing is copied; otherwise the
+    coefficients are copied into bulk storage and the source arrays freed
+    before the row-major copy is made. Either way the caller's matrix and
+    both presolve copies are never held at once.
+  */
+  void moveMatrix(CoinPackedMatrix &mtx) ;
+
   /// Count number of empty rows
   inline int countEmptyRows()
   { int empty = 0 ;
@@ -984,6 +1128,26 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   /// Sets any special options (see #presolveOptions_)
   inline void setPresolveOptions(int value)
   { presolveOptions_=value;}
+  /// Number of threads for detection scans and the row-major copy
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /*! \brief Sets number of threads for detection scans and the row-major
+	     copy (1 if not built with threads)
+
+    Set before setMatrix or moveMatrix for the row-major copy to be made
+    in parallel.
+  */
+  void setNumberThreads(int value);
+  /// Arena for postsolve action arrays (NULL if none)
+  inline CoinArena *arena() const
+  { return arena_;}
+  /*! \brief Sets arena for postsolve action arrays
+
+    The arena is not owned.  Release it (in bulk) only after the postsolve
+    objects created by this presolve have been deleted.
+  */
+  inline void setArena(CoinArena *arena)
+  { arena_ = arena;}
   //@}
 
   /*! \name Matrix storage management links
@@ -997,6 +1161,10 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   presolvehlink *clink_;
   /// Linked list for the row-major representation.
   presolvehlink *rlink_;
+  /// Free space and statistics for the column-major representation.
+  presolvehspace cspace_;
+  /// Free space and statistics for the row-major representation.
+  presolvehspace rspace_;
   //@}
 
   /// Objective function offset introduced during presolve
@@ -1090,6 +1258,51 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   inline void setMaximumSubstitutionLevel (int level)
   { maxSubstLevel_ = level ; }
 
+  /*! \name Work budget
+
+    A deterministic measure of presolve effort, in coefficients touched.
+    Transforms add to #workDone_ with #addWork and, once #workExhausted,
+    stop at a clean point (between candidates) and return the actions
+    completed so far, so the problem is always left valid.
+
+    The presolve driver should call #startTechnique before each transform,
+    which sets the base for #techniqueWorkLimit_, and stop calling
+    transforms once #workLimitReached. Both limits default to COIN_DBL_MAX
+    (no limit).
+  */
+  //@{
+  /// Coefficients touched so far
+  double workDone_ ;
+  /// Limit on #workDone_ for the whole presolve
+  double workLimit_ ;
+  /// Limit on work done by a transform since #startTechnique
+  double techniqueWorkLimit_ ;
+  /// #workDone_ at the last #startTechnique
+  double techniqueWorkStart_ ;
+  /// Set limit on work for the whole presolve
+  inline void setWorkLimit (double limit)
+  { workLimit_ = limit ; }
+  /// Set limit on work for each transform
+  inline void setTechniqueWorkLimit (double limit)
+  { techniqueWorkLimit_ = limit ; }
+  /// Work done so far
+  inline double workDone () const
+  { return (workDone_) ; }
+  /// Count work done (also charged to CoinWorkDone of the thread)
+  inline void addWork (double work)
+  { workDone_ += work ; CoinChargeWork(work) ; }
+  /// Note the start of a transform
+  inline void startTechnique ()
+  { techniqueWorkStart_ = workDone_ ; }
+  /// True if the whole presolve is out of work
+  inline bool workLimitReached () const
+  { return (workDone_ >= workLimit_) ; }
+  /// True if the current transform should stop
+  inline bool workExhausted () const
+  { return (workDone_ >= workLimit_ ||
+	    workDone_-techniqueWorkStart_ >= techniqueWorkLimit_) ; }
+  //@}
+
 
   /*! \name Row and column processing status
 
@@ -1166,6 +1379,16 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
     various \c set*Prohibited routines.
   */
   bool anyProhibited_;
+  /*! Number of threads transforms may use for detection scans
+
+    Only used if built with COINUTILS_PTHREADS; see presolve_parallel_scan.
+  */
+  int numberThreads_;
+  /*! Arena for the action arrays kept for postsolve
+
+    If NULL they come from new[].  See CoinPresolveNewArray.
+  */
+  CoinArena *arena_;
   //@}
 
   /*! \name Scratch work arrays
@@ -1199,6 +1422,58 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   double *sumDown_ ;
   //@}
 
+  /*! \name Row activity bounds cache
+
+    Finite sums and counts of infinite contributions to the lower and upper
+    bounds on row activity, kept up to date across presolve passes so that
+    transforms need not walk every row again. Allocated by
+    #startRowActivity, which the presolve driver calls if it wants the
+    cache; all are NULL otherwise.
+
+    Column bound changes are folded in by #updateColumnActivity (O(column
+    length)); #syncRowActivity finds the columns whose bounds changed since
+    the last sync, and recomputes rows whose entries may have changed (the
+    length of the row, or of a column in it, changed). A bound counts as
+    infinite at PRESOLVE_INF, as in forcing_constraint_action.
+
+    Coefficient changes which leave every row and column length as it was
+    are not detected; a transform making them must call
+    #computeRowActivity for the rows affected.
+  */
+  //@{
+  /// Sum of finite contributions to row lhs lower bound
+  double *activityDown_ ;
+  /// Sum of finite contributions to row lhs upper bound
+  double *activityUp_ ;
+  /// Count of infinite contributions to row lhs lower bound
+  int *activityInfDown_ ;
+  /// Count of infinite contributions to row lhs upper bound
+  int *activityInfUp_ ;
+  /*! \brief Count of entries the cache can't vouch for
+
+    Zero coefficients, and finite bounds of magnitude 1.0e10 or more (the
+    transforms treat these as infinite, depending on their own notion of
+    large). #rowActivityBounds fails for a row with any.
+  */
+  int *activityHuge_ ;
+  /*! \brief Sum of magnitudes of finite contributions
+
+    Never reduced by incremental updates, so it bounds the rounding error
+    of #activityDown_ and #activityUp_ (see #rowActivityError).
+  */
+  double *activityNorm_ ;
+  /// Incremental updates since a row was last recomputed; -1 if stale
+  int *activityUpdates_ ;
+  /// Row lengths when the cache last saw them
+  int *activityRowLength_ ;
+  /// Column lengths when the cache last saw them
+  int *activityColLength_ ;
+  /// Column lower bounds folded into the cache
+  double *activityColLower_ ;
+  /// Column upper bounds folded into the cache
+  double *activityColUpper_ ;
+  //@}
+
   /*! \brief Recompute row lhs bounds
 
     Calculate finite contributions to row lhs upper and lower bounds
@@ -1212,6 +1487,63 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   */
   int recomputeSums(int whichRow) ;
 
+  /*! \brief Create the row activity bounds cache
+
+    Allocates the cache (freeing any old one) and computes it for all rows.
+  */
+  void startRowActivity() ;
+  /// Free the row activity bounds cache
+  void stopRowActivity() ;
+  /// True if the row activity bounds cache is in use
+  inline bool rowActivityActive() const
+  { return (activityUpdates_ != 0) ; }
+  /*! \brief Bring the row activity bounds cache up to date
+
+    Call at the start of a transform which will query it. Does nothing if
+    the cache is not in use.
+  */
+  void syncRowActivity() ;
+  /*! \brief Fold a change in the bounds of column \p j into the cache
+
+    For transforms which change bounds and then query rows again before
+    the next #syncRowActivity. Does nothing if the cache is not in use.
+  */
+  inline void updateColumnActivity(int j)
+  { if (activityUpdates_ &&
+	(clo_[j] != activityColLower_[j] || cup_[j] != activityColUpper_[j]))
+      updateColumnActivityGuts(j) ; }
+  /*! \brief Cached bounds on the activity of row \p i
+
+    Returns false if the cache is not in use, the row has changed since it
+    was last computed, or the row has an entry counted in #activityHuge_. Otherwise the lower bound is \p finDown plus
+    \p infDown infinite contributions, and similarly for the upper bound.
+  */
+  inline bool rowActivityBounds(int i, double &finDown, int &infDown,
+				double &finUp, int &infUp) const
+  { if (!activityUpdates_ || activityUpdates_[i] < 0 || activityHuge_[i] ||
+	activityRowLength_[i] != hinrow_[i])
+      return (false) ;
+    finDown = activityDown_[i] ;
+    infDown = activityInfDown_[i] ;
+    finUp = activityUp_[i] ;
+    infUp = activityInfUp_[i] ;
+    return (true) ; }
+  /// Bound on the rounding error in the cached finite sums for row \p i
+  inline double rowActivityError(int i) const
+  { return (1.0e-9*(1.0+activityNorm_[i])) ; }
+  /*! \brief Check the cache against the matrix
+
+    Returns the number of up to date rows whose cached bounds don't match
+    a direct calculation (allowing for #rowActivityError).
+  */
+  int checkRowActivity() const ;
+  /// Recompute the cached activity bounds of row \p i (if the cache is in use)
+  void computeRowActivity(int i) ;
+  /// Worker for #updateColumnActivity
+  void updateColumnActivityGuts(int j) ;
+
+  /// Make the row-major copy and the rest of setMatrix after the column copy
+  void finishMatrix() ;
   /// Allocate scratch arrays
   void initializeStuff() ;
   /// Free scratch arrays
@@ -1234,6 +1566,16 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
   */
   int stepColsToDo () ;
 
+  /*! \brief Columns on either column ToDo list
+
+    Copies each column on #colsToDo_ or #nextColsToDo_ to \p cols once,
+    skipping prohibited columns, and returns the number copied. A column
+    on #colsToDo_ whose changed bit is set is also on #nextColsToDo_, so the
+    changed bits serve to remove duplicates. \p cols must have room for
+    #ncols_ entries. Cost is proportional to the length of the lists.
+  */
+  int changedCols (int *cols) const ;
+
   /// Return the number of columns on the #colsToDo_ list
   inline int numberColsToDo()
   { return (numberColsToDo_) ; }
@@ -1391,6 +1733,27 @@ class CoinPresolveMatrix : public CoinPrePostsolveMatrix
 
 };
 
+/*! \brief Array kept for postsolve
+
+  From the presolve arena if one is set, otherwise from new[].  Free with
+  deleteAction.
+*/
+template <class T> inline T *CoinPresolveNewArray (const CoinPresolveMatrix *prob,
+						  int n)
+{
+  CoinArena *arena = prob->arena() ;
+  return (arena) ? arena->allocateArray<T>(n) : new T [n] ;
+}
+
+/*! \brief Copy of array kept for postsolve (see CoinPresolveNewArray)
+*/
+template <class T> inline T *CoinPresolveCopyOfArray (const CoinPresolveMatrix *prob,
+						     const T *array, int n)
+{
+  CoinArena *arena = prob->arena() ;
+  return (arena) ? arena->copyOfArray(array,n) : CoinCopyOfArray(array,n) ;
+}
+
 /*! \class CoinPostsolveMatrix
     \brief Augments CoinPrePostsolveMatrix with information about the problem
 	   that is only needed during postsolve.
@@ -1483,6 +1846,19 @@ class CoinPostsolveMatrix : public CoinPrePostsolveMatrix
   */
   void assignPresolveToPostsolve (CoinPresolveMatrix *&preObj) ;
 
+  /*! \brief Postsolve only the primal solution
+
+    Frees the row duals, reduced costs and status arrays. Postsolve
+    transforms then skip all dual, reduced cost and basis status work
+    and restore only #sol_ and #acts_, which is considerably cheaper when
+    postsolving a heuristic solution. Call after loading the solution and
+    before postsolve.
+  */
+  void setPrimalOnly() ;
+  /// True if only the primal solution will be postsolved
+  inline bool primalOnly() const
+  { return (rowduals_ == 0 && rcosts_ == 0 && colstat_ == 0) ; }
+
   /// Destructor
   ~CoinPostsolveMatrix();
 
@@ -1546,11 +1922,13 @@ void presolve_make_memlists(/*CoinBigIndex *starts,*/ int *lengths,
 	   coefficient.
 
     You can use this directly, or use the inline wrappers presolve_expand_col
-    and presolve_expand_row
+    and presolve_expand_row. If \p space is supplied, gaps left by moved
+    vectors are recorded there and reused, and statistics are kept.
 */
 bool presolve_expand_major(CoinBigIndex *majstrts, double *majels,
 			   int *minndxs, int *majlens,
-			   presolvehlink *majlinks, int nmaj, int k) ;
+			   presolvehlink *majlinks, int nmaj, int k,
+			   presolvehspace *space = 0) ;
 
 /*! \relates CoinPrePostsolveMatrix
     \brief Make sure a column (colx) in a column-major matrix has room for
@@ -1559,9 +1937,10 @@ bool presolve_expand_major(CoinBigIndex *majstrts, double *majels,
 
 inline bool presolve_expand_col(CoinBigIndex *mcstrt, double *colels,
 				int *hrow, int *hincol,
-				presolvehlink *clink, int ncols, int colx)
+				presolvehlink *clink, int ncols, int colx,
+				presolvehspace *cspace = 0)
 { return presolve_expand_major(mcstrt,colels,
-			       hrow,hincol,clink,ncols,colx) ; }
+			       hrow,hincol,clink,ncols,colx,cspace) ; }
 
 /*! \relates CoinPrePostsolveMatrix
     \brief Make sure a row (rowx) in a row-major matrix has room for one
@@ -1570,9 +1949,10 @@ inline bool presolve_expand_col(CoinBigIndex *mcstrt, double *colels,
 
 inline bool presolve_expand_row(CoinBigIndex *mrstrt, double *rowels,
 				int *hcol, int *hinrow,
-				presolvehlink *rlink, int nrows, int rowx)
+				presolvehlink *rlink, int nrows, int rowx,
+				presolvehspace *rspace = 0)
 { return presolve_expand_major(mrstrt,rowels,
-			       hcol,hinrow,rlink,nrows,rowx) ; }
+			       hcol,hinrow,rlink,nrows,rowx,rspace) ; }
 
 
 /*! \relates CoinPrePostsolveMatrix
@@ -1837,6 +2217,51 @@ double *presolve_dupmajor(const double *elems, const int *indices,
 /// Initialize a vector with random numbers
 void coin_init_random_vec(double *work, int n);
 
+/*! \relates CoinPresolveMatrix
+    \brief Detection function for presolve_parallel_scan
+
+    Examines candidates look[first] to look[last-1] and sets result[k] for
+    each of them. It must not modify \p prob.
+*/
+typedef void (*presolve_scan_function)(const CoinPresolveMatrix *prob,
+				       const int *look, int first, int last,
+				       const void *info, char *result) ;
+
+/*! \relates CoinPresolveMatrix
+    \brief Run a detection scan over a list of candidates in parallel
+
+    The list is split into #numberThreads_ contiguous blocks with about the
+    same number of coefficients (using \p length, normally hinrow_ or
+    hincol_) and \p scan is called once for each block. The matrix is
+    read only while scanning, so the caller applies any transforms serially
+    afterwards, in list order. A candidate whose row or column neighbourhood
+    was changed by an earlier transform in the same pass must be examined
+    again before being acted on.
+*/
+void presolve_parallel_scan(const CoinPresolveMatrix *prob,
+			    presolve_scan_function scan,
+			    const int *look, int numberLook,
+			    const int *length, const void *info,
+			    char *result) ;
+
+/*! \relates CoinPostsolveMatrix
+    \brief Postsolve a list of actions, running independent ones in parallel
+
+    Walks the list from \p paction, as a postsolve driver would, calling
+    each action's postsolve. Consecutive actions whose footprints (see
+    CoinPresolveAction::postsolveFootprint) share no row or column form a
+    group; a group is split into up to \p numberThreads blocks, each given
+    its own share of the free list, and the blocks are postsolved in
+    parallel (if built with COINUTILS_PTHREADS). Actions without a footprint
+    are postsolved on their own, in order.
+
+    Everything is serial if \p prob has a profile (so timings stay per
+    action) or if presolve debugging or consistency checks are compiled in.
+*/
+void presolve_parallel_postsolve(const CoinPresolveAction *paction,
+				 CoinPostsolveMatrix *prob,
+				 int numberThreads = 1) ;
+
 //@}
 
 
@@ -0,0 +1,152 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinMessage.hpp"
+#include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveProfile.hpp"
+
+/*! \file
+
+  This file contains methods for CoinPresolveProfile, used to collect time
+  and effectiveness figures for each presolve action class.
+*/
+
+namespace {
+
+/*
+  Count empty major vectors and coefficients.
+*/
+void count_empty (const int *lengths, int n, int &empty, CoinBigIndex &elements)
+{
+  empty = 0 ;
+  elements = 0 ;
+  for (int i = 0 ; i < n ; i++) {
+    if (lengths[i] == 0)
+      empty++ ;
+    else
+      elements += lengths[i] ;
+  }
+}
+
+}	// end unnamed namespace
+
+CoinPresolveProfile::CoinPresolveProfile ()
+{ }
+
+void CoinPresolveProfile::clear ()
+{
+  records_.clear() ;
+  open_.clear() ;
+}
+
+CoinPresolveProfileRecord &CoinPresolveProfile::find (const char *name)
+{
+  for (size_t i = 0 ; i < records_.size() ; i++) {
+    if (records_[i].name == name)
+      return (records_[i]) ;
+  }
+  CoinPresolveProfileRecord record ;
+  record.name = name ;
+  record.presolveCalls = 0 ;
+  record.presolveTime = 0.0 ;
+  record.presolveWork = 0.0 ;
+  record.rowsRemoved = 0 ;
+  record.columnsRemoved = 0 ;
+  record.elementsRemoved = 0 ;
+  record.postsolveCalls = 0 ;
+  record.postsolveTime = 0.0 ;
+  records_.push_back(record) ;
+  return (records_.back()) ;
+}
+
+const CoinPresolveProfileRecord *
+CoinPresolveProfile::record (const char *name) const
+{
+  for (size_t i = 0 ; i < records_.size() ; i++) {
+    if (records_[i].name == name)
+      return (&records_[i]) ;
+  }
+  return (NULL) ;
+}
+
+void CoinPresolveProfile::startPresolve (const CoinPresolveMatrix *prob)
+{
+  openCall call ;
+  CoinBigIndex rowElements ;
+  count_empty(prob->hinrow_,prob->nrows_,call.emptyRows,rowElements) ;
+  count_empty(prob->hincol_,prob->ncols_,call.emptyColumns,call.elements) ;
+  call.time = CoinGetTimeOfDay() ;
+  call.work = prob->workDone_ ;
+  open_.push_back(call) ;
+}
+
+void CoinPresolveProfile::endPresolve (const CoinPresolveMatrix *prob,
+				       const char *name)
+{
+  assert (!open_.empty()) ;
+  const double endTime = CoinGetTimeOfDay() ;
+  const openCall call = open_.back() ;
+  open_.pop_back() ;
+  int emptyRows, emptyColumns ;
+  CoinBigIndex elements, rowElements ;
+  count_empty(prob->hinrow_,prob->nrows_,emptyRows,rowElements) ;
+  count_empty(prob->hincol_,prob->ncols_,emptyColumns,elements) ;
+  CoinPresolveProfileRecord &record = find(name) ;
+  record.presolveCalls++ ;
+  record.presolveTime += endTime-call.time ;
+  record.presolveWork += prob->workDone_-call.work ;
+  record.rowsRemoved += emptyRows-call.emptyRows ;
+  record.columnsRemoved += emptyColumns-call.emptyColumns ;
+  record.elementsRemoved += call.elements-elements ;
+}
+
+void CoinPresolveProfile::postsolve (const CoinPresolveAction *action,
+				     CoinPostsolveMatrix *prob)
+{
+  const double startTime = CoinGetTimeOfDay() ;
+  action->postsolve(prob) ;
+  CoinPresolveProfileRecord &record = find(action->name()) ;
+  record.postsolveCalls++ ;
+  record.postsolveTime += CoinGetTimeOfDay()-startTime ;
+}
+
+void CoinPresolveProfile::report (CoinMessageHandler *handler,
+				  const CoinMessages &messages) const
+{
+  for (size_t i = 0 ; i < records_.size() ; i++) {
+    const CoinPresolveProfileRecord &record = records_[i] ;
+    handler->message(COIN_PRESOLVE_PROFILE,messages)
+      << record.name << record.presolveCalls << record.presolveTime
+      << record.rowsRemoved << record.columnsRemoved
+      << static_cast<int>(record.elementsRemoved)
+      << record.postsolveTime << CoinMessageEol ;
+  }
+}
+
+int CoinPresolveProfile::write (const char *filename) const
+{
+  FILE *fp = fopen(filename,"w") ;
+  if (!fp)
+    return (-1) ;
+  fprintf(fp,"name,presolveCalls,presolveSeconds,presolveWork,rowsRemoved,"
+	  "columnsRemoved,elementsRemoved,postsolveCalls,postsolveSeconds\n") ;
+  for (size_t i = 0 ; i < records_.size() ; i++) {
+    const CoinPresolveProfileRecord &record = records_[i] ;
+    fprintf(fp,"%s,%d,%.6f,%.0f,%d,%d,%ld,%d,%.6f\n",
+	    record.name.c_str(),record.presolveCalls,record.presolveTime,
+	    record.presolveWork,
+	    record.rowsRemoved,record.columnsRemoved,
+	    static_cast<long>(record.elementsRemoved),
+	    record.postsolveCalls,record.postsolveTime) ;
+  }
+  fclose(fp) ;
+  return (0) ;
+}
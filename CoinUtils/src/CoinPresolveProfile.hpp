@@ -0,0 +1,121 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPresolveProfile_H
+#define CoinPresolveProfile_H
+
+#include <string>
+#include <vector>
+
+#include "CoinTypes.hpp"
+#include "CoinMessageHandler.hpp"
+
+class CoinPresolveAction ;
+class CoinPresolveMatrix ;
+class CoinPostsolveMatrix ;
+
+/*! \brief Figures collected for one presolve action class */
+typedef struct {
+  /// Name of action class (CoinPresolveAction::name())
+  std::string name ;
+  /// Number of calls to presolve
+  int presolveCalls ;
+  /// Wall clock seconds in presolve (including transforms it called)
+  double presolveTime ;
+  /// Work units (CoinPresolveMatrix::workDone_) in presolve
+  double presolveWork ;
+  /// Rows emptied
+  int rowsRemoved ;
+  /// Columns emptied
+  int columnsRemoved ;
+  /// Coefficients removed
+  CoinBigIndex elementsRemoved ;
+  /// Number of postsolve calls
+  int postsolveCalls ;
+  /// Wall clock seconds in postsolve
+  double postsolveTime ;
+} CoinPresolveProfileRecord ;
+
+/*!
+  \brief Time and effectiveness of presolve transforms
+
+  A presolve driver brackets each transform with startPresolve() and
+  endPresolve(), and runs postsolve through postsolve(). The profile then
+  holds, for each action class, the number of calls, wall time and the rows,
+  columns and coefficients which disappeared, plus the time spent in
+  postsolve. report() writes it through a CoinMessageHandler and write()
+  as comma separated values.
+
+  Calls may be nested (a transform which hands off work to another); each
+  level is timed and counted in full, so the figures for the outer
+  transform include those of the inner ones.
+
+  Counting rows, columns and coefficients costs a pass over the column and
+  row lengths at the start and end of each call.
+
+  A pointer to a profile can be left in the matrix with
+  CoinPrePostsolveMatrix::setProfile so transforms can find it; the profile
+  is not owned by the matrix.
+*/
+class CoinPresolveProfile
+{
+public:
+  /*! \name Collecting */
+  //@{
+  /// Note start of a presolve transform
+  void startPresolve(const CoinPresolveMatrix *prob) ;
+  /// Note end of presolve transform started by the matching startPresolve
+  void endPresolve(const CoinPresolveMatrix *prob, const char *name) ;
+  /// Run postsolve for one action and time it
+  void postsolve(const CoinPresolveAction *action,
+		 CoinPostsolveMatrix *prob) ;
+  /// Clear all figures
+  void clear() ;
+  //@}
+
+  /*! \name Results */
+  //@{
+  /// Number of action classes seen
+  inline int numberRecords() const
+  { return static_cast<int>(records_.size()) ; }
+  /// Figures for action class i
+  inline const CoinPresolveProfileRecord &record(int i) const
+  { return records_[i] ; }
+  /// Figures for named action class (NULL if not seen)
+  const CoinPresolveProfileRecord *record(const char *name) const ;
+  /// Reports one COIN_PRESOLVE_PROFILE message per action class
+  void report(CoinMessageHandler *handler,
+	      const CoinMessages &messages) const ;
+  /** Writes figures as comma separated values with a header line.
+      Returns 0 if OK, -1 if the file can not be opened. */
+  int write(const char *filename) const ;
+  //@}
+
+  /*! \name Constructor */
+  //@{
+  /// Default constructor
+  CoinPresolveProfile() ;
+  //@}
+
+private:
+  /// Record for name (created if needed)
+  CoinPresolveProfileRecord &find(const char *name) ;
+
+  /// State at a startPresolve not yet ended
+  typedef struct {
+    double time ;
+    double work ;
+    int emptyRows ;
+    int emptyColumns ;
+    CoinBigIndex elements ;
+  } openCall ;
+
+  /// Figures per action class in order first seen
+  std::vector<CoinPresolveProfileRecord> records_ ;
+  /// Calls started but not ended
+  std::vector<openCall> open_ ;
+} ;
+
+#endif
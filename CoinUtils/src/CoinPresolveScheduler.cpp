@@ -0,0 +1,141 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveScheduler.hpp"
+
+/*! \file
+
+  This file contains methods for CoinPresolveScheduler, which picks the
+  presolve transforms to run in each pass from their measured yield.
+*/
+
+CoinPresolveScheduler::CoinPresolveScheduler ()
+  : minimumYield_(0.0),
+    elementWeight_(0.1),
+    stopFraction_(0.0),
+    maximumBackoff_(8),
+    maximumPasses_(100),
+    numberPasses_(0),
+    lastGainPass_(-1),
+    finished_(false)
+{ }
+
+int CoinPresolveScheduler::addTechnique (const char *name,
+					 CoinPresolveFunction function)
+{
+  technique t ;
+  t.name = name ;
+  t.function = function ;
+  t.yield = 0.0 ;
+  t.calls = 0 ;
+  t.skip = 0 ;
+  t.backoff = 1 ;
+  t.lastPass = -1 ;
+  techniques_.push_back(t) ;
+  return (numberTechniques()-1) ;
+}
+
+void CoinPresolveScheduler::reset ()
+{
+  for (size_t i = 0 ; i < techniques_.size() ; i++) {
+    technique &t = techniques_[i] ;
+    t.yield = 0.0 ;
+    t.calls = 0 ;
+    t.skip = 0 ;
+    t.backoff = 1 ;
+    t.lastPass = -1 ;
+  }
+  profile_.clear() ;
+  numberPasses_ = 0 ;
+  lastGainPass_ = -1 ;
+  finished_ = false ;
+}
+
+const CoinPresolveAction *
+CoinPresolveScheduler::runPass (CoinPresolveMatrix *prob,
+				const CoinPresolveAction *next)
+{
+  if (finished_)
+    return (next) ;
+  CoinPresolveProfile *profile = prob->profile() ;
+  if (!profile)
+    profile = &profile_ ;
+  const int pass = numberPasses_++ ;
+  double passGain = 0.0 ;
+/*
+  Run each technique which isn't sitting out, measuring the change in its
+  profile record across the call.
+*/
+  for (size_t i = 0 ; i < techniques_.size() ; i++) {
+    technique &t = techniques_[i] ;
+    if (t.skip > 0) {
+      t.skip-- ;
+      continue ;
+    }
+    CoinPresolveProfileRecord before ;
+    const CoinPresolveProfileRecord *record = profile->record(t.name.c_str()) ;
+    if (record) {
+      before = *record ;
+    } else {
+      before.presolveWork = 0.0 ;
+      before.rowsRemoved = 0 ;
+      before.columnsRemoved = 0 ;
+      before.elementsRemoved = 0 ;
+    }
+    prob->startTechnique() ;
+    profile->startPresolve(prob) ;
+    next = (t.function)(prob,next) ;
+    profile->endPresolve(prob,t.name.c_str()) ;
+    record = profile->record(t.name.c_str()) ;
+
+    const double gain =
+      (record->rowsRemoved-before.rowsRemoved)+
+      (record->columnsRemoved-before.columnsRemoved)+
+      elementWeight_*(record->elementsRemoved-before.elementsRemoved) ;
+    const double work = record->presolveWork-before.presolveWork ;
+    const double thisYield = gain/(work+1.0) ;
+    t.yield = (t.calls) ? 0.5*(t.yield+thisYield) : thisYield ;
+    t.calls++ ;
+    t.lastPass = pass ;
+    if (gain <= 0.0 || thisYield < minimumYield_) {
+      t.skip = t.backoff ;
+      t.backoff = CoinMin(2*t.backoff,maximumBackoff_) ;
+    } else {
+      t.backoff = 1 ;
+    }
+    passGain += CoinMax(gain,0.0) ;
+
+    if (prob->status_ > 0 || prob->workLimitReached()) {
+      finished_ = true ;
+      return (next) ;
+    }
+  }
+/*
+  Decide whether to go on.
+*/
+  if (passGain > 0.0)
+    lastGainPass_ = pass ;
+  bool allTried = true ;
+  for (size_t i = 0 ; i < techniques_.size() ; i++) {
+    if (techniques_[i].lastPass <= lastGainPass_) {
+      allTried = false ;
+      break ;
+    }
+  }
+  if ((passGain <= 0.0 && allTried) || numberPasses_ >= maximumPasses_) {
+    finished_ = true ;
+  } else if (passGain > 0.0 && stopFraction_ > 0.0) {
+/*
+  Counting what's left scans the matrix, so only do it if asked.
+*/
+    const int size = prob->nrows_-prob->countEmptyRows()+
+		     prob->ncols_-prob->countEmptyCols() ;
+    if (passGain < stopFraction_*size)
+      finished_ = true ;
+  }
+  return (next) ;
+}
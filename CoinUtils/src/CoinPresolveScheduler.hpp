@@ -0,0 +1,139 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinPresolveScheduler_H
+#define CoinPresolveScheduler_H
+
+#include <string>
+#include <vector>
+
+#include "CoinPresolveProfile.hpp"
+
+class CoinPresolveAction ;
+class CoinPresolveMatrix ;
+
+/*! \brief A presolve transform, as in xxx_action::presolve(prob,next) */
+typedef const CoinPresolveAction *(*CoinPresolveFunction)
+	(CoinPresolveMatrix *prob, const CoinPresolveAction *next) ;
+
+/*!
+  \brief Choose presolve transforms from their measured yield
+
+  A driver registers its transforms with addTechnique() and then calls
+  runPass() until finished(). Each call to a transform is measured through
+  a CoinPresolveProfile (the one attached to the matrix, or one kept here):
+  the gain is the rows and columns emptied plus #elementWeight_ times the
+  coefficients removed, and the yield is the gain per unit of work
+  (CoinPresolveMatrix::workDone_) plus one, smoothed over calls.
+
+  A call which gains nothing, or whose yield is below #minimumYield_, puts
+  the transform back: it sits out the next 1, 2, 4, ... passes (up to
+  #maximumBackoff_), and comes back to full service as soon as it gains
+  again. Presolve is finished when every transform has been tried since
+  the last pass that gained anything, when a pass gains less than
+  #stopFraction_ of the rows and columns left, after #maximumPasses_
+  passes, when the work limit is reached or when the problem is found
+  infeasible or unbounded.
+
+  The ToDo lists are left to the driver, which steps them between passes
+  as before.
+*/
+class CoinPresolveScheduler
+{
+public:
+  /*! \name Techniques */
+  //@{
+  /*! \brief Add a transform, run in order of adding. Returns its index.
+
+    \p name is the name used for the profile; it need not match the
+    action class.
+  */
+  int addTechnique(const char *name, CoinPresolveFunction function) ;
+  /// Number of techniques
+  inline int numberTechniques() const
+  { return static_cast<int>(techniques_.size()) ; }
+  /// Name of technique i
+  inline const char *techniqueName(int i) const
+  { return (techniques_[i].name.c_str()) ; }
+  /// Smoothed yield of technique i (0 if never run)
+  inline double yield(int i) const
+  { return (techniques_[i].yield) ; }
+  /// True if technique i will run in the next pass
+  inline bool selected(int i) const
+  { return (techniques_[i].skip == 0) ; }
+  //@}
+
+  /*! \name Running */
+  //@{
+  /// Run the selected techniques once, returning the new action list
+  const CoinPresolveAction *runPass(CoinPresolveMatrix *prob,
+				    const CoinPresolveAction *next) ;
+  /// True once presolve should stop
+  inline bool finished() const
+  { return (finished_) ; }
+  /// Number of passes run
+  inline int numberPasses() const
+  { return (numberPasses_) ; }
+  /// Forget yields and passes, keeping the techniques and settings
+  void reset() ;
+  //@}
+
+  /*! \name Settings */
+  //@{
+  /// Yield below which a technique is put back (default 0.0)
+  inline void setMinimumYield(double value)
+  { minimumYield_ = value ; }
+  /// Weight of a removed coefficient against a row or column (default 0.1)
+  inline void setElementWeight(double value)
+  { elementWeight_ = value ; }
+  /// Stop when a pass gains less than this fraction (default 0.0)
+  inline void setStopFraction(double value)
+  { stopFraction_ = value ; }
+  /// Largest number of passes a technique sits out (default 8)
+  inline void setMaximumBackoff(int value)
+  { maximumBackoff_ = value ; }
+  /// Largest number of passes (default 100)
+  inline void setMaximumPasses(int value)
+  { maximumPasses_ = value ; }
+  //@}
+
+  /*! \name Constructor */
+  //@{
+  /// Default constructor
+  CoinPresolveScheduler() ;
+  //@}
+
+private:
+  /// State of one technique
+  typedef struct {
+    std::string name ;
+    CoinPresolveFunction function ;
+    /// Smoothed yield
+    double yield ;
+    /// Number of calls
+    int calls ;
+    /// Passes still to sit out
+    int skip ;
+    /// Passes to sit out next time it gains nothing
+    int backoff ;
+    /// Last pass it ran in
+    int lastPass ;
+  } technique ;
+
+  std::vector<technique> techniques_ ;
+  /// Used if the matrix has no profile
+  CoinPresolveProfile profile_ ;
+  double minimumYield_ ;
+  double elementWeight_ ;
+  double stopFraction_ ;
+  int maximumBackoff_ ;
+  int maximumPasses_ ;
+  int numberPasses_ ;
+  /// Last pass which gained anything (-1 if none)
+  int lastGainPass_ ;
+  bool finished_ ;
+} ;
+
+#endif
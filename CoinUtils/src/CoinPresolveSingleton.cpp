@@ -8,6 +8,7 @@
 
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
+#include "CoinInstrument.hpp"
 
 #include "CoinPresolveEmpty.hpp"	// for DROP_COL/DROP_ROW
 #include "CoinPresolveFixed.hpp"
@@ -50,6 +51,7 @@ slack_doubleton_action::presolve(CoinPresolveMatrix *prob,
 				 const CoinPresolveAction *next,
 				 bool &notFinished)
 {
+  COIN_TIME_SCOPE("presolve.slack_doubleton");
 # if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 # if PRESOLVE_DEBUG > 0
   std::cout << "Entering slack_doubleton_action::presolve." << std::endl ;
@@ -333,7 +335,7 @@ slack_doubleton_action::presolve(CoinPresolveMatrix *prob,
     std::cout
       << "SINGLETON ROWS: " << nactions << std::endl ;
 #   endif
-    action *save_actions = new action[nactions] ;
+    action *save_actions = CoinPresolveNewArray<action>(prob, nactions) ;
     CoinMemcpyN(actions, nactions, save_actions) ;
     next = new slack_doubleton_action(nactions,save_actions,next) ;
 
@@ -442,7 +444,8 @@ void slack_doubleton_action::postsolve(CoinPostsolveMatrix *prob) const
      */
     if (!colstat) {
       // ????
-      rowduals[irow] = 0.0 ;
+      if (rowduals)
+	rowduals[irow] = 0.0 ;
     } else {
       if (prob->columnIsBasic(jcol)) {
 	/*
@@ -512,6 +515,7 @@ slack_singleton_action::presolve(CoinPresolveMatrix *prob,
 				 const CoinPresolveAction *next,
                                  double * rowObjective)
 {
+  COIN_TIME_SCOPE("presolve.slack_singleton");
   double startTime = 0.0 ;
   int startEmptyRows=0 ;
   int startEmptyColumns = 0 ;
@@ -756,7 +760,7 @@ slack_singleton_action::presolve(CoinPresolveMatrix *prob,
     printf("%d singletons, %d with costs - offset %g\n",nactions,
            nWithCosts, costOffset) ;
 #endif
-    action *save_actions = new action[nactions] ;
+    action *save_actions = CoinPresolveNewArray<action>(prob, nactions) ;
     CoinMemcpyN(actions, nactions, save_actions) ;
     next = new slack_singleton_action(nactions, save_actions, next) ;
 
@@ -785,6 +789,24 @@ slack_singleton_action::presolve(CoinPresolveMatrix *prob,
 }
 
 void slack_singleton_action::postsolve(CoinPostsolveMatrix *prob) const
+{
+  postsolveWithFreeList(prob,prob->free_list_) ;
+}
+
+bool slack_singleton_action::postsolveFootprint (std::vector<int> &rows,
+						 std::vector<int> &columns,
+						 CoinBigIndex &entries) const
+{
+  for (int i = 0 ; i < nactions_ ; i++) {
+    rows.push_back(actions_[i].row) ;
+    columns.push_back(actions_[i].col) ;
+  }
+  entries = nactions_ ;
+  return (true) ;
+}
+
+void slack_singleton_action::postsolveWithFreeList (CoinPostsolveMatrix *prob,
+						    CoinBigIndex &free_list) const
 {
   const action *const actions = actions_ ;
   const int nactions = nactions_ ;
@@ -826,8 +848,6 @@ void slack_singleton_action::postsolve(CoinPostsolveMatrix *prob) const
   presolve_check_nbasic(prob) ;
 # endif
 
-  CoinBigIndex &free_list		= prob->free_list_ ;
-
   const double ztolzb	= prob->ztolzb_ ;
 #ifdef CHECK_ONE_ROW
   {
@@ -915,8 +935,8 @@ void slack_singleton_action::postsolve(CoinPostsolveMatrix *prob) const
       printf("SLKSING: %d = %g restored %d lb = %g ub = %g.\n",
 	     iCol,sol[iCol],prob->getColumnStatus(iCol),clo[iCol],cup[iCol]) ;
 #     endif
-    } else {
-      // must have been equality row
+    } else if (rowduals) {
+      // must have been equality row (nothing to do if primal only)
       assert (rlo[iRow]==rup[iRow]) ;
       double cost = rcosts[iCol] ;
       // adjust for coefficient
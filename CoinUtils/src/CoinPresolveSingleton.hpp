@@ -106,6 +106,14 @@ class slack_singleton_action : public CoinPresolveAction {
 
   void postsolve(CoinPostsolveMatrix *prob) const;
 
+  /// The singleton columns and their rows
+  bool postsolveFootprint(std::vector<int> &rows, std::vector<int> &columns,
+			  CoinBigIndex &entries) const;
+
+  /// Postsolve taking coefficients from \p freeList
+  void postsolveWithFreeList(CoinPostsolveMatrix *prob,
+			     CoinBigIndex &freeList) const;
+
 
   virtual ~slack_singleton_action() { deleteAction(actions_,action*); }
 };
@@ -7,6 +7,7 @@
 #include <math.h>
 
 #include "CoinPresolveMatrix.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinPresolveEmpty.hpp"	// for DROP_COL/DROP_ROW
 #include "CoinPresolvePsdebug.hpp"
 #include "CoinPresolveFixed.hpp"
@@ -73,7 +74,7 @@ void dbg_find_elem (const CoinPostsolveMatrix *postMtx, int i, int j)
 static bool 
 add_row (CoinBigIndex *mrstrt, double *rlo, double *acts, double *rup,
 	 double *rowels, int *hcol, int *hinrow, presolvehlink *rlink,
-	 int nrows, double coeff_factor, double kill_ratio,  int irowx, int irowy,
+	 presolvehspace *rspace, int nrows, double coeff_factor, double kill_ratio,  int irowx, int irowy,
 	 int *x_to_y)
 {
   CoinBigIndex krsy = mrstrt[irowy] ;
@@ -166,7 +167,7 @@ add_row (CoinBigIndex *mrstrt, double *rlo, double *acts, double *rup,
 */
       double newValue = rowels[krowy]*coeff_factor ;
       bool outOfSpace = presolve_expand_row(mrstrt,rowels,hcol,
-					    hinrow,rlink,nrows,irowx) ;
+					    hinrow,rlink,nrows,irowx,rspace) ;
       if (outOfSpace) return (true) ;
       
       krowy = mrstrt[irowy]+(krowy-krsy) ;
@@ -239,6 +240,7 @@ const CoinPresolveAction *subst_constraint_action::presolve (
     const int *implied_free, const int *whichFree, int numberFree,
     const CoinPresolveAction *next, int maxLook)
 {
+  COIN_TIME_SCOPE("presolve.subst_constraint");
 
 # if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 # if PRESOLVE_DEBUG > 0
@@ -409,7 +411,8 @@ const CoinPresolveAction *subst_constraint_action::presolve (
   the original objective.
 */
     const bool nonzero_cost = (fabs(cost[tgtcol]) > tol) ;
-    double *costsx = (nonzero_cost?new double[rowLengths[tgtrow]]:0) ;
+    double *costsx = (nonzero_cost?
+	CoinPresolveNewArray<double>(prob,rowLengths[tgtrow]):0) ;
 
 #   if PRESOLVE_DEBUG > 1
     std::cout << "  Eliminating row " << tgtrow << ", col " << tgtcol ;
@@ -443,16 +446,16 @@ const CoinPresolveAction *subst_constraint_action::presolve (
     PRESOLVE_DETAIL_PRINT(printf("pre_subst %dC %dR E\n",tgtcol,tgtrow)) ;
 
     ap->nincol = tgtcol_len ;
-    ap->rows = new int[tgtcol_len] ;
-    ap->rlos = new double[tgtcol_len] ;
-    ap->rups = new double[tgtcol_len] ;
+    ap->rows = CoinPresolveNewArray<int>(prob,tgtcol_len) ;
+    ap->rlos = CoinPresolveNewArray<double>(prob,tgtcol_len) ;
+    ap->rups = CoinPresolveNewArray<double>(prob,tgtcol_len) ;
 
     ap->costsx = costsx ;
-    ap->coeffxs = new double[tgtcol_len] ;
+    ap->coeffxs = CoinPresolveNewArray<double>(prob,tgtcol_len) ;
 
-    ap->ninrowxs = new int[tgtcol_len] ;
-    ap->rowcolsxs = new int[ntotels] ;
-    ap->rowelsxs = new double[ntotels] ;
+    ap->ninrowxs = CoinPresolveNewArray<int>(prob,tgtcol_len) ;
+    ap->rowcolsxs = CoinPresolveNewArray<int>(prob,ntotels) ;
+    ap->rowelsxs = CoinPresolveNewArray<double>(prob,ntotels) ;
 
     ntotels = 0 ;
     for (CoinBigIndex kcol = tgtcs ; kcol < tgtce ; ++kcol) {
@@ -547,7 +550,8 @@ const CoinPresolveAction *subst_constraint_action::presolve (
       CoinSort_2(colIndices+krs,colIndices+kre,rowCoeffs+krs) ;
       
       bool outOfSpace = add_row(rowStarts,rlo,acts,rup,rowCoeffs,colIndices,
-				rowLengths,rlink,nrows,coeff_factor,tolerance,i,tgtrow,
+				rowLengths,rlink,&prob->rspace_,nrows,coeff_factor,
+				tolerance,i,tgtrow,
 				x_to_y) ;
       if (outOfSpace)
 	throwCoinError("out of memory","CoinImpliedFree::presolve") ;
@@ -598,7 +602,8 @@ const CoinPresolveAction *subst_constraint_action::presolve (
 	  colCoeffs[kcol] = coeff ;
 	} else {
 	  outOfSpace = presolve_expand_col(colStarts,colCoeffs,rowIndices,
-	  				   colLengths,clink,ncols,j) ;
+	  				   colLengths,clink,ncols,j,
+					   &prob->cspace_) ;
 	  if (outOfSpace)
 	    throwCoinError("out of memory","CoinImpliedFree::presolve") ;
 	  kcs = colStarts[j] ;
@@ -686,7 +691,7 @@ const CoinPresolveAction *subst_constraint_action::presolve (
     std::cout << "NSUBSTS: " << nactions << std::endl ;
 #   endif
     next = new subst_constraint_action(nactions,
-				   CoinCopyOfArray(actions,nactions),next) ;
+				   CoinPresolveCopyOfArray(prob,actions,nactions),next) ;
     next = drop_zero_coefficients_action::presolve(prob,zerocols,
     						   nzerocols, next) ;
 #   if PRESOLVE_CONSISTENCY > 0
@@ -1035,33 +1040,37 @@ void subst_constraint_action::postsolve(CoinPostsolveMatrix *prob) const
 /*
   Calculate the reduced cost for the column absent any contribution from
   tgtrow, then set the dual for tgtrow so that the reduced cost of tgtcol
-  is zero.
+  is zero. Nothing to do if only the primal solution is wanted.
 */
-    double dj = maxmin*cost[tgtcol] ;
-    rowduals[tgtrow] = 0.0 ;
-    for (int cndx = 0 ; cndx < tgtcol_len ; ++cndx) {
-      int i = entngld_rows[cndx] ;
-      double coeff = tgtcol_coeffs[cndx] ;
-      dj -= rowduals[i]*coeff ;
+    if (rowduals) {
+      double dj = maxmin*cost[tgtcol] ;
+      rowduals[tgtrow] = 0.0 ;
+      for (int cndx = 0 ; cndx < tgtcol_len ; ++cndx) {
+	int i = entngld_rows[cndx] ;
+	double coeff = tgtcol_coeffs[cndx] ;
+	dj -= rowduals[i]*coeff ;
+      }
+      rowduals[tgtrow] = dj/tgtcoeff ;
+      rcosts[tgtcol] = 0.0 ;
+      if (prob->colstat_) {
+	if (rowduals[tgtrow] > 0)
+	  prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atUpperBound) ;
+	else
+	  prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atLowerBound) ;
+	prob->setColumnStatus(tgtcol,CoinPrePostsolveMatrix::basic) ;
+      }
+
+#     if PRESOLVE_DEBUG > 2
+      std::cout
+	<< "  row " << tgtrow << " "
+	<< prob->rowStatusString(prob->getRowStatus(tgtrow))
+	<< " dual " << rowduals[tgtrow] << std::endl ;
+      std::cout
+	<< "  col " << tgtcol << " "
+	<< prob->columnStatusString(prob->getColumnStatus(tgtcol))
+	<< " dj " << dj << std::endl ;
+#     endif
     }
-    rowduals[tgtrow] = dj/tgtcoeff ;
-    rcosts[tgtcol] = 0.0 ;
-    if (rowduals[tgtrow] > 0)
-      prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atUpperBound) ;
-    else
-      prob->setRowStatus(tgtrow,CoinPrePostsolveMatrix::atLowerBound) ;
-    prob->setColumnStatus(tgtcol,CoinPrePostsolveMatrix::basic) ;
-
-#   if PRESOLVE_DEBUG > 2
-    std::cout
-      << "  row " << tgtrow << " "
-      << prob->rowStatusString(prob->getRowStatus(tgtrow))
-      << " dual " << rowduals[tgtrow] << std::endl ;
-    std::cout
-      << "  col " << tgtcol << " "
-      << prob->columnStatusString(prob->getColumnStatus(tgtcol))
-      << " dj " << dj << std::endl ;
-#   endif
 
 #   if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
     cdone[tgtcol] = SUBST_ROW ;
@@ -1094,13 +1103,13 @@ subst_constraint_action::~subst_constraint_action()
   const action *actions = actions_ ;
 
   for (int i = 0 ; i < nactions_ ; ++i) {
-    delete [] actions[i].rows ;
-    delete [] actions[i].rlos ;
-    delete [] actions[i].rups ;
-    delete [] actions[i].coeffxs ;
-    delete [] actions[i].ninrowxs ;
-    delete [] actions[i].rowcolsxs ;
-    delete [] actions[i].rowelsxs ;
+    deleteAction(actions[i].rows,int *) ;
+    deleteAction(actions[i].rlos,double *) ;
+    deleteAction(actions[i].rups,double *) ;
+    deleteAction(actions[i].coeffxs,double *) ;
+    deleteAction(actions[i].ninrowxs,int *) ;
+    deleteAction(actions[i].rowcolsxs,int *) ;
+    deleteAction(actions[i].rowelsxs,double *) ;
 
 
     //delete [](double*)actions[i].costsx ;
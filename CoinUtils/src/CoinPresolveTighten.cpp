@@ -10,6 +10,7 @@
 #include "CoinPresolveFixed.hpp"
 #include "CoinPresolveTighten.hpp"
 #include "CoinPresolveUseless.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinFinite.hpp"
 
@@ -65,6 +66,7 @@ const char *do_tighten_action::name() const
 const CoinPresolveAction *do_tighten_action::presolve(CoinPresolveMatrix *prob,
 					       const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.do_tighten");
   double *colels	= prob->colels_;
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
@@ -240,9 +242,9 @@ const CoinPresolveAction *do_tighten_action::presolve(CoinPresolveMatrix *prob,
 	    }
 	    s->direction = iflag;
 
-	    s->rows =   new int[hincol[j]];
-	    s->lbound = new double[hincol[j]];
-	    s->ubound = new double[hincol[j]];
+	    s->rows =   CoinPresolveNewArray<int>(prob, hincol[j]);
+	    s->lbound = CoinPresolveNewArray<double>(prob, hincol[j]);
+	    s->ubound = CoinPresolveNewArray<double>(prob, hincol[j]);
 #if         PRESOLVE_DEBUG > 1
 	    printf("TIGHTEN FREE:  %d   ", j);
 #endif
@@ -287,7 +289,7 @@ const CoinPresolveAction *do_tighten_action::presolve(CoinPresolveMatrix *prob,
 #endif
 
   if (nuseless_rows) {
-    next = new do_tighten_action(nactions, CoinCopyOfArray(actions,nactions), next);
+    next = new do_tighten_action(nactions, CoinPresolveCopyOfArray(prob, actions, nactions), next);
 
     next = useless_constraint_action::presolve(prob,
 					       useless_rows, nuseless_rows,
@@ -471,7 +473,8 @@ void do_tighten_action::postsolve(CoinPostsolveMatrix *prob) const
 	Why do we correct the row status only when the column is made basic?
 	Need to look at preceding code.  -- lh, 110528 --
       */
-      if (fabs(sol[jcol]-clo[jcol]) > ZTOLDP &&
+      if (prob->colstat_ &&
+          fabs(sol[jcol]-clo[jcol]) > ZTOLDP &&
           fabs(sol[jcol]-cup[jcol]) > ZTOLDP) {
         
         prob->setColumnStatus(jcol,CoinPrePostsolveMatrix::basic);
@@ -500,9 +503,9 @@ do_tighten_action::~do_tighten_action()
 {
     if (nactions_ > 0) {
 	for (int i = nactions_ - 1; i >= 0; --i) {
-	    delete[] actions_[i].rows;
-	    delete[] actions_[i].lbound;
-	    delete[] actions_[i].ubound;
+	    deleteAction(actions_[i].rows, int*);
+	    deleteAction(actions_[i].lbound, double*);
+	    deleteAction(actions_[i].ubound, double*);
 	}
 	deleteAction(actions_, action*);
     }
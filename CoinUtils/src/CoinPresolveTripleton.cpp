@@ -9,6 +9,7 @@
 #include "CoinFinite.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
+#include "CoinInstrument.hpp"
 
 #include "CoinPresolveEmpty.hpp"	// for DROP_COL/DROP_ROW
 #include "CoinPresolveZeros.hpp"
@@ -70,8 +71,8 @@ msg
 			   double *colels,
 			   int *hrow, int *hcol,
 			   int *hinrow, int *hincol,
-			   presolvehlink *clink, int ncols,
-			   presolvehlink *rlink, int nrows,
+			   presolvehlink *clink, presolvehspace *cspace, int ncols,
+			   presolvehlink *rlink, presolvehspace *rspace, int nrows,
 			   CoinBigIndex *mrstrt, double *rowels,
 			   //double a, double b, double c,
 			   double coeff_factorx,double coeff_factorz,
@@ -181,7 +182,7 @@ msg
 	  
 	  {
 	    bool no_mem = presolve_expand_col(mcstrt,colels,hrow,hincol,
-					      clink,ncols,icolz);
+					      clink,ncols,icolz,cspace);
 	    if (no_mem)
 	      return (true);
 	    
@@ -214,7 +215,8 @@ msg
 	  hcol[k2] = icolx;
 	  rowels[k2] = colels[kcoly] * coeff_factorx;
 	}
-	presolve_expand_row(mrstrt,rowels,hcol,hinrow,rlink,nrows,row) ;
+	presolve_expand_row(mrstrt,rowels,hcol,hinrow,rlink,nrows,row,
+			    rspace) ;
 	// there is now an unused entry in the memory after the column - use it
 	int krez = mrstrt[row]+hinrow[row];
 	hcol[krez] = icolz;
@@ -223,7 +225,7 @@ msg
 
 	{
 	  bool no_mem = presolve_expand_col(mcstrt,colels,hrow,hincol,
-					    clink,ncols,icolx) ;
+					    clink,ncols,icolx,cspace) ;
 	  if (no_mem)
 	    return (true);
 
@@ -247,7 +249,7 @@ msg
 
 	{
 	  bool no_mem = presolve_expand_col(mcstrt,colels,hrow,hincol,clink,
-					    ncols,icolz);
+					    ncols,icolz,cspace);
 	  if (no_mem)
 	    return (true);
 
@@ -290,6 +292,7 @@ msg
 const CoinPresolveAction *tripleton_action::presolve(CoinPresolveMatrix *prob,
 						  const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.tripleton");
   double *colels	= prob->colels_;
   int *hrow		= prob->hrow_;
   CoinBigIndex *mcstrt		= prob->mcstrt_;
@@ -587,7 +590,8 @@ const CoinPresolveAction *tripleton_action::presolve(CoinPresolveMatrix *prob,
 	bool no_mem = elim_tripleton("ELIMT",
 				     mcstrt, rlo, acts, rup, colels,
 				     hrow, hcol, hinrow, hincol,
-				     clink, ncols, rlink, nrows,
+				     clink, &prob->cspace_, ncols,
+				     rlink, &prob->rspace_, nrows,
 				     mrstrt, rowels,
 				     cx,
 				     cz,
@@ -635,7 +639,7 @@ const CoinPresolveAction *tripleton_action::presolve(CoinPresolveMatrix *prob,
 #   if PRESOLVE_SUMMARY > 0
     printf("NTRIPLETONS:  %d\n", nactions);
 #   endif
-    action *actions1 = new action[nactions];
+    action *actions1 = CoinPresolveNewArray<action>(prob, nactions);
     CoinMemcpyN(actions, nactions, actions1);
 
     next = new tripleton_action(nactions, actions1, next);
@@ -822,7 +826,8 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
 
 	acts[iRow] += yValue * bounds_factor;
 
-	djy -= rowduals[iRow] * yValue;
+	if (rowduals)
+	  djy -= rowduals[iRow] * yValue;
       } 
       
       hrow[k] = iRow;
@@ -854,7 +859,7 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	colels[k]=value;
 	last=k;
 	k = link[k];
-	if (iRow != irow) 
+	if (rowduals && iRow != irow) 
 	  djx -= rowduals[iRow] * value;
       } else {
 	numberInColumn--;
@@ -875,7 +880,7 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
       double xValue = element1[iRow];
       element1[iRow]=0.0;
       if (fabs(xValue)>=1.0e-15) {
-	if (iRow != irow)
+	if (rowduals && iRow != irow)
 	  djx -= rowduals[iRow] * xValue;
 	numberInColumn++;
 	CoinBigIndex k = free_list;
@@ -911,7 +916,7 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	colels[k]=value;
 	last=k;
 	k = link[k];
-	if (iRow != irow) 
+	if (rowduals && iRow != irow) 
 	  djz -= rowduals[iRow] * value;
       } else {
 	numberInColumn--;
@@ -933,7 +938,7 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
       double zValue = element2[iRow];
       element2[iRow]=0.0;
       if (fabs(zValue)>=1.0e-15) {
-	if (iRow != irow)
+	if (rowduals && iRow != irow)
 	  djz -= rowduals[iRow] * zValue;
 	numberInColumn++;
 	CoinBigIndex k = free_list;
@@ -996,7 +1001,7 @@ void tripleton_action::postsolve(CoinPostsolveMatrix *prob) const
 	rcosts[jcolz] = djz - rowduals[irow] * coeffz;
 	rcosts[jcoly] = djy - rowduals[irow] * coeffy;
       }
-    } else {
+    } else if (rowduals) {
       // No status array
       // this is the coefficient we need to force col y's reduced cost to 0.0;
       // for example, this is obviously true if y is a singleton column
@@ -8,6 +8,7 @@
 #include "CoinPresolveMatrix.hpp"
 #include "CoinPresolveUseless.hpp"
 #include "CoinPresolveFixed.hpp"
+#include "CoinInstrument.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinFinite.hpp"
 
@@ -150,6 +151,12 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
   int numberInfeasible = 0 ;
   int numberChanged = 0 ;
   int totalTightened = 0 ;
+/*
+  Until a column bound is tightened, the row activity bounds cache (if it's
+  in use) holds L(i) and U(i) for the bounds we're working with.
+*/
+  prob->syncRowActivity() ;
+  bool sameBounds = true ;
   int numberCheck = -1 ;
 
   const int MAXPASS = 10 ;
@@ -194,27 +201,30 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
   bounds are conservative, then add in a whopping big value to account for the
   infinite component.
 */
-      for (CoinBigIndex kcol = krs ; kcol < kre ; ++kcol) {
-	const double value = rowCoeffs[kcol] ;
-	const int j = colIndices[kcol] ;
-	if (value > 0.0) {
-	  if (columnUpper[j] < large) 
-	    finUpi += columnUpper[j]*value ;
-	  else
-	    ++infUpi ;
-	  if (columnLower[j] > -large) 
-	    finDowni += columnLower[j]*value ;
-	  else
-	    ++infLoi ;
-	} else if (value<0.0) {
-	  if (columnUpper[j] < large) 
-	    finDowni += columnUpper[j]*value ;
-	  else
-	    ++infLoi ;
-	  if (columnLower[j] > -large) 
-	    finUpi += columnLower[j]*value ;
-	  else
-	    ++infUpi ;
+      if (!sameBounds ||
+	  !prob->rowActivityBounds(i,finDowni,infLoi,finUpi,infUpi)) {
+	for (CoinBigIndex kcol = krs ; kcol < kre ; ++kcol) {
+	  const double value = rowCoeffs[kcol] ;
+	  const int j = colIndices[kcol] ;
+	  if (value > 0.0) {
+	    if (columnUpper[j] < large) 
+	      finUpi += columnUpper[j]*value ;
+	    else
+	      ++infUpi ;
+	    if (columnLower[j] > -large) 
+	      finDowni += columnLower[j]*value ;
+	    else
+	      ++infLoi ;
+	  } else if (value<0.0) {
+	    if (columnUpper[j] < large) 
+	      finDowni += columnUpper[j]*value ;
+	    else
+	      ++infLoi ;
+	    if (columnLower[j] > -large) 
+	      finUpi += columnLower[j]*value ;
+	    else
+	      ++infUpi ;
+	  }
 	}
       }
       markRow[i] = markActOK ;
@@ -255,6 +265,13 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
 */
       const double rloi = rlo[i] ;
       const double rupi = rup[i] ;
+/*
+  A new bound on x(t) against rlo(i) needs at most one infinite contribution
+  to U(i) (and x(t) responsible for it); likewise against rup(i) and L(i).
+  If neither is possible, walking the row won't get us anything.
+*/
+      if ((rloi <= -large || infUpi > 1) && (rupi >= large || infLoi > 1))
+	continue ;
       if (finUpi < rloi && finUpi > rloi-relaxedTol)
 	finUpi = rloi ;
       if (finDowni > rupi && finDowni < rupi+relaxedTol)
@@ -309,6 +326,7 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
 		break ;
 	      }
 	      columnLower[t] = newlt ;
+	      sameBounds = false ;
 	      markRow[i] = markIgnore ;
 	      numberChanged++ ;
 	      const CoinBigIndex kcs = colStarts[t] ;
@@ -346,6 +364,7 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
 	    }
 	    if (newut < ut-1.0e-12 && newut < large) {
 	      columnUpper[t] = newut ;
+	      sameBounds = false ;
 	      if (newut-lt < -relaxedTol) {
 		numberInfeasible++ ;
 		break ;
@@ -388,6 +407,7 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
 	    }
 	    if (newut < ut-1.0e-12 && newut < large) {
 	      columnUpper[t] = newut  ;
+	      sameBounds = false ;
 	      if (newut-lt < -relaxedTol) {
 		numberInfeasible++ ;
 		break ;
@@ -426,6 +446,7 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
 	    }
 	    if (newlt > lt+1.0e-12 && newlt > -large) {
 	      columnLower[t] = newlt ;
+	      sameBounds = false ;
 	      if (ut-newlt < -relaxedTol) {
 		numberInfeasible++ ;
 		break ;
@@ -477,7 +498,7 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
       
       if (markRow[i] == markIgnore) continue ;
 /*
-  Recalculate L(i) and U(i).
+  Recalculate L(i) and U(i), unless the cache has them.
 
   LOU: Arguably this would not be necessary if we saved L(i) and U(i).
 */
@@ -488,27 +509,30 @@ const CoinPresolveAction *testRedundant (CoinPresolveMatrix *prob,
       const CoinBigIndex krs = rowStarts[i] ;
       const CoinBigIndex kre = krs+rowLengths[i] ;
 
-      for (CoinBigIndex krow = krs; krow < kre; ++krow) {
-	const double value = rowCoeffs[krow] ;
-	const int j = colIndices[krow] ;
-	if (value > 0.0) {
-	  if (columnUpper[j] < large) 
-	    finUpi += columnUpper[j] * value ;
-	  else
-	    ++infUpi ;
-	  if (columnLower[j] > -large) 
-	    finDowni += columnLower[j] * value ;
-	  else
-	    ++infLoi ;
-	} else if (value<0.0) {
-	  if (columnUpper[j] < large) 
-	    finDowni += columnUpper[j] * value ;
-	  else
-	    ++infLoi ;
-	  if (columnLower[j] > -large) 
-	    finUpi += columnLower[j] * value ;
-	  else
-	    ++infUpi ;
+      if (!sameBounds ||
+	  !prob->rowActivityBounds(i,finDowni,infLoi,finUpi,infUpi)) {
+	for (CoinBigIndex krow = krs; krow < kre; ++krow) {
+	  const double value = rowCoeffs[krow] ;
+	  const int j = colIndices[krow] ;
+	  if (value > 0.0) {
+	    if (columnUpper[j] < large) 
+	      finUpi += columnUpper[j] * value ;
+	    else
+	      ++infUpi ;
+	    if (columnLower[j] > -large) 
+	      finDowni += columnLower[j] * value ;
+	    else
+	      ++infLoi ;
+	  } else if (value<0.0) {
+	    if (columnUpper[j] < large) 
+	      finDowni += columnUpper[j] * value ;
+	    else
+	      ++infLoi ;
+	    if (columnLower[j] > -large) 
+	      finUpi += columnLower[j] * value ;
+	    else
+	      ++infUpi ;
+	  }
 	}
       }
       finUpi += 1.0e-8*fabs(finUpi) ;
@@ -634,6 +658,7 @@ const CoinPresolveAction *useless_constraint_action::presolve(CoinPresolveMatrix
 								  int nuseless_rows,
 				       const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.useless_constraint");
 # if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 # if PRESOLVE_DEBUG > 0
   std::cout
@@ -669,7 +694,7 @@ const CoinPresolveAction *useless_constraint_action::presolve(CoinPresolveMatrix
   double *rlo	= prob->rlo_;
   double *rup	= prob->rup_;
 
-  action *actions	= new action [nuseless_rows];
+  action *actions	= CoinPresolveNewArray<action>(prob,nuseless_rows);
 
   for (int i=0; i<nuseless_rows; ++i) {
     int irow = useless_rows[i];
@@ -686,8 +711,8 @@ const CoinPresolveAction *useless_constraint_action::presolve(CoinPresolveMatrix
     f->ninrow = hinrow[irow];
     f->rlo = rlo[irow];
     f->rup = rup[irow];
-    f->rowcols = CoinCopyOfArray(&hcol[krs], hinrow[irow]);
-    f->rowels  = CoinCopyOfArray(&rowels[krs], hinrow[irow]);
+    f->rowcols = CoinPresolveCopyOfArray(prob, &hcol[krs], hinrow[irow]);
+    f->rowels  = CoinPresolveCopyOfArray(prob, &rowels[krs], hinrow[irow]);
 
     for (CoinBigIndex k=krs; k<kre; k++)
     { presolve_delete_from_col(irow,hcol[k],mcstrt,hincol,hrow,colels) ;
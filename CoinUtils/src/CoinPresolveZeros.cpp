@@ -9,6 +9,7 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinPresolveMatrix.hpp"
 #include "CoinPresolveZeros.hpp"
+#include "CoinInstrument.hpp"
 
 #if PRESOLVE_DEBUG > 0 || PRESOLVE_CONSISTENCY > 0
 #include "CoinPresolvePsdebug.hpp"
@@ -201,6 +202,7 @@ const CoinPresolveAction
 					    int ncheckcols,
 					    const CoinPresolveAction *next)
 {
+  COIN_TIME_SCOPE("presolve.drop_zero_coefficients");
   double *colels = prob->colels_ ;
   int *hrow = prob->hrow_ ;
   CoinBigIndex *mcstrt = prob->mcstrt_ ;
@@ -275,16 +277,23 @@ const CoinPresolveAction
 /*
   This wrapper initialises checkcols for the case where the entire matrix
   should be scanned. Typically used from the presolve driver as part of final
-  cleanup.
+  cleanup. With changedOnly, only the columns on the ToDo lists are scanned.
 */
 const CoinPresolveAction
   *drop_zero_coefficients (CoinPresolveMatrix *prob,
-			   const CoinPresolveAction *next)
+			   const CoinPresolveAction *next,
+			   bool changedOnly)
 {
   int ncheck = prob->ncols_ ;
   int *checkcols = new int[ncheck] ;
 
-  if (prob->anyProhibited()) {
+  if (changedOnly) {
+    ncheck = prob->changedCols(checkcols) ;
+    if (ncheck == 0) {
+      delete [] checkcols ;
+      return (next) ;
+    }
+  } else if (prob->anyProhibited()) {
     ncheck = 0 ;
     for (int i = 0 ; i < prob->ncols_ ; i++)
       if (!prob->colProhibited(i))
@@ -54,7 +54,15 @@ class drop_zero_coefficients_action : public CoinPresolveAction {
   virtual ~drop_zero_coefficients_action() { deleteAction(zeros_,dropped_zero*); }
 };
 
+/*! \brief Scan for explicit zeros and drop them
+
+  If \p changedOnly is false, every column not prohibited is scanned.
+  If true, only the columns on the column ToDo lists are scanned
+  (CoinPresolveMatrix::changedCols), so that late passes cost time in
+  proportion to the changes rather than the size of the matrix.
+*/
 const CoinPresolveAction *drop_zero_coefficients(CoinPresolveMatrix *prob,
-					      const CoinPresolveAction *next);
+					      const CoinPresolveAction *next,
+					      bool changedOnly = false);
 
 #endif
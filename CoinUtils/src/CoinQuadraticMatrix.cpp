@@ -0,0 +1,411 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include "CoinPragma.hpp"
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinQuadraticMatrix.hpp"
+
+// A pending change - column in high and row in low half of key
+typedef struct {
+  CoinUInt64 key;
+  double value;
+} CoinQuadraticChange;
+inline bool operator<(const CoinQuadraticChange & a,
+		      const CoinQuadraticChange & b)
+{ return a.key < b.key;}
+
+//#############################################################################
+
+CoinQuadraticMatrix::CoinQuadraticMatrix() :
+  numberColumns_(0),
+  packedColumns_(0),
+  numberElements_(0),
+  start_(NULL),
+  row_(NULL),
+  element_(NULL),
+  numberPending_(0),
+  maximumPending_(0),
+  pendingRow_(NULL),
+  pendingColumn_(NULL),
+  pendingElement_(NULL)
+{
+}
+
+CoinQuadraticMatrix::CoinQuadraticMatrix(const CoinQuadraticMatrix & rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+CoinQuadraticMatrix &
+CoinQuadraticMatrix::operator=(const CoinQuadraticMatrix & rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+void
+CoinQuadraticMatrix::swap(CoinQuadraticMatrix & rhs)
+{
+  std::swap(numberColumns_, rhs.numberColumns_);
+  std::swap(packedColumns_, rhs.packedColumns_);
+  std::swap(numberElements_, rhs.numberElements_);
+  std::swap(start_, rhs.start_);
+  std::swap(row_, rhs.row_);
+  std::swap(element_, rhs.element_);
+  std::swap(numberPending_, rhs.numberPending_);
+  std::swap(maximumPending_, rhs.maximumPending_);
+  std::swap(pendingRow_, rhs.pendingRow_);
+  std::swap(pendingColumn_, rhs.pendingColumn_);
+  std::swap(pendingElement_, rhs.pendingElement_);
+}
+
+CoinQuadraticMatrix::~CoinQuadraticMatrix()
+{
+  gutsOfDelete();
+}
+
+void
+CoinQuadraticMatrix::gutsOfDelete()
+{
+  delete [] start_;
+  delete [] row_;
+  delete [] element_;
+  delete [] pendingRow_;
+  delete [] pendingColumn_;
+  delete [] pendingElement_;
+  start_ = NULL;
+  row_ = NULL;
+  element_ = NULL;
+  pendingRow_ = NULL;
+  pendingColumn_ = NULL;
+  pendingElement_ = NULL;
+  numberPending_ = 0;
+  maximumPending_ = 0;
+}
+
+void
+CoinQuadraticMatrix::gutsOfCopy(const CoinQuadraticMatrix & rhs)
+{
+  rhs.checkMerged();
+  numberColumns_ = rhs.numberColumns_;
+  packedColumns_ = rhs.packedColumns_;
+  numberElements_ = rhs.numberElements_;
+  start_ = CoinCopyOfArray(rhs.start_, packedColumns_ + 1);
+  row_ = CoinCopyOfArray(rhs.row_, numberElements_);
+  element_ = CoinCopyOfArray(rhs.element_, numberElements_);
+  numberPending_ = 0;
+  maximumPending_ = 0;
+  pendingRow_ = NULL;
+  pendingColumn_ = NULL;
+  pendingElement_ = NULL;
+}
+
+void
+CoinQuadraticMatrix::clear()
+{
+  gutsOfDelete();
+  numberColumns_ = 0;
+  packedColumns_ = 0;
+  numberElements_ = 0;
+}
+
+void
+CoinQuadraticMatrix::resize(int numberColumns)
+{
+  numberColumns_ = CoinMax(numberColumns_, numberColumns);
+}
+
+void
+CoinQuadraticMatrix::setTriples(int numberColumns, CoinBigIndex numberElements,
+				const int * rows, const int * columns,
+				const double * elements, bool fullMatrix)
+{
+  clear();
+  numberColumns_ = numberColumns;
+  packedColumns_ = numberColumns;
+  start_ = new CoinBigIndex [numberColumns + 1];
+  CoinZeroN(start_, numberColumns + 1);
+  CoinBigIndex k;
+  for (k = 0; k < numberElements; k++) {
+    int jColumn = CoinMax(rows[k], columns[k]);
+    assert (CoinMin(rows[k], columns[k]) >= 0 && jColumn < numberColumns);
+    start_[jColumn + 1]++;
+  }
+  for (int j = 0; j < numberColumns; j++)
+    start_[j + 1] += start_[j];
+  row_ = new int [numberElements];
+  element_ = new double [numberElements];
+  CoinBigIndex * put = CoinCopyOfArray(start_, numberColumns);
+  for (k = 0; k < numberElements; k++) {
+    int iRow = rows[k];
+    int jColumn = columns[k];
+    double value = elements[k];
+    if (iRow > jColumn) {
+      int temp = iRow;
+      iRow = jColumn;
+      jColumn = temp;
+    }
+    if (fullMatrix && iRow != jColumn)
+      value *= 0.5;
+    CoinBigIndex position = put[jColumn]++;
+    row_[position] = iRow;
+    element_[position] = value;
+  }
+  delete [] put;
+  // sort each column, add duplicates and drop zeros
+  CoinBigIndex n = 0;
+  CoinBigIndex start = 0;
+  for (int j = 0; j < numberColumns; j++) {
+    CoinBigIndex end = start_[j + 1];
+    for (k = start + 1; k < end; k++) {
+      if (row_[k] < row_[k - 1]) {
+	CoinSort_2(row_ + start, row_ + end, element_ + start);
+	break;
+      }
+    }
+    start_[j] = n;
+    k = start;
+    while (k < end) {
+      int iRow = row_[k];
+      double value = element_[k++];
+      while (k < end && row_[k] == iRow)
+	value += element_[k++];
+      if (value) {
+	row_[n] = iRow;
+	element_[n++] = value;
+      }
+    }
+    start = end;
+  }
+  start_[numberColumns] = n;
+  numberElements_ = n;
+}
+
+void
+CoinQuadraticMatrix::setElement(int i, int j, double value)
+{
+  assert (i >= 0 && j >= 0);
+  if (i > j) {
+    int temp = i;
+    i = j;
+    j = temp;
+  }
+  if (numberPending_ == maximumPending_) {
+    maximumPending_ = 2 * maximumPending_ + 100;
+    int * temp = CoinCopyOfArrayPartial(pendingRow_, maximumPending_,
+					numberPending_);
+    delete [] pendingRow_;
+    pendingRow_ = temp;
+    temp = CoinCopyOfArrayPartial(pendingColumn_, maximumPending_,
+				  numberPending_);
+    delete [] pendingColumn_;
+    pendingColumn_ = temp;
+    double * temp2 = CoinCopyOfArrayPartial(pendingElement_, maximumPending_,
+					    numberPending_);
+    delete [] pendingElement_;
+    pendingElement_ = temp2;
+  }
+  pendingRow_[numberPending_] = i;
+  pendingColumn_[numberPending_] = j;
+  pendingElement_[numberPending_++] = value;
+  numberColumns_ = CoinMax(numberColumns_, j + 1);
+}
+
+void
+CoinQuadraticMatrix::merge() const
+{
+  // sort changes keeping order of equal ones so last wins
+  CoinQuadraticChange * change = new CoinQuadraticChange [numberPending_ + 1];
+  CoinBigIndex k;
+  for (k = 0; k < numberPending_; k++) {
+    change[k].key = (static_cast<CoinUInt64>(pendingColumn_[k]) << 32) |
+      static_cast<unsigned int>(pendingRow_[k]);
+    change[k].value = pendingElement_[k];
+  }
+  std::stable_sort(change, change + numberPending_);
+  CoinBigIndex numberChanges = 0;
+  for (k = 0; k < numberPending_; k++) {
+    if (k + 1 < numberPending_ && change[k + 1].key == change[k].key)
+      continue;
+    change[numberChanges++] = change[k];
+  }
+  // sentinel (column larger than any)
+  change[numberChanges].key = ~static_cast<CoinUInt64>(0);
+  CoinBigIndex * start = new CoinBigIndex [numberColumns_ + 1];
+  int * row = new int [numberElements_ + numberChanges];
+  double * element = new double [numberElements_ + numberChanges];
+  CoinBigIndex n = 0;
+  CoinBigIndex next = 0;
+  for (int j = 0; j < numberColumns_; j++) {
+    start[j] = n;
+    CoinBigIndex kStart = (j < packedColumns_) ? start_[j] : 0;
+    CoinBigIndex kEnd = (j < packedColumns_) ? start_[j + 1] : 0;
+    k = kStart;
+    while (k < kEnd || (change[next].key >> 32) == static_cast<CoinUInt64>(j)) {
+      int iRow;
+      double value;
+      bool changed = ((change[next].key >> 32) == static_cast<CoinUInt64>(j));
+      int changeRow = changed ?
+	static_cast<int>(change[next].key & 0xffffffff) : COIN_INT_MAX;
+      if (k < kEnd && row_[k] < changeRow) {
+	iRow = row_[k];
+	value = element_[k++];
+      } else {
+	iRow = changeRow;
+	value = change[next++].value;
+	if (k < kEnd && row_[k] == iRow)
+	  k++;
+      }
+      if (value) {
+	row[n] = iRow;
+	element[n++] = value;
+      }
+    }
+  }
+  start[numberColumns_] = n;
+  delete [] change;
+  delete [] start_;
+  delete [] row_;
+  delete [] element_;
+  start_ = start;
+  row_ = row;
+  element_ = element;
+  numberElements_ = n;
+  packedColumns_ = numberColumns_;
+  numberPending_ = 0;
+}
+
+double
+CoinQuadraticMatrix::getElement(int i, int j) const
+{
+  if (i > j) {
+    int temp = i;
+    i = j;
+    j = temp;
+  }
+  if (i < 0 || j >= numberColumns_)
+    return 0.0;
+  checkMerged();
+  const int * first = row_ + start_[j];
+  const int * last = row_ + start_[j + 1];
+  const int * found = std::lower_bound(first, last, i);
+  if (found != last && *found == i)
+    return element_[found - row_];
+  else
+    return 0.0;
+}
+
+CoinPackedMatrix *
+CoinQuadraticMatrix::packedMatrix(bool full) const
+{
+  checkMerged();
+  if (!full)
+    return new CoinPackedMatrix(true, numberColumns_, numberColumns_,
+				numberElements_, element_, row_, start_, NULL);
+  // lower part of column j is upper part of row j
+  int numberDiagonal = 0;
+  CoinBigIndex * start = new CoinBigIndex [numberColumns_ + 1];
+  CoinZeroN(start, numberColumns_ + 1);
+  int j;
+  CoinBigIndex k;
+  for (j = 0; j < numberColumns_; j++) {
+    for (k = start_[j]; k < start_[j + 1]; k++) {
+      int iRow = row_[k];
+      start[j + 1]++;
+      if (iRow != j)
+	start[iRow + 1]++;
+      else
+	numberDiagonal++;
+    }
+  }
+  for (j = 0; j < numberColumns_; j++)
+    start[j + 1] += start[j];
+  CoinBigIndex numberElements = 2 * numberElements_ - numberDiagonal;
+  assert (start[numberColumns_] == numberElements);
+  int * row = new int [numberElements];
+  double * element = new double [numberElements];
+  CoinBigIndex * put = CoinCopyOfArray(start, numberColumns_);
+  for (j = 0; j < numberColumns_; j++) {
+    for (k = start_[j]; k < start_[j + 1]; k++) {
+      int iRow = row_[k];
+      double value = element_[k];
+      CoinBigIndex position = put[j]++;
+      row[position] = iRow;
+      element[position] = value;
+      if (iRow != j) {
+	position = put[iRow]++;
+	row[position] = j;
+	element[position] = value;
+      }
+    }
+  }
+  delete [] put;
+  CoinPackedMatrix * matrix = new CoinPackedMatrix();
+  int * length = NULL;
+  matrix->assignMatrix(true, numberColumns_, numberColumns_, numberElements,
+		       element, row, start, length);
+  return matrix;
+}
+
+void
+CoinQuadraticMatrix::times(const double * x, double * y) const
+{
+  checkMerged();
+  const CoinBigIndex * COIN_RESTRICT start = start_;
+  const int * COIN_RESTRICT row = row_;
+  const double * COIN_RESTRICT element = element_;
+  CoinZeroN(y, numberColumns_);
+  for (int j = 0; j < numberColumns_; j++) {
+    double xj = x[j];
+    double sum = 0.0;
+    CoinBigIndex end = start[j + 1];
+    double diagonal = 0.0;
+    // diagonal is last if there
+    if (end > start[j] && row[end - 1] == j)
+      diagonal = element[--end];
+    for (CoinBigIndex k = start[j]; k < end; k++) {
+      int iRow = row[k];
+      double value = element[k];
+      y[iRow] += value * xj;
+      sum += value * x[iRow];
+    }
+    y[j] += sum + diagonal * xj;
+  }
+}
+
+double
+CoinQuadraticMatrix::quadraticForm(const double * x) const
+{
+  checkMerged();
+  const CoinBigIndex * COIN_RESTRICT start = start_;
+  const int * COIN_RESTRICT row = row_;
+  const double * COIN_RESTRICT element = element_;
+  double total = 0.0;
+  for (int j = 0; j < numberColumns_; j++) {
+    double xj = x[j];
+    if (!xj)
+      continue;
+    CoinBigIndex end = start[j + 1];
+    double diagonal = 0.0;
+    if (end > start[j] && row[end - 1] == j)
+      diagonal = element[--end];
+    double sum = 0.0;
+    for (CoinBigIndex k = start[j]; k < end; k++)
+      sum += element[k] * x[row[k]];
+    total += xj * (2.0 * sum + diagonal * xj);
+  }
+  return total;
+}
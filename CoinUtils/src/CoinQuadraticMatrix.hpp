@@ -0,0 +1,136 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinQuadraticMatrix_H
+#define CoinQuadraticMatrix_H
+
+#include <cstddef>
+
+#include "CoinTypes.hpp"
+
+class CoinPackedMatrix;
+
+/** Symmetric quadratic matrix stored as its upper triangle
+
+    Column j holds Q(i,j) for i <= j in increasing order of i, packed one
+    column after another (start, index, element).  The objective convention
+    is c'x + 1/2 x'Qx as for QUADOBJ in MPS files.  Used by CoinModel for a
+    quadratic objective and by CoinMpsIO when reading QUADOBJ or QMATRIX,
+    so large matrices never go through strings.
+
+    Elements may also be set one at a time.  Such changes are kept as
+    triples and merged (one sort) when the matrix is next looked at, so
+    building a matrix element by element is not quadratic in cost.  As
+    merging changes the object, const methods must not be called from
+    several threads while changes are pending.
+*/
+class CoinQuadraticMatrix {
+public:
+  /**@name Loading and modifying */
+  //@{
+  /** Replaces matrix by triples (i,j,value) for numberColumns columns.
+      Elements below the diagonal are moved above and duplicates added.
+      If fullMatrix then both Q(i,j) and Q(j,i) are expected and the
+      symmetric part (Q + Q')/2 is kept i.e. off diagonal elements are
+      halved.  Zero elements are dropped */
+  void setTriples(int numberColumns, CoinBigIndex numberElements,
+		  const int * rows, const int * columns,
+		  const double * elements, bool fullMatrix = false);
+  /// Sets Q(i,j) and Q(j,i) to value (zero removes)
+  void setElement(int i, int j, double value);
+  /// Makes matrix have at least numberColumns columns
+  void resize(int numberColumns);
+  /// Removes all elements and columns
+  void clear();
+  //@}
+
+  /**@name Access */
+  //@{
+  /// Number of columns
+  inline int getNumCols() const
+  { return numberColumns_;}
+  /// Number of elements in upper triangle
+  inline CoinBigIndex getNumElements() const
+  { checkMerged(); return numberElements_;}
+  /// Starts of columns (getNumCols()+1)
+  inline const CoinBigIndex * getVectorStarts() const
+  { checkMerged(); return start_;}
+  /// Row indices (increasing in each column)
+  inline const int * getIndices() const
+  { checkMerged(); return row_;}
+  /// Elements
+  inline const double * getElements() const
+  { checkMerged(); return element_;}
+  /// Q(i,j)
+  double getElement(int i, int j) const;
+  /** Returns new column ordered CoinPackedMatrix holding upper triangle
+      (or full matrix if full) - user to delete */
+  CoinPackedMatrix * packedMatrix(bool full = false) const;
+  //@}
+
+  /**@name Kernels */
+  //@{
+  /// y = Qx
+  void times(const double * x, double * y) const;
+  /// Returns x'Qx
+  double quadraticForm(const double * x) const;
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  CoinQuadraticMatrix();
+  /// Copy constructor
+  CoinQuadraticMatrix(const CoinQuadraticMatrix & rhs);
+  /// Assignment
+  CoinQuadraticMatrix & operator=(const CoinQuadraticMatrix & rhs);
+  /// Exchange contents (no copying)
+  void swap(CoinQuadraticMatrix & rhs);
+  /// Destructor
+  ~CoinQuadraticMatrix();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Frees all arrays
+  void gutsOfDelete();
+  /// Copies rhs (with changes merged)
+  void gutsOfCopy(const CoinQuadraticMatrix & rhs);
+  /// Merges pending changes into packed form
+  void merge() const;
+  /// Merges if there are pending changes
+  inline void checkMerged() const
+  { if (numberPending_ || packedColumns_ < numberColumns_) merge();}
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Number of columns
+  int numberColumns_;
+  /// Number of columns in packed form
+  mutable int packedColumns_;
+  /// Number of elements
+  mutable CoinBigIndex numberElements_;
+  /// Starts (packedColumns_+1)
+  mutable CoinBigIndex * start_;
+  /// Row indices
+  mutable int * row_;
+  /// Elements
+  mutable double * element_;
+  /// Number of pending changes
+  mutable CoinBigIndex numberPending_;
+  /// Space for pending changes
+  CoinBigIndex maximumPending_;
+  /// Row of each pending change (row <= column)
+  mutable int * pendingRow_;
+  /// Column of each pending change
+  mutable int * pendingColumn_;
+  /// Value of each pending change
+  mutable double * pendingElement_;
+  //@}
+};
+
+#endif
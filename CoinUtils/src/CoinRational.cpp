@@ -4,63 +4,187 @@
 
 #include <algorithm>
 #include <cmath>
+#include <climits>
 #ifdef __clang__
 //labs() is in cstdlib with clang
 #include <cstdlib>
 #endif
 
 #include "CoinRational.hpp"
+#include "CoinPackedMatrix.hpp"
+
+// Values whose numerator would not fit in a long are not converted
+static const double coinRationalMaxValue = 0.25*static_cast<double>(LONG_MAX);
+
+/* True if frac (in [0,1)) is numerator/den with den a power of 2, at most
+   maxdnom and small enough (den*den*maxdelta < 1) that no fraction with a
+   smaller denominator is within maxdelta */
+static bool coinDyadic(double frac, double maxdelta, long maxdnom,
+		       long &numerator, long &den)
+{
+   int exponent;
+   double mantissa = frexp(frac, &exponent);
+   // frac = whole * 2^(exponent-53) exactly
+   long long whole = static_cast<long long>(ldexp(mantissa, 53));
+   int shift = 53 - exponent;
+   while (shift > 0 && !(whole & 1)) {
+      whole >>= 1;
+      shift--;
+   }
+   if (shift > 62 || (1LL << shift) > maxdnom)
+      return false;
+   const double power = ldexp(1.0, shift);
+   if (power*power*maxdelta >= 1.0)
+      return false;
+   numerator = static_cast<long>(whole);
+   den = 1L << shift;
+   return true;
+}
+
+/*
+  Closest rational to val with denominator at most maxdnom, stopping at the
+  first continued fraction convergent within maxdelta (so the smallest
+  denominator which will do). Integer and dyadic values are found without
+  a search. Returns true if within tolerance.
+*/
+static bool coinNearestRational(double val, double maxdelta, long maxdnom,
+				long &numerator, long &denominator)
+{
+   numerator = 0;
+   denominator = 1;
+   const double absval = fabs(val);
+   if (absval != absval || absval >= coinRationalMaxValue || maxdnom < 1)
+      return false;
+   double intpart;
+   const double fracpart = modf(absval, &intpart);
+   long h = 0, k = 1;
+   if (fracpart == 0.0) {
+      // integer
+   } else if (coinDyadic(fracpart, maxdelta, maxdnom, h, k)) {
+      // exact with a power of 2
+   } else {
+      // continued fraction of fracpart - convergents h1/k1
+      long h0 = 0, k0 = 1, h1 = 1, k1 = 0;
+      double x = fracpart;
+      for (int iteration = 0; iteration < 64; iteration++) {
+	 const double a = floor(x);
+	 if (a*k1 + k0 > static_cast<double>(maxdnom)) {
+	    // best semiconvergent within the bound, if better than h1/k1
+	    const long t = (maxdnom - k0)/k1;
+	    const long hs = t*h1 + h0;
+	    const long ks = t*k1 + k0;
+	    if (fabs(fracpart - hs/double(ks)) < fabs(fracpart - h1/double(k1))) {
+	       h1 = hs;
+	       k1 = ks;
+	    }
+	    break;
+	 }
+	 const long ia = static_cast<long>(a);
+	 const long h2 = ia*h1 + h0;
+	 const long k2 = ia*k1 + k0;
+	 h0 = h1; k0 = k1;
+	 h1 = h2; k1 = k2;
+	 if (fabs(fracpart - h1/double(k1)) <= maxdelta)
+	    break;
+	 const double remainder = x - a;
+	 if (remainder <= 0.0)
+	    break;
+	 x = 1.0/remainder;
+      }
+      h = h1;
+      k = k1;
+   }
+   if (intpart*k >= coinRationalMaxValue)
+      return false;
+   numerator = static_cast<long>(intpart)*k + h;
+   denominator = k;
+   if (val < 0)
+      numerator = -numerator;
+   return fabs(val - numerator/double(denominator)) <= maxdelta;
+}
 
-// Based on Python code from
-// http://www.johndcook.com/blog/2010/10/20/best-rational-approximation/
-// (with permission).
-//
 // Returns closest (or almost, anyway) rational to val with denominator less
 // than or equal to maxdnom.  Return value is true if within tolerance, false
 // otherwise.
 bool CoinRational::nearestRational_(double val, double maxdelta, long maxdnom)
 {
-   double intpart;
-   double fracpart = fabs(modf(val, &intpart));
-   // Consider using remainder() instead?
-   
-   long a = 0, b = 1, c = 1, d = 1;
-   
-   while ( b <= maxdnom && d <= maxdnom) {
-      double mediant = (a + c)/(double(b + d));
-      
-      if ( fracpart == mediant ) {
-	 if ( b + d <= maxdnom ) {
-	    numerator_ = a + c;
-	    denominator_ = b + d;
-	 } else if ( d > b ) {
-	    numerator_ = c;
-	    denominator_ = d;
-	 } else {
-	    numerator_ = a;
-	    denominator_ = b;
-	 }
-      } else if ( val > mediant ) {
-	 a = a + c;
-	 b = b + d;
-      } else {
-	 c = a + c;
-	 d = b + d;
+   return coinNearestRational(val, maxdelta, maxdnom, numerator_, denominator_);
+}
+
+int CoinRational::nearestRationals(const double *values, int n,
+				   double maxdelta, long maxdnom,
+				   long *numerators, long *denominators)
+{
+   int numberBad = 0;
+   for (int i = 0; i < n; i++) {
+      const double value = values[i];
+      // most coefficients are integer
+      if (value == floor(value) && fabs(value) < coinRationalMaxValue) {
+	 numerators[i] = static_cast<long>(value);
+	 denominators[i] = 1;
+      } else if (!coinNearestRational(value, maxdelta, maxdnom,
+				      numerators[i], denominators[i])) {
+	 numerators[i] = 0;
+	 denominators[i] = 1;
+	 numberBad++;
       }
-      
-      if ( b > maxdnom ) {
-	 numerator_ = c;
-	 denominator_ = d;
-      } else {
-	 numerator_ = a;
-	 denominator_ = b;
+   }
+   return numberBad;
+}
+
+/*
+  Denominator so far is D. A value v which is not near an integer multiple
+  of 1/D needs p/q near vD with q <= maxdnom/D; D then becomes Dq. Earlier
+  values stay exact (p/D = pq/Dq), so numerators are made at the end.
+*/
+long CoinRational::commonDenominator(const double *values, int n,
+				     double maxdelta, long maxdnom,
+				     long *numerators)
+{
+   long common = 1;
+   for (int i = 0; i < n; i++) {
+      const double scaled = values[i]*common;
+      if (fabs(scaled) >= coinRationalMaxValue)
+	 return 0;
+      if (fabs(scaled - floor(scaled + 0.5)) <= maxdelta*common)
+	 continue;
+      long p, q;
+      if (!coinNearestRational(scaled, maxdelta*common, maxdnom/common, p, q))
+	 return 0;
+      common *= q;
+   }
+   if (numerators) {
+      for (int i = 0; i < n; i++) {
+	 const double scaled = values[i]*common;
+	 if (fabs(scaled) >= coinRationalMaxValue)
+	    return 0;
+	 numerators[i] = static_cast<long>(floor(scaled + 0.5));
       }
    }
-   
-   numerator_ += labs(intpart) * denominator_;
-   if ( val < 0 )
-      numerator_ *= -1;
-   
-   return fabs(val - numerator_/double(denominator_)) <= maxdelta;
+   return common;
 }
 
+int CoinRational::commonDenominators(const CoinPackedMatrix &matrix,
+				     double maxdelta, long maxdnom,
+				     long *denominators, long *numerators)
+{
+   const int numberMajor = matrix.getMajorDim();
+   const CoinBigIndex *start = matrix.getVectorStarts();
+   const int *length = matrix.getVectorLengths();
+   const double *element = matrix.getElements();
+   int numberBad = 0;
+   for (int i = 0; i < numberMajor; i++) {
+      const double *values = element + start[i];
+      long *these = numerators ? numerators + start[i] : NULL;
+      denominators[i] = commonDenominator(values, length[i], maxdelta,
+					  maxdnom, these);
+      if (!denominators[i]) {
+	 numberBad++;
+	 if (these) {
+	    for (int j = 0; j < length[i]; j++)
+	       these[j] = 0;
+	 }
+      }
+   }
+   return numberBad;
+}
@@ -7,6 +7,8 @@
 
 #include <cmath>
 
+class CoinPackedMatrix;
+
 //Small class for rational numbers
 class CoinRational
 {
@@ -33,6 +35,30 @@ public :
       }	    
    };
 
+   /** Rationals for \p n values at once. For each value the smallest
+       denominator (at most \p maxdnom) within \p maxdelta is found, integer
+       and dyadic values without any search. Values with none get 0/1.
+       Returns the number of such values. */
+   static int nearestRationals(const double *values, int n,
+			       double maxdelta, long maxdnom,
+			       long *numerators, long *denominators);
+
+   /** Smallest common denominator (at most \p maxdnom) with which all \p n
+       values are within \p maxdelta of numerators[i]/denominator, or 0 if
+       there is none. \p numerators may be NULL. */
+   static long commonDenominator(const double *values, int n,
+				 double maxdelta, long maxdnom,
+				 long *numerators);
+
+   /** commonDenominator for each major vector (row of a row ordered
+       matrix) of \p matrix into \p denominators. If \p numerators is not
+       NULL it is filled in element order (as matrix.getElements()) - with
+       0 for vectors with no common denominator. Returns the number of
+       such vectors. */
+   static int commonDenominators(const CoinPackedMatrix &matrix,
+				 double maxdelta, long maxdnom,
+				 long *denominators, long *numerators);
+
 private :
 
    long numerator_;
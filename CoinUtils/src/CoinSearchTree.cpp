@@ -5,71 +5,23 @@
 
 #include <cstdio>
 #include "CoinSearchTree.hpp"
-
-BitVector128::BitVector128()
-{
-  bits_[0] = 0;
-  bits_[1] = 0;
-  bits_[2] = 0;
-  bits_[3] = 0;
-}
-
-BitVector128::BitVector128(unsigned int bits[4])
-{
-   set(bits);
-}
+#include "CoinNodeStore.hpp"
 
 void
-BitVector128::set(unsigned int bits[4])
+CoinSearchTreeBase::unstoreTop() const
 {
-   bits_[0] = bits[0];
-   bits_[1] = bits[1];
-   bits_[2] = bits[2];
-   bits_[3] = bits[3];
+    store_->unstoreNode(candidateList_.front()->currentNode());
 }
 
 void
-BitVector128::setBit(int i)
+CoinSearchTreeBase::storeSiblings(CoinTreeSiblings* s)
 {
-  int byte = i >> 5;
-  int bit = i & 31;
-  bits_[byte] |= (1 << bit);
-}
-  
-void
-BitVector128::clearBit(int i)
-{
-  int byte = i >> 5;
-  int bit = i & 31;
-  bits_[byte] &= ~(1 << bit);
-}
-
-std::string
-BitVector128::str() const
-{
-  char output[33];
-  output[32] = 0;
-  sprintf(output, "%08X%08X%08X%08X",
-	  bits_[3], bits_[2], bits_[1], bits_[0]);
-  return output;
-}
-  
-bool
-operator<(const BitVector128& b0, const BitVector128& b1)
-{
-  if (b0.bits_[3] < b1.bits_[3])
-    return true;
-  if (b0.bits_[3] > b1.bits_[3])
-    return false;
-  if (b0.bits_[2] < b1.bits_[2])
-    return true;
-  if (b0.bits_[2] > b1.bits_[2])
-    return false;
-  if (b0.bits_[1] < b1.bits_[1])
-    return true;
-  if (b0.bits_[1] > b1.bits_[1])
-    return false;
-  return (b0.bits_[0] < b1.bits_[0]);
+    const CoinTreeNode* topNode = candidateList_.front()->currentNode();
+    for (int i = s->current(); i < s->size(); ++i) {
+	CoinTreeNode* node = s->node(i);
+	if (node != topNode)
+	    store_->storeNode(node);
+    }
 }
 
 void
@@ -107,3 +59,233 @@ CoinSearchTreeManager::reevaluateSearchStrategy()
 	}
     }
 }
+
+//#############################################################################
+
+CoinParallelSearchTreeManager::CoinParallelSearchTreeManager(int numberWorkers)
+  : numberWorkers_(numberWorkers > 0 ? numberWorkers : 1),
+    workers_(NULL),
+    rebalanceFrequency_(100),
+    rebalanceTolerance_(0.01),
+    numSolution_(0)
+{
+    workers_ = new worker[numberWorkers_];
+    for (int w = 0; w < numberWorkers_; ++w) {
+	workers_[w].tree = new CoinSearchTree<CoinSearchTreeCompareBest>;
+	workers_[w].topQuality = COIN_DBL_MAX;
+	workers_[w].popsSinceCheck = 0;
+	workers_[w].steals = 0;
+#ifdef COINUTILS_PTHREADS
+	pthread_mutex_init(&workers_[w].mutex, NULL);
+#endif
+    }
+}
+
+CoinParallelSearchTreeManager::~CoinParallelSearchTreeManager()
+{
+    for (int w = 0; w < numberWorkers_; ++w) {
+	delete workers_[w].tree;
+#ifdef COINUTILS_PTHREADS
+	pthread_mutex_destroy(&workers_[w].mutex);
+#endif
+    }
+    delete [] workers_;
+}
+
+void
+CoinParallelSearchTreeManager::setTree(int w, CoinSearchTreeBase* t)
+{
+    delete workers_[w].tree;
+    workers_[w].tree = t;
+    updateTop(w);
+}
+
+void
+CoinParallelSearchTreeManager::push(int w, CoinTreeNode* node,
+				    const bool incrInserted)
+{
+    lock(w);
+    workers_[w].tree->push(1, &node, incrInserted);
+    updateTop(w);
+    unlock(w);
+}
+
+void
+CoinParallelSearchTreeManager::push(int w, const CoinTreeSiblings& s,
+				    const bool incrInserted)
+{
+    lock(w);
+    workers_[w].tree->push(s, incrInserted);
+    updateTop(w);
+    unlock(w);
+}
+
+void
+CoinParallelSearchTreeManager::push(int w, const int n, CoinTreeNode** nodes,
+				    const bool incrInserted)
+{
+    lock(w);
+    workers_[w].tree->push(n, nodes, incrInserted);
+    updateTop(w);
+    unlock(w);
+}
+
+int
+CoinParallelSearchTreeManager::bestWorker(double& quality) const
+{
+    int best = -1;
+    quality = COIN_DBL_MAX;
+    for (int v = 0; v < numberWorkers_; ++v) {
+	lock(v);
+	const double q = workers_[v].topQuality;
+	const bool nonEmpty = workers_[v].tree->size() > 0;
+	unlock(v);
+	if (nonEmpty && (best < 0 || q < quality)) {
+	    best = v;
+	    quality = q;
+	}
+    }
+    return best;
+}
+
+CoinTreeNode*
+CoinParallelSearchTreeManager::take(int v)
+{
+    CoinTreeNode* node = workers_[v].tree->top();
+    if (node) {
+	workers_[v].tree->pop();
+	updateTop(v);
+    }
+    return node;
+}
+
+CoinTreeNode*
+CoinParallelSearchTreeManager::pop(int w)
+{
+    worker& me = workers_[w];
+/*
+  Every so often see whether a better node is waiting elsewhere.
+*/
+    bool check = false;
+    if (rebalanceFrequency_ > 0 && ++me.popsSinceCheck >= rebalanceFrequency_) {
+	me.popsSinceCheck = 0;
+	check = numberWorkers_ > 1;
+    }
+    if (check) {
+	lock(w);
+	const double own = me.topQuality;
+	const bool ownEmpty = me.tree->size() == 0;
+	unlock(w);
+	double best;
+	const int v = bestWorker(best);
+	if (v >= 0 && v != w &&
+	    (ownEmpty ||
+	     best < own - rebalanceTolerance_ * CoinMax(1.0, fabs(own)))) {
+	    lock(v);
+	    CoinTreeNode* node = take(v);
+	    unlock(v);
+	    if (node) {
+		lock(w);
+		++me.steals;
+		unlock(w);
+		return node;
+	    }
+	}
+    }
+/*
+  Own tree first.
+*/
+    lock(w);
+    CoinTreeNode* node = take(w);
+    unlock(w);
+    if (node)
+	return node;
+/*
+  Steal the best top, trying again if another worker got there first.
+*/
+    for (;;) {
+	double best;
+	const int v = bestWorker(best);
+	if (v < 0)
+	    return NULL;
+	lock(v);
+	node = take(v);
+	unlock(v);
+	if (node) {
+	    lock(w);
+	    ++me.steals;
+	    unlock(w);
+	    return node;
+	}
+    }
+}
+
+bool
+CoinParallelSearchTreeManager::empty() const
+{
+    return size() == 0;
+}
+
+size_t
+CoinParallelSearchTreeManager::size() const
+{
+    size_t n = 0;
+    for (int w = 0; w < numberWorkers_; ++w) {
+	lock(w);
+	n += workers_[w].tree->size();
+	unlock(w);
+    }
+    return n;
+}
+
+size_t
+CoinParallelSearchTreeManager::numInserted() const
+{
+    size_t n = 0;
+    for (int w = 0; w < numberWorkers_; ++w) {
+	lock(w);
+	n += workers_[w].tree->numInserted();
+	unlock(w);
+    }
+    return n;
+}
+
+double
+CoinParallelSearchTreeManager::bestQuality() const
+{
+    double best;
+    bestWorker(best);
+    return best;
+}
+
+int
+CoinParallelSearchTreeManager::numberSteals(int w) const
+{
+    lock(w);
+    const int n = workers_[w].steals;
+    unlock(w);
+    return n;
+}
+
+void
+CoinParallelSearchTreeManager::newSolution(double solValue)
+{
+    ++numSolution_;
+    double q = bestQuality();
+    if (q == COIN_DBL_MAX)
+	q = solValue;
+    const bool switchToDFS = fabs(q) < 1e-3 ?
+	(fabs(solValue) < 0.005) : ((solValue-q)/fabs(q) < 0.005);
+    if (!switchToDFS)
+	return;
+    for (int w = 0; w < numberWorkers_; ++w) {
+	lock(w);
+	CoinSearchTreeBase* t = workers_[w].tree;
+	if (dynamic_cast<CoinSearchTree<CoinSearchTreeCompareDepth>*>(t) == NULL) {
+	    workers_[w].tree = new CoinSearchTree<CoinSearchTreeCompareDepth>(*t);
+	    delete t;
+	    updateTop(w);
+	}
+	unlock(w);
+    }
+}
@@ -11,58 +11,67 @@
 #include <cmath>
 #include <string>
 
+#include "CoinUtilsConfig.h"
 #include "CoinFinite.hpp"
 #include "CoinHelperFunctions.hpp"
+#include "CoinBitVector.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
 
 // #define DEBUG_PRINT
 
+class CoinNodeStore;
+
 //#############################################################################
 
-class BitVector128 {
-  friend bool operator<(const BitVector128& b0, const BitVector128& b1);
-private:
-  unsigned int bits_[4];
-public:
-  BitVector128();
-  BitVector128(unsigned int bits[4]);
-  ~BitVector128() {}
-  void set(unsigned int bits[4]);
-  void setBit(int i);
-  void clearBit(int i);
-  std::string str() const;
-};
+typedef CoinBitVector<128> BitVector128;
 
-bool operator<(const BitVector128& b0, const BitVector128& b1);
+/** Bits in the preferred child encoding of CoinTreeNode - one per level of
+    the tree. Define COIN_TREE_PREFERRED_BITS (a multiple of 64) for trees
+    deeper than 128 levels, the same for CoinUtils and the code using it. */
+#ifndef COIN_TREE_PREFERRED_BITS
+#define COIN_TREE_PREFERRED_BITS 128
+#endif
+typedef CoinBitVector<COIN_TREE_PREFERRED_BITS> CoinTreePreferred;
 
 //#############################################################################
 
 /** A class from which the real tree nodes should be derived from. Some of the
     data that undoubtedly exist in the real tree node is replicated here for
-    fast access. This class is used in the various comparison functions. */
+    fast access. This class is used in the various comparison functions.
+
+    A derived node may support packing into a CoinNodeStore by overriding
+    packedSize(), pack() and unpack(). Only the description is packed; the
+    data here stay in memory. A copy of a node is never stored. */
 class CoinTreeNode {
+    friend class CoinNodeStore;
 protected:
     CoinTreeNode() :
 	depth_(-1),
 	fractionality_(-1),
 	quality_(-COIN_DBL_MAX),
 	true_lower_bound_(-COIN_DBL_MAX),
-	preferred_() {}
+	preferred_(),
+	storeHandle_(-1) {}
     CoinTreeNode(int d,
 		 int f = -1,
 		 double q = -COIN_DBL_MAX,
 		 double tlb = -COIN_DBL_MAX,
-		 BitVector128 p = BitVector128()) :
+		 CoinTreePreferred p = CoinTreePreferred()) :
 	depth_(d),
 	fractionality_(f),
 	quality_(q),
 	true_lower_bound_(tlb),
-	preferred_(p) {}
+	preferred_(p),
+	storeHandle_(-1) {}
     CoinTreeNode(const CoinTreeNode& x) :
 	depth_(x.depth_),
 	fractionality_(x.fractionality_),
 	quality_(x.quality_),
 	true_lower_bound_(x.true_lower_bound_),
-	preferred_(x.preferred_) {}
+	preferred_(x.preferred_),
+	storeHandle_(-1) {}
     CoinTreeNode& operator=(const CoinTreeNode& x) {
         if (this != &x) {
 	  depth_ = x.depth_;
@@ -88,21 +97,34 @@ private:
 	when column generation is done. */
     double true_lower_bound_;
     /** */
-    BitVector128 preferred_;
+    CoinTreePreferred preferred_;
+    /// Record in a CoinNodeStore holding the description (-1 if none)
+    int storeHandle_;
 public:
     virtual ~CoinTreeNode() {}
 
+    /** Bytes needed to pack the description, or -1 (the default) if the
+	node can't be packed */
+    virtual int packedSize() const { return -1; }
+    /** Write the description (packedSize() bytes) to \p data and free
+	it */
+    virtual void pack(char* /*data*/) {}
+    /// Rebuild the description from what pack() wrote
+    virtual void unpack(const char* /*data*/, int /*size*/) {}
+    /// True if the description is in a CoinNodeStore
+    inline bool isStored() const { return storeHandle_ >= 0; }
+
     inline int          getDepth()         const { return depth_; }
     inline int          getFractionality() const { return fractionality_; }
     inline double       getQuality()       const { return quality_; }
     inline double       getTrueLB()        const { return true_lower_bound_; }
-    inline BitVector128 getPreferred()     const { return preferred_; }
+    inline CoinTreePreferred getPreferred() const { return preferred_; }
     
     inline void setDepth(int d)              { depth_ = d; }
     inline void setFractionality(int f)      { fractionality_ = f; }
     inline void setQuality(double q)         { quality_ = q; }
     inline void setTrueLB(double tlb)        { true_lower_bound_ = tlb; }
-    inline void setPreferred(BitVector128 p) { preferred_ = p; }
+    inline void setPreferred(const CoinTreePreferred& p) { preferred_ = p; }
 };
 
 //==============================================================================
@@ -115,16 +137,20 @@ private:
     int current_;
     int numSiblings_;
     CoinTreeNode** siblings_;
+    /// Position in a CoinSearchTreeDary heap (-1 if not in one)
+    int heapPosition_;
 public:
     CoinTreeSiblings(const int n, CoinTreeNode** nodes) :
-	current_(0), numSiblings_(n), siblings_(new CoinTreeNode*[n])
+	current_(0), numSiblings_(n), siblings_(new CoinTreeNode*[n]),
+	heapPosition_(-1)
     {
 	CoinDisjointCopyN(nodes, n, siblings_);
     }
     CoinTreeSiblings(const CoinTreeSiblings& s) :
 	current_(s.current_),
 	numSiblings_(s.numSiblings_),
-	siblings_(new CoinTreeNode*[s.numSiblings_])
+	siblings_(new CoinTreeNode*[s.numSiblings_]),
+	heapPosition_(-1)
     {
 	CoinDisjointCopyN(s.siblings_, s.numSiblings_, siblings_);
     }
@@ -133,6 +159,12 @@ public:
     /** returns false if cannot be advanced */
     inline bool advanceNode() { return ++current_ != numSiblings_; }
     inline int toProcess() const { return numSiblings_ - current_; }
+    /// Sibling i (the current one is #current_)
+    inline CoinTreeNode* node(int i) const { return siblings_[i]; }
+    /// Index of the current sibling
+    inline int current() const { return current_; }
+    inline int heapPosition() const { return heapPosition_; }
+    inline void setHeapPosition(int i) { heapPosition_ = i; }
     inline int size() const { return numSiblings_; }
     inline void printPref() const {
       for (int i = 0; i < numSiblings_; ++i) {
@@ -146,7 +178,8 @@ public:
 
 /** Function objects to compare search tree nodes. The comparison function
     must return true if the first argument is "better" than the second one,
-    i.e., it should be processed first. */
+    i.e., it should be processed first. Those which order by a single number
+    also give it as key() (smaller is better), for CoinSearchTreeDary. */
 /*@{*/
 /** Depth First Search. */
 struct CoinSearchTreeComparePreferred {
@@ -155,8 +188,8 @@ struct CoinSearchTreeComparePreferred {
 			 const CoinTreeSiblings* y) const {
     register const CoinTreeNode* xNode = x->currentNode();
     register const CoinTreeNode* yNode = y->currentNode();
-    const BitVector128 xPref = xNode->getPreferred();
-    const BitVector128 yPref = yNode->getPreferred();
+    const CoinTreePreferred xPref = xNode->getPreferred();
+    const CoinTreePreferred yPref = yNode->getPreferred();
     bool retval = true;
     if (xPref < yPref) {
       retval = true;
@@ -177,6 +210,9 @@ struct CoinSearchTreeComparePreferred {
 /** Depth First Search. */
 struct CoinSearchTreeCompareDepth {
   static inline const char* name() { return "CoinSearchTreeCompareDepth"; }
+  static inline double key(const CoinTreeSiblings* x) {
+    return -x->currentNode()->getDepth();
+  }
   inline bool operator()(const CoinTreeSiblings* x,
 			 const CoinTreeSiblings* y) const {
 #if 1
@@ -196,6 +232,9 @@ struct CoinSearchTreeCompareDepth {
 /* Breadth First Search */
 struct CoinSearchTreeCompareBreadth {
   static inline const char* name() { return "CoinSearchTreeCompareBreadth"; }
+  static inline double key(const CoinTreeSiblings* x) {
+    return x->currentNode()->getDepth();
+  }
   inline bool operator()(const CoinTreeSiblings* x,
 			 const CoinTreeSiblings* y) const {
     return x->currentNode()->getDepth() < y->currentNode()->getDepth();
@@ -206,6 +245,9 @@ struct CoinSearchTreeCompareBreadth {
 /** Best first search */
 struct CoinSearchTreeCompareBest {
   static inline const char* name() { return "CoinSearchTreeCompareBest"; }
+  static inline double key(const CoinTreeSiblings* x) {
+    return x->currentNode()->getQuality();
+  }
   inline bool operator()(const CoinTreeSiblings* x,
 			 const CoinTreeSiblings* y) const {
     return x->currentNode()->getQuality() < y->currentNode()->getQuality();
@@ -224,13 +266,22 @@ protected:
     std::vector<CoinTreeSiblings*> candidateList_;
     int numInserted_;
     int size_;
+    /// Store for packed nodes (not owned, may be NULL)
+    CoinNodeStore* store_;
+    /// Number of nodes held before new ones are packed
+    int keepInMemory_;
 
 protected:
-    CoinSearchTreeBase() : candidateList_(), numInserted_(0), size_(0) {}
+    CoinSearchTreeBase() : candidateList_(), numInserted_(0), size_(0),
+			   store_(NULL), keepInMemory_(0) {}
 
     virtual void realpop() = 0;
     virtual void realpush(CoinTreeSiblings* s) = 0;
     virtual void fixTop() = 0;
+    /// Unpack the top node if it is stored
+    void unstoreTop() const;
+    /// Pack the nodes of s unless they are on top
+    void storeSiblings(CoinTreeSiblings* s);
 
 public:
     virtual ~CoinSearchTreeBase() {}
@@ -242,9 +293,22 @@ public:
     inline bool empty() const { return candidateList_.empty(); }
     inline int size() const { return size_; }
     inline int numInserted() const { return numInserted_; }
+
+    /** Pack the nodes pushed below the top into \p store once the tree
+	holds more than \p keepInMemory nodes; top() unpacks them. The store
+	is not owned. NULL (the default) keeps every node as it is. */
+    inline void setNodeStore(CoinNodeStore* store, int keepInMemory = 1000) {
+	store_ = store;
+	keepInMemory_ = keepInMemory;
+    }
+    inline CoinNodeStore* nodeStore() const { return store_; }
+    inline int keepInMemory() const { return keepInMemory_; }
+
     inline CoinTreeNode* top() const {
        if (size_ == 0 || candidateList_.size() == 0)
 	return NULL;
+       if (store_)
+	unstoreTop();
 #ifdef DEBUG_PRINT
       char output[44];
       output[43] = 0;
@@ -274,6 +338,8 @@ public:
 	    numInserted_ += numNodes;
 	}
 	size_ += numNodes;
+	if (store_ && size_ > keepInMemory_)
+	    storeSiblings(s);
     }
     inline void push(const CoinTreeSiblings& sib,
 		     const bool incrInserted = true) {
@@ -286,6 +352,8 @@ public:
 	    numInserted_ += sib.toProcess();
 	}
 	size_ += sib.toProcess();
+	if (store_ && size_ > keepInMemory_)
+	    storeSiblings(s);
     }
 };
 
@@ -320,6 +388,8 @@ public:
 	std::make_heap(candidateList_.begin(), candidateList_.end(), comp_);
 	numInserted_ = t.numInserted_;
 	size_ = t.size_;
+	store_ = t.nodeStore();
+	keepInMemory_ = t.keepInMemory();
     }
     ~CoinSearchTree() {}
     const char* compName() const { return Comp::name(); }
@@ -386,6 +456,8 @@ public:
 	std::sort(candidateList_.begin(), candidateList_.end(), comp_);
 	numInserted_ = t.numInserted();
 	size_ = t.size();
+	store_ = t.nodeStore();
+	keepInMemory_ = t.keepInMemory();
     }
     virtual ~CoinSearchTree() {}
     const char* compName() const { return Comp::name(); }
@@ -395,6 +467,123 @@ public:
 
 //#############################################################################
 
+/** A search tree kept as a D-ary heap on keys held beside the candidates.
+
+    CoinSearchTree calls its comparison on two CoinTreeSiblings, which
+    goes through the siblings to the current node for each compare. Here
+    the key of each candidate (Comp::key(), see CoinSearchTreeCompareBest)
+    is kept in #keys_, parallel to #candidateList_, so sifting reads
+    contiguous doubles. A 4-ary heap (the default) is half the depth of a
+    binary one and its children share a cache line.
+
+    The heap is addressable: each CoinTreeSiblings knows its position, so
+    after the quality of a candidate's current node changes, update() moves
+    it in O(log n); updateKeys() recomputes every key and rebuilds the heap
+    in O(n), for when many have changed.
+
+    Comp must have key(); CoinSearchTreeComparePreferred has none.
+*/
+template <class Comp, int D = 4>
+class CoinSearchTreeDary : public CoinSearchTreeBase
+{
+private:
+    std::vector<double> keys_;
+
+    inline void place(size_t i, CoinTreeSiblings* s, double key) {
+	candidateList_[i] = s;
+	keys_[i] = key;
+	s->setHeapPosition(static_cast<int>(i));
+    }
+    void siftUp(size_t i) {
+	CoinTreeSiblings* s = candidateList_[i];
+	const double key = keys_[i];
+	while (i > 0) {
+	    const size_t parent = (i-1)/D;
+	    if (!(key < keys_[parent]))
+		break;
+	    place(i, candidateList_[parent], keys_[parent]);
+	    i = parent;
+	}
+	place(i, s, key);
+    }
+    void siftDown(size_t i) {
+	const size_t size = keys_.size();
+	CoinTreeSiblings* s = candidateList_[i];
+	const double key = keys_[i];
+	for (;;) {
+	    const size_t first = D*i+1;
+	    if (first >= size)
+		break;
+	    const size_t last = CoinMin(first+D, size);
+	    size_t best = first;
+	    for (size_t ch = first+1; ch < last; ++ch) {
+		if (keys_[ch] < keys_[best])
+		    best = ch;
+	    }
+	    if (!(keys_[best] < key))
+		break;
+	    place(i, candidateList_[best], keys_[best]);
+	    i = best;
+	}
+	place(i, s, key);
+    }
+
+protected:
+    virtual void realpop() {
+	candidateList_.front()->setHeapPosition(-1);
+	const size_t last = keys_.size()-1;
+	if (last > 0)
+	    place(0, candidateList_[last], keys_[last]);
+	candidateList_.pop_back();
+	keys_.pop_back();
+	if (last > 1)
+	    siftDown(0);
+    }
+    virtual void fixTop() {
+	keys_[0] = Comp::key(candidateList_[0]);
+	siftDown(0);
+    }
+    virtual void realpush(CoinTreeSiblings* s) {
+	candidateList_.push_back(s);
+	keys_.push_back(Comp::key(s));
+	siftUp(keys_.size()-1);
+    }
+
+public:
+    CoinSearchTreeDary() : CoinSearchTreeBase(), keys_() {}
+    CoinSearchTreeDary(const CoinSearchTreeBase& t) :
+	CoinSearchTreeBase(), keys_() {
+	candidateList_ = t.getCandidates();
+	numInserted_ = t.numInserted();
+	size_ = t.size();
+	store_ = t.nodeStore();
+	keepInMemory_ = t.keepInMemory();
+	updateKeys();
+    }
+    virtual ~CoinSearchTreeDary() {}
+    const char* compName() const { return Comp::name(); }
+
+    /** The key of \p s, which must be in this tree, has changed (for
+	example the quality of its current node); move it. */
+    void update(CoinTreeSiblings* s) {
+	const size_t i = s->heapPosition();
+	keys_[i] = Comp::key(s);
+	siftUp(i);
+	siftDown(s->heapPosition());
+    }
+    /// Recompute every key and rebuild the heap
+    void updateKeys() {
+	const size_t size = candidateList_.size();
+	keys_.resize(size);
+	for (size_t i = 0; i < size; ++i)
+	    place(i, candidateList_[i], Comp::key(candidateList_[i]));
+	for (size_t i = size > 1 ? (size-2)/D+1 : 0; i-- > 0;)
+	    siftDown(i);
+    }
+};
+
+//#############################################################################
+
 enum CoinNodeAction {
     CoinAddNodeToCandidates,
     CoinTestNodeForDiving,
@@ -462,4 +651,128 @@ public:
 
 //#############################################################################
 
+/** A pool of search trees shared by several branch-and-bound workers.
+
+    Each worker has its own tree, behind its own lock, and pushes the
+    children it creates there. pop() takes the top node of the worker's
+    own tree; when that is empty it steals the top node of the tree whose
+    top is best, so no worker waits while there are open nodes anywhere.
+    Every #rebalanceFrequency_ pops a worker also compares its own top with
+    the best top in the pool, and takes the best one instead if its own is
+    worse by more than #rebalanceTolerance_ (relative), which keeps the
+    search as a whole close to best first.
+
+    Each worker index must be used by one thread at a time; any thread may
+    call the query methods. No lock is held while another is taken. Without
+    COINUTILS_PTHREADS the locks are left out and the pool is for one
+    thread, still useful for its rebalancing.
+
+    Qualities are as for CoinTreeNode: smaller is better. bestQuality()
+    is the best top quality over the trees, which is the bound of the
+    whole pool when each tree is best first (the default).
+*/
+class CoinParallelSearchTreeManager
+{
+private:
+    CoinParallelSearchTreeManager();
+    CoinParallelSearchTreeManager(const CoinParallelSearchTreeManager&);
+    CoinParallelSearchTreeManager&
+    operator=(const CoinParallelSearchTreeManager&);
+
+    /// State of one worker
+    struct worker {
+	CoinSearchTreeBase* tree;
+	/// Quality of the top node (COIN_DBL_MAX if empty)
+	double topQuality;
+	/// Pops since the last rebalancing check
+	int popsSinceCheck;
+	/// Nodes taken from other workers
+	int steals;
+#ifdef COINUTILS_PTHREADS
+	pthread_mutex_t mutex;
+#endif
+    };
+
+    int numberWorkers_;
+    worker* workers_;
+    int rebalanceFrequency_;
+    double rebalanceTolerance_;
+    int numSolution_;
+
+    inline void lock(int w) const {
+#ifdef COINUTILS_PTHREADS
+	pthread_mutex_lock(&workers_[w].mutex);
+#else
+	(void) w;
+#endif
+    }
+    inline void unlock(int w) const {
+#ifdef COINUTILS_PTHREADS
+	pthread_mutex_unlock(&workers_[w].mutex);
+#else
+	(void) w;
+#endif
+    }
+    /// Set topQuality of worker w (locked)
+    inline void updateTop(int w) {
+	const CoinTreeNode* node = workers_[w].tree->top();
+	workers_[w].topQuality = node ? node->getQuality() : COIN_DBL_MAX;
+    }
+    /// Worker whose top is best, or -1 if all are empty
+    int bestWorker(double& quality) const;
+    /// Take the top node of worker v, or NULL if it is empty (not locked)
+    CoinTreeNode* take(int v);
+
+public:
+    /** Creates \p numberWorkers trees, each
+	CoinSearchTree<CoinSearchTreeCompareBest>. */
+    explicit CoinParallelSearchTreeManager(int numberWorkers);
+    virtual ~CoinParallelSearchTreeManager();
+
+    inline int numberWorkers() const { return numberWorkers_; }
+    /** Replace the tree of worker w, which the pool then owns. Not to be
+	called while workers are running. */
+    void setTree(int w, CoinSearchTreeBase* t);
+    inline CoinSearchTreeBase* getTree(int w) const {
+	return workers_[w].tree;
+    }
+
+    /// Check against the best top every this many pops (0 never)
+    inline void setRebalanceFrequency(int value) {
+	rebalanceFrequency_ = value;
+    }
+    inline int rebalanceFrequency() const { return rebalanceFrequency_; }
+    /// Relative difference in quality which makes a worker rebalance
+    inline void setRebalanceTolerance(double value) {
+	rebalanceTolerance_ = value;
+    }
+    inline double rebalanceTolerance() const { return rebalanceTolerance_; }
+
+    void push(int w, CoinTreeNode* node, const bool incrInserted = true);
+    void push(int w, const CoinTreeSiblings& s,
+	      const bool incrInserted = true);
+    void push(int w, const int n, CoinTreeNode** nodes,
+	      const bool incrInserted = true);
+    /** Take the next node for worker w: its own top, the best top in the
+	pool when rebalancing, or a stolen one if its own tree is empty.
+	Returns NULL when the whole pool is empty; other workers may still
+	be processing nodes and push more, so the driver decides when the
+	search is over. */
+    CoinTreeNode* pop(int w);
+
+    bool empty() const;
+    size_t size() const;
+    size_t numInserted() const;
+    /// Best top quality over the pool (COIN_DBL_MAX if empty)
+    double bestQuality() const;
+    /// Nodes worker w has taken from other workers
+    int numberSteals(int w) const;
+
+    /** As CoinSearchTreeManager::newSolution, switching every tree to
+	depth first once the gap is small. */
+    void newSolution(double solValue);
+};
+
+//#############################################################################
+
 #endif
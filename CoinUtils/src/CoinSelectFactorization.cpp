@@ -0,0 +1,571 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cassert>
+#include "CoinPragma.hpp"
+#include "CoinSelectFactorization.hpp"
+#include "CoinFactorization.hpp"
+#include "CoinOslFactorization.hpp"
+#include "CoinSimpFactorization.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+
+//  CoinSelectFactorization.  Constructor
+CoinSelectFactorization::CoinSelectFactorization (  )
+  : CoinOtherFactorization(),
+    forced_(chooseAutomatic),
+    current_(chooseAutomatic),
+    coin_(NULL),
+    other_(NULL),
+    startColumn_(NULL),
+    counts_(NULL),
+    permutation_(NULL),
+    indexColumn_(NULL),
+    areaFactor_(0.0),
+    timeInCycle_(0.0),
+    solvesInCycle_(0),
+    measuredRows_(-1),
+    lastDenseFraction_(0.0),
+    denseRows_(400),
+    denseFraction_(0.2),
+    retryInterval_(20),
+    iteration_(0)
+{
+  // arrays of base class are not used
+  pivotRow_ = NULL;
+  elements_ = NULL;
+  workArea_ = NULL;
+  for (int i=0;i<4;i++) {
+    timePerSolve_[i] = 0.0;
+    sinceUsed_[i] = 0;
+  }
+}
+// Copy constructor
+CoinSelectFactorization::CoinSelectFactorization ( const CoinSelectFactorization &other)
+  : CoinOtherFactorization(other)
+{
+  pivotRow_ = NULL;
+  elements_ = NULL;
+  workArea_ = NULL;
+  gutsOfCopy(other);
+}
+// Destructor
+CoinSelectFactorization::~CoinSelectFactorization (  )
+{
+  gutsOfDestructor();
+}
+// = copy
+CoinSelectFactorization &
+CoinSelectFactorization::operator = ( const CoinSelectFactorization & other )
+{
+  if (this != &other) {
+    CoinOtherFactorization::operator=(other);
+    gutsOfDestructor();
+    gutsOfCopy(other);
+  }
+  return *this;
+}
+// Clone
+CoinOtherFactorization *
+CoinSelectFactorization::clone() const
+{
+  return new CoinSelectFactorization(*this);
+}
+// Frees arrays and factorizations
+void
+CoinSelectFactorization::gutsOfDestructor()
+{
+  delete coin_;
+  coin_ = NULL;
+  delete other_;
+  other_ = NULL;
+  delete [] startColumn_;
+  startColumn_ = NULL;
+  delete [] counts_;
+  counts_ = NULL;
+  delete [] permutation_;
+  permutation_ = NULL;
+  indexColumn_ = NULL;
+}
+// Copies rest of other
+void
+CoinSelectFactorization::gutsOfCopy(const CoinSelectFactorization &other)
+{
+  forced_ = other.forced_;
+  current_ = other.current_;
+  coin_ = other.coin_ ? new CoinFactorization(*other.coin_) : NULL;
+  other_ = other.other_ ? other.other_->clone() : NULL;
+  // arrays only exist between getAreas and factor for CoinFactorization
+  startColumn_ = CoinCopyOfArray(other.startColumn_, numberColumns_+1);
+  counts_ = CoinCopyOfArray(other.counts_, numberRows_+numberColumns_);
+  permutation_ = CoinCopyOfArray(other.permutation_, numberColumns_);
+  indexColumn_ = NULL;
+  areaFactor_ = other.areaFactor_;
+  for (int i=0;i<4;i++) {
+    timePerSolve_[i] = other.timePerSolve_[i];
+    sinceUsed_[i] = other.sinceUsed_[i];
+  }
+  timeInCycle_ = other.timeInCycle_;
+  solvesInCycle_ = other.solvesInCycle_;
+  measuredRows_ = other.measuredRows_;
+  lastDenseFraction_ = other.lastDenseFraction_;
+  denseRows_ = other.denseRows_;
+  denseFraction_ = other.denseFraction_;
+  retryInterval_ = other.retryInterval_;
+  iteration_ = other.iteration_;
+}
+// Decides what to use for next factorization
+CoinSelectFactorization::choice
+CoinSelectFactorization::chooseNext(int numberRows,
+				    CoinBigIndex numberElements) const
+{
+  if (numberRows<=denseRows_) {
+    double density = 1.0;
+    if (numberRows)
+      density = static_cast<double>(numberElements)/
+	(static_cast<double>(numberRows)*numberRows);
+    if (density>=denseFraction_||lastDenseFraction_>0.5)
+      return chooseDense;
+  }
+  // try each sparse one once, then faster (trying slower now and then)
+  if (!timePerSolve_[chooseCoin])
+    return chooseCoin;
+  if (!timePerSolve_[chooseOsl])
+    return chooseOsl;
+  choice faster = chooseCoin;
+  choice slower = chooseOsl;
+  if (timePerSolve_[chooseOsl]<timePerSolve_[chooseCoin]) {
+    faster = chooseOsl;
+    slower = chooseCoin;
+  }
+  if (sinceUsed_[slower]>=retryInterval_)
+    return slower;
+  return faster;
+}
+// Makes current_ factorization (deleting any other)
+void
+CoinSelectFactorization::makeCurrent(choice which)
+{
+  gutsOfDestructor();
+  current_ = which;
+  switch (which) {
+  case chooseCoin:
+    coin_ = new CoinFactorization();
+    break;
+  case chooseOsl:
+    other_ = new CoinOslFactorization();
+    break;
+  case chooseSimp:
+    other_ = new CoinSimpFactorization();
+    break;
+  case chooseDense:
+    other_ = new CoinDenseFactorization();
+    break;
+  default:
+    break;
+  }
+}
+// Adds time of cycle just finished to measurements
+void
+CoinSelectFactorization::endCycle()
+{
+  // a factorization which is redone stays in cycle
+  if (current_!=chooseAutomatic&&solvesInCycle_) {
+    double time = timeInCycle_/solvesInCycle_;
+    double & average = timePerSolve_[current_];
+    average = average ? 0.5*(average+time) : time;
+    timeInCycle_ = 0.0;
+    solvesInCycle_ = 0;
+  }
+  if (coin_&&!coin_->status()&&numberRows_)
+    lastDenseFraction_ =
+      static_cast<double>(coin_->numberDense())/numberRows_;
+}
+// Copies status etc from factorization in use
+void
+CoinSelectFactorization::copyStatus()
+{
+  if (coin_) {
+    status_ = coin_->status();
+    numberGoodU_ = coin_->numberGoodColumns();
+    numberPivots_ = coin_->pivots();
+  } else if (other_) {
+    status_ = other_->status();
+    numberGoodU_ = other_->numberGoodColumns();
+    numberPivots_ = other_->pivots();
+  }
+}
+// Gets space for a factorization - choosing which one first
+void
+CoinSelectFactorization::getAreas ( int numberRows,
+				    int numberColumns,
+				    CoinBigIndex maximumL,
+				    CoinBigIndex maximumU )
+{
+  endCycle();
+  if (numberRows!=measuredRows_) {
+    // new problem
+    measuredRows_ = numberRows;
+    lastDenseFraction_ = 0.0;
+    for (int i=0;i<4;i++) {
+      timePerSolve_[i] = 0.0;
+      sinceUsed_[i] = 0;
+    }
+  }
+  choice which = forced_;
+  if (which==chooseAutomatic)
+    which = chooseNext(numberRows, maximumL);
+  for (int i=0;i<4;i++)
+    sinceUsed_[i]++;
+  sinceUsed_[which] = 0;
+  if (which!=current_) {
+    makeCurrent(which);
+    timeInCycle_ = 0.0;
+    solvesInCycle_ = 0;
+    // new factorization has not seen iteration (Osl uses it to judge
+    // eta space)
+    if (other_)
+      other_->setUsefulInformation(&iteration_, 0);
+  }
+  numberRows_ = numberRows;
+  numberColumns_ = numberColumns;
+  numberPivots_ = 0;
+  status_ = -1;
+  if (coin_) {
+    coin_->pivotTolerance(pivotTolerance_);
+    coin_->zeroTolerance(zeroTolerance_);
+#ifndef COIN_FAST_CODE
+    coin_->slackValue(slackValue_);
+#endif
+    coin_->maximumPivots(maximumPivots_);
+    coin_->relaxAccuracyCheck(relaxCheck_);
+    delete [] startColumn_;
+    delete [] counts_;
+    delete [] permutation_;
+    startColumn_ = new CoinBigIndex [numberColumns+1];
+    counts_ = new int [numberRows+numberColumns];
+    permutation_ = new int [numberColumns];
+    // basis goes straight into triplet arrays
+    int * indexRow;
+    CoinFactorizationDouble * element;
+    coin_->factorizePart1(numberRows, numberColumns, maximumL,
+			  &indexRow, &indexColumn_, &element, areaFactor_);
+  } else {
+    other_->pivotTolerance(pivotTolerance_);
+    other_->zeroTolerance(zeroTolerance_);
+#ifndef COIN_FAST_CODE
+    other_->slackValue(slackValue_);
+#endif
+    other_->maximumPivots(maximumPivots_);
+    other_->relaxAccuracyCheck(relaxCheck_);
+    other_->getAreas(numberRows, numberColumns, maximumL, maximumU);
+  }
+}
+// PreProcesses column ordered copy of basis
+void
+CoinSelectFactorization::preProcess ( )
+{
+  // CoinFactorization does it in factor
+  if (other_)
+    other_->preProcess();
+}
+// Does most of factorization returning status
+int
+CoinSelectFactorization::factor ( )
+{
+  bool timing = forced_==chooseAutomatic;
+  double time = timing ? CoinMonotonicTime() : 0.0;
+  if (coin_) {
+    // column indices (and take out any gaps)
+    const int * numberInColumn = counts_+numberRows_;
+    int * indexRow = coin_->indexRowU();
+    CoinFactorizationDouble * element = coin_->elementU();
+    CoinBigIndex put = 0;
+    for (int iColumn=0;iColumn<numberColumns_;iColumn++) {
+      CoinBigIndex start = startColumn_[iColumn];
+      CoinBigIndex end = start+numberInColumn[iColumn];
+      for (CoinBigIndex j=start;j<end;j++) {
+	indexRow[put] = indexRow[j];
+	element[put] = element[j];
+	indexColumn_[put++] = iColumn;
+      }
+    }
+    int status = coin_->factorizePart2(permutation_, static_cast<int>(put));
+    if (status==-99)
+      areaFactor_ = 2.0*CoinMax(coin_->areaFactor(), 1.0);
+  } else {
+    other_->factor();
+  }
+  copyStatus();
+  if (timing)
+    timeInCycle_ += CoinMonotonicTime()-time;
+  return status_;
+}
+// Does post processing on valid factorization - putting variables on correct rows
+void
+CoinSelectFactorization::postProcess(const int * sequence, int * pivotVariable)
+{
+  if (coin_) {
+    for (int i=0;i<numberColumns_;i++)
+      pivotVariable[permutation_[i]] = sequence[i];
+  } else {
+    other_->postProcess(sequence, pivotVariable);
+  }
+}
+// Makes a non-singular basis by replacing variables
+void
+CoinSelectFactorization::makeNonSingular(int * sequence, int numberColumns)
+{
+  if (coin_) {
+    // Replace bad ones by slacks on rows without pivots
+    int * rowPivoted = counts_;
+    CoinFillN(rowPivoted, numberRows_, -1);
+    for (int i=0;i<numberColumns_;i++) {
+      if (permutation_[i]>=0)
+	rowPivoted[permutation_[i]] = i;
+    }
+    int iRow = 0;
+    for (int i=0;i<numberColumns_;i++) {
+      if (permutation_[i]<0) {
+	while (rowPivoted[iRow]>=0)
+	  iRow++;
+	assert (iRow<numberRows_);
+	sequence[i] = iRow+numberColumns;
+	rowPivoted[iRow] = i;
+      }
+    }
+  } else {
+    other_->makeNonSingular(sequence, numberColumns);
+  }
+}
+// Set maximum pivots
+void
+CoinSelectFactorization::maximumPivots (  int value )
+{
+  maximumPivots_ = value;
+  if (coin_)
+    coin_->maximumPivots(value);
+  else if (other_)
+    other_->maximumPivots(value);
+}
+// Returns array to put basis elements in
+CoinFactorizationDouble *
+CoinSelectFactorization::elements() const
+{
+  if (coin_)
+    return coin_->elementU();
+  return other_ ? other_->elements() : NULL;
+}
+// Returns pivot row
+int *
+CoinSelectFactorization::pivotRow() const
+{
+  return other_ ? other_->pivotRow() : NULL;
+}
+// Returns work area
+CoinFactorizationDouble *
+CoinSelectFactorization::workArea() const
+{
+  return other_ ? other_->workArea() : NULL;
+}
+// Returns int work area
+int *
+CoinSelectFactorization::intWorkArea() const
+{
+  return other_ ? other_->intWorkArea() : NULL;
+}
+// Number of entries in each row
+int *
+CoinSelectFactorization::numberInRow() const
+{
+  if (coin_)
+    return counts_;
+  return other_ ? other_->numberInRow() : NULL;
+}
+// Number of entries in each column
+int *
+CoinSelectFactorization::numberInColumn() const
+{
+  if (coin_)
+    return counts_+numberRows_;
+  return other_ ? other_->numberInColumn() : NULL;
+}
+// Returns array to put basis starts in
+CoinBigIndex *
+CoinSelectFactorization::starts() const
+{
+  if (coin_)
+    return startColumn_;
+  return other_ ? other_->starts() : NULL;
+}
+// Returns permute back
+int *
+CoinSelectFactorization::permuteBack() const
+{
+  if (coin_)
+    return coin_->permuteBack();
+  return other_ ? other_->permuteBack() : NULL;
+}
+// Returns true if wants tableauColumn in replaceColumn
+bool
+CoinSelectFactorization::wantsTableauColumn() const
+{
+  return other_ ? other_->wantsTableauColumn() : false;
+}
+// Useful information for factorization
+void
+CoinSelectFactorization::setUsefulInformation(const int * info,int whereFrom)
+{
+  iteration_ = info[0];
+  if (other_)
+    other_->setUsefulInformation(info, whereFrom);
+}
+// Get rid of all memory
+void
+CoinSelectFactorization::clearArrays()
+{
+  if (other_) {
+    other_->clearArrays();
+  } else if (coin_) {
+    makeCurrent(chooseCoin);
+  }
+}
+// Returns array to put basis indices in
+int *
+CoinSelectFactorization::indices() const
+{
+  if (coin_)
+    return coin_->indexRowU();
+  return other_ ? other_->indices() : NULL;
+}
+// Returns permute in
+int *
+CoinSelectFactorization::permute() const
+{
+  if (coin_)
+    return coin_->permute();
+  return other_ ? other_->permute() : NULL;
+}
+// Total number of elements in factorization
+int
+CoinSelectFactorization::numberElements (  ) const
+{
+  if (coin_)
+    return coin_->numberElements();
+  return other_ ? other_->numberElements() : 0;
+}
+// Number of nonzeros held in factors and updates
+CoinBigIndex
+CoinSelectFactorization::numberNonZeros (  ) const
+{
+  if (coin_)
+    return coin_->numberElements();
+  return other_ ? other_->numberNonZeros() : 0;
+}
+// Replaces one Column to basis
+int
+CoinSelectFactorization::replaceColumn ( CoinIndexedVector * regionSparse,
+					 int pivotRow,
+					 double pivotCheck ,
+					 bool checkBeforeModifying,
+					 double acceptablePivot)
+{
+  bool timing = forced_==chooseAutomatic;
+  double time = timing ? CoinMonotonicTime() : 0.0;
+  int returnCode;
+  if (coin_)
+    returnCode = coin_->replaceColumn(regionSparse, pivotRow, pivotCheck,
+				      checkBeforeModifying, acceptablePivot);
+  else
+    returnCode = other_->replaceColumn(regionSparse, pivotRow, pivotCheck,
+				       checkBeforeModifying, acceptablePivot);
+  numberPivots_ = coin_ ? coin_->pivots() : other_->pivots();
+  if (timing)
+    timeInCycle_ += CoinMonotonicTime()-time;
+  return returnCode;
+}
+// Updates one column (FTRAN) from regionSparse2
+int
+CoinSelectFactorization::updateColumnFT ( CoinIndexedVector * regionSparse,
+					  CoinIndexedVector * regionSparse2,
+					  bool noPermute)
+{
+  bool timing = forced_==chooseAutomatic;
+  double time = timing ? CoinMonotonicTime() : 0.0;
+  int returnCode;
+  if (coin_) {
+    assert (!noPermute);
+    returnCode = coin_->updateColumnFT(regionSparse, regionSparse2);
+  } else {
+    returnCode = other_->updateColumnFT(regionSparse, regionSparse2,
+					noPermute);
+  }
+  if (timing) {
+    timeInCycle_ += CoinMonotonicTime()-time;
+    solvesInCycle_++;
+  }
+  return returnCode;
+}
+// Updates one column (FTRAN) without FT update
+int
+CoinSelectFactorization::updateColumn ( CoinIndexedVector * regionSparse,
+					CoinIndexedVector * regionSparse2,
+					bool noPermute) const
+{
+  bool timing = forced_==chooseAutomatic;
+  double time = timing ? CoinMonotonicTime() : 0.0;
+  int returnCode;
+  if (coin_)
+    returnCode = coin_->updateColumn(regionSparse, regionSparse2, noPermute);
+  else
+    returnCode = other_->updateColumn(regionSparse, regionSparse2, noPermute);
+  if (timing) {
+    timeInCycle_ += CoinMonotonicTime()-time;
+    solvesInCycle_++;
+  }
+  return returnCode;
+}
+// does FTRAN on two columns
+int
+CoinSelectFactorization::updateTwoColumnsFT(CoinIndexedVector * regionSparse1,
+					    CoinIndexedVector * regionSparse2,
+					    CoinIndexedVector * regionSparse3,
+					    bool noPermute)
+{
+  bool timing = forced_==chooseAutomatic;
+  double time = timing ? CoinMonotonicTime() : 0.0;
+  int returnCode;
+  if (coin_)
+    returnCode = coin_->updateTwoColumnsFT(regionSparse1, regionSparse2,
+					   regionSparse3, noPermute);
+  else
+    returnCode = other_->updateTwoColumnsFT(regionSparse1, regionSparse2,
+					    regionSparse3, noPermute);
+  if (timing) {
+    timeInCycle_ += CoinMonotonicTime()-time;
+    solvesInCycle_ += 2;
+  }
+  return returnCode;
+}
+// Updates one column (BTRAN) from regionSparse2
+int
+CoinSelectFactorization::updateColumnTranspose ( CoinIndexedVector * regionSparse,
+						 CoinIndexedVector * regionSparse2) const
+{
+  bool timing = forced_==chooseAutomatic;
+  double time = timing ? CoinMonotonicTime() : 0.0;
+  int returnCode;
+  if (coin_)
+    returnCode = coin_->updateColumnTranspose(regionSparse, regionSparse2);
+  else
+    returnCode = other_->updateColumnTranspose(regionSparse, regionSparse2);
+  if (timing) {
+    timeInCycle_ += CoinMonotonicTime()-time;
+    solvesInCycle_++;
+  }
+  return returnCode;
+}
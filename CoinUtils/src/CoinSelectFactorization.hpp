@@ -0,0 +1,268 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinSelectFactorization_H
+#define CoinSelectFactorization_H
+
+#include "CoinTypes.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinDenseFactorization.hpp"
+
+class CoinFactorization;
+
+/** Chooses a factorization each time the basis is factorized
+
+    This looks like any CoinOtherFactorization - it is filled and used as
+    ClpFactorization does - but passes everything on to one of
+    CoinFactorization, CoinOslFactorization, CoinSimpFactorization or
+    CoinDenseFactorization.  The choice is made in getAreas, so can only
+    change at a refactorization, from the size and density of the basis,
+    how much of the last factorization went dense and the measured time per
+    solve of each sparse choice:
+
+    - bases with at most denseRows rows which are dense (density at least
+      denseFraction, or more than half of the last factorization dense) use
+      CoinDenseFactorization;
+    - otherwise CoinFactorization and CoinOslFactorization are each used for
+      one cycle (a factorization and the solves and updates up to the next)
+      and then the one with less time per solve.  The other is tried again
+      every retryInterval factorizations in case the basis has changed.
+
+    Measurements are forgotten when the number of rows changes.  A choice
+    can be forced with setChoice (CoinSimpFactorization is only used then).
+    Solves are timed with CoinMonotonicTime which is cheap but not free,
+    so when a choice is forced nothing is timed.
+*/
+class CoinSelectFactorization : public CoinOtherFactorization {
+public:
+  /// Factorizations which can be chosen
+  enum choice {
+    /// Choose each time
+    chooseAutomatic = -1,
+    /// CoinFactorization
+    chooseCoin = 0,
+    /// CoinOslFactorization
+    chooseOsl = 1,
+    /// CoinSimpFactorization
+    chooseSimp = 2,
+    /// CoinDenseFactorization
+    chooseDense = 3
+  };
+
+  /**@name Constructors and destructor and copy */
+  //@{
+  /// Default constructor
+  CoinSelectFactorization (  );
+  /// Copy constructor
+  CoinSelectFactorization ( const CoinSelectFactorization &other);
+  /// Destructor
+  virtual ~CoinSelectFactorization (  );
+  /// = copy
+  CoinSelectFactorization & operator = ( const CoinSelectFactorization & other );
+  /// Clone
+  virtual CoinOtherFactorization * clone() const ;
+  //@}
+
+  /**@name Policy */
+  //@{
+  /// Forced choice (chooseAutomatic if none)
+  inline choice forcedChoice() const
+  { return forced_;}
+  /// Forces a choice from next factorization (chooseAutomatic to choose)
+  inline void setChoice(choice value)
+  { forced_ = value;}
+  /// Factorization in use (chooseAutomatic before first factorization)
+  inline choice current() const
+  { return current_;}
+  /// Most rows for dense factorization (default 400)
+  inline int denseRows() const
+  { return denseRows_;}
+  inline void setDenseRows(int value)
+  { denseRows_ = value;}
+  /// Density of basis above which dense factorization is used (default 0.2)
+  inline double denseFraction() const
+  { return denseFraction_;}
+  inline void setDenseFraction(double value)
+  { denseFraction_ = value;}
+  /// Factorizations after which slower sparse choice is tried again (default 20)
+  inline int retryInterval() const
+  { return retryInterval_;}
+  inline void setRetryInterval(int value)
+  { retryInterval_ = value;}
+  /// Measured seconds per solve for a choice (0.0 if not measured)
+  inline double timePerSolve(choice which) const
+  { return timePerSolve_[which];}
+  /// The CoinFactorization (NULL unless current is chooseCoin)
+  inline const CoinFactorization * coinFactorization() const
+  { return coin_;}
+  /// The other factorization (NULL if current is chooseCoin)
+  inline const CoinOtherFactorization * otherFactorization() const
+  { return other_;}
+  //@}
+
+  /**@name Do factorization - public */
+  //@{
+  /// Gets space for a factorization - choosing which one first
+  virtual void getAreas ( int numberRows,
+		  int numberColumns,
+		  CoinBigIndex maximumL,
+		  CoinBigIndex maximumU );
+  /// PreProcesses column ordered copy of basis
+  virtual void preProcess ( );
+  /** Does most of factorization returning status
+      0 - OK
+      -99 - needs more memory
+      -1 - singular - use numberGoodColumns and redo
+  */
+  virtual int factor ( );
+  /// Does post processing on valid factorization - putting variables on correct rows
+  virtual void postProcess(const int * sequence, int * pivotVariable);
+  /// Makes a non-singular basis by replacing variables
+  virtual void makeNonSingular(int * sequence, int numberColumns);
+  //@}
+
+  /**@name general stuff such as number of elements */
+  //@{
+  /// Set maximum pivots
+  virtual void maximumPivots (  int value );
+  /// Returns array to put basis elements in
+  virtual CoinFactorizationDouble * elements() const;
+  /// Returns pivot row
+  virtual int * pivotRow() const;
+  /// Returns work area
+  virtual CoinFactorizationDouble * workArea() const;
+  /// Returns int work area
+  virtual int * intWorkArea() const;
+  /// Number of entries in each row
+  virtual int * numberInRow() const;
+  /// Number of entries in each column
+  virtual int * numberInColumn() const;
+  /// Returns array to put basis starts in
+  virtual CoinBigIndex * starts() const;
+  /// Returns permute back
+  virtual int * permuteBack() const;
+  /// Returns true if wants tableauColumn in replaceColumn
+  virtual bool wantsTableauColumn() const;
+  /// Useful information for factorization
+  virtual void setUsefulInformation(const int * info,int whereFrom);
+  /// Get rid of all memory
+  virtual void clearArrays();
+  /// Returns array to put basis indices in
+  virtual int * indices() const;
+  /// Returns permute in
+  virtual int * permute() const;
+  /// Total number of elements in factorization
+  virtual int numberElements (  ) const;
+  /// Number of nonzeros held in factors and updates
+  virtual CoinBigIndex numberNonZeros (  ) const;
+  //@}
+
+  /**@name rank one updates which do exist */
+  //@{
+  /** Replaces one Column to basis,
+   returns 0=OK, 1=Probably OK, 2=singular, 3=no room
+      If checkBeforeModifying is true will do all accuracy checks
+      before modifying factorization.  Whether to set this depends on
+      speed considerations.  You could just do this on first iteration
+      after factorization and thereafter re-factorize
+   partial update already in U */
+  virtual int replaceColumn ( CoinIndexedVector * regionSparse,
+		      int pivotRow,
+		      double pivotCheck ,
+		      bool checkBeforeModifying=false,
+		      double acceptablePivot=1.0e-8);
+  //@}
+
+  /**@name various uses of factorization (return code number elements)
+   which user may want to know about */
+  //@{
+  /** Updates one column (FTRAN) from regionSparse2
+      Tries to do FT update
+      number returned is negative if no room
+      regionSparse starts as zero and is zero at end.
+      Note - if regionSparse2 packed on input - will be packed on output
+  */
+  virtual int updateColumnFT ( CoinIndexedVector * regionSparse,
+			       CoinIndexedVector * regionSparse2,
+			       bool noPermute=false);
+  /** This version has same effect as above with FTUpdate==false
+      so number returned is always >=0 */
+  virtual int updateColumn ( CoinIndexedVector * regionSparse,
+		     CoinIndexedVector * regionSparse2,
+		     bool noPermute=false) const;
+  /// does FTRAN on two columns
+  virtual int updateTwoColumnsFT(CoinIndexedVector * regionSparse1,
+			 CoinIndexedVector * regionSparse2,
+			 CoinIndexedVector * regionSparse3,
+			 bool noPermute=false);
+  /** Updates one column (BTRAN) from regionSparse2
+      regionSparse starts as zero and is zero at end
+      Note - if regionSparse2 packed on input - will be packed on output
+  */
+  virtual int updateColumnTranspose ( CoinIndexedVector * regionSparse,
+			      CoinIndexedVector * regionSparse2) const;
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Decides what to use for next factorization
+  choice chooseNext(int numberRows, CoinBigIndex numberElements) const;
+  /// Makes current_ factorization (deleting any other)
+  void makeCurrent(choice which);
+  /// Adds time of cycle just finished to measurements
+  void endCycle();
+  /// Copies status etc from factorization in use
+  void copyStatus();
+  /// Frees arrays and factorizations
+  void gutsOfDestructor();
+  /// Copies rest of other
+  void gutsOfCopy(const CoinSelectFactorization &other);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Forced choice
+  choice forced_;
+  /// Factorization in use
+  choice current_;
+  /// CoinFactorization (if current_ is chooseCoin)
+  CoinFactorization * coin_;
+  /// Other factorization (if current_ is not chooseCoin)
+  CoinOtherFactorization * other_;
+  /// Column starts of basis for CoinFactorization
+  CoinBigIndex * startColumn_;
+  /// Counts in rows and columns of basis for CoinFactorization
+  int * counts_;
+  /// Pivot row of each basic column (-1 if none) for CoinFactorization
+  int * permutation_;
+  /// Column indices of triplets (owned by CoinFactorization)
+  int * indexColumn_;
+  /// Area factor for CoinFactorization (raised when out of memory)
+  double areaFactor_;
+  /// Seconds per solve for each choice (0.0 if not measured)
+  double timePerSolve_[4];
+  /// Factorizations since each choice was last used
+  int sinceUsed_[4];
+  /// Seconds in cycle so far
+  mutable double timeInCycle_;
+  /// Solves and updates in cycle so far
+  mutable int solvesInCycle_;
+  /// Rows when measurements were made
+  int measuredRows_;
+  /// Fraction of last factorization which was dense
+  double lastDenseFraction_;
+  /// Most rows for dense factorization
+  int denseRows_;
+  /// Density above which dense factorization is used
+  double denseFraction_;
+  /// Factorizations after which slower sparse choice is tried again
+  int retryInterval_;
+  /// Iteration last passed in setUsefulInformation (for new factorization)
+  int iteration_;
+  //@}
+};
+
+#endif
@@ -107,22 +107,16 @@ CoinShallowPackedVector::CoinShallowPackedVector(bool testForDuplicateIndex) :
 }
    
 //-------------------------------------------------------------------
-// Explicit
+// Duplicate test for inline constructors
 //-------------------------------------------------------------------
-CoinShallowPackedVector::CoinShallowPackedVector(int size, 
-					       const int * inds,
-					       const double * elems,
-					       bool testForDuplicateIndex) :
-   CoinPackedVectorBase(),
-   indices_(inds),
-   elements_(elems),
-   nElements_(size)
+void
+CoinShallowPackedVector::testDuplicates(const char * method) const
 {
    try {
-      CoinPackedVectorBase::setTestForDuplicateIndex(testForDuplicateIndex);
+      CoinPackedVectorBase::setTestForDuplicateIndex(true);
    }
    catch (CoinError& e) {
-      throw CoinError("duplicate index", "explicit constructor",
+      throw CoinError("duplicate index", method,
 		     "CoinShallowPackedVector");
    }
 }
@@ -146,26 +140,6 @@ CoinShallowPackedVector::CoinShallowPackedVector(const CoinPackedVectorBase& x)
    }
 }
 
-//-------------------------------------------------------------------
-// Copy
-//-------------------------------------------------------------------
-CoinShallowPackedVector::CoinShallowPackedVector(const
-					       CoinShallowPackedVector& x) :
-   CoinPackedVectorBase(),
-   indices_(x.getIndices()),
-   elements_(x.getElements()),
-   nElements_(x.getNumElements())
-{
-   CoinPackedVectorBase::copyMaxMinIndex(x);
-   try {
-      CoinPackedVectorBase::setTestForDuplicateIndex(x.testForDuplicateIndex());
-   }
-   catch (CoinError& e) {
-      throw CoinError("duplicate index", "copy constructor",
-		     "CoinShallowPackedVector");
-   }
-}
-
 //-------------------------------------------------------------------
 // Print
 //-------------------------------------------------------------------
@@ -13,6 +13,7 @@
 
 #include "CoinError.hpp"
 #include "CoinPackedVectorBase.hpp"
+#include "CoinPackedVectorSpan.hpp"
 
 /** Shallow Sparse Vector
  
@@ -84,6 +85,9 @@ public:
    virtual const int * getIndices() const { return indices_; }
    /// Get element values
    virtual const double * getElements() const { return elements_; }
+   /// Same vector as a span (for loops without virtual calls)
+   inline CoinPackedVectorSpan span() const
+   { return CoinPackedVectorSpan(nElements_, indices_, elements_); }
    //@}
 
    /**@name Set methods */
@@ -109,15 +113,37 @@ public:
        copied into this class instance. The ShallowPackedVector only maintains
        the pointers to the indices and elements vectors. <br>
        The last argument specifies whether the creator of the object knows in
-       advance that there are no duplicate indices.
+       advance that there are no duplicate indices.  Without the test this
+       is inline and only stores the pointers (as CoinPackedMatrix::getVector)
    */
-   CoinShallowPackedVector(int size,
+   inline CoinShallowPackedVector(int size,
 			  const int * indices, const double * elements,
-			  bool testForDuplicateIndex = true);
+			  bool testForDuplicateIndex = true) :
+      CoinPackedVectorBase(),
+      indices_(indices),
+      elements_(elements),
+      nElements_(size)
+   {
+      if (testForDuplicateIndex)
+	 testDuplicates("explicit constructor");
+      else
+	 setTestsOff();
+   }
    /** Copy constructor from the base class. */
    CoinShallowPackedVector(const CoinPackedVectorBase &);
    /** Copy constructor. */
-   CoinShallowPackedVector(const CoinShallowPackedVector &);
+   inline CoinShallowPackedVector(const CoinShallowPackedVector & x) :
+      CoinPackedVectorBase(),
+      indices_(x.indices_),
+      elements_(x.elements_),
+      nElements_(x.nElements_)
+   {
+      CoinPackedVectorBase::copyMaxMinIndex(x);
+      if (x.testForDuplicateIndex())
+	 testDuplicates("copy constructor");
+      else
+	 setTestsOff();
+   }
    /** Destructor. */
    virtual ~CoinShallowPackedVector() {}
    /// Print vector information.
@@ -125,6 +151,10 @@ public:
    //@}
 
 private:
+   /** Turns on duplicate index test and does it (throws CoinError naming
+       \p method if there are duplicates) */
+   void testDuplicates(const char * method) const;
+
    /**@name Private member data */
    //@{
    /// Vector indices
@@ -0,0 +1,401 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#if defined(_MSC_VER)
+// Turn off compiler warning about long names
+#  pragma warning(disable:4786)
+#endif
+
+#include "CoinUtilsConfig.h"
+
+#include <cstring>
+#include <cassert>
+
+#include "CoinSharedModel.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinFileIO.hpp"
+
+#if defined(HAVE_UNISTD_H) && defined(HAVE_SYS_STAT_H) && !defined(_MSC_VER)
+#define COIN_HAS_SHM
+#endif
+
+#ifdef COIN_HAS_SHM
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//#############################################################################
+// Layout is that of CoinMpsIO::writeBinary (version 1)
+//#############################################################################
+
+namespace {
+  const char sharedMagic[8] = {'C','O','I','N','B','I','N','\0'};
+  const int sharedHeaderSize = 128;
+  // Header as written by CoinMpsIO::writeBinary
+  typedef struct {
+    char magic[8];
+    int version;
+    int headerSize;
+    CoinInt64 numberRows;
+    CoinInt64 numberColumns;
+    CoinInt64 numberElements;
+    CoinInt64 nameBytes;
+    CoinInt64 flags;
+    double objectiveOffset;
+    double infinity;
+    CoinInt64 reserved[7];
+  } CoinSharedHeader;
+
+  inline size_t sharedPad(size_t bytes)
+  { return (bytes+7)&~static_cast<size_t>(7);}
+
+  /* Output into memory.  With no buffer it just counts.  The first
+     held bytes are kept back so a reader can not see the magic before
+     everything else is there */
+  class CoinMemoryOutput : public CoinFileOutput {
+  public:
+    CoinMemoryOutput(char * buffer, size_t size)
+      : CoinFileOutput("shared memory"),
+	buffer_(buffer), size_(size), position_(0)
+    { memset(held_,0,sizeof(held_));}
+    virtual int write(const void * data, int size)
+    {
+      const char * get = reinterpret_cast<const char *>(data);
+      if (buffer_) {
+	if (position_+size>size_)
+	  return 0;
+	size_t skip = 0;
+	while (position_+skip<sizeof(held_)&&skip<static_cast<size_t>(size)) {
+	  held_[position_+skip] = get[skip];
+	  skip++;
+	}
+	memcpy(buffer_+position_+skip,get+skip,size-skip);
+      }
+      position_ += size;
+      return size;
+    }
+    inline size_t position() const
+    { return position_;}
+    inline const char * held() const
+    { return held_;}
+  private:
+    char * buffer_;
+    size_t size_;
+    size_t position_;
+    char held_[8];
+  };
+
+  bool sharedLittleEndian()
+  {
+    int one = 1;
+    return *reinterpret_cast<char *>(&one)==1;
+  }
+}
+
+//#############################################################################
+
+int
+CoinSharedModel::publish(const char * name, const CoinMpsIO & model)
+{
+#ifdef COIN_HAS_SHM
+  // size
+  CoinMemoryOutput counter(NULL,0);
+  if (model.writeBinary(&counter))
+    return -1;
+  size_t size = counter.position();
+  // replace (attached processes keep old one)
+  shm_unlink(name);
+  int fd = shm_open(name,O_CREAT|O_EXCL|O_RDWR,0644);
+  if (fd<0)
+    return -1;
+  void * mapped = MAP_FAILED;
+  if (!ftruncate(fd,static_cast<off_t>(size)))
+    mapped = mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+  close(fd);
+  if (mapped==MAP_FAILED) {
+    shm_unlink(name);
+    return -1;
+  }
+  char * base = reinterpret_cast<char *>(mapped);
+  CoinMemoryOutput output(base,size);
+  int returnCode = model.writeBinary(&output);
+  if (!returnCode) {
+    // all there - now let readers see it
+    __sync_synchronize();
+    memcpy(base,output.held(),sizeof(sharedMagic));
+  }
+  munmap(mapped,size);
+  if (returnCode) {
+    shm_unlink(name);
+    return -1;
+  }
+  return 0;
+#else
+  return -1;
+#endif
+}
+
+int
+CoinSharedModel::unpublish(const char * name)
+{
+#ifdef COIN_HAS_SHM
+  return shm_unlink(name) ? -1 : 0;
+#else
+  return -1;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+int
+CoinSharedModel::attach(const char * name)
+{
+  detach();
+#ifdef COIN_HAS_SHM
+  int fd = shm_open(name,O_RDONLY,0);
+  if (fd<0)
+    return -1;
+  return gutsOfMap(fd,false);
+#else
+  return -1;
+#endif
+}
+
+int
+CoinSharedModel::attachFile(const char * filename, bool sequential)
+{
+  detach();
+#ifdef COIN_HAS_SHM
+  int fd = open(filename,O_RDONLY);
+  if (fd<0)
+    return -1;
+  return gutsOfMap(fd,sequential);
+#else
+  return -1;
+#endif
+}
+
+// Maps (and closes) fd then attaches - returns as attach
+int
+CoinSharedModel::gutsOfMap(int fd, bool sequential)
+{
+#ifdef COIN_HAS_SHM
+  struct stat statbuf;
+  void * mapped = MAP_FAILED;
+  if (!fstat(fd,&statbuf)&&statbuf.st_size>0) {
+    size_ = static_cast<size_t>(statbuf.st_size);
+    mapped = mmap(NULL,size_,PROT_READ,MAP_SHARED,fd,0);
+  }
+  close(fd);
+  if (mapped==MAP_FAILED) {
+    size_ = 0;
+    return -1;
+  }
+  base_ = reinterpret_cast<char *>(mapped);
+#ifdef MADV_SEQUENTIAL
+  // products sweep the arrays in order - read ahead and drop behind
+  if (sequential)
+    madvise(mapped,size_,MADV_SEQUENTIAL);
+#endif
+  if (!gutsOfAttach()) {
+    detach();
+    return -2;
+  }
+  return 0;
+#else
+  return -1;
+#endif
+}
+
+// Points arrays into mapping - returns false if segment not valid
+bool
+CoinSharedModel::gutsOfAttach()
+{
+  if (!sharedLittleEndian()||size_<static_cast<size_t>(sharedHeaderSize))
+    return false;
+  CoinSharedHeader header;
+  memcpy(&header,base_,sharedHeaderSize);
+  __sync_synchronize();
+  if (memcmp(header.magic,sharedMagic,8)||header.version!=1||
+      header.headerSize!=sharedHeaderSize)
+    return false;
+  if (header.numberRows<0||header.numberRows>COIN_INT_MAX||
+      header.numberColumns<0||header.numberColumns>COIN_INT_MAX||
+      header.numberElements<0||header.nameBytes<0)
+    return false;
+  numberRows_ = static_cast<int>(header.numberRows);
+  numberColumns_ = static_cast<int>(header.numberColumns);
+  size_t numberRows = numberRows_;
+  size_t numberColumns = numberColumns_;
+  size_t numberElements = static_cast<size_t>(header.numberElements);
+  size_t numberNames = 2+numberRows+numberColumns;
+  // work out where everything is and check it fits
+  size_t offset = sharedHeaderSize;
+  size_t startOffset = offset;
+  offset += sharedPad((numberColumns+1)*8);
+  size_t lengthOffset = offset;
+  offset += sharedPad(numberColumns*4);
+  size_t indexOffset = offset;
+  offset += sharedPad(numberElements*4);
+  size_t elementOffset = offset;
+  offset += numberElements*8;
+  size_t columnOffset = offset;
+  offset += 3*numberColumns*8;
+  size_t rowOffset = offset;
+  offset += 2*numberRows*8;
+  size_t integerOffset = offset;
+  if ((header.flags&1)!=0)
+    offset += sharedPad(numberColumns);
+  size_t nameOffset = offset;
+  if ((header.flags&2)!=0)
+    offset += (numberNames+1)*8+sharedPad(static_cast<size_t>(header.nameBytes));
+  if (offset>size_)
+    return false;
+  const CoinInt64 * start =
+    reinterpret_cast<const CoinInt64 *>(base_+startOffset);
+  if (start[numberColumns]!=header.numberElements)
+    return false;
+  const CoinBigIndex * useStart;
+  if (sizeof(CoinBigIndex)==sizeof(CoinInt64)) {
+    useStart = reinterpret_cast<const CoinBigIndex *>(start);
+  } else {
+    if (header.numberElements>COIN_INT_MAX)
+      return false;
+    start_ = new CoinBigIndex [numberColumns+1];
+    for (size_t i=0;i<=numberColumns;i++)
+      start_[i] = static_cast<CoinBigIndex>(start[i]);
+    useStart = start_;
+  }
+  matrix_.borrowMatrix(true,numberRows_,numberColumns_,
+		       static_cast<CoinBigIndex>(numberElements),
+		       reinterpret_cast<const double *>(base_+elementOffset),
+		       reinterpret_cast<const int *>(base_+indexOffset),
+		       useStart,
+		       reinterpret_cast<const int *>(base_+lengthOffset));
+  const double * column = reinterpret_cast<const double *>(base_+columnOffset);
+  colLower_ = column;
+  colUpper_ = column+numberColumns;
+  objective_ = column+2*numberColumns;
+  const double * row = reinterpret_cast<const double *>(base_+rowOffset);
+  rowLower_ = row;
+  rowUpper_ = row+numberRows;
+  if ((header.flags&1)!=0)
+    integerType_ = base_+integerOffset;
+  if ((header.flags&2)!=0) {
+    nameOffset_ = reinterpret_cast<const CoinInt64 *>(base_+nameOffset);
+    names_ = base_+nameOffset+(numberNames+1)*8;
+    if (nameOffset_[numberNames]!=header.nameBytes)
+      return false;
+  }
+  objectiveOffset_ = header.objectiveOffset;
+  infinity_ = header.infinity;
+  // snapshot borrows all it can
+  snapshot_.setNumCols(numberColumns_);
+  snapshot_.setNumRows(numberRows_);
+  snapshot_.setNumElements(static_cast<int>(numberElements));
+  snapshot_.setInfinity(infinity_);
+  snapshot_.setObjOffset(objectiveOffset_);
+  snapshot_.setColLower(colLower_,false);
+  snapshot_.setColUpper(colUpper_,false);
+  snapshot_.setRowLower(rowLower_,false);
+  snapshot_.setRowUpper(rowUpper_,false);
+  snapshot_.setObjCoefficients(objective_,false);
+  snapshot_.setMatrixByCol(&matrix_,false);
+  snapshot_.createRightHandSide();
+  char * colType = new char [numberColumns_];
+  int numberIntegers = 0;
+  for (int i=0;i<numberColumns_;i++) {
+    if (integerType_&&integerType_[i]) {
+      colType[i] = 'I';
+      numberIntegers++;
+    } else {
+      colType[i] = 'C';
+    }
+  }
+  snapshot_.setColType(colType,true);
+  snapshot_.setNumIntegers(numberIntegers);
+  delete [] colType;
+  return true;
+}
+
+void
+CoinSharedModel::detach()
+{
+  snapshot_ = CoinSnapshot();
+  matrix_ = CoinPackedMatrix();
+  delete [] start_;
+  start_ = NULL;
+#ifdef COIN_HAS_SHM
+  if (base_)
+    munmap(base_,size_);
+#endif
+  base_ = NULL;
+  size_ = 0;
+  numberRows_ = 0;
+  numberColumns_ = 0;
+  colLower_ = NULL;
+  colUpper_ = NULL;
+  objective_ = NULL;
+  rowLower_ = NULL;
+  rowUpper_ = NULL;
+  integerType_ = NULL;
+  nameOffset_ = NULL;
+  names_ = NULL;
+  objectiveOffset_ = 0.0;
+  infinity_ = COIN_DBL_MAX;
+}
+
+//-----------------------------------------------------------------------------
+
+const char *
+CoinSharedModel::problemName() const
+{
+  return names_ ? names_ : "";
+}
+
+const char *
+CoinSharedModel::rowName(int i) const
+{
+  if (!names_||i<0||i>=numberRows_)
+    return NULL;
+  return names_+nameOffset_[2+i];
+}
+
+const char *
+CoinSharedModel::columnName(int i) const
+{
+  if (!names_||i<0||i>=numberColumns_)
+    return NULL;
+  return names_+nameOffset_[2+numberRows_+i];
+}
+
+//#############################################################################
+
+CoinSharedModel::CoinSharedModel()
+  : base_(NULL),
+    size_(0),
+    numberRows_(0),
+    numberColumns_(0),
+    start_(NULL),
+    colLower_(NULL),
+    colUpper_(NULL),
+    objective_(NULL),
+    rowLower_(NULL),
+    rowUpper_(NULL),
+    integerType_(NULL),
+    nameOffset_(NULL),
+    names_(NULL),
+    objectiveOffset_(0.0),
+    infinity_(COIN_DBL_MAX)
+{
+}
+
+CoinSharedModel::~CoinSharedModel()
+{
+  detach();
+}
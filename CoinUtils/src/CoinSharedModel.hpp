@@ -0,0 +1,186 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinSharedModel_H
+#define CoinSharedModel_H
+
+#include "CoinTypes.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinSnapshot.hpp"
+
+class CoinMpsIO;
+
+/** A model in POSIX shared memory (or a file), attached read only with
+    no copy
+
+    publish() writes a model held in a CoinMpsIO into a named shared memory
+    segment, in the same layout as CoinMpsIO::writeBinary.  Any process on
+    the host can then attach() to the segment: the matrix, bounds,
+    objective and names are used where they lie in the mapping, so however
+    many processes attach there is one copy of the model in memory.  The
+    matrix is an ordinary const CoinPackedMatrix (whose arrays are
+    borrowed, see CoinPackedMatrix::borrowMatrix) and snapshot() gives the
+    model as a CoinSnapshot.
+
+    The segment is little-endian with 64 bit vector starts.  If
+    CoinBigIndex is narrower the starts are converted into an array of
+    this object (one entry per column); nothing else is copied.  A
+    publisher may publish a new model under the same name while old ones
+    are attached - they keep the segment they attached to until they
+    detach.  A segment is only seen (attach succeeds) once it is complete.
+
+    Bounds are as in the CoinMpsIO which published them; infinity() gives
+    the value it used for infinity.
+
+    attachFile maps a binary file instead, which gives a matrix whose
+    arrays live in the file (out of core).
+
+    Only available where POSIX shared memory is (otherwise publish and
+    attach return -1).  On older glibc shm_open needs -lrt.
+*/
+class CoinSharedModel {
+public:
+  /**@name Publishing */
+  //@{
+  /** Write model into shared memory segment \p name (which should start
+      with '/').  Any segment of that name is replaced.  Returns 0 if OK,
+      -1 if the segment could not be made */
+  static int publish(const char * name, const CoinMpsIO & model);
+  /** Remove segment \p name.  Processes attached to it are not affected.
+      Returns 0 if OK, -1 if there was no such segment */
+  static int unpublish(const char * name);
+  //@}
+
+  /**@name Attaching */
+  //@{
+  /** Attach to segment \p name, detaching from any current one.  Returns 0
+      if OK, -1 if there is no segment (or it can not be mapped) and -2 if
+      it is not (yet) a complete model */
+  int attach(const char * name);
+  /** Attach to a file written by CoinMpsIO::writeBinary, in the same way.
+      Nothing is read until it is used, so a model bigger than memory
+      works and cold parts stay on disk; processes mapping the same file
+      share it through the page cache.  If \p sequential the kernel is
+      told the mapping is swept in order (as by times and transposeTimes)
+      so reads ahead and drops pages behind.  Returns as attach */
+  int attachFile(const char * filename, bool sequential = true);
+  /// Unmap the segment (and forget the model)
+  void detach();
+  /// True if attached
+  inline bool isAttached() const
+  { return base_ != NULL;}
+  //@}
+
+  /**@name Model (all arrays are in the segment) */
+  //@{
+  /// Number of rows
+  inline int getNumRows() const
+  { return numberRows_;}
+  /// Number of columns
+  inline int getNumCols() const
+  { return numberColumns_;}
+  /// Number of elements
+  inline CoinBigIndex getNumElements() const
+  { return matrix_.getNumElements();}
+  /// Column ordered matrix
+  inline const CoinPackedMatrix * getMatrixByCol() const
+  { return &matrix_;}
+  /// Column lower bounds
+  inline const double * getColLower() const
+  { return colLower_;}
+  /// Column upper bounds
+  inline const double * getColUpper() const
+  { return colUpper_;}
+  /// Objective
+  inline const double * getObjCoefficients() const
+  { return objective_;}
+  /// Row lower bounds
+  inline const double * getRowLower() const
+  { return rowLower_;}
+  /// Row upper bounds
+  inline const double * getRowUpper() const
+  { return rowUpper_;}
+  /// Nonzero for integer columns (NULL if none are integer)
+  inline const char * integerType() const
+  { return integerType_;}
+  /// Objective offset (as CoinMpsIO::objectiveOffset)
+  inline double objectiveOffset() const
+  { return objectiveOffset_;}
+  /// Value used for infinity by the model which was published
+  inline double infinity() const
+  { return infinity_;}
+  /// Problem name ("" if no names)
+  const char * problemName() const;
+  /// Name of row i (NULL if no names)
+  const char * rowName(int i) const;
+  /// Name of column i (NULL if no names)
+  const char * columnName(int i) const;
+  /** Model as a snapshot.  Bounds, objective and matrix are borrowed from
+      the segment; right hand side and column types are made on attach */
+  inline const CoinSnapshot & snapshot() const
+  { return snapshot_;}
+  //@}
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor - not attached
+  CoinSharedModel();
+  /// Destructor (detaches)
+  ~CoinSharedModel();
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Maps (and closes) fd then attaches - returns as attach
+  int gutsOfMap(int fd, bool sequential);
+  /// Points arrays into mapping - returns false if segment not valid
+  bool gutsOfAttach();
+  /// Not implemented (a mapping has one owner)
+  CoinSharedModel(const CoinSharedModel &);
+  /// Not implemented
+  CoinSharedModel & operator=(const CoinSharedModel &);
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Start of mapping (NULL if not attached)
+  char * base_;
+  /// Size of mapping
+  size_t size_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Matrix (arrays borrowed)
+  CoinPackedMatrix matrix_;
+  /// Vector starts converted to CoinBigIndex (NULL if used in place)
+  CoinBigIndex * start_;
+  /// Column lower bounds
+  const double * colLower_;
+  /// Column upper bounds
+  const double * colUpper_;
+  /// Objective
+  const double * objective_;
+  /// Row lower bounds
+  const double * rowLower_;
+  /// Row upper bounds
+  const double * rowUpper_;
+  /// Integer markers
+  const char * integerType_;
+  /// Name offsets (problem, objective, rows, columns)
+  const CoinInt64 * nameOffset_;
+  /// Name characters
+  const char * names_;
+  /// Objective offset
+  double objectiveOffset_;
+  /// Infinity of published model
+  double infinity_;
+  /// Snapshot borrowing arrays
+  CoinSnapshot snapshot_;
+  //@}
+};
+
+#endif
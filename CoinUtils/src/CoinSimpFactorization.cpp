@@ -246,6 +246,11 @@ void CoinSimpFactorization::gutsOfInitialize()
   maximumSpace_=0;  
   numberSlacks_=0;
   firstNumberSlacks_=0;
+  swapTol_=10.0;
+  adaptiveRefactor_=true;
+  Usize_=0;
+  factorWork_=0.0;
+  updateWork_=0.0;
   elements_ = NULL;
   pivotRow_ = NULL;
   workArea_ = NULL;
@@ -328,6 +333,9 @@ void CoinSimpFactorization::initialSomeNumbers(){
     
     EtaSize_=0;
     lastEtaRow_=-1;
+    Usize_=0;
+    factorWork_=0.0;
+    updateWork_=0.0;
     //maxEtaRows_ in allocateSomeArrays
     //EtaMaxCap_ in allocateSomeArrays
         
@@ -414,6 +422,11 @@ void CoinSimpFactorization::gutsOfCopy(const CoinSimpFactorization &other)
   
   minIncrease_ = other.minIncrease_;
   updateTol_ = other.updateTol_;
+  swapTol_ = other.swapTol_;
+  adaptiveRefactor_ = other.adaptiveRefactor_;
+  Usize_ = other.Usize_;
+  factorWork_ = other.factorWork_;
+  updateWork_ = other.updateWork_;
 
 
 
@@ -835,6 +848,10 @@ CoinSimpFactorization::factor ( )
   copyUbyColumns();
   copyRowPermutations();  
   firstNumberSlacks_=numberSlacks_;
+  Usize_=0;
+  for ( int column=0; column<numberColumns_; ++column )
+      Usize_ += UcolLengths_[column];
+  factorWork_ += LcolSize_+Usize_;
   // row permutations
   if ( status_==-1 || numberColumns_ < numberRows_ ){
       for (int j=0;j<numberRows_;j++)
@@ -914,6 +931,13 @@ CoinSimpFactorization::replaceColumn ( CoinIndexedVector * ,
 {
     if (numberPivots_==maximumPivots_) 
 	return 3; 
+    // about three solves an iteration each going through L, U and etas
+    const double solveWork = 3.0*(LcolSize_+Usize_+EtaSize_+numberRows_);
+    // refactorize once this iteration would cost more than average so far
+    if ( adaptiveRefactor_ && numberPivots_ >= 10 &&
+	 solveWork*numberPivots_ > factorWork_+updateWork_ )
+	return 3;
+    updateWork_ += solveWork;
 
     double pivotValue = pivotCheck;
     if (fabs(pivotValue)<zeroTolerance_)
@@ -1413,6 +1437,8 @@ void CoinSimpFactorization::GaussEliminate(FactorPointers &pointers, int &pivotR
     const int pivColEnd=UcolStarts_[pivotCol]+UcolLengths_[pivotCol];
     UcolInd_[indxRowR]=UcolInd_[pivColEnd-1];
     --UcolLengths_[pivotCol];
+    // elimination work is about pivot column times pivot row
+    factorWork_ += UcolLengths_[pivotCol]*(rowEnd-rowBeg+1.0);
     // go through pivot row
     for ( int i=rowBeg; i<rowEnd; ++i ){
 	int column=UrowInd_[i];
@@ -2350,6 +2376,7 @@ int CoinSimpFactorization::LUupdate(int newBasicCol)
     // remove elements of new column of U
     const int colBeg=UcolStarts_[newBasicCol];
     const int colEnd=colBeg+UcolLengths_[newBasicCol];
+    Usize_ -= UcolLengths_[newBasicCol];
     for ( int i=colBeg; i<colEnd; ++i ){
 	const int row=UcolInd_[i];
 	const int colInRow=findInRow(row,newBasicCol);
@@ -2387,6 +2414,7 @@ int CoinSimpFactorization::LUupdate(int newBasicCol)
     memcpy(&UcolInd_[ UcolStarts_[newBasicCol] ], &indNewColumn[0],
 	   sizeNewColumn * sizeof(int) );
     UcolLengths_[newBasicCol]=sizeNewColumn;
+    Usize_ += sizeNewColumn;
  
 
     const int posNewCol=colPosition_[newBasicCol];
@@ -2430,16 +2458,34 @@ int CoinSimpFactorization::LUupdate(int newBasicCol)
 	Ucolumns_[indxRow]=Ucolumns_[colEnd-1];
 	--UcolLengths_[column];
     }
+    Usize_ -= UrowLengths_[rowInU];
     UrowLengths_[rowInU]=0;
     // rowInU is empty
     // increase Eta by (lastRowInU-posNewCol) elements
     newEta(rowInU, lastRowInU-posNewCol );
     assert(!EtaLengths_[lastEtaRow_]);
     int saveSize = EtaSize_;;
+    // row being eliminated - changes if rows interchanged
+    int spikeRow=rowInU;
     for ( int i=posNewCol; i<lastRowInU; ++i ){
-	const int row=secRowOfU_[i];
+	int row=secRowOfU_[i];
 	const int column=colOfU_[i];
 	if ( denseVector_[column]==0.0 ) continue;
+	if ( swapTol_ > 0.0 && i >= numberSlacks_ &&
+	     fabs(denseVector_[column]*invOfPivots_[row]) > swapTol_ ){
+	    // multiplier too big so spike row becomes pivot row here
+	    swapSpikeRow(i, spikeRow);
+	    // finish eta of old spike row and start one for new
+	    if (EtaSize_!=saveSize)
+		EtaLengths_[lastEtaRow_]=EtaSize_ - saveSize;
+	    else
+		--lastEtaRow_;
+	    newEta(row, lastRowInU-i );
+	    saveSize = EtaSize_;
+	    const int oldSpikeRow=spikeRow;
+	    spikeRow=row;
+	    row=oldSpikeRow;
+	}
 	register const double multiplier=denseVector_[column]*invOfPivots_[row];
 	denseVector_[column]=0.0;
 	const int rowBeg=UrowStarts_[row];
@@ -2465,8 +2511,13 @@ int CoinSimpFactorization::LUupdate(int newBasicCol)
       EtaLengths_[lastEtaRow_]=EtaSize_ - saveSize;
     else
       --lastEtaRow_;
+    if ( spikeRow != rowInU ){
+	secRowOfU_[lastRowInU]=spikeRow;
+	secRowPosition_[spikeRow]=lastRowInU;
+    }
+    const int rowInUnew=spikeRow;
     // inverse of diagonal
-    invOfPivots_[rowInU]=1.0/denseVector_[ colOfU_[lastRowInU] ];
+    invOfPivots_[rowInUnew]=1.0/denseVector_[ colOfU_[lastRowInU] ];
     denseVector_[ colOfU_[lastRowInU] ]=0.0;
     // now store row
     int newEls=0;
@@ -2481,28 +2532,92 @@ int CoinSimpFactorization::LUupdate(int newBasicCol)
 	}
 #endif 
 	const int newInd=UcolStarts_[column]+UcolLengths_[column];
-	UcolInd_[newInd]=rowInU;
+	UcolInd_[newInd]=rowInUnew;
 	Ucolumns_[newInd]=coeff;
 	++UcolLengths_[column];
 	workArea2_[newEls]=coeff;
 	indVector_[newEls++]=column;
     }
 #ifdef COIN_SIMP_CAPACITY
-    if ( UrowCapacities_[rowInU] < newEls )
-	increaseRowSize(rowInU, newEls);
+    if ( UrowCapacities_[rowInUnew] < newEls )
+	increaseRowSize(rowInUnew, newEls);
 #endif 
-    const int startRow=UrowStarts_[rowInU];
+    const int startRow=UrowStarts_[rowInUnew];
     memcpy(&Urows_[startRow],&workArea2_[0], newEls*sizeof(double) );
     memcpy(&UrowInd_[startRow],&indVector_[0], newEls*sizeof(int) );
-    UrowLengths_[rowInU]=newEls;
+    UrowLengths_[rowInUnew]=newEls;
+    Usize_ += newEls;
     //
-    if ( fabs( invOfPivots_[rowInU] ) > updateTol_ )
+    if ( fabs( invOfPivots_[rowInUnew] ) > updateTol_ )
 	return 2;
 
     return 0;
 }
 
 
+void CoinSimpFactorization::swapSpikeRow(const int position,
+					 const int spikeRow)
+{
+    // denseVector_ holds spikeRow reduced up to position, row of U
+    // at position becomes the spike and spikeRow takes its place
+    const int row=secRowOfU_[position];
+    const int pivotColumn=colOfU_[position];
+    const double pivot=denseVector_[pivotColumn];
+    denseVector_[pivotColumn]=0.0;
+    // pack rest of spike
+    int newEls=0;
+    for ( int i=position+1; i<numberColumns_; ++i ){
+	const int column=colOfU_[i];
+	const double coeff=denseVector_[column];
+	if ( coeff==0.0 ) continue;
+	denseVector_[column]=0.0;
+	if ( fabs(coeff) < zeroTolerance_ ) continue;
+	workArea2_[newEls]=coeff;
+	indVector_[newEls++]=column;
+    }
+    // old row into denseVector_ and out of column storage
+    const int rowBeg=UrowStarts_[row];
+    const int rowEnd=rowBeg+UrowLengths_[row];
+    for ( int i=rowBeg; i<rowEnd; ++i ){
+	const int column=UrowInd_[i];
+	denseVector_[column]=Urows_[i];
+	const int indxRow=findInColumn(column,row);
+	assert( indxRow >= 0 );
+	const int colEnd=UcolStarts_[column]+UcolLengths_[column];
+	UcolInd_[indxRow]=UcolInd_[colEnd-1];
+	Ucolumns_[indxRow]=Ucolumns_[colEnd-1];
+	--UcolLengths_[column];
+    }
+    Usize_ -= UrowLengths_[row];
+    UrowLengths_[row]=0;
+    denseVector_[pivotColumn]=1.0/invOfPivots_[row];
+    // spike row becomes row of U at position
+    invOfPivots_[spikeRow]=1.0/pivot;
+    for ( int i=0; i<newEls; ++i ){
+	const int column=indVector_[i];
+#ifdef COIN_SIMP_CAPACITY
+	if ( UcolLengths_[column] + 1 > UcolCapacities_[column] ){
+	    increaseColSize(column, UcolLengths_[column] + 1, true);
+	}
+#endif 
+	const int newInd=UcolStarts_[column]+UcolLengths_[column];
+	UcolInd_[newInd]=spikeRow;
+	Ucolumns_[newInd]=workArea2_[i];
+	++UcolLengths_[column];
+    }
+#ifdef COIN_SIMP_CAPACITY
+    if ( UrowCapacities_[spikeRow] < newEls )
+	increaseRowSize(spikeRow, newEls);
+#endif 
+    const int startRow=UrowStarts_[spikeRow];
+    memcpy(&Urows_[startRow],&workArea2_[0], newEls*sizeof(double) );
+    memcpy(&UrowInd_[startRow],&indVector_[0], newEls*sizeof(int) );
+    UrowLengths_[spikeRow]=newEls;
+    Usize_ += newEls;
+    secRowOfU_[position]=spikeRow;
+    secRowPosition_[spikeRow]=position;
+}
+
 void CoinSimpFactorization::newEta(int row, int numNewElements){
     if ( lastEtaRow_ == maxEtaRows_-1 ){
 	int *iaux=new int[maxEtaRows_ + minIncrease_];
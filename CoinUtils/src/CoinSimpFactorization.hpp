@@ -83,8 +83,25 @@ public:
   virtual inline int numberElements (  ) const {
     return numberRows_*(numberColumns_+numberPivots_);
   }
+  /// Number of nonzeros in L, U and etas
+  virtual inline CoinBigIndex numberNonZeros (  ) const {
+    return LcolSize_+Usize_+EtaSize_;
+  }
   /// Returns maximum absolute value in factorization
   double maximumCoefficient() const;
+  /** Multiplier above which LUupdate interchanges rows to keep
+      update stable (Bartels-Golub) - 0.0 never does */
+  inline double swapTolerance() const
+  { return swapTol_;}
+  inline void setSwapTolerance(double value)
+  { swapTol_=value;}
+  /** If true replaceColumn returns 3 (refactorize) once estimated
+      cost of solves since factorization is more than it would be
+      with a new factorization */
+  inline bool adaptiveRefactor() const
+  { return adaptiveRefactor_;}
+  inline void setAdaptiveRefactor(bool yes)
+  { adaptiveRefactor_=yes;}
   //@}
 
   /**@name rank one updates which do exist */
@@ -239,6 +256,8 @@ public:
     void xUeqb(double *b, double *sol) const;
     /// updates factorization after a Simplex iteration
     int LUupdate(int newBasicCol);
+    /// interchanges spike row in LUupdate with row at position in U
+    void swapSpikeRow(const int position, const int spikeRow);
     /// creates a new eta vector
     void newEta(int row, int numNewElements);
     /// makes a copy of row permutations
@@ -412,6 +431,16 @@ protected:
     int minIncrease_;
     /// maximum size for the diagonal of U after update
     double updateTol_;
+    /// multiplier above which LUupdate interchanges rows
+    double swapTol_;
+    /// refactorize when cheaper than carrying on
+    bool adaptiveRefactor_;
+    /// number of elements in U
+    int Usize_;
+    /// estimated work in last factorization
+    double factorWork_;
+    /// estimated work in solves since factorization
+    double updateWork_;
     /// do Shul heuristic
     bool doSuhlHeuristic_;
     /// maximum of U
@@ -13,6 +13,10 @@
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include "CoinTypes.hpp"
+#if COIN_HAS_MOVE
+#include <atomic>
+#endif
 
 namespace Coin {
 
@@ -160,10 +164,62 @@ namespace Coin {
 	virtual ~ReferencedObject()       { assert(reference_count_ == 0); }
 	inline int ReferenceCount() const { return reference_count_; }
 	inline void AddRef() const        { ++reference_count_; }
-	inline void ReleaseRef() const    { --reference_count_; }
+	/** Decrements the count and returns the new value */
+	inline int ReleaseRef() const     { return --reference_count_; }
+
+    private:
+	mutable int reference_count_;
+    };
+
+    //#########################################################################
+
+    /** ReferencedObject with an atomic reference count.
+     * SmartPtr's (or SharedPtr's) to an object derived from this class may
+     * be copied and destroyed in different threads at the same time; the
+     * last one to go deletes the object.  Only the count is protected: if
+     * the object itself is changed while shared the caller must still
+     * synchronize, so this is meant for objects which are read only once
+     * shared (a model or matrix handed to parallel workers, say).
+     *
+     * AddRef is a relaxed increment (a new reference can only be made from
+     * an existing one, so nothing need be ordered) and ReleaseRef an
+     * acquire-release decrement, so that all use of the object in other
+     * threads happens before it is deleted.  ReferenceCount is only a
+     * snapshot when other threads hold references.
+     */
+    class AtomicReferencedObject {
+    public:
+	AtomicReferencedObject() : reference_count_(0) {}
+	/** A copy is a new object with no references */
+	AtomicReferencedObject(const AtomicReferencedObject &)
+	  : reference_count_(0) {}
+	/** Assignment leaves the reference count alone */
+	AtomicReferencedObject & operator=(const AtomicReferencedObject &)
+	{ return *this; }
+	virtual ~AtomicReferencedObject() { assert(ReferenceCount() == 0); }
+#if COIN_HAS_MOVE
+	inline int ReferenceCount() const
+	{ return reference_count_.load(std::memory_order_relaxed); }
+	inline void AddRef() const
+	{ reference_count_.fetch_add(1, std::memory_order_relaxed); }
+	/** Decrements the count and returns the new value */
+	inline int ReleaseRef() const
+	{ return reference_count_.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+    private:
+	mutable std::atomic<int> reference_count_;
+#else
+	inline int ReferenceCount() const
+	{ return __atomic_load_n(&reference_count_, __ATOMIC_RELAXED); }
+	inline void AddRef() const
+	{ __atomic_fetch_add(&reference_count_, 1, __ATOMIC_RELAXED); }
+	/** Decrements the count and returns the new value */
+	inline int ReleaseRef() const
+	{ return __atomic_sub_fetch(&reference_count_, 1, __ATOMIC_ACQ_REL); }
 
     private:
 	mutable int reference_count_;
+#endif
     };
 
     //#########################################################################
@@ -347,8 +403,9 @@ namespace Coin {
 	/** Release the currently referenced object. */
 	void ReleasePointer_() {
 	    if (ptr_) {
-		ptr_->ReleaseRef();
-		if (ptr_->ReferenceCount() == 0) {
+		// use the count ReleaseRef gives - with an atomic count
+		// another thread may release between two calls
+		if (ptr_->ReleaseRef() == 0) {
 		    delete ptr_;
 		}
 		ptr_ = NULL;
@@ -358,11 +415,11 @@ namespace Coin {
 	/** Set the value of the internal raw pointer from another raw
 	 * pointer, releasing the previously referenced object if necessary. */
 	SmartPtr<T>& SetFromRawPtr_(T* rhs){
-	    ReleasePointer_(); // Release any old pointer
-	    if (rhs != NULL) {
+	    // add first in case rhs is the object held
+	    if (rhs != NULL)
 		rhs->AddRef();
-		ptr_ = rhs;
-	    }
+	    ReleasePointer_(); // Release any old pointer
+	    ptr_ = rhs;
 	    return *this;
 	}
 
@@ -483,6 +540,125 @@ namespace Coin {
 	return static_cast<const void*>(lhs) == static_cast<const void*>(rhs);
     }
 
+    //#########################################################################
+
+    /** Intrusive smart pointer for sharing read only objects between
+     * threads.
+     *
+     * T must derive from AtomicReferencedObject (this is checked when
+     * compiling).  Only const access is given, so once an object is held
+     * by SharedPtr's any number of threads may copy the pointers, read the
+     * object and drop their copies without locks or deep copies; the last
+     * pointer to go deletes the object.
+     *
+     * \verbatim
+     * class MyModel : public CoinAtomicReferencedObject { ... };
+     *
+     * CoinSharedPtr<MyModel> model(new MyModel(...));
+     * // each worker takes a copy of model (one increment)
+     * // and calls const methods through it
+     * \endverbatim
+     *
+     * Naming follows SmartPtr.  With C++11 a SharedPtr can be moved, which
+     * does not touch the count.
+     */
+    template <class T>
+    class SharedPtr {
+    public:
+	/**@name Constructors/Destructors */
+	//@{
+	/** Default constructor, initialized to NULL */
+	SharedPtr() : ptr_(NULL) {}
+	/** Constructor taking a reference to ptr (which may be NULL) */
+	explicit SharedPtr(const T* ptr) : ptr_(ptr) {
+	    const AtomicReferencedObject * base = ptr;
+	    if (base)
+		base->AddRef();
+	}
+	/** Copy constructor */
+	SharedPtr(const SharedPtr<T>& copy) : ptr_(copy.ptr_) {
+	    if (ptr_)
+		ptr_->AddRef();
+	}
+#if COIN_HAS_MOVE
+	/** Move constructor - copy is left NULL */
+	SharedPtr(SharedPtr<T>&& copy) COIN_NOEXCEPT : ptr_(copy.ptr_) {
+	    copy.ptr_ = NULL;
+	}
+#endif
+	/** Destructor, deletes the object if this is the last reference */
+	~SharedPtr() {
+	    Release_();
+	}
+	//@}
+
+	/**@name Access */
+	//@{
+	/** Returns the raw pointer (never delete it) */
+	const T* GetRawPtr() const { return ptr_; }
+	/** Returns true if not NULL */
+	bool IsValid() const { return ptr_ != NULL; }
+	/** Returns true if NULL */
+	bool IsNull() const { return ptr_ == NULL; }
+	/** Number of references (a snapshot if other threads share it) */
+	int ReferenceCount() const { return ptr_ ? ptr_->ReferenceCount() : 0; }
+	const T* operator->() const {
+	    assert(ptr_);
+	    return ptr_;
+	}
+	const T& operator*() const {
+	    assert(ptr_);
+	    return *ptr_;
+	}
+	//@}
+
+	/**@name Assignment */
+	//@{
+	SharedPtr<T>& operator=(const SharedPtr<T>& rhs) {
+	    SharedPtr<T> copy(rhs);
+	    Swap(copy);
+	    return *this;
+	}
+#if COIN_HAS_MOVE
+	SharedPtr<T>& operator=(SharedPtr<T>&& rhs) COIN_NOEXCEPT {
+	    Swap(rhs);
+	    return *this;
+	}
+#endif
+	/** Refer to ptr instead (releasing the object held) */
+	void Reset(const T* ptr = NULL) {
+	    SharedPtr<T> copy(ptr);
+	    Swap(copy);
+	}
+	/** Swap with rhs (no change to counts) */
+	void Swap(SharedPtr<T>& rhs) {
+	    const T* ptr = ptr_;
+	    ptr_ = rhs.ptr_;
+	    rhs.ptr_ = ptr;
+	}
+	//@}
+
+    private:
+	/** Drops the reference (deleting the object if it was the last) */
+	void Release_() {
+	    if (ptr_ && ptr_->ReleaseRef() == 0)
+		delete ptr_;
+	    ptr_ = NULL;
+	}
+	/** Object referenced */
+	const T* ptr_;
+    };
+
+    template <class U1, class U2>
+    bool operator==(const SharedPtr<U1>& lhs, const SharedPtr<U2>& rhs) {
+	return ComparePointers(lhs.GetRawPtr(), rhs.GetRawPtr());
+    }
+
+    template <class U1, class U2>
+    bool operator!=(const SharedPtr<U1>& lhs, const SharedPtr<U2>& rhs) {
+	return !ComparePointers(lhs.GetRawPtr(), rhs.GetRawPtr());
+    }
+
 } // namespace Coin
 
 //#############################################################################
@@ -524,5 +700,7 @@ bool operator!=(U1* raw_lhs, const Coin::SmartPtr<U2>& rhs) {
 #define CoinReferencedObject Coin::ReferencedObject
 #define CoinSmartPtr         Coin::SmartPtr
 #define CoinComparePointers  Coin::ComparePointers
+#define CoinAtomicReferencedObject Coin::AtomicReferencedObject
+#define CoinSharedPtr        Coin::SharedPtr
 
 #endif
@@ -9,6 +9,7 @@
 #include "CoinSnapshot.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinFinite.hpp"
+#include "CoinFingerprint.hpp"
 
 //#############################################################################
 // Constructors / Destructor / Assignment
@@ -51,6 +52,71 @@ CoinSnapshot::operator=(const CoinSnapshot& rhs)
   }
   return *this;
 }
+#if COIN_HAS_MOVE
+//-------------------------------------------------------------------
+// Move constructor 
+//-------------------------------------------------------------------
+CoinSnapshot::CoinSnapshot (CoinSnapshot && rhs) COIN_NOEXCEPT
+{
+  gutsOfDestructor(13);
+  swap(rhs);
+}
+
+//----------------------------------------------------------------
+// Move assignment operator 
+//-------------------------------------------------------------------
+CoinSnapshot &
+CoinSnapshot::operator=(CoinSnapshot&& rhs) COIN_NOEXCEPT
+{
+  swap(rhs);
+  return *this;
+}
+#endif
+// Exchange contents (no copying)
+void 
+CoinSnapshot::swap(CoinSnapshot & rhs)
+{
+  if (this == &rhs)
+    return;
+  std::swap(objSense_,rhs.objSense_);
+  std::swap(infinity_,rhs.infinity_);
+  std::swap(objValue_,rhs.objValue_);
+  std::swap(objOffset_,rhs.objOffset_);
+  std::swap(dualTolerance_,rhs.dualTolerance_);
+  std::swap(primalTolerance_,rhs.primalTolerance_);
+  std::swap(integerTolerance_,rhs.integerTolerance_);
+  std::swap(integerUpperBound_,rhs.integerUpperBound_);
+  std::swap(integerLowerBound_,rhs.integerLowerBound_);
+  std::swap(colLower_,rhs.colLower_);
+  std::swap(colUpper_,rhs.colUpper_);
+  std::swap(rowLower_,rhs.rowLower_);
+  std::swap(rowUpper_,rhs.rowUpper_);
+  std::swap(rightHandSide_,rhs.rightHandSide_);
+  std::swap(objCoefficients_,rhs.objCoefficients_);
+  std::swap(colType_,rhs.colType_);
+  std::swap(matrixByRow_,rhs.matrixByRow_);
+  std::swap(matrixByCol_,rhs.matrixByCol_);
+  std::swap(originalMatrixByRow_,rhs.originalMatrixByRow_);
+  std::swap(originalMatrixByCol_,rhs.originalMatrixByCol_);
+  std::swap(colSolution_,rhs.colSolution_);
+  std::swap(rowPrice_,rhs.rowPrice_);
+  std::swap(reducedCost_,rhs.reducedCost_);
+  std::swap(rowActivity_,rhs.rowActivity_);
+  std::swap(doNotSeparateThis_,rhs.doNotSeparateThis_);
+  std::swap(numCols_,rhs.numCols_);
+  std::swap(numRows_,rhs.numRows_);
+  std::swap(numElements_,rhs.numElements_);
+  std::swap(numIntegers_,rhs.numIntegers_);
+  std::swap(owned_,rhs.owned_);
+  std::swap(source_,rhs.source_);
+  std::swap(viewed_,rhs.viewed_);
+  std::swap(changeGeneration_,rhs.changeGeneration_);
+  for (int i=0;i<numberArrayTypes;i++) {
+    std::swap(generation_[i],rhs.generation_[i]);
+    std::swap(wholeChange_[i],rhs.wholeChange_[i]);
+    changeLog_[i].swap(rhs.changeLog_[i]);
+  }
+}
 // Does main work of destructor
 void 
 CoinSnapshot::gutsOfDestructor(int type)
@@ -95,6 +161,7 @@ CoinSnapshot::gutsOfDestructor(int type)
     dualTolerance_ = 1.0e-7;
     primalTolerance_ = 1.0e-7;
     integerTolerance_ = 1.0e-7;
+    changeGeneration_ = 0;
   }
   if ((type&8)!=0) {
     objValue_ = COIN_DBL_MAX;
@@ -125,6 +192,15 @@ CoinSnapshot::gutsOfDestructor(int type)
     numIntegers_ = 0;
     // say nothing owned
     memset(&owned_,0,sizeof(owned_));
+    source_ = NULL;
+    viewed_ = 0;
+    memset(generation_,0,sizeof(generation_));
+    // everything may have changed
+    changeGeneration_++;
+    for (int i=0;i<numberArrayTypes;i++) {
+      wholeChange_[i] = changeGeneration_;
+      changeLog_[i].clear();
+    }
   }
 }
 // Does main work of copy
@@ -145,6 +221,14 @@ CoinSnapshot::gutsOfCopy(const CoinSnapshot & rhs)
   numElements_ = rhs.numElements_;
   numIntegers_ = rhs.numIntegers_;
   owned_ = rhs.owned_;
+  source_ = rhs.source_;
+  viewed_ = rhs.viewed_;
+  memcpy(generation_,rhs.generation_,sizeof(generation_));
+  changeGeneration_ = rhs.changeGeneration_;
+  for (int i=0;i<numberArrayTypes;i++) {
+    wholeChange_[i] = rhs.wholeChange_[i];
+    changeLog_[i] = rhs.changeLog_[i];
+  }
   if (owned_.colLower)
     colLower_ = CoinCopyOfArray(rhs.colLower_,numCols_);
   else
@@ -246,6 +330,11 @@ CoinSnapshot::loadProblem(const CoinPackedMatrix& matrix,
   objCoefficients_ = CoinCopyOfArray(obj,numCols_,0.0);
   rowLower_ = CoinCopyOfArray(rowlb,numRows_,-infinity_);
   rowUpper_ = CoinCopyOfArray(rowub,numRows_,infinity_);
+  owned_.colLower = 1;
+  owned_.colUpper = 1;
+  owned_.objCoefficients = 1;
+  owned_.rowLower = 1;
+  owned_.rowUpper = 1;
   // do rhs as well
   createRightHandSide();
 }
@@ -256,6 +345,8 @@ CoinSnapshot::setColLower(const double * array, bool copyIn)
 {
   if (owned_.colLower)
     delete [] colLower_;
+  viewed_ &= ~(1u<<colLowerArray);
+  markChanged(colLowerArray);
   if (copyIn) {
     owned_.colLower=1;
     colLower_ = CoinCopyOfArray(array,numCols_);
@@ -270,6 +361,8 @@ CoinSnapshot::setColUpper(const double * array, bool copyIn)
 {
   if (owned_.colUpper)
     delete [] colUpper_;
+  viewed_ &= ~(1u<<colUpperArray);
+  markChanged(colUpperArray);
   if (copyIn) {
     owned_.colUpper=1;
     colUpper_ = CoinCopyOfArray(array,numCols_);
@@ -284,6 +377,8 @@ CoinSnapshot::setRowLower(const double * array, bool copyIn)
 {
   if (owned_.rowLower)
     delete [] rowLower_;
+  viewed_ &= ~(1u<<rowLowerArray);
+  markChanged(rowLowerArray);
   if (copyIn) {
     owned_.rowLower=1;
     rowLower_ = CoinCopyOfArray(array,numRows_);
@@ -298,6 +393,8 @@ CoinSnapshot::setRowUpper(const double * array, bool copyIn)
 {
   if (owned_.rowUpper)
     delete [] rowUpper_;
+  viewed_ &= ~(1u<<rowUpperArray);
+  markChanged(rowUpperArray);
   if (copyIn) {
     owned_.rowUpper=1;
     rowUpper_ = CoinCopyOfArray(array,numRows_);
@@ -318,6 +415,8 @@ CoinSnapshot::setRightHandSide(const double * array, bool copyIn)
 {
   if (owned_.rightHandSide)
     delete [] rightHandSide_;
+  viewed_ &= ~(1u<<rightHandSideArray);
+  markChanged(rightHandSideArray);
   if (copyIn) {
     owned_.rightHandSide=1;
     rightHandSide_ = CoinCopyOfArray(array,numRows_);
@@ -338,6 +437,8 @@ CoinSnapshot::createRightHandSide()
 {
   if (owned_.rightHandSide)
     delete [] rightHandSide_;
+  viewed_ &= ~(1u<<rightHandSideArray);
+  markChanged(rightHandSideArray);
   owned_.rightHandSide=1;
   assert (rowUpper_);
   assert (rowLower_);
@@ -354,6 +455,8 @@ CoinSnapshot::setObjCoefficients(const double * array, bool copyIn)
 {
   if (owned_.objCoefficients)
     delete [] objCoefficients_;
+  viewed_ &= ~(1u<<objCoefficientsArray);
+  markChanged(objCoefficientsArray);
   if (copyIn) {
     owned_.objCoefficients=1;
     objCoefficients_ = CoinCopyOfArray(array,numCols_);
@@ -368,6 +471,8 @@ CoinSnapshot::setColType(const char *array, bool copyIn)
 {
   if (owned_.colType)
     delete [] colType_;
+  viewed_ &= ~(1u<<colTypeArray);
+  markChanged(colTypeArray);
   if (copyIn) {
     owned_.colType=1;
     colType_ = CoinCopyOfArray(array,numCols_);
@@ -388,6 +493,8 @@ CoinSnapshot::setMatrixByRow(const CoinPackedMatrix * matrix, bool copyIn)
 {
   if (owned_.matrixByRow)
     delete matrixByRow_;
+  viewed_ &= ~(1u<<matrixByRowArray);
+  markChanged(matrixByRowArray);
   if (copyIn) {
     owned_.matrixByRow=1;
     matrixByRow_ = new CoinPackedMatrix(*matrix);
@@ -404,6 +511,8 @@ CoinSnapshot::createMatrixByRow()
 {
   if (owned_.matrixByRow)
     delete matrixByRow_;
+  viewed_ &= ~(1u<<matrixByRowArray);
+  markChanged(matrixByRowArray);
   assert (matrixByCol_);
   owned_.matrixByRow = 1;
   CoinPackedMatrix * matrixByRow = new CoinPackedMatrix(*matrixByCol_);
@@ -416,6 +525,8 @@ CoinSnapshot::setMatrixByCol(const CoinPackedMatrix * matrix, bool copyIn)
 {
   if (owned_.matrixByCol)
     delete matrixByCol_;
+  viewed_ &= ~(1u<<matrixByColArray);
+  markChanged(matrixByColArray);
   if (copyIn) {
     owned_.matrixByCol=1;
     matrixByCol_ = new CoinPackedMatrix(*matrix);
@@ -432,6 +543,8 @@ CoinSnapshot::setOriginalMatrixByRow(const CoinPackedMatrix * matrix, bool copyI
 {
   if (owned_.originalMatrixByRow)
     delete originalMatrixByRow_;
+  viewed_ &= ~(1u<<originalMatrixByRowArray);
+  markChanged(originalMatrixByRowArray);
   if (copyIn) {
     owned_.originalMatrixByRow=1;
     originalMatrixByRow_ = new CoinPackedMatrix(*matrix);
@@ -447,6 +560,8 @@ CoinSnapshot::setOriginalMatrixByCol(const CoinPackedMatrix * matrix, bool copyI
 {
   if (owned_.originalMatrixByCol)
     delete originalMatrixByCol_;
+  viewed_ &= ~(1u<<originalMatrixByColArray);
+  markChanged(originalMatrixByColArray);
   if (copyIn) {
     owned_.originalMatrixByCol=1;
     originalMatrixByCol_ = new CoinPackedMatrix(*matrix);
@@ -462,6 +577,8 @@ CoinSnapshot::setColSolution(const double * array, bool copyIn)
 {
   if (owned_.colSolution)
     delete [] colSolution_;
+  viewed_ &= ~(1u<<colSolutionArray);
+  markChanged(colSolutionArray);
   if (copyIn) {
     owned_.colSolution=1;
     colSolution_ = CoinCopyOfArray(array,numCols_);
@@ -476,6 +593,8 @@ CoinSnapshot::setRowPrice(const double * array, bool copyIn)
 {
   if (owned_.rowPrice)
     delete [] rowPrice_;
+  viewed_ &= ~(1u<<rowPriceArray);
+  markChanged(rowPriceArray);
   if (copyIn) {
     owned_.rowPrice=1;
     rowPrice_ = CoinCopyOfArray(array,numRows_);
@@ -490,6 +609,8 @@ CoinSnapshot::setReducedCost(const double * array, bool copyIn)
 {
   if (owned_.reducedCost)
     delete [] reducedCost_;
+  viewed_ &= ~(1u<<reducedCostArray);
+  markChanged(reducedCostArray);
   if (copyIn) {
     owned_.reducedCost=1;
     reducedCost_ = CoinCopyOfArray(array,numCols_);
@@ -504,6 +625,8 @@ CoinSnapshot::setRowActivity(const double * array, bool copyIn)
 {
   if (owned_.rowActivity)
     delete [] rowActivity_;
+  viewed_ &= ~(1u<<rowActivityArray);
+  markChanged(rowActivityArray);
   if (copyIn) {
     owned_.rowActivity=1;
     rowActivity_ = CoinCopyOfArray(array,numRows_);
@@ -518,6 +641,8 @@ CoinSnapshot::setDoNotSeparateThis(const double * array, bool copyIn)
 {
   if (owned_.doNotSeparateThis)
     delete [] doNotSeparateThis_;
+  viewed_ &= ~(1u<<doNotSeparateThisArray);
+  markChanged(doNotSeparateThisArray);
   if (copyIn) {
     owned_.doNotSeparateThis=1;
     doNotSeparateThis_ = CoinCopyOfArray(array,numCols_);
@@ -526,3 +651,380 @@ CoinSnapshot::setDoNotSeparateThis(const double * array, bool copyIn)
     doNotSeparateThis_ = array;
   }
 }
+// Point array which at source array (not owned)
+void 
+CoinSnapshot::borrowArray(int which)
+{
+  const arrayType type = static_cast<arrayType>(which);
+  const void * array = source_->getArray(type);
+  generation_[which] = source_->getGeneration(type);
+  viewed_ |= 1u<<which;
+  markChanged(which);
+  switch (type) {
+  case colLowerArray:
+    if (owned_.colLower)
+      delete [] colLower_;
+    owned_.colLower=0;
+    colLower_ = static_cast<const double *>(array);
+    break;
+  case colUpperArray:
+    if (owned_.colUpper)
+      delete [] colUpper_;
+    owned_.colUpper=0;
+    colUpper_ = static_cast<const double *>(array);
+    break;
+  case rowLowerArray:
+    if (owned_.rowLower)
+      delete [] rowLower_;
+    owned_.rowLower=0;
+    rowLower_ = static_cast<const double *>(array);
+    break;
+  case rowUpperArray:
+    if (owned_.rowUpper)
+      delete [] rowUpper_;
+    owned_.rowUpper=0;
+    rowUpper_ = static_cast<const double *>(array);
+    break;
+  case rightHandSideArray:
+    if (owned_.rightHandSide)
+      delete [] rightHandSide_;
+    owned_.rightHandSide=0;
+    rightHandSide_ = static_cast<const double *>(array);
+    break;
+  case objCoefficientsArray:
+    if (owned_.objCoefficients)
+      delete [] objCoefficients_;
+    owned_.objCoefficients=0;
+    objCoefficients_ = static_cast<const double *>(array);
+    break;
+  case colTypeArray:
+    if (owned_.colType)
+      delete [] colType_;
+    owned_.colType=0;
+    colType_ = static_cast<const char *>(array);
+    break;
+  case matrixByRowArray:
+    if (owned_.matrixByRow)
+      delete matrixByRow_;
+    owned_.matrixByRow=0;
+    matrixByRow_ = static_cast<const CoinPackedMatrix *>(array);
+    break;
+  case matrixByColArray:
+    if (owned_.matrixByCol)
+      delete matrixByCol_;
+    owned_.matrixByCol=0;
+    matrixByCol_ = static_cast<const CoinPackedMatrix *>(array);
+    break;
+  case originalMatrixByRowArray:
+    if (owned_.originalMatrixByRow)
+      delete originalMatrixByRow_;
+    owned_.originalMatrixByRow=0;
+    originalMatrixByRow_ = static_cast<const CoinPackedMatrix *>(array);
+    break;
+  case originalMatrixByColArray:
+    if (owned_.originalMatrixByCol)
+      delete originalMatrixByCol_;
+    owned_.originalMatrixByCol=0;
+    originalMatrixByCol_ = static_cast<const CoinPackedMatrix *>(array);
+    break;
+  case colSolutionArray:
+    if (owned_.colSolution)
+      delete [] colSolution_;
+    owned_.colSolution=0;
+    colSolution_ = static_cast<const double *>(array);
+    break;
+  case rowPriceArray:
+    if (owned_.rowPrice)
+      delete [] rowPrice_;
+    owned_.rowPrice=0;
+    rowPrice_ = static_cast<const double *>(array);
+    break;
+  case reducedCostArray:
+    if (owned_.reducedCost)
+      delete [] reducedCost_;
+    owned_.reducedCost=0;
+    reducedCost_ = static_cast<const double *>(array);
+    break;
+  case rowActivityArray:
+    if (owned_.rowActivity)
+      delete [] rowActivity_;
+    owned_.rowActivity=0;
+    rowActivity_ = static_cast<const double *>(array);
+    break;
+  case doNotSeparateThisArray:
+    if (owned_.doNotSeparateThis)
+      delete [] doNotSeparateThis_;
+    owned_.doNotSeparateThis=0;
+    doNotSeparateThis_ = static_cast<const double *>(array);
+    break;
+  default:
+    break;
+  }
+}
+// Rebuild owned right hand side and integer count after a view change
+void 
+CoinSnapshot::derivedFromView(unsigned int changed)
+{
+  if ((changed&((1u<<matrixByColArray)|(1u<<matrixByRowArray)))!=0) {
+    if (matrixByCol_)
+      numElements_ = matrixByCol_->getNumElements();
+    else if (matrixByRow_)
+      numElements_ = matrixByRow_->getNumElements();
+  }
+  if ((changed&((1u<<rowLowerArray)|(1u<<rowUpperArray)|(1u<<rightHandSideArray)))!=0 &&
+      (!rightHandSide_||owned_.rightHandSide) && rowLower_ && rowUpper_)
+    createRightHandSide();
+  if ((changed&(1u<<colTypeArray))!=0) {
+    numIntegers_=0;
+    if (colType_) {
+      for (int i=0;i<numCols_;i++) {
+	if (colType_[i]=='B'||colType_[i]=='I')
+	  numIntegers_++;
+      }
+    }
+  }
+}
+/* Borrow all arrays from source.  Scalars are kept.  If the source has no
+   right hand side but has row bounds, one is created (and owned).
+*/
+void 
+CoinSnapshot::setView(const CoinSnapshotSource * source)
+{
+  gutsOfDestructor(3);
+  source_ = source;
+  numRows_ = source->getNumRows();
+  numCols_ = source->getNumCols();
+  for (int i=0;i<numberArrayTypes;i++)
+    borrowArray(i);
+  derivedFromView((1u<<numberArrayTypes)-1);
+}
+/* Re-point borrowed arrays whose generation has changed.  Returns number
+   re-pointed.
+*/
+int 
+CoinSnapshot::refresh()
+{
+  if (!source_)
+    return 0;
+  numRows_ = source_->getNumRows();
+  numCols_ = source_->getNumCols();
+  unsigned int changed=0;
+  int numberChanged=0;
+  for (int i=0;i<numberArrayTypes;i++) {
+    if ((viewed_&(1u<<i))!=0 &&
+	source_->getGeneration(static_cast<arrayType>(i))!=generation_[i]) {
+      borrowArray(i);
+      changed |= 1u<<i;
+      numberChanged++;
+    }
+  }
+  if (changed)
+    derivedFromView(changed);
+  return numberChanged;
+}
+// True unless a borrowed array has changed generation
+bool 
+CoinSnapshot::isValid() const
+{
+  for (int i=0;i<numberArrayTypes;i++) {
+    if ((viewed_&(1u<<i))!=0 &&
+	source_->getGeneration(static_cast<arrayType>(i))!=generation_[i])
+      return false;
+  }
+  return true;
+}
+// Record that all of array which may have changed
+void 
+CoinSnapshot::markChanged(int which)
+{
+  wholeChange_[which] = ++changeGeneration_;
+  changeLog_[which].clear();
+}
+// True if array which has changed since generation
+bool 
+CoinSnapshot::changedSince(arrayType which, unsigned int generation) const
+{
+  return wholeChange_[which]>generation ||
+    (!changeLog_[which].empty()&&changeLog_[which].back().first>generation);
+}
+/* Entries of array which changed since generation.  Returns the number, or
+   -1 if the whole array may have changed.
+*/
+int 
+CoinSnapshot::getChangedEntries(arrayType which, unsigned int generation,
+				int * whichEntries) const
+{
+  if (wholeChange_[which]>generation)
+    return -1;
+  const std::vector<std::pair<unsigned int,int> > & log = changeLog_[which];
+  int number=0;
+  for (int i=static_cast<int>(log.size())-1;i>=0&&log[i].first>generation;i--)
+    whichEntries[number++] = log[i].second;
+  return number;
+}
+// Owned, writable copy of a double array (copied if borrowed)
+double * 
+CoinSnapshot::writableArray(arrayType which)
+{
+  const double ** array = NULL;
+  unsigned int owned = 0;
+  int length = numCols_;
+  switch (which) {
+  case colLowerArray:
+    array = &colLower_;
+    owned = owned_.colLower;
+    owned_.colLower = 1;
+    break;
+  case colUpperArray:
+    array = &colUpper_;
+    owned = owned_.colUpper;
+    owned_.colUpper = 1;
+    break;
+  case rowLowerArray:
+    array = &rowLower_;
+    owned = owned_.rowLower;
+    owned_.rowLower = 1;
+    length = numRows_;
+    break;
+  case rowUpperArray:
+    array = &rowUpper_;
+    owned = owned_.rowUpper;
+    owned_.rowUpper = 1;
+    length = numRows_;
+    break;
+  case rightHandSideArray:
+    array = &rightHandSide_;
+    owned = owned_.rightHandSide;
+    owned_.rightHandSide = 1;
+    length = numRows_;
+    break;
+  case colSolutionArray:
+    array = &colSolution_;
+    owned = owned_.colSolution;
+    owned_.colSolution = 1;
+    break;
+  case rowPriceArray:
+    array = &rowPrice_;
+    owned = owned_.rowPrice;
+    owned_.rowPrice = 1;
+    length = numRows_;
+    break;
+  case reducedCostArray:
+    array = &reducedCost_;
+    owned = owned_.reducedCost;
+    owned_.reducedCost = 1;
+    break;
+  case rowActivityArray:
+    array = &rowActivity_;
+    owned = owned_.rowActivity;
+    owned_.rowActivity = 1;
+    length = numRows_;
+    break;
+  default:
+    abort();
+  }
+  viewed_ &= ~(1u<<which);
+  assert (*array);
+  if (!owned)
+    *array = CoinCopyOfArray(*array,length);
+  return const_cast<double *>(*array);
+}
+/* Does work of update methods.  The log is dropped (and the whole array
+   marked) once it holds more entries than a quarter of the array.
+*/
+void 
+CoinSnapshot::updateArray(arrayType which, int number, const int * whichEntries,
+			  const double * values)
+{
+  double * array = writableArray(which);
+  const bool isRow = (which==rowLowerArray||which==rowUpperArray||
+		      which==rowPriceArray||which==rowActivityArray);
+  const int length = isRow ? numRows_ : numCols_;
+  for (int i=0;i<number;i++)
+    array[whichEntries[i]] = values[i];
+  std::vector<std::pair<unsigned int,int> > & log = changeLog_[which];
+  if (static_cast<int>(log.size())+number>(length>>2)) {
+    markChanged(which);
+  } else {
+    changeGeneration_++;
+    for (int i=0;i<number;i++)
+      log.push_back(std::make_pair(changeGeneration_,whichEntries[i]));
+  }
+  if ((which==rowLowerArray||which==rowUpperArray)&&rightHandSide_) {
+    double * rightHandSide = writableArray(rightHandSideArray);
+    for (int i=0;i<number;i++) {
+      int iRow = whichEntries[i];
+      rightHandSide[iRow] = (rowUpper_[iRow]!=infinity_) ?
+	rowUpper_[iRow] : rowLower_[iRow];
+    }
+    std::vector<std::pair<unsigned int,int> > & rhsLog =
+      changeLog_[rightHandSideArray];
+    if (static_cast<int>(rhsLog.size())+number>(numRows_>>2)) {
+      markChanged(rightHandSideArray);
+    } else {
+      for (int i=0;i<number;i++)
+	rhsLog.push_back(std::make_pair(changeGeneration_,whichEntries[i]));
+    }
+  }
+}
+void 
+CoinSnapshot::updateColLower(int number, const int * which, const double * values)
+{
+  updateArray(colLowerArray,number,which,values);
+}
+void 
+CoinSnapshot::updateColUpper(int number, const int * which, const double * values)
+{
+  updateArray(colUpperArray,number,which,values);
+}
+void 
+CoinSnapshot::updateRowLower(int number, const int * which, const double * values)
+{
+  updateArray(rowLowerArray,number,which,values);
+}
+void 
+CoinSnapshot::updateRowUpper(int number, const int * which, const double * values)
+{
+  updateArray(rowUpperArray,number,which,values);
+}
+void 
+CoinSnapshot::updateColSolution(int number, const int * which, const double * values)
+{
+  updateArray(colSolutionArray,number,which,values);
+}
+void 
+CoinSnapshot::updateRowPrice(int number, const int * which, const double * values)
+{
+  updateArray(rowPriceArray,number,which,values);
+}
+void 
+CoinSnapshot::updateReducedCost(int number, const int * which, const double * values)
+{
+  updateArray(reducedCostArray,number,which,values);
+}
+void 
+CoinSnapshot::updateRowActivity(int number, const int * which, const double * values)
+{
+  updateArray(rowActivityArray,number,which,values);
+}
+// Fingerprint of matrix, bounds, objective and integer columns
+CoinFingerprint 
+CoinSnapshot::fingerprint(int numberThreads) const
+{
+  CoinFingerprint result;
+  const CoinPackedMatrix * matrix = matrixByCol_ ? matrixByCol_ : matrixByRow_;
+  if (matrix)
+    result.addMatrix(*matrix,true,numberThreads);
+  else
+    result.addDimensions(numRows_,numCols_);
+  result.addModelArrays(numRows_,numCols_,colLower_,colUpper_,
+			objCoefficients_,rowLower_,rowUpper_);
+  if (colType_) {
+    char * isInteger = new char [numCols_];
+    for (int i=0;i<numCols_;i++)
+      isInteger[i] = (colType_[i]=='B'||colType_[i]=='I') ? 1 : 0;
+    result.addIntegers(numCols_,isInteger);
+    delete [] isInteger;
+  }
+  return result;
+}
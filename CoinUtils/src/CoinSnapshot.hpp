@@ -7,7 +7,10 @@
 #define CoinSnapshot_H
 
 class CoinPackedMatrix;
+class CoinSnapshotSource;
+#include <vector>
 #include "CoinTypes.hpp"
+#include "CoinFingerprint.hpp"
 
 //#############################################################################
 
@@ -16,6 +19,11 @@ class CoinPackedMatrix;
     
   The class may or may not own the arrays - see owned_
 
+  In view mode (setView) the snapshot borrows every array a
+  CoinSnapshotSource offers and remembers its generation. A solver which
+  bumps the generation of an array whenever it moves or changes it lets
+  refresh() re-point only those arrays, and isValid() tell whether a
+  borrowed array has changed under the snapshot. Nothing is copied.
 
   Querying a problem that has no data associated with it will result in
   zeros for the number of rows and columns, and NULL pointers from
@@ -121,6 +129,12 @@ public:
   /// Get pointer to column-wise copy of "original" matrix
   inline const CoinPackedMatrix * getOriginalMatrixByCol() const
   { return originalMatrixByCol_;}
+
+  /** Fingerprint of current matrix (whichever copy there is), bounds,
+      objective and integer ('B' or 'I') columns - the same as
+      CoinModel::fingerprint and CoinMpsIO::fingerprint for the same
+      problem */
+  CoinFingerprint fingerprint(int numberThreads = 1) const;
   //@}
   
   /**@name Solution query methods */
@@ -182,6 +196,98 @@ public:
   { return integerLowerBound_;}
   //@}
   
+  //---------------------------------------------------------------------------
+
+  /**@name View mode */
+  //@{
+  /// Arrays which may be borrowed from a CoinSnapshotSource
+  enum arrayType {
+    colLowerArray = 0,
+    colUpperArray,
+    rowLowerArray,
+    rowUpperArray,
+    rightHandSideArray,
+    objCoefficientsArray,
+    colTypeArray,
+    matrixByRowArray,
+    matrixByColArray,
+    originalMatrixByRowArray,
+    originalMatrixByColArray,
+    colSolutionArray,
+    rowPriceArray,
+    reducedCostArray,
+    rowActivityArray,
+    doNotSeparateThisArray,
+    numberArrayTypes
+  };
+
+  /** Borrow all arrays from source (which must outlive the snapshot or
+      the next setView). Scalars are kept. If the source has no right hand
+      side but has row bounds, one is created (and owned).
+  */
+  void setView(const CoinSnapshotSource * source);
+
+  /** Re-point borrowed arrays whose generation has changed, and take the
+      sizes again. Arrays set since by the set methods are left alone.
+      Returns number of arrays re-pointed.
+  */
+  int refresh();
+
+  /// True unless a borrowed array has changed generation since borrowed
+  bool isValid() const;
+
+  /// Source in view mode, else NULL
+  inline const CoinSnapshotSource * getViewSource() const
+  { return source_;}
+
+  /// True if array which is borrowed from the source
+  inline bool isViewed(arrayType which) const
+  { return (viewed_&(1u<<which))!=0;}
+  //@}
+
+  /**@name Incremental updates
+
+     Each change to an array moves the snapshot on a generation.  A
+     consumer remembers getGeneration() and later asks what changed since,
+     so it can redo only the work on changed entries.  The update methods
+     change a few entries in time proportional to their number; an array
+     which is borrowed (not owned) is copied on the first update and is
+     then no longer re-pointed by refresh().
+  */
+  //@{
+  /// Current generation
+  inline unsigned int getGeneration() const
+  { return changeGeneration_;}
+
+  /// True if array which has changed since generation
+  bool changedSince(arrayType which, unsigned int generation) const;
+
+  /** Entries of array which changed since generation (an entry may be
+      listed more than once) into whichEntries, which must be long enough
+      for the array.  Returns the number, or -1 if the whole array may have
+      changed.
+  */
+  int getChangedEntries(arrayType which, unsigned int generation,
+			int * whichEntries) const;
+
+  /// Change number column lower bounds
+  void updateColLower(int number, const int * which, const double * values);
+  /// Change number column upper bounds
+  void updateColUpper(int number, const int * which, const double * values);
+  /// Change number row lower bounds (and right hand sides)
+  void updateRowLower(int number, const int * which, const double * values);
+  /// Change number row upper bounds (and right hand sides)
+  void updateRowUpper(int number, const int * which, const double * values);
+  /// Change number primal values
+  void updateColSolution(int number, const int * which, const double * values);
+  /// Change number dual values
+  void updateRowPrice(int number, const int * which, const double * values);
+  /// Change number reduced costs
+  void updateReducedCost(int number, const int * which, const double * values);
+  /// Change number row activities
+  void updateRowActivity(int number, const int * which, const double * values);
+  //@}
+  
   //---------------------------------------------------------------------------
   
   /**@name Method to input a problem */
@@ -343,6 +449,17 @@ public:
   /// Assignment operator 
   CoinSnapshot & operator=(const CoinSnapshot& rhs);
   
+#if COIN_HAS_MOVE
+  /// Move constructor (takes arrays, rhs is left as if default constructed)
+  CoinSnapshot(CoinSnapshot &&) COIN_NOEXCEPT;
+  
+  /// Move assignment (exchanges contents with rhs)
+  CoinSnapshot & operator=(CoinSnapshot&& rhs) COIN_NOEXCEPT;
+  
+#endif
+  /// Exchange contents, ownership and view state with rhs (no copying)
+  void swap(CoinSnapshot & rhs);
+  
   /// Destructor 
   virtual ~CoinSnapshot ();
   
@@ -360,6 +477,17 @@ private:
   void gutsOfDestructor(int type);
   /// Does main work of copy
   void gutsOfCopy(const CoinSnapshot & rhs);
+  /// Point array which at source array (not owned)
+  void borrowArray(int which);
+  /// Rebuild owned right hand side and integer count after a view change
+  void derivedFromView(unsigned int changed);
+  /// Record that all of array which may have changed
+  void markChanged(int which);
+  /// Owned, writable copy of a double array (copied if borrowed)
+  double * writableArray(arrayType which);
+  /// Does work of update methods
+  void updateArray(arrayType which, int number, const int * whichEntries,
+		   const double * values);
   //@}
 
   ///@name Private member data 
@@ -471,6 +599,48 @@ private:
       unsigned int doNotSeparateThis:1;
   } coinOwned;
   coinOwned owned_;
+
+  /// Source in view mode
+  const CoinSnapshotSource * source_;
+
+  /// Bit per arrayType - borrowed from source_
+  unsigned int viewed_;
+
+  /// Generation of each array when borrowed
+  unsigned int generation_[numberArrayTypes];
+
+  /// Generation of last change
+  unsigned int changeGeneration_;
+
+  /// Generation at which each array last changed as a whole
+  unsigned int wholeChange_[numberArrayTypes];
+
+  /// Entries changed by update methods since then - (generation, entry)
+  std::vector<std::pair<unsigned int,int> > changeLog_[numberArrayTypes];
   //@}
 };  
+
+//#############################################################################
+
+/** Arrays for a CoinSnapshot in view mode.
+
+  A solver implements this over its own arrays. The generation of an
+  array must change whenever its contents or address do (a counter
+  bumped on each change will do); the snapshot compares generations and
+  does not look at the data.
+*/
+class CoinSnapshotSource {
+public:
+  virtual ~CoinSnapshotSource() {}
+  /// Number of rows
+  virtual int getNumRows() const = 0;
+  /// Number of columns
+  virtual int getNumCols() const = 0;
+  /** Current address of array which (a const double *, const char * or
+      const CoinPackedMatrix * as for the CoinSnapshot get method), or
+      NULL if not available */
+  virtual const void * getArray(CoinSnapshot::arrayType which) const = 0;
+  /// Current generation of array which
+  virtual unsigned int getGeneration(CoinSnapshot::arrayType which) const = 0;
+};
 #endif
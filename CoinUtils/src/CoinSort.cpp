@@ -0,0 +1,62 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include "CoinPragma.hpp"
+#include "CoinSort.hpp"
+#include "CoinThreadPool.hpp"
+
+//#############################################################################
+// Threads used by CoinSort_2 and CoinSort_3 on large arrays
+static int coinSortThreads = 1;
+
+void CoinSetSortThreads(int numberThreads)
+{
+#ifdef COINUTILS_PTHREADS
+  coinSortThreads = numberThreads > 1 ? numberThreads : 1;
+#else
+  coinSortThreads = 1;
+  (void) numberThreads;
+#endif
+}
+
+int CoinSortThreads()
+{
+  return coinSortThreads;
+}
+
+// One task
+typedef struct {
+  void (*task)(void *, int);
+  void *data;
+  int which;
+} CoinSortTask;
+
+static void *
+coinSortWorker(void *info)
+{
+  CoinSortTask *task = static_cast<CoinSortTask *>(info);
+  task->task(task->data, task->which);
+  return NULL;
+}
+
+// Runs all tasks - first one in this thread
+void CoinSortRunTasks(int numberTasks, void (*task)(void *, int), void *data)
+{
+  if (numberTasks > 1) {
+    CoinSortTask *info = new CoinSortTask[numberTasks];
+    for (int i = 0; i < numberTasks; i++) {
+      info[i].task = task;
+      info[i].data = data;
+      info[i].which = i;
+    }
+    CoinThreadPool::run(coinSortWorker, info, sizeof(CoinSortTask), numberTasks);
+    delete[] info;
+    return;
+  }
+  for (int i = 0; i < numberTasks; i++)
+    task(data, i);
+}
@@ -9,7 +9,9 @@
 #include <functional>
 #include <new>
 #include <algorithm>
+#include <cstring>
 #include "CoinDistance.hpp"
+#include "CoinTypes.hpp"
 
 // Uncomment the next three lines to get thorough initialisation of memory.
 // #ifndef ZEROFAULT
@@ -73,8 +75,8 @@ public:
   inline bool operator()(const CoinPair<S,T>& t1,
 			 const CoinPair<S,T>& t2) const
   { 
-    const T t1Abs = t1.first < static_cast<T>(0) ? -t1.first : t1.first;
-    const T t2Abs = t2.first < static_cast<T>(0) ? -t2.first : t2.first;
+    const S t1Abs = t1.first < static_cast<S>(0) ? -t1.first : t1.first;
+    const S t2Abs = t2.first < static_cast<S>(0) ? -t2.first : t2.first;
     return t1Abs < t2Abs; 
   }
 };
@@ -87,8 +89,8 @@ public:
   /// Compare function
   inline bool operator()(CoinPair<S,T> t1, CoinPair<S,T> t2) const
   { 
-    const T t1Abs = t1.first < static_cast<T>(0) ? -t1.first : t1.first;
-    const T t2Abs = t2.first < static_cast<T>(0) ? -t2.first : t2.first;
+    const S t1Abs = t1.first < static_cast<S>(0) ? -t1.first : t1.first;
+    const S t2Abs = t2.first < static_cast<S>(0) ? -t2.first : t2.first;
     return t1Abs > t2Abs; 
   }
 };
@@ -185,7 +187,8 @@ CoinSort_2(Iter_S sfirst, Iter_S slast, Iter_T tfirst)
 #else //=======================================================================
 
 template <class S, class T, class CoinCompare2> void
-CoinSort_2(S* sfirst, S* slast, T* tfirst, const CoinCompare2& pc)
+// This Always uses std::sort
+CoinSort_2Std(S* sfirst, S* slast, T* tfirst, const CoinCompare2& pc)
 {
   const size_t len = coinDistance(sfirst, slast);
   if (len <= 1)
@@ -221,7 +224,392 @@ template <class S, class T> void
 // This Always uses std::sort
 CoinSort_2Std(S* sfirst, S* slast, T* tfirst)
 {
-  CoinSort_2(sfirst, slast, tfirst, CoinFirstLess_2<S,T>());
+  CoinSort_2Std(sfirst, slast, tfirst, CoinFirstLess_2<S,T>());
+}
+/// Serial sort - std::sort or a radix sort if one applies (see below)
+template <class S, class T, class CoinCompare2> void
+CoinSort_2Serial(S* sfirst, S* slast, T* tfirst, const CoinCompare2& pc)
+{
+  CoinSort_2Std(sfirst, slast, tfirst, pc);
+}
+//-----------------------------------------------------------------------------
+/**@name Radix sorts
+
+   LSD radix sorts used by CoinSort_2 and CoinSort_3 instead of std::sort
+   when the keys are int or double, the comparison is one of the standard
+   first element ones and there are at least COIN_RADIX_SORT_MIN entries.
+   Keys are mapped to unsigned integers with the same order and sorted 11
+   bits at a time directly on the arrays (with scratch copies of each
+   array - so payload types must be default constructible).  The sort is
+   stable and -0.0 is the same key as +0.0.  Passes on
+   digits which are the same for all keys are skipped, so small integer
+   ranges take one or two passes.
+*/
+//@{
+#ifndef COIN_RADIX_SORT_MIN
+#define COIN_RADIX_SORT_MIN 4096
+#endif
+/// type - 1 decreasing, 2 absolute value
+inline void 
+CoinRadixEncode(const int* s, size_t n, unsigned int* key, int type)
+{
+  const unsigned int flip = (type&1)!=0 ? 0x7fffffffu : 0x80000000u;
+  for (size_t i = 0; i < n; i++)
+    key[i] = static_cast<unsigned int>(s[i]) ^ flip;
+}
+inline void 
+CoinRadixEncode(const double* s, size_t n, CoinUInt64* key, int type)
+{
+  const CoinUInt64 sign = static_cast<CoinUInt64>(1) << 63;
+  const CoinUInt64 flip = (type&1)!=0 ? ~static_cast<CoinUInt64>(0) : 0;
+  for (size_t i = 0; i < n; i++) {
+    CoinUInt64 bits;
+    memcpy(&bits, s+i, sizeof(bits));
+    if (bits == sign)
+      bits = 0; // -0.0 ties with +0.0 as in comparisons
+    if ((type&2)!=0)
+      bits &= ~sign;
+    else if ((bits&sign)!=0)
+      bits = ~bits;
+    else
+      bits |= sign;
+    key[i] = bits ^ flip;
+  }
+}
+/// Sorts s, t and u (if not NULL) on encoded keys (which are destroyed)
+template <class K, class S, class T, class U> void
+CoinRadixSortKeys(K* key, S* s, T* t, U* u, size_t n)
+{
+  const int bits = 11;
+  const size_t radix = static_cast<size_t>(1) << bits;
+  const K mask = static_cast<K>(radix - 1);
+  const int numberDigits = static_cast<int>((8*sizeof(K) + bits - 1) / bits);
+  size_t* count = new size_t [numberDigits*radix];
+  memset(count, 0, numberDigits*radix*sizeof(size_t));
+  for (size_t i = 0; i < n; i++) {
+    K k = key[i];
+    for (int d = 0; d < numberDigits; d++)
+      count[d*radix + ((k >> (d*bits)) & mask)]++;
+  }
+  K* keyWork = new K [n];
+  S* sWork = new S [n];
+  T* tWork = new T [n];
+  U* uWork = u ? new U [n] : NULL;
+  K* keyIn = key;
+  S* sIn = s;
+  T* tIn = t;
+  U* uIn = u;
+  for (int d = 0; d < numberDigits; d++) {
+    size_t* c = count + d*radix;
+    const int shift = d*bits;
+    if (c[(keyIn[0] >> shift) & mask] == n)
+      continue; // all same
+    size_t sum = 0;
+    for (size_t j = 0; j < radix; j++) {
+      size_t number = c[j];
+      c[j] = sum;
+      sum += number;
+    }
+    for (size_t i = 0; i < n; i++) {
+      K k = keyIn[i];
+      size_t put = c[(k >> shift) & mask]++;
+      keyWork[put] = k;
+      sWork[put] = sIn[i];
+      tWork[put] = tIn[i];
+      if (uIn)
+	uWork[put] = uIn[i];
+    }
+    std::swap(keyIn, keyWork);
+    std::swap(sIn, sWork);
+    std::swap(tIn, tWork);
+    std::swap(uIn, uWork);
+  }
+  if (sIn != s) {
+    // result is in scratch
+    std::copy(sIn, sIn+n, s);
+    std::copy(tIn, tIn+n, t);
+    if (u)
+      std::copy(uIn, uIn+n, u);
+    std::swap(keyIn, keyWork);
+    std::swap(sIn, sWork);
+    std::swap(tIn, tWork);
+    std::swap(uIn, uWork);
+  }
+  delete [] count;
+  delete [] keyWork;
+  delete [] sWork;
+  delete [] tWork;
+  delete [] uWork;
+}
+template <class T, class U> void
+CoinRadixSort(int* s, size_t n, T* t, U* u, int type)
+{
+  unsigned int* key = new unsigned int [n];
+  CoinRadixEncode(s, n, key, type);
+  CoinRadixSortKeys(key, s, t, u, n);
+  delete [] key;
+}
+template <class T, class U> void
+CoinRadixSort(double* s, size_t n, T* t, U* u, int type)
+{
+  CoinUInt64* key = new CoinUInt64 [n];
+  CoinRadixEncode(s, n, key, type);
+  CoinRadixSortKeys(key, s, t, u, n);
+  delete [] key;
+}
+/// Serial CoinSort_2 on standard comparisons of int and double keys
+template <class T> void
+CoinSort_2Serial(int* sfirst, int* slast, T* tfirst, const CoinFirstLess_2<int,T>& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_2Std(sfirst, slast, tfirst, pc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, static_cast<int*>(NULL), 0);
+}
+template <class T> void
+CoinSort_2Serial(int* sfirst, int* slast, T* tfirst, const CoinFirstGreater_2<int,T>& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_2Std(sfirst, slast, tfirst, pc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, static_cast<int*>(NULL), 1);
+}
+template <class T> void
+CoinSort_2Serial(double* sfirst, double* slast, T* tfirst, const CoinFirstLess_2<double,T>& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_2Std(sfirst, slast, tfirst, pc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, static_cast<int*>(NULL), 0);
+}
+template <class T> void
+CoinSort_2Serial(double* sfirst, double* slast, T* tfirst, const CoinFirstGreater_2<double,T>& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_2Std(sfirst, slast, tfirst, pc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, static_cast<int*>(NULL), 1);
+}
+template <class T> void
+CoinSort_2Serial(double* sfirst, double* slast, T* tfirst, const CoinFirstAbsLess_2<double,T>& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_2Std(sfirst, slast, tfirst, pc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, static_cast<int*>(NULL), 2);
+}
+template <class T> void
+CoinSort_2Serial(double* sfirst, double* slast, T* tfirst, const CoinFirstAbsGreater_2<double,T>& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_2Std(sfirst, slast, tfirst, pc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, static_cast<int*>(NULL), 3);
+}
+//@}
+//-----------------------------------------------------------------------------
+/**@name Parallel sorts
+
+   Above COIN_PARALLEL_SORT_MIN entries CoinSort_2 and CoinSort_3 split
+   the arrays into one run per thread, sort the runs with the serial code
+   (so radix sorts still apply) and then merge pairs of runs until one is
+   left.  In each merge round the output is cut into equal pieces, one per
+   thread, and the start of each piece in its two input runs is found by
+   binary search, so all threads stay busy until the end.  Merges prefer
+   the left run on ties.  Scratch copies of each array are needed, so
+   payload types must be default constructible.
+
+   Threads are only started if CoinUtils was built with thread support
+   and CoinSetSortThreads has been called with more than one thread.  The
+   default is one thread, as callers which are already threaded would
+   otherwise be oversubscribed.
+*/
+//@{
+#ifndef COIN_PARALLEL_SORT_MIN
+#define COIN_PARALLEL_SORT_MIN 100000
+#endif
+/** Sets number of threads CoinSort_2 and CoinSort_3 may use on large
+    arrays (ignored if built without thread support) */
+void CoinSetSortThreads(int numberThreads);
+/// Number of threads CoinSort_2 and CoinSort_3 may use on large arrays
+int CoinSortThreads();
+/** Runs task(data,i) for i=0 to numberTasks-1, each on its own thread if
+    built with thread support, and returns when all have finished */
+void CoinSortRunTasks(int numberTasks, void (*task)(void *, int), void *data);
+
+/// Arrays for CoinSortParallel when sorting pairs
+template <class S, class T>
+class CoinSortArrays_2 {
+public:
+  typedef CoinPair<S,T> value_type;
+  CoinSortArrays_2(S* s, T* t) : s_(s), t_(t) {}
+  inline value_type item(size_t i) const
+  { return value_type(s_[i], t_[i]); }
+  inline void put(size_t i, const CoinSortArrays_2& from, size_t j)
+  { s_[i] = from.s_[j]; t_[i] = from.t_[j]; }
+  inline CoinSortArrays_2 scratch(size_t n) const
+  { return CoinSortArrays_2(new S [n], new T [n]); }
+  inline void freeScratch()
+  { delete [] s_; delete [] t_; }
+  template <class CoinCompare2> inline void
+  sortSerial(size_t first, size_t last, const CoinCompare2& pc)
+  { CoinSort_2Serial(s_+first, s_+last, t_+first, pc); }
+private:
+  S* s_;
+  T* t_;
+};
+
+/** Parallel merge sort of n entries held in arrays (of type A, one of
+    CoinSortArrays_2 or CoinSortArrays_3) in the order given by
+    comparison pc using numberThreads threads */
+template <class A, class Compare>
+class CoinSortParallel {
+public:
+  CoinSortParallel(const A& arrays, size_t n, const Compare& pc)
+    : in_(arrays), out_(arrays), arrays_(arrays), n_(n), pc_(pc),
+      numberRuns_(0), numberPieces_(0), start_(NULL) {}
+
+  void sort(int numberThreads)
+  {
+    int numberRuns = static_cast<int>(std::min(static_cast<size_t>(numberThreads),
+						 n_ / 1024));
+    if (numberRuns < 2) {
+      arrays_.sortSerial(0, n_, pc_);
+      return;
+    }
+    numberRuns_ = numberRuns;
+    numberPieces_ = numberThreads;
+    start_ = new size_t [numberRuns_+1];
+    for (int i = 0; i <= numberRuns_; i++)
+      start_[i] = (n_ * i) / numberRuns_;
+    CoinSortRunTasks(numberRuns_, sortTask, this);
+    A scratch = arrays_.scratch(n_);
+    in_ = arrays_;
+    out_ = scratch;
+    bool inScratch = false;
+    while (numberRuns_ > 1) {
+      CoinSortRunTasks(numberPieces_, mergeTask, this);
+      // runs 2k and 2k+1 are now run k
+      int k = 0;
+      for (int i = 0; i < numberRuns_; i += 2)
+	start_[k++] = start_[i];
+      start_[k] = n_;
+      numberRuns_ = k;
+      std::swap(in_, out_);
+      inScratch = !inScratch;
+    }
+    if (inScratch)
+      CoinSortRunTasks(numberPieces_, copyTask, this);
+    delete [] start_;
+    start_ = NULL;
+    scratch.freeScratch();
+  }
+private:
+  static void sortTask(void* data, int i)
+  {
+    CoinSortParallel* self = static_cast<CoinSortParallel*>(data);
+    self->arrays_.sortSerial(self->start_[i], self->start_[i+1], self->pc_);
+  }
+  /// Number of first k merged entries which come from run a (length m)
+  size_t coRank(size_t k, size_t a, size_t m, size_t b, size_t l) const
+  {
+    size_t low = k > l ? k - l : 0;
+    size_t high = std::min(k, m);
+    while (low < high) {
+      size_t i = (low + high) >> 1;
+      if (pc_(in_.item(b + k - i - 1), in_.item(a + i)))
+	high = i;
+      else
+	low = i + 1;
+    }
+    return low;
+  }
+  static void mergeTask(void* data, int piece)
+  {
+    CoinSortParallel* self = static_cast<CoinSortParallel*>(data);
+    self->merge(piece);
+  }
+  void merge(int piece)
+  {
+    const size_t first = (n_ * piece) / numberPieces_;
+    const size_t last = (n_ * (piece + 1)) / numberPieces_;
+    for (int r = 0; r < numberRuns_; r += 2) {
+      const size_t a = start_[r];
+      const size_t b = start_[std::min(r+1, numberRuns_)];
+      const size_t end = start_[std::min(r+2, numberRuns_)];
+      if (end <= first)
+	continue;
+      if (a >= last)
+	break;
+      const size_t m = b - a;
+      const size_t l = end - b;
+      const size_t k0 = std::max(first, a) - a;
+      const size_t k1 = std::min(last, end) - a;
+      size_t i = coRank(k0, a, m, b, l);
+      size_t j = k0 - i;
+      const size_t iEnd = coRank(k1, a, m, b, l);
+      const size_t jEnd = k1 - iEnd;
+      size_t put = a + k0;
+      while (i < iEnd && j < jEnd) {
+	if (pc_(in_.item(b + j), in_.item(a + i)))
+	  out_.put(put++, in_, b + j++);
+	else
+	  out_.put(put++, in_, a + i++);
+      }
+      while (i < iEnd)
+	out_.put(put++, in_, a + i++);
+      while (j < jEnd)
+	out_.put(put++, in_, b + j++);
+    }
+  }
+  static void copyTask(void* data, int piece)
+  {
+    CoinSortParallel* self = static_cast<CoinSortParallel*>(data);
+    const size_t first = (self->n_ * piece) / self->numberPieces_;
+    const size_t last = (self->n_ * (piece + 1)) / self->numberPieces_;
+    for (size_t i = first; i < last; i++)
+      self->arrays_.put(i, self->in_, i);
+  }
+
+  /// Runs being merged
+  A in_;
+  /// Where merged runs go
+  A out_;
+  /// Arrays being sorted
+  A arrays_;
+  /// Number of entries
+  size_t n_;
+  /// Comparison
+  Compare pc_;
+  /// Number of sorted runs
+  int numberRuns_;
+  /// Number of pieces each merge round is cut into
+  int numberPieces_;
+  /// Start of each run (numberRuns_+1)
+  size_t* start_;
+};
+//@}
+/** Sort a pair of arrays, ordered by pc, in parallel above
+    COIN_PARALLEL_SORT_MIN entries.  The radix and parallel sorts use
+    scratch arrays so T must be default constructible. */
+template <class S, class T, class CoinCompare2> void
+CoinSort_2(S* sfirst, S* slast, T* tfirst, const CoinCompare2& pc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  const int numberThreads = len < COIN_PARALLEL_SORT_MIN ? 1 : CoinSortThreads();
+  if (numberThreads <= 1) {
+    CoinSort_2Serial(sfirst, slast, tfirst, pc);
+  } else {
+    CoinSortParallel<CoinSortArrays_2<S,T>, CoinCompare2>
+      sorter(CoinSortArrays_2<S,T>(sfirst, tfirst), len, pc);
+    sorter.sort(numberThreads);
+  }
 }
 #ifndef COIN_USE_EKK_SORT
 //-----------------------------------------------------------------------------
@@ -503,8 +891,8 @@ public:
   inline bool operator()(const CoinTriple<S,T,U>& t1,
 			 const CoinTriple<S,T,U>& t2) const
   { 
-    const T t1Abs = t1.first < static_cast<T>(0) ? -t1.first : t1.first;
-    const T t2Abs = t2.first < static_cast<T>(0) ? -t2.first : t2.first;
+    const S t1Abs = t1.first < static_cast<S>(0) ? -t1.first : t1.first;
+    const S t2Abs = t2.first < static_cast<S>(0) ? -t2.first : t2.first;
     return t1Abs < t2Abs; 
   }
 };
@@ -518,8 +906,8 @@ public:
   inline bool operator()(const CoinTriple<S,T,U>& t1,
 			 const CoinTriple<S,T,U>& t2) const
   { 
-    const T t1Abs = t1.first < static_cast<T>(0) ? -t1.first : t1.first;
-    const T t2Abs = t2.first < static_cast<T>(0) ? -t2.first : t2.first;
+    const S t1Abs = t1.first < static_cast<S>(0) ? -t1.first : t1.first;
+    const S t2Abs = t2.first < static_cast<S>(0) ? -t2.first : t2.first;
     return t1Abs > t2Abs; 
   }
 };
@@ -633,7 +1021,8 @@ CoinSort_3(Iter_S sfirst, Iter_S slast, Iter_T tfirst, Iter_U, ufirst)
 #else //=======================================================================
 
 template <class S, class T, class U, class CoinCompare3> void
-CoinSort_3(S* sfirst, S* slast, T* tfirst, U* ufirst, const CoinCompare3& tc)
+// This Always uses std::sort
+CoinSort_3Std(S* sfirst, S* slast, T* tfirst, U* ufirst, const CoinCompare3& tc)
 {
   const size_t len = coinDistance(sfirst,slast);
   if (len <= 1)
@@ -664,6 +1053,111 @@ CoinSort_3(S* sfirst, S* slast, T* tfirst, U* ufirst, const CoinCompare3& tc)
 
   ::operator delete(x);
 }
+/// Serial sort - std::sort or a radix sort if one applies
+template <class S, class T, class U, class CoinCompare3> void
+CoinSort_3Serial(S* sfirst, S* slast, T* tfirst, U* ufirst, const CoinCompare3& tc)
+{
+  CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+}
+/// Serial CoinSort_3 on standard comparisons of int and double keys (radix sort)
+template <class T, class U> void
+CoinSort_3Serial(int* sfirst, int* slast, T* tfirst, U* ufirst,
+	   const CoinFirstLess_3<int,T,U>& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, ufirst, 0);
+}
+template <class T, class U> void
+CoinSort_3Serial(int* sfirst, int* slast, T* tfirst, U* ufirst,
+	   const CoinFirstGreater_3<int,T,U>& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, ufirst, 1);
+}
+template <class T, class U> void
+CoinSort_3Serial(double* sfirst, double* slast, T* tfirst, U* ufirst,
+	   const CoinFirstLess_3<double,T,U>& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, ufirst, 0);
+}
+template <class T, class U> void
+CoinSort_3Serial(double* sfirst, double* slast, T* tfirst, U* ufirst,
+	   const CoinFirstGreater_3<double,T,U>& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, ufirst, 1);
+}
+template <class T, class U> void
+CoinSort_3Serial(double* sfirst, double* slast, T* tfirst, U* ufirst,
+	   const CoinFirstAbsLess_3<double,T,U>& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, ufirst, 2);
+}
+template <class T, class U> void
+CoinSort_3Serial(double* sfirst, double* slast, T* tfirst, U* ufirst,
+	   const CoinFirstAbsGreater_3<double,T,U>& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  if (len < COIN_RADIX_SORT_MIN)
+    CoinSort_3Std(sfirst, slast, tfirst, ufirst, tc);
+  else
+    CoinRadixSort(sfirst, len, tfirst, ufirst, 3);
+}
+/// Arrays for CoinSortParallel when sorting triples
+template <class S, class T, class U>
+class CoinSortArrays_3 {
+public:
+  typedef CoinTriple<S,T,U> value_type;
+  CoinSortArrays_3(S* s, T* t, U* u) : s_(s), t_(t), u_(u) {}
+  inline value_type item(size_t i) const
+  { return value_type(s_[i], t_[i], u_[i]); }
+  inline void put(size_t i, const CoinSortArrays_3& from, size_t j)
+  { s_[i] = from.s_[j]; t_[i] = from.t_[j]; u_[i] = from.u_[j]; }
+  inline CoinSortArrays_3 scratch(size_t n) const
+  { return CoinSortArrays_3(new S [n], new T [n], new U [n]); }
+  inline void freeScratch()
+  { delete [] s_; delete [] t_; delete [] u_; }
+  template <class CoinCompare3> inline void
+  sortSerial(size_t first, size_t last, const CoinCompare3& tc)
+  { CoinSort_3Serial(s_+first, s_+last, t_+first, u_+first, tc); }
+private:
+  S* s_;
+  T* t_;
+  U* u_;
+};
+/** Sort a triple of arrays, ordered by tc, in parallel above
+    COIN_PARALLEL_SORT_MIN entries.  The radix and parallel sorts use
+    scratch arrays so T and U must be default constructible. */
+template <class S, class T, class U, class CoinCompare3> void
+CoinSort_3(S* sfirst, S* slast, T* tfirst, U* ufirst, const CoinCompare3& tc)
+{
+  const size_t len = coinDistance(sfirst, slast);
+  const int numberThreads = len < COIN_PARALLEL_SORT_MIN ? 1 : CoinSortThreads();
+  if (numberThreads <= 1) {
+    CoinSort_3Serial(sfirst, slast, tfirst, ufirst, tc);
+  } else {
+    CoinSortParallel<CoinSortArrays_3<S,T,U>, CoinCompare3>
+      sorter(CoinSortArrays_3<S,T,U>(sfirst, tfirst, ufirst), len, tc);
+    sorter.sort(numberThreads);
+  }
+}
 //-----------------------------------------------------------------------------
 template <class S, class T, class U> void
 CoinSort_3(S* sfirst, S* slast, T* tfirst, U* ufirst)
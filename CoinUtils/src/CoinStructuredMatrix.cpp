@@ -0,0 +1,480 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinError.hpp"
+#include "CoinStructuredMatrix.hpp"
+#include "CoinStructuredModel.hpp"
+#include "CoinThreadPool.hpp"
+
+//#############################################################################
+/* Work for one thread.  A product is done in units - the element blocks
+   unitBlock[unitStart[u]] to unitBlock[unitStart[u+1]-1] added into group
+   unitGroup[u] (row block, or column block for transposeTimes) of the
+   result, or into work space at unitWork[u] if that is not -1.  Groups
+   done in work space are then added up. */
+typedef struct {
+  const CoinPackedMatrix * blocks;
+  const int * rowBlock;
+  const int * columnBlock;
+  const int * rowStart;
+  const int * columnStart;
+  // first row (or column) of each group
+  const int * groupStart;
+  const int * unitStart;
+  const int * unitBlock;
+  const int * unitGroup;
+  const int * unitWork;
+  // groups done in work space and their units (first to last-1)
+  const int * splitGroup;
+  const int * splitFirstUnit;
+  const int * splitLastUnit;
+  int numberSplit;
+  const double * in;
+  const double * in2;
+  double * out;
+  double * out2;
+  double * work;
+  double * work2;
+  // units first to last-1 (or for adding up part which of number)
+  int first;
+  int last;
+  int which;
+  int number;
+  // 0 times, 1 transposeTimes, 2 bounds, 3 add up, 4 add up bounds
+  int type;
+} CoinStructuredThread;
+
+// y += block x
+static void
+coinStructuredTimes(const CoinPackedMatrix & block, const double * x,
+		    double * y)
+{
+  const CoinBigIndex * start = block.getVectorStarts();
+  const int * length = block.getVectorLengths();
+  const int * row = block.getIndices();
+  const double * element = block.getElements();
+  const int numberColumns = block.getMajorDim();
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    const double value = x[iColumn];
+    if (value) {
+      const CoinBigIndex end = start[iColumn] + length[iColumn];
+      for (CoinBigIndex j = start[iColumn]; j < end; j++)
+	y[row[j]] += value * element[j];
+    }
+  }
+}
+
+// x += block' y
+static void
+coinStructuredTransposeTimes(const CoinPackedMatrix & block, const double * y,
+			     double * x)
+{
+  const CoinBigIndex * start = block.getVectorStarts();
+  const int * length = block.getVectorLengths();
+  const int * row = block.getIndices();
+  const double * element = block.getElements();
+  const int numberColumns = block.getMajorDim();
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    double value = 0.0;
+    const CoinBigIndex end = start[iColumn] + length[iColumn];
+    for (CoinBigIndex j = start[iColumn]; j < end; j++)
+      value += y[row[j]] * element[j];
+    x[iColumn] += value;
+  }
+}
+
+// Adds row activity bounds of block (once infinite stays at -+COIN_DBL_MAX)
+static void
+coinStructuredBounds(const CoinPackedMatrix & block, const double * lower,
+		     const double * upper, double * minimum, double * maximum)
+{
+  const CoinBigIndex * start = block.getVectorStarts();
+  const int * length = block.getVectorLengths();
+  const int * row = block.getIndices();
+  const double * element = block.getElements();
+  const int numberColumns = block.getMajorDim();
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    const double lowerValue = lower[iColumn];
+    const double upperValue = upper[iColumn];
+    const bool infiniteLower = lowerValue <= -1.0e30;
+    const bool infiniteUpper = upperValue >= 1.0e30;
+    const CoinBigIndex end = start[iColumn] + length[iColumn];
+    for (CoinBigIndex j = start[iColumn]; j < end; j++) {
+      const int iRow = row[j];
+      const double value = element[j];
+      if (value > 0.0) {
+	if (infiniteLower)
+	  minimum[iRow] = -COIN_DBL_MAX;
+	else if (minimum[iRow] > -COIN_DBL_MAX)
+	  minimum[iRow] += value * lowerValue;
+	if (infiniteUpper)
+	  maximum[iRow] = COIN_DBL_MAX;
+	else if (maximum[iRow] < COIN_DBL_MAX)
+	  maximum[iRow] += value * upperValue;
+      } else if (value < 0.0) {
+	if (infiniteUpper)
+	  minimum[iRow] = -COIN_DBL_MAX;
+	else if (minimum[iRow] > -COIN_DBL_MAX)
+	  minimum[iRow] += value * upperValue;
+	if (infiniteLower)
+	  maximum[iRow] = COIN_DBL_MAX;
+	else if (maximum[iRow] < COIN_DBL_MAX)
+	  maximum[iRow] += value * lowerValue;
+      }
+    }
+  }
+}
+
+// Does units first to last-1
+static void
+coinStructuredUnits(const CoinStructuredThread & info)
+{
+  for (int iUnit = info.first; iUnit < info.last; iUnit++) {
+    const int iGroup = info.unitGroup[iUnit];
+    const int number = info.groupStart[iGroup+1] - info.groupStart[iGroup];
+    double * out;
+    double * out2;
+    if (info.unitWork[iUnit] < 0) {
+      out = info.out + info.groupStart[iGroup];
+      out2 = info.out2 ? info.out2 + info.groupStart[iGroup] : NULL;
+    } else {
+      out = info.work + info.unitWork[iUnit];
+      out2 = info.work2 ? info.work2 + info.unitWork[iUnit] : NULL;
+    }
+    CoinZeroN(out, number);
+    if (out2)
+      CoinZeroN(out2, number);
+    for (int k = info.unitStart[iUnit]; k < info.unitStart[iUnit+1]; k++) {
+      const int iBlock = info.unitBlock[k];
+      const CoinPackedMatrix & block = info.blocks[iBlock];
+      const int rowOffset = info.rowStart[info.rowBlock[iBlock]];
+      const int columnOffset = info.columnStart[info.columnBlock[iBlock]];
+      switch (info.type) {
+      case 0:
+	coinStructuredTimes(block, info.in + columnOffset, out);
+	break;
+      case 1:
+	coinStructuredTransposeTimes(block, info.in + rowOffset, out);
+	break;
+      default:
+	coinStructuredBounds(block, info.in + columnOffset,
+			     info.in2 + columnOffset, out, out2);
+	break;
+      }
+    }
+  }
+}
+
+// Adds up groups done in work space - this thread does its part of each
+static void
+coinStructuredAdd(const CoinStructuredThread & info)
+{
+  for (int iSplit = 0; iSplit < info.numberSplit; iSplit++) {
+    const int iGroup = info.splitGroup[iSplit];
+    const int firstUnit = info.splitFirstUnit[iSplit];
+    const int lastUnit = info.splitLastUnit[iSplit];
+    const int number = info.groupStart[iGroup+1] - info.groupStart[iGroup];
+    const int first = static_cast<int>((static_cast<double>(number)
+					* info.which) / info.number);
+    const int last = static_cast<int>((static_cast<double>(number)
+				       * (info.which+1)) / info.number);
+    double * out = info.out + info.groupStart[iGroup];
+    if (info.type == 3) {
+      for (int i = first; i < last; i++) {
+	double value = 0.0;
+	for (int iUnit = firstUnit; iUnit < lastUnit; iUnit++)
+	  value += info.work[info.unitWork[iUnit] + i];
+	out[i] = value;
+      }
+    } else {
+      // minimum from work, maximum from work2 - infinite if any part is
+      double * out2 = info.out2 + info.groupStart[iGroup];
+      for (int i = first; i < last; i++) {
+	double minimum = 0.0;
+	double maximum = 0.0;
+	for (int iUnit = firstUnit; iUnit < lastUnit; iUnit++) {
+	  const int position = info.unitWork[iUnit] + i;
+	  if (minimum > -COIN_DBL_MAX) {
+	    if (info.work[position] > -COIN_DBL_MAX)
+	      minimum += info.work[position];
+	    else
+	      minimum = -COIN_DBL_MAX;
+	  }
+	  if (maximum < COIN_DBL_MAX) {
+	    if (info.work2[position] < COIN_DBL_MAX)
+	      maximum += info.work2[position];
+	    else
+	      maximum = COIN_DBL_MAX;
+	  }
+	}
+	out[i] = minimum;
+	out2[i] = maximum;
+      }
+    }
+  }
+}
+
+static void *
+coinStructuredWorker(void * threadInfo)
+{
+  const CoinStructuredThread & info =
+    *reinterpret_cast<CoinStructuredThread *>(threadInfo);
+  if (info.type < 3)
+    coinStructuredUnits(info);
+  else
+    coinStructuredAdd(info);
+  return NULL;
+}
+
+//#############################################################################
+
+CoinStructuredMatrix::CoinStructuredMatrix()
+  : rowBlockStart_(1, 0),
+    columnBlockStart_(1, 0),
+    rowBlockListStart_(1, 0),
+    columnBlockListStart_(1, 0),
+    numberElements_(0),
+    numberThreads_(1)
+{
+}
+
+CoinStructuredMatrix::CoinStructuredMatrix(const CoinStructuredModel & model)
+  : numberThreads_(1)
+{
+  load(model);
+}
+
+void
+CoinStructuredMatrix::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  numberThreads_ = CoinMax(value, 1);
+#else
+  numberThreads_ = 1;
+  (void) value;
+#endif
+}
+
+// Lists of element blocks by row (or column) block
+static void
+coinStructuredLists(const std::vector<int> & group, int numberGroups,
+		    std::vector<int> & listStart, std::vector<int> & list)
+{
+  const int numberBlocks = static_cast<int>(group.size());
+  listStart.assign(numberGroups+1, 0);
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++)
+    listStart[group[iBlock]+1]++;
+  for (int i = 0; i < numberGroups; i++)
+    listStart[i+1] += listStart[i];
+  list.resize(numberBlocks);
+  std::vector<int> next(listStart.begin(), listStart.end() - 1);
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++)
+    list[next[group[iBlock]]++] = iBlock;
+}
+
+void
+CoinStructuredMatrix::load(const CoinStructuredModel & model)
+{
+  const int numberBlocks = static_cast<int>(model.numberElementBlocks());
+  const int numberRowBlocks = model.numberRowBlocks();
+  const int numberColumnBlocks = model.numberColumnBlocks();
+  std::vector<int> numberRows(numberRowBlocks, -1);
+  std::vector<int> numberColumns(numberColumnBlocks, -1);
+  std::vector<CoinPackedMatrix> blocks(numberBlocks);
+  rowBlock_.resize(numberBlocks);
+  columnBlock_.resize(numberBlocks);
+  numberElements_ = 0;
+  for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+    const CoinModelBlockInfo & info = model.blockType(iBlock);
+    const CoinModel * block = model.coinBlock(iBlock);
+    if (!block || !block->packedMatrix())
+      throw CoinError("block has no packed matrix", "load",
+		      "CoinStructuredMatrix");
+    const int iRowBlock = info.rowBlock;
+    const int iColumnBlock = info.columnBlock;
+    if ((numberRows[iRowBlock] >= 0 &&
+	 numberRows[iRowBlock] != block->numberRows()) ||
+	(numberColumns[iColumnBlock] >= 0 &&
+	 numberColumns[iColumnBlock] != block->numberColumns()))
+      throw CoinError("blocks of one row or column block differ in size",
+		      "load", "CoinStructuredMatrix");
+    numberRows[iRowBlock] = block->numberRows();
+    numberColumns[iColumnBlock] = block->numberColumns();
+    rowBlock_[iBlock] = iRowBlock;
+    columnBlock_[iBlock] = iColumnBlock;
+    const CoinPackedMatrix & matrix = *block->packedMatrix();
+    if (matrix.isColOrdered())
+      blocks[iBlock] = matrix;
+    else
+      blocks[iBlock].reverseOrderedCopyOf(matrix);
+    if (blocks[iBlock].getNumRows() < block->numberRows() ||
+	blocks[iBlock].getNumCols() < block->numberColumns())
+      blocks[iBlock].setDimensions(block->numberRows(),
+				   block->numberColumns());
+    numberElements_ += blocks[iBlock].getNumElements();
+  }
+  blocks_.swap(blocks);
+  rowBlockStart_.assign(numberRowBlocks+1, 0);
+  for (int i = 0; i < numberRowBlocks; i++)
+    rowBlockStart_[i+1] = rowBlockStart_[i] + CoinMax(numberRows[i], 0);
+  columnBlockStart_.assign(numberColumnBlocks+1, 0);
+  for (int i = 0; i < numberColumnBlocks; i++)
+    columnBlockStart_[i+1] =
+      columnBlockStart_[i] + CoinMax(numberColumns[i], 0);
+  coinStructuredLists(rowBlock_, numberRowBlocks, rowBlockListStart_,
+		      rowBlockList_);
+  coinStructuredLists(columnBlock_, numberColumnBlocks, columnBlockListStart_,
+		      columnBlockList_);
+}
+
+//#############################################################################
+
+void
+CoinStructuredMatrix::product(int type, const double * in, const double * in2,
+			      double * out, double * out2) const
+{
+  if (blocks_.empty())
+    return;
+  // groups of result are column blocks for transposeTimes
+  const bool byColumn = type == 1;
+  const int numberGroups = byColumn ? numberColumnBlocks() : numberRowBlocks();
+  const int * groupStart = byColumn ? &columnBlockStart_[0] : &rowBlockStart_[0];
+  const int * listStart =
+    byColumn ? &columnBlockListStart_[0] : &rowBlockListStart_[0];
+  const int * list = byColumn ? &columnBlockList_[0] : &rowBlockList_[0];
+  int numberThreads =
+    CoinMax(1, CoinMin(numberThreads_,
+		       static_cast<int>(numberElements_ / 20000)));
+  const double share = static_cast<double>(numberElements_) / numberThreads;
+  /* A group is one unit unless it has several element blocks and more
+     than a thread's share - then each element block is a unit into work
+     space */
+  std::vector<int> unitStart(1, 0);
+  std::vector<int> unitBlock;
+  std::vector<int> unitGroup;
+  std::vector<int> unitWork;
+  std::vector<CoinBigIndex> unitElements;
+  std::vector<int> splitGroup;
+  std::vector<int> splitFirstUnit;
+  std::vector<int> splitLastUnit;
+  int workSize = 0;
+  for (int iGroup = 0; iGroup < numberGroups; iGroup++) {
+    CoinBigIndex numberElements = 0;
+    for (int k = listStart[iGroup]; k < listStart[iGroup+1]; k++)
+      numberElements += blocks_[list[k]].getNumElements();
+    if (numberThreads > 1 && listStart[iGroup+1] - listStart[iGroup] > 1 &&
+	numberElements > share) {
+      const int number = groupStart[iGroup+1] - groupStart[iGroup];
+      splitGroup.push_back(iGroup);
+      splitFirstUnit.push_back(static_cast<int>(unitGroup.size()));
+      for (int k = listStart[iGroup]; k < listStart[iGroup+1]; k++) {
+	unitBlock.push_back(list[k]);
+	unitStart.push_back(static_cast<int>(unitBlock.size()));
+	unitGroup.push_back(iGroup);
+	unitWork.push_back(workSize);
+	unitElements.push_back(blocks_[list[k]].getNumElements());
+	workSize += number;
+      }
+      splitLastUnit.push_back(static_cast<int>(unitGroup.size()));
+    } else {
+      for (int k = listStart[iGroup]; k < listStart[iGroup+1]; k++)
+	unitBlock.push_back(list[k]);
+      unitStart.push_back(static_cast<int>(unitBlock.size()));
+      unitGroup.push_back(iGroup);
+      unitWork.push_back(-1);
+      unitElements.push_back(numberElements);
+    }
+  }
+  const int numberUnits = static_cast<int>(unitGroup.size());
+  const int numberWork = type == 2 ? 2 : 1;
+  double * work = new double [numberWork * CoinMax(workSize, 1)];
+  CoinStructuredThread base;
+  memset(&base, 0, sizeof(CoinStructuredThread));
+  base.blocks = &blocks_[0];
+  base.rowBlock = &rowBlock_[0];
+  base.columnBlock = &columnBlock_[0];
+  base.rowStart = &rowBlockStart_[0];
+  base.columnStart = &columnBlockStart_[0];
+  base.groupStart = groupStart;
+  base.unitStart = &unitStart[0];
+  base.unitBlock = &unitBlock[0];
+  base.unitGroup = &unitGroup[0];
+  base.unitWork = &unitWork[0];
+  base.numberSplit = static_cast<int>(splitGroup.size());
+  if (!splitGroup.empty()) {
+    base.splitGroup = &splitGroup[0];
+    base.splitFirstUnit = &splitFirstUnit[0];
+    base.splitLastUnit = &splitLastUnit[0];
+  }
+  base.in = in;
+  base.in2 = in2;
+  base.out = out;
+  base.out2 = out2;
+  base.work = work;
+  if (type == 2)
+    base.work2 = work + CoinMax(workSize, 1);
+  // units split between threads by number of elements (at least one each)
+  numberThreads = CoinMin(numberThreads, numberUnits);
+  CoinStructuredThread * thread = new CoinStructuredThread [numberThreads];
+  int iUnit = 0;
+  CoinBigIndex done = 0;
+  for (int i = 0; i < numberThreads; i++) {
+    thread[i] = base;
+    thread[i].type = type;
+    thread[i].first = iUnit;
+    const double target =
+      (static_cast<double>(numberElements_) * (i+1)) / numberThreads;
+    while (iUnit < numberUnits - (numberThreads - 1 - i) &&
+	   (done < target || iUnit == thread[i].first)) {
+      done += unitElements[iUnit];
+      iUnit++;
+    }
+    thread[i].last = iUnit;
+  }
+  thread[numberThreads-1].last = numberUnits;
+  CoinThreadPool::run(coinStructuredWorker, thread,
+		      sizeof(CoinStructuredThread), numberThreads);
+  if (workSize) {
+    // add up with rows (or columns) split between threads
+    for (int i = 0; i < numberThreads; i++) {
+      thread[i] = base;
+      thread[i].type = type == 2 ? 4 : 3;
+      thread[i].which = i;
+      thread[i].number = numberThreads;
+    }
+    CoinThreadPool::run(coinStructuredWorker, thread,
+			sizeof(CoinStructuredThread), numberThreads);
+  }
+  delete [] thread;
+  delete [] work;
+}
+
+void
+CoinStructuredMatrix::times(const double * x, double * y) const
+{
+  product(0, x, NULL, y, NULL);
+}
+
+void
+CoinStructuredMatrix::transposeTimes(const double * y, double * x) const
+{
+  product(1, y, NULL, x, NULL);
+}
+
+void
+CoinStructuredMatrix::rowActivityBounds(const double * columnLower,
+					const double * columnUpper,
+					double * rowMinimum,
+					double * rowMaximum) const
+{
+  product(2, columnLower, columnUpper, rowMinimum, rowMaximum);
+}
@@ -0,0 +1,138 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinStructuredMatrix_H
+#define CoinStructuredMatrix_H
+
+#include <vector>
+
+#include "CoinPackedMatrix.hpp"
+
+class CoinStructuredModel;
+
+/** Matrix of a CoinStructuredModel kept block by block for products
+
+    Each element block of the model is copied as a column ordered
+    CoinPackedMatrix.  Rows are numbered row block by row block, in the
+    order of the row blocks of the model, and columns the same way by
+    column blocks (see rowBlockStarts and columnBlockStarts), so vectors
+    passed in and out are in that order and not that of any flat matrix
+    the model was decomposed from.
+
+    Products and row activity bounds do the element blocks at the same
+    time (split between threads by number of elements if built with
+    COINUTILS_PTHREADS and setNumberThreads is used).  Each row block of
+    the result (column block for transposeTimes) is normally done by one
+    thread straight into the result, so diagonal blocks and the border
+    blocks beside them need no extra work.  A row block with more than
+    one element block and more than a thread's share of elements - the
+    master rows of a large Dantzig-Wolfe decomposition, or the master
+    columns of a Benders one for transposeTimes - has its element blocks
+    done by several threads into work space, which is then added up with
+    the rows split between threads.
+
+    Bounds of 1.0e30 or more in size are infinite.
+*/
+class CoinStructuredMatrix {
+public:
+  /**@name Products */
+  //@{
+  /// y = A x
+  void times(const double * x, double * y) const;
+  /// x = A' y
+  void transposeTimes(const double * y, double * x) const;
+  /** Smallest and largest activity of each row for the given column
+      bounds (-COIN_DBL_MAX or COIN_DBL_MAX when unbounded) */
+  void rowActivityBounds(const double * columnLower,
+			 const double * columnUpper,
+			 double * rowMinimum, double * rowMaximum) const;
+  //@}
+
+  /**@name Layout */
+  //@{
+  /// Copies the element blocks of model (throws CoinError if it can't)
+  void load(const CoinStructuredModel & model);
+  inline int getNumRows() const
+  { return rowBlockStart_.back();}
+  inline int getNumCols() const
+  { return columnBlockStart_.back();}
+  inline CoinBigIndex getNumElements() const
+  { return numberElements_;}
+  inline int numberRowBlocks() const
+  { return static_cast<int>(rowBlockStart_.size()) - 1;}
+  inline int numberColumnBlocks() const
+  { return static_cast<int>(columnBlockStart_.size()) - 1;}
+  inline int numberBlocks() const
+  { return static_cast<int>(blocks_.size());}
+  /// First row of each row block (numberRowBlocks()+1 entries)
+  inline const int * rowBlockStarts() const
+  { return &rowBlockStart_[0];}
+  /// First column of each column block (numberColumnBlocks()+1 entries)
+  inline const int * columnBlockStarts() const
+  { return &columnBlockStart_[0];}
+  /// Element block i (column ordered)
+  inline const CoinPackedMatrix & block(int i) const
+  { return blocks_[i];}
+  /// Row block of element block i
+  inline int rowBlock(int i) const
+  { return rowBlock_[i];}
+  /// Column block of element block i
+  inline int columnBlock(int i) const
+  { return columnBlock_[i];}
+  /// Number of element blocks in row block i
+  inline int numberBlocksInRowBlock(int i) const
+  { return rowBlockListStart_[i+1] - rowBlockListStart_[i];}
+  /// Number of element blocks in column block i
+  inline int numberBlocksInColumnBlock(int i) const
+  { return columnBlockListStart_[i+1] - columnBlockListStart_[i];}
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Number of threads for products
+  inline int numberThreads() const
+  { return numberThreads_;}
+  /// Set number of threads (1 if not built with threads)
+  void setNumberThreads(int value);
+  //@}
+
+  /**@name Constructors (copy and assignment are the default ones) */
+  //@{
+  /// Default constructor (no blocks)
+  CoinStructuredMatrix();
+  /// Copies the element blocks of model (see load)
+  explicit CoinStructuredMatrix(const CoinStructuredModel & model);
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /// Product of type 0 times, 1 transposeTimes or 2 row activity bounds
+  void product(int type, const double * in, const double * in2,
+	       double * out, double * out2) const;
+  //@}
+
+  /**@name Private member data */
+  //@{
+  /// Element blocks (column ordered)
+  std::vector<CoinPackedMatrix> blocks_;
+  /// Row and column block of each element block
+  std::vector<int> rowBlock_;
+  std::vector<int> columnBlock_;
+  /// First row of each row block and first column of each column block
+  std::vector<int> rowBlockStart_;
+  std::vector<int> columnBlockStart_;
+  /// Element blocks of each row block (start and list)
+  std::vector<int> rowBlockListStart_;
+  std::vector<int> rowBlockList_;
+  /// Element blocks of each column block (start and list)
+  std::vector<int> columnBlockListStart_;
+  std::vector<int> columnBlockList_;
+  CoinBigIndex numberElements_;
+  int numberThreads_;
+  //@}
+};
+
+#endif
@@ -11,6 +11,10 @@
 #include "CoinMpsIO.hpp"
 #include "CoinMessage.hpp"
 #include "CoinFloatEqual.hpp"
+#include "CoinPackedMatrixStructure.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinNameHash.hpp"
+#include "CoinThreadPool.hpp"
 
 //#############################################################################
 // Constructors / Destructor / Assignment
@@ -546,9 +550,10 @@ CoinStructuredModel::refresh(int iBlock)
 */
 int 
 CoinStructuredModel::fillInfo(CoinModelBlockInfo & info,
-			      const CoinModel * block) 
+			      const CoinModel * block, int whatsSet) 
 {
-  int whatsSet = block->whatIsSet();
+  if (whatsSet<0)
+    whatsSet = block->whatIsSet();
   info.matrix = static_cast<char>(((whatsSet&1)!=0) ? 1 : 0);
   info.rhs = static_cast<char>(((whatsSet&2)!=0) ? 1 : 0);
   info.rowName = static_cast<char>(((whatsSet&4)!=0) ? 1 : 0);
@@ -684,14 +689,13 @@ CoinStructuredModel::addBlock(const std::string & rowBlock,
 		   rowLower,rowUpper);
   return addBlock(rowBlock,columnBlock,block);
 }
-/* add a block from a CoinModel without names*/
-int 
-CoinStructuredModel::addBlock(const std::string & rowBlock,
-			      const std::string & columnBlock,
-			      CoinBaseModel * block)
+// Makes room for at least numberBlocks element blocks
+void
+CoinStructuredModel::resizeBlocks(int numberBlocks)
 {
-  if (numberElementBlocks_==maximumElementBlocks_) {
-    maximumElementBlocks_ = 3*(maximumElementBlocks_+10)/2;
+  if (numberBlocks>maximumElementBlocks_) {
+    maximumElementBlocks_ = CoinMax(3*(maximumElementBlocks_+10)/2,
+				    numberBlocks);
     CoinBaseModel ** temp = new CoinBaseModel * [maximumElementBlocks_];
     memcpy(temp,blocks_,numberElementBlocks_*sizeof(CoinBaseModel *));
     delete [] blocks_;
@@ -708,6 +712,14 @@ CoinStructuredModel::addBlock(const std::string & rowBlock,
       coinModelBlocks_ = temp;
     }
   }
+}
+/* add a block from a CoinModel without names*/
+int 
+CoinStructuredModel::addBlock(const std::string & rowBlock,
+			      const std::string & columnBlock,
+			      CoinBaseModel * block)
+{
+  resizeBlocks(numberElementBlocks_+1);
   blocks_[numberElementBlocks_++]=block;
   block->setRowBlock(rowBlock);
   block->setColumnBlock(columnBlock);
@@ -739,6 +751,658 @@ CoinStructuredModel::addBlock(const CoinBaseModel & block)
   return addBlock(block.getRowBlock(),block.getColumnBlock(),
 		  block);
 }
+//#############################################################################
+// Threaded block work.  Decompose runs its three ordering passes at the same
+// time and makes the sub problems of different blocks on different threads.
+// addBlocks converts blocks and writeBlockMps writes them the same way.  The
+// results do not depend on the number of threads.
+
+// Threads used for block work
+static int coinBlockThreads = 1;
+
+typedef struct {
+  // by major (rows for Dantzig-Wolfe, columns for Benders)
+  const CoinBigIndex * start;
+  const int * length;
+  const int * index;
+  const double * element;
+  int numberMajor;
+  int numberMinor;
+  // ordering pass - 0 forwards, 1 backwards, 2 sparsest first
+  int way;
+  // work arrays for pass (majorBlock has numberMajor+1)
+  int * majorBlock;
+  int * minorBlock;
+  int * firstInBlock;
+  int * nextMinor;
+  int * stack;
+  // results of pass
+  double best;
+  int bestMajor;
+  int numberBlocks;
+  // sub problems - majors and minors of each block (master minors last)
+  const int * blockMajor;
+  const int * blockMajorStart;
+  const int * blockMinor;
+  const int * blockMinorStart;
+  // block of each minor and position in its block
+  const int * whichBlock;
+  const int * position;
+  const double * rowLower;
+  const double * rowUpper;
+  const double * columnLower;
+  const double * columnUpper;
+  const double * objective;
+  bool benders;
+  CoinModel ** diagonal;
+  CoinModel ** border;
+  // blocks - this thread does which, which+numberThreads ...
+  int which;
+  int numberThreads;
+  CoinBaseModel ** blocks;
+  CoinModelBlockInfo * info;
+  // what is set (converting) or return code (writing)
+  int * result;
+  CoinModel ** coinBlocks;
+  // writing
+  const char * baseName;
+  int compression;
+  int formatType;
+  int numberAcross;
+  bool keepStrings;
+  /* 0 - ordering pass, 1 - sub problems, 2 - convert blocks,
+     3 - write blocks */
+  int type;
+} CoinBlockThread;
+
+/* One ordering pass of decompose.  Majors are taken in order and each joins
+   (or merges) the blocks of its minors.  After half of them the best point
+   to stop (the rest going into the master) is remembered. */
+static void
+coinDecomposePass(CoinBlockThread & info)
+{
+  const CoinBigIndex * start = info.start;
+  const int * length = info.length;
+  const int * index = info.index;
+  const int numberMajor = info.numberMajor;
+  const int numberMinor = info.numberMinor;
+  int * majorBlock = info.majorBlock;
+  int * minorBlock = info.minorBlock;
+  int * firstInBlock = info.firstInBlock;
+  int * nextMinor = info.nextMinor;
+  int * stack = info.stack;
+  if (info.way==0) {
+    // forwards
+    for (int i=0;i<numberMajor;i++)
+      stack[i]=i;
+  } else if (info.way==1) {
+    // backwards
+    for (int i=0;i<numberMajor;i++)
+      stack[i]=numberMajor-1-i;
+  } else {
+    // sparsest first
+    for (int i=0;i<numberMajor;i++) {
+      majorBlock[i]=length[i];
+      stack[i]=i;
+    }
+    CoinSort_2(majorBlock,majorBlock+numberMajor,stack);
+  }
+  CoinFillN(majorBlock,numberMajor,-1);
+  majorBlock[numberMajor]=0;
+  CoinFillN(firstInBlock,numberMajor,-1);
+  CoinFillN(minorBlock,numberMinor,-1);
+  CoinFillN(nextMinor,numberMinor,-1);
+  int numberMarked = 0;
+  int numberBlocks=0;
+  int bestMajor = -1;
+  int maximumInBlock = 0;
+  int majorsDone=0;
+  int checkAfter = (5*numberMajor)/10+1;
+  double best = COIN_DBL_MAX;
+  int bestDone=-1;
+  int numberGoodBlocks=0;
+  for (int k=0;k<numberMajor;k++) {
+    int iMajor = stack[k];
+    CoinBigIndex kStart = start[iMajor];
+    CoinBigIndex kEnd = kStart+length[iMajor];
+    int iBlock=-1;
+    for (CoinBigIndex j=kStart;j<kEnd;j++) {
+      int iMinor = index[j];
+      if (minorBlock[iMinor]>=0) {
+	// already marked
+	if (iBlock<0) {
+	  iBlock = minorBlock[iMinor];
+	} else if (iBlock != minorBlock[iMinor]) {
+	  // join two blocks
+	  int jBlock = minorBlock[iMinor];
+	  numberGoodBlocks--;
+	  // Increase count of iBlock
+	  majorBlock[iBlock] += majorBlock[jBlock];
+	  majorBlock[jBlock]=0;
+	  // First minor of block jBlock
+	  int jMinor = firstInBlock[jBlock];
+	  while (jMinor>=0) {
+	    minorBlock[jMinor]=iBlock;
+	    iMinor = jMinor;
+	    jMinor = nextMinor[jMinor];
+	  }
+	  nextMinor[iMinor] = firstInBlock[iBlock];
+	  firstInBlock[iBlock] = firstInBlock[jBlock];
+	  firstInBlock[jBlock]=-1;
+	}
+      }
+    }
+    int n=static_cast<int>(kEnd-kStart);
+    // If not in block - then start one
+    if (iBlock<0) {
+      // unless empty
+      if (n) {
+	iBlock = numberBlocks;
+	numberBlocks++;
+	numberGoodBlocks++;
+	int jMinor = index[kStart];
+	minorBlock[jMinor]=iBlock;
+	firstInBlock[iBlock]=jMinor;
+	numberMarked += n;
+	majorBlock[iBlock] = n;
+	for (CoinBigIndex j=kStart+1;j<kEnd;j++) {
+	  int iMinor = index[j];
+	  minorBlock[iMinor]=iBlock;
+	  nextMinor[jMinor]=iMinor;
+	  jMinor=iMinor;
+	}
+      } else {
+	majorBlock[numberMajor]++;
+      }
+    } else {
+      // add all to this block if not already in
+      int jMinor = firstInBlock[iBlock];
+      for (CoinBigIndex j=kStart;j<kEnd;j++) {
+	int iMinor = index[j];
+	if (minorBlock[iMinor]<0) {
+	  numberMarked++;
+	  majorBlock[iBlock]++;
+	  minorBlock[iMinor]=iBlock;
+	  nextMinor[iMinor]=jMinor;
+	  jMinor=iMinor;
+	}
+      }
+      firstInBlock[iBlock]=jMinor;
+    }
+    majorsDone++;
+    if (iBlock>=0) 
+      maximumInBlock = CoinMax(maximumInBlock,majorBlock[iBlock]);
+    if (majorsDone>=checkAfter) {
+      assert (numberGoodBlocks>0);
+      if (maximumInBlock*10<numberMinor*11&&numberGoodBlocks>1) {
+	double test = maximumInBlock;
+	if(best*static_cast<double>(majorsDone) > test) {
+	  best = test/static_cast<double> (majorsDone); 
+	  bestMajor = k;
+	  bestDone=majorsDone;
+	}
+      }
+    }	      
+  }
+  if (bestDone<numberMajor)
+    info.best=-(numberMajor-bestDone);
+  else
+    info.best=-numberMajor;
+  info.bestMajor=bestMajor;
+  info.numberBlocks=numberBlocks;
+}
+
+/* Makes diagonal and border (master minors) sub problems of a block.
+   Blocks are built by major and for Benders turned round */
+static void
+coinDecomposeBlock(const CoinBlockThread & info, int iBlock)
+{
+  const int numberBlocks = info.numberBlocks;
+  const int * major = info.blockMajor+info.blockMajorStart[iBlock];
+  const int numberMajor = info.blockMajorStart[iBlock+1]-
+    info.blockMajorStart[iBlock];
+  const int * minor = info.blockMinor+info.blockMinorStart[iBlock];
+  const int numberMinor = info.blockMinorStart[iBlock+1]-
+    info.blockMinorStart[iBlock];
+  const int * master = info.blockMinor+info.blockMinorStart[numberBlocks];
+  const int numberMaster = info.blockMinorStart[numberBlocks+1]-
+    info.blockMinorStart[numberBlocks];
+  const CoinBigIndex * start = info.start;
+  const int * length = info.length;
+  const int * index = info.index;
+  const double * element = info.element;
+  const int * whichBlock = info.whichBlock;
+  const int * position = info.position;
+  // count
+  CoinBigIndex * startDiagonal = new CoinBigIndex [numberMajor+1];
+  CoinBigIndex * startBorder = new CoinBigIndex [numberMajor+1];
+  CoinBigIndex numberDiagonal=0;
+  CoinBigIndex numberBorder=0;
+  startDiagonal[0]=0;
+  startBorder[0]=0;
+  for (int i=0;i<numberMajor;i++) {
+    int iMajor = major[i];
+    for (CoinBigIndex j=start[iMajor];j<start[iMajor]+length[iMajor];j++) {
+      int jBlock = whichBlock[index[j]];
+      if (jBlock==iBlock)
+	numberDiagonal++;
+      else if (jBlock<0)
+	numberBorder++;
+    }
+    startDiagonal[i+1]=numberDiagonal;
+    startBorder[i+1]=numberBorder;
+  }
+  int * indexDiagonal = new int [CoinMax(numberDiagonal,static_cast<CoinBigIndex>(1))];
+  double * elementDiagonal = new double [CoinMax(numberDiagonal,static_cast<CoinBigIndex>(1))];
+  int * indexBorder = new int [CoinMax(numberBorder,static_cast<CoinBigIndex>(1))];
+  double * elementBorder = new double [CoinMax(numberBorder,static_cast<CoinBigIndex>(1))];
+  numberDiagonal=0;
+  numberBorder=0;
+  for (int i=0;i<numberMajor;i++) {
+    int iMajor = major[i];
+    for (CoinBigIndex j=start[iMajor];j<start[iMajor]+length[iMajor];j++) {
+      int iMinor = index[j];
+      int jBlock = whichBlock[iMinor];
+      if (jBlock==iBlock) {
+	indexDiagonal[numberDiagonal]=position[iMinor];
+	elementDiagonal[numberDiagonal++]=element[j];
+      } else if (jBlock<0) {
+	indexBorder[numberBorder]=position[iMinor];
+	elementBorder[numberBorder++]=element[j];
+      }
+    }
+  }
+  // matrices take arrays
+  int * length2 = NULL;
+  CoinPackedMatrix diagonal;
+  diagonal.assignMatrix(!info.benders,numberMinor,numberMajor,numberDiagonal,
+			elementDiagonal,indexDiagonal,startDiagonal,length2);
+  CoinPackedMatrix border;
+  border.assignMatrix(!info.benders,numberMaster,numberMajor,numberBorder,
+		      elementBorder,indexBorder,startBorder,length2);
+  if (!info.benders) {
+    // Dantzig-Wolfe - majors are columns and border is in master rows
+    double * rowLo = new double [numberMinor];
+    double * rowUp = new double [numberMinor];
+    for (int i=0;i<numberMinor;i++) {
+      rowLo[i]=info.rowLower[minor[i]];
+      rowUp[i]=info.rowUpper[minor[i]];
+    }
+    CoinModel * block = new CoinModel(numberMinor,numberMajor,&diagonal,
+				      rowLo,rowUp,NULL,NULL,NULL);
+    block->setOriginalIndices(minor,major);
+    info.diagonal[iBlock]=block;
+    delete [] rowLo;
+    delete [] rowUp;
+    double * obj = new double [numberMajor];
+    double * columnLo = new double [numberMajor];
+    double * columnUp = new double [numberMajor];
+    for (int i=0;i<numberMajor;i++) {
+      obj[i]=info.objective[major[i]];
+      columnLo[i]=info.columnLower[major[i]];
+      columnUp[i]=info.columnUpper[major[i]];
+    }
+    block = new CoinModel(numberMaster,numberMajor,&border,
+			  NULL,NULL,columnLo,columnUp,obj);
+    block->setOriginalIndices(master,major);
+    info.border[iBlock]=block;
+    delete [] obj;
+    delete [] columnLo;
+    delete [] columnUp;
+  } else {
+    // Benders - majors are rows and border is in master columns
+    diagonal.reverseOrdering();
+    border.reverseOrdering();
+    double * rowLo = new double [numberMajor];
+    double * rowUp = new double [numberMajor];
+    for (int i=0;i<numberMajor;i++) {
+      rowLo[i]=info.rowLower[major[i]];
+      rowUp[i]=info.rowUpper[major[i]];
+    }
+    double * obj = new double [numberMinor];
+    double * columnLo = new double [numberMinor];
+    double * columnUp = new double [numberMinor];
+    for (int i=0;i<numberMinor;i++) {
+      obj[i]=info.objective[minor[i]];
+      columnLo[i]=info.columnLower[minor[i]];
+      columnUp[i]=info.columnUpper[minor[i]];
+    }
+    CoinModel * block = new CoinModel(numberMajor,numberMinor,&diagonal,
+				      rowLo,rowUp,columnLo,columnUp,obj);
+    block->setOriginalIndices(major,minor);
+    info.diagonal[iBlock]=block;
+    delete [] rowLo;
+    delete [] rowUp;
+    delete [] obj;
+    delete [] columnLo;
+    delete [] columnUp;
+    block = new CoinModel(numberMajor,numberMaster,&border,
+			  NULL,NULL,NULL,NULL,NULL);
+    block->setOriginalIndices(major,master);
+    info.border[iBlock]=block;
+  }
+}
+
+static void *
+coinBlockWorker(void * threadInfo)
+{
+  CoinBlockThread & info = *reinterpret_cast<CoinBlockThread *>(threadInfo);
+  switch (info.type) {
+  case 0:
+    coinDecomposePass(info);
+    break;
+  case 1:
+    for (int iBlock=info.which;iBlock<info.numberBlocks;
+	 iBlock+=info.numberThreads)
+      coinDecomposeBlock(info,iBlock);
+    break;
+  case 2:
+    for (int iBlock=info.which;iBlock<info.numberBlocks;
+	 iBlock+=info.numberThreads) {
+      CoinModel * block = dynamic_cast<CoinModel *>(info.blocks[iBlock]);
+      if (block) {
+	// Convert matrix
+	if (block->type()!=3)
+	  block->convertMatrix();
+	info.result[iBlock]=block->whatIsSet();
+      } else {
+	CoinStructuredModel * subModel =
+	  dynamic_cast<CoinStructuredModel *>(info.blocks[iBlock]);
+	assert (subModel);
+	info.coinBlocks[iBlock]=subModel->coinModelBlock(info.info[iBlock]);
+      }
+    }
+    break;
+  case 3:
+    for (int iBlock=info.which;iBlock<info.numberBlocks;
+	 iBlock+=info.numberThreads) {
+      CoinModel * block = info.coinBlocks[iBlock];
+      if (block) {
+	char * name = new char [strlen(info.baseName)+20];
+	sprintf(name,"%s_%d.mps",info.baseName,iBlock);
+	info.result[iBlock]=block->writeMps(name,info.compression,
+					    info.formatType,info.numberAcross,
+					    info.keepStrings);
+	delete [] name;
+      } else {
+	info.result[iBlock]=-1;
+      }
+    }
+    break;
+  }
+  return NULL;
+}
+// Runs all threads - first one in this thread
+static void
+coinBlockRun(CoinBlockThread * thread, int numberThreads, int type)
+{
+  for (int i = 0; i < numberThreads; i++)
+    thread[i].type = type;
+  CoinThreadPool::run(coinBlockWorker, thread, sizeof(CoinBlockThread),
+		      numberThreads);
+}
+// Sets up thread information for blocks (which to do, what else is zero)
+static CoinBlockThread *
+coinBlockThreadInfo(int numberBlocks, int & numberThreads)
+{
+  numberThreads = CoinMax(CoinMin(coinBlockThreads,numberBlocks),1);
+  CoinBlockThread * thread = new CoinBlockThread [numberThreads];
+  memset(thread,0,numberThreads*sizeof(CoinBlockThread));
+  for (int i=0;i<numberThreads;i++) {
+    thread[i].which=i;
+    thread[i].numberThreads=numberThreads;
+    thread[i].numberBlocks=numberBlocks;
+  }
+  return thread;
+}
+/* Runs the three ordering passes of decompose (at the same time if threads
+   allowed).  The arrays given are used by the sorted pass and so are left
+   as after it (as if the passes had been done one after another).  Returns
+   number of blocks found by sorted pass */
+static int
+coinDecomposeOrdering(const CoinBigIndex * start, const int * length,
+		      const int * index, int numberMajor, int numberMinor,
+		      int * majorBlock, int * minorBlock, int * firstInBlock,
+		      int * nextMinor, int * stack,
+		      double * best, int * bestMajor)
+{
+  CoinBlockThread pass[3];
+  memset(pass,0,sizeof(pass));
+  for (int iWay=0;iWay<3;iWay++) {
+    CoinBlockThread & info = pass[iWay];
+    info.start=start;
+    info.length=length;
+    info.index=index;
+    info.numberMajor=numberMajor;
+    info.numberMinor=numberMinor;
+    info.way=iWay;
+    if (iWay==2) {
+      info.majorBlock=majorBlock;
+      info.minorBlock=minorBlock;
+      info.firstInBlock=firstInBlock;
+      info.nextMinor=nextMinor;
+      info.stack=stack;
+    } else {
+      info.majorBlock=new int [numberMajor+1];
+      info.minorBlock=new int [numberMinor];
+      info.firstInBlock=new int [numberMajor];
+      info.nextMinor=new int [numberMinor];
+      info.stack=new int [numberMajor];
+    }
+  }
+  coinBlockRun(pass,3,0);
+  for (int iWay=0;iWay<3;iWay++) {
+    CoinBlockThread & info = pass[iWay];
+    best[iWay]=info.best;
+    bestMajor[iWay]=info.bestMajor;
+    if (iWay<2) {
+      delete [] info.majorBlock;
+      delete [] info.minorBlock;
+      delete [] info.firstInBlock;
+      delete [] info.nextMinor;
+      delete [] info.stack;
+    }
+  }
+  return pass[2].numberBlocks;
+}
+/* Lists of members of each block in order with master (negative block)
+   as block numberBlocks.  position is place in list of block */
+static void
+coinBlockLists(const int * whichBlock, int number, int numberBlocks,
+	       int * list, int * listStart, int * position)
+{
+  CoinZeroN(listStart,numberBlocks+2);
+  for (int i=0;i<number;i++) {
+    int iBlock = whichBlock[i]>=0 ? whichBlock[i] : numberBlocks;
+    listStart[iBlock+1]++;
+  }
+  for (int iBlock=0;iBlock<=numberBlocks;iBlock++)
+    listStart[iBlock+1]+=listStart[iBlock];
+  for (int i=0;i<number;i++) {
+    int iBlock = whichBlock[i]>=0 ? whichBlock[i] : numberBlocks;
+    int put = listStart[iBlock]++;
+    list[put]=i;
+  }
+  for (int iBlock=numberBlocks;iBlock>0;iBlock--)
+    listStart[iBlock]=listStart[iBlock-1];
+  listStart[0]=0;
+  for (int iBlock=0;iBlock<=numberBlocks;iBlock++) {
+    for (int k=listStart[iBlock];k<listStart[iBlock+1];k++)
+      position[list[k]]=k-listStart[iBlock];
+  }
+}
+/* Makes diagonal and border sub problems of all blocks (on threads).
+   Majors are columns for Dantzig-Wolfe and rows for Benders */
+static void
+coinDecomposeBlocks(const CoinBigIndex * start, const int * length,
+		    const int * index, const double * element,
+		    int numberMajor, const int * majorBlock,
+		    int numberMinor, const int * minorBlock, int numberBlocks,
+		    const double * rowLower, const double * rowUpper,
+		    const double * columnLower, const double * columnUpper,
+		    const double * objective, bool benders,
+		    CoinModel ** diagonal, CoinModel ** border)
+{
+  int * blockMajor = new int [numberMajor];
+  int * blockMajorStart = new int [numberBlocks+2];
+  int * majorPosition = new int [numberMajor];
+  coinBlockLists(majorBlock,numberMajor,numberBlocks,
+		 blockMajor,blockMajorStart,majorPosition);
+  delete [] majorPosition;
+  int * blockMinor = new int [numberMinor];
+  int * blockMinorStart = new int [numberBlocks+2];
+  int * minorPosition = new int [numberMinor];
+  coinBlockLists(minorBlock,numberMinor,numberBlocks,
+		 blockMinor,blockMinorStart,minorPosition);
+  int numberThreads;
+  CoinBlockThread * thread = coinBlockThreadInfo(numberBlocks,numberThreads);
+  for (int i=0;i<numberThreads;i++) {
+    CoinBlockThread & info = thread[i];
+    info.start=start;
+    info.length=length;
+    info.index=index;
+    info.element=element;
+    info.blockMajor=blockMajor;
+    info.blockMajorStart=blockMajorStart;
+    info.blockMinor=blockMinor;
+    info.blockMinorStart=blockMinorStart;
+    info.whichBlock=minorBlock;
+    info.position=minorPosition;
+    info.rowLower=rowLower;
+    info.rowUpper=rowUpper;
+    info.columnLower=columnLower;
+    info.columnUpper=columnUpper;
+    info.objective=objective;
+    info.benders=benders;
+    info.diagonal=diagonal;
+    info.border=border;
+  }
+  coinBlockRun(thread,numberThreads,1);
+  delete [] thread;
+  delete [] blockMajor;
+  delete [] blockMajorStart;
+  delete [] blockMinor;
+  delete [] blockMinorStart;
+  delete [] minorPosition;
+}
+
+void
+CoinStructuredModel::setBlockThreads(int numberThreads)
+{
+#ifdef COINUTILS_PTHREADS
+  coinBlockThreads = CoinMax(numberThreads, 1);
+#else
+  coinBlockThreads = 1;
+  (void) numberThreads;
+#endif
+}
+
+int
+CoinStructuredModel::blockThreads()
+{
+  return coinBlockThreads;
+}
+
+/* add blocks - structured model takes ownership.  Matrices are converted
+   and what is set found on threads.  Returns number of errors */
+int
+CoinStructuredModel::addBlocks(int numberBlocks,
+			       const std::string * rowBlocks,
+			       const std::string * columnBlocks,
+			       CoinBaseModel ** blocks)
+{
+  if (numberBlocks<=0)
+    return 0;
+  resizeBlocks(numberElementBlocks_+numberBlocks);
+  for (int i=0;i<numberBlocks;i++) {
+    blocks[i]->setRowBlock(rowBlocks[i]);
+    blocks[i]->setColumnBlock(columnBlocks[i]);
+  }
+  int * whatsSet = new int [numberBlocks];
+  CoinModel ** coinBlocks = new CoinModel * [numberBlocks];
+  CoinZeroN(coinBlocks,numberBlocks);
+  int numberThreads;
+  CoinBlockThread * thread = coinBlockThreadInfo(numberBlocks,numberThreads);
+  for (int i=0;i<numberThreads;i++) {
+    thread[i].blocks=blocks;
+    thread[i].info=blockType_+numberElementBlocks_;
+    thread[i].result=whatsSet;
+    thread[i].coinBlocks=coinBlocks;
+  }
+  coinBlockRun(thread,numberThreads,2);
+  delete [] thread;
+  // counts and checks in order
+  int numberErrors=0;
+  for (int i=0;i<numberBlocks;i++) {
+    CoinBaseModel * block = blocks[i];
+    blocks_[numberElementBlocks_++]=block;
+    CoinModel * coinBlock = dynamic_cast<CoinModel *>(block);
+    if (coinBlock) {
+      numberErrors += fillInfo(blockType_[numberElementBlocks_-1],coinBlock,
+			       whatsSet[i]);
+    } else {
+      CoinStructuredModel * subModel =
+	dynamic_cast<CoinStructuredModel *>(block);
+      fillInfo(blockType_[numberElementBlocks_-1],subModel);
+      setCoinModel(coinBlocks[i],numberElementBlocks_-1);
+    }
+  }
+  delete [] whatsSet;
+  delete [] coinBlocks;
+  return numberErrors;
+}
+/* Write each block (as CoinModel) to baseName_i.mps on threads.
+   Returns number of blocks not written */
+int
+CoinStructuredModel::writeBlockMps(const char * baseName, int compression,
+				   int formatType, int numberAcross,
+				   bool keepStrings)
+{
+  int numberBlocks = numberElementBlocks_;
+  if (!numberBlocks)
+    return 0;
+  int * returnCode = new int [numberBlocks];
+  CoinModel ** coinBlocks = new CoinModel * [numberBlocks];
+  for (int i=0;i<numberBlocks;i++)
+    coinBlocks[i]=coinBlock(i);
+  int numberThreads;
+  CoinBlockThread * thread = coinBlockThreadInfo(numberBlocks,numberThreads);
+  for (int i=0;i<numberThreads;i++) {
+    thread[i].result=returnCode;
+    thread[i].coinBlocks=coinBlocks;
+    thread[i].baseName=baseName;
+    thread[i].compression=compression;
+    thread[i].formatType=formatType;
+    thread[i].numberAcross=numberAcross;
+    thread[i].keepStrings=keepStrings;
+  }
+  coinBlockRun(thread,numberThreads,3);
+  delete [] thread;
+  int numberErrors=0;
+  for (int i=0;i<numberBlocks;i++) {
+    if (returnCode[i])
+      numberErrors++;
+  }
+  delete [] returnCode;
+  delete [] coinBlocks;
+  return numberErrors;
+}
+/* Write the problem in MPS format to a file with the given filename.
+   Blocks are put together as one CoinModel */
+int
+CoinStructuredModel::writeMps(const char *filename, int compression,
+			      int formatType, int numberAcross,
+			      bool keepStrings)
+{
+  CoinModelBlockInfo info;
+  CoinModel * block = coinModelBlock(info);
+  block->setProblemName(problemName_.c_str());
+  block->setOptimizationDirection(optimizationDirection_);
+  int returnCode = block->writeMps(filename,compression,formatType,
+				   numberAcross,keepStrings);
+  delete block;
+  return returnCode;
+}
 /* Decompose a model specified as arrays + CoinPackedMatrix
    1 - try D-W
    2 - try Benders
@@ -797,183 +1461,13 @@ CoinStructuredModel::decompose(const CoinPackedMatrix & matrix,
     int * whichColumn = new int [numberColumns];
     int * stack = new int [numberRows];
     if (newWay && !starts) {
-      //double best2[3]={COIN_DBL_MAX,COIN_DBL_MAX,COIN_DBL_MAX};
-      double best2[3]={0.0,0.0,0.0};
-      int row2[3]={-1,-1,-1};
-      // try forward and backward and sorted
-      for (int iWay=0;iWay<3;iWay++) {
-	if (iWay==0) {
-	  // forwards
-	  for (int i=0;i<numberRows;i++)
-	    stack[i]=i;
-	} else if (iWay==1) {
-	  // backwards
-	  for (int i=0;i<numberRows;i++)
-	    stack[i]=numberRows-1-i;
-	} else {
-	  // sparsest first
-	  for (int i=0;i<numberRows;i++) {
-	    rowBlock[i]=rowLength[i];
-	    stack[i]=i;
-	  }
-	  CoinSort_2(rowBlock,rowBlock+numberRows,stack);
-	}
-	CoinFillN(rowBlock,numberRows,-1);
-	rowBlock[numberRows]=0;
-	CoinFillN(whichRow,numberRows,-1);
-	CoinFillN(columnBlock,numberColumns,-1);
-	CoinFillN(whichColumn,numberColumns,-1);
-	int numberMarkedColumns = 0;
-	numberBlocks=0;
-	int bestRow = -1;
-	int maximumInBlock = 0;
-	int rowsDone=0;
-	int checkAfterRows = (5*numberRows)/10+1;
-#define OSL_WAY
-#ifdef OSL_WAY
-	double best = COIN_DBL_MAX;
-	int bestRowsDone=-1;
-#else
-	double best = 0.0; //COIN_DBL_MAX;
-#endif
-	int numberGoodBlocks=0;
-	
-	for (int kRow=0;kRow<numberRows;kRow++) {
-	  iRow = stack[kRow];
-	  CoinBigIndex start = rowStart[iRow];
-	  CoinBigIndex end = start+rowLength[iRow];
-	  int iBlock=-1;
-	  for (CoinBigIndex j=start;j<end;j++) {
-	    int iColumn = column[j];
-	    if (columnBlock[iColumn]>=0) {
-	      // already marked
-	      if (iBlock<0) {
-		iBlock = columnBlock[iColumn];
-	      } else if (iBlock != columnBlock[iColumn]) {
-		// join two blocks
-		int jBlock = columnBlock[iColumn];
-		numberGoodBlocks--;
-		// Increase count of iBlock
-		rowBlock[iBlock] += rowBlock[jBlock];
-		rowBlock[jBlock]=0;
-		// First column of block jBlock
-		int jColumn = whichRow[jBlock];
-		while (jColumn>=0) {
-		  columnBlock[jColumn]=iBlock;
-		  iColumn = jColumn;
-		  jColumn = whichColumn[jColumn];
-		}
-		whichColumn[iColumn] = whichRow[iBlock];
-		whichRow[iBlock] = whichRow[jBlock];
-		whichRow[jBlock]=-1;
-	      }
-	    }
-	  }
-	  int n=end-start;
-	  // If not in block - then start one
-	  if (iBlock<0) {
-	    // unless null row
-	    if (n) {
-	      iBlock = numberBlocks;
-	      numberBlocks++;
-	      numberGoodBlocks++;
-	      int jColumn = column[start];
-	      columnBlock[jColumn]=iBlock;
-	      whichRow[iBlock]=jColumn;
-	      numberMarkedColumns += n;
-	      rowBlock[iBlock] = n;
-	      for (CoinBigIndex j=start+1;j<end;j++) {
-		int iColumn = column[j];
-		columnBlock[iColumn]=iBlock;
-		whichColumn[jColumn]=iColumn;
-		jColumn=iColumn;
-	      }
-	    } else {
-	      rowBlock[numberRows]++;
-	    }
-	  } else {
-	    // add all to this block if not already in
-	    int jColumn = whichRow[iBlock];
-	    for (CoinBigIndex j=start;j<end;j++) {
-	      int iColumn = column[j];
-	      if (columnBlock[iColumn]<0) {
-		numberMarkedColumns++;
-		rowBlock[iBlock]++;
-		columnBlock[iColumn]=iBlock;
-		whichColumn[iColumn]=jColumn;
-		jColumn=iColumn;
-	      }
-	    }
-	    whichRow[iBlock]=jColumn;
-	  }
-#if 0
-	  {
-	    int nn=0;
-	    int * temp = new int [numberRows];
-	    CoinZeroN(temp,numberRows);
-	    for (int i=0;i<numberColumns;i++) {
-	      int iBlock = columnBlock[i];
-	      if (iBlock>=0) {
-		nn++;
-		assert (iBlock<numberBlocks);
-		temp[iBlock]++;
-	      }
-	    }
-	    for (int i=0;i<numberBlocks;i++)
-	      assert (temp[i]==rowBlock[i]);
-	    assert (nn==numberMarkedColumns);
-	    for (int i=0;i<numberBlocks;i++) {
-	      // First column of block i
-	      int jColumn = whichRow[i];
-	      int n=0;
-	      while (jColumn>=0) {
-		n++;
-		jColumn = whichColumn[jColumn];
-	      }
-	      assert (n==temp[i]);
-	    }
-	    delete [] temp;
-	  }
-#endif
-	  rowsDone++;
-	  if (iBlock>=0) 
-	    maximumInBlock = CoinMax(maximumInBlock,rowBlock[iBlock]);
-	  if (rowsDone>=checkAfterRows) {
-	    assert (numberGoodBlocks>0);
-	    double averageSize = static_cast<double>(numberMarkedColumns)/
-	      static_cast<double>(numberGoodBlocks);
-#ifndef OSL_WAY
-	    double notionalBlocks = static_cast<double>(numberMarkedColumns)/
-	      averageSize;
-	    if (maximumInBlock<3*averageSize&&numberGoodBlocks>2) {
-	      if(best*(numberRows-rowsDone) < notionalBlocks) {
-		best = notionalBlocks/
-		  static_cast<double> (numberRows-rowsDone); 
-		bestRow = kRow;
-	      }
-	    }
-#else
-	    if (maximumInBlock*10<numberColumns*11&&numberGoodBlocks>1) {
-	      double test = maximumInBlock + 0.0*averageSize;
-	      if(best*static_cast<double>(rowsDone) > test) {
-		best = test/static_cast<double> (rowsDone); 
-		bestRow = kRow;
-		bestRowsDone=rowsDone;
-	      }
-	    }
-#endif
-	  }	      
-	}
-#ifndef OSL_WAY
-	best2[iWay]=best;
-#else
-	if (bestRowsDone<numberRows)
-	  best2[iWay]=-(numberRows-bestRowsDone);
-	else
-	  best2[iWay]=-numberRows;
-#endif
-	row2[iWay]=bestRow;
-      }
+      double best2[3];
+      int row2[3];
+      // try forward and backward and sorted (at same time if threads)
+      numberBlocks = coinDecomposeOrdering(rowStart,rowLength,column,
+					   numberRows,numberColumns,
+					   rowBlock,columnBlock,whichRow,
+					   whichColumn,stack,best2,row2);
       // mark rows
       int nMaster;
       CoinFillN(rowBlock,numberRows,-2);
@@ -1084,56 +1578,19 @@ CoinStructuredModel::decompose(const CoinPackedMatrix & matrix,
       }
     }
     if (!starts) {
-      numberBlocks=0;
-      CoinFillN(columnBlock,numberColumns,-2);
-    }
-    for (iColumn=0;iColumn<numberColumns;iColumn++) {
-      int kstart = columnStart[iColumn];
-      int kend = columnStart[iColumn]+columnLength[iColumn];
-      if (columnBlock[iColumn]==-2) {
-	// column not allocated
-	int j;
-	int nstack=0;
-	for (j=kstart;j<kend;j++) {
-	  int iRow= row[j];
-	  if (rowBlock[iRow]!=-1) {
-	    assert(rowBlock[iRow]==-2);
-	    rowBlock[iRow]=numberBlocks; // mark
-	    stack[nstack++] = iRow;
-	  }
-	}
-	if (nstack) {
-	  // new block - put all connected in
-	  numberBlocks++;
-	  columnBlock[iColumn]=numberBlocks-1;
-	  while (nstack) {
-	    int iRow = stack[--nstack];
-	    int k;
-	    for (k=rowStart[iRow];k<rowStart[iRow]+rowLength[iRow];k++) {
-	      int iColumn = column[k];
-	      int kkstart = columnStart[iColumn];
-	      int kkend = kkstart + columnLength[iColumn];
-	      if (columnBlock[iColumn]==-2) {
-		columnBlock[iColumn]=numberBlocks-1; // mark
-		// column not allocated
-		int jj;
-		for (jj=kkstart;jj<kkend;jj++) {
-		  int jRow= row[jj];
-		  if (rowBlock[jRow]==-2) {
-		    rowBlock[jRow]=numberBlocks-1;
-		    stack[nstack++]=jRow;
-		  }
-		}
-	      } else {
-		assert (columnBlock[iColumn]==numberBlocks-1);
-	      }
-	    }
-	  }
-	} else {
-	  // Only in master
-	  columnBlock[iColumn]=-1;
-	}
+      // blocks are connected components once master rows are left out
+      char * masterRow = new char [numberRows];
+      for (iRow=0;iRow<numberRows;iRow++)
+	masterRow[iRow] = (rowBlock[iRow]==-1) ? 1 : 0;
+      CoinPackedMatrixStructure structure;
+      numberBlocks = structure.findComponents(matrix,masterRow);
+      const int * rowComponent = structure.rowComponent();
+      for (iRow=0;iRow<numberRows;iRow++) {
+	if (rowBlock[iRow]==-2&&rowComponent[iRow]>=0)
+	  rowBlock[iRow]=rowComponent[iRow];
       }
+      CoinMemcpyN(structure.columnComponent(),numberColumns,columnBlock);
+      delete [] masterRow;
     }
     delete [] stack;
     int numberMasterRows=0;
@@ -1243,62 +1700,26 @@ CoinStructuredModel::decompose(const CoinPackedMatrix & matrix,
     }
     // Name for master so at top
     addRowBlock(numberMasterRows,"row_master");
-    // Arrays
-    // get full matrix
-    CoinPackedMatrix fullMatrix = matrix;
-    int numberRow2,numberColumn2;
-    int iBlock;
-    for (iBlock=0;iBlock<numberBlocks;iBlock++) {
+    // Make diagonal and top blocks (on threads) and add in order
+    CoinModel ** diagonal = new CoinModel * [numberBlocks];
+    CoinModel ** border = new CoinModel * [numberBlocks];
+    coinDecomposeBlocks(columnStart,columnLength,row,matrix.getElements(),
+			numberColumns,columnBlock,numberRows,rowBlock,
+			numberBlocks,rowLower,rowUpper,columnLower,columnUpper,
+			objective,false,diagonal,border);
+    for (int iBlock=0;iBlock<numberBlocks;iBlock++) {
       char rowName[20];
       sprintf(rowName,"row_%d",iBlock);
       char columnName[20];
       sprintf(columnName,"column_%d",iBlock);
-      numberRow2=0;
-      numberColumn2=0;
-      for (iRow=0;iRow<numberRows;iRow++) {
-	if (iBlock==rowBlock[iRow]) {
-	  rowLo[numberRow2]=rowLower[iRow];
-	  rowUp[numberRow2]=rowUpper[iRow];
-	  whichRow[numberRow2++]=iRow;
-	}
-      }
-      for (iColumn=0;iColumn<numberColumns;iColumn++) {
-	if (iBlock==columnBlock[iColumn]) {
-	  obj[numberColumn2]=objective[iColumn];
-	  columnLo[numberColumn2]=columnLower[iColumn];
-	  columnUp[numberColumn2]=columnUpper[iColumn];
-	  whichColumn[numberColumn2++]=iColumn;
-	}
-      }
-      // Diagonal block
-      CoinPackedMatrix mat(fullMatrix,
-			   numberRow2,whichRow,
-			   numberColumn2,whichColumn);
-      // make sure correct dimensions
-      mat.setDimensions(numberRow2,numberColumn2);
-      CoinModel * block = new CoinModel(numberRow2,numberColumn2,&mat,
-					rowLo,rowUp,NULL,NULL,NULL);
-      block->setOriginalIndices(whichRow,whichColumn);
-      addBlock(rowName,columnName,block); // takes ownership
-      // and top block
-      numberRow2=0;
-      // get top matrix
-      for (iRow=0;iRow<numberRows;iRow++) {
-	int iBlock = rowBlock[iRow];
-	if (iBlock==-1) {
-	  whichRow[numberRow2++]=iRow;
-	}
-      }
-      CoinPackedMatrix top(fullMatrix,
-			   numberRow2,whichRow,
-			   numberColumn2,whichColumn);
-      // make sure correct dimensions
-      top.setDimensions(numberRow2,numberColumn2);
-      block = new CoinModel(numberMasterRows,numberColumn2,&top,
-			    NULL,NULL,columnLo,columnUp,obj);
-      block->setOriginalIndices(whichRow,whichColumn);
-      addBlock("row_master",columnName,block); // takes ownership
+      addBlock(rowName,columnName,diagonal[iBlock]); // takes ownership
+      addBlock("row_master",columnName,border[iBlock]); // takes ownership
     }
+    delete [] diagonal;
+    delete [] border;
+    // get full matrix
+    CoinPackedMatrix fullMatrix = matrix;
+    int numberRow2,numberColumn2;
     // and master
     numberRow2=0;
     numberColumn2=0;
@@ -1383,153 +1804,13 @@ CoinStructuredModel::decompose(const CoinPackedMatrix & matrix,
     int * whichColumn = new int [numberColumns];
     int * stack = new int [numberColumns];
     if (newWay) {
-      //double best2[3]={COIN_DBL_MAX,COIN_DBL_MAX,COIN_DBL_MAX};
-      double best2[3]={0.0,0.0,0.0};
-      int column2[3]={-1,-1,-1};
-      // try forward and backward and sorted
-      for (int iWay=0;iWay<3;iWay++) {
-	if (iWay==0) {
-	  // forwards
-	  for (int i=0;i<numberColumns;i++)
-	    stack[i]=i;
-	} else if (iWay==1) {
-	  // backwards
-	  for (int i=0;i<numberColumns;i++)
-	    stack[i]=numberColumns-1-i;
-	} else {
-	  // sparsest first
-	  for (int i=0;i<numberColumns;i++) {
-	    columnBlock[i]=columnLength[i];
-	    stack[i]=i;
-	  }
-	  CoinSort_2(columnBlock,columnBlock+numberColumns,stack);
-	}
-	CoinFillN(columnBlock,numberColumns,-1);
-	columnBlock[numberColumns]=0;
-	CoinFillN(whichColumn,numberColumns,-1);
-	CoinFillN(rowBlock,numberRows,-1);
-	CoinFillN(whichRow,numberRows,-1);
-	int numberMarkedRows = 0;
-	numberBlocks=0;
-	int bestColumn = -1;
-	int maximumInBlock = 0;
-	int columnsDone=0;
-	int checkAfterColumns = (5*numberColumns)/10+1;
-#ifdef OSL_WAY
-	double best = COIN_DBL_MAX;
-	int bestColumnsDone=-1;
-#else
-	double best = 0.0; //COIN_DBL_MAX;
-#endif
-	int numberGoodBlocks=0;
-	
-	for (int kColumn=0;kColumn<numberColumns;kColumn++) {
-	  iColumn = stack[kColumn];
-	  CoinBigIndex start = columnStart[iColumn];
-	  CoinBigIndex end = start+columnLength[iColumn];
-	  int iBlock=-1;
-	  for (CoinBigIndex j=start;j<end;j++) {
-	    int iRow = row[j];
-	    if (rowBlock[iRow]>=0) {
-	      // already marked
-	      if (iBlock<0) {
-		iBlock = rowBlock[iRow];
-	      } else if (iBlock != rowBlock[iRow]) {
-		// join two blocks
-		int jBlock = rowBlock[iRow];
-		numberGoodBlocks--;
-		// Increase count of iBlock
-		columnBlock[iBlock] += columnBlock[jBlock];
-		columnBlock[jBlock]=0;
-		// First row of block jBlock
-		int jRow = whichColumn[jBlock];
-		while (jRow>=0) {
-		  rowBlock[jRow]=iBlock;
-		  iRow = jRow;
-		  jRow = whichRow[jRow];
-		}
-		whichRow[iRow] = whichColumn[iBlock];
-		whichColumn[iBlock] = whichColumn[jBlock];
-		whichColumn[jBlock]=-1;
-	      }
-	    }
-	  }
-	  int n=end-start;
-	  // If not in block - then start one
-	  if (iBlock<0) {
-	    // unless null column
-	    if (n) {
-	      iBlock = numberBlocks;
-	      numberBlocks++;
-	      numberGoodBlocks++;
-	      int jRow = row[start];
-	      rowBlock[jRow]=iBlock;
-	      whichColumn[iBlock]=jRow;
-	      numberMarkedRows += n;
-	      columnBlock[iBlock] = n;
-	      for (CoinBigIndex j=start+1;j<end;j++) {
-		int iRow = row[j];
-		rowBlock[iRow]=iBlock;
-		whichRow[jRow]=iRow;
-		jRow=iRow;
-	      }
-	    } else {
-	      columnBlock[numberColumns]++;
-	    }
-	  } else {
-	    // add all to this block if not already in
-	    int jRow = whichColumn[iBlock];
-	    for (CoinBigIndex j=start;j<end;j++) {
-	      int iRow = row[j];
-	      if (rowBlock[iRow]<0) {
-		numberMarkedRows++;
-		columnBlock[iBlock]++;
-		rowBlock[iRow]=iBlock;
-		whichRow[iRow]=jRow;
-		jRow=iRow;
-	      }
-	    }
-	    whichColumn[iBlock]=jRow;
-	  }
-	  columnsDone++;
-	  if (iBlock>=0) 
-	    maximumInBlock = CoinMax(maximumInBlock,columnBlock[iBlock]);
-	  if (columnsDone>=checkAfterColumns) {
-	    assert (numberGoodBlocks>0);
-	    double averageSize = static_cast<double>(numberMarkedRows)/
-	      static_cast<double>(numberGoodBlocks);
-#ifndef OSL_WAY
-	    double notionalBlocks = static_cast<double>(numberMarkedRows)/
-	      averageSize;
-	    if (maximumInBlock<3*averageSize&&numberGoodBlocks>2) {
-	      if(best*(numberColumns-columnsDone) < notionalBlocks) {
-		best = notionalBlocks/
-		  static_cast<double> (numberColumns-columnsDone); 
-		bestColumn = kColumn;
-	      }
-	    }
-#else
-	    if (maximumInBlock*10<numberRows*11&&numberGoodBlocks>1) {
-	      double test = maximumInBlock + 0.0*averageSize;
-	      if(best*static_cast<double>(columnsDone) > test) {
-		best = test/static_cast<double> (columnsDone); 
-		bestColumn = kColumn;
-		bestColumnsDone=columnsDone;
-	      }
-	    }
-#endif
-	  }	      
-	}
-#ifndef OSL_WAY
-	best2[iWay]=best;
-#else
-	if (bestColumnsDone<numberColumns)
-	  best2[iWay]=-(numberColumns-bestColumnsDone);
-	else
-	  best2[iWay]=-numberColumns;
-#endif
-	column2[iWay]=bestColumn;
-      }
+      double best2[3];
+      int column2[3];
+      // try forward and backward and sorted (at same time if threads)
+      numberBlocks = coinDecomposeOrdering(columnStart,columnLength,row,
+					   numberColumns,numberRows,
+					   columnBlock,rowBlock,whichColumn,
+					   whichRow,stack,best2,column2);
       // mark columns
       int nMaster;
       CoinFillN(columnBlock,numberColumns,-2);
@@ -1783,62 +2064,26 @@ CoinStructuredModel::decompose(const CoinPackedMatrix & matrix,
     }
     // Name for master so at beginning
     addColumnBlock(numberMasterColumns,"column_master");
-    // Arrays
-    // get full matrix
-    CoinPackedMatrix fullMatrix = matrix;
-    int numberRow2,numberColumn2;
-    int iBlock;
-    for (iBlock=0;iBlock<numberBlocks;iBlock++) {
+    // Make diagonal and beginning blocks (on threads) and add in order
+    CoinModel ** diagonal = new CoinModel * [numberBlocks];
+    CoinModel ** border = new CoinModel * [numberBlocks];
+    coinDecomposeBlocks(rowStart,rowLength,column,rowCopy.getElements(),
+			numberRows,rowBlock,numberColumns,columnBlock,
+			numberBlocks,rowLower,rowUpper,columnLower,columnUpper,
+			objective,true,diagonal,border);
+    for (int iBlock=0;iBlock<numberBlocks;iBlock++) {
       char rowName[20];
       sprintf(rowName,"row_%d",iBlock);
       char columnName[20];
       sprintf(columnName,"column_%d",iBlock);
-      numberRow2=0;
-      numberColumn2=0;
-      for (iColumn=0;iColumn<numberColumns;iColumn++) {
-	if (iBlock==columnBlock[iColumn]) {
-	  obj[numberColumn2]=objective[iColumn];
-	  columnLo[numberColumn2]=columnLower[iColumn];
-	  columnUp[numberColumn2]=columnUpper[iColumn];
-	  whichColumn[numberColumn2++]=iColumn;
-	}
-      }
-      for (iRow=0;iRow<numberRows;iRow++) {
-	if (iBlock==rowBlock[iRow]) {
-	  rowLo[numberRow2]=rowLower[iRow];
-	  rowUp[numberRow2]=rowUpper[iRow];
-	  whichRow[numberRow2++]=iRow;
-	}
-      }
-      // Diagonal block
-      CoinPackedMatrix mat(fullMatrix,
-			   numberRow2,whichRow,
-			   numberColumn2,whichColumn);
-      // make sure correct dimensions
-      mat.setDimensions(numberRow2,numberColumn2);
-      CoinModel * block = new CoinModel(numberRow2,numberColumn2,&mat,
-					rowLo,rowUp,columnLo,columnUp,obj);
-      block->setOriginalIndices(whichRow,whichColumn);
-      addBlock(rowName,columnName,block); // takes ownership
-      // and beginning block
-      numberColumn2=0;
-      // get beginning matrix
-      for (iColumn=0;iColumn<numberColumns;iColumn++) {
-	int iBlock = columnBlock[iColumn];
-	if (iBlock==-1) {
-	  whichColumn[numberColumn2++]=iColumn;
-	}
-      }
-      CoinPackedMatrix beginning(fullMatrix,
-			   numberRow2,whichRow,
-			   numberColumn2,whichColumn);
-      // make sure correct dimensions *********
-      beginning.setDimensions(numberRow2,numberColumn2);
-      block = new CoinModel(numberRow2,numberMasterColumns,&beginning,
-			    NULL,NULL,NULL,NULL,NULL);
-      block->setOriginalIndices(whichRow,whichColumn);
-      addBlock(rowName,"column_master",block); // takes ownership
+      addBlock(rowName,columnName,diagonal[iBlock]); // takes ownership
+      addBlock(rowName,"column_master",border[iBlock]); // takes ownership
     }
+    delete [] diagonal;
+    delete [] border;
+    // get full matrix
+    CoinPackedMatrix fullMatrix = matrix;
+    int numberRow2,numberColumn2;
     // and master
     numberRow2=0;
     numberColumn2=0;
@@ -2020,13 +2265,761 @@ CoinStructuredModel::decompose(const CoinModel & coinModel, int type,
   delete [] blockStarts;
   return nBlocks;
 }
-// Read SMPS model
-int 
+//#############################################################################
+// SMPS reading.  The core file is split by the time file into a first stage
+// (the master) and a second stage (all later periods).  Each scenario is
+// made by changing the second stage models in place, passing them on and
+// then putting back the core values.
+
+// One change to core model given in stochastic file
+typedef struct {
+  double value;
+  // core row (-1 if cost or bound)
+  int row;
+  // core column (-1 if rhs)
+  int column;
+  /* 'E' element, 'R' rhs, 'C' cost, 'L' lower bound, 'U' upper bound,
+     'F' fixed */
+  char type;
+} CoinSmpsChange;
+
+// Value changed for a scenario (to put back)
+typedef struct {
+  double value;
+  double value2;
+  // second stage row and column
+  int row;
+  int column;
+  // as change but 'B' is element in beginning (first stage columns)
+  char type;
+} CoinSmpsUndo;
+
+typedef struct {
+  const CoinMpsIO * core;
+  const char * rowSense;
+  const char * objectiveName;
+  // second stage index of each core row (or -1)
+  const int * rowSecond;
+  // first stage index of each core column (or -1)
+  const int * columnMaster;
+  // second stage index of each core column (or -1)
+  const int * columnSecond;
+  // scenario rows by first stage columns
+  CoinModel * beginning;
+  // scenario rows by second stage columns
+  CoinModel * block;
+  std::vector<CoinSmpsUndo> undo;
+  CoinSmpsFunction function;
+  void * userData;
+  int numberScenarios;
+  int numberErrors;
+  bool stop;
+} CoinSmpsInfo;
+
+// Splits line into tokens - returns number (0 for comments)
+static int
+coinSmpsTokens(char * line, char ** token, int maximum)
+{
+  if (line[0]=='*')
+    return 0;
+  int n=0;
+  char * pos = line;
+  while (n<maximum) {
+    while (*pos==' '||*pos=='\t'||*pos=='\n'||*pos=='\r')
+      pos++;
+    if (!*pos)
+      break;
+    token[n++]=pos;
+    while (*pos&&*pos!=' '&&*pos!='\t'&&*pos!='\n'&&*pos!='\r')
+      pos++;
+    if (*pos)
+      *pos++='\0';
+  }
+  return n;
+}
+
+/* Decodes an entry of stochastic file - either
+   column row value (row may be objective, column may be rhs name) or
+   boundType boundName column value.  Returns false if not known */
+static bool
+coinSmpsChange(const CoinSmpsInfo & info, char ** token, int n,
+	       CoinSmpsChange & change)
+{
+  const CoinMpsIO * core = info.core;
+  change.row=-1;
+  change.column=-1;
+  if (n==3) {
+    change.value=atof(token[2]);
+    change.column=core->columnIndex(token[0]);
+    bool objective = !strcmp(token[1],info.objectiveName);
+    if (change.column>=0) {
+      if (objective) {
+	change.type='C';
+	return true;
+      }
+      change.type='E';
+      change.row=core->rowIndex(token[1]);
+      return change.row>=0;
+    } else {
+      // rhs
+      change.type='R';
+      change.row=core->rowIndex(token[1]);
+      return change.row>=0;
+    }
+  } else if (n==4) {
+    change.value=atof(token[3]);
+    change.column=core->columnIndex(token[2]);
+    if (!strcmp(token[0],"UP"))
+      change.type='U';
+    else if (!strcmp(token[0],"LO"))
+      change.type='L';
+    else if (!strcmp(token[0],"FX"))
+      change.type='F';
+    else
+      return false;
+    return change.column>=0;
+  }
+  return false;
+}
+
+// New value - how is 0 replace, 1 add, 2 multiply
+static inline double
+coinSmpsValue(double oldValue, double value, int how)
+{
+  if (how==1)
+    return oldValue+value;
+  else if (how==2)
+    return oldValue*value;
+  else
+    return value;
+}
+
+/* Applies change to second stage models (saving old values).
+   Returns 1 if change is to first stage (not allowed) */
+static int
+coinSmpsApply(CoinSmpsInfo & info, const CoinSmpsChange & change, int how)
+{
+  CoinSmpsUndo undo;
+  undo.type=change.type;
+  undo.row=change.row>=0 ? info.rowSecond[change.row] : -1;
+  undo.column=change.column>=0 ? info.columnSecond[change.column] : -1;
+  if (change.type=='E') {
+    if (undo.row<0)
+      return 1;
+    CoinModel * model = info.block;
+    if (undo.column<0) {
+      // in first stage column
+      model = info.beginning;
+      undo.type='B';
+      undo.column=info.columnMaster[change.column];
+    }
+    undo.value=model->getElement(undo.row,undo.column);
+    model->setElement(undo.row,undo.column,
+		      coinSmpsValue(undo.value,change.value,how));
+  } else if (change.type=='R') {
+    if (undo.row<0)
+      return 1;
+    CoinModel * model = info.block;
+    double lower = model->getRowLower(undo.row);
+    double upper = model->getRowUpper(undo.row);
+    undo.value=lower;
+    undo.value2=upper;
+    char sense = info.rowSense[change.row];
+    if (sense=='E') {
+      double value = coinSmpsValue(upper,change.value,how);
+      model->setRowBounds(undo.row,value,value);
+    } else if (sense=='G') {
+      // keep range
+      double value = coinSmpsValue(lower,change.value,how);
+      if (upper<COIN_DBL_MAX)
+	upper += value-lower;
+      model->setRowBounds(undo.row,value,upper);
+    } else if (sense=='L'||sense=='R') {
+      double value = coinSmpsValue(upper,change.value,how);
+      if (lower>-COIN_DBL_MAX)
+	lower += value-upper;
+      model->setRowBounds(undo.row,lower,value);
+    }
+  } else {
+    // cost or bound
+    if (undo.column<0)
+      return 1;
+    CoinModel * model = info.block;
+    if (change.type=='C') {
+      undo.value=model->getColumnObjective(undo.column);
+      model->setColumnObjective(undo.column,
+				coinSmpsValue(undo.value,change.value,how));
+    } else {
+      double lower = model->getColumnLower(undo.column);
+      double upper = model->getColumnUpper(undo.column);
+      undo.value=lower;
+      undo.value2=upper;
+      if (change.type!='U')
+	lower = coinSmpsValue(lower,change.value,how);
+      if (change.type!='L')
+	upper = coinSmpsValue(upper,change.value,how);
+      model->setColumnBounds(undo.column,lower,upper);
+    }
+  }
+  info.undo.push_back(undo);
+  return 0;
+}
+
+// Puts back core values (in reverse order)
+static void
+coinSmpsRestore(CoinSmpsInfo & info)
+{
+  for (int i=static_cast<int>(info.undo.size())-1;i>=0;i--) {
+    const CoinSmpsUndo & undo = info.undo[i];
+    switch (undo.type) {
+    case 'E':
+    case 'B':
+      {
+	CoinModel * model = undo.type=='E' ? info.block : info.beginning;
+	if (undo.value)
+	  model->setElement(undo.row,undo.column,undo.value);
+	else
+	  model->deleteElement(undo.row,undo.column);
+      }
+      break;
+    case 'R':
+      info.block->setRowBounds(undo.row,undo.value,undo.value2);
+      break;
+    case 'C':
+      info.block->setColumnObjective(undo.column,undo.value);
+      break;
+    default:
+      info.block->setColumnBounds(undo.column,undo.value,undo.value2);
+      break;
+    }
+  }
+  info.undo.clear();
+}
+
+// Passes on scenario (with changes applied) and puts back core values
+static void
+coinSmpsScenario(CoinSmpsInfo & info, const char * name, double probability)
+{
+  if (!info.stop) {
+    if (info.function(info.numberScenarios,name,probability,
+		      *info.beginning,*info.block,info.userData))
+      info.stop=true;
+    info.numberScenarios++;
+  }
+  coinSmpsRestore(info);
+}
+
+// Finds file with one of two extensions
+static bool
+coinSmpsFile(const char * filename, const char * extension1,
+	     const char * extension2, std::string & name)
+{
+  name = std::string(filename)+extension1;
+  if (fileCoinReadable(name))
+    return true;
+  name = std::string(filename)+extension2;
+  return fileCoinReadable(name);
+}
+
+/* Reads time file and sets period of each core row and column.
+   Returns number of periods or -1 if bad */
+static int
+coinSmpsTime(const std::string & fileName, const CoinMpsIO & core,
+	     int * rowPeriod, int * columnPeriod, int & numberErrors)
+{
+  CoinFileInput * input = NULL;
+  try {
+    input = CoinFileInput::create(fileName);
+  }
+  catch (CoinError &) {
+    return -1;
+  }
+  int numberRows = core.getNumRows();
+  int numberColumns = core.getNumCols();
+  CoinZeroN(rowPeriod,numberRows);
+  CoinZeroN(columnPeriod,numberColumns);
+  // implicit - first row and column of each period
+  std::vector<int> firstRow;
+  std::vector<int> firstColumn;
+  CoinNameHash periods;
+  int numberPeriods=0;
+  // 0 - before PERIODS, 1 PERIODS, 2 ROWS, 3 COLUMNS
+  int section=0;
+  char line[1024];
+  char * token[4];
+  while (input->gets(line,sizeof(line))) {
+    bool header = (line[0]!=' '&&line[0]!='\t');
+    int n = coinSmpsTokens(line,token,4);
+    if (!n)
+      continue;
+    if (header) {
+      if (!strcmp(token[0],"ENDATA"))
+	break;
+      else if (!strcmp(token[0],"PERIODS"))
+	section=1;
+      else if (!strcmp(token[0],"ROWS"))
+	section=2;
+      else if (!strcmp(token[0],"COLUMNS"))
+	section=3;
+      else if (strcmp(token[0],"TIME"))
+	numberErrors++;
+      continue;
+    }
+    if (section==1) {
+      // period name last
+      if (periods.add(numberPeriods,token[n-1])!=numberPeriods) {
+	numberErrors++;
+	continue;
+      }
+      numberPeriods++;
+      if (n==3) {
+	int iColumn = core.columnIndex(token[0]);
+	int iRow = core.rowIndex(token[1]);
+	if (iColumn<0||iRow<0)
+	  numberErrors++;
+	firstColumn.push_back(iColumn>=0 ? iColumn : numberColumns);
+	firstRow.push_back(iRow>=0 ? iRow : numberRows);
+      }
+    } else if ((section==2||section==3)&&n==2) {
+      int iPeriod = periods.find(token[1]);
+      int i = (section==2) ? core.rowIndex(token[0]) :
+	core.columnIndex(token[0]);
+      if (iPeriod<0||i<0) {
+	numberErrors++;
+      } else if (section==2) {
+	rowPeriod[i]=iPeriod;
+      } else {
+	columnPeriod[i]=iPeriod;
+      }
+    } else {
+      numberErrors++;
+    }
+  }
+  delete input;
+  if (firstRow.size()) {
+    // implicit
+    for (int iPeriod=1;iPeriod<static_cast<int>(firstRow.size());iPeriod++) {
+      for (int i=firstRow[iPeriod];i<numberRows;i++)
+	rowPeriod[i]=iPeriod;
+      for (int i=firstColumn[iPeriod];i<numberColumns;i++)
+	columnPeriod[i]=iPeriod;
+    }
+  }
+  return numberPeriods;
+}
+
+// Adds scenario blocks to structured model (for readSmps)
+static int
+coinSmpsAddScenario(int iScenario, const char * , double probability,
+		    const CoinModel & beginning, const CoinModel & block,
+		    void * userData)
+{
+  CoinStructuredModel * model =
+    reinterpret_cast<CoinStructuredModel *>(userData);
+  char rowName[20];
+  sprintf(rowName,"row_%d",iScenario);
+  char columnName[20];
+  sprintf(columnName,"column_%d",iScenario);
+  CoinModel * block2 = new CoinModel(block);
+  // expected cost
+  int numberColumns = block2->numberColumns();
+  for (int i=0;i<numberColumns;i++) {
+    double value = block2->getColumnObjective(i);
+    if (value)
+      block2->setColumnObjective(i,value*probability);
+  }
+  model->addBlock(rowName,columnName,block2); // takes ownership
+  model->addBlock(rowName,"column_master",
+		  new CoinModel(beginning)); // takes ownership
+  return 0;
+}
+
+// Read SMPS model (as deterministic equivalent)
+int
 CoinStructuredModel::readSmps(const char *filename,
 			      bool keepNames, bool ignoreErrors)
 {
-  abort();
-  return 0;
+  return readSmps(filename,coinSmpsAddScenario,this,keepNames,ignoreErrors);
+}
+
+/* Read SMPS model passing on each scenario as it is read.
+   Returns number of errors (-1 if files could not be read) */
+int
+CoinStructuredModel::readSmps(const char *filename,
+			      CoinSmpsFunction function, void * userData,
+			      bool keepNames, bool ignoreErrors)
+{
+  std::string coreName;
+  std::string timeName;
+  std::string stochName;
+  if (!coinSmpsFile(filename,".cor",".core",coreName)||
+      !coinSmpsFile(filename,".tim",".time",timeName)||
+      !coinSmpsFile(filename,".sto",".stoch",stochName))
+    return -1;
+  CoinMpsIO core;
+  if (handler_)
+    core.passInMessageHandler(handler_);
+  else
+    core.messageHandler()->setLogLevel(logLevel_);
+  if (core.readMps(coreName.c_str(),""))
+    return -1;
+  int numberRows = core.getNumRows();
+  int numberColumns = core.getNumCols();
+  problemName_ = core.getProblemName();
+  objectiveOffset_ = core.objectiveOffset();
+  int numberErrors=0;
+  int * rowSecond = new int [numberRows];
+  int * columnMaster = new int [numberColumns];
+  int * columnSecond = new int [numberColumns];
+  int numberPeriods = coinSmpsTime(timeName,core,rowSecond,columnSecond,
+				   numberErrors);
+  if (numberPeriods<2) {
+    delete [] rowSecond;
+    delete [] columnMaster;
+    delete [] columnSecond;
+    return -1;
+  }
+  // All later periods are in second stage
+  int numberMasterRows=0;
+  int numberSecondRows=0;
+  int * whichRow = new int [numberRows];
+  for (int iRow=0;iRow<numberRows;iRow++) {
+    if (rowSecond[iRow]) {
+      rowSecond[iRow]=numberSecondRows++;
+    } else {
+      whichRow[numberMasterRows++]=iRow;
+      rowSecond[iRow]=-1;
+    }
+  }
+  int numberMasterColumns=0;
+  int numberSecondColumns=0;
+  int * whichColumn = new int [numberColumns];
+  for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+    if (columnSecond[iColumn]) {
+      columnSecond[iColumn]=numberSecondColumns++;
+      columnMaster[iColumn]=-1;
+    } else {
+      whichColumn[numberMasterColumns]=iColumn;
+      columnMaster[iColumn]=numberMasterColumns++;
+      columnSecond[iColumn]=-1;
+    }
+  }
+  const double * rowLower = core.getRowLower();
+  const double * rowUpper = core.getRowUpper();
+  const double * columnLower = core.getColLower();
+  const double * columnUpper = core.getColUpper();
+  const double * objective = core.getObjCoefficients();
+  const CoinPackedMatrix * matrix = core.getMatrixByCol();
+  // Master
+  {
+    CoinPackedMatrix top(*matrix,numberMasterRows,whichRow,
+			 numberMasterColumns,whichColumn);
+    top.setDimensions(numberMasterRows,numberMasterColumns);
+    double * rowLo = new double [numberMasterRows];
+    double * rowUp = new double [numberMasterRows];
+    for (int i=0;i<numberMasterRows;i++) {
+      rowLo[i]=rowLower[whichRow[i]];
+      rowUp[i]=rowUpper[whichRow[i]];
+    }
+    double * columnLo = new double [numberMasterColumns];
+    double * columnUp = new double [numberMasterColumns];
+    double * obj = new double [numberMasterColumns];
+    for (int i=0;i<numberMasterColumns;i++) {
+      columnLo[i]=columnLower[whichColumn[i]];
+      columnUp[i]=columnUpper[whichColumn[i]];
+      obj[i]=objective[whichColumn[i]];
+    }
+    CoinModel * master = new CoinModel(numberMasterRows,numberMasterColumns,
+				       &top,rowLo,rowUp,columnLo,columnUp,obj);
+    delete [] rowLo;
+    delete [] rowUp;
+    delete [] columnLo;
+    delete [] columnUp;
+    delete [] obj;
+    for (int i=0;i<numberMasterColumns;i++) {
+      if (core.isInteger(whichColumn[i]))
+	master->setColumnIsInteger(i,true);
+    }
+    if (keepNames) {
+      for (int i=0;i<numberMasterRows;i++)
+	master->setRowName(i,core.rowName(whichRow[i]));
+      for (int i=0;i<numberMasterColumns;i++)
+	master->setColumnName(i,core.columnName(whichColumn[i]));
+    }
+    master->setOriginalIndices(whichRow,whichColumn);
+    addBlock("row_master","column_master",master); // takes ownership
+  }
+  delete [] whichRow;
+  delete [] whichColumn;
+  /* Second stage models - elements can be changed so made as
+     triples.  First stage rows should not have second stage elements */
+  CoinModel beginning;
+  CoinModel block;
+  if (numberSecondRows) {
+    beginning.setRowBounds(numberSecondRows-1,-COIN_DBL_MAX,COIN_DBL_MAX);
+    for (int iRow=0;iRow<numberRows;iRow++) {
+      int i = rowSecond[iRow];
+      if (i>=0) {
+	block.setRowBounds(i,rowLower[iRow],rowUpper[iRow]);
+	if (keepNames)
+	  block.setRowName(i,core.rowName(iRow));
+      }
+    }
+  }
+  {
+    const int * row = matrix->getIndices();
+    const CoinBigIndex * columnStart = matrix->getVectorStarts();
+    const int * columnLength = matrix->getVectorLengths();
+    const double * element = matrix->getElements();
+    int * rows = new int [numberSecondRows+1];
+    double * elements = new double [numberSecondRows+1];
+    for (int iColumn=0;iColumn<numberColumns;iColumn++) {
+      int n=0;
+      for (CoinBigIndex j=columnStart[iColumn];
+	   j<columnStart[iColumn]+columnLength[iColumn];j++) {
+	int i = rowSecond[row[j]];
+	if (i>=0) {
+	  rows[n]=i;
+	  elements[n++]=element[j];
+	} else if (columnSecond[iColumn]>=0) {
+	  // first stage row with second stage element
+	  numberErrors++;
+	}
+      }
+      const char * name = keepNames ? core.columnName(iColumn) : NULL;
+      if (columnSecond[iColumn]>=0)
+	block.addColumn(n,rows,elements,columnLower[iColumn],
+			columnUpper[iColumn],objective[iColumn],name,
+			core.isInteger(iColumn));
+      else
+	beginning.addColumn(n,rows,elements,0.0,COIN_DBL_MAX,0.0,name);
+    }
+    delete [] rows;
+    delete [] elements;
+  }
+  CoinSmpsInfo info;
+  info.core=&core;
+  info.rowSense=core.getRowSense();
+  info.objectiveName=core.getObjectiveName();
+  info.rowSecond=rowSecond;
+  info.columnMaster=columnMaster;
+  info.columnSecond=columnSecond;
+  info.beginning=&beginning;
+  info.block=&block;
+  info.function=function;
+  info.userData=userData;
+  info.numberScenarios=0;
+  info.numberErrors=numberErrors;
+  info.stop=(numberErrors&&!ignoreErrors);
+  CoinFileInput * input = NULL;
+  try {
+    input = CoinFileInput::create(stochName);
+  }
+  catch (CoinError &) {
+    info.numberErrors++;
+    info.stop=true;
+  }
+  /* Scenarios are stored as changes to parent.  For independent and
+     blocks each group has alternatives, each a list of changes */
+  std::vector<CoinSmpsChange> changes;
+  std::vector<int> changeStart;
+  std::vector<int> parent;
+  std::vector<double> probability;
+  std::vector<int> group;
+  CoinNameHash names;
+  // 0 none, 1 scenarios, 2 independent, 3 blocks
+  int section=0;
+  // 0 replace, 1 add, 2 multiply
+  int how=0;
+  char line[1024];
+  char * token[8];
+  CoinSmpsChange lastChange;
+  lastChange.type=0;
+  std::string scenarioName;
+  while (!info.stop&&input->gets(line,sizeof(line))) {
+    bool header = (line[0]!=' '&&line[0]!='\t');
+    int n = coinSmpsTokens(line,token,8);
+    if (!n)
+      continue;
+    if (header) {
+      if (!strcmp(token[0],"ENDATA"))
+	break;
+      else if (!strcmp(token[0],"STOCH"))
+	continue;
+      section=0;
+      if (!strcmp(token[0],"SCENARIOS"))
+	section=1;
+      else if (!strcmp(token[0],"INDEP"))
+	section=2;
+      else if (!strcmp(token[0],"BLOCKS"))
+	section=3;
+      how=0;
+      for (int i=1;i<n;i++) {
+	if (!strcmp(token[i],"ADD"))
+	  how=1;
+	else if (!strcmp(token[i],"MULTIPLY"))
+	  how=2;
+	else if (strcmp(token[i],"DISCRETE")&&strcmp(token[i],"REPLACE"))
+	  section=0;
+      }
+      if (!section||(section==1&&how))
+	info.numberErrors++;
+    } else if (section==1) {
+      if (!strcmp(token[0],"SC")&&n>=4) {
+	int iScenario = static_cast<int>(parent.size());
+	if (iScenario) {
+	  // finish last
+	  changeStart.push_back(static_cast<int>(changes.size()));
+	  int kScenario=iScenario-1;
+	  // apply from root
+	  std::vector<int> path;
+	  while (kScenario>=0) {
+	    path.push_back(kScenario);
+	    kScenario=parent[kScenario];
+	  }
+	  for (int k=static_cast<int>(path.size())-1;k>=0;k--) {
+	    int jScenario = path[k];
+	    for (int j=changeStart[jScenario];j<changeStart[jScenario+1];j++)
+	      info.numberErrors += coinSmpsApply(info,changes[j],0);
+	  }
+	  coinSmpsScenario(info,scenarioName.c_str(),
+			   probability[iScenario-1]);
+	} else {
+	  changeStart.push_back(0);
+	}
+	scenarioName = token[1];
+	if (names.add(iScenario,token[1])!=iScenario)
+	  info.numberErrors++;
+	int iParent=-1;
+	if (strcmp(token[2],"ROOT")) {
+	  iParent = names.find(token[2]);
+	  if (iParent<0||iParent==iScenario) {
+	    info.numberErrors++;
+	    iParent=-1;
+	  }
+	}
+	parent.push_back(iParent);
+	probability.push_back(atof(token[3]));
+      } else if (parent.size()) {
+	CoinSmpsChange change;
+	if (coinSmpsChange(info,token,n,change))
+	  changes.push_back(change);
+	else
+	  info.numberErrors++;
+      } else {
+	info.numberErrors++;
+      }
+    } else if (section==2) {
+      // (bound) column row value [period] probability
+      int nChange = strcmp(token[0],"UP")&&strcmp(token[0],"LO")&&
+	strcmp(token[0],"FX") ? 3 : 4;
+      CoinSmpsChange change;
+      if (n<nChange+1||!coinSmpsChange(info,token,nChange,change)) {
+	info.numberErrors++;
+	continue;
+      }
+      if (lastChange.type!=change.type||lastChange.row!=change.row||
+	  lastChange.column!=change.column)
+	group.push_back(static_cast<int>(probability.size()));
+      lastChange=change;
+      changeStart.push_back(static_cast<int>(changes.size()));
+      changes.push_back(change);
+      probability.push_back(atof(token[n-1]));
+    } else if (section==3) {
+      if (!strcmp(token[0],"BL")&&n>=4) {
+	// alternative of a block (blocks numbered in order)
+	int iBlock = names.add(names.numberNames(),token[1]);
+	parent.push_back(iBlock);
+	changeStart.push_back(static_cast<int>(changes.size()));
+	probability.push_back(atof(token[n-1]));
+      } else if (parent.size()) {
+	CoinSmpsChange change;
+	if (coinSmpsChange(info,token,n,change))
+	  changes.push_back(change);
+	else
+	  info.numberErrors++;
+      } else {
+	info.numberErrors++;
+      }
+    } else {
+      info.numberErrors++;
+    }
+    if (info.numberErrors&&!ignoreErrors)
+      info.stop=true;
+  }
+  delete input;
+  if (!info.stop) {
+    if (parent.size()&&!group.size()&&section==1) {
+      // last scenario
+      int iScenario = static_cast<int>(parent.size());
+      changeStart.push_back(static_cast<int>(changes.size()));
+      int kScenario=iScenario-1;
+      std::vector<int> path;
+      while (kScenario>=0) {
+	path.push_back(kScenario);
+	kScenario=parent[kScenario];
+      }
+      for (int k=static_cast<int>(path.size())-1;k>=0;k--) {
+	int jScenario = path[k];
+	for (int j=changeStart[jScenario];j<changeStart[jScenario+1];j++)
+	  info.numberErrors += coinSmpsApply(info,changes[j],0);
+      }
+      coinSmpsScenario(info,scenarioName.c_str(),probability[iScenario-1]);
+    } else if (section==2||section==3) {
+      int numberAlternatives = static_cast<int>(probability.size());
+      changeStart.push_back(static_cast<int>(changes.size()));
+      // alternatives of each group
+      int numberGroups;
+      std::vector<int> alternative(numberAlternatives);
+      if (section==2) {
+	numberGroups = static_cast<int>(group.size());
+	group.push_back(numberAlternatives);
+	for (int i=0;i<numberAlternatives;i++)
+	  alternative[i]=i;
+      } else {
+	numberGroups = names.numberNames();
+	group.assign(numberGroups+1,0);
+	for (int i=0;i<numberAlternatives;i++)
+	  group[parent[i]+1]++;
+	for (int i=0;i<numberGroups;i++)
+	  group[i+1]+=group[i];
+	std::vector<int> put(group.begin(),group.end()-1);
+	for (int i=0;i<numberAlternatives;i++)
+	  alternative[put[parent[i]]++]=i;
+      }
+      // all combinations
+      std::vector<int> counter(numberGroups,0);
+      char name[20];
+      while (!info.stop) {
+	double scenarioProbability=1.0;
+	for (int iGroup=0;iGroup<numberGroups;iGroup++) {
+	  int k = alternative[group[iGroup]+counter[iGroup]];
+	  scenarioProbability *= probability[k];
+	  for (int j=changeStart[k];j<changeStart[k+1];j++)
+	    info.numberErrors += coinSmpsApply(info,changes[j],how);
+	}
+	sprintf(name,"SCEN%d",info.numberScenarios);
+	coinSmpsScenario(info,name,scenarioProbability);
+	int iGroup=0;
+	while (iGroup<numberGroups&&
+	       ++counter[iGroup]==group[iGroup+1]-group[iGroup])
+	  counter[iGroup++]=0;
+	if (iGroup==numberGroups)
+	  break;
+      }
+    }
+  }
+  delete [] rowSecond;
+  delete [] columnMaster;
+  delete [] columnSecond;
+  if (info.numberErrors&&handler_) {
+    char generalPrint[200];
+    sprintf(generalPrint,"%d errors reading SMPS files %s",
+	    info.numberErrors,filename);
+    handler_->message(COIN_GENERAL_WARNING,messages_)<<
+      generalPrint << CoinMessageEol;
+  }
+  return info.numberErrors;
 }
 // Return block corresponding to row and column
 const CoinBaseModel *  
@@ -33,6 +33,18 @@
     {}
 } CoinModelBlockInfo;
 
+/** Called by CoinStructuredModel::readSmps for each scenario as it is read.
+    The scenario rows are given as two models - beginning has elements in
+    first stage columns and block the second stage columns (with their
+    bounds and costs) and the row bounds.  Costs are not multiplied by
+    probability.  The models are changed back for the next scenario so
+    must be copied if wanted later.  Return nonzero to stop reading.
+*/
+typedef int (*CoinSmpsFunction)(int iScenario, const char * name,
+				double probability,
+				const CoinModel & beginning,
+				const CoinModel & block, void * userData);
+
 class CoinStructuredModel : public CoinBaseModel {
   
 public:
@@ -63,18 +75,29 @@ public:
 	       const double * rowLower, const double * rowUpper,
 	       const double * columnLower, const double * columnUpper,
 	       const double * objective);
+  /** add blocks using names given as parameters - structured model takes
+      ownership.  Matrices of blocks are converted and what is set found
+      at the same time if threads allowed (see setBlockThreads).
+      returns number of errors (e.g. both have objectives but not same)
+   */
+  int addBlocks(int numberBlocks,
+		const std::string * rowBlocks,
+		const std::string * columnBlocks,
+		CoinBaseModel ** blocks);
 
   /** Write the problem in MPS format to a file with the given filename.
       
-  \param compression can be set to three values to indicate what kind
+  \param compression can be set to five values to indicate what kind
   of file should be written
   <ul>
   <li> 0: plain text (default)
   <li> 1: gzip compressed (.gz is appended to \c filename)
   <li> 2: bzip2 compressed (.bz2 is appended to \c filename) (TODO)
+  <li> 3: zstd compressed (.zst is appended to \c filename)
+  <li> 4: lz4 compressed (.lz4 is appended to \c filename)
   </ul>
   If the library was not compiled with the requested compression then
-  writeMps falls back to writing a plain text file.
+  writeMps falls back as CoinMpsIO::writeMps does.
   
   \param formatType specifies the precision to used for values in the
   MPS file
@@ -91,10 +114,35 @@ public:
   */
   int writeMps(const char *filename, int compression = 0,
                int formatType = 0, int numberAcross = 2, bool keepStrings=false) ;
-  /// Read SMPS model
+  /** Write each block (as CoinModel) to a file baseName_i.mps where i is
+      block number.  Files are written at the same time if threads
+      allowed.  Parameters as writeMps.
+      Returns number of blocks which could not be written
+  */
+  int writeBlockMps(const char * baseName, int compression = 0,
+		    int formatType = 0, int numberAcross = 2,
+		    bool keepStrings = false);
+  /** Read SMPS model - filename.cor (or .core), .tim (or .time) and
+      .sto (or .stoch).  Two stage only - periods after the first are all
+      in the second stage.  Stochastic data may be SCENARIOS, INDEP or
+      BLOCKS (DISCRETE).  Model should be empty.  First stage is added
+      as master and each scenario as blocks row_i by column_master and
+      row_i by column_i with costs multiplied by probability.
+      Returns number of errors (-1 if files could not be read)
+  */
   int readSmps(const char *filename,
                  bool keepNames = false,
                  bool ignoreErrors = false);
+  /** Read SMPS model as readSmps but only first stage is added (as
+      master) and each scenario is passed to function as soon as it has
+      been read.  Scenarios are made by changing the core second stage
+      in place so memory does not grow with number of scenarios (except
+      that SCENARIOS changes are kept as later ones may use them).
+      Returns number of errors (-1 if files could not be read)
+  */
+  int readSmps(const char *filename, CoinSmpsFunction function,
+	       void * userData, bool keepNames = false,
+	       bool ignoreErrors = false);
 
   /** Decompose a CoinModel
       1 - try D-W
@@ -108,7 +156,9 @@ public:
       1 - try D-W
       2 - try Benders
       3 - try Staircase
-      Returns number of blocks or zero if no structure
+      Returns number of blocks or zero if no structure.
+      Ordering passes and making sub problems use threads if allowed
+      (the decomposition is the same whatever the number of threads)
   */
   int decompose(const CoinPackedMatrix & matrix,
 		const double * rowLower, const double * rowUpper,
@@ -119,6 +169,14 @@ public:
   
    //@}
 
+  /**@name Threads for block work */
+  //@{
+  /** Sets number of threads used by decompose, addBlocks and
+      writeBlockMps.  Always 1 if not built with COINUTILS_PTHREADS. */
+  static void setBlockThreads(int numberThreads);
+  /// Number of threads used for block work
+  static int blockThreads();
+  //@}
 
   /**@name For getting information */
    //@{
@@ -216,12 +274,16 @@ public:
 private:
 
   /** Fill in info structure and update counts
-      Returns number of inconsistencies on border
+      Returns number of inconsistencies on border.
+      whatsSet is block->whatIsSet() if already known
   */
-  int fillInfo(CoinModelBlockInfo & info,const CoinModel * block);
+  int fillInfo(CoinModelBlockInfo & info,const CoinModel * block,
+	       int whatsSet=-1);
   /** Fill in info structure and update counts
   */
   void fillInfo(CoinModelBlockInfo & info,const CoinStructuredModel * block);
+  /// Makes room for at least numberBlocks element blocks
+  void resizeBlocks(int numberBlocks);
   /**@name Data members */
    //@{
   /// Current number of row blocks
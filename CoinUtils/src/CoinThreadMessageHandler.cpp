@@ -0,0 +1,311 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinThreadMessageHandler.hpp"
+#include "CoinHelperFunctions.hpp"
+#include <cstring>
+#ifdef COINUTILS_PTHREADS
+#include <sched.h>
+#endif
+
+/* Formats the messages of one thread and queues the text for the writer
+   thread of its owner */
+class CoinThreadLocalHandler : public CoinMessageHandler {
+public:
+  CoinThreadLocalHandler(CoinThreadMessageHandler * owner) :
+    CoinMessageHandler(owner->filePointer()),
+    owner_(owner),
+    settingsVersion_(-1)
+  { }
+  /// Copy log levels etc from owner if they have changed
+  inline void checkSettings()
+  {
+#ifdef COINUTILS_PTHREADS
+    int version = __atomic_load_n(&owner_->settingsVersion_,__ATOMIC_ACQUIRE);
+    if (version!=settingsVersion_) {
+      takeSettings();
+      settingsVersion_ = version;
+    }
+#endif
+  }
+  /// Copy log levels etc from owner
+  void takeSettings()
+  {
+    logLevel_ = owner_->logLevel_;
+    for (int i=0;i<COIN_NUM_LOG;i++)
+      logLevels_[i] = owner_->logLevels_[i];
+    prefix_ = owner_->prefix_;
+    strcpy(g_format_,owner_->g_format_);
+    g_precision_ = owner_->g_precision_;
+    fp_ = owner_->fp_;
+    binaryLog_ = owner_->binaryLog_;
+  }
+  /// Queue text
+  virtual int print();
+  /// Print everything queued before stopping
+  virtual void checkSeverity();
+private:
+  CoinThreadMessageHandler * owner_;
+  /// Version of owner's settings last taken
+  int settingsVersion_;
+};
+
+int
+CoinThreadLocalHandler::print()
+{
+#ifdef COINUTILS_PTHREADS
+  CoinThreadMessageHandler::queued * item = new CoinThreadMessageHandler::queued;
+  item->text = messageBuffer_;
+  item->source = source_;
+  item->externalNumber = currentMessage_.externalNumber_;
+  item->severity = currentMessage_.severity_;
+  item->detail = currentMessage_.detail_;
+  owner_->push(item);
+  return 0;
+#else
+  return CoinMessageHandler::print();
+#endif
+}
+
+void
+CoinThreadLocalHandler::checkSeverity()
+{
+  if (currentMessage_.severity_=='S')
+    owner_->flush();
+  CoinMessageHandler::checkSeverity();
+}
+
+//#############################################################################
+
+// Constructor
+CoinThreadMessageHandler::CoinThreadMessageHandler() :
+  CoinMessageHandler()
+{
+  gutsOfConstructor();
+}
+// Constructor
+CoinThreadMessageHandler::CoinThreadMessageHandler(FILE * fp) :
+  CoinMessageHandler(fp)
+{
+  gutsOfConstructor();
+}
+/* The copy constructor */
+CoinThreadMessageHandler::CoinThreadMessageHandler(const CoinThreadMessageHandler& rhs) :
+  CoinMessageHandler(rhs)
+{
+  gutsOfConstructor();
+}
+/* assignment operator. */
+CoinThreadMessageHandler &
+CoinThreadMessageHandler::operator=(const CoinThreadMessageHandler& rhs)
+{
+  if (this != &rhs) {
+    // writer must not be printing while settings change
+    flush();
+    bool threaded = threadSafe_;
+    CoinMessageHandler::operator=(rhs);
+    threadSafe_ = threaded;
+    settingsChanged();
+  }
+  return *this;
+}
+/* Destructor */
+CoinThreadMessageHandler::~CoinThreadMessageHandler()
+{
+  flush();
+  gutsOfDestructor();
+}
+// Clone
+CoinMessageHandler *
+CoinThreadMessageHandler::clone() const
+{
+  return new CoinThreadMessageHandler(*this);
+}
+
+void
+CoinThreadMessageHandler::gutsOfConstructor()
+{
+#ifdef COINUTILS_PTHREADS
+  stub_.next = NULL;
+  head_ = &stub_;
+  tail_ = &stub_;
+  numberPushed_ = 0;
+  numberPrinted_ = 0;
+  sleeping_ = 0;
+  done_ = 0;
+  settingsVersion_ = 0;
+  pthread_mutex_init(&mutex_,NULL);
+  pthread_cond_init(&condition_,NULL);
+  pthread_key_create(&key_,NULL);
+  // if no thread, messages are formatted and printed here as usual
+  threadSafe_ = !pthread_create(&thread_,NULL,writer,this);
+#endif
+}
+
+void
+CoinThreadMessageHandler::gutsOfDestructor()
+{
+#ifdef COINUTILS_PTHREADS
+  if (threadSafe_) {
+    // writer empties queue before it stops
+    pthread_mutex_lock(&mutex_);
+    done_ = 1;
+    pthread_cond_broadcast(&condition_);
+    pthread_mutex_unlock(&mutex_);
+    pthread_join(thread_,NULL);
+    threadSafe_ = false;
+  }
+  for (size_t i=0;i<locals_.size();i++)
+    delete locals_[i];
+  locals_.clear();
+  pthread_key_delete(key_);
+  pthread_cond_destroy(&condition_);
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+// Formatting handler for the calling thread
+CoinMessageHandler *
+CoinThreadMessageHandler::localHandler()
+{
+#ifdef COINUTILS_PTHREADS
+  if (threadSafe_) {
+    CoinThreadLocalHandler * local =
+      static_cast<CoinThreadLocalHandler *>(pthread_getspecific(key_));
+    if (!local) {
+      local = new CoinThreadLocalHandler(this);
+      pthread_setspecific(key_,local);
+      pthread_mutex_lock(&mutex_);
+      locals_.push_back(local);
+      pthread_mutex_unlock(&mutex_);
+    }
+    local->checkSettings();
+    return local;
+  }
+#endif
+  return this;
+}
+
+// Wait until every message queued so far has been printed
+void
+CoinThreadMessageHandler::flush()
+{
+#ifdef COINUTILS_PTHREADS
+  if (threadSafe_) {
+    CoinUInt64 target = __atomic_load_n(&numberPushed_,__ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&mutex_);
+    while (__atomic_load_n(&numberPrinted_,__ATOMIC_SEQ_CST)<target)
+      pthread_cond_wait(&condition_,&mutex_);
+    pthread_mutex_unlock(&mutex_);
+  }
+#endif
+}
+
+// Settings have changed
+void
+CoinThreadMessageHandler::settingsChanged()
+{
+#ifdef COINUTILS_PTHREADS
+  __atomic_add_fetch(&settingsVersion_,1,__ATOMIC_RELEASE);
+#endif
+}
+
+#ifdef COINUTILS_PTHREADS
+/* Queue is the intrusive one of Vyukov: producers exchange head_ and then
+   link the old head to the new item, the writer follows next pointers from
+   tail_.  stub_ is put back when the queue would otherwise empty, so the
+   last item can be handed out.  An item whose producer has exchanged but
+   not yet linked is not seen until it is linked.
+*/
+void
+CoinThreadMessageHandler::push(queued * item)
+{
+  item->next = NULL;
+  queued * previous = __atomic_exchange_n(&head_,item,__ATOMIC_SEQ_CST);
+  __atomic_store_n(&previous->next,item,__ATOMIC_RELEASE);
+  __atomic_add_fetch(&numberPushed_,1,__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&sleeping_,__ATOMIC_SEQ_CST)) {
+    pthread_mutex_lock(&mutex_);
+    pthread_cond_broadcast(&condition_);
+    pthread_mutex_unlock(&mutex_);
+  }
+}
+
+CoinThreadMessageHandler::queued *
+CoinThreadMessageHandler::pop()
+{
+  queued * tail = tail_;
+  queued * next = __atomic_load_n(&tail->next,__ATOMIC_ACQUIRE);
+  if (tail==&stub_) {
+    if (!next)
+      return NULL;
+    tail_ = next;
+    tail = next;
+    next = __atomic_load_n(&next->next,__ATOMIC_ACQUIRE);
+  }
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail!=__atomic_load_n(&head_,__ATOMIC_ACQUIRE))
+    return NULL; // producer between exchange and link
+  stub_.next = NULL;
+  queued * previous = __atomic_exchange_n(&head_,&stub_,__ATOMIC_SEQ_CST);
+  __atomic_store_n(&previous->next,&stub_,__ATOMIC_RELEASE);
+  next = __atomic_load_n(&tail->next,__ATOMIC_ACQUIRE);
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  return NULL;
+}
+
+void *
+CoinThreadMessageHandler::writer(void * info)
+{
+  CoinThreadMessageHandler * handler =
+    static_cast<CoinThreadMessageHandler *>(info);
+  while (true) {
+    queued * item = handler->pop();
+    if (item) {
+      size_t length = CoinMin(item->text.size(),
+			      static_cast<size_t>(COIN_MESSAGE_HANDLER_MAX_BUFFER_SIZE-1));
+      memcpy(handler->messageBuffer_,item->text.c_str(),length);
+      handler->messageBuffer_[length] = '\0';
+      handler->messageOut_ = handler->messageBuffer_+length;
+      handler->source_ = item->source;
+      handler->currentMessage_.externalNumber_ = item->externalNumber;
+      handler->currentMessage_.severity_ = item->severity;
+      handler->currentMessage_.detail_ = item->detail;
+      handler->highestNumber_ = CoinMax(handler->highestNumber_,item->externalNumber);
+      handler->print();
+      delete item;
+      __atomic_add_fetch(&handler->numberPrinted_,1,__ATOMIC_SEQ_CST);
+      continue;
+    }
+    pthread_mutex_lock(&handler->mutex_);
+    __atomic_store_n(&handler->sleeping_,1,__ATOMIC_SEQ_CST);
+    // wake anyone in flush
+    pthread_cond_broadcast(&handler->condition_);
+    bool empty = (__atomic_load_n(&handler->head_,__ATOMIC_SEQ_CST)==&handler->stub_&&
+		  handler->tail_==&handler->stub_);
+    if (!empty) {
+      // more coming (maybe a producer between exchange and link)
+      __atomic_store_n(&handler->sleeping_,0,__ATOMIC_SEQ_CST);
+      pthread_mutex_unlock(&handler->mutex_);
+      sched_yield();
+      continue;
+    }
+    if (handler->done_) {
+      pthread_mutex_unlock(&handler->mutex_);
+      break;
+    }
+    pthread_cond_wait(&handler->condition_,&handler->mutex_);
+    __atomic_store_n(&handler->sleeping_,0,__ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&handler->mutex_);
+  }
+  return NULL;
+}
+#endif
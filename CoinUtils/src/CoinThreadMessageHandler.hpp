@@ -0,0 +1,133 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinThreadMessageHandler_H
+#define CoinThreadMessageHandler_H
+
+#include "CoinUtilsConfig.h"
+#include "CoinTypes.hpp"
+#include "CoinMessageHandler.hpp"
+
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+class CoinThreadLocalHandler;
+
+/** Message handler which may be shared by several threads.
+
+  Each thread which starts a message gets its own formatting handler (a
+  CoinMessageHandler with its own buffer and field values), so the
+  message(), operator<< and CoinMessageEol calls of different threads do
+  not interfere.  The log level is checked there, before any formatting,
+  exactly as for CoinMessageHandler.  A finished message goes as text on a
+  lock free queue (many producers, one consumer) to a writer thread, which
+  calls print() - so print() runs in one thread only and messages come
+  out whole and in the order they were finished.  Producers never wait
+  for the writer.
+
+  Rules:
+  - each thread must start a message with message() (a bare << on the
+    shared handler starts nothing);
+  - set log levels, prefix and precision before the threads start - a
+    thread's formatting handler copies them when it is made.  If they are
+    changed later call settingsChanged() so every thread copies them again
+    at its next message;
+  - a derived print() sees messageBuffer(), currentMessage() (number,
+    severity and detail only) and currentSource(); the field values
+    (doubleValue() etc.) stay with the formatting handler;
+  - a class which overrides print() must call flush() in its own
+    destructor.  By the time this destructor runs the derived print() has
+    gone, so anything still queued would be printed by
+    CoinMessageHandler::print() instead.
+
+  flush() waits until everything queued has been printed.  Without
+  COINUTILS_PTHREADS this is an ordinary CoinMessageHandler.
+*/
+class CoinThreadMessageHandler : public CoinMessageHandler {
+
+friend class CoinThreadLocalHandler;
+
+public:
+  /**@name Constructors etc */
+  //@{
+  /// Constructor
+  CoinThreadMessageHandler();
+  /// Constructor to put to file pointer (won't be closed)
+  CoinThreadMessageHandler(FILE *fp);
+  /** Destructor - flushes and stops the writer thread (derived classes
+      with their own print() must flush first, see above) */
+  virtual ~CoinThreadMessageHandler();
+  /** The copy constructor - settings are copied, the copy has its own
+      writer thread */
+  CoinThreadMessageHandler(const CoinThreadMessageHandler&);
+  /** Assignment operator - flushes, then takes settings. */
+  CoinThreadMessageHandler& operator=(const CoinThreadMessageHandler&);
+  /// Clone
+  virtual CoinMessageHandler * clone() const;
+  //@}
+
+  /**@name Thread safe mode */
+  //@{
+  /// Formatting handler for the calling thread
+  virtual CoinMessageHandler * localHandler();
+  /// Wait until every message queued so far has been printed
+  void flush();
+  /** Log levels, prefix etc have changed - each thread takes them again
+      at its next message */
+  void settingsChanged();
+  /// True if messages go through the writer thread
+  inline bool threaded() const
+  { return threadSafe_;}
+  //@}
+
+private:
+  /// Set up queue and writer thread
+  void gutsOfConstructor();
+  /// Stop writer thread and free formatting handlers
+  void gutsOfDestructor();
+#ifdef COINUTILS_PTHREADS
+  /// One finished message
+  struct queued {
+    queued * next;
+    std::string text;
+    std::string source;
+    int externalNumber;
+    char severity;
+    char detail;
+  };
+  /// Called by formatting handlers
+  void push(queued * item);
+  /// Next message or NULL (writer thread only)
+  queued * pop();
+  /// Writer thread
+  static void * writer(void * info);
+
+  /// Last pushed (producers exchange this)
+  queued * head_;
+  /// Next to pop (writer only)
+  queued * tail_;
+  /// Sentinel which keeps the queue non empty
+  queued stub_;
+  /// Messages pushed and printed
+  CoinUInt64 numberPushed_;
+  CoinUInt64 numberPrinted_;
+  /// Writer is (about to be) asleep
+  int sleeping_;
+  /// Writer should stop when queue empty
+  int done_;
+  /// Incremented when settings change (formatting handlers compare)
+  int settingsVersion_;
+  pthread_t thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;
+  /// Formatting handler of each thread
+  pthread_key_t key_;
+  /// All formatting handlers (to free them)
+  std::vector<CoinThreadLocalHandler *> locals_;
+#endif
+};
+
+#endif
@@ -0,0 +1,250 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "CoinPragma.hpp"
+#include "CoinThreadPool.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(CPU_SETSIZE)
+#define COIN_POOL_AFFINITY
+#endif
+#ifdef _MSC_VER
+#define COIN_POOL_TLS __declspec(thread)
+#else
+#define COIN_POOL_TLS __thread
+#endif
+#endif
+
+//#############################################################################
+// Pool state (plain statics - usable at any time)
+
+static CoinTaskRunner coinPoolRunner = NULL;
+static void *coinPoolRunnerData = NULL;
+static bool coinPoolPin = false;
+
+#ifdef COINUTILS_PTHREADS
+// Tasks of one call of run
+typedef struct coinPoolJob {
+  CoinTaskFunction function;
+  char *info;
+  int sizeInfo;
+  int number;
+  // next task to hand out and number finished
+  int next;
+  int done;
+  // next job with tasks to hand out
+  coinPoolJob *nextJob;
+} coinPoolJob;
+
+static pthread_mutex_t coinPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+// pool threads wait on this for jobs
+static pthread_cond_t coinPoolWork = PTHREAD_COND_INITIALIZER;
+// callers of run wait on this for their tasks to finish
+static pthread_cond_t coinPoolDone = PTHREAD_COND_INITIALIZER;
+static coinPoolJob *coinPoolJobs = NULL;
+static pthread_t *coinPoolThreadId = NULL;
+static int coinPoolNumberStarted = 0;
+// 0 until set (then processors online)
+static int coinPoolNumberThreads = 0;
+static bool coinPoolStop = false;
+static COIN_POOL_TLS int coinPoolInTask = 0;
+
+// Takes job out of list of jobs with tasks to hand out (lock held)
+static void
+coinPoolUnlink(coinPoolJob *job)
+{
+  coinPoolJob **previous = &coinPoolJobs;
+  while (*previous != job)
+    previous = &(*previous)->nextJob;
+  *previous = job->nextJob;
+}
+
+// Hands out next task of job (lock held)
+static inline char *
+coinPoolNextTask(coinPoolJob *job)
+{
+  char *info = job->info + job->next * job->sizeInfo;
+  job->next++;
+  if (job->next == job->number)
+    coinPoolUnlink(job);
+  return info;
+}
+
+// Body of each pool thread
+static void *
+coinPoolWorker(void *arg)
+{
+#ifdef COIN_POOL_AFFINITY
+  if (coinPoolPin) {
+    long numberCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (numberCpus > 1) {
+      int which = static_cast< int >((reinterpret_cast< size_t >(arg) + 1) % numberCpus);
+      if (which < CPU_SETSIZE) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(which, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      }
+    }
+  }
+#else
+  (void)arg;
+#endif
+  // anything run from a task is done in this thread
+  coinPoolInTask = 1;
+  pthread_mutex_lock(&coinPoolMutex);
+  while (true) {
+    while (!coinPoolStop && !coinPoolJobs)
+      pthread_cond_wait(&coinPoolWork, &coinPoolMutex);
+    if (coinPoolStop)
+      break;
+    coinPoolJob *job = coinPoolJobs;
+    char *info = coinPoolNextTask(job);
+    pthread_mutex_unlock(&coinPoolMutex);
+    job->function(info);
+    pthread_mutex_lock(&coinPoolMutex);
+    job->done++;
+    if (job->done == job->number)
+      pthread_cond_broadcast(&coinPoolDone);
+  }
+  pthread_mutex_unlock(&coinPoolMutex);
+  return NULL;
+}
+
+// Stops pool threads (lock not held)
+static void
+coinPoolStopThreads()
+{
+  pthread_mutex_lock(&coinPoolMutex);
+  int numberStarted = coinPoolNumberStarted;
+  pthread_t *threadId = coinPoolThreadId;
+  coinPoolStop = true;
+  pthread_cond_broadcast(&coinPoolWork);
+  pthread_mutex_unlock(&coinPoolMutex);
+  for (int i = 0; i < numberStarted; i++)
+    pthread_join(threadId[i], NULL);
+  pthread_mutex_lock(&coinPoolMutex);
+  delete[] threadId;
+  coinPoolThreadId = NULL;
+  coinPoolNumberStarted = 0;
+  coinPoolStop = false;
+  pthread_mutex_unlock(&coinPoolMutex);
+}
+#endif
+
+//#############################################################################
+
+void CoinThreadPool::run(CoinTaskFunction function, void *info, int sizeInfo,
+  int number)
+{
+  char *base = static_cast< char * >(info);
+  if (number <= 0)
+    return;
+  if (coinPoolRunner) {
+    coinPoolRunner(function, base, sizeInfo, number, coinPoolRunnerData);
+    return;
+  }
+#ifdef COINUTILS_PTHREADS
+  int numberThreads = CoinThreadPool::numberThreads();
+  if (number > 1 && numberThreads > 1 && !coinPoolInTask) {
+    pthread_mutex_lock(&coinPoolMutex);
+    if (!coinPoolNumberStarted) {
+      // start pool (any which fail just leave fewer)
+      coinPoolThreadId = new pthread_t[numberThreads - 1];
+      for (int i = 0; i < numberThreads - 1; i++) {
+        if (pthread_create(coinPoolThreadId + coinPoolNumberStarted, NULL,
+              coinPoolWorker, reinterpret_cast< void * >(static_cast< size_t >(i))))
+          break;
+        coinPoolNumberStarted++;
+      }
+    }
+    coinPoolJob job;
+    job.function = function;
+    job.info = base;
+    job.sizeInfo = sizeInfo;
+    job.number = number;
+    job.next = 0;
+    job.done = 0;
+    job.nextJob = NULL;
+    // last in list so earlier callers are served first
+    coinPoolJob **last = &coinPoolJobs;
+    while (*last)
+      last = &(*last)->nextJob;
+    *last = &job;
+    pthread_cond_broadcast(&coinPoolWork);
+    // do tasks here as well
+    coinPoolInTask = 1;
+    while (job.next < job.number) {
+      char *infoTask = coinPoolNextTask(&job);
+      pthread_mutex_unlock(&coinPoolMutex);
+      function(infoTask);
+      pthread_mutex_lock(&coinPoolMutex);
+      job.done++;
+    }
+    coinPoolInTask = 0;
+    while (job.done < job.number)
+      pthread_cond_wait(&coinPoolDone, &coinPoolMutex);
+    pthread_mutex_unlock(&coinPoolMutex);
+    return;
+  }
+#endif
+  for (int i = 0; i < number; i++)
+    function(base + i * sizeInfo);
+}
+
+bool CoinThreadPool::inTask()
+{
+#ifdef COINUTILS_PTHREADS
+  return coinPoolInTask != 0;
+#else
+  return false;
+#endif
+}
+
+int CoinThreadPool::numberThreads()
+{
+#ifdef COINUTILS_PTHREADS
+  if (!coinPoolNumberThreads) {
+    int number = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    number = static_cast< int >(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+    coinPoolNumberThreads = number > 1 ? number : 1;
+  }
+  return coinPoolNumberThreads;
+#else
+  return 1;
+#endif
+}
+
+void CoinThreadPool::setNumberThreads(int value)
+{
+#ifdef COINUTILS_PTHREADS
+  coinPoolStopThreads();
+  coinPoolNumberThreads = value > 1 ? value : 1;
+#else
+  (void)value;
+#endif
+}
+
+bool CoinThreadPool::pinThreads()
+{
+  return coinPoolPin;
+}
+
+void CoinThreadPool::setPinThreads(bool yesNo)
+{
+  coinPoolPin = yesNo;
+}
+
+void CoinThreadPool::setRunner(CoinTaskRunner runner, void *data)
+{
+  coinPoolRunner = runner;
+  coinPoolRunnerData = data;
+}
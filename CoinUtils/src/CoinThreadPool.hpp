@@ -0,0 +1,87 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinThreadPool_H
+#define CoinThreadPool_H
+
+#include <cstddef>
+
+#include "CoinUtilsConfig.h"
+
+/*! \file CoinThreadPool.hpp
+  \brief One pool of threads for all parallel work in CoinUtils
+
+  Parallel code in CoinUtils splits its work into a number of independent
+  tasks - usually one per thread asked for - each with its own piece of
+  an array of information, and hands them to
+
+  \code
+    CoinThreadPool::run(worker, thread, sizeof(thread[0]), numberTasks);
+  \endcode
+
+  which returns when all tasks are done.  The calling thread does tasks
+  too.  The rest are taken, first come first served, by the threads of
+  one pool which are started on first use and then wait for work, so
+  however many parallel paths are in use at most numberThreads() threads
+  are busy.  Tasks must not wait for each other.
+
+  A task which itself calls run (nested parallelism) does all its tasks
+  in its own thread, as do calls when there is one thread.  An
+  application with its own pool can take over all tasks by
+  setRunner - nesting is then left to the application's pool.
+
+  Without COINUTILS_PTHREADS tasks are done one after another (or by the
+  runner if one is set).
+*/
+
+/// Body of a task - info is its own piece of the information array
+typedef void *(*CoinTaskFunction)(void *info);
+
+/** Runs \p number tasks of \p function for an application's own pool
+    (TBB, OpenMP ...).  Must call function(info + i * sizeInfo) for i from
+    0 to number-1 and return when all are done. \p data is as given to
+    CoinThreadPool::setRunner. */
+typedef void (*CoinTaskRunner)(CoinTaskFunction function, char *info,
+  int sizeInfo, int number, void *data);
+
+/** Shared pool of threads.
+
+  All static.
+*/
+class CoinThreadPool {
+public:
+  /**@name Running tasks */
+  //@{
+  /** Does function(info + i * sizeInfo) for i from 0 to number-1,
+      returning when all are done. Thread safe. */
+  static void run(CoinTaskFunction function, void *info, int sizeInfo,
+    int number);
+  /// True if calling thread is doing a task (so run would be serial)
+  static bool inTask();
+  //@}
+
+  /**@name Policy */
+  //@{
+  /** Number of threads (including callers of run) which may do tasks.
+      Defaults to number of processors online; always 1 without
+      COINUTILS_PTHREADS */
+  static int numberThreads();
+  /** Sets number of threads.  Any pool threads are stopped (so this must
+      not be called while tasks are running) and as many as needed are
+      started at next run */
+  static void setNumberThreads(int value);
+  /// Whether pool threads are pinned to cores
+  static bool pinThreads();
+  /** Sets pinning of pool threads - thread i to core i+1 (wrapping) so
+      callers can keep core 0. Linux only; takes effect as threads are
+      started */
+  static void setPinThreads(bool yesNo);
+  /** Passes all tasks to \p runner (NULL to go back to the pool).
+      \p data is passed on to the runner */
+  static void setRunner(CoinTaskRunner runner, void *data = NULL);
+  //@}
+};
+
+#endif
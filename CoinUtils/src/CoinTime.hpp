@@ -75,23 +75,95 @@ inline double CoinGetTimeOfDay()
 
 #endif // _MSC_VER
 
+//#############################################################################
+
+/**
+   Seconds from an arbitrary start on a clock which never goes back
+   (clock_gettime(CLOCK_MONOTONIC) where there is one, else
+   CoinGetTimeOfDay). Only differences mean anything.
+*/
+inline double CoinMonotonicTime()
+{
+#if defined(CLOCK_MONOTONIC) && !defined(_MSC_VER)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + 1.0e-9*static_cast<double>(ts.tv_nsec);
+#else
+    return CoinGetTimeOfDay();
+#endif
+}
+
 /**
    Query the elapsed wallclock time since the first call to this function. If
    a positive argument is passed to the function then the time of the first
    call is set to that value (this kind of argument is allowed only at the
    first call!). If a negative argument is passed to the function then it
    returns the time when it was set.
+
+   The time of day is read only at the first call; later times are measured
+   on CoinMonotonicTime from there, so a change of the system clock does not
+   upset elapsed times.
 */
 
 inline double CoinWallclockTime(double callType = 0)
 {
-    double callTime = CoinGetTimeOfDay();
+    static const double offset = CoinGetTimeOfDay() - CoinMonotonicTime();
+    double callTime = CoinMonotonicTime() + offset;
     static const double firstCall = callType > 0 ? callType : callTime;
     return callType < 0 ? firstCall : callTime - firstCall;
 }
 
 //#############################################################################
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define COIN_HAS_CYCLE_COUNTER
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+/**
+   Count of processor cycles (the time stamp counter on x86, else
+   nanoseconds of CoinMonotonicTime). Cheap enough for timing short hot
+   paths; convert with CoinCyclesPerSecond(). Counters of different cores
+   are assumed to agree, as they do on current x86 processors.
+*/
+inline unsigned long long CoinCycleCount()
+{
+#ifdef COIN_HAS_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return static_cast<unsigned long long>(CoinMonotonicTime()*1.0e9);
+#endif
+}
+
+/**
+   Cycles of CoinCycleCount in a second. With a time stamp counter this is
+   measured (over 20 milliseconds) on the first call.
+*/
+inline double CoinCyclesPerSecond()
+{
+#ifdef COIN_HAS_CYCLE_COUNTER
+    static double rate = 0.0;
+    if (!rate) {
+      double startTime = CoinMonotonicTime();
+      unsigned long long startCycles = CoinCycleCount();
+      double endTime;
+      do {
+	endTime = CoinMonotonicTime();
+      } while (endTime < startTime+0.02);
+      rate = static_cast<double>(CoinCycleCount()-startCycles)/(endTime-startTime);
+    }
+    return rate;
+#else
+    return 1.0e9;
+#endif
+}
+
+//#############################################################################
+
 //#define HAVE_SDK // if SDK under Win32 is installed, for CPU instead of elapsed time under Win 
 #ifdef HAVE_SDK
 #include <windows.h>
@@ -136,6 +208,23 @@ static inline double CoinCpuTime()
 
 //#############################################################################
 
+/**
+   CPU seconds used by the calling thread (CLOCK_THREAD_CPUTIME_ID where
+   there is one, else CoinCpuTime, which is for the whole process).
+   Values of different threads can not be compared.
+*/
+static inline double CoinThreadCpuTime()
+{
+#if defined(CLOCK_THREAD_CPUTIME_ID) && !defined(_MSC_VER)
+  struct timespec ts;
+  if (!clock_gettime(CLOCK_THREAD_CPUTIME_ID,&ts))
+    return static_cast<double>(ts.tv_sec) + 1.0e-9*static_cast<double>(ts.tv_nsec);
+#endif
+  return CoinCpuTime();
+}
+
+//#############################################################################
+
 
 
 static inline double CoinSysTime()
@@ -196,12 +285,25 @@ static inline double CoinCpuTimeJustChildren()
 */
 class CoinTimer
 {
+public:
+   /// Clocks a timer can run on
+   enum Clock {
+      /// CPU time of the whole process (CoinCpuTime)
+      processCpu = 0,
+      /// CPU time of the thread which queries (CoinThreadCpuTime)
+      threadCpu,
+      /// Elapsed time (CoinMonotonicTime)
+      wallclock
+   };
+
 private:
    /// When the timer was initialized/reset/restarted
    double start;
    /// 
    double limit;
    double end;
+   /// Clock in use
+   Clock clock_;
 #ifdef COIN_COMPILE_WITH_TRACING
    std::fstream* stream;
    bool write_stream;
@@ -236,11 +338,22 @@ private:
       return d_tmp;
    }
 #endif   
+   /// Time now on the timer's clock
+   inline double now() const {
+      switch (clock_) {
+      case threadCpu:
+	 return CoinThreadCpuTime();
+      case wallclock:
+	 return CoinMonotonicTime();
+      default:
+	 return CoinCpuTime();
+      }
+   }
 
 public:
    /// Default constructor creates a timer with no time limit and no tracing
    CoinTimer() :
-      start(0), limit(1e100), end(1e100)
+      start(0), limit(1e100), end(1e100), clock_(processCpu)
 #ifdef COIN_COMPILE_WITH_TRACING
       , stream(0), write_stream(true)
 #endif
@@ -248,28 +361,38 @@ public:
 
    /// Create a timer with the given time limit and with no tracing
    CoinTimer(double lim) :
-      start(CoinCpuTime()), limit(lim), end(start+lim)
+      start(CoinCpuTime()), limit(lim), end(start+lim), clock_(processCpu)
 #ifdef COIN_COMPILE_WITH_TRACING
       , stream(0), write_stream(true)
 #endif
    {}
 
+   /** Create a timer on the given clock with the given time limit and with
+       no tracing. A threadCpu timer gives each worker its own budget; it
+       must be queried from the thread which started it. */
+   CoinTimer(double lim, Clock clock) :
+      start(0), limit(lim), end(lim), clock_(clock)
+#ifdef COIN_COMPILE_WITH_TRACING
+      , stream(0), write_stream(true)
+#endif
+   { restart(); }
+
 #ifdef COIN_COMPILE_WITH_TRACING
    /** Create a timer with no time limit and with writing/reading the trace
        to/from the given stream, depending on the argument \c write. */
    CoinTimer(std::fstream* s, bool write) :
-      start(0), limit(1e100), end(1e100),
+      start(0), limit(1e100), end(1e100), clock_(processCpu),
       stream(s), write_stream(write) {}
    
    /** Create a timer with the given time limit and with writing/reading the
        trace to/from the given stream, depending on the argument \c write. */
    CoinTimer(double lim, std::fstream* s, bool w) :
-      start(CoinCpuTime()), limit(lim), end(start+lim),
+      start(CoinCpuTime()), limit(lim), end(start+lim), clock_(processCpu),
       stream(s), write_stream(w) {}
 #endif
    
    /// Restart the timer (keeping the same time limit)
-   inline void restart() { start=CoinCpuTime(); end=start+limit; }
+   inline void restart() { start=now(); end=start+limit; }
    /// An alternate name for \c restart()
    inline void reset() { restart(); }
    /// Reset (and restart) the timer and change its time limit
@@ -278,27 +401,130 @@ public:
    /** Return whether the given percentage of the time limit has elapsed since
        the timer was started */
    inline bool isPastPercent(double pct) const {
-      return evaluate(start + limit * pct < CoinCpuTime());
+      return evaluate(start + limit * pct < now());
    }
    /** Return whether the given amount of time has elapsed since the timer was
        started */
    inline bool isPast(double lim) const {
-      return evaluate(start + lim < CoinCpuTime());
+      return evaluate(start + lim < now());
    }
    /** Return whether the originally specified time limit has passed since the
        timer was started */
    inline bool isExpired() const {
-      return evaluate(end < CoinCpuTime());
+      return evaluate(end < now());
    }
 
    /** Return how much time is left on the timer */
    inline double timeLeft() const {
-      return evaluate(end - CoinCpuTime());
+      return evaluate(end - now());
    }
 
    /** Return how much time has elapsed */
    inline double timeElapsed() const {
-      return evaluate(CoinCpuTime() - start);
+      return evaluate(now() - start);
+   }
+
+   inline void setLimit(double l) {
+      limit = l;
+      return;
+   }
+
+   /// Change clock (restarts the timer)
+   inline void setClock(Clock clock) { clock_=clock; restart(); }
+   /// Clock in use
+   inline Clock getClock() const { return clock_; }
+};
+
+//#############################################################################
+
+#if defined(_MSC_VER)
+#define COIN_WORK_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define COIN_WORK_THREAD_LOCAL __thread
+#else
+#define COIN_WORK_THREAD_LOCAL
+#endif
+
+/**
+   Work units done by the calling thread. Instrumented kernels charge it
+   with CoinChargeWork: FTRAN and BTRAN the nonzeros in and out,
+   factorization the elements of L and U it made, matrix times vector the
+   coefficients (or nonzeros of a sparse vector) and presolve what it adds
+   with CoinPresolveMatrix::addWork. The same work on the same data always
+   gives the same count, whatever the machine or its load.
+*/
+inline double &CoinWorkDone()
+{
+  static COIN_WORK_THREAD_LOCAL double work = 0.0;
+  return work;
+}
+
+/// Charge \p work units to the calling thread
+inline void CoinChargeWork(double work)
+{
+  CoinWorkDone() += work;
+}
+
+/**
+ A timer on the deterministic work clock (CoinWorkDone), used like
+ CoinTimer: a limit is in work units and a search with such a limit stops
+ at the same point on every run.
+
+ The clock is that of the thread which queries, so create and query a
+ timer in one thread. Work done for it by other threads (which charge
+ their own clocks) can be credited with addWork - add it at a fixed point,
+ such as when the helpers are joined, to stay deterministic.
+*/
+class CoinWorkTimer
+{
+private:
+   /// Work at start (less credited work)
+   double start;
+   double limit;
+   double end;
+
+public:
+   /// Default constructor creates a timer with no work limit
+   CoinWorkTimer() :
+      start(CoinWorkDone()), limit(1e100), end(1e100) {}
+
+   /// Create a timer with the given work limit
+   CoinWorkTimer(double lim) :
+      start(CoinWorkDone()), limit(lim), end(start+lim) {}
+
+   /// Restart the timer (keeping the same work limit)
+   inline void restart() { start=CoinWorkDone(); end=start+limit; }
+   /// An alternate name for \c restart()
+   inline void reset() { restart(); }
+   /// Reset (and restart) the timer and change its work limit
+   inline void reset(double lim) { limit=lim; restart(); }
+   /// Credit work done by other threads
+   inline void addWork(double work) { start-=work; end-=work; }
+
+   /** Return whether the given percentage of the work limit has been done
+       since the timer was started */
+   inline bool isPastPercent(double pct) const {
+      return start + limit * pct < CoinWorkDone();
+   }
+   /** Return whether the given amount of work has been done since the timer
+       was started */
+   inline bool isPast(double lim) const {
+      return start + lim < CoinWorkDone();
+   }
+   /** Return whether the work limit has been reached since the timer was
+       started */
+   inline bool isExpired() const {
+      return end < CoinWorkDone();
+   }
+
+   /** Return how much work is left on the timer */
+   inline double timeLeft() const {
+      return end - CoinWorkDone();
+   }
+
+   /** Return how much work has been done */
+   inline double timeElapsed() const {
+      return CoinWorkDone() - start;
    }
 
    inline void setLimit(double l) {
@@ -31,6 +31,8 @@ typedef long CoinBigIndex;
 #else
 typedef long long CoinBigIndex;
 #endif
+/// Element counts of CoinPackedMatrix64, whatever CoinBigIndex is
+typedef CoinInt64 CoinBigIndex64;
 
 //=============================================================================
 #ifndef COIN_BIG_DOUBLE
@@ -61,4 +63,15 @@ typedef long double CoinFactorizationDouble;
 typedef double CoinFactorizationDouble;
 #endif
 
+//=============================================================================
+/* Move constructors and move assignment are only declared when the
+   compiler has rvalue references. */
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define COIN_HAS_MOVE 1
+#define COIN_NOEXCEPT noexcept
+#else
+#define COIN_HAS_MOVE 0
+#define COIN_NOEXCEPT
+#endif
+
 #endif
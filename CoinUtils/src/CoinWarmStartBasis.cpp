@@ -10,6 +10,7 @@
 
 #include "CoinUtilsConfig.h"
 #include <cassert>
+#include <cstring>
 
 #include "CoinWarmStartBasis.hpp"
 #include "CoinHelperFunctions.hpp"
@@ -133,6 +134,32 @@ CoinWarmStartBasis::operator=(const CoinWarmStartBasis& rhs)
   return *this;
 }
 
+#if COIN_HAS_MOVE
+CoinWarmStartBasis::CoinWarmStartBasis(CoinWarmStartBasis&& ws) COIN_NOEXCEPT :
+  numStructural_(0), numArtificial_(0), maxSize_(0),
+  structuralStatus_(NULL), artificialStatus_(NULL) {
+  swap(ws);
+}
+
+CoinWarmStartBasis& 
+CoinWarmStartBasis::operator=(CoinWarmStartBasis&& rhs) COIN_NOEXCEPT
+{
+  swap(rhs);
+  return *this;
+}
+#endif
+
+// Artificial status is part of structural array so goes with it
+void
+CoinWarmStartBasis::swap(CoinWarmStartBasis& rhs)
+{
+  std::swap(numStructural_,rhs.numStructural_);
+  std::swap(numArtificial_,rhs.numArtificial_);
+  std::swap(maxSize_,rhs.maxSize_);
+  std::swap(structuralStatus_,rhs.structuralStatus_);
+  std::swap(artificialStatus_,rhs.artificialStatus_);
+}
+
 // Resizes 
 void 
 CoinWarmStartBasis::resize (int newNumberRows, int newNumberColumns)
@@ -248,83 +275,93 @@ void CoinWarmStartBasis::compressRows (int tgtCnt, const int *tgts)
 
 /*
   deleteRows takes an unordered list of target indices with duplicates and
-  removes them from the basis. The strategy is to preprocesses the list into
-  an ascending list without duplicates, suitable for compressRows.
+  removes them from the basis. A map of new positions (CoinDeletionMap)
+  replaces sorting the list, then one pass over the status array compacts it.
 */
 void 
 CoinWarmStartBasis::deleteRows (int rawTgtCnt, const int *rawTgts)
-{ if (rawTgtCnt <= 0) return ;
-
-  int i;
-  int last=-1;
-  bool ordered=true;
-  for (i=0;i<rawTgtCnt;i++) {
-    int iRow = rawTgts[i];
-    if (iRow>last) {
-      last=iRow;
-    } else {
-      ordered=false;
-      break;
-    }
-  }
-  if (ordered) {
-    compressRows(rawTgtCnt,rawTgts) ;
-  } else {
-    int * tgts = new int[rawTgtCnt] ;
-    CoinMemcpyN(rawTgts,rawTgtCnt,tgts);
-    int *first = &tgts[0] ;
-    int *last = &tgts[rawTgtCnt] ;
-    int *endUnique ;
-    std::sort(first,last) ;
-    endUnique = std::unique(first,last) ;
-    int tgtCnt = static_cast<int>(endUnique-first) ;
-    compressRows(tgtCnt,tgts) ;
-    delete [] tgts ;
-  }
+{ if (rawTgtCnt <= 0 || numArtificial_ <= 0) return ;
+
+  int * newIndex = new int[numArtificial_] ;
+  CoinDeletionMap(numArtificial_,rawTgtCnt,rawTgts,newIndex) ;
+  remapRows(newIndex) ;
+  delete [] newIndex ;
   return  ; }
 
 // Deletes columns
 void 
 CoinWarmStartBasis::deleteColumns(int number, const int * which)
 {
-  int i ;
-  char * deleted = new char[numStructural_];
-  int numberDeleted=0;
-  memset(deleted,0,numStructural_*sizeof(char));
-  for (i=0;i<number;i++) {
-    int j = which[i];
-    if (j>=0&&j<numStructural_&&!deleted[j]) {
-      numberDeleted++;
-      deleted[j]=1;
-    }
+  if (number <= 0 || numStructural_ <= 0)
+    return;
+  int * newIndex = new int[numStructural_];
+  CoinDeletionMap(numStructural_,number,which,newIndex);
+  remapColumns(newIndex);
+  delete [] newIndex;
+}
+
+/*
+  Entries move down (newIndex[i] <= i), so compaction can be done in place:
+  the two bits written never belong to an entry not yet read. Entries before
+  the first deletion stay where they are.
+*/
+void
+CoinWarmStartBasis::remapRows (const int * newIndex)
+{ int i = 0 ;
+  while (i < numArtificial_ && newIndex[i] == i) i++ ;
+  int put = i ;
+# ifdef COIN_DEBUG
+  int nbCnt = 0 ;
+# endif
+  for ( ; i < numArtificial_ ; i++)
+  { Status stati = getStatus(artificialStatus_,i) ;
+    if (newIndex[i] >= 0)
+    { setStatus(artificialStatus_,put++,stati) ; }
+#   ifdef COIN_DEBUG
+    else
+    if (stati != CoinWarmStartBasis::basic)
+    { nbCnt++ ; }
+#   endif
   }
-  int nCharNewS  = 4*((numStructural_-numberDeleted+15)>>4);
-  int nCharNewA  = 4*((numArtificial_+15)>>4);
-  char * array = new char[4*maxSize_];
-# ifdef ZEROFAULT
-  memset(array,0,(4*maxSize_*sizeof(char))) ;
+# ifdef COIN_DEBUG
+  if (nbCnt > 0)
+  { std::cout << nbCnt << " nonbasic artificials deleted." << std::endl ; }
 # endif
-  CoinMemcpyN(artificialStatus_,nCharNewA,array+nCharNewS);
-  int put=0;
+  numArtificial_ = put ;
+  return ; }
+
+/*
+  As remapRows, then the artificial statuses are moved down to follow the
+  (possibly shorter) structural ones.
+*/
+void
+CoinWarmStartBasis::remapColumns (const int * newIndex)
+{
+  int i = 0;
+  while (i < numStructural_ && newIndex[i] == i)
+    i++;
+  int put = i;
 # ifdef COIN_DEBUG
   int numberBasic=0;
 # endif
-  for (i=0;i<numStructural_;i++) {
-    Status status = getStructStatus(i);
-    if (!deleted[i]) {
-      setStatus(array,put,status) ;
-      put++; }
+  for ( ; i < numStructural_ ; i++) {
+    Status status = getStatus(structuralStatus_,i);
+    if (newIndex[i] >= 0)
+      setStatus(structuralStatus_,put++,status);
 #   ifdef COIN_DEBUG
     else
     if (status==CoinWarmStartBasis::basic)
-    { numberBasic++ ; }
+      numberBasic++;
 #   endif
   }
-  delete [] structuralStatus_;
-  structuralStatus_ = array;
-  artificialStatus_ = structuralStatus_ + nCharNewS;
-  delete [] deleted;
-  numStructural_ -= numberDeleted;
+  int nCharNewS  = 4*((put+15)>>4);
+  int nCharNewA  = 4*((numArtificial_+15)>>4);
+  char * newArtificial = structuralStatus_ + nCharNewS;
+  if (newArtificial != artificialStatus_) {
+    memmove(newArtificial,artificialStatus_,nCharNewA);
+    artificialStatus_ = newArtificial;
+  }
+  numStructural_ = put;
 #ifdef COIN_DEBUG
   if (numberBasic)
     std::cout<<numberBasic<<" basic structurals deleted"<<std::endl;
@@ -510,6 +547,32 @@ CoinWarmStartBasis::fixFullBasis()
   }
   return returnCode;
 }
+/*
+  Append to diffNdx/diffVal the words of newStatus which differ from
+  oldStatus, tagging indices with tag. Two words are compared at a time, as
+  one 64-bit XOR, so long unchanged stretches go quickly.
+*/
+static inline void scanStatusDiff (const unsigned int *oldStatus,
+				   const unsigned int *newStatus, int n,
+				   unsigned int tag, unsigned int *diffNdx,
+				   unsigned int *diffVal, int &numberChanged)
+{ int i = 0 ;
+  for ( ; i+1 < n ; i += 2)
+  { CoinUInt64 oldPair ;
+    CoinUInt64 newPair ;
+    memcpy(&oldPair,oldStatus+i,sizeof(oldPair)) ;
+    memcpy(&newPair,newStatus+i,sizeof(newPair)) ;
+    if ((oldPair^newPair) == 0) continue ;
+    if (oldStatus[i] != newStatus[i])
+    { diffNdx[numberChanged] = i|tag ;
+      diffVal[numberChanged++] = newStatus[i] ; }
+    if (oldStatus[i+1] != newStatus[i+1])
+    { diffNdx[numberChanged] = (i+1)|tag ;
+      diffVal[numberChanged++] = newStatus[i+1] ; } }
+  if (i < n && oldStatus[i] != newStatus[i])
+  { diffNdx[numberChanged] = i|tag ;
+    diffVal[numberChanged++] = newStatus[i] ; } }
+
 /*
   Generate a diff that'll convert oldCWS into the basis pointed to by this.
 
@@ -571,11 +634,9 @@ CoinWarmStartBasis::generateDiff (const CoinWarmStart *const oldCWS) const
       reinterpret_cast<const unsigned int *>(newBasis->getArtificialStatus()) ;
   int numberChanged = 0 ;
   int i ;
-  for (i = 0 ; i < sizeOldArtif ; i++)
-  { if (oldStatus[i] != newStatus[i])
-    { diffNdx[numberChanged] = i|0x80000000 ;
-      diffVal[numberChanged++] = newStatus[i] ; } }
-  for ( ; i < sizeNewArtif ; i++)
+  scanStatusDiff(oldStatus,newStatus,sizeOldArtif,0x80000000,
+		 diffNdx,diffVal,numberChanged) ;
+  for (i = sizeOldArtif ; i < sizeNewArtif ; i++)
   { diffNdx[numberChanged] = i|0x80000000 ;
     diffVal[numberChanged++] = newStatus[i] ; }
 /*
@@ -585,21 +646,47 @@ CoinWarmStartBasis::generateDiff (const CoinWarmStart *const oldCWS) const
       reinterpret_cast<const unsigned int *>(oldBasis->getStructuralStatus()) ;
   newStatus =
       reinterpret_cast<const unsigned int *>(newBasis->getStructuralStatus()) ;
-  for (i = 0 ; i < sizeOldStruct ; i++)
-  { if (oldStatus[i] != newStatus[i])
-    { diffNdx[numberChanged] = i ;
-      diffVal[numberChanged++] = newStatus[i] ; } }
-  for ( ; i < sizeNewStruct ; i++)
+  scanStatusDiff(oldStatus,newStatus,sizeOldStruct,0,
+		 diffNdx,diffVal,numberChanged) ;
+  for (i = sizeOldStruct ; i < sizeNewStruct ; i++)
   { diffNdx[numberChanged] = i ;
     diffVal[numberChanged++] = newStatus[i] ; }
+/*
+  Count the runs of consecutive words. The tag bit keeps logical and
+  structural runs apart. Run-length encoding wins when the runs average
+  more than two words.
+*/
+  int numberRuns = 0 ;
+  for (i = 0 ; i < numberChanged ; i++)
+  { if (i == 0 || diffNdx[i] != diffNdx[i-1]+1)
+      numberRuns++ ; }
+  const bool useRuns = (2*numberRuns+numberChanged < 2*numberChanged) ;
+  const int diffLength =
+    (useRuns) ? 2*numberRuns+numberChanged : 2*numberChanged ;
 /*
   Create the object of our desire.
 */
   CoinWarmStartBasisDiff *diff;
-  if ((numberChanged*2<maxBasisLength+1||!newStructCnt)&&true)
-    diff = new CoinWarmStartBasisDiff(numberChanged,diffNdx,diffVal) ;
-  else
+  if (diffLength<maxBasisLength+1||!newStructCnt) {
+    if (useRuns) {
+      unsigned int *runStart = new unsigned int [2*numberRuns] ;
+      unsigned int *runLength = runStart+numberRuns ;
+      int k = -1 ;
+      for (i = 0 ; i < numberChanged ; i++)
+      { if (i == 0 || diffNdx[i] != diffNdx[i-1]+1)
+	{ k++ ;
+	  runStart[k] = diffNdx[i] ;
+	  runLength[k] = 0 ; }
+	runLength[k]++ ; }
+      diff = new CoinWarmStartBasisDiff(numberRuns,runStart,runLength,
+					numberChanged,diffVal) ;
+      delete [] runStart ;
+    } else {
+      diff = new CoinWarmStartBasisDiff(numberChanged,diffNdx,diffVal) ;
+    }
+  } else {
     diff = new CoinWarmStartBasisDiff(newBasis) ;
+  }
 /*
   Clean up and return.
 */
@@ -633,7 +720,23 @@ void CoinWarmStartBasis::applyDiff (const CoinWarmStartDiff *const cwsdDiff)
     reinterpret_cast<unsigned int *>(this->getStructuralStatus()) ;
   unsigned int *artifStatus =
     reinterpret_cast<unsigned int *>(this->getArtificialStatus()) ;
-  if (numberChanges>=0) {
+  if (diff->runs_ > 0) {
+/*
+  Run-length encoded: copy each run in one go.
+*/
+    const int numberRuns = diff->runs_ ;
+    const unsigned int *runStart = diff->difference_ ;
+    const unsigned int *runLength = runStart+numberRuns ;
+    const unsigned int *diffVals = runLength+numberRuns ;
+    for (int i = 0 ; i < numberRuns ; i++)
+    { const unsigned int start = runStart[i] ;
+      const int length = static_cast<int>(runLength[i]) ;
+      if ((start&0x80000000) == 0)
+	CoinMemcpyN(diffVals,length,structStatus+start) ;
+      else
+	CoinMemcpyN(diffVals,length,artifStatus+(start&0x7fffffff)) ;
+      diffVals += length ; }
+  } else if (numberChanges>=0) {
     const unsigned int *diffNdxs = diff->difference_ ;
     const unsigned int *diffVals = diffNdxs+numberChanges ;
     
@@ -674,6 +777,7 @@ const char *statusName (CoinWarmStartBasis::Status status) {
 CoinWarmStartBasisDiff::CoinWarmStartBasisDiff (int sze,
   const unsigned int *const diffNdxs, const unsigned int *const diffVals)
   : sze_(sze),
+    runs_(0),
     difference_(NULL)
 
 { if (sze > 0)
@@ -681,12 +785,32 @@ CoinWarmStartBasisDiff::CoinWarmStartBasisDiff (int sze,
     CoinMemcpyN(diffNdxs,sze,difference_);
     CoinMemcpyN(diffVals,sze,difference_+sze_); }
   
+  return ; }
+/*
+  Run-length constructor.
+*/
+CoinWarmStartBasisDiff::CoinWarmStartBasisDiff (int nRuns,
+  const unsigned int *const runStarts, const unsigned int *const runLengths,
+  int sze, const unsigned int *const diffVals)
+  : sze_(sze),
+    runs_(nRuns),
+    difference_(NULL)
+
+{ if (sze > 0)
+  { difference_ = new unsigned int[2*nRuns+sze] ;
+    CoinMemcpyN(runStarts,nRuns,difference_);
+    CoinMemcpyN(runLengths,nRuns,difference_+nRuns);
+    CoinMemcpyN(diffVals,sze,difference_+2*nRuns); }
+  else
+  { runs_ = 0 ; }
+
   return ; }
 /*
   Constructor when full is smaller than diff!
 */
 CoinWarmStartBasisDiff::CoinWarmStartBasisDiff (const CoinWarmStartBasis * rhs)
   : sze_(0),
+    runs_(0),
     difference_(0)
 {
   const int artifCnt = rhs->getNumArtificial() ;
@@ -712,9 +836,10 @@ CoinWarmStartBasisDiff::CoinWarmStartBasisDiff (const CoinWarmStartBasis * rhs)
 CoinWarmStartBasisDiff::CoinWarmStartBasisDiff
   (const CoinWarmStartBasisDiff &rhs)
   : sze_(rhs.sze_),
+    runs_(rhs.runs_),
     difference_(0)
 { if (sze_ >0)
-    { difference_ = CoinCopyOfArray(rhs.difference_,2*sze_); }
+    { difference_ = CoinCopyOfArray(rhs.difference_,rhs.allocated()); }
   else if (sze_<0) {
     const unsigned int * diff = rhs.difference_ -1;
     const int artifCnt = static_cast<int> (diff[0]);
@@ -743,8 +868,9 @@ CoinWarmStartBasisDiff::operator= (const CoinWarmStartBasisDiff &rhs)
 	delete [] diff;
       }
     sze_ = rhs.sze_ ;
+    runs_ = rhs.runs_ ;
     if (sze_ > 0)
-      { difference_ = CoinCopyOfArray(rhs.difference_,2*sze_); }
+      { difference_ = CoinCopyOfArray(rhs.difference_,rhs.allocated()); }
     else if (sze_<0) {
       const unsigned int * diff = rhs.difference_ -1;
       const int artifCnt = static_cast<int> (diff[0]);
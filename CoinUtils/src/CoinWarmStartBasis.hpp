@@ -237,6 +237,22 @@ public:
 
   virtual void deleteColumns(int number, const int * which);
 
+  /** \brief Delete rows given a map of new positions
+
+    \p newIndex has an entry for each row of the basis: its new position,
+    or -1 if it is deleted. Positions must keep the order of the rows
+    kept (as from CoinDeletionMap, which deleteRows() uses). Lets a client
+    deleting the same rows from a model and a basis build the map once.
+    The warnings for deleteRows() apply.
+  */
+  void remapRows(const int * newIndex);
+
+  /** \brief Delete columns given a map of new positions
+
+    As remapRows(). The warnings for deleteColumns() apply.
+  */
+  void remapColumns(const int * newIndex);
+
   /** \brief Merge entries from a source basis into this basis.
 
     \warning
@@ -293,6 +309,18 @@ public:
 
   virtual CoinWarmStartBasis& operator=(const CoinWarmStartBasis& rhs) ;
 
+#if COIN_HAS_MOVE
+  /** Move constructor.  Takes the status arrays of \p ws, which is left
+      as an empty basis. */
+  CoinWarmStartBasis(CoinWarmStartBasis&& ws) COIN_NOEXCEPT ;
+
+  /** Move assignment (exchanges status arrays with \p rhs) */
+  CoinWarmStartBasis& operator=(CoinWarmStartBasis&& rhs) COIN_NOEXCEPT ;
+#endif
+
+  /** Exchange status arrays with \p rhs (no copying) */
+  void swap(CoinWarmStartBasis& rhs) ;
+
   /** Assign the status vectors to be the warm start information.
   
       In this method the CoinWarmStartBasis object assumes ownership of the
@@ -380,8 +408,18 @@ const char *statusName(CoinWarmStartBasis::Status status) ;
   applying diffs, is restricted to the friend functions
   CoinWarmStartBasis::generateDiff() and CoinWarmStartBasis::applyDiff().
 
-  The actual data structure is an unsigned int vector, #difference_ which
-  starts with indices of changed and then has values starting after #sze_
+  The actual data structure is an unsigned int vector, #difference_, in
+  one of three forms:
+  <ul>
+    <li> #sze_ > 0, #runs_ == 0: the indices of the changed words, then
+	 their values starting after #sze_;
+    <li> #sze_ > 0, #runs_ > 0: the first index of each run of consecutive
+	 changed words, the length of each run, then the #sze_ values;
+    <li> #sze_ < 0: the whole basis (see the constructor from a basis).
+  </ul>
+  generateDiff() picks whichever is smallest, so changes that cluster (a
+  block of rows or columns) cost one index each rather than one per word,
+  and applyDiff() copies each run in one go.
 
   \todo This is a pretty generic structure, and vector diff is a pretty generic
 	activity. We should be able to convert this to a template.
@@ -415,7 +453,7 @@ class CoinWarmStartBasisDiff : public virtual CoinWarmStartDiff
     see it when they make <i>their</i> default constructor protected or
     private.
   */
-  CoinWarmStartBasisDiff () : sze_(0), difference_(0) { } 
+  CoinWarmStartBasisDiff () : sze_(0), runs_(0), difference_(0) { } 
 
   /*! \brief Copy constructor
   
@@ -435,6 +473,20 @@ class CoinWarmStartBasisDiff : public virtual CoinWarmStartDiff
 
   /*! \brief Constructor when full is smaller than diff!*/
   CoinWarmStartBasisDiff (const CoinWarmStartBasis * rhs);
+
+  /*! \brief Run-length constructor
+
+    \p runStarts and \p runLengths give \p nRuns runs of consecutive
+    words (tagged as for the standard constructor), \p diffVals the
+    \p sze values in order.
+  */
+  CoinWarmStartBasisDiff (int nRuns, const unsigned int *const runStarts,
+			  const unsigned int *const runLengths,
+			  int sze, const unsigned int *const diffVals) ;
+
+  /*! \brief Number of unsigned ints held in #difference_ (for sze_ >= 0) */
+  inline int allocated () const
+  { return ((runs_ > 0) ? 2*runs_+sze_ : 2*sze_) ; }
   
   private:
 
@@ -442,10 +494,14 @@ class CoinWarmStartBasisDiff : public virtual CoinWarmStartDiff
     CoinWarmStartBasis::generateDiff(const CoinWarmStart *const oldCWS) const ;
   friend void
     CoinWarmStartBasis::applyDiff(const CoinWarmStartDiff *const diff) ;
+  friend class CoinWarmStartSharedBasis ;
 
   /*! \brief Number of entries (and allocated capacity), in units of \c int. */
   int sze_ ;
 
+  /*! \brief Number of runs if run-length encoded, else 0 */
+  int runs_ ;
+
   /*! \brief Array of diff indices and diff values */
 
   unsigned int *difference_ ;
@@ -0,0 +1,155 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinWarmStartDiffCoder_H
+#define CoinWarmStartDiffCoder_H
+
+#include <cstdio>
+#include <vector>
+
+#include "CoinTypes.hpp"
+
+/*! \file CoinWarmStartDiffCoder.hpp
+  \brief Compact byte encoding of warm start diffs
+
+  The diffs of CoinWarmStartVector and CoinWarmStartPrimalDual encode
+  themselves (CoinWarmStartVectorDiff::encode()) as
+
+    - the number of entries as a varint;
+    - a mode byte (#CoinDiffExact or #CoinDiffFloat);
+    - each index as the zigzag varint of its difference from the one
+      before, which is one byte for most entries of a diff from
+      generateDiff(), whose indices ascend;
+    - the values, as T or (when quantising) as float.
+
+  A varint holds 7 bits per byte, low bits first, with the top bit set on
+  all bytes but the last. Values are in host byte order, so sender and
+  receiver must agree on it.
+
+  CoinWarmStartDiffWriter and CoinWarmStartDiffReader stream such
+  encodings as length prefixed records through a FILE (a file, a pipe or a
+  socket opened with fdopen).
+*/
+
+/// Value modes of an encoded diff
+enum CoinDiffValueMode {
+  /// Values as stored
+  CoinDiffExact = 0,
+  /// Values rounded to float
+  CoinDiffFloat = 1
+};
+
+/// Append \p value to \p buffer as a varint
+inline void CoinVarintPut(std::vector<unsigned char> &buffer, CoinUInt64 value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<unsigned char>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<unsigned char>(value));
+}
+
+/** Read a varint at \p buffer (not beyond \p end) into \p value and
+    advance \p buffer. Returns false if the varint is cut short or too long. */
+inline bool CoinVarintGet(const unsigned char *&buffer,
+  const unsigned char *end, CoinUInt64 &value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64 && buffer < end; shift += 7) {
+    const unsigned char byte = *buffer++;
+    value |= static_cast<CoinUInt64>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/// Zigzag mapping of a signed difference, so small magnitudes are small
+inline CoinUInt64 CoinZigzag(CoinInt64 value)
+{
+  return (static_cast<CoinUInt64>(value) << 1) ^ static_cast<CoinUInt64>(value >> 63);
+}
+inline CoinInt64 CoinUnzigzag(CoinUInt64 value)
+{
+  return static_cast<CoinInt64>(value >> 1) ^ -static_cast<CoinInt64>(value & 1);
+}
+
+//#############################################################################
+
+/** Writes encoded diffs to a FILE, each as a varint length then the bytes.
+
+  The FILE stays the caller's. Typical use:
+
+  \code
+    std::vector<unsigned char> buffer;
+    diff->encode(buffer, quantise);
+    writer.write(buffer);
+  \endcode
+*/
+class CoinWarmStartDiffWriter {
+public:
+  CoinWarmStartDiffWriter(FILE *fp)
+    : fp_(fp)
+    , bytes_(0)
+  {
+  }
+  /// Write one record. Returns false on a write error.
+  bool write(const std::vector<unsigned char> &record)
+  {
+    header_.clear();
+    CoinVarintPut(header_, record.size());
+    if (fwrite(&header_[0], 1, header_.size(), fp_) != header_.size())
+      return false;
+    if (!record.empty() && fwrite(&record[0], 1, record.size(), fp_) != record.size())
+      return false;
+    bytes_ += header_.size() + record.size();
+    return true;
+  }
+  /// Flush the FILE
+  bool flush()
+  {
+    return fflush(fp_) == 0;
+  }
+  /// Bytes written
+  inline size_t bytesWritten() const
+  {
+    return bytes_;
+  }
+
+private:
+  FILE *fp_;
+  std::vector<unsigned char> header_;
+  size_t bytes_;
+};
+
+/// Reads records written by CoinWarmStartDiffWriter
+class CoinWarmStartDiffReader {
+public:
+  CoinWarmStartDiffReader(FILE *fp)
+    : fp_(fp)
+  {
+  }
+  /** Read one record into \p record. Returns false at end of file or on a
+      short read. */
+  bool read(std::vector<unsigned char> &record)
+  {
+    CoinUInt64 size = 0;
+    int c;
+    for (int shift = 0;; shift += 7) {
+      if (shift >= 64 || (c = getc(fp_)) == EOF)
+        return false;
+      size |= static_cast<CoinUInt64>(c & 0x7f) << shift;
+      if (!(c & 0x80))
+        break;
+    }
+    record.resize(static_cast<size_t>(size));
+    return !size || fread(&record[0], 1, record.size(), fp_) == record.size();
+  }
+
+private:
+  FILE *fp_;
+};
+
+#endif
@@ -71,3 +71,27 @@ CoinWarmStartPrimalDual::applyDiff (const CoinWarmStartDiff *const cwsdDiff)
   primal_.applyDiff(&diff->primalDiff_);
   dual_.applyDiff(&diff->dualDiff_);
 }
+
+//#############################################################################
+
+CoinWarmStartPrimalDualDiff *
+CoinWarmStartPrimalDualDiff::decode (const unsigned char *&buffer,
+				     const unsigned char *end)
+{
+  CoinWarmStartVectorDiff<double> *primal =
+    CoinWarmStartVectorDiff<double>::decode(buffer,end) ;
+  if (!primal)
+    return NULL ;
+  CoinWarmStartVectorDiff<double> *dual =
+    CoinWarmStartVectorDiff<double>::decode(buffer,end) ;
+  if (!dual) {
+    delete primal ;
+    return NULL ;
+  }
+  CoinWarmStartPrimalDualDiff *diff = new CoinWarmStartPrimalDualDiff ;
+  diff->primalDiff_.swap(*primal) ;
+  diff->dualDiff_.swap(*dual) ;
+  delete primal ;
+  delete dual ;
+  return diff ;
+}
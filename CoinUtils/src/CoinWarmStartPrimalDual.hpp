@@ -158,6 +158,26 @@ public:
   /*! \brief Destructor */
   virtual ~CoinWarmStartPrimalDualDiff() {}
 
+  /*! \brief Append the primal then the dual diff to \p buffer
+
+    See CoinWarmStartVectorDiff::encode(). With \p quantise true values
+    go as float, which is enough to restart an interior or first order
+    method but not to reproduce its iterates exactly.
+  */
+  void encode(std::vector<unsigned char> &buffer, bool quantise = false) const
+  {
+    primalDiff_.encode(buffer, quantise);
+    dualDiff_.encode(buffer, quantise);
+  }
+
+  /*! \brief Read a diff written by encode()
+
+    Advances \p buffer. Returns a new diff, or NULL if the bytes are
+    malformed.
+  */
+  static CoinWarmStartPrimalDualDiff *
+  decode(const unsigned char *&buffer, const unsigned char *end) ;
+
 protected:
 
   /*! \brief Default constructor
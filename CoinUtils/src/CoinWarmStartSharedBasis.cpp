@@ -0,0 +1,191 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinUtilsConfig.h"
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include "CoinWarmStartSharedBasis.hpp"
+
+/*
+  Constructor: take a copy of the basis as the base. The artificial bytes
+  start on a page boundary.
+*/
+CoinWarmStartSharedBasis::CoinWarmStartSharedBasis
+  (const CoinWarmStartBasis &base)
+  : base_(new sharedBase),
+    artifOffset_(0),
+    structBytes_(0),
+    artifBytes_(0)
+{ base_->basis = base ;
+  base_->refCount = 1 ;
+  structBytes_ = 4*((base.getNumStructural()+15)>>4) ;
+  artifBytes_ = 4*((base.getNumArtificial()+15)>>4) ;
+  artifOffset_ = ((structBytes_+pageBytes-1)/pageBytes)*pageBytes ; }
+
+CoinWarmStartSharedBasis::CoinWarmStartSharedBasis
+  (const CoinWarmStartSharedBasis &rhs)
+  : CoinWarmStart(rhs),
+    base_(rhs.base_),
+    artifOffset_(rhs.artifOffset_),
+    structBytes_(rhs.structBytes_),
+    artifBytes_(rhs.artifBytes_)
+{ base_->refCount++ ;
+  copyPages(rhs) ; }
+
+CoinWarmStartSharedBasis &
+CoinWarmStartSharedBasis::operator= (const CoinWarmStartSharedBasis &rhs)
+{ if (this != &rhs)
+  { rhs.base_->refCount++ ;
+    freePages() ;
+    releaseBase() ;
+    base_ = rhs.base_ ;
+    artifOffset_ = rhs.artifOffset_ ;
+    structBytes_ = rhs.structBytes_ ;
+    artifBytes_ = rhs.artifBytes_ ;
+    copyPages(rhs) ; }
+  return (*this) ; }
+
+CoinWarmStartSharedBasis::~CoinWarmStartSharedBasis ()
+{ freePages() ;
+  releaseBase() ; }
+
+void CoinWarmStartSharedBasis::releaseBase ()
+{ if (--base_->refCount == 0)
+    delete base_ ;
+  base_ = NULL ; }
+
+void CoinWarmStartSharedBasis::copyPages (const CoinWarmStartSharedBasis &rhs)
+{ pageIndex_ = rhs.pageIndex_ ;
+  pageData_.resize(rhs.pageData_.size()) ;
+  for (size_t i = 0 ; i < pageData_.size() ; i++)
+  { pageData_[i] = new char [pageBytes] ;
+    memcpy(pageData_[i],rhs.pageData_[i],pageBytes) ; } }
+
+void CoinWarmStartSharedBasis::freePages ()
+{ for (size_t i = 0 ; i < pageData_.size() ; i++)
+    delete [] pageData_[i] ;
+  pageIndex_.clear() ;
+  pageData_.clear() ; }
+
+//#############################################################################
+
+const char *CoinWarmStartSharedBasis::findPage (int page) const
+{ if (pageIndex_.empty())
+    return (NULL) ;
+  std::vector<int>::const_iterator it =
+    std::lower_bound(pageIndex_.begin(),pageIndex_.end(),page) ;
+  if (it == pageIndex_.end() || *it != page)
+    return (NULL) ;
+  return (pageData_[it-pageIndex_.begin()]) ; }
+
+/*
+  Find the private page, or make it from the base. The part of the page
+  beyond the end of the base array is zero.
+*/
+char *CoinWarmStartSharedBasis::writablePage (int page)
+{ std::vector<int>::iterator it =
+    std::lower_bound(pageIndex_.begin(),pageIndex_.end(),page) ;
+  const size_t pos = it-pageIndex_.begin() ;
+  if (it != pageIndex_.end() && *it == page)
+    return (pageData_[pos]) ;
+  char *data = new char [pageBytes] ;
+  memset(data,0,pageBytes) ;
+  int start = page*pageBytes ;
+  const char *from ;
+  int available ;
+  if (start < artifOffset_)
+  { from = base_->basis.getStructuralStatus()+start ;
+    available = structBytes_-start ; }
+  else
+  { from = base_->basis.getArtificialStatus()+(start-artifOffset_) ;
+    available = artifBytes_-(start-artifOffset_) ; }
+  if (available > 0)
+    memcpy(data,from,CoinMin(available,static_cast<int>(pageBytes))) ;
+  pageIndex_.insert(it,page) ;
+  pageData_.insert(pageData_.begin()+pos,data) ;
+  return (data) ; }
+
+void CoinWarmStartSharedBasis::setStructStatus (int i, Status st)
+{ const int k = i>>2 ;
+  char &st_byte = writablePage(k/pageBytes)[k%pageBytes] ;
+  st_byte = static_cast<char>(st_byte & ~(3 << ((i&3)<<1))) ;
+  st_byte = static_cast<char>(st_byte | (st << ((i&3)<<1))) ; }
+
+void CoinWarmStartSharedBasis::setArtifStatus (int i, Status st)
+{ const int k = artifOffset_+(i>>2) ;
+  char &st_byte = writablePage(k/pageBytes)[k%pageBytes] ;
+  st_byte = static_cast<char>(st_byte & ~(3 << ((i&3)<<1))) ;
+  st_byte = static_cast<char>(st_byte | (st << ((i&3)<<1))) ; }
+
+/*
+  Status words are 4 bytes and pages a multiple of 4, so a word lies in one
+  page.
+*/
+void CoinWarmStartSharedBasis::writeWord (bool artif, int w,
+					  unsigned int value)
+{ const int k = (artif ? artifOffset_ : 0)+4*w ;
+  memcpy(writablePage(k/pageBytes)+(k%pageBytes),&value,sizeof(value)) ; }
+
+//#############################################################################
+
+CoinWarmStartBasis *CoinWarmStartSharedBasis::basis () const
+{ CoinWarmStartBasis *result = new CoinWarmStartBasis(base_->basis) ;
+  char *structStatus = result->getStructuralStatus() ;
+  char *artifStatus = result->getArtificialStatus() ;
+  for (size_t i = 0 ; i < pageIndex_.size() ; i++)
+  { const int start = pageIndex_[i]*pageBytes ;
+    if (start < artifOffset_)
+      memcpy(structStatus+start,pageData_[i],
+	     CoinMin(structBytes_-start,static_cast<int>(pageBytes))) ;
+    else
+      memcpy(artifStatus+(start-artifOffset_),pageData_[i],
+	     CoinMin(artifBytes_-(start-artifOffset_),
+		     static_cast<int>(pageBytes))) ; }
+  return (result) ; }
+
+/*
+  Apply a diff word by word (or run by run). A diff which holds the whole
+  basis touches every page, as it must.
+*/
+void CoinWarmStartSharedBasis::applyDiff
+  (const CoinWarmStartDiff *const cwsdDiff)
+{ const CoinWarmStartBasisDiff *diff =
+    dynamic_cast<const CoinWarmStartBasisDiff *>(cwsdDiff) ;
+#ifndef NDEBUG
+  if (!diff)
+  { throw CoinError("Diff not derived from CoinWarmStartBasisDiff.",
+		    "applyDiff","CoinWarmStartSharedBasis") ; }
+#endif
+  const int numberChanges = diff->sze_ ;
+  if (diff->runs_ > 0)
+  { const int numberRuns = diff->runs_ ;
+    const unsigned int *runStart = diff->difference_ ;
+    const unsigned int *runLength = runStart+numberRuns ;
+    const unsigned int *diffVals = runLength+numberRuns ;
+    for (int i = 0 ; i < numberRuns ; i++)
+    { const bool artif = ((runStart[i]&0x80000000) != 0) ;
+      const int start = static_cast<int>(runStart[i]&0x7fffffff) ;
+      for (unsigned int j = 0 ; j < runLength[i] ; j++)
+	writeWord(artif,start+j,*diffVals++) ; } }
+  else if (numberChanges >= 0)
+  { const unsigned int *diffNdxs = diff->difference_ ;
+    const unsigned int *diffVals = diffNdxs+numberChanges ;
+    for (int i = 0 ; i < numberChanges ; i++)
+    { const bool artif = ((diffNdxs[i]&0x80000000) != 0) ;
+      writeWord(artif,static_cast<int>(diffNdxs[i]&0x7fffffff),
+		diffVals[i]) ; } }
+  else
+  { const unsigned int *diffA = diff->difference_-1 ;
+    const int artifCnt = static_cast<int>(diffA[0]) ;
+    const int structCnt = -numberChanges ;
+    const int sizeArtif = (artifCnt+15)>>4 ;
+    const int sizeStruct = (structCnt+15)>>4 ;
+    for (int i = 0 ; i < sizeStruct ; i++)
+      writeWord(false,i,diffA[1+i]) ;
+    for (int i = 0 ; i < sizeArtif ; i++)
+      writeWord(true,i,diffA[1+sizeStruct+i]) ; }
+  return ; }
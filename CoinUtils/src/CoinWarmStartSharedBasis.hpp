@@ -0,0 +1,130 @@
+/* $Id$ */
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef CoinWarmStartSharedBasis_H
+#define CoinWarmStartSharedBasis_H
+
+#include <vector>
+
+#include "CoinWarmStartBasis.hpp"
+
+/*! \class CoinWarmStartSharedBasis
+    \brief A basis held as changes to a shared, read only base basis
+
+    Nodes of a search tree mostly have bases which differ in a few
+    statuses from their parent's. A CoinWarmStartSharedBasis refers to a
+    reference counted base CoinWarmStartBasis and keeps private copies of
+    only the pages (#pageBytes bytes, 4*#pageBytes statuses) it has
+    written to. Copying one copies its private pages and shares the base,
+    so memory per node is in proportion to the changes, not the size of
+    the model.
+
+    Accessors match CoinWarmStartBasis. Each read looks for a private
+    page by binary search among those held, so reading is slower than
+    from a CoinWarmStartBasis; basis() builds one when many reads are
+    to come. applyDiff() takes a CoinWarmStartBasisDiff in any of its
+    forms.
+
+    The size is that of the base and can't be changed. The reference count
+    is not thread safe: copies of one basis should stay in one thread.
+*/
+
+class CoinWarmStartSharedBasis : public virtual CoinWarmStart {
+public:
+  typedef CoinWarmStartBasis::Status Status ;
+
+  /// Bytes per private page
+  enum { pageBytes = 64 } ;
+
+  /*! \name Constructors, destructor, and related functions */
+  //@{
+  /// Copy \p base into a new shared base, with no changes
+  CoinWarmStartSharedBasis(const CoinWarmStartBasis &base) ;
+  /// Share the base of \p rhs and copy its private pages
+  CoinWarmStartSharedBasis(const CoinWarmStartSharedBasis &rhs) ;
+  CoinWarmStartSharedBasis &operator=(const CoinWarmStartSharedBasis &rhs) ;
+  virtual ~CoinWarmStartSharedBasis() ;
+  /// `Virtual constructor'
+  virtual CoinWarmStart *clone() const
+  { return (new CoinWarmStartSharedBasis(*this)) ; }
+  //@}
+
+  /*! \name Basis information, as for CoinWarmStartBasis */
+  //@{
+  inline int getNumStructural() const
+  { return (base_->basis.getNumStructural()) ; }
+  inline int getNumArtificial() const
+  { return (base_->basis.getNumArtificial()) ; }
+  inline Status getStructStatus(int i) const
+  { const char st = readByte(i>>2) ;
+    return (static_cast<Status>((st >> ((i&3)<<1)) & 3)) ; }
+  inline Status getArtifStatus(int i) const
+  { const char st = readByte(artifOffset_+(i>>2)) ;
+    return (static_cast<Status>((st >> ((i&3)<<1)) & 3)) ; }
+  void setStructStatus(int i, Status st) ;
+  void setArtifStatus(int i, Status st) ;
+  /// A CoinWarmStartBasis with the same statuses (owned by the caller)
+  CoinWarmStartBasis *basis() const ;
+  /// Apply a CoinWarmStartBasisDiff
+  virtual void applyDiff(const CoinWarmStartDiff *const cwsdDiff) ;
+  //@}
+
+  /*! \name Statistics */
+  //@{
+  /// Number of private pages
+  inline int numberPrivatePages() const
+  { return (static_cast<int>(pageIndex_.size())) ; }
+  /// Number of bases sharing the base
+  inline int shareCount() const
+  { return (base_->refCount) ; }
+  //@}
+
+private:
+  /// Reference counted base
+  struct sharedBase {
+    CoinWarmStartBasis basis ;
+    int refCount ;
+  } ;
+
+  /*! \brief Byte \p k of the status bytes
+
+    Structural status bytes come first, artificial ones from
+    #artifOffset_, which is rounded up to a page so that no page mixes
+    the two.
+  */
+  inline char readByte(int k) const
+  { const char *page = findPage(k/pageBytes) ;
+    return (page ? page[k%pageBytes] : baseByte(k)) ; }
+  /// Byte k of the base
+  inline char baseByte(int k) const
+  { return ((k < artifOffset_) ?
+	    base_->basis.getStructuralStatus()[k] :
+	    base_->basis.getArtificialStatus()[k-artifOffset_]) ; }
+  /// Private page, or NULL
+  const char *findPage(int page) const ;
+  /// Private page, made from the base if need be
+  char *writablePage(int page) ;
+  /// Copy private pages of rhs
+  void copyPages(const CoinWarmStartSharedBasis &rhs) ;
+  /// Drop private pages
+  void freePages() ;
+  /// Drop the base
+  void releaseBase() ;
+  /// Write the unsigned int status word w (as in a diff) of one array
+  void writeWord(bool artif, int w, unsigned int value) ;
+
+  sharedBase *base_ ;
+  /// Byte offset of the artificial statuses (a multiple of pageBytes)
+  int artifOffset_ ;
+  /// Number of bytes of each kind in the base
+  int structBytes_ ;
+  int artifBytes_ ;
+  /// Sorted indices of private pages
+  std::vector<int> pageIndex_ ;
+  /// Private pages, parallel to pageIndex_
+  std::vector<char *> pageData_ ;
+} ;
+
+#endif
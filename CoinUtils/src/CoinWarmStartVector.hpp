@@ -13,9 +13,11 @@
 
 #include <cassert>
 #include <cmath>
+#include <vector>
 
 #include "CoinHelperFunctions.hpp"
 #include "CoinWarmStart.hpp"
+#include "CoinWarmStartDiffCoder.hpp"
 
 
 //#############################################################################
@@ -144,6 +146,8 @@ private:
   CoinWarmStartVector::generateDiff() and CoinWarmStartVector::applyDiff().
 
   The actual data structure is a pair of vectors, #diffNdxs_ and #diffVals_.
+  For shipping elsewhere, encode() gives a compact byte form and decode()
+  reads it back (see CoinWarmStartDiffCoder.hpp).
     
 */
 
@@ -207,6 +211,25 @@ public:
     delete[] diffVals_;  diffVals_ = NULL;
   }
 
+  /*! \name Compact encoding */
+  //@{
+  /*! \brief Append the diff to \p buffer
+
+    Indices are delta coded varints. If \p quantise is true and T is wider
+    than float, values are rounded to float; applying the decoded diff
+    then gives only an approximate warm start.
+  */
+  void encode(std::vector<unsigned char> &buffer, bool quantise = false) const ;
+
+  /*! \brief Read a diff written by encode()
+
+    Reads from \p buffer, not beyond \p end, and advances \p buffer.
+    Returns a new diff, or NULL if the bytes are malformed.
+  */
+  static CoinWarmStartVectorDiff<T> *
+  decode(const unsigned char *&buffer, const unsigned char *end) ;
+  //@}
+
 private:
 
   /*!
@@ -425,6 +448,91 @@ CoinWarmStartVector<T>::applyDiff (const CoinWarmStartDiff *const cwsdDiff)
 
 //#############################################################################
 
+/*
+  Encode as count, mode, zigzag deltas of the indices, then the values.
+*/
+
+template <typename T> void
+CoinWarmStartVectorDiff<T>::encode (std::vector<unsigned char> &buffer,
+				    bool quantise) const
+{
+  if (sizeof(T) <= sizeof(float))
+    quantise = false ;
+  const int mode = quantise ? CoinDiffFloat : CoinDiffExact ;
+  const size_t valueBytes = quantise ? sizeof(float) : sizeof(T) ;
+  buffer.reserve(buffer.size()+3*sze_+sze_*valueBytes+8) ;
+  CoinVarintPut(buffer,sze_) ;
+  buffer.push_back(static_cast<unsigned char>(mode)) ;
+  CoinInt64 last = -1 ;
+  for (int i = 0 ; i < sze_ ; i++) {
+    const CoinInt64 ndx = diffNdxs_[i] ;
+    CoinVarintPut(buffer,CoinZigzag(ndx-last-1)) ;
+    last = ndx ;
+  }
+  size_t at = buffer.size() ;
+  buffer.resize(at+sze_*valueBytes) ;
+  if (quantise) {
+    for (int i = 0 ; i < sze_ ; i++) {
+      const float value = static_cast<float>(diffVals_[i]) ;
+      memcpy(&buffer[at],&value,sizeof(float)) ;
+      at += sizeof(float) ;
+    }
+  } else if (sze_ > 0) {
+    memcpy(&buffer[at],diffVals_,sze_*sizeof(T)) ;
+  }
+}
+
+template <typename T> CoinWarmStartVectorDiff<T> *
+CoinWarmStartVectorDiff<T>::decode (const unsigned char *&buffer,
+				    const unsigned char *end)
+{
+  CoinUInt64 count ;
+  if (!CoinVarintGet(buffer,end,count) || buffer >= end)
+    return NULL ;
+  const int mode = *buffer++ ;
+  if (mode != CoinDiffExact && mode != CoinDiffFloat)
+    return NULL ;
+  const size_t valueBytes = (mode == CoinDiffFloat) ? sizeof(float) : sizeof(T) ;
+  // Each entry takes at least one index byte
+  if (count > static_cast<CoinUInt64>(end-buffer))
+    return NULL ;
+  const int sze = static_cast<int>(count) ;
+  CoinWarmStartVectorDiff<T> *diff = new CoinWarmStartVectorDiff<T>() ;
+  if (sze > 0) {
+    diff->sze_ = sze ;
+    diff->diffNdxs_ = new unsigned int[sze] ;
+    diff->diffVals_ = new T[sze] ;
+  }
+  CoinInt64 last = -1 ;
+  for (int i = 0 ; i < sze ; i++) {
+    CoinUInt64 delta ;
+    if (!CoinVarintGet(buffer,end,delta)) {
+      delete diff ;
+      return NULL ;
+    }
+    last += CoinUnzigzag(delta)+1 ;
+    diff->diffNdxs_[i] = static_cast<unsigned int>(last) ;
+  }
+  if (static_cast<size_t>(end-buffer) < sze*valueBytes) {
+    delete diff ;
+    return NULL ;
+  }
+  if (mode == CoinDiffFloat) {
+    for (int i = 0 ; i < sze ; i++) {
+      float value ;
+      memcpy(&value,buffer,sizeof(float)) ;
+      buffer += sizeof(float) ;
+      diff->diffVals_[i] = static_cast<T>(value) ;
+    }
+  } else if (sze > 0) {
+    memcpy(diff->diffVals_,buffer,sze*sizeof(T)) ;
+    buffer += sze*sizeof(T) ;
+  }
+  return diff ;
+}
+
+//#############################################################################
+
 
 // Assignment
 
@@ -22,6 +22,15 @@
 /* Define to 1 if zlib is available */
 /* #define COIN_HAS_ZLIB */
 
+/* Define to 1 if zstd is available */
+/* #define COIN_HAS_ZSTD */
+
+/* Define to 1 if lz4 is available */
+/* #define COIN_HAS_LZ4 */
+
+/* Define to 1 if libcurl is available */
+/* #define COIN_HAS_CURL */
+
 #ifdef _MSC_VER
 /* Define to be the name of C-function for Inf check */
 #define COIN_C_FINITE _finite
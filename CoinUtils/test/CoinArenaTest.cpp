@@ -0,0 +1,119 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinArena.hpp"
+
+namespace {
+
+struct counted {
+  counted() : value(42) {}
+  int value;
+};
+
+inline bool aligned(const void *p, size_t alignment)
+{
+  return (reinterpret_cast<size_t>(p) & (alignment - 1)) == 0;
+}
+
+}	// end file-local namespace
+
+void CoinArenaUnitTest()
+{
+  int notFromArena = 0;
+  {
+    CoinArena arena(1024);
+    assert (!arena.bytesAllocated());
+    assert (!arena.bytesReserved());
+    assert (!arena.owns(&notFromArena));
+
+    // alignment
+    const size_t alignments[] = {1, 2, 8, 16, 32, 64};
+    for (int k = 0; k < 6; k++) {
+      for (int i = 0; i < 20; i++) {
+	void *p = arena.allocate(3 + i, alignments[k]);
+	assert (aligned(p, alignments[k]));
+	assert (arena.owns(p));
+	assert (CoinArena::anyOwns(p));
+      }
+    }
+    assert (arena.bytesReserved() >= arena.bytesAllocated());
+
+    // many allocations over several chunks do not overlap
+    std::vector<unsigned char *> blocks;
+    for (int i = 0; i < 500; i++) {
+      int size = 1 + (i * 37) % 200;
+      unsigned char *p = static_cast<unsigned char *>(arena.allocate(size, 8));
+      memset(p, i & 255, size);
+      blocks.push_back(p);
+    }
+    for (int i = 0; i < 500; i++) {
+      int size = 1 + (i * 37) % 200;
+      for (int j = 0; j < size; j++)
+	assert (blocks[i][j] == (i & 255));
+    }
+
+    // large request gets its own chunk
+    size_t reserved = arena.bytesReserved();
+    char *large = static_cast<char *>(arena.allocate(10000));
+    assert (arena.owns(large) && arena.owns(large + 9999));
+    assert (arena.bytesReserved() >= reserved + 10000);
+    memset(large, 1, 10000);
+
+    // typed helpers
+    counted *array = arena.allocateArray<counted>(50);
+    for (int i = 0; i < 50; i++)
+      assert (array[i].value == 42);
+    int values[] = {3, 1, 4, 1, 5};
+    int *copy = arena.copyOfArray(values, 5);
+    assert (copy != values && arena.owns(copy));
+    for (int i = 0; i < 5; i++)
+      assert (copy[i] == values[i]);
+    assert (!arena.copyOfArray(static_cast<int *>(NULL), 5));
+    char *name = arena.strdup("CoinArena");
+    assert (!strcmp(name, "CoinArena") && arena.owns(name));
+    assert (!arena.strdup(NULL));
+
+    // another arena owns only its own
+    {
+      CoinArena other;
+      void *p = other.allocate(100);
+      assert (other.owns(p) && !arena.owns(p));
+      assert (!other.owns(name));
+      assert (CoinArena::anyOwns(p) && CoinArena::anyOwns(name));
+    }
+
+    // release keeps newest chunk unless freeAll
+    void *first = arena.allocate(16);
+    arena.release();
+    assert (!arena.bytesAllocated());
+    assert (arena.bytesReserved() > 0);
+    void *again = arena.allocate(16);
+    assert (arena.owns(again));
+    assert (!arena.owns(large));
+    arena.release(true);
+    assert (!arena.bytesAllocated());
+    assert (!arena.bytesReserved());
+    assert (!arena.owns(again) && !arena.owns(first));
+    // usable after release
+    assert (arena.owns(arena.allocate(8)));
+  }
+  // nothing is owned once arenas are gone
+  void *p;
+  {
+    CoinArena arena;
+    p = arena.allocate(64);
+    assert (CoinArena::anyOwns(p));
+  }
+  assert (!CoinArena::anyOwns(p));
+  assert (!CoinArena::anyOwns(&notFromArena));
+}
@@ -0,0 +1,129 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+#include "CoinPragma.hpp"
+#include "CoinBitVector.hpp"
+#include "CoinSearchTree.hpp"
+
+namespace {
+
+// Bit by bit count (to check CoinBitCount)
+int slowCount(CoinUInt64 x)
+{
+  int count = 0;
+  for (int i = 0; i < 64; i++)
+    count += static_cast<int>((x >> i) & 1);
+  return count;
+}
+
+template <int NBITS>
+void testBits()
+{
+  typedef CoinBitVector<NBITS> bits;
+  const int numberWords = bits::numberWords;
+  bits a;
+  assert (!a.any() && !a.count());
+  for (int i = 0; i < NBITS; i += 3)
+    a.setBit(i);
+  assert (a.any());
+  assert (a.count() == (NBITS + 2) / 3);
+  for (int i = 0; i < NBITS; i++)
+    assert (a.testBit(i) == (i % 3 == 0));
+  a.clearBit(0);
+  a.clearBit(NBITS - 1);
+  assert (!a.testBit(0));
+  assert (a.count() == (NBITS + 2) / 3 - 1 - ((NBITS - 1) % 3 == 0 ? 1 : 0));
+
+  // bulk operations against bit by bit
+  bits b;
+  for (int i = 0; i < NBITS; i += 5)
+    b.setBit(i);
+  bits andBits = a & b;
+  bits orBits = a | b;
+  bits xorBits = a ^ b;
+  bits notBits = ~a;
+  for (int i = 0; i < NBITS; i++) {
+    assert (andBits.testBit(i) == (a.testBit(i) && b.testBit(i)));
+    assert (orBits.testBit(i) == (a.testBit(i) || b.testBit(i)));
+    assert (xorBits.testBit(i) == (a.testBit(i) != b.testBit(i)));
+    assert (notBits.testBit(i) == !a.testBit(i));
+  }
+  assert (a.count() + notBits.count() == NBITS);
+  bits c(a);
+  c ^= a;
+  assert (!c.any());
+  c |= b;
+  assert (c == b);
+  c &= a;
+  assert (c == andBits);
+
+  // order as unsigned number - high word decides
+  bits low, high;
+  low.setBit(0);
+  high.setBit(NBITS - 1);
+  assert (low < high && !(high < low));
+  bits lowAll(~bits());
+  lowAll.clearBit(NBITS - 1);
+  assert (lowAll < high);
+  assert (!(low < low));
+  assert (low != high && low == low);
+
+  // from unsigned ints, least significant first
+  unsigned int in[NBITS / 32];
+  for (int i = 0; i < NBITS / 32; i++)
+    in[i] = 0x01010101u * (i + 1);
+  bits d(in);
+  for (int i = 0; i < numberWords; i++)
+    assert (d.word(i) == ((static_cast<CoinUInt64>(in[2 * i + 1]) << 32) | in[2 * i]));
+  std::string text = d.str();
+  assert (text.size() == static_cast<size_t>(NBITS / 4));
+  // most significant first
+  char expected[9];
+  sprintf(expected, "%08X", in[NBITS / 32 - 1]);
+  assert (text.substr(0, 8) == expected);
+  sprintf(expected, "%08X", in[0]);
+  assert (text.substr(text.size() - 8) == expected);
+  d.clear();
+  assert (!d.any());
+}
+
+}	// end file-local namespace
+
+void CoinBitVectorUnitTest()
+{
+  // word level functions
+  const CoinUInt64 words[] = {0, 1, 0x8000000000000000ULL,
+			      0xffffffffffffffffULL, 0x0123456789abcdefULL,
+			      0xf0f0f0f00f0f0f0fULL};
+  int total = 0;
+  for (int i = 0; i < 6; i++) {
+    assert (CoinBitCount(words[i]) == slowCount(words[i]));
+    total += slowCount(words[i]);
+  }
+  assert (CoinBitCount(words, 6) == total);
+  const CoinUInt64 small[] = {0xffffffffffffffffULL, 1};
+  const CoinUInt64 large[] = {0, 2};
+  assert (CoinBitCompare(small, large, 2) == -1);
+  assert (CoinBitCompare(large, small, 2) == 1);
+  assert (CoinBitCompare(small, small, 2) == 0);
+  // only low words looked at
+  assert (CoinBitCompare(large, small, 1) == -1);
+
+  testBits<64>();
+  testBits<128>();
+  testBits<256>();
+
+  // preferred child encoding of the search tree
+  BitVector128 preferred;
+  preferred.setBit(3);
+  assert (preferred.str() == "00000000000000000000000000000008");
+}
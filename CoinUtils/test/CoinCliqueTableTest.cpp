@@ -0,0 +1,161 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinCliqueTable.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFinite.hpp"
+
+void CoinCliqueTableUnitTest()
+{
+  // Clique table - cliques from rows, conflicts, dominance and merging
+  // 0-7 and 9-20 binary, 8 continuous
+  const int numberColumns = 24;
+  double columnLower[numberColumns];
+  double columnUpper[numberColumns];
+  char integerType[numberColumns];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    columnLower[iColumn] = 0.0;
+    columnUpper[iColumn] = iColumn == 8 ? 10.0 : 1.0;
+    integerType[iColumn] = iColumn == 8 ? 0 : 1;
+  }
+  CoinPackedMatrix matrix(false,0,0);
+  matrix.setDimensions(0,numberColumns);
+  double rowLower[8];
+  double rowUpper[8];
+  // x0+x1+x2+x3 <= 1
+  int index0[4] = { 0, 1, 2, 3 };
+  double ones[12] = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
+		      1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  matrix.appendRow(4,index0,ones);
+  rowLower[0] = -COIN_DBL_MAX; rowUpper[0] = 1.0;
+  // x4+x5 >= 1
+  int index1[2] = { 4, 5 };
+  matrix.appendRow(2,index1,ones);
+  rowLower[1] = 1.0; rowUpper[1] = COIN_DBL_MAX;
+  // 3x5+2x6+2x7+x8 <= 4 - gives {x5,x6} and {x5,x7}
+  int index2[4] = { 5, 6, 7, 8 };
+  double elements2[4] = { 3.0, 2.0, 2.0, 1.0 };
+  matrix.appendRow(4,index2,elements2);
+  rowLower[2] = -COIN_DBL_MAX; rowUpper[2] = 4.0;
+  // x0+x4 <= 1
+  int index3[2] = { 0, 4 };
+  matrix.appendRow(2,index3,ones);
+  rowLower[3] = -COIN_DBL_MAX; rowUpper[3] = 1.0;
+  // x1+x8 <= 1 - only one binary
+  int index4[2] = { 1, 8 };
+  matrix.appendRow(2,index4,ones);
+  rowLower[4] = -COIN_DBL_MAX; rowUpper[4] = 1.0;
+  // x6-x7 <= 0
+  int index5[2] = { 6, 7 };
+  double elements5[2] = { 1.0, -1.0 };
+  matrix.appendRow(2,index5,elements5);
+  rowLower[5] = -COIN_DBL_MAX; rowUpper[5] = 0.0;
+  // x9+...+x20 = 1 (large clique)
+  int index6[12];
+  for (int j = 0; j < 12; j++)
+    index6[j] = 9 + j;
+  matrix.appendRow(12,index6,ones);
+  rowLower[6] = 1.0; rowUpper[6] = 1.0;
+  // x9+x10 <= 1 (dominated)
+  matrix.appendRow(2,index6,ones);
+  rowLower[7] = -COIN_DBL_MAX; rowUpper[7] = 1.0;
+  matrix.reverseOrdering();
+  CoinCliqueTable table;
+  assert( table.extract(matrix,columnLower,columnUpper,integerType,
+			rowLower,rowUpper) == 8 );
+  assert( table.numberColumns() == numberColumns );
+  assert( table.cliqueSize(0) == 4 && table.cliqueRow(0) == 0 );
+  assert( table.cliqueMembers()[table.cliqueStarts()[1]] ==
+	  CoinCliqueTable::literal(4,true) );
+  assert( table.cliqueRow(6) == 6 && table.cliqueSize(6) == 12 );
+  const int x0 = CoinCliqueTable::literal(0);
+  assert( table.conflict(x0,CoinCliqueTable::literal(3)) );
+  assert( table.conflict(x0,CoinCliqueTable::literal(4)) );
+  assert( !table.conflict(CoinCliqueTable::literal(1),
+			  CoinCliqueTable::literal(4)) );
+  assert( table.conflict(x0,CoinCliqueTable::complement(x0)) );
+  assert( !table.conflict(x0,x0) );
+  assert( table.conflict(CoinCliqueTable::literal(4,true),
+			 CoinCliqueTable::literal(5,true)) );
+  assert( table.conflict(CoinCliqueTable::literal(5),
+			 CoinCliqueTable::literal(7)) );
+  assert( !table.conflict(CoinCliqueTable::literal(6),
+			  CoinCliqueTable::literal(7)) );
+  assert( table.conflict(CoinCliqueTable::literal(6),
+			 CoinCliqueTable::literal(7,true)) );
+  assert( table.conflict(CoinCliqueTable::literal(11),
+			 CoinCliqueTable::literal(20)) );
+  assert( !table.conflict(CoinCliqueTable::literal(11),
+			  CoinCliqueTable::literal(20,true)) );
+  int which[2*numberColumns];
+  assert( table.neighbours(x0,which) == 5 );
+  assert( which[0] == 1 && which[1] == 2 && which[4] == 8 );
+  // dominance
+  CoinCliqueTable copy(table);
+  assert( copy.removeDominated() == 1 );
+  assert( copy.numberCliques() == 7 );
+  assert( copy.conflict(CoinCliqueTable::literal(9),
+			CoinCliqueTable::literal(10)) );
+  // x3 implies x7
+  copy.addImplication(CoinCliqueTable::literal(3),
+		      CoinCliqueTable::literal(7));
+  assert( copy.conflict(CoinCliqueTable::literal(3),
+			CoinCliqueTable::literal(7,true)) );
+  // triangle of pairs merges into one clique
+  int pair[2];
+  for (int j = 21; j < 24; j++) {
+    pair[0] = CoinCliqueTable::literal(j);
+    pair[1] = CoinCliqueTable::literal(j < 23 ? j+1 : 21);
+    copy.addClique(2,pair);
+  }
+  const int numberBefore = copy.numberCliques();
+  assert( copy.mergeCliques() >= 3 );
+  int numberTriangle = 0;
+  for (int iClique = 0; iClique < copy.numberCliques(); iClique++) {
+    const int * members = copy.cliqueMembers() +
+      copy.cliqueStarts()[iClique];
+    if (members[0] == CoinCliqueTable::literal(21)) {
+      assert( copy.cliqueSize(iClique) == 3 );
+      numberTriangle++;
+    }
+  }
+  assert( numberTriangle == 1 );
+  assert( copy.numberCliques() < numberBefore );
+  // same cliques with threads
+  CoinPackedMatrix chain(false,0,0);
+  const int n = 5000;
+  chain.setDimensions(0,n);
+  double * lower = new double [n];
+  double * upper = new double [n];
+  char * type = new char [n];
+  for (int i = 0; i < n; i++) {
+    lower[i] = 0.0;
+    upper[i] = 1.0;
+    type[i] = 1;
+    int index[3] = { i, (i+1)%n, (i+7)%n };
+    double elements[3] = { 2.0, 1.0, 1.5 };
+    chain.appendRow(3,index,elements);
+  }
+  CoinCliqueTable serial(n);
+  CoinCliqueTable parallel(n);
+  parallel.setNumberThreads(4);
+  serial.extract(chain,lower,upper,type,lower,upper);
+  parallel.extract(chain,lower,upper,type,lower,upper);
+  assert( serial.numberCliques() == n );
+  assert( parallel.numberCliques() == n );
+  for (int i = 0; i <= n; i++)
+    assert( serial.cliqueStarts()[i] == parallel.cliqueStarts()[i] );
+  for (int i = 0; i < serial.cliqueStarts()[n]; i++)
+    assert( serial.cliqueMembers()[i] == parallel.cliqueMembers()[i] );
+  delete [] type;
+  delete [] upper;
+  delete [] lower;
+}
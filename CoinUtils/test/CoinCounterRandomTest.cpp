@@ -0,0 +1,83 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+
+void CoinCounterRandomUnitTest()
+{
+  // mix is the splitmix64 finaliser - first value of splitmix64 from 0
+  assert(CoinCounterRandom::mix(0) == 0);
+  assert(CoinCounterRandom::mix(0x9e3779b97f4a7c15ULL) ==
+	 0xe220a8397b1dcdafULL);
+  assert(CoinCounterRandom::toDouble(0) > 0.0);
+  assert(CoinCounterRandom::toDouble(~static_cast<CoinUInt64>(0)) < 1.0);
+
+  // same seed and stream - same numbers; otherwise different
+  CoinCounterRandom a(2026, 3);
+  CoinCounterRandom b(2026, 3);
+  CoinCounterRandom c(2026, 4);
+  CoinCounterRandom d(2027, 3);
+  assert(a.key() == b.key() && a.key() != c.key() && a.key() != d.key());
+  for (int i = 0; i < 100; i++) {
+    const CoinUInt64 value = a.randomInteger();
+    assert(value == b.randomInteger());
+    assert(value == a.at(i));
+    assert(value != c.randomInteger() && value != d.randomInteger());
+  }
+  assert(a.position() == 100);
+  CoinCounterRandom defaultRandom;
+  assert(defaultRandom.key() == CoinCounterRandom(12345678).key());
+
+  // jumps and positions
+  a.setSeed(2026, 3);
+  assert(!a.position());
+  a.jump(1000000);
+  assert(a.randomInteger() == b.at(1000000));
+  a.setPosition(7);
+  assert(a.randomDouble() == CoinCounterRandom::toDouble(b.at(7)));
+  assert(a.position() == 8);
+
+  // fillDoubles as many randomDouble
+  const int n = 1001;
+  std::vector<double> values(n);
+  a.setPosition(5);
+  a.fillDoubles(&values[0], n);
+  assert(a.position() == static_cast<CoinUInt64>(5 + n));
+  b.setPosition(5);
+  for (int i = 0; i < n; i++)
+    assert(values[i] == b.randomDouble());
+
+  // substreams - reproducible, start at 0, differ from parent and each other
+  a.setPosition(3);
+  CoinCounterRandom s1 = a.substream(1);
+  assert(!s1.position());
+  assert(s1.key() == b.substream(1).key());
+  assert(s1.key() != a.key() && s1.key() != a.substream(2).key());
+  assert(s1.substream(1).key() != s1.key());
+
+  // in (0,1) with about the right mean and spread
+  const int number = 100000;
+  values.resize(number);
+  c.fillDoubles(&values[0], number);
+  double sum = 0.0;
+  double sumSquares = 0.0;
+  for (int i = 0; i < number; i++) {
+    assert(values[i] > 0.0 && values[i] < 1.0);
+    sum += values[i];
+    sumSquares += values[i] * values[i];
+  }
+  const double mean = sum / number;
+  const double variance = sumSquares / number - mean * mean;
+  assert(fabs(mean - 0.5) < 0.01);
+  assert(fabs(variance - 1.0 / 12.0) < 0.005);
+}
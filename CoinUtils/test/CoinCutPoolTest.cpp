@@ -0,0 +1,102 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinCutPool.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinPackedMatrixDuplicates.hpp"
+#include "CoinPackedVector.hpp"
+#include "CoinHelperFunctions.hpp"
+
+void CoinCutPoolUnitTest()
+{
+  // Cut pool - parallel cuts merged, violation, aging and purging
+  CoinCutPool pool;
+  int index0[3] = { 4, 0, 2 };
+  double elements0[3] = { 1.0, -2.0, 2.0 };
+  // -2x0 + 2x2 + x4 <= 2 stored as x0 - x2 - 0.5x4 >= -1
+  assert( pool.addCut(3,index0,elements0,-COIN_DBL_MAX,2.0) == 0 );
+  assert( pool.lower()[0] == -1.0 && pool.upper()[0] > 1.0e30 );
+  // same cut scaled and tighter
+  double elements1[3] = { -0.5, 1.0, -1.0 };
+  assert( pool.addCut(3,index0,elements1,-0.75,COIN_DBL_MAX) == 0 );
+  assert( pool.numberCuts() == 1 && pool.numberDuplicates() == 1 );
+  assert( pool.lower()[0] == -0.75 );
+  CoinPackedVector row;
+  row.insert(1,3.0);
+  row.insert(3,4.0);
+  assert( pool.addCut(row,-COIN_DBL_MAX,5.0) == 1 );
+  assert( pool.norm(1) == 1.25 );
+  int index2[1] = { 4 };
+  double elements2[1] = { 2.0 };
+  assert( pool.addCut(1,index2,elements2,1.0,1.0) == 2 );
+  assert( pool.addCut(0,index2,elements2,1.0,1.0) == -1 );
+  const CoinPackedMatrix & cuts = pool.matrix();
+  assert( cuts.isColOrdered() == false && cuts.getNumRows() == 3 );
+  assert( cuts.getIndices()[0] == 0 && cuts.getElements()[0] == 1.0 );
+  double x[5] = { 0.0, 1.0, 1.0, 1.0, 0.5 };
+  double violation[3];
+  double efficacy[3];
+  pool.evaluate(x,violation,efficacy);
+  // x0 - x2 - 0.5x4 = -1.25, 0.75x1 + x3 = 1.75 <= 1.25, x4 = 0.5
+  assert( violation[0] == 0.5 && violation[1] == 0.5 && violation[2] == 0.0 );
+  assert( efficacy[0] == 0.5/1.5 && efficacy[1] == 0.4 );
+  int which[3];
+  assert( pool.violatedCuts(x,0.35,which) == 1 && which[0] == 1 );
+  assert( pool.violatedCuts(x,0.0,which) == 2 && which[0] == 1 );
+  assert( pool.age(0) == 0 && pool.age(2) == 2 );
+  assert( pool.purge(1) == 1 && pool.numberCuts() == 2 );
+  assert( pool.upper()[1] == 1.25 );
+  // new cut finds earlier one after renumbering
+  assert( pool.addCut(row,-COIN_DBL_MAX,4.0) == 1 );
+  assert( pool.upper()[1] == 1.0 );
+  int first = 0;
+  pool.deleteCuts(1,&first);
+  assert( pool.numberCuts() == 1 && pool.hash(0) ==
+	  CoinPackedMatrixDuplicates::hashVector(cuts.getVectorLengths()[0],
+						 cuts.getIndices(),
+						 cuts.getElements()) );
+  // many cuts - table grows and evaluate may use threads
+  pool.clear();
+  pool.setNumberThreads(4);
+  const int numberColumns = 1000;
+  std::vector<double> solution(numberColumns);
+  for (int i = 0; i < numberColumns; i++)
+    solution[i] = (i % 7) * 0.25;
+  for (int iCut = 0; iCut < 20000; iCut++) {
+    int index[4];
+    double elements[4];
+    for (int k = 0; k < 4; k++) {
+      index[k] = (iCut * (k + 1) * 13 + k) % numberColumns;
+      elements[k] = 1.0 + ((iCut / 3000 + k) % 5);
+    }
+    if (index[1] == index[0] || index[2] == index[0] ||
+	index[2] == index[1] || index[3] == index[0] ||
+	index[3] == index[1] || index[3] == index[2])
+      continue;
+    pool.addCut(4,index,elements,-COIN_DBL_MAX,10.0);
+  }
+  const int numberCuts = pool.numberCuts();
+  assert( numberCuts > 4000 && pool.numberDuplicates() > 10000 );
+  std::vector<double> manyViolations(numberCuts);
+  pool.evaluate(&solution[0],&manyViolations[0]);
+  const CoinPackedMatrix & many = pool.matrix();
+  for (int iCut = 0; iCut < numberCuts; iCut++) {
+    double activity = 0.0;
+    for (CoinBigIndex j = many.getVectorFirst(iCut);
+	 j < many.getVectorLast(iCut); j++)
+      activity += many.getElements()[j] * solution[many.getIndices()[j]];
+    double violation = CoinMax(activity - pool.upper()[iCut],
+			       pool.lower()[iCut] - activity);
+    assert( fabs(CoinMax(violation,0.0) - manyViolations[iCut]) < 1.0e-12 );
+  }
+}
@@ -12,6 +12,8 @@
 #endif
 
 #include <cassert>
+#include <cmath>
+#include <utility>
 
 #include "CoinDenseVector.hpp"
 #include "CoinFloatEqual.hpp"
@@ -79,6 +81,57 @@ CoinDenseVectorUnitTest(T dummy)
     CoinDenseVector<T> div = r / r1;
     assert(div.sum() == 4.0);
 
+    // Norms (blocked) on more than one block
+    {
+      T el9[9] = { 1, -2, 3, -4, 5, -6, 7, -8, 9 };
+      CoinDenseVector<T> v(9,el9);
+      assert( v.oneNorm() == 45 );
+      assert( v.infNorm() == 9 );
+      assert( v.twoNorm() == sqrt(285.0) );
+      assert( v.sum() == 5 );
+      assert( v.compensatedSum() == 5.0 );
+      assert( v.pairwiseSum() == 5.0 );
+      assert( v.dotProduct(v) == 285.0 );
+    }
+
+    // Fused kernels agree with the operators
+    {
+      CoinDenseVector<T> fused;
+      fused.setLinearCombination(1,r,2,r1);
+      CoinDenseVector<T> chained = r + static_cast<T>(2)*r1;
+      for (int i = 0; i < ne; i++)
+	assert( fused[i] == chained[i] );
+      fused.axpy(-3,r);
+      assert( fused.oneNorm() == 0 );
+      // aliased
+      fused = r;
+      fused.setLinearCombination(2,fused,-1,r);
+      for (int i = 0; i < ne; i++)
+	assert( fused[i] == r[i] );
+    }
+
+    // Compensated and pairwise sums lose less than a simple sum
+    {
+      const int n = 10000;
+      CoinDenseVector<T> v(n,static_cast<T>(0.1));
+      v[0] = static_cast<T>(1.0e6);
+      double exact = 1.0e6 + (n - 1) * static_cast<double>(v[1]);
+      CoinRelFltEq eq(1.0e-12);
+      assert( eq(v.compensatedSum(),exact) );
+      assert( fabs(v.pairwiseSum() - exact) <= fabs(v.sum() - exact) );
+    }
+
+#if COIN_HAS_MOVE
+    // Moving takes the elements
+    {
+      CoinDenseVector<T> source(r);
+      const T * elements = source.getElements();
+      CoinDenseVector<T> moved(std::move(source));
+      assert( moved.getElements() == elements && !source.getNumElements() );
+      source = r + r1;
+      assert( source[3] == 100 );
+    }
+#endif
 }
 
 template void CoinDenseVectorUnitTest<float>(float);
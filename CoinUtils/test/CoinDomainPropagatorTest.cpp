@@ -0,0 +1,100 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinDomainPropagator.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFinite.hpp"
+
+void CoinDomainPropagatorUnitTest()
+{
+  // Domain propagation - tightening, reasons and backtracking
+  // x0-x2 integer in [0,10], x3 in [0,inf), x4 free
+  const int numberColumns = 5;
+  double columnLower[numberColumns] = { 0.0, 0.0, 0.0, 0.0, -COIN_DBL_MAX };
+  double columnUpper[numberColumns] = { 10.0, 10.0, 10.0, COIN_DBL_MAX,
+					COIN_DBL_MAX };
+  char integerType[numberColumns] = { 1, 1, 1, 0, 0 };
+  CoinPackedMatrix matrix(false,0,0);
+  matrix.setDimensions(0,numberColumns);
+  double rowLower[4];
+  double rowUpper[4];
+  // x0+x1+x2 <= 4
+  int index0[3] = { 0, 1, 2 };
+  double elements0[3] = { 1.0, 1.0, 1.0 };
+  matrix.appendRow(3,index0,elements0);
+  rowLower[0] = -COIN_DBL_MAX; rowUpper[0] = 4.0;
+  // x3-x0 >= 0
+  int index1[2] = { 0, 3 };
+  double elements1[2] = { -1.0, 1.0 };
+  matrix.appendRow(2,index1,elements1);
+  rowLower[1] = 0.0; rowUpper[1] = COIN_DBL_MAX;
+  // x3 <= 2.5
+  int index2[1] = { 3 };
+  double elements2[1] = { 1.0 };
+  matrix.appendRow(1,index2,elements2);
+  rowLower[2] = -COIN_DBL_MAX; rowUpper[2] = 2.5;
+  // x4-x1 <= 0 (only x4 has infinite contribution)
+  int index3[2] = { 1, 4 };
+  double elements3[2] = { -1.0, 1.0 };
+  matrix.appendRow(2,index3,elements3);
+  rowLower[3] = -COIN_DBL_MAX; rowUpper[3] = 0.0;
+  CoinDomainPropagator propagator;
+  propagator.load(matrix,columnLower,columnUpper,integerType,
+		  rowLower,rowUpper);
+  assert( propagator.propagate() > 0 );
+  const double * lower = propagator.lower();
+  const double * upper = propagator.upper();
+  assert( upper[0] == 2.0 && upper[1] == 4.0 && upper[2] == 4.0 );
+  assert( upper[3] == 2.5 && upper[4] == 4.0 );
+  assert( lower[4] < -1.0e30 );
+  // x0 <= 2 from row 1, after x0 <= 4 from row 0
+  int last = propagator.lastChange(0,true);
+  assert( propagator.changeReason(last) == 1 );
+  assert( propagator.changeNewValue(last) == 2.0 );
+  int previous = propagator.changePrevious(last);
+  assert( propagator.changeReason(previous) == 0 );
+  assert( propagator.changeOldValue(previous) == 10.0 );
+  assert( propagator.changePrevious(previous) == -1 );
+  assert( propagator.propagate() == 0 );
+  // branch x1 >= 3
+  int mark1 = propagator.mark();
+  assert( !propagator.changeLower(1,3.0) );
+  assert( propagator.changeReason(propagator.lastChange(1,false)) == -1 );
+  assert( propagator.propagate() == 2 );
+  assert( upper[0] == 1.0 && upper[2] == 1.0 );
+  assert( propagator.minimumActivity(0) == 3.0 );
+  assert( propagator.maximumActivity(0) == 6.0 );
+  // x0 >= 1 and x2 >= 1 - infeasible in row 0
+  int mark2 = propagator.mark();
+  assert( !propagator.changeLower(2,1.0) );
+  assert( !propagator.changeLower(0,1.0) );
+  assert( propagator.propagate() == -1 );
+  assert( propagator.infeasibleRow() == 0 );
+  assert( propagator.changeLower(0,2.0) == 1 );
+  propagator.backtrack(mark2);
+  assert( propagator.mark() == mark2 );
+  assert( lower[0] == 0.0 && lower[2] == 0.0 );
+  assert( propagator.minimumActivity(0) == 3.0 );
+  assert( propagator.maximumActivity(0) == 6.0 );
+  propagator.backtrack(mark1);
+  assert( propagator.mark() == mark1 );
+  assert( lower[1] == 0.0 && upper[0] == 2.0 && upper[2] == 4.0 );
+  assert( propagator.lastChange(1,false) == -1 );
+  assert( propagator.minimumActivity(0) == 0.0 );
+  assert( propagator.maximumActivity(0) == 10.0 );
+  assert( propagator.minimumActivity(3) == -COIN_DBL_MAX );
+  assert( propagator.maximumActivity(3) == 4.0 );
+  // all the way back
+  propagator.backtrack(0);
+  assert( upper[0] == 10.0 && upper[3] > 1.0e30 );
+  assert( propagator.maximumActivity(0) == 30.0 );
+  assert( propagator.maximumActivity(2) == COIN_DBL_MAX );
+}
@@ -0,0 +1,740 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Replays recorded (or generated) basis sequences against each
+// factorization class and reports timing and nonzero figures.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinFactorization.hpp"
+#include "CoinDenseFactorization.hpp"
+#include "CoinSimpFactorization.hpp"
+#include "CoinOslFactorization.hpp"
+#include "CoinSelectFactorization.hpp"
+#include "CoinFactorizationTrace.hpp"
+
+namespace {
+
+/*
+  Common face of CoinFactorization and the CoinOtherFactorization classes
+  as a simplex code sees them.  Basic variables are numbered as in
+  CoinFactorizationTrace.
+*/
+class benchFactor {
+public:
+  virtual ~benchFactor() {}
+  virtual const char *name() const = 0;
+  /* Factorizes basis and sets pivotVariable.  If basis was singular
+     sequence is patched with slacks (and 1 returned) */
+  virtual int factorize(const CoinPackedMatrix &matrix, int *sequence,
+			int *pivotVariable) = 0;
+  virtual int ftran(CoinIndexedVector *work, CoinIndexedVector *column) = 0;
+  // FTRAN without saving anything for an update
+  virtual int solve(CoinIndexedVector *work, CoinIndexedVector *column) = 0;
+  virtual int btran(CoinIndexedVector *work, CoinIndexedVector *row) = 0;
+  virtual int replace(CoinIndexedVector *work, CoinIndexedVector *column,
+		      int pivotRow, double alpha) = 0;
+  virtual CoinBigIndex elements() const = 0;
+  virtual int pivots() const = 0;
+  virtual double slackValue() const = 0;
+};
+
+class benchCoinFactorization : public benchFactor {
+public:
+  benchCoinFactorization(int maximumPivots, int lazyRowCopy = 0,
+			 int blockSizeR = 0, int adaptiveRefactor = 0,
+			 bool reusePivotOrder = false)
+  {
+    factorization_.maximumPivots(maximumPivots);
+    factorization_.setLazyRowCopyU(lazyRowCopy);
+    factorization_.setBlockSizeR(blockSizeR);
+    factorization_.setAdaptiveRefactor(adaptiveRefactor);
+    factorization_.setReusePivotOrder(reusePivotOrder);
+  }
+  virtual const char *name() const
+  {
+    if (factorization_.reusePivotOrder())
+      return "CoinFactorization reuse";
+    if (factorization_.adaptiveRefactor())
+      return "CoinFactorization adapt";
+    if (factorization_.blockSizeR())
+      return "CoinFactorization blockR";
+    return factorization_.lazyRowCopyU() ? "CoinFactorization lazy" :
+      "CoinFactorization";
+  }
+  virtual int factorize(const CoinPackedMatrix &matrix, int *sequence,
+			int *pivotVariable)
+  {
+    int numberRows = matrix.getNumRows();
+    int numberColumns = matrix.getNumCols();
+    std::vector<int> rowIsBasic(numberRows, -1);
+    std::vector<int> columnIsBasic(numberColumns+1, -1);
+    int returnCode = 0;
+    for (int pass = 0; pass < 2; pass++) {
+      rowIsBasic.assign(numberRows, -1);
+      columnIsBasic.assign(numberColumns+1, -1);
+      for (int i = 0; i < numberRows; i++) {
+	int iSequence = sequence[i];
+	if (iSequence >= numberColumns)
+	  rowIsBasic[iSequence-numberColumns] = 1;
+	else
+	  columnIsBasic[iSequence] = 1;
+      }
+      int status = factorization_.factorize(matrix, &rowIsBasic[0],
+					    &columnIsBasic[0]);
+      if (status == -99) {
+	// try again with more room
+	status = factorization_.factorize(matrix, &rowIsBasic[0],
+					  &columnIsBasic[0], 2.0);
+      }
+      if (status == 0)
+	break;
+      if (pass)
+	return -1;
+      /* Singular - rows which did not get a pivot get their slacks in
+	 place of variables which were thrown out */
+      returnCode = 1;
+      std::vector<char> covered(numberRows, 0);
+      for (int i = 0; i < numberRows; i++) {
+	if (rowIsBasic[i] >= 0)
+	  covered[rowIsBasic[i]] = 1;
+      }
+      for (int i = 0; i < numberColumns; i++) {
+	if (columnIsBasic[i] >= 0)
+	  covered[columnIsBasic[i]] = 1;
+      }
+      int nextRow = 0;
+      for (int i = 0; i < numberRows; i++) {
+	int iSequence = sequence[i];
+	int pivot = iSequence >= numberColumns ?
+	  rowIsBasic[iSequence-numberColumns] : columnIsBasic[iSequence];
+	if (pivot < 0) {
+	  while (covered[nextRow])
+	    nextRow++;
+	  sequence[i] = nextRow+numberColumns;
+	  covered[nextRow] = 1;
+	}
+      }
+    }
+    for (int i = 0; i < numberRows; i++) {
+      if (rowIsBasic[i] >= 0)
+	pivotVariable[rowIsBasic[i]] = i+numberColumns;
+    }
+    for (int i = 0; i < numberColumns; i++) {
+      if (columnIsBasic[i] >= 0)
+	pivotVariable[columnIsBasic[i]] = i;
+    }
+    return returnCode;
+  }
+  virtual int ftran(CoinIndexedVector *work, CoinIndexedVector *column)
+  { return factorization_.updateColumnFT(work, column); }
+  virtual int solve(CoinIndexedVector *work, CoinIndexedVector *column)
+  { return factorization_.updateColumn(work, column); }
+  virtual int btran(CoinIndexedVector *work, CoinIndexedVector *row)
+  { return factorization_.updateColumnTranspose(work, row); }
+  virtual int replace(CoinIndexedVector *work, CoinIndexedVector *,
+		      int pivotRow, double alpha)
+  { return factorization_.replaceColumn(work, pivotRow, alpha); }
+  virtual CoinBigIndex elements() const
+  { return factorization_.numberElements(); }
+  virtual int pivots() const
+  { return factorization_.pivots(); }
+  virtual double slackValue() const
+  { return factorization_.slackValue(); }
+private:
+  CoinFactorization factorization_;
+};
+
+class benchOtherFactorization : public benchFactor {
+public:
+  benchOtherFactorization(CoinOtherFactorization *factorization,
+			  const char *name, int maximumPivots)
+    : factorization_(factorization), name_(name), iteration_(0)
+  { factorization_->maximumPivots(maximumPivots); }
+  virtual ~benchOtherFactorization()
+  { delete factorization_; }
+  virtual const char *name() const { return name_; }
+  // As ClpFactorization does it
+  virtual int factorize(const CoinPackedMatrix &matrix, int *sequence,
+			int *pivotVariable)
+  {
+    int numberRows = matrix.getNumRows();
+    int numberColumns = matrix.getNumCols();
+    const CoinBigIndex *columnStart = matrix.getVectorStarts();
+    const int *columnLength = matrix.getVectorLengths();
+    const int *row = matrix.getIndices();
+    const double *element = matrix.getElements();
+    double slack = factorization_->slackValue();
+    int returnCode = 0;
+    for (int pass = 0; pass < 4; pass++) {
+      CoinBigIndex numberElements = 0;
+      for (int i = 0; i < numberRows; i++) {
+	int iSequence = sequence[i];
+	numberElements += iSequence >= numberColumns ? 1 :
+	  columnLength[iSequence];
+      }
+      factorization_->setUsefulInformation(&iteration_, 0);
+      factorization_->getAreas(numberRows, numberRows, numberElements,
+			       2*numberElements);
+      CoinFactorizationDouble *elementU = factorization_->elements();
+      int *indexRowU = factorization_->indices();
+      CoinBigIndex *startColumnU = factorization_->starts();
+      int *numberInRow = factorization_->numberInRow();
+      int *numberInColumn = factorization_->numberInColumn();
+      CoinZeroN(numberInRow, numberRows);
+      CoinZeroN(numberInColumn, numberRows);
+      CoinBigIndex put = 0;
+      for (int i = 0; i < numberRows; i++) {
+	int iSequence = sequence[i];
+	startColumnU[i] = put;
+	if (iSequence >= numberColumns) {
+	  int iRow = iSequence-numberColumns;
+	  indexRowU[put] = iRow;
+	  elementU[put++] = slack;
+	  numberInRow[iRow]++;
+	} else {
+	  for (CoinBigIndex j = columnStart[iSequence];
+	       j < columnStart[iSequence]+columnLength[iSequence]; j++) {
+	    int iRow = row[j];
+	    indexRowU[put] = iRow;
+	    elementU[put++] = element[j];
+	    numberInRow[iRow]++;
+	  }
+	}
+	numberInColumn[i] = static_cast<int>(put-startColumnU[i]);
+      }
+      startColumnU[numberRows] = put;
+      factorization_->preProcess();
+      int status = factorization_->factor();
+      if (status == 0) {
+	factorization_->postProcess(sequence, pivotVariable);
+	return returnCode;
+      } else if (status == -1) {
+	factorization_->makeNonSingular(sequence, numberColumns);
+	returnCode = 1;
+      }
+      // -99 just means try again with bigger areas
+    }
+    return -1;
+  }
+  virtual int ftran(CoinIndexedVector *work, CoinIndexedVector *column)
+  { return factorization_->updateColumnFT(work, column); }
+  virtual int solve(CoinIndexedVector *work, CoinIndexedVector *column)
+  { return factorization_->updateColumn(work, column); }
+  virtual int btran(CoinIndexedVector *work, CoinIndexedVector *row)
+  { return factorization_->updateColumnTranspose(work, row); }
+  virtual int replace(CoinIndexedVector *work, CoinIndexedVector *column,
+		      int pivotRow, double alpha)
+  {
+    iteration_++;
+    factorization_->setUsefulInformation(&iteration_, 1);
+    return factorization_->replaceColumn(
+	      factorization_->wantsTableauColumn() ? column : work,
+	      pivotRow, alpha);
+  }
+  virtual CoinBigIndex elements() const
+  { return factorization_->numberNonZeros(); }
+  virtual int pivots() const
+  { return factorization_->pivots(); }
+  virtual double slackValue() const
+  { return factorization_->slackValue(); }
+private:
+  CoinOtherFactorization *factorization_;
+  const char *name_;
+  int iteration_;
+};
+
+/// Figures for one factorization on one trace
+typedef struct {
+  int factorizations;
+  int forced;
+  int singular;
+  int pivots;
+  double factorTime;
+  double ftranTime;
+  double btranTime;
+  double replaceTime;
+  double totalTime;
+  double factorElements;
+  CoinBigIndex maximumElements;
+  double maximumError;
+} benchFigures;
+
+// Puts column (or slack) of variable into vector in packed form as Clp does
+void unpackVariable(const CoinPackedMatrix &matrix, int iSequence,
+		    double slack, CoinIndexedVector &vector)
+{
+  int numberColumns = matrix.getNumCols();
+  if (iSequence >= numberColumns) {
+    int iRow = iSequence-numberColumns;
+    vector.createPacked(1, &iRow, &slack);
+  } else {
+    CoinBigIndex start = matrix.getVectorStarts()[iSequence];
+    vector.createPacked(matrix.getVectorLengths()[iSequence],
+			matrix.getIndices()+start,
+			matrix.getElements()+start);
+  }
+}
+
+// Value in row of packed vector
+double packedValue(const CoinIndexedVector &vector, int iRow)
+{
+  const double *region = vector.denseVector();
+  const int *index = vector.getIndices();
+  int number = vector.getNumElements();
+  for (int i = 0; i < number; i++) {
+    if (index[i] == iRow)
+      return region[i];
+  }
+  return 0.0;
+}
+
+/* Largest error in updated column of variable basic in pivotRow
+   (which should be unit vector).  Done unpacked as updateColumn wants */
+double unitError(benchFactor &factor, const CoinPackedMatrix &matrix,
+		 int iSequence, int pivotRow,
+		 CoinIndexedVector &work, CoinIndexedVector &column)
+{
+  unpackVariable(matrix, iSequence, factor.slackValue(), column);
+  // expand
+  int number = column.getNumElements();
+  std::vector<int> index(column.getIndices(), column.getIndices()+number);
+  std::vector<double> value(column.denseVector(),
+			    column.denseVector()+number);
+  column.clear();
+  for (int i = 0; i < number; i++)
+    column.insert(index[i], value[i]);
+  factor.solve(&work, &column);
+  const double *region = column.denseVector();
+  number = column.getNumElements();
+  double largest = fabs(region[pivotRow]-1.0);
+  for (int i = 0; i < number; i++) {
+    int iRow = column.getIndices()[i];
+    if (iRow != pivotRow)
+      largest = CoinMax(largest, fabs(region[iRow]));
+  }
+  column.clear();
+  work.clear();
+  return largest;
+}
+
+// Replays trace through factorization
+void replay(const CoinFactorizationTrace &trace, benchFactor &factor,
+	    int maximumPivots, benchFigures &figures)
+{
+  memset(&figures, 0, sizeof(figures));
+  const CoinPackedMatrix &matrix = *trace.matrix();
+  int numberRows = trace.numberRows();
+  int numberColumns = trace.numberColumns();
+  int numberTotal = numberRows+numberColumns;
+  std::vector<int> sequence(numberRows);
+  std::vector<int> pivotVariable(numberRows);
+  // row of each basic variable, -1 if not basic
+  std::vector<int> rowOf(numberTotal, -1);
+  CoinIndexedVector work;
+  CoinIndexedVector column;
+  CoinIndexedVector row;
+  CoinIndexedVector rowWork;
+  // updates may use a row for each pivot
+  int capacity = numberRows+maximumPivots+1;
+  work.reserve(capacity);
+  column.reserve(capacity);
+  row.reserve(capacity);
+  rowWork.reserve(capacity);
+  const int *basis = trace.basis();
+  double startTime = CoinCpuTime();
+  int lastIn = -1;
+  for (int iEvent = 0; iEvent < trace.numberEvents(); iEvent++) {
+    bool refactorize = false;
+    if (trace.event(iEvent) == CoinFactorizationTrace::factorizeEvent) {
+      // fill up short bases with slacks
+      int numberBasic = trace.first(iEvent);
+      CoinMemcpyN(basis+trace.second(iEvent), numberBasic, &sequence[0]);
+      std::vector<char> isBasic(numberTotal, 0);
+      for (int i = 0; i < numberBasic; i++)
+	isBasic[sequence[i]] = 1;
+      for (int iRow = 0; iRow < numberRows && numberBasic < numberRows;
+	   iRow++) {
+	if (!isBasic[iRow+numberColumns])
+	  sequence[numberBasic++] = iRow+numberColumns;
+      }
+      refactorize = true;
+    } else {
+      int sequenceIn = trace.first(iEvent);
+      int sequenceOut = trace.second(iEvent);
+      int pivotRow = rowOf[sequenceOut];
+      if (pivotRow < 0 || rowOf[sequenceIn] >= 0)
+	continue; // not consistent with basis (after singularity)
+      // BTRAN of unit vector as for row of tableau (dual simplex order)
+      double one = 1.0;
+      row.createPacked(1, &pivotRow, &one);
+      double time1 = CoinCpuTime();
+      factor.btran(&rowWork, &row);
+      double time2 = CoinCpuTime();
+      figures.btranTime += time2-time1;
+      row.clear();
+      rowWork.clear();
+      // FTRAN of incoming column, leaves spike in work for replace
+      time1 = CoinCpuTime();
+      unpackVariable(matrix, sequenceIn, factor.slackValue(), column);
+      factor.ftran(&work, &column);
+      double alpha = packedValue(column, pivotRow);
+      time2 = CoinCpuTime();
+      figures.ftranTime += time2-time1;
+      int status = 2;
+      if (fabs(alpha) > 1.0e-9) {
+	time1 = CoinCpuTime();
+	status = factor.replace(&work, &column, pivotRow, alpha);
+	time2 = CoinCpuTime();
+	figures.replaceTime += time2-time1;
+      }
+      work.clear();
+      column.clear();
+      rowOf[sequenceOut] = -1;
+      rowOf[sequenceIn] = pivotRow;
+      pivotVariable[pivotRow] = sequenceIn;
+      figures.pivots++;
+      lastIn = sequenceIn;
+      if (status >= 1) {
+	// column did not go in (or, for 1, may be in only partly as when
+	// Osl runs out of eta space) so refactorize as Clp does and do not
+	// check
+	figures.forced++;
+	refactorize = true;
+	lastIn = -1;
+      } else {
+	figures.maximumElements = CoinMax(figures.maximumElements,
+					  factor.elements());
+      }
+      // as new basis
+      CoinMemcpyN(&pivotVariable[0], numberRows, &sequence[0]);
+    }
+    if (refactorize) {
+      if (lastIn >= 0 && rowOf[lastIn] >= 0 && figures.factorizations) {
+	// see how accurate updates were
+	double error = unitError(factor, matrix, lastIn, rowOf[lastIn],
+				 work, column);
+	figures.maximumError = CoinMax(figures.maximumError, error);
+      }
+      double time1 = CoinCpuTime();
+      int status = factor.factorize(matrix, &sequence[0], &pivotVariable[0]);
+      double time2 = CoinCpuTime();
+      figures.factorTime += time2-time1;
+      figures.factorizations++;
+      if (status)
+	figures.singular++;
+      if (status < 0)
+	break;
+      figures.factorElements += factor.elements();
+      figures.maximumElements = CoinMax(figures.maximumElements,
+					factor.elements());
+      rowOf.assign(numberTotal, -1);
+      for (int i = 0; i < numberRows; i++)
+	rowOf[pivotVariable[i]] = i;
+      lastIn = -1;
+    }
+  }
+  figures.totalTime = CoinCpuTime()-startTime;
+  if (figures.factorizations)
+    figures.factorElements /= figures.factorizations;
+}
+
+/*
+  Makes trace by doing random pivots on matrix with CoinFactorization.
+  Entering variables are random nonbasic variables and the leaving one
+  has largest element in updated column, so bases stay well conditioned.
+*/
+void generate(const CoinPackedMatrix &matrix, int numberPivots,
+	      int maximumPivots, CoinFactorizationTrace &trace)
+{
+  trace.setMatrix(matrix);
+  const CoinPackedMatrix &columnCopy = *trace.matrix();
+  int numberRows = columnCopy.getNumRows();
+  int numberColumns = columnCopy.getNumCols();
+  int numberTotal = numberRows+numberColumns;
+  benchCoinFactorization factor(maximumPivots);
+  std::vector<int> sequence(numberRows);
+  std::vector<int> pivotVariable(numberRows);
+  std::vector<int> rowOf(numberTotal, -1);
+  for (int i = 0; i < numberRows; i++)
+    sequence[i] = i+numberColumns;
+  CoinIndexedVector work;
+  CoinIndexedVector column;
+  work.reserve(numberRows+maximumPivots+1);
+  column.reserve(numberRows+maximumPivots+1);
+  CoinThreadRandom random(1234567);
+  bool refactorize = true;
+  int numberDone = 0;
+  int numberTries = 0;
+  while (numberDone < numberPivots && numberTries < 10*numberPivots) {
+    if (refactorize) {
+      if (factor.factorize(columnCopy, &sequence[0], &pivotVariable[0]) < 0)
+	break;
+      trace.addFactorize(numberRows, &sequence[0]);
+      rowOf.assign(numberTotal, -1);
+      for (int i = 0; i < numberRows; i++)
+	rowOf[pivotVariable[i]] = i;
+      refactorize = false;
+    }
+    numberTries++;
+    int sequenceIn = static_cast<int>(random.randomDouble()*numberTotal);
+    if (sequenceIn >= numberTotal || rowOf[sequenceIn] >= 0)
+      continue;
+    unpackVariable(columnCopy, sequenceIn, factor.slackValue(), column);
+    factor.ftran(&work, &column);
+    const double *region = column.denseVector();
+    const int *index = column.getIndices();
+    int number = column.getNumElements();
+    int pivotRow = -1;
+    double alpha = 0.0;
+    double largest = 1.0e-5;
+    for (int i = 0; i < number; i++) {
+      int iRow = index[i];
+      if (fabs(region[i]) > largest) {
+	largest = fabs(region[i]);
+	pivotRow = iRow;
+	alpha = region[i];
+      }
+    }
+    if (pivotRow >= 0) {
+      int sequenceOut = pivotVariable[pivotRow];
+      int status = factor.replace(&work, &column, pivotRow, alpha);
+      trace.addPivot(sequenceIn, sequenceOut);
+      numberDone++;
+      rowOf[sequenceOut] = -1;
+      rowOf[sequenceIn] = pivotRow;
+      pivotVariable[pivotRow] = sequenceIn;
+      if (status >= 1 || factor.pivots() >= maximumPivots) {
+	CoinMemcpyN(&pivotVariable[0], numberRows, &sequence[0]);
+	refactorize = true;
+      }
+    }
+    work.clear();
+    column.clear();
+  }
+}
+
+// Random sparse matrix with a diagonal so slack free bases exist
+CoinPackedMatrix randomMatrix(int numberRows, int numberColumns,
+			      int perColumn)
+{
+  CoinThreadRandom random(987654321);
+  std::vector<CoinBigIndex> start(numberColumns+1);
+  std::vector<int> row;
+  std::vector<double> element;
+  std::vector<char> used(numberRows, 0);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    start[iColumn] = static_cast<CoinBigIndex>(row.size());
+    int diagonal = iColumn%numberRows;
+    row.push_back(diagonal);
+    element.push_back(1.0+random.randomDouble());
+    used[diagonal] = 1;
+    for (int k = 1; k < perColumn; k++) {
+      int iRow = static_cast<int>(random.randomDouble()*numberRows);
+      if (iRow < numberRows && !used[iRow]) {
+	used[iRow] = 1;
+	row.push_back(iRow);
+	element.push_back(2.0*random.randomDouble()-1.0);
+      }
+    }
+    for (CoinBigIndex j = start[iColumn]; j < static_cast<CoinBigIndex>(row.size()); j++)
+      used[row[j]] = 0;
+  }
+  start[numberColumns] = static_cast<CoinBigIndex>(row.size());
+  return CoinPackedMatrix(true, numberRows, numberColumns,
+			  start[numberColumns], &element[0], &row[0],
+			  &start[0], NULL);
+}
+
+} // end unnamed namespace
+
+/*
+  Parameters (all optional)
+    -replay=file[,file...]  traces to replay
+    -generate=file          model (mps) to generate trace from
+    -trace=file             where to write generated trace
+    -pivots=n               pivots in generated trace (default 1000)
+    -maxPivots=n            pivots between factorizations (default 100)
+    -factorizations=list    any of coin,osl,simp,dense,select (default all)
+    -denseLimit=n           skip dense factorization above n rows (2000)
+    -lazyRowCopy=n          also CoinFactorization with n updates kept
+                            out of row copy of U
+    -blockR=n               also CoinFactorization merging R etas into
+                            blocks of n
+    -adaptive=n             also CoinFactorization refactorizing when
+                            adaptive control says so, up to n pivots
+    -reuseOrder             also CoinFactorization following pivot order
+                            of last factorization
+    -csv=file               append figures as comma separated values
+    -tolerance=x            largest error allowed after updates (1.0e-7)
+  With no trace or model a random matrix is used.  Returns 2 if any
+  factorization has an error above tolerance.
+*/
+int CoinFactorizationBenchmark(std::map<std::string, std::string> &parms)
+{
+  int numberPivots = 1000;
+  int maximumPivots = 100;
+  int denseLimit = 2000;
+  int lazyRowCopy = 0;
+  int blockSizeR = 0;
+  int adaptivePivots = 0;
+  double tolerance = 1.0e-7;
+  bool reuseOrder = parms.find("-reuseOrder") != parms.end();
+  if (parms.find("-pivots") != parms.end())
+    numberPivots = atoi(parms["-pivots"].c_str());
+  if (parms.find("-maxPivots") != parms.end())
+    maximumPivots = atoi(parms["-maxPivots"].c_str());
+  if (parms.find("-denseLimit") != parms.end())
+    denseLimit = atoi(parms["-denseLimit"].c_str());
+  if (parms.find("-lazyRowCopy") != parms.end())
+    lazyRowCopy = atoi(parms["-lazyRowCopy"].c_str());
+  if (parms.find("-blockR") != parms.end())
+    blockSizeR = atoi(parms["-blockR"].c_str());
+  if (parms.find("-adaptive") != parms.end())
+    adaptivePivots = atoi(parms["-adaptive"].c_str());
+  if (parms.find("-tolerance") != parms.end())
+    tolerance = atof(parms["-tolerance"].c_str());
+  std::string which = "coin,osl,simp,dense,select";
+  if (parms.find("-factorizations") != parms.end())
+    which = parms["-factorizations"];
+  which = "," + which + ",";
+  // Get traces
+  std::vector<std::string> names;
+  std::vector<CoinFactorizationTrace> traces;
+  if (parms.find("-replay") != parms.end()) {
+    std::string list = parms["-replay"];
+    while (list.length()) {
+      std::string::size_type comma = list.find(',');
+      std::string file = list.substr(0, comma);
+      list = comma == std::string::npos ? "" : list.substr(comma+1);
+      CoinFactorizationTrace trace;
+      int returnCode = trace.readTrace(file.c_str());
+      if (returnCode) {
+	printf("Unable to read trace %s (%d)\n", file.c_str(), returnCode);
+	return 1;
+      }
+      names.push_back(file);
+      traces.push_back(trace);
+    }
+  }
+  if (!traces.size()) {
+    CoinFactorizationTrace trace;
+    if (parms.find("-generate") != parms.end()) {
+      std::string file = parms["-generate"];
+      CoinMpsIO m;
+      m.messageHandler()->setLogLevel(0);
+      if (m.readMps(file.c_str(), "")) {
+	printf("Unable to read model %s\n", file.c_str());
+	return 1;
+      }
+      generate(*m.getMatrixByCol(), numberPivots, maximumPivots, trace);
+      names.push_back(file);
+    } else {
+      CoinPackedMatrix matrix = randomMatrix(1000, 3000, 5);
+      generate(matrix, numberPivots, maximumPivots, trace);
+      names.push_back("random");
+    }
+    if (parms.find("-trace") != parms.end()) {
+      if (trace.writeTrace(parms["-trace"].c_str())) {
+	printf("Unable to write trace %s\n", parms["-trace"].c_str());
+	return 1;
+      }
+    }
+    traces.push_back(trace);
+  }
+  int returnCode = 0;
+  FILE *csv = NULL;
+  if (parms.find("-csv") != parms.end()) {
+    csv = fopen(parms["-csv"].c_str(), "a");
+    if (!csv) {
+      printf("Unable to open %s\n", parms["-csv"].c_str());
+      return 1;
+    }
+    fseek(csv, 0, SEEK_END);
+    if (!ftell(csv))
+      fprintf(csv, "trace,factorization,factorizations,forced,singular,"
+	      "pivots,total,factor,ftran,btran,replace,averageElements,"
+	      "maximumElements,maximumError\n");
+  }
+  for (size_t iTrace = 0; iTrace < traces.size(); iTrace++) {
+    const CoinFactorizationTrace &trace = traces[iTrace];
+    int numberRows = trace.numberRows();
+    printf("%s - %d rows, %d columns, %d factorizations, %d pivots\n",
+	   names[iTrace].c_str(), numberRows, trace.numberColumns(),
+	   trace.numberFactorizations(), trace.numberPivots());
+    printf("%-24s %6s %6s %8s %8s %8s %8s %8s %10s %10s %9s\n",
+	   "factorization", "facts", "forced", "total", "factor", "ftran",
+	   "btran", "replace", "avg nz", "max nz", "error");
+    std::vector<benchFactor *> factors;
+    if (which.find(",coin,") != std::string::npos)
+      factors.push_back(new benchCoinFactorization(maximumPivots));
+    if (which.find(",coin,") != std::string::npos && lazyRowCopy > 0)
+      factors.push_back(new benchCoinFactorization(maximumPivots,
+						   lazyRowCopy));
+    if (which.find(",coin,") != std::string::npos && blockSizeR > 1)
+      factors.push_back(new benchCoinFactorization(maximumPivots, 0,
+						   blockSizeR));
+    if (which.find(",coin,") != std::string::npos && adaptivePivots > 0)
+      factors.push_back(new benchCoinFactorization(adaptivePivots, 0, 0, 2));
+    if (which.find(",coin,") != std::string::npos && reuseOrder)
+      factors.push_back(new benchCoinFactorization(maximumPivots, 0, 0, 0,
+						   true));
+    if (which.find(",osl,") != std::string::npos)
+      factors.push_back(new benchOtherFactorization(
+			  new CoinOslFactorization(), "CoinOslFactorization",
+			  maximumPivots));
+    if (which.find(",simp,") != std::string::npos)
+      factors.push_back(new benchOtherFactorization(
+			  new CoinSimpFactorization(), "CoinSimpFactorization",
+			  maximumPivots));
+    if (which.find(",dense,") != std::string::npos && numberRows <= denseLimit)
+      factors.push_back(new benchOtherFactorization(
+			  new CoinDenseFactorization(), "CoinDenseFactorization",
+			  maximumPivots));
+    if (which.find(",select,") != std::string::npos)
+      factors.push_back(new benchOtherFactorization(
+			  new CoinSelectFactorization(),
+			  "CoinSelectFactorization", maximumPivots));
+    for (size_t i = 0; i < factors.size(); i++) {
+      benchFigures figures;
+      replay(trace, *factors[i], maximumPivots, figures);
+      printf("%-24s %6d %6d %8.3f %8.3f %8.3f %8.3f %8.3f %10.0f %10d %9.2g%s\n",
+	     factors[i]->name(), figures.factorizations, figures.forced,
+	     figures.totalTime, figures.factorTime, figures.ftranTime,
+	     figures.btranTime, figures.replaceTime, figures.factorElements,
+	     static_cast<int>(figures.maximumElements), figures.maximumError,
+	     figures.singular ? " (singular)" : "");
+      if (csv)
+	fprintf(csv, "%s,%s,%d,%d,%d,%d,%g,%g,%g,%g,%g,%g,%d,%g\n",
+		names[iTrace].c_str(), factors[i]->name(),
+		figures.factorizations, figures.forced, figures.singular,
+		figures.pivots, figures.totalTime, figures.factorTime,
+		figures.ftranTime, figures.btranTime, figures.replaceTime,
+		figures.factorElements,
+		static_cast<int>(figures.maximumElements),
+		figures.maximumError);
+      if (figures.maximumError > tolerance) {
+	printf("%s error %g is above tolerance %g\n", factors[i]->name(),
+	       figures.maximumError, tolerance);
+	returnCode = 2;
+      }
+      delete factors[i];
+    }
+  }
+  if (csv)
+    fclose(csv);
+  return returnCode;
+}
@@ -0,0 +1,114 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinFingerprint.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinModel.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinSnapshot.hpp"
+#include "CoinFinite.hpp"
+
+void CoinFingerprintUnitTest()
+{
+  // Fingerprints - orientation, pattern and the same model three ways
+  const int numberRows = 40;
+  const int numberColumns = 60;
+  CoinPackedMatrix byColumn(true,0,0);
+  byColumn.setDimensions(numberRows,0);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    int index[4];
+    double elements[4];
+    for (int j = 0; j < 4; j++) {
+      index[j] = (iColumn + 7*j)%numberRows;
+      elements[j] = (j == 2) ? -0.5*iColumn : 1.0 + j;
+    }
+    byColumn.appendCol(4,index,elements);
+  }
+  CoinPackedMatrix byRow;
+  byRow.reverseOrderedCopyOf(byColumn);
+  assert( byColumn.fingerprint() != byRow.fingerprint() );
+  assert( byColumn.fingerprint(true) == byRow.fingerprint(true) );
+  assert( byColumn.fingerprint(false,4) == byColumn.fingerprint() );
+  // stored zero (column 0) is left out of content but not pattern
+  CoinPackedMatrix noZero(byColumn);
+  noZero.removeGaps(1.0e-300);
+  assert( noZero.getNumElements() == byColumn.getNumElements() - 1 );
+  assert( noZero.fingerprint() == byColumn.fingerprint() );
+  assert( noZero.patternFingerprint() != byColumn.patternFingerprint() );
+  // values do not change pattern - so equivalence within tolerance
+  CoinPackedMatrix perturbed(byColumn);
+  perturbed.modifyCoefficient(17,10,2.0+1.0e-14);
+  assert( perturbed.fingerprint() != byColumn.fingerprint() );
+  assert( perturbed.patternFingerprint() == byColumn.patternFingerprint() );
+  assert( perturbed.isEquivalent(byColumn) );
+  CoinPackedMatrix moved(byColumn);
+  moved.modifyCoefficient(24,10,2.0);
+  assert( !moved.isEquivalent(byColumn) );
+  char hex[33];
+  byColumn.fingerprint().toString(hex);
+  assert( strlen(hex) == 32 );
+
+  double columnLower[numberColumns];
+  double columnUpper[numberColumns];
+  double objective[numberColumns];
+  char integer[numberColumns];
+  char columnType[numberColumns];
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    columnLower[iColumn] = (iColumn%5 == 0) ? -COIN_DBL_MAX : 0.0;
+    columnUpper[iColumn] = (iColumn%3 == 0) ? 1.0 : COIN_DBL_MAX;
+    objective[iColumn] = iColumn - 20.0;
+    integer[iColumn] = (iColumn%4 == 0) ? 1 : 0;
+    columnType[iColumn] = (iColumn%4 == 0) ? 'I' : 'C';
+  }
+  double rowLower[numberRows];
+  double rowUpper[numberRows];
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    rowLower[iRow] = (iRow%2) ? 1.0 : -COIN_DBL_MAX;
+    rowUpper[iRow] = 10.0 + iRow;
+  }
+  CoinMpsIO mps;
+  mps.setMpsData(byColumn,1.0e30,columnLower,columnUpper,objective,
+		 integer,rowLower,rowUpper,
+		 static_cast<const char * const *>(NULL),
+		 static_cast<const char * const *>(NULL));
+  // one model packed from rows, one built column by column
+  CoinModel packed;
+  packed.loadArrays(numberRows,numberColumns,false,
+		    byRow.getVectorStarts(),byRow.getIndices(),
+		    byRow.getElements(),rowLower,rowUpper,
+		    columnLower,columnUpper,objective,integer);
+  CoinModel model;
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    model.setRowBounds(iRow,rowLower[iRow],rowUpper[iRow]);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    const CoinBigIndex start = byColumn.getVectorStarts()[iColumn];
+    model.addColumn(byColumn.getVectorLengths()[iColumn],
+		    byColumn.getIndices() + start,
+		    byColumn.getElements() + start,
+		    columnLower[iColumn],columnUpper[iColumn],
+		    objective[iColumn],NULL,integer[iColumn] != 0);
+  }
+  CoinSnapshot snapshot;
+  snapshot.loadProblem(byRow,columnLower,columnUpper,objective,
+		       rowLower,rowUpper,false);
+  snapshot.setColType(columnType);
+  const CoinFingerprint fingerprint = mps.fingerprint();
+  assert( packed.fingerprint() == fingerprint );
+  assert( model.fingerprint() == fingerprint );
+  assert( model.fingerprint(4) == fingerprint );
+  assert( snapshot.fingerprint() == fingerprint );
+  model.setColumnUpper(1,5.0);
+  assert( model.fingerprint() != fingerprint );
+  model.setColumnUpper(1,COIN_DBL_MAX);
+  model.setColumnIsInteger(1,true);
+  assert( model.fingerprint() != fingerprint );
+}
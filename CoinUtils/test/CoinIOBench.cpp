@@ -0,0 +1,570 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Writes generated and real models as MPS and LP files in each compression
+// and times reading them back, end to end and phase by phase.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#if !defined(_MSC_VER)
+#include <sys/resource.h>
+#endif
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinError.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinFinite.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinLpIO.hpp"
+#include "CoinModelUseful.hpp"
+#include "CoinPackedMatrix.hpp"
+
+namespace {
+
+/// One model held in memory, with names
+struct benchModel {
+  std::string name;
+  CoinPackedMatrix matrix;
+  std::vector<double> columnLower;
+  std::vector<double> columnUpper;
+  std::vector<double> objective;
+  std::vector<double> rowLower;
+  std::vector<double> rowUpper;
+  std::vector<char> integerType;
+  std::vector<std::string> rowNames;
+  std::vector<std::string> columnNames;
+};
+
+/// Figures for one file
+struct benchFigures {
+  double writeTime;
+  double readTime;
+  double fileBytes;
+  double textBytes;
+  // Phases
+  double ioTime;
+  double tokenTime;
+  double numberTime;
+  double hashTime;
+  double matrixTime;
+  int tokens;
+  double peakRss;
+};
+
+// Peak resident set size of the process in MB (0 if not known)
+double peakRss()
+{
+#if !defined(_MSC_VER)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage))
+    return 0.0;
+#ifdef __APPLE__
+  return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+#else
+  return 0.0;
+#endif
+}
+
+double fileSize(const std::string &file)
+{
+  FILE *fp = fopen(file.c_str(), "rb");
+  if (!fp)
+    return 0.0;
+  fseek(fp, 0, SEEK_END);
+  double size = static_cast<double>(ftell(fp));
+  fclose(fp);
+  return size;
+}
+
+// Random model with names R0000000, C0000000 .. and some integers
+void generateModel(int numberRows, int numberColumns, int perColumn,
+		   benchModel &model)
+{
+  CoinThreadRandom random(987654321);
+  std::vector<CoinBigIndex> start(numberColumns+1);
+  std::vector<int> row;
+  std::vector<double> element;
+  std::vector<char> used(numberRows, 0);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    start[iColumn] = static_cast<CoinBigIndex>(row.size());
+    for (int k = 0; k < perColumn; k++) {
+      int iRow = k ? static_cast<int>(random.randomDouble()*numberRows)
+	: iColumn%numberRows;
+      if (iRow < numberRows && !used[iRow]) {
+	used[iRow] = 1;
+	row.push_back(iRow);
+	// Mix of short and long numbers as in real models
+	double value = 2.0*random.randomDouble()-1.0;
+	if (k&1)
+	  value = floor(100.0*value) + 0.5;
+	element.push_back(value);
+      }
+    }
+    for (CoinBigIndex j = start[iColumn]; j < static_cast<CoinBigIndex>(row.size()); j++)
+      used[row[j]] = 0;
+  }
+  start[numberColumns] = static_cast<CoinBigIndex>(row.size());
+  model.name = "generated";
+  model.matrix = CoinPackedMatrix(true, numberRows, numberColumns,
+				  start[numberColumns], &element[0], &row[0],
+				  &start[0], NULL);
+  model.columnLower.assign(numberColumns, 0.0);
+  model.columnUpper.resize(numberColumns);
+  model.objective.resize(numberColumns);
+  model.integerType.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    model.columnUpper[iColumn] = (iColumn%3) ? COIN_DBL_MAX : 10.0;
+    model.objective[iColumn] = floor(1000.0*random.randomDouble())*0.01;
+    model.integerType[iColumn] = (iColumn%7) ? 0 : 1;
+  }
+  model.rowLower.assign(numberRows, -COIN_DBL_MAX);
+  model.rowUpper.resize(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    model.rowUpper[iRow] = 1.0+floor(100.0*random.randomDouble());
+  char name[16];
+  model.rowNames.resize(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    sprintf(name, "R%7.7d", iRow);
+    model.rowNames[iRow] = name;
+  }
+  model.columnNames.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    sprintf(name, "C%7.7d", iColumn);
+    model.columnNames[iColumn] = name;
+  }
+}
+
+// Takes model from a reader
+void takeModel(const CoinMpsIO &m, benchModel &model)
+{
+  int numberRows = m.getNumRows();
+  int numberColumns = m.getNumCols();
+  model.matrix = *m.getMatrixByCol();
+  model.columnLower.assign(m.getColLower(), m.getColLower()+numberColumns);
+  model.columnUpper.assign(m.getColUpper(), m.getColUpper()+numberColumns);
+  model.objective.assign(m.getObjCoefficients(),
+			 m.getObjCoefficients()+numberColumns);
+  model.rowLower.assign(m.getRowLower(), m.getRowLower()+numberRows);
+  model.rowUpper.assign(m.getRowUpper(), m.getRowUpper()+numberRows);
+  model.integerType.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    model.integerType[iColumn] = m.isInteger(iColumn) ? 1 : 0;
+  model.rowNames.resize(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    model.rowNames[iRow] = m.rowName(iRow);
+  model.columnNames.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    model.columnNames[iColumn] = m.columnName(iColumn);
+}
+
+void takeModel(const CoinLpIO &m, benchModel &model)
+{
+  int numberRows = m.getNumRows();
+  int numberColumns = m.getNumCols();
+  model.matrix = *m.getMatrixByCol();
+  model.columnLower.assign(m.getColLower(), m.getColLower()+numberColumns);
+  model.columnUpper.assign(m.getColUpper(), m.getColUpper()+numberColumns);
+  model.objective.assign(m.getObjCoefficients(),
+			 m.getObjCoefficients()+numberColumns);
+  model.rowLower.assign(m.getRowLower(), m.getRowLower()+numberRows);
+  model.rowUpper.assign(m.getRowUpper(), m.getRowUpper()+numberRows);
+  model.integerType.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    model.integerType[iColumn] = m.isInteger(iColumn) ? 1 : 0;
+  model.rowNames.resize(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    model.rowNames[iRow] = m.rowName(iRow);
+  model.columnNames.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    model.columnNames[iColumn] = m.columnName(iColumn);
+}
+
+// Writes model, returns file name actually written (or "" on failure)
+std::string writeModel(const benchModel &model, bool lp,
+		       const std::string &base, int compression)
+{
+  static const char *suffix[] = { "", ".gz", ".bz2", ".zst", ".lz4" };
+  std::string file = base + (lp ? ".lp" : ".mps");
+  int numberRows = model.matrix.getNumRows();
+  int numberColumns = model.matrix.getNumCols();
+  std::vector<const char *> rowNames(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    rowNames[iRow] = model.rowNames[iRow].c_str();
+  std::vector<const char *> columnNames(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    columnNames[iColumn] = model.columnNames[iColumn].c_str();
+  int returnCode;
+  if (lp) {
+    CoinLpIO m;
+    m.messageHandler()->setLogLevel(0);
+    m.setLpDataWithoutRowAndColNames(model.matrix, &model.columnLower[0],
+				     &model.columnUpper[0],
+				     &model.objective[0],
+				     &model.integerType[0],
+				     &model.rowLower[0], &model.rowUpper[0]);
+    // LP names also need the objective name at the end of the row names
+    rowNames.push_back("obj");
+    m.setLpDataRowAndColNames(&rowNames[0], &columnNames[0]);
+    returnCode = m.writeLp(file.c_str(), true, compression);
+  } else {
+    CoinMpsIO m;
+    m.messageHandler()->setLogLevel(0);
+    m.setMpsData(model.matrix, COIN_DBL_MAX, &model.columnLower[0],
+		 &model.columnUpper[0], &model.objective[0],
+		 &model.integerType[0], &model.rowLower[0],
+		 &model.rowUpper[0], model.columnNames, model.rowNames);
+    returnCode = m.writeMps(file.c_str(), compression);
+  }
+  if (returnCode)
+    return "";
+  file += suffix[compression];
+  return fileSize(file) > 0.0 ? file : "";
+}
+
+// Reads whole file (decompressed) into text
+double readText(const std::string &file, std::string &text)
+{
+  double time1 = CoinWallclockTime();
+  CoinFileInput *input = CoinFileInput::create(file);
+  text.clear();
+  size_t length;
+  char *chunk;
+  while ((chunk = input->readChunk(length)) != NULL)
+    text.append(chunk, length);
+  delete input;
+  return CoinWallclockTime() - time1;
+}
+
+// Splits text at white space; fields are kept as offsets
+double tokenize(const std::string &text, std::vector<size_t> &fields)
+{
+  double time1 = CoinWallclockTime();
+  fields.clear();
+  const char *c = text.c_str();
+  size_t length = text.length();
+  size_t i = 0;
+  while (i < length) {
+    while (i < length && (c[i] == ' ' || c[i] == '\t' || c[i] == '\n' || c[i] == '\r'))
+      i++;
+    if (i < length)
+      fields.push_back(i);
+    while (i < length && !(c[i] == ' ' || c[i] == '\t' || c[i] == '\n' || c[i] == '\r'))
+      i++;
+  }
+  return CoinWallclockTime() - time1;
+}
+
+// Converts every field that starts like a number
+double parseNumbers(const std::string &text, const std::vector<size_t> &fields,
+		    double &sum)
+{
+  double time1 = CoinWallclockTime();
+  const char *c = text.c_str();
+  sum = 0.0;
+  for (size_t i = 0; i < fields.size(); i++) {
+    const char *field = c + fields[i];
+    if ((*field >= '0' && *field <= '9') || *field == '-' || *field == '+' || *field == '.')
+      sum += strtod(field, NULL);
+  }
+  return CoinWallclockTime() - time1;
+}
+
+// Hashes row and column names and looks each one up, as readers do
+double hashNames(const benchModel &model)
+{
+  double time1 = CoinWallclockTime();
+  for (int pass = 0; pass < 2; pass++) {
+    const std::vector<std::string> &names = pass ? model.columnNames
+      : model.rowNames;
+    int number = static_cast<int>(names.size());
+    std::vector<const char *> pointers(number);
+    for (int i = 0; i < number; i++)
+      pointers[i] = names[i].c_str();
+    CoinModelHash hash;
+    hash.resize(number);
+    if (number)
+      hash.addNames(number, &pointers[0]);
+    for (int i = 0; i < number; i++) {
+      if (hash.hash(pointers[i]) != i)
+	throw CoinError("name not found", "hashNames", "CoinIOBench");
+    }
+  }
+  return CoinWallclockTime() - time1;
+}
+
+// Builds column ordered matrix from triples, as readers do
+double buildMatrix(const benchModel &model)
+{
+  CoinPackedMatrix rowCopy;
+  rowCopy.reverseOrderedCopyOf(model.matrix);
+  CoinBigIndex numberElements = model.matrix.getNumElements();
+  std::vector<int> rowIndices(numberElements);
+  std::vector<int> columnIndices(numberElements);
+  std::vector<double> elements(numberElements);
+  CoinBigIndex k = 0;
+  for (int iRow = 0; iRow < rowCopy.getNumRows(); iRow++) {
+    for (CoinBigIndex j = rowCopy.getVectorFirst(iRow); j < rowCopy.getVectorLast(iRow); j++) {
+      rowIndices[k] = iRow;
+      columnIndices[k] = rowCopy.getIndices()[j];
+      elements[k++] = rowCopy.getElements()[j];
+    }
+  }
+  double time1 = CoinWallclockTime();
+  CoinPackedMatrix matrix(true, numberElements ? &rowIndices[0] : NULL,
+			  numberElements ? &columnIndices[0] : NULL,
+			  numberElements ? &elements[0] : NULL, numberElements);
+  double time = CoinWallclockTime() - time1;
+  if (matrix.getNumElements() != numberElements)
+    throw CoinError("wrong number of elements", "buildMatrix", "CoinIOBench");
+  return time;
+}
+
+// Reads file back with the real reader, returns false if not same size
+bool readModel(const std::string &file, bool lp, const benchModel &model,
+	       double &time)
+{
+  double time1 = CoinWallclockTime();
+  int numberRows;
+  int numberColumns;
+  CoinBigIndex numberElements;
+  if (lp) {
+    CoinLpIO m;
+    m.messageHandler()->setLogLevel(0);
+    m.readLp(file.c_str());
+    numberRows = m.getNumRows();
+    numberColumns = m.getNumCols();
+    numberElements = m.getNumElements();
+  } else {
+    CoinMpsIO m;
+    m.messageHandler()->setLogLevel(0);
+    if (m.readMps(file.c_str(), ""))
+      return false;
+    numberRows = m.getNumRows();
+    numberColumns = m.getNumCols();
+    numberElements = m.getNumElements();
+  }
+  time = CoinWallclockTime() - time1;
+  // LP is written with a fixed number of decimals so tiny elements vanish
+  return numberRows == model.matrix.getNumRows()
+    && numberColumns == model.matrix.getNumCols()
+    && (lp || numberElements == model.matrix.getNumElements());
+}
+
+// Best (smallest) of repeats of each timing
+void benchFile(const benchModel &model, bool lp, const std::string &base,
+	       int compression, int repeats, std::string &file,
+	       benchFigures &figures)
+{
+  memset(&figures, 0, sizeof(figures));
+  double sum = 0.0;
+  for (int pass = 0; pass < repeats; pass++) {
+    double time1 = CoinWallclockTime();
+    file = writeModel(model, lp, base, compression);
+    double writeTime = CoinWallclockTime() - time1;
+    if (file == "")
+      return;
+    double readTime;
+    if (!readModel(file, lp, model, readTime))
+      throw CoinError("model read back differs", "benchFile", "CoinIOBench");
+    std::string text;
+    double ioTime = readText(file, text);
+    std::vector<size_t> fields;
+    double tokenTime = tokenize(text, fields);
+    double numberTime = parseNumbers(text, fields, sum);
+    double hashTime = hashNames(model);
+    double matrixTime = buildMatrix(model);
+    if (!pass || writeTime < figures.writeTime)
+      figures.writeTime = writeTime;
+    if (!pass || readTime < figures.readTime)
+      figures.readTime = readTime;
+    if (!pass || ioTime < figures.ioTime)
+      figures.ioTime = ioTime;
+    if (!pass || tokenTime < figures.tokenTime)
+      figures.tokenTime = tokenTime;
+    if (!pass || numberTime < figures.numberTime)
+      figures.numberTime = numberTime;
+    if (!pass || hashTime < figures.hashTime)
+      figures.hashTime = hashTime;
+    if (!pass || matrixTime < figures.matrixTime)
+      figures.matrixTime = matrixTime;
+    figures.textBytes = static_cast<double>(text.length());
+    figures.tokens = static_cast<int>(fields.size());
+  }
+  figures.fileBytes = fileSize(file);
+  figures.peakRss = peakRss();
+}
+
+bool compressionAvailable(int compression)
+{
+  switch (compression) {
+  case 1:
+    return CoinFileInput::haveGzipSupport();
+  case 2:
+    return CoinFileInput::haveBzip2Support();
+  case 3:
+    return CoinFileInput::haveZstdSupport();
+  case 4:
+    return CoinFileInput::haveLz4Support();
+  default:
+    return true;
+  }
+}
+
+} // end unnamed namespace
+
+/*
+  Parameters (all optional)
+    -models=file[,file...]  real models (.mps or .lp, may be compressed)
+    -rows=n                 rows of generated model (default 20000)
+    -columns=n              columns of generated model (default 50000)
+    -perColumn=n            elements per generated column (default 5)
+    -formats=list           any of mps,lp (default both)
+    -compress=list          any of none,gzip,bzip2,zstd,lz4 (default
+                            none,gzip,bzip2 - those not built in are skipped)
+    -repeats=n              best of n runs (default 1)
+    -dir=directory          where to write files (default .)
+    -keep                   do not delete written files
+    -csv=file               append figures as comma separated values
+  The generated model is always included. MB/s is uncompressed text read
+  by the real reader per second. The phases (io: decompress into memory,
+  tokens: split at white space, numbers: strtod of numeric fields, hash:
+  add and find all names, matrix: column ordered matrix from triples) are
+  timed separately on the same file and model, so they show where reading
+  time can go rather than adding up to it.
+*/
+int CoinIOBenchmark(std::map<std::string, std::string> &parms)
+{
+  int numberRows = 20000;
+  int numberColumns = 50000;
+  int perColumn = 5;
+  int repeats = 1;
+  if (parms.find("-rows") != parms.end())
+    numberRows = atoi(parms["-rows"].c_str());
+  if (parms.find("-columns") != parms.end())
+    numberColumns = atoi(parms["-columns"].c_str());
+  if (parms.find("-perColumn") != parms.end())
+    perColumn = atoi(parms["-perColumn"].c_str());
+  if (parms.find("-repeats") != parms.end())
+    repeats = atoi(parms["-repeats"].c_str());
+  if (numberRows < 1 || numberColumns < 1 || perColumn < 1 || repeats < 1) {
+    printf("Bad -rows, -columns, -perColumn or -repeats\n");
+    return 1;
+  }
+  std::string formats = "mps,lp";
+  if (parms.find("-formats") != parms.end())
+    formats = parms["-formats"];
+  formats = "," + formats + ",";
+  std::string compress = "none,gzip,bzip2";
+  if (parms.find("-compress") != parms.end())
+    compress = parms["-compress"];
+  compress = "," + compress + ",";
+  std::string dir = ".";
+  if (parms.find("-dir") != parms.end())
+    dir = parms["-dir"];
+  bool keep = parms.find("-keep") != parms.end();
+  // Get models
+  std::vector<benchModel> models(1);
+  generateModel(numberRows, numberColumns, perColumn, models[0]);
+  if (parms.find("-models") != parms.end()) {
+    std::string list = parms["-models"];
+    while (list.length()) {
+      std::string::size_type comma = list.find(',');
+      std::string file = list.substr(0, comma);
+      list = comma == std::string::npos ? "" : list.substr(comma+1);
+      models.push_back(benchModel());
+      benchModel &model = models.back();
+      std::string::size_type slash = file.find_last_of("/\\");
+      model.name = slash == std::string::npos ? file : file.substr(slash+1);
+      if (file.find(".lp") != std::string::npos) {
+	CoinLpIO m;
+	m.messageHandler()->setLogLevel(0);
+	m.readLp(file.c_str());
+	takeModel(m, model);
+      } else {
+	CoinMpsIO m;
+	m.messageHandler()->setLogLevel(0);
+	if (m.readMps(file.c_str(), "")) {
+	  printf("Unable to read model %s\n", file.c_str());
+	  return 1;
+	}
+	takeModel(m, model);
+      }
+    }
+  }
+  FILE *csv = NULL;
+  if (parms.find("-csv") != parms.end()) {
+    csv = fopen(parms["-csv"].c_str(), "a");
+    if (!csv) {
+      printf("Unable to open %s\n", parms["-csv"].c_str());
+      return 1;
+    }
+    fseek(csv, 0, SEEK_END);
+    if (!ftell(csv))
+      fprintf(csv, "model,format,compression,fileBytes,textBytes,fields,"
+	      "write,read,MBps,io,tokens,numbers,hash,matrix,peakRssMB\n");
+  }
+  static const char *compressionName[] = { "none", "gzip", "bzip2", "zstd", "lz4" };
+  for (size_t iModel = 0; iModel < models.size(); iModel++) {
+    const benchModel &model = models[iModel];
+    printf("%s - %d rows, %d columns, %d elements\n", model.name.c_str(),
+	   model.matrix.getNumRows(), model.matrix.getNumCols(),
+	   static_cast<int>(model.matrix.getNumElements()));
+    printf("%-4s %-6s %8s %8s %7s %7s %7s %7s %7s %7s %7s %7s %7s\n",
+	   "fmt", "comp", "file MB", "text MB", "write", "read", "MB/s",
+	   "io", "tokens", "numbers", "hash", "matrix", "rss MB");
+    for (int lp = 0; lp < 2; lp++) {
+      if (formats.find(lp ? ",lp," : ",mps,") == std::string::npos)
+	continue;
+      for (int compression = 0; compression < 5; compression++) {
+	if (compress.find("," + std::string(compressionName[compression]) + ",")
+	    == std::string::npos)
+	  continue;
+	if (!compressionAvailable(compression))
+	  continue;
+	char base[32];
+	sprintf(base, "/coinIOBench%d", static_cast<int>(iModel));
+	std::string file;
+	benchFigures figures;
+	benchFile(model, lp != 0, dir + base, compression, repeats, file,
+		  figures);
+	if (file == "") {
+	  printf("%-4s %-6s unable to write\n", lp ? "lp" : "mps",
+		 compressionName[compression]);
+	  continue;
+	}
+	double mbs = figures.readTime > 0.0
+	  ? figures.textBytes / (1.0e6 * figures.readTime) : 0.0;
+	printf("%-4s %-6s %8.2f %8.2f %7.3f %7.3f %7.1f %7.3f %7.3f %7.3f %7.3f %7.3f %7.1f\n",
+	       lp ? "lp" : "mps", compressionName[compression],
+	       figures.fileBytes * 1.0e-6, figures.textBytes * 1.0e-6,
+	       figures.writeTime, figures.readTime, mbs, figures.ioTime,
+	       figures.tokenTime, figures.numberTime, figures.hashTime,
+	       figures.matrixTime, figures.peakRss);
+	if (csv)
+	  fprintf(csv, "%s,%s,%s,%.0f,%.0f,%d,%g,%g,%g,%g,%g,%g,%g,%g,%g\n",
+		  model.name.c_str(), lp ? "lp" : "mps",
+		  compressionName[compression], figures.fileBytes,
+		  figures.textBytes, figures.tokens, figures.writeTime,
+		  figures.readTime, mbs, figures.ioTime, figures.tokenTime,
+		  figures.numberTime, figures.hashTime, figures.matrixTime,
+		  figures.peakRss);
+	if (!keep)
+	  remove(file.c_str());
+      }
+    }
+  }
+  if (csv)
+    fclose(csv);
+  return 0;
+}
@@ -13,10 +13,15 @@
 #define NO_CHECK_CL
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 #include "CoinFinite.hpp"
 #include "CoinIndexedVector.hpp"
+#include "CoinPermute.hpp"
 #include "CoinShallowPackedVector.hpp"
 
 //--------------------------------------------------------------------------
@@ -527,6 +532,286 @@ CoinIndexedVectorUnitTest()
     assert( add[4] == 40.+40. );
     
   }
+
+  {
+    // Arrays with length are aligned and keep data when extended
+    CoinDoubleArrayWithLength a(100,1);
+    assert( (reinterpret_cast<CoinInt64>(a.array())&63)==0 );
+    a.array()[99]=3.0;
+    a.extend(1000*CoinSizeofAsInt(double));
+    assert( (reinterpret_cast<CoinInt64>(a.array())&63)==0 );
+    assert( a.array()[0]==0.0 && a.array()[99]==3.0 );
+    CoinIntArrayWithLength b;
+    b.switchOn();
+    b.conditionalNew(37);
+    assert( (reinterpret_cast<CoinInt64>(b.array())&63)==0 );
+    CoinArrayWithLength::setHugePageThreshold(1<<20);
+    CoinArrayWithLength c(3<<20,1);
+    assert( (reinterpret_cast<CoinInt64>(c.array())&((1<<21)-1))==0 );
+    CoinArrayWithLength d(c);
+    assert( d.array()[(3<<20)-1]==0 );
+    CoinArrayWithLength::setHugePageThreshold(0);
+  }
+
+  {
+    // Pooled work vectors come back clean
+    CoinIndexedVectorPool pool(2);
+    CoinIndexedVector * first;
+    {
+      CoinIndexedVectorLease work(100,&pool);
+      assert( work->capacity()>=100 && !work->getNumElements() );
+      work->insert(7,1.0);
+      work->insert(99,2.0);
+      first = work.vector();
+    }
+    assert( pool.numberPooled()==1 && pool.numberMisses()==1 );
+    {
+      CoinIndexedVectorLease work(90,&pool);
+      assert( work.vector()==first && pool.numberHits()==1 );
+      assert( !work->getNumElements() && !(*work)[7] && !(*work)[99] );
+      // too big to reuse
+      CoinIndexedVectorLease small(10,&pool);
+      assert( small->capacity()==10 );
+    }
+    assert( pool.numberPooled()==2 );
+    CoinIndexedVectorLease threaded(50);
+    assert( CoinIndexedVectorPool::threadPool()==CoinIndexedVectorPool::threadPool() );
+  }
+
+  {
+    // Partitions scanned, compacted and cleared by several threads
+    CoinPartitionedVector r;
+    r.reserve(1000);
+    int starts[5]={0,250,500,750,1000};
+    r.setPartitions(4,starts);
+    double * dense = r.denseVector();
+    for (int i=0;i<1000;i+=7)
+      dense[i]=i+1.0;
+    dense[3]=1.0e-12;
+    int n = r.scanAll(1.0e-10,4);
+    assert( n==143 && r.getNumElements()==143 );
+    assert( r.getNumElements(1)==36 && r.getIndices()[250]==252 );
+    assert( r.getIndices()[1]==7 && dense[1]==8.0 );
+    r.compact(4);
+    assert( r.getNumElements()==143 && !r.getNumPartitions() );
+    for (int k=0;k<n;k++) {
+      assert( r.getIndices()[k]==7*k );
+      assert( dense[k]==7*k+1.0 );
+    }
+    for (int k=n;k<1000;k++)
+      assert( !dense[k] );
+    r.clearAndReset();
+    r.setPartitions(4,starts);
+    dense[999]=5.0;
+    dense[0]=1.0;
+    r.scanAll(0.0,3);
+    r.clearAndKeep(3);
+    r.checkClear();
+  }
+
+  {
+    // Occupancy bitmap
+    CoinIndexedVector r(1000);
+    r.insert(700,1.0);
+    r.setBitmap(true);
+    assert( r.hasBitmap() && (r.bitmap()[10]>>60)==1 );
+    for (int i=999;i>=0;i-=5)
+      r.quickAdd(i,i+1.0);
+    r.add(3,-4.0);
+    r.sort();
+    assert( r.getNumElements()==202 );
+    for (int k=1;k<r.getNumElements();k++)
+      assert( r.getIndices()[k-1]<r.getIndices()[k] );
+    assert( r.getIndices()[0]==3 && r.getIndices()[1]==4 );
+    assert( r[700]==1.0 && r[704]==705.0 );
+    // written directly
+    double * dense = r.denseVector();
+    dense[0]=1.0;
+    r.markIndex(0);
+    dense[4]=1.0e-12;
+    assert( r.scanBitmap(1.0e-10)==202 && r.getIndices()[0]==0 );
+    assert( !dense[4] );
+    r.reserve(2000);
+    r.insert(1999,1.0);
+    r.clear();
+    r.checkClear();
+    for (int k=0;k<(2000+63)/64;k++)
+      assert( !r.bitmap()[k] );
+    r.setBitmap(false);
+    assert( !r.hasBitmap() );
+  }
+
+  {
+    // Fused dot products and axpy
+    CoinIndexedVector r(1000);
+    double a[5][1000];
+    for (int j=0;j<1000;j++) {
+      for (int k=0;k<5;k++)
+	a[k][j]=(j%(k+3))-1.0;
+      if (j%3==0)
+	r.insert(j,0.5*j+1.0);
+    }
+    const double * arrays[5]={a[0],a[1],a[2],a[3],a[4]};
+    double result[5];
+    for (int pass=0;pass<2;pass++) {
+      r.dotProducts(5,arrays,result);
+      for (int k=0;k<5;k++) {
+	double sum=0.0;
+	for (int j=0;j<1000;j+=3)
+	  sum += (0.5*j+1.0)*a[k][j];
+	assert( fabs(result[k]-sum)<1.0e-8*(1.0+fabs(sum)) );
+      }
+      double dot = r.axpyDot(2.0,a[0],a[0]);
+      assert( fabs(dot-result[0])<1.0e-8*(1.0+fabs(dot)) );
+      for (int j=0;j<1000;j+=3)
+	assert( a[0][j]==(j%3)+1.0+j );
+      for (int j=0;j<1000;j+=3)
+	a[0][j]-=j+2.0;
+      // again packed
+      r.cleanAndPack(0.0);
+    }
+  }
+
+  {
+    // Largest few (heap) and many (nth_element), weighted and partitioned
+    CoinPartitionedVector r;
+    r.reserve(2000);
+    int starts[5]={0,500,1000,1500,2000};
+    r.setPartitions(4,starts);
+    double * dense = r.denseVector();
+    double values[2000];
+    double weights[2000];
+    for (int i=0;i<2000;i++) {
+      values[i]=((i*37)%2000)*((i&1)!=0 ? -1.0 : 1.0);
+      dense[i]=values[i];
+      weights[i]=1.0+(i%3);
+    }
+    r.scanAll();
+    int which[1990];
+    std::vector<std::pair<double,int> > all;
+    for (int pass=1;pass>=0;pass--) {
+      const double * w = pass ? weights : NULL;
+      all.clear();
+      for (int i=0;i<2000;i++) {
+	double score = w ? values[i]*values[i]/w[i] : fabs(values[i]);
+	if (score>10.0)
+	  all.push_back(std::make_pair(-score,i));
+      }
+      std::sort(all.begin(),all.end());
+      for (int number=5;number<=1990;number+=1985) {
+	int n = r.selectLargest(number,which,w,10.0,3);
+	assert( n==CoinMin(number,static_cast<int>(all.size())) );
+	for (int k=0;k<n;k++)
+	  assert( which[k]==all[k].second );
+      }
+    }
+    // and not partitioned
+    r.compact();
+    assert( r.selectLargest(5,which)==5 );
+    for (int k=0;k<5;k++)
+      assert( which[k]==all[k].second );
+    assert( !r.selectLargest(0,which) );
+    r.clear();
+  }
+
+  {
+    // Changing mode keeps values (positions overlap when packed)
+    CoinIndexedVector r(100);
+    r.setBitmap(true);
+    r.insert(2,3.0);
+    r.insert(0,1.0);
+    r.insert(1,2.0);
+    r.insert(60,-4.0);
+    r.makePacked();
+    assert( r.packedMode() && r.getNumElements()==4 );
+    const double * packed = r.denseVector();
+    const int * index = r.getIndices();
+    for (int i=0;i<4;i++)
+      assert( packed[i]==(index[i]==60 ? -4.0 : index[i]+1.0) );
+    assert( !packed[60] );
+    r.makeUnpacked();
+    assert( !r.packedMode() && r.getNumElements()==4 );
+    assert( r[0]==1.0 && r[1]==2.0 && r[2]==3.0 && r[60]==-4.0 );
+    assert( !r[3] );
+    // sparse goes packed, dense unpacked
+    r.adaptMode();
+    assert( r.packedMode() );
+    r.makeUnpacked();
+    for (int i=3;i<60;i++)
+      r.quickAdd(i,1.0);
+    r.makePacked();
+    r.adaptMode();
+    assert( !r.packedMode() && r[60]==-4.0 && r[10]==1.0 );
+    r.clear();
+    r.checkClear();
+  }
+
+  {
+    // Permute through a reversal (long enough for vector code)
+    const int n=100;
+    int permute[n];
+    int index[n];
+    double in[n];
+    double out[n];
+    for (int i=0;i<n;i++) {
+      permute[i]=n-1-i;
+      index[i]=(7*i)%n;
+      in[i]=0.0;
+      out[i]=0.0;
+    }
+    int number=50;
+    for (int j=0;j<number;j++)
+      in[index[j]]=j-20.0;
+    int outIndex[n];
+    int firstLast[2]={n,0};
+    CoinPermuteScatter(permute,index,number,in,false,out,outIndex,NULL,
+		       firstLast);
+    int first=n;
+    int last=0;
+    for (int j=0;j<number;j++) {
+      int k=permute[index[j]];
+      assert( outIndex[j]==k && out[k]==j-20.0 );
+      first=CoinMin(first,k);
+      last=CoinMax(last,k);
+    }
+    assert( firstLast[0]==first && firstLast[1]==last );
+    for (int i=0;i<n;i++)
+      assert( !in[i] );
+    // and back packed, dropping zero
+    int back[n];
+    for (int i=0;i<n;i++)
+      back[permute[i]]=i;
+    int kept=CoinPermuteGather(back,outIndex,number,out,in,true,index,
+			       0.5,1);
+    assert( kept==number-1 );
+    for (int j=0;j<kept;j++)
+      assert( in[j]==(j<20 ? j-20.0 : j-19.0) );
+    for (int i=0;i<n;i++)
+      assert( !out[i] );
+  }
+
+#if COIN_HAS_MOVE
+  {
+    // Moving takes the arrays (so also in std::vector)
+    CoinIndexedVector source(100);
+    source.insert(3,1.5);
+    source.insert(70,-2.0);
+    source.setBitmap(true);
+    const double * dense = source.denseVector();
+    CoinIndexedVector moved(std::move(source));
+    assert( moved.denseVector()==dense && moved.getNumElements()==2 );
+    assert( moved[70]==-2.0 && moved.hasBitmap() );
+    assert( !source.getNumElements() && !source.capacity() );
+    source = std::move(moved);
+    assert( source.denseVector()==dense && source[3]==1.5 );
+    std::vector<CoinIndexedVector> vectors;
+    vectors.push_back(std::move(source));
+    vectors.push_back(CoinIndexedVector(10));
+    assert( vectors[0].denseVector()==dense && vectors[1].capacity()==10 );
+    vectors[0].clear();
+    assert( !vectors[0].getNumElements() );
+  }
+#endif
   
 }
     
@@ -0,0 +1,120 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstring>
+#include <string>
+
+#include "CoinPragma.hpp"
+#include "CoinInstrument.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+namespace {
+
+const int numberThreads = 4;
+const int numberCounts = 1000;
+
+void *countInThread(void *info)
+{
+  const int id = *static_cast<int *>(info);
+  for (int i = 0; i < numberCounts; i++)
+    CoinInstrument::add(id);
+  return NULL;
+}
+
+}	// end file-local namespace
+
+void CoinInstrumentUnitTest()
+{
+  // names
+  const int countId = CoinInstrument::registerName("test.instrument.count");
+  const int timeId = CoinInstrument::registerName("test.instrument.time", true);
+  assert (countId > 0 && timeId > 0 && countId != timeId);
+  assert (CoinInstrument::registerName("test.instrument.count") == countId);
+  assert (!strcmp(CoinInstrument::name(countId), "test.instrument.count"));
+  assert (!strcmp(CoinInstrument::name(0), "instrument.overflow"));
+  assert (!CoinInstrument::name(-1));
+  assert (!CoinInstrument::name(CoinInstrument::numberNames()));
+  assert (CoinInstrument::numberNames() > timeId);
+
+  CoinInstrument::reset();
+  CoinUInt64 count;
+  double seconds;
+  CoinInstrument::add(countId);
+  CoinInstrument::add(countId, 4);
+  CoinInstrument::totals(countId, count, seconds);
+  assert (count == 5 && seconds == 0.0);
+  CoinInstrument::addTime(timeId, 0);
+  {
+    CoinInstrumentTimer timer(timeId);
+    volatile double sum = 0.0;
+    for (int i = 0; i < 100000; i++)
+      sum = sum + i;
+  }
+  CoinInstrument::totals(timeId, count, seconds);
+  assert (count == 2 && seconds >= 0.0);
+
+  // reports
+  std::string json;
+  CoinInstrument::report(json);
+  assert (json[0] == '{' && json[json.size() - 1] == '}');
+  assert (json.find("\"test.instrument.count\":{\"count\":5}") != std::string::npos);
+  assert (json.find("\"test.instrument.time\":{\"count\":2,\"seconds\":") != std::string::npos);
+  std::string prometheus;
+  CoinInstrument::report(prometheus, CoinInstrumentPrometheus, "lp");
+  assert (prometheus.find("# TYPE lp_test_instrument_count_total counter\n"
+			  "lp_test_instrument_count_total 5\n") != std::string::npos);
+  assert (prometheus.find("lp_test_instrument_time_total 2\n") != std::string::npos);
+  assert (prometheus.find("# TYPE lp_test_instrument_time_seconds_total counter\n")
+	  != std::string::npos);
+  // no seconds for a plain counter
+  assert (prometheus.find("lp_test_instrument_count_seconds") == std::string::npos);
+
+  // reset - nothing reported
+  CoinInstrument::reset();
+  CoinInstrument::totals(countId, count, seconds);
+  assert (!count);
+  json.clear();
+  CoinInstrument::report(json);
+  assert (json.find("test.instrument") == std::string::npos);
+
+  // macros
+#ifndef COIN_NO_INSTRUMENT
+  for (int i = 0; i < 3; i++) {
+    COIN_COUNT("test.instrument.count");
+    COIN_COUNT_ADD("test.instrument.count", 2);
+    COIN_TIME_SCOPE("test.instrument.time");
+  }
+  CoinInstrument::totals(countId, count, seconds);
+  assert (count == 9);
+  CoinInstrument::totals(timeId, count, seconds);
+  assert (count == 3);
+#endif
+
+  // slots of each thread summed, and kept after it ends
+#ifdef COINUTILS_PTHREADS
+  CoinInstrument::reset();
+  int id = countId;
+  pthread_t threads[numberThreads];
+  for (int i = 0; i < numberThreads; i++)
+    pthread_create(threads + i, NULL, countInThread, &id);
+  for (int i = 0; i < numberThreads; i++)
+    pthread_join(threads[i], NULL);
+  CoinInstrument::totals(countId, count, seconds);
+  assert (count == numberThreads * numberCounts);
+#else
+  int id = countId;
+  CoinInstrument::reset();
+  countInThread(&id);
+  CoinInstrument::totals(countId, count, seconds);
+  assert (count == numberCounts);
+#endif
+  CoinInstrument::reset();
+}
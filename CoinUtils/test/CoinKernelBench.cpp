@@ -0,0 +1,557 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Times vector, matrix and sort kernels over a range of sizes and
+// densities, writes the figures as comma separated values and compares
+// them with figures saved from an earlier run.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinPackedVector.hpp"
+#include "CoinShallowPackedVector.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinPackedMatrixProduct.hpp"
+#include "CoinSort.hpp"
+
+namespace {
+
+/** A kernel to be timed.  run() is called repeatedly and must leave
+    things as it found them (kernels which change their data restore it
+    within run(); the cost of that is part of the figure). */
+class benchKernel {
+public:
+  virtual ~benchKernel() {}
+  virtual void run() = 0;
+};
+
+// Seconds per call of kernel: batches are doubled until one takes
+// minimumTime, and the best of three such batches is kept
+double timeKernel(benchKernel &kernel, double minimumTime, int &calls)
+{
+  kernel.run(); // warm up
+  double best = COIN_DBL_MAX;
+  calls = 1;
+  for (int trial = 0; trial < 3; trial++) {
+    while (true) {
+      double time1 = CoinWallclockTime();
+      for (int i = 0; i < calls; i++)
+	kernel.run();
+      double time = CoinWallclockTime() - time1;
+      if (time >= minimumTime || calls >= (1 << 30)) {
+	best = CoinMin(best, time / calls);
+	break;
+      }
+      calls *= 2;
+    }
+  }
+  return best;
+}
+
+// Distinct random indices in [0,size)
+void randomIndices(CoinThreadRandom &random, int size, int number,
+		   std::vector<int> &indices)
+{
+  std::vector<char> used(size, 0);
+  indices.clear();
+  while (static_cast<int>(indices.size()) < number) {
+    int i = static_cast<int>(random.randomDouble() * size);
+    if (i < size && !used[i]) {
+      used[i] = 1;
+      indices.push_back(i);
+    }
+  }
+}
+
+//-------------------------------------------------------------------
+// CoinIndexedVector
+
+class indexedScan : public benchKernel {
+public:
+  indexedScan(const std::vector<int> &indices, int size)
+    : vector_(size)
+  {
+    double *dense = vector_.denseVector();
+    for (size_t i = 0; i < indices.size(); i++)
+      dense[indices[i]] = 1.0 + i;
+  }
+  void run()
+  {
+    vector_.setNumElements(0);
+    vector_.scan();
+  }
+  CoinIndexedVector vector_;
+};
+
+class indexedClean : public benchKernel {
+public:
+  indexedClean(const std::vector<int> &indices, int size)
+    : vector_(static_cast<int>(indices.size()), &indices[0], 1.0)
+  {
+    vector_.reserve(size);
+  }
+  // Nothing is below the tolerance so nothing changes
+  void run() { vector_.clean(1.0e-12); }
+  CoinIndexedVector vector_;
+};
+
+class indexedSort : public benchKernel {
+public:
+  indexedSort(const std::vector<int> &indices, int size)
+    : vector_(static_cast<int>(indices.size()), &indices[0], 1.0)
+    , original_(indices)
+  {
+    vector_.reserve(size);
+  }
+  void run()
+  {
+    CoinMemcpyN(&original_[0], static_cast<int>(original_.size()),
+		vector_.getIndices());
+    vector_.sortIncrIndex();
+  }
+  CoinIndexedVector vector_;
+  std::vector<int> original_;
+};
+
+class indexedAppend : public benchKernel {
+public:
+  indexedAppend(const std::vector<int> &indices, int size)
+    : vector_(size)
+    , caboose_(static_cast<int>(indices.size()), &indices[0], 1.0)
+  {
+    caboose_.reserve(size);
+  }
+  void run()
+  {
+    vector_.clear();
+    vector_.append(caboose_);
+  }
+  CoinIndexedVector vector_;
+  CoinIndexedVector caboose_;
+};
+
+//-------------------------------------------------------------------
+// CoinPackedVector
+
+class packedAdd : public benchKernel {
+public:
+  packedAdd(const std::vector<int> &first, const std::vector<int> &second)
+  {
+    std::vector<double> elements(first.size(), 1.0);
+    a_.setVector(static_cast<int>(first.size()), &first[0], &elements[0]);
+    elements.assign(second.size(), 2.0);
+    b_.setVector(static_cast<int>(second.size()), &second[0], &elements[0]);
+  }
+  void run()
+  {
+    CoinPackedVector sum = a_ + b_;
+    sink_ = sum.getNumElements();
+  }
+  CoinPackedVector a_;
+  CoinPackedVector b_;
+  int sink_;
+};
+
+class packedDot : public benchKernel {
+public:
+  packedDot(const std::vector<int> &indices, int size)
+    : dense_(size, 0.5)
+    , sink_(0.0)
+  {
+    std::vector<double> elements(indices.size(), 1.5);
+    vector_.setVector(static_cast<int>(indices.size()), &indices[0],
+		      &elements[0]);
+  }
+  void run() { sink_ += vector_.dotProduct(&dense_[0]); }
+  CoinPackedVector vector_;
+  std::vector<double> dense_;
+  double sink_;
+};
+
+class packedNorms : public benchKernel {
+public:
+  packedNorms(const std::vector<int> &indices)
+    : sink_(0.0)
+  {
+    std::vector<double> elements(indices.size());
+    for (size_t i = 0; i < elements.size(); i++)
+      elements[i] = (i & 1) ? -1.0 - i : 1.0 + i;
+    vector_.setVector(static_cast<int>(indices.size()), &indices[0],
+		      &elements[0]);
+  }
+  void run()
+  {
+    sink_ += vector_.oneNorm() + vector_.twoNorm() + vector_.infNorm();
+  }
+  CoinPackedVector vector_;
+  double sink_;
+};
+
+//-------------------------------------------------------------------
+// CoinPackedMatrix
+
+class matrixTimes : public benchKernel {
+public:
+  matrixTimes(const CoinPackedMatrix &matrix, bool transpose)
+    : matrix_(matrix)
+    , transpose_(transpose)
+    , x_(transpose ? matrix.getNumRows() : matrix.getNumCols(), 1.0)
+    , y_(transpose ? matrix.getNumCols() : matrix.getNumRows(), 0.0)
+  {
+  }
+  void run()
+  {
+    if (transpose_)
+      matrix_.transposeTimes(&x_[0], &y_[0]);
+    else
+      matrix_.times(&x_[0], &y_[0]);
+  }
+  const CoinPackedMatrix &matrix_;
+  bool transpose_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+};
+
+// Eight interleaved vectors at once (deterministic, so both gather)
+class matrixBatch : public benchKernel {
+public:
+  matrixBatch(const CoinPackedMatrix &matrix, bool transpose)
+    : product_(matrix, 1, true)
+    , transpose_(transpose)
+    , x_(8 * (transpose ? matrix.getNumRows() : matrix.getNumCols()), 1.0)
+    , y_(8 * (transpose ? matrix.getNumCols() : matrix.getNumRows()), 0.0)
+  {
+  }
+  void run()
+  {
+    if (transpose_)
+      product_.transposeTimesBatch(8, &x_[0], &y_[0]);
+    else
+      product_.timesBatch(8, &x_[0], &y_[0]);
+  }
+  CoinPackedMatrixProduct product_;
+  bool transpose_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+};
+
+class matrixReverse : public benchKernel {
+public:
+  matrixReverse(const CoinPackedMatrix &matrix)
+    : matrix_(matrix)
+  {
+  }
+  void run() { copy_.reverseOrderedCopyOf(matrix_); }
+  const CoinPackedMatrix &matrix_;
+  CoinPackedMatrix copy_;
+};
+
+// Appends all rows of matrix to an empty column ordered matrix
+class matrixAppendRows : public benchKernel {
+public:
+  matrixAppendRows(const CoinPackedMatrix &matrix)
+  {
+    rowCopy_.reverseOrderedCopyOf(matrix);
+    numberColumns_ = matrix.getNumCols();
+    int numberRows = rowCopy_.getNumRows();
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      CoinBigIndex start = rowCopy_.getVectorFirst(iRow);
+      rows_.push_back(new CoinShallowPackedVector(
+	rowCopy_.getVectorSize(iRow), rowCopy_.getIndices() + start,
+	rowCopy_.getElements() + start, false));
+    }
+  }
+  ~matrixAppendRows()
+  {
+    for (size_t i = 0; i < rows_.size(); i++)
+      delete rows_[i];
+  }
+  void run()
+  {
+    CoinPackedMatrix matrix(true, 0, 0);
+    matrix.setDimensions(0, numberColumns_);
+    matrix.appendRows(static_cast<int>(rows_.size()), &rows_[0]);
+  }
+  CoinPackedMatrix rowCopy_;
+  int numberColumns_;
+  std::vector<const CoinPackedVectorBase *> rows_;
+};
+
+//-------------------------------------------------------------------
+// CoinSort
+
+class sortPairs : public benchKernel {
+public:
+  sortPairs(CoinThreadRandom &random, int size)
+    : original_(size)
+    , key_(size)
+    , value_(size)
+  {
+    for (int i = 0; i < size; i++)
+      original_[i] = random.randomDouble();
+  }
+  void run()
+  {
+    int size = static_cast<int>(original_.size());
+    CoinMemcpyN(&original_[0], size, &key_[0]);
+    CoinIotaN(&value_[0], size, 0);
+    CoinSort_2(&key_[0], &key_[0] + size, &value_[0]);
+  }
+  std::vector<double> original_;
+  std::vector<double> key_;
+  std::vector<int> value_;
+};
+
+//-------------------------------------------------------------------
+
+/// Times kernels and writes (and compares) the figures
+class benchRunner {
+public:
+  benchRunner(double minimumTime, double tolerance,
+	      const std::map<std::string, double> &baseline, FILE *save)
+    : minimumTime_(minimumTime)
+    , tolerance_(tolerance)
+    , baseline_(baseline)
+    , save_(save)
+    , numberSlower_(0)
+  {
+    printf("kernel,size,density,calls,nanoseconds%s\n",
+	   baseline_.size() ? ",baseline,ratio,status" : "");
+    if (save_)
+      fprintf(save_, "kernel,size,density,calls,nanoseconds\n");
+  }
+  void time(const char *name, int size, double density, benchKernel &kernel)
+  {
+    int calls;
+    double nanoseconds = 1.0e9 * timeKernel(kernel, minimumTime_, calls);
+    char key[200];
+    sprintf(key, "%s,%d,%g", name, size, density);
+    printf("%s,%d,%.1f", key, calls, nanoseconds);
+    std::map<std::string, double>::const_iterator found = baseline_.find(key);
+    if (found != baseline_.end()) {
+      double ratio = found->second > 0.0 ? nanoseconds / found->second : 1.0;
+      bool slower = ratio > tolerance_;
+      printf(",%.1f,%.3f,%s", found->second, ratio, slower ? "SLOWER" : "ok");
+      if (slower)
+	numberSlower_++;
+    } else if (baseline_.size()) {
+      printf(",,,new");
+    }
+    printf("\n");
+    fflush(stdout);
+    if (save_)
+      fprintf(save_, "%s,%d,%.1f\n", key, calls, nanoseconds);
+  }
+  inline int numberSlower() const { return numberSlower_; }
+
+private:
+  double minimumTime_;
+  double tolerance_;
+  const std::map<std::string, double> &baseline_;
+  FILE *save_;
+  int numberSlower_;
+};
+
+// Fills list from comma separated numbers
+void parseList(const std::string &text, std::vector<double> &list)
+{
+  list.clear();
+  std::string rest = text;
+  while (rest.length()) {
+    std::string::size_type comma = rest.find(',');
+    list.push_back(atof(rest.substr(0, comma).c_str()));
+    rest = comma == std::string::npos ? "" : rest.substr(comma+1);
+  }
+}
+
+// Reads kernel,size,density -> nanoseconds from a saved file
+bool readBaseline(const char *file, std::map<std::string, double> &baseline)
+{
+  FILE *fp = fopen(file, "r");
+  if (!fp)
+    return false;
+  char line[512];
+  while (fgets(line, sizeof(line), fp)) {
+    std::string text(line);
+    std::string::size_type comma1 = text.find(',');
+    std::string::size_type comma2 = comma1 == std::string::npos
+      ? comma1 : text.find(',', comma1+1);
+    std::string::size_type comma3 = comma2 == std::string::npos
+      ? comma2 : text.find(',', comma2+1);
+    std::string::size_type comma4 = comma3 == std::string::npos
+      ? comma3 : text.find(',', comma3+1);
+    if (comma4 == std::string::npos || text.substr(0, comma1) == "kernel")
+      continue;
+    baseline[text.substr(0, comma3)] = atof(text.c_str() + comma4 + 1);
+  }
+  fclose(fp);
+  return true;
+}
+
+} // end unnamed namespace
+
+/*
+  Parameters (all optional)
+    -sizes=n[,n...]         vector lengths and sort sizes
+                            (default 1000,100000,1000000)
+    -densities=d[,d...]     fraction of entries nonzero
+                            (default 0.001,0.01,0.1)
+    -matrixSizes=n[,n...]   rows and columns of square matrices
+                            (default 1000,10000,100000)
+    -maxElements=n          skip matrices with more elements (10000000)
+    -time=seconds           least time of a timed batch (default 0.05)
+    -save=file              write figures to file (for use as -baseline)
+    -baseline=file          compare with figures written by -save
+    -tolerance=r            ratio to baseline reported as SLOWER (1.25)
+  Output is comma separated values on stdout: kernel, size, density (0
+  for kernels not depending on it), calls in the timed batch and
+  nanoseconds per call, followed with -baseline by the baseline figure,
+  the ratio and ok, SLOWER or new. The return code is 2 if any kernel
+  was SLOWER.
+*/
+int CoinKernelBenchmark(std::map<std::string, std::string> &parms)
+{
+  std::vector<double> sizes;
+  std::vector<double> densities;
+  std::vector<double> matrixSizes;
+  parseList(parms.find("-sizes") != parms.end() ? parms["-sizes"]
+	    : "1000,100000,1000000", sizes);
+  parseList(parms.find("-densities") != parms.end() ? parms["-densities"]
+	    : "0.001,0.01,0.1", densities);
+  parseList(parms.find("-matrixSizes") != parms.end() ? parms["-matrixSizes"]
+	    : "1000,10000,100000", matrixSizes);
+  double maxElements = 1.0e7;
+  double minimumTime = 0.05;
+  double tolerance = 1.25;
+  if (parms.find("-maxElements") != parms.end())
+    maxElements = atof(parms["-maxElements"].c_str());
+  if (parms.find("-time") != parms.end())
+    minimumTime = atof(parms["-time"].c_str());
+  if (parms.find("-tolerance") != parms.end())
+    tolerance = atof(parms["-tolerance"].c_str());
+  std::map<std::string, double> baseline;
+  if (parms.find("-baseline") != parms.end()) {
+    if (!readBaseline(parms["-baseline"].c_str(), baseline)) {
+      fprintf(stderr, "Unable to read %s\n", parms["-baseline"].c_str());
+      return 1;
+    }
+  }
+  FILE *save = NULL;
+  if (parms.find("-save") != parms.end()) {
+    save = fopen(parms["-save"].c_str(), "w");
+    if (!save) {
+      fprintf(stderr, "Unable to open %s\n", parms["-save"].c_str());
+      return 1;
+    }
+  }
+  benchRunner runner(minimumTime, tolerance, baseline, save);
+  CoinThreadRandom random(1234567);
+  for (size_t iSize = 0; iSize < sizes.size(); iSize++) {
+    int size = static_cast<int>(sizes[iSize]);
+    if (size < 1)
+      continue;
+    for (size_t iDensity = 0; iDensity < densities.size(); iDensity++) {
+      double density = densities[iDensity];
+      int number = CoinMax(1, CoinMin(size, static_cast<int>(density * size)));
+      std::vector<int> indices;
+      std::vector<int> other;
+      randomIndices(random, size, number, indices);
+      randomIndices(random, size, number, other);
+      {
+	indexedScan kernel(indices, size);
+	runner.time("indexed.scan", size, density, kernel);
+      }
+      {
+	indexedClean kernel(indices, size);
+	runner.time("indexed.clean", size, density, kernel);
+      }
+      {
+	indexedSort kernel(indices, size);
+	runner.time("indexed.sort", size, density, kernel);
+      }
+      {
+	indexedAppend kernel(indices, size);
+	runner.time("indexed.append", size, density, kernel);
+      }
+      {
+	packedAdd kernel(indices, other);
+	runner.time("packed.add", size, density, kernel);
+      }
+      {
+	packedDot kernel(indices, size);
+	runner.time("packed.dot", size, density, kernel);
+      }
+      {
+	packedNorms kernel(indices);
+	runner.time("packed.norms", size, density, kernel);
+      }
+    }
+    sortPairs kernel(random, size);
+    runner.time("sort.CoinSort_2", size, 0.0, kernel);
+  }
+  for (size_t iSize = 0; iSize < matrixSizes.size(); iSize++) {
+    int size = static_cast<int>(matrixSizes[iSize]);
+    if (size < 1)
+      continue;
+    for (size_t iDensity = 0; iDensity < densities.size(); iDensity++) {
+      double density = densities[iDensity];
+      int perColumn = CoinMax(1, CoinMin(size, static_cast<int>(density * size)));
+      if (static_cast<double>(perColumn) * size > maxElements)
+	continue;
+      std::vector<CoinBigIndex> start(size+1);
+      std::vector<int> row;
+      std::vector<double> element;
+      std::vector<int> indices;
+      for (int iColumn = 0; iColumn < size; iColumn++) {
+	start[iColumn] = static_cast<CoinBigIndex>(row.size());
+	randomIndices(random, size, perColumn, indices);
+	std::sort(indices.begin(), indices.end());
+	for (int k = 0; k < perColumn; k++) {
+	  row.push_back(indices[k]);
+	  element.push_back(2.0 * random.randomDouble() - 1.0);
+	}
+      }
+      start[size] = static_cast<CoinBigIndex>(row.size());
+      CoinPackedMatrix matrix(true, size, size, start[size], &element[0],
+			      &row[0], &start[0], NULL);
+      {
+	matrixTimes kernel(matrix, false);
+	runner.time("matrix.times", size, density, kernel);
+      }
+      {
+	matrixTimes kernel(matrix, true);
+	runner.time("matrix.transposeTimes", size, density, kernel);
+      }
+      {
+	matrixBatch kernel(matrix, false);
+	runner.time("matrix.timesBatch8", size, density, kernel);
+      }
+      {
+	matrixBatch kernel(matrix, true);
+	runner.time("matrix.transposeTimesBatch8", size, density, kernel);
+      }
+      {
+	matrixReverse kernel(matrix);
+	runner.time("matrix.reverseOrderedCopyOf", size, density, kernel);
+      }
+      {
+	matrixAppendRows kernel(matrix);
+	runner.time("matrix.appendRows", size, density, kernel);
+      }
+    }
+  }
+  if (save)
+    fclose(save);
+  return runner.numberSlower() ? 2 : 0;
+}
@@ -14,10 +14,51 @@
 #include <cassert>
 
 #include "CoinLpIO.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinError.hpp"
 #include "CoinFloatEqual.hpp"
 #include <string.h>
 //#############################################################################
 
+// Source giving the file after test:// a few bytes at a time (as a slow
+// server might)
+class CoinLpIoTestSource : public CoinFileSource {
+public:
+   CoinLpIoTestSource(const std::string & fileName) {
+      FILE * fp = fopen(fileName.c_str(), "rb");
+      assert( fp );
+      char buffer[1024];
+      size_t n;
+      while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+         data_.append(buffer, n);
+      fclose(fp);
+   }
+   virtual CoinInt64 size() { return data_.size(); }
+   virtual int readRange(CoinInt64 offset, void * buffer, int size) {
+      CoinInt64 n = static_cast<CoinInt64>(data_.size()) - offset;
+      if (n > 7)
+         n = 7;
+      if (n > size)
+         n = size;
+      if (n <= 0)
+         return 0;
+      memcpy(buffer, data_.c_str() + offset, static_cast<size_t>(n));
+      return static_cast<int>(n);
+   }
+private:
+   std::string data_;
+};
+
+static CoinFileSource * openLpIoTestSource(const std::string & name)
+{
+   return new CoinLpIoTestSource(name.substr(7));
+}
+
+static CoinFileSource * openLpIoMissingSource(const std::string &)
+{
+   return NULL;
+}
+
 //--------------------------------------------------------------------------
 // test import methods
 void
@@ -66,16 +107,14 @@ CoinLpIOUnitTest(const std::string& lpDir)
                assert(!strcmp(im.names_[1][i], imC1.names_[1][i]));
             }
 
-            for (int i = 0; i < im.maxHash_[0]; i++) {
-               // check hash value for row name
-               assert(im.hash_[0][i].next  == imC1.hash_[0][i].next);
-               assert(im.hash_[0][i].index == imC1.hash_[0][i].index);
+            for (int i = 0; i < im.numberHash_[0]; i++) {
+               // check hash lookup for row name
+               assert(imC1.findHash(im.names_[0][i], 0) == i);
             }
 
-            for (int i = 0; i < im.maxHash_[1]; i++) {
-               // check hash value for column name
-               assert(im.hash_[1][i].next == imC1.hash_[1][i].next);
-               assert(im.hash_[1][i].index == imC1.hash_[1][i].index);
+            for (int i = 0; i < im.numberHash_[1]; i++) {
+               // check hash lookup for column name
+               assert(imC1.findHash(im.names_[1][i], 1) == i);
             }
 
             CoinLpIO imC2(im);
@@ -95,16 +134,14 @@ CoinLpIOUnitTest(const std::string& lpDir)
                assert(!strcmp(lhs.names_[1][i], imC2.names_[1][i]));
             }
 
-            for (int i = 0; i < imC2.maxHash_[0]; i++) {
-               // check hash value for row name
-               assert(lhs.hash_[0][i].next  == imC2.hash_[0][i].next);
-               assert(lhs.hash_[0][i].index == imC2.hash_[0][i].index);
+            for (int i = 0; i < imC2.numberHash_[0]; i++) {
+               // check hash lookup for row name
+               assert(lhs.findHash(imC2.names_[0][i], 0) == i);
             }
 
-            for (int i = 0; i < im.maxHash_[1]; i++) {
-               // check hash value for column name
-               assert(lhs.hash_[1][i].next == imC2.hash_[1][i].next);
-               assert(lhs.hash_[1][i].index == imC2.hash_[1][i].index);
+            for (int i = 0; i < imC2.numberHash_[1]; i++) {
+               // check hash lookup for column name
+               assert(lhs.findHash(imC2.names_[1][i], 1) == i);
             }
          }
          // Test that lhs has correct values even though rhs has gone out of scope
@@ -362,4 +399,180 @@ CoinLpIOUnitTest(const std::string& lpDir)
          }
       }
    }
+   // Read through buffered tokens - comments, split signs and compressed
+   // (decompressing ahead on another thread if possible, and on the
+   // second round written by a background thread with a flush midway)
+   {
+      const char * text =
+         "\\ comment before objective\n"
+         "Maximize\n obj: 2 x + - 3 y -z\n"
+         "Subject To\n"
+         " c1: x + y / comment after row\n  + z <= 4\n"
+         " c2: -1.5\tx\n >= -2\n"
+         "Bounds\n z free\nGenerals\n y\nEnd";
+      CoinFileOutput::Compression compress[5] =
+         { CoinFileOutput::COMPRESS_NONE, CoinFileOutput::COMPRESS_GZIP,
+           CoinFileOutput::COMPRESS_BZIP2, CoinFileOutput::COMPRESS_ZSTD,
+           CoinFileOutput::COMPRESS_LZ4 };
+      for (int iPass = 0; iPass < 10; iPass++) {
+         if (!CoinFileOutput::compressionSupported(compress[iPass%5]))
+            continue;
+         CoinFileOutput * output;
+         if (iPass < 5) {
+            output = CoinFileOutput::create("CoinLpIoTokens.lp",
+                                            compress[iPass%5]);
+            output->puts(text);
+         } else {
+            output = CoinFileOutput::createAsync("CoinLpIoTokens.lp",
+                                                 compress[iPass%5]);
+            int half = static_cast<int>(strlen(text)/2);
+            assert( output->write(text, half) == half );
+            assert( output->flush() );
+            assert( output->puts(text + half) );
+         }
+         assert( output->close() );
+         assert( output->write(text, 1) == 0 );
+         delete output;
+         // whole file comes back in place
+         CoinFileInput * input = CoinFileInput::create("CoinLpIoTokens.lp");
+         size_t total = 0;
+         size_t length;
+         while (input->readChunk(length))
+            total += length;
+         delete input;
+         assert( total == strlen(text) );
+         CoinLpIO m;
+         m.messageHandler()->setLogLevel(0);
+         m.setNumberThreads(1 + iPass/5);
+         m.readLp("CoinLpIoTokens.lp");
+         assert( m.getNumCols() == 3 );
+         assert( m.getNumRows() == 2 );
+         assert( !strcmp(m.columnName(1), "y") );
+         assert( !strcmp(m.rowName(1), "c2") );
+         const double * obj = m.getObjCoefficients();
+         assert( obj[0] == -2.0 && obj[1] == 3.0 && obj[2] == 1.0 );
+         assert( m.getRowUpper()[0] == 4.0 );
+         assert( m.getRowLower()[1] == -2.0 );
+         assert( m.getMatrixByRow()->getNumElements() == 4 );
+         assert( m.getMatrixByRow()->getCoefficient(1, 0) == -1.5 );
+         assert( m.getColLower()[2] < -1.0e30 );
+         assert( m.isInteger(1) && !m.isInteger(0) );
+      }
+   }
+   // Read through a registered source - plain and compressed, with
+   // ranges asked for ahead on other threads on the second round
+   {
+      const char * text =
+         "Minimize\n obj: x + 2 y\n"
+         "Subject To\n c1: x + y >= 1\n"
+         "Bounds\n y <= 4\nEnd\n";
+      CoinFileInput::registerSource("TEST", openLpIoTestSource);
+      CoinFileInput::registerSource("missing", openLpIoMissingSource);
+      CoinFileOutput::Compression compress[5] =
+         { CoinFileOutput::COMPRESS_NONE, CoinFileOutput::COMPRESS_GZIP,
+           CoinFileOutput::COMPRESS_BZIP2, CoinFileOutput::COMPRESS_ZSTD,
+           CoinFileOutput::COMPRESS_LZ4 };
+      for (int iPass = 0; iPass < 10; iPass++) {
+         if (!CoinFileOutput::compressionSupported(compress[iPass%5]))
+            continue;
+         CoinFileOutput * output =
+            CoinFileOutput::create("CoinLpIoSource.lp", compress[iPass%5]);
+         output->puts(text);
+         assert( output->close() );
+         delete output;
+         std::string name = "test://CoinLpIoSource.lp";
+         assert( fileCoinReadable(name) );
+         assert( name == "test://CoinLpIoSource.lp" );
+         CoinFileInput * input = CoinFileInput::create(name, 1 + 2*(iPass/5));
+         char line[100];
+         assert( !strcmp(input->gets(line, 100), "Minimize\n") );
+         delete input;
+         CoinLpIO m;
+         m.messageHandler()->setLogLevel(0);
+         m.setNumberThreads(1 + 2*(iPass/5));
+         m.readLp(name.c_str());
+         assert( m.getNumCols() == 2 );
+         assert( m.getNumRows() == 1 );
+         assert( m.getObjCoefficients()[1] == 2.0 );
+         assert( m.getColUpper()[1] == 4.0 );
+      }
+      std::string name = "missing://CoinLpIoSource.lp";
+      assert( !fileCoinReadable(name) );
+      bool thrown = false;
+      try {
+         delete CoinFileInput::create(name);
+      }
+      catch (CoinError &) {
+         thrown = true;
+      }
+      assert( thrown );
+      CoinFileInput::registerSource("test", NULL);
+      CoinFileInput::registerSource("missing", NULL);
+      name = "test://CoinLpIoSource.lp";
+      assert( !fileCoinReadable(name) );
+   }
+   // Read through a model cache
+   {
+      FILE * fp = fopen("CoinLpIoCache.lp", "w");
+      fputs("Maximize\n obj: x + 2 y\n"
+            "Subject To\n c1: x + y <= 3\n c2: x - y >= -1\n"
+            "Bounds\n y <= 4\nGenerals\n x\nEnd\n", fp);
+      fclose(fp);
+      CoinModelCache cache;
+      CoinLpIO m;
+      m.messageHandler()->setLogLevel(0);
+      m.setModelCache(&cache);
+      m.readLp("CoinLpIoCache.lp");
+      CoinLpIO m2;
+      m2.messageHandler()->setLogLevel(0);
+      m2.setModelCache(&cache);
+      m2.readLp("CoinLpIoCache.lp");
+      assert( cache.misses() == 1 && cache.hits() == 1 );
+      assert( m2.getNumRows() == 2 && m2.getNumCols() == 2 );
+      assert( m2.getObjCoefficients()[1] == -2.0 );
+      assert( m2.objectiveOffset() == m.objectiveOffset() );
+      assert( m2.getRowUpper()[0] == 3.0 && m2.getColUpper()[1] == 4.0 );
+      assert( m2.isInteger(0) && !m2.isInteger(1) );
+      assert( !strcmp(m2.rowName(1), "c2") && m2.columnIndex("y") == 1 );
+      assert( !strcmp(m2.getObjName(), m.getObjName()) );
+      assert( m2.getMatrixByRow() != m.getMatrixByRow() );
+      Coin::SmartPtr<CoinCachedModel> view = m.viewLp("CoinLpIoCache.lp");
+      assert( view->lp()->getMatrixByCol()->getNumElements() == 4 );
+      assert( cache.hits() == 2 && cache.numberModels() == 1 );
+      m2.setEpsilon(1.0e-7);
+      m2.readLp("CoinLpIoCache.lp");
+      assert( cache.misses() == 2 && cache.numberModels() == 2 );
+      cache.clear();
+      assert( cache.numberModels() == 0 && cache.bytes() == 0 );
+      assert( view->lp()->getNumRows() == 2 );
+   }
+   // Write compressed (using threads if possible) and read back
+   {
+      CoinLpIO m;
+      m.messageHandler()->setLogLevel(0);
+      std::string fn = lpDir + "exmip1.lp";
+      m.readLp(fn.c_str());
+      m.setNumberThreads(2);
+      m.writeLp("CoinLpIoTest2.lp", true, 1);
+      CoinLpIO m2;
+      m2.messageHandler()->setLogLevel(0);
+      if (CoinFileOutput::compressionSupported(CoinFileOutput::COMPRESS_GZIP))
+         m2.readLp("CoinLpIoTest2.lp.gz");
+      else
+         m2.readLp("CoinLpIoTest2.lp");
+      assert( m2.getNumCols() == m.getNumCols() );
+      assert( m2.getNumRows() == m.getNumRows() );
+      assert( m2.getNumElements() == m.getNumElements() );
+      CoinRelFltEq eq(1.0e-5);
+      for (int i = 0; i < m.getNumRows(); i++) {
+         assert( !strcmp(m.rowName(i), m2.rowName(i)) );
+         assert( eq(m.getRowLower()[i], m2.getRowLower()[i]) );
+         assert( eq(m.getRowUpper()[i], m2.getRowUpper()[i]) );
+      }
+      for (int j = 0; j < m.getNumCols(); j++) {
+         assert( !strcmp(m.columnName(j), m2.columnName(j)) );
+         assert( eq(m.getObjCoefficients()[j], m2.getObjCoefficients()[j]) );
+         assert( eq(m.getColUpper()[j], m2.getColUpper()[j]) );
+      }
+   }
 }
@@ -12,9 +12,13 @@
 #endif
 
 #include <cassert>
+#include <utility>
 
 #include "CoinMpsIO.hpp"
 #include "CoinModel.hpp"
+#include "CoinNameHash.hpp"
+#include "CoinModelDelta.hpp"
+#include "CoinWarmStartBasis.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinTime.hpp"
 
@@ -503,6 +507,11 @@ CoinModelUnitTest(const std::string & mpsDir,
     }
     // write out
     model.writeMps("byColumn.mps");
+    // and binary snapshot which should read back the same
+    assert (!model.writeBinary("byColumn.bin"));
+    CoinModel binary;
+    assert (!binary.readBinary("byColumn.bin"));
+    assert (!model.differentModel(binary,false));
   }
 
   // model was created by column - play around
@@ -682,6 +691,351 @@ CoinModelUnitTest(const std::string & mpsDir,
 	<< time1 << " seconds\n" << std::endl ;
     }
   }
+  // Name hash
+  {
+    CoinNameHash hash;
+    const int n = 5000;
+    char ** names = new char * [n];
+    for (int i = 0; i < n; i++) {
+      char temp[20];
+      sprintf(temp, "R%07d", i);
+      names[i] = CoinStrdup(temp);
+    }
+    assert (!hash.add(n, names));
+    assert (hash.numberNames() == n);
+    for (int i = 0; i < n; i++) {
+      assert (hash.find(names[i]) == i);
+      assert (!strcmp(hash.name(i), names[i]));
+    }
+    assert (hash.find("R") == -1);
+    assert (hash.find("") == -1);
+    // duplicate is not added
+    assert (hash.add(n, names[17]) == 17);
+    assert (hash.name(n) == NULL);
+    // remove every third and check rest still found
+    for (int i = 0; i < n; i += 3)
+      assert (hash.remove(i));
+    assert (!hash.remove(0));
+    int * which = new int [n];
+    hash.find(n, names, which);
+    for (int i = 0; i < n; i++)
+      assert (which[i] == ((i % 3) ? i : -1));
+    // put back at other indices (old space is recovered)
+    CoinNameHash copy(hash);
+    for (int i = 0; i < n; i += 3)
+      assert (copy.add(n + i, names[i]) == n + i);
+    assert (copy.numberNames() == n);
+    for (int i = 0; i < n; i++)
+      assert (copy.find(names[i]) == ((i % 3) ? i : n + i));
+    // renaming an index removes old name
+    copy.add(1, "new name");
+    assert (copy.find(names[1]) == -1);
+    assert (copy.find("new name") == 1);
+    hash = copy;
+    assert (hash.find("new name") == 1);
+    // batch add reports duplicates
+    hash.clear();
+    assert (!hash.numberNames());
+    strcpy(names[4], names[3]);
+    assert (hash.add(10, names, 0, which) == 1);
+    assert (which[3] == -1 && which[4] == 3);
+    for (int i = 0; i < n; i++)
+      free(names[i]);
+    delete [] names;
+    delete [] which;
+  }
+  // Random access to elements
+  {
+    CoinModel model;
+    const int n = 300;
+    // scrambled order
+    for (int k = 0; k < n * n; k++) {
+      int which = static_cast<int>((k * 7919L) % (n * n));
+      int i = which / n;
+      int j = which % n;
+      if ((i + j) % 3 == 0)
+        model.setElement(i, j, i + 0.001 * j + 1.0);
+    }
+    assert (model.numberRows() == n && model.numberColumns() == n);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++)
+        assert (model.getElement(i, j) == (((i + j) % 3) ? 0.0 : i + 0.001 * j + 1.0));
+    }
+    // delete some and change others
+    for (int i = 0; i < n; i += 2) {
+      for (int j = (3 - i % 3) % 3; j < n; j += 3)
+        model.deleteElement(i, j);
+    }
+    model.setElement(1, 2, -1.0);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        double value = 0.0;
+        if ((i & 1) && (i + j) % 3 == 0)
+          value = (i == 1 && j == 2) ? -1.0 : i + 0.001 * j + 1.0;
+        assert (model.getElement(i, j) == value);
+      }
+    }
+    model.validateLinks();
+  }
+  // Bulk load
+  {
+    // 3 rows, 4 columns
+    const CoinBigIndex start[5] = {0, 2, 3, 5, 6};
+    const int index[6] = {0, 2, 1, 0, 1, 2};
+    const double element[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    const double rowUpper[3] = {10.0, 20.0, 30.0};
+    const double objective[4] = {1.0, -1.0, 2.0, -2.0};
+    const char integerType[4] = {0, 1, 0, 1};
+    const char * rowNames[3] = {"a", "b", "c"};
+    const char * columnNames[4] = {"w", "x", NULL, "z"};
+    CoinModel byColumn;
+    byColumn.loadArrays(3, 4, true, start, index, element, NULL, rowUpper,
+			NULL, NULL, objective, integerType, rowNames,
+			columnNames);
+    // same as triplets in scrambled order
+    const int tripletRow[6] = {1, 2, 0, 0, 1, 2};
+    const int tripletColumn[6] = {2, 3, 2, 0, 1, 0};
+    const double tripletElement[6] = {5.0, 6.0, 4.0, 1.0, 3.0, 2.0};
+    CoinModel byTriplet;
+    byTriplet.loadTriplets(3, 4, 6, tripletRow, tripletColumn, tripletElement,
+			   NULL, rowUpper, NULL, NULL, objective, integerType,
+			   rowNames, columnNames);
+    for (int iPass = 0; iPass < 2; iPass++) {
+      CoinModel & model = iPass ? byTriplet : byColumn;
+      assert (model.numberRows() == 3 && model.numberColumns() == 4);
+      assert (model.numberElements() == 6);
+      const CoinPackedMatrix * matrix = model.packedMatrix();
+      assert (matrix && matrix->isColOrdered());
+      assert (matrix->getCoefficient(2, 0) == 2.0);
+      assert (matrix->getCoefficient(1, 2) == 5.0);
+      assert (matrix->getCoefficient(2, 1) == 0.0);
+      assert (model.getRowLower(1) == -COIN_DBL_MAX);
+      assert (model.getRowUpper(2) == 30.0);
+      assert (model.getColumnUpper(0) == COIN_DBL_MAX);
+      assert (model.getColumnObjective(3) == -2.0);
+      assert (model.getColumnIsInteger(1) && !model.getColumnIsInteger(2));
+      assert (model.row("c") == 2 && model.column("z") == 3);
+      assert (model.column("y") == -1 && !model.getColumnName(2));
+    }
+    // row ordered
+    const CoinBigIndex rowStart[4] = {0, 1, 3, 4};
+    const int rowIndex[4] = {1, 0, 3, 2};
+    const double rowElement[4] = {1.0, 2.0, 3.0, 4.0};
+    CoinModel byRow;
+    byRow.loadArrays(3, 4, false, rowStart, rowIndex, rowElement, NULL, NULL,
+		     NULL, NULL, NULL);
+    assert (!byRow.packedMatrix()->isColOrdered());
+    assert (byRow.packedMatrix()->getCoefficient(1, 3) == 3.0);
+    assert (byRow.getColumnName(0) == NULL);
+    bool caught = false;
+    try {
+      CoinModel bad;
+      bad.loadTriplets(3, 4, 6, tripletColumn, tripletColumn, tripletElement,
+		       NULL, NULL, NULL, NULL, NULL);
+    } catch (CoinError &) {
+      caught = true;
+    }
+    assert (caught);
+  }
+  // Elements as triples - lists only made when traversed
+  {
+    CoinModel model;
+    int column[2] = {3, 1};
+    double element[2] = {1.0, 2.0};
+    model.addRow(2, column, element, 0.0, 1.0);
+    model.setElement(2, 0, 3.0);
+    model.setElement(1, 3, 4.0);
+    model.setElement(0, 1, 5.0);
+    model.setElement(2, 2, 6.0);
+    CoinPackedMatrix matrix;
+    model.createPackedMatrix(matrix, NULL);
+    assert (matrix.isColOrdered() && matrix.getNumElements() == 5);
+    assert (matrix.getCoefficient(0, 1) == 5.0);
+    const int * row = matrix.getIndices();
+    const CoinBigIndex * start = matrix.getVectorStarts();
+    assert (row[start[3]] == 0 && row[start[3]+1] == 1);
+    // now by row
+    CoinModelLink triple = model.firstInRow(2);
+    assert (triple.column() == 0 && triple.value() == 3.0);
+    triple = model.next(triple);
+    assert (triple.column() == 2 && triple.value() == 6.0);
+    // lists kept up to date from now on
+    model.setElement(2, 1, 7.0);
+    model.deleteElement(2, 0);
+    triple = model.firstInColumn(1);
+    int number = 0;
+    while (triple.row() >= 0) {
+      number++;
+      triple = model.next(triple);
+    }
+    assert (number == 2);
+    model.validateLinks();
+    model.createPackedMatrix(matrix, NULL);
+    assert (matrix.getNumElements() == 5);
+    assert (matrix.getCoefficient(2, 1) == 7.0 && !matrix.getCoefficient(2, 0));
+  }
+  // Quadratic objective held as upper triangle
+  {
+    CoinModel model;
+    for (int i = 0; i < 3; i++)
+      model.setColumnBounds(i, 0.0, 1.0);
+    model.setQuadraticElement(0, 0, 2.0);
+    model.setQuadraticElement(2, 0, 1.0);
+    model.setQuadraticElement(1, 2, -1.0);
+    model.setQuadraticElement(1, 2, 3.0);
+    assert (model.getQuadraticElement(0, 2) == 1.0);
+    assert (model.getQuadraticElement(2, 1) == 3.0);
+    const CoinQuadraticMatrix & quadratic = model.quadraticObjective();
+    assert (quadratic.getNumElements() == 3);
+    double x[3] = {1.0, 2.0, 3.0};
+    double y[3];
+    quadratic.times(x, y);
+    assert (y[0] == 5.0 && y[1] == 9.0 && y[2] == 7.0);
+    assert (quadratic.quadraticForm(x) == 44.0);
+    model.setQuadraticElement(0, 2, 0.0);
+    assert (quadratic.getNumElements() == 2);
+    CoinModel copy(model);
+    assert (copy.getQuadraticElement(1, 2) == 3.0);
+    assert (!copy.getQuadraticElement(0, 2));
+  }
+  // Delta between two models
+  {
+    CoinModel base;
+    int column[3] = {0, 1, 2};
+    double element[3] = {1.0, 2.0, 3.0};
+    base.addRow(3, column, element, 0.0, 4.0, "r0");
+    base.addRow(2, column+1, element, -1.0, 1.0, "r1");
+    CoinModel model(base);
+    model.setRowBounds(1, -2.0, 2.0);
+    model.setColumnObjective(2, 5.0);
+    model.setElement(0, 1, 7.0);
+    model.deleteElement(1, 2);
+    model.setElement(2, 3, 1.0);
+    model.setRowName(2, "r2");
+    CoinModel copy(base);
+    CoinModelDelta delta(copy, model);
+    assert (delta.numberRows() == 3 && delta.numberColumns() == 4);
+    assert (delta.numberElementChanges() == 3);
+    size_t size = delta.bufferSize();
+    char * buffer = new char [size];
+    delta.toBuffer(buffer);
+    CoinModelDelta delta2;
+    assert (!delta2.fromBuffer(buffer, size));
+    buffer[0] = 'X';
+    assert (delta2.fromBuffer(buffer, size) == -2 && delta2.isEmpty());
+    delete [] buffer;
+    assert (!delta.apply(copy));
+    assert (copy.getRowLower(1) == -2.0 && copy.getColumnObjective(2) == 5.0);
+    assert (copy.getElement(0, 1) == 7.0 && !copy.getElement(1, 2));
+    assert (!strcmp(copy.getRowName(2), "r2"));
+    assert (!copy.differentModel(model, false));
+    assert (delta.apply(copy) == -1);
+  }
+  // Deleting many rows and columns in one pass, with a map for the basis
+  {
+    CoinModel model;
+    const int numberRows = 40;
+    const int numberColumns = 30;
+    for (int i = 0; i < numberRows; i++) {
+      int column[2] = {i % numberColumns, (i+7) % numberColumns};
+      double element[2] = {1.0+i, -1.0};
+      char name[10];
+      sprintf(name, "r%d", i);
+      model.addRow(2, column, element, -i, 100.0+i, name);
+    }
+    CoinWarmStartBasis basis;
+    basis.setSize(numberColumns, numberRows);
+    for (int i = 0; i < numberRows; i++)
+      basis.setArtifStatus(i, (i % 3) ? CoinWarmStartBasis::basic
+			   : CoinWarmStartBasis::atLowerBound);
+    for (int j = 0; j < numberColumns; j++)
+      basis.setStructStatus(j, (j % 2) ? CoinWarmStartBasis::atUpperBound
+			    : CoinWarmStartBasis::basic);
+    // unsorted, duplicated and out of range
+    const int deleteRows[7] = {35, 2, 17, 2, 39, 100, 0};
+    int newRow[numberRows];
+    assert (model.deleteRows(7, deleteRows, newRow) == 5);
+    assert (model.numberRows() == numberRows-5);
+    assert (newRow[0] == -1 && newRow[1] == 0 && newRow[3] == 1);
+    assert (newRow[38] == numberRows-6);
+    assert (model.numberElements() == 2*(numberRows-5));
+    CoinWarmStartBasis copy(basis);
+    basis.remapRows(newRow);
+    copy.deleteRows(7, deleteRows);
+    assert (basis.getNumArtificial() == numberRows-5);
+    for (int i = 0; i < numberRows; i++) {
+      if (newRow[i] >= 0) {
+	assert (basis.getArtifStatus(newRow[i]) == copy.getArtifStatus(newRow[i]));
+	assert (basis.getArtifStatus(newRow[i]) ==
+		((i % 3) ? CoinWarmStartBasis::basic
+		 : CoinWarmStartBasis::atLowerBound));
+	char name[10];
+	sprintf(name, "r%d", i);
+	assert (!strcmp(model.getRowName(newRow[i]), name));
+	assert (model.row(name) == newRow[i]);
+	assert (model.getRowLower(newRow[i]) == -i);
+	assert (model.getElement(newRow[i], i % numberColumns) == 1.0+i);
+      }
+    }
+    const int deleteColumns[4] = {29, 3, 4, 3};
+    int newColumn[numberColumns];
+    assert (model.deleteColumns(4, deleteColumns, newColumn) == 3);
+    assert (model.numberColumns() == numberColumns-3);
+    basis.remapColumns(newColumn);
+    assert (basis.getNumStructural() == numberColumns-3);
+    for (int j = 0; j < numberColumns; j++) {
+      if (newColumn[j] >= 0)
+	assert (basis.getStructStatus(newColumn[j]) ==
+		((j % 2) ? CoinWarmStartBasis::atUpperBound
+		 : CoinWarmStartBasis::basic));
+    }
+    // artificials moved to follow shorter structurals
+    for (int i = 0; i < numberRows; i++) {
+      if (newRow[i] >= 0)
+	assert (basis.getArtifStatus(newRow[i]) == copy.getArtifStatus(newRow[i]));
+    }
+    for (int i = 0; i < numberRows; i++) {
+      int j = i % numberColumns;
+      if (newRow[i] >= 0 && newColumn[j] >= 0)
+	assert (model.getElement(newRow[i], newColumn[j]) == 1.0+i);
+    }
+    CoinPackedMatrix matrix;
+    model.createPackedMatrix(matrix, NULL);
+    assert (matrix.getNumRows() == numberRows-5 &&
+	    matrix.getNumCols() == numberColumns-3);
+  }
+#if COIN_HAS_MOVE
+  // Moving takes the arrays (and arena names) without copying
+  {
+    CoinModel source;
+    source.useArena();
+    const int rows[2] = {0, 1};
+    const double elements[2] = {1.0, 2.0};
+    source.addColumn(2, rows, elements, 0.0, 4.0, 1.0, "x0", false);
+    source.addColumn(1, rows+1, elements, 0.0, 1.0, -1.0, "x1", true);
+    source.setRowName(0, "r0");
+    source.setRowBounds(1, -1.0, 3.0);
+    CoinModel copy(source);
+    const double * lower = source.rowLowerArray();
+    CoinModel moved(std::move(source));
+    assert (moved.rowLowerArray() == lower);
+    assert (!moved.differentModel(copy, false));
+    assert (!strcmp(moved.getRowName(0), "r0"));
+    assert (!source.numberRows() && !source.numberColumns());
+    source = std::move(moved);
+    assert (source.rowLowerArray() == lower);
+    assert (!source.differentModel(copy, false));
+    CoinModel other;
+    other.swap(source);
+    assert (!other.differentModel(copy, false) && !source.numberColumns());
+    // reader gives up its problem and handler
+    CoinMpsIO reader;
+    reader.setProblemName("moved");
+    CoinMpsIO movedReader(std::move(reader));
+    assert (!strcmp(movedReader.getProblemName(), "moved"));
+    assert (movedReader.messageHandler() && !reader.messageHandler());
+  }
+#endif
 }
 
 
@@ -14,10 +14,34 @@
 #include <cassert>
 
 #include "CoinMpsIO.hpp"
+#include "CoinSharedModel.hpp"
 #include "CoinFloatEqual.hpp"
+#include "CoinNumberIO.hpp"
+#include "CoinWarmStartBasis.hpp"
 
 //#############################################################################
 
+// Builds column copy from callbacks
+class CoinMpsTestCallback : public CoinMpsCallback {
+public:
+  CoinMpsTestCallback() : matrix(true,0.0,0.0), numberRows(-1),
+			  numberBounds(0) {}
+  virtual void rows(int number, const char * const *)
+  { numberRows = number;}
+  virtual void column(int iColumn, const char *, double, int numberElements,
+		      const int * rows, const double * elements, bool)
+  {
+    assert( iColumn == matrix.getNumCols() );
+    matrix.setDimensions(numberRows,iColumn);
+    matrix.appendCol(numberElements,rows,elements);
+  }
+  virtual void columnBounds(int, double, double, bool)
+  { numberBounds++;}
+  CoinPackedMatrix matrix;
+  int numberRows;
+  int numberBounds;
+};
+
 //--------------------------------------------------------------------------
 // test import methods
 void
@@ -158,7 +182,293 @@ CoinMpsIOUnitTest(const std::string & mpsDir)
       assert( eq( dumSi.getObjCoefficients()[6],  0.0) );
       assert( eq( dumSi.getObjCoefficients()[7], -1.0) );
     }
-    
+
+    // Number conversion used by readers and writers
+    {
+      const double values[] = {0.0, 1.0, -2.5, 0.1, 1.0/3.0, 1.0e-7,
+			       -123456.789, 1.0e30, 4.9e-324, 1.7976931348623157e308};
+      char buffer[24];
+      for (int i = 0; i < 10; i++) {
+	int length = CoinFormatDouble(values[i],buffer);
+	assert( length < 24 && length == static_cast<int>(strlen(buffer)) );
+	char * end;
+	assert( CoinStrtod(buffer,&end) == values[i] );
+	assert( end == buffer + length );
+      }
+      CoinFormatDouble(0.1,buffer);
+      assert( !strcmp(buffer,"0.1") );
+      assert( CoinStrtod(" -1.5e+2x",NULL) == -150.0 );
+      assert( CoinStrtod("0.30000000000000004",NULL) == 0.1+0.2 );
+    }
+
+    // Read with COLUMNS section parsed by several threads
+    {
+      CoinMpsIO dumSi;
+      dumSi.setNumberThreads(3);
+      int numErr = dumSi.readMps(fn.c_str(),"mps");
+      assert( numErr == 0 );
+      assert( dumSi.getNumCols() == m.getNumCols() );
+      assert( dumSi.getNumElements() == m.getNumElements() );
+      assert( dumSi.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+      for (int i = 0; i < m.getNumCols(); i++) {
+	assert( dumSi.getObjCoefficients()[i] == m.getObjCoefficients()[i] );
+	assert( dumSi.isInteger(i) == m.isInteger(i) );
+	assert( !strcmp(dumSi.columnName(i),m.columnName(i)) );
+      }
+    }
+
+    // Read passing columns to callback
+    {
+      CoinMpsIO dumSi;
+      CoinMpsTestCallback callback;
+      int numErr = dumSi.readMps(fn.c_str(),"mps",callback);
+      assert( numErr == 0 );
+      assert( dumSi.getNumElements() == 0 );
+      assert( dumSi.getNumCols() == m.getNumCols() );
+      assert( callback.numberBounds == m.getNumCols() );
+      assert( callback.matrix.isEquivalent(*m.getMatrixByCol()) );
+      for (int i = 0; i < m.getNumCols(); i++) {
+	assert( dumSi.getColUpper()[i] == m.getColUpper()[i] );
+	assert( dumSi.getObjCoefficients()[i] == m.getObjCoefficients()[i] );
+      }
+    }
+
+    // Read without keeping names, write default names and read back
+    {
+      CoinMpsIO dumSi;
+      dumSi.setKeepNames(1);
+      int numErr = dumSi.readMps(fn.c_str(),"mps");
+      assert( numErr == 0 );
+      assert( !strcmp(dumSi.rowName(1),m.rowName(1)) );
+      CoinMpsIO dumSi1;
+      dumSi1.setKeepNames(2);
+      numErr = dumSi1.readMps(fn.c_str(),"mps");
+      assert( numErr == 0 );
+      assert( !strcmp(dumSi1.rowName(2),"R0000002") );
+      assert( !strcmp(dumSi1.columnName(1),"C0000001") );
+      assert( dumSi1.rowIndex("R0000002") == 2 );
+      assert( dumSi1.columnIndex(m.columnName(1)) == -1 );
+      assert( dumSi1.writeMps("CoinMpsIoTest3.mps") == 0 );
+      CoinMpsIO dumSi2;
+      dumSi2.setKeepNames(1);
+      numErr = dumSi2.readMps("CoinMpsIoTest3.mps");
+      assert( numErr == 0 );
+      assert( dumSi2.columnIndex("C0000004") == 4 );
+      assert( !strcmp(dumSi2.rowName(3),"R0000003") );
+      assert( dumSi2.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+      CoinMpsIO dumSi3(dumSi2);
+      assert( !strcmp(dumSi3.columnName(0),"C0000000") );
+    }
+
+    // Write with sections formatted by several threads and read back
+    {
+      CoinMpsIO dumSi(m);
+      dumSi.setNumberThreads(2);
+      assert( dumSi.writeMps("CoinMpsIoTest2.mps",1,0,2) == 0 );
+      CoinMpsIO dumSi2;
+      int numErr = dumSi2.readMps("CoinMpsIoTest2.mps");
+      assert( numErr == 0 );
+      assert( dumSi2.getNumRows() == m.getNumRows() );
+      assert( dumSi2.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+      CoinRelFltEq eq;
+      for (int i = 0; i < m.getNumCols(); i++) {
+	assert( eq(dumSi2.getColLower()[i],m.getColLower()[i]) );
+	assert( eq(dumSi2.getColUpper()[i],m.getColUpper()[i]) );
+	assert( dumSi2.isInteger(i) == m.isInteger(i) );
+      }
+      for (int i = 0; i < m.getNumRows(); i++) {
+	assert( eq(dumSi2.getRowLower()[i],m.getRowLower()[i]) );
+	assert( eq(dumSi2.getRowUpper()[i],m.getRowUpper()[i]) );
+      }
+    }
+
+    // Binary snapshot round trip
+    {
+      assert( m.writeBinary("CoinMpsIoTest.bin") == 0 );
+      CoinMpsIO dumSi;
+      int numErr = dumSi.readBinary("CoinMpsIoTest.bin");
+      assert( numErr == 0 );
+      assert( dumSi.getNumRows() == m.getNumRows() );
+      assert( dumSi.getNumCols() == m.getNumCols() );
+      assert( dumSi.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+      for (int i = 0; i < m.getNumCols(); i++) {
+	assert( dumSi.getColLower()[i] == m.getColLower()[i] );
+	assert( dumSi.getColUpper()[i] == m.getColUpper()[i] );
+	assert( dumSi.getObjCoefficients()[i] == m.getObjCoefficients()[i] );
+	assert( dumSi.isInteger(i) == m.isInteger(i) );
+	assert( !strcmp(dumSi.columnName(i),m.columnName(i)) );
+      }
+      for (int i = 0; i < m.getNumRows(); i++) {
+	assert( dumSi.getRowLower()[i] == m.getRowLower()[i] );
+	assert( dumSi.getRowUpper()[i] == m.getRowUpper()[i] );
+	assert( !strcmp(dumSi.rowName(i),m.rowName(i)) );
+      }
+      assert( !strcmp(dumSi.getProblemName(),m.getProblemName()) );
+      assert( dumSi.readBinary((fn+".mps").c_str()) == -2 );
+      // lengths and row indices past the sizes in the header
+      FILE * fp = fopen("CoinMpsIoTest.bin","r+b");
+      assert( fp );
+      const long lengthAt = 128 + 8*(m.getNumCols()+1);
+      const long rowAt = lengthAt + 8*((m.getNumCols()+1)/2);
+      const unsigned char big[4] = {0x40, 0x42, 0x0f, 0};
+      unsigned char saved[4];
+      assert( !fseek(fp,lengthAt,SEEK_SET) && fread(saved,1,4,fp) == 4 );
+      assert( !fseek(fp,lengthAt,SEEK_SET) && fwrite(big,1,4,fp) == 4 );
+      fflush(fp);
+      assert( dumSi.readBinary("CoinMpsIoTest.bin") == -3 );
+      assert( !dumSi.getNumRows() && !dumSi.getNumCols() );
+      assert( !fseek(fp,lengthAt,SEEK_SET) && fwrite(saved,1,4,fp) == 4 );
+      assert( !fseek(fp,rowAt,SEEK_SET) && fread(saved,1,4,fp) == 4 );
+      assert( !fseek(fp,rowAt,SEEK_SET) && fwrite(big,1,4,fp) == 4 );
+      fflush(fp);
+      assert( dumSi.readBinary("CoinMpsIoTest.bin") == -3 );
+      assert( !fseek(fp,rowAt,SEEK_SET) && fwrite(saved,1,4,fp) == 4 );
+      fclose(fp);
+      assert( dumSi.readBinary("CoinMpsIoTest.bin") == 0 );
+    }
+
+    // Published in shared memory and attached without a copy
+    {
+      CoinSharedModel shared;
+      if (CoinSharedModel::publish("/CoinMpsIoTest",m) == 0) {
+	assert( shared.attach("/CoinMpsIoTest") == 0 );
+	const CoinPackedMatrix * matrix = shared.getMatrixByCol();
+	assert( matrix->isBorrowed() );
+	assert( matrix->isEquivalent(*m.getMatrixByCol()) );
+	const CoinSnapshot & snapshot = shared.snapshot();
+	assert( snapshot.getNumCols() == m.getNumCols() );
+	assert( snapshot.getMatrixByCol() == matrix );
+	for (int i = 0; i < m.getNumCols(); i++) {
+	  assert( shared.getColUpper()[i] == m.getColUpper()[i] );
+	  assert( snapshot.getObjCoefficients()[i] ==
+		  m.getObjCoefficients()[i] );
+	  assert( (snapshot.getColType()[i] == 'I') == m.isInteger(i) );
+	  assert( !strcmp(shared.columnName(i),m.columnName(i)) );
+	}
+	for (int i = 0; i < m.getNumRows(); i++) {
+	  assert( snapshot.getRowLower()[i] == m.getRowLower()[i] );
+	  assert( !strcmp(shared.rowName(i),m.rowName(i)) );
+	}
+	assert( !strcmp(shared.problemName(),m.getProblemName()) );
+	// still there after segment is removed
+	assert( CoinSharedModel::unpublish("/CoinMpsIoTest") == 0 );
+	assert( matrix->getNumElements() == m.getNumElements() );
+	CoinSharedModel other;
+	assert( other.attach("/CoinMpsIoTest") == -1 );
+	shared.detach();
+	assert( !shared.isAttached() && !shared.getNumCols() );
+      }
+      // binary file mapped in place
+      if (shared.attachFile("CoinMpsIoTest.bin") == 0) {
+	assert( shared.getMatrixByCol()->isBorrowed() );
+	assert( shared.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+	for (int i = 0; i < m.getNumRows(); i++)
+	  assert( shared.getRowUpper()[i] == m.getRowUpper()[i] );
+	assert( shared.attachFile((fn+".mps").c_str()) == -2 );
+	assert( !shared.isAttached() );
+      }
+    }
+
+    // Read through a model cache (written from copy so m stays unbuilt)
+    {
+      assert( CoinMpsIO(m).writeMps("CoinMpsIoTest4.mps") == 0 );
+      CoinModelCache cache;
+      CoinMpsIO dumSi;
+      dumSi.setModelCache(&cache);
+      assert( dumSi.readMps("CoinMpsIoTest4.mps") == 0 );
+      assert( cache.misses() == 1 && cache.numberModels() == 1 );
+      CoinMpsIO dumSi2;
+      dumSi2.setModelCache(&cache);
+      assert( dumSi2.readMps("CoinMpsIoTest4","mps") == 0 );
+      assert( cache.hits() == 1 );
+      assert( dumSi2.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+      assert( dumSi2.getMatrixByCol() != dumSi.getMatrixByCol() );
+      for (int i = 0; i < m.getNumCols(); i++) {
+	assert( dumSi2.getColUpper()[i] == dumSi.getColUpper()[i] );
+	assert( !strcmp(dumSi2.columnName(i),m.columnName(i)) );
+      }
+      assert( dumSi2.rowIndex(m.rowName(2)) == 2 );
+      // view is the cached model itself
+      Coin::SmartPtr<CoinCachedModel> view = dumSi.viewMps("CoinMpsIoTest4.mps");
+      assert( view.IsValid() && view->returnCode() == 0 );
+      assert( view.GetRawPtr() ==
+	      dumSi2.viewMps("CoinMpsIoTest4.mps").GetRawPtr() );
+      assert( view->mps()->getNumRows() == m.getNumRows() );
+      assert( cache.hits() == 3 && cache.bytes() >= view->bytes() );
+      // other settings are another model
+      dumSi2.setInfinity(1.0e20);
+      assert( dumSi2.viewMps("CoinMpsIoTest4.mps").GetRawPtr() !=
+	      view.GetRawPtr() );
+      assert( cache.numberModels() == 2 );
+      // changed file (here written another way) is read again
+      assert( CoinMpsIO(m).writeMps("CoinMpsIoTest4.mps",0,2) == 0 );
+      assert( dumSi.readMps("CoinMpsIoTest4.mps") == 0 );
+      assert( cache.misses() == 3 );
+      assert( dumSi.getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+      // least recently used models dropped
+      cache.setMaximumBytes(view->bytes());
+      assert( cache.numberModels() <= 1 && cache.evictions() >= 2 );
+      cache.setMaximumBytes(0);
+      assert( cache.numberModels() == 0 && cache.bytes() == 0 );
+      // dropped models live on while used
+      assert( view->mps()->getMatrixByCol()->isEquivalent(*m.getMatrixByCol()) );
+    }
+
+    // Basis read from text (names looked up in batches), then binary
+    {
+      FILE * fp = fopen("CoinMpsIoTest.bas","w");
+      assert( fp );
+      fprintf(fp,"NAME          EXMIP1\n XU %s %s\n XL %s %s\n"
+	      " XU %s %s\nENDATA\n",m.columnName(0),m.rowName(1),
+	      m.columnName(2),m.rowName(0),m.columnName(7),m.rowName(4));
+      fclose(fp);
+      int numberRows = m.getNumRows();
+      int numberColumns = m.getNumCols();
+      std::vector<std::string> rowNames;
+      std::vector<std::string> columnNames;
+      for (int i = 0; i < numberRows; i++)
+	rowNames.push_back(m.rowName(i));
+      for (int i = 0; i < numberColumns; i++)
+	columnNames.push_back(m.columnName(i));
+      std::vector<unsigned char> rowStatus(numberRows,1);
+      std::vector<unsigned char> columnStatus(numberColumns,3);
+      CoinMpsIO dumSi;
+      int returnCode = dumSi.readBasis("CoinMpsIoTest.bas","",NULL,
+				       &rowStatus[0],&columnStatus[0],
+				       columnNames,numberColumns,
+				       rowNames,numberRows);
+      assert( returnCode == 0 );
+      assert( columnStatus[0] == 1 && rowStatus[1] == 2 );
+      assert( columnStatus[2] == 1 && rowStatus[0] == 3 );
+      assert( columnStatus[7] == 1 && rowStatus[4] == 2 );
+      assert( columnStatus[1] == 3 && rowStatus[2] == 1 );
+      CoinWarmStartBasis basis;
+      basis.setSize(numberColumns,numberRows);
+      for (int i = 0; i < numberColumns; i++)
+	basis.setStructStatus(i,
+	  static_cast<CoinWarmStartBasis::Status>(columnStatus[i]));
+      for (int i = 0; i < numberRows; i++)
+	basis.setArtifStatus(i,
+	  static_cast<CoinWarmStartBasis::Status>(rowStatus[i]));
+      assert( dumSi.writeBasisBinary("CoinMpsIoTest.bbas",basis) == 0 );
+      CoinWarmStartBasis basis2;
+      assert( dumSi.readBasisBinary("CoinMpsIoTest.bbas",basis2) == 0 );
+      assert( basis2.getNumStructural() == numberColumns );
+      assert( basis2.getNumArtificial() == numberRows );
+      for (int i = 0; i < numberColumns; i++)
+	assert( basis2.getStructStatus(i) == basis.getStructStatus(i) );
+      for (int i = 0; i < numberRows; i++)
+	assert( basis2.getArtifStatus(i) == basis.getArtifStatus(i) );
+      // damaged status is caught by checksum
+      fp = fopen("CoinMpsIoTest.bbas","r+b");
+      assert( fp );
+      fseek(fp,64,SEEK_SET);
+      fputc(0xff,fp);
+      fclose(fp);
+      assert( dumSi.readBasisBinary("CoinMpsIoTest.bbas",basis2) == -2 );
+      assert( dumSi.readBasisBinary("CoinMpsIoTest.bas",basis2) == -2 );
+    }
+
     // Test matrixByRow method
     { 
       const CoinMpsIO si(m);
@@ -0,0 +1,221 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinNodeStore.hpp"
+#include "CoinSearchTree.hpp"
+
+namespace {
+
+// Node whose description is a list of bound changes
+class testNode : public CoinTreeNode {
+public:
+  testNode(int depth, double quality, int numberChanges)
+    : CoinTreeNode(depth, -1, quality)
+  {
+    for (int i = 0; i < numberChanges; i++)
+      changes_.push_back(depth * 1000 + i);
+  }
+  virtual int packedSize() const
+  {
+    return static_cast<int>(changes_.size() * sizeof(int));
+  }
+  virtual void pack(char *data)
+  {
+    if (!changes_.empty())
+      memcpy(data, &changes_[0], changes_.size() * sizeof(int));
+    std::vector<int>().swap(changes_);
+  }
+  virtual void unpack(const char *data, int size)
+  {
+    changes_.resize(size / sizeof(int));
+    if (!changes_.empty())
+      memcpy(&changes_[0], data, size);
+  }
+  // True if description is as made
+  bool intact(int numberChanges) const
+  {
+    if (static_cast<int>(changes_.size()) != numberChanges)
+      return false;
+    for (int i = 0; i < numberChanges; i++) {
+      if (changes_[i] != getDepth() * 1000 + i)
+	return false;
+    }
+    return true;
+  }
+  std::vector<int> changes_;
+};
+
+// Node which can't be packed
+class plainNode : public CoinTreeNode {
+public:
+  plainNode() : CoinTreeNode(0) {}
+};
+
+// Record of n bytes seed, seed+1, ...
+void fillRecord(char *data, int n, int seed)
+{
+  for (int i = 0; i < n; i++)
+    data[i] = static_cast<char>(seed + i);
+}
+
+bool checkRecord(const CoinNodeStore &store, int handle, int n, int seed)
+{
+  if (store.size(handle) != n)
+    return false;
+  std::vector<char> data(n + 1);
+  store.load(handle, &data[0]);
+  for (int i = 0; i < n; i++) {
+    if (data[i] != static_cast<char>(seed + i))
+      return false;
+  }
+  return true;
+}
+
+}	// end file-local namespace
+
+void CoinNodeStoreUnitTest()
+{
+  char data[1000];
+  // records in memory
+  {
+    CoinNodeStore store;
+    std::vector<int> handles;
+    for (int i = 0; i < 10; i++) {
+      fillRecord(data, 10 * i, i);
+      handles.push_back(store.store(data, 10 * i));
+    }
+    assert (store.numberRecords() == 10);
+    assert (store.bytesInMemory() == 450);
+    assert (!store.bytesOnFile());
+    assert (!store.numberSpilled());
+    for (int i = 0; i < 10; i++)
+      assert (checkRecord(store, handles[i], 10 * i, i));
+    store.release(handles[3]);
+    assert (store.numberRecords() == 9);
+    assert (store.bytesInMemory() == 420);
+    // handle is reused
+    fillRecord(data, 5, 77);
+    assert (store.store(data, 5) == handles[3]);
+    assert (checkRecord(store, handles[3], 5, 77));
+    for (int i = 0; i < 10; i++) {
+      if (i != 3)
+	assert (checkRecord(store, handles[i], 10 * i, i));
+    }
+  }
+  // compaction when most of the arena is dead
+  {
+    CoinNodeStore store;
+    std::vector<int> handles;
+    for (int i = 0; i < 200; i++) {
+      fillRecord(data, 1000, i);
+      handles.push_back(store.store(data, 1000));
+    }
+    for (int i = 0; i < 200; i++) {
+      if (i % 10)
+	store.release(handles[i]);
+    }
+    assert (store.numberRecords() == 20);
+    assert (store.bytesInMemory() == 20000);
+    for (int i = 0; i < 200; i += 10)
+      assert (checkRecord(store, handles[i], 1000, i));
+  }
+  // spilling over the cap, to a named file
+  {
+    const char *fileName = "CoinNodeStoreTest.spill";
+    {
+      CoinNodeStore store(2500);
+      store.setSpillFile(fileName);
+      std::vector<int> handles;
+      for (int i = 0; i < 8; i++) {
+	fillRecord(data, 1000, i);
+	handles.push_back(store.store(data, 1000));
+      }
+      assert (store.bytesInMemory() == 2000);
+      assert (store.bytesOnFile() == 6000);
+      assert (store.numberSpilled() == 6);
+      for (int i = 0; i < 8; i++)
+	assert (checkRecord(store, handles[i], 1000, i));
+      // once nothing on file is live the file is used again from start
+      for (int i = 2; i < 8; i++)
+	store.release(handles[i]);
+      assert (!store.bytesOnFile());
+      fillRecord(data, 700, 33);
+      int handle = store.store(data, 700);
+      assert (store.numberSpilled() == 7);
+      assert (store.bytesOnFile() == 700);
+      assert (checkRecord(store, handle, 700, 33));
+      assert (checkRecord(store, handles[0], 1000, 0));
+      FILE *fp = fopen(fileName, "rb");
+      assert (fp);
+      fclose(fp);
+    }
+    // file removed with the store
+    FILE *fp = fopen(fileName, "rb");
+    assert (!fp);
+  }
+  // nodes
+  {
+    CoinNodeStore store;
+    testNode node(3, 1.5, 25);
+    assert (!node.isStored());
+    assert (store.storeNode(&node));
+    assert (node.isStored());
+    assert (node.changes_.empty());
+    assert (store.numberRecords() == 1);
+    // already stored
+    assert (!store.storeNode(&node));
+    store.unstoreNode(&node);
+    assert (!node.isStored());
+    assert (node.intact(25));
+    assert (!store.numberRecords());
+    // nothing to do
+    store.unstoreNode(&node);
+    assert (node.intact(25));
+    plainNode plain;
+    assert (!store.storeNode(&plain));
+    assert (!plain.isStored());
+  }
+  // search tree packs nodes below top and unpacks them on the way up
+  {
+    CoinNodeStore store;
+    CoinSearchTree<CoinSearchTreeCompareBest> tree;
+    tree.setNodeStore(&store, 2);
+    const int numberNodes = 12;
+    std::vector<testNode *> nodes;
+    for (int i = 0; i < numberNodes; i++) {
+      testNode *node = new testNode(i, (i * 7) % numberNodes, 10 + i);
+      nodes.push_back(node);
+      CoinTreeNode *one = node;
+      tree.push(1, &one);
+    }
+    assert (tree.size() == numberNodes);
+    assert (store.numberRecords() > 0);
+    double lastQuality = -1.0;
+    int numberPopped = 0;
+    while (!tree.empty()) {
+      testNode *node = dynamic_cast<testNode *>(tree.top());
+      assert (node);
+      assert (!node->isStored());
+      assert (node->intact(10 + node->getDepth()));
+      assert (node->getQuality() >= lastQuality);
+      lastQuality = node->getQuality();
+      tree.pop();
+      numberPopped++;
+    }
+    assert (numberPopped == numberNodes);
+    assert (!store.numberRecords());
+    for (int i = 0; i < numberNodes; i++)
+      delete nodes[i];
+  }
+}
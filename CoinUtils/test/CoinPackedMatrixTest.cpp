@@ -12,10 +12,24 @@
 #endif
 
 #include <cassert>
+#include <utility>
 
 #include "CoinFloatEqual.hpp"
 #include "CoinPackedVector.hpp"
 #include "CoinPackedMatrix.hpp"
+#include "CoinPackedMatrixProduct.hpp"
+#include "CoinPackedMatrixCompressed.hpp"
+#include "CoinPackedMatrixSliced.hpp"
+#include "CoinPackedMatrixDuplicates.hpp"
+#include "CoinPackedMatrixScaling.hpp"
+#include "CoinPackedMatrixView.hpp"
+#include "CoinPackedMatrixStructure.hpp"
+#include "CoinPackedMatrixSymmetry.hpp"
+#include "CoinPackedMatrixOrdering.hpp"
+#include "CoinPackedMatrix64.hpp"
+#include "CoinSort.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinDenseFactorization.hpp"
 
 //#############################################################################
 
@@ -624,11 +638,1375 @@ CoinPackedMatrixUnitTest()
       assert( pmtro.getVectorStarts()[5]==14 );
       assert(globalP->isEquivalent(pmtro));
 
+      // Test threaded products against serial ones
+      {
+	double x[8] = { 1.0, -2.0, 0.0, 3.5, 1.0, -1.0, 2.0, 0.5 };
+	double xt[5] = { 1.0, 0.0, -0.5, 2.0, 3.0 };
+	double y[5], yp[5], z[8], zp[8];
+	pmtco.times(x,y);
+	pmtco.transposeTimes(xt,z);
+	for (int det = 0; det < 4; det++) {
+	  for (int nThreads = 1; nThreads <= 3; nThreads++) {
+	    CoinPackedMatrixProduct product(pmtco,nThreads,(det&1)!=0);
+	    // each thread with own copy of its block
+	    if (det > 1) {
+	      int cpu[3] = { 0, 0, 0 };
+	      product.setThreadCpus(cpu);
+	      product.setPlacement(CoinPackedMatrixProduct::placePartitioned);
+	    }
+	    product.times(x,yp);
+	    product.transposeTimes(xt,zp);
+	    int i;
+	    for (i = 0; i < 5; i++) {
+	      assert( eq(y[i],yp[i]) );
+	      assert( !(det&1) || y[i]==yp[i] );
+	    }
+	    for (i = 0; i < 8; i++)
+	      assert( z[i]==zp[i] );
+	    // two interleaved vectors (second is twice first) at once
+	    double xb[16], xtb[10], yb[10], zb[16];
+	    for (i = 0; i < 8; i++) {
+	      xb[2*i] = x[i];
+	      xb[2*i+1] = 2.0*x[i];
+	    }
+	    for (i = 0; i < 5; i++) {
+	      xtb[2*i] = xt[i];
+	      xtb[2*i+1] = 2.0*xt[i];
+	    }
+	    product.timesBatch(2,xb,yb);
+	    product.transposeTimesBatch(2,xtb,zb);
+	    for (i = 0; i < 5; i++)
+	      assert( yb[2*i]==yp[i] && yb[2*i+1]==2.0*yp[i] );
+	    for (i = 0; i < 8; i++)
+	      assert( zb[2*i]==zp[i] && zb[2*i+1]==2.0*zp[i] );
+	    CoinPackedMatrixProduct productRow(pmtro,nThreads,(det&1)!=0);
+	    if (det > 1)
+	      productRow.setPlacement(CoinPackedMatrixProduct::placePartitioned);
+	    productRow.times(x,yp);
+	    for (i = 0; i < 5; i++)
+	      assert( y[i]==yp[i] );
+	  }
+	}
+      }
+
+      // Test dual orientation against a fresh reverse copy after each change
+      {
+	CoinPackedMatrix m(pmtco);
+	m.setExtraGap(0.5);
+	m.setExtraMajor(0.5);
+	m.setDualOrientation(true);
+	const CoinPackedMatrix * reverse = m.getReverseOrderedCopy();
+	assert( reverse && !reverse->isColOrdered() );
+	for (int pass = 0; pass < 6; pass++) {
+	  if (pass == 1) {
+	    CoinBigIndex starts[3] = { 0, 2, 3 };
+	    int cols[3] = { 1, 6, 4 };
+	    double els[3] = { 1.5, -2.5, 4.0 };
+	    m.appendRows(2, starts, cols, els);
+	  } else if (pass == 2) {
+	    int del[2] = { 0, 5 };
+	    m.deleteRows(2, del);
+	  } else if (pass == 3) {
+	    m.modifyCoefficient(1, 1, 7.0);
+	    m.modifyCoefficient(0, 3, 0.0);
+	    m.modifyCoefficient(2, 7, -1.0);
+	  } else if (pass == 4) {
+	    CoinBigIndex starts[2] = { 0, 2 };
+	    int rows[2] = { 0, 3 };
+	    double els[2] = { 9.0, 8.0 };
+	    m.appendCols(1, starts, rows, els);
+	  } else if (pass == 5) {
+	    int del[1] = { 2 };
+	    m.deleteCols(1, del);
+	  }
+	  // updates are incremental - the copy is not rebuilt
+	  assert( m.getReverseOrderedCopy() == reverse );
+	  CoinPackedMatrix fresh;
+	  fresh.reverseOrderedCopyOf(m);
+	  assert( reverse->getNumRows() == fresh.getNumRows() );
+	  assert( reverse->getNumCols() == fresh.getNumCols() );
+	  assert( reverse->getNumElements() == fresh.getNumElements() );
+	  for (int iRow = 0; iRow < m.getNumRows(); iRow++) {
+	    for (int iColumn = 0; iColumn < m.getNumCols(); iColumn++)
+	      assert( reverse->getCoefficient(iRow,iColumn) ==
+		      m.getCoefficient(iRow,iColumn) );
+	  }
+	}
+	m.transpose();
+	assert( m.getReverseOrderedCopy() != NULL );
+	assert( m.getReverseOrderedCopy()->isColOrdered() != m.isColOrdered() );
+	m.setDualOrientation(false);
+	assert( !m.getReverseOrderedCopy() );
+      }
+
+      // Threaded reverse ordered copy must match the serial one exactly
+      {
+	const int numberColumns = 20000;
+	const int numberRows = 3000;
+	const CoinBigIndex numberElements = 12*numberColumns;
+	int * rows = new int [numberElements];
+	int * columns = new int [numberElements];
+	double * elements = new double [numberElements];
+	for (CoinBigIndex k = 0; k < numberElements; k++) {
+	  rows[k] = static_cast<int>((k*7919)%numberRows);
+	  columns[k] = static_cast<int>(k%numberColumns);
+	  elements[k] = static_cast<double>(k+1);
+	}
+	CoinPackedMatrix big(true,rows,columns,elements,numberElements);
+	delete [] rows;
+	delete [] columns;
+	delete [] elements;
+	const int saveThreads = CoinPackedMatrix::transposeThreads();
+	CoinPackedMatrix serial;
+	serial.setExtraGap(0.25);
+	CoinPackedMatrix::setTransposeThreads(1);
+	serial.reverseOrderedCopyOf(big);
+	CoinPackedMatrix threaded;
+	threaded.setExtraGap(0.25);
+	CoinPackedMatrix::setTransposeThreads(3);
+	threaded.reverseOrderedCopyOf(big);
+	CoinPackedMatrix::setTransposeThreads(saveThreads);
+	assert( serial.getMajorDim() == threaded.getMajorDim() );
+	assert( serial.getNumElements() == threaded.getNumElements() );
+	for (int i = 0; i < serial.getMajorDim(); i++) {
+	  const CoinBigIndex start = serial.getVectorStarts()[i];
+	  assert( start == threaded.getVectorStarts()[i] );
+	  assert( serial.getVectorLengths()[i] == threaded.getVectorLengths()[i] );
+	  for (CoinBigIndex j = start; j < start+serial.getVectorLengths()[i]; j++) {
+	    assert( serial.getIndices()[j] == threaded.getIndices()[j] );
+	    assert( serial.getElements()[j] == threaded.getElements()[j] );
+	    assert( j == start || serial.getIndices()[j-1] < serial.getIndices()[j] );
+	  }
+	}
+      }
+
+      // Threaded clean up must match the serial one exactly
+      {
+	const int numberColumns = 20000;
+	const int numberRows = 3000;
+	const int numberPerColumn = 12;
+	CoinBigIndex * start = new CoinBigIndex [numberColumns+1];
+	int * length = new int [numberColumns];
+	int * rows = new int [numberPerColumn*numberColumns];
+	double * elements = new double [numberPerColumn*numberColumns];
+	CoinBigIndex k = 0;
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  start[iColumn] = k;
+	  length[iColumn] = numberPerColumn;
+	  for (int j = 0; j < numberPerColumn; j++) {
+	    // some duplicates (which may cancel) and some tiny elements
+	    rows[k] = (j%5 == 4) ? rows[k-1]
+	      : static_cast<int>((k*7919)%numberRows);
+	    if (j%5 == 4 && iColumn%3 == 0)
+	      elements[k] = -elements[k-1];
+	    else if ((k%11) == 0)
+	      elements[k] = 1.0e-25;
+	    else
+	      elements[k] = static_cast<double>(k%97) - 48.5;
+	    k++;
+	  }
+	}
+	start[numberColumns] = k;
+	CoinPackedMatrix big(true,numberRows,numberColumns,k,
+			     elements,rows,start,length);
+	delete [] start;
+	delete [] length;
+	delete [] rows;
+	delete [] elements;
+	const int saveThreads = CoinPackedMatrix::cleanThreads();
+	// compress, eliminateDuplicates, removeGaps with and without value
+	// (after compress leaves gaps) and cleanMatrix
+	for (int type = 0; type < 5; type++) {
+	  CoinPackedMatrix serial(big);
+	  CoinPackedMatrix threaded(big);
+	  CoinBigIndex number[2] = {0, 0};
+	  for (int pass = 0; pass < 2; pass++) {
+	    CoinPackedMatrix & matrix = pass ? threaded : serial;
+	    CoinPackedMatrix::setCleanThreads(pass ? 3 : 1);
+	    if (type == 0) {
+	      number[pass] = matrix.compress(1.0e-20);
+	    } else if (type == 1) {
+	      number[pass] = matrix.eliminateDuplicates(1.0e-20);
+	    } else if (type == 2 || type == 3) {
+	      matrix.compress(1.0e-20);
+	      matrix.removeGaps(type == 2 ? -1.0 : 10.0);
+	    } else {
+	      number[pass] = matrix.cleanMatrix();
+	    }
+	  }
+	  CoinPackedMatrix::setCleanThreads(saveThreads);
+	  assert( number[0] == number[1] );
+	  assert( type == 2 || type == 3 || number[0] > 0 );
+	  assert( serial.getNumElements() == threaded.getNumElements() );
+	  for (int i = 0; i <= serial.getMajorDim(); i++)
+	    assert( serial.getVectorStarts()[i] == threaded.getVectorStarts()[i] );
+	  for (int i = 0; i < serial.getMajorDim(); i++) {
+	    const CoinBigIndex first = serial.getVectorStarts()[i];
+	    assert( serial.getVectorLengths()[i] == threaded.getVectorLengths()[i] );
+	    for (CoinBigIndex j = first; j < first+serial.getVectorLengths()[i]; j++) {
+	      assert( serial.getIndices()[j] == threaded.getIndices()[j] );
+	      assert( serial.getElements()[j] == threaded.getElements()[j] );
+	    }
+	  }
+	}
+      }
+
+      // Compressed copies must give exactly the same products
+      {
+	const int numberColumns = 500;
+	const int numberRows = 300;
+	const CoinBigIndex numberElements = 6*numberColumns;
+	int * rows = new int [numberElements];
+	int * columns = new int [numberElements];
+	double * elements = new double [numberElements];
+	double * x = new double [numberColumns];
+	double * xRow = new double [numberRows];
+	double * y1 = new double [numberColumns];
+	double * y2 = new double [numberColumns];
+	for (int i = 0; i < numberColumns; i++)
+	  x[i] = (i%7) ? 0.5*i - 17.25 : 0.0;
+	for (int i = 0; i < numberRows; i++)
+	  xRow[i] = (i%5) ? 1.0/(i+1) : 0.0;
+	// +-1, all ones, a constant and many values (two byte codes)
+	for (int type = 0; type < 4; type++) {
+	  for (CoinBigIndex k = 0; k < numberElements; k++) {
+	    columns[k] = static_cast<int>(k%numberColumns);
+	    rows[k] = static_cast<int>((columns[k]+50*(k/numberColumns))%numberRows);
+	    if (type == 0)
+	      elements[k] = (k%3) ? 1.0 : -1.0;
+	    else if (type == 1)
+	      elements[k] = 1.0;
+	    else if (type == 2)
+	      elements[k] = 2.5;
+	    else
+	      elements[k] = static_cast<double>(k%1000) - 499.5;
+	  }
+	  const int expected[4] = { 2, 1, 1, 1000 };
+	  for (int ordered = 0; ordered < 2; ordered++) {
+	    CoinPackedMatrix matrix(ordered == 0,rows,columns,elements,
+				    numberElements);
+	    assert( CoinPackedMatrixCompressed::countValues(matrix) ==
+		    expected[type] );
+	    assert( CoinPackedMatrixCompressed::countValues(matrix,999) ==
+		    (type == 3 ? -1 : expected[type]) );
+	    CoinPackedMatrixCompressed compressed(matrix);
+	    assert( compressed.numberValues() == expected[type] );
+	    assert( compressed.allOnes() == (type == 1) );
+	    assert( compressed.getNumRows() == matrix.getNumRows() );
+	    assert( compressed.getNumCols() == matrix.getNumCols() );
+	    assert( compressed.memoryBytes() <
+		    static_cast<size_t>(numberElements)*
+		    (sizeof(int)+sizeof(double)) );
+	    CoinPackedMatrixCompressed copy;
+	    copy = compressed;
+	    matrix.times(x,y1);
+	    copy.times(x,y2);
+	    for (int i = 0; i < numberRows; i++)
+	      assert( y1[i] == y2[i] );
+	    matrix.transposeTimes(xRow,y1);
+	    copy.transposeTimes(xRow,y2);
+	    for (int i = 0; i < numberColumns; i++)
+	      assert( y1[i] == y2[i] );
+	    CoinPackedMatrix * expanded = copy.expand();
+	    assert( expanded->isColOrdered() == matrix.isColOrdered() );
+	    assert( expanded->getNumElements() == matrix.getNumElements() );
+	    for (int i = 0; i < matrix.getMajorDim(); i++) {
+	      const CoinBigIndex start = matrix.getVectorStarts()[i];
+	      const CoinBigIndex startE = expanded->getVectorStarts()[i];
+	      assert( matrix.getVectorLengths()[i] ==
+		      expanded->getVectorLengths()[i] );
+	      for (int j = 0; j < matrix.getVectorLengths()[i]; j++) {
+		assert( matrix.getIndices()[start+j] ==
+			expanded->getIndices()[startE+j] );
+		assert( matrix.getElements()[start+j] ==
+			expanded->getElements()[startE+j] );
+	      }
+	    }
+	    delete expanded;
+	  }
+	}
+	delete [] rows;
+	delete [] columns;
+	delete [] elements;
+	delete [] x;
+	delete [] xRow;
+	delete [] y1;
+	delete [] y2;
+      }
+
+      // Sliced copies - integer data so sums are exact in any order
+      {
+	const int numberColumns = 333;
+	const int numberRows = 101;
+	const int numberVectors = 3;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	int rows[numberRows];
+	double elements[numberRows];
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  // lengths from 0 to 40
+	  const int n = (iColumn*17)%41;
+	  for (int j = 0; j < n; j++) {
+	    rows[j] = (iColumn + 2*j)%numberRows;
+	    elements[j] = static_cast<double>((iColumn+j)%9) - 4.0;
+	  }
+	  CoinSort_2(rows,rows+n,elements);
+	  matrix.appendCol(n,rows,elements);
+	}
+	double * x = new double [numberVectors*numberColumns];
+	double * xRow = new double [numberVectors*numberRows];
+	double * y1 = new double [numberVectors*numberColumns];
+	double * y2 = new double [numberVectors*numberColumns];
+	for (int i = 0; i < numberVectors*numberColumns; i++)
+	  x[i] = static_cast<double>(i%13) - 6.0;
+	for (int i = 0; i < numberVectors*numberRows; i++)
+	  xRow[i] = static_cast<double>(i%7) - 2.0;
+	const int heights[3] = { 1, 4, 8 };
+	for (int ordered = 0; ordered < 2; ordered++) {
+	  if (ordered)
+	    matrix.reverseOrdering();
+	  for (int iHeight = 0; iHeight < 3; iHeight++) {
+	    for (int window = 1; window <= 64; window *= 64) {
+	      CoinPackedMatrixSliced sliced(matrix,heights[iHeight],
+					    heights[iHeight]*window);
+	      assert( sliced.getNumRows() == numberRows );
+	      assert( sliced.getNumCols() == numberColumns );
+	      assert( sliced.rowPaddedElements() >= matrix.getNumElements() );
+	      assert( sliced.columnPaddedElements() >= matrix.getNumElements() );
+	      if (heights[iHeight] == 1) {
+		assert( sliced.rowPaddedElements() == matrix.getNumElements() );
+	      }
+	      CoinPackedMatrixSliced copy(sliced);
+	      for (int v = 0; v < numberVectors; v++)
+		matrix.times(x+v*numberColumns,y1+v*numberRows);
+	      copy.times(x,y2);
+	      for (int i = 0; i < numberRows; i++)
+		assert( y1[i] == y2[i] );
+	      copy.timesMultiple(numberVectors,x,y2);
+	      for (int i = 0; i < numberVectors*numberRows; i++)
+		assert( y1[i] == y2[i] );
+	      for (int v = 0; v < numberVectors; v++)
+		matrix.transposeTimes(xRow+v*numberRows,y1+v*numberColumns);
+	      copy.transposeTimes(xRow,y2);
+	      for (int i = 0; i < numberColumns; i++)
+		assert( y1[i] == y2[i] );
+	      copy.transposeTimesMultiple(numberVectors,xRow,y2);
+	      for (int i = 0; i < numberVectors*numberColumns; i++)
+		assert( y1[i] == y2[i] );
+	    }
+	  }
+	}
+	CoinPackedMatrixSliced empty;
+	assert( empty.getNumRows() == 0 && empty.rowPaddedElements() == 0 );
+	delete [] x;
+	delete [] xRow;
+	delete [] y1;
+	delete [] y2;
+      }
+
+      // Sparse products into indexed vectors (integer data so exact)
+      {
+	const int numberColumns = 400;
+	const int numberRows = 250;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	int rows[5];
+	double elements[5];
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  for (int j = 0; j < 5; j++) {
+	    rows[j] = (iColumn + 50*j)%numberRows;
+	    elements[j] = (j&1) ? 1.0 : -1.0;
+	  }
+	  CoinSort_2(rows,rows+5,elements);
+	  matrix.appendCol(5,rows,elements);
+	}
+	double * dense = new double [numberColumns];
+	double * result = new double [numberColumns];
+	for (int pass = 0; pass < 8; pass++) {
+	  const bool transpose = (pass&1) != 0;
+	  const bool sparse = (pass&2) != 0;
+	  if (pass == 4) {
+	    matrix.reverseOrdering();
+	    matrix.setDualOrientation(true);
+	  }
+	  const int numberIn = transpose ? numberRows : numberColumns;
+	  const int numberOut = transpose ? numberColumns : numberRows;
+	  // x has cancelling pairs so some results are exactly zero
+	  CoinIndexedVector x(numberIn);
+	  CoinZeroN(dense,numberIn);
+	  for (int i = 0; i < numberIn; i += (sparse ? 37 : 2)) {
+	    dense[i] = (i%3) ? 2.0 : -3.0;
+	    x.insert(i,dense[i]);
+	  }
+	  if (pass >= 6) {
+	    // packed input
+	    CoinIndexedVector xPacked;
+	    xPacked.reserve(numberIn);
+	    for (int k = 0; k < x.getNumElements(); k++)
+	      xPacked.denseVector()[k] = x.denseVector()[x.getIndices()[k]];
+	    CoinMemcpyN(x.getIndices(),x.getNumElements(),
+			xPacked.getIndices());
+	    xPacked.setNumElements(x.getNumElements());
+	    xPacked.setPackedMode(true);
+	    x = xPacked;
+	  }
+	  CoinIndexedVector y(3);
+	  y.insert(1,5.0);
+	  if (transpose) {
+	    matrix.transposeTimes(dense,result);
+	    matrix.transposeTimes(x,y);
+	  } else {
+	    matrix.times(dense,result);
+	    matrix.times(x,y);
+	  }
+	  assert( y.capacity() >= numberOut );
+	  assert( !y.packedMode() );
+	  int numberNonZero = 0;
+	  for (int i = 0; i < numberOut; i++) {
+	    assert( y.denseVector()[i] == result[i] );
+	    if (result[i])
+	      numberNonZero++;
+	  }
+	  assert( y.getNumElements() == numberNonZero );
+	  for (int k = 0; k < y.getNumElements(); k++)
+	    assert( y.denseVector()[y.getIndices()[k]] != 0.0 );
+	}
+	delete [] dense;
+	delete [] result;
+      }
+
+      // Block append - appended rows go to a tail until compacted
+      {
+	const int numberColumns = 60;
+	const int numberRows = 30;
+	const int numberCuts = 25;
+	CoinPackedMatrix reference(true,0,0);
+	reference.setDimensions(numberRows,0);
+	int index[numberColumns];
+	double elements[numberColumns];
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  for (int j = 0; j < 4; j++) {
+	    index[j] = (iColumn + 7*j)%numberRows;
+	    elements[j] = static_cast<double>(j+1);
+	  }
+	  CoinSort_2(index,index+4,elements);
+	  reference.appendCol(4,index,elements);
+	}
+	for (int ordered = 0; ordered < 2; ordered++) {
+	  CoinPackedMatrix base(reference);
+	  CoinPackedMatrix full(reference);
+	  if (ordered) {
+	    // columns are minor vectors of a row ordered matrix
+	    base.reverseOrdering();
+	    full.reverseOrdering();
+	  }
+	  CoinPackedMatrix matrix(base);
+	  matrix.setDualOrientation(ordered == 0);
+	  matrix.setBlockAppend(true,100.0);
+	  const CoinBigIndex mainElements = matrix.getNumElements();
+	  const int numberMinor = matrix.getMinorDim();
+	  const int numberOther = matrix.getMajorDim();
+	  // some one at a time, some as a block
+	  CoinBigIndex starts[numberCuts+1];
+	  int * cutIndex = new int [numberCuts*numberOther];
+	  double * cutElement = new double [numberCuts*numberOther];
+	  starts[0] = 0;
+	  for (int iCut = 0; iCut < numberCuts; iCut++) {
+	    int n = 0;
+	    for (int i = iCut%3; i < numberOther; i += 5) {
+	      cutIndex[starts[iCut]+n] = i;
+	      cutElement[starts[iCut]+n] = static_cast<double>((i+iCut)%4) - 1.5;
+	      n++;
+	    }
+	    starts[iCut+1] = starts[iCut] + n;
+	  }
+	  for (int iCut = 0; iCut < numberCuts; iCut++) {
+	    const int n = static_cast<int>(starts[iCut+1]-starts[iCut]);
+	    const int * which = cutIndex+starts[iCut];
+	    const double * value = cutElement+starts[iCut];
+	    if (ordered)
+	      full.appendCol(n,which,value);
+	    else
+	      full.appendRow(n,which,value);
+	    if (iCut < 10) {
+	      if (ordered)
+		matrix.appendCol(n,which,value);
+	      else
+		matrix.appendRow(n,which,value);
+	    }
+	  }
+	  CoinBigIndex blockStarts[numberCuts+1];
+	  for (int iCut = 10; iCut <= numberCuts; iCut++)
+	    blockStarts[iCut-10] = starts[iCut] - starts[10];
+	  if (ordered)
+	    matrix.appendCols(numberCuts-10,blockStarts,cutIndex+starts[10],
+			      cutElement+starts[10],-1);
+	  else
+	    matrix.appendRows(numberCuts-10,blockStarts,cutIndex+starts[10],
+			      cutElement+starts[10],-1);
+	  delete [] cutIndex;
+	  delete [] cutElement;
+	  assert( matrix.getTail() != NULL );
+	  assert( matrix.getTail()->getMajorDim() == numberCuts );
+	  assert( matrix.getNumElements() == mainElements );
+	  assert( matrix.getMinorDim() == numberMinor + numberCuts );
+	  assert( matrix.getNumRows() == full.getNumRows() );
+	  assert( matrix.getNumCols() == full.getNumCols() );
+	  for (int pass = 0; pass < 2; pass++) {
+	    const int numberX = pass ? full.getNumRows() : full.getNumCols();
+	    const int numberY = pass ? full.getNumCols() : full.getNumRows();
+	    double * x = new double [numberX];
+	    double * y1 = new double [numberY];
+	    double * y2 = new double [numberY];
+	    CoinIndexedVector xVector(numberX);
+	    CoinIndexedVector yVector;
+	    for (int i = 0; i < numberX; i++) {
+	      x[i] = (i%4) ? static_cast<double>(i%7) - 3.0 : 0.0;
+	      if (x[i])
+		xVector.insert(i,x[i]);
+	    }
+	    if (pass) {
+	      full.transposeTimes(x,y1);
+	      matrix.transposeTimes(x,y2);
+	      matrix.transposeTimes(xVector,yVector);
+	    } else {
+	      full.times(x,y1);
+	      matrix.times(x,y2);
+	      matrix.times(xVector,yVector);
+	    }
+	    for (int i = 0; i < numberY; i++) {
+	      assert( y1[i] == y2[i] );
+	      assert( y1[i] == yVector.denseVector()[i] );
+	    }
+	    delete [] x;
+	    delete [] y1;
+	    delete [] y2;
+	  }
+	  for (int iRow = 0; iRow < full.getNumRows(); iRow++) {
+	    for (int iColumn = 0; iColumn < full.getNumCols(); iColumn++)
+	      assert( matrix.getCoefficient(iRow,iColumn) ==
+		      full.getCoefficient(iRow,iColumn) );
+	  }
+	  if (ordered == 0) {
+	    const CoinPackedMatrix * reverse = matrix.getReverseOrderedCopy();
+	    assert( reverse->getNumElements() == full.getNumElements() );
+	  }
+	  // copies are compacted
+	  CoinPackedMatrix copy(matrix);
+	  assert( !copy.getTail() );
+	  assert( copy.getNumElements() == full.getNumElements() );
+	  CoinPackedMatrix bottom(base);
+	  bottom.setBlockAppend(true,100.0);
+	  if (ordered)
+	    bottom.rightAppendPackedMatrix(matrix);
+	  else
+	    bottom.bottomAppendPackedMatrix(matrix);
+	  assert( bottom.getTail() &&
+		  bottom.getMinorDim() == 2*numberMinor + numberCuts );
+	  matrix.compactTail();
+	  assert( !matrix.getTail() );
+	  assert( matrix.getNumElements() == full.getNumElements() );
+	  for (int iRow = 0; iRow < full.getNumRows(); iRow++) {
+	    for (int iColumn = 0; iColumn < full.getNumCols(); iColumn++) {
+	      assert( matrix.getCoefficient(iRow,iColumn) ==
+		      full.getCoefficient(iRow,iColumn) );
+	      assert( copy.getCoefficient(iRow,iColumn) ==
+		      full.getCoefficient(iRow,iColumn) );
+	    }
+	  }
+	  // tail is compacted when it gets too big
+	  bottom.setBlockAppend(true,0.0);
+	  assert( !bottom.getTail() );
+	  assert( bottom.getNumElements() ==
+		  mainElements + full.getNumElements() );
+	}
+      }
+
+      // Duplicates - columns j and j+20 (j a multiple of 5) are the same
+      {
+	const int numberRows = 20;
+	const int numberColumns = 40;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  const int base = iColumn%20;
+	  int index[3];
+	  double elements[3];
+	  for (int j = 0; j < 3; j++) {
+	    index[j] = (base + 3*j)%numberRows;
+	    elements[j] = static_cast<double>(base + j);
+	  }
+	  if (iColumn >= 20 && (base%5) == 0) {
+	    // same column with entries in another order
+	    std::swap(index[0],index[2]);
+	    std::swap(elements[0],elements[2]);
+	  } else if (iColumn >= 20) {
+	    elements[1] += 0.5;
+	  }
+	  matrix.appendCol(3,index,elements);
+	}
+	CoinPackedMatrixDuplicates duplicates;
+	duplicates.setNumberThreads(2);
+	duplicates.findColumns(matrix);
+	assert( duplicates.numberCandidates() == numberColumns );
+	assert( duplicates.numberClasses() == 4 );
+	assert( duplicates.numberDuplicates() == 4 );
+	for (int iClass = 0; iClass < 4; iClass++) {
+	  const int * members = duplicates.classMembers() +
+	    duplicates.classStarts()[iClass];
+	  assert( duplicates.classStarts()[iClass+1] -
+		  duplicates.classStarts()[iClass] == 2 );
+	  assert( members[0] == 5*iClass && members[1] == 5*iClass + 20 );
+	}
+	// only some candidates
+	int candidates[3] = { 25, 7, 5 };
+	duplicates.findColumns(matrix,3,candidates);
+	assert( duplicates.numberClasses() == 1 );
+	assert( duplicates.classMembers()[0] == 5 &&
+		duplicates.classMembers()[1] == 25 );
+	assert( duplicates.hashes()[0] == duplicates.hashes()[2] );
+	assert( duplicates.hashes()[0] != duplicates.hashes()[1] );
+	// rows of the transpose
+	CoinPackedMatrix rowCopy;
+	rowCopy.reverseOrderedCopyOf(matrix);
+	rowCopy.transpose();
+	CoinPackedMatrixDuplicates copy(duplicates);
+	copy.findRows(rowCopy);
+	assert( copy.numberClasses() == 4 );
+	assert( copy.classMembers()[7] == 35 );
+	// -0.0 is the same as 0.0
+	int index[2] = { 1, 4 };
+	double elements[2] = { 0.0, 2.0 };
+	double negative[2] = { -0.0, 2.0 };
+	assert( CoinPackedMatrixDuplicates::hashVector(2,index,elements) ==
+		CoinPackedMatrixDuplicates::hashVector(2,index,negative) );
+      }
+
+      // Scaling - rows and columns multiplied by wide range of powers of two
+      {
+	const int numberRows = 15;
+	const int numberColumns = 25;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  int index[4];
+	  double elements[4];
+	  int n = 0;
+	  for (int iRow = iColumn%3; iRow < numberRows; iRow += 4) {
+	    index[n] = iRow;
+	    elements[n++] = ldexp(static_cast<double>(1 + (iRow+iColumn)%3),
+				  3*iRow - 2*iColumn);
+	  }
+	  matrix.appendCol(n,index,elements);
+	}
+	matrix.setDualOrientation(true);
+	double x[numberColumns];
+	double xRow[numberRows];
+	for (int i = 0; i < numberColumns; i++)
+	  x[i] = static_cast<double>(i%5) - 2.0;
+	for (int i = 0; i < numberRows; i++)
+	  xRow[i] = static_cast<double>(i%3) - 1.0;
+	for (int iMethod = 0; iMethod < 3; iMethod++) {
+	  CoinPackedMatrixScaling scaling(
+	    static_cast<CoinPackedMatrixScaling::Method>(iMethod));
+	  scaling.setNumberThreads(2);
+	  scaling.findScales(matrix);
+	  assert( scaling.getNumRows() == numberRows );
+	  assert( scaling.ratioAfter() < 1.0e-3 * scaling.ratioBefore() );
+	  for (int i = 0; i < numberColumns; i++) {
+	    int exponent;
+	    assert( frexp(scaling.columnScale()[i],&exponent) == 0.5 );
+	  }
+	  // lazy and in place give exactly the same
+	  double y1[numberColumns];
+	  double y2[numberColumns];
+	  CoinPackedMatrix scaled(matrix);
+	  scaling.scale(scaled);
+	  scaling.times(matrix,x,y1);
+	  scaled.times(x,y2);
+	  for (int i = 0; i < numberRows; i++)
+	    assert( y1[i] == y2[i] );
+	  scaling.transposeTimes(matrix,xRow,y1);
+	  scaled.transposeTimes(xRow,y2);
+	  for (int i = 0; i < numberColumns; i++)
+	    assert( y1[i] == y2[i] );
+	  // unscaling is exact
+	  CoinPackedMatrixScaling copy(scaling);
+	  copy.unscale(scaled);
+	  for (int iRow = 0; iRow < numberRows; iRow++) {
+	    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+	      assert( scaled.getCoefficient(iRow,iColumn) ==
+		      matrix.getCoefficient(iRow,iColumn) );
+	  }
+	}
+	// equilibrium without rounding - largest in each column is one
+	CoinPackedMatrixScaling scaling(CoinPackedMatrixScaling::equilibrium);
+	scaling.setPowerOfTwo(false);
+	scaling.findScales(matrix);
+	CoinPackedMatrix scaled(matrix);
+	scaling.scale(scaled);
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  const CoinShallowPackedVector column = scaled.getVector(iColumn);
+	  double largest = 0.0;
+	  for (int j = 0; j < column.getNumElements(); j++)
+	    largest = CoinMax(largest,fabs(column.getElements()[j]));
+	  assert( fabs(largest - 1.0) < 1.0e-12 );
+	}
+	CoinPackedMatrix wrong(true,0,0);
+	bool thrown = false;
+	try {
+	  scaling.scale(wrong);
+	}
+	catch (CoinError &) {
+	  thrown = true;
+	}
+	assert( thrown );
+      }
+
+      // Views - same as submatrixOf without copying
+      {
+	const int numberRows = 12;
+	const int numberColumns = 18;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  int index[3];
+	  double elements[3];
+	  for (int j = 0; j < 3; j++) {
+	    index[j] = (iColumn + 4*j)%numberRows;
+	    elements[j] = static_cast<double>(iColumn - j);
+	  }
+	  matrix.appendCol(3,index,elements);
+	}
+	const int columns[5] = { 3, 17, 3, 0, 9 };
+	const int rows[6] = { 7, 0, 3, 11, 4, 8 };
+	const int minorColumns[5] = { 17, 3, 0, 9, 12 };
+	for (int ordered = 0; ordered < 2; ordered++) {
+	  CoinPackedMatrix parent(matrix);
+	  if (ordered)
+	    parent.reverseOrdering();
+	  // all of minor dimension - same as submatrixOfWithDuplicates
+	  const int * major = ordered ? rows : columns;
+	  const int numberMajor = ordered ? 6 : 5;
+	  CoinPackedMatrixView view(parent,numberMajor,major);
+	  CoinPackedMatrix sub;
+	  sub.submatrixOfWithDuplicates(parent,numberMajor,major);
+	  assert( view.getNumElements() == sub.getNumElements() );
+	  assert( view.getNumRows() == sub.getNumRows() );
+	  assert( view.getNumCols() == sub.getNumCols() );
+	  for (int i = 0; i < numberMajor; i++)
+	    assert( view.getVector(i) == sub.getVector(i) );
+	  // rows and columns chosen
+	  CoinPackedMatrixView both(parent,numberMajor,major,
+				    ordered ? 5 : 6,
+				    ordered ? minorColumns : rows);
+	  CoinPackedMatrix copy;
+	  both.materialize(copy);
+	  assert( copy.getNumElements() == both.getNumElements() );
+	  assert( copy.isColOrdered() == parent.isColOrdered() );
+	  const int numberX = CoinMax(both.getNumCols(),both.getNumRows());
+	  double x[numberColumns];
+	  double y1[numberColumns];
+	  double y2[numberColumns];
+	  for (int i = 0; i < numberX; i++)
+	    x[i] = static_cast<double>(i%4) - 1.0;
+	  both.times(x,y1);
+	  copy.times(x,y2);
+	  for (int i = 0; i < both.getNumRows(); i++)
+	    assert( y1[i] == y2[i] );
+	  CoinPackedMatrixView other(both);
+	  other.transposeTimes(x,y1);
+	  copy.transposeTimes(x,y2);
+	  for (int i = 0; i < both.getNumCols(); i++)
+	    assert( y1[i] == y2[i] );
+	  for (int i = 0; i < numberMajor; i++)
+	    assert( both.getVector(i) == copy.getVector(i) );
+	}
+	bool thrown = false;
+	try {
+	  const int repeated[2] = { 1, 1 };
+	  CoinPackedMatrixView bad(matrix,2,columns,2,repeated);
+	}
+	catch (CoinError &) {
+	  thrown = true;
+	}
+	assert( thrown );
+      }
+
+      // Structure - components, transversal and block triangular form
+      {
+	// three blocks of columns (interleaved) joined by last row
+	const int numberRows = 7;
+	const int numberColumns = 9;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  const int iBlock = iColumn%3;
+	  int index[3] = { 2*iBlock, 2*iBlock + 1, 6 };
+	  double elements[3] = { 1.0, 2.0, 3.0 };
+	  matrix.appendCol(iColumn < 3 ? 3 : 2,index,elements);
+	}
+	CoinPackedMatrixStructure structure;
+	assert( structure.findComponents(matrix) == 1 );
+	char ignore[numberRows] = { 0, 0, 0, 0, 0, 0, 1 };
+	assert( structure.findComponents(matrix,ignore) == 3 );
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+	  assert( structure.columnComponent()[iColumn] == iColumn%3 );
+	for (int iRow = 0; iRow < numberRows; iRow++)
+	  assert( structure.rowComponent()[iRow] ==
+		  (iRow < 6 ? iRow/2 : -1) );
+	assert( structure.findTransversal(matrix) == numberRows );
+	// 2 by 2 block, row 2 also in column 0, column 3 only in row 0
+	CoinPackedMatrix small(true,0,0);
+	small.setDimensions(3,0);
+	int index01[2] = { 0, 1 };
+	int index02[3] = { 0, 1, 2 };
+	int index2[1] = { 2 };
+	double ones[3] = { 1.0, 1.0, 1.0 };
+	small.appendCol(3,index02,ones);
+	small.appendCol(2,index01,ones);
+	small.appendCol(1,index2,ones);
+	assert( structure.findBlockTriangular(small) == 2 );
+	assert( structure.numberMatched() == 3 );
+	assert( structure.columnOrder()[0] == 2 );
+	assert( structure.rowOrder()[0] == 2 );
+	assert( structure.columnBlockStart()[1] == 1 );
+	// another column in row 2 makes row 2 under-determined
+	small.appendCol(1,index2,ones);
+	assert( structure.findBlockTriangular(small) == 1 );
+	assert( structure.numberMatched() == 3 );
+	assert( structure.rowBlockStart()[0] == 1 );
+	assert( structure.columnBlockStart()[0] == 2 );
+	assert( structure.rowOrder()[0] == 2 );
+	// bigger one - check form
+	for (int ordered = 0; ordered < 2; ordered++) {
+	  const int n = 40;
+	  CoinPackedMatrix big(true,0,0);
+	  big.setDimensions(n-3,0);
+	  for (int iColumn = 0; iColumn < n; iColumn++) {
+	    int index[3];
+	    int k = 0;
+	    for (int j = 0; j < 3; j++) {
+	      const int iRow = (iColumn*(j+3) + 7*j)%(n-3);
+	      if (iColumn%5 == 4 && j)
+		continue;
+	      if (!k || index[k-1] != iRow)
+		index[k++] = iRow;
+	    }
+	    if (k == 3 && index[2] == index[0])
+	      k = 2;
+	    big.appendCol(k,index,ones);
+	  }
+	  if (ordered)
+	    big.reverseOrdering();
+	  CoinPackedMatrixStructure copy;
+	  copy.findBlockTriangular(big);
+	  CoinPackedMatrixStructure other(copy);
+	  const int numberBlocks = other.numberBlocks();
+	  const int * rowOrder = other.rowOrder();
+	  const int * columnOrder = other.columnOrder();
+	  const int * rowBlockStart = other.rowBlockStart();
+	  const int * columnBlockStart = other.columnBlockStart();
+	  int rowBlock[n];
+	  int columnBlock[n];
+	  // -1 under-determined part, numberBlocks over-determined part
+	  for (int i = 0; i < big.getNumRows(); i++) {
+	    int iBlock = numberBlocks;
+	    if (i < rowBlockStart[0])
+	      iBlock = -1;
+	    for (int k = 0; k < numberBlocks; k++) {
+	      if (i >= rowBlockStart[k] && i < rowBlockStart[k+1])
+		iBlock = k;
+	    }
+	    rowBlock[rowOrder[i]] = iBlock;
+	  }
+	  for (int i = 0; i < big.getNumCols(); i++) {
+	    int iBlock = numberBlocks;
+	    if (i < columnBlockStart[0])
+	      iBlock = -1;
+	    for (int k = 0; k < numberBlocks; k++) {
+	      if (i >= columnBlockStart[k] && i < columnBlockStart[k+1])
+		iBlock = k;
+	    }
+	    columnBlock[columnOrder[i]] = iBlock;
+	  }
+	  for (int iRow = 0; iRow < big.getNumRows(); iRow++) {
+	    for (int iColumn = 0; iColumn < n; iColumn++) {
+	      if (big.getCoefficient(iRow,iColumn))
+		assert( columnBlock[iColumn] >= rowBlock[iRow] );
+	    }
+	  }
+	  for (int iColumn = 0; iColumn < n; iColumn++) {
+	    const int iRow = other.columnMatch()[iColumn];
+	    if (iRow >= 0) {
+	      assert( big.getCoefficient(iRow,iColumn) );
+	      assert( other.rowMatch()[iRow] == iColumn );
+	    }
+	  }
+	}
+      }
+
+      // Symmetry - bin packing and a cycle (which refinement can not split)
+      {
+	// 3 bins, items 0 and 1 same size, then y for each bin
+	const int numberBins = 3;
+	const int numberItems = 4;
+	const int numberColumns = numberItems*numberBins + numberBins;
+	const int numberRows = numberItems + numberBins;
+	const double size[numberItems] = { 3.0, 3.0, 4.0, 5.0 };
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	double columnLower[numberColumns];
+	double columnUpper[numberColumns];
+	double objective[numberColumns];
+	char integerType[numberColumns];
+	for (int iItem = 0; iItem < numberItems; iItem++) {
+	  for (int iBin = 0; iBin < numberBins; iBin++) {
+	    int index[2] = { iItem, numberItems + iBin };
+	    double elements[2] = { 1.0, size[iItem] };
+	    matrix.appendCol(2,index,elements);
+	  }
+	}
+	for (int iBin = 0; iBin < numberBins; iBin++) {
+	  int index[1] = { numberItems + iBin };
+	  double elements[1] = { -10.0 };
+	  matrix.appendCol(1,index,elements);
+	}
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  columnLower[iColumn] = 0.0;
+	  columnUpper[iColumn] = 1.0;
+	  objective[iColumn] = iColumn < numberItems*numberBins ? 0.0 : 1.0;
+	  integerType[iColumn] = 1;
+	}
+	double rowLower[numberRows];
+	double rowUpper[numberRows];
+	for (int iRow = 0; iRow < numberRows; iRow++) {
+	  rowLower[iRow] = iRow < numberItems ? 1.0 : -COIN_DBL_MAX;
+	  rowUpper[iRow] = iRow < numberItems ? 1.0 : 0.0;
+	}
+	CoinPackedMatrixSymmetry symmetry;
+	assert( symmetry.find(matrix,columnLower,columnUpper,objective,
+			      integerType,rowLower,rowUpper) > 0 );
+	assert( symmetry.complete() );
+	assert( symmetry.numberOrbits() == 4 );
+	assert( symmetry.orbitStarts()[1] == 6 );
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  const int orbit = iColumn < 6 ? 0 : 3*(iColumn/3);
+	  assert( symmetry.columnOrbit()[iColumn] == orbit );
+	}
+	// generators keep data of columns
+	for (int k = 0; k < symmetry.generatorStarts()[symmetry.numberGenerators()];
+	     k++) {
+	  const int iColumn = symmetry.generatorColumns()[k];
+	  const int image = symmetry.generatorImages()[k];
+	  assert( objective[iColumn] == objective[image] );
+	  assert( matrix.getVectorLengths()[iColumn] ==
+		  matrix.getVectorLengths()[image] );
+	}
+	// item 0 a little bigger - only bins are symmetric
+	matrix.modifyCoefficient(numberItems,0,3.5);
+	matrix.modifyCoefficient(numberItems+1,1,3.5);
+	matrix.modifyCoefficient(numberItems+2,2,3.5);
+	symmetry.find(matrix,columnLower,columnUpper,objective,
+		      integerType,rowLower,rowUpper);
+	assert( symmetry.numberOrbits() == 5 );
+	assert( symmetry.columnOrbit()[1] == 0 && symmetry.columnOrbit()[3] == 3 );
+	// different costs - none
+	objective[numberColumns-1] = 2.0;
+	objective[numberColumns-2] = 3.0;
+	symmetry.find(matrix,columnLower,columnUpper,objective,
+		      integerType,rowLower,rowUpper);
+	assert( !symmetry.numberGenerators() );
+	assert( !symmetry.numberOrbits() );
+	// cycle - all columns alike until search
+	const int n = 7;
+	CoinPackedMatrix cycle(false,0,0);
+	cycle.setDimensions(0,n);
+	for (int i = 0; i < n; i++) {
+	  int index[2] = { i, (i+3)%n };
+	  double elements[2] = { 1.0, 1.0 };
+	  cycle.appendRow(2,index,elements);
+	}
+	symmetry.find(cycle,columnLower,columnUpper,objective,NULL,
+		      columnLower,columnUpper);
+	assert( symmetry.complete() );
+	assert( symmetry.numberOrbits() == 1 );
+	assert( symmetry.orbitStarts()[1] == n );
+	symmetry.setMaximumNodes(0);
+	symmetry.find(cycle,columnLower,columnUpper,objective,NULL,
+		      columnLower,columnUpper);
+	assert( !symmetry.complete() );
+	assert( !symmetry.numberOrbits() );
+      }
+
+      // 64 bit element counts - round trip and products
+      {
+	const int numberRows = 9;
+	const int numberColumns = 14;
+	CoinPackedMatrix matrix(true,0,0);
+	matrix.setDimensions(numberRows,0);
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+	  int index[3];
+	  double elements[3];
+	  const int number = 1 + iColumn%3;
+	  for (int j = 0; j < number; j++) {
+	    index[j] = (iColumn + 3*j)%numberRows;
+	    elements[j] = static_cast<double>(iColumn + 1 - 2*j);
+	  }
+	  matrix.appendCol(number,index,elements);
+	}
+	for (int ordered = 0; ordered < 2; ordered++) {
+	  CoinPackedMatrix parent(matrix);
+	  if (ordered)
+	    parent.reverseOrdering();
+	  // may leave gaps
+	  const int deleted = 2;
+	  parent.deleteRows(1,&deleted);
+	  CoinPackedMatrix64 wide(parent);
+	  assert( wide.fitsPackedMatrix() );
+	  assert( wide.getNumElements() == parent.getNumElements() );
+	  assert( wide.getNumRows() == parent.getNumRows() );
+	  assert( wide.getNumCols() == parent.getNumCols() );
+	  for (int i = 0; i < wide.getMajorDim(); i++)
+	    assert( wide.getVector(i) == parent.getVector(i) );
+	  CoinPackedMatrix back;
+	  CoinPackedMatrix64 other(wide);
+	  other.copyTo(back);
+	  assert( back.isEquivalent(parent) );
+	  double x[numberColumns];
+	  double y1[numberColumns];
+	  double y2[numberColumns];
+	  for (int i = 0; i < numberColumns; i++)
+	    x[i] = static_cast<double>(i%5) - 2.0;
+	  wide.times(x,y1);
+	  parent.times(x,y2);
+	  for (int i = 0; i < parent.getNumRows(); i++)
+	    assert( y1[i] == y2[i] );
+	  wide.transposeTimes(x,y1);
+	  parent.transposeTimes(x,y2);
+	  for (int i = 0; i < parent.getNumCols(); i++)
+	    assert( y1[i] == y2[i] );
+	  const int which[3] = { 4, 0, 4 };
+	  CoinPackedMatrix basis;
+	  wide.extractMajor(3,which,basis);
+	  CoinPackedMatrix sub;
+	  sub.submatrixOfWithDuplicates(parent,3,which);
+	  assert( basis.getNumElements() == sub.getNumElements() );
+	  for (int i = 0; i < 3; i++)
+	    assert( basis.getVector(i) == sub.getVector(i) );
+	}
+	CoinPackedMatrix64 built;
+	for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+	  built.appendMajorVector(matrix.getVectorSize(iColumn),
+				  matrix.getIndices()+matrix.getVectorFirst(iColumn),
+				  matrix.getElements()+matrix.getVectorFirst(iColumn));
+	built.setMinorDim(numberRows);
+	CoinPackedMatrix back;
+	built.copyTo(back);
+	assert( back.isEquivalent(matrix) );
+	bool thrown = false;
+	try {
+	  const int bad = -1;
+	  const double one = 1.0;
+	  built.appendMajorVector(1,&bad,&one);
+	}
+	catch (CoinError &) {
+	  thrown = true;
+	}
+	assert( thrown );
+      }
     }
     
     delete globalP;
   }
-  
+
+#if COIN_HAS_MOVE
+  {
+    // Moving takes the arrays of a matrix
+    const int rows[5] = {0, 2, 1, 0, 2};
+    const int columns[5] = {0, 0, 1, 2, 2};
+    const double elements[5] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    CoinPackedMatrix source(true, rows, columns, elements, 5);
+    CoinPackedMatrix copy(source);
+    const double * element = source.getElements();
+    CoinPackedMatrix moved(std::move(source));
+    assert( moved.getElements()==element );
+    assert( moved.isEquivalent(copy) );
+    assert( !source.getNumElements() && !source.getMajorDim() );
+    source = copy;
+    assert( source.isEquivalent(copy) );
+    CoinPackedMatrix other;
+    other = std::move(moved);
+    assert( other.getElements()==element && other.isEquivalent(copy) );
+    assert( !moved.getNumElements() );
+  }
+#endif
+
+  {
+    // Spans look at the same storage as getVector
+    const int rows[5] = {0, 2, 1, 0, 2};
+    const int columns[5] = {0, 0, 1, 2, 2};
+    const double elements[5] = {1.0, 2.0, 3.0, 4.0, 5.0};
+    CoinPackedMatrix matrix(true, rows, columns, elements, 5);
+    const double x[3] = {1.0, 10.0, 100.0};
+    double y[3] = {0.0, 0.0, 0.0};
+    double yIterated[3] = {0.0, 0.0, 0.0};
+    for (int iColumn = 0; iColumn < 3; iColumn++) {
+      CoinPackedVectorSpan span = matrix.getVectorSpan(iColumn);
+      CoinShallowPackedVector vector = matrix.getVector(iColumn);
+      assert( span.size()==vector.getNumElements() );
+      assert( span.indices()==vector.getIndices() );
+      assert( span.elements()==vector.getElements() );
+      assert( vector.span().indices()==span.indices() );
+      double sum = 0.0;
+      int count = 0;
+      for (CoinPackedVectorSpan::const_iterator it = span.begin();
+	   it != span.end(); ++it) {
+	assert( it->index==span.index(count) && it.value()==span.element(count) );
+	sum += x[it->index] * it->value;
+	count++;
+      }
+      assert( count==span.size() );
+      assert( sum==span.dot(x) );
+      span.addTo(x[iColumn], y);
+      for (int i = 0; i < vector.getNumElements(); i++)
+	yIterated[vector.getIndices()[i]] += x[iColumn] * vector.getElements()[i];
+    }
+    for (int iRow = 0; iRow < 3; iRow++)
+      assert( y[iRow]==yIterated[iRow] );
+#if COIN_HAS_MOVE
+    double total = 0.0;
+    for (auto entry : matrix.getVectorSpan(2))
+      total += entry.value;
+    assert( total==9.0 );
+#endif
+    assert( CoinPackedVectorSpan().empty() );
+#ifndef COIN_FAST_CODE
+    bool thrown = false;
+    try {
+      matrix.getVectorSpan(3);
+    }
+    catch (CoinError &) {
+      thrown = true;
+    }
+    assert( thrown );
+#endif
+  }
+
+  // Borrowed arrays are used in place and never freed
+  {
+    const double elem[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    const int ind[] = { 0, 2, 1, 0, 2 };
+    const CoinBigIndex start[] = { 0, 2, 3, 5 };
+    const int len[] = { 2, 1, 2 };
+    CoinPackedMatrix borrowed;
+    borrowed.borrowMatrix(true,3,3,5,elem,ind,start,len);
+    assert( borrowed.isBorrowed() );
+    assert( borrowed.getElements() == elem );
+    assert( borrowed.getVectorStarts() == start );
+    CoinPackedMatrix copy(true,3,3,5,elem,ind,start,len);
+    assert( !copy.isBorrowed() && copy.isEquivalent(borrowed) );
+    double x[] = { 1.0, 1.0, 1.0 };
+    double y[3];
+    borrowed.times(x,y);
+    assert( y[0] == 5.0 && y[1] == 3.0 && y[2] == 7.0 );
+    CoinPackedMatrix owned(borrowed);
+    assert( !owned.isBorrowed() && owned.getElements() != elem );
+    borrowed = owned;
+    assert( !borrowed.isBorrowed() && borrowed.getElements() != elem );
+  }
+
+  // Orderings - banded matrix with rows and columns scrambled
+  {
+    const int n = 2000;
+    CoinPackedMatrix scrambled(true,0,0);
+    scrambled.setDimensions(n,0);
+    // column (k*7919)%n is column k of band, row (j*3001)%n row j
+    int * whichColumn = new int [n];
+    for (int k = 0; k < n; k++)
+      whichColumn[(k*7919)%n] = k;
+    for (int iColumn = 0; iColumn < n; iColumn++) {
+      const int k = whichColumn[iColumn];
+      int rows[5];
+      double elements[5];
+      int number = 0;
+      for (int j = CoinMax(k-2,0); j <= CoinMin(k+2,n-1); j++) {
+	rows[number] = (j*3001)%n;
+	elements[number++] = 1.0 + 0.25*(j-k) + 0.001*k;
+      }
+      scrambled.appendCol(number,rows,elements);
+    }
+    delete [] whichColumn;
+    CoinPackedMatrixOrdering ordering;
+    const int before = CoinPackedMatrixOrdering::bandwidth(scrambled);
+    const int after = ordering.reverseCuthillMcKee(scrambled);
+    assert( after <= 20 && after < before );
+    CoinPackedMatrix ordered(scrambled);
+    ordering.apply(ordered);
+    assert( CoinPackedMatrixOrdering::bandwidth(ordered) == after );
+    assert( ordered.getNumElements() == scrambled.getNumElements() );
+    std::vector<double> x(n), y(n), xOrdered(n), yOrdered(n), yBack(n);
+    for (int i = 0; i < n; i++)
+      x[i] = static_cast<double>(i%13) - 6.0;
+    scrambled.times(&x[0],&y[0]);
+    ordering.orderColumns(&x[0],&xOrdered[0]);
+    ordered.times(&xOrdered[0],&yOrdered[0]);
+    ordering.unorderRows(&yOrdered[0],&yBack[0]);
+    for (int i = 0; i < n; i++)
+      assert( fabs(y[i] - yBack[i]) < 1.0e-10 );
+    ordering.orderRows(&y[0],&yBack[0]);
+    for (int i = 0; i < n; i++)
+      assert( fabs(yOrdered[i] - yBack[i]) < 1.0e-10 );
+    // row ordered copy the same way
+    CoinPackedMatrix byRow;
+    byRow.reverseOrderedCopyOf(scrambled);
+    ordering.apply(byRow);
+    assert( !byRow.isColOrdered() );
+    byRow.times(&xOrdered[0],&yBack[0]);
+    for (int i = 0; i < n; i++)
+      assert( fabs(yOrdered[i] - yBack[i]) < 1.0e-10 );
+
+    // four parts - a band has few cut rows
+    const int numberParts = 4;
+    const int numberCut = ordering.partition(scrambled,numberParts);
+    assert( ordering.numberParts() == numberParts );
+    assert( numberCut > 0 && numberCut <= 4*(numberParts-1) );
+    const int * columnPartStart = ordering.columnPartStart();
+    const int * rowPartStart = ordering.rowPartStart();
+    assert( columnPartStart[0] == 0 && columnPartStart[numberParts] == n );
+    assert( rowPartStart[numberParts] == n - numberCut );
+    assert( rowPartStart[numberParts+1] == n );
+    std::vector<int> part(n,-1);
+    for (int p = 0; p < numberParts; p++) {
+      CoinBigIndex weight = 0;
+      for (int k = columnPartStart[p]; k < columnPartStart[p+1]; k++) {
+	const int iColumn = ordering.columnOrder()[k];
+	assert( part[iColumn] < 0 );
+	part[iColumn] = p;
+	weight += scrambled.getVectorSize(iColumn) + 1;
+      }
+      assert( weight <= 1.03*(scrambled.getNumElements() + n)/numberParts + 6 );
+    }
+    CoinPackedMatrix rowOrdered;
+    rowOrdered.reverseOrderedCopyOf(scrambled);
+    for (int p = 0; p <= numberParts; p++) {
+      for (int k = rowPartStart[p]; k < rowPartStart[p+1]; k++) {
+	const CoinShallowPackedVector row =
+	  rowOrdered.getVector(ordering.rowOrder()[k]);
+	bool cut = false;
+	for (int j = 0; j < row.getNumElements(); j++) {
+	  if (part[row.getIndices()[j]] != part[row.getIndices()[0]])
+	    cut = true;
+	  else if (p < numberParts)
+	    assert( part[row.getIndices()[j]] == p );
+	}
+	assert( cut == (p == numberParts) );
+      }
+    }
+
+    // columns with same rows next to each other
+    {
+      const int rows[6][2] = { {1,3}, {0,2}, {1,3}, {2,4}, {1,3}, {0,2} };
+      CoinPackedMatrix small(true,0,0);
+      small.setDimensions(6,0);
+      const double elements[2] = { 1.0, -1.0 };
+      for (int iColumn = 0; iColumn < 6; iColumn++)
+	small.appendCol(2,rows[iColumn],elements);
+      small.appendCol(0,NULL,NULL);
+      ordering.clusterColumns(small);
+      const int * columnOrder = ordering.columnOrder();
+      const int expected[7] = { 1, 5, 0, 2, 4, 3, 6 };
+      for (int k = 0; k < 7; k++)
+	assert( columnOrder[k] == expected[k] );
+      const int * rowOrder = ordering.rowOrder();
+      const int expectedRows[6] = { 0, 2, 1, 3, 4, 5 };
+      for (int k = 0; k < 6; k++)
+	assert( rowOrder[k] == expectedRows[k] );
+      bool thrown = false;
+      try {
+	ordering.apply(scrambled);
+      }
+      catch (CoinError &) {
+	thrown = true;
+      }
+      assert( thrown );
+    }
+  }
+
+  // Batched dense factorization - residuals of both solves
+  {
+    const int numberMatrices = 11;
+    const int n = 9;
+    std::vector<double> dense(numberMatrices*n*n);
+    for (int m = 0; m < numberMatrices; m++) {
+      for (int j = 0; j < n; j++) {
+	for (int i = 0; i < n; i++) {
+	  double value = static_cast<double>((7*i + 3*j + 5*m + i*j)%11) - 5.0;
+	  if (i == (j + m)%n)
+	    value += 20.0; // well away from singular but needs pivoting
+	  dense[(m*n + j)*n + i] = value;
+	}
+      }
+    }
+    // matrix 5 has a zero column
+    for (int i = 0; i < n; i++)
+      dense[(5*n + 4)*n + i] = 0.0;
+    for (int threads = 1; threads < 4; threads += 2) {
+      CoinDenseBatchFactorization batch;
+      batch.setNumberThreads(threads);
+      batch.resize(numberMatrices,n);
+      assert( batch.numberGroups() == 3 );
+      for (int m = 0; m < numberMatrices; m++) {
+	if (m != 2) {
+	  batch.setMatrix(m,&dense[m*n*n],n);
+	} else {
+	  batch.clearMatrix(m);
+	  for (int j = 0; j < n; j++) {
+	    int rows[9];
+	    double elements[9];
+	    int number = 0;
+	    for (int i = 0; i < n; i++) {
+	      if (dense[(m*n + j)*n + i]) {
+		rows[number] = i;
+		elements[number++] = dense[(m*n + j)*n + i];
+	      }
+	    }
+	    batch.setColumn(m,j,number,rows,elements);
+	  }
+	}
+      }
+      assert( batch.elements()[batch.offset(7,3,4)] == dense[(7*n + 4)*n + 3] );
+      assert( batch.factor() == 1 );
+      for (int m = 0; m < numberMatrices; m++)
+	assert( batch.status(m) == (m == 5 ? 1 : 0) );
+      for (int transpose = 0; transpose < 2; transpose++) {
+	std::vector<double> rhs(batch.rhsLength());
+	for (int m = 0; m < numberMatrices; m++) {
+	  for (int i = 0; i < n; i++)
+	    rhs[batch.rhsOffset(m,i)] = static_cast<double>(i + m) - 4.0;
+	}
+	batch.solve(&rhs[0],transpose != 0);
+	for (int m = 0; m < numberMatrices; m++) {
+	  if (m == 5) {
+	    // dropped variable is zero
+	    if (!transpose)
+	      assert( rhs[batch.rhsOffset(m,4)] == 0.0 );
+	    continue;
+	  }
+	  for (int i = 0; i < n; i++) {
+	    double value = 0.0;
+	    for (int j = 0; j < n; j++) {
+	      double element = transpose ? dense[(m*n + i)*n + j]
+		: dense[(m*n + j)*n + i];
+	      value += element*rhs[batch.rhsOffset(m,j)];
+	    }
+	    assert( fabs(value - (static_cast<double>(i + m) - 4.0)) < 1.0e-9 );
+	  }
+	}
+      }
+    }
+  }
+
 #if 0
   {
     // test append
@@ -7,6 +7,7 @@
 #endif
 
 #include <cassert>
+#include <utility>
 
 #include "CoinPragma.hpp"
 #include "CoinFloatEqual.hpp"
@@ -1046,5 +1047,52 @@ CoinPackedVectorUnitTest()
 
   } 
 
+  // Small vectors are held inline, larger ones in one block - copies,
+  // growth and moves across the boundary
+  {
+    int inxBig[12];
+    double elBig[12];
+    for (i = 0; i < 12; i++) {
+      inxBig[i] = 3*i+1;
+      elBig[i] = 0.5*i-2.0;
+    }
+    CoinPackedVector small(3,inxBig,elBig);
+    assert( small.capacity()==3 );
+    CoinPackedVector grown(small);
+    for (i = 3; i < 12; i++)
+      grown.insert(inxBig[i],elBig[i]);
+    assert( grown.getNumElements()==12 );
+    for (i = 0; i < 12; i++) {
+      assert( grown.getIndices()[i]==inxBig[i] );
+      assert( grown.getElements()[i]==elBig[i] );
+      assert( grown.getOriginalPosition()[i]==i );
+    }
+    CoinPackedVector copy;
+    copy = grown;
+    assert( copy == grown );
+#if COIN_HAS_MOVE
+    CoinPackedVector moved(std::move(grown));
+    assert( moved == copy );
+    assert( grown.getNumElements()==0 && grown.capacity()==0 );
+    CoinPackedVector movedSmall(std::move(small));
+    assert( movedSmall.getNumElements()==3 );
+    assert( movedSmall[4]==elBig[1] );
+    moved = std::move(movedSmall);
+    assert( moved.getNumElements()==3 && moved.getMaxIndex()==7 );
+    moved.insert(100,1.0);
+    assert( moved.getNumElements()==4 );
+    bool errorThrown = false;
+    try {
+      moved.insert(100,1.0);
+    }
+    catch (CoinError& e) {
+      errorThrown = true;
+    }
+    assert( errorThrown );
+    movedSmall = std::move(copy);
+    assert( movedSmall.getNumElements()==12 );
+#endif
+  }
+
 }
 
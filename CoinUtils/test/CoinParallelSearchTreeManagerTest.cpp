@@ -0,0 +1,180 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinSearchTree.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+namespace {
+
+// Complete binary tree - node id has children 2*id+1 and 2*id+2
+const int maximumDepth = 12;
+const int numberNodes = (1 << (maximumDepth + 1)) - 1;
+
+class idNode : public CoinTreeNode {
+public:
+  idNode(int id, int depth, double quality)
+    : CoinTreeNode(depth, -1, quality), id_(id) {}
+  int id_;
+};
+
+// Bound worse than parent by an amount varying from node to node, so best
+// first jumps around the tree and tops of the workers differ
+idNode *child(const idNode *parent, int which)
+{
+  const int id = 2 * parent->id_ + 1 + which;
+  const unsigned int hash = static_cast<unsigned int>(id) * 2654435761u;
+  const double step = ((hash >> 8) & 1023) / 1024.0;
+  return new idNode(id, parent->getDepth() + 1,
+		    parent->getQuality() + 4.0 * step);
+}
+
+// Pushes children of node (if any) to worker w
+void branch(CoinParallelSearchTreeManager &pool, int w, const idNode *node)
+{
+  if (node->getDepth() == maximumDepth)
+    return;
+  CoinTreeNode *children[2];
+  children[0] = child(node, 0);
+  children[1] = child(node, 1);
+  pool.push(w, 2, children);
+}
+
+// Workers take turns in one thread - returns ids in order processed
+std::vector<int> searchInTurn(int numberWorkers, int &numberSteals)
+{
+  CoinParallelSearchTreeManager pool(numberWorkers);
+  pool.setRebalanceFrequency(3);
+  pool.push(0, new idNode(0, 0, 0.0));
+  std::vector<int> order;
+  for (int w = 0;; w = (w + 1) % numberWorkers) {
+    idNode *node = dynamic_cast<idNode *>(pool.pop(w));
+    // only one thread so nothing more can come
+    if (!node)
+      break;
+    order.push_back(node->id_);
+    branch(pool, w, node);
+    delete node;
+  }
+  assert(pool.empty() && !pool.size());
+  assert(pool.numInserted() == static_cast<size_t>(numberNodes));
+  assert(pool.bestQuality() == COIN_DBL_MAX);
+  numberSteals = 0;
+  for (int w = 0; w < numberWorkers; w++)
+    numberSteals += pool.numberSteals(w);
+  return order;
+}
+
+void checkOnce(const std::vector<int> &order)
+{
+  assert(static_cast<int>(order.size()) == numberNodes);
+  std::vector<int> visits(numberNodes, 0);
+  for (size_t i = 0; i < order.size(); i++) {
+    assert(order[i] >= 0 && order[i] < numberNodes);
+    visits[order[i]]++;
+  }
+  for (int i = 0; i < numberNodes; i++)
+    assert(visits[i] == 1);
+}
+
+#ifdef COINUTILS_PTHREADS
+const int numberThreads = 4;
+
+struct searchInfo {
+  CoinParallelSearchTreeManager *pool;
+  pthread_mutex_t mutex;
+  // nodes pushed and not yet processed
+  int outstanding;
+  std::vector<int> visits;
+};
+
+struct workerInfo {
+  searchInfo *search;
+  int w;
+};
+
+void *searchInThread(void *info)
+{
+  workerInfo *me = static_cast<workerInfo *>(info);
+  searchInfo *search = me->search;
+  for (;;) {
+    idNode *node = dynamic_cast<idNode *>(search->pool->pop(me->w));
+    if (node) {
+      pthread_mutex_lock(&search->mutex);
+      search->visits[node->id_]++;
+      // count children before they can be taken
+      if (node->getDepth() < maximumDepth)
+	search->outstanding += 2;
+      pthread_mutex_unlock(&search->mutex);
+      branch(*search->pool, me->w, node);
+      delete node;
+      pthread_mutex_lock(&search->mutex);
+      search->outstanding--;
+      pthread_mutex_unlock(&search->mutex);
+    } else {
+      // pool empty - finished only if no worker can push more
+      pthread_mutex_lock(&search->mutex);
+      const bool finished = !search->outstanding;
+      pthread_mutex_unlock(&search->mutex);
+      if (finished)
+	break;
+    }
+  }
+  return NULL;
+}
+#endif
+
+}	// end file-local namespace
+
+void CoinParallelSearchTreeManagerUnitTest()
+{
+  // one worker never steals
+  int numberSteals;
+  std::vector<int> order = searchInTurn(1, numberSteals);
+  checkOnce(order);
+  assert(!numberSteals);
+
+  // several workers - same order each time and work moves between them
+  order = searchInTurn(3, numberSteals);
+  checkOnce(order);
+  assert(numberSteals > 0);
+  int numberSteals2;
+  assert(searchInTurn(3, numberSteals2) == order);
+  assert(numberSteals2 == numberSteals);
+
+  // workers in threads - order varies but each node once
+#ifdef COINUTILS_PTHREADS
+  CoinParallelSearchTreeManager pool(numberThreads);
+  pool.setRebalanceFrequency(3);
+  searchInfo search;
+  search.pool = &pool;
+  pthread_mutex_init(&search.mutex, NULL);
+  search.outstanding = 1;
+  search.visits.assign(numberNodes, 0);
+  pool.push(0, new idNode(0, 0, 0.0));
+  workerInfo info[numberThreads];
+  pthread_t threads[numberThreads];
+  for (int i = 0; i < numberThreads; i++) {
+    info[i].search = &search;
+    info[i].w = i;
+    pthread_create(threads + i, NULL, searchInThread, info + i);
+  }
+  for (int i = 0; i < numberThreads; i++)
+    pthread_join(threads[i], NULL);
+  pthread_mutex_destroy(&search.mutex);
+  assert(!search.outstanding && pool.empty());
+  assert(pool.numInserted() == static_cast<size_t>(numberNodes));
+  for (int i = 0; i < numberNodes; i++)
+    assert(search.visits[i] == 1);
+#endif
+}
@@ -0,0 +1,165 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinParam.hpp"
+
+namespace {
+
+enum {
+  primalTolerance = 0,
+  primalSimplex,
+  nullParam,
+  maxNodes,
+  maxSolutions,
+  logLevel,
+  logFile,
+  direction,
+  solve,
+  solution,
+  query,
+  queryList,
+  duplicate1,
+  duplicate2
+};
+
+// Shared prefixes, short matches, a null, duplicates and help (`?')
+CoinParamVec testParams()
+{
+  CoinParamVec params;
+  params.push_back(new CoinParam("prim!alTolerance", "tolerance",
+				 0.0, 1.0, 1.0e-7));
+  params.push_back(new CoinParam("primalS!implex", "solve by primal"));
+  params.push_back(NULL);
+  params.push_back(new CoinParam("maxN!odes", "node limit", 0, 1000000, 100));
+  params.push_back(new CoinParam("maxS!olutions", "solution limit", 0, 100, 1));
+  params.push_back(new CoinParam("log!Level", "amount of output", 0, 4, 1));
+  params.push_back(new CoinParam("logF!ile", "output file",
+				 std::string("")));
+  CoinParam *sense = new CoinParam("direction", "sense", "min", 0);
+  sense->appendKwd("max");
+  params.push_back(sense);
+  params.push_back(new CoinParam("solve", "solve problem"));
+  params.push_back(new CoinParam("sol!ution", "solution file",
+				 std::string("")));
+  params.push_back(new CoinParam("?", "help"));
+  params.push_back(new CoinParam("?!list", "list parameters"));
+  params.push_back(new CoinParam("dup!licate", "first", 0, 1, 0));
+  params.push_back(new CoinParam("Dup!licate", "second", 0, 1, 0));
+  return params;
+}
+
+// Index gives the same as the linear scan
+void checkMatch(const CoinParamVec &params, const CoinParamIndex &index,
+		const std::string &name)
+{
+  int matchNdx;
+  int shortCnt;
+  const int matchCnt = CoinParamUtils::matchParam(params, name, matchNdx,
+						  shortCnt);
+  int indexNdx = -2;
+  int indexShort = -2;
+  assert(index.match(name, indexNdx, indexShort) == matchCnt);
+  assert(indexNdx == matchNdx && indexShort == shortCnt);
+  assert(CoinParamUtils::matchParam(index, name, indexNdx, indexShort) ==
+	 matchCnt);
+}
+
+}	// end file-local namespace
+
+void CoinParamIndexUnitTest()
+{
+  CoinParamVec params = testParams();
+  CoinParamIndex index(params);
+  assert(index.size() == static_cast<int>(params.size()));
+
+  // every prefix of every name in both cases, and past the end
+  std::vector<std::string> names;
+  for (size_t i = 0; i < params.size(); i++) {
+    if (params[i])
+      names.push_back(params[i]->name());
+  }
+  names.push_back("zzz");
+  names.push_back("??");
+  for (size_t i = 0; i < names.size(); i++) {
+    const std::string &name = names[i];
+    std::string upper = name;
+    for (size_t k = 0; k < upper.length(); k++)
+      upper[k] = static_cast<char>(toupper(static_cast<unsigned char>(upper[k])));
+    for (size_t k = 0; k <= name.length(); k++) {
+      checkMatch(params, index, name.substr(0, k));
+      checkMatch(params, index, upper.substr(0, k));
+    }
+    checkMatch(params, index, name + "x");
+  }
+  // some answers spelt out
+  int matchNdx;
+  int shortCnt;
+  assert(index.match("prim", matchNdx, shortCnt) == 1);
+  assert(matchNdx == primalTolerance && shortCnt == 1);
+  assert(index.match("sol", matchNdx, shortCnt) == 1);
+  assert(matchNdx == solution && shortCnt == 1);
+  assert(index.match("DUPL", matchNdx, shortCnt) == 2);
+  assert(matchNdx == duplicate2);
+  assert(index.match("?", matchNdx, shortCnt) == 1 && matchNdx == query);
+
+  // lookup through the index as without
+  int matchCnt;
+  int queryCnt;
+  assert(CoinParamUtils::lookupParam("maxN", params, index, &matchCnt,
+				     &shortCnt, &queryCnt) == maxNodes);
+  assert(CoinParamUtils::lookupParam("maxN", params, &matchCnt, &shortCnt,
+				     &queryCnt) == maxNodes);
+
+  // scripts
+  const std::string script = "-primalTol 1e-6 --maxNodes=50 direction max "
+    "primalS logF out.txt bogus 3 logL 2";
+  const CoinParamSettings &settings = index.parse(script);
+  assert(settings.size() == 8);
+  assert(settings[0].index == primalTolerance && settings[0].value == "1e-6");
+  assert(settings[1].index == maxNodes && settings[1].value == "50");
+  assert(settings[2].index == direction && settings[2].value == "max");
+  assert(settings[3].index == primalSimplex && settings[3].value == "");
+  assert(settings[4].index == logFile && settings[4].value == "out.txt");
+  assert(settings[5].index == -1 && settings[5].keyword == "bogus");
+  assert(settings[6].index == -1 && settings[6].keyword == "3");
+  assert(settings[7].index == logLevel && settings[7].value == "2");
+  assert(&index.parse(script) == &settings && index.cachedScripts() == 1);
+  assert(CoinParamIndex::apply(settings, params) == 5);
+  assert(params[primalTolerance]->dblVal() == 1.0e-6);
+  assert(params[maxNodes]->intVal() == 50);
+  assert(params[direction]->kwdVal() == "max");
+  assert(params[logFile]->strVal() == "out.txt");
+  assert(params[logLevel]->intVal() == 2);
+
+  // bad value stops loading; ambiguous keyword is not loaded
+  assert(CoinParamIndex::apply(index.parse("maxS 3 maxN many logL 4"),
+			       params) == -1);
+  assert(params[maxSolutions]->intVal() == 3);
+  assert(params[logLevel]->intVal() == 2);
+  const CoinParamSettings &ambiguous = index.parse("dup 1");
+  assert(ambiguous.size() == 2 && ambiguous[0].index == -1);
+  assert(!CoinParamIndex::apply(ambiguous, params));
+  assert(index.cachedScripts() == 3);
+  index.clearCache();
+  assert(!index.cachedScripts());
+
+  // rebuild after a name change
+  params[solve]->setName("run");
+  index.build(params);
+  checkMatch(params, index, "run");
+  checkMatch(params, index, "solv");
+
+  for (size_t i = 0; i < params.size(); i++)
+    delete params[i];
+}
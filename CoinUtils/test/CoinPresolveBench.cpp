@@ -0,0 +1,601 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Runs the presolve transforms on models, reports time and reductions of
+// each technique (from CoinPresolveProfile), postsolves a basic solution of
+// the presolved model and checks the result against the original model.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinFinite.hpp"
+#include "CoinMpsIO.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveProfile.hpp"
+#include "CoinPresolveScheduler.hpp"
+#include "CoinPresolveEmpty.hpp"
+#include "CoinPresolveFixed.hpp"
+#include "CoinPresolveSingleton.hpp"
+#include "CoinPresolveDoubleton.hpp"
+#include "CoinPresolveTripleton.hpp"
+#include "CoinPresolveZeros.hpp"
+#include "CoinPresolveSubst.hpp"
+#include "CoinPresolveForcing.hpp"
+#include "CoinPresolveDual.hpp"
+#include "CoinPresolveTighten.hpp"
+#include "CoinPresolveDupcol.hpp"
+#include "CoinPresolveImpliedFree.hpp"
+#include "CoinPresolveDominated.hpp"
+#if PRESOLVE_DEBUG || PRESOLVE_CONSISTENCY
+#include "CoinPresolvePsdebug.hpp"
+#endif
+
+namespace {
+
+/// A model as read (minimisation)
+struct benchModel {
+  std::string name;
+  CoinPackedMatrix matrix;
+  std::vector<double> columnLower;
+  std::vector<double> columnUpper;
+  std::vector<double> objective;
+  std::vector<double> rowLower;
+  std::vector<double> rowUpper;
+  std::vector<unsigned char> integerType;
+  double objectiveOffset;
+};
+
+/// Results of the checks of one postsolved solution
+struct benchChecks {
+  /// Values which are NaN or infinite
+  int bogus;
+  /// Row activities which differ from the product of matrix and solution
+  int rowActivity;
+  /// Reduced costs which differ from cost less duals times column
+  int reducedCost;
+  /// Basic variables less number of rows
+  int basicExcess;
+  /// Objective of original solution less presolved objective and bias
+  double objectiveError;
+  /// Rows and columns checked
+  int rowsChecked;
+  int columnsChecked;
+};
+
+//-------------------------------------------------------------------
+// Wrappers giving the transforms with extra arguments the
+// CoinPresolveFunction signature
+
+const CoinPresolveAction *slackDoubleton(CoinPresolveMatrix *prob,
+					 const CoinPresolveAction *next)
+{
+  bool notFinished = false;
+  return slack_doubleton_action::presolve(prob, next, notFinished);
+}
+
+const CoinPresolveAction *impliedFree(CoinPresolveMatrix *prob,
+				      const CoinPresolveAction *next)
+{
+  int fillLevel = prob->maxSubstLevel_;
+  return implied_free_action::presolve(prob, next, fillLevel);
+}
+
+const CoinPresolveAction *dominatedColumns(CoinPresolveMatrix *prob,
+					   const CoinPresolveAction *next)
+{
+  return dominated_col_action::presolve(prob, next);
+}
+
+//-------------------------------------------------------------------
+
+// Random model with the structures presolve looks for: fixed, duplicate
+// and singleton columns, singleton and doubleton rows, equalities
+void generateModel(int numberRows, int numberColumns, benchModel &model)
+{
+  CoinThreadRandom random(12345678);
+  std::vector<int> rowIndices;
+  std::vector<int> columnIndices;
+  std::vector<double> elements;
+  std::vector<int> used(numberRows, -1);
+  model.name = "generated";
+  model.columnLower.assign(numberColumns, 0.0);
+  model.columnUpper.assign(numberColumns, 10.0);
+  model.objective.resize(numberColumns);
+  model.integerType.assign(numberColumns, 0);
+  int lastStart = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    int start = static_cast<int>(elements.size());
+    if (iColumn % 20 == 19 && iColumn) {
+      // duplicate of previous column
+      int end = start;
+      for (int k = lastStart; k < end; k++) {
+	rowIndices.push_back(rowIndices[k]);
+	columnIndices.push_back(iColumn);
+	elements.push_back(elements[k]);
+      }
+    } else {
+      int number = (iColumn % 11 == 5) ? 1 : 2 + iColumn % 4;
+      for (int k = 0; k < number; k++) {
+	int iRow = static_cast<int>(random.randomDouble() * numberRows);
+	if (iRow >= numberRows || used[iRow] == iColumn)
+	  continue;
+	used[iRow] = iColumn;
+	rowIndices.push_back(iRow);
+	columnIndices.push_back(iColumn);
+	elements.push_back(floor(20.0 * random.randomDouble()) - 9.5);
+      }
+    }
+    lastStart = start;
+    model.objective[iColumn] = floor(10.0 * random.randomDouble()) - 3.0;
+    if (iColumn % 10 == 3)
+      model.columnLower[iColumn] = model.columnUpper[iColumn] = 2.0;
+    else if (iColumn % 13 == 7)
+      model.columnUpper[iColumn] = COIN_DBL_MAX;
+    // keep the model bounded
+    if (model.columnUpper[iColumn] == COIN_DBL_MAX)
+      model.objective[iColumn] = fabs(model.objective[iColumn]) + 1.0;
+    if (iColumn % 9 == 4)
+      model.integerType[iColumn] = 1;
+  }
+  // Singleton and doubleton rows on top
+  for (int iRow = 0; iRow < numberRows; iRow += 17) {
+    int iColumn = static_cast<int>(random.randomDouble() * numberColumns);
+    int jColumn = static_cast<int>(random.randomDouble() * numberColumns);
+    if (iColumn >= numberColumns || jColumn >= numberColumns || iColumn == jColumn)
+      continue;
+    bool found = false;
+    for (size_t k = 0; k < rowIndices.size() && !found; k++)
+      found = rowIndices[k] == iRow;
+    if (found)
+      continue;
+    rowIndices.push_back(iRow);
+    columnIndices.push_back(iColumn);
+    elements.push_back(1.0);
+    if (iRow % 2) {
+      rowIndices.push_back(iRow);
+      columnIndices.push_back(jColumn);
+      elements.push_back(-2.0);
+    }
+  }
+  model.matrix = CoinPackedMatrix(true, &rowIndices[0], &columnIndices[0],
+				  &elements[0],
+				  static_cast<CoinBigIndex>(elements.size()));
+  model.matrix.setDimensions(numberRows, numberColumns);
+  // Row bounds around the activity of a solution within the column
+  // bounds, so the model is feasible
+  std::vector<double> solution(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    if (model.columnLower[iColumn] == model.columnUpper[iColumn])
+      solution[iColumn] = model.columnLower[iColumn];
+    else
+      solution[iColumn] = floor(10.0 * random.randomDouble());
+  }
+  std::vector<double> activity(numberRows, 0.0);
+  model.matrix.times(&solution[0], &activity[0]);
+  model.rowLower.resize(numberRows);
+  model.rowUpper.resize(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    double value = floor(30.0 * random.randomDouble());
+    if (iRow % 5 == 0) {
+      model.rowLower[iRow] = model.rowUpper[iRow] = activity[iRow];
+    } else if (iRow % 5 == 1) {
+      model.rowLower[iRow] = -COIN_DBL_MAX;
+      model.rowUpper[iRow] = activity[iRow] + value;
+    } else if (iRow % 5 == 2) {
+      model.rowLower[iRow] = activity[iRow] - value;
+      model.rowUpper[iRow] = COIN_DBL_MAX;
+    } else {
+      model.rowLower[iRow] = activity[iRow] - value;
+      model.rowUpper[iRow] = activity[iRow] + value + 5.0;
+    }
+  }
+  model.objectiveOffset = 0.0;
+}
+
+bool readModel(const std::string &file, benchModel &model)
+{
+  CoinMpsIO m;
+  m.messageHandler()->setLogLevel(0);
+  if (m.readMps(file.c_str(), ""))
+    return false;
+  std::string::size_type slash = file.find_last_of("/\\");
+  model.name = slash == std::string::npos ? file : file.substr(slash+1);
+  int numberRows = m.getNumRows();
+  int numberColumns = m.getNumCols();
+  model.matrix = *m.getMatrixByCol();
+  model.columnLower.assign(m.getColLower(), m.getColLower()+numberColumns);
+  model.columnUpper.assign(m.getColUpper(), m.getColUpper()+numberColumns);
+  model.objective.assign(m.getObjCoefficients(),
+			 m.getObjCoefficients()+numberColumns);
+  model.rowLower.assign(m.getRowLower(), m.getRowLower()+numberRows);
+  model.rowUpper.assign(m.getRowUpper(), m.getRowUpper()+numberRows);
+  model.integerType.resize(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+    model.integerType[iColumn] = m.isInteger(iColumn) ? 1 : 0;
+  model.objectiveOffset = m.objectiveOffset();
+  return true;
+}
+
+// Loads model into a new presolve matrix
+CoinPresolveMatrix *loadModel(const benchModel &model)
+{
+  int numberRows = model.matrix.getNumRows();
+  int numberColumns = model.matrix.getNumCols();
+  CoinPresolveMatrix *prob =
+    new CoinPresolveMatrix(numberColumns, numberRows,
+			   model.matrix.getNumElements());
+  prob->messageHandler()->setLogLevel(0);
+  CoinPackedMatrix matrix(model.matrix);
+  matrix.removeGaps();
+  prob->moveMatrix(matrix);
+  prob->setColLower(&model.columnLower[0], numberColumns);
+  prob->setColUpper(&model.columnUpper[0], numberColumns);
+  prob->setCost(&model.objective[0], numberColumns);
+  prob->setRowLower(&model.rowLower[0], numberRows);
+  prob->setRowUpper(&model.rowUpper[0], numberRows);
+  prob->setVariableType(&model.integerType[0], numberColumns);
+  prob->setObjSense(1.0);
+  prob->setObjOffset(model.objectiveOffset);
+  prob->setPrimalTolerance(1.0e-8);
+  prob->setDualTolerance(1.0e-7);
+  prob->feasibilityTolerance_ = 1.0e-7;
+  prob->status_ = 0;
+  return prob;
+}
+
+/*
+  Runs presolve with every technique through a CoinPresolveScheduler, much
+  as a solver's driver would (fixed columns first, empty rows and columns
+  dropped at the end).
+*/
+const CoinPresolveAction *runPresolve(CoinPresolveMatrix *prob,
+				      CoinPresolveProfile &profile,
+				      int maximumPasses)
+{
+  CoinPresolveScheduler scheduler;
+  scheduler.setMaximumPasses(maximumPasses);
+  scheduler.addTechnique("slack_doubleton", slackDoubleton);
+  scheduler.addTechnique("doubleton", doubleton_action::presolve);
+  scheduler.addTechnique("tripleton", tripleton_action::presolve);
+  scheduler.addTechnique("tighten", do_tighten_action::presolve);
+  scheduler.addTechnique("forcing", forcing_constraint_action::presolve);
+  scheduler.addTechnique("implied_free", impliedFree);
+  scheduler.addTechnique("dual", remove_dual_action::presolve);
+  scheduler.addTechnique("dupcol", dupcol_action::presolve);
+  scheduler.addTechnique("duprow", duprow_action::presolve);
+  scheduler.addTechnique("dominated", dominatedColumns);
+  const CoinPresolveAction *actions = NULL;
+  profile.startPresolve(prob);
+  actions = make_fixed(prob, actions);
+  profile.endPresolve(prob, "make_fixed");
+  prob->initColsToDo();
+  prob->initRowsToDo();
+  while (!scheduler.finished() && !prob->status_) {
+    prob->pass_++;
+    actions = scheduler.runPass(prob, actions);
+    prob->stepRowsToDo();
+    prob->stepColsToDo();
+    if (!prob->numberRowsToDo_ && !prob->numberColsToDo_) {
+      prob->initColsToDo();
+      prob->initRowsToDo();
+    }
+  }
+  if (!prob->status_) {
+    actions = drop_empty_cols_action::presolve(prob, actions);
+    actions = drop_empty_rows_action::presolve(prob, actions);
+  }
+  return actions;
+}
+
+/*
+  Gives the presolved problem a basic solution: slacks basic, columns
+  nonbasic at a finite bound (or free at zero), duals zero. Arrays are
+  sized for the original problem, as postsolve expects.
+*/
+void basicSolution(CoinPresolveMatrix *prob)
+{
+  int ncols0 = prob->ncols0_;
+  int nrows0 = prob->nrows0_;
+  int ncols = prob->ncols_;
+  int nrows = prob->nrows_;
+  prob->sol_ = new double[ncols0];
+  prob->rcosts_ = new double[ncols0];
+  prob->acts_ = new double[nrows0];
+  prob->rowduals_ = new double[nrows0];
+  prob->colstat_ = new unsigned char[ncols0+nrows0];
+  prob->rowstat_ = prob->colstat_ + ncols0;
+  CoinZeroN(prob->acts_, nrows0);
+  CoinZeroN(prob->rowduals_, nrows0);
+  for (int j = 0; j < ncols; j++) {
+    double lower = prob->clo_[j];
+    double upper = prob->cup_[j];
+    double value;
+    if (lower > -PRESOLVE_INF) {
+      value = lower;
+      prob->setColumnStatus(j, CoinPrePostsolveMatrix::atLowerBound);
+    } else if (upper < PRESOLVE_INF) {
+      value = upper;
+      prob->setColumnStatus(j, CoinPrePostsolveMatrix::atUpperBound);
+    } else {
+      value = 0.0;
+      prob->setColumnStatus(j, CoinPrePostsolveMatrix::isFree);
+    }
+    prob->sol_[j] = value;
+    prob->rcosts_[j] = prob->cost_[j];
+    for (CoinBigIndex k = prob->mcstrt_[j]; k < prob->mcstrt_[j]+prob->hincol_[j]; k++)
+      prob->acts_[prob->hrow_[k]] += value * prob->colels_[k];
+  }
+  for (int i = 0; i < nrows; i++)
+    prob->setRowStatus(i, CoinPrePostsolveMatrix::basic);
+}
+
+// Objective of presolved problem at its solution
+double presolvedObjective(const CoinPresolveMatrix *prob)
+{
+  double objective = 0.0;
+  for (int j = 0; j < prob->ncols_; j++)
+    objective += prob->cost_[j] * prob->sol_[j];
+  return objective;
+}
+
+// Checks postsolved solution against original model (a sample of rows
+// and columns if sample < 1)
+void checkSolution(const benchModel &model, const CoinPostsolveMatrix &post,
+		   double presolvedObjective, double sample, benchChecks &checks)
+{
+  memset(&checks, 0, sizeof(checks));
+  const CoinPackedMatrix &matrix = model.matrix;
+  int numberRows = matrix.getNumRows();
+  int numberColumns = matrix.getNumCols();
+  const double *sol = post.sol_;
+  const double *acts = post.acts_;
+  const double *duals = post.rowduals_;
+  const double *rcosts = post.rcosts_;
+  CoinThreadRandom random(4321);
+  const double tolerance = 1.0e-6;
+  // Activities from row copy
+  CoinPackedMatrix rowCopy;
+  rowCopy.reverseOrderedCopyOf(matrix);
+  for (int i = 0; i < numberRows; i++) {
+    if (sample < 1.0 && random.randomDouble() > sample)
+      continue;
+    checks.rowsChecked++;
+    if (!CoinFinite(acts[i]) || CoinIsnan(acts[i])) {
+      checks.bogus++;
+      continue;
+    }
+    double activity = 0.0;
+    for (CoinBigIndex k = rowCopy.getVectorFirst(i); k < rowCopy.getVectorLast(i); k++)
+      activity += rowCopy.getElements()[k] * sol[rowCopy.getIndices()[k]];
+    if (fabs(activity - acts[i]) > tolerance * (1.0 + fabs(activity)))
+      checks.rowActivity++;
+  }
+  for (int j = 0; j < numberColumns; j++) {
+    if (sample < 1.0 && random.randomDouble() > sample)
+      continue;
+    checks.columnsChecked++;
+    if (!CoinFinite(sol[j]) || CoinIsnan(sol[j])) {
+      checks.bogus++;
+      continue;
+    }
+    if (!duals)
+      continue;
+    double dj = model.objective[j];
+    for (CoinBigIndex k = matrix.getVectorFirst(j); k < matrix.getVectorLast(j); k++)
+      dj -= duals[matrix.getIndices()[k]] * matrix.getElements()[k];
+    if (fabs(dj - rcosts[j]) > tolerance * (1.0 + fabs(dj)))
+      checks.reducedCost++;
+  }
+  if (post.colstat_) {
+    int numberBasic = 0;
+    for (int j = 0; j < numberColumns; j++) {
+      if (post.getColumnStatus(j) == CoinPrePostsolveMatrix::basic)
+	numberBasic++;
+    }
+    for (int i = 0; i < numberRows; i++) {
+      if (post.getRowStatus(i) == CoinPrePostsolveMatrix::basic)
+	numberBasic++;
+    }
+    checks.basicExcess = numberBasic - numberRows;
+  }
+  double objective = 0.0;
+  for (int j = 0; j < numberColumns; j++)
+    objective += model.objective[j] * sol[j];
+  checks.objectiveError = objective - presolvedObjective;
+}
+
+} // end unnamed namespace
+
+/*
+  Parameters (all optional)
+    -models=file[,file...]  MPS models (may be compressed)
+    -rows=n                 rows of generated model (default 20000)
+    -columns=n              columns of generated model (default 40000)
+    -passes=n               largest number of presolve passes (default 20)
+    -sample=fraction        fraction of rows and columns checked after
+                            postsolve (default 1.0)
+    -checkEvery=n           in builds with PRESOLVE_DEBUG or
+                            PRESOLVE_CONSISTENCY, also run the
+                            CoinPresolvePsdebug solution checks after
+                            every n-th postsolve action (default 0 - only
+                            at the end)
+    -primalOnly             postsolve only primal values (no duals,
+                            reduced costs or status)
+    -csv=file               append technique figures as comma separated
+                            values
+  With no models a generated one is used. For each model a line gives the
+  size before and after presolve, presolve and postsolve seconds and the
+  checks, followed by calls, seconds and reductions of each technique and
+  calls and seconds of postsolve for each action class.
+
+  The presolved problem is given a basic (not optimal) solution, which is
+  postsolved. The checks count values which are not finite, row activities
+  and reduced costs which do not agree with the original matrix, basic
+  variables in excess of the number of rows, and the difference between
+  objective values (original less presolved plus bias). Any failure gives
+  return code 2. With -primalOnly only activities and objective are
+  checked.
+*/
+int CoinPresolveBenchmark(std::map<std::string, std::string> &parms)
+{
+  int numberRows = 20000;
+  int numberColumns = 40000;
+  int maximumPasses = 20;
+  int checkEvery = 0;
+  double sample = 1.0;
+  if (parms.find("-rows") != parms.end())
+    numberRows = atoi(parms["-rows"].c_str());
+  if (parms.find("-columns") != parms.end())
+    numberColumns = atoi(parms["-columns"].c_str());
+  if (parms.find("-passes") != parms.end())
+    maximumPasses = atoi(parms["-passes"].c_str());
+  if (parms.find("-sample") != parms.end())
+    sample = atof(parms["-sample"].c_str());
+  if (parms.find("-checkEvery") != parms.end())
+    checkEvery = atoi(parms["-checkEvery"].c_str());
+  bool primalOnly = parms.find("-primalOnly") != parms.end();
+  if (numberRows < 1 || numberColumns < 1 || maximumPasses < 1) {
+    printf("Bad -rows, -columns or -passes\n");
+    return 1;
+  }
+  std::vector<benchModel> models;
+  if (parms.find("-models") != parms.end()) {
+    std::string list = parms["-models"];
+    while (list.length()) {
+      std::string::size_type comma = list.find(',');
+      std::string file = list.substr(0, comma);
+      list = comma == std::string::npos ? "" : list.substr(comma+1);
+      models.push_back(benchModel());
+      if (!readModel(file, models.back())) {
+	printf("Unable to read model %s\n", file.c_str());
+	return 1;
+      }
+    }
+  } else {
+    models.push_back(benchModel());
+    generateModel(numberRows, numberColumns, models.back());
+  }
+  FILE *csv = NULL;
+  if (parms.find("-csv") != parms.end()) {
+    csv = fopen(parms["-csv"].c_str(), "a");
+    if (!csv) {
+      printf("Unable to open %s\n", parms["-csv"].c_str());
+      return 1;
+    }
+    fseek(csv, 0, SEEK_END);
+    if (!ftell(csv))
+      fprintf(csv, "model,technique,calls,presolveSeconds,presolveWork,"
+	      "rowsRemoved,columnsRemoved,elementsRemoved,postsolveCalls,"
+	      "postsolveSeconds\n");
+  }
+  int numberFailures = 0;
+  for (size_t iModel = 0; iModel < models.size(); iModel++) {
+    const benchModel &model = models[iModel];
+    CoinPresolveProfile profile;
+    CoinPresolveMatrix *prob = loadModel(model);
+    prob->setProfile(&profile);
+    double time1 = CoinWallclockTime();
+    const CoinPresolveAction *actions = runPresolve(prob, profile,
+						    maximumPasses);
+    double presolveTime = CoinWallclockTime() - time1;
+    printf("%s - %d rows, %d columns, %d elements -> ", model.name.c_str(),
+	   model.matrix.getNumRows(), model.matrix.getNumCols(),
+	   static_cast<int>(model.matrix.getNumElements()));
+    if (prob->status_) {
+      printf("%s in presolve\n", (prob->status_ & 1) ? "infeasible" : "unbounded");
+    } else {
+      printf("%d rows, %d columns, %d elements\n", prob->nrows_, prob->ncols_,
+	     static_cast<int>(prob->nelems_));
+    }
+    double postsolveTime = 0.0;
+    benchChecks checks;
+    memset(&checks, 0, sizeof(checks));
+    if (!prob->status_) {
+      basicSolution(prob);
+      double objective = presolvedObjective(prob) + prob->dobias_;
+      CoinPostsolveMatrix post(0, 0, 0);
+      post.assignPresolveToPostsolve(prob);
+      if (primalOnly)
+	post.setPrimalOnly();
+      time1 = CoinWallclockTime();
+      int numberActions = 0;
+      for (const CoinPresolveAction *action = actions; action; action = action->next) {
+	profile.postsolve(action, &post);
+	numberActions++;
+#if PRESOLVE_DEBUG || PRESOLVE_CONSISTENCY
+	if (checkEvery > 0 && numberActions % checkEvery == 0) {
+	  presolve_check_sol(&post, 2, 2, 1);
+	  presolve_check_nbasic(&post);
+	}
+#endif
+      }
+      postsolveTime = CoinWallclockTime() - time1;
+      checkSolution(model, post, objective, sample, checks);
+      bool ok = !checks.bogus && !checks.rowActivity && !checks.reducedCost
+	&& !checks.basicExcess
+	&& fabs(checks.objectiveError) <= 1.0e-6 * (1.0 + fabs(objective));
+      if (!ok)
+	numberFailures++;
+      printf("presolve %.3f s, postsolve %.3f s (%d actions), checked %d rows"
+	     " %d columns: bogus %d, activity %d, reduced cost %d,"
+	     " basic excess %d, objective error %g - %s\n",
+	     presolveTime, postsolveTime, numberActions, checks.rowsChecked,
+	     checks.columnsChecked, checks.bogus, checks.rowActivity,
+	     checks.reducedCost, checks.basicExcess, checks.objectiveError,
+	     ok ? "ok" : "FAILED");
+    } else {
+      printf("presolve %.3f s\n", presolveTime);
+      delete prob;
+    }
+    // Presolve records are named by technique, postsolve ones by class
+    printf("  %-30s %6s %9s %8s %8s %10s\n", "technique", "calls",
+	   "seconds", "rows", "columns", "elements");
+    for (int i = 0; i < profile.numberRecords(); i++) {
+      const CoinPresolveProfileRecord &record = profile.record(i);
+      if (!record.presolveCalls)
+	continue;
+      printf("  %-30s %6d %9.4f %8d %8d %10d\n", record.name.c_str(),
+	     record.presolveCalls, record.presolveTime, record.rowsRemoved,
+	     record.columnsRemoved, static_cast<int>(record.elementsRemoved));
+    }
+    printf("  %-30s %6s %9s\n", "postsolve", "calls", "seconds");
+    for (int i = 0; i < profile.numberRecords(); i++) {
+      const CoinPresolveProfileRecord &record = profile.record(i);
+      if (!record.postsolveCalls)
+	continue;
+      printf("  %-30s %6d %9.4f\n", record.name.c_str(),
+	     record.postsolveCalls, record.postsolveTime);
+    }
+    if (csv) {
+      for (int i = 0; i < profile.numberRecords(); i++) {
+	const CoinPresolveProfileRecord &record = profile.record(i);
+	fprintf(csv, "%s,%s,%d,%g,%g,%d,%d,%d,%d,%g\n", model.name.c_str(),
+		record.name.c_str(), record.presolveCalls, record.presolveTime,
+		record.presolveWork, record.rowsRemoved, record.columnsRemoved,
+		static_cast<int>(record.elementsRemoved), record.postsolveCalls,
+		record.postsolveTime);
+      }
+    }
+    while (actions) {
+      const CoinPresolveAction *next = actions->next;
+      delete actions;
+      actions = next;
+    }
+  }
+  if (csv)
+    fclose(csv);
+#if !(PRESOLVE_DEBUG || PRESOLVE_CONSISTENCY)
+  (void) checkEvery;
+#endif
+  return numberFailures ? 2 : 0;
+}
@@ -0,0 +1,182 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "CoinPragma.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinPresolveMatrix.hpp"
+#include "CoinPresolveFixed.hpp"
+#include "CoinPresolveJournal.hpp"
+
+namespace {
+
+/*
+  Three rows, four columns of two coefficients each, with \p fixedColumn
+  fixed at 1.  Every choice of fixed column gives the same structure.  A
+  fifth column (row 2 only) can be added to change the structure.
+
+      row 0:  x0      + x2 + x3
+      row 1:  x0 + x1      + x3
+      row 2:       x1 + x2
+*/
+CoinPresolveMatrix *loadModel(int fixedColumn, int numberColumns = 4)
+{
+  const int numberRows = 3;
+  int rows[] = {0, 1, 1, 2, 0, 2, 0, 1, 2};
+  int columns[] = {0, 0, 1, 1, 2, 2, 3, 3, 4};
+  double elements[] = {1.0, 2.0, 1.0, -1.0, 3.0, 1.0, 1.0, 1.0, 1.0};
+  // columns beyond numberColumns are left out
+  int numberElements = 0;
+  while (numberElements < 9 && columns[numberElements] < numberColumns)
+    numberElements++;
+  CoinPackedMatrix matrix(true, rows, columns, elements, numberElements);
+  matrix.setDimensions(numberRows, numberColumns);
+  matrix.removeGaps();
+  CoinPresolveMatrix *prob =
+    new CoinPresolveMatrix(numberColumns, numberRows, numberElements);
+  prob->messageHandler()->setLogLevel(0);
+  prob->moveMatrix(matrix);
+  double columnLower[] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  double columnUpper[] = {4.0, 4.0, 4.0, 4.0, 4.0};
+  double cost[] = {1.0, 1.0, 1.0, 1.0, 1.0};
+  double rowLower[] = {0.0, 0.0, 0.0};
+  double rowUpper[] = {10.0, 10.0, 10.0};
+  columnLower[fixedColumn] = columnUpper[fixedColumn] = 1.0;
+  prob->setColLower(columnLower, numberColumns);
+  prob->setColUpper(columnUpper, numberColumns);
+  prob->setCost(cost, numberColumns);
+  prob->setRowLower(rowLower, numberRows);
+  prob->setRowUpper(rowUpper, numberRows);
+  prob->setObjSense(1.0);
+  prob->status_ = 0;
+  return prob;
+}
+
+void deleteActions(const CoinPresolveAction *actions)
+{
+  while (actions) {
+    const CoinPresolveAction *next = actions->next;
+    delete actions;
+    actions = next;
+  }
+}
+
+/*
+  Replays step 0 of \p journal on \p prob the way a driver would - fixing
+  only the columns the step names.  Returns what checkStep says.
+*/
+int replayFixed(const CoinPresolveJournal &journal, CoinPresolveMatrix *prob)
+{
+  assert (!strcmp(journal.stepName(0), "make_fixed_action"));
+  prob->initColsToDo();
+  prob->initRowsToDo();
+  assert (journal.prepareStep(prob, 0));
+  // fixed columns among those loaded
+  int *fixed = prob->usefulColumnInt_;
+  int numberFixed = 0;
+  for (int k = 0; k < prob->numberColsToDo_; k++) {
+    int j = prob->colsToDo_[k];
+    if (prob->clo_[j] == prob->cup_[j])
+      fixed[numberFixed++] = j;
+  }
+  const CoinPresolveAction *actions = NULL;
+  if (numberFixed)
+    actions = make_fixed_action::presolve(prob, fixed, numberFixed, true,
+					  NULL);
+  int numberMatched = journal.checkStep(prob, 0, actions, NULL);
+  deleteActions(actions);
+  return numberMatched;
+}
+
+}	// end file-local namespace
+
+void CoinPresolveJournalUnitTest()
+{
+  CoinPresolveJournal journal;
+  assert (!journal.numberSteps());
+
+  // record fixing column 1
+  CoinPresolveMatrix *prob = loadModel(1);
+  journal.startRecording(prob);
+  const CoinPresolveAction *actions = make_fixed(prob, NULL);
+  assert (actions);
+  journal.record(prob, actions, NULL);
+  assert (journal.numberSteps() == 1);
+  {
+    const CoinPresolveJournalStep &step = journal.step(0);
+    assert (step.name == "make_fixed_action");
+    assert (step.complete);
+    assert (step.columns.size() == 1 && step.columns[0] == 1);
+    assert (step.columnLengths.size() == 1);
+    assert (step.rows.size() == 2);
+    assert (step.rowLengths.size() == 2);
+    for (int k = 0; k < 2; k++) {
+      int iRow = step.rows[k];
+      assert (iRow == 1 || iRow == 2);
+      // column 1 gone from the row
+      assert (step.rowLengths[k] == (iRow == 1 ? 2 : 1));
+    }
+  }
+  // nothing new - nothing recorded
+  journal.record(prob, actions, actions);
+  assert (journal.numberSteps() == 1);
+  deleteActions(actions);
+  delete prob;
+
+  // write and read back
+  const char *fileName = "CoinPresolveJournalTest.journal";
+  assert (!journal.write(fileName));
+  CoinPresolveJournal copy;
+  assert (!copy.read(fileName));
+  assert (copy.numberSteps() == journal.numberSteps());
+  {
+    const CoinPresolveJournalStep &a = journal.step(0);
+    const CoinPresolveJournalStep &b = copy.step(0);
+    assert (a.name == b.name && a.complete == b.complete);
+    assert (a.rows == b.rows && a.columns == b.columns);
+    assert (a.rowLengths == b.rowLengths);
+    assert (a.columnLengths == b.columnLengths);
+  }
+  remove(fileName);
+  assert (copy.read(fileName) == -1);
+  // not a journal
+  FILE *fp = fopen(fileName, "w");
+  assert (fp);
+  fprintf(fp, "NotAJournal 1\n");
+  fclose(fp);
+  assert (copy.read(fileName) == -2);
+  assert (!copy.numberSteps());
+  remove(fileName);
+
+  // same data - replay matches
+  prob = loadModel(1);
+  assert (journal.startReplay(prob));
+  assert (replayFixed(journal, prob) == 1);
+  delete prob;
+
+  // same structure, other column fixed - structure accepted but step fails
+  prob = loadModel(2);
+  assert (journal.startReplay(prob));
+  assert (replayFixed(journal, prob) == 0);
+  delete prob;
+
+  // different size - no replay
+  prob = loadModel(1, 5);
+  assert (!journal.startReplay(prob));
+  delete prob;
+
+  // step pointing outside the model can not be prepared
+  prob = loadModel(0, 1);
+  prob->initColsToDo();
+  prob->initRowsToDo();
+  assert (!journal.prepareStep(prob, 0));
+  delete prob;
+}
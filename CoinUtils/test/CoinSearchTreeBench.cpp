@@ -0,0 +1,319 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Drives the search trees with a synthetic branch and bound - each node
+// popped has children of worse quality until enough nodes have been made -
+// and times push and pop for each comparison, gives the memory the tree
+// holds per open node and how CoinParallelSearchTreeManager scales.
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#if !defined(_MSC_VER)
+#include <sys/resource.h>
+#endif
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinSearchTree.hpp"
+#include "CoinThreadPool.hpp"
+
+namespace {
+
+// Node with nothing beyond what CoinTreeNode holds
+class BenchNode : public CoinTreeNode {
+public:
+  BenchNode(int depth, double quality, const CoinTreePreferred &preferred)
+    : CoinTreeNode(depth, -1, quality, quality, preferred)
+  {
+  }
+};
+
+// Random number in [0,1) from seed (CoinDrand48 is not for threads)
+inline double benchRandom(unsigned int &seed)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<double>(seed >> 8) * (1.0 / 16777216.0);
+}
+
+// Creates children of parent (none once at maxDepth) and returns how many.
+// The first child is preferred - the others set the bit for their depth,
+// most significant first, so CoinSearchTreeComparePreferred dives.
+int branch(const CoinTreeNode *parent, int numberChildren, int maxDepth,
+	   unsigned int &seed, CoinTreeNode **children)
+{
+  const int depth = parent->getDepth() + 1;
+  if (depth > maxDepth)
+    return 0;
+  for (int i = 0; i < numberChildren; i++) {
+    CoinTreePreferred preferred = parent->getPreferred();
+    if (i)
+      preferred.setBit(COIN_TREE_PREFERRED_BITS - depth);
+    children[i] = new BenchNode(depth,
+      parent->getQuality() + benchRandom(seed), preferred);
+  }
+  return numberChildren;
+}
+
+// Peak resident set size of the process in MB (0 if not known)
+double peakRss()
+{
+#if !defined(_MSC_VER)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage))
+    return 0.0;
+#ifdef __APPLE__
+  return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+#else
+  return 0.0;
+#endif
+}
+
+// Bytes held by tree for its open nodes (not counting malloc overhead)
+double treeBytes(const CoinSearchTreeBase *tree, int keyBytes)
+{
+  const std::vector<CoinTreeSiblings *> &candidates = tree->getCandidates();
+  double bytes = static_cast<double>(candidates.capacity())
+    * (sizeof(CoinTreeSiblings *) + keyBytes);
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const CoinTreeSiblings *siblings = candidates[i];
+    bytes += sizeof(CoinTreeSiblings)
+      + siblings->size() * sizeof(CoinTreeNode *)
+      + siblings->toProcess() * sizeof(BenchNode);
+  }
+  return bytes;
+}
+
+/* Makes numberNodes nodes through manager (tree already set) and pops
+   until it is empty. A new root is pushed if the tree empties early. */
+bool benchTree(const char *name, CoinSearchTreeManager &manager, int keyBytes,
+	       int numberNodes, int numberChildren, int maxDepth)
+{
+  CoinTreeNode **children = new CoinTreeNode *[numberChildren];
+  unsigned int seed = 1234567;
+  int created = 0;
+  int pops = 0;
+  int peakOpen = 0;
+  int fullOpen = 0;
+  double bytesPerNode = 0.0;
+  double pushTime = 0.0;
+  double time1 = CoinWallclockTime();
+  while (created < numberNodes || !manager.empty()) {
+    if (manager.empty()) {
+      manager.push(new BenchNode(0, 0.0, CoinTreePreferred()));
+      created++;
+    }
+    CoinTreeNode *node = manager.top();
+    manager.pop();
+    pops++;
+    if (created < numberNodes) {
+      int n = branch(node, CoinMin(numberChildren, numberNodes - created),
+	maxDepth, seed, children);
+      if (n) {
+	double time2 = CoinWallclockTime();
+	manager.push(n, children);
+	pushTime += CoinWallclockTime() - time2;
+	created += n;
+      }
+      peakOpen = CoinMax(peakOpen, static_cast<int>(manager.size()));
+      if (created == numberNodes) {
+	// everything is made so tree is about as big as it gets
+	double time2 = CoinWallclockTime();
+	fullOpen = static_cast<int>(manager.size());
+	if (fullOpen)
+	  bytesPerNode = treeBytes(manager.getTree(), keyBytes) / fullOpen;
+	time1 += CoinWallclockTime() - time2;
+      }
+    }
+    delete node;
+  }
+  double time = CoinWallclockTime() - time1;
+  delete[] children;
+  bool ok = pops == created && manager.size() == 0;
+  printf("%-14s %10d %8.3f %10.0f %7.3f %10d %7.1f  %s\n", name, pops, time,
+    pops / CoinMax(time, 1.0e-9), pushTime, peakOpen, bytesPerNode,
+    ok ? "ok" : "WRONG");
+  return ok;
+}
+
+// Work for one worker of the parallel manager
+typedef struct {
+  CoinParallelSearchTreeManager *manager;
+  int worker;
+  int numberNodes;
+  int numberChildren;
+  int maxDepth;
+  int pops;
+  int created;
+} benchWorker;
+
+// Makes the worker's share of nodes then pops until the pool is empty
+void *parallelWorker(void *info)
+{
+  benchWorker *work = reinterpret_cast<benchWorker *>(info);
+  CoinParallelSearchTreeManager &manager = *work->manager;
+  const int w = work->worker;
+  CoinTreeNode **children = new CoinTreeNode *[work->numberChildren];
+  unsigned int seed = 1234567 + 7919 * w;
+  int created = 0;
+  int pops = 0;
+  for (;;) {
+    CoinTreeNode *node = manager.pop(w);
+    if (!node) {
+      if (created >= work->numberNodes)
+	break;
+      // nothing anywhere - start another tree
+      node = new BenchNode(0, 0.0, CoinTreePreferred());
+      created++;
+    }
+    pops++;
+    if (created < work->numberNodes) {
+      int n = branch(node,
+	CoinMin(work->numberChildren, work->numberNodes - created),
+	work->maxDepth, seed, children);
+      if (n) {
+	manager.push(w, n, children);
+	created += n;
+      }
+    }
+    delete node;
+  }
+  delete[] children;
+  work->pops = pops;
+  work->created = created;
+  return NULL;
+}
+
+// Runs numberWorkers workers at once on one pool
+bool benchParallel(int numberWorkers, int numberNodes, int numberChildren,
+		   int maxDepth, double &baseTime)
+{
+  CoinParallelSearchTreeManager manager(numberWorkers);
+  benchWorker *work = new benchWorker[numberWorkers];
+  for (int i = 0; i < numberWorkers; i++) {
+    work[i].manager = &manager;
+    work[i].worker = i;
+    work[i].numberNodes = static_cast<int>(
+      (static_cast<double>(numberNodes) * (i + 1)) / numberWorkers)
+      - static_cast<int>((static_cast<double>(numberNodes) * i)
+	/ numberWorkers);
+    work[i].numberChildren = numberChildren;
+    work[i].maxDepth = maxDepth;
+  }
+  double time1 = CoinWallclockTime();
+  CoinThreadPool::run(parallelWorker, work, sizeof(benchWorker),
+    numberWorkers);
+  double time = CoinWallclockTime() - time1;
+  int pops = 0;
+  int created = 0;
+  int steals = 0;
+  for (int i = 0; i < numberWorkers; i++) {
+    pops += work[i].pops;
+    created += work[i].created;
+    steals += manager.numberSteals(i);
+  }
+  if (numberWorkers == 1)
+    baseTime = time;
+  bool ok = pops == created && manager.empty();
+  printf("%-14d %10d %8.3f %10.0f %7.2f %10d  %s\n", numberWorkers, pops, time,
+    pops / CoinMax(time, 1.0e-9), baseTime / CoinMax(time, 1.0e-9), steals,
+    ok ? "ok" : "WRONG");
+  delete[] work;
+  return ok;
+}
+
+} // namespace
+
+//----------------------------------------------------------------
+// benchmark tree [-nodes=N] [-children=N] [-depth=N] [-threads=N]
+//
+// Each comparison makes -nodes nodes, -children for each node popped
+// (none below -depth), through a CoinSearchTreeManager. A line gives
+// nodes popped, seconds, nodes a second, seconds in push, most open
+// nodes and bytes of tree per open node once all are made (nodes,
+// siblings and heap, not malloc overhead). Node new and delete are in
+// the times as in a real search.
+//
+// Then the same best first search is split between 1, 2, 4 ... -threads
+// workers of a CoinParallelSearchTreeManager with speedup against one
+// and the number of steals (workers are run one after another if
+// CoinUtils was built without thread support).
+//----------------------------------------------------------------
+int CoinSearchTreeBenchmark(std::map<std::string, std::string> &parms)
+{
+  int numberNodes = 1000000;
+  int numberChildren = 2;
+  int maxDepth = 100;
+  int numberThreads = 4;
+  if (parms.find("-nodes") != parms.end())
+    numberNodes = atoi(parms["-nodes"].c_str());
+  if (parms.find("-children") != parms.end())
+    numberChildren = atoi(parms["-children"].c_str());
+  if (parms.find("-depth") != parms.end())
+    maxDepth = atoi(parms["-depth"].c_str());
+  if (parms.find("-threads") != parms.end())
+    numberThreads = atoi(parms["-threads"].c_str());
+  if (numberNodes < 1 || numberChildren < 1 || numberThreads < 1) {
+    printf("Bad -nodes, -children or -threads\n");
+    return 1;
+  }
+  if (maxDepth < 1 || maxDepth >= COIN_TREE_PREFERRED_BITS) {
+    printf("-depth must be between 1 and %d\n", COIN_TREE_PREFERRED_BITS - 1);
+    return 1;
+  }
+  printf("%-14s %10s %8s %10s %7s %10s %7s\n", "tree", "nodes", "seconds",
+    "nodes/s", "push", "peak open", "bytes");
+  bool ok = true;
+  {
+    CoinSearchTreeManager manager;
+    manager.setTree(new CoinSearchTree< CoinSearchTreeCompareBest >());
+    ok = benchTree("best", manager, 0, numberNodes, numberChildren, maxDepth)
+      && ok;
+  }
+  {
+    CoinSearchTreeManager manager;
+    manager.setTree(new CoinSearchTreeDary< CoinSearchTreeCompareBest >());
+    ok = benchTree("best 4-ary", manager, sizeof(double), numberNodes,
+	   numberChildren, maxDepth)
+      && ok;
+  }
+  {
+    CoinSearchTreeManager manager;
+    manager.setTree(new CoinSearchTree< CoinSearchTreeCompareDepth >());
+    ok = benchTree("depth", manager, 0, numberNodes, numberChildren, maxDepth)
+      && ok;
+  }
+  {
+    CoinSearchTreeManager manager;
+    manager.setTree(new CoinSearchTreeDary< CoinSearchTreeCompareDepth >());
+    ok = benchTree("depth 4-ary", manager, sizeof(double), numberNodes,
+	   numberChildren, maxDepth)
+      && ok;
+  }
+  {
+    CoinSearchTreeManager manager;
+    manager.setTree(new CoinSearchTree< CoinSearchTreeComparePreferred >());
+    ok = benchTree("preferred", manager, 0, numberNodes, numberChildren,
+	   maxDepth)
+      && ok;
+  }
+  printf("%-14s %10s %8s %10s %7s %10s\n", "workers", "nodes", "seconds",
+    "nodes/s", "speedup", "steals");
+  double baseTime = 0.0;
+  for (int workers = 1;; workers = CoinMin(2 * workers, numberThreads)) {
+    ok = benchParallel(workers, numberNodes, numberChildren, maxDepth,
+	   baseTime)
+      && ok;
+    if (workers == numberThreads)
+      break;
+  }
+  printf("peak resident %.1f MB\n", peakRss());
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinSearchTree.hpp"
+
+namespace {
+
+class qualityNode : public CoinTreeNode {
+public:
+  qualityNode(double quality) : CoinTreeNode(0, -1, quality) {}
+};
+
+typedef CoinSearchTree<CoinSearchTreeCompareBest> binaryTree;
+
+// Nodes with different qualities (so both heaps have one order)
+class nodeMaker {
+public:
+  nodeMaker() : count_(0) {}
+  ~nodeMaker()
+  {
+    for (size_t i = 0; i < nodes_.size(); i++)
+      delete nodes_[i];
+  }
+  CoinTreeNode *make()
+  {
+    nodes_.push_back(new qualityNode((count_ * 7919) % 10007));
+    count_++;
+    return nodes_.back();
+  }
+  int count_;
+  std::vector<CoinTreeNode *> nodes_;
+};
+
+// Positions known and every key no better than its parent's
+template <int D>
+bool isHeap(const CoinSearchTreeDary<CoinSearchTreeCompareBest, D> &tree)
+{
+  const std::vector<CoinTreeSiblings *> &candidates = tree.getCandidates();
+  for (size_t i = 0; i < candidates.size(); i++) {
+    if (candidates[i]->heapPosition() != static_cast<int>(i))
+      return false;
+    if (i && CoinSearchTreeCompareBest::key(candidates[i]) <
+	CoinSearchTreeCompareBest::key(candidates[(i - 1) / D]))
+      return false;
+  }
+  return true;
+}
+
+// Pushes n nodes, alternately alone and as two siblings, to both trees
+template <int D>
+void pushBoth(CoinSearchTreeDary<CoinSearchTreeCompareBest, D> &dary,
+	      binaryTree &binary, nodeMaker &maker, int n)
+{
+  while (n > 0) {
+    const int numberSiblings = (maker.count_ % 3 == 1 && n > 1) ? 2 : 1;
+    CoinTreeNode *nodes[2];
+    for (int i = 0; i < numberSiblings; i++)
+      nodes[i] = maker.make();
+    dary.push(numberSiblings, nodes);
+    binary.push(numberSiblings, nodes);
+    n -= numberSiblings;
+    assert(isHeap(dary));
+  }
+}
+
+// Pops n nodes from both trees checking they agree
+template <int D>
+void popBoth(CoinSearchTreeDary<CoinSearchTreeCompareBest, D> &dary,
+	     binaryTree &binary, int n)
+{
+  for (int i = 0; i < n; i++) {
+    assert(dary.size() == binary.size());
+    assert(dary.top() && dary.top() == binary.top());
+    dary.pop();
+    binary.pop();
+    assert(isHeap(dary));
+  }
+}
+
+template <int D>
+void checkArity()
+{
+  // interleaved pushes and pops
+  {
+    nodeMaker maker;
+    CoinSearchTreeDary<CoinSearchTreeCompareBest, D> dary;
+    binaryTree binary;
+    for (int round = 0; round < 10; round++) {
+      pushBoth(dary, binary, maker, 40 + 7 * round);
+      popBoth(dary, binary, 25 + 5 * round);
+    }
+    popBoth(dary, binary, binary.size());
+    assert(dary.empty() && !dary.top());
+  }
+  // pop everything from heaps which end at arity edges - one full
+  // level, one child of a new level and one full group of children
+  const int sizes[] = {1, 2, D, D + 1, D * D, D * D + 1, D * D + D + 1,
+		       D * D + D + 2};
+  for (int k = 0; k < static_cast<int>(sizeof(sizes) / sizeof(int)); k++) {
+    nodeMaker maker;
+    CoinSearchTreeDary<CoinSearchTreeCompareBest, D> dary;
+    binaryTree binary;
+    for (int i = 0; i < sizes[k]; i++) {
+      CoinTreeNode *node = maker.make();
+      dary.push(1, &node);
+      binary.push(1, &node);
+    }
+    assert(isHeap(dary));
+    popBoth(dary, binary, sizes[k]);
+    assert(dary.empty() && binary.empty());
+  }
+  // change of quality in the middle, last and first candidates
+  {
+    nodeMaker maker;
+    CoinSearchTreeDary<CoinSearchTreeCompareBest, D> dary;
+    const int n = D * D + 3;
+    for (int i = 0; i < n; i++) {
+      CoinTreeNode *node = maker.make();
+      dary.push(1, &node);
+    }
+    const int changes[] = {n / 2, n - 1, 0, D, D + 1};
+    for (int k = 0; k < 5; k++) {
+      CoinTreeSiblings *s = dary.getCandidates()[changes[k]];
+      // better than all then worse than all
+      s->currentNode()->setQuality(k % 2 ? 20000.0 : -1.0 - k);
+      dary.update(s);
+      assert(isHeap(dary));
+    }
+    // many changed
+    for (int i = 0; i < n; i++)
+      maker.nodes_[i]->setQuality(maker.nodes_[i]->getQuality() *
+				  (i % 2 ? 1.0 : -1.0));
+    dary.updateKeys();
+    assert(isHeap(dary));
+    double last = -COIN_DBL_MAX;
+    while (!dary.empty()) {
+      assert(dary.top()->getQuality() >= last);
+      last = dary.top()->getQuality();
+      dary.pop();
+      assert(isHeap(dary));
+    }
+  }
+  // made from a binary tree
+  {
+    nodeMaker maker;
+    binaryTree binary;
+    binaryTree *copied = new binaryTree;
+    for (int i = 0; i < 3 * D + 2; i++) {
+      CoinTreeNode *nodes[2];
+      nodes[0] = maker.make();
+      nodes[1] = maker.make();
+      binary.push(2, nodes);
+      copied->push(2, nodes);
+    }
+    CoinSearchTreeDary<CoinSearchTreeCompareBest, D> fromBinary(*copied);
+    // candidates now belong to fromBinary
+    delete copied;
+    assert(isHeap(fromBinary));
+    while (!binary.empty()) {
+      assert(fromBinary.size() == binary.size());
+      assert(fromBinary.top() == binary.top());
+      fromBinary.pop();
+      binary.pop();
+      assert(isHeap(fromBinary));
+    }
+    assert(fromBinary.empty());
+  }
+}
+
+}	// end file-local namespace
+
+void CoinSearchTreeDaryUnitTest()
+{
+  checkArity<2>();
+  checkArity<3>();
+  checkArity<4>();
+  checkArity<8>();
+}
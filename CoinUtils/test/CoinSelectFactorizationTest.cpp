@@ -0,0 +1,279 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinSelectFactorization.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinHelperFunctions.hpp"
+
+namespace {
+
+const int numberRows = 250;
+const int numberColumns = 750;
+const double tolerance = 1.0e-9;
+
+// Sparse columns each with a diagonal so slack free bases exist
+CoinPackedMatrix randomMatrix()
+{
+  CoinThreadRandom random(13579);
+  std::vector<CoinBigIndex> start(1, 0);
+  std::vector<int> row;
+  std::vector<double> element;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    int diagonal = iColumn % numberRows;
+    row.push_back(diagonal);
+    element.push_back(2.0 + random.randomDouble());
+    for (int k = 1; k < 4; k++) {
+      int iRow = (diagonal + 1 + static_cast<int>
+		  (random.randomDouble() * (numberRows - 1))) % numberRows;
+      bool used = false;
+      for (size_t j = start.back(); j < row.size(); j++)
+	used = used || row[j] == iRow;
+      if (!used) {
+	row.push_back(iRow);
+	element.push_back(random.randomDouble() - 0.5);
+      }
+    }
+    start.push_back(static_cast<CoinBigIndex>(row.size()));
+  }
+  return CoinPackedMatrix(true, numberRows, numberColumns,
+			  start[numberColumns], &element[0], &row[0],
+			  &start[0], NULL);
+}
+
+// Column of variable (slacks after structurals) as a dense vector
+void unpack(const CoinPackedMatrix &matrix, int iSequence, double slack,
+	    std::vector<double> &column)
+{
+  column.assign(numberRows, 0.0);
+  if (iSequence >= numberColumns) {
+    column[iSequence - numberColumns] = slack;
+  } else {
+    CoinBigIndex start = matrix.getVectorStarts()[iSequence];
+    for (int j = 0; j < matrix.getVectorLengths()[iSequence]; j++)
+      column[matrix.getIndices()[start + j]] = matrix.getElements()[start + j];
+  }
+}
+
+// Fills and factorizes as ClpFactorization does - returns status
+int factorize(CoinSelectFactorization &factorization,
+	      const CoinPackedMatrix &matrix, int iteration, int *sequence,
+	      int *pivotVariable)
+{
+  double slack = factorization.slackValue();
+  for (int pass = 0; pass < 4; pass++) {
+    CoinBigIndex numberElements = 0;
+    for (int i = 0; i < numberRows; i++)
+      numberElements += sequence[i] >= numberColumns ? 1 :
+	matrix.getVectorLengths()[sequence[i]];
+    // room as ClpFactorization gives
+    numberElements = 3 * numberRows + 3 * numberElements + 20000;
+    factorization.setUsefulInformation(&iteration, 0);
+    factorization.getAreas(numberRows, numberRows, numberElements,
+			   2 * numberElements);
+    CoinFactorizationDouble *elementU = factorization.elements();
+    int *indexRowU = factorization.indices();
+    CoinBigIndex *startColumnU = factorization.starts();
+    int *numberInRow = factorization.numberInRow();
+    int *numberInColumn = factorization.numberInColumn();
+    CoinZeroN(numberInRow, numberRows);
+    CoinZeroN(numberInColumn, numberRows);
+    CoinBigIndex put = 0;
+    std::vector<double> column;
+    for (int i = 0; i < numberRows; i++) {
+      startColumnU[i] = put;
+      unpack(matrix, sequence[i], slack, column);
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+	if (column[iRow]) {
+	  indexRowU[put] = iRow;
+	  elementU[put++] = column[iRow];
+	  numberInRow[iRow]++;
+	}
+      }
+      numberInColumn[i] = static_cast<int>(put - startColumnU[i]);
+    }
+    startColumnU[numberRows] = put;
+    factorization.preProcess();
+    int status = factorization.factor();
+    if (status != -99) {
+      if (!status)
+	factorization.postProcess(sequence, pivotVariable);
+      return status;
+    }
+  }
+  return -99;
+}
+
+// Values of vector by row
+std::vector<double> dense(const CoinIndexedVector &vector)
+{
+  std::vector<double> values(numberRows, 0.0);
+  for (int k = 0; k < vector.getNumElements(); k++) {
+    int iRow = vector.getIndices()[k];
+    values[iRow] = vector.packedMode() ? vector.denseVector()[k] :
+      vector.denseVector()[iRow];
+  }
+  return values;
+}
+
+// Largest error in B x = a where x is by pivot row
+double ftranError(const CoinPackedMatrix &matrix, double slack,
+		  const int *pivotVariable, const CoinIndexedVector &vector,
+		  const std::vector<double> &a)
+{
+  std::vector<double> x = dense(vector);
+  std::vector<double> product(numberRows, 0.0);
+  std::vector<double> column;
+  for (int i = 0; i < numberRows; i++) {
+    unpack(matrix, pivotVariable[i], slack, column);
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      product[iRow] += x[i] * column[iRow];
+  }
+  double largest = 0.0;
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    largest = CoinMax(largest, fabs(product[iRow] - a[iRow]));
+  return largest;
+}
+
+// Largest error in y B = unit vector for pivotRow
+double btranError(const CoinPackedMatrix &matrix, double slack,
+		  const int *pivotVariable, const CoinIndexedVector &vector,
+		  int pivotRow)
+{
+  std::vector<double> y = dense(vector);
+  std::vector<double> column;
+  double largest = 0.0;
+  for (int i = 0; i < numberRows; i++) {
+    unpack(matrix, pivotVariable[i], slack, column);
+    double value = 0.0;
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      value += y[iRow] * column[iRow];
+    largest = CoinMax(largest, fabs(value - (i == pivotRow ? 1.0 : 0.0)));
+  }
+  return largest;
+}
+
+typedef CoinSelectFactorization selector;
+
+}	// end file-local namespace
+
+void CoinSelectFactorizationUnitTest()
+{
+  const CoinPackedMatrix matrix = randomMatrix();
+  CoinSelectFactorization factorization;
+  // sparse only and alternate often so there are switches
+  factorization.setDenseRows(0);
+  factorization.setRetryInterval(2);
+  const int maximumPivots = 60;
+  factorization.maximumPivots(maximumPivots);
+  std::vector<int> sequence(numberRows);
+  std::vector<int> pivotVariable(numberRows);
+  const int numberTotal = numberRows + numberColumns;
+  std::vector<int> rowOf(numberTotal, -1);
+  for (int i = 0; i < numberRows; i++)
+    sequence[i] = numberColumns + i;
+  CoinIndexedVector work;
+  CoinIndexedVector column;
+  CoinIndexedVector row;
+  CoinIndexedVector rowWork;
+  work.reserve(numberRows + maximumPivots + 1);
+  column.reserve(numberRows + maximumPivots + 1);
+  row.reserve(numberRows + maximumPivots + 1);
+  rowWork.reserve(numberRows + maximumPivots + 1);
+  CoinThreadRandom random(24680);
+  int iteration = 0;
+  int numberUsed[2] = {0, 0};
+  int numberSwitches = 0;
+  selector::choice last = selector::chooseAutomatic;
+  for (int cycle = 0; cycle < 12; cycle++) {
+    assert(!factorize(factorization, matrix, iteration, &sequence[0],
+		      &pivotVariable[0]));
+    selector::choice current = factorization.current();
+    assert(current == selector::chooseCoin || current == selector::chooseOsl);
+    numberUsed[current]++;
+    if (last != selector::chooseAutomatic && current != last)
+      numberSwitches++;
+    last = current;
+    rowOf.assign(numberTotal, -1);
+    for (int i = 0; i < numberRows; i++)
+      rowOf[pivotVariable[i]] = i;
+    const double slack = factorization.slackValue();
+    std::vector<double> a;
+    int numberPivots = 0;
+    while (numberPivots < maximumPivots - 10) {
+      int sequenceIn = static_cast<int>(random.randomDouble() * numberTotal);
+      if (sequenceIn >= numberTotal || rowOf[sequenceIn] >= 0)
+	continue;
+      // FTRAN of incoming column to choose pivot row
+      unpack(matrix, sequenceIn, slack, a);
+      std::vector<int> index;
+      std::vector<double> value;
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+	if (a[iRow]) {
+	  index.push_back(iRow);
+	  value.push_back(a[iRow]);
+	  column.insert(iRow, a[iRow]);
+	}
+      }
+      factorization.updateColumn(&work, &column);
+      assert(ftranError(matrix, slack, &pivotVariable[0], column, a) <
+	     tolerance);
+      std::vector<double> x = dense(column);
+      work.clear();
+      column.clear();
+      int pivotRow = -1;
+      double alpha = 0.0;
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+	if (fabs(x[iRow]) > fabs(alpha)) {
+	  alpha = x[iRow];
+	  pivotRow = iRow;
+	}
+      }
+      assert(pivotRow >= 0 && fabs(alpha) > 1.0e-3);
+      // BTRAN of unit vector (as for row of tableau)
+      double one = 1.0;
+      row.createPacked(1, &pivotRow, &one);
+      factorization.updateColumnTranspose(&rowWork, &row);
+      assert(btranError(matrix, slack, &pivotVariable[0], row, pivotRow) <
+	     tolerance);
+      row.clear();
+      rowWork.clear();
+      // FTRAN saving spike for update
+      column.createPacked(static_cast<int>(index.size()), &index[0],
+			  &value[0]);
+      factorization.updateColumnFT(&work, &column);
+      assert(ftranError(matrix, slack, &pivotVariable[0], column, a) <
+	     tolerance);
+      iteration++;
+      factorization.setUsefulInformation(&iteration, 1);
+      int status = factorization.replaceColumn(
+		     factorization.wantsTableauColumn() ? &column : &work,
+		     pivotRow, alpha);
+      work.clear();
+      column.clear();
+      assert(status >= 0 && status <= 3);
+      if (status >= 2)
+	break; // not in
+      int sequenceOut = pivotVariable[pivotRow];
+      rowOf[sequenceOut] = -1;
+      rowOf[sequenceIn] = pivotRow;
+      pivotVariable[pivotRow] = sequenceIn;
+      numberPivots++;
+      if (status == 1)
+	break; // refactorize soon as Clp would
+    }
+    CoinMemcpyN(&pivotVariable[0], numberRows, &sequence[0]);
+  }
+  assert(numberUsed[selector::chooseCoin] && numberUsed[selector::chooseOsl]);
+  assert(numberSwitches >= 2);
+}
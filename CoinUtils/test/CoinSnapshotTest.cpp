@@ -0,0 +1,370 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <algorithm>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinSnapshot.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFinite.hpp"
+
+namespace {
+
+// Large enough that a few updates are logged (up to a quarter of array)
+const int numberRows = 12;
+const int numberColumns = 20;
+
+// Each column has entries in two rows (and first in three if extra)
+CoinPackedMatrix testMatrix(double scale, bool extra = false)
+{
+  std::vector<CoinBigIndex> start;
+  std::vector<int> row;
+  std::vector<double> element;
+  for (int i = 0; i < numberColumns; i++) {
+    start.push_back(static_cast<CoinBigIndex>(row.size()));
+    row.push_back(i % numberRows);
+    element.push_back(scale * (i + 1));
+    row.push_back((i + 2) % numberRows);
+    element.push_back(-scale);
+    if (extra && !i) {
+      row.push_back(1);
+      element.push_back(scale);
+    }
+  }
+  start.push_back(static_cast<CoinBigIndex>(row.size()));
+  return CoinPackedMatrix(true, numberRows, numberColumns,
+			  start[numberColumns], &element[0], &row[0],
+			  &start[0], NULL);
+}
+
+// Solver side of a view - arrays and a generation for each
+class testSource : public CoinSnapshotSource {
+public:
+  testSource()
+    : colLower(numberColumns, 0.0), colUpper(numberColumns, 10.0),
+      rowLower(numberRows, -COIN_DBL_MAX), rowUpper(numberRows, 4.0),
+      objective(numberColumns, 1.0), colType(numberColumns, 'C'),
+      colSolution(numberColumns, 0.5), matrix(testMatrix(1.0))
+  {
+    rowLower[1] = 1.0;
+    rowUpper[1] = COIN_DBL_MAX;
+    colType[2] = 'B';
+    for (int i = 0; i < CoinSnapshot::numberArrayTypes; i++)
+      generation[i] = 1;
+  }
+  virtual int getNumRows() const { return numberRows; }
+  virtual int getNumCols() const { return numberColumns; }
+  virtual const void *getArray(CoinSnapshot::arrayType which) const
+  {
+    switch (which) {
+    case CoinSnapshot::colLowerArray:
+      return &colLower[0];
+    case CoinSnapshot::colUpperArray:
+      return &colUpper[0];
+    case CoinSnapshot::rowLowerArray:
+      return &rowLower[0];
+    case CoinSnapshot::rowUpperArray:
+      return &rowUpper[0];
+    case CoinSnapshot::objCoefficientsArray:
+      return &objective[0];
+    case CoinSnapshot::colTypeArray:
+      return &colType[0];
+    case CoinSnapshot::matrixByColArray:
+      return &matrix;
+    case CoinSnapshot::colSolutionArray:
+      return &colSolution[0];
+    default:
+      // no right hand side so snapshot makes one
+      return NULL;
+    }
+  }
+  virtual unsigned int getGeneration(CoinSnapshot::arrayType which) const
+  {
+    return generation[which];
+  }
+  std::vector<double> colLower;
+  std::vector<double> colUpper;
+  std::vector<double> rowLower;
+  std::vector<double> rowUpper;
+  std::vector<double> objective;
+  std::vector<char> colType;
+  std::vector<double> colSolution;
+  CoinPackedMatrix matrix;
+  unsigned int generation[CoinSnapshot::numberArrayTypes];
+};
+
+// Right hand side as documented for getRightHandSide
+bool rightHandSideOK(const CoinSnapshot &snapshot)
+{
+  const double *rhs = snapshot.getRightHandSide();
+  for (int i = 0; i < snapshot.getNumRows(); i++) {
+    const double upper = snapshot.getRowUpper()[i];
+    if (rhs[i] != (upper != snapshot.getInfinity() ?
+		   upper : snapshot.getRowLower()[i]))
+      return false;
+  }
+  return true;
+}
+
+// A view sees changes the solver makes after it was set
+void testView()
+{
+  testSource source;
+  CoinSnapshot snapshot;
+  snapshot.setView(&source);
+  assert(snapshot.getViewSource() == &source && snapshot.isValid());
+  assert(snapshot.getNumRows() == numberRows);
+  assert(snapshot.getNumCols() == numberColumns);
+  assert(snapshot.getColLower() == &source.colLower[0]);
+  assert(snapshot.getMatrixByCol() == &source.matrix);
+  assert(snapshot.getNumElements() == source.matrix.getNumElements());
+  assert(snapshot.getNumIntegers() == 1 && snapshot.isBinary(2));
+  assert(snapshot.isViewed(CoinSnapshot::colUpperArray));
+  assert(!snapshot.isViewed(CoinSnapshot::rightHandSideArray));
+  assert(snapshot.getRightHandSide() && rightHandSideOK(snapshot));
+
+  // in place - seen at once, and after the generation moves until refresh
+  // the snapshot knows it is out of date
+  source.colUpper[3] = 7.0;
+  assert(snapshot.getColUpper()[3] == 7.0);
+  unsigned int generation = snapshot.getGeneration();
+  source.generation[CoinSnapshot::colUpperArray]++;
+  assert(!snapshot.isValid());
+  assert(snapshot.refresh() == 1 && snapshot.isValid());
+  assert(snapshot.changedSince(CoinSnapshot::colUpperArray, generation));
+  assert(!snapshot.changedSince(CoinSnapshot::colLowerArray, generation));
+  assert(snapshot.refresh() == 0);
+
+  // row bounds - right hand side follows
+  source.rowUpper[0] = 2.5;
+  source.rowUpper[1] = 6.0;
+  source.generation[CoinSnapshot::rowUpperArray]++;
+  generation = snapshot.getGeneration();
+  assert(snapshot.refresh() == 1);
+  assert(snapshot.getRightHandSide()[0] == 2.5);
+  assert(snapshot.getRightHandSide()[1] == 6.0 && rightHandSideOK(snapshot));
+  assert(snapshot.changedSince(CoinSnapshot::rightHandSideArray, generation));
+
+  // moved array
+  std::vector<double> moved(source.colLower);
+  moved[0] = -3.0;
+  source.colLower.swap(moved);
+  source.generation[CoinSnapshot::colLowerArray]++;
+  assert(snapshot.refresh() == 1);
+  assert(snapshot.getColLower() == &source.colLower[0]);
+  assert(snapshot.getColLower()[0] == -3.0);
+
+  // counts follow types and matrix
+  source.colType[5] = 'I';
+  source.matrix = testMatrix(2.0, true);
+  source.generation[CoinSnapshot::colTypeArray]++;
+  source.generation[CoinSnapshot::matrixByColArray]++;
+  assert(snapshot.refresh() == 2);
+  assert(snapshot.getNumIntegers() == 2 && snapshot.isIntegerNonBinary(5));
+  assert(snapshot.getNumElements() == 2 * numberColumns + 1);
+
+  // a copy shares the source
+  CoinSnapshot copy(snapshot);
+  assert(copy.getViewSource() == &source && copy.isValid());
+  assert(copy.getColSolution() == &source.colSolution[0]);
+
+  // arrays set since are left alone
+  const std::vector<double> lower(numberColumns, 1.0);
+  snapshot.setColLower(&lower[0]);
+  assert(!snapshot.isViewed(CoinSnapshot::colLowerArray));
+  source.colLower[0] = -4.0;
+  source.generation[CoinSnapshot::colLowerArray]++;
+  assert(snapshot.isValid() && !snapshot.refresh());
+  assert(snapshot.getColLower()[0] == 1.0);
+  assert(!copy.isValid() && copy.refresh() == 1);
+  assert(copy.getColLower()[0] == -4.0);
+}
+
+// Problem and solution for testUpdate
+struct problemData {
+  problemData()
+    : colLower(numberColumns, 0.0), colUpper(numberColumns),
+      objective(numberColumns), rowLower(numberRows, -COIN_DBL_MAX),
+      rowUpper(numberRows), colSolution(numberColumns, 1.0),
+      rowPrice(numberRows, 0.0), reducedCost(numberColumns, 0.0),
+      rowActivity(numberRows, 0.0)
+  {
+    for (int i = 0; i < numberColumns; i++) {
+      colUpper[i] = i + 1.0;
+      objective[i] = i % 3 - 1.0;
+    }
+    for (int i = 0; i < numberRows; i++)
+      rowUpper[i] = i % 4 ? 2.0 * i : COIN_DBL_MAX;
+  }
+  // copies everything into snapshot as a solver would
+  void load(CoinSnapshot &snapshot) const
+  {
+    snapshot.loadProblem(testMatrix(1.0), &colLower[0], &colUpper[0],
+			 &objective[0], &rowLower[0], &rowUpper[0]);
+    snapshot.setColSolution(&colSolution[0]);
+    snapshot.setRowPrice(&rowPrice[0]);
+    snapshot.setReducedCost(&reducedCost[0]);
+    snapshot.setRowActivity(&rowActivity[0]);
+  }
+  std::vector<double> colLower;
+  std::vector<double> colUpper;
+  std::vector<double> objective;
+  std::vector<double> rowLower;
+  std::vector<double> rowUpper;
+  std::vector<double> colSolution;
+  std::vector<double> rowPrice;
+  std::vector<double> reducedCost;
+  std::vector<double> rowActivity;
+};
+
+bool same(const double *a, const double *b, int n)
+{
+  for (int i = 0; i < n; i++) {
+    if (a[i] != b[i])
+      return false;
+  }
+  return true;
+}
+
+bool sameProblem(const CoinSnapshot &a, const CoinSnapshot &b)
+{
+  const int m = numberRows;
+  const int n = numberColumns;
+  return a.getNumRows() == m && b.getNumRows() == m &&
+    a.getNumCols() == n && b.getNumCols() == n &&
+    a.getNumElements() == b.getNumElements() &&
+    same(a.getColLower(), b.getColLower(), n) &&
+    same(a.getColUpper(), b.getColUpper(), n) &&
+    same(a.getObjCoefficients(), b.getObjCoefficients(), n) &&
+    same(a.getRowLower(), b.getRowLower(), m) &&
+    same(a.getRowUpper(), b.getRowUpper(), m) &&
+    same(a.getRightHandSide(), b.getRightHandSide(), m) &&
+    same(a.getColSolution(), b.getColSolution(), n) &&
+    same(a.getRowPrice(), b.getRowPrice(), m) &&
+    same(a.getReducedCost(), b.getReducedCost(), n) &&
+    same(a.getRowActivity(), b.getRowActivity(), m);
+}
+
+// Entries changed as a sorted list (or -1)
+std::vector<int> changed(const CoinSnapshot &snapshot,
+			 CoinSnapshot::arrayType which,
+			 unsigned int generation)
+{
+  std::vector<int> entries(numberRows + numberColumns);
+  int number = snapshot.getChangedEntries(which, generation, &entries[0]);
+  if (number < 0)
+    return std::vector<int>(1, -1);
+  entries.resize(number);
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  return entries;
+}
+
+// Updates give the same snapshot as loading the changed data
+void testUpdate()
+{
+  problemData data;
+  CoinSnapshot snapshot;
+  data.load(snapshot);
+  const unsigned int generation = snapshot.getGeneration();
+
+  // each change made to data and (as update) to snapshot
+  const int columns[] = {6, 1};
+  const double colLower[] = {-2.0, 0.5};
+  snapshot.updateColLower(2, columns, colLower);
+  data.colLower[6] = -2.0;
+  data.colLower[1] = 0.5;
+  const double colUpper[] = {3.0};
+  snapshot.updateColUpper(1, columns, colUpper);
+  data.colUpper[6] = 3.0;
+  // row 4 upper infinite and row 3 finite - both change right hand side
+  const int rows[] = {4, 3};
+  const double rowUpper[] = {9.0, COIN_DBL_MAX};
+  snapshot.updateRowUpper(2, rows, rowUpper);
+  data.rowUpper[4] = 9.0;
+  data.rowUpper[3] = COIN_DBL_MAX;
+  const double rowLower[] = {-1.0};
+  snapshot.updateRowLower(1, rows + 1, rowLower);
+  data.rowLower[3] = -1.0;
+  const double values[] = {0.25, 0.75};
+  snapshot.updateColSolution(2, columns, values);
+  data.colSolution[6] = 0.25;
+  data.colSolution[1] = 0.75;
+  snapshot.updateRowPrice(1, rows, values);
+  data.rowPrice[4] = 0.25;
+  snapshot.updateReducedCost(2, columns, values);
+  data.reducedCost[6] = 0.25;
+  data.reducedCost[1] = 0.75;
+  snapshot.updateRowActivity(1, rows + 1, values + 1);
+  data.rowActivity[3] = 0.75;
+
+  CoinSnapshot loaded;
+  data.load(loaded);
+  assert(sameProblem(snapshot, loaded));
+  assert(rightHandSideOK(snapshot));
+
+  // and says what changed
+  std::vector<int> expected;
+  expected.push_back(1);
+  expected.push_back(6);
+  assert(changed(snapshot, CoinSnapshot::colLowerArray, generation) == expected);
+  assert(changed(snapshot, CoinSnapshot::reducedCostArray, generation) ==
+	 expected);
+  expected.assign(1, 6);
+  assert(changed(snapshot, CoinSnapshot::colUpperArray, generation) == expected);
+  expected.assign(1, 3);
+  expected.push_back(4);
+  assert(changed(snapshot, CoinSnapshot::rightHandSideArray, generation) ==
+	 expected);
+  assert(!snapshot.changedSince(CoinSnapshot::objCoefficientsArray,
+				generation));
+  const unsigned int later = snapshot.getGeneration();
+  assert(later > generation);
+  assert(changed(snapshot, CoinSnapshot::colLowerArray, later).empty());
+
+  // many changes - whole array changed, values still the same as loaded
+  std::vector<int> many;
+  std::vector<double> manyValues;
+  for (int i = 0; i < numberColumns; i += 2) {
+    many.push_back(i);
+    manyValues.push_back(-i);
+    data.colSolution[i] = -i;
+  }
+  snapshot.updateColSolution(static_cast<int>(many.size()), &many[0],
+			     &manyValues[0]);
+  assert(changed(snapshot, CoinSnapshot::colSolutionArray, later) ==
+	 std::vector<int>(1, -1));
+  CoinSnapshot reloaded;
+  data.load(reloaded);
+  assert(sameProblem(snapshot, reloaded));
+
+  // update of a view copies the array and leaves the solver's alone
+  testSource source;
+  CoinSnapshot view;
+  view.setView(&source);
+  view.updateColUpper(1, columns, colUpper);
+  assert(view.getColUpper() != &source.colUpper[0]);
+  assert(view.getColUpper()[6] == 3.0 && source.colUpper[6] == 10.0);
+  assert(!view.isViewed(CoinSnapshot::colUpperArray));
+  view.updateRowUpper(2, rows, rowUpper);
+  assert(source.rowUpper[4] == 4.0 && rightHandSideOK(view));
+  source.generation[CoinSnapshot::colUpperArray]++;
+  source.generation[CoinSnapshot::rowUpperArray]++;
+  assert(view.isValid() && !view.refresh());
+  assert(view.getColUpper()[6] == 3.0 && view.getRowUpper()[4] == 9.0);
+}
+
+}	// end file-local namespace
+
+void CoinSnapshotUnitTest()
+{
+  testView();
+  testUpdate();
+}
@@ -0,0 +1,139 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Times CoinSort_2 and CoinSort_3 serially and with the parallel merge
+// sort and checks both give correctly sorted permutations.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include "CoinSort.hpp"
+
+namespace {
+
+// Returns true if s is sorted by pc and is original permuted by t
+template <class S, class CoinCompare2>
+bool checkSort(const S *s, const int *t, const S *original, int n,
+	       const CoinCompare2 &pc)
+{
+  char *seen = new char[n];
+  CoinZeroN(seen, n);
+  bool ok = true;
+  for (int i = 0; i < n && ok; i++) {
+    ok = t[i] >= 0 && t[i] < n && !seen[t[i]] && s[i] == original[t[i]];
+    if (ok)
+      seen[t[i]] = 1;
+    if (ok && i)
+      ok = !pc(CoinPair<S, int>(s[i], 0), CoinPair<S, int>(s[i-1], 0));
+  }
+  delete[] seen;
+  return ok;
+}
+
+// Times one comparison on a pair sort and a triple sort
+template <class S, class CoinCompare2, class CoinCompare3>
+bool benchSort(const char *name, const S *original, int n, int numberThreads,
+	       const CoinCompare2 &pc, const CoinCompare3 &tc)
+{
+  S *s = new S[n];
+  int *t = new int[n];
+  double *u = new double[n];
+  bool ok = true;
+  double times[4];
+  for (int pass = 0; pass < 4; pass++) {
+    CoinMemcpyN(original, n, s);
+    for (int i = 0; i < n; i++) {
+      t[i] = i;
+      u[i] = i;
+    }
+    double time1 = CoinWallclockTime();
+    int threads = (pass & 1) ? numberThreads : 1;
+    if (pass < 2) {
+      CoinSortParallel<CoinSortArrays_2<S, int>, CoinCompare2>
+	sorter(CoinSortArrays_2<S, int>(s, t), n, pc);
+      sorter.sort(threads);
+    } else {
+      CoinSortParallel<CoinSortArrays_3<S, int, double>, CoinCompare3>
+	sorter(CoinSortArrays_3<S, int, double>(s, t, u), n, tc);
+      sorter.sort(threads);
+      for (int i = 0; i < n && ok; i++)
+	ok = u[i] == t[i];
+    }
+    times[pass] = CoinWallclockTime() - time1;
+    ok = ok && checkSort(s, t, original, n, pc);
+  }
+  printf("%-18s %9d  pair %8.4f %8.4f  triple %8.4f %8.4f  %s\n",
+    name, n, times[0], times[1], times[2], times[3], ok ? "ok" : "WRONG");
+  delete[] s;
+  delete[] t;
+  delete[] u;
+  return ok;
+}
+
+} // namespace
+
+//----------------------------------------------------------------
+// benchmark sort [-size=N] [-threads=N]
+//
+// Each line gives seconds with one thread and with -threads threads
+// (tasks are run one after another if CoinUtils was built without
+// thread support).
+//----------------------------------------------------------------
+int CoinSortBenchmark(std::map<std::string, std::string> &parms)
+{
+  int n = 2000000;
+  int numberThreads = 4;
+  if (parms.find("-size") != parms.end())
+    n = atoi(parms["-size"].c_str());
+  if (parms.find("-threads") != parms.end())
+    numberThreads = atoi(parms["-threads"].c_str());
+  if (n < 1 || numberThreads < 1) {
+    printf("Bad -size or -threads\n");
+    return 1;
+  }
+  CoinSeedRandom(1234567);
+  int *intKey = new int[n];
+  double *doubleKey = new double[n];
+  for (int i = 0; i < n; i++) {
+    intKey[i] = static_cast<int>(CoinDrand48() * n) - n / 2;
+    doubleKey[i] = floor((CoinDrand48() - 0.5) * 1.0e6) * 1.0e-3;
+  }
+  printf("%-18s %9s  (seconds serial, %d threads)\n", "comparison", "size",
+    numberThreads);
+  bool ok = true;
+  ok = benchSort("int less", intKey, n, numberThreads,
+	 CoinFirstLess_2<int, int>(), CoinFirstLess_3<int, int, double>())
+    && ok;
+  ok = benchSort("int greater", intKey, n, numberThreads,
+	 CoinFirstGreater_2<int, int>(),
+	 CoinFirstGreater_3<int, int, double>())
+    && ok;
+  ok = benchSort("double less", doubleKey, n, numberThreads,
+	 CoinFirstLess_2<double, int>(),
+	 CoinFirstLess_3<double, int, double>())
+    && ok;
+  ok = benchSort("double absgreater", doubleKey, n, numberThreads,
+	 CoinFirstAbsGreater_2<double, int>(),
+	 CoinFirstAbsGreater_3<double, int, double>())
+    && ok;
+  // external vector comparison can not use a radix sort
+  CoinExternalVectorFirstLess_2<int, int, double> externalLess(doubleKey);
+  CoinExternalVectorFirstLess_3<int, int, double, double> externalLess3(doubleKey);
+  int *position = new int[n];
+  for (int i = 0; i < n; i++)
+    position[i] = static_cast<int>((static_cast<CoinInt64>(i) * 7919) % n);
+  ok = benchSort("external less", position, n, numberThreads,
+	 externalLess, externalLess3)
+    && ok;
+  delete[] position;
+  delete[] intKey;
+  delete[] doubleKey;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cfloat>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinSort.hpp"
+#include "CoinHelperFunctions.hpp"
+
+namespace {
+
+// Enough entries for the radix sort but serial
+const int numberEntries = COIN_RADIX_SORT_MIN + 1000;
+
+// Keys with many ties (and payload is position so order of ties shows)
+std::vector<int> intKeys()
+{
+  CoinThreadRandom random(97531);
+  std::vector<int> key(numberEntries);
+  for (int i = 0; i < numberEntries; i++)
+    key[i] = static_cast<int>(random.randomDouble() * 101.0) - 50;
+  key[7] = INT_MIN;
+  key[11] = INT_MAX;
+  key[13] = INT_MIN;
+  return key;
+}
+
+// Ties, negatives, both zeros and the same absolute value with each sign
+std::vector<double> doubleKeys()
+{
+  const double few[] = {0.0, -0.0, 1.5, -1.5, 3.0, -3.0, 1.0e-300,
+			-1.0e-300, DBL_MAX, -DBL_MAX};
+  const int numberFew = static_cast<int>(sizeof(few) / sizeof(double));
+  CoinThreadRandom random(86420);
+  std::vector<double> key(numberEntries);
+  for (int i = 0; i < numberEntries; i++) {
+    int k = static_cast<int>(random.randomDouble() * 2 * numberFew);
+    key[i] = k < numberFew ? few[k] : 100.0 * (random.randomDouble() - 0.5);
+  }
+  return key;
+}
+
+// Radix sort must give exactly the stable comparison sort
+template <class S, class Compare2>
+void checkSort2(const std::vector<S> &key, const Compare2 &pc)
+{
+  const int n = static_cast<int>(key.size());
+  std::vector<S> s(key);
+  std::vector<int> t(n);
+  std::vector<CoinPair<S,int> > x;
+  for (int i = 0; i < n; i++) {
+    t[i] = i;
+    x.push_back(CoinPair<S,int>(key[i], i));
+  }
+  CoinSort_2(&s[0], &s[0] + n, &t[0], pc);
+  std::stable_sort(x.begin(), x.end(), pc);
+  for (int i = 0; i < n; i++) {
+    // bits so -0.0 and +0.0 are told apart
+    assert(!memcmp(&s[i], &x[i].first, sizeof(S)));
+    assert(t[i] == x[i].second);
+  }
+}
+
+template <class S, class Compare3>
+void checkSort3(const std::vector<S> &key, const Compare3 &tc)
+{
+  const int n = static_cast<int>(key.size());
+  std::vector<S> s(key);
+  std::vector<int> t(n);
+  std::vector<double> u(n);
+  std::vector<CoinTriple<S,int,double> > x;
+  for (int i = 0; i < n; i++) {
+    t[i] = i;
+    u[i] = 0.5 * i;
+    x.push_back(CoinTriple<S,int,double>(key[i], i, 0.5 * i));
+  }
+  CoinSort_3(&s[0], &s[0] + n, &t[0], &u[0], tc);
+  std::stable_sort(x.begin(), x.end(), tc);
+  for (int i = 0; i < n; i++) {
+    assert(!memcmp(&s[i], &x[i].first, sizeof(S)));
+    assert(t[i] == x[i].second);
+    assert(u[i] == x[i].third);
+  }
+}
+
+}	// end file-local namespace
+
+void CoinSortUnitTest()
+{
+  const std::vector<int> intKey = intKeys();
+  checkSort2(intKey, CoinFirstLess_2<int,int>());
+  checkSort2(intKey, CoinFirstGreater_2<int,int>());
+  checkSort3(intKey, CoinFirstLess_3<int,int,double>());
+  checkSort3(intKey, CoinFirstGreater_3<int,int,double>());
+
+  const std::vector<double> doubleKey = doubleKeys();
+  checkSort2(doubleKey, CoinFirstLess_2<double,int>());
+  checkSort2(doubleKey, CoinFirstGreater_2<double,int>());
+  checkSort2(doubleKey, CoinFirstAbsLess_2<double,int>());
+  checkSort2(doubleKey, CoinFirstAbsGreater_2<double,int>());
+  checkSort3(doubleKey, CoinFirstLess_3<double,int,double>());
+  checkSort3(doubleKey, CoinFirstGreater_3<double,int,double>());
+  checkSort3(doubleKey, CoinFirstAbsLess_3<double,int,double>());
+  checkSort3(doubleKey, CoinFirstAbsGreater_3<double,int,double>());
+
+  // default (increasing) and a key set which is all one value
+  std::vector<double> s(doubleKey);
+  std::vector<int> t(s.size());
+  CoinSort_2(&s[0], &s[0] + s.size(), &t[0]);
+  for (size_t i = 1; i < s.size(); i++)
+    assert(s[i - 1] <= s[i]);
+  checkSort2(std::vector<int>(numberEntries, 3), CoinFirstLess_2<int,int>());
+}
@@ -0,0 +1,187 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinStructuredMatrix.hpp"
+#include "CoinStructuredModel.hpp"
+#include "CoinModel.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinShallowPackedVector.hpp"
+
+void CoinStructuredMatrixUnitTest()
+{
+  // Block products - diagonal blocks, linking rows and linking columns
+  const int numberDiagonal = 8;
+  const int blockRows = 200;
+  const int blockColumns = 400;
+  const int linkingRows = 20;
+  const int linkingColumns = 400;
+  CoinStructuredModel structured;
+  std::vector<int> rowBlockOf;
+  std::vector<int> columnBlockOf;
+  std::vector<CoinPackedMatrix> pieces;
+  for (int k = 0; k < numberDiagonal; k++) {
+    char rowName[20];
+    char columnName[20];
+    sprintf(rowName,"R%d",k);
+    sprintf(columnName,"C%d",k);
+    int index[16];
+    double elements[16];
+    CoinPackedMatrix diagonal(true,0,0);
+    diagonal.setDimensions(blockRows,0);
+    for (int iColumn = 0; iColumn < blockColumns; iColumn++) {
+      // 11*j differ for j < 16 so no repeats
+      for (int j = 0; j < 16; j++) {
+	index[j] = (iColumn*3 + 11*j + k)%blockRows;
+	elements[j] = ((iColumn + j + k)%7) - 3.5;
+      }
+      diagonal.appendCol(16,index,elements);
+    }
+    // one given by rows
+    if (k == 3)
+      diagonal.reverseOrdering();
+    CoinPackedMatrix linking(true,0,0);
+    linking.setDimensions(linkingRows,0);
+    for (int iColumn = 0; iColumn < blockColumns; iColumn++) {
+      for (int j = 0; j < 10; j++) {
+	index[j] = (iColumn + k + 2*j)%linkingRows;
+	elements[j] = 1.0 + ((iColumn + j)%3);
+      }
+      linking.appendCol(10,index,elements);
+    }
+    CoinPackedMatrix benders(true,0,0);
+    benders.setDimensions(blockRows,0);
+    for (int iColumn = 0; iColumn < linkingColumns; iColumn++) {
+      for (int j = 0; j < 10; j++) {
+	index[j] = (iColumn + k + 20*j)%blockRows;
+	elements[j] = (j%2) ? -1.0 : 0.5*(k+1);
+      }
+      benders.appendCol(10,index,elements);
+    }
+    // as decompose makes blocks
+    structured.addBlock(rowName,columnName,
+			new CoinModel(blockRows,blockColumns,&diagonal,
+				      NULL,NULL,NULL,NULL,NULL));
+    structured.addBlock("L",columnName,
+			new CoinModel(linkingRows,blockColumns,&linking,
+				      NULL,NULL,NULL,NULL,NULL));
+    structured.addBlock(rowName,"X",
+			new CoinModel(blockRows,linkingColumns,&benders,
+				      NULL,NULL,NULL,NULL,NULL));
+    rowBlockOf.push_back(structured.rowBlock(rowName));
+    columnBlockOf.push_back(structured.columnBlock(columnName));
+    pieces.push_back(diagonal);
+    rowBlockOf.push_back(structured.rowBlock("L"));
+    columnBlockOf.push_back(structured.columnBlock(columnName));
+    pieces.push_back(linking);
+    rowBlockOf.push_back(structured.rowBlock(rowName));
+    columnBlockOf.push_back(structured.columnBlock("X"));
+    pieces.push_back(benders);
+  }
+  CoinStructuredMatrix blocks(structured);
+  const int numberRows = blocks.getNumRows();
+  const int numberColumns = blocks.getNumCols();
+  assert( numberRows == numberDiagonal*blockRows + linkingRows );
+  assert( numberColumns == numberDiagonal*blockColumns + linkingColumns );
+  assert( blocks.numberBlocks() == 3*numberDiagonal );
+  assert( blocks.numberBlocksInRowBlock(structured.rowBlock("L")) ==
+	  numberDiagonal );
+  assert( blocks.numberBlocksInRowBlock(structured.rowBlock("R2")) == 2 );
+  assert( blocks.numberBlocksInColumnBlock(structured.columnBlock("X")) ==
+	  numberDiagonal );
+  // same matrix flat in block order
+  const int * rowStart = blocks.rowBlockStarts();
+  const int * columnStart = blocks.columnBlockStarts();
+  std::vector<int> rows;
+  std::vector<int> columns;
+  std::vector<double> values;
+  for (size_t i = 0; i < pieces.size(); i++) {
+    CoinPackedMatrix piece;
+    if (pieces[i].isColOrdered())
+      piece.reverseOrderedCopyOf(pieces[i]);
+    else
+      piece = pieces[i];
+    for (int iRow = 0; iRow < piece.getNumRows(); iRow++) {
+      const CoinShallowPackedVector row = piece.getVector(iRow);
+      for (int j = 0; j < row.getNumElements(); j++) {
+	rows.push_back(iRow + rowStart[rowBlockOf[i]]);
+	columns.push_back(row.getIndices()[j] +
+			  columnStart[columnBlockOf[i]]);
+	values.push_back(row.getElements()[j]);
+      }
+    }
+  }
+  CoinPackedMatrix flat(true,&rows[0],&columns[0],&values[0],
+			static_cast<CoinBigIndex>(values.size()));
+  flat.setDimensions(numberRows,numberColumns);
+  assert( flat.getNumElements() == blocks.getNumElements() );
+  std::vector<double> x(numberColumns);
+  std::vector<double> lower(numberColumns);
+  std::vector<double> upper(numberColumns);
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    x[iColumn] = ((iColumn*13)%17) - 8.0;
+    lower[iColumn] = (iColumn%11 == 0) ? -COIN_DBL_MAX : -1.0;
+    upper[iColumn] = (iColumn%977 == 0) ? COIN_DBL_MAX : 2.0 + iColumn%3;
+  }
+  std::vector<double> y(numberRows);
+  for (int iRow = 0; iRow < numberRows; iRow++)
+    y[iRow] = ((iRow*7)%5) - 2.0;
+  std::vector<double> flatY(numberRows);
+  std::vector<double> flatX(numberColumns);
+  flat.times(&x[0],&flatY[0]);
+  flat.transposeTimes(&y[0],&flatX[0]);
+  // activity bounds the slow way
+  std::vector<double> flatMinimum(numberRows,0.0);
+  std::vector<double> flatMaximum(numberRows,0.0);
+  std::vector<int> infiniteMinimum(numberRows,0);
+  std::vector<int> infiniteMaximum(numberRows,0);
+  for (size_t j = 0; j < values.size(); j++) {
+    const int iRow = rows[j];
+    const double value = values[j];
+    const double forMinimum = value > 0.0 ? lower[columns[j]] :
+      upper[columns[j]];
+    const double forMaximum = value > 0.0 ? upper[columns[j]] :
+      lower[columns[j]];
+    if (fabs(forMinimum) >= 1.0e30)
+      infiniteMinimum[iRow]++;
+    else
+      flatMinimum[iRow] += value*forMinimum;
+    if (fabs(forMaximum) >= 1.0e30)
+      infiniteMaximum[iRow]++;
+    else
+      flatMaximum[iRow] += value*forMaximum;
+  }
+  // with 5 threads "L" and "X" have more than a share so are added up
+  for (int numberThreads = 1; numberThreads <= 5; numberThreads += 4) {
+    blocks.setNumberThreads(numberThreads);
+    std::vector<double> blockY(numberRows,1.0e50);
+    std::vector<double> blockX(numberColumns,1.0e50);
+    std::vector<double> minimum(numberRows,1.0e50);
+    std::vector<double> maximum(numberRows,1.0e50);
+    blocks.times(&x[0],&blockY[0]);
+    blocks.transposeTimes(&y[0],&blockX[0]);
+    blocks.rowActivityBounds(&lower[0],&upper[0],&minimum[0],&maximum[0]);
+    for (int iRow = 0; iRow < numberRows; iRow++) {
+      assert( fabs(blockY[iRow] - flatY[iRow]) < 1.0e-9 );
+      if (infiniteMinimum[iRow])
+	assert( minimum[iRow] == -COIN_DBL_MAX );
+      else
+	assert( fabs(minimum[iRow] - flatMinimum[iRow]) < 1.0e-9 );
+      if (infiniteMaximum[iRow])
+	assert( maximum[iRow] == COIN_DBL_MAX );
+      else
+	assert( fabs(maximum[iRow] - flatMaximum[iRow]) < 1.0e-9 );
+    }
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      assert( fabs(blockX[iColumn] - flatX[iColumn]) < 1.0e-9 );
+  }
+}
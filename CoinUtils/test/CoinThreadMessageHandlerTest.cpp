@@ -0,0 +1,122 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinThreadMessageHandler.hpp"
+
+namespace {
+
+const int numberThreads = 4;
+const int numberLines = 500;
+// Messages printed by any recordingHandler
+int numberSeen = 0;
+
+/* Keeps thread and line number of each message printed.  print() runs in
+   the writer thread only so needs no locking. */
+class recordingHandler : public CoinThreadMessageHandler {
+public:
+  recordingHandler() : CoinThreadMessageHandler() {}
+  ~recordingHandler() { flush(); }
+  virtual int print()
+  {
+    int thread = -1;
+    int line = -1;
+    int n = sscanf(messageBuffer(),"thread %d line %d",&thread,&line);
+    assert (n==2);
+    assert (currentMessage().externalNumber()==thread+1);
+    threads_.push_back(thread);
+    lines_.push_back(line);
+    numberSeen++;
+    return 0;
+  }
+  std::vector<int> threads_;
+  std::vector<int> lines_;
+};
+
+struct threadInfo {
+  CoinMessageHandler * handler;
+  int thread;
+};
+
+void * logLines(void * info)
+{
+  threadInfo * mine = static_cast<threadInfo *>(info);
+  char line[80];
+  for (int i=0;i<numberLines;i++) {
+    sprintf(line,"thread %d line %d",mine->thread,i);
+    mine->handler->message(mine->thread+1,"TST",line,'I',1) << CoinMessageEol;
+  }
+  return NULL;
+}
+
+}	// end file-local namespace
+
+void CoinThreadMessageHandlerUnitTest()
+{
+  recordingHandler handler;
+  handler.setLogLevel(1);
+  handler.setPrefix(false);
+  threadInfo info[numberThreads];
+  for (int i=0;i<numberThreads;i++) {
+    info[i].handler = &handler;
+    info[i].thread = i;
+  }
+#ifdef COINUTILS_PTHREADS
+  assert (handler.threaded());
+  pthread_t threads[numberThreads];
+  for (int i=0;i<numberThreads;i++)
+    pthread_create(threads+i,NULL,logLines,info+i);
+  for (int i=0;i<numberThreads;i++)
+    pthread_join(threads[i],NULL);
+#else
+  for (int i=0;i<numberThreads;i++)
+    logLines(info+i);
+#endif
+  handler.flush();
+  // every message printed whole, each thread's in the order it logged them
+  int numberPrinted = static_cast<int>(handler.lines_.size());
+  assert (numberPrinted==numberThreads*numberLines);
+  std::vector<int> next(numberThreads,0);
+  for (int i=0;i<numberPrinted;i++) {
+    int thread = handler.threads_[i];
+    assert (thread>=0&&thread<numberThreads);
+    assert (handler.lines_[i]==next[thread]);
+    next[thread]++;
+  }
+  for (int i=0;i<numberThreads;i++)
+    assert (next[i]==numberLines);
+
+  // a thread only takes new log level after settingsChanged()
+  handler.threads_.clear();
+  handler.lines_.clear();
+  handler.message(1,"TST","thread 0 line 0",'I',1) << CoinMessageEol;
+  handler.setLogLevel(0);
+  handler.settingsChanged();
+  handler.message(1,"TST","thread 0 line 1",'I',1) << CoinMessageEol;
+  handler.setLogLevel(1);
+  handler.settingsChanged();
+  handler.message(1,"TST","thread 0 line 2",'I',1) << CoinMessageEol;
+  handler.flush();
+  assert (handler.lines_.size()==2);
+  assert (handler.lines_[0]==0);
+  assert (handler.lines_[1]==2);
+
+  // messages still queued are printed by this print() before it goes
+  recordingHandler * last = new recordingHandler();
+  last->setLogLevel(1);
+  last->setPrefix(false);
+  info[0].handler = last;
+  numberSeen = 0;
+  logLines(info);
+  delete last;
+  assert (numberSeen==numberLines);
+}
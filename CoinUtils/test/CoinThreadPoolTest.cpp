@@ -0,0 +1,239 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinThreadPool.hpp"
+#include "CoinHelperFunctions.hpp"
+#ifdef COINUTILS_PTHREADS
+#include <pthread.h>
+#endif
+
+namespace {
+
+const int numberValues = 10000;
+const int numberInner = 8;
+
+// Sums one piece of an array
+struct sumInfo {
+  const int * values;
+  int start;
+  int end;
+  long long sum;
+  int timesRun;
+};
+
+void * sumPiece(void * info)
+{
+  sumInfo * piece = static_cast<sumInfo *>(info);
+  long long sum = 0;
+  for (int i=piece->start;i<piece->end;i++)
+    sum += piece->values[i];
+  piece->sum = sum;
+  piece->timesRun++;
+  return NULL;
+}
+
+// Sum of values in pieces - returns total
+long long sumPieces(const int * values, int start, int end, int number,
+		    sumInfo * pieces)
+{
+  int size = (end-start+number-1)/number;
+  for (int i=0;i<number;i++) {
+    pieces[i].values = values;
+    pieces[i].start = CoinMin(start+i*size,end);
+    pieces[i].end = CoinMin(start+(i+1)*size,end);
+    pieces[i].sum = 0;
+    pieces[i].timesRun = 0;
+  }
+  CoinThreadPool::run(sumPiece,pieces,sizeof(sumInfo),number);
+  long long sum = 0;
+  for (int i=0;i<number;i++) {
+    assert (pieces[i].timesRun==1);
+    sum += pieces[i].sum;
+  }
+  return sum;
+}
+
+/* Outer task of nested test - sums its piece by running inner tasks,
+   which must be done in this thread (so they never wait for each other) */
+struct nestedInfo {
+  const int * values;
+  int start;
+  int end;
+  long long sum;
+  bool inTask;
+  bool sameThread;
+};
+
+#ifdef COINUTILS_PTHREADS
+struct threadInfo {
+  sumInfo piece;
+  pthread_t thread;
+};
+
+void * innerThread(void * info)
+{
+  threadInfo * mine = static_cast<threadInfo *>(info);
+  mine->thread = pthread_self();
+  return sumPiece(&mine->piece);
+}
+#endif
+
+void * nestedTask(void * info)
+{
+  nestedInfo * outer = static_cast<nestedInfo *>(info);
+  outer->inTask = CoinThreadPool::inTask();
+  outer->sameThread = true;
+#ifdef COINUTILS_PTHREADS
+  threadInfo inner[numberInner];
+  int size = (outer->end-outer->start+numberInner-1)/numberInner;
+  for (int i=0;i<numberInner;i++) {
+    inner[i].piece.values = outer->values;
+    inner[i].piece.start = CoinMin(outer->start+i*size,outer->end);
+    inner[i].piece.end = CoinMin(outer->start+(i+1)*size,outer->end);
+    inner[i].piece.sum = 0;
+    inner[i].piece.timesRun = 0;
+  }
+  CoinThreadPool::run(innerThread,inner,sizeof(threadInfo),numberInner);
+  outer->sum = 0;
+  for (int i=0;i<numberInner;i++) {
+    assert (inner[i].piece.timesRun==1);
+    outer->sum += inner[i].piece.sum;
+    if (!pthread_equal(inner[i].thread,pthread_self()))
+      outer->sameThread = false;
+  }
+#else
+  sumInfo inner[numberInner];
+  outer->sum = sumPieces(outer->values,outer->start,outer->end,
+			 numberInner,inner);
+#endif
+  return NULL;
+}
+
+// Runner which does tasks backwards and counts calls
+int numberRunnerCalls = 0;
+void backwardsRunner(CoinTaskFunction function, char * info, int sizeInfo,
+		     int number, void * data)
+{
+  numberRunnerCalls++;
+  assert (data==&numberRunnerCalls);
+  for (int i=number-1;i>=0;i--)
+    function(info+i*sizeInfo);
+}
+
+#ifdef COINUTILS_PTHREADS
+// Several callers of run at once
+struct callerInfo {
+  const int * values;
+  long long sum;
+};
+
+void * caller(void * info)
+{
+  callerInfo * mine = static_cast<callerInfo *>(info);
+  sumInfo pieces[16];
+  mine->sum = sumPieces(mine->values,0,numberValues,16,pieces);
+  return NULL;
+}
+#endif
+
+}	// end file-local namespace
+
+void CoinThreadPoolUnitTest()
+{
+  int saveThreads = CoinThreadPool::numberThreads();
+  // make sure pool is used even on one processor
+  CoinThreadPool::setNumberThreads(4);
+  int * values = new int[numberValues];
+  long long total = 0;
+  for (int i=0;i<numberValues;i++) {
+    values[i] = (i*7919)%1000-500;
+    total += values[i];
+  }
+  assert (!CoinThreadPool::inTask());
+
+  // batches of tasks - fewer, as many and more than threads
+  {
+    sumInfo pieces[100];
+    int sizes[] = {1,3,4,7,100};
+    for (int k=0;k<5;k++)
+      for (int pass=0;pass<10;pass++)
+	assert (sumPieces(values,0,numberValues,sizes[k],pieces)==total);
+    // nothing to do
+    CoinThreadPool::run(sumPiece,pieces,sizeof(sumInfo),0);
+  }
+
+  // fork-join inside tasks
+  {
+    const int numberOuter = 6;
+    nestedInfo outer[numberOuter];
+    int size = (numberValues+numberOuter-1)/numberOuter;
+    for (int i=0;i<numberOuter;i++) {
+      outer[i].values = values;
+      outer[i].start = CoinMin(i*size,numberValues);
+      outer[i].end = CoinMin((i+1)*size,numberValues);
+      outer[i].sum = 0;
+    }
+    CoinThreadPool::run(nestedTask,outer,sizeof(nestedInfo),numberOuter);
+    long long sum = 0;
+    for (int i=0;i<numberOuter;i++) {
+      sum += outer[i].sum;
+      assert (outer[i].sameThread);
+#ifdef COINUTILS_PTHREADS
+      assert (outer[i].inTask);
+#endif
+    }
+    assert (sum==total);
+    assert (!CoinThreadPool::inTask());
+  }
+
+#ifdef COINUTILS_PTHREADS
+  // several threads calling run at the same time
+  {
+    const int numberCallers = 4;
+    callerInfo callers[numberCallers];
+    pthread_t threads[numberCallers];
+    for (int i=0;i<numberCallers;i++) {
+      callers[i].values = values;
+      callers[i].sum = 0;
+      pthread_create(threads+i,NULL,caller,callers+i);
+    }
+    for (int i=0;i<numberCallers;i++) {
+      pthread_join(threads[i],NULL);
+      assert (callers[i].sum==total);
+    }
+  }
+#endif
+
+  // one thread and changing number of threads
+  {
+    sumInfo pieces[9];
+    CoinThreadPool::setNumberThreads(1);
+    assert (CoinThreadPool::numberThreads()==1);
+    assert (sumPieces(values,0,numberValues,9,pieces)==total);
+    CoinThreadPool::setNumberThreads(3);
+    assert (sumPieces(values,0,numberValues,9,pieces)==total);
+  }
+
+  // application's runner takes everything
+  {
+    sumInfo pieces[5];
+    numberRunnerCalls = 0;
+    CoinThreadPool::setRunner(backwardsRunner,&numberRunnerCalls);
+    assert (sumPieces(values,0,numberValues,5,pieces)==total);
+    assert (numberRunnerCalls==1);
+    CoinThreadPool::setRunner(NULL);
+    assert (sumPieces(values,0,numberValues,5,pieces)==total);
+    assert (numberRunnerCalls==1);
+  }
+
+  delete [] values;
+  CoinThreadPool::setNumberThreads(saveThreads);
+}
@@ -0,0 +1,182 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "CoinPragma.hpp"
+#include "CoinWarmStartDiffCoder.hpp"
+#include "CoinWarmStartVector.hpp"
+#include "CoinWarmStartPrimalDual.hpp"
+
+namespace {
+
+const int numberValues = 2000;
+
+// Base vector and one with a few entries changed
+void makeVectors(std::vector<double> &before, std::vector<double> &after)
+{
+  before.resize(numberValues);
+  after.resize(numberValues);
+  for (int i = 0; i < numberValues; i++) {
+    before[i] = 0.1 * i;
+    after[i] = before[i];
+  }
+  for (int i = 3; i < numberValues; i += 37)
+    after[i] = 1.0 / (i + 3.0);
+  // and the last
+  after[numberValues - 1] = -7.25;
+}
+
+}	// end file-local namespace
+
+void CoinWarmStartDiffCoderUnitTest()
+{
+  // varints and zigzag
+  {
+    const CoinUInt64 values[] = {0, 1, 127, 128, 300, 16383, 16384,
+				 0xffffffffULL, 0x100000000ULL,
+				 0xffffffffffffffffULL};
+    const int sizes[] = {1, 1, 1, 2, 2, 2, 3, 5, 5, 10};
+    std::vector<unsigned char> buffer;
+    for (int i = 0; i < 10; i++) {
+      size_t before = buffer.size();
+      CoinVarintPut(buffer, values[i]);
+      assert (buffer.size() - before == static_cast<size_t>(sizes[i]));
+    }
+    const unsigned char *at = &buffer[0];
+    const unsigned char *end = at + buffer.size();
+    for (int i = 0; i < 10; i++) {
+      CoinUInt64 value;
+      assert (CoinVarintGet(at, end, value));
+      assert (value == values[i]);
+    }
+    assert (at == end);
+    // last one cut short
+    CoinUInt64 value;
+    at = end - 10;
+    assert (!CoinVarintGet(at, end - 1, value));
+    const CoinInt64 signedValues[] = {0, -1, 1, -64, 63, -1000000,
+				      0x7fffffffffffffffLL,
+				      -0x7fffffffffffffffLL - 1};
+    for (int i = 0; i < 8; i++)
+      assert (CoinUnzigzag(CoinZigzag(signedValues[i])) == signedValues[i]);
+    // small magnitudes stay small
+    assert (CoinZigzag(-1) == 1 && CoinZigzag(1) == 2 && CoinZigzag(-64) < 128);
+  }
+
+  // vector diff exact and quantised
+  {
+    std::vector<double> before, after;
+    makeVectors(before, after);
+    CoinWarmStartVector<double> oldVector(numberValues, &before[0]);
+    CoinWarmStartVector<double> newVector(numberValues, &after[0]);
+    CoinWarmStartDiff *diff = newVector.generateDiff(&oldVector);
+    const CoinWarmStartVectorDiff<double> *vectorDiff =
+      dynamic_cast<const CoinWarmStartVectorDiff<double> *>(diff);
+    assert (vectorDiff);
+    std::vector<unsigned char> exact;
+    vectorDiff->encode(exact);
+    std::vector<unsigned char> quantised;
+    vectorDiff->encode(quantised, true);
+    assert (quantised.size() < exact.size());
+    delete diff;
+
+    const unsigned char *at = &exact[0];
+    CoinWarmStartVectorDiff<double> *decoded =
+      CoinWarmStartVectorDiff<double>::decode(at, at + exact.size());
+    assert (decoded);
+    assert (at == &exact[0] + exact.size());
+    CoinWarmStartVector<double> rebuilt(oldVector);
+    rebuilt.applyDiff(decoded);
+    delete decoded;
+    for (int i = 0; i < numberValues; i++)
+      assert (rebuilt.values()[i] == after[i]);
+
+    at = &quantised[0];
+    decoded = CoinWarmStartVectorDiff<double>::decode(at, at + quantised.size());
+    assert (decoded);
+    CoinWarmStartVector<double> approximate(oldVector);
+    approximate.applyDiff(decoded);
+    delete decoded;
+    for (int i = 0; i < numberValues; i++)
+      assert (fabs(approximate.values()[i] - after[i]) <=
+	      1.0e-6 * (1.0 + fabs(after[i])));
+
+    // malformed - every truncation and a bad mode
+    for (size_t length = 0; length < exact.size(); length += 7) {
+      at = &exact[0];
+      assert (!CoinWarmStartVectorDiff<double>::decode(at, at + length));
+    }
+    std::vector<unsigned char> bad(exact);
+    CoinUInt64 count;
+    at = &bad[0];
+    assert (CoinVarintGet(at, at + bad.size(), count));
+    bad[at - &bad[0]] = 7;
+    at = &bad[0];
+    assert (!CoinWarmStartVectorDiff<double>::decode(at, at + bad.size()));
+  }
+
+  // primal dual diff - two vector diffs back to back
+  {
+    std::vector<double> before, after;
+    makeVectors(before, after);
+    CoinWarmStartPrimalDual oldStart(numberValues, numberValues / 2,
+				     &before[0], &before[0]);
+    CoinWarmStartPrimalDual newStart(numberValues, numberValues / 2,
+				     &after[0], &after[0]);
+    CoinWarmStartDiff *diff = newStart.generateDiff(&oldStart);
+    const CoinWarmStartPrimalDualDiff *pdDiff =
+      dynamic_cast<const CoinWarmStartPrimalDualDiff *>(diff);
+    assert (pdDiff);
+    std::vector<unsigned char> buffer;
+    pdDiff->encode(buffer);
+    delete diff;
+    const unsigned char *at = &buffer[0];
+    CoinWarmStartPrimalDualDiff *decoded =
+      CoinWarmStartPrimalDualDiff::decode(at, at + buffer.size());
+    assert (decoded);
+    assert (at == &buffer[0] + buffer.size());
+    CoinWarmStartPrimalDual rebuilt(oldStart);
+    rebuilt.applyDiff(decoded);
+    delete decoded;
+    for (int i = 0; i < numberValues; i++)
+      assert (rebuilt.primal()[i] == after[i]);
+    for (int i = 0; i < numberValues / 2; i++)
+      assert (rebuilt.dual()[i] == after[i]);
+    // dual part missing
+    at = &buffer[0];
+    assert (!CoinWarmStartPrimalDualDiff::decode(at, at + buffer.size() / 2));
+  }
+
+  // records through a FILE
+  {
+    FILE *fp = tmpfile();
+    assert (fp);
+    std::vector<unsigned char> records[3];
+    records[0].assign(5, 1);
+    records[2].assign(300, 2);
+    CoinWarmStartDiffWriter writer(fp);
+    for (int i = 0; i < 3; i++)
+      assert (writer.write(records[i]));
+    assert (writer.flush());
+    // length prefix of 1, 1 and 2 bytes
+    assert (writer.bytesWritten() == 5 + 300 + 4);
+    rewind(fp);
+    CoinWarmStartDiffReader reader(fp);
+    std::vector<unsigned char> record;
+    for (int i = 0; i < 3; i++) {
+      assert (reader.read(record));
+      assert (record == records[i]);
+    }
+    assert (!reader.read(record));
+    fclose(fp);
+  }
+}
@@ -0,0 +1,135 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+
+#include "CoinPragma.hpp"
+#include "CoinWarmStartBasis.hpp"
+#include "CoinWarmStartSharedBasis.hpp"
+
+namespace {
+
+const int numberStructural = 1000;
+const int numberArtificial = 300;
+
+CoinWarmStartBasis::Status statusOf(int i, int seed)
+{
+  return static_cast<CoinWarmStartBasis::Status>((i * 7 + seed) % 4);
+}
+
+// True if shared has the same statuses as basis
+bool sameStatus(const CoinWarmStartSharedBasis &shared,
+		const CoinWarmStartBasis &basis)
+{
+  if (shared.getNumStructural() != basis.getNumStructural() ||
+      shared.getNumArtificial() != basis.getNumArtificial())
+    return false;
+  for (int i = 0; i < basis.getNumStructural(); i++) {
+    if (shared.getStructStatus(i) != basis.getStructStatus(i))
+      return false;
+  }
+  for (int i = 0; i < basis.getNumArtificial(); i++) {
+    if (shared.getArtifStatus(i) != basis.getArtifStatus(i))
+      return false;
+  }
+  return true;
+}
+
+// Applies diff from base to target to a shared copy of base
+bool diffWorks(const CoinWarmStartBasis &base,
+	       const CoinWarmStartBasis &target)
+{
+  CoinWarmStartDiff *diff = target.generateDiff(&base);
+  CoinWarmStartSharedBasis shared(base);
+  shared.applyDiff(diff);
+  delete diff;
+  return sameStatus(shared, target);
+}
+
+}	// end file-local namespace
+
+void CoinWarmStartSharedBasisUnitTest()
+{
+  CoinWarmStartBasis base;
+  base.setSize(numberStructural, numberArtificial);
+  for (int i = 0; i < numberStructural; i++)
+    base.setStructStatus(i, statusOf(i, 0));
+  for (int i = 0; i < numberArtificial; i++)
+    base.setArtifStatus(i, statusOf(i, 1));
+
+  CoinWarmStartSharedBasis shared(base);
+  assert (sameStatus(shared, base));
+  assert (!shared.numberPrivatePages());
+  assert (shared.shareCount() == 1);
+
+  // a change makes one private page and leaves the base alone
+  CoinWarmStartBasis expected(base);
+  shared.setStructStatus(5, CoinWarmStartBasis::isFree);
+  expected.setStructStatus(5, CoinWarmStartBasis::isFree);
+  shared.setStructStatus(6, CoinWarmStartBasis::basic);
+  expected.setStructStatus(6, CoinWarmStartBasis::basic);
+  assert (shared.numberPrivatePages() == 1);
+  assert (sameStatus(shared, expected));
+  // artificials have pages of their own
+  shared.setArtifStatus(0, CoinWarmStartBasis::atUpperBound);
+  expected.setArtifStatus(0, CoinWarmStartBasis::atUpperBound);
+  shared.setArtifStatus(numberArtificial - 1, CoinWarmStartBasis::basic);
+  expected.setArtifStatus(numberArtificial - 1, CoinWarmStartBasis::basic);
+  shared.setStructStatus(numberStructural - 1, CoinWarmStartBasis::basic);
+  expected.setStructStatus(numberStructural - 1, CoinWarmStartBasis::basic);
+  assert (shared.numberPrivatePages() == 4);
+  assert (sameStatus(shared, expected));
+
+  // copies share the base but not the changes
+  {
+    CoinWarmStartSharedBasis copy(shared);
+    assert (shared.shareCount() == 2);
+    assert (sameStatus(copy, expected));
+    copy.setStructStatus(5, CoinWarmStartBasis::atLowerBound);
+    assert (copy.getStructStatus(5) == CoinWarmStartBasis::atLowerBound);
+    assert (sameStatus(shared, expected));
+    CoinWarmStart *clone = shared.clone();
+    assert (shared.shareCount() == 3);
+    CoinWarmStartSharedBasis *cloned =
+      dynamic_cast<CoinWarmStartSharedBasis *>(clone);
+    assert (cloned && sameStatus(*cloned, expected));
+    delete clone;
+    // assignment from a copy of another base
+    CoinWarmStartSharedBasis other(base);
+    other = copy;
+    assert (other.shareCount() == 3);
+    assert (other.getStructStatus(5) == CoinWarmStartBasis::atLowerBound);
+    other = other;
+    assert (other.getStructStatus(5) == CoinWarmStartBasis::atLowerBound);
+  }
+  assert (shared.shareCount() == 1);
+
+  // full basis back
+  {
+    CoinWarmStartBasis *basis = shared.basis();
+    assert (sameStatus(shared, *basis));
+    delete basis;
+  }
+
+  // diffs - scattered words, a run of words and the whole basis
+  {
+    CoinWarmStartBasis target(base);
+    target.setStructStatus(0, CoinWarmStartBasis::isFree);
+    target.setStructStatus(500, CoinWarmStartBasis::isFree);
+    target.setArtifStatus(200, CoinWarmStartBasis::isFree);
+    assert (diffWorks(base, target));
+    for (int i = 160; i < 400; i++)
+      target.setStructStatus(i, statusOf(i, 2));
+    assert (diffWorks(base, target));
+    for (int i = 0; i < numberStructural; i++)
+      target.setStructStatus(i, statusOf(i, 3));
+    for (int i = 0; i < numberArtificial; i++)
+      target.setArtifStatus(i, statusOf(i, 2));
+    assert (diffWorks(base, target));
+  }
+}
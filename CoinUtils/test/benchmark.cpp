@@ -0,0 +1,88 @@
+// Copyright (C) 2026, International Business Machines
+// Corporation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Timing of CoinUtils components.  Unlike unitTest nothing is checked
+// beyond what is needed to make the figures meaningful.
+
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "CoinPragma.hpp"
+#include "CoinError.hpp"
+
+int CoinFactorizationBenchmark(std::map<std::string, std::string> &parms);
+int CoinSortBenchmark(std::map<std::string, std::string> &parms);
+int CoinIOBenchmark(std::map<std::string, std::string> &parms);
+int CoinKernelBenchmark(std::map<std::string, std::string> &parms);
+int CoinPresolveBenchmark(std::map<std::string, std::string> &parms);
+int CoinSearchTreeBenchmark(std::map<std::string, std::string> &parms);
+
+//----------------------------------------------------------------
+// benchmark suite [-keyword=value ...]
+//
+// where suite is one of
+//   factor: replay basis sequences through each factorization class
+//           (see CoinFactorizationBench.cpp for keywords)
+//   sort:   serial and parallel CoinSort_2 and CoinSort_3
+//           (see CoinSortBench.cpp for keywords)
+//   io:     write and read MPS and LP files in each compression
+//           (see CoinIOBench.cpp for keywords)
+//   kernel: vector, matrix and sort kernels against a saved baseline
+//           (see CoinKernelBench.cpp for keywords)
+//   presolve: presolve transforms with postsolve checks
+//           (see CoinPresolveBench.cpp for keywords)
+//   tree:   node throughput of the search trees, serial and parallel
+//           (see CoinSearchTreeBench.cpp for keywords)
+//----------------------------------------------------------------
+int main(int argc, const char *argv[])
+{
+  std::string suite;
+  std::map<std::string, std::string> parms;
+  for (int i = 1; i < argc; i++) {
+    std::string parm(argv[i]);
+    if (parm[0] != '-') {
+      suite = parm;
+      continue;
+    }
+    std::string::size_type eqPos = parm.find('=');
+    if (eqPos == std::string::npos)
+      parms[parm] = "";
+    else
+      parms[parm.substr(0, eqPos)] = parm.substr(eqPos+1);
+  }
+  int returnCode = 1;
+  try {
+    if (suite == "factor") {
+      returnCode = CoinFactorizationBenchmark(parms);
+    } else if (suite == "sort") {
+      returnCode = CoinSortBenchmark(parms);
+    } else if (suite == "io") {
+      returnCode = CoinIOBenchmark(parms);
+    } else if (suite == "kernel") {
+      returnCode = CoinKernelBenchmark(parms);
+    } else if (suite == "presolve") {
+      returnCode = CoinPresolveBenchmark(parms);
+    } else if (suite == "tree") {
+      returnCode = CoinSearchTreeBenchmark(parms);
+    } else {
+      std::cerr
+	<< "Correct usage: \n"
+	<< "  benchmark suite [-keyword=value ...]\n"
+	<< "where suite is one of:\n"
+	<< "  factor: factorization replay\n"
+	<< "  sort: serial and parallel sorts\n"
+	<< "  io: MPS and LP reading and writing\n"
+	<< "  kernel: vector, matrix and sort kernels\n"
+	<< "  presolve: presolve and postsolve of models\n"
+	<< "  tree: search tree node throughput\n";
+    }
+  }
+  catch (CoinError& error) {
+    std::cerr << "Caught CoinError exception: ";
+    error.print(true);
+  }
+  return returnCode;
+}
@@ -13,6 +13,7 @@
 
 #include "CoinPragma.hpp"
 #include "CoinFinite.hpp"
+#include "CoinFloatEqual.hpp"
 #include "CoinError.hpp"
 #include "CoinHelperFunctions.hpp"
 #include "CoinSort.hpp"
@@ -24,11 +25,46 @@
 #include "CoinMpsIO.hpp"
 #include "CoinLpIO.hpp"
 #include "CoinMessageHandler.hpp"
+#include "CoinSmartPtr.hpp"
 void CoinModelUnitTest(const std::string & mpsDir,
                        const std::string & netlibDir, const std::string & testModel);
+void CoinArenaUnitTest();
+void CoinBitVectorUnitTest();
+void CoinCliqueTableUnitTest();
+void CoinCounterRandomUnitTest();
+void CoinCutPoolUnitTest();
+void CoinDomainPropagatorUnitTest();
+void CoinFingerprintUnitTest();
+void CoinInstrumentUnitTest();
+void CoinNodeStoreUnitTest();
+void CoinParallelSearchTreeManagerUnitTest();
+void CoinParamIndexUnitTest();
+void CoinPresolveJournalUnitTest();
+void CoinSearchTreeDaryUnitTest();
+void CoinSelectFactorizationUnitTest();
+void CoinSnapshotUnitTest();
+void CoinSortUnitTest();
+void CoinStructuredMatrixUnitTest();
+void CoinThreadMessageHandlerUnitTest();
+void CoinWarmStartDiffCoderUnitTest();
+void CoinWarmStartSharedBasisUnitTest();
+void CoinThreadPoolUnitTest();
 // Function Prototypes. Function definitions is in this file.
 void testingMessage( const char * const msg );
 
+namespace {
+  // Counts destructions
+  int numberSharedDeleted = 0 ;
+  class sharedThing : public CoinAtomicReferencedObject {
+  public:
+    sharedThing () : value_(42) {}
+    ~sharedThing () { numberSharedDeleted++ ; }
+    int value () const { return value_ ; }
+  private:
+    int value_ ;
+  } ;
+}
+
 //----------------------------------------------------------------
 // unitTest [-mpsDir=V1] [-netlibDir=V2] [-testModel=V3]
 // 
@@ -171,6 +207,79 @@ int main (int argc, const char *argv[])
   testingMessage( "ERROR: No functional CoinIsnan.\n" ) ;
 # endif
 
+/*
+  Check the array versions agree with the value by value tests.
+*/
+  testingMessage( "Testing array checks ... " ) ;
+  {
+    const int size = 21 ;
+    double a[size] ;
+    double b[size] ;
+    for (int i = 0 ; i < size ; i++) {
+      a[i] = i - 10.0 ;
+      b[i] = a[i] ;
+    }
+    bool ok = CoinFirstNotFinite(a,size) == size ;
+    ok &= CoinCountAbove(a,size,7.5) == 6 ;
+    a[17] = checkVal ;
+    ok &= CoinFirstNotFinite(a,size) == 17 ;
+    a[3] = COIN_DBL_MAX ;
+    ok &= CoinFirstNotFinite(a,size) == (CoinFinite(COIN_DBL_MAX) ? 17 : 3) ;
+    a[3] = b[3] ;
+    a[17] = b[17] ;
+    CoinAbsFltEq absEq(1.0e-6) ;
+    CoinRelFltEq relEq(1.0e-6) ;
+    ok &= absEq.firstDifferent(a,b,size) == size ;
+    ok &= relEq.firstDifferent(a,b,size) == size ;
+    a[19] = b[19] + 1.0e-3 ;
+    a[12] = b[12] + 1.0e-9 ;
+    ok &= absEq.firstDifferent(a,b,size) == 19 ;
+    ok &= relEq.firstDifferent(a,b,size) == 19 ;
+    a[5] = b[5] = COIN_DBL_MAX ;
+    a[6] = COIN_DBL_MAX ;
+    ok &= relEq.firstDifferent(a,b,size) == 6 ;
+    ok &= CoinFirstDifferent(relEq,a,b,size) == 6 ;
+    int count = 0 ;
+    for (int i = 0 ; i < size ; i++) {
+      if (!relEq(a[i],b[i]))
+	count++ ;
+    }
+    ok &= relEq.countDifferent(a,b,size) == count ;
+    ok &= absEq.countDifferent(a,b,size) == 2 ;
+    if (ok)
+    { testingMessage( "ok.\n" ) ; }
+    else
+    { allOK = false ;
+      testingMessage( "ERROR.\n" ) ; }
+  }
+
+
+  testingMessage( "Testing CoinSharedPtr ... " ) ;
+  {
+    bool ok = true ;
+    {
+      CoinSharedPtr<sharedThing> first(new sharedThing()) ;
+      CoinSharedPtr<sharedThing> second(first) ;
+      CoinSharedPtr<sharedThing> third ;
+      third = second ;
+      ok &= first.ReferenceCount() == 3 && third->value() == 42 ;
+      ok &= first == third ;
+      second.Reset() ;
+      third = third ;
+      ok &= first.ReferenceCount() == 2 && second.IsNull() ;
+      ok &= numberSharedDeleted == 0 ;
+      // SmartPtr also works with an atomic count
+      CoinSmartPtr<sharedThing> smart = new sharedThing() ;
+      smart = smart.GetRawPtr() ;
+      ok &= smart->ReferenceCount() == 1 ;
+    }
+    ok &= numberSharedDeleted == 2 ;
+    if (ok)
+    { testingMessage( "ok.\n" ) ; }
+    else
+    { allOK = false ;
+      testingMessage( "ERROR.\n" ) ; }
+  }
 
   testingMessage( "Testing CoinModel\n" );
   CoinModelUnitTest(mpsDir,netlibDir,testModel);
@@ -204,10 +313,73 @@ int main (int argc, const char *argv[])
   testingMessage( "Testing CoinLpIO\n" );
   CoinLpIOUnitTest(mpsDir);
 
+  testingMessage( "Testing CoinWarmStartSharedBasis\n" );
+  CoinWarmStartSharedBasisUnitTest();
+
+  testingMessage( "Testing CoinInstrument\n" );
+  CoinInstrumentUnitTest();
+
+  testingMessage( "Testing CoinBitVector\n" );
+  CoinBitVectorUnitTest();
+
+  testingMessage( "Testing CoinArena\n" );
+  CoinArenaUnitTest();
+
+  testingMessage( "Testing CoinWarmStartDiffCoder\n" );
+  CoinWarmStartDiffCoderUnitTest();
+
+  testingMessage( "Testing CoinNodeStore\n" );
+  CoinNodeStoreUnitTest();
+
+  testingMessage( "Testing CoinPresolveJournal\n" );
+  CoinPresolveJournalUnitTest();
+
+  testingMessage( "Testing CoinCliqueTable\n" );
+  CoinCliqueTableUnitTest();
+
+  testingMessage( "Testing CoinDomainPropagator\n" );
+  CoinDomainPropagatorUnitTest();
+
+  testingMessage( "Testing CoinCutPool\n" );
+  CoinCutPoolUnitTest();
+
+  testingMessage( "Testing CoinFingerprint\n" );
+  CoinFingerprintUnitTest();
+
+  testingMessage( "Testing CoinStructuredMatrix\n" );
+  CoinStructuredMatrixUnitTest();
+
+  testingMessage( "Testing CoinSelectFactorization\n" );
+  CoinSelectFactorizationUnitTest();
+
+  testingMessage( "Testing CoinSort\n" );
+  CoinSortUnitTest();
+
+  testingMessage( "Testing CoinParallelSearchTreeManager\n" );
+  CoinParallelSearchTreeManagerUnitTest();
+
+  testingMessage( "Testing CoinSearchTreeDary\n" );
+  CoinSearchTreeDaryUnitTest();
+
+  testingMessage( "Testing CoinSnapshot\n" );
+  CoinSnapshotUnitTest();
+
+  testingMessage( "Testing CoinCounterRandom\n" );
+  CoinCounterRandomUnitTest();
+
+  testingMessage( "Testing CoinParamIndex\n" );
+  CoinParamIndexUnitTest();
+
   testingMessage( "Testing CoinMessageHandler\n" );
   if (!CoinMessageHandlerUnitTest())
   { allOK = false ; }
 
+  testingMessage( "Testing CoinThreadMessageHandler\n" );
+  CoinThreadMessageHandlerUnitTest();
+
+  testingMessage( "Testing CoinThreadPool\n" );
+  CoinThreadPoolUnitTest();
+
   if (allOK)
   { testingMessage( "All tests completed successfully.\n" );
     return (0) ; }